@@ -0,0 +1,233 @@
+#include "oem/ibm/libpldmresponder/file_io.hpp"
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <unistd.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+
+/* Transfers a file between the BMC and a simulated host through dma::DMA,
+ * and reports the throughput of each run with the time the transfers
+ * waited, spent in DMA and in file I/O, as recorded for the DMA statistics
+ * of pldmd.
+ *
+ * The XDMA device is replaced by a regular file, large enough for the VGA
+ * window: the DMA operations written to it complete at once, the benchmark
+ * measures the BMC side of the transfers, the file I/O, the copies through
+ * the staging buffers and the waits. Run it with several values of the
+ * oem-ibm-dma-maxsize option to compare the chunk sizes. On a system, the
+ * DMA time of the real transfers is read with pldmtool oem-ibm
+ * DMAStatistics.
+ */
+
+namespace fs = std::filesystem;
+using namespace pldm::responder;
+
+namespace
+{
+
+/** @brief Benchmark parameters, from the command line */
+struct Config
+{
+    uint32_t size = 16 * 1024 * 1024;
+    size_t transfers = 16;
+    size_t runs = 1;
+    bool downstream = false;
+    bool async = false;
+};
+
+/** @brief Address of the simulated host memory, unused by the fake device */
+constexpr uint64_t hostAddress = 0x1000000;
+
+/** @brief Run the transfers one after the other, on the calling thread
+ *
+ *  @return true if all the transfers succeeded
+ */
+bool runSync(const Config& config, int fd)
+{
+    dma::DMA intf;
+    for (size_t i = 0; i < config.transfers; i++)
+    {
+        if (intf.transferFile(fd, 0, config.size, hostAddress,
+                              !config.downstream) < 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** @brief Run the transfers off the event loop, keeping maxQueuedTransfers
+ *         of them queued
+ *
+ *  @return true if all the transfers succeeded
+ */
+bool runAsync(const Config& config, int fd)
+{
+    auto event = sdeventplus::Event::get_default();
+    auto file = std::make_shared<pldm::utils::CustomFD>(dup(fd));
+    size_t queued = 0;
+    size_t done = 0;
+    bool ok = true;
+
+    std::function<void()> queue;
+    queue = [&] {
+        while (queued < config.transfers)
+        {
+            dma::DMA intf;
+            if (!intf.transferFileAsync(file, 0, config.size, hostAddress,
+                                        !config.downstream, [&](int rc) {
+                                            ok = ok && rc == 0;
+                                            if (++done == config.transfers)
+                                            {
+                                                event.exit(0);
+                                                return;
+                                            }
+                                            queue();
+                                        }))
+            {
+                return;
+            }
+            queued++;
+        }
+    };
+    queue();
+    return !event.loop() && ok;
+}
+
+/** @brief Run the transfers once and report their throughput and the
+ *         statistics they recorded
+ *
+ *  @return true if all the transfers succeeded
+ */
+bool runTransfers(const Config& config, int fd)
+{
+    auto before = dma::getTransferStats()[dma::untypedTransfers];
+    auto start = std::chrono::steady_clock::now();
+    auto ok = config.async ? runAsync(config, fd) : runSync(config, fd);
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    auto after = dma::getTransferStats()[dma::untypedTransfers];
+
+    auto bytes = after.bytes - before.bytes;
+    auto mib = static_cast<double>(bytes) / (1024 * 1024);
+    std::cout << std::format(
+        "{:>10} us {:>10.0f} KiB/s {:>8} chunks {:>10} us wait {:>10} us DMA "
+        "{:>10} us file I/O{}\n",
+        elapsed.count(),
+        elapsed.count() ? mib * 1024 * 1000000 / elapsed.count() : 0.0,
+        after.chunks - before.chunks, after.waitUs - before.waitUs,
+        after.dmaUs - before.dmaUs, after.fileUs - before.fileUs,
+        ok ? "" : " FAILED");
+    return ok;
+}
+
+void usage()
+{
+    std::cerr << "Usage: dma_benchmark [options]\n"
+                 "  --size N        bytes per transfer (16777216)\n"
+                 "  --transfers N   transfers per run (16)\n"
+                 "  --runs N        runs of the transfers (1)\n"
+                 "  --downstream    transfer from the host to the BMC\n"
+                 "  --async         queue the transfers off the event loop\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    static struct option options[] = {
+        {"size", required_argument, nullptr, 's'},
+        {"transfers", required_argument, nullptr, 't'},
+        {"runs", required_argument, nullptr, 'R'},
+        {"downstream", no_argument, nullptr, 'd'},
+        {"async", no_argument, nullptr, 'a'},
+        {nullptr, 0, nullptr, 0}};
+
+    Config config;
+    int option = 0;
+    while ((option = getopt_long(argc, argv, "", options, nullptr)) != -1)
+    {
+        auto value = optarg ? std::strtoul(optarg, nullptr, 10) : 0;
+        switch (option)
+        {
+            case 's':
+                config.size = value;
+                break;
+            case 't':
+                config.transfers = value;
+                break;
+            case 'R':
+                config.runs = value;
+                break;
+            case 'd':
+                config.downstream = true;
+                break;
+            case 'a':
+                config.async = true;
+                break;
+            default:
+                usage();
+                return EXIT_FAILURE;
+        }
+    }
+    if (!config.size || config.size % dma::minSize || !config.transfers)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    char tmpl[] = "/tmp/dma_benchmark.XXXXXX";
+    if (!mkdtemp(tmpl))
+    {
+        std::cerr << "Failed to create the benchmark directory\n";
+        return EXIT_FAILURE;
+    }
+    fs::path dir(tmpl);
+
+    // The DMA operations written to the device file overwrite the window
+    // and grow the file, the transferred data is not checked
+    auto devicePath = dir / "xdma";
+    std::ofstream(devicePath).close();
+    fs::resize_file(devicePath, dma::maxSize + getpagesize());
+    dma::DMA::setDevice(devicePath);
+
+    auto dataPath = dir / "data";
+    std::ofstream(dataPath).close();
+    fs::resize_file(dataPath, config.size);
+    int fd = open(dataPath.c_str(), O_RDWR);
+    if (fd < 0)
+    {
+        std::cerr << "Failed to open the benchmark file\n";
+        fs::remove_all(dir);
+        return EXIT_FAILURE;
+    }
+    pldm::utils::CustomFD file(fd);
+
+    std::cout << std::format(
+        "{} transfers of {} bytes {}, {} byte chunks{}\n", config.transfers,
+        config.size, config.downstream ? "from the host" : "to the host",
+        dma::maxSize, config.async ? ", off the event loop" : "");
+
+    auto rc = EXIT_SUCCESS;
+    for (size_t run = 0; run < config.runs; run++)
+    {
+        if (!runTransfers(config, file()))
+        {
+            rc = EXIT_FAILURE;
+            break;
+        }
+    }
+
+    fs::remove_all(dir);
+    return rc;
+}
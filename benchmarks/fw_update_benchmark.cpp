@@ -0,0 +1,703 @@
+#include "benchmarks/alloc_counter.hpp"
+#include "common/instance_id.hpp"
+#include "common/loopback.hpp"
+#include "common/transport.hpp"
+#include "fw-update/update_manager.hpp"
+#include "requester/handler.hpp"
+
+#include <getopt.h>
+#include <libpldm/base.h>
+#include <libpldm/firmware_update.h>
+#include <libpldm/utils.h>
+#include <sys/resource.h>
+
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+/* Updates simulated firmware devices with a synthetic package through
+ * fw_update::UpdateManager, and reports the end-to-end update time, the
+ * CPU time per MiB of firmware data served, the peak RSS and the number of
+ * allocations of each run.
+ *
+ * The FDs answer on a loopback network in the process, with a configurable
+ * delay, chunk size and rate of dropped requests and re-requested chunks.
+ * The inventory of the FDs is filled in as a discovery would, only the
+ * update is measured. The CPU time includes the simulated FDs, which do
+ * not copy the data they receive. The update publishes its activation on
+ * D-Bus, run the benchmark in a D-Bus session, as the unit tests.
+ */
+
+namespace fs = std::filesystem;
+using namespace pldm;
+using namespace pldm::fw_update;
+using pldm::transport::Loopback;
+
+namespace
+{
+
+/** @brief UUID descriptor of the simulated FDs and of the package record */
+constexpr std::array<uint8_t, PLDM_FWUP_UUID_LENGTH> deviceUUID{
+    0x16, 0x20, 0x23, 0xC9, 0x3E, 0xC5, 0x41, 0x15,
+    0x95, 0xF4, 0x48, 0x70, 0x1D, 0x49, 0xD6, 0x75};
+
+constexpr CompClassification compClassification = 10;
+constexpr CompIdentifier firstCompIdentifier = 100;
+constexpr mctp_eid_t firstEid = 8;
+constexpr size_t maxDevices = 240;
+
+/** @struct Config
+ *
+ *  Configuration of a benchmark run
+ */
+struct Config
+{
+    size_t devices = 8;
+    size_t components = 1;
+    uint32_t componentSize = 1024 * 1024;
+    /** @brief Length of the data the FDs request, 0 for the MaxTransferSize
+     *         announced in RequestUpdate
+     */
+    uint32_t chunkSize = 0;
+    /** @brief Delay of the messages the FDs send */
+    std::chrono::microseconds latency{0};
+    /** @brief Requests of the BMC the FDs do not answer, per thousand */
+    unsigned dropPermille = 0;
+    /** @brief Chunks the FDs request again, per thousand */
+    unsigned retryPermille = 0;
+    NetworkId networks = 1;
+    size_t runs = 1;
+    unsigned seed = 1;
+    std::chrono::seconds timeout{600};
+};
+
+void appendLE(std::vector<uint8_t>& buffer, uint32_t value, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; i++)
+    {
+        buffer.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+uint32_t readLE(std::span<const uint8_t> buffer, size_t offset, size_t bytes)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < bytes && offset + i < buffer.size(); i++)
+    {
+        value |= static_cast<uint32_t>(buffer[offset + i]) << (8 * i);
+    }
+    return value;
+}
+
+/** @brief Write a package with one FirmwareDeviceIDRecord, matching every
+ *         simulated FD and applicable to all of its components
+ */
+void writePackage(const fs::path& path, const Config& config)
+{
+    constexpr std::array<uint8_t, PLDM_FWUP_UUID_LENGTH> headerIdentifier{
+        0xF0, 0x18, 0x87, 0x8C, 0xCB, 0x7D, 0x49, 0x43,
+        0x98, 0x00, 0xA0, 0x2F, 0x05, 0x9A, 0xCA, 0x02};
+    constexpr size_t compImageInfoSize = 22;
+    const std::string version = "Benchmark";
+    const uint16_t bitmapLength = (config.components + 7) / 8 * 8;
+
+    std::vector<uint8_t> record;
+    appendLE(record, 0, 2); // RecordLength, set below
+    appendLE(record, 1, 1); // DescriptorCount
+    appendLE(record, 0, 4); // DeviceUpdateOptionFlags
+    appendLE(record, PLDM_STR_TYPE_ASCII, 1);
+    appendLE(record, version.size(), 1);
+    appendLE(record, 0, 2); // FirmwareDevicePackageDataLength
+    std::vector<uint8_t> bitmap(bitmapLength / 8, 0);
+    for (size_t i = 0; i < config.components; i++)
+    {
+        bitmap[i / 8] |= 1 << (i % 8);
+    }
+    record.insert(record.end(), bitmap.begin(), bitmap.end());
+    record.insert(record.end(), version.begin(), version.end());
+    appendLE(record, PLDM_FWUP_UUID, 2);
+    appendLE(record, deviceUUID.size(), 2);
+    record.insert(record.end(), deviceUUID.begin(), deviceUUID.end());
+    record[0] = record.size() & 0xFF;
+    record[1] = record.size() >> 8;
+
+    std::vector<std::string> compVersions;
+    size_t compInfosSize = 0;
+    for (size_t i = 0; i < config.components; i++)
+    {
+        compVersions.push_back(std::format("Component{}", i));
+        compInfosSize += compImageInfoSize + compVersions.back().size();
+    }
+
+    std::vector<uint8_t> header(headerIdentifier.begin(),
+                                headerIdentifier.end());
+    appendLE(header, 1, 1); // PackageHeaderFormatRevision
+    const auto headerSize = header.size() + 2 + 13 + 2 + 2 + version.size() +
+                            1 + record.size() + 2 + compInfosSize + 4;
+    appendLE(header, headerSize, 2);
+    header.resize(header.size() + 13, 0); // PackageReleaseDateTime
+    appendLE(header, bitmapLength, 2);
+    appendLE(header, PLDM_STR_TYPE_ASCII, 1);
+    appendLE(header, version.size(), 1);
+    header.insert(header.end(), version.begin(), version.end());
+    appendLE(header, 1, 1); // DeviceIDRecordCount
+    header.insert(header.end(), record.begin(), record.end());
+    appendLE(header, config.components, 2);
+    for (size_t i = 0; i < config.components; i++)
+    {
+        appendLE(header, compClassification, 2);
+        appendLE(header, firstCompIdentifier + i, 2);
+        appendLE(header, 0xFFFFFFFF, 4); // ComponentComparisonStamp
+        appendLE(header, 0, 2);          // ComponentOptions
+        appendLE(header, 0, 2);          // RequestedComponentActivationMethod
+        appendLE(header, headerSize + i * config.componentSize, 4);
+        appendLE(header, config.componentSize, 4);
+        appendLE(header, PLDM_STR_TYPE_ASCII, 1);
+        appendLE(header, compVersions[i].size(), 1);
+        header.insert(header.end(), compVersions[i].begin(),
+                      compVersions[i].end());
+    }
+    appendLE(header, crc32(header.data(), header.size()), 4);
+
+    std::ofstream package(path, std::ios::binary | std::ios::trunc);
+    package.write(reinterpret_cast<const char*>(header.data()), header.size());
+    std::vector<char> block(64 * 1024);
+    for (size_t i = 0; i < block.size(); i++)
+    {
+        block[i] = static_cast<char>(i * 31);
+    }
+    for (uint64_t left = static_cast<uint64_t>(config.componentSize) *
+                         config.components;
+         left;)
+    {
+        auto length = std::min<uint64_t>(left, block.size());
+        package.write(block.data(), length);
+        left -= length;
+    }
+}
+
+/** @class SimulatedDevice
+ *
+ *  Firmware device answering the requests of the update agent, and
+ *  requesting the component images and reporting their transfer,
+ *  verification and application as an FD does.
+ */
+class SimulatedDevice
+{
+  public:
+    SimulatedDevice(mctp_eid_t eid, const Config& config) :
+        eid(eid), config(config), random(config.seed + eid)
+    {}
+
+    /** @brief Handle a message of the BMC */
+    void receive(std::span<const uint8_t> msg)
+    {
+        pldm_header_info header{};
+        if (msg.size() < sizeof(pldm_msg_hdr) ||
+            unpack_pldm_header(
+                reinterpret_cast<const pldm_msg_hdr*>(msg.data()), &header))
+        {
+            failed = true;
+            return;
+        }
+        auto payload = msg.subspan(sizeof(pldm_msg_hdr));
+        if (header.msg_type == PLDM_RESPONSE)
+        {
+            handleResponse(header.command, payload);
+        }
+        else
+        {
+            handleRequest(header, payload);
+        }
+    }
+
+    bool isActivated() const
+    {
+        return activated;
+    }
+
+    bool hasFailed() const
+    {
+        return failed;
+    }
+
+    /** @brief Firmware data served, re-requested chunks included */
+    uint64_t bytes = 0;
+    uint64_t chunks = 0;
+    uint64_t retries = 0;
+    uint64_t drops = 0;
+
+  private:
+    bool inject(unsigned permille)
+    {
+        return permille &&
+               std::uniform_int_distribution<unsigned>(0, 999)(random) <
+                   permille;
+    }
+
+    void send(MessageType msgType, uint8_t instanceId, uint8_t command,
+              const std::vector<uint8_t>& payload)
+    {
+        std::vector<uint8_t> msg(sizeof(pldm_msg_hdr));
+        pldm_header_info header{};
+        header.msg_type = msgType;
+        header.instance = instanceId;
+        header.pldm_type = PLDM_FWUP;
+        header.command = command;
+        pack_pldm_header(&header, reinterpret_cast<pldm_msg_hdr*>(msg.data()));
+        msg.insert(msg.end(), payload.begin(), payload.end());
+        Loopback::get().send(eid, std::move(msg), config.latency);
+    }
+
+    void sendRequest(uint8_t command, const std::vector<uint8_t>& payload)
+    {
+        instanceId = (instanceId + 1) % maxInstanceIds;
+        send(PLDM_REQUEST, instanceId, command, payload);
+    }
+
+    void handleRequest(const pldm_header_info& header,
+                       std::span<const uint8_t> payload)
+    {
+        if (inject(config.dropPermille))
+        {
+            drops++;
+            return;
+        }
+
+        std::vector<uint8_t> response{PLDM_SUCCESS};
+        switch (header.command)
+        {
+            case PLDM_REQUEST_UPDATE:
+                maxTransferSize = readLE(payload, 0, 4);
+                // FirmwareDeviceMetaDataLength, FDWillSendGetPackageData
+                appendLE(response, 0, 3);
+                break;
+            case PLDM_PASS_COMPONENT_TABLE:
+                // ComponentResponse, ComponentResponseCode
+                appendLE(response, 0, 2);
+                break;
+            case PLDM_UPDATE_COMPONENT:
+                // ComponentCompatibilityResponse and its code,
+                // UpdateOptionFlagsEnabled, TimeBeforeRequestFWData
+                appendLE(response, 0, 8);
+                break;
+            case PLDM_ACTIVATE_FIRMWARE:
+                activated = true;
+                // EstimatedTimeForSelfContainedActivation
+                appendLE(response, 0, 2);
+                break;
+            default:
+                response = {PLDM_ERROR_UNSUPPORTED_PLDM_CMD};
+                break;
+        }
+        send(PLDM_RESPONSE, header.instance, header.command, response);
+
+        // A retried UpdateComponent does not restart the transfer
+        if (header.command == PLDM_UPDATE_COMPONENT && !transferring)
+        {
+            transferring = true;
+            componentSize = readLE(payload, 9, 4);
+            offset = 0;
+            requestData();
+        }
+    }
+
+    void handleResponse(uint8_t command, std::span<const uint8_t> payload)
+    {
+        if (payload.empty() || payload[0] != PLDM_SUCCESS)
+        {
+            std::cerr << std::format(
+                "EID {} got completion code {} for command {:#x}\n", eid,
+                payload.empty() ? 0 : payload[0], command);
+            failed = true;
+            return;
+        }
+
+        switch (command)
+        {
+            case PLDM_REQUEST_FIRMWARE_DATA:
+                if (payload.size() - 1 != length)
+                {
+                    failed = true;
+                    return;
+                }
+                bytes += length;
+                chunks++;
+                if (inject(config.retryPermille))
+                {
+                    retries++;
+                }
+                else
+                {
+                    offset += length;
+                }
+                if (offset < componentSize)
+                {
+                    requestData();
+                }
+                else
+                {
+                    sendRequest(PLDM_TRANSFER_COMPLETE,
+                                {PLDM_FWUP_TRANSFER_SUCCESS});
+                }
+                break;
+            case PLDM_TRANSFER_COMPLETE:
+                sendRequest(PLDM_VERIFY_COMPLETE, {PLDM_FWUP_VERIFY_SUCCESS});
+                break;
+            case PLDM_VERIFY_COMPLETE:
+                // ComponentActivationMethodsModification
+                sendRequest(PLDM_APPLY_COMPLETE,
+                            {PLDM_FWUP_APPLY_SUCCESS, 0, 0});
+                break;
+            case PLDM_APPLY_COMPLETE:
+                transferring = false;
+                break;
+            default:
+                break;
+        }
+    }
+
+    /** @brief Request the next chunk of the component image */
+    void requestData()
+    {
+        uint32_t chunkSize = maxTransferSize;
+        if (config.chunkSize)
+        {
+            chunkSize = std::clamp<uint32_t>(
+                config.chunkSize, PLDM_FWUP_BASELINE_TRANSFER_SIZE,
+                std::max<uint32_t>(maxTransferSize,
+                                   PLDM_FWUP_BASELINE_TRANSFER_SIZE));
+        }
+        // The last chunk may be padded up to the baseline transfer size
+        length = std::min(chunkSize,
+                          std::max<uint32_t>(componentSize - offset,
+                                             PLDM_FWUP_BASELINE_TRANSFER_SIZE));
+        std::vector<uint8_t> payload;
+        appendLE(payload, offset, 4);
+        appendLE(payload, length, 4);
+        sendRequest(PLDM_REQUEST_FIRMWARE_DATA, payload);
+    }
+
+    mctp_eid_t eid;
+    const Config& config;
+    std::minstd_rand random;
+    uint8_t instanceId = 0;
+    uint32_t maxTransferSize = PLDM_FWUP_BASELINE_TRANSFER_SIZE;
+    uint32_t componentSize = 0;
+    uint32_t offset = 0;
+    uint32_t length = 0;
+    bool transferring = false;
+    bool activated = false;
+    bool failed = false;
+};
+
+/** @brief Peak RSS in KiB since the last reset, see resetPeakRSS() */
+uint64_t readPeakRSS()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.starts_with("VmHWM:"))
+        {
+            return std::strtoull(line.c_str() + 6, nullptr, 10);
+        }
+    }
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/** @brief Reset the peak RSS to the current RSS, on Linux 4.0 and later */
+void resetPeakRSS()
+{
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+std::chrono::microseconds cpuTime()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           std::chrono::microseconds(usage.ru_utime.tv_usec +
+                                     usage.ru_stime.tv_usec);
+}
+
+/** @brief Update the simulated FDs once
+ *
+ *  @return true if all the FDs activated their firmware
+ */
+bool runUpdate(const Config& config, const fs::path& packagePath,
+               InstanceIdDb& instanceIdDb)
+{
+    auto event = sdeventplus::Event::get_new();
+    PldmTransport transport{"loopback"};
+    requester::Handler<requester::Request> handler(&transport, event,
+                                                   instanceIdDb, false);
+
+    DescriptorMap descriptorMap;
+    ComponentInfoMap componentInfoMap;
+    NetworkMap networkMap;
+    std::vector<std::unique_ptr<SimulatedDevice>> devices;
+    auto& loopback = Loopback::get();
+    loopback.clear();
+    for (size_t i = 0; i < config.devices; i++)
+    {
+        mctp_eid_t eid = firstEid + i;
+        descriptorMap[eid].emplace(
+            PLDM_FWUP_UUID, DescriptorData(deviceUUID.begin(), deviceUUID.end()));
+        for (size_t comp = 0; comp < config.components; comp++)
+        {
+            CompKey key{compClassification,
+                        static_cast<CompIdentifier>(firstCompIdentifier + comp)};
+            componentInfoMap[eid][key] = comp;
+        }
+        networkMap[eid] = i % config.networks;
+        auto& device = devices.emplace_back(
+            std::make_unique<SimulatedDevice>(eid, config));
+        loopback.attach(eid, std::bind_front(&SimulatedDevice::receive,
+                                             device.get()));
+    }
+
+    UpdateManager updateManager(event, handler, instanceIdDb, descriptorMap,
+                                componentInfoMap, networkMap);
+    if (updateManager.processPackage(packagePath))
+    {
+        std::cerr << "Failed to process the benchmark package\n";
+        return false;
+    }
+
+    auto done = [&devices, &loopback]() {
+        return loopback.empty() &&
+               std::ranges::all_of(devices, &SimulatedDevice::isActivated);
+    };
+    auto failed = [&devices]() {
+        return std::ranges::any_of(devices, &SimulatedDevice::hasFailed);
+    };
+
+    // Dispatch the messages of the FDs as pldmd does
+    Response response;
+    sdeventplus::source::IO io(
+        event, transport.getEventSource(), EPOLLIN,
+        [&](sdeventplus::source::IO&, int, uint32_t) {
+            pldm_tid_t tid{};
+            void* msg = nullptr;
+            size_t len = 0;
+            while (transport.recvMsg(tid, msg, len) == PLDM_REQUESTER_SUCCESS)
+            {
+                auto pldmMsg = static_cast<const pldm_msg*>(msg);
+                pldm_header_info header{};
+                unpack_pldm_header(&pldmMsg->hdr, &header);
+                auto payloadLength = len - sizeof(pldm_msg_hdr);
+                if (header.msg_type != PLDM_RESPONSE)
+                {
+                    response = updateManager.handleRequest(
+                        tid, header.command, pldmMsg, payloadLength);
+                    transport.sendMsg(tid, response.data(), response.size());
+                }
+                else
+                {
+                    handler.handleResponse(tid, header.instance,
+                                           header.pldm_type, header.command,
+                                           pldmMsg, payloadLength);
+                }
+                free(msg);
+            }
+            if (failed())
+            {
+                event.exit(EXIT_FAILURE);
+            }
+            else if (done())
+            {
+                event.exit(EXIT_SUCCESS);
+            }
+        });
+    sdbusplus::Timer timeout(event.get(), [&event]() {
+        std::cerr << "Firmware update timed out\n";
+        event.exit(EXIT_FAILURE);
+    });
+    timeout.start(config.timeout);
+
+    resetPeakRSS();
+    auto allocated = allocations.load();
+    auto cpuStart = cpuTime();
+    auto start = std::chrono::steady_clock::now();
+    updateManager.activatePackage();
+    auto rc = event.loop();
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    auto cpu = cpuTime() - cpuStart;
+    auto allocs = allocations.load() - allocated;
+    auto peakRSS = readPeakRSS();
+    loopback.clear();
+
+    uint64_t bytes = 0;
+    uint64_t chunks = 0;
+    uint64_t retries = 0;
+    uint64_t drops = 0;
+    for (const auto& device : devices)
+    {
+        bytes += device->bytes;
+        chunks += device->chunks;
+        retries += device->retries;
+        drops += device->drops;
+    }
+    auto mib = static_cast<double>(bytes) / (1024 * 1024);
+    std::cout << std::format(
+        "{:>10} us {:>10.0f} KiB/s {:>8.0f} us CPU/MiB {:>8} KiB peak RSS "
+        "{:>10} allocs {:>8} chunks {:>6} retries {:>4} drops{}\n",
+        elapsed.count(),
+        elapsed.count() ? mib * 1024 * 1000000 / elapsed.count() : 0.0,
+        mib ? cpu.count() / mib : 0.0, peakRSS, allocs, chunks, retries, drops,
+        rc ? " FAILED" : "");
+    return !rc;
+}
+
+void usage()
+{
+    std::cerr
+        << "Usage: fw_update_benchmark [options]\n"
+           "  --devices N          simulated FDs, at most 240 (8)\n"
+           "  --components N       components per FD (1)\n"
+           "  --component-size N   bytes per component (1048576)\n"
+           "  --chunk-size N       bytes the FDs request, 0 for the\n"
+           "                       MaxTransferSize (0)\n"
+           "  --latency US         delay of the messages of the FDs (0)\n"
+           "  --drop N             requests the FDs do not answer, per\n"
+           "                       thousand (0)\n"
+           "  --retry N            chunks the FDs request again, per\n"
+           "                       thousand (0)\n"
+           "  --networks N         MCTP networks the FDs are spread on (1)\n"
+           "  --runs N             updates of the FDs (1)\n"
+           "  --seed N             seed of the injected failures (1)\n"
+           "  --timeout S          time limit of an update (600)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    static struct option options[] = {
+        {"devices", required_argument, nullptr, 'd'},
+        {"components", required_argument, nullptr, 'c'},
+        {"component-size", required_argument, nullptr, 's'},
+        {"chunk-size", required_argument, nullptr, 'k'},
+        {"latency", required_argument, nullptr, 'l'},
+        {"drop", required_argument, nullptr, 'D'},
+        {"retry", required_argument, nullptr, 'r'},
+        {"networks", required_argument, nullptr, 'n'},
+        {"runs", required_argument, nullptr, 'R'},
+        {"seed", required_argument, nullptr, 'S'},
+        {"timeout", required_argument, nullptr, 't'},
+        {nullptr, 0, nullptr, 0}};
+
+    Config config;
+    int option = 0;
+    while ((option = getopt_long(argc, argv, "", options, nullptr)) != -1)
+    {
+        auto value = optarg ? std::strtoul(optarg, nullptr, 10) : 0;
+        switch (option)
+        {
+            case 'd':
+                config.devices = value;
+                break;
+            case 'c':
+                config.components = value;
+                break;
+            case 's':
+                config.componentSize = value;
+                break;
+            case 'k':
+                config.chunkSize = value;
+                break;
+            case 'l':
+                config.latency = std::chrono::microseconds(value);
+                break;
+            case 'D':
+                config.dropPermille = value;
+                break;
+            case 'r':
+                config.retryPermille = value;
+                break;
+            case 'n':
+                config.networks = std::max<NetworkId>(value, 1);
+                break;
+            case 'R':
+                config.runs = value;
+                break;
+            case 'S':
+                config.seed = value;
+                break;
+            case 't':
+                config.timeout = std::chrono::seconds(value);
+                break;
+            default:
+                usage();
+                return EXIT_FAILURE;
+        }
+    }
+    if (!config.devices || config.devices > maxDevices ||
+        !config.components || config.components > 255 ||
+        !config.componentSize ||
+        // The component offsets are 32-bit in the package header
+        static_cast<uint64_t>(config.components) * config.componentSize >
+            UINT32_MAX - UINT16_MAX)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    char tmpl[] = "/tmp/fw_update_benchmark.XXXXXX";
+    if (!mkdtemp(tmpl))
+    {
+        std::cerr << "Failed to create the benchmark directory\n";
+        return EXIT_FAILURE;
+    }
+    fs::path dir(tmpl);
+    auto packagePath = dir / "package.bin";
+    writePackage(packagePath, config);
+
+    auto dbPath = dir / "instance_id_db";
+    std::ofstream(dbPath).close();
+    fs::resize_file(dbPath,
+                    static_cast<uintmax_t>(PLDM_MAX_TIDS) * maxInstanceIds);
+    InstanceIdDb instanceIdDb(dbPath);
+
+    std::cout << std::format(
+        "{} FDs, {} components of {} bytes, {} byte chunks, {} us latency, "
+        "{} drop and {} retry per thousand, {} networks\n",
+        config.devices, config.components, config.componentSize,
+        config.chunkSize ? std::to_string(config.chunkSize)
+                         : std::string("MaxTransferSize"),
+        config.latency.count(), config.dropPermille, config.retryPermille,
+        config.networks);
+
+    auto rc = EXIT_SUCCESS;
+    for (size_t run = 0; run < config.runs; run++)
+    {
+        if (!runUpdate(config, packagePath, instanceIdDb))
+        {
+            rc = EXIT_FAILURE;
+            break;
+        }
+    }
+
+    fs::remove_all(dir);
+    return rc;
+}
@@ -0,0 +1,482 @@
+#include "benchmarks/alloc_counter.hpp"
+#include "common/flight_recorder.hpp"
+#include "common/instance_id.hpp"
+#include "common/loopback.hpp"
+#include "common/transport.hpp"
+#include "host-bmc/host_pdr_handler.hpp"
+#include "requester/handler.hpp"
+
+#include <getopt.h>
+#include <libpldm/base.h>
+#include <libpldm/pdr.h>
+#include <libpldm/platform.h>
+#include <sys/resource.h>
+
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+/* Replays the host PDR exchange recorded in a pldmd flight recorder dump
+ * against HostPDRHandler, and reports the time of the exchange, its CPU
+ * time and its number of allocations. The time pldmd spent processing the
+ * PDRs and merging the entity associations, as marked in the dump, is
+ * reported alongside.
+ *
+ * A host simulated on the loopback network answers each GetPDR request
+ * with the response recorded for its record handle, after the latency
+ * recorded for it or the one given on the command line. Other requests of
+ * the BMC get an ERROR_UNSUPPORTED_PLDM_CMD completion code. The dump must
+ * hold whole GetPDR responses, record it with flightrecorder-max-entries
+ * above three times the number of host PDRs and flightrecorder-payload-size
+ * above the largest PDR. The host inventory is published on D-Bus, run the
+ * replay in a D-Bus session, as the unit tests.
+ */
+
+namespace fs = std::filesystem;
+using namespace pldm;
+using namespace pldm::flightrecorder;
+using pldm::transport::Loopback;
+
+namespace
+{
+
+/** @struct Config
+ *
+ *  Configuration of a replay
+ */
+struct Config
+{
+    /** @brief Delay of the responses of the host, the recorded latency of
+     *         each response if unset
+     */
+    std::optional<std::chrono::microseconds> latency;
+    size_t runs = 1;
+    std::chrono::seconds timeout{600};
+};
+
+/** @struct RecordedResponse
+ *
+ *  GetPDR response of the host, as recorded
+ */
+struct RecordedResponse
+{
+    std::vector<uint8_t> msg;
+    std::chrono::nanoseconds latency{};
+};
+
+/** @struct Trace
+ *
+ *  Host PDR exchange extracted from a flight recorder dump
+ */
+struct Trace
+{
+    mctp_eid_t eid = 0;
+    /** @brief GetPDR responses by record handle */
+    std::map<uint32_t, RecordedResponse> responses;
+    size_t truncated = 0;
+    size_t processed = 0;
+    std::chrono::nanoseconds processing{};
+    std::chrono::nanoseconds slowestProcessing{};
+    uint32_t slowestRecordHandle = 0;
+    size_t merges = 0;
+    std::chrono::nanoseconds merging{};
+};
+
+/** @brief Extract the GetPDR exchange of a dump and the marks about it */
+std::optional<Trace> readTrace(const fs::path& path)
+{
+    auto slots = readDump(path);
+    if (!slots)
+    {
+        return std::nullopt;
+    }
+
+    Trace trace;
+    // GetPDR requests waiting for their response, by EID and instance ID
+    std::map<std::pair<uint8_t, uint8_t>, std::pair<uint32_t, uint64_t>>
+        requests;
+    for (const auto& [slot, payload] : *slots)
+    {
+        if (slot.flags & flightRecorderMarkFlag)
+        {
+            if (payload.size() < sizeof(FlightRecorderMark))
+            {
+                continue;
+            }
+            FlightRecorderMark mark{};
+            std::memcpy(&mark, payload.data(), sizeof(mark));
+            std::chrono::nanoseconds duration(mark.duration);
+            if (mark.kind == static_cast<uint8_t>(MarkKind::hostPdrProcessed))
+            {
+                trace.processed++;
+                trace.processing += duration;
+                if (duration > trace.slowestProcessing)
+                {
+                    trace.slowestProcessing = duration;
+                    trace.slowestRecordHandle = mark.recordHandle;
+                }
+            }
+            else if (mark.kind == static_cast<uint8_t>(MarkKind::hostPdrMerge))
+            {
+                trace.merges++;
+                trace.merging += duration;
+            }
+            continue;
+        }
+
+        pldm_header_info header{};
+        if (payload.size() < sizeof(pldm_msg_hdr) ||
+            unpack_pldm_header(
+                reinterpret_cast<const pldm_msg_hdr*>(payload.data()),
+                &header) ||
+            header.pldm_type != PLDM_PLATFORM ||
+            header.command != PLDM_GET_PDR)
+        {
+            continue;
+        }
+
+        auto msg = reinterpret_cast<const pldm_msg*>(payload.data());
+        auto payloadLength = payload.size() - sizeof(pldm_msg_hdr);
+        if (slot.flags & flightRecorderTx)
+        {
+            uint32_t recordHandle{};
+            uint32_t dataTransferHandle{};
+            uint8_t transferOpFlag{};
+            uint16_t requestCount{};
+            uint16_t recordChangeNumber{};
+            if (header.msg_type == PLDM_REQUEST &&
+                !decode_get_pdr_req(msg, payloadLength, &recordHandle,
+                                    &dataTransferHandle, &transferOpFlag,
+                                    &requestCount, &recordChangeNumber))
+            {
+                requests[{slot.tid, header.instance}] = {recordHandle,
+                                                         slot.timestamp};
+            }
+            continue;
+        }
+
+        auto request = requests.find({slot.tid, header.instance});
+        if (header.msg_type != PLDM_RESPONSE || request == requests.end())
+        {
+            continue;
+        }
+        auto [recordHandle, timestamp] = request->second;
+        requests.erase(request);
+        if (slot.length > payload.size())
+        {
+            trace.truncated++;
+            continue;
+        }
+        trace.eid = slot.tid;
+        trace.responses[recordHandle] = {
+            payload, std::chrono::nanoseconds(slot.timestamp - timestamp)};
+    }
+    return trace;
+}
+
+/** @class SimulatedHost
+ *
+ *  Host answering the GetPDR requests of the BMC with the recorded
+ *  responses.
+ */
+class SimulatedHost
+{
+  public:
+    SimulatedHost(const Trace& trace, const Config& config) :
+        trace(trace), config(config)
+    {}
+
+    /** @brief Handle a message of the BMC */
+    void receive(std::span<const uint8_t> msg)
+    {
+        pldm_header_info header{};
+        if (msg.size() < sizeof(pldm_msg_hdr) ||
+            unpack_pldm_header(
+                reinterpret_cast<const pldm_msg_hdr*>(msg.data()), &header) ||
+            header.msg_type != PLDM_REQUEST)
+        {
+            return;
+        }
+
+        uint32_t recordHandle{};
+        uint32_t dataTransferHandle{};
+        uint8_t transferOpFlag{};
+        uint16_t requestCount{};
+        uint16_t recordChangeNumber{};
+        auto request = reinterpret_cast<const pldm_msg*>(msg.data());
+        if (header.pldm_type == PLDM_PLATFORM &&
+            header.command == PLDM_GET_PDR &&
+            !decode_get_pdr_req(request, msg.size() - sizeof(pldm_msg_hdr),
+                                &recordHandle, &dataTransferHandle,
+                                &transferOpFlag, &requestCount,
+                                &recordChangeNumber))
+        {
+            auto it = trace.responses.find(recordHandle);
+            if (it != trace.responses.end())
+            {
+                auto response = it->second.msg;
+                auto hdr = reinterpret_cast<pldm_msg_hdr*>(response.data());
+                hdr->instance_id = header.instance;
+                served++;
+                // The completion code and the next record handle follow the
+                // header, the last PDR has no next record handle
+                auto next = std::span(response).subspan(sizeof(pldm_msg_hdr));
+                if (next.size() < 5 || next[0] != PLDM_SUCCESS ||
+                    !(next[1] | next[2] | next[3] | next[4]))
+                {
+                    finished = true;
+                }
+                Loopback::get().send(
+                    trace.eid, std::move(response),
+                    config.latency
+                        ? *config.latency
+                        : std::chrono::duration_cast<std::chrono::microseconds>(
+                              it->second.latency));
+                return;
+            }
+            // The exchange fails on the record handle missing from the dump
+            missing++;
+            finished = true;
+        }
+
+        std::vector<uint8_t> response(sizeof(pldm_msg_hdr) + 1);
+        encode_cc_only_resp(header.instance, header.pldm_type, header.command,
+                            PLDM_ERROR_UNSUPPORTED_PLDM_CMD,
+                            reinterpret_cast<pldm_msg*>(response.data()));
+        Loopback::get().send(trace.eid, std::move(response),
+                             config.latency.value_or(
+                                 std::chrono::microseconds(0)));
+    }
+
+    /** @brief GetPDR requests answered with a recorded response */
+    size_t served = 0;
+
+    /** @brief GetPDR requests of a record handle missing from the dump */
+    size_t missing = 0;
+
+    /** @brief Whether the last PDR of the exchange was sent */
+    bool finished = false;
+
+  private:
+    const Trace& trace;
+    const Config& config;
+};
+
+std::chrono::microseconds cpuTime()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           std::chrono::microseconds(usage.ru_utime.tv_usec +
+                                     usage.ru_stime.tv_usec);
+}
+
+/** @brief Replay the PDR exchange once
+ *
+ *  @return true if the exchange completed
+ */
+bool runReplay(const Trace& trace, const Config& config,
+               InstanceIdDb& instanceIdDb)
+{
+    auto event = sdeventplus::Event::get_new();
+    PldmTransport transport{"loopback"};
+    requester::Handler<requester::Request> handler(&transport, event,
+                                                   instanceIdDb, false);
+
+    auto& loopback = Loopback::get();
+    loopback.clear();
+    SimulatedHost host(trace, config);
+    loopback.attach(trace.eid,
+                    std::bind_front(&SimulatedHost::receive, &host));
+
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> repo(
+        pldm_pdr_init(), pldm_pdr_destroy);
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        entityTree(pldm_entity_association_tree_init(),
+                   pldm_entity_association_tree_destroy);
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        bmcEntityTree(pldm_entity_association_tree_init(),
+                      pldm_entity_association_tree_destroy);
+    HostPDRHandler hostPDRHandler(
+        transport.getEventSource(), trace.eid, event, repo.get(), "",
+        entityTree.get(), bmcEntityTree.get(), instanceIdDb, &handler);
+
+    // Once the last PDR was processed, stop when the event loop has nothing
+    // else to do, the inventory objects are created from the event loop
+    std::unique_ptr<sdeventplus::source::Defer> idle;
+    sdeventplus::source::IO io(
+        event, transport.getEventSource(), EPOLLIN,
+        [&](sdeventplus::source::IO&, int, uint32_t) {
+            pldm_tid_t tid{};
+            void* msg = nullptr;
+            size_t len = 0;
+            while (transport.recvMsg(tid, msg, len) == PLDM_REQUESTER_SUCCESS)
+            {
+                auto pldmMsg = static_cast<const pldm_msg*>(msg);
+                pldm_header_info header{};
+                unpack_pldm_header(&pldmMsg->hdr, &header);
+                if (header.msg_type == PLDM_RESPONSE)
+                {
+                    handler.handleResponse(tid, header.instance,
+                                           header.pldm_type, header.command,
+                                           pldmMsg, len - sizeof(pldm_msg_hdr));
+                }
+                free(msg);
+            }
+            if (!idle && host.finished && loopback.empty())
+            {
+                idle = std::make_unique<sdeventplus::source::Defer>(
+                    event, [&event](sdeventplus::source::EventBase&) {
+                        event.exit(EXIT_SUCCESS);
+                    });
+                idle->set_priority(SD_EVENT_PRIORITY_IDLE);
+            }
+        });
+    sdbusplus::Timer timeout(event.get(), [&event]() {
+        std::cerr << "Host PDR exchange timed out\n";
+        event.exit(EXIT_FAILURE);
+    });
+    timeout.start(config.timeout);
+
+    auto allocated = allocations.load();
+    auto cpuStart = cpuTime();
+    auto start = std::chrono::steady_clock::now();
+    hostPDRHandler.fetchPDR({});
+    auto rc = event.loop();
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    auto cpu = cpuTime() - cpuStart;
+    auto allocs = allocations.load() - allocated;
+    loopback.clear();
+
+    std::cout << std::format(
+        "{:>10} us {:>10} us CPU {:>10} allocs {:>6} PDRs {:>6} repo "
+        "records {:>4} missing{}\n",
+        elapsed.count(), cpu.count(), allocs, host.served,
+        pldm_pdr_get_record_count(repo.get()), host.missing,
+        rc || host.missing ? " FAILED" : "");
+    return !rc && !host.missing;
+}
+
+void usage()
+{
+    std::cerr << "Usage: host_pdr_replay [options] dump\n"
+                 "  --latency US         delay of the responses of the host,\n"
+                 "                       the recorded one if not given\n"
+                 "  --runs N             replays of the exchange (1)\n"
+                 "  --timeout S          time limit of an exchange (600)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    static struct option options[] = {
+        {"latency", required_argument, nullptr, 'l'},
+        {"runs", required_argument, nullptr, 'R'},
+        {"timeout", required_argument, nullptr, 't'},
+        {nullptr, 0, nullptr, 0}};
+
+    Config config;
+    int option = 0;
+    while ((option = getopt_long(argc, argv, "", options, nullptr)) != -1)
+    {
+        auto value = optarg ? std::strtoul(optarg, nullptr, 10) : 0;
+        switch (option)
+        {
+            case 'l':
+                config.latency = std::chrono::microseconds(value);
+                break;
+            case 'R':
+                config.runs = value;
+                break;
+            case 't':
+                config.timeout = std::chrono::seconds(value);
+                break;
+            default:
+                usage();
+                return EXIT_FAILURE;
+        }
+    }
+    if (optind + 1 != argc)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    auto trace = readTrace(argv[optind]);
+    if (!trace)
+    {
+        std::cerr << argv[optind] << ": not a flight recorder dump of version "
+                  << flightRecorderVersion << "\n";
+        return EXIT_FAILURE;
+    }
+    if (!trace->responses.contains(0))
+    {
+        std::cerr << argv[optind]
+                  << ": the dump does not hold the start of a host PDR "
+                     "exchange, "
+                  << trace->truncated << " truncated GetPDR responses\n";
+        return EXIT_FAILURE;
+    }
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    std::cout << std::format(
+        "{} GetPDR responses from EID {}, {} truncated\n"
+        "recorded: {} PDRs processed in {} us, slowest record handle {} in "
+        "{} us, {} merges in {} us\n",
+        trace->responses.size(), trace->eid, trace->truncated,
+        trace->processed,
+        duration_cast<microseconds>(trace->processing).count(),
+        trace->slowestRecordHandle,
+        duration_cast<microseconds>(trace->slowestProcessing).count(),
+        trace->merges, duration_cast<microseconds>(trace->merging).count());
+
+    char tmpl[] = "/tmp/host_pdr_replay.XXXXXX";
+    if (!mkdtemp(tmpl))
+    {
+        std::cerr << "Failed to create the replay directory\n";
+        return EXIT_FAILURE;
+    }
+    fs::path dir(tmpl);
+    auto dbPath = dir / "instance_id_db";
+    std::ofstream(dbPath).close();
+    fs::resize_file(dbPath,
+                    static_cast<uintmax_t>(PLDM_MAX_TIDS) * maxInstanceIds);
+    InstanceIdDb instanceIdDb(dbPath);
+
+    auto rc = EXIT_SUCCESS;
+    for (size_t run = 0; run < config.runs; run++)
+    {
+        if (!runReplay(*trace, config, instanceIdDb))
+        {
+            rc = EXIT_FAILURE;
+            break;
+        }
+    }
+
+    fs::remove_all(dir);
+    return rc;
+}
@@ -0,0 +1,432 @@
+#include "benchmarks/alloc_counter.hpp"
+#include "common/bios_utils.hpp"
+#include "common/instance_id.hpp"
+#include "common/loopback.hpp"
+#include "common/transport.hpp"
+#include "common/utils.hpp"
+#include "invoker.hpp"
+#include "libpldmresponder/bios_config.hpp"
+#include "libpldmresponder/bios_table.hpp"
+#include "libpldmresponder/fru.hpp"
+#include "libpldmresponder/platform.hpp"
+#include "platform-mc/numeric_sensor.hpp"
+#include "requester/handler.hpp"
+
+#include <libpldm/base.h>
+#include <libpldm/bios.h>
+#include <libpldm/fru.h>
+#include <libpldm/pdr.h>
+#include <libpldm/platform.h>
+
+#include <nlohmann/json.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* Runs single operations of the hot paths of pldmd in a loop, and reports
+ * the time and the number of allocations per operation, at each scale given
+ * on the command line: the number of PDRs, FRU records and BIOS attributes
+ * of the tables the operations run against, and the number of operations of
+ * the other stages. The tables are built before the measured loop.
+ *
+ * The requester sends over the loopback transport backend to an endpoint
+ * dropping the requests, the responses are handed to the requester as the
+ * event loop of pldmd would. The numeric sensor publishes its readings on
+ * D-Bus, run the benchmark in a D-Bus session, as the unit tests.
+ */
+
+namespace fs = std::filesystem;
+using namespace pldm;
+using namespace pldm::responder;
+using pldm::transport::Loopback;
+using Json = nlohmann::json;
+
+namespace
+{
+
+constexpr auto fruJsonsDir = "../libpldmresponder/test/fru_jsons/good";
+constexpr auto fruMasterJson =
+    "../libpldmresponder/test/fru_jsons/fru_master/fru_master.json";
+
+/** @brief EID of the endpoint the requester sends to */
+constexpr mctp_eid_t benchmarkEid = 9;
+
+/** @brief D-Bus handler resolving every object to the same service */
+class BenchmarkDBusHandler : public pldm::utils::DBusHandler
+{
+  public:
+    std::string getService(const char* /*path*/,
+                           const char* /*interface*/) const override
+    {
+        return "xyz.openbmc_project.Benchmark";
+    }
+};
+
+/** @brief Handler of a PLDM type answering one command with its
+ *         completion code
+ */
+class BenchmarkCmdHandler : public CmdHandler
+{
+  public:
+    explicit BenchmarkCmdHandler(Command command)
+    {
+        handlers.emplace(
+            command, [](pldm_tid_t, const pldm_msg* request, size_t) {
+                return ccOnlyResponse(request, PLDM_SUCCESS);
+            });
+    }
+};
+
+/** @brief Run an operation ops times and report its time and its number of
+ *         allocations per operation
+ *
+ *  @param[in] name - name of the operation
+ *  @param[in] scale - size of the tables the operation runs against
+ *  @param[in] ops - number of operations
+ *  @param[in] op - the operation, called with its index
+ */
+template <typename Op>
+void runOps(std::string_view name, size_t scale, size_t ops, Op&& op)
+{
+    auto allocated = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ops; i++)
+    {
+        op(i);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    ops = std::max<size_t>(ops, 1);
+    std::cout << std::format(
+        "{:<22} {:>6} entities {:>12.1f} ns/op {:>8.2f} allocs/op\n", name,
+        scale, static_cast<double>(elapsed.count()) / ops,
+        static_cast<double>(allocations.load() - allocated) / ops);
+}
+
+/** @brief Inventory of a system with DIMMs on its motherboard */
+dbus::ObjectValueTree makeInventory(size_t scale)
+{
+    const std::string system = "/xyz/openbmc_project/inventory/system";
+    const std::string chassis = system + "/chassis";
+    const std::string motherboard = chassis + "/motherboard";
+    constexpr auto item = "xyz.openbmc_project.Inventory.Item";
+
+    dbus::ObjectValueTree objects;
+    objects[sdbusplus::message::object_path(system)] = {
+        {"xyz.openbmc_project.Inventory.Item.System", {}},
+        {item, {{"Present", true}}}};
+    objects[sdbusplus::message::object_path(chassis)] = {
+        {"xyz.openbmc_project.Inventory.Item.Chassis", {}},
+        {item, {{"Present", true}}}};
+    objects[sdbusplus::message::object_path(motherboard)] = {
+        {"xyz.openbmc_project.Inventory.Item.Board.Motherboard", {}},
+        {item, {{"Present", true}, {"PrettyName", std::string("Board")}}}};
+
+    for (size_t i = 0; i < scale; i++)
+    {
+        auto id = std::to_string(i);
+        objects[sdbusplus::message::object_path(motherboard + "/dimm" + id)] =
+            {{"xyz.openbmc_project.Inventory.Item.Dimm", {}},
+             {item, {{"Present", true}, {"PrettyName", "DIMM " + id}}},
+             {"xyz.openbmc_project.Inventory.Decorator.Asset",
+              {{"Model", std::string("DDR5")},
+               {"PartNumber", "PN" + id},
+               {"SerialNumber", "SN" + id},
+               {"Manufacturer", std::string("Benchmark")}}}};
+    }
+    return objects;
+}
+
+/** @brief State effecter PDR JSON with one effecter per entity */
+Json makeEffecterPDRs(size_t scale)
+{
+    Json entries = Json::array();
+    for (size_t i = 0; i < scale; i++)
+    {
+        entries.push_back(
+            {{"type", 33},
+             {"instance", i},
+             {"container", 0},
+             {"effecters",
+              {{{"set", {{"id", 196}, {"size", 1}, {"states", {1, 2}}}},
+                {"dbus",
+                 {{"path", std::format("/xyz/openbmc_project/bench{}", i)},
+                  {"interface", "xyz.openbmc_project.Benchmark"},
+                  {"property_name", "State"},
+                  {"property_type", "string"},
+                  {"property_values",
+                   {"xyz.openbmc_project.Benchmark.On",
+                    "xyz.openbmc_project.Benchmark.Off"}}}}}}}});
+    }
+    return {{"effecterPDRs", {{{"pdrType", 11}, {"entries", entries}}}}};
+}
+
+/** @brief BIOS attribute JSON with integer attributes */
+Json makeBIOSAttributes(size_t scale)
+{
+    Json entries = Json::array();
+    for (size_t i = 0; i < scale; i++)
+    {
+        auto name = std::format("attr{}", i);
+        entries.push_back({{"attribute_type", "integer"},
+                           {"attribute_name", name},
+                           {"read_only", false},
+                           {"help_text", name + " HelpText"},
+                           {"display_name", name + " DisplayName"},
+                           {"lower_bound", 0},
+                           {"upper_bound", 100},
+                           {"scalar_increment", 1},
+                           {"default_value", 0}});
+    }
+    return {{"entries", entries}};
+}
+
+/** @brief Pack the header of a SetStateEffecterStates request */
+void packRequestHeader(uint8_t instanceId, pldm_msg* msg)
+{
+    pldm_header_info header{};
+    header.msg_type = PLDM_REQUEST;
+    header.instance = instanceId;
+    header.pldm_type = PLDM_PLATFORM;
+    header.command = PLDM_SET_STATE_EFFECTER_STATES;
+    pack_pldm_header(&header, &msg->hdr);
+}
+
+/** @brief Register a request and match its response, per operation */
+void benchmarkRequester(size_t scale, InstanceIdDb& instanceIdDb)
+{
+    auto event = sdeventplus::Event::get_new();
+    PldmTransport transport{"loopback"};
+    requester::Handler<requester::Request> handler(&transport, event,
+                                                   instanceIdDb, false);
+    auto& loopback = Loopback::get();
+    loopback.clear();
+    loopback.attach(benchmarkEid, [](std::span<const uint8_t>) {});
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + 1> response{};
+    auto responseMsg = reinterpret_cast<pldm_msg*>(response.data());
+
+    size_t responses = 0;
+    runOps("requester", scale, scale, [&](size_t) {
+        auto instanceId = instanceIdDb.next(benchmarkEid);
+        RequestMsg request(sizeof(pldm_msg_hdr));
+        packRequestHeader(instanceId, request.msg());
+        handler.registerRequest(
+            benchmarkEid, instanceId, PLDM_PLATFORM,
+            PLDM_SET_STATE_EFFECTER_STATES, std::move(request),
+            [&responses](mctp_eid_t, const pldm_msg*, size_t) {
+                responses++;
+            });
+        handler.handleResponse(benchmarkEid, instanceId, PLDM_PLATFORM,
+                               PLDM_SET_STATE_EFFECTER_STATES, responseMsg,
+                               1);
+    });
+    loopback.clear();
+
+    if (responses != scale)
+    {
+        std::cerr << std::format("{} responses matched out of {}\n",
+                                 responses, scale);
+    }
+}
+
+/** @brief Dispatch a request to its command handler, per operation */
+void benchmarkInvoker(size_t scale)
+{
+    Invoker invoker;
+    invoker.registerHandler(
+        PLDM_PLATFORM,
+        std::make_unique<BenchmarkCmdHandler>(PLDM_SET_STATE_EFFECTER_STATES));
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr)> request{};
+    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+    packRequestHeader(0, requestMsg);
+
+    runOps("invoker", scale, scale, [&](size_t) {
+        invoker.handle(0, PLDM_PLATFORM, PLDM_SET_STATE_EFFECTER_STATES,
+                       requestMsg, 0);
+    });
+}
+
+/** @brief Walk the PDR repository with GetPDR, per record */
+void benchmarkGetPDR(size_t scale, const fs::path& dir)
+{
+    auto pdrDir = dir / "pdr";
+    fs::create_directories(pdrDir);
+    std::ofstream(pdrDir / "effecter_pdr.json") << makeEffecterPDRs(scale);
+
+    BenchmarkDBusHandler dbusHandler;
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo(
+        pldm_pdr_init(), pldm_pdr_destroy);
+    auto event = sdeventplus::Event::get_default();
+    platform::Handler handler(&dbusHandler, 0, nullptr, pdrDir, pdrRepo.get(),
+                              nullptr, nullptr, nullptr, nullptr, nullptr,
+                              event);
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
+        request{};
+    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+    auto getPDRReq = reinterpret_cast<pldm_get_pdr_req*>(requestMsg->payload);
+    getPDRReq->request_count = UINT16_MAX;
+
+    uint32_t recordHandle = 0;
+    runOps("getPDR", scale, pldm_pdr_get_record_count(pdrRepo.get()),
+           [&](size_t) {
+               getPDRReq->record_handle = recordHandle;
+               auto response =
+                   handler.getPDR(requestMsg, PLDM_GET_PDR_REQ_BYTES);
+               auto getPDRResp = reinterpret_cast<pldm_get_pdr_resp*>(
+                   reinterpret_cast<pldm_msg*>(response.data())->payload);
+               recordHandle = getPDRResp->next_record_handle;
+           });
+}
+
+/** @brief Get the FRU table and FRU records by option, per operation */
+void benchmarkFRU(size_t scale)
+{
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> repo(
+        pldm_pdr_init(), pldm_pdr_destroy);
+    using Tree =
+        std::unique_ptr<pldm_entity_association_tree,
+                        decltype(&pldm_entity_association_tree_destroy)>;
+    Tree entityTree(pldm_entity_association_tree_init(),
+                    pldm_entity_association_tree_destroy);
+    Tree bmcEntityTree(pldm_entity_association_tree_init(),
+                       pldm_entity_association_tree_destroy);
+
+    FruImpl impl(fruJsonsDir, fruMasterJson, repo.get(), entityTree.get(),
+                 bmcEntityTree.get());
+    impl.setInventoryObjects(makeInventory(scale));
+    impl.buildFRUTable();
+
+    constexpr size_t tableOps = 100;
+    runOps("getFRUTable", scale, tableOps, [&impl](size_t) {
+        Response response(sizeof(pldm_msg_hdr) +
+                          PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES);
+        impl.getFRUTable(response);
+    });
+
+    auto recordSets = std::max<uint16_t>(impl.numRSI(), 1);
+    runOps("getFRURecordByOption", scale, scale, [&](size_t i) {
+        std::vector<uint8_t> fruData;
+        impl.getFRURecordByOption(fruData, 0, 1 + i % recordSets,
+                                  PLDM_FRU_RECORD_TYPE_GENERAL, 0);
+    });
+}
+
+/** @brief Set the value of a BIOS attribute, per attribute */
+void benchmarkSetAttrValue(size_t scale, const fs::path& dir)
+{
+    auto jsonDir = dir / "bios";
+    auto tableDir = dir / "bios_tables";
+    fs::create_directories(jsonDir);
+    std::ofstream(jsonDir / "bios_attrs.json") << makeBIOSAttributes(scale);
+
+    BenchmarkDBusHandler dbusHandler;
+    bios::BIOSConfig biosConfig(jsonDir.c_str(), tableDir.c_str(),
+                                &dbusHandler, 0, 0, nullptr, nullptr, nullptr,
+                                []() {});
+
+    std::vector<uint16_t> attrHandles;
+    if (auto attrTable = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_TABLE))
+    {
+        for (auto entry :
+             pldm::bios::utils::BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(
+                 attrTable->data(), attrTable->size()))
+        {
+            attrHandles.emplace_back(
+                bios::table::attribute::decodeHeader(entry).attrHandle);
+        }
+    }
+
+    // Handle, type and value of an integer attribute value entry
+    std::array<uint8_t, sizeof(uint16_t) + 1 + sizeof(uint64_t)> entry{};
+    entry[2] = PLDM_BIOS_INTEGER;
+    runOps("setAttrValue", scale, attrHandles.size(), [&](size_t i) {
+        uint16_t handle = attrHandles[i];
+        uint64_t value = i % 100;
+        std::memcpy(entry.data(), &handle, sizeof(handle));
+        std::memcpy(entry.data() + 3, &value, sizeof(value));
+        biosConfig.setAttrValue(entry.data(), entry.size(), true, false,
+                                false);
+    });
+}
+
+/** @brief Publish a reading of a numeric sensor, per reading */
+void benchmarkNumericSensor(size_t scale)
+{
+    auto pdr = std::make_shared<pldm_compact_numeric_sensor_pdr>();
+    pdr->sensor_id = 1;
+    pdr->entity_type = PLDM_ENTITY_POWER_SUPPLY;
+    pdr->entity_instance = 1;
+    pdr->container_id = 1;
+    pdr->base_unit = PLDM_SENSOR_UNIT_DEGRESS_C;
+
+    std::string sensorName{"PLDM_Benchmark_Temp"};
+    std::string inventoryPath{
+        "/xyz/openbmc_project/inventory/Item/Board/PLDM_Benchmark"};
+    platform_mc::NumericSensor sensor(1, false, pdr, sensorName,
+                                      inventoryPath);
+
+    runOps("updateReading", scale, scale, [&sensor](size_t i) {
+        sensor.updateReading(true, true, static_cast<double>(i % 100));
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<size_t> scales;
+    for (int i = 1; i < argc; i++)
+    {
+        scales.push_back(std::strtoul(argv[i], nullptr, 10));
+    }
+    if (scales.empty())
+    {
+        scales = {1000, 10000};
+    }
+
+    char tmpl[] = "/tmp/hot_path_benchmark.XXXXXX";
+    if (!mkdtemp(tmpl))
+    {
+        std::cerr << "Failed to create the benchmark directory\n";
+        return EXIT_FAILURE;
+    }
+    fs::path dir(tmpl);
+
+    auto dbPath = dir / "instance_id_db";
+    std::ofstream(dbPath).close();
+    fs::resize_file(dbPath,
+                    static_cast<uintmax_t>(PLDM_MAX_TIDS) * maxInstanceIds);
+    InstanceIdDb instanceIdDb(dbPath);
+
+    for (auto scale : scales)
+    {
+        auto scaleDir = dir / std::to_string(scale);
+        benchmarkRequester(scale, instanceIdDb);
+        benchmarkInvoker(scale);
+        benchmarkGetPDR(scale, scaleDir);
+        benchmarkFRU(scale);
+        benchmarkSetAttrValue(scale, scaleDir);
+        benchmarkNumericSensor(scale);
+    }
+
+    fs::remove_all(dir);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,252 @@
+#include "benchmarks/alloc_counter.hpp"
+#include "common/utils.hpp"
+#include "libpldmresponder/bios_config.hpp"
+#include "libpldmresponder/fru.hpp"
+#include "libpldmresponder/pdr_utils.hpp"
+#include "libpldmresponder/platform.hpp"
+
+#include <libpldm/pdr.h>
+
+#include <nlohmann/json.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* Builds the FRU table, the PDRs and the BIOS tables from synthetic inputs
+ * of each scale given on the command line, and reports the time and the
+ * number of allocations of each stage.
+ *
+ * The stages run against a D-Bus handler resolving every service to the
+ * same name, the inputs hold no property to read from D-Bus. The BIOS
+ * attributes listen for pending attributes on the bus, run the benchmark
+ * in a D-Bus session, as the unit tests.
+ */
+
+namespace fs = std::filesystem;
+using namespace pldm::responder;
+using Json = nlohmann::json;
+
+namespace
+{
+
+constexpr auto fruJsonsDir = "../libpldmresponder/test/fru_jsons/good";
+constexpr auto fruMasterJson =
+    "../libpldmresponder/test/fru_jsons/fru_master/fru_master.json";
+
+/** @brief D-Bus handler resolving every object to the same service */
+class BenchmarkDBusHandler : public pldm::utils::DBusHandler
+{
+  public:
+    std::string getService(const char* /*path*/,
+                           const char* /*interface*/) const override
+    {
+        return "xyz.openbmc_project.Benchmark";
+    }
+};
+
+/** @brief Run a stage and report its time and its number of allocations */
+template <typename Stage>
+void runStage(std::string_view name, size_t scale, Stage&& stage)
+{
+    auto allocated = allocations.load();
+    auto start = std::chrono::steady_clock::now();
+    stage();
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << std::format("{:<6} {:>6} entities {:>10} us {:>10} allocs\n",
+                             name, scale, elapsed.count(),
+                             allocations.load() - allocated);
+}
+
+/** @brief Inventory of a system with DIMMs on its motherboard */
+dbus::ObjectValueTree makeInventory(size_t scale)
+{
+    const std::string system = "/xyz/openbmc_project/inventory/system";
+    const std::string chassis = system + "/chassis";
+    const std::string motherboard = chassis + "/motherboard";
+    constexpr auto item = "xyz.openbmc_project.Inventory.Item";
+
+    dbus::ObjectValueTree objects;
+    objects[sdbusplus::message::object_path(system)] = {
+        {"xyz.openbmc_project.Inventory.Item.System", {}},
+        {item, {{"Present", true}}}};
+    objects[sdbusplus::message::object_path(chassis)] = {
+        {"xyz.openbmc_project.Inventory.Item.Chassis", {}},
+        {item, {{"Present", true}}}};
+    objects[sdbusplus::message::object_path(motherboard)] = {
+        {"xyz.openbmc_project.Inventory.Item.Board.Motherboard", {}},
+        {item, {{"Present", true}, {"PrettyName", std::string("Board")}}}};
+
+    for (size_t i = 0; i < scale; i++)
+    {
+        auto id = std::to_string(i);
+        objects[sdbusplus::message::object_path(motherboard + "/dimm" + id)] =
+            {{"xyz.openbmc_project.Inventory.Item.Dimm", {}},
+             {item, {{"Present", true}, {"PrettyName", "DIMM " + id}}},
+             {"xyz.openbmc_project.Inventory.Decorator.Asset",
+              {{"Model", std::string("DDR5")},
+               {"PartNumber", "PN" + id},
+               {"SerialNumber", "SN" + id},
+               {"Manufacturer", std::string("Benchmark")}}}};
+    }
+    return objects;
+}
+
+/** @brief State effecter PDR JSON with one effecter per entity */
+Json makeEffecterPDRs(size_t scale)
+{
+    Json entries = Json::array();
+    for (size_t i = 0; i < scale; i++)
+    {
+        entries.push_back(
+            {{"type", 33},
+             {"instance", i},
+             {"container", 0},
+             {"effecters",
+              {{{"set", {{"id", 196}, {"size", 1}, {"states", {1, 2}}}},
+                {"dbus",
+                 {{"path", std::format("/xyz/openbmc_project/bench{}", i)},
+                  {"interface", "xyz.openbmc_project.Benchmark"},
+                  {"property_name", "State"},
+                  {"property_type", "string"},
+                  {"property_values",
+                   {"xyz.openbmc_project.Benchmark.On",
+                    "xyz.openbmc_project.Benchmark.Off"}}}}}}}});
+    }
+    return {{"effecterPDRs", {{{"pdrType", 11}, {"entries", entries}}}}};
+}
+
+/** @brief BIOS attribute JSON with enum, integer and string attributes */
+Json makeBIOSAttributes(size_t scale)
+{
+    Json entries = Json::array();
+    for (size_t i = 0; i < scale; i++)
+    {
+        auto name = std::format("attr{}", i);
+        Json entry{{"attribute_name", name},
+                   {"read_only", false},
+                   {"help_text", name + " HelpText"},
+                   {"display_name", name + " DisplayName"}};
+        switch (i % 3)
+        {
+            case 0:
+                entry["attribute_type"] = "enum";
+                entry["possible_values"] = {"On", "Off"};
+                entry["default_values"] = {"On"};
+                break;
+            case 1:
+                entry["attribute_type"] = "integer";
+                entry["lower_bound"] = 0;
+                entry["upper_bound"] = 100;
+                entry["scalar_increment"] = 1;
+                entry["default_value"] = 0;
+                break;
+            default:
+                entry["attribute_type"] = "string";
+                entry["string_type"] = "ASCII";
+                entry["minimum_string_length"] = 1;
+                entry["maximum_string_length"] = 32;
+                entry["default_string"] = "abc";
+                break;
+        }
+        entries.push_back(std::move(entry));
+    }
+    return {{"entries", entries}};
+}
+
+void benchmarkFRU(size_t scale)
+{
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> repo(
+        pldm_pdr_init(), pldm_pdr_destroy);
+    using Tree =
+        std::unique_ptr<pldm_entity_association_tree,
+                        decltype(&pldm_entity_association_tree_destroy)>;
+    Tree entityTree(pldm_entity_association_tree_init(),
+                    pldm_entity_association_tree_destroy);
+    Tree bmcEntityTree(pldm_entity_association_tree_init(),
+                       pldm_entity_association_tree_destroy);
+
+    FruImpl impl(fruJsonsDir, fruMasterJson, repo.get(), entityTree.get(),
+                 bmcEntityTree.get());
+    impl.setInventoryObjects(makeInventory(scale));
+    runStage("fru", scale, [&impl] { impl.buildFRUTable(); });
+}
+
+void benchmarkPDR(size_t scale, const fs::path& dir)
+{
+    auto pdrDir = dir / "pdr";
+    fs::create_directories(pdrDir);
+    std::ofstream(pdrDir / "effecter_pdr.json") << makeEffecterPDRs(scale);
+
+    BenchmarkDBusHandler dbusHandler;
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo(
+        pldm_pdr_init(), pldm_pdr_destroy);
+    auto event = sdeventplus::Event::get_default();
+    platform::Handler handler(&dbusHandler, 0, nullptr, pdrDir, pdrRepo.get(),
+                              nullptr, nullptr, nullptr, nullptr, nullptr,
+                              event, true);
+
+    pdr_utils::Repo repo(pdrRepo.get());
+    runStage("pdr", scale,
+             [&] { handler.generate(dbusHandler, {pdrDir}, repo); });
+}
+
+void benchmarkBIOS(size_t scale, const fs::path& dir)
+{
+    auto jsonDir = dir / "bios";
+    auto tableDir = dir / "bios_tables";
+    fs::create_directories(jsonDir);
+    std::ofstream(jsonDir / "bios_attrs.json") << makeBIOSAttributes(scale);
+
+    BenchmarkDBusHandler dbusHandler;
+    runStage("bios", scale, [&] {
+        bios::BIOSConfig biosConfig(jsonDir.c_str(), tableDir.c_str(),
+                                    &dbusHandler, 0, 0, nullptr, nullptr,
+                                    nullptr, []() {});
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<size_t> scales;
+    for (int i = 1; i < argc; i++)
+    {
+        scales.push_back(std::strtoul(argv[i], nullptr, 10));
+    }
+    if (scales.empty())
+    {
+        scales = {100, 1000, 10000};
+    }
+
+    char tmpl[] = "/tmp/pldm_benchmark.XXXXXX";
+    if (!mkdtemp(tmpl))
+    {
+        std::cerr << "Failed to create the benchmark directory\n";
+        return EXIT_FAILURE;
+    }
+    fs::path dir(tmpl);
+
+    for (auto scale : scales)
+    {
+        auto scaleDir = dir / std::to_string(scale);
+        benchmarkFRU(scale);
+        benchmarkPDR(scale, scaleDir);
+        benchmarkBIOS(scale, scaleDir);
+    }
+
+    fs::remove_all(dir);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,929 @@
+#include "benchmarks/alloc_counter.hpp"
+#include "common/instance_id.hpp"
+#include "common/loopback.hpp"
+#include "common/transport.hpp"
+#include "common/utils.hpp"
+#include "platform-mc/manager.hpp"
+#include "requester/handler.hpp"
+#include "requester/mctp_endpoint_discovery.hpp"
+
+#include <getopt.h>
+#include <libpldm/base.h>
+#include <libpldm/entity.h>
+#include <libpldm/fru.h>
+#include <libpldm/platform.h>
+#include <libpldm/utils.h>
+#include <sys/resource.h>
+
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/* Discovers simulated PLDM termini through platform_mc::Manager, then polls
+ * their sensors for a while, and reports the discovery time, the polling
+ * cycle time, the sensors read and the PropertiesChanged signals emitted
+ * per second, the CPU use, the RSS and the number of allocations.
+ *
+ * Each terminus answers on a loopback network in the process, with a
+ * configurable delay and jitter, and has a PDR repository of numeric
+ * sensors with their auxiliary names PDRs and of compact numeric sensors,
+ * and a FRU record table. The termini may send numeric sensor events,
+ * handled as pldmd does. The sensors and the inventory are published on
+ * D-Bus, run the benchmark in a D-Bus session, as the unit tests.
+ */
+
+namespace fs = std::filesystem;
+using namespace pldm;
+using pldm::transport::Loopback;
+
+namespace
+{
+
+/** @brief EIDs of the termini follow the one of the BMC */
+constexpr mctp_eid_t firstEid = BmcMctpEid + 1;
+constexpr size_t maxTermini = 254 - BmcMctpEid;
+
+constexpr ver32_t pldmVersion{0x00, 0xf0, 0xf0, 0xf1};
+
+/** @struct Config
+ *
+ *  Configuration of a benchmark run
+ */
+struct Config
+{
+    size_t termini = 8;
+    /** @brief Sensors per terminus, half numeric and half compact */
+    size_t sensors = 32;
+    /** @brief UpdateInterval of the numeric sensors */
+    float sensorInterval = 1;
+    /** @brief Delay of the messages the termini send */
+    std::chrono::microseconds latency{0};
+    /** @brief Random delay added to the latency, at most */
+    std::chrono::microseconds jitter{0};
+    /** @brief Sensor events sent per second by the whole farm */
+    unsigned eventRate = 0;
+    /** @brief Time the sensors are polled for once discovered */
+    std::chrono::seconds duration{10};
+    unsigned seed = 1;
+    std::chrono::seconds timeout{600};
+};
+
+void appendLE(std::vector<uint8_t>& buffer, uint32_t value, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; i++)
+    {
+        buffer.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void appendFloat(std::vector<uint8_t>& buffer, float value)
+{
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    appendLE(buffer, bits, sizeof(bits));
+}
+
+/** @brief Start a PDR, its length is set by finishPDR() */
+std::vector<uint8_t> startPDR(uint32_t recordHandle, uint8_t type)
+{
+    std::vector<uint8_t> pdr;
+    appendLE(pdr, recordHandle, 4);
+    pdr.push_back(1); // PDRHeaderVersion
+    pdr.push_back(type);
+    appendLE(pdr, 0, 2); // recordChangeNumber
+    appendLE(pdr, 0, 2); // dataLength
+    return pdr;
+}
+
+void finishPDR(std::vector<uint8_t>& pdr)
+{
+    auto length = pdr.size() - sizeof(pldm_pdr_hdr);
+    pdr[8] = static_cast<uint8_t>(length);
+    pdr[9] = static_cast<uint8_t>(length >> 8);
+}
+
+/** @brief Numeric sensor PDR with 8-bit readings and high thresholds */
+std::vector<uint8_t> makeNumericSensorPDR(uint32_t recordHandle,
+                                          uint16_t sensorId,
+                                          float updateInterval)
+{
+    auto pdr = startPDR(recordHandle, PLDM_NUMERIC_SENSOR_PDR);
+    appendLE(pdr, 0, 2); // PLDMTerminusHandle
+    appendLE(pdr, sensorId, 2);
+    appendLE(pdr, PLDM_ENTITY_POWER_SUPPLY, 2);
+    appendLE(pdr, sensorId, 2); // entityInstanceNumber
+    appendLE(pdr, 1, 2);        // containerID
+    pdr.push_back(PLDM_NO_INIT);
+    pdr.push_back(true); // sensorAuxiliaryNamesPDR
+    pdr.push_back(PLDM_SENSOR_UNIT_DEGRESS_C);
+    pdr.insert(pdr.end(), 8, 0); // unitModifier to auxOEMUnitHandle
+    pdr.push_back(true);         // isLinear
+    pdr.push_back(PLDM_SENSOR_DATA_SIZE_UINT8);
+    appendFloat(pdr, 1);     // resolution
+    appendFloat(pdr, 0);     // offset
+    appendLE(pdr, 0, 2);     // accuracy
+    pdr.push_back(0);        // plusTolerance
+    pdr.push_back(0);        // minusTolerance
+    pdr.push_back(0);        // hysteresis
+    pdr.push_back(0x03);     // supportedThresholds, warning and critical high
+    pdr.push_back(0);        // thresholdAndHysteresisVolatility
+    appendFloat(pdr, 0);     // stateTransitionInterval
+    appendFloat(pdr, updateInterval);
+    pdr.push_back(255);      // maxReadable
+    pdr.push_back(0);        // minReadable
+    pdr.push_back(PLDM_RANGE_FIELD_FORMAT_UINT8);
+    pdr.push_back(0);        // rangeFieldSupport
+    pdr.insert(pdr.end(), 3, 0); // nominalValue, normalMax, normalMin
+    pdr.push_back(90);           // warningHigh
+    pdr.push_back(0);            // warningLow
+    pdr.push_back(100);          // criticalHigh
+    pdr.insert(pdr.end(), 3, 0); // criticalLow, fatalHigh, fatalLow
+    finishPDR(pdr);
+    return pdr;
+}
+
+/** @brief Sensor auxiliary names PDR with one English name */
+std::vector<uint8_t> makeSensorAuxNamesPDR(uint32_t recordHandle,
+                                           uint16_t sensorId,
+                                           std::string_view name)
+{
+    auto pdr = startPDR(recordHandle, PLDM_SENSOR_AUXILIARY_NAMES_PDR);
+    appendLE(pdr, 0, 2); // PLDMTerminusHandle
+    appendLE(pdr, sensorId, 2);
+    pdr.push_back(1); // sensorCount
+    pdr.push_back(1); // nameStringCount
+    pdr.insert(pdr.end(), {'e', 'n', 0});
+    // UTF-16BE, null terminated
+    for (auto c : name)
+    {
+        pdr.push_back(0);
+        pdr.push_back(static_cast<uint8_t>(c));
+    }
+    pdr.insert(pdr.end(), {0, 0});
+    finishPDR(pdr);
+    return pdr;
+}
+
+/** @brief Compact numeric sensor PDR, named in the PDR */
+std::vector<uint8_t> makeCompactNumericSensorPDR(uint32_t recordHandle,
+                                                 uint16_t sensorId,
+                                                 std::string_view name)
+{
+    pldm_compact_numeric_sensor_pdr fixed{};
+    fixed.hdr.record_handle = recordHandle;
+    fixed.hdr.version = 1;
+    fixed.hdr.type = PLDM_COMPACT_NUMERIC_SENSOR_PDR;
+    fixed.sensor_id = sensorId;
+    fixed.entity_type = PLDM_ENTITY_POWER_SUPPLY;
+    fixed.entity_instance = sensorId;
+    fixed.container_id = 1;
+    fixed.sensor_name_length = name.size();
+    fixed.base_unit = PLDM_SENSOR_UNIT_DEGRESS_C;
+
+    // The fixed part ends with the first byte of the name
+    auto bytes = reinterpret_cast<const uint8_t*>(&fixed);
+    std::vector<uint8_t> pdr(bytes, bytes + sizeof(fixed) - sizeof(uint8_t));
+    pdr.insert(pdr.end(), name.begin(), name.end());
+    finishPDR(pdr);
+    return pdr;
+}
+
+/** @brief Response of the given payload length to a request */
+std::vector<uint8_t> makeResponse(size_t payloadLength)
+{
+    return std::vector<uint8_t>(sizeof(pldm_msg_hdr) + payloadLength);
+}
+
+/** @class SimulatedTerminus
+ *
+ *  PLDM terminus answering the discovery, the PDR and FRU table transfers
+ *  and the sensor reads of the BMC, and sending numeric sensor events.
+ */
+class SimulatedTerminus
+{
+  public:
+    SimulatedTerminus(mctp_eid_t eid, const Config& config) :
+        eid(eid), config(config), random(config.seed + eid)
+    {
+        uint32_t recordHandle = 1;
+        for (size_t i = 0; i < config.sensors; i++)
+        {
+            uint16_t sensorId = i + 1;
+            auto name = std::format("Sim_{}_Temp_{}", eid, sensorId);
+            if (i % 2)
+            {
+                pdrs.emplace_back(makeCompactNumericSensorPDR(
+                    recordHandle++, sensorId, name));
+                continue;
+            }
+            pdrs.emplace_back(makeNumericSensorPDR(recordHandle++, sensorId,
+                                                   config.sensorInterval));
+            pdrs.emplace_back(
+                makeSensorAuxNamesPDR(recordHandle++, sensorId, name));
+        }
+
+        std::vector<uint8_t> tlvs;
+        auto addField = [&tlvs](uint8_t type, std::string_view value) {
+            tlvs.push_back(type);
+            tlvs.push_back(value.size());
+            tlvs.insert(tlvs.end(), value.begin(), value.end());
+        };
+        addField(PLDM_FRU_FIELD_TYPE_MODEL, "SimulatedTerminus");
+        addField(PLDM_FRU_FIELD_TYPE_PN, std::format("PN{}", eid));
+        addField(PLDM_FRU_FIELD_TYPE_SN, std::format("SN{}", eid));
+        addField(PLDM_FRU_FIELD_TYPE_MANUFAC, "Benchmark");
+        fruTable.resize(sizeof(pldm_fru_record_data_format) + tlvs.size());
+        size_t fruTableSize = 0;
+        encode_fru_record(fruTable.data(), fruTable.size(), &fruTableSize, 1,
+                          PLDM_FRU_RECORD_TYPE_GENERAL, 4,
+                          PLDM_FRU_ENCODING_ASCII, tlvs.data(), tlvs.size());
+        fruTable.resize(fruTableSize);
+    }
+
+    /** @brief Handle a message of the BMC */
+    void receive(std::span<const uint8_t> msg)
+    {
+        pldm_header_info header{};
+        if (msg.size() < sizeof(pldm_msg_hdr) ||
+            unpack_pldm_header(
+                reinterpret_cast<const pldm_msg_hdr*>(msg.data()), &header))
+        {
+            return;
+        }
+        // The BMC acknowledges the events, nothing to do
+        if (header.msg_type == PLDM_RESPONSE)
+        {
+            return;
+        }
+
+        auto request = reinterpret_cast<const pldm_msg*>(msg.data());
+        auto response =
+            handleRequest(header, request, msg.size() - sizeof(pldm_msg_hdr));
+        if (response.empty())
+        {
+            response = makeResponse(1);
+            auto responseMsg = reinterpret_cast<pldm_msg*>(response.data());
+            encode_cc_only_resp(header.instance, header.pldm_type,
+                                header.command, PLDM_ERROR_UNSUPPORTED_PLDM_CMD,
+                                responseMsg);
+        }
+        Loopback::get().send(eid, std::move(response), delay());
+    }
+
+    /** @brief Send a numeric sensor event of one of the sensors */
+    void sendSensorEvent()
+    {
+        if (tid == PLDM_TID_UNASSIGNED || !config.sensors)
+        {
+            return;
+        }
+
+        uint16_t sensorId =
+            std::uniform_int_distribution<uint16_t>(1, config.sensors)(random);
+        std::array<uint8_t, 7> eventData{
+            static_cast<uint8_t>(sensorId),
+            static_cast<uint8_t>(sensorId >> 8),
+            PLDM_NUMERIC_SENSOR_STATE,
+            PLDM_SENSOR_NORMAL, // eventState
+            PLDM_SENSOR_NORMAL, // previousEventState
+            PLDM_SENSOR_DATA_SIZE_UINT8,
+            reading()};
+
+        instanceId = (instanceId + 1) % maxInstanceIds;
+        auto payloadLength =
+            PLDM_PLATFORM_EVENT_MESSAGE_MIN_REQ_BYTES + eventData.size();
+        std::vector<uint8_t> msg(sizeof(pldm_msg_hdr) + payloadLength);
+        encode_platform_event_message_req(
+            instanceId, 1, tid, PLDM_SENSOR_EVENT, eventData.data(),
+            eventData.size(), reinterpret_cast<pldm_msg*>(msg.data()),
+            payloadLength);
+        Loopback::get().send(eid, std::move(msg), delay());
+    }
+
+  private:
+    std::chrono::microseconds delay()
+    {
+        if (!config.jitter.count())
+        {
+            return config.latency;
+        }
+        return config.latency +
+               std::chrono::microseconds(
+                   std::uniform_int_distribution<int64_t>(
+                       0, config.jitter.count())(random));
+    }
+
+    uint8_t reading()
+    {
+        return std::uniform_int_distribution<unsigned>(20, 80)(random);
+    }
+
+    std::vector<uint8_t> handleRequest(const pldm_header_info& header,
+                                       const pldm_msg* request,
+                                       size_t payloadLength)
+    {
+        auto id = header.instance;
+        switch (header.pldm_type)
+        {
+            case PLDM_BASE:
+                return handleBaseRequest(id, header.command, request,
+                                         payloadLength);
+            case PLDM_PLATFORM:
+                return handlePlatformRequest(id, header.command, request,
+                                             payloadLength);
+            case PLDM_FRU:
+                return handleFruRequest(id, header.command, request,
+                                        payloadLength);
+            default:
+                return {};
+        }
+    }
+
+    std::vector<uint8_t> handleBaseRequest(uint8_t id, uint8_t command,
+                                           const pldm_msg* request,
+                                           size_t payloadLength)
+    {
+        switch (command)
+        {
+            case PLDM_GET_TID:
+            {
+                auto response = makeResponse(PLDM_GET_TID_RESP_BYTES);
+                encode_get_tid_resp(id, PLDM_SUCCESS, tid,
+                                    reinterpret_cast<pldm_msg*>(
+                                        response.data()));
+                return response;
+            }
+            case PLDM_SET_TID:
+            {
+                if (!payloadLength)
+                {
+                    return {};
+                }
+                tid = request->payload[0];
+                auto response = makeResponse(1);
+                encode_cc_only_resp(id, PLDM_BASE, PLDM_SET_TID, PLDM_SUCCESS,
+                                    reinterpret_cast<pldm_msg*>(
+                                        response.data()));
+                return response;
+            }
+            case PLDM_GET_PLDM_TYPES:
+            {
+                std::array<bitfield8_t, 8> types{};
+                types[0].byte = 1 << PLDM_BASE | 1 << PLDM_PLATFORM |
+                                1 << PLDM_FRU;
+                auto response = makeResponse(PLDM_GET_TYPES_RESP_BYTES);
+                encode_get_types_resp(id, PLDM_SUCCESS, types.data(),
+                                      reinterpret_cast<pldm_msg*>(
+                                          response.data()));
+                return response;
+            }
+            case PLDM_GET_PLDM_VERSION:
+            {
+                auto response = makeResponse(PLDM_GET_VERSION_RESP_BYTES);
+                encode_get_version_resp(
+                    id, PLDM_SUCCESS, 0, PLDM_START_AND_END, &pldmVersion,
+                    sizeof(pldmVersion),
+                    reinterpret_cast<pldm_msg*>(response.data()));
+                return response;
+            }
+            case PLDM_GET_PLDM_COMMANDS:
+            {
+                uint8_t type = 0;
+                ver32_t version{};
+                if (decode_get_commands_req(request, payloadLength, &type,
+                                            &version))
+                {
+                    return {};
+                }
+                auto commands = supportedCommands(type);
+                std::array<bitfield8_t, 32> cmds{};
+                for (auto cmd : commands)
+                {
+                    cmds[cmd / 8].byte |= 1 << (cmd % 8);
+                }
+                auto response = makeResponse(PLDM_GET_COMMANDS_RESP_BYTES);
+                encode_get_commands_resp(id, PLDM_SUCCESS, cmds.data(),
+                                         reinterpret_cast<pldm_msg*>(
+                                             response.data()));
+                return response;
+            }
+            default:
+                return {};
+        }
+    }
+
+    std::vector<uint8_t> handlePlatformRequest(uint8_t id, uint8_t command,
+                                               const pldm_msg* request,
+                                               size_t payloadLength)
+    {
+        switch (command)
+        {
+            case PLDM_GET_PDR:
+                return getPDR(id, request, payloadLength);
+            case PLDM_GET_SENSOR_READING:
+            {
+                uint16_t sensorId = 0;
+                bool8_t rearm = 0;
+                if (decode_get_sensor_reading_req(request, payloadLength,
+                                                  &sensorId, &rearm))
+                {
+                    return {};
+                }
+                auto value = reading();
+                auto response =
+                    makeResponse(PLDM_GET_SENSOR_READING_MIN_RESP_BYTES);
+                encode_get_sensor_reading_resp(
+                    id, PLDM_SUCCESS, PLDM_SENSOR_DATA_SIZE_UINT8,
+                    PLDM_SENSOR_ENABLED, PLDM_NO_EVENT_GENERATION,
+                    PLDM_SENSOR_NORMAL, PLDM_SENSOR_NORMAL, PLDM_SENSOR_NORMAL,
+                    &value, reinterpret_cast<pldm_msg*>(response.data()),
+                    PLDM_GET_SENSOR_READING_MIN_RESP_BYTES);
+                return response;
+            }
+            case PLDM_SET_EVENT_RECEIVER:
+            {
+                auto response = makeResponse(1);
+                encode_cc_only_resp(id, PLDM_PLATFORM, command, PLDM_SUCCESS,
+                                    reinterpret_cast<pldm_msg*>(
+                                        response.data()));
+                return response;
+            }
+            default:
+                return {};
+        }
+    }
+
+    /** @brief GetPDR, records larger than the request count are sent in
+     *         parts
+     */
+    std::vector<uint8_t> getPDR(uint8_t id, const pldm_msg* request,
+                                size_t payloadLength)
+    {
+        uint32_t recordHandle = 0;
+        uint32_t dataTransferHandle = 0;
+        uint8_t transferOpFlag = 0;
+        uint16_t requestCount = 0;
+        uint16_t recordChangeNumber = 0;
+        if (decode_get_pdr_req(request, payloadLength, &recordHandle,
+                               &dataTransferHandle, &transferOpFlag,
+                               &requestCount, &recordChangeNumber))
+        {
+            return {};
+        }
+
+        // Handle 0 is the first record
+        size_t index = recordHandle ? recordHandle - 1 : 0;
+        if (index >= pdrs.size())
+        {
+            auto response = makeResponse(1);
+            encode_cc_only_resp(id, PLDM_PLATFORM, PLDM_GET_PDR,
+                                PLDM_PLATFORM_INVALID_RECORD_HANDLE,
+                                reinterpret_cast<pldm_msg*>(response.data()));
+            return response;
+        }
+
+        const auto& record = pdrs[index];
+        size_t offset =
+            transferOpFlag == PLDM_GET_FIRSTPART ? 0 : dataTransferHandle;
+        offset = std::min(offset, record.size());
+        size_t count = std::min<size_t>(requestCount, record.size() - offset);
+        bool last = offset + count == record.size();
+        uint8_t transferFlag = 0;
+        if (!offset)
+        {
+            transferFlag = last ? PLDM_START_AND_END : PLDM_START;
+        }
+        else
+        {
+            transferFlag = last ? PLDM_END : PLDM_MIDDLE;
+        }
+        uint8_t crc = transferFlag == PLDM_END
+                          ? crc8(record.data(), record.size())
+                          : 0;
+
+        auto response = makeResponse(PLDM_GET_PDR_MIN_RESP_BYTES + count +
+                                     (transferFlag == PLDM_END ? 1 : 0));
+        encode_get_pdr_resp(
+            id, PLDM_SUCCESS, index + 1 < pdrs.size() ? index + 2 : 0,
+            last ? 0 : offset + count, transferFlag, count,
+            record.data() + offset, crc,
+            reinterpret_cast<pldm_msg*>(response.data()));
+        return response;
+    }
+
+    std::vector<uint8_t> handleFruRequest(uint8_t id, uint8_t command,
+                                          const pldm_msg*, size_t)
+    {
+        switch (command)
+        {
+            case PLDM_GET_FRU_RECORD_TABLE_METADATA:
+            {
+                auto response =
+                    makeResponse(PLDM_GET_FRU_RECORD_TABLE_METADATA_RESP_BYTES);
+                encode_get_fru_record_table_metadata_resp(
+                    id, PLDM_SUCCESS, 1, 0, UINT32_MAX, fruTable.size(), 1, 1,
+                    crc32(fruTable.data(), fruTable.size()),
+                    reinterpret_cast<pldm_msg*>(response.data()));
+                return response;
+            }
+            case PLDM_GET_FRU_RECORD_TABLE:
+            {
+                auto response = makeResponse(
+                    PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES + fruTable.size());
+                encode_get_fru_record_table_resp(
+                    id, PLDM_SUCCESS, 0, PLDM_START_AND_END,
+                    reinterpret_cast<pldm_msg*>(response.data()));
+                std::ranges::copy(fruTable,
+                                  response.begin() + sizeof(pldm_msg_hdr) +
+                                      PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES);
+                return response;
+            }
+            default:
+                return {};
+        }
+    }
+
+    static std::vector<uint8_t> supportedCommands(uint8_t type)
+    {
+        switch (type)
+        {
+            case PLDM_BASE:
+                return {PLDM_GET_TID, PLDM_SET_TID, PLDM_GET_PLDM_VERSION,
+                        PLDM_GET_PLDM_TYPES, PLDM_GET_PLDM_COMMANDS};
+            case PLDM_PLATFORM:
+                return {PLDM_GET_PDR, PLDM_GET_SENSOR_READING,
+                        PLDM_SET_EVENT_RECEIVER};
+            case PLDM_FRU:
+                return {PLDM_GET_FRU_RECORD_TABLE_METADATA,
+                        PLDM_GET_FRU_RECORD_TABLE};
+            default:
+                return {};
+        }
+    }
+
+    mctp_eid_t eid;
+    const Config& config;
+    std::minstd_rand random;
+    pldm_tid_t tid = PLDM_TID_UNASSIGNED;
+    uint8_t instanceId = 0;
+    std::vector<std::vector<uint8_t>> pdrs;
+    std::vector<uint8_t> fruTable;
+};
+
+/** @brief Value in KiB of a line of /proc/self/status */
+uint64_t readStatusKiB(std::string_view key)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.starts_with(key))
+        {
+            return std::strtoull(line.c_str() + key.size(), nullptr, 10);
+        }
+    }
+    return 0;
+}
+
+std::chrono::microseconds cpuTime()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           std::chrono::microseconds(usage.ru_utime.tv_usec +
+                                     usage.ru_stime.tv_usec);
+}
+
+/** @struct PollTotals
+ *
+ *  Sensor polling of all the termini so far
+ */
+struct PollTotals
+{
+    uint64_t cycles = 0;
+    uint64_t sensorsRead = 0;
+    uint64_t totalCycleUs = 0;
+    uint64_t maxCycleUs = 0;
+};
+
+PollTotals pollTotals(const platform_mc::Manager& manager)
+{
+    PollTotals totals;
+    for (const auto& [tid, stats] : manager.getSensorPollStats())
+    {
+        totals.cycles += stats.cycles;
+        totals.sensorsRead += stats.sensorsRead;
+        totals.totalCycleUs += stats.totalCycleUs;
+        totals.maxCycleUs = std::max(totals.maxCycleUs, stats.maxCycleUs);
+    }
+    return totals;
+}
+
+/** @brief Discover the simulated termini and poll their sensors
+ *
+ *  @return true if all the termini were discovered
+ */
+bool runFarm(const Config& config, InstanceIdDb& instanceIdDb)
+{
+    auto event = sdeventplus::Event::get_default();
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
+
+    PldmTransport transport{"loopback"};
+    requester::Handler<requester::Request> handler(&transport, event,
+                                                   instanceIdDb, false);
+    platform_mc::Manager manager(event, handler, instanceIdDb);
+
+    std::vector<std::unique_ptr<SimulatedTerminus>> termini;
+    MctpInfos mctpInfos;
+    auto& loopback = Loopback::get();
+    loopback.clear();
+    for (size_t i = 0; i < config.termini; i++)
+    {
+        mctp_eid_t eid = firstEid + i;
+        auto& terminus = termini.emplace_back(
+            std::make_unique<SimulatedTerminus>(eid, config));
+        loopback.attach(eid, std::bind_front(&SimulatedTerminus::receive,
+                                             terminus.get()));
+        mctpInfos.emplace_back(eid, emptyUUID, "", 0);
+    }
+
+    // Count the PropertiesChanged signals of the sensors and the inventory
+    uint64_t signals = 0;
+    sdbusplus::bus::match_t signalMatch(
+        bus,
+        "type='signal',interface='org.freedesktop.DBus.Properties',"
+        "member='PropertiesChanged',sender='" +
+            bus.get_unique_name() + "'",
+        [&signals](sdbusplus::message_t&) { signals++; });
+
+    // Dispatch the messages of the termini as pldmd does
+    uint64_t eventsHandled = 0;
+    sdeventplus::source::IO io(
+        event, transport.getEventSource(), EPOLLIN,
+        [&](sdeventplus::source::IO&, int, uint32_t) {
+            pldm_tid_t tid{};
+            void* msg = nullptr;
+            size_t len = 0;
+            while (transport.recvMsg(tid, msg, len) == PLDM_REQUESTER_SUCCESS)
+            {
+                auto pldmMsg = static_cast<const pldm_msg*>(msg);
+                pldm_header_info header{};
+                unpack_pldm_header(&pldmMsg->hdr, &header);
+                auto payloadLength = len - sizeof(pldm_msg_hdr);
+                if (header.msg_type == PLDM_RESPONSE)
+                {
+                    handler.handleResponse(tid, header.instance,
+                                           header.pldm_type, header.command,
+                                           pldmMsg, payloadLength);
+                }
+                else if (header.pldm_type == PLDM_PLATFORM &&
+                         header.command == PLDM_PLATFORM_EVENT_MESSAGE)
+                {
+                    uint8_t formatVersion{};
+                    uint8_t eventTid{};
+                    uint8_t eventClass{};
+                    size_t offset{};
+                    auto rc = decode_platform_event_message_req(
+                        pldmMsg, payloadLength, &formatVersion, &eventTid,
+                        &eventClass, &offset);
+                    if (rc == PLDM_SUCCESS && eventClass == PLDM_SENSOR_EVENT)
+                    {
+                        rc = manager.handleSensorEvent(pldmMsg, payloadLength,
+                                                       formatVersion, eventTid,
+                                                       offset);
+                        eventsHandled++;
+                    }
+                    auto response =
+                        makeResponse(PLDM_PLATFORM_EVENT_MESSAGE_RESP_BYTES);
+                    encode_platform_event_message_resp(
+                        header.instance, rc, PLDM_EVENT_NO_LOGGING,
+                        reinterpret_cast<pldm_msg*>(response.data()));
+                    transport.sendMsg(tid, response.data(), response.size());
+                }
+                free(msg);
+            }
+        });
+
+    // Round robin over the termini, at the rate of the farm
+    size_t nextEventTerminus = 0;
+    sdbusplus::Timer eventTimer(event.get(), [&]() {
+        termini[nextEventTerminus]->sendSensorEvent();
+        nextEventTerminus = (nextEventTerminus + 1) % termini.size();
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    auto allocated = allocations.load();
+    std::chrono::microseconds discovery{0};
+    PollTotals pollStart;
+    uint64_t signalsStart = 0;
+    std::chrono::microseconds cpuStart{0};
+    std::chrono::steady_clock::time_point windowStart;
+    bool discovered = false;
+
+    sdbusplus::Timer windowTimer(event.get(), [&event]() {
+        event.exit(EXIT_SUCCESS);
+    });
+    sdbusplus::Timer progressTimer(event.get(), [&]() {
+        if (discovered)
+        {
+            return;
+        }
+        size_t initialized = 0;
+        for (const auto& [tid, terminus] : manager.getTermini())
+        {
+            initialized += terminus && terminus->initialized;
+        }
+        if (initialized < config.termini)
+        {
+            return;
+        }
+
+        discovered = true;
+        windowStart = std::chrono::steady_clock::now();
+        discovery = std::chrono::duration_cast<std::chrono::microseconds>(
+            windowStart - start);
+        pollStart = pollTotals(manager);
+        signalsStart = signals;
+        cpuStart = cpuTime();
+        windowTimer.start(config.duration);
+        if (config.eventRate)
+        {
+            eventTimer.start(std::chrono::microseconds(std::max<uint64_t>(
+                                 1000000 / config.eventRate, 1)),
+                             true);
+        }
+    });
+    progressTimer.start(std::chrono::milliseconds(10), true);
+
+    sdbusplus::Timer timeout(event.get(), [&event]() {
+        std::cerr << "Terminus discovery timed out\n";
+        event.exit(EXIT_FAILURE);
+    });
+    timeout.start(config.timeout);
+
+    manager.handleMctpEndpoints(mctpInfos);
+    auto rc = event.loop();
+    auto elapsed = std::chrono::steady_clock::now() - windowStart;
+    auto allocs = allocations.load() - allocated;
+
+    if (rc || !discovered)
+    {
+        loopback.clear();
+        std::cout << "FAILED\n";
+        return false;
+    }
+
+    auto seconds = std::chrono::duration<double>(elapsed).count();
+    auto cpu = cpuTime() - cpuStart;
+    auto polled = pollTotals(manager);
+    auto cycles = polled.cycles - pollStart.cycles;
+    auto cycleUs = polled.totalCycleUs - pollStart.totalCycleUs;
+    auto sensorsRead = polled.sensorsRead - pollStart.sensorsRead;
+    auto rss = readStatusKiB("VmRSS:");
+    auto peakRSS = readStatusKiB("VmHWM:");
+    size_t sensors = 0;
+    for (const auto& [tid, terminus] : manager.getTermini())
+    {
+        sensors += terminus->numericSensors.size();
+    }
+    loopback.clear();
+
+    std::cout << std::format(
+        "{:>10} us discovery {:>6} sensors {:>8.0f} us avg {:>8} us max "
+        "poll cycle {:>8.0f} sensors/s {:>8.0f} signals/s {:>6.0f} events/s "
+        "{:>5.1f}% CPU {:>8} KiB RSS {:>8} KiB peak RSS {:>10} allocs\n",
+        discovery.count(), sensors,
+        cycles ? static_cast<double>(cycleUs) / cycles : 0.0,
+        polled.maxCycleUs, sensorsRead / seconds,
+        (signals - signalsStart) / seconds, eventsHandled / seconds,
+        std::chrono::duration<double>(cpu).count() * 100 / seconds, rss,
+        peakRSS, allocs);
+    return true;
+}
+
+void usage()
+{
+    std::cerr
+        << "Usage: terminus_farm_benchmark [options]\n"
+           "  --termini N          simulated termini, at most 246 (8)\n"
+           "  --sensors N          sensors per terminus, half numeric and\n"
+           "                       half compact numeric (32)\n"
+           "  --sensor-interval MS UpdateInterval of the numeric sensors\n"
+           "                       (1000)\n"
+           "  --latency US         delay of the messages of the termini (0)\n"
+           "  --jitter US          random delay added to the latency, at\n"
+           "                       most (0)\n"
+           "  --event-rate N       sensor events per second of the farm (0)\n"
+           "  --duration S         time the sensors are polled for (10)\n"
+           "  --seed N             seed of the readings and the jitter (1)\n"
+           "  --timeout S          time limit of the discovery (600)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    static struct option options[] = {
+        {"termini", required_argument, nullptr, 't'},
+        {"sensors", required_argument, nullptr, 's'},
+        {"sensor-interval", required_argument, nullptr, 'i'},
+        {"latency", required_argument, nullptr, 'l'},
+        {"jitter", required_argument, nullptr, 'j'},
+        {"event-rate", required_argument, nullptr, 'e'},
+        {"duration", required_argument, nullptr, 'd'},
+        {"seed", required_argument, nullptr, 'S'},
+        {"timeout", required_argument, nullptr, 'T'},
+        {nullptr, 0, nullptr, 0}};
+
+    Config config;
+    int option = 0;
+    while ((option = getopt_long(argc, argv, "", options, nullptr)) != -1)
+    {
+        auto value = optarg ? std::strtoul(optarg, nullptr, 10) : 0;
+        switch (option)
+        {
+            case 't':
+                config.termini = value;
+                break;
+            case 's':
+                config.sensors = value;
+                break;
+            case 'i':
+                config.sensorInterval = static_cast<float>(value) / 1000;
+                break;
+            case 'l':
+                config.latency = std::chrono::microseconds(value);
+                break;
+            case 'j':
+                config.jitter = std::chrono::microseconds(value);
+                break;
+            case 'e':
+                config.eventRate = value;
+                break;
+            case 'd':
+                config.duration = std::chrono::seconds(value);
+                break;
+            case 'S':
+                config.seed = value;
+                break;
+            case 'T':
+                config.timeout = std::chrono::seconds(value);
+                break;
+            default:
+                usage();
+                return EXIT_FAILURE;
+        }
+    }
+    if (!config.termini || config.termini > maxTermini ||
+        config.sensors > UINT16_MAX)
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    char tmpl[] = "/tmp/terminus_farm_benchmark.XXXXXX";
+    if (!mkdtemp(tmpl))
+    {
+        std::cerr << "Failed to create the benchmark directory\n";
+        return EXIT_FAILURE;
+    }
+    fs::path dir(tmpl);
+    auto dbPath = dir / "instance_id_db";
+    std::ofstream(dbPath).close();
+    fs::resize_file(dbPath,
+                    static_cast<uintmax_t>(PLDM_MAX_TIDS) * maxInstanceIds);
+    InstanceIdDb instanceIdDb(dbPath);
+
+    std::cout << std::format(
+        "{} termini, {} sensors each, {} ms update interval, {} us latency, "
+        "{} us jitter, {} events/s, {} s polling\n",
+        config.termini, config.sensors,
+        static_cast<unsigned>(config.sensorInterval * 1000),
+        config.latency.count(), config.jitter.count(), config.eventRate,
+        config.duration.count());
+
+    auto rc = runFarm(config, instanceIdDb) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    fs::remove_all(dir);
+    return rc;
+}
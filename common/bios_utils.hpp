@@ -1,9 +1,12 @@
 #pragma once
 
+#include <endian.h>
 #include <libpldm/bios_table.h>
 
+#include <cstdint>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <type_traits>
 #include <vector>
 
@@ -16,6 +19,31 @@ namespace utils
 
 using Table = std::vector<uint8_t>;
 
+/** @brief Command code of GetBIOSTableTags, defined by DSP0247 and not by
+ *         libpldm
+ */
+constexpr uint8_t getBIOSTableTagsCommand = 0x04;
+
+/** @brief Tag of a BIOS table, its CRC32 checksum
+ *
+ *  The checksum ends the table and changes with any change of its content,
+ *  so a copy of a table is current as long as its tag matches.
+ *
+ *  @param[in] table - the table, padded and checksummed
+ *
+ *  @return the tag, std::nullopt if the table is too short
+ */
+inline std::optional<uint32_t> getTableTag(const Table& table)
+{
+    uint32_t tag = 0;
+    if (table.size() < sizeof(tag))
+    {
+        return std::nullopt;
+    }
+    std::memcpy(&tag, table.data() + table.size() - sizeof(tag), sizeof(tag));
+    return le32toh(tag);
+}
+
 /** @class BIOSTableIter
  *  @brief Const Iterator of a BIOS Table
  */
@@ -0,0 +1,293 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+#include <systemd/sd-event.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <format>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace pldm
+{
+namespace stats
+{
+
+/** @struct LoopActivity
+ *
+ *  What the event loop callback running does, set by the callbacks of
+ *  interest, for the report of the callbacks stalling the loop.
+ */
+struct LoopActivity
+{
+    std::string_view source;        //!< owner of the callback, a literal
+    std::optional<uint8_t> tid;     //!< terminus the callback works for
+    std::optional<uint8_t> type;    //!< PLDM type of the message handled
+    std::optional<uint8_t> command; //!< PLDM command of the message handled
+    std::string dbus;               //!< member and path of the D-Bus message
+};
+
+/** @class DaemonStats
+ *
+ *  Counters of the work done by pldmd: event loop iterations, messages
+ *  received per PLDM type, responses sent and D-Bus calls per method. The
+ *  counters only grow, a monitor derives rates from two reads and the
+ *  uptime between them. With a stall threshold set, each event loop
+ *  callback taking longer is logged with the activity it declared.
+ *
+ *  pldmd handles messages on one thread, the counters are not locked.
+ */
+class DaemonStats
+{
+  public:
+    DaemonStats(const DaemonStats&) = delete;
+    DaemonStats& operator=(const DaemonStats&) = delete;
+
+    static DaemonStats& getInstance()
+    {
+        static DaemonStats stats;
+        return stats;
+    }
+
+    /** @brief Count a received message
+     *
+     *  @param[in] pldmType - PLDM type of the message
+     */
+    void addRxMessage(uint8_t pldmType)
+    {
+        rxMessages[pldmType % rxMessages.size()]++;
+    }
+
+    /** @brief Count a response sent
+     *
+     *  @param[in] bytes - length of the response
+     */
+    void addResponse(size_t bytes)
+    {
+        responses++;
+        responseBytes += bytes;
+    }
+
+    /** @brief Count a D-Bus method call
+     *
+     *  @param[in] method - name of the method
+     */
+    void addDbusCall(std::string_view method)
+    {
+        if (auto it = dbusCalls.find(method); it != dbusCalls.end())
+        {
+            it->second++;
+            return;
+        }
+        dbusCalls.emplace(method, 1);
+    }
+
+    /** @brief Count an event loop iteration
+     *
+     *  @param[in] busy - time from the wakeup to the end of the dispatch
+     */
+    void addLoopIteration(std::chrono::microseconds busy)
+    {
+        loopIterations++;
+        loopBusyUs += busy.count();
+        loopMaxIterationUs =
+            std::max<uint64_t>(loopMaxIterationUs, busy.count());
+
+        if (stallThreshold.count() && busy >= stallThreshold)
+        {
+            loopStalls++;
+            reportStall(busy);
+        }
+        activity.source = {};
+        activity.tid.reset();
+        activity.type.reset();
+        activity.command.reset();
+        activity.dbus.clear();
+    }
+
+    /** @brief Log the event loop callbacks taking at least a threshold
+     *
+     *  @param[in] threshold - shortest callback logged, 0 disables the logs
+     */
+    void setStallThreshold(std::chrono::microseconds threshold)
+    {
+        stallThreshold = threshold;
+    }
+
+    /** @brief Declare what the running event loop callback does
+     *
+     *  @param[in] source - owner of the callback, a literal
+     *  @param[in] tid - terminus the callback works for
+     */
+    void setLoopActivity(std::string_view source,
+                         std::optional<uint8_t> tid = std::nullopt)
+    {
+        activity.source = source;
+        activity.tid = tid;
+    }
+
+    /** @brief Declare the PLDM message the running callback handles
+     *
+     *  @param[in] source - owner of the callback, a literal
+     *  @param[in] tid - terminus the message comes from
+     *  @param[in] type - PLDM type of the message
+     *  @param[in] command - PLDM command of the message
+     */
+    void setLoopActivity(std::string_view source, uint8_t tid, uint8_t type,
+                         uint8_t command)
+    {
+        setLoopActivity(source, tid);
+        activity.type = type;
+        activity.command = command;
+    }
+
+    /** @brief Measure the iterations of an event loop
+     *
+     *  Each iteration dispatches one event source, the time from the wakeup
+     *  of an iteration to the prepare phase of the next one is the duration
+     *  of that callback.
+     *
+     *  @param[in] event - the event loop
+     *
+     *  @return 0 on success, a negative errno otherwise
+     */
+    int monitorEventLoop(sd_event* event)
+    {
+        // A timer never expiring, for its prepare callback to run on each
+        // iteration
+        auto rc = sd_event_add_time(
+            event, &loopSource, CLOCK_MONOTONIC, UINT64_MAX, 0,
+            [](sd_event_source*, uint64_t, void*) { return 0; }, nullptr);
+        if (rc < 0)
+        {
+            return rc;
+        }
+        return sd_event_source_set_prepare(loopSource, onPrepare);
+    }
+
+    /** @brief Attribute the event loop callbacks of a bus to the D-Bus
+     *         messages they handle
+     *
+     *  Only done with a stall threshold set, a filter sees every message
+     *  received before its handler.
+     *
+     *  @param[in] bus - the bus, attached to the monitored event loop
+     *
+     *  @return 0 on success, a negative errno otherwise
+     */
+    int monitorDbus(sd_bus* bus)
+    {
+        if (!stallThreshold.count())
+        {
+            return 0;
+        }
+        return sd_bus_add_filter(bus, &dbusFilter, onDbusMessage, nullptr);
+    }
+
+    /** @brief Messages received, indexed by PLDM type */
+    const std::array<uint64_t, 64>& getRxMessages() const
+    {
+        return rxMessages;
+    }
+
+    /** @brief D-Bus method calls, by method */
+    const std::map<std::string, uint64_t, std::less<>>& getDbusCalls() const
+    {
+        return dbusCalls;
+    }
+
+    /** @brief Time since pldmd started */
+    std::chrono::microseconds getUptime() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+    }
+
+    uint64_t responses = 0;
+    uint64_t responseBytes = 0;
+    uint64_t loopIterations = 0;
+    uint64_t loopBusyUs = 0;
+    uint64_t loopMaxIterationUs = 0;
+    uint64_t loopStalls = 0; //!< callbacks over the stall threshold
+
+  private:
+    DaemonStats() : start(std::chrono::steady_clock::now()) {}
+
+    ~DaemonStats()
+    {
+        sd_bus_slot_unref(dbusFilter);
+        sd_event_source_unref(loopSource);
+    }
+
+    void reportStall(std::chrono::microseconds busy) const
+    {
+        std::string detail;
+        if (activity.tid)
+        {
+            detail += std::format(" for TID {}", *activity.tid);
+        }
+        if (activity.type && activity.command)
+        {
+            detail += std::format(" handling PLDM type {:#x} command {:#x}",
+                                  *activity.type, *activity.command);
+        }
+        if (!activity.dbus.empty())
+        {
+            detail += " handling D-Bus " + activity.dbus;
+        }
+        lg2::warning(
+            "Event loop callback of {SOURCE}{DETAIL} took {DURATION_US} us",
+            "SOURCE", activity.source.empty() ? "an unknown source"
+                                              : activity.source,
+            "DETAIL", detail, "DURATION_US", busy.count());
+    }
+
+    static int onDbusMessage(sd_bus_message* msg, void*, sd_bus_error*)
+    {
+        auto& activity = getInstance().activity;
+        auto member = sd_bus_message_get_member(msg);
+        auto path = sd_bus_message_get_path(msg);
+        activity.source = "D-Bus";
+        activity.dbus.assign(member ? member : "");
+        activity.dbus.append(" ").append(path ? path : "");
+        return 0;
+    }
+
+    static int onPrepare(sd_event_source* source, void*)
+    {
+        uint64_t wakeup = 0;
+        // Positive before the first iteration, there is no wakeup yet
+        if (sd_event_now(sd_event_source_get_event(source), CLOCK_MONOTONIC,
+                         &wakeup) != 0)
+        {
+            return 0;
+        }
+        timespec ts{};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        uint64_t now = static_cast<uint64_t>(ts.tv_sec) * 1000000 +
+                       ts.tv_nsec / 1000;
+        getInstance().addLoopIteration(
+            std::chrono::microseconds(now > wakeup ? now - wakeup : 0));
+        return 0;
+    }
+
+    std::chrono::steady_clock::time_point start;
+    std::array<uint64_t, 64> rxMessages{};
+    std::map<std::string, uint64_t, std::less<>> dbusCalls;
+    sd_event_source* loopSource = nullptr;
+    sd_bus_slot* dbusFilter = nullptr;
+    std::chrono::microseconds stallThreshold{0};
+    LoopActivity activity;
+};
+
+} // namespace stats
+} // namespace pldm
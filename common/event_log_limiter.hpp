@@ -0,0 +1,181 @@
+#pragma once
+
+#include <sdbusplus/timer.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <utility>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @brief Kind of the events logged, the limits of each are separate */
+enum class EventLogSource : uint8_t
+{
+    Threshold,
+    NumericSensorEvent,
+    Cper,
+    Oem,
+};
+
+/** @struct EventLogKey
+ *
+ *  The events a log entry is about, repeated events of a key are
+ *  aggregated.
+ */
+struct EventLogKey
+{
+    EventLogSource source;
+    uint8_t tid;
+    uint16_t id;  //!< sensor ID, or the ID meaningful to the source
+    uint8_t type; //!< event type, as defined by the source
+
+    auto operator<=>(const EventLogKey&) const = default;
+};
+
+/** @class EventLogLimiter
+ *
+ *  Flood control of the log entries of the events of the termini. The
+ *  first event of a key is logged, the next ones within the summary
+ *  interval are only counted, and at the end of the interval the summary
+ *  of the key logs how many were. A key keeps being summarized every
+ *  interval while its events repeat, and is forgotten after an interval
+ *  without any, its next event is logged again. A flapping sensor or an
+ *  error storm costs a counter increment per event, not a journal or
+ *  D-Bus log entry.
+ */
+class EventLogLimiter
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Log the events of a key suppressed over an interval
+     *
+     *  @param[in] suppressed - number of events not logged
+     *  @param[in] interval - the summary interval
+     */
+    using Summary =
+        std::function<void(uint64_t suppressed, std::chrono::seconds interval)>;
+
+    EventLogLimiter(const EventLogLimiter&) = delete;
+    EventLogLimiter& operator=(const EventLogLimiter&) = delete;
+
+    /** @brief The limiter of the default event loop */
+    static EventLogLimiter& getInstance()
+    {
+        static EventLogLimiter limiter(
+            sdeventplus::Event::get_default(),
+            std::chrono::seconds(EVENT_LOG_SUMMARY_INTERVAL));
+        return limiter;
+    }
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - event loop the summaries are logged from
+     *  @param[in] interval - summary interval, 0 logs every event
+     */
+    EventLogLimiter(const sdeventplus::Event& event,
+                    std::chrono::seconds interval) :
+        interval(interval), timer(event.get(), [this]() { flush(); })
+    {}
+
+    /** @brief Check if an event is logged
+     *
+     *  @param[in] key - the events the event is one of
+     *  @param[in] makeSummary - returns the Summary of the key, only called
+     *                           for its first event, the repeated ones cost
+     *                           no copy of what the summary captures
+     *
+     *  @return true to log the event, false when it is only counted
+     */
+    template <typename F>
+    bool admit(const EventLogKey& key, F&& makeSummary)
+    {
+        if (!interval.count())
+        {
+            return true;
+        }
+
+        auto now = Clock::now();
+        auto it = keys.find(key);
+        if (it == keys.end())
+        {
+            keys.emplace(key, Entry{now + interval, 0,
+                                    Summary(std::forward<F>(makeSummary)())});
+            if (!timer.isEnabled())
+            {
+                timer.start(interval, true);
+            }
+            return true;
+        }
+
+        it->second.suppressed++;
+        suppressed++;
+        return false;
+    }
+
+    /** @brief Get the number of events not logged so far */
+    uint64_t getSuppressed() const
+    {
+        return suppressed;
+    }
+
+    /** @brief Log the summaries of the intervals ended */
+    void flush()
+    {
+        auto now = Clock::now();
+        for (auto it = keys.begin(); it != keys.end();)
+        {
+            auto& entry = it->second;
+            if (entry.end > now)
+            {
+                ++it;
+                continue;
+            }
+            if (!entry.suppressed)
+            {
+                it = keys.erase(it);
+                continue;
+            }
+            entry.summary(std::exchange(entry.suppressed, 0), interval);
+            entry.end = now + interval;
+            ++it;
+        }
+        if (keys.empty())
+        {
+            timer.stop();
+        }
+    }
+
+  private:
+    /** @struct Entry
+     *
+     *  Events of a key in the current interval
+     */
+    struct Entry
+    {
+        Clock::time_point end;
+        uint64_t suppressed;
+        Summary summary;
+    };
+
+    std::chrono::seconds interval;
+
+    /** @brief Keys with an event in the current or the last interval */
+    std::map<EventLogKey, Entry> keys;
+
+    /** @brief Events not logged so far */
+    uint64_t suppressed = 0;
+
+    /** @brief Logs the summaries, runs while keys are tracked */
+    sdbusplus::Timer timer;
+};
+
+} // namespace utils
+} // namespace pldm
@@ -3,9 +3,19 @@
 #include <common/utils.hpp>
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
 #include <fstream>
-#include <iomanip>
-#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -15,35 +25,108 @@ namespace pldm
 namespace flightrecorder
 {
 using ReqOrResponse = bool;
-using FlightRecorderData = std::vector<uint8_t>;
-using FlightRecorderTimeStamp = std::string;
-using FlightRecorderRecord =
-    std::tuple<FlightRecorderTimeStamp, ReqOrResponse, FlightRecorderData>;
-using FlightRecorderCassette = std::vector<FlightRecorderRecord>;
 static constexpr auto flightRecorderDumpPath = "/tmp/pldm_flight_recorder";
 
+/** @brief Magic identifying a binary flight recorder dump */
+static constexpr std::array<char, 8> flightRecorderMagic = {
+    'P', 'L', 'D', 'M', 'F', 'R', 'E', 'C'};
+static constexpr uint32_t flightRecorderVersion = 2;
+
+/** @brief Slot flag set for messages sent by this terminus */
+static constexpr uint8_t flightRecorderTx = 0x01;
+
+/** @brief Slot flag set for marks, the payload is a FlightRecorderMark */
+static constexpr uint8_t flightRecorderMarkFlag = 0x02;
+
+/** @brief What a FlightRecorderMark annotates */
+enum class MarkKind : uint8_t
+{
+    hostPdrExchange = 1,  //!< A host PDR exchange starts
+    hostPdrProcessed = 2, //!< A host PDR was added to the repo
+    hostPdrMerge = 3,     //!< The host entity associations were merged
+};
+
+/** @struct FlightRecorderMark
+ *
+ *  Payload of a mark, annotating the messages recorded around it with the
+ *  time pldmd spent on them.
+ */
+struct FlightRecorderMark
+{
+    uint8_t kind; //!< MarkKind
+    uint8_t reserved[3];
+    uint32_t recordHandle; //!< PDR the mark is about, 0 if none
+    uint64_t duration;     //!< time spent, in nanoseconds
+};
+static_assert(sizeof(FlightRecorderMark) == 16);
+
+static_assert(FLIGHT_RECORDER_PAYLOAD_SIZE % 8 == 0,
+              "flight recorder payload size must be a multiple of 8");
+static_assert(FLIGHT_RECORDER_PAYLOAD_SIZE >= sizeof(FlightRecorderMark),
+              "flight recorder payload size must hold a mark");
+
+/** @struct FlightRecorderSlot
+ *
+ *  One fixed-size record of the ring. Messages longer than the inline
+ *  payload are truncated, length keeps the original size.
+ */
+struct FlightRecorderSlot
+{
+    uint64_t sequence;  //!< record number, starting at 1, 0 for an empty slot
+    uint64_t timestamp; //!< CLOCK_MONOTONIC in nanoseconds
+    uint16_t length;    //!< length of the message on the wire
+    uint8_t flags; //!< flightRecorderTx for outgoing messages,
+                   //!< flightRecorderMarkFlag for marks
+    uint8_t tid;   //!< remote terminus the message was exchanged with
+    uint32_t reserved;
+    uint8_t payload[FLIGHT_RECORDER_PAYLOAD_SIZE];
+};
+static_assert(sizeof(FlightRecorderSlot) == 24 + FLIGHT_RECORDER_PAYLOAD_SIZE);
+
+/** @struct FlightRecorderHeader
+ *
+ *  Header of the binary dump, followed by slotCount FlightRecorderSlots in
+ *  ring order. All fields are in host byte order.
+ */
+struct FlightRecorderHeader
+{
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t payloadSize;
+    uint32_t slotSize;
+    uint64_t sequence;      //!< number of records written so far
+    int64_t realtimeOffset; //!< CLOCK_REALTIME - CLOCK_MONOTONIC at dump, ns
+};
+static_assert(sizeof(FlightRecorderHeader) == 40);
+
 /** @class FlightRecorder
  *
  *  The class for implementing the PLDM flight recorder logic. This class
  *  handles the insertion of the data into the recorder and also provides
  *  API's to dump the flight recorder into a file.
+ *
+ *  Records live in a ring of slots allocated once at construction, so the
+ *  recording path neither allocates nor formats. Writers claim a slot with an
+ *  atomic increment of the sequence number.
  */
 
 class FlightRecorder
 {
   private:
-    FlightRecorder() : index(0)
+    FlightRecorder()
     {
         flightRecorderPolicy = FLIGHT_RECORDER_MAX_ENTRIES ? true : false;
         if (flightRecorderPolicy)
         {
-            tapeRecorder = FlightRecorderCassette(FLIGHT_RECORDER_MAX_ENTRIES);
+            tapeRecorder =
+                std::vector<FlightRecorderSlot>(FLIGHT_RECORDER_MAX_ENTRIES);
         }
     }
 
   protected:
-    int index;
-    FlightRecorderCassette tapeRecorder;
+    std::atomic<uint64_t> sequence{0};
+    std::vector<FlightRecorderSlot> tapeRecorder;
     bool flightRecorderPolicy;
 
   public:
@@ -64,25 +147,46 @@ class FlightRecorder
      *  @param[in] buffer  - The request/response byte buffer
      *  @param[in] isRequest - bool that captures if it is a request message or
      *                         a response message
+     *  @param[in] tid - The remote terminus of the message
      *
      *  @return void
      */
-    void saveRecord(const FlightRecorderData& buffer, ReqOrResponse isRequest)
+    void saveRecord(std::span<const uint8_t> buffer, ReqOrResponse isRequest,
+                    uint8_t tid = 0)
+    {
+        save(buffer, isRequest ? flightRecorderTx : 0, tid);
+    }
+
+    /** @brief Add a mark to the flightRecorder
+     *
+     *  @param[in] kind - what the mark annotates
+     *  @param[in] tid - The remote terminus the mark is about
+     *  @param[in] recordHandle - The PDR the mark is about, 0 if none
+     *  @param[in] duration - The time spent
+     *
+     *  @return void
+     */
+    void saveMark(MarkKind kind, uint8_t tid, uint32_t recordHandle,
+                  std::chrono::nanoseconds duration)
     {
-        // if the flight recorder policy is enabled, then only insert the
-        // messages into the flight recorder, if not this function will be just
-        // a no-op
         if (flightRecorderPolicy)
         {
-            int currentIndex = index++;
-            tapeRecorder[currentIndex] = std::make_tuple(
-                pldm::utils::getCurrentSystemTime(), isRequest, buffer);
-            index =
-                (currentIndex == FLIGHT_RECORDER_MAX_ENTRIES - 1) ? 0 : index;
+            FlightRecorderMark mark{};
+            mark.kind = static_cast<uint8_t>(kind);
+            mark.recordHandle = recordHandle;
+            mark.duration = duration.count();
+            save(std::span(reinterpret_cast<const uint8_t*>(&mark),
+                           sizeof(mark)),
+                 flightRecorderMarkFlag, tid);
         }
     }
 
     /** @brief play flight recorder
+     *
+     *  Writes the binary dump to flightRecorderDumpPath. The file can be
+     *  mmap'ed as a FlightRecorderHeader followed by the slot array, and
+     *  decoded with tools/flight-recorder/pldm_flight_recorder_decode.py or
+     *  pldmtool decode.
      *
      *  @return void
      */
@@ -91,28 +195,34 @@ class FlightRecorder
     {
         if (flightRecorderPolicy)
         {
-            std::ofstream recorderOutputFile(flightRecorderDumpPath);
+            std::ofstream recorderOutputFile(flightRecorderDumpPath,
+                                             std::ios::binary |
+                                                 std::ios::trunc);
             info("Dumping the flight recorder into : {DUMP_PATH}", "DUMP_PATH",
                  flightRecorderDumpPath);
-            for (const auto& message : tapeRecorder)
-            {
-                recorderOutputFile
-                    << std::get<FlightRecorderTimeStamp>(message) << " : ";
-                if (std::get<ReqOrResponse>(message))
-                {
-                    recorderOutputFile << "Tx : \n";
-                }
-                else
-                {
-                    recorderOutputFile << "Rx : \n";
-                }
-                for (const auto& word : std::get<FlightRecorderData>(message))
-                {
-                    recorderOutputFile << std::setfill('0') << std::setw(2)
-                                       << std::hex << (unsigned)word << " ";
-                }
-                recorderOutputFile << std::endl;
-            }
+
+            timespec mono{};
+            timespec real{};
+            clock_gettime(CLOCK_MONOTONIC, &mono);
+            clock_gettime(CLOCK_REALTIME, &real);
+
+            FlightRecorderHeader header{};
+            header.magic = flightRecorderMagic;
+            header.version = flightRecorderVersion;
+            header.slotCount = tapeRecorder.size();
+            header.payloadSize = FLIGHT_RECORDER_PAYLOAD_SIZE;
+            header.slotSize = sizeof(FlightRecorderSlot);
+            header.sequence = sequence.load(std::memory_order_acquire);
+            header.realtimeOffset =
+                (static_cast<int64_t>(real.tv_sec) - mono.tv_sec) *
+                    1000000000LL +
+                (static_cast<int64_t>(real.tv_nsec) - mono.tv_nsec);
+
+            recorderOutputFile.write(reinterpret_cast<const char*>(&header),
+                                     sizeof(header));
+            recorderOutputFile.write(
+                reinterpret_cast<const char*>(tapeRecorder.data()),
+                tapeRecorder.size() * sizeof(FlightRecorderSlot));
             recorderOutputFile.close();
         }
         else
@@ -120,7 +230,93 @@ class FlightRecorder
             error("Fight recorder policy is disabled");
         }
     }
+
+  private:
+    /** @brief Write a record into the next slot of the ring
+     *
+     *  @param[in] buffer - The record
+     *  @param[in] flags - Slot flags of the record
+     *  @param[in] tid - The remote terminus of the record
+     */
+    void save(std::span<const uint8_t> buffer, uint8_t flags, uint8_t tid)
+    {
+        // if the flight recorder policy is enabled, then only insert the
+        // messages into the flight recorder, if not this function will be just
+        // a no-op
+        if (flightRecorderPolicy)
+        {
+            auto seq = sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+            auto& slot = tapeRecorder[(seq - 1) % tapeRecorder.size()];
+
+            // Readers skip slots whose sequence is 0 while they are rewritten
+            std::atomic_ref<uint64_t> slotSequence(slot.sequence);
+            slotSequence.store(0, std::memory_order_relaxed);
+
+            timespec ts{};
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            slot.timestamp =
+                static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+            slot.length = static_cast<uint16_t>(
+                std::min<size_t>(buffer.size(), UINT16_MAX));
+            slot.flags = flags;
+            slot.tid = tid;
+            auto copyLen = std::min(buffer.size(), sizeof(slot.payload));
+            std::memcpy(slot.payload, buffer.data(), copyLen);
+            slotSequence.store(seq, std::memory_order_release);
+        }
+    }
 };
 
+/** @brief A record of a dump and its payload, as captured */
+using DumpRecord = std::pair<FlightRecorderSlot, std::vector<uint8_t>>;
+
+/** @brief Read the records of a dump in the order they were written
+ *
+ *  @param[in] path - the dump written by FlightRecorder::playRecorder
+ *
+ *  @return the records, std::nullopt if the file is not a dump of this
+ *          version
+ */
+inline std::optional<std::vector<DumpRecord>> readDump(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    FlightRecorderHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != flightRecorderMagic ||
+        header.version != flightRecorderVersion ||
+        header.slotSize < offsetof(FlightRecorderSlot, payload) ||
+        header.slotSize - offsetof(FlightRecorderSlot, payload) !=
+            header.payloadSize)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<DumpRecord> records;
+    std::vector<uint8_t> buffer(header.slotSize);
+    for (uint32_t i = 0; i < header.slotCount; i++)
+    {
+        if (!file.read(reinterpret_cast<char*>(buffer.data()), buffer.size()))
+        {
+            return std::nullopt;
+        }
+        FlightRecorderSlot slot{};
+        std::memcpy(&slot, buffer.data(),
+                    offsetof(FlightRecorderSlot, payload));
+        if (!slot.sequence)
+        {
+            continue;
+        }
+        auto payload = std::span(buffer).subspan(
+            offsetof(FlightRecorderSlot, payload),
+            std::min<size_t>(slot.length, header.payloadSize));
+        records.emplace_back(
+            slot, std::vector<uint8_t>(payload.begin(), payload.end()));
+    }
+    std::ranges::sort(records, {}, [](const auto& entry) {
+        return entry.first.sequence;
+    });
+    return records;
+}
+
 } // namespace flightrecorder
 } // namespace pldm
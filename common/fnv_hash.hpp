@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @brief FNV-1a 64-bit offset basis, the hash of no bytes
+ *
+ *  The content hashes of pldmd tell changed or stale data apart. FNV-1a is
+ *  fast and good enough for that, it does not resist collisions made on
+ *  purpose.
+ */
+constexpr uint64_t fnvOffsetBasis = 0xcbf29ce484222325ULL;
+
+/** @brief FNV-1a 64-bit prime */
+constexpr uint64_t fnvPrime = 0x100000001b3ULL;
+
+/** @brief Add a byte to an FNV-1a hash
+ *
+ *  @param[in,out] hash - hash of the bytes before
+ *  @param[in] byte - byte added
+ */
+constexpr void fnvHash(uint64_t& hash, uint8_t byte)
+{
+    hash ^= byte;
+    hash *= fnvPrime;
+}
+
+/** @brief Add bytes to an FNV-1a hash
+ *
+ *  @param[in,out] hash - hash of the bytes before
+ *  @param[in] bytes - bytes added
+ */
+constexpr void fnvHash(uint64_t& hash, std::span<const uint8_t> bytes)
+{
+    for (auto byte : bytes)
+    {
+        fnvHash(hash, byte);
+    }
+}
+
+/** @brief Add the characters of a string to an FNV-1a hash
+ *
+ *  @param[in,out] hash - hash of the bytes before
+ *  @param[in] bytes - characters added
+ */
+constexpr void fnvHash(uint64_t& hash, std::string_view bytes)
+{
+    for (auto byte : bytes)
+    {
+        fnvHash(hash, static_cast<uint8_t>(byte));
+    }
+}
+
+} // namespace utils
+} // namespace pldm
@@ -2,22 +2,47 @@
 
 #include <libpldm/instance-id.h>
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cerrno>
 #include <cstdint>
 #include <exception>
+#include <map>
 #include <string>
 #include <system_error>
 
 namespace pldm
 {
 
+/** @brief Number of instance IDs of a terminus as per DSP0240 */
+constexpr uint8_t maxInstanceIds = 32;
+
+/** @struct InstanceIdStats
+ *  @brief Counters of the instance ID allocator
+ */
+struct InstanceIdStats
+{
+    uint64_t localAllocations = 0; //!< IDs recycled without the database
+    uint64_t dbAllocations = 0;    //!< IDs allocated from the database
+    uint64_t dbFrees = 0;          //!< IDs returned to the database
+    uint64_t contended = 0;   //!< database had no ID, a leased one was used
+    uint64_t exhausted = 0;   //!< no ID available at all
+};
+
 /** @class InstanceId
  *  @brief Implementation of PLDM instance id as per DSP0240 v1.0.0
+ *
+ *  Instance IDs allocated from the libpldm database are leased: a freed ID
+ *  stays allocated in the database and is recycled by this process, up to
+ *  leaseSize IDs per TID. Allocation and free of a leased ID take no lock.
+ *  Until the lease is full new IDs still come from the database, and freed
+ *  IDs are recycled oldest first, so IDs keep rotating as DSP0240 expects.
  */
 class InstanceIdDb
 {
   public:
-    InstanceIdDb()
+    InstanceIdDb() : leaseSize(clampLeaseSize(INSTANCE_ID_LEASE_SIZE))
     {
         int rc = pldm_instance_db_init_default(&pldmInstanceIdDb);
         if (rc)
@@ -29,8 +54,12 @@ class InstanceIdDb
     /** @brief Constructor
      *
      *  @param[in] path - instance ID database path
+     *  @param[in] leaseSize - instance IDs kept per TID once freed, 1 returns
+     *                         every freed ID to the database
      */
-    InstanceIdDb(const std::string& path)
+    InstanceIdDb(const std::string& path,
+                 uint8_t leaseSize = INSTANCE_ID_LEASE_SIZE) :
+        leaseSize(clampLeaseSize(leaseSize))
     {
         int rc = pldm_instance_db_init(&pldmInstanceIdDb, path.c_str());
         if (rc)
@@ -48,6 +77,16 @@ class InstanceIdDb
          *
          * Broadly, it should be possible to use strace to investigate.
          */
+        for (const auto& [tid, lease] : leases)
+        {
+            for (uint8_t id = 0; id < maxInstanceIds; id++)
+            {
+                if (lease.leased & (1u << id))
+                {
+                    pldm_instance_id_free(pldmInstanceIdDb, tid, id);
+                }
+            }
+        }
         pldm_instance_db_destroy(pldmInstanceIdDb);
     }
 
@@ -58,11 +97,25 @@ class InstanceIdDb
      */
     uint8_t next(uint8_t tid)
     {
+        auto& lease = leases[tid];
+        if (lease.count && std::popcount(lease.leased) >= leaseSize)
+        {
+            stats.localAllocations++;
+            return lease.take();
+        }
+
         uint8_t id;
         int rc = pldm_instance_id_alloc(pldmInstanceIdDb, tid, &id);
 
         if (rc == -EAGAIN)
         {
+            // Other processes hold the rest, fall back on an idle leased ID
+            if (lease.count)
+            {
+                stats.contended++;
+                return lease.take();
+            }
+            stats.exhausted++;
             throw std::runtime_error("No free instance ids");
         }
 
@@ -71,6 +124,9 @@ class InstanceIdDb
             throw std::system_category().default_error_condition(rc);
         }
 
+        stats.dbAllocations++;
+        lease.leased |= 1u << id;
+        lease.inUse |= 1u << id;
         return id;
     }
 
@@ -80,6 +136,27 @@ class InstanceIdDb
      */
     void free(uint8_t tid, uint8_t instanceId)
     {
+        if (auto it = leases.find(tid);
+            it != leases.end() && instanceId < maxInstanceIds &&
+            (it->second.leased & (1u << instanceId)))
+        {
+            auto& lease = it->second;
+            if (!(lease.inUse & (1u << instanceId)))
+            {
+                throw std::runtime_error(
+                    "Instance ID " + std::to_string(instanceId) + " for TID " +
+                    std::to_string(tid) + " was not previously allocated");
+            }
+            lease.inUse &= ~(1u << instanceId);
+            if (leaseSize > 1 && std::popcount(lease.leased) <= leaseSize)
+            {
+                lease.put(instanceId);
+                return;
+            }
+            lease.leased &= ~(1u << instanceId);
+            stats.dbFrees++;
+        }
+
         int rc = pldm_instance_id_free(pldmInstanceIdDb, tid, instanceId);
         if (rc == -EINVAL)
         {
@@ -93,8 +170,57 @@ class InstanceIdDb
         }
     }
 
+    /** @brief Get the allocator counters
+     *
+     *  @return counters since construction
+     */
+    const InstanceIdStats& getStats() const
+    {
+        return stats;
+    }
+
   private:
+    /** @struct Lease
+     *  @brief Instance IDs of one TID held in the database by this process
+     */
+    struct Lease
+    {
+        uint32_t leased = 0; //!< IDs allocated in the database
+        uint32_t inUse = 0;  //!< leased IDs handed out by next()
+        std::array<uint8_t, maxInstanceIds> idle{}; //!< freed IDs, FIFO
+        uint8_t head = 0;
+        uint8_t count = 0;
+
+        uint8_t take()
+        {
+            auto id = idle[head];
+            head = (head + 1) % maxInstanceIds;
+            count--;
+            inUse |= 1u << id;
+            return id;
+        }
+
+        void put(uint8_t id)
+        {
+            idle[(head + count) % maxInstanceIds] = id;
+            count++;
+        }
+    };
+
+    static uint8_t clampLeaseSize(unsigned size)
+    {
+        return std::clamp<unsigned>(size, 1, maxInstanceIds);
+    }
+
     pldm_instance_db* pldmInstanceIdDb = nullptr;
+
+    /** @brief IDs leased per TID */
+    std::map<uint8_t, Lease> leases;
+
+    /** @brief Upper bound of the IDs leased per TID */
+    uint8_t leaseSize;
+
+    InstanceIdStats stats;
 };
 
 } // namespace pldm
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "common/worker_pool.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <vector>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @struct JsonPreloadStats
+ *
+ *  What a JsonCache::preload did: the files parsed, their size, the time it
+ *  took and the time the parsers spent, the latter over the former being the
+ *  speedup of parsing concurrently.
+ */
+struct JsonPreloadStats
+{
+    size_t files = 0;  //!< files parsed successfully
+    size_t failed = 0; //!< files not parsed, their readers report the error
+    uint64_t bytes = 0;
+    std::chrono::microseconds elapsed{};
+    std::chrono::microseconds parsing{}; //!< summed over the workers
+};
+
+/** @class JsonCache
+ *
+ *  JSON configuration files parsed ahead of their readers. pldmd preloads
+ *  the configuration of all the subsystems on the worker pool before the
+ *  event loop starts, the parser of each subsystem then takes its files from
+ *  the cache instead of parsing them on the main thread one after another.
+ *  A file is taken once, a later reload reads it from disk, and the files
+ *  left once pldmd started are evicted.
+ */
+class JsonCache
+{
+  public:
+    JsonCache(const JsonCache&) = delete;
+    JsonCache& operator=(const JsonCache&) = delete;
+
+    static JsonCache& getInstance()
+    {
+        static JsonCache cache;
+        return cache;
+    }
+
+    /** @brief Parse JSON files concurrently
+     *
+     *  Files failing to parse are not cached, their readers parse them again
+     *  and report the error the way they always did.
+     *
+     *  @param[in] paths - JSON files, and directories whose .json files are
+     *                     parsed, missing ones are skipped
+     *  @param[in] pool - workers parsing along with the calling thread,
+     *                    which waits for them
+     *
+     *  @return what was preloaded
+     */
+    JsonPreloadStats preload(const std::vector<std::filesystem::path>& paths,
+                             WorkerPool& pool = WorkerPool::getInstance())
+    {
+        namespace fs = std::filesystem;
+        auto begin = std::chrono::steady_clock::now();
+
+        std::vector<fs::path> files;
+        for (const auto& path : paths)
+        {
+            std::error_code ec;
+            if (fs::is_regular_file(path, ec))
+            {
+                files.emplace_back(path);
+                continue;
+            }
+            for (const auto& entry : fs::directory_iterator(path, ec))
+            {
+                if (entry.is_regular_file(ec) &&
+                    entry.path().extension() == ".json")
+                {
+                    files.emplace_back(entry.path());
+                }
+            }
+        }
+
+        // The parsers share the state with the pool, a job starting late
+        // finds no file left and only drops its reference
+        auto state = std::make_shared<PreloadState>();
+        state->files = std::move(files);
+        state->parsed.resize(state->files.size());
+        state->sizes.resize(state->files.size(), 0);
+
+        // The calling thread parses along with the workers
+        auto jobs = std::min<size_t>(WORKER_POOL_THREADS,
+                                     state->files.size() / 2);
+        for (size_t i = 0; i < jobs; i++)
+        {
+            try
+            {
+                pool.post([state]() { state->parse(); }, []() {});
+            }
+            catch (const std::system_error&)
+            {
+                // The calling thread parses the files left
+                break;
+            }
+        }
+        state->parse();
+        {
+            std::unique_lock lock(state->mutex);
+            state->allParsed.wait(lock, [&state]() {
+                return state->done == state->files.size();
+            });
+        }
+        const auto& parsedFiles = state->files;
+        auto& parsed = state->parsed;
+        const auto& sizes = state->sizes;
+
+        JsonPreloadStats stats{};
+        std::lock_guard lock(mutex);
+        for (size_t index = 0; index < parsedFiles.size(); index++)
+        {
+            if (parsed[index].is_discarded())
+            {
+                stats.failed++;
+                continue;
+            }
+            stats.files++;
+            stats.bytes += sizes[index];
+            cache.insert_or_assign(parsedFiles[index],
+                                   std::move(parsed[index]));
+        }
+        stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - begin);
+        stats.parsing = std::chrono::microseconds(state->parsingUs.load());
+        return stats;
+    }
+
+    /** @brief Take a preloaded file out of the cache
+     *
+     *  @param[in] path - the JSON file
+     *
+     *  @return the parsed file, std::nullopt if it was not preloaded
+     */
+    std::optional<nlohmann::json> take(const std::filesystem::path& path)
+    {
+        std::lock_guard lock(mutex);
+        auto node = cache.extract(path);
+        if (node.empty())
+        {
+            return std::nullopt;
+        }
+        return std::move(node.mapped());
+    }
+
+    /** @brief Take a preloaded file, or parse it from disk
+     *
+     *  @param[in] path - the JSON file
+     *  @param[in] allowExceptions - throw on a parse error rather than
+     *                               return a discarded value, as
+     *                               nlohmann::json::parse
+     *
+     *  @return the parsed file
+     */
+    nlohmann::json parse(const std::filesystem::path& path,
+                         bool allowExceptions = true)
+    {
+        if (auto json = take(path))
+        {
+            return std::move(*json);
+        }
+        std::ifstream file(path);
+        return nlohmann::json::parse(file, nullptr, allowExceptions);
+    }
+
+    /** @brief Drop the preloaded files not taken, once their readers had
+     *         their chance, the readers skipping a file, as the BIOS
+     *         configuration found in the schema cache, would otherwise keep
+     *         it in memory for the life of pldmd
+     *
+     *  @return the number of files dropped
+     */
+    size_t evict()
+    {
+        std::lock_guard lock(mutex);
+        auto count = cache.size();
+        cache.clear();
+        return count;
+    }
+
+  private:
+    JsonCache() = default;
+
+    /** @struct PreloadState
+     *
+     *  Files of a preload, shared by the calling thread and the pool jobs
+     *  parsing them.
+     */
+    struct PreloadState
+    {
+        std::vector<std::filesystem::path> files;
+        std::vector<nlohmann::json> parsed;
+        std::vector<uint64_t> sizes;
+        std::atomic<size_t> next{0};
+        std::atomic<uint64_t> parsingUs{0};
+        std::mutex mutex;
+        std::condition_variable allParsed;
+        size_t done = 0; //!< files parsed, guarded by mutex
+
+        /** @brief Parse the files not taken by another thread yet */
+        void parse()
+        {
+            for (auto index = next++; index < files.size(); index = next++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                std::ifstream file(files[index]);
+                parsed[index] = nlohmann::json::parse(file, nullptr, false);
+                std::error_code ec;
+                sizes[index] = std::filesystem::file_size(files[index], ec);
+                parsingUs +=
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+
+                std::lock_guard lock(mutex);
+                if (++done == files.size())
+                {
+                    allParsed.notify_all();
+                }
+            }
+        }
+    };
+
+    std::mutex mutex;
+    std::map<std::filesystem::path, nlohmann::json> cache;
+};
+
+} // namespace utils
+} // namespace pldm
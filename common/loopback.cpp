@@ -0,0 +1,159 @@
+#include "loopback.hpp"
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+
+namespace pldm
+{
+
+namespace transport
+{
+
+Loopback& Loopback::get()
+{
+    static Loopback loopback;
+    return loopback;
+}
+
+Loopback::Loopback()
+{
+    fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category());
+    }
+}
+
+Loopback::~Loopback()
+{
+    close(fd);
+}
+
+void Loopback::clear()
+{
+    pending.clear();
+    receivers.clear();
+    arm();
+}
+
+void Loopback::send(mctp_eid_t eid, std::vector<uint8_t>&& msg,
+                    std::chrono::microseconds delay)
+{
+    auto it = pending.emplace(Clock::now() + delay,
+                              std::make_pair(eid, std::move(msg)));
+    if (it == pending.begin())
+    {
+        arm();
+    }
+}
+
+bool Loopback::deliver(mctp_eid_t eid, std::span<const uint8_t> msg)
+{
+    auto it = receivers.find(eid);
+    if (it == receivers.end())
+    {
+        return false;
+    }
+    it->second(msg);
+    return true;
+}
+
+bool Loopback::receive(mctp_eid_t& eid, std::vector<uint8_t>& msg)
+{
+    auto it = pending.begin();
+    if (it == pending.end() || it->first > Clock::now())
+    {
+        arm();
+        return false;
+    }
+    eid = it->second.first;
+    msg = std::move(it->second.second);
+    pending.erase(it);
+    return true;
+}
+
+void Loopback::arm()
+{
+    // Consume the expiration of the timer before arming it again
+    uint64_t expirations = 0;
+    [[maybe_unused]] auto rc = read(fd, &expirations, sizeof(expirations));
+
+    itimerspec spec{};
+    if (!pending.empty())
+    {
+        // A zero it_value disarms the timer, a due message fires at once
+        auto delay = std::max<Clock::duration>(
+            pending.begin()->first - Clock::now(), std::chrono::nanoseconds(1));
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(delay)
+                      .count();
+        spec.it_value.tv_sec = ns / 1000000000;
+        spec.it_value.tv_nsec = ns % 1000000000;
+    }
+    timerfd_settime(fd, 0, &spec, nullptr);
+}
+
+namespace
+{
+
+/** @brief Backend of the Loopback network */
+class LoopbackBackend : public Backend
+{
+  public:
+    int getEventSource() const override
+    {
+        return Loopback::get().getEventSource();
+    }
+
+    pldm_requester_rc_t sendMsg(pldm_tid_t tid, const void* tx,
+                                size_t len) override
+    {
+        if (!Loopback::get().deliver(
+                tid, std::span(static_cast<const uint8_t*>(tx), len)))
+        {
+            return PLDM_REQUESTER_SEND_FAIL;
+        }
+        return PLDM_REQUESTER_SUCCESS;
+    }
+
+    pldm_requester_rc_t recvMsg(pldm_tid_t& tid, void*& rx,
+                                size_t& len) override
+    {
+        rx = nullptr;
+        len = 0;
+
+        mctp_eid_t eid{};
+        std::vector<uint8_t> msg;
+        if (!Loopback::get().receive(eid, msg))
+        {
+            return PLDM_REQUESTER_TRANSPORT_BUSY;
+        }
+
+        rx = malloc(msg.size());
+        if (!rx)
+        {
+            return PLDM_REQUESTER_RECV_FAIL;
+        }
+        memcpy(rx, msg.data(), msg.size());
+        len = msg.size();
+        tid = eid;
+        return PLDM_REQUESTER_SUCCESS;
+    }
+};
+
+} // namespace
+
+std::unique_ptr<Backend> makeLoopbackBackend()
+{
+    return std::make_unique<LoopbackBackend>();
+}
+
+} // namespace transport
+
+} // namespace pldm
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "common/transport_backend.hpp"
+
+#include <libpldm/base.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+
+namespace transport
+{
+
+/** @class Loopback
+ *
+ *  MCTP network simulated in the process, for the benchmarks and the tests.
+ *  The "loopback" backend hands the messages the BMC sends to the receiver
+ *  attached to their destination EID, and receives the messages the
+ *  simulated endpoints send once their delay elapsed.
+ */
+class Loopback
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Receiver = std::function<void(std::span<const uint8_t> msg)>;
+
+    Loopback(const Loopback&) = delete;
+    Loopback(Loopback&&) = delete;
+    Loopback& operator=(const Loopback&) = delete;
+    Loopback& operator=(Loopback&&) = delete;
+
+    /** @brief Get the network of the process */
+    static Loopback& get();
+
+    /** @brief Attach a simulated endpoint
+     *
+     *  @param[in] eid - EID of the endpoint
+     *  @param[in] receiver - called with the messages the BMC sends to eid
+     */
+    void attach(mctp_eid_t eid, Receiver receiver)
+    {
+        receivers[eid] = std::move(receiver);
+    }
+
+    /** @brief Detach all the endpoints and drop the messages in flight */
+    void clear();
+
+    /** @brief Send a message of an endpoint to the BMC
+     *
+     *  @param[in] eid - EID of the endpoint
+     *  @param[in] msg - PLDM message
+     *  @param[in] delay - time before the BMC can receive the message
+     */
+    void send(mctp_eid_t eid, std::vector<uint8_t>&& msg,
+              std::chrono::microseconds delay);
+
+    /** @brief Deliver a message of the BMC to an endpoint
+     *
+     *  @param[in] eid - EID of the endpoint
+     *  @param[in] msg - PLDM message
+     *
+     *  @return false if no endpoint is attached to eid
+     */
+    bool deliver(mctp_eid_t eid, std::span<const uint8_t> msg);
+
+    /** @brief Receive the next message due to the BMC
+     *
+     *  @param[out] eid - EID of the endpoint which sent the message
+     *  @param[out] msg - PLDM message
+     *
+     *  @return false if no message is due yet
+     */
+    bool receive(mctp_eid_t& eid, std::vector<uint8_t>& msg);
+
+    /** @brief Check if messages to the BMC are in flight */
+    bool empty() const
+    {
+        return pending.empty();
+    }
+
+    /** @brief Provides a timer file descriptor, readable once a message to
+     *         the BMC is due
+     */
+    int getEventSource() const
+    {
+        return fd;
+    }
+
+  private:
+    Loopback();
+    ~Loopback();
+
+    /** @brief Arm the timer for the earliest message in flight */
+    void arm();
+
+    /** @brief Timer file descriptor */
+    int fd = -1;
+
+    /** @brief Messages to the BMC in flight, by time they are due */
+    std::multimap<Clock::time_point,
+                  std::pair<mctp_eid_t, std::vector<uint8_t>>>
+        pending;
+
+    /** @brief Receivers of the attached endpoints */
+    std::unordered_map<mctp_eid_t, Receiver> receivers;
+};
+
+/** @brief Create a backend exchanging messages over Loopback::get() */
+std::unique_ptr<Backend> makeLoopbackBackend();
+
+} // namespace transport
+
+} // namespace pldm
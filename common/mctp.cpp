@@ -1,86 +1,655 @@
-#include <stdio.h>
-#include <cstdlib>
-#include <vector>
-#include <cstring>
-
 #include "mctp.hpp"
+
 #include "i2c/i2c.h"
 
-extern "C" {
-#include "libmctp.h"
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <format>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C"
+{
 #include "core-internal.h"
-#include "libmctp-i2c.h"
 #include "i2c-internal.h"
+#include "libmctp-i2c.h"
+#include "libmctp.h"
+}
+
+PHOSPHOR_LOG2_USING;
+
+namespace MCTP
+{
+
+/* Used when the configuration file is missing */
+static constexpr unsigned DEFAULT_I2C_BUS = 1;
+static constexpr uint8_t DEFAULT_I2C_ADDR = 0x21;
+static constexpr uint8_t DEFAULT_EID = 0x50;
+static constexpr uint8_t DEFAULT_ROUTE_EID = 0x51;
+static constexpr uint8_t DEFAULT_ROUTE_ADDR = 0x22;
+static constexpr uint8_t MCTP_MSG_TYPE_PLDM = 0x01;
+static constexpr uint8_t PLDM_REQUEST_BIT = 0x80;
+static constexpr uint8_t PLDM_INSTANCE_ID_MASK = 0x1f;
+static constexpr uint8_t MCTP_TAG_MAX = 7;
+/* Enough for the largest packet, either way */
+static constexpr size_t I2C_PACKET_SIZE = 256;
+/* Attempts to write a packet before it is dropped */
+static constexpr unsigned TX_ATTEMPTS_MAX = 3;
+/* Longest flush() waits for the queued packets to be written */
+static constexpr auto TX_FLUSH_TIMEOUT = std::chrono::seconds(5);
+/* Flag of the i2c-slave-mqueue device addresses in sysfs */
+static constexpr uint16_t I2C_SLAVE_ADDR_FLAG = 0x1000;
+
+/** @brief A message reassembled by libmctp, waiting for receive() */
+struct RxMessage
+{
+    uint8_t eid;
+    std::unique_ptr<uint8_t, decltype(&free)> msg;
+    size_t len;
+};
+
+/** @brief A neighbour endpoint of the routing table */
+struct Route
+{
+    uint8_t eid;
+    unsigned bus;
+    uint8_t address;
+};
+
+/** @brief One I2C segment
+ *
+ *  libmctp registers a single bus per core, so every segment has its own
+ *  core and binding, and with them its own TX queue.
+ */
+struct Bus
+{
+    /** @brief I2C bus number, /dev/i2c-<number> */
+    unsigned number;
+
+    /** @brief 7-bit I2C address of the BMC on the bus */
+    uint8_t address;
+
+    /** @brief Local EID on the bus */
+    uint8_t eid;
+
+    /** @brief Most packets written back to back per processTx() pass, each
+     *         in its own I2C transaction
+     */
+    size_t batch = 1;
+
+    /** @brief i2c-slave-mqueue file backing address */
+    std::string slaveQueue;
+
+    struct mctp* mctp = nullptr;
+    struct mctp_binding_i2c* i2c = nullptr;
+
+    /** @brief I2C adapter, opened once in init() */
+    int busFd = -1;
+
+    /** @brief i2c-slave-mqueue file, signals POLLPRI when packets arrive */
+    int slaveFd = -1;
+
+    /** @brief Destination endpoints of messages that have not fully drained
+     */
+    std::set<uint8_t> txEids;
+
+    /** @brief Failed attempts to write the packet at the head of the queue
+     */
+    unsigned txAttempts = 0;
+
+    /** @brief First error of the packets that could not be written */
+    int txError = 0;
+};
+
+/** @brief Buses, in the order of the configuration */
+static std::vector<std::unique_ptr<Bus>> buses;
+
+/** @brief Bus reaching each known endpoint, from the routing table or
+ *         learned from the messages received
+ */
+static std::map<uint8_t, Bus*> routes;
+
+/** @brief eventfd that is readable while fragments are queued */
+static int txEventFd = -1;
+
+/** @brief semaphore eventfd counting the messages in rxQueue */
+static int rxEventFd = -1;
+
+/** @brief epoll set over the slave queues and rxEventFd, see
+ *         getEventSource()
+ */
+static int epollFd = -1;
+
+static std::deque<RxMessage> rxQueue;
+
+/** @brief Tag of the requests received, by endpoint and PLDM instance ID,
+ *         used to send the matching responses
+ *
+ *  An endpoint may have several requests in flight, each on its own tag.
+ */
+static std::map<std::pair<uint8_t, uint8_t>, uint8_t> rxTags;
+
+static uint8_t nextTag = 0;
+
+static void rx(uint8_t src_eid, bool tag_owner, uint8_t msg_tag, void* ctx,
+               void* msg, size_t len);
+static int tx(const void* buf, size_t len, void* ctx);
+
+/** @brief Signal the event loop that there is work for processTx() */
+static void armTx()
+{
+    uint64_t one = 1;
+    if (write(txEventFd, &one, sizeof(one)) < 0)
+    {
+        perror("MCTP TX eventfd write");
+    }
+}
+
+/** @brief Find the bus of an I2C bus number */
+static Bus* findBus(unsigned number)
+{
+    for (auto& bus : buses)
+    {
+        if (bus->number == number)
+        {
+            return bus.get();
+        }
+    }
+    return nullptr;
+}
+
+/** @brief Move every packet held by the I2C slave queues into libmctp */
+static void processRx()
+{
+    std::array<uint8_t, I2C_PACKET_SIZE> buf;
+    for (auto& bus : buses)
+    {
+        if (bus->slaveFd < 0)
+        {
+            continue;
+        }
+        while (true)
+        {
+            lseek(bus->slaveFd, 0, SEEK_SET);
+            auto len = read(bus->slaveFd, buf.data(), buf.size());
+            if (len <= 0)
+            {
+                break;
+            }
+            mctp_i2c_rx(bus->i2c, buf.data(), len);
+        }
+    }
+}
+
+/** @brief Check whether a bus still has fragments waiting to be sent */
+static bool txPending(Bus& bus)
+{
+    std::erase_if(bus.txEids, [&bus](uint8_t eid) {
+        return mctp_is_tx_ready(bus.mctp, eid);
+    });
+    return !bus.txEids.empty();
+}
+
+/** @brief Drop the packet at the head of the TX queue of a bus
+ *
+ *  A packet libmctp is told was written leaves its queue, the next ones
+ *  are not held back by one that cannot be written, nor is the event loop
+ *  kept spinning on it. The endpoint drops the partial message.
+ *
+ *  @return 0, for the transmit callback of the binding to return
+ */
+static int dropTx(Bus& bus, int rc)
+{
+    error("Dropped a packet on I2C bus {BUS}, error - {ERROR}", "BUS",
+          bus.number, "ERROR", strerror(-rc));
+    bus.txAttempts = 0;
+    if (!bus.txError)
+    {
+        bus.txError = rc;
+    }
+    return 0;
+}
+
+/** @brief Transmit up to a batch of queued fragments of a bus */
+static void pollTx(Bus& bus)
+{
+    for (size_t i = 0; i < bus.batch && txPending(bus); i++)
+    {
+        mctp_i2c_tx_poll(bus.i2c);
+    }
+}
+
+void recv(unsigned bus, uint8_t* buf, size_t len)
+{
+    if (auto b = findBus(bus))
+    {
+        mctp_i2c_rx(b->i2c, buf, len);
+    }
+}
+
+int getEventSource()
+{
+    return epollFd;
+}
+
+int receive(uint8_t& eid, void*& msg, size_t& len)
+{
+    processRx();
+
+    if (rxQueue.empty())
+    {
+        return -EAGAIN;
+    }
+
+    uint64_t count;
+    if (read(rxEventFd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+    {
+        perror("MCTP RX eventfd read");
+    }
+
+    auto& front = rxQueue.front();
+    eid = front.eid;
+    msg = front.msg.release();
+    len = front.len;
+    rxQueue.pop_front();
+    return 0;
 }
 
-namespace MCTP {
-    static const uint8_t I2C_ADDR = 0x21;
-    static const uint8_t EID = 0x50;
-    struct mctp *mctp;
-    struct mctp_binding_i2c *i2c;
-    static void rx(uint8_t src_eid, bool tag_owner, uint8_t msg_tag, void *ctx,
-        void *msg, size_t len);
-    static int tx(const void *buf, size_t len, void *ctx);
-    void recv(uint8_t *buf, size_t len) {
-        mctp_i2c_rx(i2c, buf, len);
-    }
-    ;
-    void send(uint8_t eid, const uint8_t *buf, size_t len) {
-        eid = 0x51;
-        mctp_message_tx(mctp, eid, true, 2, buf, len);
-        while (!mctp_is_tx_ready(mctp, eid)) {
-            mctp_i2c_tx_poll(i2c);
+int send(uint8_t eid, const uint8_t* buf, size_t len)
+{
+    if (!len)
+    {
+        return -EINVAL;
+    }
+
+    auto route = routes.find(eid);
+    if (route == routes.end())
+    {
+        return -EHOSTUNREACH;
+    }
+    auto& bus = *route->second;
+
+    bool tagOwner = buf[0] & PLDM_REQUEST_BIT;
+    uint8_t tag = 0;
+    if (tagOwner)
+    {
+        tag = nextTag;
+        nextTag = (nextTag == MCTP_TAG_MAX) ? 0 : nextTag + 1;
+    }
+    else if (auto it = rxTags.find(
+                 {eid, static_cast<uint8_t>(buf[0] & PLDM_INSTANCE_ID_MASK)});
+             it != rxTags.end())
+    {
+        tag = it->second;
+        rxTags.erase(it);
+    }
+
+    std::vector<uint8_t> mctpMsg;
+    mctpMsg.reserve(len + 1);
+    mctpMsg.push_back(MCTP_MSG_TYPE_PLDM);
+    mctpMsg.insert(mctpMsg.end(), buf, buf + len);
+
+    int rc = mctp_message_tx(bus.mctp, eid, tagOwner, tag, mctpMsg.data(),
+                             mctpMsg.size());
+    if (rc)
+    {
+        return rc;
+    }
+    bus.txEids.insert(eid);
+    armTx();
+    return 0;
+}
+
+bool txPending()
+{
+    bool pending = false;
+    for (auto& bus : buses)
+    {
+        pending = txPending(*bus) || pending;
+    }
+    return pending;
+}
+
+int getTxEventSource()
+{
+    return txEventFd;
+}
+
+void processTx()
+{
+    uint64_t count;
+    if (read(txEventFd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+    {
+        perror("MCTP TX eventfd read");
+    }
+
+    // One batch per bus and dispatch keeps other event sources serviced
+    // while a multi-packet message drains, and a busy bus from delaying the
+    // others.
+    bool pending = false;
+    for (auto& bus : buses)
+    {
+        if (txPending(*bus))
+        {
+            pollTx(*bus);
+            pending = txPending(*bus) || pending;
+        }
+    }
+
+    if (pending)
+    {
+        armTx();
+    }
+}
+
+int flush()
+{
+    for (auto& bus : buses)
+    {
+        bus->txError = 0;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + TX_FLUSH_TIMEOUT;
+    while (txPending())
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            error("Timed out writing the queued MCTP packets");
+            processTx();
+            return -ETIMEDOUT;
+        }
+        for (auto& bus : buses)
+        {
+            if (!bus->txEids.empty())
+            {
+                pollTx(*bus);
+            }
+        }
+    }
+    processTx();
+
+    for (auto& bus : buses)
+    {
+        if (bus->txError)
+        {
+            return bus->txError;
+        }
+    }
+    return 0;
+}
+
+/** @brief Read the buses and the routing table
+ *
+ *  @param[in] path - path of the JSON configuration, see init()
+ *  @param[out] routeTable - the routes of the configuration
+ *
+ *  @return the buses, std::nullopt if the file is missing or invalid
+ */
+static std::optional<std::vector<std::unique_ptr<Bus>>>
+    parseConfig(const std::filesystem::path& path,
+                std::vector<Route>& routeTable)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return std::nullopt;
+    }
+
+    auto json = nlohmann::json::parse(file, nullptr, false);
+    if (json.is_discarded() || !json.contains("buses"))
+    {
+        error("Failed to parse the MCTP I2C config '{PATH}'", "PATH", path);
+        return std::nullopt;
+    }
+
+    std::vector<std::unique_ptr<Bus>> config;
+    try
+    {
+        auto eid = json.value("eid", DEFAULT_EID);
+        for (const auto& entry : json["buses"])
+        {
+            auto bus = std::make_unique<Bus>();
+            bus->number = entry.at("bus").get<unsigned>();
+            bus->address = entry.at("address").get<uint8_t>();
+            bus->eid = entry.value("eid", eid);
+            bus->batch = std::clamp<size_t>(entry.value("batch", 1), 1,
+                                            I2C_RDWR_IOCTL_MAX_MSGS);
+            bus->slaveQueue = entry.value(
+                "slave_queue",
+                std::format("/sys/bus/i2c/devices/{}-{:04x}/slave-mqueue",
+                            bus->number, I2C_SLAVE_ADDR_FLAG | bus->address));
+            config.push_back(std::move(bus));
         }
+        for (const auto& entry : json.value("routes", nlohmann::json::array()))
+        {
+            routeTable.emplace_back(entry.at("eid").get<uint8_t>(),
+                                    entry.at("bus").get<unsigned>(),
+                                    entry.at("address").get<uint8_t>());
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error("Invalid entry in the MCTP I2C config '{PATH}', error - {ERROR}",
+              "PATH", path, "ERROR", e);
+        return std::nullopt;
     }
+
+    if (config.empty())
+    {
+        error("No bus in the MCTP I2C config '{PATH}'", "PATH", path);
+        return std::nullopt;
+    }
+    return config;
 }
 
-void MCTP::init() {
+/** @brief Set up the core and the binding of a bus, and add its slave queue
+ *         to the epoll set
+ */
+static void setupBus(Bus& bus)
+{
+    bus.mctp = mctp_init();
+    assert(bus.mctp);
+    bus.i2c = reinterpret_cast<struct mctp_binding_i2c*>(
+        malloc(sizeof(struct mctp_binding_i2c)));
+    assert(bus.i2c);
+
+    auto device = std::format("/dev/i2c-{}", bus.number);
+    if ((bus.busFd = i2c_open(device.c_str())) == -1)
+    {
+        error("Failed to open the I2C bus {BUS}", "BUS", device);
+    }
+
+    bus.slaveFd =
+        open(bus.slaveQueue.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (bus.slaveFd < 0)
+    {
+        error("Failed to open the I2C slave queue {PATH}, errno - {ERRNO}",
+              "PATH", bus.slaveQueue, "ERRNO", errno);
+    }
+    else
+    {
+        // sysfs attributes are always POLLIN, new data is flagged by POLLPRI
+        struct epoll_event ev{};
+        ev.events = EPOLLPRI;
+        ev.data.fd = bus.slaveFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, bus.slaveFd, &ev);
+    }
+
+    mctp_i2c_setup(bus.i2c, bus.address, tx, &bus);
+    mctp_register_bus(bus.mctp, mctp_binding_i2c_core(bus.i2c), bus.eid);
+    mctp_set_rx_all(bus.mctp, rx, &bus);
+}
+
+} // namespace MCTP
+
+void MCTP::init(const std::filesystem::path& config)
+{
+    if (!buses.empty())
+    {
+        return;
+    }
+
     mctp_set_log_stdio(MCTP_LOG_DEBUG);
-    mctp = mctp_init();
-    assert(mctp);
-    i2c = reinterpret_cast<struct mctp_binding_i2c *>(malloc(
-        sizeof(struct mctp_binding_i2c)));
-    assert(i2c);
 
-    mctp_i2c_setup(i2c, I2C_ADDR, tx, NULL);
-    mctp_register_bus(mctp, mctp_binding_i2c_core(i2c), EID);
-    mctp_set_rx_all(mctp, rx, NULL);
-    mctp_i2c_set_neighbour(i2c, 0x51, 0x22);
+    std::vector<Route> routeTable;
+    if (auto parsed = parseConfig(config, routeTable))
+    {
+        buses = std::move(*parsed);
+    }
+    else
+    {
+        routeTable.clear();
+        auto bus = std::make_unique<Bus>();
+        bus->number = DEFAULT_I2C_BUS;
+        bus->address = DEFAULT_I2C_ADDR;
+        bus->eid = DEFAULT_EID;
+        bus->slaveQueue = std::format(
+            "/sys/bus/i2c/devices/{}-{:04x}/slave-mqueue", DEFAULT_I2C_BUS,
+            I2C_SLAVE_ADDR_FLAG | DEFAULT_I2C_ADDR);
+        buses.push_back(std::move(bus));
+        routeTable.emplace_back(DEFAULT_ROUTE_EID, DEFAULT_I2C_BUS,
+                                DEFAULT_ROUTE_ADDR);
+    }
+
+    txEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    assert(txEventFd >= 0);
+    rxEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC | EFD_SEMAPHORE);
+    assert(rxEventFd >= 0);
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    assert(epollFd >= 0);
+
+    struct epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = rxEventFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, rxEventFd, &ev);
+
+    for (auto& bus : buses)
+    {
+        setupBus(*bus);
+    }
+
+    for (const auto& route : routeTable)
+    {
+        auto bus = findBus(route.bus);
+        if (!bus)
+        {
+            error("No bus {BUS} for the route to EID {EID}", "BUS", route.bus,
+                  "EID", route.eid);
+            continue;
+        }
+        if (mctp_i2c_set_neighbour(bus->i2c, route.eid, route.address))
+        {
+            error("Failed to add the neighbour EID {EID} on bus {BUS}", "EID",
+                  route.eid, "BUS", route.bus);
+            continue;
+        }
+        routes[route.eid] = bus;
+    }
 }
 
 static void MCTP::rx(uint8_t src_eid, bool tag_owner, uint8_t msg_tag,
-    void *ctx, void *msg, size_t len) {
-    printf("I2C RX\n");
-}
+                     void* ctx, void* msg, size_t len)
+{
+    auto data = static_cast<const uint8_t*>(msg);
+    if (len < 2 || data[0] != MCTP_MSG_TYPE_PLDM)
+    {
+        return;
+    }
 
-static int MCTP::tx(const void *buf, size_t len, void *ctx) {
-    auto data = reinterpret_cast<const uint8_t *>(buf);
+    // The binding learns the address of the sender, reply on the same bus
+    routes.try_emplace(src_eid, static_cast<Bus*>(ctx));
 
-    int bus;
-    if ((bus = i2c_open("/dev/i2c-1")) == -1) {
+    if (tag_owner)
+    {
+        uint8_t instanceId = data[1] & PLDM_INSTANCE_ID_MASK;
+        rxTags[{src_eid, instanceId}] = msg_tag;
+    }
 
-        printf("libi2c error\n");
+    // libmctp frees its reassembly buffer once the callback returns, and
+    // the PLDM message starts after the MCTP message type byte: the message
+    // is copied once here, recvMsg() then hands this copy over as is
+    std::unique_ptr<uint8_t, decltype(&free)> copy(
+        static_cast<uint8_t*>(malloc(len - 1)), free);
+    if (!copy)
+    {
+        return;
     }
+    std::memcpy(copy.get(), data + 1, len - 1);
+    rxQueue.emplace_back(src_eid, std::move(copy), len - 1);
 
-    printf("antes   ");
-    for (size_t i = 0; i < len; i++) {
-        printf("%d ", data[i]);
+    uint64_t one = 1;
+    if (write(rxEventFd, &one, sizeof(one)) < 0)
+    {
+        perror("MCTP RX eventfd write");
     }
-    std::vector<uint8_t> miau(len);
-    memcpy(miau.data(), data, len);
-    auto hdr = reinterpret_cast<struct mctp_i2c_hdr *>(miau.data());
-    hdr->dest = i2c->own_addr << 1;
-    hdr->source = ((i2c->own_addr + 1) << 1) + 1;
-    miau.data()[5] = 80;
-    miau.data()[6] = 81;
+}
+
+static int MCTP::tx(const void* buf, size_t len, void* ctx)
+{
+    auto& bus = *static_cast<Bus*>(ctx);
+    auto data = reinterpret_cast<const uint8_t*>(buf);
+    auto hdr = reinterpret_cast<const struct mctp_i2c_hdr*>(data);
 
-    printf("\ndespues ");
-    for (size_t i = 0; i < len; i++) {
-        printf("%d ", miau.data()[i]);
+    if (bus.busFd == -1)
+    {
+        return dropTx(bus, -EBADF);
+    }
+    if (len <= sizeof(struct mctp_i2c_hdr) || len - 1 > I2C_PACKET_SIZE)
+    {
+        return dropTx(bus, -EINVAL);
     }
-    printf(" tx\n");
 
-    mctp_i2c_rx(i2c, miau.data(), len);
+    // The destination address byte is carried by the I2C transaction itself.
+    // Each packet is a transaction of its own, ended by a STOP condition, as
+    // the i2c-slave-mqueue receivers only queue a packet on a STOP.
+    struct i2c_msg msg{};
+    msg.addr = hdr->dest >> 1;
+    msg.flags = 0;
+    msg.len = len - 1;
+    msg.buf = const_cast<uint8_t*>(data + 1);
 
+    struct i2c_rdwr_ioctl_data xfer{};
+    xfer.msgs = &msg;
+    xfer.nmsgs = 1;
+    if (ioctl(bus.busFd, I2C_RDWR, &xfer) < 0)
+    {
+        int rc = -errno;
+        error(
+            "Failed to write a packet to address {ADDRESS} on I2C bus {BUS}, attempt {ATTEMPT}, error - {ERROR}",
+            "ADDRESS", msg.addr, "BUS", bus.number, "ATTEMPT",
+            bus.txAttempts + 1, "ERROR", strerror(-rc));
+        // A lost arbitration or a busy endpoint may clear, the packet is
+        // kept for the next pass, up to TX_ATTEMPTS_MAX times
+        if (++bus.txAttempts < TX_ATTEMPTS_MAX)
+        {
+            return rc;
+        }
+        return dropTx(bus, rc);
+    }
+    bus.txAttempts = 0;
     return 0;
-}
\ No newline at end of file
+}
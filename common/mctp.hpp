@@ -1,10 +1,117 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <vector>
 
-namespace MCTP {
-    void init();
+namespace MCTP
+{
 
-    void recv(uint8_t *buf, size_t len);
-    void send(uint8_t eid, const uint8_t *buf, size_t len);
-}
\ No newline at end of file
+/** @brief Initialise one MCTP core and I2C binding per configured bus
+ *
+ *  The buses and the routing table are read from a JSON file like
+ *
+ *  {
+ *      "eid": 80,
+ *      "buses": [{ "bus": 1, "address": 33 }],
+ *      "routes": [{ "eid": 81, "bus": 1, "address": 34 }]
+ *  }
+ *
+ *  where "address" is the 7-bit I2C address, of the BMC on a bus or of the
+ *  endpoint in a route. A bus may set its own "eid" and "slave_queue", the
+ *  i2c-slave-mqueue file backing its address, and "batch", the number of
+ *  packets written back to back per processTx() pass (1 by default), each in
+ *  its own I2C transaction. Without the file, a single
+ *  binding on bus 1 reaching EID 0x51 is set up.
+ *
+ *  Opens the I2C adapters once and keeps the file descriptors for the
+ *  lifetime of the process. Calling init() more than once is a no-op.
+ *
+ *  @param[in] config - path of the JSON configuration
+ */
+void init(const std::filesystem::path& config = MCTP_I2C_CONFIG_JSON);
+
+/** @brief Feed a raw MCTP-over-I2C packet into the binding of a bus
+ *
+ *  @param[in] bus - I2C bus number the packet was received on
+ *  @param[in] buf - packet, starting with the destination address byte
+ *  @param[in] len - length of buf
+ */
+void recv(unsigned bus, uint8_t* buf, size_t len);
+
+/** @brief Provides a file descriptor that can be polled for readiness.
+ *
+ *  The descriptor is readable (POLLIN) when either a reassembled message is
+ *  queued or the I2C slave queue of any bus holds packets. A subsequent call to
+ *  receive() services the slave queue and yields a message if one is
+ *  complete.
+ *
+ *  @return The relevant file descriptor, -1 if not initialised
+ */
+int getEventSource();
+
+/** @brief Receive a reassembled PLDM message
+ *
+ *  The message is copied once out of libmctp, on reassembly, and handed
+ *  over as is.
+ *
+ *  @param[out] eid - source endpoint ID of the message
+ *  @param[out] msg - the PLDM message, without the MCTP message type byte,
+ *                    to be released with free()
+ *  @param[out] len - length of msg
+ *
+ *  @return 0 on success, -EAGAIN if no complete message is available
+ */
+int receive(uint8_t& eid, void*& msg, size_t& len);
+
+/** @brief Queue an MCTP message for transmission
+ *
+ *  The message is fragmented by libmctp and the fragments are queued on the
+ *  binding of the bus the routing table gives for eid. Endpoints missing
+ *  from the table are reachable once a message from them has been received.
+ *  Transmission is driven by processTx(), either from an event loop
+ *  watching getTxEventSource() or synchronously through flush().
+ *
+ *  @param[in] eid - destination endpoint ID
+ *  @param[in] buf - the PLDM message to send, the MCTP message type byte is
+ *                   prepended by the binding
+ *  @param[in] len - length of buf
+ *
+ *  @return 0 on success, -EHOSTUNREACH if eid has no route, negative errno
+ *          otherwise
+ */
+int send(uint8_t eid, const uint8_t* buf, size_t len);
+
+/** @brief Provides a file descriptor that becomes readable while there are
+ *         queued fragments waiting to be transmitted
+ *
+ *  @return The eventfd signalling pending transmission, -1 if not initialised
+ */
+int getTxEventSource();
+
+/** @brief Transmit the next queued fragment of every bus
+ *
+ *  Sends at most one fragment per bus, or one batch of them on the buses
+ *  configured so, so that a long message does not monopolise the event
+ *  loop, nor hold back the traffic of the other buses.
+ *  The TX event source stays readable while fragments remain.
+ */
+void processTx();
+
+/** @brief Synchronously transmit every queued fragment
+ *
+ *  Intended for tools that do not run an event loop.
+ *
+ *  @return 0 on success, the negative errno of the first fragment that could
+ *          not be written otherwise
+ */
+int flush();
+
+/** @brief Check whether fragments are still waiting to be transmitted
+ *
+ *  @return true if the TX queue of any bus is not empty
+ */
+bool txPending();
+
+} // namespace MCTP
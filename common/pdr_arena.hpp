@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace pldm
+{
+namespace pdr
+{
+
+/**
+ * @brief PdrArena
+ *
+ * Holds the raw PDRs of a terminus back to back in one contiguous buffer,
+ * indexed by the offset of each record, instead of one heap allocation per
+ * PDR. Records are read as spans which stay valid until the arena is
+ * modified.
+ */
+class PdrArena
+{
+  public:
+    using value_type = std::span<const uint8_t>;
+
+    class const_iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = PdrArena::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        const_iterator() = default;
+        const_iterator(const PdrArena* arena, size_t index) :
+            arena(arena), index(index)
+        {}
+
+        value_type operator*() const
+        {
+            return (*arena)[index];
+        }
+
+        const_iterator& operator++()
+        {
+            index++;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            auto it = *this;
+            index++;
+            return it;
+        }
+
+        bool operator==(const const_iterator&) const = default;
+
+      private:
+        const PdrArena* arena = nullptr;
+        size_t index = 0;
+    };
+
+    /** @brief Reserve room for the records of a repository
+     *
+     *  The sizes come from the terminus, so the reservation is capped and
+     *  the arena still grows past it when needed.
+     *
+     *  @param[in] count - number of records
+     *  @param[in] bytes - total size of the records
+     */
+    void reserve(size_t count, size_t bytes)
+    {
+        offsets.reserve(std::min(count, maxReservedRecords));
+        data.reserve(std::min(bytes, maxReservedBytes));
+    }
+
+    /** @brief Append a copy of a record */
+    void emplace_back(std::span<const uint8_t> pdr)
+    {
+        offsets.emplace_back(data.size());
+        data.insert(data.end(), pdr.begin(), pdr.end());
+    }
+
+    /** @brief Remove all the records */
+    void clear()
+    {
+        offsets.clear();
+        data.clear();
+    }
+
+    /** @brief Release the memory not used by the records */
+    void shrink_to_fit()
+    {
+        offsets.shrink_to_fit();
+        data.shrink_to_fit();
+    }
+
+    /** @brief Number of records */
+    size_t size() const
+    {
+        return offsets.size();
+    }
+
+    bool empty() const
+    {
+        return offsets.empty();
+    }
+
+    /** @brief Total size of the records in bytes */
+    size_t bytes() const
+    {
+        return data.size();
+    }
+
+    /** @brief Get the record at an index */
+    value_type operator[](size_t index) const
+    {
+        auto end = index + 1 < offsets.size() ? offsets[index + 1]
+                                              : data.size();
+        return value_type(data).subspan(offsets[index], end - offsets[index]);
+    }
+
+    const_iterator begin() const
+    {
+        return {this, 0};
+    }
+
+    const_iterator end() const
+    {
+        return {this, size()};
+    }
+
+    bool operator==(const PdrArena&) const = default;
+
+  private:
+    static constexpr size_t maxReservedRecords = 4096;
+    static constexpr size_t maxReservedBytes = 1024 * 1024;
+
+    /** @brief Offset of each record in data */
+    std::vector<uint32_t> offsets;
+
+    /** @brief The records back to back */
+    std::vector<uint8_t> data;
+};
+
+} // namespace pdr
+} // namespace pldm
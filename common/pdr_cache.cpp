@@ -0,0 +1,213 @@
+#include "pdr_cache.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <limits>
+#include <system_error>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace pdr
+{
+
+namespace
+{
+
+/** @brief Magic identifying a PDR cache file */
+constexpr std::array<char, 8> pdrCacheMagic = {'P', 'L', 'D', 'M',
+                                               'P', 'D', 'R', 'C'};
+constexpr uint32_t pdrCacheVersion = 1;
+
+/** @brief Largest PDR a cache entry may hold, header plus 16-bit data length */
+constexpr size_t maxCachedPdrSize =
+    sizeof(pldm_pdr_hdr) + std::numeric_limits<uint16_t>::max();
+
+template <typename T>
+void writeValue(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool readValue(std::ifstream& file, T& value)
+{
+    return static_cast<bool>(
+        file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+void writeSignature(std::ofstream& file,
+                    const PdrRepositorySignature& signature)
+{
+    writeValue(file, signature.updateTime);
+    writeValue(file, signature.oemUpdateTime);
+    writeValue(file, signature.recordCount);
+    writeValue(file, signature.repositorySize);
+    writeValue(file, signature.largestRecordSize);
+}
+
+bool readSignature(std::ifstream& file, PdrRepositorySignature& signature)
+{
+    return readValue(file, signature.updateTime) &&
+           readValue(file, signature.oemUpdateTime) &&
+           readValue(file, signature.recordCount) &&
+           readValue(file, signature.repositorySize) &&
+           readValue(file, signature.largestRecordSize);
+}
+
+} // namespace
+
+std::filesystem::path PdrCache::entryPath(const std::string& key) const
+{
+    std::string name = key;
+    std::ranges::replace_if(
+        name,
+        [](char c) {
+            return !std::isalnum(static_cast<unsigned char>(c)) && c != '-' &&
+                   c != '_';
+        },
+        '_');
+    return dir / (name + ".pdr");
+}
+
+std::optional<PdrArena> PdrCache::load(
+    const std::string& key, const PdrRepositorySignature& signature) const
+{
+    if (!enabled())
+    {
+        return std::nullopt;
+    }
+
+    auto path = entryPath(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return std::nullopt;
+    }
+
+    std::array<char, 8> magic{};
+    uint32_t version = 0;
+    PdrRepositorySignature cachedSignature{};
+    uint32_t pdrCount = 0;
+    if (!readValue(file, magic) || !readValue(file, version) ||
+        !readSignature(file, cachedSignature) || !readValue(file, pdrCount))
+    {
+        lg2::error("Truncated PDR cache file {PATH}", "PATH",
+                   path.string());
+        return std::nullopt;
+    }
+
+    if (magic != pdrCacheMagic || version != pdrCacheVersion)
+    {
+        lg2::error("Unsupported PDR cache file {PATH}", "PATH",
+                   path.string());
+        return std::nullopt;
+    }
+
+    if (cachedSignature != signature)
+    {
+        lg2::info("PDR cache of {KEY} is stale", "KEY", key);
+        return std::nullopt;
+    }
+
+    PdrArena pdrs;
+    pdrs.reserve(std::min(pdrCount, signature.recordCount),
+                 signature.repositorySize);
+    std::vector<uint8_t> pdr;
+    for (uint32_t i = 0; i < pdrCount; i++)
+    {
+        uint32_t length = 0;
+        if (!readValue(file, length) || length < sizeof(pldm_pdr_hdr) ||
+            length > maxCachedPdrSize)
+        {
+            lg2::error("Corrupted PDR cache file {PATH}", "PATH",
+                       path.string());
+            return std::nullopt;
+        }
+
+        pdr.resize(length);
+        if (!file.read(reinterpret_cast<char*>(pdr.data()), length))
+        {
+            lg2::error("Truncated PDR cache file {PATH}", "PATH",
+                       path.string());
+            return std::nullopt;
+        }
+        pdrs.emplace_back(pdr);
+    }
+
+    return pdrs;
+}
+
+bool PdrCache::store(const std::string& key,
+                     const PdrRepositorySignature& signature,
+                     const PdrArena& pdrs) const
+{
+    if (!enabled())
+    {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (ec)
+    {
+        lg2::error("Failed to create PDR cache directory {DIR}, error {ERROR}",
+                   "DIR", dir.string(), "ERROR", ec.message());
+        return false;
+    }
+
+    /* Write a temporary file and rename it, a crash must not leave a
+     * partially written entry behind */
+    auto path = entryPath(key);
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        writeValue(file, pdrCacheMagic);
+        writeValue(file, pdrCacheVersion);
+        writeSignature(file, signature);
+        writeValue(file, static_cast<uint32_t>(pdrs.size()));
+        for (auto pdr : pdrs)
+        {
+            writeValue(file, static_cast<uint32_t>(pdr.size()));
+            file.write(reinterpret_cast<const char*>(pdr.data()), pdr.size());
+        }
+        file.close();
+        if (!file)
+        {
+            lg2::error("Failed to write PDR cache file {PATH}", "PATH",
+                       tmpPath.string());
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec)
+    {
+        lg2::error("Failed to update PDR cache file {PATH}, error {ERROR}",
+                   "PATH", path.string(), "ERROR", ec.message());
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+void PdrCache::remove(const std::string& key) const
+{
+    if (!enabled())
+    {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(entryPath(key), ec);
+}
+
+} // namespace pdr
+} // namespace pldm
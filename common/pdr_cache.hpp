@@ -0,0 +1,94 @@
+#pragma once
+
+#include "pdr_arena.hpp"
+
+#include <libpldm/platform.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace pldm
+{
+namespace pdr
+{
+
+/** @struct PdrRepositorySignature
+ *
+ *  The GetPDRRepositoryInfo fields a cached PDR set is validated against.
+ *  A terminus changing its repository must change at least one of them.
+ */
+struct PdrRepositorySignature
+{
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> updateTime{};
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> oemUpdateTime{};
+    uint32_t recordCount = 0;
+    uint32_t repositorySize = 0;
+    uint32_t largestRecordSize = 0;
+
+    bool operator==(const PdrRepositorySignature&) const = default;
+};
+
+/**
+ * @brief PdrCache
+ *
+ * Keeps the PDRs fetched from each terminus on disk, one file per terminus
+ * identity, so an unchanged terminus does not need to transfer its whole
+ * repository again after a restart of pldmd or an MCTP reset.
+ */
+class PdrCache
+{
+  public:
+    PdrCache() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] dir - Directory holding the cache files, empty to disable
+     *                   the cache
+     */
+    explicit PdrCache(const std::filesystem::path& dir) : dir(dir) {}
+
+    /** @brief Check if the cache is enabled */
+    bool enabled() const
+    {
+        return !dir.empty();
+    }
+
+    /** @brief Load the PDRs cached for a terminus
+     *
+     *  @param[in] key - Stable identity of the terminus
+     *  @param[in] signature - Current signature of the terminus repository
+     *  @return the cached PDRs, std::nullopt if there is no entry, the entry
+     *          is corrupted or was stored for a different signature
+     */
+    std::optional<PdrArena> load(
+        const std::string& key, const PdrRepositorySignature& signature) const;
+
+    /** @brief Store the PDRs of a terminus, replacing any previous entry
+     *
+     *  @param[in] key - Stable identity of the terminus
+     *  @param[in] signature - Signature of the repository the PDRs came from
+     *  @param[in] pdrs - PDRs of the terminus
+     *  @return true if the entry was written
+     */
+    bool store(const std::string& key, const PdrRepositorySignature& signature,
+               const PdrArena& pdrs) const;
+
+    /** @brief Remove the entry of a terminus
+     *
+     *  @param[in] key - Stable identity of the terminus
+     */
+    void remove(const std::string& key) const;
+
+  private:
+    /** @brief Path of the cache file of a terminus */
+    std::filesystem::path entryPath(const std::string& key) const;
+
+    /** @brief Directory holding the cache files */
+    std::filesystem::path dir;
+};
+
+} // namespace pdr
+} // namespace pldm
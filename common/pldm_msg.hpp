@@ -0,0 +1,111 @@
+#pragma once
+
+#include "common/types.hpp"
+
+#include <libpldm/base.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+
+/** @class RequestMsg
+ *
+ *  An encoded PLDM request message owning its bytes. Messages of up to
+ *  inlineBytes are kept in the object itself, on the stack or within the
+ *  structure holding it, so building and queueing them allocates nothing.
+ *  Longer messages, and pldm::Request vectors handed over, live on the heap.
+ */
+class RequestMsg
+{
+  public:
+    /** @brief Longest message kept without heap allocation */
+    static constexpr size_t inlineBytes = 64;
+
+    RequestMsg() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] size - length of the message, header included, zeroed
+     */
+    explicit RequestMsg(size_t size) : len(size)
+    {
+        if (size > inlineBytes)
+        {
+            heap.resize(size);
+        }
+    }
+
+    /** @brief Take over an encoded message without copy
+     *
+     *  @param[in] request - the message
+     */
+    RequestMsg(pldm::Request&& request) :
+        len(request.size()), heap(std::move(request))
+    {}
+
+    /** @brief The bytes of the message */
+    uint8_t* data()
+    {
+        return heap.empty() ? local.data() : heap.data();
+    }
+
+    /** @brief The bytes of the message */
+    const uint8_t* data() const
+    {
+        return heap.empty() ? local.data() : heap.data();
+    }
+
+    /** @brief Length of the message, header included */
+    size_t size() const
+    {
+        return len;
+    }
+
+    /** @brief The message, for the libpldm encoders */
+    pldm_msg* msg()
+    {
+        return reinterpret_cast<pldm_msg*>(data());
+    }
+
+    /** @brief The message, for the libpldm decoders */
+    const pldm_msg* msg() const
+    {
+        return reinterpret_cast<const pldm_msg*>(data());
+    }
+
+    operator std::span<const uint8_t>() const
+    {
+        return {data(), size()};
+    }
+
+  private:
+    size_t len = 0;
+    std::array<uint8_t, inlineBytes> local{};
+    std::vector<uint8_t> heap;
+};
+
+/** @class PldmMsg
+ *
+ *  A PLDM request message of a payload size known at compile time, always
+ *  kept without heap allocation. It is a RequestMsg and is handed to the
+ *  requester handler as such.
+ *
+ *  @tparam PayloadBytes - length of the payload, PLDM_*_REQ_BYTES
+ */
+template <size_t PayloadBytes>
+class PldmMsg : public RequestMsg
+{
+  public:
+    static_assert(sizeof(pldm_msg_hdr) + PayloadBytes <= inlineBytes,
+                  "Use a RequestMsg for longer messages");
+
+    PldmMsg() : RequestMsg(sizeof(pldm_msg_hdr) + PayloadBytes) {}
+};
+
+} // namespace pldm
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace pldm
+{
+namespace utils
+{
+
+/**
+ * @brief ServiceCache
+ *
+ * Least recently used cache of the D-Bus service names owning an interface
+ * of an object path, as resolved by the ObjectMapper. An empty interface
+ * stands for a lookup without interface.
+ */
+class ServiceCache
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] capacity - number of entries, 0 disables the cache
+     */
+    explicit ServiceCache(size_t capacity = 0) : maxEntries(capacity) {}
+
+    /** @brief Get the service of an object path and interface
+     *
+     *  @return the service, std::nullopt if it is not cached
+     */
+    std::optional<std::string> get(const std::string& path,
+                                   const std::string& interface)
+    {
+        auto it = index.find(makeKey(path, interface));
+        if (it == index.end())
+        {
+            return std::nullopt;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->service;
+    }
+
+    /** @brief Cache the service of an object path and interface, evicting
+     *         the least recently used entry when the cache is full
+     */
+    void insert(const std::string& path, const std::string& interface,
+                const std::string& service)
+    {
+        if (!maxEntries)
+        {
+            return;
+        }
+
+        auto key = makeKey(path, interface);
+        if (auto it = index.find(key); it != index.end())
+        {
+            it->second->service = service;
+            entries.splice(entries.begin(), entries, it->second);
+            return;
+        }
+
+        if (entries.size() >= maxEntries)
+        {
+            index.erase(makeKey(entries.back().path, entries.back().interface));
+            entries.pop_back();
+        }
+        entries.emplace_front(path, interface, service);
+        index.emplace(std::move(key), entries.begin());
+    }
+
+    /** @brief Drop the entries of an object path */
+    void erasePath(const std::string& path)
+    {
+        eraseIf([&path](const Entry& entry) { return entry.path == path; });
+    }
+
+    /** @brief Drop the entries resolved to a service */
+    void eraseService(const std::string& service)
+    {
+        eraseIf([&service](const Entry& entry) {
+            return entry.service == service;
+        });
+    }
+
+    /** @brief Drop all the entries */
+    void clear()
+    {
+        entries.clear();
+        index.clear();
+    }
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    size_t capacity() const
+    {
+        return maxEntries;
+    }
+
+  private:
+    struct Entry
+    {
+        Entry(std::string path, std::string interface, std::string service) :
+            path(std::move(path)), interface(std::move(interface)),
+            service(std::move(service))
+        {}
+
+        std::string path;
+        std::string interface;
+        std::string service;
+    };
+
+    static std::string makeKey(const std::string& path,
+                               const std::string& interface)
+    {
+        std::string key;
+        key.reserve(path.size() + interface.size() + 1);
+        key.append(path).push_back('\0');
+        key.append(interface);
+        return key;
+    }
+
+    template <typename Pred>
+    void eraseIf(Pred pred)
+    {
+        for (auto it = entries.begin(); it != entries.end();)
+        {
+            if (pred(*it))
+            {
+                index.erase(makeKey(it->path, it->interface));
+                it = entries.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    size_t maxEntries;
+
+    /** @brief Entries, the most recently used first */
+    std::list<Entry> entries;
+
+    /** @brief Entries keyed by object path and interface */
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+};
+
+} // namespace utils
+} // namespace pldm
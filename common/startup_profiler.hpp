@@ -0,0 +1,185 @@
+#pragma once
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace stats
+{
+
+/** @struct StartupTiming
+ *
+ *  When a startup phase ended, from the start of pldmd, and how long it
+ *  took, 0 for a milestone.
+ */
+struct StartupTiming
+{
+    std::chrono::microseconds at;
+    std::chrono::microseconds duration;
+};
+
+/** @class StartupProfiler
+ *
+ *  Timings of the startup of pldmd: the phases run before the event loop,
+ *  the ones triggered lazily once it runs, as the PDR repository build, the
+ *  first GetPDR or the discovery of the termini, and the Ready milestone,
+ *  reached once every required milestone is. Only the first occurrence of a
+ *  phase is kept, a terminus coming back later does not move its timings.
+ *  Each timing is logged when recorded.
+ */
+class StartupProfiler
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    StartupProfiler(const StartupProfiler&) = delete;
+    StartupProfiler& operator=(const StartupProfiler&) = delete;
+
+    /** @brief The profiler, the first call is the start of pldmd */
+    static StartupProfiler& getInstance()
+    {
+        static StartupProfiler profiler;
+        return profiler;
+    }
+
+    /** @brief Record a phase ending now
+     *
+     *  @param[in] name - name of the phase
+     *  @param[in] begin - when the phase began
+     *
+     *  @return now, the beginning of a phase following this one
+     */
+    Clock::time_point phase(std::string_view name, Clock::time_point begin)
+    {
+        auto now = Clock::now();
+        if (timings.contains(name))
+        {
+            return now;
+        }
+        StartupTiming timing{
+            std::chrono::duration_cast<std::chrono::microseconds>(now - start),
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                now - std::max(begin, start))};
+        timings.emplace(name, timing);
+        info(
+            "Startup phase {PHASE} took {DURATION_US} us, done at {AT_US} us",
+            "PHASE", name, "DURATION_US", timing.duration.count(), "AT_US",
+            timing.at.count());
+        notify(name);
+        checkReady();
+        return now;
+    }
+
+    /** @brief Record a milestone reached now
+     *
+     *  @param[in] name - name of the milestone
+     */
+    void milestone(std::string_view name)
+    {
+        phase(name, Clock::now());
+    }
+
+    /** @brief Set the milestones pldmd is ready after
+     *
+     *  @param[in] names - names of the milestones
+     */
+    void require(std::initializer_list<std::string_view> names)
+    {
+        required.insert(names.begin(), names.end());
+        checkReady();
+    }
+
+    /** @brief Call a callback once a phase or milestone is recorded, right
+     *         away if it already is
+     *
+     *  @param[in] name - name of the phase or milestone, Ready included
+     *  @param[in] callback - the callback
+     */
+    void whenReached(std::string_view name, std::function<void()>&& callback)
+    {
+        if (timings.contains(name))
+        {
+            callback();
+            return;
+        }
+        waiting.emplace(name, std::move(callback));
+    }
+
+    /** @brief Time from the start of pldmd to the Ready milestone, if
+     *         reached
+     */
+    std::optional<std::chrono::microseconds> getReady() const
+    {
+        auto it = timings.find(readyMilestone);
+        if (it == timings.end())
+        {
+            return std::nullopt;
+        }
+        return it->second.at;
+    }
+
+    /** @brief The timings recorded, by phase */
+    const std::map<std::string, StartupTiming, std::less<>>& getTimings() const
+    {
+        return timings;
+    }
+
+    static constexpr auto readyMilestone = "Ready";
+
+  private:
+    StartupProfiler() : start(Clock::now()) {}
+
+    void checkReady()
+    {
+        if (required.empty() || timings.contains(readyMilestone) ||
+            !std::ranges::all_of(required, [this](const auto& name) {
+                return timings.contains(name);
+            }))
+        {
+            return;
+        }
+        auto at = std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - start);
+        timings.emplace(readyMilestone,
+                        StartupTiming{at, std::chrono::microseconds(0)});
+        info("pldmd ready after {DURATION_US} us", "DURATION_US", at.count());
+        notify(readyMilestone);
+    }
+
+    /** @brief Call the callbacks waiting for a phase just recorded */
+    void notify(std::string_view name)
+    {
+        auto [first, last] = waiting.equal_range(name);
+        std::vector<std::function<void()>> callbacks;
+        for (auto it = first; it != last; ++it)
+        {
+            callbacks.emplace_back(std::move(it->second));
+        }
+        waiting.erase(first, last);
+        for (auto& callback : callbacks)
+        {
+            callback();
+        }
+    }
+
+    Clock::time_point start;
+    std::map<std::string, StartupTiming, std::less<>> timings;
+    std::set<std::string, std::less<>> required;
+    std::multimap<std::string, std::function<void()>, std::less<>> waiting;
+};
+
+} // namespace stats
+} // namespace pldm
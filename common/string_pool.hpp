@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @class StringPool
+ *
+ *  One copy of each string repeated across termini and sensors, such as the
+ *  language tags of the auxiliary names. Interned strings live as long as
+ *  pldmd and are never moved, views of them stay valid.
+ *
+ *  pldmd handles the termini on one thread, the pool is not locked.
+ */
+class StringPool
+{
+  public:
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    static StringPool& getInstance()
+    {
+        static StringPool pool;
+        return pool;
+    }
+
+    /** @brief Get the pooled copy of a string
+     *
+     *  @param[in] value - the string
+     *
+     *  @return a view of the pooled copy, equal to value
+     */
+    std::string_view intern(std::string_view value)
+    {
+        if (auto it = strings.find(value); it != strings.end())
+        {
+            return *it;
+        }
+        return *strings.emplace(value).first;
+    }
+
+    /** @brief Number of distinct strings pooled */
+    size_t size() const
+    {
+        return strings.size();
+    }
+
+  private:
+    struct Hash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view value) const
+        {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    /** @brief Nodes of an unordered_set are not moved by a rehash */
+    std::unordered_set<std::string, Hash, std::equal_to<>> strings;
+};
+
+} // namespace utils
+} // namespace pldm
@@ -0,0 +1,77 @@
+#include "common/event_log_limiter.hpp"
+
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+constexpr EventLogKey sensorKey{EventLogSource::Threshold, 1, 10, 0};
+constexpr EventLogKey otherKey{EventLogSource::Threshold, 1, 11, 0};
+
+} // namespace
+
+TEST(EventLogLimiter, repeatedEventsAreSummarized)
+{
+    auto event = sdeventplus::Event::get_new();
+    EventLogLimiter limiter(event, 1s);
+
+    std::vector<uint64_t> summaries;
+    auto makeSummary = [&summaries]() {
+        return [&summaries](uint64_t suppressed, std::chrono::seconds) {
+            summaries.emplace_back(suppressed);
+        };
+    };
+
+    EXPECT_TRUE(limiter.admit(sensorKey, makeSummary));
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_FALSE(limiter.admit(sensorKey, makeSummary));
+    }
+    EXPECT_TRUE(limiter.admit(otherKey, makeSummary));
+    EXPECT_EQ(limiter.getSuppressed(), 5u);
+
+    // The interval ends with one summary, of the key with repeated events
+    while (summaries.empty())
+    {
+        event.run(std::nullopt);
+    }
+    ASSERT_EQ(summaries.size(), 1u);
+    EXPECT_EQ(summaries[0], 5u);
+
+    // The events keep being counted until an interval without any
+    EXPECT_FALSE(limiter.admit(sensorKey, makeSummary));
+    while (summaries.size() < 2)
+    {
+        event.run(std::nullopt);
+    }
+    EXPECT_EQ(summaries[1], 1u);
+    event.run(1500ms);
+    event.run(1500ms);
+    EXPECT_TRUE(limiter.admit(sensorKey, makeSummary));
+}
+
+TEST(EventLogLimiter, zeroIntervalLogsEveryEvent)
+{
+    auto event = sdeventplus::Event::get_new();
+    EventLogLimiter limiter(event, 0s);
+
+    int made = 0;
+    auto makeSummary = [&made]() {
+        made++;
+        return [](uint64_t, std::chrono::seconds) {};
+    };
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_TRUE(limiter.admit(sensorKey, makeSummary));
+    }
+    EXPECT_EQ(made, 0);
+    EXPECT_EQ(limiter.getSuppressed(), 0u);
+}
@@ -0,0 +1,58 @@
+#include "common/json_cache.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+namespace fs = std::filesystem;
+
+TEST(JsonCache, preloadAndTake)
+{
+    auto dir = fs::temp_directory_path() / "pldm_json_cache_test";
+    fs::create_directories(dir);
+    std::ofstream(dir / "a.json") << R"({"entries": [1, 2]})";
+    std::ofstream(dir / "b.json") << R"({"entries": [3]})";
+    std::ofstream(dir / "bad.json") << R"({"entries": )";
+    std::ofstream(dir / "notes.txt") << "not a config";
+
+    auto& cache = JsonCache::getInstance();
+    auto stats = cache.preload({dir, dir / "missing.json"});
+    EXPECT_EQ(stats.files, 2);
+    EXPECT_EQ(stats.failed, 1);
+    EXPECT_GT(stats.bytes, 0);
+
+    auto a = cache.take(dir / "a.json");
+    ASSERT_TRUE(a.has_value());
+    EXPECT_EQ(a->at("entries").size(), 2);
+    // A file is taken once, later reads go to disk
+    EXPECT_FALSE(cache.take(dir / "a.json").has_value());
+    EXPECT_EQ(cache.parse(dir / "a.json").at("entries").size(), 2);
+
+    EXPECT_EQ(cache.parse(dir / "b.json").at("entries").size(), 1);
+    EXPECT_FALSE(cache.take(dir / "bad.json").has_value());
+    EXPECT_TRUE(cache.parse(dir / "bad.json", false).is_discarded());
+    EXPECT_FALSE(cache.take(dir / "notes.txt").has_value());
+
+    fs::remove_all(dir);
+}
+
+TEST(JsonCache, evictFilesNotTaken)
+{
+    auto dir = fs::temp_directory_path() / "pldm_json_cache_evict_test";
+    fs::create_directories(dir);
+    std::ofstream(dir / "taken.json") << R"({"entries": [1]})";
+    std::ofstream(dir / "skipped.json") << R"({"entries": [2]})";
+
+    auto& cache = JsonCache::getInstance();
+    cache.evict();
+    EXPECT_EQ(cache.preload({dir}).files, 2);
+    EXPECT_TRUE(cache.take(dir / "taken.json").has_value());
+
+    EXPECT_EQ(cache.evict(), 1);
+    EXPECT_FALSE(cache.take(dir / "skipped.json").has_value());
+    EXPECT_EQ(cache.parse(dir / "skipped.json").at("entries").size(), 1);
+
+    fs::remove_all(dir);
+}
@@ -1,5 +1,7 @@
 #include "common/utils.hpp"
 
+#include <cerrno>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -65,6 +67,9 @@ class MockdBusHandler : public pldm::utils::DBusHandler
     MOCK_METHOD(pldm::utils::PropertyValue, getDbusPropertyVariant,
                 (const char*, const char*, const char*), (const override));
 
+    MOCK_METHOD(pldm::utils::PropertyMap, getDbusPropertiesVariant,
+                (const char*, const char*, const char*), (const override));
+
     MOCK_METHOD(pldm::utils::GetSubTreeResponse, getSubtree,
                 (const std::string&, int, const std::vector<std::string>&),
                 (const override));
@@ -72,4 +77,25 @@ class MockdBusHandler : public pldm::utils::DBusHandler
     MOCK_METHOD(pldm::utils::GetSubTreePathsResponse, getSubTreePaths,
                 (const std::string&, int, const std::vector<std::string>&),
                 (const override));
+
+    /** @brief Serve the asynchronous reads from the mocked synchronous one */
+    void getDbusPropertyVariantAsync(
+        const pldm::utils::DBusMapping& dBusMap,
+        std::function<void(int, pldm::utils::PropertyValue&&)> callback)
+        const override
+    {
+        pldm::utils::PropertyValue value;
+        try
+        {
+            value = getDbusPropertyVariant(dBusMap.objectPath.c_str(),
+                                           dBusMap.propertyName.c_str(),
+                                           dBusMap.interface.c_str());
+        }
+        catch (const std::exception&)
+        {
+            callback(-EIO, {});
+            return;
+        }
+        callback(0, std::move(value));
+    }
 };
@@ -0,0 +1,57 @@
+#include "common/pdr_arena.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::pdr;
+
+TEST(PdrArenaTest, emplaceAndIndex)
+{
+    std::vector<std::vector<uint8_t>> records{
+        {0x1, 0x2, 0x3}, {0x4}, {0x5, 0x6, 0x7, 0x8}};
+
+    PdrArena arena;
+    EXPECT_TRUE(arena.empty());
+    arena.reserve(records.size(), 8);
+    for (const auto& record : records)
+    {
+        arena.emplace_back(record);
+    }
+
+    ASSERT_EQ(records.size(), arena.size());
+    EXPECT_EQ(8, arena.bytes());
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        EXPECT_TRUE(std::ranges::equal(records[i], arena[i]));
+    }
+
+    size_t i = 0;
+    for (auto record : arena)
+    {
+        EXPECT_TRUE(std::ranges::equal(records[i++], record));
+    }
+    EXPECT_EQ(records.size(), i);
+
+    arena.clear();
+    EXPECT_TRUE(arena.empty());
+    EXPECT_EQ(0, arena.bytes());
+    EXPECT_EQ(arena.begin(), arena.end());
+}
+
+TEST(PdrArenaTest, compare)
+{
+    PdrArena a;
+    PdrArena b;
+    a.emplace_back(std::vector<uint8_t>{0x1, 0x2});
+    b.emplace_back(std::vector<uint8_t>{0x1});
+    b.emplace_back(std::vector<uint8_t>{0x2});
+
+    /* Same bytes, different records */
+    EXPECT_NE(a, b);
+
+    b.clear();
+    b.emplace_back(std::vector<uint8_t>{0x1, 0x2});
+    EXPECT_EQ(a, b);
+}
@@ -0,0 +1,95 @@
+#include "common/pdr_cache.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using namespace pldm::pdr;
+
+class PdrCacheTest : public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pldm_pdr_cache.XXXXXX";
+        dir = fs::path(mkdtemp(tmpdir));
+        signature.updateTime = {0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7,
+                                0x8, 0x9, 0xa, 0xb, 0xc, 0xd};
+        signature.recordCount = 2;
+        signature.repositorySize = 40;
+        signature.largestRecordSize = 24;
+        pdrs.emplace_back(std::vector<uint8_t>(16, 0x11));
+        pdrs.emplace_back(std::vector<uint8_t>(24, 0x22));
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(dir);
+    }
+
+    fs::path dir;
+    PdrRepositorySignature signature{};
+    PdrArena pdrs;
+};
+
+TEST_F(PdrCacheTest, storeLoad)
+{
+    PdrCache cache(dir / "cache");
+    EXPECT_FALSE(cache.load("uuid_1", signature).has_value());
+
+    EXPECT_TRUE(cache.store("uuid_1", signature, pdrs));
+    auto cached = cache.load("uuid_1", signature);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(pdrs, cached.value());
+
+    /* Entries are per terminus */
+    EXPECT_FALSE(cache.load("uuid_2", signature).has_value());
+
+    cache.remove("uuid_1");
+    EXPECT_FALSE(cache.load("uuid_1", signature).has_value());
+}
+
+TEST_F(PdrCacheTest, staleSignature)
+{
+    PdrCache cache(dir);
+    ASSERT_TRUE(cache.store("uuid_1", signature, pdrs));
+
+    auto changed = signature;
+    changed.updateTime[0]++;
+    EXPECT_FALSE(cache.load("uuid_1", changed).has_value());
+
+    changed = signature;
+    changed.recordCount++;
+    EXPECT_FALSE(cache.load("uuid_1", changed).has_value());
+
+    changed = signature;
+    changed.largestRecordSize++;
+    EXPECT_FALSE(cache.load("uuid_1", changed).has_value());
+
+    EXPECT_TRUE(cache.load("uuid_1", signature).has_value());
+}
+
+TEST_F(PdrCacheTest, corruptedEntry)
+{
+    PdrCache cache(dir);
+    ASSERT_TRUE(cache.store("uuid_1", signature, pdrs));
+
+    auto file = *fs::directory_iterator(dir);
+    fs::resize_file(file.path(), fs::file_size(file.path()) - 1);
+    EXPECT_FALSE(cache.load("uuid_1", signature).has_value());
+
+    std::ofstream(file.path(), std::ios::trunc) << "garbage";
+    EXPECT_FALSE(cache.load("uuid_1", signature).has_value());
+}
+
+TEST_F(PdrCacheTest, disabled)
+{
+    PdrCache cache;
+    EXPECT_FALSE(cache.enabled());
+    EXPECT_FALSE(cache.store("uuid_1", signature, pdrs));
+    EXPECT_FALSE(cache.load("uuid_1", signature).has_value());
+}
@@ -0,0 +1,46 @@
+#include "common/pldm_msg.hpp"
+
+#include <libpldm/base.h>
+
+#include <span>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+
+TEST(RequestMsg, fixedSize)
+{
+    PldmMsg<PLDM_GET_VERSION_REQ_BYTES> request;
+    ASSERT_EQ(request.size(),
+              sizeof(pldm_msg_hdr) + PLDM_GET_VERSION_REQ_BYTES);
+    ASSERT_EQ(encode_get_version_req(1, 0, PLDM_GET_FIRSTPART, PLDM_BASE,
+                                     request.msg()),
+              PLDM_SUCCESS);
+
+    RequestMsg moved(std::move(request));
+    EXPECT_EQ(moved.size(), sizeof(pldm_msg_hdr) + PLDM_GET_VERSION_REQ_BYTES);
+    EXPECT_EQ(moved.msg()->hdr.instance_id, 1);
+    EXPECT_EQ(moved.msg()->hdr.command, PLDM_GET_PLDM_VERSION);
+}
+
+TEST(RequestMsg, longMessage)
+{
+    RequestMsg request(RequestMsg::inlineBytes + 1);
+    request.data()[RequestMsg::inlineBytes] = 0xa5;
+
+    RequestMsg moved(std::move(request));
+    std::span<const uint8_t> bytes = moved;
+    ASSERT_EQ(bytes.size(), RequestMsg::inlineBytes + 1);
+    EXPECT_EQ(bytes.back(), 0xa5);
+}
+
+TEST(RequestMsg, fromVector)
+{
+    Request vector(sizeof(pldm_msg_hdr) + 1, 0x11);
+    auto data = vector.data();
+
+    RequestMsg request(std::move(vector));
+    EXPECT_EQ(request.data(), data);
+    EXPECT_EQ(request.size(), sizeof(pldm_msg_hdr) + 1);
+}
@@ -1,9 +1,15 @@
+#include "common/service_cache.hpp"
 #include "common/utils.hpp"
 #include "mocked_utils.hpp"
 
 #include <libpldm/platform.h>
 #include <linux/mctp.h>
 
+#include <cerrno>
+#include <map>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 using namespace pldm::utils;
@@ -1053,6 +1059,23 @@ TEST(Split, allTestCases)
     EXPECT_EQ(results5[0], "aa");
 }
 
+TEST(WidenPathNamespace, allTestCases)
+{
+    std::string pathNamespace;
+    widenPathNamespace(pathNamespace, "/xyz/openbmc_project/led/groups/a");
+    EXPECT_EQ(pathNamespace, "/xyz/openbmc_project/led/groups/a");
+    widenPathNamespace(pathNamespace, "/xyz/openbmc_project/led/groups/a/b");
+    EXPECT_EQ(pathNamespace, "/xyz/openbmc_project/led/groups/a");
+    widenPathNamespace(pathNamespace, "/xyz/openbmc_project/led/groups/ab");
+    EXPECT_EQ(pathNamespace, "/xyz/openbmc_project/led/groups");
+    widenPathNamespace(pathNamespace, "/xyz/openbmc_project/led");
+    EXPECT_EQ(pathNamespace, "/xyz/openbmc_project/led");
+    widenPathNamespace(pathNamespace, "/xyz/openbmc_project/state/host0");
+    EXPECT_EQ(pathNamespace, "/xyz/openbmc_project");
+    widenPathNamespace(pathNamespace, "/com/ibm");
+    EXPECT_EQ(pathNamespace, "/");
+}
+
 TEST(ValidEID, allTestCases)
 {
     auto rc = isValidEID(MCTP_ADDR_NULL);
@@ -1190,3 +1213,135 @@ TEST(fruFieldParserU32, BadTest)
     result = fruFieldParserU32(nullptr, data.size());
     EXPECT_EQ(std::nullopt, result);
 }
+
+TEST(ServiceCache, lruEviction)
+{
+    ServiceCache cache(2);
+    cache.insert("/a", "xyz.A", "svc.a");
+    cache.insert("/b", "xyz.B", "svc.b");
+    EXPECT_EQ(cache.get("/a", "xyz.A"), "svc.a");
+
+    // "/b" is the least recently used
+    cache.insert("/c", "", "svc.c");
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_FALSE(cache.get("/b", "xyz.B").has_value());
+    EXPECT_EQ(cache.get("/a", "xyz.A"), "svc.a");
+    EXPECT_EQ(cache.get("/c", ""), "svc.c");
+    EXPECT_FALSE(cache.get("/c", "xyz.C").has_value());
+
+    cache.insert("/c", "", "svc.d");
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.get("/c", ""), "svc.d");
+}
+
+TEST(ServiceCache, invalidate)
+{
+    ServiceCache cache(8);
+    cache.insert("/a", "xyz.A", "svc.1");
+    cache.insert("/a", "xyz.B", "svc.2");
+    cache.insert("/b", "xyz.A", "svc.1");
+    cache.insert("/c", "xyz.C", "svc.3");
+
+    cache.erasePath("/a");
+    EXPECT_FALSE(cache.get("/a", "xyz.A").has_value());
+    EXPECT_FALSE(cache.get("/a", "xyz.B").has_value());
+    EXPECT_EQ(cache.get("/b", "xyz.A"), "svc.1");
+
+    cache.eraseService("svc.1");
+    EXPECT_FALSE(cache.get("/b", "xyz.A").has_value());
+    EXPECT_EQ(cache.size(), 1);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(ServiceCache, disabled)
+{
+    ServiceCache cache;
+    cache.insert("/a", "xyz.A", "svc.a");
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.get("/a", "xyz.A").has_value());
+}
+
+TEST(AsyncDBusHandler, failingServiceLeavesOthers)
+{
+    AsyncDBusHandler::PropertyWrites writes{
+        {{"/a/1", "xyz.A", "Value", "uint8_t"}, uint8_t(1)},
+        {{"/b/1", "xyz.B", "Value", "uint8_t"}, uint8_t(2)},
+        {{"/a/2", "xyz.A", "Value", "uint8_t"}, uint8_t(3)},
+        {{"/c/1", "xyz.C", "Value", "uint8_t"}, uint8_t(4)},
+    };
+
+    // The services are resolved after the call, as from the mapper
+    std::vector<std::pair<std::string, AsyncDBusHandler::ServiceCallback>>
+        lookups;
+    auto resolve = [&lookups](const DBusMapping& dBusMap,
+                              AsyncDBusHandler::ServiceCallback callback) {
+        lookups.emplace_back("svc." + dBusMap.interface.substr(4),
+                             std::move(callback));
+    };
+    std::map<std::string, std::vector<uint8_t>> written;
+    auto write = [&written](const std::string& service,
+                            AsyncDBusHandler::PropertyWrites serviceWrites,
+                            AsyncDBusHandler::Callback callback) {
+        if (service == "svc.B")
+        {
+            callback(-EIO);
+            return;
+        }
+        for (const auto& [dBusMap, value] : serviceWrites)
+        {
+            written[service].push_back(std::get<uint8_t>(value));
+        }
+        callback(0);
+    };
+
+    std::vector<int> results;
+    AsyncDBusHandler::setPropertiesPerService(
+        std::move(writes), resolve, write,
+        [&results](int rc) { results.push_back(rc); });
+    ASSERT_EQ(lookups.size(), 4);
+    EXPECT_TRUE(results.empty());
+
+    for (auto& [service, callback] : lookups)
+    {
+        callback(0, service);
+    }
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0], -EIO);
+    EXPECT_EQ(written["svc.A"], (std::vector<uint8_t>{1, 3}));
+    EXPECT_EQ(written["svc.C"], (std::vector<uint8_t>{4}));
+    EXPECT_FALSE(written.contains("svc.B"));
+}
+
+TEST(AsyncDBusHandler, unresolvedServiceLeavesOthers)
+{
+    AsyncDBusHandler::PropertyWrites writes{
+        {{"/a/1", "xyz.A", "Value", "uint8_t"}, uint8_t(1)},
+        {{"/b/1", "xyz.B", "Value", "uint8_t"}, uint8_t(2)},
+    };
+
+    auto resolve = [](const DBusMapping& dBusMap,
+                      AsyncDBusHandler::ServiceCallback callback) {
+        if (dBusMap.interface == "xyz.B")
+        {
+            callback(-ENOENT, {});
+            return;
+        }
+        callback(0, "svc.A");
+    };
+    std::vector<std::string> services;
+    auto write = [&services](const std::string& service,
+                             AsyncDBusHandler::PropertyWrites,
+                             AsyncDBusHandler::Callback callback) {
+        services.push_back(service);
+        callback(0);
+    };
+
+    std::vector<int> results;
+    AsyncDBusHandler::setPropertiesPerService(
+        std::move(writes), resolve, write,
+        [&results](int rc) { results.push_back(rc); });
+    EXPECT_EQ(results, std::vector<int>{-ENOENT});
+    EXPECT_EQ(services, std::vector<std::string>{"svc.A"});
+}
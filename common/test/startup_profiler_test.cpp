@@ -0,0 +1,45 @@
+#include "common/startup_profiler.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::stats;
+
+TEST(StartupProfiler, readyOnceRequiredMilestonesReached)
+{
+    auto& profiler = StartupProfiler::getInstance();
+    auto begin = StartupProfiler::Clock::now();
+    profiler.phase("Config", begin);
+    profiler.require({"Config", "EventLoop"});
+    EXPECT_FALSE(profiler.getReady().has_value());
+
+    profiler.milestone("EventLoop");
+    ASSERT_TRUE(profiler.getReady().has_value());
+
+    const auto& timings = profiler.getTimings();
+    ASSERT_TRUE(timings.contains("Config"));
+    EXPECT_EQ(timings.at("EventLoop").duration.count(), 0);
+    EXPECT_LE(timings.at("Config").at, timings.at("EventLoop").at);
+    EXPECT_LE(timings.at("EventLoop").at, *profiler.getReady());
+
+    // Only the first occurrence of a phase is kept
+    auto firstAt = timings.at("EventLoop").at;
+    profiler.milestone("EventLoop");
+    EXPECT_EQ(timings.at("EventLoop").at, firstAt);
+}
+
+TEST(StartupProfiler, callbackWhenPhaseReached)
+{
+    auto& profiler = StartupProfiler::getInstance();
+    int called = 0;
+    profiler.whenReached("Transport", [&called] { called++; });
+    EXPECT_EQ(called, 0);
+
+    profiler.phase("Transport", StartupProfiler::Clock::now());
+    EXPECT_EQ(called, 1);
+    profiler.phase("Transport", StartupProfiler::Clock::now());
+    EXPECT_EQ(called, 1);
+
+    // Already reached, called right away
+    profiler.whenReached("Transport", [&called] { called++; });
+    EXPECT_EQ(called, 2);
+}
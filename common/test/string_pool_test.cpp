@@ -0,0 +1,26 @@
+#include "common/string_pool.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+
+TEST(StringPool, equalStringsShareOneCopy)
+{
+    auto& pool = StringPool::getInstance();
+    std::string first{"en"};
+    std::string second{"en"};
+
+    auto firstView = pool.intern(first);
+    auto size = pool.size();
+    auto secondView = pool.intern(second);
+    EXPECT_EQ(firstView, "en");
+    EXPECT_EQ(firstView.data(), secondView.data());
+    EXPECT_EQ(pool.size(), size);
+
+    first = "fr";
+    EXPECT_EQ(secondView, "en");
+    EXPECT_NE(pool.intern(first).data(), firstView.data());
+    EXPECT_EQ(pool.size(), size + 1);
+}
@@ -0,0 +1,63 @@
+#include "common/trace.hpp"
+
+#include <libpldm/base.h>
+
+#include <nlohmann/json.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::trace;
+
+TEST(Trace, ringKeepsNewest)
+{
+    Recorder recorder(2);
+    recorder.instant("first", "test", 1);
+    recorder.instant("second", "test", 2);
+    recorder.instant("third", "test", 3);
+
+    auto events = recorder.events();
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_STREQ(events[0].name, "second");
+    EXPECT_EQ(events[0].sequence, 2);
+    EXPECT_STREQ(events[1].name, "third");
+    EXPECT_EQ(events[1].arg, 3);
+}
+
+TEST(Trace, disabled)
+{
+    Recorder recorder(0);
+    recorder.instant("instant", "test", 0);
+    EXPECT_TRUE(recorder.events().empty());
+}
+
+TEST(Trace, dumpChromeFormat)
+{
+    Recorder recorder(8);
+    auto begin = Clock::now();
+    recorder.complete("handler", "responder", begin, PLDM_GET_TID);
+    recorder.instant("rx", "pldmd", 9);
+    recorder.async("request", "requester", begin, 9);
+
+    std::string path = "/tmp/pldm_trace_test.json";
+    recorder.dump(path);
+    std::ifstream file(path);
+    auto trace = nlohmann::json::parse(file);
+    std::remove(path.c_str());
+
+    const auto& events = trace.at("traceEvents");
+    ASSERT_EQ(events.size(), 4);
+    EXPECT_EQ(events[0].at("name"), "handler");
+    EXPECT_EQ(events[0].at("ph"), "X");
+    EXPECT_EQ(events[0].at("args").at("arg"), PLDM_GET_TID);
+    EXPECT_GE(events[0].at("dur").get<double>(), 0);
+    EXPECT_EQ(events[1].at("ph"), "i");
+    EXPECT_EQ(events[2].at("ph"), "b");
+    EXPECT_EQ(events[3].at("ph"), "e");
+    EXPECT_EQ(events[2].at("id"), events[3].at("id"));
+    EXPECT_LE(events[2].at("ts").get<double>(),
+              events[3].at("ts").get<double>());
+}
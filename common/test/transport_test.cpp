@@ -0,0 +1,180 @@
+#include "common/loopback.hpp"
+#include "common/transport.hpp"
+
+#include <libpldm/base.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using pldm::transport::Loopback;
+
+constexpr mctp_eid_t eid = 9;
+
+class TestTransport : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        Loopback::get().clear();
+    }
+
+    void TearDown() override
+    {
+        Loopback::get().clear();
+    }
+
+    /** @brief Answer the requests to eid with a response carrying the
+     *         completion code
+     */
+    void answer(uint8_t completionCode)
+    {
+        Loopback::get().attach(eid, [completionCode](
+                                        std::span<const uint8_t> request) {
+            std::vector<uint8_t> response(request.begin(), request.end());
+            response[0] &= ~0x80;
+            response.push_back(completionCode);
+            Loopback::get().send(eid, std::move(response),
+                                 std::chrono::microseconds(100));
+        });
+    }
+
+    std::vector<uint8_t> request{0x80 | 0x03, PLDM_BASE, PLDM_GET_TID};
+};
+
+TEST_F(TestTransport, unknownBackend)
+{
+    EXPECT_THROW(PldmTransport{"none"}, std::system_error);
+}
+
+TEST_F(TestTransport, sendRecv)
+{
+    PldmTransport transport{"loopback"};
+    answer(PLDM_SUCCESS);
+
+    void* rx = nullptr;
+    size_t len = 0;
+    ASSERT_EQ(transport.sendRecvMsg(eid, request.data(), request.size(), rx,
+                                    len),
+              PLDM_REQUESTER_SUCCESS);
+    ASSERT_EQ(len, request.size() + 1);
+    auto response = static_cast<const uint8_t*>(rx);
+    EXPECT_EQ(response[0], 0x03);
+    EXPECT_EQ(response[len - 1], PLDM_SUCCESS);
+    free(rx);
+}
+
+TEST_F(TestTransport, recvBusy)
+{
+    PldmTransport transport{"loopback"};
+    answer(PLDM_SUCCESS);
+
+    pldm_tid_t tid{};
+    void* rx = nullptr;
+    size_t len = 0;
+    EXPECT_EQ(transport.recvMsg(tid, rx, len), PLDM_REQUESTER_TRANSPORT_BUSY);
+
+    ASSERT_EQ(transport.sendMsg(eid, request.data(), request.size()),
+              PLDM_REQUESTER_SUCCESS);
+    pollfd pfd{transport.getEventSource(), POLLIN, 0};
+    ASSERT_EQ(poll(&pfd, 1, 1000), 1);
+    ASSERT_EQ(transport.recvMsg(tid, rx, len), PLDM_REQUESTER_SUCCESS);
+    EXPECT_EQ(tid, eid);
+    free(rx);
+}
+
+TEST_F(TestTransport, noEndpoint)
+{
+    PldmTransport transport{"loopback"};
+    EXPECT_EQ(transport.sendMsg(eid, request.data(), request.size()),
+              PLDM_REQUESTER_SEND_FAIL);
+}
+
+TEST_F(TestTransport, recvBuffer)
+{
+    PldmTransport transport{"loopback"};
+    answer(PLDM_ERROR);
+
+    ASSERT_EQ(transport.sendMsg(eid, request.data(), request.size()),
+              PLDM_REQUESTER_SUCCESS);
+    pollfd pfd{transport.getEventSource(), POLLIN, 0};
+    ASSERT_EQ(poll(&pfd, 1, 1000), 1);
+
+    pldm_tid_t tid{};
+    pldm::transport::RxBuffer rx;
+    size_t len = 0;
+    ASSERT_EQ(transport.recvMsg(tid, rx, len), PLDM_REQUESTER_SUCCESS);
+    ASSERT_EQ(len, request.size() + 1);
+    EXPECT_EQ(static_cast<const uint8_t*>(rx.get())[len - 1], PLDM_ERROR);
+}
+
+#ifdef PLDM_TRANSPORT_WITH_MCTP_DEMUX
+TEST_F(TestTransport, mctpDemuxDrainDoesNotBlock)
+{
+    // Stand in for mctp-demux-daemon on its abstract socket
+    int server = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    ASSERT_GE(server, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    constexpr char path[] = "\0mctp-mux";
+    std::memcpy(addr.sun_path, path, sizeof(path) - 1);
+    auto addrLen = offsetof(sockaddr_un, sun_path) + sizeof(path) - 1;
+    if (bind(server, reinterpret_cast<sockaddr*>(&addr), addrLen) ||
+        listen(server, 1))
+    {
+        close(server);
+        GTEST_SKIP() << "mctp-mux socket in use";
+    }
+
+    PldmTransport transport{"mctp-demux"};
+    int client = accept(server, nullptr, nullptr);
+    ASSERT_GE(client, 0);
+    uint8_t type{};
+    ASSERT_EQ(read(client, &type, sizeof(type)), 1);
+
+    // EID and MCTP message type, then the PLDM message
+    std::vector<uint8_t> msg{eid, type};
+    msg.insert(msg.end(), request.begin(), request.end());
+    ASSERT_EQ(write(client, msg.data(), msg.size()),
+              static_cast<ssize_t>(msg.size()));
+
+    pldm_tid_t tid{};
+    pldm::transport::RxBuffer rx;
+    size_t len = 0;
+    ASSERT_EQ(transport.recvMsg(tid, rx, len), PLDM_REQUESTER_SUCCESS);
+    EXPECT_EQ(tid, eid);
+    EXPECT_EQ(len, request.size());
+
+    // The socket is empty, the next receive reports busy without blocking
+    EXPECT_EQ(transport.recvMsg(tid, rx, len), PLDM_REQUESTER_TRANSPORT_BUSY);
+
+    close(client);
+    close(server);
+}
+#endif
+
+TEST(BufferPool, reuse)
+{
+    using pldm::transport::RxBuffer;
+    using pldm::transport::RxBufferRelease;
+
+    auto pool = std::make_shared<pldm::transport::BufferPool>(64, 1);
+    void* first = pool->get();
+    void* second = pool->get();
+    RxBuffer(first, RxBufferRelease{pool}).reset();
+    // Beyond maxIdle, released buffers are freed
+    RxBuffer(second, RxBufferRelease{pool}).reset();
+
+    RxBuffer reused(pool->get(), RxBufferRelease{pool});
+    EXPECT_EQ(reused.get(), first);
+}
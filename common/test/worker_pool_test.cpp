@@ -0,0 +1,64 @@
+#include "common/worker_pool.hpp"
+
+#include <sdeventplus/event.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::utils;
+
+TEST(WorkerPool, completionRunsOnEventLoop)
+{
+    auto event = sdeventplus::Event::get_new();
+    WorkerPool pool(event, 2);
+    auto loopThread = std::this_thread::get_id();
+
+    int done = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        // Each job records its own thread, read once the job is done
+        auto jobThread = std::make_shared<std::thread::id>();
+        pool.post([jobThread]() { *jobThread = std::this_thread::get_id(); },
+                  [&done, jobThread, loopThread]() {
+                      EXPECT_EQ(std::this_thread::get_id(), loopThread);
+                      EXPECT_NE(*jobThread, loopThread);
+                      done++;
+                  });
+    }
+    while (done < 4)
+    {
+        event.run(std::nullopt);
+    }
+}
+
+TEST(WorkerPool, offloadResumesWithResult)
+{
+    auto event = sdeventplus::Event::get_new();
+    WorkerPool pool(event, 1);
+
+    std::optional<int> result;
+    bool failed = false;
+    exec::async_scope scope;
+    scope.spawn(stdexec::just() |
+                stdexec::let_value([&]() -> exec::task<void> {
+                    result = co_await pool.offload([]() { return 42; });
+                    try
+                    {
+                        co_await pool.offload(
+                            []() { throw std::runtime_error("failed"); });
+                    }
+                    catch (const std::runtime_error&)
+                    {
+                        failed = true;
+                    }
+                }),
+                exec::default_task_context<void>(exec::inline_scheduler{}));
+    while (!failed)
+    {
+        event.run(std::nullopt);
+    }
+    EXPECT_EQ(result, 42);
+}
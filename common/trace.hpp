@@ -0,0 +1,307 @@
+#pragma once
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if TRACE_MAX_EVENTS && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define PLDM_TRACE_USDT 1
+#endif
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace trace
+{
+static constexpr auto traceDumpPath = "/tmp/pldm_trace.json";
+
+/** @brief Clock of the trace events, CLOCK_MONOTONIC as perf and ftrace */
+using Clock = std::chrono::steady_clock;
+
+/** @brief How an Event is drawn on the timeline */
+enum class Phase : uint8_t
+{
+    complete, //!< A span of the event loop, nested in the spans around it
+    instant,  //!< A point in time
+    async,    //!< A span overlapping others, a request in flight
+};
+
+/** @struct Event
+ *
+ *  One fixed-size record of the ring. name and category are string
+ *  literals, recording copies nothing.
+ */
+struct Event
+{
+    uint64_t sequence; //!< record number, starting at 1, 0 for an empty slot
+    uint64_t begin;    //!< Clock time in nanoseconds
+    uint64_t duration; //!< in nanoseconds, 0 for instants
+    const char* name;
+    const char* category;
+    uint32_t arg; //!< command, TID or EID the event is about
+    Phase phase;
+};
+
+/** @class Recorder
+ *
+ *  Spans and instants of the hot paths of pldmd, kept in a ring allocated
+ *  once and written out in the Chrome trace format, which Perfetto and
+ *  chrome://tracing load, on SIGUSR2. When sys/sdt.h is available the
+ *  same points are USDT probes pldmd:span and pldmd:instant, for perf and
+ *  bpftrace to follow live.
+ *
+ *  Only built in when the trace-max-events option is set, the
+ *  PLDM_TRACE_* macros compile to nothing otherwise.
+ */
+class Recorder
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] capacity - number of events kept, the oldest are
+     *                        overwritten
+     */
+    explicit Recorder(size_t capacity) : ring(capacity) {}
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    static Recorder& getInstance()
+    {
+        static Recorder recorder(TRACE_MAX_EVENTS);
+        return recorder;
+    }
+
+    /** @brief Record a span of the event loop
+     *
+     *  @param[in] name - what was done
+     *  @param[in] category - the part of pldmd doing it
+     *  @param[in] begin - when it started
+     *  @param[in] arg - command, TID or EID the span is about
+     */
+    void complete(const char* name, const char* category,
+                  Clock::time_point begin, uint32_t arg)
+    {
+        save(Phase::complete, name, category, begin, Clock::now(), arg);
+    }
+
+    /** @brief Record a point in time
+     *
+     *  @param[in] name - what happened
+     *  @param[in] category - the part of pldmd it happened in
+     *  @param[in] arg - command, TID or EID the instant is about
+     */
+    void instant(const char* name, const char* category, uint32_t arg)
+    {
+#ifdef PLDM_TRACE_USDT
+        DTRACE_PROBE3(pldmd, instant, name, category, arg);
+#endif
+        auto now = Clock::now();
+        save(Phase::instant, name, category, now, now, arg);
+    }
+
+    /** @brief Record a span completing across event loop iterations
+     *
+     *  @param[in] name - what was done
+     *  @param[in] category - the part of pldmd doing it
+     *  @param[in] begin - when it started
+     *  @param[in] arg - command, TID or EID the span is about
+     */
+    void async(const char* name, const char* category, Clock::time_point begin,
+               uint32_t arg)
+    {
+        save(Phase::async, name, category, begin, Clock::now(), arg);
+    }
+
+    /** @brief The events recorded, oldest first */
+    std::vector<Event> events() const
+    {
+        std::vector<Event> recorded;
+        auto last = sequence.load(std::memory_order_acquire);
+        auto first = last > ring.size() ? last - ring.size() + 1 : 1;
+        for (auto seq = first; seq <= last; seq++)
+        {
+            const auto& event = ring[(seq - 1) % ring.size()];
+            if (event.sequence == seq)
+            {
+                recorded.emplace_back(event);
+            }
+        }
+        return recorded;
+    }
+
+    /** @brief Write the events in the Chrome trace format
+     *
+     *  Spans of the event loop are complete ("X") events of one thread,
+     *  requests in flight and sensor polling cycles are async ("b"/"e")
+     *  events, in the order they were recorded.
+     *
+     *  @param[in] path - file to write
+     */
+    void dump(const std::string& path = traceDumpPath) const
+    {
+        if (ring.empty())
+        {
+            error("Tracing is disabled");
+            return;
+        }
+        info("Dumping the trace into : {DUMP_PATH}", "DUMP_PATH", path);
+
+        std::ofstream file(path, std::ios::trunc);
+        file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        const char* separator = "";
+        for (const auto& event : events())
+        {
+            auto common = [&](const char* phase, uint64_t ts) {
+                file << separator << "{\"name\":\"" << event.name
+                     << "\",\"cat\":\"" << event.category << "\",\"ph\":\""
+                     << phase << "\",\"ts\":" << ts / 1000 << '.'
+                     << ts % 1000 / 100 << ts % 100 / 10 << ts % 10
+                     << ",\"pid\":1,\"tid\":1,\"args\":{\"arg\":" << event.arg
+                     << '}';
+                separator = ",\n";
+            };
+            switch (event.phase)
+            {
+                case Phase::complete:
+                    common("X", event.begin);
+                    file << ",\"dur\":" << event.duration / 1000 << '.'
+                         << event.duration % 1000 / 100
+                         << event.duration % 100 / 10 << event.duration % 10
+                         << '}';
+                    break;
+                case Phase::instant:
+                    common("i", event.begin);
+                    file << ",\"s\":\"t\"}";
+                    break;
+                case Phase::async:
+                    common("b", event.begin);
+                    file << ",\"id\":" << event.sequence << '}';
+                    common("e", event.begin + event.duration);
+                    file << ",\"id\":" << event.sequence << '}';
+                    break;
+            }
+        }
+        file << "]}\n";
+    }
+
+  private:
+    /** @brief Write an event into the next slot of the ring */
+    void save(Phase phase, const char* name, const char* category,
+              Clock::time_point begin, Clock::time_point end, uint32_t arg)
+    {
+        if (ring.empty())
+        {
+            return;
+        }
+        auto seq = sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+        auto& event = ring[(seq - 1) % ring.size()];
+
+        // Readers skip slots whose sequence is 0 while they are rewritten
+        std::atomic_ref<uint64_t> eventSequence(event.sequence);
+        eventSequence.store(0, std::memory_order_relaxed);
+        event.begin = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          begin.time_since_epoch())
+                          .count();
+        event.duration =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)
+                .count();
+        event.name = name;
+        event.category = category;
+        event.arg = arg;
+        event.phase = phase;
+        eventSequence.store(seq, std::memory_order_release);
+    }
+
+    std::atomic<uint64_t> sequence{0};
+    std::vector<Event> ring;
+};
+
+/** @class Span
+ *
+ *  Records the time from its construction to its destruction as a span of
+ *  the event loop, or as an async span when it lives in a coroutine frame
+ *  across event loop iterations.
+ */
+class Span
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] name - what is done, a string literal
+     *  @param[in] category - the part of pldmd doing it, a string literal
+     *  @param[in] arg - command, TID or EID the span is about
+     *  @param[in] phase - Phase::complete or Phase::async
+     */
+    Span(const char* name, const char* category, uint32_t arg = 0,
+         Phase phase = Phase::complete) :
+        name(name), category(category), arg(arg), phase(phase),
+        begin(Clock::now())
+    {
+#ifdef PLDM_TRACE_USDT
+        DTRACE_PROBE4(pldmd, span, name, category, arg, 1);
+#endif
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    ~Span()
+    {
+#ifdef PLDM_TRACE_USDT
+        DTRACE_PROBE4(pldmd, span, name, category, arg, 0);
+#endif
+        if (phase == Phase::async)
+        {
+            Recorder::getInstance().async(name, category, begin, arg);
+            return;
+        }
+        Recorder::getInstance().complete(name, category, begin, arg);
+    }
+
+  private:
+    const char* name;
+    const char* category;
+    uint32_t arg;
+    Phase phase;
+    Clock::time_point begin;
+};
+
+} // namespace trace
+} // namespace pldm
+
+#define PLDM_TRACE_CONCAT_(a, b) a##b
+#define PLDM_TRACE_CONCAT(a, b) PLDM_TRACE_CONCAT_(a, b)
+#define PLDM_TRACE_NAME PLDM_TRACE_CONCAT(pldmTraceSpan, __COUNTER__)
+
+#if TRACE_MAX_EVENTS
+/** @brief Trace the rest of the enclosing scope as a span */
+#define PLDM_TRACE_SPAN(...)                                                   \
+    pldm::trace::Span PLDM_TRACE_NAME(__VA_ARGS__)
+/** @brief Trace a point in time */
+#define PLDM_TRACE_INSTANT(name, category, arg)                                \
+    pldm::trace::Recorder::getInstance().instant(name, category, arg)
+/** @brief Trace the rest of the enclosing coroutine scope as an async span
+ */
+#define PLDM_TRACE_ASYNC_SPAN(name, category, arg)                             \
+    pldm::trace::Span PLDM_TRACE_NAME(name, category, arg,                     \
+                                      pldm::trace::Phase::async)
+/** @brief Trace a span begun at a time_point from another iteration of the
+ *         event loop
+ */
+#define PLDM_TRACE_ASYNC(name, category, begin, arg)                           \
+    pldm::trace::Recorder::getInstance().async(name, category, begin, arg)
+#else
+#define PLDM_TRACE_SPAN(...) static_cast<void>(0)
+#define PLDM_TRACE_INSTANT(name, category, arg) static_cast<void>(0)
+#define PLDM_TRACE_ASYNC_SPAN(name, category, arg) static_cast<void>(0)
+#define PLDM_TRACE_ASYNC(name, category, begin, arg) static_cast<void>(0)
+#endif
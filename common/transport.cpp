@@ -1,22 +1,164 @@
 #include "common/transport.hpp"
 
 #include <libpldm/transport.h>
-#include <libpldm/transport/af-mctp.h>
 #include <libpldm/transport/mctp-demux.h>
+#include <linux/mctp.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
 
 #include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
 #include <ranges>
 #include <system_error>
-#include <iostream>
+#include <vector>
 
+#ifdef PLDM_TRANSPORT_WITH_I2C
 #include "mctp.hpp"
+#endif
+#ifdef PLDM_TRANSPORT_WITH_LOOPBACK
+#include "loopback.hpp"
+#endif
 
-struct pldm_transport* transport_impl_init(TransportImpl& impl, pollfd& pollfd);
-void transport_impl_destroy(TransportImpl& impl);
+PHOSPHOR_LOG2_USING;
 
 static constexpr uint8_t MCTP_EID_VALID_MIN = 8;
 static constexpr uint8_t MCTP_EID_VALID_MAX = 255;
 
+#ifndef AF_MCTP
+#define AF_MCTP 45
+#endif
+#ifndef MCTP_MSG_TYPE_PLDM
+#define MCTP_MSG_TYPE_PLDM 1
+#endif
+
+namespace pldm
+{
+
+namespace transport
+{
+
+namespace
+{
+
+/** @brief Network of the AF_MCTP backends created next */
+uint32_t mctpNetwork = MCTP_NET_ANY;
+
+#ifdef PLDM_TRANSPORT_WITH_I2C
+/** @brief Backend of the MCTP I2C binding of common/mctp.cpp */
+class I2CBackend : public Backend
+{
+  public:
+    I2CBackend()
+    {
+        MCTP::init();
+        if (MCTP::getEventSource() < 0)
+        {
+            throw std::system_error(ENODEV, std::generic_category());
+        }
+    }
+
+    int getEventSource() const override
+    {
+        return MCTP::getEventSource();
+    }
+
+    pldm_requester_rc_t sendMsg(pldm_tid_t tid, const void* tx,
+                                size_t len) override
+    {
+        if (MCTP::send(tid, static_cast<const uint8_t*>(tx), len))
+        {
+            return PLDM_REQUESTER_SEND_FAIL;
+        }
+        return PLDM_REQUESTER_SUCCESS;
+    }
+
+    pldm_requester_rc_t recvMsg(pldm_tid_t& tid, void*& rx,
+                                size_t& len) override
+    {
+        uint8_t eid{};
+        if (MCTP::receive(eid, rx, len))
+        {
+            return PLDM_REQUESTER_TRANSPORT_BUSY;
+        }
+        tid = eid;
+        return PLDM_REQUESTER_SUCCESS;
+    }
+
+    int getTxEventSource() const override
+    {
+        return MCTP::getTxEventSource();
+    }
+
+    void processTx() override
+    {
+        MCTP::processTx();
+    }
+
+    int flush() override
+    {
+        return MCTP::flush();
+    }
+};
+#endif
+
+/** @brief Backend of a libpldm transport, which owns the buffers it
+ *         receives into
+ */
+class LibpldmBackend : public Backend
+{
+  public:
+    LibpldmBackend(struct pldm_transport* transport, pollfd pfd,
+                   std::function<void()> destroy) :
+        transport(transport), pfd(pfd), destroy(std::move(destroy))
+    {}
+
+    ~LibpldmBackend() override
+    {
+        destroy();
+    }
+
+    int getEventSource() const override
+    {
+        return pfd.fd;
+    }
+
+    pldm_requester_rc_t sendMsg(pldm_tid_t tid, const void* tx,
+                                size_t len) override
+    {
+        return pldm_transport_send_msg(transport, tid, tx, len);
+    }
+
+    pldm_requester_rc_t recvMsg(pldm_tid_t& tid, void*& rx,
+                                size_t& len) override
+    {
+        // The libpldm socket blocks, receive only once it is readable or
+        // closed so that draining the messages stops when none is left
+        pollfd ready = pfd;
+        ready.revents = 0;
+        if (poll(&ready, 1, 0) <= 0)
+        {
+            return PLDM_REQUESTER_TRANSPORT_BUSY;
+        }
+        return pldm_transport_recv_msg(transport, &tid, &rx, &len);
+    }
+
+  private:
+    struct pldm_transport* transport;
+    pollfd pfd;
+    std::function<void()> destroy;
+};
+
 /*
  * Currently the OpenBMC ecosystem assumes TID == EID. Pre-populate the TID
  * mappings over the EID space excluding the Null (0), Reserved (1 to 7),
@@ -34,107 +176,426 @@ static constexpr uint8_t MCTP_EID_VALID_MAX = 255;
  * prevent the failure of pldm_transport_mctp_demux_recv().
  */
 
-[[maybe_unused]] static struct pldm_transport*
-    pldm_transport_impl_mctp_demux_init(TransportImpl& impl, pollfd& pollfd)
+#ifdef PLDM_TRANSPORT_WITH_MCTP_DEMUX
+std::unique_ptr<Backend> makeMctpDemuxBackend()
 {
-    impl.mctp_demux = nullptr;
-    pldm_transport_mctp_demux_init(&impl.mctp_demux);
-    if (!impl.mctp_demux)
+    struct pldm_transport_mctp_demux* demux = nullptr;
+    pldm_transport_mctp_demux_init(&demux);
+    if (!demux)
     {
-        return nullptr;
+        throw std::system_error(ENOMEM, std::generic_category());
     }
 
     for (const auto eid :
          std::views::iota(MCTP_EID_VALID_MIN, MCTP_EID_VALID_MAX))
     {
-        int rc = pldm_transport_mctp_demux_map_tid(impl.mctp_demux, eid, eid);
+        int rc = pldm_transport_mctp_demux_map_tid(demux, eid, eid);
         if (rc)
         {
-            pldm_transport_af_mctp_destroy(impl.af_mctp);
-            return nullptr;
+            pldm_transport_mctp_demux_destroy(demux);
+            throw std::system_error(ENOMEM, std::generic_category());
         }
     }
 
-    pldm_transport* pldmTransport =
-        pldm_transport_mctp_demux_core(impl.mctp_demux);
+    auto transport = pldm_transport_mctp_demux_core(demux);
+    pollfd pfd{};
+    pldm_transport_mctp_demux_init_pollfd(transport, &pfd);
+    return std::make_unique<LibpldmBackend>(
+        transport, pfd, [demux] { pldm_transport_mctp_demux_destroy(demux); });
+}
+#endif
 
-    if (pldmTransport != nullptr)
+#ifdef PLDM_TRANSPORT_WITH_AF_MCTP
+/** @brief Backend of an AF_MCTP socket
+ *
+ *  Receives up to AF_MCTP_RX_BATCH messages with each recvmmsg() call,
+ *  into buffers of AF_MCTP_RX_BUFFER_SIZE bytes reused from a pool, which
+ *  keeps at most AF_MCTP_RX_BATCH released buffers. The MCTP tag of each
+ *  request received is kept until its response is sent, as the kernel
+ *  expects the response on the tag of the request.
+ */
+class AfMctpBackend : public Backend
+{
+  public:
+    AfMctpBackend() :
+        pool(std::make_shared<BufferPool>(AF_MCTP_RX_BUFFER_SIZE,
+                                          AF_MCTP_RX_BATCH))
     {
-        pldm_transport_mctp_demux_init_pollfd(pldmTransport, &pollfd);
+        fd = socket(AF_MCTP, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category());
+        }
+
+        /* Listen for requests on any interface of the network */
+        struct sockaddr_mctp addr{};
+        addr.smctp_family = AF_MCTP;
+        addr.smctp_network = network;
+        addr.smctp_addr.s_addr = MCTP_ADDR_ANY;
+        addr.smctp_type = MCTP_MSG_TYPE_PLDM;
+        if (bind(fd, reinterpret_cast<const struct sockaddr*>(&addr),
+                 sizeof(addr)))
+        {
+            auto err = errno;
+            close(fd);
+            throw std::system_error(err, std::generic_category());
+        }
+
+        for (size_t i = 0; i < AF_MCTP_RX_BATCH; i++)
+        {
+            msgs[i].msg_hdr.msg_name = &addrs[i];
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
     }
 
-    return pldmTransport;
-}
+    ~AfMctpBackend() override
+    {
+        close(fd);
+    }
 
-[[maybe_unused]] static struct pldm_transport* pldm_transport_impl_af_mctp_init(
-    TransportImpl& impl, pollfd& pollfd)
-{
-    impl.af_mctp = nullptr;
-    pldm_transport_af_mctp_init(&impl.af_mctp);
-    if (!impl.af_mctp)
+    int getEventSource() const override
     {
-        return nullptr;
+        return fd;
     }
 
-    for (const auto eid :
-         std::views::iota(MCTP_EID_VALID_MIN, MCTP_EID_VALID_MAX))
+    pldm_requester_rc_t sendMsg(pldm_tid_t tid, const void* tx,
+                                size_t len) override
     {
-        int rc = pldm_transport_af_mctp_map_tid(impl.af_mctp, eid, eid);
-        if (rc)
+        if (len < sizeof(pldm_msg_hdr))
+        {
+            return PLDM_REQUESTER_NOT_REQ_MSG;
+        }
+        auto hdr = static_cast<const pldm_msg_hdr*>(tx);
+
+        struct sockaddr_mctp addr{};
+        addr.smctp_family = AF_MCTP;
+        addr.smctp_network = network;
+        addr.smctp_addr.s_addr = tid;
+        addr.smctp_type = MCTP_MSG_TYPE_PLDM;
+        if (hdr->request)
         {
-            pldm_transport_af_mctp_destroy(impl.af_mctp);
-            return nullptr;
+            // The kernel allocates the tag of the requests
+            addr.smctp_tag = MCTP_TAG_OWNER;
         }
+        else
+        {
+            auto it = rxTags.find({tid, hdr->instance_id});
+            if (it == rxTags.end())
+            {
+                return PLDM_REQUESTER_SEND_FAIL;
+            }
+            addr.smctp_tag = it->second;
+            rxTags.erase(it);
+        }
+
+        if (sendto(fd, tx, len, 0,
+                   reinterpret_cast<const struct sockaddr*>(&addr),
+                   sizeof(addr)) != static_cast<ssize_t>(len))
+        {
+            return PLDM_REQUESTER_SEND_FAIL;
+        }
+        return PLDM_REQUESTER_SUCCESS;
     }
 
-    /* Listen for requests on any interface */
-    if (pldm_transport_af_mctp_bind(impl.af_mctp, nullptr, 0))
+    pldm_requester_rc_t recvBuffer(pldm_tid_t& tid, RxBuffer& rx,
+                                   size_t& len) override
     {
-        return nullptr;
+        if (ready.empty())
+        {
+            fill();
+        }
+        if (ready.empty())
+        {
+            return PLDM_REQUESTER_TRANSPORT_BUSY;
+        }
+
+        auto& front = ready.front();
+        tid = front.tid;
+        rx = std::move(front.buffer);
+        len = front.len;
+        ready.pop_front();
+        return PLDM_REQUESTER_SUCCESS;
     }
 
-    pldm_transport* pldmTransport = pldm_transport_af_mctp_core(impl.af_mctp);
+    pldm_requester_rc_t recvMsg(pldm_tid_t& tid, void*& rx,
+                                size_t& len) override
+    {
+        // Callers of this variant release the buffer with free()
+        RxBuffer buffer;
+        auto rc = recvBuffer(tid, buffer, len);
+        if (rc != PLDM_REQUESTER_SUCCESS)
+        {
+            return rc;
+        }
+        rx = malloc(len);
+        if (!rx)
+        {
+            return PLDM_REQUESTER_RECV_FAIL;
+        }
+        memcpy(rx, buffer.get(), len);
+        return PLDM_REQUESTER_SUCCESS;
+    }
+
+  private:
+    /** @brief A message received by fill(), waiting for recvBuffer() */
+    struct Received
+    {
+        pldm_tid_t tid;
+        RxBuffer buffer;
+        size_t len;
+    };
 
-    if (pldmTransport != nullptr)
+    /** @brief Receive the messages pending on the socket, one batch */
+    void fill()
     {
-        pldm_transport_af_mctp_init_pollfd(pldmTransport, &pollfd);
+        for (size_t i = 0; i < AF_MCTP_RX_BATCH; i++)
+        {
+            if (!buffers[i])
+            {
+                buffers[i] = RxBuffer(pool->get(), RxBufferRelease{pool});
+                if (!buffers[i])
+                {
+                    return;
+                }
+            }
+            iovs[i].iov_base = buffers[i].get();
+            iovs[i].iov_len = pool->bufferSize();
+            msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+            msgs[i].msg_hdr.msg_flags = 0;
+        }
+
+        int count = recvmmsg(fd, msgs.data(), msgs.size(), MSG_DONTWAIT,
+                             nullptr);
+        for (int i = 0; i < count; i++)
+        {
+            const auto& addr = addrs[i];
+            size_t len = msgs[i].msg_len;
+            if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC)
+            {
+                error(
+                    "Dropped a PLDM message of EID {EID} larger than {SIZE} bytes",
+                    "EID", addr.smctp_addr.s_addr, "SIZE", pool->bufferSize());
+                continue;
+            }
+            if (addr.smctp_type != MCTP_MSG_TYPE_PLDM ||
+                len < sizeof(pldm_msg_hdr))
+            {
+                continue;
+            }
+
+            auto hdr = static_cast<const pldm_msg_hdr*>(buffers[i].get());
+            if (hdr->request && (addr.smctp_tag & MCTP_TAG_OWNER))
+            {
+                rxTags[{addr.smctp_addr.s_addr, hdr->instance_id}] =
+                    addr.smctp_tag & ~MCTP_TAG_OWNER;
+            }
+            ready.emplace_back(addr.smctp_addr.s_addr, std::move(buffers[i]),
+                               len);
+        }
     }
 
-    return pldmTransport;
+    /** @brief The AF_MCTP socket */
+    int fd = -1;
+
+    /** @brief MCTP network the socket is bound to */
+    uint32_t network = mctpNetwork;
+
+    std::shared_ptr<BufferPool> pool;
+
+    /** @brief recvmmsg() arguments, reused from one batch to the next */
+    std::array<struct mmsghdr, AF_MCTP_RX_BATCH> msgs{};
+    std::array<struct iovec, AF_MCTP_RX_BATCH> iovs{};
+    std::array<struct sockaddr_mctp, AF_MCTP_RX_BATCH> addrs{};
+
+    /** @brief Buffers of the next batch, the ones left unused stay there */
+    std::array<RxBuffer, AF_MCTP_RX_BATCH> buffers;
+
+    std::deque<Received> ready;
+
+    /** @brief MCTP tag of the requests received, by EID and instance ID */
+    std::map<std::pair<uint8_t, uint8_t>, uint8_t> rxTags;
+};
+#endif
+
+/** @brief Create an epoll file descriptor over a set of file descriptors */
+int makeEpoll(const std::vector<int>& fds)
+{
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0)
+    {
+        throw std::system_error(errno, std::generic_category());
+    }
+    for (auto fd : fds)
+    {
+        struct epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0)
+        {
+            auto err = errno;
+            close(epollFd);
+            throw std::system_error(err, std::generic_category());
+        }
+    }
+    return epollFd;
 }
 
-struct pldm_transport* transport_impl_init(TransportImpl& impl, pollfd& pollfd)
+} // namespace
+
+const std::map<std::string, BackendFactory>& getBackends()
 {
-#if defined(PLDM_TRANSPORT_WITH_MCTP_DEMUX)
-    return pldm_transport_impl_mctp_demux_init(impl, pollfd);
-#elif defined(PLDM_TRANSPORT_WITH_AF_MCTP)
-    return pldm_transport_impl_af_mctp_init(impl, pollfd);
-#else
-    return nullptr;
+    static const std::map<std::string, BackendFactory> backends{
+#ifdef PLDM_TRANSPORT_WITH_I2C
+        {"i2c", [] { return std::make_unique<I2CBackend>(); }},
 #endif
+#ifdef PLDM_TRANSPORT_WITH_MCTP_DEMUX
+        {"mctp-demux", makeMctpDemuxBackend},
+#endif
+#ifdef PLDM_TRANSPORT_WITH_AF_MCTP
+        {"af-mctp", [] { return std::make_unique<AfMctpBackend>(); }},
+#endif
+#ifdef PLDM_TRANSPORT_WITH_LOOPBACK
+        {"loopback", makeLoopbackBackend},
+#endif
+    };
+    return backends;
 }
 
-void transport_impl_destroy(TransportImpl& impl)
+void setMctpNetwork(uint32_t network)
 {
-#if defined(PLDM_TRANSPORT_WITH_MCTP_DEMUX)
-    pldm_transport_mctp_demux_destroy(impl.mctp_demux);
-#elif defined(PLDM_TRANSPORT_WITH_AF_MCTP)
-    pldm_transport_af_mctp_destroy(impl.af_mctp);
-#endif
+    mctpNetwork = network;
 }
 
+} // namespace transport
+
+} // namespace pldm
+
+using pldm::transport::Backend;
+
 PldmTransport::PldmTransport()
 {
-    // transport = transport_impl_init(impl, pfd);
-    // if (!transport)
-    // {
-    //     throw std::system_error(ENOMEM, std::generic_category());
-    // }
+    configure(TRANSPORT_CONFIG_JSON);
+    setupEventSources();
+}
+
+PldmTransport::PldmTransport(const std::string& backend)
+{
+    routes.fill(&use(backend));
+    setupEventSources();
 }
 
 PldmTransport::~PldmTransport()
 {
-    // transport_impl_destroy(impl);
+    if (rxEpollFd >= 0)
+    {
+        close(rxEpollFd);
+    }
+    if (txEpollFd >= 0)
+    {
+        close(txEpollFd);
+    }
+}
+
+Backend& PldmTransport::use(const std::string& name)
+{
+    if (auto it = backends.find(name); it != backends.end())
+    {
+        return *it->second;
+    }
+
+    const auto& factories = pldm::transport::getBackends();
+    auto factory = factories.find(name);
+    if (factory == factories.end())
+    {
+        error("PLDM transport backend '{NAME}' is not available", "NAME",
+              name);
+        throw std::system_error(ENOENT, std::generic_category());
+    }
+    auto& backend = backends[name];
+    backend = factory->second();
+    rxBackends.push_back(backend.get());
+    return *backend;
+}
+
+void PldmTransport::configure(const std::filesystem::path& config)
+{
+    std::string defaultBackend = PLDM_TRANSPORT_DEFAULT;
+    std::vector<std::pair<pldm_tid_t, std::string>> endpoints;
+
+    std::ifstream file(config);
+    if (file.is_open())
+    {
+        auto json = nlohmann::json::parse(file, nullptr, false);
+        if (json.is_discarded())
+        {
+            error("Failed to parse the PLDM transport config '{PATH}'", "PATH",
+                  config);
+        }
+        else
+        {
+            try
+            {
+                defaultBackend = json.value("default", defaultBackend);
+                for (const auto& entry :
+                     json.value("endpoints", nlohmann::json::array()))
+                {
+                    endpoints.emplace_back(
+                        entry.at("eid").get<pldm_tid_t>(),
+                        entry.at("backend").get<std::string>());
+                }
+            }
+            catch (const std::exception& e)
+            {
+                error(
+                    "Invalid entry in the PLDM transport config '{PATH}', error - {ERROR}",
+                    "PATH", config, "ERROR", e);
+            }
+        }
+    }
+
+    routes.fill(&use(defaultBackend));
+    for (const auto& [tid, backend] : endpoints)
+    {
+        routes[tid] = &use(backend);
+    }
+}
+
+void PldmTransport::setupEventSources()
+{
+    std::vector<int> rxFds;
+    std::vector<int> txFds;
+    for (auto backend : rxBackends)
+    {
+        rxFds.push_back(backend->getEventSource());
+        if (auto fd = backend->getTxEventSource(); fd >= 0)
+        {
+            txFds.push_back(fd);
+        }
+    }
+
+    // A single backend is polled directly, as before the backends existed
+    if (rxFds.size() == 1)
+    {
+        pfd.fd = rxFds.front();
+    }
+    else
+    {
+        rxEpollFd = pldm::transport::makeEpoll(rxFds);
+        pfd.fd = rxEpollFd;
+    }
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    if (txFds.size() == 1)
+    {
+        txFd = txFds.front();
+    }
+    else if (txFds.size() > 1)
+    {
+        txEpollFd = pldm::transport::makeEpoll(txFds);
+        txFd = txEpollFd;
+    }
 }
 
 int PldmTransport::getEventSource() const
@@ -142,24 +603,167 @@ int PldmTransport::getEventSource() const
     return pfd.fd;
 }
 
+int PldmTransport::getTxEventSource() const
+{
+    return txFd;
+}
+
+void PldmTransport::processTx()
+{
+    for (auto backend : rxBackends)
+    {
+        backend->processTx();
+    }
+}
+
+int PldmTransport::flush()
+{
+    int rc = 0;
+    for (auto backend : rxBackends)
+    {
+        if (auto backendRc = backend->flush(); backendRc && !rc)
+        {
+            rc = backendRc;
+        }
+    }
+    return rc;
+}
+
 pldm_requester_rc_t PldmTransport::sendMsg(pldm_tid_t tid, const void* tx,
                                            size_t len)
 {
-    return pldm_transport_send_msg(transport, tid, tx, len);
+    return getBackend(tid).sendMsg(tid, tx, len);
+}
+
+namespace
+{
+
+pldm_requester_rc_t recvFrom(Backend& backend, pldm_tid_t& tid, void*& rx,
+                             size_t& len)
+{
+    return backend.recvMsg(tid, rx, len);
+}
+
+pldm_requester_rc_t recvFrom(Backend& backend, pldm_tid_t& tid,
+                             pldm::transport::RxBuffer& rx, size_t& len)
+{
+    return backend.recvBuffer(tid, rx, len);
+}
+
+void release(void*& rx)
+{
+    free(rx);
+    rx = nullptr;
+}
+
+void release(pldm::transport::RxBuffer& rx)
+{
+    rx.reset();
+}
+
+} // namespace
+
+template <typename Buffer>
+pldm_requester_rc_t PldmTransport::receive(pldm_tid_t& tid, Buffer& rx,
+                                           size_t& len)
+{
+    len = 0;
+    for (size_t i = 0; i < rxBackends.size(); i++)
+    {
+        auto backend = rxBackends[nextRx];
+        nextRx = (nextRx + 1) % rxBackends.size();
+
+        auto rc = recvFrom(*backend, tid, rx, len);
+        if (rc == PLDM_REQUESTER_TRANSPORT_BUSY)
+        {
+            continue;
+        }
+        if (rc == PLDM_REQUESTER_SUCCESS && len < sizeof(pldm_msg_hdr))
+        {
+            release(rx);
+            len = 0;
+            return PLDM_REQUESTER_INVALID_RECV_LEN;
+        }
+        return rc;
+    }
+    return PLDM_REQUESTER_TRANSPORT_BUSY;
 }
 
 pldm_requester_rc_t PldmTransport::recvMsg(pldm_tid_t& tid, void*& rx,
                                            size_t& len)
 {
-    return pldm_transport_recv_msg(transport, &tid, (void**)&rx, &len);
+    rx = nullptr;
+    return receive(tid, rx, len);
+}
+
+pldm_requester_rc_t PldmTransport::recvMsg(
+    pldm_tid_t& tid, pldm::transport::RxBuffer& rx, size_t& len)
+{
+    rx.reset();
+    return receive(tid, rx, len);
 }
 
 pldm_requester_rc_t PldmTransport::sendRecvMsg(
     pldm_tid_t tid, const void* tx, size_t txLen, void*& rx, size_t& rxLen)
 {
-    std::cout << "send receive\n";
-    MCTP::send(tid, reinterpret_cast<const uint8_t*>(tx), txLen);
+    if (txLen < sizeof(pldm_msg_hdr))
+    {
+        return PLDM_REQUESTER_NOT_REQ_MSG;
+    }
+    auto reqHdr = static_cast<const pldm_msg_hdr*>(tx);
 
-    std::cout << tid << tx << txLen << rx << rxLen << std::endl;
-    return pldm_requester_rc_t::PLDM_REQUESTER_RECV_FAIL;
+    auto rc = sendMsg(tid, tx, txLen);
+    if (rc != PLDM_REQUESTER_SUCCESS)
+    {
+        return rc;
+    }
+    // sendRecvMsg() is synchronous by contract, drain the TX queue inline
+    if (getBackend(tid).flush())
+    {
+        return PLDM_REQUESTER_SEND_FAIL;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(RESPONSE_TIME_OUT);
+    while (true)
+    {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0)
+        {
+            return PLDM_REQUESTER_RECV_FAIL;
+        }
+
+        int ret = poll(&pfd, 1, remaining.count());
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return PLDM_REQUESTER_POLL_FAIL;
+        }
+        if (ret == 0)
+        {
+            return PLDM_REQUESTER_RECV_FAIL;
+        }
+
+        pldm_tid_t rxTid{};
+        void* msg = nullptr;
+        size_t len = 0;
+        while (recvMsg(rxTid, msg, len) == PLDM_REQUESTER_SUCCESS)
+        {
+            auto rspHdr = static_cast<const pldm_msg_hdr*>(msg);
+            if (rxTid == tid && !rspHdr->request &&
+                rspHdr->instance_id == reqHdr->instance_id &&
+                rspHdr->type == reqHdr->type &&
+                rspHdr->command == reqHdr->command)
+            {
+                rx = msg;
+                rxLen = len;
+                return PLDM_REQUESTER_SUCCESS;
+            }
+            free(msg);
+        }
+    }
 }
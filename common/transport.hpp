@@ -1,25 +1,50 @@
 #pragma once
 
+#include "common/transport_backend.hpp"
+
 #include <libpldm/base.h>
 #include <libpldm/pldm.h>
 #include <poll.h>
 
+#include <array>
 #include <cstddef>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
-struct pldm_transport_mctp_demux;
-struct pldm_transport_af_mctp;
-
-union TransportImpl
-{
-    struct pldm_transport_mctp_demux* mctp_demux;
-    struct pldm_transport_af_mctp* af_mctp;
-};
-
-/* RAII for pldm_transport */
+/** @class PldmTransport
+ *
+ *  Exchanges PLDM messages with the endpoints through the backends of
+ *  pldm::transport. Every endpoint uses the default backend, unless a
+ *  JSON file routes it to another one:
+ *
+ *  {
+ *      "default": "i2c",
+ *      "endpoints": [{ "eid": 9, "backend": "af-mctp" }]
+ *  }
+ *
+ *  Only the backends in use are created.
+ */
 class PldmTransport
 {
   public:
+    /** @brief Constructor, routing the endpoints as configured in
+     *         TRANSPORT_CONFIG_JSON
+     *
+     *  Without the file, every endpoint is routed to PLDM_TRANSPORT_DEFAULT.
+     *  Throws std::system_error if a backend cannot be created.
+     */
     PldmTransport();
+
+    /** @brief Constructor, routing every endpoint to one backend
+     *
+     *  @param[in] backend - name of the backend, see
+     *                       pldm::transport::getBackends()
+     */
+    explicit PldmTransport(const std::string& backend);
+
     PldmTransport(const PldmTransport& other) = delete;
     PldmTransport(const PldmTransport&& other) = delete;
     PldmTransport& operator=(const PldmTransport& other) = delete;
@@ -29,12 +54,31 @@ class PldmTransport
     /** @brief Provides a file descriptor that can be polled for readiness.
      *
      * Readiness generally indicates that a call to recvMsg() will immediately
-     * yield a message.
+     * yield a message. With several backends in use, this is an epoll file
+     * descriptor over theirs.
      *
      * @return The relevant file descriptor.
      */
     int getEventSource() const;
 
+    /** @brief Provides a file descriptor, readable while messages queued by
+     *         sendMsg() wait for processTx()
+     *
+     *  @return The file descriptor, -1 if no backend in use queues messages
+     */
+    int getTxEventSource() const;
+
+    /** @brief Make progress on the messages queued by the backends */
+    void processTx();
+
+    /** @brief Synchronously send every message queued by the backends
+     *
+     *  Intended for tools that do not run an event loop.
+     *
+     *  @return 0 on success, negative errno if a message was not sent
+     */
+    int flush();
+
     /** @brief Asynchronously send a PLDM message to the specified terminus
      *
      * The message may be either a request or a response.
@@ -51,7 +95,10 @@ class PldmTransport
     /** @brief Asynchronously receive a PLDM message addressed to the local
      * terminus
      *
-     * The message may be either a request or a response.
+     * The message may be either a request or a response. The backends are
+     * polled in turn, so one busy backend does not starve the others. The
+     * buffer queued by the backend is handed over without another copy, the
+     * caller releases it with free().
      *
      * @param[out] tid - The terminus ID of the message source
      * @param[out] rx - A pointer to the received, encoded message
@@ -62,6 +109,21 @@ class PldmTransport
      */
     pldm_requester_rc_t recvMsg(pldm_tid_t& tid, void*& rx, size_t& len);
 
+    /** @brief Asynchronously receive a PLDM message, in a buffer the
+     *         backend may pool
+     *
+     *  Callers draining many messages avoid an allocation per message: the
+     *  buffer returns to the pool of the backend once released.
+     *
+     *  @param[out] tid - The terminus ID of the message source
+     *  @param[out] rx - The received, encoded message
+     *  @param[out] len - The length of rx
+     *
+     *  @return as recvMsg()
+     */
+    pldm_requester_rc_t recvMsg(pldm_tid_t& tid,
+                                pldm::transport::RxBuffer& rx, size_t& len);
+
     /** @brief Synchronously exchange a request and response with the specified
      * terminus.
      *
@@ -89,18 +151,52 @@ class PldmTransport
                                     size_t txLen, void*& rx, size_t& rxLen);
 
   private:
-    /** @brief A pollfd object for holding a file descriptor from the libpldm
-     *         transport implementation
+    /** @brief Create a backend, if not in use yet
+     *
+     *  @return the backend
      */
-    pollfd pfd;
+    pldm::transport::Backend& use(const std::string& name);
 
-    /** @brief A union holding an appropriately-typed pointer to the selected
-     *         libpldm transport implementation
+    /** @brief Receive from the backends in turn, into a buffer of type
+     *         void* or RxBuffer
      */
-    TransportImpl impl;
+    template <typename Buffer>
+    pldm_requester_rc_t receive(pldm_tid_t& tid, Buffer& rx, size_t& len);
+
+    /** @brief Read the routes of the endpoints and create their backends */
+    void configure(const std::filesystem::path& config);
 
-    /** @brief The abstract libpldm transport object for sending and receiving
-     *         PLDM messages.
+    /** @brief Set up the event sources once the backends are created */
+    void setupEventSources();
+
+    /** @brief Get the backend of a terminus */
+    pldm::transport::Backend& getBackend(pldm_tid_t tid)
+    {
+        return *routes[tid];
+    }
+
+    /** @brief Backends in use, by name */
+    std::map<std::string, std::unique_ptr<pldm::transport::Backend>>
+        backends;
+
+    /** @brief Backends in use, in the order recvMsg() polls them */
+    std::vector<pldm::transport::Backend*> rxBackends;
+
+    /** @brief Index in rxBackends of the next backend to poll */
+    size_t nextRx = 0;
+
+    /** @brief Backend of each terminus */
+    std::array<pldm::transport::Backend*, 256> routes{};
+
+    /** @brief epoll file descriptors over the RX and TX event sources of the
+     *         backends, -1 when a single backend needs none
      */
-    struct pldm_transport* transport;
+    int rxEpollFd = -1;
+    int txEpollFd = -1;
+
+    /** @brief A pollfd object for holding the event source */
+    pollfd pfd;
+
+    /** @brief TX event source, see getTxEventSource() */
+    int txFd = -1;
 };
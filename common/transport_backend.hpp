@@ -0,0 +1,223 @@
+#pragma once
+
+#include <libpldm/base.h>
+#include <libpldm/pldm.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+
+namespace transport
+{
+
+/** @class BufferPool
+ *
+ *  Receive buffers of a fixed size, reused from one message to the next
+ *  instead of allocated and freed for each of them.
+ */
+class BufferPool
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] size - size of the buffers
+     *  @param[in] maxIdle - most released buffers kept for reuse, the others
+     *                       are freed
+     */
+    BufferPool(size_t size, size_t maxIdle) : size(size), maxIdle(maxIdle) {}
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    ~BufferPool()
+    {
+        for (auto buffer : idle)
+        {
+            free(buffer);
+        }
+    }
+
+    /** @brief Get a buffer, nullptr if none can be allocated */
+    void* get()
+    {
+        if (idle.empty())
+        {
+            return malloc(size);
+        }
+        auto buffer = idle.back();
+        idle.pop_back();
+        return buffer;
+    }
+
+    /** @brief Give a buffer back */
+    void put(void* buffer)
+    {
+        if (idle.size() < maxIdle)
+        {
+            idle.push_back(buffer);
+            return;
+        }
+        free(buffer);
+    }
+
+    /** @brief Size of the buffers */
+    size_t bufferSize() const
+    {
+        return size;
+    }
+
+  private:
+    size_t size;
+    size_t maxIdle;
+    std::vector<void*> idle;
+};
+
+/** @brief Release a received buffer to its pool, or with free() if it has
+ *         none
+ */
+struct RxBufferRelease
+{
+    std::shared_ptr<BufferPool> pool;
+
+    void operator()(void* buffer) const
+    {
+        if (pool)
+        {
+            pool->put(buffer);
+        }
+        else
+        {
+            free(buffer);
+        }
+    }
+};
+
+/** @brief A received message, owning its buffer */
+using RxBuffer = std::unique_ptr<void, RxBufferRelease>;
+
+/** @class Backend
+ *
+ *  A way of exchanging PLDM messages with endpoints: the MCTP I2C binding,
+ *  the libpldm mctp-demux transport, AF_MCTP sockets, or the loopback
+ *  network of the process. PldmTransport routes each endpoint to one
+ *  backend.
+ *
+ *  Sending and receiving never block: readiness of getEventSource() tells
+ *  messages may be received, until recvMsg() reports the backend busy, and
+ *  the backends with a TX queue drain it from processTx(), while
+ *  getTxEventSource() is readable.
+ */
+class Backend
+{
+  public:
+    virtual ~Backend() = default;
+
+    /** @brief Provides a file descriptor, readable when recvMsg() may yield
+     *         a message
+     */
+    virtual int getEventSource() const = 0;
+
+    /** @brief Queue a PLDM message to a terminus
+     *
+     *  @param[in] tid - terminus ID of the destination
+     *  @param[in] tx - the encoded and framed message
+     *  @param[in] len - length of tx
+     *
+     *  @return PLDM_REQUESTER_SUCCESS on success, otherwise an appropriate
+     *          PLDM_REQUESTER_* error code
+     */
+    virtual pldm_requester_rc_t sendMsg(pldm_tid_t tid, const void* tx,
+                                        size_t len) = 0;
+
+    /** @brief Receive a PLDM message
+     *
+     *  The buffer queued by the backend is handed over without another
+     *  copy, the caller releases it with free().
+     *
+     *  @param[out] tid - terminus ID of the source
+     *  @param[out] rx - the received message
+     *  @param[out] len - length of rx
+     *
+     *  @return PLDM_REQUESTER_SUCCESS on success,
+     *          PLDM_REQUESTER_TRANSPORT_BUSY if no message is available,
+     *          otherwise an appropriate PLDM_REQUESTER_* error code
+     */
+    virtual pldm_requester_rc_t recvMsg(pldm_tid_t& tid, void*& rx,
+                                        size_t& len) = 0;
+
+    /** @brief Receive a PLDM message, in a buffer the backend may pool
+     *
+     *  Backends receiving into pooled buffers override it, the buffer goes
+     *  back to the pool once released. The default hands out the buffer of
+     *  recvMsg().
+     *
+     *  @param[out] tid - terminus ID of the source
+     *  @param[out] rx - the received message
+     *  @param[out] len - length of rx
+     *
+     *  @return as recvMsg()
+     */
+    virtual pldm_requester_rc_t recvBuffer(pldm_tid_t& tid, RxBuffer& rx,
+                                           size_t& len)
+    {
+        void* msg = nullptr;
+        auto rc = recvMsg(tid, msg, len);
+        rx.reset(msg);
+        return rc;
+    }
+
+    /** @brief Provides a file descriptor, readable while queued messages
+     *         wait for processTx()
+     *
+     *  @return the file descriptor, -1 if messages are sent at once
+     */
+    virtual int getTxEventSource() const
+    {
+        return -1;
+    }
+
+    /** @brief Make progress on the queued messages */
+    virtual void processTx() {}
+
+    /** @brief Send every queued message
+     *
+     *  @return 0 on success, negative errno if a message was not sent
+     */
+    virtual int flush()
+    {
+        return 0;
+    }
+};
+
+/** @brief Create a backend, throws std::system_error on failure */
+using BackendFactory = std::function<std::unique_ptr<Backend>()>;
+
+/** @brief Backends compiled in, by name
+ *
+ *  "i2c", "mctp-demux", "af-mctp" and "loopback", as enabled by the
+ *  transport-backends build option.
+ */
+const std::map<std::string, BackendFactory>& getBackends();
+
+/** @brief Set the MCTP network the "af-mctp" backend binds and sends on
+ *
+ *  MCTP_NET_ANY unless set. Only the backends created afterwards use it, a
+ *  pldmd instance claiming a single network sets it before creating its
+ *  PldmTransport, so that the instances of the other networks can bind the
+ *  PLDM message type as well.
+ *
+ *  @param[in] network - the MCTP network
+ */
+void setMctpNetwork(uint32_t network);
+
+} // namespace transport
+
+} // namespace pldm
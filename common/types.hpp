@@ -117,6 +117,9 @@ using CompClassificationIndex = uint8_t;
 using ComponentInfo = std::map<CompKey, CompClassificationIndex>;
 using ComponentInfoMap = std::unordered_map<eid, ComponentInfo>;
 
+// MCTP network of the discovered endpoints
+using NetworkMap = std::unordered_map<eid, NetworkId>;
+
 // PackageHeaderInformation
 using PackageHeaderSize = size_t;
 using PackageVersion = std::string;
@@ -1,8 +1,13 @@
 #include "utils.hpp"
 
+#include "daemon_stats.hpp"
+#include "service_cache.hpp"
+#include "trace.hpp"
+
 #include <libpldm/pdr.h>
 #include <libpldm/pldm_types.h>
 #include <linux/mctp.h>
+#include <malloc.h>
 
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
@@ -12,10 +17,13 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cerrno>
 #include <ctime>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -140,28 +148,32 @@ std::vector<std::vector<uint8_t>> findStateSensorPDR(
 
 uint8_t readHostEID()
 {
-    uint8_t eid{};
+    auto eids = readHostEIDs();
+    return eids.empty() ? 0 : eids.front();
+}
+
+std::vector<uint8_t> readHostEIDs()
+{
+    std::vector<uint8_t> eids;
     std::ifstream eidFile{HOST_EID_PATH};
     if (!eidFile.good())
     {
         error("Failed to open remote terminus EID file at path '{PATH}'",
               "PATH", static_cast<std::string>(HOST_EID_PATH));
+        return eids;
     }
-    else
+
+    std::string eidStr;
+    while (eidFile >> eidStr)
     {
-        std::string eidStr;
-        eidFile >> eidStr;
-        if (!eidStr.empty())
-        {
-            eid = atoi(eidStr.c_str());
-        }
-        else
-        {
-            error("Remote terminus EID file was empty");
-        }
+        eids.emplace_back(atoi(eidStr.c_str()));
+    }
+    if (eids.empty())
+    {
+        error("Remote terminus EID file was empty");
     }
 
-    return eid;
+    return eids;
 }
 
 bool isValidEID(eid mctpEid)
@@ -228,9 +240,120 @@ std::optional<std::vector<set_effecter_state_field>> parseEffecterData(
     return std::make_optional(std::move(stateField));
 }
 
+namespace
+{
+
+/** @brief The service names resolved by getService() and the matches
+ *         keeping them up to date
+ */
+struct ServiceCacheState
+{
+    ServiceCache cache;
+    std::vector<std::unique_ptr<sdbusplus::bus::match_t>> matches;
+};
+
+ServiceCacheState& serviceCacheState()
+{
+    // The bus must outlive the matches
+    DBusHandler::getBus();
+    static ServiceCacheState state;
+    return state;
+}
+
+} // namespace
+
+void DBusHandler::enableServiceCache(size_t capacity, bool warmStart)
+{
+    using namespace sdbusplus::bus::match::rules;
+
+    auto& state = serviceCacheState();
+    state.matches.clear();
+    state.cache = ServiceCache(capacity);
+    if (!capacity)
+    {
+        return;
+    }
+
+    auto& bus = getBus();
+    auto onInterfaces = [](sdbusplus::message_t& msg) {
+        sdbusplus::message::object_path path;
+        msg.read(path);
+        serviceCacheState().cache.erasePath(path.str);
+    };
+    state.matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, interfacesAdded(), onInterfaces));
+    state.matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, interfacesRemoved(), onInterfaces));
+    state.matches.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
+        bus, nameOwnerChanged(), [](sdbusplus::message_t& msg) {
+            std::string name;
+            std::string oldOwner;
+            std::string newOwner;
+            msg.read(name, oldOwner, newOwner);
+            if (!oldOwner.empty())
+            {
+                auto& cache = serviceCacheState().cache;
+                cache.eraseService(name);
+                cache.eraseService(oldOwner);
+            }
+        }));
+
+    if (!warmStart)
+    {
+        return;
+    }
+
+    // Resolve like getService(): the first service in name order wins
+    std::map<std::pair<std::string, std::string>, std::string> services;
+    try
+    {
+        for (const auto& [path, serviceMap] :
+             DBusHandler().getSubtree("/", 0, {}))
+        {
+            for (const auto& [service, interfaces] : serviceMap)
+            {
+                auto add = [&](const std::string& interface) {
+                    auto [it, inserted] =
+                        services.try_emplace({path, interface}, service);
+                    if (!inserted && service < it->second)
+                    {
+                        it->second = service;
+                    }
+                };
+                add({});
+                std::ranges::for_each(interfaces, add);
+            }
+        }
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        error("Failed to prefill the D-Bus service cache, error - {ERROR}",
+              "ERROR", e);
+        return;
+    }
+
+    for (const auto& [key, service] : services)
+    {
+        if (state.cache.size() >= capacity)
+        {
+            break;
+        }
+        state.cache.insert(key.first, key.second, service);
+    }
+    info("Prefilled the D-Bus service cache with {COUNT} entries", "COUNT",
+         state.cache.size());
+}
+
 std::string DBusHandler::getService(const char* path,
                                     const char* interface) const
 {
+    auto& cache = serviceCacheState().cache;
+    std::string cacheInterface = interface ? interface : "";
+    if (auto service = cache.get(path, cacheInterface))
+    {
+        return *service;
+    }
+
     using DbusInterfaceList = std::vector<std::string>;
     std::map<std::string, std::vector<std::string>> mapperResponse;
     auto& bus = DBusHandler::getBus();
@@ -248,9 +371,13 @@ std::string DBusHandler::getService(const char* path,
         mapper.append(path, DbusInterfaceList({}));
     }
 
+    PLDM_TRACE_SPAN("GetObject", "dbus");
+    stats::DaemonStats::getInstance().addDbusCall("GetObject");
     auto mapperResponseMsg = bus.call(mapper, dbusTimeout);
     mapperResponseMsg.read(mapperResponse);
-    return mapperResponse.begin()->first;
+    const auto& service = mapperResponse.begin()->first;
+    cache.insert(path, cacheInterface, service);
+    return service;
 }
 
 GetSubTreeResponse DBusHandler::getSubtree(
@@ -262,6 +389,8 @@ GetSubTreeResponse DBusHandler::getSubtree(
                                       ObjectMapper::instance_path,
                                       ObjectMapper::interface, "GetSubTree");
     method.append(searchPath, depth, ifaceList);
+    PLDM_TRACE_SPAN("GetSubTree", "dbus");
+    stats::DaemonStats::getInstance().addDbusCall("GetSubTree");
     auto reply = bus.call(method, dbusTimeout);
     GetSubTreeResponse response;
     reply.read(response);
@@ -278,6 +407,8 @@ GetSubTreePathsResponse DBusHandler::getSubTreePaths(
         ObjectMapper::default_service, ObjectMapper::instance_path,
         ObjectMapper::interface, "GetSubTreePaths");
     method.append(objectPath, depth, ifaceList);
+    PLDM_TRACE_SPAN("GetSubTreePaths", "dbus");
+    stats::DaemonStats::getInstance().addDbusCall("GetSubTreePaths");
     auto reply = bus.call(method, dbusTimeout);
 
     reply.read(paths);
@@ -292,6 +423,8 @@ GetAncestorsResponse DBusHandler::getAncestors(
                                       ObjectMapper::instance_path,
                                       ObjectMapper::interface, "GetAncestors");
     method.append(path, ifaceList);
+    PLDM_TRACE_SPAN("GetAncestors", "dbus");
+    stats::DaemonStats::getInstance().addDbusCall("GetAncestors");
     auto reply = bus.call(method, dbusTimeout);
     GetAncestorsResponse response;
     reply.read(response);
@@ -327,69 +460,70 @@ void reportError(const char* errorMsg)
     }
 }
 
-void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
-                                  const PropertyValue& value) const
+/** @brief Append a property value to a Set call, as the D-Bus type of the
+ *         property
+ *
+ *  @throw std::invalid_argument for an unsupported D-Bus type
+ *         std::bad_variant_access when value does not hold that type
+ */
+static void appendDbusValue(sdbusplus::message_t& method,
+                            const DBusMapping& dBusMap,
+                            const PropertyValue& value)
 {
-    auto setDbusValue = [&dBusMap, this](const auto& variant) {
-        auto& bus = getBus();
-        auto service =
-            getService(dBusMap.objectPath.c_str(), dBusMap.interface.c_str());
-        auto method = bus.new_method_call(
-            service.c_str(), dBusMap.objectPath.c_str(), dbusProperties, "Set");
+    auto append = [&method, &dBusMap](const auto& variant) {
         method.append(dBusMap.interface.c_str(), dBusMap.propertyName.c_str(),
                       variant);
-        bus.call_noreply(method, dbusTimeout);
     };
 
     if (dBusMap.propertyType == "uint8_t")
     {
         std::variant<uint8_t> v = std::get<uint8_t>(value);
-        setDbusValue(v);
+        append(v);
     }
     else if (dBusMap.propertyType == "bool")
     {
         std::variant<bool> v = std::get<bool>(value);
-        setDbusValue(v);
+        append(v);
     }
     else if (dBusMap.propertyType == "int16_t")
     {
         std::variant<int16_t> v = std::get<int16_t>(value);
-        setDbusValue(v);
+        append(v);
     }
     else if (dBusMap.propertyType == "uint16_t")
     {
         std::variant<uint16_t> v = std::get<uint16_t>(value);
-        setDbusValue(v);
+        append(v);
     }
     else if (dBusMap.propertyType == "int32_t")
     {
         std::variant<int32_t> v = std::get<int32_t>(value);
-        setDbusValue(v);
+        append(v);
     }
     else if (dBusMap.propertyType == "uint32_t")
     {
         std::variant<uint32_t> v = std::get<uint32_t>(value);
-        setDbusValue(v);
+        append(v);
     }
     else if (dBusMap.propertyType == "int64_t")
     {
         std::variant<int64_t> v = std::get<int64_t>(value);
-        setDbusValue(v);
+        append(v);
     }
     else if (dBusMap.propertyType == "uint64_t")
     {
         std::variant<uint64_t> v = std::get<uint64_t>(value);
-        setDbusValue(v);
+        append(v);
     }
     else if (dBusMap.propertyType == "double")
     {
         std::variant<double> v = std::get<double>(value);
-        setDbusValue(v);
+        append(v);
     }
     else if (dBusMap.propertyType == "string")
     {
         std::variant<std::string> v = std::get<std::string>(value);
-        setDbusValue(v);
+        append(v);
     }
     else
     {
@@ -399,6 +533,20 @@ void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
     }
 }
 
+void DBusHandler::setDbusProperty(const DBusMapping& dBusMap,
+                                  const PropertyValue& value) const
+{
+    auto& bus = getBus();
+    auto service =
+        getService(dBusMap.objectPath.c_str(), dBusMap.interface.c_str());
+    auto method = bus.new_method_call(
+        service.c_str(), dBusMap.objectPath.c_str(), dbusProperties, "Set");
+    appendDbusValue(method, dBusMap, value);
+    PLDM_TRACE_SPAN("Set", "dbus");
+    stats::DaemonStats::getInstance().addDbusCall("Set");
+    bus.call_noreply(method, dbusTimeout);
+}
+
 PropertyValue DBusHandler::getDbusPropertyVariant(
     const char* objPath, const char* dbusProp, const char* dbusInterface) const
 {
@@ -407,9 +555,409 @@ PropertyValue DBusHandler::getDbusPropertyVariant(
     auto method =
         bus.new_method_call(service.c_str(), objPath, dbusProperties, "Get");
     method.append(dbusInterface, dbusProp);
+    PLDM_TRACE_SPAN("Get", "dbus");
+    stats::DaemonStats::getInstance().addDbusCall("Get");
     return bus.call(method, dbusTimeout).unpack<PropertyValue>();
 }
 
+void DBusHandler::getDbusPropertyVariantAsync(
+    const DBusMapping& dBusMap,
+    std::function<void(int rc, PropertyValue&& value)> callback) const
+{
+    try
+    {
+        AsyncDBusHandler().getDbusPropertyVariant(dBusMap, callback);
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to get property '{PROPERTY}' of path '{PATH}', error - {ERROR}",
+            "PROPERTY", dBusMap.propertyName, "PATH", dBusMap.objectPath,
+            "ERROR", e);
+        callback(-EIO, {});
+    }
+}
+
+namespace
+{
+
+using ReplyHandler = std::function<void(int rc, sdbusplus::message_t* reply)>;
+
+int onAsyncReply(sd_bus_message* msg, void* userdata, sd_bus_error*)
+{
+    auto& handler = *static_cast<ReplyHandler*>(userdata);
+    sdbusplus::message_t reply(msg);
+    if (reply.is_method_error())
+    {
+        auto rc = sd_bus_message_get_errno(msg);
+        handler(rc > 0 ? -rc : -EIO, nullptr);
+        return 0;
+    }
+    handler(0, &reply);
+    return 0;
+}
+
+void destroyReplyHandler(void* userdata)
+{
+    delete static_cast<ReplyHandler*>(userdata);
+}
+
+/** @brief Send a method call, handler gets the reply from the event loop
+ *
+ *  @param[in] method - the method call
+ *  @param[in] handler - called with the reply, nullptr on error
+ *  @param[in] timeout - timeout of the call in microseconds
+ */
+void callAsync(sdbusplus::message_t& method, ReplyHandler handler,
+               uint64_t timeout = dbusTimeout)
+{
+    stats::DaemonStats::getInstance().addDbusCall(method.get_member());
+#if TRACE_MAX_EVENTS
+    handler = [handler = std::move(handler), begin = pldm::trace::Clock::now()](
+                  int rc, sdbusplus::message_t* reply) {
+        PLDM_TRACE_ASYNC("call", "dbus", begin, 0);
+        handler(rc, reply);
+    };
+#endif
+    auto userdata = new ReplyHandler(std::move(handler));
+    sd_bus_slot* slot = nullptr;
+    auto rc = sd_bus_call_async(nullptr, &slot, method.get(), onAsyncReply,
+                                userdata, timeout);
+    if (rc < 0)
+    {
+        (*userdata)(rc, nullptr);
+        delete userdata;
+        return;
+    }
+
+    // The bus owns the slot until the reply was handled
+    sd_bus_slot_set_destroy_callback(slot, destroyReplyHandler);
+    sd_bus_slot_set_floating(slot, 1);
+    sd_bus_slot_unref(slot);
+}
+
+} // namespace
+
+void AsyncDBusHandler::getService(const std::string& path,
+                                  const std::string& interface,
+                                  ServiceCallback callback) const
+{
+    if (auto service = serviceCacheState().cache.get(path, interface))
+    {
+        callback(0, *service);
+        return;
+    }
+
+    auto& bus = DBusHandler::getBus();
+    auto mapper = bus.new_method_call(ObjectMapper::default_service,
+                                      ObjectMapper::instance_path,
+                                      ObjectMapper::interface, "GetObject");
+    mapper.append(path, std::vector<std::string>({interface}));
+    callAsync(mapper, [path, interface, callback = std::move(callback)](
+                          int rc, sdbusplus::message_t* reply) {
+        std::map<std::string, std::vector<std::string>> mapperResponse;
+        if (!rc)
+        {
+            try
+            {
+                reply->read(mapperResponse);
+            }
+            catch (const sdbusplus::exception_t&)
+            {
+                rc = -EBADMSG;
+            }
+        }
+        if (!rc && mapperResponse.empty())
+        {
+            rc = -ENOENT;
+        }
+        if (rc)
+        {
+            callback(rc, {});
+            return;
+        }
+        const auto& service = mapperResponse.begin()->first;
+        serviceCacheState().cache.insert(path, interface, service);
+        callback(0, service);
+    });
+}
+
+namespace
+{
+
+/** @brief Set a D-Bus property of an object of a resolved service */
+void setServiceProperty(const std::string& service, const DBusMapping& dBusMap,
+                        const PropertyValue& value,
+                        AsyncDBusHandler::Callback callback)
+{
+    auto method = DBusHandler::getBus().new_method_call(
+        service.c_str(), dBusMap.objectPath.c_str(), dbusProperties, "Set");
+    try
+    {
+        appendDbusValue(method, dBusMap, value);
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to encode property '{PROPERTY}' of path '{PATH}', error - {ERROR}",
+            "PROPERTY", dBusMap.propertyName, "PATH", dBusMap.objectPath,
+            "ERROR", e);
+        callback(-EINVAL);
+        return;
+    }
+    callAsync(method, [callback = std::move(callback)](
+                          int rc, sdbusplus::message_t*) { callback(rc); });
+}
+
+/** @brief Set D-Bus properties of the objects of a service one after the
+ *         other, from a write on, stopping at the first failing
+ */
+void setServiceProperties(std::string service,
+                          AsyncDBusHandler::PropertyWrites writes, size_t next,
+                          AsyncDBusHandler::Callback callback)
+{
+    if (next == writes.size())
+    {
+        callback(0);
+        return;
+    }
+
+    const auto& [dBusMap, value] = writes[next];
+    setServiceProperty(
+        service, dBusMap, value,
+        [service, writes = std::move(writes), next,
+         callback = std::move(callback)](int rc) mutable {
+            if (rc)
+            {
+                const auto& failed = writes[next].first;
+                error(
+                    "Failed to set property '{PROPERTY}', interface '{INTERFACE}' and path '{PATH}', error - {ERROR}",
+                    "PROPERTY", failed.propertyName, "INTERFACE",
+                    failed.interface, "PATH", failed.objectPath, "ERROR", -rc);
+                callback(rc);
+                return;
+            }
+            setServiceProperties(std::move(service), std::move(writes),
+                                 next + 1, std::move(callback));
+        });
+}
+
+} // namespace
+
+void AsyncDBusHandler::setDbusProperty(const DBusMapping& dBusMap,
+                                       const PropertyValue& value,
+                                       Callback callback) const
+{
+    getService(dBusMap.objectPath, dBusMap.interface,
+               [dBusMap, value, callback = std::move(callback)](
+                   int rc, const std::string& service) mutable {
+                   if (rc)
+                   {
+                       callback(rc);
+                       return;
+                   }
+                   setServiceProperty(service, dBusMap, value,
+                                      std::move(callback));
+               });
+}
+
+/** @brief Send a method call, callback gets the unpacked reply */
+template <typename Reply>
+void callAsyncUnpack(sdbusplus::message_t& method,
+                     std::function<void(int rc, Reply&& reply)> callback)
+{
+    callAsync(method, [callback = std::move(callback)](
+                          int rc, sdbusplus::message_t* msg) {
+        Reply reply{};
+        if (!rc)
+        {
+            try
+            {
+                msg->read(reply);
+            }
+            catch (const sdbusplus::exception_t&)
+            {
+                rc = -EBADMSG;
+            }
+        }
+        callback(rc, std::move(reply));
+    });
+}
+
+void AsyncDBusHandler::callMethod(sdbusplus::message_t& method,
+                                  uint64_t timeout,
+                                  ReplyCallback callback) const
+{
+    callAsync(method, std::move(callback), timeout);
+}
+
+void AsyncDBusHandler::getManagedObj(const std::string& service,
+                                     const std::string& path,
+                                     ManagedObjectsCallback callback) const
+{
+    auto method = DBusHandler::getBus().new_method_call(
+        service.c_str(), path.c_str(), "org.freedesktop.DBus.ObjectManager",
+        "GetManagedObjects");
+    callAsyncUnpack<ObjectValueTree>(method, std::move(callback));
+}
+
+void AsyncDBusHandler::getDbusPropertyVariant(const DBusMapping& dBusMap,
+                                              PropertyCallback callback) const
+{
+    getService(dBusMap.objectPath, dBusMap.interface,
+               [dBusMap, callback = std::move(callback)](
+                   int rc, const std::string& service) mutable {
+                   if (rc)
+                   {
+                       callback(rc, {});
+                       return;
+                   }
+
+                   auto method = DBusHandler::getBus().new_method_call(
+                       service.c_str(), dBusMap.objectPath.c_str(),
+                       dbusProperties, "Get");
+                   method.append(dBusMap.interface, dBusMap.propertyName);
+                   callAsyncUnpack<PropertyValue>(method, std::move(callback));
+               });
+}
+
+void AsyncDBusHandler::setDbusProperties(PropertyWrites writes,
+                                         Callback callback) const
+{
+    if (writes.empty())
+    {
+        callback(0);
+        return;
+    }
+
+    auto [dBusMap, value] = std::move(writes.front());
+    writes.erase(writes.begin());
+    setDbusProperty(
+        dBusMap, value,
+        [dBusMap, writes = std::move(writes),
+         callback = std::move(callback)](int rc) mutable {
+            if (rc)
+            {
+                error(
+                    "Failed to set property '{PROPERTY}', interface '{INTERFACE}' and path '{PATH}', error - {ERROR}",
+                    "PROPERTY", dBusMap.propertyName, "INTERFACE",
+                    dBusMap.interface, "PATH", dBusMap.objectPath, "ERROR",
+                    -rc);
+                callback(rc);
+                return;
+            }
+            // The handler making the call may be gone by now
+            AsyncDBusHandler().setDbusProperties(std::move(writes),
+                                                 std::move(callback));
+        });
+}
+
+void AsyncDBusHandler::setDbusPropertiesPerService(PropertyWrites writes,
+                                                   Callback callback) const
+{
+    if (writes.size() < 2)
+    {
+        setDbusProperties(std::move(writes), std::move(callback));
+        return;
+    }
+
+    setPropertiesPerService(
+        std::move(writes),
+        [](const DBusMapping& dBusMap, ServiceCallback resolved) {
+            // The handler making the call may be gone by now
+            AsyncDBusHandler().getService(dBusMap.objectPath,
+                                          dBusMap.interface,
+                                          std::move(resolved));
+        },
+        [](const std::string& service, PropertyWrites serviceWrites,
+           Callback done) {
+            setServiceProperties(service, std::move(serviceWrites), 0,
+                                 std::move(done));
+        },
+        std::move(callback));
+}
+
+void AsyncDBusHandler::setPropertiesPerService(
+    PropertyWrites writes, ServiceResolver resolve, ServiceWriter write,
+    Callback callback)
+{
+    struct Batch
+    {
+        PropertyWrites writes;
+        std::vector<std::string> services;
+        size_t pending;
+        int rc;
+        Callback callback;
+
+        void done(int writeRc)
+        {
+            if (writeRc && !rc)
+            {
+                rc = writeRc;
+            }
+            if (--pending == 0)
+            {
+                callback(rc);
+            }
+        }
+    };
+    if (writes.empty())
+    {
+        callback(0);
+        return;
+    }
+    auto count = writes.size();
+    auto batch = std::make_shared<Batch>(
+        std::move(writes), std::vector<std::string>(count), count, 0,
+        std::move(callback));
+
+    // The services are resolved first, most often from the service cache,
+    // then each service gets its writes in order
+    auto resolved = [batch, write = std::move(write)]() {
+        std::map<std::string, PropertyWrites> perService;
+        for (size_t index = 0; index < batch->writes.size(); index++)
+        {
+            if (!batch->services[index].empty())
+            {
+                perService[batch->services[index]].emplace_back(
+                    std::move(batch->writes[index]));
+            }
+        }
+        batch->pending = perService.size() + 1;
+        for (auto& [service, serviceWrites] : perService)
+        {
+            write(service, std::move(serviceWrites),
+                  [batch](int rc) { batch->done(rc); });
+        }
+        batch->done(0);
+    };
+
+    for (size_t index = 0; index < count; index++)
+    {
+        resolve(
+            batch->writes[index].first,
+            [batch, index, resolved](int rc, const std::string& service) {
+                if (rc)
+                {
+                    const auto& failed = batch->writes[index].first;
+                    error(
+                        "Failed to get the service of path '{PATH}' and interface '{INTERFACE}', error - {ERROR}",
+                        "PATH", failed.objectPath, "INTERFACE",
+                        failed.interface, "ERROR", -rc);
+                    batch->rc = batch->rc ? batch->rc : rc;
+                }
+                else
+                {
+                    batch->services[index] = service;
+                }
+                if (--batch->pending == 0)
+                {
+                    resolved();
+                }
+            });
+    }
+}
+
 ObjectValueTree DBusHandler::getManagedObj(const char* service,
                                            const char* rootPath)
 {
@@ -417,6 +965,8 @@ ObjectValueTree DBusHandler::getManagedObj(const char* service,
     auto method = bus.new_method_call(service, rootPath,
                                       "org.freedesktop.DBus.ObjectManager",
                                       "GetManagedObjects");
+    PLDM_TRACE_SPAN("GetManagedObjects", "dbus");
+    stats::DaemonStats::getInstance().addDbusCall("GetManagedObjects");
     return bus.call(method).unpack<ObjectValueTree>();
 }
 
@@ -428,6 +978,8 @@ PropertyMap DBusHandler::getDbusPropertiesVariant(
     auto method =
         bus.new_method_call(serviceName, objPath, dbusProperties, "GetAll");
     method.append(dbusInterface);
+    PLDM_TRACE_SPAN("GetAll", "dbus");
+    stats::DaemonStats::getInstance().addDbusCall("GetAll");
     return bus.call(method, dbusTimeout).unpack<PropertyMap>();
 }
 
@@ -599,7 +1151,14 @@ uint16_t findStateSensorId(const pldm_pdr* pdrRepo, uint8_t tid,
     return PLDM_INVALID_EFFECTER_ID;
 }
 
-void printBuffer(bool isTx, const std::vector<uint8_t>& buffer)
+void releaseFreedMemory()
+{
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+}
+
+void printBuffer(bool isTx, std::span<const uint8_t> buffer)
 {
     if (buffer.empty())
     {
@@ -655,6 +1214,30 @@ std::vector<std::string> split(std::string_view srcStr, std::string_view delim,
     return out;
 }
 
+void widenPathNamespace(std::string& pathNamespace, std::string_view objectPath)
+{
+    if (pathNamespace.empty())
+    {
+        pathNamespace = objectPath;
+        return;
+    }
+    size_t length = std::ranges::mismatch(pathNamespace, objectPath).in1 -
+                    pathNamespace.begin();
+    if (length == pathNamespace.size() &&
+        (length == objectPath.size() || objectPath[length] == '/'))
+    {
+        return;
+    }
+    if (length == objectPath.size() && pathNamespace[length] == '/')
+    {
+        pathNamespace.resize(length);
+        return;
+    }
+    auto slash =
+        length ? pathNamespace.rfind('/', length - 1) : std::string::npos;
+    pathNamespace.resize(slash == std::string::npos || slash == 0 ? 1 : slash);
+}
+
 std::string getCurrentSystemTime()
 {
     const auto zonedTime{std::chrono::zoned_time{
@@ -21,8 +21,10 @@
 #include <deque>
 #include <exception>
 #include <filesystem>
+#include <functional>
 #include <iostream>
 #include <map>
+#include <span>
 #include <string>
 #include <variant>
 #include <vector>
@@ -253,9 +255,24 @@ class DBusHandler : public DBusHandlerInterface
         return bus;
     }
 
+    /** @brief Cache the service names resolved by getService()
+     *
+     *  The cache is kept up to date from the InterfacesAdded,
+     *  InterfacesRemoved and NameOwnerChanged signals, so the process must
+     *  dispatch the messages of the bus, like the pldmd event loop does.
+     *
+     *  @param[in] capacity - number of object path and interface entries,
+     *                        the least recently used are evicted. 0 disables
+     *                        the cache
+     *  @param[in] warmStart - prefill the cache from one mapper GetSubTree
+     */
+    static void enableServiceCache(size_t capacity, bool warmStart);
+
     /**
      *  @brief Get the DBUS Service name for the input dbus path
      *
+     *  Served from the service cache once enabled.
+     *
      *  @param[in] path - DBUS object path
      *  @param[in] interface - DBUS Interface
      *
@@ -338,6 +355,20 @@ class DBusHandler : public DBusHandlerInterface
         const char* serviceName, const char* objPath,
         const char* dbusInterface) const override;
 
+    /** @brief Get a D-Bus property without blocking, like
+     *         AsyncDBusHandler::getDbusPropertyVariant()
+     *
+     *  Errors are passed to the callback, the method does not throw.
+     *
+     *  @param[in] dBusMap - Object path, property name and interface of the
+     *                       D-Bus object
+     *  @param[in] callback - called with 0 and the property value, else a
+     *                        negative errno
+     */
+    virtual void getDbusPropertyVariantAsync(
+        const DBusMapping& dBusMap,
+        std::function<void(int rc, PropertyValue&& value)> callback) const;
+
     /** @brief The template function to get property from the requested dbus
      *         path
      *
@@ -402,6 +433,121 @@ class DBusHandler : public DBusHandlerInterface
     }
 };
 
+/**
+ *  @class AsyncDBusHandler
+ *
+ *  D-Bus calls returning at once, the result of a call is passed to its
+ *  callback from the event loop when the reply arrives. Used by the
+ *  responders so a slow D-Bus service does not block pldmd.
+ *
+ *  The callbacks get 0 on success, else a negative errno. When a call can
+ *  not be sent its callback runs before the call returns.
+ */
+class AsyncDBusHandler
+{
+  public:
+    using Callback = std::function<void(int rc)>;
+    using ServiceCallback =
+        std::function<void(int rc, const std::string& service)>;
+    using PropertyWrites = std::vector<std::pair<DBusMapping, PropertyValue>>;
+    using ManagedObjectsCallback =
+        std::function<void(int rc, ObjectValueTree&& objects)>;
+    using PropertyCallback =
+        std::function<void(int rc, PropertyValue&& value)>;
+    using ReplyCallback =
+        std::function<void(int rc, sdbusplus::message_t* reply)>;
+    using ServiceResolver = std::function<void(const DBusMapping& dBusMap,
+                                               ServiceCallback callback)>;
+    using ServiceWriter = std::function<void(
+        const std::string& service, PropertyWrites writes, Callback callback)>;
+
+    /** @brief Call a D-Bus method
+     *
+     *  @param[in] method - the method call
+     *  @param[in] timeout - timeout of the call in microseconds
+     *  @param[in] callback - called with the reply, nullptr on error
+     */
+    void callMethod(sdbusplus::message_t& method, uint64_t timeout,
+                    ReplyCallback callback) const;
+
+    /** @brief Get the D-Bus service name of an object path
+     *
+     *  @param[in] path - D-Bus object path
+     *  @param[in] interface - D-Bus interface
+     *  @param[in] callback - called with the service name
+     */
+    void getService(const std::string& path, const std::string& interface,
+                    ServiceCallback callback) const;
+
+    /** @brief Set a D-Bus property
+     *
+     *  @param[in] dBusMap - Object path, property name, interface and property
+     *                       type for the D-Bus object
+     *  @param[in] value - The value to be set
+     *  @param[in] callback - called once the property is set
+     */
+    void setDbusProperty(const DBusMapping& dBusMap,
+                         const PropertyValue& value, Callback callback) const;
+
+    /** @brief Set D-Bus properties one after the other, in order
+     *
+     *  Stops at the first property failing to be set, like a loop of
+     *  DBusHandler::setDbusProperty() calls would.
+     *
+     *  @param[in] writes - the properties and their values
+     *  @param[in] callback - called once all the properties are set or one
+     *                        failed
+     */
+    void setDbusProperties(PropertyWrites writes, Callback callback) const;
+
+    /** @brief Set D-Bus properties, grouped per D-Bus service
+     *
+     *  The properties of the objects of a service are set one after the
+     *  other, in order, stopping at the first failing. The services are
+     *  written in parallel, a failing service does not stop the others.
+     *
+     *  @param[in] writes - the properties and their values
+     *  @param[in] callback - called once the writes of every service ended,
+     *                        with the error of the first failure
+     */
+    void setDbusPropertiesPerService(PropertyWrites writes,
+                                     Callback callback) const;
+
+    /** @brief Set properties grouped per service, the flow of
+     *         setDbusPropertiesPerService() with the service lookup and the
+     *         writes to a service given
+     *
+     *  @param[in] writes - the properties and their values
+     *  @param[in] resolve - gets the service of the object of a property
+     *  @param[in] write - sets the properties of a service in order,
+     *                     stopping at the first failing
+     *  @param[in] callback - called once the writes of every service ended,
+     *                        with the error of the first failure
+     */
+    static void setPropertiesPerService(PropertyWrites writes,
+                                        ServiceResolver resolve,
+                                        ServiceWriter write,
+                                        Callback callback);
+
+    /** @brief Get the objects managed by a D-Bus service under a path
+     *
+     *  @param[in] service - The D-Bus service providing the managed objects
+     *  @param[in] path - The object path of the object manager
+     *  @param[in] callback - called with the managed objects
+     */
+    void getManagedObj(const std::string& service, const std::string& path,
+                       ManagedObjectsCallback callback) const;
+
+    /** @brief Get a D-Bus property
+     *
+     *  @param[in] dBusMap - Object path, property name and interface of the
+     *                       D-Bus object
+     *  @param[in] callback - called with the property value
+     */
+    void getDbusPropertyVariant(const DBusMapping& dBusMap,
+                                PropertyCallback callback) const;
+};
+
 /** @brief Fetch parent D-Bus object based on pathname
  *
  *  @param[in] dbusObj - child D-Bus object
@@ -416,10 +562,17 @@ inline std::string findParent(const std::string& dbusObj)
 
 /** @brief Read (static) MCTP EID of host firmware from a file
  *
- *  @return uint8_t - MCTP EID
+ *  @return uint8_t - MCTP EID, of the first host when there are several
  */
 uint8_t readHostEID();
 
+/** @brief Read the (static) MCTP EIDs of the hosts firmware from a file,
+ *         separated by white space, in the order of the host indexes
+ *
+ *  @return the MCTP EIDs, empty if the file has none
+ */
+std::vector<uint8_t> readHostEIDs();
+
 /** @brief Validate the MCTP EID of MCTP endpoint
  *         In `Table 2 - Special endpoint IDs` of DSP0236. EID 0 is NULL_EID.
  *         EID from 1 to 7 is reserved EID. EID 0xFF is broadcast EID.
@@ -512,6 +665,16 @@ int emitStateSensorEventSignal(uint8_t tid, uint16_t sensorId,
  */
 void recoverMctpEndpoint(const std::string& endpointObjPath);
 
+/** @brief Return the heap pages freed in bulk to the system
+ *
+ *  The PDR repository of libpldm and the sensors allocate one block per
+ *  record, the blocks freed when a terminus or the host PDRs go away are
+ *  scattered over the heap and the pages holding them stay mapped. Called
+ *  after such a bulk release, for the RSS of pldmd to come back to its
+ *  level before the PDRs were added.
+ */
+void releaseFreedMemory();
+
 /** @brief Print the buffer
  *
  *  @param[in]  isTx - True if the buffer is an outgoing PLDM message, false if
@@ -520,7 +683,7 @@ void recoverMctpEndpoint(const std::string& endpointObjPath);
  *
  *  @return - None
  */
-void printBuffer(bool isTx, const std::vector<uint8_t>& buffer);
+void printBuffer(bool isTx, std::span<const uint8_t> buffer);
 
 /** @brief Convert the buffer to std::string
  *
@@ -546,6 +709,17 @@ std::string toString(const struct variable_field& var);
  */
 std::vector<std::string> split(std::string_view srcStr, std::string_view delim,
                                std::string_view trimStr = "");
+
+/** @brief Widen a D-Bus path namespace to the deepest one also holding an
+ *         object path
+ *
+ *  @param[in,out] pathNamespace - path namespace, empty to start from the
+ *                                 object path
+ *  @param[in] objectPath - D-Bus object path
+ */
+void widenPathNamespace(std::string& pathNamespace,
+                        std::string_view objectPath);
+
 /** @brief Get the current system time in readable format
  *
  *  @return - std::string equivalent of the system time
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/async.hpp>
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace pldm
+{
+namespace utils
+{
+
+/** @brief Completion signature of a sender of a T */
+template <typename T>
+struct ValueSignature
+{
+    using type = stdexec::set_value_t(T);
+};
+
+template <>
+struct ValueSignature<void>
+{
+    using type = stdexec::set_value_t();
+};
+
+/** @class WorkerPool
+ *
+ *  A few threads running the CPU heavy work of pldmd, as checksums of large
+ *  tables or the decoding of bulky event data, off the event loop. A job
+ *  runs on a worker, its completion then runs on the event loop, where the
+ *  rest of pldmd lives; the job must only touch the data handed to it. The
+ *  threads are started by the first job, at most WORKER_POOL_THREADS jobs
+ *  run at once and the other ones wait in FIFO order.
+ */
+class WorkerPool
+{
+  public:
+    using Job = std::function<void()>;
+    using Completion = std::function<void()>;
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /** @brief The pool of the default event loop */
+    static WorkerPool& getInstance()
+    {
+        static WorkerPool pool(sdeventplus::Event::get_default(),
+                               WORKER_POOL_THREADS);
+        return pool;
+    }
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - event loop the completions run on
+     *  @param[in] threads - number of worker threads
+     */
+    WorkerPool(const sdeventplus::Event& event, size_t threads) :
+        event(event), threads(std::max<size_t>(threads, 1))
+    {}
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard lock(mutex);
+            jobs.clear();
+        }
+        workers.clear();
+        completionSource.reset();
+        if (completionFd >= 0)
+        {
+            close(completionFd);
+        }
+    }
+
+    /** @brief Run a job on a worker
+     *
+     *  @param[in] job - work run on a worker thread
+     *  @param[in] completion - called on the event loop once the job is done
+     *
+     *  @throw std::system_error if the pool can't be started
+     */
+    void post(Job&& job, Completion&& completion)
+    {
+        start();
+        {
+            std::lock_guard lock(mutex);
+            jobs.emplace_back(std::move(job), std::move(completion));
+        }
+        jobReady.notify_one();
+    }
+
+    /** @brief Run a function on a worker, resuming on the event loop
+     *
+     *  @param[in] work - function run on a worker thread
+     *
+     *  @return a sender of the result of work, or of the exception it threw,
+     *          completing on the event loop, to co_await in an exec::task
+     */
+    template <typename F>
+    auto offload(F&& work)
+    {
+        return OffloadSender<std::decay_t<F>>{*this, std::forward<F>(work)};
+    }
+
+  private:
+    /** @brief Start the workers and the completion source, once */
+    void start()
+    {
+        if (completionFd >= 0)
+        {
+            return;
+        }
+        completionFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (completionFd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to create the worker eventfd");
+        }
+        completionSource = std::make_unique<sdeventplus::source::IO>(
+            event, completionFd, EPOLLIN,
+            [this](sdeventplus::source::IO&, int, uint32_t) {
+                runCompletions();
+            });
+        for (size_t i = 0; i < threads; i++)
+        {
+            workers.emplace_back(
+                [this](std::stop_token stop) { runJobs(stop); });
+        }
+    }
+
+    /** @brief Body of a worker thread */
+    void runJobs(std::stop_token stop)
+    {
+        while (true)
+        {
+            std::pair<Job, Completion> job;
+            {
+                std::unique_lock lock(mutex);
+                if (!jobReady.wait(lock, stop,
+                                   [this] { return !jobs.empty(); }))
+                {
+                    return;
+                }
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            job.first();
+
+            {
+                std::lock_guard lock(mutex);
+                completions.emplace_back(std::move(job.second));
+            }
+            uint64_t one = 1;
+            [[maybe_unused]] auto written =
+                write(completionFd, &one, sizeof(one));
+        }
+    }
+
+    /** @brief Run the completions of the jobs done, on the event loop */
+    void runCompletions()
+    {
+        uint64_t count;
+        [[maybe_unused]] auto readBytes =
+            read(completionFd, &count, sizeof(count));
+
+        std::vector<Completion> done;
+        {
+            std::lock_guard lock(mutex);
+            done.swap(completions);
+        }
+        for (auto& completion : done)
+        {
+            completion();
+        }
+    }
+
+    template <typename F>
+    using Result = std::invoke_result_t<F&>;
+
+    /** @brief State of an offload, living in the awaiting coroutine frame
+     *
+     *  @tparam F - the function offloaded
+     *  @tparam R - the receiver of its result
+     */
+    template <typename F, stdexec::receiver R>
+    struct OffloadOperation
+    {
+        friend void tag_invoke(stdexec::start_t, OffloadOperation& op) noexcept
+        {
+            try
+            {
+                op.pool.post([&op]() { op.run(); }, [&op]() { op.complete(); });
+            }
+            catch (...)
+            {
+                stdexec::set_error(std::move(op.receiver),
+                                   std::current_exception());
+            }
+        }
+
+        /** @brief Run the function, on a worker */
+        void run()
+        {
+            try
+            {
+                if constexpr (std::is_void_v<Result<F>>)
+                {
+                    work();
+                }
+                else
+                {
+                    result.emplace(work());
+                }
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+        }
+
+        /** @brief Hand the result to the receiver, on the event loop */
+        void complete()
+        {
+            if (exception)
+            {
+                stdexec::set_error(std::move(receiver), exception);
+            }
+            else if constexpr (std::is_void_v<Result<F>>)
+            {
+                stdexec::set_value(std::move(receiver));
+            }
+            else
+            {
+                stdexec::set_value(std::move(receiver), std::move(*result));
+            }
+        }
+
+        WorkerPool& pool;
+        F work;
+        R receiver;
+        std::conditional_t<std::is_void_v<Result<F>>, std::monostate,
+                           std::optional<Result<F>>>
+            result{};
+        std::exception_ptr exception;
+    };
+
+    /** @brief Sender of the result of an offloaded function
+     *
+     *  @tparam F - the function offloaded
+     */
+    template <typename F>
+    struct OffloadSender
+    {
+        using is_sender = void;
+
+        friend auto tag_invoke(stdexec::get_completion_signatures_t,
+                               const OffloadSender&, auto)
+            -> stdexec::completion_signatures<
+                typename ValueSignature<Result<F>>::type,
+                stdexec::set_error_t(std::exception_ptr)>;
+
+        template <stdexec::receiver R>
+        friend auto tag_invoke(stdexec::connect_t, OffloadSender&& self, R r)
+        {
+            return OffloadOperation<F, R>{self.pool, std::move(self.work),
+                                          std::move(r)};
+        }
+
+        WorkerPool& pool;
+        F work;
+    };
+
+    sdeventplus::Event event;
+    size_t threads;
+
+    std::mutex mutex;
+    std::condition_variable_any jobReady;
+
+    /** @brief Jobs waiting for a worker, with their completion */
+    std::deque<std::pair<Job, Completion>> jobs;
+
+    /** @brief Completions of the jobs done */
+    std::vector<Completion> completions;
+
+    /** @brief eventfd readable while completions are pending */
+    int completionFd = -1;
+
+    /** @brief Calls the pending completions from the event loop */
+    std::unique_ptr<sdeventplus::source::IO> completionSource;
+
+    /** @brief The worker threads, stopped first */
+    std::vector<std::jthread> workers;
+};
+
+} // namespace utils
+} // namespace pldm
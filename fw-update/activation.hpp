@@ -59,13 +59,14 @@ class Delete : public DeleteIntf
     Delete(sdbusplus::bus_t& bus, const std::string& objPath,
            UpdateManager* updateManager) :
         DeleteIntf(bus, objPath.c_str(), action::emit_interface_added),
-        updateManager(updateManager)
+        objPath(objPath), updateManager(updateManager)
     {}
 
     /** @brief Delete the Activation D-Bus object for the FW update package */
     void delete_() override;
 
   private:
+    const std::string objPath;
     UpdateManager* updateManager;
 };
 
@@ -1,12 +1,15 @@
 #include "device_updater.hpp"
 
 #include "activation.hpp"
+#include "package_image.hpp"
 #include "update_manager.hpp"
 
 #include <libpldm/firmware_update.h>
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
 
 PHOSPHOR_LOG2_USING;
@@ -19,10 +22,9 @@ namespace fw_update
 
 void DeviceUpdater::startFwUpdateFlow()
 {
+    telemetry = {};
+    endPhase();
     auto instanceId = updateManager->instanceIdDb.next(eid);
-    // NumberOfComponents
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
     // PackageDataLength
     const auto& fwDevicePkgData =
         std::get<FirmwareDevicePackageData>(fwDeviceIDRecord);
@@ -35,10 +37,10 @@ void DeviceUpdater::startFwUpdateFlow()
     compImgSetVerStrInfo.length =
         static_cast<uint8_t>(compImageSetVersion.size());
 
-    Request request(
+    RequestMsg request(
         sizeof(pldm_msg_hdr) + sizeof(struct pldm_request_update_req) +
         compImgSetVerStrInfo.length);
-    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+    auto requestMsg = request.msg();
 
     auto rc = encode_request_update_req(
         instanceId, maxTransferSize, applicableComponents.size(),
@@ -99,6 +101,8 @@ void DeviceUpdater::requestUpdate(mctp_eid_t eid, const pldm_msg* response,
         return;
     }
 
+    telemetry.requestUpdate = endPhase();
+
     // Optional fields DeviceMetaData and GetPackageData not handled
     pldmRequest = std::make_unique<sdeventplus::source::Defer>(
         updateManager->event,
@@ -112,8 +116,6 @@ void DeviceUpdater::sendPassCompTableRequest(size_t offset)
 
     auto instanceId = updateManager->instanceIdDb.next(eid);
     // TransferFlag
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
     uint8_t transferFlag = 0;
     if (applicableComponents.size() == 1)
     {
@@ -165,10 +167,10 @@ void DeviceUpdater::sendPassCompTableRequest(size_t offset)
     compVerStrInfo.ptr = reinterpret_cast<const uint8_t*>(compVersion.data());
     compVerStrInfo.length = static_cast<uint8_t>(compVersion.size());
 
-    Request request(
+    RequestMsg request(
         sizeof(pldm_msg_hdr) + sizeof(struct pldm_pass_component_table_req) +
         compVerStrInfo.length);
-    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+    auto requestMsg = request.msg();
     auto rc = encode_pass_component_table_req(
         instanceId, transferFlag, compClassification, compIdentifier,
         compClassificationIndex, compComparisonStamp, PLDM_STR_TYPE_ASCII,
@@ -233,10 +235,9 @@ void DeviceUpdater::passCompTable(mctp_eid_t eid, const pldm_msg* response,
     }
     // Handle ComponentResponseCode
 
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
     if (componentIndex == applicableComponents.size() - 1)
     {
+        telemetry.passComponentTable = endPhase();
         componentIndex = 0;
         pldmRequest = std::make_unique<sdeventplus::source::Defer>(
             updateManager->event,
@@ -256,11 +257,15 @@ void DeviceUpdater::passCompTable(mctp_eid_t eid, const pldm_msg* response,
 void DeviceUpdater::sendUpdateComponentRequest(size_t offset)
 {
     pldmRequest.reset();
+    transferProfile = {};
+    telemetry.components.push_back({.index = applicableComponents[offset]});
+    endPhase();
 
     auto instanceId = updateManager->instanceIdDb.next(eid);
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
     const auto& comp = compImageInfos[applicableComponents[offset]];
+    // The FD reads the component image through RequestFirmwareData
+    PackageImage::advise(package, std::get<5>(comp), std::get<6>(comp),
+                         MADV_SEQUENTIAL);
     // ComponentClassification
     CompClassification compClassification = std::get<static_cast<size_t>(
         ComponentImageInfoPos::CompClassificationPos)>(comp);
@@ -293,10 +298,10 @@ void DeviceUpdater::sendUpdateComponentRequest(size_t offset)
     compVerStrInfo.ptr = reinterpret_cast<const uint8_t*>(compVersion.data());
     compVerStrInfo.length = static_cast<uint8_t>(compVersion.size());
 
-    Request request(
+    RequestMsg request(
         sizeof(pldm_msg_hdr) + sizeof(struct pldm_update_component_req) +
         compVerStrInfo.length);
-    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+    auto requestMsg = request.msg();
 
     auto rc = encode_update_component_req(
         instanceId, compClassification, compIdentifier, compClassificationIndex,
@@ -363,6 +368,8 @@ void DeviceUpdater::updateComponent(mctp_eid_t eid, const pldm_msg* response,
             "EID", eid, "CC", completionCode);
         return;
     }
+
+    endComponentPhase(&ComponentTelemetry::updateComponent);
 }
 
 Response DeviceUpdater::requestFwData(const pldm_msg* request,
@@ -392,8 +399,6 @@ Response DeviceUpdater::requestFwData(const pldm_msg* request,
         return response;
     }
 
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
     const auto& comp = compImageInfos[applicableComponents[componentIndex]];
     auto compOffset = std::get<5>(comp);
     auto compSize = std::get<6>(comp);
@@ -433,13 +438,32 @@ Response DeviceUpdater::requestFwData(const pldm_msg* request,
         padBytes = offset + length - compSize;
     }
 
+    // The component image may be truncated in the package, the bytes past
+    // its end are sent as padding
+    size_t dataOffset = static_cast<size_t>(compOffset) + offset;
+    size_t dataLength = length - padBytes;
+    if (dataOffset >= package.size())
+    {
+        dataLength = 0;
+    }
+    else
+    {
+        dataLength = std::min(dataLength, package.size() - dataOffset);
+    }
+
     response.resize(sizeof(pldm_msg_hdr) + sizeof(completionCode) + length);
     responseMsg = reinterpret_cast<pldm_msg*>(response.data());
-    package.seekg(compOffset + offset);
-    package.read(
-        reinterpret_cast<char*>(
-            response.data() + sizeof(pldm_msg_hdr) + sizeof(completionCode)),
-        length - padBytes);
+    if (dataLength)
+    {
+        std::memcpy(response.data() + sizeof(pldm_msg_hdr) +
+                        sizeof(completionCode),
+                    package.data() + dataOffset, dataLength);
+        // FDs mostly request the data in order, read the next chunk ahead
+        PackageImage::advise(package, dataOffset + dataLength, length,
+                             MADV_WILLNEED);
+    }
+    transferProfile.record(length);
+    transferProfile.recordRange(offset, length);
     rc = encode_request_firmware_data_resp(
         request->hdr.instance_id, completionCode, responseMsg,
         sizeof(completionCode));
@@ -481,16 +505,31 @@ Response DeviceUpdater::transferComplete(const pldm_msg* request,
         return response;
     }
 
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
     const auto& comp = compImageInfos[applicableComponents[componentIndex]];
     const auto& compVersion = std::get<7>(comp);
 
+    endComponentPhase(&ComponentTelemetry::transfer);
+    if (!telemetry.components.empty())
+    {
+        auto& compTelemetry = telemetry.components.back();
+        compTelemetry.bytes = transferProfile.bytes;
+        compTelemetry.chunks = transferProfile.requests;
+        compTelemetry.retries = transferProfile.retries;
+    }
+
     if (transferResult == PLDM_FWUP_TRANSFER_SUCCESS)
     {
         info(
             "Component endpoint ID '{EID}' and version '{COMPONENT_VERSION}' transfer complete.",
             "EID", eid, "COMPONENT_VERSION", compVersion);
+        info(
+            "Component endpoint ID '{EID}' and version '{COMPONENT_VERSION}' transferred in {REQUESTS} requests of {MIN_LENGTH} to {MAX_LENGTH} bytes, {THROUGHPUT} bytes/s, {MEAN_INTERVAL}us mean and {MAX_INTERVAL}us max between requests",
+            "EID", eid, "COMPONENT_VERSION", compVersion, "REQUESTS",
+            transferProfile.requests, "MIN_LENGTH", transferProfile.minLength,
+            "MAX_LENGTH", transferProfile.maxLength, "THROUGHPUT",
+            transferProfile.throughput(), "MEAN_INTERVAL",
+            transferProfile.meanInterval().count(), "MAX_INTERVAL",
+            transferProfile.maxInterval.count());
     }
     else
     {
@@ -539,11 +578,10 @@ Response DeviceUpdater::verifyComplete(const pldm_msg* request,
         return response;
     }
 
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
     const auto& comp = compImageInfos[applicableComponents[componentIndex]];
     const auto& compVersion = std::get<7>(comp);
 
+    endComponentPhase(&ComponentTelemetry::verify);
     if (verifyResult == PLDM_FWUP_VERIFY_SUCCESS)
     {
         info(
@@ -599,11 +637,10 @@ Response DeviceUpdater::applyComplete(const pldm_msg* request,
         return response;
     }
 
-    const auto& applicableComponents =
-        std::get<ApplicableComponents>(fwDeviceIDRecord);
     const auto& comp = compImageInfos[applicableComponents[componentIndex]];
     const auto& compVersion = std::get<7>(comp);
 
+    endComponentPhase(&ComponentTelemetry::apply);
     if (applyResult == PLDM_FWUP_APPLY_SUCCESS ||
         applyResult == PLDM_FWUP_APPLY_SUCCESS_WITH_ACTIVATION_METHOD)
     {
@@ -611,6 +648,8 @@ Response DeviceUpdater::applyComplete(const pldm_msg* request,
             "Component endpoint ID '{EID}' with '{COMPONENT_VERSION}' apply complete.",
             "EID", eid, "COMPONENT_VERSION", compVersion);
         updateManager->updateActivationProgress();
+        updateManager->checkpointComponents(eid, resumedComponents +
+                                                     componentIndex + 1);
     }
     else
     {
@@ -651,10 +690,10 @@ Response DeviceUpdater::applyComplete(const pldm_msg* request,
 void DeviceUpdater::sendActivateFirmwareRequest()
 {
     pldmRequest.reset();
+    endPhase();
     auto instanceId = updateManager->instanceIdDb.next(eid);
-    Request request(
-        sizeof(pldm_msg_hdr) + sizeof(struct pldm_activate_firmware_req));
-    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+    PldmMsg<sizeof(struct pldm_activate_firmware_req)> request;
+    auto requestMsg = request.msg();
 
     auto rc = encode_activate_firmware_req(
         instanceId, PLDM_NOT_ACTIVATE_SELF_CONTAINED_COMPONENTS, requestMsg,
@@ -712,9 +751,29 @@ void DeviceUpdater::activateFirmware(mctp_eid_t eid, const pldm_msg* response,
         return;
     }
 
+    telemetry.activate = endPhase();
     updateManager->updateDeviceCompletion(eid, true);
 }
 
+std::chrono::microseconds DeviceUpdater::endPhase()
+{
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed =
+        std::chrono::duration_cast<std::chrono::microseconds>(now - phaseStart);
+    phaseStart = now;
+    return elapsed;
+}
+
+void DeviceUpdater::endComponentPhase(
+    std::chrono::microseconds ComponentTelemetry::*phase)
+{
+    auto elapsed = endPhase();
+    if (!telemetry.components.empty())
+    {
+        telemetry.components.back().*phase = elapsed;
+    }
+}
+
 } // namespace fw_update
 
 } // namespace pldm
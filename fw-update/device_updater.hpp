@@ -7,7 +7,11 @@
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
 
-#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 namespace pldm
 {
@@ -17,6 +21,142 @@ namespace fw_update
 
 class UpdateManager;
 
+/** @struct TransferProfile
+ *
+ *  Profile of the RequestFirmwareData requests of the FD for a component
+ */
+struct TransferProfile
+{
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Record a served RequestFirmwareData request
+     *
+     *  @param[in] length - requested length
+     *  @param[in] now - time of the request
+     */
+    void record(uint32_t length, Clock::time_point now = Clock::now())
+    {
+        if (!requests)
+        {
+            first = now;
+            minLength = length;
+        }
+        else
+        {
+            maxInterval = std::max(
+                maxInterval,
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    now - last));
+        }
+        last = now;
+        requests++;
+        bytes += length;
+        minLength = std::min(minLength, length);
+        maxLength = std::max(maxLength, length);
+    }
+
+    /** @brief Count the requests of data already served as retries
+     *
+     *  The FDs request the data in order and only go back to retry.
+     *
+     *  @param[in] offset - requested offset in the component image
+     *  @param[in] length - requested length
+     */
+    void recordRange(uint32_t offset, uint32_t length)
+    {
+        if (offset < servedEnd)
+        {
+            retries++;
+        }
+        servedEnd = std::max<uint64_t>(servedEnd,
+                                       static_cast<uint64_t>(offset) + length);
+    }
+
+    /** @brief Mean time between two requests */
+    std::chrono::microseconds meanInterval() const
+    {
+        if (requests < 2)
+        {
+            return std::chrono::microseconds(0);
+        }
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   last - first) /
+               (requests - 1);
+    }
+
+    /** @brief Bytes served per second, from the first to the last request */
+    uint64_t throughput() const
+    {
+        auto elapsed =
+            std::chrono::duration_cast<std::chrono::microseconds>(last - first)
+                .count();
+        if (requests < 2 || elapsed <= 0)
+        {
+            return 0;
+        }
+        return bytes * 1000000 / elapsed;
+    }
+
+    size_t requests = 0;
+    uint64_t bytes = 0;
+    uint64_t retries = 0;
+    uint64_t servedEnd = 0;
+    uint32_t minLength = 0;
+    uint32_t maxLength = 0;
+    Clock::time_point first;
+    Clock::time_point last;
+    std::chrono::microseconds maxInterval{0};
+};
+
+/** @struct ComponentTelemetry
+ *
+ *  Time spent in the phases of the update of a component and data served to
+ *  the FD for it
+ */
+struct ComponentTelemetry
+{
+    /** @brief Index of the component in the component image information */
+    size_t index = 0;
+
+    /** @brief UpdateComponent request to its response */
+    std::chrono::microseconds updateComponent{0};
+
+    /** @brief UpdateComponent response to TransferComplete */
+    std::chrono::microseconds transfer{0};
+
+    /** @brief TransferComplete to VerifyComplete */
+    std::chrono::microseconds verify{0};
+
+    /** @brief VerifyComplete to ApplyComplete */
+    std::chrono::microseconds apply{0};
+
+    /** @brief Bytes served, RequestFirmwareData requests and retries */
+    uint64_t bytes = 0;
+    uint64_t chunks = 0;
+    uint64_t retries = 0;
+};
+
+/** @struct UpdateTelemetry
+ *
+ *  Time spent in the phases of the update of an FD
+ */
+struct UpdateTelemetry
+{
+    /** @brief RequestUpdate request to its response */
+    std::chrono::microseconds requestUpdate{0};
+
+    /** @brief RequestUpdate response to the last PassComponentTable
+     *         response
+     */
+    std::chrono::microseconds passComponentTable{0};
+
+    /** @brief ActivateFirmware request to its response */
+    std::chrono::microseconds activate{0};
+
+    /** @brief Components updated, in update order */
+    std::vector<ComponentTelemetry> components;
+};
+
 /** @class DeviceUpdater
  *
  *  DeviceUpdater orchestrates the firmware update of the firmware device and
@@ -35,7 +175,7 @@ class DeviceUpdater
     /** @brief Constructor
      *
      *  @param[in] eid - Endpoint ID of the firmware device
-     *  @param[in] package - File stream for firmware update package
+     *  @param[in] package - Bytes of the mapped firmware update package
      *  @param[in] fwDeviceIDRecord - FirmwareDeviceIDRecord in the fw update
      *                                package that matches this firmware device
      *  @param[in] compImageInfos - Component image information for all the
@@ -43,20 +183,36 @@ class DeviceUpdater
      *  @param[in] compInfo - Component info for the components in this FD
      *                        derived from GetFirmwareParameters response
      *  @param[in] maxTransferSize - Maximum size in bytes of the variable
-     *                               payload allowed to be requested by the FD
+     *                               payload allowed to be requested by the FD,
+     *                               announced in RequestUpdate
      *  @param[in] updateManager - To update the status of fw update of the
      *                             device
+     *  @param[in] resumedComponents - Number of the first applicable
+     *                                 components already applied by an
+     *                                 interrupted update, not updated again
      */
-    explicit DeviceUpdater(mctp_eid_t eid, std::ifstream& package,
+    explicit DeviceUpdater(mctp_eid_t eid, std::span<const uint8_t> package,
                            const FirmwareDeviceIDRecord& fwDeviceIDRecord,
                            const ComponentImageInfos& compImageInfos,
                            const ComponentInfo& compInfo,
                            uint32_t maxTransferSize,
-                           UpdateManager* updateManager) :
+                           UpdateManager* updateManager,
+                           size_t resumedComponents = 0) :
         eid(eid), package(package), fwDeviceIDRecord(fwDeviceIDRecord),
         compImageInfos(compImageInfos), compInfo(compInfo),
         maxTransferSize(maxTransferSize), updateManager(updateManager)
-    {}
+    {
+        const auto& components =
+            std::get<ApplicableComponents>(fwDeviceIDRecord);
+        // RequestUpdate needs a component to update, the last one is
+        // updated again when all of them were applied
+        this->resumedComponents =
+            components.empty()
+                ? 0
+                : std::min(resumedComponents, components.size() - 1);
+        applicableComponents.assign(
+            components.begin() + this->resumedComponents, components.end());
+    }
 
     /** @brief Start the firmware update flow for the FD
      *
@@ -153,6 +309,26 @@ class DeviceUpdater
     void activateFirmware(mctp_eid_t eid, const pldm_msg* response,
                           size_t respMsgLen);
 
+    /** @brief Get the number of the first applicable components not
+     *         updated again
+     */
+    size_t getResumedComponents() const
+    {
+        return resumedComponents;
+    }
+
+    /** @brief Get the transfer profile of the component being updated */
+    const TransferProfile& getTransferProfile() const
+    {
+        return transferProfile;
+    }
+
+    /** @brief Get the time spent in the phases of the update so far */
+    const UpdateTelemetry& getTelemetry() const
+    {
+        return telemetry;
+    }
+
   private:
     /** @brief Send PassComponentTable command request
      *
@@ -169,11 +345,26 @@ class DeviceUpdater
     /** @brief Send ActivateFirmware command request */
     void sendActivateFirmwareRequest();
 
+    /** @brief End the current phase of the update and start the next one
+     *
+     *  @return time spent in the phase
+     */
+    std::chrono::microseconds endPhase();
+
+    /** @brief End a phase of the update of the current component
+     *
+     *  @param[in] phase - time of the phase in ComponentTelemetry
+     */
+    void endComponentPhase(
+        std::chrono::microseconds ComponentTelemetry::*phase);
+
     /** @brief Endpoint ID of the firmware device */
     mctp_eid_t eid;
 
-    /** @brief File stream for firmware update package */
-    std::ifstream& package;
+    /** @brief Bytes of the mapped firmware update package, shared by the
+     *         updaters of all the FDs
+     */
+    std::span<const uint8_t> package;
 
     /** @brief FirmwareDeviceIDRecord in the fw update package that matches this
      *         firmware device
@@ -198,6 +389,12 @@ class DeviceUpdater
     /** @brief To update the status of fw update of the FD */
     UpdateManager* updateManager;
 
+    /** @brief Number of the first applicable components not updated again */
+    size_t resumedComponents = 0;
+
+    /** @brief Applicable components of the FD left to update */
+    ApplicableComponents applicableComponents;
+
     /** @brief Component index is used to track the current component being
      *         updated if multiple components are applicable for the FD.
      *         It is also used to keep track of the next component in
@@ -205,6 +402,15 @@ class DeviceUpdater
      */
     size_t componentIndex = 0;
 
+    /** @brief Transfer profile of the component being updated */
+    TransferProfile transferProfile;
+
+    /** @brief Time spent in the phases of the update */
+    UpdateTelemetry telemetry;
+
+    /** @brief Start of the current phase of the update */
+    std::chrono::steady_clock::time_point phaseStart;
+
     /** @brief To send a PLDM request after the current command handling */
     std::unique_ptr<sdeventplus::source::Defer> pldmRequest;
 };
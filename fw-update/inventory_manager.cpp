@@ -7,7 +7,8 @@
 
 #include <phosphor-logging/lg2.hpp>
 
-#include <functional>
+#include <algorithm>
+#include <tuple>
 
 PHOSPHOR_LOG2_USING;
 
@@ -19,25 +20,224 @@ void InventoryManager::discoverFDs(const std::vector<mctp_eid_t>& eids)
 {
     for (const auto& eid : eids)
     {
-        try
+        if (std::ranges::find(queuedEids, eid) == queuedEids.end())
         {
-            sendQueryDeviceIdentifiersRequest(eid);
+            queuedEids.push_back(eid);
         }
-        catch (const std::exception& e)
+    }
+
+    /* A worker starts discovering a queued FD right away */
+    while (!queuedEids.empty() && discoveryWorkers < discoveryConcurrency)
+    {
+        ++discoveryWorkers;
+        discoveryScope.spawn(
+            discoveryWorker(),
+            exec::default_task_context<void>(exec::inline_scheduler{}));
+    }
+}
+
+void InventoryManager::removeFDs(const std::vector<mctp_eid_t>& eids)
+{
+    for (const auto& eid : eids)
+    {
+        /* The responses of a discovery in flight are dropped */
+        removals[eid]++;
+        std::erase(queuedEids, eid);
+        descriptorMap.erase(eid);
+        downstreamDescriptorMap.erase(eid);
+        componentInfoMap.erase(eid);
+    }
+}
+
+exec::task<void> InventoryManager::discoveryWorker()
+{
+    while (!queuedEids.empty())
+    {
+        auto eid = queuedEids.front();
+        queuedEids.pop_front();
+
+        /* The inventory of the FDs is kept until they are removed */
+        if (!descriptorMap.contains(eid) || !componentInfoMap.contains(eid))
         {
-            error(
-                "Failed to discover file descriptors for endpoint ID {EID} with {ERROR}",
-                "EID", eid, "ERROR", e);
+            co_await discoverFD(eid);
         }
     }
+    --discoveryWorkers;
 }
 
-void InventoryManager::sendQueryDeviceIdentifiersRequest(mctp_eid_t eid)
+exec::task<void> InventoryManager::discoverFD(mctp_eid_t eid)
+{
+    try
+    {
+        if (co_await sendQueryDeviceIdentifiersRequest(eid))
+        {
+            co_return;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to discover file descriptors for endpoint ID {EID} with {ERROR}",
+            "EID", eid, "ERROR", e);
+        co_return;
+    }
+
+    exec::async_scope scope;
+    scope.spawn(discoverComponents(eid),
+                exec::default_task_context<void>(exec::inline_scheduler{}));
+    scope.spawn(discoverDownstreamDevices(eid),
+                exec::default_task_context<void>(exec::inline_scheduler{}));
+    co_await scope.on_empty();
+}
+
+exec::task<void> InventoryManager::discoverComponents(mctp_eid_t eid)
+{
+    try
+    {
+        co_await sendGetFirmwareParametersRequest(eid);
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to send get firmware parameters request for endpoint ID {EID} with {ERROR}",
+            "EID", eid, "ERROR", e);
+    }
+}
+
+exec::task<void> InventoryManager::discoverDownstreamDevices(mctp_eid_t eid)
+{
+    bool updateSupported = false;
+    try
+    {
+        if (co_await sendQueryDownstreamDevicesRequest(eid, updateSupported))
+        {
+            co_return;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to send QueryDownstreamDevices request for endpoint ID {EID} with {ERROR}",
+            "EID", eid, "ERROR", e);
+        co_return;
+    }
+
+    /* The FDP does not support firmware updates but may report inventory
+     * information on downstream devices. In this scenario, sends only
+     * GetDownstreamFirmwareParameters to the FDP. The definition can be found
+     * at Table 15 of DSP0267_1.1.0
+     */
+    exec::async_scope scope;
+    if (updateSupported)
+    {
+        scope.spawn(
+            discoverDownstreamIdentifiers(eid),
+            exec::default_task_context<void>(exec::inline_scheduler{}));
+    }
+    scope.spawn(discoverDownstreamFirmwareParameters(eid),
+                exec::default_task_context<void>(exec::inline_scheduler{}));
+    co_await scope.on_empty();
+}
+
+exec::task<void> InventoryManager::discoverDownstreamIdentifiers(
+    mctp_eid_t eid)
+{
+    /** DataTransferHandle will be skipped when TransferOperationFlag is
+     *  `GetFirstPart`. Use 0x0 as default by following example in
+     *  Figure 9 in DSP0267 1.1.0
+     */
+    std::optional<uint32_t> dataTransferHandle{0x0};
+    auto transferOperationFlag = PLDM_GET_FIRSTPART;
+    try
+    {
+        while (dataTransferHandle)
+        {
+            auto rc = co_await sendQueryDownstreamIdentifiersRequest(
+                eid, *dataTransferHandle, transferOperationFlag,
+                dataTransferHandle);
+            if (rc)
+            {
+                co_return;
+            }
+            transferOperationFlag = PLDM_GET_NEXTPART;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to send QueryDownstreamIdentifiers request for endpoint ID {EID} with {ERROR}",
+            "EID", eid, "ERROR", e);
+    }
+}
+
+exec::task<void> InventoryManager::discoverDownstreamFirmwareParameters(
+    mctp_eid_t eid)
+{
+    std::optional<uint32_t> dataTransferHandle{0x0};
+    auto transferOperationFlag = PLDM_GET_FIRSTPART;
+    try
+    {
+        while (dataTransferHandle)
+        {
+            auto rc = co_await sendGetDownstreamFirmwareParametersRequest(
+                eid, *dataTransferHandle, transferOperationFlag,
+                dataTransferHandle);
+            if (rc)
+            {
+                co_return;
+            }
+            transferOperationFlag = PLDM_GET_NEXTPART;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to send QueryDownstreamFirmwareParameters request for endpoint ID {EID} with {ERROR}",
+            "EID", eid, "ERROR", e);
+    }
+}
+
+exec::task<int> InventoryManager::sendRecvPldmMsg(
+    mctp_eid_t eid, RequestMsg& request, const pldm_msg** responseMsg,
+    size_t* responseLen)
+{
+    int rc = 0;
+    auto removal = removals[eid];
+    try
+    {
+        std::tie(rc, *responseMsg, *responseLen) =
+            co_await handler.sendRecvMsg(eid, std::move(request));
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        error("Failed to send PLDM message to endpoint ID {EID}, error {ERROR}",
+              "EID", eid, "ERROR", e);
+        co_return PLDM_ERROR;
+    }
+
+    /* The FD was removed meanwhile, its inventory must stay dropped */
+    if (removals[eid] != removal)
+    {
+        info("Endpoint ID {EID} removed during its discovery", "EID", eid);
+        co_return PLDM_ERROR;
+    }
+
+    /* The response handlers report the requests without response */
+    if (rc == PLDM_ERROR_NOT_READY)
+    {
+        *responseMsg = nullptr;
+        *responseLen = 0;
+        co_return PLDM_SUCCESS;
+    }
+    co_return rc;
+}
+
+exec::task<int> InventoryManager::sendQueryDeviceIdentifiersRequest(
+    mctp_eid_t eid)
 {
     auto instanceId = instanceIdDb.next(eid);
-    Request requestMsg(
-        sizeof(pldm_msg_hdr) + PLDM_QUERY_DEVICE_IDENTIFIERS_REQ_BYTES);
-    auto request = new (requestMsg.data()) pldm_msg;
+    PldmMsg<PLDM_QUERY_DEVICE_IDENTIFIERS_REQ_BYTES> requestMsg;
+    auto request = requestMsg.msg();
     auto rc = encode_query_device_identifiers_req(
         instanceId, PLDM_QUERY_DEVICE_IDENTIFIERS_REQ_BYTES, request);
     if (rc)
@@ -46,25 +246,24 @@ void InventoryManager::sendQueryDeviceIdentifiersRequest(mctp_eid_t eid)
         error(
             "Failed to encode query device identifiers request for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
-        throw std::runtime_error(
-            "Failed to encode QueryDeviceIdentifiers request");
+        co_return rc;
     }
 
-    rc = handler.registerRequest(
-        eid, instanceId, PLDM_FWUP, PLDM_QUERY_DEVICE_IDENTIFIERS,
-        std::move(requestMsg),
-        std::bind_front(&InventoryManager::queryDeviceIdentifiers, this));
+    const pldm_msg* response = nullptr;
+    size_t respMsgLen = 0;
+    rc = co_await sendRecvPldmMsg(eid, requestMsg, &response, &respMsgLen);
     if (rc)
     {
         error(
             "Failed to send query device identifiers request for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
-        throw std::runtime_error(
-            "Failed to send QueryDeviceIdentifiers request");
+        co_return rc;
     }
+
+    co_return queryDeviceIdentifiers(eid, response, respMsgLen);
 }
 
-void InventoryManager::queryDeviceIdentifiers(
+int InventoryManager::queryDeviceIdentifiers(
     mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen)
 {
     if (response == nullptr || !respMsgLen)
@@ -72,7 +271,7 @@ void InventoryManager::queryDeviceIdentifiers(
         error(
             "No response received for query device identifiers for endpoint ID {EID}",
             "EID", eid);
-        return;
+        return PLDM_ERROR_NOT_READY;
     }
 
     uint8_t completionCode = PLDM_SUCCESS;
@@ -88,7 +287,7 @@ void InventoryManager::queryDeviceIdentifiers(
         error(
             "Failed to decode query device identifiers response for endpoint ID {EID} and descriptor count {DESCRIPTOR_COUNT}, response code {RC}",
             "EID", eid, "DESCRIPTOR_COUNT", descriptorCount, "RC", rc);
-        return;
+        return rc;
     }
 
     if (completionCode)
@@ -96,7 +295,7 @@ void InventoryManager::queryDeviceIdentifiers(
         error(
             "Failed to query device identifiers response for endpoint ID {EID}, completion code {CC}",
             "EID", eid, "CC", completionCode);
-        return;
+        return completionCode;
     }
 
     Descriptors descriptors{};
@@ -114,7 +313,7 @@ void InventoryManager::queryDeviceIdentifiers(
                 "Failed to decode descriptor type {TYPE}, length {LENGTH} and value for endpoint ID {EID}, response code {RC}",
                 "TYPE", descriptorType, "LENGTH", deviceIdentifiersLen, "EID",
                 eid, "RC", rc);
-            return;
+            return rc;
         }
 
         if (descriptorType != PLDM_FWUP_VENDOR_DEFINED)
@@ -138,7 +337,7 @@ void InventoryManager::queryDeviceIdentifiers(
                 error(
                     "Failed to decode vendor-defined descriptor value for endpoint ID {EID}, response code {RC}",
                     "EID", eid, "RC", rc);
-                return;
+                return rc;
             }
 
             auto vendorDefinedDescriptorTitleStr =
@@ -160,16 +359,15 @@ void InventoryManager::queryDeviceIdentifiers(
     }
 
     descriptorMap.emplace(eid, std::move(descriptors));
-
-    // Send GetFirmwareParameters request
-    sendGetFirmwareParametersRequest(eid);
+    return PLDM_SUCCESS;
 }
 
-void InventoryManager::sendQueryDownstreamDevicesRequest(mctp_eid_t eid)
+exec::task<int> InventoryManager::sendQueryDownstreamDevicesRequest(
+    mctp_eid_t eid, bool& updateSupported)
 {
-    Request requestMsg(sizeof(pldm_msg_hdr));
+    PldmMsg<0> requestMsg;
     auto instanceId = instanceIdDb.next(eid);
-    auto request = new (requestMsg.data()) pldm_msg;
+    auto request = requestMsg.msg();
     auto rc = encode_query_downstream_devices_req(instanceId, request);
     if (rc)
     {
@@ -177,31 +375,34 @@ void InventoryManager::sendQueryDownstreamDevicesRequest(mctp_eid_t eid)
         error(
             "Failed to encode query downstream devices request for endpoint ID EID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
-        throw std::runtime_error(
-            "Failed to encode query downstream devices request");
+        co_return rc;
     }
 
-    rc = handler.registerRequest(
-        eid, instanceId, PLDM_FWUP, PLDM_QUERY_DOWNSTREAM_DEVICES,
-        std::move(requestMsg),
-        std::bind_front(&InventoryManager::queryDownstreamDevices, this));
+    const pldm_msg* response = nullptr;
+    size_t respMsgLen = 0;
+    rc = co_await sendRecvPldmMsg(eid, requestMsg, &response, &respMsgLen);
     if (rc)
     {
         error(
             "Failed to send QueryDownstreamDevices request for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
+        co_return rc;
     }
+
+    co_return queryDownstreamDevices(eid, response, respMsgLen,
+                                     updateSupported);
 }
 
-void InventoryManager::queryDownstreamDevices(
-    mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen)
+int InventoryManager::queryDownstreamDevices(
+    mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen,
+    bool& updateSupported)
 {
     if (!response || !respMsgLen)
     {
         error(
             "No response received for QueryDownstreamDevices for endpoint ID {EID}",
             "EID", eid);
-        return;
+        return PLDM_ERROR_NOT_READY;
     }
 
     pldm_query_downstream_devices_resp downstreamDevicesResp{};
@@ -212,7 +413,7 @@ void InventoryManager::queryDownstreamDevices(
         error(
             "Decoding QueryDownstreamDevices response failed for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
-        return;
+        return rc;
     }
 
     switch (downstreamDevicesResp.completion_code)
@@ -225,58 +426,41 @@ void InventoryManager::queryDownstreamDevices(
              */
             info("Endpoint ID {EID} does not support QueryDownstreamDevices",
                  "EID", eid);
-            return;
+            return PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
         default:
             error(
                 "QueryDownstreamDevices response failed with error completion code for endpoint ID {EID} with completion code {CC}",
                 "EID", eid, "CC", downstreamDevicesResp.completion_code);
-            return;
+            return downstreamDevicesResp.completion_code;
     }
 
     switch (downstreamDevicesResp.downstream_device_update_supported)
     {
         case PLDM_FWUP_DOWNSTREAM_DEVICE_UPDATE_SUPPORTED:
-            /** DataTransferHandle will be skipped when TransferOperationFlag is
-             *  `GetFirstPart`. Use 0x0 as default by following example in
-             *  Figure 9 in DSP0267 1.1.0
-             */
-            try
-            {
-                sendQueryDownstreamIdentifiersRequest(eid, 0x0,
-                                                      PLDM_GET_FIRSTPART);
-            }
-            catch (const std::exception& e)
-            {
-                error(
-                    "Failed to send QueryDownstreamIdentifiers request for endpoint ID {EID} with {ERROR}",
-                    "EID", eid, "ERROR", e);
-            }
+            updateSupported = true;
             break;
         case PLDM_FWUP_DOWNSTREAM_DEVICE_UPDATE_NOT_SUPPORTED:
-            /* The FDP does not support firmware updates but may report
-             * inventory information on downstream devices.
-             * In this scenario, sends only GetDownstreamFirmwareParameters
-             * to the FDP.
-             * The definition can be found at Table 15 of DSP0267_1.1.0
-             */
+            updateSupported = false;
             break;
         default:
             error(
                 "Unknown response of DownstreamDeviceUpdateSupported from endpoint ID {EID} with value {VALUE}",
                 "EID", eid, "VALUE",
                 downstreamDevicesResp.downstream_device_update_supported);
-            return;
+            return PLDM_ERROR_INVALID_DATA;
     }
+    return PLDM_SUCCESS;
 }
 
-void InventoryManager::sendQueryDownstreamIdentifiersRequest(
+exec::task<int> InventoryManager::sendQueryDownstreamIdentifiersRequest(
     mctp_eid_t eid, uint32_t dataTransferHandle,
-    enum transfer_op_flag transferOperationFlag)
+    enum transfer_op_flag transferOperationFlag,
+    std::optional<uint32_t>& nextDataTransferHandle)
 {
+    nextDataTransferHandle.reset();
     auto instanceId = instanceIdDb.next(eid);
-    Request requestMsg(
-        sizeof(pldm_msg_hdr) + PLDM_QUERY_DOWNSTREAM_IDENTIFIERS_REQ_BYTES);
-    auto request = new (requestMsg.data()) pldm_msg;
+    PldmMsg<PLDM_QUERY_DOWNSTREAM_IDENTIFIERS_REQ_BYTES> requestMsg;
+    auto request = requestMsg.msg();
     pldm_query_downstream_identifiers_req requestParameters{
         dataTransferHandle, static_cast<uint8_t>(transferOperationFlag)};
 
@@ -289,24 +473,27 @@ void InventoryManager::sendQueryDownstreamIdentifiersRequest(
         error(
             "Failed to encode query downstream identifiers request for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
-        throw std::runtime_error(
-            "Failed to encode query downstream identifiers request");
+        co_return rc;
     }
 
-    rc = handler.registerRequest(
-        eid, instanceId, PLDM_FWUP, PLDM_QUERY_DOWNSTREAM_IDENTIFIERS,
-        std::move(requestMsg),
-        std::bind_front(&InventoryManager::queryDownstreamIdentifiers, this));
+    const pldm_msg* response = nullptr;
+    size_t respMsgLen = 0;
+    rc = co_await sendRecvPldmMsg(eid, requestMsg, &response, &respMsgLen);
     if (rc)
     {
         error(
             "Failed to send QueryDownstreamIdentifiers request for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
+        co_return rc;
     }
+
+    co_return queryDownstreamIdentifiers(eid, response, respMsgLen,
+                                         &nextDataTransferHandle);
 }
 
-void InventoryManager::queryDownstreamIdentifiers(
-    mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen)
+int InventoryManager::queryDownstreamIdentifiers(
+    mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen,
+    std::optional<uint32_t>* nextDataTransferHandle)
 {
     if (!response || !respMsgLen)
     {
@@ -314,7 +501,7 @@ void InventoryManager::queryDownstreamIdentifiers(
             "No response received for QueryDownstreamIdentifiers for endpoint ID {EID}",
             "EID", eid);
         descriptorMap.erase(eid);
-        return;
+        return PLDM_ERROR_NOT_READY;
     }
 
     pldm_query_downstream_identifiers_resp downstreamIds{};
@@ -327,7 +514,7 @@ void InventoryManager::queryDownstreamIdentifiers(
         error(
             "Decoding QueryDownstreamIdentifiers response failed for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
-        return;
+        return rc;
     }
 
     if (downstreamIds.completion_code)
@@ -335,7 +522,7 @@ void InventoryManager::queryDownstreamIdentifiers(
         error(
             "QueryDownstreamIdentifiers response failed with error completion code for endpoint ID {EID} with completion code {CC}",
             "EID", eid, "CC", unsigned(downstreamIds.completion_code));
-        return;
+        return downstreamIds.completion_code;
     }
 
     DownstreamDeviceInfo initialDownstreamDevices{};
@@ -383,7 +570,7 @@ void InventoryManager::queryDownstreamIdentifiers(
                     error(
                         "Decoding Vendor-defined descriptor value failed for endpoint ID {EID} with response code {RC}",
                         "EID", eid, "RC", rc);
-                    return;
+                    return rc;
                 }
 
                 auto vendorDefinedDescriptorTitleStr =
@@ -403,7 +590,7 @@ void InventoryManager::queryDownstreamIdentifiers(
             error(
                 "Failed to decode downstream device descriptor for endpoint ID {EID} with response code {RC}",
                 "EID", eid, "RC", rc);
-            return;
+            return rc;
         }
         downstreamDevices->emplace(dev.downstream_device_index, descriptors);
     }
@@ -412,7 +599,7 @@ void InventoryManager::queryDownstreamIdentifiers(
         error(
             "Failed to decode downstream devices from iterator for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
-        return;
+        return rc;
     }
 
     switch (downstreamIds.transfer_flag)
@@ -422,33 +609,29 @@ void InventoryManager::queryDownstreamIdentifiers(
                 eid, std::move(initialDownstreamDevices));
             [[fallthrough]];
         case PLDM_MIDDLE:
-            sendQueryDownstreamIdentifiersRequest(
-                eid, downstreamIds.next_data_transfer_handle,
-                PLDM_GET_NEXTPART);
+            if (nextDataTransferHandle)
+            {
+                *nextDataTransferHandle =
+                    downstreamIds.next_data_transfer_handle;
+            }
             break;
         case PLDM_START_AND_END:
             downstreamDescriptorMap.insert_or_assign(
                 eid, std::move(initialDownstreamDevices));
-            /** DataTransferHandle will be skipped when TransferOperationFlag is
-             *  `GetFirstPart`. Use 0x0 as default by following example in
-             *  Figure 9 in DSP0267 1.1.0
-             */
-            [[fallthrough]];
-        case PLDM_END:
-            sendGetDownstreamFirmwareParametersRequest(eid, 0x0,
-                                                       PLDM_GET_FIRSTPART);
             break;
     }
+    return PLDM_SUCCESS;
 }
 
-void InventoryManager::sendGetDownstreamFirmwareParametersRequest(
+exec::task<int> InventoryManager::sendGetDownstreamFirmwareParametersRequest(
     mctp_eid_t eid, uint32_t dataTransferHandle,
-    enum transfer_op_flag transferOperationFlag)
+    enum transfer_op_flag transferOperationFlag,
+    std::optional<uint32_t>& nextDataTransferHandle)
 {
-    Request requestMsg(sizeof(pldm_msg_hdr) +
-                       PLDM_GET_DOWNSTREAM_FIRMWARE_PARAMETERS_REQ_BYTES);
+    nextDataTransferHandle.reset();
+    PldmMsg<PLDM_GET_DOWNSTREAM_FIRMWARE_PARAMETERS_REQ_BYTES> requestMsg;
     auto instanceId = instanceIdDb.next(eid);
-    auto request = new (requestMsg.data()) pldm_msg;
+    auto request = requestMsg.msg();
     pldm_get_downstream_firmware_parameters_req requestParameters{
         dataTransferHandle, static_cast<uint8_t>(transferOperationFlag)};
     auto rc = encode_get_downstream_firmware_parameters_req(
@@ -460,25 +643,27 @@ void InventoryManager::sendGetDownstreamFirmwareParametersRequest(
         error(
             "Failed to encode query downstream firmware parameters request for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
-        throw std::runtime_error(
-            "Failed to encode query downstream firmware parameters request");
+        co_return rc;
     }
 
-    rc = handler.registerRequest(
-        eid, instanceId, PLDM_FWUP, PLDM_QUERY_DOWNSTREAM_FIRMWARE_PARAMETERS,
-        std::move(requestMsg),
-        std::bind_front(&InventoryManager::getDownstreamFirmwareParameters,
-                        this));
+    const pldm_msg* response = nullptr;
+    size_t respMsgLen = 0;
+    rc = co_await sendRecvPldmMsg(eid, requestMsg, &response, &respMsgLen);
     if (rc)
     {
         error(
             "Failed to send QueryDownstreamFirmwareParameters request for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
+        co_return rc;
     }
+
+    co_return getDownstreamFirmwareParameters(eid, response, respMsgLen,
+                                              &nextDataTransferHandle);
 }
 
-void InventoryManager::getDownstreamFirmwareParameters(
-    mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen)
+int InventoryManager::getDownstreamFirmwareParameters(
+    mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen,
+    std::optional<uint32_t>* nextDataTransferHandle)
 {
     if (!response || !respMsgLen)
     {
@@ -486,7 +671,7 @@ void InventoryManager::getDownstreamFirmwareParameters(
             "No response received for QueryDownstreamFirmwareParameters for endpoint ID {EID}",
             "EID", eid);
         descriptorMap.erase(eid);
-        return;
+        return PLDM_ERROR_NOT_READY;
     }
 
     pldm_get_downstream_firmware_parameters_resp resp{};
@@ -501,7 +686,7 @@ void InventoryManager::getDownstreamFirmwareParameters(
         error(
             "Decoding QueryDownstreamFirmwareParameters response failed for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
-        return;
+        return rc;
     }
 
     if (resp.completion_code)
@@ -509,7 +694,7 @@ void InventoryManager::getDownstreamFirmwareParameters(
         error(
             "QueryDownstreamFirmwareParameters response failed with error completion code for endpoint ID {EID} with completion code {CC}",
             "EID", eid, "CC", resp.completion_code);
-        return;
+        return resp.completion_code;
     }
 
     foreach_pldm_downstream_device_parameters_entry(params, entry, rc)
@@ -524,25 +709,28 @@ void InventoryManager::getDownstreamFirmwareParameters(
         error(
             "Failed to decode downstream device parameters from iterator for endpoint ID {EID} with response code {RC}",
             "EID", eid, "RC", rc);
-        return;
+        return rc;
     }
 
     switch (resp.transfer_flag)
     {
         case PLDM_START:
         case PLDM_MIDDLE:
-            sendGetDownstreamFirmwareParametersRequest(
-                eid, resp.next_data_transfer_handle, PLDM_GET_NEXTPART);
+            if (nextDataTransferHandle)
+            {
+                *nextDataTransferHandle = resp.next_data_transfer_handle;
+            }
             break;
     }
+    return PLDM_SUCCESS;
 }
 
-void InventoryManager::sendGetFirmwareParametersRequest(mctp_eid_t eid)
+exec::task<int> InventoryManager::sendGetFirmwareParametersRequest(
+    mctp_eid_t eid)
 {
     auto instanceId = instanceIdDb.next(eid);
-    Request requestMsg(
-        sizeof(pldm_msg_hdr) + PLDM_GET_FIRMWARE_PARAMETERS_REQ_BYTES);
-    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    PldmMsg<PLDM_GET_FIRMWARE_PARAMETERS_REQ_BYTES> requestMsg;
+    auto request = requestMsg.msg();
     auto rc = encode_get_firmware_parameters_req(
         instanceId, PLDM_GET_FIRMWARE_PARAMETERS_REQ_BYTES, request);
     if (rc)
@@ -551,22 +739,24 @@ void InventoryManager::sendGetFirmwareParametersRequest(mctp_eid_t eid)
         error(
             "Failed to encode get firmware parameters req for endpoint ID {EID}, response code {RC}",
             "EID", eid, "RC", rc);
-        return;
+        co_return rc;
     }
 
-    rc = handler.registerRequest(
-        eid, instanceId, PLDM_FWUP, PLDM_GET_FIRMWARE_PARAMETERS,
-        std::move(requestMsg),
-        std::bind_front(&InventoryManager::getFirmwareParameters, this));
+    const pldm_msg* response = nullptr;
+    size_t respMsgLen = 0;
+    rc = co_await sendRecvPldmMsg(eid, requestMsg, &response, &respMsgLen);
     if (rc)
     {
         error(
             "Failed to send get firmware parameters request for endpoint ID {EID}, response code {RC}",
             "EID", eid, "RC", rc);
+        co_return rc;
     }
+
+    co_return getFirmwareParameters(eid, response, respMsgLen);
 }
 
-void InventoryManager::getFirmwareParameters(
+int InventoryManager::getFirmwareParameters(
     mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen)
 {
     if (response == nullptr || !respMsgLen)
@@ -575,7 +765,7 @@ void InventoryManager::getFirmwareParameters(
             "No response received for get firmware parameters for endpoint ID {EID}",
             "EID", eid);
         descriptorMap.erase(eid);
-        return;
+        return PLDM_ERROR_NOT_READY;
     }
 
     pldm_get_firmware_parameters_resp fwParams{};
@@ -591,7 +781,7 @@ void InventoryManager::getFirmwareParameters(
         error(
             "Failed to decode get firmware parameters response for endpoint ID {EID}, response code {RC}",
             "EID", eid, "RC", rc);
-        return;
+        return rc;
     }
 
     if (fwParams.completion_code)
@@ -600,7 +790,7 @@ void InventoryManager::getFirmwareParameters(
         error(
             "Failed to get firmware parameters response for endpoint ID {EID}, completion code {CC}",
             "EID", eid, "CC", fw_param_cc);
-        return;
+        return fw_param_cc;
     }
 
     auto compParamPtr = compParamTable.ptr;
@@ -620,7 +810,7 @@ void InventoryManager::getFirmwareParameters(
             error(
                 "Failed to decode component parameter table entry for endpoint ID {EID}, response code {RC}",
                 "EID", eid, "RC", rc);
-            return;
+            return rc;
         }
 
         auto compClassification = compEntry.comp_classification;
@@ -634,6 +824,7 @@ void InventoryManager::getFirmwareParameters(
                              activeCompVerStr.length + pendingCompVerStr.length;
     }
     componentInfoMap.emplace(eid, std::move(componentInfo));
+    return PLDM_SUCCESS;
 }
 
 } // namespace fw_update
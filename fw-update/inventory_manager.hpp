@@ -1,9 +1,17 @@
 #pragma once
 
+#include "config.h"
+
 #include "common/instance_id.hpp"
 #include "common/types.hpp"
 #include "requester/handler.hpp"
 
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <optional>
+#include <vector>
+
 namespace pldm
 {
 
@@ -55,51 +63,75 @@ class InventoryManager
      *
      *  Inventory commands QueryDeviceIdentifiers and GetFirmwareParmeters
      *  commands are sent to every FD and the response is used to populate
-     *  the firmware identifiers and component details of the FDs.
+     *  the firmware identifiers and component details of the FDs. The FDs
+     *  are discovered a few at a time, and the inventory of the FDs already
+     *  discovered is kept until they are removed.
      *
      *  @param[in] eids - MCTP endpoint ID of the FDs
      */
     void discoverFDs(const std::vector<mctp_eid_t>& eids);
 
+    /** @brief Drop the inventory of removed FDs
+     *
+     *  The FDs are discovered again when they are added back.
+     *
+     *  @param[in] eids - MCTP endpoint ID of the FDs
+     */
+    void removeFDs(const std::vector<mctp_eid_t>& eids);
+
     /** @brief Handler for QueryDeviceIdentifiers command response
      *
      *  The response of the QueryDeviceIdentifiers is processed and firmware
-     *  identifiers of the FD is updated. GetFirmwareParameters command request
-     *  is sent to the FD.
+     *  identifiers of the FD is updated.
      *
      *  @param[in] eid - Remote MCTP endpoint
      *  @param[in] response - PLDM response message
      *  @param[in] respMsgLen - Response message length
+     *
+     *  @return PLDM_SUCCESS if the firmware identifiers are updated
      */
-    void queryDeviceIdentifiers(mctp_eid_t eid, const pldm_msg* response,
-                                size_t respMsgLen);
+    int queryDeviceIdentifiers(mctp_eid_t eid, const pldm_msg* response,
+                               size_t respMsgLen);
 
     /** @brief Handler for QueryDownstreamDevices command response
      *
      *  @param[in] eid - Remote MCTP endpoint
      *  @param[in] response - PLDM response message
      *  @param[in] respMsgLen - Response message length
+     *  @param[out] updateSupported - if the downstream devices can be updated
+     *
+     *  @return PLDM_SUCCESS if the FD reports downstream devices
      */
-    void queryDownstreamDevices(mctp_eid_t eid, const pldm_msg* response,
-                                size_t respMsgLen);
+    int queryDownstreamDevices(mctp_eid_t eid, const pldm_msg* response,
+                               size_t respMsgLen, bool& updateSupported);
 
     /** @brief Handler for QueryDownstreamIdentifiers command response
      *
      *  @param[in] eid - Remote MCTP endpoint
      *  @param[in] response - PLDM response message
      *  @param[in] respMsgLen - Response message length
+     *  @param[out] nextDataTransferHandle - handle of the next part, unset
+     *                                       when the response is the last part
+     *
+     *  @return PLDM_SUCCESS if the downstream identifiers are updated
      */
-    void queryDownstreamIdentifiers(mctp_eid_t eid, const pldm_msg* response,
-                                    size_t respMsgLen);
+    int queryDownstreamIdentifiers(
+        mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen,
+        std::optional<uint32_t>* nextDataTransferHandle = nullptr);
 
     /** @brief Handler for GetDownstreamFirmwareParameters command response
      *
      *  @param[in] eid - Remote MCTP endpoint
      *  @param[in] response - PLDM response message
      *  @param[in] respMsgLen - Response message length
+     *  @param[out] nextDataTransferHandle - handle of the next part, unset
+     *                                       when the response is the last part
+     *
+     *  @return PLDM_SUCCESS if the response is valid
      */
-    void getDownstreamFirmwareParameters(
-        mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen);
+    int getDownstreamFirmwareParameters(
+        mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen,
+        std::optional<uint32_t>* nextDataTransferHandle = nullptr);
 
     /** @brief Handler for GetFirmwareParameters command response
      *
@@ -109,24 +141,90 @@ class InventoryManager
      *  @param[in] eid - Remote MCTP endpoint
      *  @param[in] response - PLDM response message
      *  @param[in] respMsgLen - Response message length
+     *
+     *  @return PLDM_SUCCESS if the component details are updated
      */
-    void getFirmwareParameters(mctp_eid_t eid, const pldm_msg* response,
-                               size_t respMsgLen);
+    int getFirmwareParameters(mctp_eid_t eid, const pldm_msg* response,
+                              size_t respMsgLen);
 
   private:
+    /** @brief Discover the FDs queued for discovery one after the other,
+     *         up to discoveryConcurrency workers run at the same time
+     */
+    exec::task<void> discoveryWorker();
+
+    /** @brief Discover the inventory of an FD
+     *
+     *  Once the firmware identifiers of the FD are known, its components and
+     *  its downstream devices are discovered at the same time.
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     */
+    exec::task<void> discoverFD(mctp_eid_t eid);
+
+    /** @brief Discover the component details of an FD
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     */
+    exec::task<void> discoverComponents(mctp_eid_t eid);
+
+    /** @brief Discover the downstream devices of an FD
+     *
+     *  The downstream identifiers and the downstream firmware parameters are
+     *  queried at the same time.
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     */
+    exec::task<void> discoverDownstreamDevices(mctp_eid_t eid);
+
+    /** @brief Query all the parts of the downstream identifiers of an FD
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     */
+    exec::task<void> discoverDownstreamIdentifiers(mctp_eid_t eid);
+
+    /** @brief Query all the parts of the downstream firmware parameters of an
+     *         FD
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     */
+    exec::task<void> discoverDownstreamFirmwareParameters(mctp_eid_t eid);
+
+    /** @brief Send a PLDM request and wait for its response
+     *
+     *  A request timing out completes successfully without response, to be
+     *  reported by the response handlers.
+     *
+     *  @param[in] eid - Remote MCTP endpoint
+     *  @param[in] request - PLDM request message
+     *  @param[out] responseMsg - PLDM response message
+     *  @param[out] responseLen - Response message length
+     *
+     *  @return PLDM_SUCCESS unless the request cannot be sent
+     */
+    exec::task<int> sendRecvPldmMsg(mctp_eid_t eid, RequestMsg& request,
+                                    const pldm_msg** responseMsg,
+                                    size_t* responseLen);
+
     /**
      * @brief Sends QueryDeviceIdentifiers request
      *
      * @param[in] eid - Remote MCTP endpoint
+     *
+     * @return PLDM_SUCCESS if the firmware identifiers are updated
      */
-    void sendQueryDeviceIdentifiersRequest(mctp_eid_t eid);
+    exec::task<int> sendQueryDeviceIdentifiersRequest(mctp_eid_t eid);
 
     /**
      * @brief Sends QueryDownstreamDevices request
      *
      * @param[in] eid - Remote MCTP endpoint
+     * @param[out] updateSupported - if the downstream devices can be updated
+     *
+     * @return PLDM_SUCCESS if the FD reports downstream devices
      */
-    void sendQueryDownstreamDevicesRequest(mctp_eid_t eid);
+    exec::task<int> sendQueryDownstreamDevicesRequest(mctp_eid_t eid,
+                                                      bool& updateSupported);
 
     /**
      * @brief Sends QueryDownstreamIdentifiers request
@@ -137,10 +235,15 @@ class InventoryManager
      * @param[in] eid - Remote MCTP endpoint
      * @param[in] dataTransferHandle - Data transfer handle
      * @param[in] transferOperationFlag - Transfer operation flag
+     * @param[out] nextDataTransferHandle - handle of the next part, unset
+     *                                      when the response is the last part
+     *
+     * @return PLDM_SUCCESS if the downstream identifiers are updated
      */
-    void sendQueryDownstreamIdentifiersRequest(
+    exec::task<int> sendQueryDownstreamIdentifiersRequest(
         mctp_eid_t eid, uint32_t dataTransferHandle,
-        enum transfer_op_flag transferOperationFlag);
+        enum transfer_op_flag transferOperationFlag,
+        std::optional<uint32_t>& nextDataTransferHandle);
 
     /**
      * @brief Sends QueryDownstreamFirmwareParameters request
@@ -148,16 +251,23 @@ class InventoryManager
      * @param[in] eid - Remote MCTP endpoint
      * @param[in] dataTransferHandle - Data transfer handle
      * @param[in] transferOperationFlag - Transfer operation flag
+     * @param[out] nextDataTransferHandle - handle of the next part, unset
+     *                                      when the response is the last part
+     *
+     * @return PLDM_SUCCESS if the response is valid
      */
-    void sendGetDownstreamFirmwareParametersRequest(
+    exec::task<int> sendGetDownstreamFirmwareParametersRequest(
         mctp_eid_t eid, uint32_t dataTransferHandle,
-        const enum transfer_op_flag transferOperationFlag);
+        const enum transfer_op_flag transferOperationFlag,
+        std::optional<uint32_t>& nextDataTransferHandle);
 
     /** @brief Send GetFirmwareParameters command request
      *
      *  @param[in] eid - Remote MCTP endpoint
+     *
+     *  @return PLDM_SUCCESS if the component details are updated
      */
-    void sendGetFirmwareParametersRequest(mctp_eid_t eid);
+    exec::task<int> sendGetFirmwareParametersRequest(mctp_eid_t eid);
 
     /** @brief PLDM request handler */
     pldm::requester::Handler<pldm::requester::Request>& handler;
@@ -173,6 +283,24 @@ class InventoryManager
 
     /** @brief Component information needed for the update of the managed FDs */
     ComponentInfoMap& componentInfoMap;
+
+    /** @brief FDs waiting to be discovered */
+    std::deque<mctp_eid_t> queuedEids;
+
+    /** @brief Number of discoveryWorker running */
+    size_t discoveryWorkers = 0;
+
+    /** @brief Number of times each FD was removed, a discovery in flight
+     *         drops the responses of an FD removed after it sent a request
+     */
+    std::map<mctp_eid_t, uint64_t> removals;
+
+    /** @brief maximum number of FDs discovered at the same time */
+    size_t discoveryConcurrency =
+        std::max(FW_UPDATE_DISCOVERY_CONCURRENCY, 1);
+
+    /** @brief scope of the discovery workers */
+    exec::async_scope discoveryScope;
 };
 
 } // namespace fw_update
@@ -43,7 +43,7 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
         inventoryMgr(handler, instanceIdDb, descriptorMap,
                      downstreamDescriptorMap, componentInfoMap),
         updateManager(event, handler, instanceIdDb, descriptorMap,
-                      componentInfoMap)
+                      componentInfoMap, networkMap)
     {}
 
     /** @brief Helper function to invoke registered handlers for
@@ -57,6 +57,8 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
         for (const auto& mctpInfo : mctpInfos)
         {
             eids.emplace_back(std::get<mctp_eid_t>(mctpInfo));
+            networkMap[std::get<mctp_eid_t>(mctpInfo)] =
+                std::get<NetworkId>(mctpInfo);
         }
 
         inventoryMgr.discoverFDs(eids);
@@ -67,9 +69,15 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
      *
      *  @param[in] mctpInfos - information of removed MCTP endpoints
      */
-    void handleRemovedMctpEndpoints(const MctpInfos&)
+    void handleRemovedMctpEndpoints(const MctpInfos& mctpInfos)
     {
-        return;
+        std::vector<mctp_eid_t> eids;
+        for (const auto& mctpInfo : mctpInfos)
+        {
+            eids.emplace_back(std::get<mctp_eid_t>(mctpInfo));
+        }
+
+        inventoryMgr.removeFDs(eids);
     }
 
     /** @brief Helper function to invoke registered handlers for
@@ -119,6 +127,9 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
     /** Component information of all the discovered MCTP endpoints */
     ComponentInfoMap componentInfoMap;
 
+    /** MCTP network of all the discovered MCTP endpoints */
+    NetworkMap networkMap;
+
     /** @brief PLDM firmware inventory manager */
     InventoryManager inventoryMgr;
 
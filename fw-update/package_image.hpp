@@ -0,0 +1,222 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+/** @class PackageImage
+ *
+ *  Read only mapping of a firmware update package. The package is mapped
+ *  once and the RequestFirmwareData responses of every firmware device are
+ *  copied from the mapping, so the devices updated in parallel do not share
+ *  a stream position. The package file is copied into a sealed memfd first,
+ *  the mapping stays valid when the file is truncated or rewritten during
+ *  the update, which would raise SIGBUS on a mapping of the file itself.
+ */
+class PackageImage
+{
+  public:
+    PackageImage() = default;
+    PackageImage(const PackageImage&) = delete;
+    PackageImage& operator=(const PackageImage&) = delete;
+
+    PackageImage(PackageImage&& other) noexcept :
+        mapped(std::exchange(other.mapped, nullptr)),
+        length(std::exchange(other.length, 0))
+    {}
+
+    PackageImage& operator=(PackageImage&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            mapped = std::exchange(other.mapped, nullptr);
+            length = std::exchange(other.length, 0);
+        }
+        return *this;
+    }
+
+    ~PackageImage()
+    {
+        close();
+    }
+
+    /** @brief Map a package file, unmapping the previous package
+     *
+     *  @param[in] path - path of the package file
+     *  @return 0 on success, the errno value otherwise
+     */
+    int open(const std::filesystem::path& path)
+    {
+        close();
+
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return errno;
+        }
+        int copy = -1;
+        auto rc = sealedCopy(fd, copy);
+        ::close(fd);
+        if (rc)
+        {
+            return rc;
+        }
+
+        /* The copy is sealed, its size can't change under the mapping */
+        struct stat st{};
+        if (fstat(copy, &st) < 0)
+        {
+            rc = errno;
+            ::close(copy);
+            return rc;
+        }
+        auto size = static_cast<size_t>(st.st_size);
+        void* ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, copy, 0);
+        rc = errno;
+        ::close(copy);
+        if (ptr == MAP_FAILED)
+        {
+            return rc;
+        }
+
+        mapped = ptr;
+        length = size;
+        return 0;
+    }
+
+    /** @brief Unmap the package */
+    void close()
+    {
+        if (mapped)
+        {
+            munmap(mapped, length);
+            mapped = nullptr;
+            length = 0;
+        }
+    }
+
+    /** @brief Get the bytes of the package, empty if none is mapped */
+    std::span<const uint8_t> data() const
+    {
+        return {static_cast<const uint8_t*>(mapped), length};
+    }
+
+    size_t size() const
+    {
+        return length;
+    }
+
+    /** @brief Advise the kernel of the way a range of the package is read
+     *
+     *  @param[in] package - bytes of the mapped package
+     *  @param[in] offset - offset of the range in the package
+     *  @param[in] size - size of the range
+     *  @param[in] advice - MADV_SEQUENTIAL or MADV_WILLNEED
+     */
+    static void advise(std::span<const uint8_t> package, size_t offset,
+                       size_t size, int advice)
+    {
+        if (package.empty() || offset >= package.size())
+        {
+            return;
+        }
+        size = std::min(size, package.size() - offset);
+
+        static const auto pageSize =
+            static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        auto begin = reinterpret_cast<uintptr_t>(package.data() + offset);
+        auto end = begin + size;
+        begin &= ~(pageSize - 1);
+        madvise(reinterpret_cast<void*>(begin), end - begin, advice);
+    }
+
+  private:
+    /** @brief Copy a package file into a memfd sealed against any change
+     *
+     *  @param[in] fd - the package file
+     *  @param[out] copy - the sealed memfd
+     *  @return 0 on success, the errno value otherwise, EINVAL if the file
+     *          is empty or changed its size while it was copied
+     */
+    static int sealedCopy(int fd, int& copy)
+    {
+        struct stat st{};
+        if (fstat(fd, &st) < 0)
+        {
+            return errno;
+        }
+        if (st.st_size <= 0)
+        {
+            return EINVAL;
+        }
+
+        copy = memfd_create("pldm-fw-package", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+        if (copy < 0)
+        {
+            return errno;
+        }
+
+        off_t offset = 0;
+        while (offset < st.st_size)
+        {
+            auto copied = sendfile(copy, fd, &offset, st.st_size - offset);
+            if (copied < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (copied <= 0)
+            {
+                auto rc = copied < 0 ? errno : EINVAL;
+                ::close(copy);
+                return rc;
+            }
+        }
+
+        /* The file was truncated or extended while it was copied */
+        struct stat after{};
+        int rc = 0;
+        if (fstat(fd, &after) < 0)
+        {
+            rc = errno;
+        }
+        else if (after.st_size != st.st_size)
+        {
+            rc = EINVAL;
+        }
+        else if (fcntl(copy, F_ADD_SEALS,
+                       F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE |
+                           F_SEAL_SEAL) < 0)
+        {
+            rc = errno;
+        }
+        if (rc)
+        {
+            ::close(copy);
+        }
+        return rc;
+    }
+
+    void* mapped = nullptr;
+    size_t length = 0;
+};
+
+} // namespace fw_update
+
+} // namespace pldm
@@ -8,6 +8,7 @@
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
+#include <algorithm>
 #include <memory>
 
 PHOSPHOR_LOG2_USING;
@@ -22,7 +23,7 @@ using InternalFailure =
     sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure;
 
 size_t PackageParser::parseFDIdentificationArea(
-    DeviceIDRecordCount deviceIdRecCount, const std::vector<uint8_t>& pkgHdr,
+    DeviceIDRecordCount deviceIdRecCount, std::span<const uint8_t> pkgHdr,
     size_t offset)
 {
     size_t pkgHdrRemainingSize = pkgHdr.size() - offset;
@@ -47,7 +48,9 @@ size_t PackageParser::parseFDIdentificationArea(
             throw InternalFailure();
         }
 
-        Descriptors descriptors{};
+        // Only the descriptors are kept, to match the records to the FDs
+        // without decoding them
+        RecordRef record{offset, descriptorIndex.size(), 0};
         while (deviceIdRecHeader.descriptor_count-- &&
                (recordDescriptors.length > 0))
         {
@@ -66,14 +69,11 @@ size_t PackageParser::parseFDIdentificationArea(
                 throw InternalFailure();
             }
 
-            if (descriptorType != PLDM_FWUP_VENDOR_DEFINED)
-            {
-                descriptors.emplace(
-                    descriptorType,
-                    DescriptorData{descriptorData.ptr,
-                                   descriptorData.ptr + descriptorData.length});
-            }
-            else
+            DescriptorRef descriptor{
+                descriptorType,
+                {},
+                {descriptorData.ptr, descriptorData.length}};
+            if (descriptorType == PLDM_FWUP_VENDOR_DEFINED)
             {
                 uint8_t descTitleStrType = 0;
                 variable_field descTitleStr{};
@@ -91,14 +91,12 @@ size_t PackageParser::parseFDIdentificationArea(
                     throw InternalFailure();
                 }
 
-                descriptors.emplace(
-                    descriptorType,
-                    std::make_tuple(utils::toString(descTitleStr),
-                                    VendorDefinedDescriptorData{
-                                        vendorDefinedDescData.ptr,
-                                        vendorDefinedDescData.ptr +
-                                            vendorDefinedDescData.length}));
+                descriptor.title = {descTitleStr.ptr, descTitleStr.length};
+                descriptor.data = {vendorDefinedDescData.ptr,
+                                   vendorDefinedDescData.length};
             }
+            descriptorIndex.emplace_back(descriptor);
+            record.descriptorCount++;
 
             auto nextDescriptorOffset =
                 sizeof(pldm_descriptor_tlv().descriptor_type) +
@@ -108,40 +106,150 @@ size_t PackageParser::parseFDIdentificationArea(
             recordDescriptors.length -= nextDescriptorOffset;
         }
 
-        DeviceUpdateOptionFlags deviceUpdateOptionFlags =
-            deviceIdRecHeader.device_update_option_flags.value;
+        recordIndex.emplace_back(record);
+        offset += deviceIdRecHeader.record_length;
+        pkgHdrRemainingSize -= deviceIdRecHeader.record_length;
+    }
+
+    return offset;
+}
 
-        ApplicableComponents componentsList;
+FirmwareDeviceIDRecord PackageParser::decodeFwDeviceIDRecord(size_t index) const
+{
+    const auto& record = recordIndex.at(index);
+
+    // The record was validated when the package header was parsed
+    pldm_firmware_device_id_record deviceIdRecHeader{};
+    variable_field applicableComponents{};
+    variable_field compImageSetVersionStr{};
+    variable_field recordDescriptors{};
+    variable_field fwDevicePkgData{};
+    auto rc = decode_firmware_device_id_record(
+        pkgHeader.data() + record.offset, pkgHeader.size() - record.offset,
+        componentBitmapBitLength, &deviceIdRecHeader, &applicableComponents,
+        &compImageSetVersionStr, &recordDescriptors, &fwDevicePkgData);
+    if (rc)
+    {
+        error(
+            "Failed to decode firmware device ID record, response code '{RC}'",
+            "RC", rc);
+        throw InternalFailure();
+    }
 
-        for (size_t varBitfieldIdx = 0;
-             varBitfieldIdx < applicableComponents.length; varBitfieldIdx++)
+    Descriptors descriptors{};
+    for (size_t i = 0; i < record.descriptorCount; i++)
+    {
+        const auto& descriptor = descriptorIndex[record.firstDescriptor + i];
+        if (descriptor.type != PLDM_FWUP_VENDOR_DEFINED)
         {
-            std::bitset<8> entry{*(applicableComponents.ptr + varBitfieldIdx)};
-            for (size_t idx = 0; idx < entry.size(); idx++)
+            descriptors.emplace(descriptor.type,
+                                DescriptorData{descriptor.data.begin(),
+                                               descriptor.data.end()});
+        }
+        else
+        {
+            variable_field descTitleStr{descriptor.title.data(),
+                                        descriptor.title.size()};
+            descriptors.emplace(
+                descriptor.type,
+                std::make_tuple(utils::toString(descTitleStr),
+                                VendorDefinedDescriptorData{
+                                    descriptor.data.begin(),
+                                    descriptor.data.end()}));
+        }
+    }
+
+    DeviceUpdateOptionFlags deviceUpdateOptionFlags =
+        deviceIdRecHeader.device_update_option_flags.value;
+
+    ApplicableComponents componentsList;
+
+    for (size_t varBitfieldIdx = 0;
+         varBitfieldIdx < applicableComponents.length; varBitfieldIdx++)
+    {
+        std::bitset<8> entry{*(applicableComponents.ptr + varBitfieldIdx)};
+        for (size_t idx = 0; idx < entry.size(); idx++)
+        {
+            if (entry[idx])
             {
-                if (entry[idx])
-                {
-                    componentsList.emplace_back(
-                        idx + (varBitfieldIdx * entry.size()));
-                }
+                componentsList.emplace_back(
+                    idx + (varBitfieldIdx * entry.size()));
             }
         }
+    }
 
-        fwDeviceIDRecords.emplace_back(std::make_tuple(
-            deviceUpdateOptionFlags, componentsList,
-            utils::toString(compImageSetVersionStr), std::move(descriptors),
-            FirmwareDevicePackageData{
-                fwDevicePkgData.ptr,
-                fwDevicePkgData.ptr + fwDevicePkgData.length}));
-        offset += deviceIdRecHeader.record_length;
-        pkgHdrRemainingSize -= deviceIdRecHeader.record_length;
+    return std::make_tuple(
+        deviceUpdateOptionFlags, componentsList,
+        utils::toString(compImageSetVersionStr), std::move(descriptors),
+        FirmwareDevicePackageData{fwDevicePkgData.ptr,
+                                  fwDevicePkgData.ptr +
+                                      fwDevicePkgData.length});
+}
+
+bool PackageParser::matchFwDeviceIDRecord(size_t index,
+                                          const Descriptors& descriptors) const
+{
+    const auto& record = recordIndex.at(index);
+    for (size_t i = 0; i < record.descriptorCount; i++)
+    {
+        const auto& descriptor = descriptorIndex[record.firstDescriptor + i];
+        auto [first, last] = descriptors.equal_range(descriptor.type);
+        auto found = std::any_of(first, last, [&](const auto& entry) {
+            if (descriptor.type != PLDM_FWUP_VENDOR_DEFINED)
+            {
+                const auto* data = std::get_if<DescriptorData>(&entry.second);
+                return data && std::ranges::equal(*data, descriptor.data);
+            }
+            const auto* info =
+                std::get_if<VendorDefinedDescriptorInfo>(&entry.second);
+            if (!info)
+            {
+                return false;
+            }
+            variable_field descTitleStr{descriptor.title.data(),
+                                        descriptor.title.size()};
+            return std::get<VendorDefinedDescriptorTitle>(*info) ==
+                       utils::toString(descTitleStr) &&
+                   std::ranges::equal(std::get<VendorDefinedDescriptorData>(
+                                          *info),
+                                      descriptor.data);
+        });
+        if (!found)
+        {
+            return false;
+        }
     }
+    return true;
+}
 
-    return offset;
+const FirmwareDeviceIDRecord&
+    PackageParser::getFwDeviceIDRecord(size_t index) const
+{
+    auto it = decodedRecords.find(index);
+    if (it == decodedRecords.end())
+    {
+        it = decodedRecords.emplace(index, decodeFwDeviceIDRecord(index)).first;
+    }
+    return it->second;
+}
+
+const FirmwareDeviceIDRecords& PackageParser::getFwDeviceIDRecords() const
+{
+    if (!fwDeviceIDRecords)
+    {
+        FirmwareDeviceIDRecords records;
+        records.reserve(recordIndex.size());
+        for (size_t index = 0; index < recordIndex.size(); index++)
+        {
+            records.emplace_back(getFwDeviceIDRecord(index));
+        }
+        fwDeviceIDRecords = std::move(records);
+    }
+    return *fwDeviceIDRecords;
 }
 
 size_t PackageParser::parseCompImageInfoArea(ComponentImageCount compImageCount,
-                                             const std::vector<uint8_t>& pkgHdr,
+                                             std::span<const uint8_t> pkgHdr,
                                              size_t offset)
 {
     size_t pkgHdrRemainingSize = pkgHdr.size() - offset;
@@ -212,16 +320,17 @@ void PackageParser::validatePkgTotalSize(uintmax_t pkgSize)
         calcPkgSize += compSize;
     }
 
-    if (calcPkgSize != pkgSize)
+    if (pkgSize != pkgSizeUnknown && calcPkgSize != pkgSize)
     {
         error(
             "Failed to match package size '{PKG_SIZE}' to calculated package size '{CALCULATED_PACKAGE_SIZE}'.",
             "PKG_SIZE", pkgSize, "CALCULATED_PACKAGE_SIZE", calcPkgSize);
         throw InternalFailure();
     }
+    this->pkgSize = calcPkgSize;
 }
 
-void PackageParserV1::parse(const std::vector<uint8_t>& pkgHdr,
+void PackageParserV1::parse(std::span<const uint8_t> pkgHdr,
                             uintmax_t pkgSize)
 {
     if (pkgHeaderSize != pkgHdr.size())
@@ -239,11 +348,12 @@ void PackageParserV1::parse(const std::vector<uint8_t>& pkgHdr,
         throw InternalFailure();
     }
 
+    pkgHeader = pkgHdr;
     auto deviceIdRecCount = static_cast<DeviceIDRecordCount>(pkgHdr[offset]);
     offset += sizeof(DeviceIDRecordCount);
 
     offset = parseFDIdentificationArea(deviceIdRecCount, pkgHdr, offset);
-    if (deviceIdRecCount != fwDeviceIDRecords.size())
+    if (deviceIdRecCount != recordIndex.size())
     {
         error("Failed to find DeviceIDRecordCount {DREC_CNT} entries",
               "DREC_CNT", deviceIdRecCount);
@@ -324,6 +434,33 @@ std::unique_ptr<PackageParser> parsePkgHeader(std::vector<uint8_t>& pkgData)
     return nullptr;
 }
 
+uint32_t computeComponentChecksum(std::span<const uint8_t> package,
+                                  const ComponentImageInfo& compImageInfo)
+{
+    size_t offset = std::get<static_cast<size_t>(
+        ComponentImageInfoPos::CompLocationOffsetPos)>(compImageInfo);
+    size_t size = std::get<static_cast<size_t>(
+        ComponentImageInfoPos::CompSizePos)>(compImageInfo);
+    if (offset > package.size() || size > package.size() - offset)
+    {
+        return 0;
+    }
+    return crc32(package.data() + offset, size);
+}
+
+std::vector<uint32_t> computeComponentChecksums(
+    std::span<const uint8_t> package, const ComponentImageInfos& compImageInfos)
+{
+    std::vector<uint32_t> checksums;
+    checksums.reserve(compImageInfos.size());
+    for (const auto& compImageInfo : compImageInfos)
+    {
+        checksums.emplace_back(
+            computeComponentChecksum(package, compImageInfo));
+    }
+    return checksums;
+}
+
 } // namespace fw_update
 
 } // namespace pldm
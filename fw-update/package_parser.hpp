@@ -6,7 +6,10 @@
 
 #include <array>
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <optional>
+#include <span>
 #include <tuple>
 #include <vector>
 
@@ -51,25 +54,60 @@ class PackageParser
         componentBitmapBitLength(componentBitmapBitLength)
     {}
 
+    /** @brief Package size passed to parse when the package is streamed and
+     *         its size is only known from its header
+     */
+    static constexpr uintmax_t pkgSizeUnknown = 0;
+
     /** @brief Parse the firmware update package header
      *
-     *  @param[in] pkgHdr - Package header
-     *  @param[in] pkgSize - Size of the firmware update package
+     *  The firmware device ID records are only indexed, they are decoded
+     *  from the header when they are asked for.
+     *
+     *  @param[in] pkgHdr - Package header, to outlive the parser
+     *  @param[in] pkgSize - Size of the firmware update package, or
+     *                       pkgSizeUnknown to skip the check of the size
      *
      *  @note Throws exception is parsing fails
      */
-    virtual void parse(const std::vector<uint8_t>& pkgHdr,
-                       uintmax_t pkgSize) = 0;
+    virtual void parse(std::span<const uint8_t> pkgHdr, uintmax_t pkgSize) = 0;
+
+    /** @brief Get the number of firmware device ID records in the package */
+    size_t getFwDeviceIDRecordCount() const
+    {
+        return recordIndex.size();
+    }
+
+    /** @brief Check if the descriptors of an FD match a firmware device ID
+     *         record, without decoding the record
+     *
+     *  @param[in] index - index of the record in the package
+     *  @param[in] descriptors - descriptors of the FD
+     *
+     *  @return true if every descriptor of the record is one of the FD
+     */
+    bool matchFwDeviceIDRecord(size_t index,
+                               const Descriptors& descriptors) const;
+
+    /** @brief Get a firmware device ID record of the package
+     *
+     *  The record is decoded on first use and stays valid with the parser.
+     *
+     *  @param[in] index - index of the record in the package
+     *
+     *  @return the firmware device ID record
+     */
+    const FirmwareDeviceIDRecord& getFwDeviceIDRecord(size_t index) const;
 
     /** @brief Get firmware device ID records from the package
+     *
+     *  Decodes all the records, getFwDeviceIDRecord only decodes the records
+     *  matching the FDs.
      *
      *  @return if parsing the package is successful, return firmware device ID
      *          records
      */
-    const FirmwareDeviceIDRecords& getFwDeviceIDRecords() const
-    {
-        return fwDeviceIDRecords;
-    }
+    const FirmwareDeviceIDRecords& getFwDeviceIDRecords() const;
 
     /** @brief Get component image information from the package
      *
@@ -81,6 +119,16 @@ class PackageParser
         return componentImageInfos;
     }
 
+    /** @brief Get the size of the package described by its header
+     *
+     *  @return the size of the package header plus the size of its
+     *          components, once the header is parsed
+     */
+    uintmax_t getPkgSize() const
+    {
+        return pkgSize;
+    }
+
     /** @brief Device identifiers of the managed FDs */
     const PackageHeaderSize pkgHeaderSize;
 
@@ -99,7 +147,7 @@ class PackageParser
      *          device identification area, on error throw exception.
      */
     size_t parseFDIdentificationArea(DeviceIDRecordCount deviceIdRecCount,
-                                     const std::vector<uint8_t>& pkgHdr,
+                                     std::span<const uint8_t> pkgHdr,
                                      size_t offset);
 
     /** @brief Parse the component image information area
@@ -113,7 +161,7 @@ class PackageParser
      *          image information area, on error throw exception.
      */
     size_t parseCompImageInfoArea(ComponentImageCount compImageCount,
-                                  const std::vector<uint8_t>& pkgHdr,
+                                  std::span<const uint8_t> pkgHdr,
                                   size_t offset);
 
     /** @brief Validate the total size of the package
@@ -121,18 +169,71 @@ class PackageParser
      *  Verify the total size of the package is the sum of package header and
      *  the size of each component.
      *
-     *  @param[in] pkgSize - firmware update package size
+     *  @param[in] pkgSize - firmware update package size, or pkgSizeUnknown
+     *                       to only verify the component locations
      *
      *  @note Throws exception if validation fails
      */
     void validatePkgTotalSize(uintmax_t pkgSize);
 
+    /** @brief Decode a firmware device ID record from the package header
+     *
+     *  @param[in] index - index of the record in the package
+     *
+     *  @return the firmware device ID record
+     */
+    FirmwareDeviceIDRecord decodeFwDeviceIDRecord(size_t index) const;
+
+    /** @struct DescriptorRef
+     *
+     *  Descriptor of a firmware device ID record, in the package header
+     */
+    struct DescriptorRef
+    {
+        DescriptorType type;
+
+        /** @brief Title of a vendor-defined descriptor */
+        std::span<const uint8_t> title;
+
+        std::span<const uint8_t> data;
+    };
+
+    /** @struct RecordRef
+     *
+     *  Firmware device ID record, in the package header
+     */
+    struct RecordRef
+    {
+        /** @brief Offset of the record in the package header */
+        size_t offset;
+
+        /** @brief First descriptor of the record in descriptorIndex */
+        size_t firstDescriptor;
+
+        size_t descriptorCount;
+    };
+
+    /** @brief Package header the records are decoded from */
+    std::span<const uint8_t> pkgHeader;
+
     /** @brief Firmware Device ID Records in the package */
-    FirmwareDeviceIDRecords fwDeviceIDRecords;
+    std::vector<RecordRef> recordIndex;
+
+    /** @brief Descriptors of all the records, in record order */
+    std::vector<DescriptorRef> descriptorIndex;
+
+    /** @brief Records decoded by getFwDeviceIDRecord */
+    mutable std::map<size_t, FirmwareDeviceIDRecord> decodedRecords;
+
+    /** @brief All the records, decoded by getFwDeviceIDRecords */
+    mutable std::optional<FirmwareDeviceIDRecords> fwDeviceIDRecords;
 
     /** @brief Component Image Information in the package */
     ComponentImageInfos componentImageInfos;
 
+    /** @brief Size of the package described by the header */
+    uintmax_t pkgSize = 0;
+
     /** @brief The number of bits that will be used to represent the bitmap in
      *         the ApplicableComponents field for matching device. The value
      *         shall be a multiple of 8 and be large enough to contain a bit
@@ -170,7 +271,7 @@ class PackageParserV1 final : public PackageParser
         PackageParser(pkgHeaderSize, pkgVersion, componentBitmapBitLength)
     {}
 
-    virtual void parse(const std::vector<uint8_t>& pkgHdr, uintmax_t pkgSize);
+    virtual void parse(std::span<const uint8_t> pkgHdr, uintmax_t pkgSize);
 };
 
 /** @brief Parse the package header information
@@ -182,6 +283,28 @@ class PackageParserV1 final : public PackageParser
  */
 std::unique_ptr<PackageParser> parsePkgHeader(std::vector<uint8_t>& pkgHdrInfo);
 
+/** @brief Compute the CRC32 of a component image of a package
+ *
+ *  @param[in] package - bytes of the package, whose header is parsed
+ *  @param[in] compImageInfo - component image information of the component
+ *
+ *  @return the CRC32 of the component, 0 if it is past the end of the
+ *          package
+ */
+uint32_t computeComponentChecksum(std::span<const uint8_t> package,
+                                  const ComponentImageInfo& compImageInfo);
+
+/** @brief Compute the CRC32 of each component image of a package
+ *
+ *  @param[in] package - bytes of the package, whose header is parsed
+ *  @param[in] compImageInfos - component image information of the package
+ *
+ *  @return the CRC32 of each component, in the order of compImageInfos
+ */
+std::vector<uint32_t> computeComponentChecksums(
+    std::span<const uint8_t> package,
+    const ComponentImageInfos& compImageInfos);
+
 } // namespace fw_update
 
 } // namespace pldm
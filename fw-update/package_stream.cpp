@@ -0,0 +1,372 @@
+#include "package_stream.hpp"
+
+#include "common/worker_pool.hpp"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <libpldm/firmware_update.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <xyz/openbmc_project/Common/error.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+using namespace std::string_literals;
+namespace fs = std::filesystem;
+using InternalFailure =
+    sdbusplus::xyz::openbmc_project::Common::Error::InternalFailure;
+using pldm::utils::WorkerPool;
+
+/** @brief Size of the reads of a streamed package */
+constexpr size_t streamChunkSize = 64 * 1024;
+
+size_t PackageHeaderReader::feed(std::span<const uint8_t> data)
+{
+    size_t taken = 0;
+    while (!parsed)
+    {
+        // The header information holds the size of the package header
+        size_t wanted = sizeof(pldm_package_header_information);
+        if (parser)
+        {
+            wanted = parser->pkgHeaderSize;
+        }
+        else if (header.size() >= wanted)
+        {
+            wanted += reinterpret_cast<const pldm_package_header_information*>(
+                          header.data())
+                          ->package_version_string_length;
+        }
+
+        auto count = std::min(wanted - header.size(), data.size() - taken);
+        header.insert(header.end(), data.begin() + taken,
+                      data.begin() + taken + count);
+        taken += count;
+        if (header.size() < wanted)
+        {
+            break;
+        }
+
+        if (!parser)
+        {
+            auto pkgHeaderInfo =
+                reinterpret_cast<const pldm_package_header_information*>(
+                    header.data());
+            auto pkgHeaderInfoSize =
+                sizeof(pldm_package_header_information) +
+                pkgHeaderInfo->package_version_string_length;
+            if (header.size() < pkgHeaderInfoSize)
+            {
+                continue;
+            }
+
+            parser = parsePkgHeader(header);
+            if (parser == nullptr)
+            {
+                error("Invalid PLDM package header information");
+                throw InternalFailure();
+            }
+            if (parser->pkgHeaderSize < header.size())
+            {
+                error("Invalid package header size '{PKG_HDR_SIZE}'",
+                      "PKG_HDR_SIZE", parser->pkgHeaderSize);
+                throw InternalFailure();
+            }
+            continue;
+        }
+
+        parser->parse(header, PackageParser::pkgSizeUnknown);
+        parsed = true;
+    }
+    return taken;
+}
+
+PackageStream::PackageStream(
+    sdeventplus::Event& event, const std::string& socketPath,
+    const fs::path& spoolDir, HeaderCallback headerCallback,
+    PackageCallback packageCallback) :
+    event(event), socketPath(socketPath), spoolDir(spoolDir),
+    headerCallback(std::move(headerCallback)),
+    packageCallback(std::move(packageCallback))
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(addr.sun_path))
+    {
+        throw std::invalid_argument("Package stream socket path too long");
+    }
+    std::copy(socketPath.begin(), socketPath.end(), addr.sun_path);
+
+    fs::create_directories(spoolDir);
+    fs::create_directories(fs::path(socketPath).parent_path());
+    unlink(socketPath.c_str());
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0)
+    {
+        auto error = errno;
+        throw std::runtime_error("socket failed, errno="s +
+                                 std::strerror(error));
+    }
+
+    if (bind(listenFd, reinterpret_cast<const sockaddr*>(&addr),
+             sizeof(addr)) < 0 ||
+        chmod(socketPath.c_str(), S_IRUSR | S_IWUSR) < 0 ||
+        listen(listenFd, 1) < 0)
+    {
+        auto error = errno;
+        close(listenFd);
+        throw std::runtime_error("Failed to listen on "s + socketPath +
+                                 ", errno="s + std::strerror(error));
+    }
+
+    listenIO = std::make_unique<sdeventplus::source::IO>(
+        event, listenFd, EPOLLIN,
+        [this](sdeventplus::source::IO&, int, uint32_t) { accept(); });
+}
+
+PackageStream::~PackageStream()
+{
+    connIO.reset();
+    listenIO.reset();
+    if (connFd >= 0)
+    {
+        close(connFd);
+    }
+    if (spoolFile)
+    {
+        spoolFile.reset();
+        std::error_code ec;
+        fs::remove(spoolPath, ec);
+    }
+    if (listenFd >= 0)
+    {
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+}
+
+void PackageStream::accept()
+{
+    int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0)
+    {
+        return;
+    }
+    if (connFd >= 0)
+    {
+        error(
+            "Firmware update package already being streamed, dropping the connection");
+        close(fd);
+        return;
+    }
+
+    connRelease.reset();
+    connFd = fd;
+    reader = PackageHeaderReader();
+    pkgSize = 0;
+    received = 0;
+    connIO = std::make_unique<sdeventplus::source::IO>(
+        event, connFd, EPOLLIN,
+        [this](sdeventplus::source::IO&, int, uint32_t) { receive(); });
+}
+
+void PackageStream::receive()
+{
+    while (connFd >= 0 && !connRelease && !spooling)
+    {
+        std::vector<uint8_t> buffer(streamChunkSize);
+        auto bytes = read(connFd, buffer.data(), buffer.size());
+        if (bytes < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                abort("read failed, errno="s + std::strerror(errno));
+            }
+            return;
+        }
+        if (bytes == 0)
+        {
+            abort("package truncated at " + std::to_string(received) +
+                  " bytes");
+            return;
+        }
+
+        buffer.resize(bytes);
+        std::span<const uint8_t> data(buffer);
+        if (!reader.complete())
+        {
+            size_t taken = 0;
+            try
+            {
+                taken = reader.feed(data);
+            }
+            catch (const std::exception& e)
+            {
+                abort("invalid package header, "s + e.what());
+                return;
+            }
+            if (!reader.complete())
+            {
+                continue;
+            }
+
+            const auto& parser = *reader.getParser();
+            pkgSize = parser.getPkgSize();
+            if (!headerCallback(parser))
+            {
+                abort("package version " + parser.pkgVersion +
+                      " is not to be applied");
+                return;
+            }
+
+            std::error_code ec;
+            auto space = fs::space(spoolDir, ec);
+            if (!ec && space.available < pkgSize)
+            {
+                abort("not enough space for " + std::to_string(pkgSize) +
+                      " bytes in " + spoolDir.string());
+                return;
+            }
+
+            auto path = (spoolDir / "package.XXXXXX").string();
+            int fd = mkostemp(path.data(), O_CLOEXEC);
+            if (fd < 0)
+            {
+                abort("failed to create the spool file, errno="s +
+                      std::strerror(errno));
+                return;
+            }
+            spoolFile = std::make_shared<SpoolFile>(fd);
+            spoolPath = path;
+
+            // The header is spooled with the first component bytes
+            std::vector<uint8_t> chunk(reader.getHeader());
+            data = data.subspan(taken);
+            chunk.insert(chunk.end(), data.begin(), data.end());
+            buffer = std::move(chunk);
+        }
+
+        if (received + buffer.size() > pkgSize)
+        {
+            abort("more than the " + std::to_string(pkgSize) +
+                  " bytes of the package received");
+            return;
+        }
+        spool(std::move(buffer));
+    }
+}
+
+void PackageStream::spool(std::vector<uint8_t>&& data)
+{
+    auto size = data.size();
+    auto rc = std::make_shared<int>(0);
+    try
+    {
+        WorkerPool::getInstance().post(
+            [file = spoolFile, chunk = std::move(data), rc] {
+                std::span<const uint8_t> pending(chunk);
+                while (!pending.empty())
+                {
+                    auto bytes =
+                        write(file->fd, pending.data(), pending.size());
+                    if (bytes < 0)
+                    {
+                        if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                        *rc = errno;
+                        return;
+                    }
+                    pending = pending.subspan(bytes);
+                }
+            },
+            [this, size, rc] { spooled(size, *rc); });
+    }
+    catch (const std::system_error& e)
+    {
+        abort("failed to start the spool write, "s + e.what());
+        return;
+    }
+    spooling = true;
+    connIO->set_enabled(sdeventplus::source::Enabled::Off);
+}
+
+void PackageStream::spooled(size_t size, int rc)
+{
+    spooling = false;
+    if (rc)
+    {
+        abort("failed to spool the package, errno="s + std::strerror(rc));
+        return;
+    }
+    received += size;
+    if (received == pkgSize)
+    {
+        finish();
+        return;
+    }
+    connIO->set_enabled(sdeventplus::source::Enabled::On);
+}
+
+void PackageStream::finish()
+{
+    spoolFile.reset();
+    auto path = std::exchange(spoolPath, {});
+    closeConnection();
+
+    info("Received streamed firmware update package of {SIZE} bytes", "SIZE",
+         received);
+    packageCallback(path);
+}
+
+void PackageStream::abort(const std::string& reason)
+{
+    error("Dropped the streamed firmware update package, {REASON}", "REASON",
+          reason);
+    spoolFile.reset();
+    if (!spoolPath.empty())
+    {
+        std::error_code ec;
+        fs::remove(spoolPath, ec);
+        spoolPath.clear();
+    }
+    closeConnection();
+}
+
+void PackageStream::closeConnection()
+{
+    connIO->set_enabled(sdeventplus::source::Enabled::Off);
+    connRelease = std::make_unique<sdeventplus::source::Defer>(
+        event, [this](sdeventplus::source::EventBase&) {
+            connIO.reset();
+            close(connFd);
+            connFd = -1;
+        });
+}
+
+} // namespace fw_update
+
+} // namespace pldm
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "package_parser.hpp"
+
+#include <unistd.h>
+
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/source/io.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+/** @class PackageHeaderReader
+ *
+ *  Collects the package header of a firmware update package received in
+ *  chunks and parses it as soon as it is complete, before the components
+ *  are received.
+ */
+class PackageHeaderReader
+{
+  public:
+    /** @brief Take the bytes of the package header from a chunk
+     *
+     *  @param[in] data - next bytes of the package
+     *  @return the number of bytes taken, the bytes after the header are left
+     *          to the caller
+     *
+     *  @note Throws exception if the header is invalid
+     */
+    size_t feed(std::span<const uint8_t> data);
+
+    /** @brief Check if the header is received and parsed */
+    bool complete() const
+    {
+        return parsed;
+    }
+
+    /** @brief Get the bytes of the package header */
+    const std::vector<uint8_t>& getHeader() const
+    {
+        return header;
+    }
+
+    /** @brief Get the parser of the header, once complete */
+    std::unique_ptr<PackageParser>& getParser()
+    {
+        return parser;
+    }
+
+  private:
+    /** @brief Bytes of the header received so far */
+    std::vector<uint8_t> header;
+
+    std::unique_ptr<PackageParser> parser;
+
+    bool parsed = false;
+};
+
+/** @class PackageStream
+ *
+ *  Receives firmware update packages streamed to a Unix socket, one package
+ *  per connection. The package header is parsed as soon as it arrives, and
+ *  the package is rejected before its components are received if the header
+ *  is invalid or the package does not match any FD. The components are
+ *  spooled to a file in a persistent directory, so the package does not need
+ *  to be held in the RAM backed image directory. The spool file is written
+ *  on the worker pool, the connection is not read meanwhile.
+ */
+class PackageStream
+{
+  public:
+    /** @brief Check if a package with a parsed header should be received */
+    using HeaderCallback = std::function<bool(const PackageParser&)>;
+
+    /** @brief Process a received package spooled to a file */
+    using PackageCallback = std::function<int(const std::filesystem::path&)>;
+
+    PackageStream(const PackageStream&) = delete;
+    PackageStream& operator=(const PackageStream&) = delete;
+    PackageStream(PackageStream&&) = delete;
+    PackageStream& operator=(PackageStream&&) = delete;
+    ~PackageStream();
+
+    /** @brief Constructor
+     *
+     *  @param[in] event - PLDM daemon's main event loop
+     *  @param[in] socketPath - path of the Unix socket to listen on
+     *  @param[in] spoolDir - directory the packages are spooled to
+     *  @param[in] headerCallback - to check a package from its header
+     *  @param[in] packageCallback - to process a received package
+     *
+     *  @note Throws exception if the socket cannot be created
+     */
+    PackageStream(sdeventplus::Event& event, const std::string& socketPath,
+                  const std::filesystem::path& spoolDir,
+                  HeaderCallback headerCallback,
+                  PackageCallback packageCallback);
+
+  private:
+    /** @brief Accept a connection streaming a package */
+    void accept();
+
+    /** @brief Receive the next bytes of the package being streamed */
+    void receive();
+
+    /** @brief Spool bytes of the package being streamed on the worker
+     *         pool, the connection is read again once they are written
+     *
+     *  @param[in] data - next bytes of the package
+     */
+    void spool(std::vector<uint8_t>&& data);
+
+    /** @brief Continue with the package once bytes are spooled
+     *
+     *  @param[in] size - number of bytes spooled
+     *  @param[in] rc - 0 or the errno of the failed write
+     */
+    void spooled(size_t size, int rc);
+
+    /** @brief Process the package once completely received */
+    void finish();
+
+    /** @brief Drop the package being streamed
+     *
+     *  @param[in] reason - why the package is dropped
+     */
+    void abort(const std::string& reason);
+
+    /** @brief Close the connection after the current event handling */
+    void closeConnection();
+
+    sdeventplus::Event& event;
+    std::string socketPath;
+    std::filesystem::path spoolDir;
+    HeaderCallback headerCallback;
+    PackageCallback packageCallback;
+
+    /** @brief Listening socket */
+    int listenFd = -1;
+    std::unique_ptr<sdeventplus::source::IO> listenIO;
+
+    /** @brief Connection streaming a package, one at a time */
+    int connFd = -1;
+    std::unique_ptr<sdeventplus::source::IO> connIO;
+
+    /** @brief To release the connection after its last event */
+    std::unique_ptr<sdeventplus::source::Defer> connRelease;
+
+    /** @brief Header of the package being streamed */
+    PackageHeaderReader reader;
+
+    /** @struct SpoolFile
+     *
+     *  Spool file descriptor, shared with the write running on the worker
+     *  pool so that dropping the package does not close it under the write.
+     */
+    struct SpoolFile
+    {
+        explicit SpoolFile(int fd) : fd(fd) {}
+        SpoolFile(const SpoolFile&) = delete;
+        SpoolFile& operator=(const SpoolFile&) = delete;
+        ~SpoolFile()
+        {
+            close(fd);
+        }
+
+        int fd;
+    };
+
+    /** @brief Spool file of the package being streamed */
+    std::shared_ptr<SpoolFile> spoolFile;
+    std::filesystem::path spoolPath;
+
+    /** @brief Whether bytes of the package are being spooled */
+    bool spooling = false;
+
+    /** @brief Size of the package from its header, and bytes received */
+    uintmax_t pkgSize = 0;
+    uintmax_t received = 0;
+};
+
+} // namespace fw_update
+
+} // namespace pldm
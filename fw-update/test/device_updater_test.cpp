@@ -1,11 +1,16 @@
 #include "common/instance_id.hpp"
 #include "common/utils.hpp"
 #include "fw-update/device_updater.hpp"
+#include "fw-update/package_image.hpp"
 #include "fw-update/package_parser.hpp"
 #include "requester/handler.hpp"
 
 #include <libpldm/firmware_update.h>
 
+#include <cstdlib>
+#include <filesystem>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -30,10 +35,12 @@ class DeviceUpdaterTest : public testing::Test
         compImageInfos = {
             {10, 100, 0xFFFFFFFF, 0, 0, 139, 1024, "VersionString3"}};
         compInfo = {{std::make_pair(10, 100), 1}};
+        image.open("./test_pkg");
     }
 
     int fd = -1;
     std::ifstream package;
+    PackageImage image;
     FirmwareDeviceIDRecord fwDeviceIDRecord;
     ComponentImageInfos compImageInfos;
     ComponentInfo compInfo;
@@ -81,8 +88,8 @@ TEST_F(DeviceUpdaterTest, validatePackage)
 
 TEST_F(DeviceUpdaterTest, ReadPackage512B)
 {
-    DeviceUpdater deviceUpdater(0, package, fwDeviceIDRecord, compImageInfos,
-                                compInfo, 512, nullptr);
+    DeviceUpdater deviceUpdater(0, image.data(), fwDeviceIDRecord,
+                                compImageInfos, compInfo, 512, nullptr);
 
     constexpr std::array<uint8_t, sizeof(pldm_msg_hdr) +
                                       sizeof(pldm_request_firmware_data_req)>
@@ -150,3 +157,120 @@ TEST_F(DeviceUpdaterTest, ReadPackage512B)
         0xA2, 0x72, 0x33, 0x00, 0x3C, 0x7E, 0x28, 0x36, 0x10, 0x90, 0x38, 0xFB};
     EXPECT_EQ(response, compFirst512B);
 }
+
+TEST_F(DeviceUpdaterTest, ReadPackagePastEnd)
+{
+    // Last 512 bytes of the 1024 bytes component, and of the package
+    constexpr std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                                      sizeof(pldm_request_firmware_data_req)>
+        reqFwDataReq{0x8A, 0x05, 0x15, 0x00, 0x02, 0x00,
+                     0x00, 0x00, 0x02, 0x00, 0x00};
+    constexpr uint32_t length = 512;
+    auto requestMsg = reinterpret_cast<const pldm_msg*>(reqFwDataReq.data());
+    constexpr auto dataOffset = sizeof(pldm_msg_hdr) + sizeof(uint8_t);
+
+    DeviceUpdater deviceUpdater(0, image.data(), fwDeviceIDRecord,
+                                compImageInfos, compInfo, 512, nullptr);
+    auto response = deviceUpdater.requestFwData(
+        requestMsg, sizeof(pldm_request_firmware_data_req));
+    ASSERT_EQ(response.size(), dataOffset + length);
+    EXPECT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+    EXPECT_TRUE(std::equal(response.begin() + dataOffset, response.end(),
+                           image.data().end() - length));
+
+    // The component claims more bytes than the package holds, the missing
+    // bytes are sent as padding
+    ComponentImageInfos truncatedCompImageInfos{
+        {10, 100, 0xFFFFFFFF, 0, 0, 139, 1536, "VersionString3"}};
+    constexpr std::array<uint8_t, sizeof(pldm_msg_hdr) +
+                                      sizeof(pldm_request_firmware_data_req)>
+        reqPastEnd{0x8A, 0x05, 0x15, 0x00, 0x04, 0x00,
+                   0x00, 0x00, 0x02, 0x00, 0x00};
+    DeviceUpdater truncatedUpdater(0, image.data(), fwDeviceIDRecord,
+                                   truncatedCompImageInfos, compInfo, 512,
+                                   nullptr);
+    response = truncatedUpdater.requestFwData(
+        reinterpret_cast<const pldm_msg*>(reqPastEnd.data()),
+        sizeof(pldm_request_firmware_data_req));
+    ASSERT_EQ(response.size(), dataOffset + length);
+    EXPECT_EQ(response[sizeof(pldm_msg_hdr)], PLDM_SUCCESS);
+    EXPECT_TRUE(std::all_of(response.begin() + dataOffset, response.end(),
+                            [](uint8_t byte) { return byte == 0; }));
+}
+
+TEST(TransferProfile, record)
+{
+    using namespace std::chrono_literals;
+    TransferProfile profile;
+    EXPECT_EQ(profile.throughput(), 0);
+
+    TransferProfile::Clock::time_point start{};
+    profile.record(512, start);
+    profile.record(1024, start + 1ms);
+    profile.record(512, start + 4ms);
+
+    EXPECT_EQ(profile.requests, 3);
+    EXPECT_EQ(profile.bytes, 2048);
+    EXPECT_EQ(profile.minLength, 512);
+    EXPECT_EQ(profile.maxLength, 1024);
+    EXPECT_EQ(profile.meanInterval(), 2ms);
+    EXPECT_EQ(profile.maxInterval, 3ms);
+    EXPECT_EQ(profile.throughput(), 512000);
+}
+
+TEST_F(DeviceUpdaterTest, ResumedComponents)
+{
+    FirmwareDeviceIDRecord record{
+        1, {0, 1, 2}, "VersionString2", std::get<Descriptors>(fwDeviceIDRecord),
+        {}};
+    DeviceUpdater resumed(0, image.data(), record, compImageInfos, compInfo,
+                          512, nullptr, 2);
+    EXPECT_EQ(resumed.getResumedComponents(), 2);
+
+    // The last component is updated again when all were applied
+    DeviceUpdater applied(0, image.data(), record, compImageInfos, compInfo,
+                          512, nullptr, 5);
+    EXPECT_EQ(applied.getResumedComponents(), 2);
+
+    DeviceUpdater fresh(0, image.data(), record, compImageInfos, compInfo, 512,
+                        nullptr);
+    EXPECT_EQ(fresh.getResumedComponents(), 0);
+}
+
+TEST(TransferProfile, retries)
+{
+    TransferProfile profile;
+    profile.recordRange(0, 512);
+    profile.recordRange(512, 512);
+    // The FD requests the second chunk again
+    profile.recordRange(512, 512);
+    profile.recordRange(1024, 256);
+    EXPECT_EQ(profile.retries, 1);
+    EXPECT_EQ(profile.servedEnd, 1280);
+}
+
+TEST(PackageImage, truncatedAfterOpen)
+{
+    char tmpdir[] = "/tmp/pldm_fw_image.XXXXXX";
+    std::filesystem::path dir(mkdtemp(tmpdir));
+    auto path = dir / "pkg";
+    std::filesystem::copy_file("./test_pkg", path);
+    auto size = std::filesystem::file_size(path);
+
+    PackageImage image;
+    ASSERT_EQ(image.open(path), 0);
+    std::vector<uint8_t> before(image.data().begin(), image.data().end());
+    ASSERT_EQ(before.size(), size);
+
+    // The mapping is a sealed copy, truncating the file doesn't fault it
+    std::filesystem::resize_file(path, 0);
+    EXPECT_EQ(image.size(), size);
+    EXPECT_TRUE(std::equal(before.begin(), before.end(),
+                           image.data().begin()));
+
+    // An empty package is rejected
+    EXPECT_EQ(image.open(path), EINVAL);
+    EXPECT_TRUE(image.data().empty());
+
+    std::filesystem::remove_all(dir);
+}
@@ -231,3 +231,30 @@ TEST_F(InventoryManagerTest, getFirmwareParametersResponseErrorCC)
     inventoryManager.getFirmwareParameters(1, responseMsg, respPayloadLength);
     EXPECT_EQ(outComponentInfoMap.size(), 0);
 }
+
+TEST_F(InventoryManagerTest, removeFDs)
+{
+    constexpr size_t respPayloadLength = 1;
+    constexpr std::array<uint8_t, sizeof(pldm_msg_hdr) + respPayloadLength>
+        getFirmwareParametersResp{0x00, 0x00, 0x00, 0x01};
+    auto responseMsg =
+        reinterpret_cast<const pldm_msg*>(getFirmwareParametersResp.data());
+    EXPECT_NE(inventoryManager.getFirmwareParameters(1, responseMsg,
+                                                     respPayloadLength),
+              PLDM_SUCCESS);
+    EXPECT_EQ(inventoryManager.getFirmwareParameters(1, nullptr, 0),
+              PLDM_ERROR_NOT_READY);
+
+    outDescriptorMap[1] = {};
+    outDescriptorMap[2] = {};
+    outDownstreamDescriptorMap[1] = {};
+    outComponentInfoMap[1] = {};
+    outComponentInfoMap[2] = {};
+    inventoryManager.removeFDs({1});
+
+    EXPECT_EQ(outDescriptorMap.size(), 1);
+    EXPECT_TRUE(outDescriptorMap.contains(2));
+    EXPECT_TRUE(outDownstreamDescriptorMap.empty());
+    EXPECT_EQ(outComponentInfoMap.size(), 1);
+    EXPECT_TRUE(outComponentInfoMap.contains(2));
+}
@@ -1,5 +1,8 @@
 #include "fw-update/package_parser.hpp"
 
+#include <libpldm/utils.h>
+
+#include <numeric>
 #include <typeinfo>
 
 #include <gmock/gmock.h>
@@ -49,6 +52,48 @@ TEST(PackageParser, ValidPkgSingleDescriptorSingleComponent)
     ComponentImageInfos compImageInfos{
         {10, 100, 0xFFFFFFFF, 0, 0, 139, 27, "VersionString3"}};
     EXPECT_EQ(outCompImageInfos, compImageInfos);
+
+    ASSERT_EQ(parser->getFwDeviceIDRecordCount(), 1);
+    EXPECT_EQ(parser->getFwDeviceIDRecord(0), fwDeviceIDRecords[0]);
+    EXPECT_EQ(&parser->getFwDeviceIDRecord(0), &parser->getFwDeviceIDRecord(0));
+}
+
+TEST(PackageParser, MatchFwDeviceIDRecord)
+{
+    std::vector<uint8_t> fwPkgHdr{
+        0xF0, 0x18, 0x87, 0x8C, 0xCB, 0x7D, 0x49, 0x43, 0x98, 0x00, 0xA0, 0x2F,
+        0x05, 0x9A, 0xCA, 0x02, 0x01, 0x8B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x19, 0x0C, 0xE5, 0x07, 0x00, 0x08, 0x00, 0x01, 0x0E,
+        0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74, 0x72, 0x69, 0x6E,
+        0x67, 0x31, 0x01, 0x2E, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0E,
+        0x00, 0x00, 0x01, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74,
+        0x72, 0x69, 0x6E, 0x67, 0x32, 0x02, 0x00, 0x10, 0x00, 0x16, 0x20, 0x23,
+        0xC9, 0x3E, 0xC5, 0x41, 0x15, 0x95, 0xF4, 0x48, 0x70, 0x1D, 0x49, 0xD6,
+        0x75, 0x01, 0x00, 0x0A, 0x00, 0x64, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,
+        0x00, 0x00, 0x00, 0x8B, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x01,
+        0x0E, 0x56, 0x65, 0x72, 0x73, 0x69, 0x6F, 0x6E, 0x53, 0x74, 0x72, 0x69,
+        0x6E, 0x67, 0x33, 0x4F, 0x96, 0xAE, 0x56};
+
+    auto parser = parsePkgHeader(fwPkgHdr);
+    ASSERT_NE(parser, nullptr);
+    parser->parse(fwPkgHdr, 166);
+
+    DescriptorData uuid{0x16, 0x20, 0x23, 0xC9, 0x3E, 0xC5, 0x41, 0x15,
+                        0x95, 0xF4, 0x48, 0x70, 0x1D, 0x49, 0xD6, 0x75};
+    EXPECT_TRUE(parser->matchFwDeviceIDRecord(0, {{PLDM_FWUP_UUID, uuid}}));
+
+    // The FD may have more descriptors than the record
+    EXPECT_TRUE(parser->matchFwDeviceIDRecord(
+        0, {{PLDM_FWUP_IANA_ENTERPRISE_ID, DescriptorData{0x47, 0x16, 0, 0}},
+            {PLDM_FWUP_UUID, uuid}}));
+
+    auto otherUuid = uuid;
+    otherUuid.back() = 0x76;
+    EXPECT_FALSE(
+        parser->matchFwDeviceIDRecord(0, {{PLDM_FWUP_UUID, otherUuid}}));
+    EXPECT_FALSE(parser->matchFwDeviceIDRecord(
+        0, {{PLDM_FWUP_IANA_ENTERPRISE_ID, DescriptorData{0x47, 0x16, 0, 0}}}));
+    EXPECT_ANY_THROW(parser->matchFwDeviceIDRecord(1, {}));
 }
 
 TEST(PackageParser, ValidPkgMultipleDescriptorsMultipleComponents)
@@ -181,3 +226,29 @@ TEST(PackageParser, InvalidPkgBadChecksum)
     EXPECT_EQ(parser->pkgVersion, pkgVersion);
     EXPECT_THROW(parser->parse(fwPkgHdr, pkgSize), std::exception);
 }
+
+TEST(PackageParser, ComponentChecksums)
+{
+    std::vector<uint8_t> package(4096);
+    std::iota(package.begin(), package.end(), 0);
+    ComponentImageInfos compImageInfos;
+    for (CompLocationOffset offset = 96; offset < package.size();
+         offset += 400)
+    {
+        compImageInfos.emplace_back(10, 100, 0xFFFFFFFF, 0, 0, offset, 400,
+                                    "VersionString");
+    }
+    // Past the end of the package
+    compImageInfos.emplace_back(10, 100, 0xFFFFFFFF, 0, 0, 4000, 400,
+                                "VersionString");
+
+    auto checksums = computeComponentChecksums(package, compImageInfos);
+    ASSERT_EQ(checksums.size(), compImageInfos.size());
+    for (size_t index = 0; index + 1 < compImageInfos.size(); index++)
+    {
+        auto offset = std::get<5>(compImageInfos[index]);
+        EXPECT_EQ(checksums[index], crc32(package.data() + offset, 400));
+    }
+    EXPECT_EQ(checksums.back(), 0);
+    EXPECT_TRUE(computeComponentChecksums(package, {}).empty());
+}
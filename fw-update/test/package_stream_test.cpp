@@ -0,0 +1,117 @@
+#include "fw-update/package_stream.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using namespace pldm::fw_update;
+
+static std::vector<uint8_t> readFile(const fs::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)),
+                                std::istreambuf_iterator<char>());
+}
+
+TEST(PackageHeaderReader, chunkedHeader)
+{
+    auto package = readFile("./test_pkg");
+    ASSERT_EQ(package.size(), 1163);
+
+    PackageHeaderReader reader;
+    constexpr size_t chunkSize = 7;
+    size_t offset = 0;
+    size_t taken = 0;
+    while (!reader.complete() && offset < package.size())
+    {
+        auto count = std::min(chunkSize, package.size() - offset);
+        taken = reader.feed(std::span(package).subspan(offset, count));
+        offset += count;
+    }
+
+    ASSERT_TRUE(reader.complete());
+    auto& parser = reader.getParser();
+    ASSERT_NE(parser, nullptr);
+    EXPECT_EQ(parser->pkgHeaderSize, 139);
+    EXPECT_EQ(offset - chunkSize + taken, parser->pkgHeaderSize);
+    EXPECT_EQ(parser->getPkgSize(), package.size());
+    EXPECT_EQ(reader.getHeader(),
+              std::vector<uint8_t>(package.begin(), package.begin() + 139));
+    EXPECT_EQ(parser->getFwDeviceIDRecords().size(), 1);
+    EXPECT_EQ(parser->getComponentImageInfos().size(), 1);
+
+    // The bytes after the header are left to the caller
+    EXPECT_EQ(reader.feed(std::span(package).subspan(offset)), 0);
+}
+
+TEST(PackageHeaderReader, invalidHeader)
+{
+    std::vector<uint8_t> garbage(256, 0xA5);
+    PackageHeaderReader reader;
+    EXPECT_ANY_THROW(reader.feed(garbage));
+    EXPECT_FALSE(reader.complete());
+}
+
+TEST(PackageStream, packageSpooled)
+{
+    auto package = readFile("./test_pkg");
+    ASSERT_EQ(package.size(), 1163);
+
+    char tmpdir[] = "/tmp/pldm_fw_stream.XXXXXX";
+    fs::path dir(mkdtemp(tmpdir));
+    auto socketPath = (dir / "socket").string();
+    auto event = sdeventplus::Event::get_default();
+    std::vector<uint8_t> spooled;
+    bool received = false;
+    PackageStream stream(
+        event, socketPath, dir / "spool",
+        [](const PackageParser&) { return true; },
+        [&](const fs::path& path) {
+            spooled = readFile(path);
+            received = true;
+            fs::remove(path);
+            return 0;
+        });
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    ASSERT_GE(fd, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::copy(socketPath.begin(), socketPath.end(), addr.sun_path);
+    ASSERT_EQ(
+        connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)),
+        0);
+
+    // The header and the components arrive in several chunks, each is
+    // spooled on the worker pool before the next one is read
+    constexpr size_t chunkSize = 500;
+    for (size_t offset = 0; offset < package.size(); offset += chunkSize)
+    {
+        auto count = std::min(chunkSize, package.size() - offset);
+        ASSERT_EQ(write(fd, package.data() + offset, count),
+                  static_cast<ssize_t>(count));
+        event.run(std::chrono::milliseconds(10));
+    }
+    for (int i = 0; i < 100 && !received; ++i)
+    {
+        event.run(std::chrono::milliseconds(10));
+    }
+
+    ASSERT_TRUE(received);
+    EXPECT_EQ(spooled, package);
+    close(fd);
+    fs::remove_all(dir);
+}
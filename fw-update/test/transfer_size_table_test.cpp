@@ -0,0 +1,64 @@
+#include "fw-update/transfer_size_table.hpp"
+
+#include <libpldm/firmware_update.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::fw_update;
+
+TEST(TransferSizeTable, loadAndMatch)
+{
+    char tmpfile[] = "/tmp/pldm_transfer_size.XXXXXX";
+    auto fd = mkstemp(tmpfile);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    std::ofstream(tmpfile) << R"({
+        "entries": [
+            {
+                "descriptors": [
+                    { "type": 0, "data": [16, 222] },
+                    { "type": 256, "data": [1, 2] }
+                ],
+                "max_transfer_size": 65536
+            },
+            {
+                "descriptors": [{ "type": 0, "data": [16, 222] }],
+                "max_transfer_size": 8192
+            },
+            {
+                "descriptors": [{ "type": 0, "data": [1, 1] }],
+                "max_transfer_size": 16
+            },
+            {
+                "max_transfer_size": 4096
+            }
+        ]
+    })";
+
+    TransferSizeTable table(tmpfile);
+    std::filesystem::remove(tmpfile);
+    // The entries below the baseline transfer size or without descriptors
+    // are dropped
+    EXPECT_EQ(table.size(), 2);
+
+    Descriptors gpu{{PLDM_FWUP_PCI_VENDOR_ID, DescriptorData{16, 222}},
+                    {PLDM_FWUP_PCI_DEVICE_ID, DescriptorData{1, 2}}};
+    Descriptors otherGpu{{PLDM_FWUP_PCI_VENDOR_ID, DescriptorData{16, 222}},
+                         {PLDM_FWUP_PCI_DEVICE_ID, DescriptorData{3, 4}}};
+    Descriptors nic{{PLDM_FWUP_PCI_VENDOR_ID, DescriptorData{1, 1}}};
+    EXPECT_EQ(table.get(gpu, 4096), 65536);
+    EXPECT_EQ(table.get(otherGpu, 4096), 8192);
+    EXPECT_EQ(table.get(nic, 4096), 4096);
+}
+
+TEST(TransferSizeTable, missingFile)
+{
+    TransferSizeTable table("/tmp/pldm_transfer_size_missing.json");
+    EXPECT_EQ(table.size(), 0);
+    EXPECT_EQ(table.get({}, 4096), 4096);
+}
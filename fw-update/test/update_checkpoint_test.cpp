@@ -0,0 +1,94 @@
+#include "fw-update/update_checkpoint.hpp"
+
+#include <libpldm/firmware_update.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using namespace pldm::fw_update;
+
+class UpdateCheckpointTest : public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pldm_fw_checkpoint.XXXXXX";
+        dir = fs::path(mkdtemp(tmpdir));
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(dir);
+    }
+
+    fs::path dir;
+    Descriptors descriptors{{PLDM_FWUP_UUID, DescriptorData(16, 0x11)}};
+    uint64_t deviceId = UpdateCheckpoint::computeDeviceId(descriptors);
+};
+
+TEST_F(UpdateCheckpointTest, storeLoad)
+{
+    auto path = dir / "checkpoint";
+    std::vector<uint8_t> header{0x01, 0x02, 0x03, 0x04};
+    auto hash = UpdateCheckpoint::computeHash(header, 1024);
+    EXPECT_NE(hash, UpdateCheckpoint::computeHash(header, 1025));
+
+    {
+        UpdateCheckpoint checkpoint(path);
+        checkpoint.setPackage(hash);
+        checkpoint.setComponents(8, deviceId, 2);
+        checkpoint.setComponents(9, deviceId, 1);
+        checkpoint.erase(9);
+    }
+
+    UpdateCheckpoint checkpoint(path);
+    checkpoint.setPackage(hash);
+    EXPECT_EQ(checkpoint.getComponents(8, deviceId), 2);
+    EXPECT_EQ(checkpoint.getComponents(9, deviceId), 0);
+
+    // The progress of another package is dropped
+    checkpoint.setPackage(hash + 1);
+    EXPECT_EQ(checkpoint.getComponents(8, deviceId), 0);
+    UpdateCheckpoint reloaded(path);
+    reloaded.setPackage(hash);
+    EXPECT_EQ(reloaded.getComponents(8, deviceId), 0);
+}
+
+TEST_F(UpdateCheckpointTest, eidOfAnotherDevice)
+{
+    auto path = dir / "checkpoint";
+    Descriptors other{{PLDM_FWUP_UUID, DescriptorData(16, 0x22)}};
+    auto otherId = UpdateCheckpoint::computeDeviceId(other);
+    EXPECT_NE(deviceId, otherId);
+
+    Descriptors vendor{
+        {PLDM_FWUP_VENDOR_DEFINED,
+         VendorDefinedDescriptorInfo{"OpenBMC", {0x01}}}};
+    EXPECT_NE(UpdateCheckpoint::computeDeviceId(vendor), deviceId);
+
+    {
+        UpdateCheckpoint checkpoint(path);
+        checkpoint.setPackage(1);
+        checkpoint.setComponents(8, deviceId, 2);
+    }
+
+    // The EID was assigned to another device meanwhile
+    UpdateCheckpoint checkpoint(path);
+    checkpoint.setPackage(1);
+    EXPECT_EQ(checkpoint.getComponents(8, otherId), 0);
+    EXPECT_EQ(checkpoint.getComponents(8, deviceId), 2);
+}
+
+TEST_F(UpdateCheckpointTest, disabled)
+{
+    UpdateCheckpoint checkpoint;
+    EXPECT_FALSE(checkpoint.enabled());
+    checkpoint.setPackage(1);
+    checkpoint.setComponents(8, deviceId, 2);
+    EXPECT_EQ(checkpoint.getComponents(8, deviceId), 2);
+    EXPECT_TRUE(fs::is_empty(dir));
+}
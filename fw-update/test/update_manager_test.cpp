@@ -0,0 +1,200 @@
+#include "common/instance_id.hpp"
+#include "fw-update/update_manager.hpp"
+#include "requester/handler.hpp"
+#include "test/test_instance_id.hpp"
+
+#include <libpldm/firmware_update.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using namespace pldm;
+using namespace pldm::fw_update;
+using namespace std::chrono;
+using ActivationServer =
+    sdbusplus::xyz::openbmc_project::Software::server::Activation;
+using Activations = ActivationServer::Activations;
+
+constexpr mctp_eid_t eid = 1;
+
+class TestUpdateManager : public testing::Test
+{
+  protected:
+    TestUpdateManager() :
+        event(sdeventplus::Event::get_default()),
+        reqHandler(nullptr, event, instanceIdDb, false, seconds(1), 2,
+                   milliseconds(100)),
+        manager(event, reqHandler, instanceIdDb, descriptorMap,
+                componentInfoMap, networkMap)
+    {
+        char tmpdir[] = "/tmp/pldm_fw_queue.XXXXXX";
+        dir = fs::path(mkdtemp(tmpdir));
+        manager.maxQueuedPackages = 2;
+    }
+
+    ~TestUpdateManager() override
+    {
+        fs::remove_all(dir);
+    }
+
+    /** @brief Process a copy of the test package */
+    fs::path processPackage(const std::string& name)
+    {
+        auto path = dir / name;
+        fs::copy_file("./test_pkg", path);
+        EXPECT_EQ(manager.processPackage(path), 0);
+        return path;
+    }
+
+    void activate()
+    {
+        manager.activation->requestedActivation(
+            ActivationServer::RequestedActivations::Active);
+    }
+
+    /** @brief End the update of the FD, which ends the activation */
+    void finish(bool status)
+    {
+        manager.updateDeviceCompletion(eid, status);
+    }
+
+    void runDeferred()
+    {
+        event.run(std::nullopt);
+    }
+
+    Activations state() const
+    {
+        return manager.activation->activation();
+    }
+
+    bool hasActivation() const
+    {
+        return manager.activation != nullptr;
+    }
+
+    const fs::path& activePackage() const
+    {
+        return manager.fwPackageFilePath;
+    }
+
+    const std::string& objPath() const
+    {
+        return manager.objPath;
+    }
+
+    /** @brief Give the last queued package its own D-Bus object path */
+    void renameQueued(const std::string& path)
+    {
+        manager.queuedPackages.back().objPath = path;
+    }
+
+    const Activation* finished(const std::string& path) const
+    {
+        auto it = manager.finishedActivations.find(path);
+        return it != manager.finishedActivations.end()
+                   ? it->second.activation.get()
+                   : nullptr;
+    }
+
+    fs::path dir;
+    sdeventplus::Event event;
+    TestInstanceIdDb instanceIdDb;
+    requester::Handler<requester::Request> reqHandler;
+    DescriptorMap descriptorMap{
+        {eid,
+         {{PLDM_FWUP_UUID,
+           DescriptorData{0x16, 0x20, 0x23, 0xC9, 0x3E, 0xC5, 0x41, 0x15,
+                          0x95, 0xF4, 0x48, 0x70, 0x1D, 0x49, 0xD6, 0x75}}}}};
+    ComponentInfoMap componentInfoMap{{eid, {{std::make_pair(10, 100), 1}}}};
+    NetworkMap networkMap{};
+    UpdateManager manager;
+};
+
+TEST_F(TestUpdateManager, queuedPackagesActivateInOrder)
+{
+    auto first = processPackage("first");
+    activate();
+    ASSERT_EQ(state(), Activations::Activating);
+
+    auto second = processPackage("second");
+    auto third = processPackage("third");
+    EXPECT_EQ(manager.getQueuedPackages(), 2);
+    EXPECT_EQ(activePackage(), first);
+
+    // The queue is full
+    fs::copy_file("./test_pkg", dir / "fourth");
+    EXPECT_EQ(manager.processPackage(dir / "fourth"), -1);
+    EXPECT_FALSE(fs::exists(dir / "fourth"));
+
+    finish(true);
+    EXPECT_EQ(state(), Activations::Active);
+    runDeferred();
+    EXPECT_EQ(activePackage(), second);
+    EXPECT_EQ(state(), Activations::Activating);
+    EXPECT_FALSE(fs::exists(first));
+
+    finish(false);
+    runDeferred();
+    EXPECT_EQ(activePackage(), third);
+    EXPECT_EQ(manager.getQueuedPackages(), 0);
+}
+
+TEST_F(TestUpdateManager, finishedResultStaysVisible)
+{
+    processPackage("first");
+    auto firstPath = objPath();
+    activate();
+    processPackage("second");
+    renameQueued(firstPath + "0");
+
+    finish(false);
+    runDeferred();
+    EXPECT_EQ(objPath(), firstPath + "0");
+    auto result = finished(firstPath);
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result->activation(), Activations::Failed);
+
+    // Deleting the result leaves the activation in progress
+    manager.deleteActivation(firstPath);
+    EXPECT_EQ(finished(firstPath), nullptr);
+    EXPECT_EQ(state(), Activations::Activating);
+}
+
+TEST_F(TestUpdateManager, packageQueuedBehindPendingActivation)
+{
+    processPackage("first");
+    activate();
+    auto second = processPackage("second");
+
+    // The activation ended, the queued package is not activated yet
+    finish(false);
+    ASSERT_EQ(state(), Activations::Failed);
+    auto third = processPackage("third");
+    EXPECT_EQ(manager.getQueuedPackages(), 2);
+
+    runDeferred();
+    EXPECT_EQ(activePackage(), second);
+    EXPECT_EQ(manager.getQueuedPackages(), 1);
+    EXPECT_TRUE(fs::exists(third));
+}
+
+TEST_F(TestUpdateManager, clearDropsQueuedPackages)
+{
+    processPackage("first");
+    activate();
+    auto second = processPackage("second");
+    ASSERT_EQ(manager.getQueuedPackages(), 1);
+
+    manager.clearActivationInfo();
+    EXPECT_EQ(manager.getQueuedPackages(), 0);
+    EXPECT_FALSE(fs::exists(second));
+    EXPECT_FALSE(hasActivation());
+}
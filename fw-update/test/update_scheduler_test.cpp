@@ -0,0 +1,64 @@
+#include "fw-update/update_scheduler.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace pldm::fw_update;
+
+TEST(UpdateScheduler, noLimits)
+{
+    UpdateScheduler scheduler;
+    scheduler.add(8, 1, 0);
+    scheduler.add(9, 1, 0);
+    scheduler.add(10, 2, 1);
+
+    EXPECT_EQ(scheduler.next(), (std::vector<mctp_eid_t>{8, 9, 10}));
+    EXPECT_TRUE(scheduler.next().empty());
+    EXPECT_EQ(scheduler.runningCount(), 3);
+}
+
+TEST(UpdateScheduler, concurrencyLimits)
+{
+    UpdateScheduler scheduler({3, 2, false});
+    scheduler.add(8, 1, 0);
+    scheduler.add(9, 1, 0);
+    scheduler.add(10, 1, 0);
+    scheduler.add(11, 2, 0);
+    scheduler.add(12, 2, 0);
+
+    // Two devices of network 1, then the devices of network 2
+    EXPECT_EQ(scheduler.next(), (std::vector<mctp_eid_t>{8, 9, 11}));
+    EXPECT_TRUE(scheduler.next().empty());
+
+    EXPECT_TRUE(scheduler.complete(11, true).empty());
+    EXPECT_EQ(scheduler.next(), std::vector<mctp_eid_t>{12});
+
+    EXPECT_TRUE(scheduler.complete(8, false).empty());
+    EXPECT_EQ(scheduler.next(), std::vector<mctp_eid_t>{10});
+    EXPECT_EQ(scheduler.pendingCount(), 0);
+}
+
+TEST(UpdateScheduler, canary)
+{
+    UpdateScheduler scheduler({0, 0, true});
+    scheduler.add(8, 1, 0);
+    scheduler.add(9, 1, 0);
+    scheduler.add(10, 1, 0);
+    scheduler.add(20, 2, 1);
+    scheduler.add(21, 2, 1);
+
+    // One canary of each device class
+    EXPECT_EQ(scheduler.next(), (std::vector<mctp_eid_t>{8, 20}));
+    EXPECT_TRUE(scheduler.next().empty());
+
+    EXPECT_TRUE(scheduler.complete(8, true).empty());
+    EXPECT_EQ(scheduler.next(), (std::vector<mctp_eid_t>{9, 10}));
+
+    // A failed canary cancels the rest of its class
+    EXPECT_EQ(scheduler.complete(20, false), std::vector<mctp_eid_t>{21});
+    EXPECT_TRUE(scheduler.next().empty());
+    EXPECT_EQ(scheduler.pendingCount(), 0);
+
+    // Not a canary
+    EXPECT_TRUE(scheduler.complete(9, false).empty());
+    EXPECT_EQ(scheduler.runningCount(), 1);
+}
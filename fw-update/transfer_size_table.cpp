@@ -0,0 +1,83 @@
+#include "transfer_size_table.hpp"
+
+#include <libpldm/firmware_update.h>
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <fstream>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+TransferSizeTable::TransferSizeTable(const std::filesystem::path& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return;
+    }
+
+    auto json = nlohmann::json::parse(file, nullptr, false);
+    if (json.is_discarded() || !json.contains("entries"))
+    {
+        error("Failed to parse the firmware transfer size config '{PATH}'",
+              "PATH", path);
+        return;
+    }
+
+    for (const auto& entry : json["entries"])
+    {
+        try
+        {
+            Descriptors descriptors;
+            for (const auto& descriptor : entry.at("descriptors"))
+            {
+                descriptors.emplace(
+                    descriptor.at("type").get<DescriptorType>(),
+                    descriptor.at("data").get<DescriptorData>());
+            }
+            auto maxTransferSize =
+                entry.at("max_transfer_size").get<uint32_t>();
+            if (descriptors.empty() ||
+                maxTransferSize < PLDM_FWUP_BASELINE_TRANSFER_SIZE)
+            {
+                error(
+                    "Invalid entry in the firmware transfer size config '{PATH}'",
+                    "PATH", path);
+                continue;
+            }
+            add(descriptors, maxTransferSize);
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Invalid entry in the firmware transfer size config '{PATH}', error - {ERROR}",
+                "PATH", path, "ERROR", e);
+        }
+    }
+}
+
+uint32_t TransferSizeTable::get(const Descriptors& descriptors,
+                                uint32_t defaultSize) const
+{
+    for (const auto& [entryDescriptors, maxTransferSize] : entries)
+    {
+        if (std::includes(descriptors.begin(), descriptors.end(),
+                          entryDescriptors.begin(), entryDescriptors.end()))
+        {
+            return maxTransferSize;
+        }
+    }
+    return defaultSize;
+}
+
+} // namespace fw_update
+
+} // namespace pldm
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "common/types.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+/** @class TransferSizeTable
+ *
+ *  MaxTransferSize announced in RequestUpdate to each class of FDs, a class
+ *  being the FDs whose descriptors include the descriptors of an entry, so
+ *  the FDs on fast links are not held to the transfer size of the slowest
+ *  ones. The table is read from a JSON file of entries like
+ *
+ *  {
+ *      "entries": [
+ *          {
+ *              "descriptors": [{ "type": 1, "data": [0, 0, 167, 172] }],
+ *              "max_transfer_size": 65536
+ *          }
+ *      ]
+ *  }
+ */
+class TransferSizeTable
+{
+  public:
+    TransferSizeTable() = default;
+
+    /** @brief Constructor, reading the table from a JSON file
+     *
+     *  @param[in] path - path of the JSON file, a missing file is an empty
+     *                    table
+     */
+    explicit TransferSizeTable(const std::filesystem::path& path);
+
+    /** @brief Add an entry, after the entries already in the table */
+    void add(const Descriptors& descriptors, uint32_t maxTransferSize)
+    {
+        entries.emplace_back(descriptors, maxTransferSize);
+    }
+
+    /** @brief Get the MaxTransferSize to announce to an FD
+     *
+     *  @param[in] descriptors - descriptors of the FD
+     *  @param[in] defaultSize - size for the FDs matching no entry
+     *  @return the size of the first entry the FD matches, defaultSize if
+     *          none
+     */
+    uint32_t get(const Descriptors& descriptors, uint32_t defaultSize) const;
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+  private:
+    std::vector<std::pair<Descriptors, uint32_t>> entries;
+};
+
+} // namespace fw_update
+
+} // namespace pldm
@@ -0,0 +1,183 @@
+#include "update_checkpoint.hpp"
+
+#include "common/fnv_hash.hpp"
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <fstream>
+#include <string>
+#include <variant>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+UpdateCheckpoint::UpdateCheckpoint(const std::filesystem::path& path) :
+    path(path)
+{
+    if (!enabled())
+    {
+        return;
+    }
+
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return;
+    }
+
+    auto json = nlohmann::json::parse(file, nullptr, false);
+    try
+    {
+        packageHash = json.at("package").get<uint64_t>();
+        for (const auto& [eid, progress] : json.at("devices").items())
+        {
+            components[static_cast<mctp_eid_t>(std::stoul(eid))] = {
+                progress.at("device").get<uint64_t>(),
+                progress.at("components").get<size_t>()};
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to load the firmware update checkpoint '{PATH}', error - {ERROR}",
+            "PATH", path, "ERROR", e);
+        packageHash = 0;
+        components.clear();
+    }
+}
+
+void UpdateCheckpoint::setPackage(uint64_t packageHash)
+{
+    if (this->packageHash == packageHash)
+    {
+        return;
+    }
+    this->packageHash = packageHash;
+    components.clear();
+    store();
+}
+
+size_t UpdateCheckpoint::getComponents(mctp_eid_t eid,
+                                       uint64_t deviceId) const
+{
+    auto it = components.find(eid);
+    if (it == components.end() || it->second.deviceId != deviceId)
+    {
+        return 0;
+    }
+    return it->second.components;
+}
+
+void UpdateCheckpoint::setComponents(mctp_eid_t eid, uint64_t deviceId,
+                                     size_t count)
+{
+    components[eid] = {deviceId, count};
+    store();
+}
+
+void UpdateCheckpoint::erase(mctp_eid_t eid)
+{
+    if (components.erase(eid))
+    {
+        store();
+    }
+}
+
+uint64_t UpdateCheckpoint::computeHash(std::span<const uint8_t> pkgHeader,
+                                       uintmax_t pkgSize)
+{
+    uint64_t hash = pldm::utils::fnvOffsetBasis;
+    pldm::utils::fnvHash(hash, pkgHeader);
+    for (size_t i = 0; i < sizeof(pkgSize); i++)
+    {
+        pldm::utils::fnvHash(hash, static_cast<uint8_t>(pkgSize >> (i * 8)));
+    }
+    return hash;
+}
+
+uint64_t UpdateCheckpoint::computeDeviceId(const Descriptors& descriptors)
+{
+    uint64_t hash = pldm::utils::fnvOffsetBasis;
+    auto add = [&hash](std::span<const uint8_t> bytes) {
+        // The length keeps the descriptors apart
+        for (size_t i = 0; i < sizeof(uint64_t); i++)
+        {
+            pldm::utils::fnvHash(hash,
+                           static_cast<uint8_t>(bytes.size() >> (i * 8)));
+        }
+        pldm::utils::fnvHash(hash, bytes);
+    };
+
+    for (const auto& [type, value] : descriptors)
+    {
+        add({reinterpret_cast<const uint8_t*>(&type), sizeof(type)});
+        if (const auto* data = std::get_if<DescriptorData>(&value))
+        {
+            add(*data);
+        }
+        else
+        {
+            const auto& [title, vendorData] =
+                std::get<VendorDefinedDescriptorInfo>(value);
+            add({reinterpret_cast<const uint8_t*>(title.data()),
+                 title.size()});
+            add(vendorData);
+        }
+    }
+    return hash;
+}
+
+void UpdateCheckpoint::store() const
+{
+    if (!enabled())
+    {
+        return;
+    }
+
+    nlohmann::json devices = nlohmann::json::object();
+    for (const auto& [eid, progress] : components)
+    {
+        devices[std::to_string(eid)] = {{"device", progress.deviceId},
+                                        {"components", progress.components}};
+    }
+    nlohmann::json json{{"package", packageHash}, {"devices", devices}};
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    // Write a temporary file and rename it, a crash must not leave a
+    // partially written checkpoint behind
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::trunc);
+        file << json;
+        file.close();
+        if (!file)
+        {
+            error("Failed to write the firmware update checkpoint '{PATH}'",
+                  "PATH", tmpPath);
+            std::filesystem::remove(tmpPath, ec);
+            return;
+        }
+    }
+
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec)
+    {
+        error(
+            "Failed to update the firmware update checkpoint '{PATH}', error - {ERROR}",
+            "PATH", path, "ERROR", ec.message());
+        std::filesystem::remove(tmpPath, ec);
+    }
+}
+
+} // namespace fw_update
+
+} // namespace pldm
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "common/types.hpp"
+
+#include <libpldm/base.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <span>
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+/** @class UpdateCheckpoint
+ *
+ *  Persists the progress of the firmware updates of a package, as the
+ *  number of applicable components each FD applied, so an update
+ *  interrupted by a pldmd restart or an endpoint reset resumes after the
+ *  components already applied when the same package is supplied again.
+ *  The progress of an FD is kept by EID along with the identity of the
+ *  device, so an EID assigned to another device starts over. The FD chooses
+ *  the offsets of the component data it requests, so the progress within a
+ *  component is not resumed.
+ */
+class UpdateCheckpoint
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] path - file the progress is kept in, empty to disable the
+     *                    checkpoints
+     */
+    explicit UpdateCheckpoint(const std::filesystem::path& path = {});
+
+    bool enabled() const
+    {
+        return !path.empty();
+    }
+
+    /** @brief Select the package being updated, dropping the progress of
+     *         another package
+     *
+     *  @param[in] packageHash - hash of the package, from computeHash
+     */
+    void setPackage(uint64_t packageHash);
+
+    /** @brief Get the number of components an FD applied
+     *
+     *  @param[in] eid - MCTP endpoint ID of the FD
+     *  @param[in] deviceId - identity of the FD, from computeDeviceId
+     *  @return the number of components, 0 if none or if they were applied
+     *          by another device with the EID
+     */
+    size_t getComponents(mctp_eid_t eid, uint64_t deviceId) const;
+
+    /** @brief Record the number of components an FD applied */
+    void setComponents(mctp_eid_t eid, uint64_t deviceId, size_t components);
+
+    /** @brief Drop the progress of an FD, once it activated the package */
+    void erase(mctp_eid_t eid);
+
+    /** @brief Compute the hash identifying a package
+     *
+     *  @param[in] pkgHeader - package header, ending with its checksum
+     *  @param[in] pkgSize - size of the package
+     */
+    static uint64_t computeHash(std::span<const uint8_t> pkgHeader,
+                                uintmax_t pkgSize);
+
+    /** @brief Compute the identity of an FD
+     *
+     *  @param[in] descriptors - descriptors of the FD, from
+     *                           QueryDeviceIdentifiers, which include its
+     *                           UUID when it has one
+     */
+    static uint64_t computeDeviceId(const Descriptors& descriptors);
+
+  private:
+    /** @brief Write the progress to the checkpoint file */
+    void store() const;
+
+    std::filesystem::path path;
+
+    /** @brief Hash of the package of the progress */
+    uint64_t packageHash = 0;
+
+    /** @brief Progress of an FD */
+    struct Progress
+    {
+        /** @brief Identity of the FD */
+        uint64_t deviceId;
+
+        /** @brief Number of components applied */
+        size_t components;
+    };
+
+    /** @brief Progress of each FD */
+    std::map<mctp_eid_t, Progress> components;
+};
+
+} // namespace fw_update
+
+} // namespace pldm
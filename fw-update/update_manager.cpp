@@ -2,15 +2,21 @@
 
 #include "activation.hpp"
 #include "common/utils.hpp"
+#include "common/worker_pool.hpp"
 #include "package_parser.hpp"
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <filesystem>
-#include <fstream>
+#include <memory>
+#include <set>
 #include <string>
+#include <string_view>
+#include <utility>
 
 PHOSPHOR_LOG2_USING;
 
@@ -23,6 +29,68 @@ namespace fw_update
 namespace fs = std::filesystem;
 namespace software = sdbusplus::xyz::openbmc_project::Software::server;
 
+#ifdef FW_UPDATE_COMPONENT_CHECKSUMS
+/** @brief Log the CRC32 of the components of a package once computed on the
+ *         worker pool, one job per component
+ *
+ *  The jobs map the package themselves, so the package can be installed,
+ *  queued or dropped meanwhile. Reading the components also brings them in
+ *  the page cache for their transfer.
+ *
+ *  @param[in] packageFilePath - path of the package file
+ *  @param[in] parser - parser of the package
+ */
+static void logComponentChecksums(const fs::path& packageFilePath,
+                                  const PackageParser& parser)
+{
+    struct Checksums
+    {
+        PackageImage image;
+        std::string pkgVersion;
+        ComponentImageInfos compImageInfos;
+        std::vector<uint32_t> checksums;
+    };
+
+    auto state = std::make_shared<Checksums>();
+    if (state->image.open(packageFilePath))
+    {
+        return;
+    }
+    state->pkgVersion = parser.pkgVersion;
+    state->compImageInfos = parser.getComponentImageInfos();
+    state->checksums.resize(state->compImageInfos.size());
+
+    try
+    {
+        auto& pool = pldm::utils::WorkerPool::getInstance();
+        for (size_t index = 0; index < state->compImageInfos.size(); index++)
+        {
+            // Each job only writes its own checksum
+            pool.post(
+                [state, index]() {
+                    state->checksums[index] = computeComponentChecksum(
+                        state->image.data(), state->compImageInfos[index]);
+                },
+                [state, index]() {
+                    info(
+                        "Component '{COMPONENT_VERSION}' of PLDM fw update package for version '{VERSION}' has CRC32 '{CRC32}'",
+                        "COMPONENT_VERSION",
+                        std::get<static_cast<size_t>(
+                            ComponentImageInfoPos::CompVersionPos)>(
+                            state->compImageInfos[index]),
+                        "VERSION", state->pkgVersion, "CRC32", lg2::hex,
+                        state->checksums[index]);
+                });
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to compute the component checksums, error - {ERROR}",
+              "ERROR", e);
+    }
+}
+#endif
+
 int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
 {
     // If no devices discovered, take no action on the package.
@@ -32,18 +100,13 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
     }
 
     namespace software = sdbusplus::xyz::openbmc_project::Software::server;
-    // If a firmware activation of a package is in progress, don't proceed with
-    // package processing
+    // If a firmware activation of a package is in progress, the package is
+    // queued behind it and the packages already queued
     if (activation)
     {
-        if (activation->activation() ==
-            software::Activation::Activations::Activating)
+        if (activationPending())
         {
-            error(
-                "Activation of PLDM fw update package for version '{VERSION}' already in progress.",
-                "VERSION", parser->pkgVersion);
-            std::filesystem::remove(packageFilePath);
-            return -1;
+            return queuePackage(packageFilePath);
         }
         else
         {
@@ -51,19 +114,45 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
         }
     }
 
-    package.open(packageFilePath,
-                 std::ios::binary | std::ios::in | std::ios::ate);
-    if (!package.good())
+    PreparedPackage prepared;
+    switch (preparePackage(packageFilePath, prepared))
+    {
+        case PrepareStatus::Ready:
+            break;
+        case PrepareStatus::Unreadable:
+            std::filesystem::remove(packageFilePath);
+            return -1;
+        case PrepareStatus::Invalid:
+            objPath = prepared.objPath;
+            activation = std::make_unique<Activation>(
+                pldm::utils::DBusHandler::getBus(), objPath,
+                software::Activation::Activations::Invalid, this);
+            return -1;
+        case PrepareStatus::NoMatch:
+            objPath = prepared.objPath;
+            activation = std::make_unique<Activation>(
+                pldm::utils::DBusHandler::getBus(), objPath,
+                software::Activation::Activations::Invalid, this);
+            return 0;
+    }
+
+    installPackage(std::move(prepared));
+    return 0;
+}
+
+UpdateManager::PrepareStatus UpdateManager::preparePackage(
+    const std::filesystem::path& packageFilePath, PreparedPackage& prepared)
+{
+    auto& package = prepared.image;
+    if (auto rc = package.open(packageFilePath); rc)
     {
         error(
             "Failed to open the PLDM fw update package file '{FILE}', error - {ERROR}.",
-            "ERROR", errno, "FILE", packageFilePath);
-        package.close();
-        std::filesystem::remove(packageFilePath);
-        return -1;
+            "ERROR", rc, "FILE", packageFilePath);
+        return PrepareStatus::Unreadable;
     }
 
-    uintmax_t packageSize = package.tellg();
+    uintmax_t packageSize = package.size();
     if (packageSize < sizeof(pldm_package_header_information))
     {
         error(
@@ -71,129 +160,286 @@ int UpdateManager::processPackage(const std::filesystem::path& packageFilePath)
             "SIZE", packageSize, "PACKAGE_HEADER_INFO_SIZE",
             sizeof(pldm_package_header_information));
         package.close();
-        std::filesystem::remove(packageFilePath);
-        return -1;
+        return PrepareStatus::Unreadable;
     }
 
-    package.seekg(0);
-    std::vector<uint8_t> packageHeader(sizeof(pldm_package_header_information));
-    package.read(reinterpret_cast<char*>(packageHeader.data()),
-                 sizeof(pldm_package_header_information));
-
     auto pkgHeaderInfo =
         reinterpret_cast<const pldm_package_header_information*>(
-            packageHeader.data());
+            package.data().data());
     auto pkgHeaderInfoSize = sizeof(pldm_package_header_information) +
                              pkgHeaderInfo->package_version_string_length;
-    packageHeader.clear();
-    packageHeader.resize(pkgHeaderInfoSize);
-    package.seekg(0);
-    package.read(reinterpret_cast<char*>(packageHeader.data()),
-                 pkgHeaderInfoSize);
+    std::vector<uint8_t> packageHeader(pkgHeaderInfoSize);
+    std::memcpy(packageHeader.data(), package.data().data(),
+                std::min<size_t>(pkgHeaderInfoSize, packageSize));
 
+    auto& parser = prepared.parser;
     parser = parsePkgHeader(packageHeader);
     if (parser == nullptr)
     {
         error("Invalid PLDM package header information");
         package.close();
-        std::filesystem::remove(packageFilePath);
-        return -1;
+        return PrepareStatus::Unreadable;
     }
 
     // Populate object path with the hash of the package version
     size_t versionHash = std::hash<std::string>{}(parser->pkgVersion);
-    objPath = swRootPath + std::to_string(versionHash);
+    prepared.objPath = swRootPath + std::to_string(versionHash);
 
-    package.seekg(0);
-    packageHeader.resize(parser->pkgHeaderSize);
-    package.read(reinterpret_cast<char*>(packageHeader.data()),
-                 parser->pkgHeaderSize);
+    // The parser decodes the records from the mapped package on demand
+    auto pkgHeader = package.data().first(
+        std::min<size_t>(parser->pkgHeaderSize, packageSize));
     try
     {
-        parser->parse(packageHeader, packageSize);
+        parser->parse(pkgHeader, packageSize);
     }
     catch (const std::exception& e)
     {
         error("Invalid PLDM package header, error - {ERROR}", "ERROR", e);
-        activation = std::make_unique<Activation>(
-            pldm::utils::DBusHandler::getBus(), objPath,
-            software::Activation::Activations::Invalid, this);
         package.close();
         parser.reset();
-        return -1;
+        return PrepareStatus::Invalid;
     }
 
-    auto deviceUpdaterInfos =
-        associatePkgToDevices(parser->getFwDeviceIDRecords(), descriptorMap,
-                              totalNumComponentUpdates);
-    if (!deviceUpdaterInfos.size())
+    prepared.deviceUpdaterInfos = associatePkgToDevices(
+        *parser, descriptorMap, prepared.totalNumComponentUpdates);
+    if (!prepared.deviceUpdaterInfos.size())
     {
         error(
             "No matching devices found with the PLDM firmware update package");
-        activation = std::make_unique<Activation>(
-            pldm::utils::DBusHandler::getBus(), objPath,
-            software::Activation::Activations::Invalid, this);
         package.close();
         parser.reset();
-        return 0;
+        return PrepareStatus::NoMatch;
     }
 
-    const auto& fwDeviceIDRecords = parser->getFwDeviceIDRecords();
+    prepared.packageHash =
+        UpdateCheckpoint::computeHash(pkgHeader, packageSize);
+
+#ifdef FW_UPDATE_COMPONENT_CHECKSUMS
+    logComponentChecksums(packageFilePath, *parser);
+#endif
+
+    prepared.path = packageFilePath;
+    return PrepareStatus::Ready;
+}
+
+void UpdateManager::installPackage(PreparedPackage&& prepared)
+{
+    package = std::move(prepared.image);
+    parser = std::move(prepared.parser);
+    objPath = std::move(prepared.objPath);
+    deviceUpdaterInfos = std::move(prepared.deviceUpdaterInfos);
+    totalNumComponentUpdates = prepared.totalNumComponentUpdates;
+
     const auto& compImageInfos = parser->getComponentImageInfos();
+    checkpoint.setPackage(prepared.packageHash);
 
     for (const auto& deviceUpdaterInfo : deviceUpdaterInfos)
     {
         const auto& fwDeviceIDRecord =
-            fwDeviceIDRecords[deviceUpdaterInfo.second];
+            parser->getFwDeviceIDRecord(deviceUpdaterInfo.second);
         auto search = componentInfoMap.find(deviceUpdaterInfo.first);
-        deviceUpdaterMap.emplace(
+        auto maxTransferSize = transferSizes.get(
+            descriptorMap.at(deviceUpdaterInfo.first), MAXIMUM_TRANSFER_SIZE);
+        auto [it, added] = deviceUpdaterMap.emplace(
             deviceUpdaterInfo.first,
             std::make_unique<DeviceUpdater>(
-                deviceUpdaterInfo.first, package, fwDeviceIDRecord,
-                compImageInfos, search->second, MAXIMUM_TRANSFER_SIZE, this));
+                deviceUpdaterInfo.first, package.data(), fwDeviceIDRecord,
+                compImageInfos, search->second, maxTransferSize, this,
+                checkpoint.getComponents(
+                    deviceUpdaterInfo.first,
+                    UpdateCheckpoint::computeDeviceId(
+                        descriptorMap.at(deviceUpdaterInfo.first)))));
+        if (added && it->second->getResumedComponents())
+        {
+            info(
+                "Resuming the firmware update of endpoint ID '{EID}' after {COMPONENTS} applied components",
+                "EID", deviceUpdaterInfo.first, "COMPONENTS",
+                it->second->getResumedComponents());
+            compUpdateCompletedCount += it->second->getResumedComponents();
+        }
+    }
+
+    scheduler.clear();
+    std::set<mctp_eid_t> scheduled;
+    for (const auto& [eid, deviceClass] : deviceUpdaterInfos)
+    {
+        // An FD matching several records is updated with the first one
+        if (!scheduled.insert(eid).second)
+        {
+            continue;
+        }
+        auto network = networkMap.find(eid);
+        scheduler.add(eid, network != networkMap.end() ? network->second : 0,
+                      deviceClass);
     }
 
-    fwPackageFilePath = packageFilePath;
+    fwPackageFilePath = std::move(prepared.path);
     activation = std::make_unique<Activation>(
         pldm::utils::DBusHandler::getBus(), objPath,
         software::Activation::Activations::Ready, this);
     activationProgress = std::make_unique<ActivationProgress>(
         pldm::utils::DBusHandler::getBus(), objPath);
+    updateStatistics = std::make_unique<UpdateStatistics>(
+        pldm::utils::DBusHandler::getBus(), objPath,
+        std::bind_front(&UpdateManager::getUpdateStatistics, this));
+}
 
+int UpdateManager::queuePackage(const std::filesystem::path& packageFilePath)
+{
+    if (queuedPackages.size() >= maxQueuedPackages)
+    {
+        error(
+            "Activation of PLDM fw update package for version '{VERSION}' already in progress.",
+            "VERSION", parser->pkgVersion);
+        std::filesystem::remove(packageFilePath);
+        return -1;
+    }
+
+    PreparedPackage prepared;
+    auto status = preparePackage(packageFilePath, prepared);
+    if (status != PrepareStatus::Ready)
+    {
+        error(
+            "Failed to queue the PLDM fw update package file '{FILE}' behind the activation in progress.",
+            "FILE", packageFilePath);
+        std::filesystem::remove(packageFilePath);
+        return -1;
+    }
+
+    // The kernel reads the components ahead while the activation in
+    // progress transfers its own
+    PackageImage::advise(prepared.image.data(), 0, prepared.image.size(),
+                         MADV_WILLNEED);
+    info(
+        "PLDM fw update package for version '{VERSION}' queued behind version '{CURRENT}', {COUNT} packages queued",
+        "VERSION", prepared.parser->pkgVersion, "CURRENT", parser->pkgVersion,
+        "COUNT", queuedPackages.size() + 1);
+    queuedPackages.emplace_back(std::move(prepared));
     return 0;
 }
 
+void UpdateManager::activateQueuedPackage()
+{
+    queuedActivation.reset();
+    if (queuedPackages.empty())
+    {
+        return;
+    }
+
+    auto prepared = std::move(queuedPackages.front());
+    queuedPackages.pop_front();
+    // The Active or Failed result stays on D-Bus, unless the queued package
+    // takes over its object path
+    if (activation && objPath != prepared.objPath)
+    {
+        finishedActivations.insert_or_assign(
+            objPath, FinishedActivation{std::move(activation),
+                                        std::move(activationProgress)});
+    }
+    finishedActivations.erase(prepared.objPath);
+    resetActivation();
+    info("Activating the queued PLDM fw update package for version '{VERSION}'",
+         "VERSION", prepared.parser->pkgVersion);
+    installPackage(std::move(prepared));
+    activation->requestedActivation(
+        software::Activation::RequestedActivations::Active);
+}
+
+bool UpdateManager::activationPending() const
+{
+    return activation && (activation->activation() ==
+                              software::Activation::Activations::Activating ||
+                          !queuedPackages.empty());
+}
+
+bool UpdateManager::checkStreamedPackage(const PackageParser& packageParser)
+{
+    if (!descriptorMap.size())
+    {
+        return false;
+    }
+    if (activationPending() && queuedPackages.size() >= maxQueuedPackages)
+    {
+        error(
+            "Activation of PLDM fw update package for version '{VERSION}' already in progress.",
+            "VERSION", packageParser.pkgVersion);
+        return false;
+    }
+
+    TotalComponentUpdates componentUpdates = 0;
+    return !associatePkgToDevices(packageParser, descriptorMap,
+                                  componentUpdates)
+                .empty();
+}
+
+void UpdateManager::startPackageStream()
+{
+    if (std::string_view(FW_UPDATE_STREAM_SOCKET).empty())
+    {
+        return;
+    }
+
+    try
+    {
+        packageStream = std::make_unique<PackageStream>(
+            event, FW_UPDATE_STREAM_SOCKET, FW_UPDATE_SPOOL_DIR,
+            std::bind_front(&UpdateManager::checkStreamedPackage, this),
+            std::bind_front(&UpdateManager::processPackage, this));
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to listen for streamed packages, error - {ERROR}",
+              "ERROR", e);
+    }
+}
+
 DeviceUpdaterInfos UpdateManager::associatePkgToDevices(
-    const FirmwareDeviceIDRecords& fwDeviceIDRecords,
-    const DescriptorMap& descriptorMap,
+    const PackageParser& packageParser, const DescriptorMap& descriptorMap,
     TotalComponentUpdates& totalNumComponentUpdates)
 {
-    DeviceUpdaterInfos deviceUpdaterInfos;
-    for (size_t index = 0; index < fwDeviceIDRecords.size(); ++index)
+    DeviceUpdaterInfos infos;
+    for (size_t index = 0; index < packageParser.getFwDeviceIDRecordCount();
+         ++index)
     {
-        const auto& deviceIDDescriptors =
-            std::get<Descriptors>(fwDeviceIDRecords[index]);
         for (const auto& [eid, descriptors] : descriptorMap)
         {
-            if (std::includes(descriptors.begin(), descriptors.end(),
-                              deviceIDDescriptors.begin(),
-                              deviceIDDescriptors.end()))
+            if (packageParser.matchFwDeviceIDRecord(index, descriptors))
             {
-                deviceUpdaterInfos.emplace_back(std::make_pair(eid, index));
+                infos.emplace_back(std::make_pair(eid, index));
                 const auto& applicableComponents =
-                    std::get<ApplicableComponents>(fwDeviceIDRecords[index]);
+                    std::get<ApplicableComponents>(
+                        packageParser.getFwDeviceIDRecord(index));
                 totalNumComponentUpdates += applicableComponents.size();
             }
         }
     }
-    return deviceUpdaterInfos;
+    return infos;
 }
 
 void UpdateManager::updateDeviceCompletion(mctp_eid_t eid, bool status)
 {
     deviceUpdateCompletionMap.emplace(eid, status);
+    if (status)
+    {
+        checkpoint.erase(eid);
+    }
+    for (auto cancelled : scheduler.complete(eid, status))
+    {
+        error(
+            "Firmware update of endpoint ID '{EID}' cancelled, the update of endpoint ID '{CANARY}' failed",
+            "EID", cancelled, "CANARY", eid);
+        deviceUpdateCompletionMap.emplace(cancelled, false);
+    }
+    startDeviceUpdates();
+
     if (deviceUpdateCompletionMap.size() == deviceUpdaterMap.size())
     {
+        if (!queuedPackages.empty())
+        {
+            queuedActivation = std::make_unique<sdeventplus::source::Defer>(
+                event, std::bind(&UpdateManager::activateQueuedPackage, this));
+        }
+
         for (const auto& [eid, status] : deviceUpdateCompletionMap)
         {
             if (!status)
@@ -261,20 +507,86 @@ Response UpdateManager::handleRequest(mctp_eid_t eid, uint8_t command,
 void UpdateManager::activatePackage()
 {
     startTime = std::chrono::steady_clock::now();
-    for (const auto& [eid, deviceUpdaterPtr] : deviceUpdaterMap)
+    startDeviceUpdates();
+}
+
+void UpdateManager::startDeviceUpdates()
+{
+    for (auto eid : scheduler.next())
     {
-        deviceUpdaterPtr->startFwUpdateFlow();
+        info("Starting the firmware update of endpoint ID '{EID}'", "EID",
+             eid);
+        deviceUpdaterMap.at(eid)->startFwUpdateFlow();
     }
 }
 
+std::vector<UpdateStatisticsEntry> UpdateManager::getUpdateStatistics() const
+{
+    const auto& compImageInfos = parser->getComponentImageInfos();
+    std::vector<UpdateStatisticsEntry> entries;
+    for (const auto& [eid, updater] : deviceUpdaterMap)
+    {
+        const auto& telemetry = updater->getTelemetry();
+        std::vector<ComponentStatisticsEntry> components;
+        for (const auto& comp : telemetry.components)
+        {
+            components.emplace_back(
+                std::get<static_cast<size_t>(
+                    ComponentImageInfoPos::CompIdentifierPos)>(
+                    compImageInfos[comp.index]),
+                comp.updateComponent.count(), comp.transfer.count(),
+                comp.verify.count(), comp.apply.count(), comp.bytes,
+                comp.chunks, comp.retries);
+        }
+        entries.emplace_back(eid, telemetry.requestUpdate.count(),
+                             telemetry.passComponentTable.count(),
+                             telemetry.activate.count(),
+                             std::move(components));
+    }
+    std::ranges::sort(entries, {}, [](const auto& entry) {
+        return std::get<0>(entry);
+    });
+    return entries;
+}
+
 void UpdateManager::clearActivationInfo()
+{
+    resetActivation();
+    finishedActivations.clear();
+
+    queuedActivation.reset();
+    if (!queuedPackages.empty())
+    {
+        info("Dropping {COUNT} queued PLDM fw update packages", "COUNT",
+             queuedPackages.size());
+    }
+    for (const auto& queued : queuedPackages)
+    {
+        std::filesystem::remove(queued.path);
+    }
+    queuedPackages.clear();
+}
+
+void UpdateManager::deleteActivation(const std::string& path)
+{
+    if (finishedActivations.erase(path))
+    {
+        return;
+    }
+    clearActivationInfo();
+}
+
+void UpdateManager::resetActivation()
 {
     activation.reset();
     activationProgress.reset();
+    updateStatistics.reset();
     objPath.clear();
 
     deviceUpdaterMap.clear();
     deviceUpdateCompletionMap.clear();
+    deviceUpdaterInfos.clear();
+    scheduler.clear();
     parser.reset();
     package.close();
     std::filesystem::remove(fwPackageFilePath);
@@ -282,6 +594,18 @@ void UpdateManager::clearActivationInfo()
     compUpdateCompletedCount = 0;
 }
 
+void UpdateManager::checkpointComponents(mctp_eid_t eid, size_t components)
+{
+    auto descriptors = descriptorMap.find(eid);
+    if (descriptors == descriptorMap.end())
+    {
+        return;
+    }
+    checkpoint.setComponents(
+        eid, UpdateCheckpoint::computeDeviceId(descriptors->second),
+        components);
+}
+
 void UpdateManager::updateActivationProgress()
 {
     compUpdateCompletedCount++;
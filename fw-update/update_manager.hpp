@@ -4,18 +4,27 @@
 #include "common/types.hpp"
 #include "device_updater.hpp"
 #include "fw-update/activation.hpp"
+#include "package_image.hpp"
 #include "package_parser.hpp"
+#include "package_stream.hpp"
 #include "requester/handler.hpp"
+#include "transfer_size_table.hpp"
+#include "update_checkpoint.hpp"
+#include "update_scheduler.hpp"
+#include "update_statistics.hpp"
 #include "watch.hpp"
 
 #include <libpldm/base.h>
 
 #include <chrono>
+#include <deque>
 #include <filesystem>
-#include <fstream>
+#include <map>
 #include <tuple>
 #include <unordered_map>
 
+class TestUpdateManager;
+
 namespace pldm
 {
 
@@ -31,6 +40,21 @@ using DeviceUpdaterInfo = std::pair<mctp_eid_t, DeviceIDRecordOffset>;
 using DeviceUpdaterInfos = std::vector<DeviceUpdaterInfo>;
 using TotalComponentUpdates = size_t;
 
+/** @struct PreparedPackage
+ *
+ *  Package parsed, validated and matched to the FDs, ready to be activated
+ */
+struct PreparedPackage
+{
+    std::filesystem::path path;
+    std::string objPath;
+    PackageImage image;
+    std::unique_ptr<PackageParser> parser;
+    DeviceUpdaterInfos deviceUpdaterInfos;
+    TotalComponentUpdates totalNumComponentUpdates = 0;
+    uint64_t packageHash = 0;
+};
+
 class UpdateManager
 {
   public:
@@ -45,13 +69,19 @@ class UpdateManager
         Event& event,
         pldm::requester::Handler<pldm::requester::Request>& handler,
         InstanceIdDb& instanceIdDb, const DescriptorMap& descriptorMap,
-        const ComponentInfoMap& componentInfoMap) :
+        const ComponentInfoMap& componentInfoMap,
+        const NetworkMap& networkMap) :
         event(event), handler(handler), instanceIdDb(instanceIdDb),
         descriptorMap(descriptorMap), componentInfoMap(componentInfoMap),
+        networkMap(networkMap),
         watch(event.get(),
               std::bind_front(&UpdateManager::processPackage, this)),
+        scheduler({FW_UPDATE_MAX_CONCURRENT,
+                   FW_UPDATE_MAX_CONCURRENT_PER_NETWORK, updateCanary}),
         totalNumComponentUpdates(0), compUpdateCompletedCount(0)
-    {}
+    {
+        startPackageStream();
+    }
 
     /** @brief Handle PLDM request for the commands in the FW update
      *         specification
@@ -68,24 +98,76 @@ class UpdateManager
 
     int processPackage(const std::filesystem::path& packageFilePath);
 
+    /** @brief Check if a streamed package is to be received, from its header
+     *
+     *  @param[in] packageParser - parser of the package header
+     *  @return true if the package matches FDs and no activation is in
+     *          progress
+     */
+    bool checkStreamedPackage(const PackageParser& packageParser);
+
+    /** @brief Get the number of packages queued behind the activation in
+     *         progress
+     */
+    size_t getQueuedPackages() const
+    {
+        return queuedPackages.size();
+    }
+
     void updateDeviceCompletion(mctp_eid_t eid, bool status);
 
     void updateActivationProgress();
 
+    /** @brief Record the number of applicable components an FD applied, for
+     *         an interrupted update to resume after them
+     *
+     *  @param[in] eid - MCTP endpoint ID of the FD
+     *  @param[in] components - number of the first applicable components
+     *                          applied
+     */
+    void checkpointComponents(mctp_eid_t eid, size_t components);
+
     /** @brief Callback function that will be invoked when the
      *         RequestedActivation will be set to active in the Activation
      *         interface
      */
     void activatePackage();
 
+    /** @brief Tear down the activation, the results of the activations that
+     *         ended before it and the queued packages
+     */
     void clearActivationInfo();
 
-    /** @brief
+    /** @brief Delete the activation of a package, called by its Delete
+     *         interface
      *
+     *  @param[in] path - D-Bus object path of the activation
+     */
+    void deleteActivation(const std::string& path);
+
+    /** @brief Listen for packages streamed to the package stream socket */
+    void startPackageStream();
+
+    /** @brief Start the updates of the FDs the scheduler lets start */
+    void startDeviceUpdates();
+
+    /** @brief Collect the telemetry of the FDs whose update started
+     *
+     *  @return the entries of the GetStatistics method
+     */
+    std::vector<UpdateStatisticsEntry> getUpdateStatistics() const;
+
+    /** @brief Associate the firmware device ID records of a package to the
+     *         FDs they match
+     *
+     *  @param[in] packageParser - parser of the package header
+     *  @param[in] descriptorMap - descriptors of the FDs
+     *  @param[out] totalNumComponentUpdates - components to update
+     *
+     *  @return the FDs and the index of the record each matches
      */
     DeviceUpdaterInfos associatePkgToDevices(
-        const FirmwareDeviceIDRecords& fwDeviceIDRecords,
-        const DescriptorMap& descriptorMap,
+        const PackageParser& packageParser, const DescriptorMap& descriptorMap,
         TotalComponentUpdates& totalNumComponentUpdates);
 
     const std::string swRootPath{"/xyz/openbmc_project/software/"};
@@ -95,24 +177,128 @@ class UpdateManager
     InstanceIdDb& instanceIdDb; //!< reference to an InstanceIdDb
 
   private:
+    /** @brief Outcome of the preparation of a package */
+    enum class PrepareStatus
+    {
+        Ready,      //!< matched to FDs, ready to be activated
+        Unreadable, //!< not a PLDM fw update package
+        Invalid,    //!< the package header is invalid
+        NoMatch,    //!< no managed FD matches the package
+    };
+
+    /** @brief Parse and validate a package and match it to the FDs
+     *
+     *  @param[in] packageFilePath - path of the package file
+     *  @param[out] prepared - the package, ready when PrepareStatus::Ready
+     *
+     *  @return the outcome of the preparation
+     */
+    PrepareStatus preparePackage(const std::filesystem::path& packageFilePath,
+                                 PreparedPackage& prepared);
+
+    /** @brief Make a prepared package the package to be activated
+     *
+     *  @param[in] prepared - the package, ready
+     */
+    void installPackage(PreparedPackage&& prepared);
+
+    /** @brief Prepare a package received while an activation is in
+     *         progress and queue it, when the queue has room
+     *
+     *  @param[in] packageFilePath - path of the package file
+     *
+     *  @return 0 if the package is queued, -1 otherwise
+     */
+    int queuePackage(const std::filesystem::path& packageFilePath);
+
+    /** @brief Activate the first queued package, the activation in progress
+     *         ended
+     */
+    void activateQueuedPackage();
+
+    /** @brief Check if a package received now is to be queued
+     *
+     *  @return true if an activation is in progress or queued packages wait
+     *          for their own
+     */
+    bool activationPending() const;
+
+    /** @brief Tear down the activation, the package and the FD updaters */
+    void resetActivation();
+
     /** @brief Device identifiers of the managed FDs */
     const DescriptorMap& descriptorMap;
     /** @brief Component information needed for the update of the managed FDs */
     const ComponentInfoMap& componentInfoMap;
+    /** @brief MCTP network of the managed FDs */
+    const NetworkMap& networkMap;
     Watch watch;
 
+    /** @brief Receives the streamed packages, when the socket is configured
+     */
+    std::unique_ptr<PackageStream> packageStream;
+
+#ifdef FW_UPDATE_CANARY
+    static constexpr bool updateCanary = true;
+#else
+    static constexpr bool updateCanary = false;
+#endif
+
     std::unique_ptr<Activation> activation;
     std::unique_ptr<ActivationProgress> activationProgress;
+    std::unique_ptr<UpdateStatistics> updateStatistics;
     std::string objPath;
 
     std::filesystem::path fwPackageFilePath;
     std::unique_ptr<PackageParser> parser;
-    std::ifstream package;
+    PackageImage package;
+
+    /** @brief Packages received while an activation is in progress, prepared
+     *         and activated in order once it ends
+     */
+    std::deque<PreparedPackage> queuedPackages;
+
+    /** @brief Number of packages queued at most, 0 refuses the packages
+     *         received while an activation is in progress
+     */
+    size_t maxQueuedPackages = FW_UPDATE_PACKAGE_QUEUE;
+
+    /** @brief Activation of a package that ended, Active or Failed */
+    struct FinishedActivation
+    {
+        std::unique_ptr<Activation> activation;
+        std::unique_ptr<ActivationProgress> activationProgress;
+    };
+
+    /** @brief Activations that ended before the activation of the queued
+     *         package replacing them, by D-Bus object path, kept until
+     *         deleted or a package is processed anew
+     */
+    std::map<std::string, FinishedActivation> finishedActivations;
+
+    /** @brief Activates the next queued package, out of the callbacks of the
+     *         DeviceUpdater ending the activation in progress
+     */
+    std::unique_ptr<sdeventplus::source::Defer> queuedActivation;
 
     std::unordered_map<mctp_eid_t, std::unique_ptr<DeviceUpdater>>
         deviceUpdaterMap;
     std::unordered_map<mctp_eid_t, bool> deviceUpdateCompletionMap;
 
+    /** @brief FDs matching the package, in the order of their
+     *         FirmwareDeviceIDRecord
+     */
+    DeviceUpdaterInfos deviceUpdaterInfos;
+
+    /** @brief Decides when the update of each FD starts */
+    UpdateScheduler scheduler;
+
+    /** @brief MaxTransferSize announced to each class of FDs */
+    TransferSizeTable transferSizes{FW_UPDATE_TRANSFER_SIZE_JSON};
+
+    /** @brief Progress of the updates, to resume an interrupted update */
+    UpdateCheckpoint checkpoint{FW_UPDATE_CHECKPOINT_PATH};
+
     /** @brief Total number of component updates to calculate the progress of
      *         the Firmware activation
      */
@@ -125,6 +311,8 @@ class UpdateManager
      */
     size_t compUpdateCompletedCount;
     decltype(std::chrono::steady_clock::now()) startTime;
+
+    friend class ::TestUpdateManager;
 };
 
 } // namespace fw_update
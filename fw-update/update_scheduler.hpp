@@ -0,0 +1,209 @@
+#pragma once
+
+#include "common/types.hpp"
+
+#include <libpldm/base.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+using DeviceClassIndex = size_t;
+
+/** @struct UpdateLimits
+ *
+ *  How many firmware devices are updated at once
+ */
+struct UpdateLimits
+{
+    /** @brief Devices updated at once, 0 for no limit */
+    size_t maxConcurrent = 0;
+
+    /** @brief Devices of one MCTP network updated at once, 0 for no limit */
+    size_t maxPerNetwork = 0;
+
+    /** @brief Update one device of each class alone first, and the other
+     *         devices of the class only once it succeeded
+     */
+    bool canary = false;
+};
+
+/** @class UpdateScheduler
+ *
+ *  Decides when the update of each firmware device matching a package
+ *  starts. Devices start in the order they are added, the order of their
+ *  FirmwareDeviceIDRecord in the package, within the global and per MCTP
+ *  network limits. With canary updates, the first device of each device
+ *  class, the devices matching one FirmwareDeviceIDRecord, is updated
+ *  alone, and the update of the other devices of the class is cancelled
+ *  if it fails.
+ */
+class UpdateScheduler
+{
+  public:
+    explicit UpdateScheduler(const UpdateLimits& limits = {}) : limits(limits)
+    {}
+
+    /** @brief Queue the update of a device
+     *
+     *  @param[in] eid - MCTP endpoint ID of the device
+     *  @param[in] network - MCTP network of the device
+     *  @param[in] deviceClass - device class of the device
+     */
+    void add(mctp_eid_t eid, NetworkId network, DeviceClassIndex deviceClass)
+    {
+        pending.push_back({eid, network, deviceClass});
+    }
+
+    /** @brief Take the devices whose update can start now
+     *
+     *  @return the endpoint IDs of the devices, in starting order
+     */
+    std::vector<mctp_eid_t> next()
+    {
+        std::vector<mctp_eid_t> eids;
+        for (auto it = pending.begin(); it != pending.end();)
+        {
+            if (limits.maxConcurrent && running.size() >= limits.maxConcurrent)
+            {
+                break;
+            }
+            if (limits.maxPerNetwork &&
+                networkRunning[it->network] >= limits.maxPerNetwork)
+            {
+                ++it;
+                continue;
+            }
+            if (limits.canary)
+            {
+                auto& state = classStates[it->deviceClass];
+                if (state == CanaryState::Running)
+                {
+                    ++it;
+                    continue;
+                }
+                if (state == CanaryState::None)
+                {
+                    state = CanaryState::Running;
+                    canaries[it->eid] = it->deviceClass;
+                }
+            }
+
+            networkRunning[it->network]++;
+            running.emplace(it->eid, it->network);
+            eids.push_back(it->eid);
+            it = pending.erase(it);
+        }
+        return eids;
+    }
+
+    /** @brief Record the end of the update of a device
+     *
+     *  @param[in] eid - MCTP endpoint ID of the device
+     *  @param[in] status - true if the update succeeded
+     *  @return the endpoint IDs of the devices whose update is cancelled,
+     *          when the device was the canary of its class and failed
+     */
+    std::vector<mctp_eid_t> complete(mctp_eid_t eid, bool status)
+    {
+        std::vector<mctp_eid_t> cancelled;
+        if (auto it = running.find(eid); it != running.end())
+        {
+            networkRunning[it->second]--;
+            running.erase(it);
+        }
+
+        auto canary = canaries.find(eid);
+        if (canary == canaries.end())
+        {
+            return cancelled;
+        }
+        auto deviceClass = canary->second;
+        canaries.erase(canary);
+        classStates[deviceClass] = status ? CanaryState::Passed
+                                          : CanaryState::Failed;
+        if (status)
+        {
+            return cancelled;
+        }
+
+        for (auto it = pending.begin(); it != pending.end();)
+        {
+            if (it->deviceClass == deviceClass)
+            {
+                cancelled.push_back(it->eid);
+                it = pending.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        return cancelled;
+    }
+
+    /** @brief Drop the queued and running updates */
+    void clear()
+    {
+        pending.clear();
+        running.clear();
+        networkRunning.clear();
+        classStates.clear();
+        canaries.clear();
+    }
+
+    size_t pendingCount() const
+    {
+        return pending.size();
+    }
+
+    size_t runningCount() const
+    {
+        return running.size();
+    }
+
+  private:
+    enum class CanaryState
+    {
+        None,
+        Running,
+        Passed,
+        Failed,
+    };
+
+    struct Device
+    {
+        mctp_eid_t eid;
+        NetworkId network;
+        DeviceClassIndex deviceClass;
+    };
+
+    UpdateLimits limits;
+
+    /** @brief Devices not started yet, in starting order */
+    std::deque<Device> pending;
+
+    /** @brief MCTP network of the devices being updated */
+    std::map<mctp_eid_t, NetworkId> running;
+
+    /** @brief Number of devices being updated in each MCTP network */
+    std::map<NetworkId, size_t> networkRunning;
+
+    /** @brief Canary update state of each device class */
+    std::map<DeviceClassIndex, CanaryState> classStates;
+
+    /** @brief Device class of the canaries being updated */
+    std::map<mctp_eid_t, DeviceClassIndex> canaries;
+};
+
+} // namespace fw_update
+
+} // namespace pldm
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+
+namespace fw_update
+{
+
+/** @brief D-Bus interface publishing the telemetry of a firmware update */
+static constexpr auto updateStatisticsInterface =
+    "xyz.openbmc_project.PLDM.FirmwareUpdateStatistics";
+
+/** @brief Telemetry of a component: component identifier, microseconds in
+ *         UpdateComponent, transfer, verify and apply, bytes served,
+ *         RequestFirmwareData requests and retries
+ */
+using ComponentStatisticsEntry =
+    std::tuple<uint16_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t,
+               uint64_t, uint64_t>;
+
+/** @brief Telemetry of an FD: EID, microseconds in RequestUpdate,
+ *         PassComponentTable and ActivateFirmware, and the telemetry of the
+ *         components updated
+ */
+using UpdateStatisticsEntry =
+    std::tuple<uint8_t, uint64_t, uint64_t, uint64_t,
+               std::vector<ComponentStatisticsEntry>>;
+
+/** @class UpdateStatistics
+ *  @brief Read-only view of the firmware update telemetry on D-Bus
+ *  @details Implements the GetStatistics method returning
+ *  a(yttta(qttttttt)) on the software object of the package, one entry per
+ *  FD matching the package. The phases not reached yet take no time.
+ */
+class UpdateStatistics
+{
+  public:
+    using Collect = std::function<std::vector<UpdateStatisticsEntry>()>;
+
+    UpdateStatistics() = delete;
+    UpdateStatistics(const UpdateStatistics&) = delete;
+    UpdateStatistics& operator=(const UpdateStatistics&) = delete;
+    UpdateStatistics(UpdateStatistics&&) = delete;
+    UpdateStatistics& operator=(UpdateStatistics&&) = delete;
+    ~UpdateStatistics() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] collect - to collect the telemetry of the FDs
+     */
+    UpdateStatistics(sdbusplus::bus_t& bus, const std::string& path,
+                     Collect collect) :
+        collect(std::move(collect)),
+        interface(bus, path.c_str(), updateStatisticsInterface, vtable, this)
+    {}
+
+  private:
+    static int getStatisticsCallback(sd_bus_message* msg, void* context,
+                                     sd_bus_error* error)
+    {
+        try
+        {
+            auto self = static_cast<UpdateStatistics*>(context);
+            auto m = sdbusplus::message_t(msg);
+            auto reply = m.new_method_return();
+            reply.append(self->collect());
+            reply.method_return();
+        }
+        catch (const std::exception& e)
+        {
+            return sd_bus_error_set(error, SD_BUS_ERROR_FAILED, e.what());
+        }
+        return 1;
+    }
+
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method("GetStatistics", "", "a(yttta(qttttttt))",
+                                  getStatisticsCallback,
+                                  SD_BUS_VTABLE_UNPRIVILEGED),
+        sdbusplus::vtable::end()};
+
+    Collect collect;
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace fw_update
+
+} // namespace pldm
@@ -4,6 +4,8 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+
 PHOSPHOR_LOG2_USING;
 
 namespace pldm
@@ -18,20 +20,123 @@ namespace state_sensor
 {
 const std::vector<uint8_t> pdrTypes{PLDM_STATE_SENSOR_PDR};
 
+const PropertyValue* DbusPropertyCache::get(
+    const std::string& objPath, const std::string& interface,
+    const std::string& propertyName) const
+{
+    auto it = values.find({objPath, interface, propertyName});
+    return it != values.end() ? &it->second : nullptr;
+}
+
+void DbusPropertyCache::watch(const std::string& objPath,
+                              const std::string& interface)
+{
+    auto& propertiesMatch = propertiesMatches[{objPath, interface}];
+    if (!propertiesMatch)
+    {
+        propertiesMatch = std::make_unique<sdbusplus::bus::match_t>(
+            DBusHandler::getBus(),
+            propertiesChanged(objPath.c_str(), interface.c_str()),
+            [this, objPath, interface](auto& msg) {
+                DbusChangedProps props{};
+                std::string intf;
+                msg.read(intf, props);
+                for (auto& [name, value] : props)
+                {
+                    auto it = values.find({objPath, interface, name});
+                    if (it != values.end())
+                    {
+                        it->second = std::move(value);
+                    }
+                }
+            });
+    }
+
+    auto& removedMatch = removedMatches[objPath];
+    if (!removedMatch)
+    {
+        removedMatch = std::make_unique<sdbusplus::bus::match_t>(
+            DBusHandler::getBus(), interfacesRemoved() + argNpath(0, objPath),
+            [this, objPath](auto& msg) {
+                sdbusplus::message::object_path path;
+                std::vector<std::string> interfaces;
+                msg.read(path, interfaces);
+                std::erase_if(values, [&](const auto& entry) {
+                    const auto& [entryPath, entryInterface, name] =
+                        entry.first;
+                    return entryPath == objPath &&
+                           std::ranges::find(interfaces, entryInterface) !=
+                               interfaces.end();
+                });
+            });
+    }
+}
+
+void DbusPropertyCache::set(const std::string& objPath,
+                            const std::string& interface,
+                            const std::string& propertyName,
+                            PropertyValue value)
+{
+    values.insert_or_assign({objPath, interface, propertyName},
+                            std::move(value));
+}
+
+void DbusPropertyCache::erase(const std::string& objPath,
+                              const std::string& interface,
+                              const std::string& propertyName)
+{
+    values.erase({objPath, interface, propertyName});
+}
+
+PropertyValue CachedDBusHandler::getDbusPropertyVariant(
+    const char* objPath, const char* dbusProp, const char* dbusInterface) const
+{
+    if (!cache)
+    {
+        return DBusHandler::getDbusPropertyVariant(objPath, dbusProp,
+                                                   dbusInterface);
+    }
+
+    if (auto value = cache->get(objPath, dbusInterface, dbusProp))
+    {
+        return *value;
+    }
+
+    cache->watch(objPath, dbusInterface);
+    auto value =
+        DBusHandler::getDbusPropertyVariant(objPath, dbusProp, dbusInterface);
+    cache->set(objPath, dbusInterface, dbusProp, value);
+    return value;
+}
+
+void CachedDBusHandler::setDbusProperty(const DBusMapping& dBusMap,
+                                        const PropertyValue& value) const
+{
+    DBusHandler::setDbusProperty(dBusMap, value);
+    // The value set is converted to the D-Bus type, read it back on the next
+    // get rather than caching the unconverted value
+    if (cache)
+    {
+        cache->erase(dBusMap.objectPath, dBusMap.interface,
+                     dBusMap.propertyName);
+    }
+}
+
 DbusToPLDMEvent::DbusToPLDMEvent(
     int /* mctp_fd */, uint8_t mctp_eid, pldm::InstanceIdDb& instanceIdDb,
     pldm::requester::Handler<pldm::requester::Request>* handler) :
-    mctp_eid(mctp_eid), instanceIdDb(instanceIdDb), handler(handler)
+    mctp_eid(mctp_eid), instanceIdDb(instanceIdDb),
+    sensorEventTimer([this]() { sendPendingSensorEvents(); }), handler(handler)
 {}
 
 void DbusToPLDMEvent::sendEventMsg(uint8_t eventType,
                                    const std::vector<uint8_t>& eventDataVec)
 {
     auto instanceId = instanceIdDb.next(mctp_eid);
-    std::vector<uint8_t> requestMsg(
+    RequestMsg requestMsg(
         sizeof(pldm_msg_hdr) + PLDM_PLATFORM_EVENT_MESSAGE_MIN_REQ_BYTES +
         eventDataVec.size());
-    auto request = new (requestMsg.data()) pldm_msg;
+    auto request = requestMsg.msg();
 
     auto rc = encode_platform_event_message_req(
         instanceId, 1 /*formatVersion*/, TERMINUS_ID /*tId*/, eventType,
@@ -91,86 +196,139 @@ void DbusToPLDMEvent::sendStateSensorEvent(SensorId sensorId,
         return;
     }
 
-    size_t sensorEventSize = PLDM_SENSOR_EVENT_DATA_MIN_LENGTH + 1;
     const auto& [dbusMappings, dbusValMaps] = dbusMaps.at(sensorId);
     for (size_t offset = 0; offset < dbusMappings.size(); ++offset)
     {
-        std::vector<uint8_t> sensorEventDataVec{};
-        sensorEventDataVec.resize(sensorEventSize);
+        const auto& dbusMapping = dbusMappings[offset];
+        stateSensorDispatch[dbusMapping.objectPath].emplace_back(
+            sensorId, static_cast<uint8_t>(offset), dbusMapping,
+            dbusValMaps[offset]);
+    }
+}
+
+void DbusToPLDMEvent::createStateSensorMatches()
+{
+    /* Deepest path namespace holding all the objects of each interface */
+    std::map<std::string, std::string> pathNamespaces;
+    for (const auto& [objectPath, entries] : stateSensorDispatch)
+    {
+        for (const auto& entry : entries)
+        {
+            widenPathNamespace(pathNamespaces[entry.dbusMapping.interface],
+                               objectPath);
+        }
+    }
+
+    for (const auto& [iface, pathNamespace] : pathNamespaces)
+    {
+        stateSensorMatchs.emplace_back(
+            std::make_unique<sdbusplus::bus::match_t>(
+                DBusHandler::getBus(),
+                type::signal() + member("PropertiesChanged") +
+                    path_namespace(pathNamespace) + interface(dbusProperties) +
+                    argN(0, iface),
+                std::bind_front(&DbusToPLDMEvent::processPropertiesChanged,
+                                this)));
+    }
+}
+
+void DbusToPLDMEvent::processPropertiesChanged(sdbusplus::message_t& msg)
+{
+    auto it = stateSensorDispatch.find(msg.get_path());
+    if (it == stateSensorDispatch.end())
+    {
+        return;
+    }
+
+    DbusChangedProps props{};
+    std::string intf;
+    msg.read(intf, props);
+    for (const auto& entry : it->second)
+    {
+        const auto& dbusMapping = entry.dbusMapping;
+        if (dbusMapping.interface != intf)
+        {
+            continue;
+        }
+        auto prop = props.find(dbusMapping.propertyName);
+        if (prop == props.end())
+        {
+            continue;
+        }
+
+        for (const auto& [state, value] : entry.dbusValueMapping)
+        {
+            bool findValue = false;
+            if (dbusMapping.propertyType == "string")
+            {
+                const auto& dst = std::get<std::string>(prop->second);
+                auto values =
+                    pldm::utils::split(std::get<std::string>(value), "||", " ");
+                findValue = std::ranges::find(values, dst) != values.end();
+            }
+            else
+            {
+                findValue = value == prop->second;
+            }
+
+            if (findValue)
+            {
+                pendingSensorStates[{entry.sensorId, entry.offset}] = state;
+                break;
+            }
+        }
+    }
+
+    if (pendingSensorStates.empty() || sensorEventTimer.isRunning())
+    {
+        return;
+    }
+    if (sensorEventCoalesceInterval.count() == 0)
+    {
+        sendPendingSensorEvents();
+        return;
+    }
+    sensorEventTimer.start(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            sensorEventCoalesceInterval));
+}
+
+void DbusToPLDMEvent::sendPendingSensorEvents()
+{
+    auto pending = std::move(pendingSensorStates);
+    pendingSensorStates.clear();
+
+    // Encode PLDM platform event msg to indicate a state sensor change.
+    // DSP0248_1.2.0 Table 19
+    std::vector<uint8_t> sensorEventDataVec(
+        PLDM_SENSOR_EVENT_DATA_MIN_LENGTH + 1);
+    for (const auto& [sensor, state] : pending)
+    {
+        const auto& [sensorId, offset] = sensor;
+        uint8_t previousState = state;
+        auto cache = sensorCacheMap.find(sensorId);
+        if (cache != sensorCacheMap.end() && offset < cache->second.size() &&
+            cache->second[offset] != PLDM_SENSOR_UNKNOWN)
+        {
+            previousState = cache->second[offset];
+            if (previousState == state)
+            {
+                // The host already has this state
+                continue;
+            }
+        }
+
         auto eventData = new (sensorEventDataVec.data()) pldm_sensor_event_data;
         eventData->sensor_id = sensorId;
         eventData->sensor_event_class_type = PLDM_STATE_SENSOR_STATE;
-        eventData->event_class[0] = static_cast<uint8_t>(offset);
-        eventData->event_class[1] = PLDM_SENSOR_UNKNOWN;
-        eventData->event_class[2] = PLDM_SENSOR_UNKNOWN;
-
-        const auto& dbusMapping = dbusMappings[offset];
-        const auto& dbusValueMapping = dbusValMaps[offset];
-        auto stateSensorMatch = std::make_unique<sdbusplus::bus::match_t>(
-            pldm::utils::DBusHandler::getBus(),
-            propertiesChanged(dbusMapping.objectPath.c_str(),
-                              dbusMapping.interface.c_str()),
-            [this, sensorEventDataVec, dbusValueMapping, dbusMapping, sensorId,
-             offset](auto& msg) mutable {
-                DbusChangedProps props{};
-                std::string intf;
-                uint8_t previousState = PLDM_SENSOR_UNKNOWN;
-                msg.read(intf, props);
-                if (!props.contains(dbusMapping.propertyName))
-                {
-                    return;
-                }
-                for (const auto& itr : dbusValueMapping)
-                {
-                    bool findValue = false;
-                    if (dbusMapping.propertyType == "string")
-                    {
-                        std::string src = std::get<std::string>(itr.second);
-                        std::string dst = std::get<std::string>(
-                            props.at(dbusMapping.propertyName));
-
-                        auto values = pldm::utils::split(src, "||", " ");
-                        for (const auto& value : values)
-                        {
-                            if (value == dst)
-                            {
-                                findValue = true;
-                                break;
-                            }
-                        }
-                    }
-                    else
-                    {
-                        findValue =
-                            itr.second == props.at(dbusMapping.propertyName)
-                                ? true
-                                : false;
-                    }
-
-                    if (findValue)
-                    {
-                        auto eventData = new (sensorEventDataVec.data())
-                            pldm_sensor_event_data;
-                        eventData->event_class[1] = itr.first;
-                        if (sensorCacheMap.contains(sensorId) &&
-                            sensorCacheMap[sensorId][offset] !=
-                                PLDM_SENSOR_UNKNOWN)
-                        {
-                            previousState = sensorCacheMap[sensorId][offset];
-                        }
-                        else
-                        {
-                            previousState = itr.first;
-                        }
-                        eventData->event_class[2] = previousState;
-                        this->sendEventMsg(PLDM_SENSOR_EVENT,
-                                           sensorEventDataVec);
-                        updateSensorCacheMaps(sensorId, offset, previousState);
-                        break;
-                    }
-                }
-            });
-        stateSensorMatchs.emplace_back(std::move(stateSensorMatch));
+        eventData->event_class[0] = offset;
+        eventData->event_class[1] = state;
+        eventData->event_class[2] = previousState;
+        sendEventMsg(PLDM_SENSOR_EVENT, sensorEventDataVec);
+        if (offset < std::tuple_size_v<EventStates>)
+        {
+            updateSensorCacheMaps(sensorId, offset, state);
+        }
     }
 }
 
@@ -191,6 +349,8 @@ void DbusToPLDMEvent::listenSensorEvent(const pdr_utils::Repo& repo,
         throw std::runtime_error("Unable to instantiate sensor PDR repository");
     }
 
+    stateSensorMatchs.clear();
+    stateSensorDispatch.clear();
     for (auto pdrType : pdrTypes)
     {
         Repo sensorPDRs(sensorPdrRepo.get());
@@ -214,6 +374,7 @@ void DbusToPLDMEvent::listenSensorEvent(const pdr_utils::Repo& repo,
             pdrRecord = sensorPDRs.getNextRecord(pdrRecord, pdrEntry);
         }
     }
+    createStateSensorMatches();
 }
 
 } // namespace state_sensor
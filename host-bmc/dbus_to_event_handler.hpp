@@ -6,7 +6,13 @@
 
 #include <libpldm/platform.h>
 
+#include <sdbusplus/timer.hpp>
+
+#include <chrono>
 #include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
 
 namespace pldm
 {
@@ -22,9 +28,112 @@ using stateSensorCacheMaps =
 
 namespace state_sensor
 {
+/** @class DbusPropertyCache
+ *  @brief Values of the D-Bus properties backing the sensors and effecters,
+ *         kept up to date by the PropertiesChanged signals of their objects
+ */
+class DbusPropertyCache
+{
+  public:
+    /** @brief Get the cached value of a property
+     *  @param[in] objPath - D-Bus object path
+     *  @param[in] interface - D-Bus interface
+     *  @param[in] propertyName - D-Bus property name
+     *  @return the value, nullptr if the property is not cached
+     */
+    const pldm::utils::PropertyValue* get(
+        const std::string& objPath, const std::string& interface,
+        const std::string& propertyName) const;
+
+    /** @brief Start tracking the properties of an interface of an object
+     *
+     *  Called before reading a property of the interface from D-Bus, so a
+     *  change signalled after the read is not missed.
+     *
+     *  @param[in] objPath - D-Bus object path
+     *  @param[in] interface - D-Bus interface
+     */
+    void watch(const std::string& objPath, const std::string& interface);
+
+    /** @brief Cache the value of a watched property
+     *  @param[in] objPath - D-Bus object path
+     *  @param[in] interface - D-Bus interface
+     *  @param[in] propertyName - D-Bus property name
+     *  @param[in] value - the value read from D-Bus
+     */
+    void set(const std::string& objPath, const std::string& interface,
+             const std::string& propertyName, pldm::utils::PropertyValue value);
+
+    /** @brief Drop the cached value of a property
+     *  @param[in] objPath - D-Bus object path
+     *  @param[in] interface - D-Bus interface
+     *  @param[in] propertyName - D-Bus property name
+     */
+    void erase(const std::string& objPath, const std::string& interface,
+               const std::string& propertyName);
+
+  private:
+    using PropertyKey = std::tuple<std::string, std::string, std::string>;
+
+    /** @brief Cached values keyed by object path, interface and property */
+    std::map<PropertyKey, pldm::utils::PropertyValue> values;
+
+    /** @brief PropertiesChanged matches keyed by object path and interface */
+    std::map<std::pair<std::string, std::string>,
+             std::unique_ptr<sdbusplus::bus::match_t>>
+        propertiesMatches;
+
+    /** @brief InterfacesRemoved matches keyed by object path */
+    std::map<std::string, std::unique_ptr<sdbusplus::bus::match_t>>
+        removedMatches;
+};
+
+/** @class CachedDBusHandler
+ *  @brief DBusHandler reading the properties through a DbusPropertyCache,
+ *         only the first read of a property goes to D-Bus
+ */
+class CachedDBusHandler : public pldm::utils::DBusHandler
+{
+  public:
+    /** @brief Constructor
+     *  @param[in] cache - the property cache, nullptr to read from D-Bus
+     */
+    explicit CachedDBusHandler(DbusPropertyCache* cache) : cache(cache) {}
+
+    pldm::utils::PropertyValue getDbusPropertyVariant(
+        const char* objPath, const char* dbusProp,
+        const char* dbusInterface) const override;
+
+    void setDbusProperty(
+        const pldm::utils::DBusMapping& dBusMap,
+        const pldm::utils::PropertyValue& value) const override;
+
+  private:
+    DbusPropertyCache* cache;
+};
+
+/** @struct StateSensorMatchEntry
+ *  A state sensor offset backed by a property of a D-Bus object
+ */
+struct StateSensorMatchEntry
+{
+    /** @brief state sensor id */
+    SensorId sensorId;
+    /** @brief offset within the composite sensor */
+    uint8_t offset;
+    /** @brief D-Bus property backing the sensor offset */
+    pldm::utils::DBusMapping dbusMapping;
+    /** @brief D-Bus property values of the sensor states */
+    pldm::responder::pdr_utils::StatestoDbusVal dbusValueMapping;
+};
+
 /** @class DbusToPLDMEvent
  *  @brief This class can listen to the state sensor PDRs and send PLDM event
  *         msg when a D-Bus property changes
+ *
+ *  The state changes signalled within sensorEventCoalesceInterval of each
+ *  other are sent together, once per sensor offset with its latest state.
+ *  A change to the state last sent for the offset is not sent.
  */
 class DbusToPLDMEvent
 {
@@ -60,6 +169,14 @@ class DbusToPLDMEvent
         return sensorCacheMap;
     }
 
+    /** @brief get the cache of the D-Bus properties of the sensors and
+     *         effecters
+     */
+    inline DbusPropertyCache& getPropertyCache()
+    {
+        return propertyCache;
+    }
+
     /** @brief function to update the sensor cache
      *  @param[in] sensorId - sensor Id of the corresponding sensor
      *  @param[in] sensorRearm - sensor rearm value with in the sensor
@@ -73,11 +190,27 @@ class DbusToPLDMEvent
     }
 
   private:
-    /** @brief Send state sensor event msg when a D-Bus property changes
+    /** @brief Watch the D-Bus properties of a state sensor for changes
      *  @param[in] sensorId - sensor id
+     *  @param[in] dbusMaps - The map of D-Bus mapping and value
      */
     void sendStateSensorEvent(SensorId sensorId, const DbusObjMaps& dbusMaps);
 
+    /** @brief Create one PropertiesChanged match per D-Bus interface of the
+     *         watched sensor properties
+     */
+    void createStateSensorMatches();
+
+    /** @brief Queue the state changes of the sensors backed by an object
+     *  @param[in] msg - PropertiesChanged signal of the object
+     */
+    void processPropertiesChanged(sdbusplus::message_t& msg);
+
+    /** @brief Send the queued state changes which differ from the states
+     *         last sent
+     */
+    void sendPendingSensorEvents();
+
     /** @brief Send all of sensor event
      *  @param[in] eventType - PLDM Event types
      *  @param[in] eventDataVec - std::vector, contains send event data
@@ -93,14 +226,31 @@ class DbusToPLDMEvent
      */
     pldm::InstanceIdDb& instanceIdDb;
 
-    /** @brief D-Bus property changed signal match */
+    /** @brief D-Bus property changed signal matches, one per interface */
     std::vector<std::unique_ptr<sdbusplus::bus::match_t>> stateSensorMatchs;
 
+    /** @brief State sensor offsets backed by each D-Bus object path */
+    std::unordered_map<std::string, std::vector<StateSensorMatchEntry>>
+        stateSensorDispatch;
+
+    /** @brief Latest states not sent yet, keyed by sensor id and offset */
+    std::map<std::pair<SensorId, uint8_t>, uint8_t> pendingSensorStates;
+
+    /** @brief Time the state changes are gathered before being sent */
+    const std::chrono::milliseconds sensorEventCoalesceInterval{
+        SENSOR_EVENT_COALESCE_INTERVAL};
+
+    /** @brief Sends the pending state changes */
+    sdbusplus::Timer sensorEventTimer;
+
     /** @brief PLDM request handler */
     pldm::requester::Handler<pldm::requester::Request>* handler;
 
     /** @brief sensor cache */
     stateSensorCacheMaps sensorCacheMap;
+
+    /** @brief D-Bus property cache */
+    DbusPropertyCache propertyCache;
 };
 
 } // namespace state_sensor
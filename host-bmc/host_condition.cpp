@@ -20,5 +20,22 @@ Host::FirmwareCondition Host::currentFirmwareCondition() const
     return value;
 }
 
+void Host::setHostPdrObj(std::shared_ptr<HostPDRHandler> obj)
+{
+    hostPdrObj = obj;
+    if (hostPdrObj == nullptr)
+    {
+        return;
+    }
+    hostPdrObj->subscribeHostState([this](HostStateEvent event) {
+        if (event == HostStateEvent::firmwareUp ||
+            event == HostStateEvent::off)
+        {
+            // The stored value only drives the signal, reads are overridden
+            HostIntf::currentFirmwareCondition(currentFirmwareCondition());
+        }
+    });
+}
+
 } // namespace dbus_api
 } // namespace pldm
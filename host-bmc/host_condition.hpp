@@ -30,11 +30,11 @@ class Host : public HostIntf
     /** @brief Override reads to CurrentFirmwareCondition */
     FirmwareCondition currentFirmwareCondition() const override;
 
-    /** @brief Store shared pointer to host PDR instance */
-    void setHostPdrObj(std::shared_ptr<HostPDRHandler> obj)
-    {
-        hostPdrObj = obj;
-    }
+    /** @brief Store shared pointer to host PDR instance, and emit
+     *         PropertiesChanged for CurrentFirmwareCondition when the host
+     *         comes up or goes off
+     */
+    void setHostPdrObj(std::shared_ptr<HostPDRHandler> obj);
 
   private:
     std::shared_ptr<HostPDRHandler> hostPdrObj;
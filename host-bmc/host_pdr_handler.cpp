@@ -4,6 +4,8 @@
 #ifdef OEM_IBM
 #include <libpldm/oem/ibm/fru.h>
 #endif
+#include "common/daemon_stats.hpp"
+#include "common/flight_recorder.hpp"
 #include "dbus/custom_dbus.hpp"
 
 #include <nlohmann/json.hpp>
@@ -13,7 +15,9 @@
 #include <sdeventplus/source/io.hpp>
 #include <sdeventplus/source/time.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <fstream>
 #include <type_traits>
 
@@ -29,8 +33,15 @@ using namespace pldm::hostbmc::utils;
 using Json = nlohmann::json;
 namespace fs = std::filesystem;
 using namespace pldm::dbus;
+using pldm::flightrecorder::FlightRecorder;
+using pldm::flightrecorder::MarkKind;
 const Json emptyJson{};
 
+/** @brief Time the host inventory D-Bus objects are created for before the
+ *  event loop gets to serve other requests
+ */
+constexpr auto inventoryBatchTime = std::chrono::milliseconds(5);
+
 template <typename T>
 uint16_t extractTerminusHandle(std::vector<uint8_t>& pdr)
 {
@@ -51,14 +62,9 @@ uint16_t extractTerminusHandle(std::vector<uint8_t>& pdr)
 }
 
 template <typename T>
-void updateContainerId(pldm_entity_association_tree* entityTree,
-                       std::vector<uint8_t>& pdr)
+void updateContainerId(EntityNodeIndex& entityIndex, std::span<uint8_t> pdr)
 {
     T* t = nullptr;
-    if (entityTree == nullptr)
-    {
-        return;
-    }
     if (std::is_same<T, pldm_pdr_fru_record_set>::value)
     {
         t = (T*)(pdr.data() + sizeof(pldm_pdr_hdr));
@@ -73,8 +79,7 @@ void updateContainerId(pldm_entity_association_tree* entityTree,
     }
 
     pldm_entity entity{t->entity_type, t->entity_instance, t->container_id};
-    auto node = pldm_entity_association_tree_find_with_locality(
-        entityTree, &entity, true);
+    auto node = entityIndex.find(entity, true);
     if (node)
     {
         pldm_entity e = pldm_entity_extract(node);
@@ -88,18 +93,23 @@ HostPDRHandler::HostPDRHandler(
     pldm_entity_association_tree* entityTree,
     pldm_entity_association_tree* bmcEntityTree,
     pldm::InstanceIdDb& instanceIdDb,
-    pldm::requester::Handler<pldm::requester::Request>* handler) :
-    mctp_eid(mctp_eid), event(event), repo(repo),
+    pldm::requester::Handler<pldm::requester::Request>* handler,
+    uint8_t hostId) :
+    mctp_eid(mctp_eid), hostId(hostId), event(event), repo(repo),
     stateSensorHandler(eventsJsonsDir), entityTree(entityTree),
-    instanceIdDb(instanceIdDb), handler(handler),
+    bmcEntityTree(bmcEntityTree), instanceIdDb(instanceIdDb), handler(handler),
     entityMaps(parseEntityMap(ENTITY_MAP_JSON)), oemUtilsHandler(nullptr)
 {
+    // The PDRs of the first host keep the key they were cached with before
+    // the hosts were told apart
+    hostPdrCacheKey = hostId ? "host" + std::to_string(hostId) : "host";
     mergedHostParents = false;
     hostOffMatch = std::make_unique<sdbusplus::bus::match_t>(
         pldm::utils::DBusHandler::getBus(),
-        propertiesChanged("/xyz/openbmc_project/state/host0",
+        propertiesChanged("/xyz/openbmc_project/state/host" +
+                              std::to_string(hostId),
                           "xyz.openbmc_project.State.Host"),
-        [this, repo, entityTree, bmcEntityTree](sdbusplus::message_t& msg) {
+        [this](sdbusplus::message_t& msg) {
             DbusChangedProps props{};
             std::string intf;
             msg.read(intf, props);
@@ -108,26 +118,85 @@ HostPDRHandler::HostPDRHandler(
             {
                 PropertyValue value = itr->second;
                 auto propVal = std::get<std::string>(value);
-                if (propVal == "xyz.openbmc_project.State.Host.HostState.Off")
+                if (propVal ==
+                    "xyz.openbmc_project.State.Host.HostState.Running")
                 {
-                    // Delete all the remote terminus information
-                    std::erase_if(tlPDRInfo, [](const auto& item) {
-                        const auto& [key, value] = item;
-                        return key != TERMINUS_HANDLE;
-                    });
-                    // when the host is powered off, set the availability
-                    // state of all the dbus objects to false
-                    this->setPresenceFrus();
-                    pldm_pdr_remove_remote_pdrs(repo);
-                    pldm_entity_association_tree_destroy_root(entityTree);
-                    pldm_entity_association_tree_copy_root(bmcEntityTree,
-                                                           entityTree);
-                    this->sensorMap.clear();
-                    this->responseReceived = false;
-                    this->mergedHostParents = false;
+                    this->notifyHostState(HostStateEvent::running);
+                }
+                else if (
+                    propVal ==
+                    "xyz.openbmc_project.State.Host.HostState.TransitioningToOff")
+                {
+                    this->notifyHostState(HostStateEvent::transitioningToOff);
+                }
+                else if (propVal ==
+                         "xyz.openbmc_project.State.Host.HostState.Off")
+                {
+                    this->processHostOff();
                 }
             }
         });
+    if (hostId)
+    {
+        hostRepo.reset(pldm_pdr_init());
+        this->repo = hostRepo.get();
+    }
+    indexedRepo = pldm::responder::pdr_utils::Repo(this->repo);
+}
+
+void HostPDRHandler::processHostOff()
+{
+    // when the host is powered off, set the availability
+    // state of all the dbus objects to false
+    setPresenceFrus();
+    pldm_pdr_remove_remote_pdrs(repo);
+    pldm::responder::pdr_utils::Repo::invalidateIndex(repo);
+    // Delete all the remote terminus information
+    std::erase_if(tlPDRInfo, [](const auto& item) {
+        const auto& [key, value] = item;
+        return key != TERMINUS_HANDLE;
+    });
+    // The host forgets the BMC PDRs it fetched
+    pdrChangeLog.reset();
+    // The tree is BMC's copy while no host entity was merged
+    if (hostEntitiesMerged)
+    {
+        pldm_entity_association_tree_destroy_root(entityTree);
+        pldm_entity_association_tree_copy_root(bmcEntityTree, entityTree);
+        hostEntitiesMerged = false;
+    }
+    sensorMap.clear();
+    // Objects created later would be available again
+    deferredCreateDbusObjects.reset();
+    inventoryObjects.clear();
+    dbusObjectsCreated = false;
+    fruRecordTableReceived = false;
+    hostEntityAssociationPDRs.clear();
+    hostEntityAssociationHandles.clear();
+    hostContainedPDRs.clear();
+    responseReceived = false;
+    pdrExchangeComplete = false;
+    fruTableComplete = false;
+    mergedHostParents = false;
+    notifyHostState(HostStateEvent::off);
+    pldm::utils::releaseFreedMemory();
+}
+
+void HostPDRHandler::removeTerminusPDRs(pdr::TerminusID tid)
+{
+    for (auto it = tlPDRInfo.cbegin(); it != tlPDRInfo.cend();)
+    {
+        if (std::get<0>(it->second) == tid)
+        {
+            pldm_pdr_remove_pdrs_by_terminus_handle(repo, it->first);
+            pldm::responder::pdr_utils::Repo::invalidateIndex(repo);
+            it = tlPDRInfo.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
 }
 
 void HostPDRHandler::setPresenceFrus()
@@ -163,32 +232,179 @@ void HostPDRHandler::fetchPDR(PDRRecordHandles&& recordHandles)
 
 void HostPDRHandler::_fetchPDR(sdeventplus::source::EventBase& /*source*/)
 {
+    stats::DaemonStats::getInstance().setLoopActivity("HostPDRHandler fetch");
+    // A new PDR exchange supersedes the ongoing one
+    pdrExchange++;
+    FlightRecorder::GetInstance().saveMark(MarkKind::hostPdrExchange,
+                                           getHostTID(), 0,
+                                           std::chrono::nanoseconds(0));
+    pdrResponses.clear();
+    pdrResponseSeq = pdrRequestSeq;
+    fullHostPDRFetch = false;
+    fetchedHostPDRs.clear();
+    fruRecordTableRequested = false;
+    fruRecordTableReceived = false;
+    pdrExchangeComplete = false;
+
+    // The other hosts merge their entities into their own copy of the BMC
+    // entity tree, taken once the BMC entities are known
+    if (hostId && !hostEntitiesMerged)
+    {
+        pldm_entity_association_tree_destroy_root(entityTree);
+        pldm_entity_association_tree_copy_root(bmcEntityTree, entityTree);
+    }
+
+    if (isHostPdrModified || !pdrRecordHandles.empty())
+    {
+        // The cached repository no longer matches the one of the host
+        hostPdrCache.remove(hostPdrCacheKey);
+    }
+    else if (hostPdrCache.enabled())
+    {
+        // The whole repository is fetched, it may be cached already
+        getHostPDRRepositoryInfo();
+        return;
+    }
+
     getHostPDR();
 }
 
+void HostPDRHandler::getHostPDRRepositoryInfo()
+{
+    PldmMsg<0> requestMsg;
+    auto request = requestMsg.msg();
+    auto instanceId = instanceIdDb.next(mctp_eid);
+    auto rc = encode_pldm_header_only(PLDM_REQUEST, instanceId, PLDM_PLATFORM,
+                                      PLDM_GET_PDR_REPOSITORY_INFO, request);
+    if (rc != PLDM_SUCCESS)
+    {
+        instanceIdDb.free(mctp_eid, instanceId);
+        error(
+            "Failed to encode GetPDRRepositoryInfo request, response code '{RC}'",
+            "RC", rc);
+        getHostPDR();
+        return;
+    }
+
+    auto repositoryInfoHandler = [this, exchange = pdrExchange](
+                                     mctp_eid_t /*eid*/,
+                                     const pldm_msg* response,
+                                     size_t respMsgLen) {
+        if (exchange != pdrExchange)
+        {
+            return;
+        }
+
+        uint8_t completionCode{};
+        uint8_t repositoryState{};
+        uint8_t dataTransferHandleTimeout{};
+        pdr::PdrRepositorySignature signature{};
+        auto rc =
+            response && respMsgLen
+                ? decode_get_pdr_repository_info_resp(
+                      response, respMsgLen, &completionCode, &repositoryState,
+                      signature.updateTime.data(),
+                      signature.oemUpdateTime.data(), &signature.recordCount,
+                      &signature.repositorySize, &signature.largestRecordSize,
+                      &dataTransferHandleTimeout)
+                : PLDM_ERROR;
+        // Without an update time a changed repository of the same size can't
+        // be told apart from the cached one
+        if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS ||
+            repositoryState != PLDM_AVAILABLE ||
+            std::ranges::none_of(signature.updateTime,
+                                 [](uint8_t byte) { return byte != 0; }))
+        {
+            info(
+                "Fetching the host PDRs without cache, response code '{RC}' and completion code '{CC}'",
+                "RC", rc, "CC", completionCode);
+            getHostPDR();
+            return;
+        }
+
+        auto cachedPdrs = hostPdrCache.load(hostPdrCacheKey, signature);
+        if (cachedPdrs)
+        {
+            info("Loaded '{COUNT}' cached host PDRs", "COUNT",
+                 cachedPdrs->size());
+            addCachedHostPDRs(*cachedPdrs);
+            return;
+        }
+
+        hostPdrSignature = signature;
+        fullHostPDRFetch = true;
+        getHostPDR();
+    };
+
+    rc = handler->registerRequest(mctp_eid, instanceId, PLDM_PLATFORM,
+                                  PLDM_GET_PDR_REPOSITORY_INFO,
+                                  std::move(requestMsg),
+                                  std::move(repositoryInfoHandler));
+    if (rc)
+    {
+        error(
+            "Failed to send the GetPDRRepositoryInfo request to remote terminus, response code '{RC}'",
+            "RC", rc);
+        getHostPDR();
+    }
+}
+
+void HostPDRHandler::addCachedHostPDRs(const pdr::PdrArena& pdrs)
+{
+    auto recordHandle = [](std::span<const uint8_t> pdr) {
+        return reinterpret_cast<const pldm_pdr_hdr*>(pdr.data())
+            ->record_handle;
+    };
+
+    for (size_t i = 0; i < pdrs.size(); i++)
+    {
+        // The repository of the host is unchanged, add its PDRs the way they
+        // were added when they were fetched
+        pdrBuffer.assign(pdrs[i].begin(), pdrs[i].end());
+        auto nextRecordHandle =
+            i + 1 < pdrs.size() ? recordHandle(pdrs[i + 1]) : 0;
+        if (!addHostPDR(pdrBuffer, recordHandle(pdrs[i]), nextRecordHandle))
+        {
+            return;
+        }
+    }
+}
+
 void HostPDRHandler::getHostPDR(uint32_t nextRecordHandle)
 {
     pdrFetchEvent.reset();
 
-    std::vector<uint8_t> requestMsg(
-        sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES);
-    auto request = new (requestMsg.data()) pldm_msg;
-    uint32_t recordHandle{};
-    if (!nextRecordHandle && (!modifiedPDRRecordHandles.empty()) &&
-        isHostPdrModified)
+    if (nextRecordHandle || !requestKnownHostPDRs())
     {
-        recordHandle = modifiedPDRRecordHandles.front();
-        modifiedPDRRecordHandles.pop_front();
+        requestHostPDR(nextRecordHandle);
     }
-    else if (!nextRecordHandle && (!pdrRecordHandles.empty()))
+}
+
+bool HostPDRHandler::requestKnownHostPDRs()
+{
+    auto& recordHandles =
+        isHostPdrModified ? modifiedPDRRecordHandles : pdrRecordHandles;
+    if (recordHandles.empty())
     {
-        recordHandle = pdrRecordHandles.front();
-        pdrRecordHandles.pop_front();
+        return false;
     }
-    else
+
+    while (!recordHandles.empty() &&
+           pdrRequestSeq - pdrResponseSeq < REQUEST_WINDOW_SIZE)
     {
-        recordHandle = nextRecordHandle;
+        if (!requestHostPDR(recordHandles.front()))
+        {
+            break;
+        }
+        recordHandles.pop_front();
     }
+    return true;
+}
+
+bool HostPDRHandler::requestHostPDR(uint32_t recordHandle)
+{
+    PldmMsg<PLDM_GET_PDR_REQ_BYTES> requestMsg;
+    auto request = requestMsg.msg();
     auto instanceId = instanceIdDb.next(mctp_eid);
 
     auto rc =
@@ -199,19 +415,92 @@ void HostPDRHandler::getHostPDR(uint32_t nextRecordHandle)
         instanceIdDb.free(mctp_eid, instanceId);
         error("Failed to encode get pdr request, response code '{RC}'", "RC",
               rc);
-        return;
+        return false;
     }
 
     rc = handler->registerRequest(
         mctp_eid, instanceId, PLDM_PLATFORM, PLDM_GET_PDR,
         std::move(requestMsg),
-        std::bind_front(&HostPDRHandler::processHostPDRs, this));
+        std::bind_front(&HostPDRHandler::handleHostPDRResponse, this,
+                        pdrRequestSeq));
     if (rc)
     {
         error(
             "Failed to send the getPDR request to remote terminus, response code '{RC}'",
             "RC", rc);
+        return false;
+    }
+    pdrRequestSeq++;
+    return true;
+}
+
+void HostPDRHandler::handleHostPDRResponse(
+    uint32_t seq, mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen)
+{
+    if (seq < pdrResponseSeq)
+    {
+        // The PDR exchange of the request is over
+        return;
+    }
+    if (seq > pdrResponseSeq)
+    {
+        // Add the PDRs to the repo in the order they were requested, the
+        // entity association PDRs come before the PDRs they contain
+        auto& msg = pdrResponses[seq];
+        if (response)
+        {
+            auto data = reinterpret_cast<const uint8_t*>(response);
+            msg.assign(data, data + sizeof(pldm_msg_hdr) + respMsgLen);
+        }
+        return;
     }
+
+    auto nextRecordHandle = processHostPDRs(eid, response, respMsgLen);
+    pdrResponseSeq++;
+    while (nextRecordHandle && pdrResponseSeq < pdrRequestSeq)
+    {
+        auto it = pdrResponses.find(pdrResponseSeq);
+        if (it == pdrResponses.end())
+        {
+            break;
+        }
+        auto msg = std::move(it->second);
+        pdrResponses.erase(it);
+        nextRecordHandle =
+            msg.empty() ? processHostPDRs(eid, nullptr, 0)
+                        : processHostPDRs(
+                              eid, new (msg.data()) pldm_msg,
+                              msg.size() - sizeof(pldm_msg_hdr));
+        pdrResponseSeq++;
+    }
+
+    if (!nextRecordHandle)
+    {
+        // Nothing is left to merge unless the PDR exchange was interrupted
+        mergeHostEntityAssociations();
+        pdrResponses.clear();
+        pdrResponseSeq = pdrRequestSeq;
+        return;
+    }
+
+    // Keep the window full while record handles are left to fetch, and
+    // follow the chain of the host once all the responses are processed
+    if (requestKnownHostPDRs() || pdrResponseSeq < pdrRequestSeq)
+    {
+        return;
+    }
+
+    if (isHostPdrModified)
+    {
+        // All the modified PDRs were fetched
+        isHostPdrModified = false;
+        mergeHostEntityAssociations();
+        return;
+    }
+
+    // Ask for the next PDR right away rather than from the event loop, the
+    // requester sends it once this response is released
+    requestHostPDR(*nextRecordHandle);
 }
 
 int HostPDRHandler::handleStateSensorEvent(const StateSensorEntry& entry,
@@ -228,7 +517,8 @@ int HostPDRHandler::handleStateSensorEvent(const StateSensorEntry& entry,
 }
 
 void HostPDRHandler::mergeEntityAssociations(
-    const std::vector<uint8_t>& pdr, [[maybe_unused]] const uint32_t& size,
+    EntityNodeIndex& entityIndex, const std::vector<uint8_t>& pdr,
+    [[maybe_unused]] const uint32_t& size,
     [[maybe_unused]] const uint32_t& record_handle)
 {
     size_t numEntities{};
@@ -252,13 +542,11 @@ void HostPDRHandler::mergeEntityAssociations(
         pldm_entity_node* pNode = nullptr;
         if (!mergedHostParents)
         {
-            pNode = pldm_entity_association_tree_find_with_locality(
-                entityTree, &entities[0], false);
+            pNode = entityIndex.find(entities[0], false);
         }
         else
         {
-            pNode = pldm_entity_association_tree_find_with_locality(
-                entityTree, &entities[0], true);
+            pNode = entityIndex.find(entities[0], true);
         }
         if (!pNode)
         {
@@ -275,15 +563,16 @@ void HostPDRHandler::mergeEntityAssociations(
                 isUpdateContainerId =
                     checkIfLogicalBitSet(entities[i].entity_container_id);
             }
-            auto node = pldm_entity_association_tree_add_entity(
-                entityTree, &entities[i], entities[i].entity_instance_num,
-                pNode, entityPdr->association_type, true, isUpdateContainerId,
+            auto node = entityIndex.add(
+                entities[i], entities[i].entity_instance_num, pNode,
+                entityPdr->association_type, true, isUpdateContainerId,
                 0xFFFF);
             if (!node)
             {
                 continue;
             }
             merged = true;
+            hostEntitiesMerged = true;
             entityAssoc.push_back(node);
         }
 
@@ -335,50 +624,129 @@ void HostPDRHandler::mergeEntityAssociations(
     free(entities);
 }
 
-void HostPDRHandler::sendPDRRepositoryChgEvent(std::vector<uint8_t>&& pdrTypes,
-                                               uint8_t eventDataFormat)
+void HostPDRHandler::mergeHostEntityAssociations()
 {
-    assert(eventDataFormat == FORMAT_IS_PDR_HANDLES);
+    if (hostEntityAssociationPDRs.empty() && hostContainedPDRs.empty())
+    {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    EntityNodeIndex entityIndex(entityTree);
 
-    // Extract from the PDR repo record handles of PDRs we want the host
-    // to pull up.
-    std::vector<uint8_t> eventDataOps{PLDM_RECORDS_ADDED};
-    std::vector<uint8_t> numsOfChangeEntries(1);
-    std::vector<std::vector<ChangeEntry>> changeEntries(
-        numsOfChangeEntries.size());
-    for (auto pdrType : pdrTypes)
+    std::vector<uint8_t> pdr;
+    for (size_t i = 0; i < hostEntityAssociationPDRs.size(); i++)
     {
-        const pldm_pdr_record* record{};
-        do
+        auto associationPDR = hostEntityAssociationPDRs[i];
+        pdr.assign(associationPDR.begin(), associationPDR.end());
+        mergeEntityAssociations(entityIndex, pdr, pdr.size(),
+                                hostEntityAssociationHandles[i]);
+    }
+    hostEntityAssociationPDRs.clear();
+    hostEntityAssociationHandles.clear();
+
+    for (const auto& [recordHandle, type] : hostContainedPDRs)
+    {
+        pldm::responder::pdr_utils::PdrEntry entry{};
+        if (!indexedRepo.findRecord(recordHandle, entry))
         {
-            record = pldm_pdr_find_record_by_type(repo, pdrType, record,
-                                                  nullptr, nullptr);
-            if (record && pldm_pdr_record_is_remote(record))
-            {
-                changeEntries[0].push_back(
-                    pldm_pdr_get_record_handle(repo, record));
-            }
-        } while (record);
+            continue;
+        }
+
+        // The PDR is updated where the repo holds it
+        auto size = entry.size;
+        std::span<uint8_t> record(entry.data, size);
+        if (type == PLDM_STATE_SENSOR_PDR &&
+            size >= sizeof(pldm_state_sensor_pdr))
+        {
+            updateContainerId<pldm_state_sensor_pdr>(entityIndex, record);
+        }
+        else if (type == PLDM_PDR_FRU_RECORD_SET &&
+                 size >= sizeof(pldm_pdr_hdr) + sizeof(pldm_pdr_fru_record_set))
+        {
+            updateContainerId<pldm_pdr_fru_record_set>(entityIndex, record);
+        }
+        else if (type == PLDM_STATE_EFFECTER_PDR &&
+                 size >= sizeof(pldm_state_effecter_pdr))
+        {
+            updateContainerId<pldm_state_effecter_pdr>(entityIndex, record);
+        }
+        else if (type == PLDM_NUMERIC_EFFECTER_PDR &&
+                 size >= sizeof(pldm_numeric_effecter_value_pdr))
+        {
+            updateContainerId<pldm_numeric_effecter_value_pdr>(entityIndex,
+                                                               record);
+        }
     }
-    if (changeEntries.empty())
+
+    // The lookups of the repo keep copies of the PDRs updated in place
+    pldm::responder::pdr_utils::Repo::invalidateIndex(repo);
+    hostContainedPDRs.clear();
+
+    FlightRecorder::GetInstance().saveMark(
+        MarkKind::hostPdrMerge, getHostTID(), 0,
+        std::chrono::steady_clock::now() - start);
+}
+
+void HostPDRHandler::sendPDRRepositoryChgEvent(
+    std::vector<uint8_t>&& pdrTypes, [[maybe_unused]] uint8_t eventDataFormat)
+{
+    assert(eventDataFormat == FORMAT_IS_PDR_HANDLES);
+
+    // Only report the records added, deleted or modified since the last
+    // event the host acknowledged, so the host pulls up the touched PDRs
+    // only.
+    auto changes = pdrChangeLog.diff(repo, pdrTypes, PdrOrigin::remote);
+    if (changes.empty())
     {
         return;
     }
-    numsOfChangeEntries[0] = changeEntries[0].size();
+    sendPDRChanges(std::move(changes), true);
+}
+
+void HostPDRHandler::sendPDRRepositoryChgEvent(PdrChanges&& changes)
+{
+    // The host fetches all the PDRs once it is up
+    if (changes.empty() || !isHostUp())
+    {
+        return;
+    }
+    sendPDRChanges(std::move(changes), false);
+}
+
+void HostPDRHandler::sendPDRChanges(PdrChanges&& changes, bool logged)
+{
+    std::vector<uint8_t> eventDataOps;
+    std::vector<uint8_t> numsOfChangeEntries;
+    std::vector<const uint32_t*> changeEntries;
+    size_t maxSize = PLDM_PDR_REPOSITORY_CHG_EVENT_MIN_LENGTH;
+    for (const auto& [operation, handles] :
+         {std::pair{PLDM_RECORDS_DELETED, &changes.deleted},
+          std::pair{PLDM_RECORDS_ADDED, &changes.added},
+          std::pair{PLDM_RECORDS_MODIFIED, &changes.modified}})
+    {
+        // The number of change entries of a change record is 8 bits wide
+        for (size_t offset = 0; offset < handles->size(); offset += UINT8_MAX)
+        {
+            auto count = std::min<size_t>(UINT8_MAX, handles->size() - offset);
+            eventDataOps.push_back(operation);
+            numsOfChangeEntries.push_back(count);
+            changeEntries.push_back(handles->data() + offset);
+            maxSize += PLDM_PDR_REPOSITORY_CHANGE_RECORD_MIN_LENGTH +
+                       count * sizeof(uint32_t);
+        }
+    }
 
     // Encode PLDM platform event msg to indicate a PDR repo change.
-    size_t maxSize = PLDM_PDR_REPOSITORY_CHG_EVENT_MIN_LENGTH +
-                     PLDM_PDR_REPOSITORY_CHANGE_RECORD_MIN_LENGTH +
-                     changeEntries[0].size() * sizeof(uint32_t);
     std::vector<uint8_t> eventDataVec{};
     eventDataVec.resize(maxSize);
     auto eventData = new (eventDataVec.data())
         pldm_pdr_repository_chg_event_data;
     size_t actualSize{};
-    auto firstEntry = changeEntries[0].data();
     auto rc = encode_pldm_pdr_repository_chg_event_data(
-        eventDataFormat, 1, eventDataOps.data(), numsOfChangeEntries.data(),
-        &firstEntry, eventData, &actualSize, maxSize);
+        FORMAT_IS_PDR_HANDLES, eventDataOps.size(), eventDataOps.data(),
+        numsOfChangeEntries.data(), changeEntries.data(), eventData,
+        &actualSize, maxSize);
     if (rc != PLDM_SUCCESS)
     {
         error(
@@ -386,11 +754,15 @@ void HostPDRHandler::sendPDRRepositoryChgEvent(std::vector<uint8_t>&& pdrTypes,
             "RC", rc);
         return;
     }
+    info(
+        "Sending PDR repository change event: {ADDED} added, {DELETED} deleted and {MODIFIED} modified records",
+        "ADDED", changes.added.size(), "DELETED", changes.deleted.size(),
+        "MODIFIED", changes.modified.size());
     auto instanceId = instanceIdDb.next(mctp_eid);
-    std::vector<uint8_t> requestMsg(
+    RequestMsg requestMsg(
         sizeof(pldm_msg_hdr) + PLDM_PLATFORM_EVENT_MESSAGE_MIN_REQ_BYTES +
         actualSize);
-    auto request = new (requestMsg.data()) pldm_msg;
+    auto request = requestMsg.msg();
     rc = encode_platform_event_message_req(
         instanceId, 1, TERMINUS_ID, PLDM_PDR_REPOSITORY_CHG_EVENT,
         eventDataVec.data(), actualSize, request,
@@ -404,28 +776,37 @@ void HostPDRHandler::sendPDRRepositoryChgEvent(std::vector<uint8_t>&& pdrTypes,
         return;
     }
 
-    auto platformEventMessageResponseHandler = [](mctp_eid_t /*eid*/,
-                                                  const pldm_msg* response,
-                                                  size_t respMsgLen) {
-        if (response == nullptr || !respMsgLen)
-        {
-            error(
-                "Failed to receive response for the PDR repository changed event");
-            return;
-        }
+    // The changes are recorded once the host acknowledged them, a lost
+    // event is reported again with the next one
+    auto platformEventMessageResponseHandler =
+        [this, changes = std::move(changes), logged](mctp_eid_t /*eid*/,
+                                                     const pldm_msg* response,
+                                                     size_t respMsgLen) {
+            if (response == nullptr || !respMsgLen)
+            {
+                error(
+                    "Failed to receive response for the PDR repository changed event");
+                return;
+            }
 
-        uint8_t completionCode{};
-        uint8_t status{};
-        auto responsePtr = reinterpret_cast<const struct pldm_msg*>(response);
-        auto rc = decode_platform_event_message_resp(responsePtr, respMsgLen,
-                                                     &completionCode, &status);
-        if (rc || completionCode)
-        {
-            error(
-                "Failed to decode platform event message response, response code '{RC}' and completion code '{CC}'",
-                "RC", rc, "CC", completionCode);
-        }
-    };
+            uint8_t completionCode{};
+            uint8_t status{};
+            auto responsePtr =
+                reinterpret_cast<const struct pldm_msg*>(response);
+            auto rc = decode_platform_event_message_resp(
+                responsePtr, respMsgLen, &completionCode, &status);
+            if (rc || completionCode)
+            {
+                error(
+                    "Failed to decode platform event message response, response code '{RC}' and completion code '{CC}'",
+                    "RC", rc, "CC", completionCode);
+                return;
+            }
+            if (logged)
+            {
+                pdrChangeLog.commit(changes);
+            }
+        };
 
     rc = handler->registerRequest(
         mctp_eid, instanceId, PLDM_PLATFORM, PLDM_PLATFORM_EVENT_MESSAGE,
@@ -438,10 +819,27 @@ void HostPDRHandler::sendPDRRepositoryChgEvent(std::vector<uint8_t>&& pdrTypes,
     }
 }
 
-void HostPDRHandler::parseStateSensorPDRs(const PDRList& stateSensorPDRs)
+std::span<const uint8_t> HostPDRHandler::getRepoRecord(
+    uint32_t recordHandle) const
 {
-    for (const auto& pdr : stateSensorPDRs)
+    pldm::responder::pdr_utils::PdrEntry entry{};
+    if (!indexedRepo.findRecord(recordHandle, entry))
     {
+        return {};
+    }
+    return {entry.data, entry.size};
+}
+
+void HostPDRHandler::parseStateSensorPDRs(
+    const PDRRecordHandles& stateSensorPDRs)
+{
+    for (const auto& recordHandle : stateSensorPDRs)
+    {
+        auto pdr = getRepoRecord(recordHandle);
+        if (pdr.size() < sizeof(pldm_state_sensor_pdr))
+        {
+            continue;
+        }
         SensorEntry sensorEntry{};
         const auto& [terminusHandle, sensorID, sensorInfo] =
             responder::pdr_utils::parseStateSensorPDR(pdr);
@@ -460,19 +858,12 @@ void HostPDRHandler::parseStateSensorPDRs(const PDRList& stateSensorPDRs)
     }
 }
 
-void HostPDRHandler::processHostPDRs(
+std::optional<uint32_t> HostPDRHandler::processHostPDRs(
     mctp_eid_t /*eid*/, const pldm_msg* response, size_t respMsgLen)
 {
-    static bool merged = false;
-    static PDRList stateSensorPDRs{};
-    static PDRList fruRecordSetPDRs{};
+    auto start = std::chrono::steady_clock::now();
     uint32_t nextRecordHandle{};
-    uint8_t tlEid = 0;
-    bool tlValid = true;
     uint32_t rh = 0;
-    uint16_t terminusHandle = 0;
-    uint16_t pdrTerminusHandle = 0;
-    uint8_t tid = 0;
 
     uint8_t completionCode{};
     uint32_t nextDataTransferHandle{};
@@ -484,160 +875,196 @@ void HostPDRHandler::processHostPDRs(
         error("Failed to receive response for the GetPDR command");
         pldm::utils::reportError(
             "xyz.openbmc_project.PLDM.Error.GetPDR.PDRExchangeFailure");
-        return;
+        return std::nullopt;
     }
 
-    auto rc = decode_get_pdr_resp(
-        response, respMsgLen /*- sizeof(pldm_msg_hdr)*/, &completionCode,
-        &nextRecordHandle, &nextDataTransferHandle, &transferFlag, &respCount,
-        nullptr, 0, &transferCRC);
-    std::vector<uint8_t> responsePDRMsg;
-    responsePDRMsg.resize(respMsgLen + sizeof(pldm_msg_hdr));
-    memcpy(responsePDRMsg.data(), response, respMsgLen + sizeof(pldm_msg_hdr));
-    if (rc != PLDM_SUCCESS)
+    // Decode the PDR once, into a buffer which keeps its capacity across the
+    // responses of the PDR exchange. The PDR data can't be larger than the
+    // response payload past the fixed fields.
+    pdrBuffer.resize(respMsgLen > PLDM_GET_PDR_MIN_RESP_BYTES
+                         ? respMsgLen - PLDM_GET_PDR_MIN_RESP_BYTES
+                         : 0);
+    auto rc = decode_get_pdr_resp(response, respMsgLen, &completionCode,
+                                  &nextRecordHandle, &nextDataTransferHandle,
+                                  &transferFlag, &respCount, pdrBuffer.data(),
+                                  pdrBuffer.size(), &transferCRC);
+    if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
     {
         error(
-            "Failed to decode getPDR response for next record handle '{NEXT_RECORD_HANDLE}', response code '{RC}'",
-            "NEXT_RECORD_HANDLE", nextRecordHandle, "RC", rc);
-        return;
+            "Failed to decode getPDR response for next record handle '{NEXT_RECORD_HANDLE}', next data transfer handle '{DATA_TRANSFER_HANDLE}' and transfer flag '{FLAG}', response code '{RC}' and completion code '{CC}'",
+            "NEXT_RECORD_HANDLE", nextRecordHandle, "DATA_TRANSFER_HANDLE",
+            nextDataTransferHandle, "FLAG", transferFlag, "RC", rc, "CC",
+            completionCode);
+        return std::nullopt;
+    }
+    if (respCount < sizeof(pldm_pdr_hdr))
+    {
+        error(
+            "Failed to decode getPDR response for next record handle '{NEXT_RECORD_HANDLE}', invalid PDR size '{SIZE}'",
+            "NEXT_RECORD_HANDLE", nextRecordHandle, "SIZE", respCount);
+        return std::nullopt;
+    }
+    pdrBuffer.resize(respCount);
+    if (fullHostPDRFetch)
+    {
+        // Cache the PDR as the host sent it, before it is merged
+        fetchedHostPDRs.emplace_back(pdrBuffer);
+    }
+
+    // when nextRecordHandle is 0, we need the recordHandle of the last
+    // PDR and not 0-1.
+    if (!nextRecordHandle)
+    {
+        rh = nextRecordHandle;
+    }
+    else
+    {
+        rh = nextRecordHandle - 1;
+    }
+
+    auto recordHandle =
+        reinterpret_cast<const pldm_pdr_hdr*>(pdrBuffer.data())->record_handle;
+    auto next = addHostPDR(pdrBuffer, rh, nextRecordHandle);
+    FlightRecorder::GetInstance().saveMark(
+        MarkKind::hostPdrProcessed, getHostTID(), recordHandle,
+        std::chrono::steady_clock::now() - start);
+    return next;
+}
+
+std::optional<uint32_t> HostPDRHandler::addHostPDR(
+    std::vector<uint8_t>& pdr, uint32_t rh, uint32_t nextRecordHandle)
+{
+    uint8_t tlEid = 0;
+    bool tlValid = true;
+    uint16_t terminusHandle = 0;
+    uint16_t pdrTerminusHandle = 0;
+    uint8_t tid = 0;
+
+    auto pdrHdr = new (pdr.data()) pldm_pdr_hdr;
+    if (!rh)
+    {
+        rh = pdrHdr->record_handle;
+    }
+
+    if (pdrHdr->type == PLDM_PDR_ENTITY_ASSOCIATION)
+    {
+        // Merged in one pass once the PDRs are fetched
+        hostEntityAssociationPDRs.emplace_back(pdr);
+        hostEntityAssociationHandles.emplace_back(rh);
+        entityAssociationsMerged = true;
     }
     else
     {
-        std::vector<uint8_t> pdr(respCount, 0);
-        rc = decode_get_pdr_resp(response, respMsgLen, &completionCode,
-                                 &nextRecordHandle, &nextDataTransferHandle,
-                                 &transferFlag, &respCount, pdr.data(),
-                                 respCount, &transferCRC);
-        if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
+        if (pdrHdr->type == PLDM_TERMINUS_LOCATOR_PDR)
         {
-            error(
-                "Failed to decode getPDR response for next record handle '{NEXT_RECORD_HANDLE}', next data transfer handle '{DATA_TRANSFER_HANDLE}' and transfer flag '{FLAG}', response code '{RC}' and completion code '{CC}'",
-                "NEXT_RECORD_HANDLE", nextRecordHandle, "DATA_TRANSFER_HANDLE",
-                nextDataTransferHandle, "FLAG", transferFlag, "RC", rc, "CC",
-                completionCode);
-            return;
+            pdrTerminusHandle =
+                extractTerminusHandle<pldm_terminus_locator_pdr>(pdr);
+            auto tlpdr =
+                reinterpret_cast<const pldm_terminus_locator_pdr*>(pdr.data());
+
+            terminusHandle = tlpdr->terminus_handle;
+            tid = tlpdr->tid;
+            auto terminus_locator_type = tlpdr->terminus_locator_type;
+            if (terminus_locator_type == PLDM_TERMINUS_LOCATOR_TYPE_MCTP_EID)
+            {
+                auto locatorValue = reinterpret_cast<
+                    const pldm_terminus_locator_type_mctp_eid*>(
+                    tlpdr->terminus_locator_value);
+                tlEid = static_cast<uint8_t>(locatorValue->eid);
+            }
+            if (tlpdr->validity == 0)
+            {
+                tlValid = false;
+            }
+            for (const auto& terminusMap : tlPDRInfo)
+            {
+                if ((terminusHandle == (terminusMap.first)) &&
+                    (get<1>(terminusMap.second) == tlEid) &&
+                    (get<2>(terminusMap.second) == tlpdr->validity))
+                {
+                    // TL PDR already present with same validity don't
+                    // add the PDR to the repo just return
+                    return std::nullopt;
+                }
+            }
+            tlPDRInfo.insert_or_assign(
+                tlpdr->terminus_handle,
+                std::make_tuple(tlpdr->tid, tlEid, tlpdr->validity));
         }
-        else
+        else if (pdrHdr->type == PLDM_STATE_SENSOR_PDR)
         {
-            // when nextRecordHandle is 0, we need the recordHandle of the last
-            // PDR and not 0-1.
-            if (!nextRecordHandle)
+            pdrTerminusHandle =
+                extractTerminusHandle<pldm_state_sensor_pdr>(pdr);
+        }
+        else if (pdrHdr->type == PLDM_PDR_FRU_RECORD_SET)
+        {
+            pdrTerminusHandle =
+                extractTerminusHandle<pldm_pdr_fru_record_set>(pdr);
+        }
+        else if (pdrHdr->type == PLDM_STATE_EFFECTER_PDR)
+        {
+            pdrTerminusHandle =
+                extractTerminusHandle<pldm_state_effecter_pdr>(pdr);
+        }
+        else if (pdrHdr->type == PLDM_NUMERIC_EFFECTER_PDR)
+        {
+            pdrTerminusHandle =
+                extractTerminusHandle<pldm_numeric_effecter_value_pdr>(pdr);
+        }
+        // if the TLPDR is invalid update the repo accordingly
+        if (!tlValid)
+        {
+            pldm_pdr_update_TL_pdr(repo, terminusHandle, tid, tlEid, tlValid);
+
+            if (!isHostUp())
             {
-                rh = nextRecordHandle;
+                // The terminus PDR becomes invalid when the terminus
+                // itself is down. We don't need to do PDR exchange in
+                // that case, so setting the next record handle to 0.
+                nextRecordHandle = 0;
+                // The PDRs fetched so far aren't the whole repository
+                fullHostPDRFetch = false;
             }
-            else
+        }
+        else
+        {
+            auto rc = pldm_pdr_add(repo, pdr.data(), pdr.size(), true,
+                                   pdrTerminusHandle, &rh);
+            if (rc)
             {
-                rh = nextRecordHandle - 1;
+                // pldm_pdr_add() assert()ed on failure to add a PDR.
+                throw std::runtime_error("Failed to add PDR");
             }
 
-            auto pdrHdr = new (pdr.data()) pldm_pdr_hdr;
-            if (!rh)
+            if (pdrHdr->type == PLDM_STATE_SENSOR_PDR ||
+                pdrHdr->type == PLDM_PDR_FRU_RECORD_SET ||
+                pdrHdr->type == PLDM_STATE_EFFECTER_PDR ||
+                pdrHdr->type == PLDM_NUMERIC_EFFECTER_PDR)
             {
-                rh = pdrHdr->record_handle;
+                // The container ID is updated in the repo once the entity
+                // associations are merged
+                hostContainedPDRs.emplace_back(rh, pdrHdr->type);
             }
 
-            if (pdrHdr->type == PLDM_PDR_ENTITY_ASSOCIATION)
+            // Keep the record handle only, the repo holds the PDR
+            if (pdrHdr->type == PLDM_STATE_SENSOR_PDR)
             {
-                this->mergeEntityAssociations(pdr, respCount, rh);
-                merged = true;
+                hostStateSensorPDRs.emplace_back(rh);
             }
-            else
+            else if (pdrHdr->type == PLDM_PDR_FRU_RECORD_SET)
             {
-                if (pdrHdr->type == PLDM_TERMINUS_LOCATOR_PDR)
+                hostFruRecordSetPDRs.emplace_back(rh);
+                // Fetch the FRU record table while the PDRs are fetched
+                if (!fruRecordTableRequested)
                 {
-                    pdrTerminusHandle =
-                        extractTerminusHandle<pldm_terminus_locator_pdr>(pdr);
-                    auto tlpdr =
-                        reinterpret_cast<const pldm_terminus_locator_pdr*>(
-                            pdr.data());
-
-                    terminusHandle = tlpdr->terminus_handle;
-                    tid = tlpdr->tid;
-                    auto terminus_locator_type = tlpdr->terminus_locator_type;
-                    if (terminus_locator_type ==
-                        PLDM_TERMINUS_LOCATOR_TYPE_MCTP_EID)
-                    {
-                        auto locatorValue = reinterpret_cast<
-                            const pldm_terminus_locator_type_mctp_eid*>(
-                            tlpdr->terminus_locator_value);
-                        tlEid = static_cast<uint8_t>(locatorValue->eid);
-                    }
-                    if (tlpdr->validity == 0)
-                    {
-                        tlValid = false;
-                    }
-                    for (const auto& terminusMap : tlPDRInfo)
-                    {
-                        if ((terminusHandle == (terminusMap.first)) &&
-                            (get<1>(terminusMap.second) == tlEid) &&
-                            (get<2>(terminusMap.second) == tlpdr->validity))
-                        {
-                            // TL PDR already present with same validity don't
-                            // add the PDR to the repo just return
-                            return;
-                        }
-                    }
-                    tlPDRInfo.insert_or_assign(
-                        tlpdr->terminus_handle,
-                        std::make_tuple(tlpdr->tid, tlEid, tlpdr->validity));
-                }
-                else if (pdrHdr->type == PLDM_STATE_SENSOR_PDR)
-                {
-                    pdrTerminusHandle =
-                        extractTerminusHandle<pldm_state_sensor_pdr>(pdr);
-                    updateContainerId<pldm_state_sensor_pdr>(entityTree, pdr);
-                    stateSensorPDRs.emplace_back(pdr);
-                }
-                else if (pdrHdr->type == PLDM_PDR_FRU_RECORD_SET)
-                {
-                    pdrTerminusHandle =
-                        extractTerminusHandle<pldm_pdr_fru_record_set>(pdr);
-                    updateContainerId<pldm_pdr_fru_record_set>(entityTree, pdr);
-                    fruRecordSetPDRs.emplace_back(pdr);
-                }
-                else if (pdrHdr->type == PLDM_STATE_EFFECTER_PDR)
-                {
-                    pdrTerminusHandle =
-                        extractTerminusHandle<pldm_state_effecter_pdr>(pdr);
-                    updateContainerId<pldm_state_effecter_pdr>(entityTree, pdr);
-                }
-                else if (pdrHdr->type == PLDM_NUMERIC_EFFECTER_PDR)
-                {
-                    pdrTerminusHandle =
-                        extractTerminusHandle<pldm_numeric_effecter_value_pdr>(
-                            pdr);
-                    updateContainerId<pldm_numeric_effecter_value_pdr>(
-                        entityTree, pdr);
-                }
-                // if the TLPDR is invalid update the repo accordingly
-                if (!tlValid)
-                {
-                    pldm_pdr_update_TL_pdr(repo, terminusHandle, tid, tlEid,
-                                           tlValid);
-
-                    if (!isHostUp())
-                    {
-                        // The terminus PDR becomes invalid when the terminus
-                        // itself is down. We don't need to do PDR exchange in
-                        // that case, so setting the next record handle to 0.
-                        nextRecordHandle = 0;
-                    }
-                }
-                else
-                {
-                    rc = pldm_pdr_add(repo, pdr.data(), respCount, true,
-                                      pdrTerminusHandle, &rh);
-                    if (rc)
-                    {
-                        // pldm_pdr_add() assert()ed on failure to add a PDR.
-                        throw std::runtime_error("Failed to add PDR");
-                    }
+                    getFRURecordTableMetadataByRemote();
                 }
             }
         }
     }
     if (!nextRecordHandle)
     {
+        mergeHostEntityAssociations();
         updateEntityAssociation(entityAssociations, entityTree, objPathMap,
                                 entityMaps, oemPlatformHandler);
         if (oemUtilsHandler)
@@ -645,19 +1072,33 @@ void HostPDRHandler::processHostPDRs(
             oemUtilsHandler->setCoreCount(entityAssociations, entityMaps);
         }
         /*received last record*/
-        this->parseStateSensorPDRs(stateSensorPDRs);
-        this->createDbusObjects(fruRecordSetPDRs);
+        this->parseStateSensorPDRs(hostStateSensorPDRs);
+        this->createDbusObjects(hostFruRecordSetPDRs);
         if (isHostUp())
         {
-            this->setHostSensorState(stateSensorPDRs);
+            this->setHostSensorState(hostStateSensorPDRs);
         }
-        stateSensorPDRs.clear();
-        fruRecordSetPDRs.clear();
+        hostStateSensorPDRs.clear();
+        hostFruRecordSetPDRs.clear();
+        pdrBuffer.clear();
+        pdrBuffer.shrink_to_fit();
         entityAssociations.clear();
 
-        if (merged)
+        if (fullHostPDRFetch)
+        {
+            fullHostPDRFetch = false;
+            hostPdrCache.store(hostPdrCacheKey, hostPdrSignature,
+                               fetchedHostPDRs);
+            fetchedHostPDRs.clear();
+        }
+
+        pdrExchangeComplete = true;
+        notifyHostState(HostStateEvent::pdrExchangeComplete);
+
+        // The repo of a host after the first is not served by GetPDR, the
+        // host is not told about the merged entity associations
+        if (entityAssociationsMerged && !hostRepo)
         {
-            merged = false;
             deferredPDRRepoChgEvent =
                 std::make_unique<sdeventplus::source::Defer>(
                     event,
@@ -665,23 +1106,11 @@ void HostPDRHandler::processHostPDRs(
                         std::mem_fn((&HostPDRHandler::_processPDRRepoChgEvent)),
                         this, std::placeholders::_1));
         }
+        entityAssociationsMerged = false;
+        return std::nullopt;
     }
-    else
-    {
-        if (modifiedPDRRecordHandles.empty() && isHostPdrModified)
-        {
-            isHostPdrModified = false;
-        }
-        else
-        {
-            deferredFetchPDREvent =
-                std::make_unique<sdeventplus::source::Defer>(
-                    event,
-                    std::bind(
-                        std::mem_fn((&HostPDRHandler::_processFetchPDREvent)),
-                        this, nextRecordHandle, std::placeholders::_1));
-        }
-    }
+
+    return nextRecordHandle;
 }
 
 void HostPDRHandler::_processPDRRepoChgEvent(
@@ -693,30 +1122,12 @@ void HostPDRHandler::_processPDRRepoChgEvent(
         FORMAT_IS_PDR_HANDLES);
 }
 
-void HostPDRHandler::_processFetchPDREvent(
-    uint32_t nextRecordHandle, sdeventplus::source::EventBase& /*source */)
-{
-    deferredFetchPDREvent.reset();
-    if (!this->pdrRecordHandles.empty())
-    {
-        nextRecordHandle = this->pdrRecordHandles.front();
-        this->pdrRecordHandles.pop_front();
-    }
-    if (isHostPdrModified && (!this->modifiedPDRRecordHandles.empty()))
-    {
-        nextRecordHandle = this->modifiedPDRRecordHandles.front();
-        this->modifiedPDRRecordHandles.pop_front();
-    }
-    this->getHostPDR(nextRecordHandle);
-}
-
 void HostPDRHandler::setHostFirmwareCondition()
 {
     responseReceived = false;
     auto instanceId = instanceIdDb.next(mctp_eid);
-    std::vector<uint8_t> requestMsg(
-        sizeof(pldm_msg_hdr) + PLDM_GET_VERSION_REQ_BYTES);
-    auto request = new (requestMsg.data()) pldm_msg;
+    PldmMsg<PLDM_GET_VERSION_REQ_BYTES> requestMsg;
+    auto request = requestMsg.msg();
     auto rc = encode_get_version_req(instanceId, 0, PLDM_GET_FIRSTPART,
                                      PLDM_BASE, request);
     if (rc != PLDM_SUCCESS)
@@ -738,7 +1149,7 @@ void HostPDRHandler::setHostFirmwareCondition()
         }
         info("Getting the response code '{RC}'", "RC", lg2::hex,
              response->payload[0]);
-        this->responseReceived = true;
+        this->setHostUp();
     };
     rc = handler->registerRequest(mctp_eid, instanceId, PLDM_BASE,
                                   PLDM_GET_PLDM_VERSION, std::move(requestMsg),
@@ -755,12 +1166,35 @@ bool HostPDRHandler::isHostUp()
     return responseReceived;
 }
 
-void HostPDRHandler::setHostSensorState(const PDRList& stateSensorPDRs)
+void HostPDRHandler::setHostUp()
+{
+    if (responseReceived)
+    {
+        return;
+    }
+    responseReceived = true;
+    notifyHostState(HostStateEvent::firmwareUp);
+}
+
+void HostPDRHandler::notifyHostState(HostStateEvent event)
+{
+    // By index, a callback may subscribe another one
+    for (size_t i = 0; i < hostStateCallbacks.size(); ++i)
+    {
+        hostStateCallbacks[i](event);
+    }
+}
+
+void HostPDRHandler::setHostSensorState(
+    const PDRRecordHandles& stateSensorPDRs)
 {
-    for (const auto& stateSensorPDR : stateSensorPDRs)
+    for (const auto& recordHandle : stateSensorPDRs)
     {
-        auto pdr = reinterpret_cast<const pldm_state_sensor_pdr*>(
-            stateSensorPDR.data());
+        auto stateSensorPDR = getRepoRecord(recordHandle);
+        auto pdr = stateSensorPDR.size() < sizeof(pldm_state_sensor_pdr)
+                       ? nullptr
+                       : reinterpret_cast<const pldm_state_sensor_pdr*>(
+                             stateSensorPDR.data());
 
         if (!pdr)
         {
@@ -770,169 +1204,185 @@ void HostPDRHandler::setHostSensorState(const PDRList& stateSensorPDRs)
             return;
         }
 
-        uint16_t sensorId = pdr->sensor_id;
+        auto terminus = tlPDRInfo.find(pdr->terminus_handle);
+        if (terminus == tlPDRInfo.end())
+        {
+            continue;
+        }
+        const auto& terminusInfo = terminus->second;
+        if (std::get<2>(terminusInfo) == PLDM_TL_PDR_VALID)
+        {
+            mctp_eid = std::get<1>(terminusInfo);
+        }
+        hostSensorReads.emplace_back(mctp_eid, std::get<0>(terminusInfo),
+                                     pdr->sensor_id);
+    }
+
+    sendHostSensorReads();
+}
+
+void HostPDRHandler::sendHostSensorReads()
+{
+    while (!hostSensorReads.empty() &&
+           hostSensorReadsInFlight < REQUEST_WINDOW_SIZE)
+    {
+        auto [eid, tid, sensorId] = hostSensorReads.front();
+        hostSensorReads.pop_front();
+
+        bitfield8_t sensorRearm;
+        sensorRearm.byte = 0;
 
-        for (const auto& [terminusHandle, terminusInfo] : tlPDRInfo)
+        auto instanceId = instanceIdDb.next(eid);
+        PldmMsg<PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES> requestMsg;
+        auto request = requestMsg.msg();
+        auto rc = encode_get_state_sensor_readings_req(instanceId, sensorId,
+                                                       sensorRearm, 0, request);
+
+        if (rc != PLDM_SUCCESS)
         {
-            if (terminusHandle == pdr->terminus_handle)
-            {
-                if (std::get<2>(terminusInfo) == PLDM_TL_PDR_VALID)
-                {
-                    mctp_eid = std::get<1>(terminusInfo);
-                }
+            instanceIdDb.free(eid, instanceId);
+            error(
+                "Failed to encode get state sensor readings request for sensorID '{SENSOR_ID}' and  instanceID '{INSTANCE}', response code '{RC}'",
+                "SENSOR_ID", sensorId, "INSTANCE", instanceId, "RC", rc);
+            pldm::utils::reportError(
+                "xyz.openbmc_project.bmc.pldm.InternalFailure");
+            continue;
+        }
 
-                bitfield8_t sensorRearm;
-                sensorRearm.byte = 0;
-                uint8_t tid = std::get<0>(terminusInfo);
+        auto getStateSensorReadingRespHandler =
+            [this, tid, sensorId, instanceId](mctp_eid_t /*eid*/,
+                                              const pldm_msg* response,
+                                              size_t respMsgLen) {
+                hostSensorReadsInFlight--;
+                processHostSensorReading(tid, sensorId, instanceId, response,
+                                         respMsgLen);
+                sendHostSensorReads();
+            };
+
+        rc = handler->registerRequest(
+            eid, instanceId, PLDM_PLATFORM, PLDM_GET_STATE_SENSOR_READINGS,
+            std::move(requestMsg), std::move(getStateSensorReadingRespHandler));
+
+        if (rc != PLDM_SUCCESS)
+        {
+            error(
+                "Failed to send request to get state sensor reading on remote terminus for sensorID '{SENSOR_ID}' and  instanceID '{INSTANCE}', response code '{RC}'",
+                "SENSOR_ID", sensorId, "INSTANCE", instanceId, "RC", rc);
+            continue;
+        }
+        hostSensorReadsInFlight++;
+    }
+}
 
-                auto instanceId = instanceIdDb.next(mctp_eid);
-                std::vector<uint8_t> requestMsg(
-                    sizeof(pldm_msg_hdr) +
-                    PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES);
-                auto request = new (requestMsg.data()) pldm_msg;
-                auto rc = encode_get_state_sensor_readings_req(
-                    instanceId, sensorId, sensorRearm, 0, request);
+void HostPDRHandler::processHostSensorReading(
+    pdr::TerminusID tid, pdr::SensorID sensorId, uint8_t instanceId,
+    const pldm_msg* response, size_t respMsgLen)
+{
+    if (response == nullptr || !respMsgLen)
+    {
+        error(
+            "Failed to receive response for get state sensor reading command for sensorID '{SENSOR_ID}' and  instanceID '{INSTANCE}'",
+            "SENSOR_ID", sensorId, "INSTANCE", instanceId);
+        return;
+    }
 
-                if (rc != PLDM_SUCCESS)
-                {
-                    instanceIdDb.free(mctp_eid, instanceId);
-                    error(
-                        "Failed to encode get state sensor readings request for sensorID '{SENSOR_ID}' and  instanceID '{INSTANCE}', response code '{RC}'",
-                        "SENSOR_ID", sensorId, "INSTANCE", instanceId, "RC",
-                        rc);
-                    pldm::utils::reportError(
-                        "xyz.openbmc_project.bmc.pldm.InternalFailure");
-                    return;
-                }
+    std::array<get_sensor_state_field, 8> stateFields{};
+    uint8_t compSensorCount = 0;
+    uint8_t completionCode = 0;
+    auto rc = decode_get_state_sensor_readings_resp(
+        response, respMsgLen, &completionCode, &compSensorCount,
+        stateFields.data());
+    if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
+    {
+        error(
+            "Failed to decode get state sensor readings response for sensorID '{SENSOR_ID}' and  instanceID '{INSTANCE}', response code'{RC}' and completion code '{CC}'",
+            "SENSOR_ID", sensorId, "INSTANCE", instanceId, "RC", rc, "CC",
+            completionCode);
+        pldm::utils::reportError(
+            "xyz.openbmc_project.bmc.pldm.InternalFailure");
+        return;
+    }
 
-                auto getStateSensorReadingRespHandler = [=, this](
-                                                            mctp_eid_t /*eid*/,
-                                                            const pldm_msg*
-                                                                response,
-                                                            size_t respMsgLen) {
-                    if (response == nullptr || !respMsgLen)
-                    {
-                        error(
-                            "Failed to receive response for get state sensor reading command for sensorID '{SENSOR_ID}' and  instanceID '{INSTANCE}'",
-                            "SENSOR_ID", sensorId, "INSTANCE", instanceId);
-                        return;
-                    }
-                    std::array<get_sensor_state_field, 8> stateField{};
-                    uint8_t completionCode = 0;
-                    uint8_t comp_sensor_count = 0;
+    setHostSensorReading(
+        tid, sensorId,
+        std::span(stateFields.data(),
+                  std::min<size_t>(compSensorCount, stateFields.size())));
+}
 
-                    auto rc = decode_get_state_sensor_readings_resp(
-                        response, respMsgLen, &completionCode,
-                        &comp_sensor_count, stateField.data());
+void HostPDRHandler::setHostSensorReading(
+    uint8_t tid, uint16_t sensorId,
+    std::span<const get_sensor_state_field> stateFields)
+{
+    uint8_t eventState;
+    uint8_t previousEventState;
 
-                    if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
-                    {
-                        error(
-                            "Failed to decode get state sensor readings response for sensorID '{SENSOR_ID}' and  instanceID '{INSTANCE}', response code'{RC}' and completion code '{CC}'",
-                            "SENSOR_ID", sensorId, "INSTANCE", instanceId, "RC",
-                            rc, "CC", completionCode);
-                        pldm::utils::reportError(
-                            "xyz.openbmc_project.bmc.pldm.InternalFailure");
-                    }
+    for (uint8_t sensorOffset = 0; sensorOffset < stateFields.size();
+         sensorOffset++)
+    {
+        eventState = stateFields[sensorOffset].present_state;
+        previousEventState = stateFields[sensorOffset].previous_state;
 
-                    uint8_t eventState;
-                    uint8_t previousEventState;
+        emitStateSensorEventSignal(tid, sensorId, sensorOffset, eventState,
+                                   previousEventState);
 
-                    for (uint8_t sensorOffset = 0;
-                         sensorOffset < comp_sensor_count; sensorOffset++)
-                    {
-                        eventState = stateField[sensorOffset].present_state;
-                        previousEventState =
-                            stateField[sensorOffset].previous_state;
-
-                        emitStateSensorEventSignal(tid, sensorId, sensorOffset,
-                                                   eventState,
-                                                   previousEventState);
-
-                        SensorEntry sensorEntry{tid, sensorId};
-
-                        pldm::pdr::EntityInfo entityInfo{};
-                        pldm::pdr::CompositeSensorStates
-                            compositeSensorStates{};
-                        std::vector<pldm::pdr::StateSetId> stateSetIds{};
-
-                        try
-                        {
-                            std::tie(entityInfo, compositeSensorStates,
-                                     stateSetIds) =
-                                lookupSensorInfo(sensorEntry);
-                        }
-                        catch (const std::out_of_range&)
-                        {
-                            try
-                            {
-                                sensorEntry.terminusID = PLDM_TID_RESERVED;
-                                std::tie(entityInfo, compositeSensorStates,
-                                         stateSetIds) =
-                                    lookupSensorInfo(sensorEntry);
-                            }
-                            catch (const std::out_of_range&)
-                            {
-                                error("No mapping for the events");
-                            }
-                        }
-
-                        if ((compositeSensorStates.size() > 1) &&
-                            (sensorOffset > (compositeSensorStates.size() - 1)))
-                        {
-                            error(
-                                "Error Invalid data, Invalid sensor offset '{SENSOR_OFFSET}'",
-                                "SENSOR_OFFSET", sensorOffset);
-                            return;
-                        }
-
-                        const auto& possibleStates =
-                            compositeSensorStates[sensorOffset];
-                        if (possibleStates.find(eventState) ==
-                            possibleStates.end())
-                        {
-                            error(
-                                "Error invalid_data, Invalid event state '{STATE}'",
-                                "STATE", eventState);
-                            return;
-                        }
-                        const auto& [containerId, entityType, entityInstance] =
-                            entityInfo;
-                        auto stateSetId = stateSetIds[sensorOffset];
-                        pldm::responder::events::StateSensorEntry
-                            stateSensorEntry{containerId,    entityType,
-                                             entityInstance, sensorOffset,
-                                             stateSetId,     false};
-                        handleStateSensorEvent(stateSensorEntry, eventState);
-                    }
-                };
+        SensorEntry sensorEntry{tid, sensorId};
 
-                rc = handler->registerRequest(
-                    mctp_eid, instanceId, PLDM_PLATFORM,
-                    PLDM_GET_STATE_SENSOR_READINGS, std::move(requestMsg),
-                    std::move(getStateSensorReadingRespHandler));
+        pldm::pdr::EntityInfo entityInfo{};
+        pldm::pdr::CompositeSensorStates compositeSensorStates{};
+        std::vector<pldm::pdr::StateSetId> stateSetIds{};
 
-                if (rc != PLDM_SUCCESS)
-                {
-                    error(
-                        "Failed to send request to get state sensor reading on remote terminus for sensorID '{SENSOR_ID}' and  instanceID '{INSTANCE}', response code '{RC}'",
-                        "SENSOR_ID", sensorId, "INSTANCE", instanceId, "RC",
-                        rc);
-                }
+        try
+        {
+            std::tie(entityInfo, compositeSensorStates, stateSetIds) =
+                lookupSensorInfo(sensorEntry);
+        }
+        catch (const std::out_of_range&)
+        {
+            try
+            {
+                sensorEntry.terminusID = PLDM_TID_RESERVED;
+                std::tie(entityInfo, compositeSensorStates, stateSetIds) =
+                    lookupSensorInfo(sensorEntry);
             }
+            catch (const std::out_of_range&)
+            {
+                error("No mapping for the events");
+            }
+        }
+
+        if ((compositeSensorStates.size() > 1) &&
+            (sensorOffset > (compositeSensorStates.size() - 1)))
+        {
+            error("Error Invalid data, Invalid sensor offset '{SENSOR_OFFSET}'",
+                  "SENSOR_OFFSET", sensorOffset);
+            return;
         }
+
+        const auto& possibleStates = compositeSensorStates[sensorOffset];
+        if (possibleStates.find(eventState) == possibleStates.end())
+        {
+            error("Error invalid_data, Invalid event state '{STATE}'", "STATE",
+                  eventState);
+            return;
+        }
+        const auto& [containerId, entityType, entityInstance] = entityInfo;
+        auto stateSetId = stateSetIds[sensorOffset];
+        pldm::responder::events::StateSensorEntry stateSensorEntry{
+            containerId, entityType, entityInstance,
+            sensorOffset, stateSetId, false};
+        handleStateSensorEvent(stateSensorEntry, eventState);
     }
 }
 
-void HostPDRHandler::getFRURecordTableMetadataByRemote(
-    const PDRList& fruRecordSetPDRs)
+void HostPDRHandler::getFRURecordTableMetadataByRemote()
 {
+    fruRecordTableRequested = true;
+    fruTableComplete = false;
     auto instanceId = instanceIdDb.next(mctp_eid);
-    std::vector<uint8_t> requestMsg(
-        sizeof(pldm_msg_hdr) + PLDM_GET_FRU_RECORD_TABLE_METADATA_REQ_BYTES);
+    PldmMsg<PLDM_GET_FRU_RECORD_TABLE_METADATA_REQ_BYTES> requestMsg;
 
     // GetFruRecordTableMetadata
-    auto request = new (requestMsg.data()) pldm_msg;
+    auto request = requestMsg.msg();
     auto rc = encode_get_fru_record_table_metadata_req(
         instanceId, request, requestMsg.size() - sizeof(pldm_msg_hdr));
     if (rc != PLDM_SUCCESS)
@@ -944,11 +1394,15 @@ void HostPDRHandler::getFRURecordTableMetadataByRemote(
         return;
     }
 
-    auto getFruRecordTableMetadataResponseHandler = [this, fruRecordSetPDRs](
-                                                        mctp_eid_t /*eid*/,
-                                                        const pldm_msg*
-                                                            response,
-                                                        size_t respMsgLen) {
+    auto getFruRecordTableMetadataResponseHandler =
+        [this, exchange = pdrExchange](mctp_eid_t /*eid*/,
+                                       const pldm_msg* response,
+                                       size_t respMsgLen) {
+        if (exchange != pdrExchange)
+        {
+            // A later PDR exchange requests the table again
+            return;
+        }
         if (response == nullptr || !respMsgLen)
         {
             error(
@@ -977,7 +1431,7 @@ void HostPDRHandler::getFRURecordTableMetadataByRemote(
         }
 
         // pass total to getFRURecordTableByRemote
-        this->getFRURecordTableByRemote(fruRecordSetPDRs, total);
+        this->getFRURecordTableByRemote(total);
     };
 
     rc = handler->registerRequest(
@@ -994,8 +1448,7 @@ void HostPDRHandler::getFRURecordTableMetadataByRemote(
     return;
 }
 
-void HostPDRHandler::getFRURecordTableByRemote(const PDRList& fruRecordSetPDRs,
-                                               uint16_t totalTableRecords)
+void HostPDRHandler::getFRURecordTableByRemote(uint16_t totalTableRecords)
 {
     fruRecordData.clear();
 
@@ -1006,11 +1459,10 @@ void HostPDRHandler::getFRURecordTableByRemote(const PDRList& fruRecordSetPDRs,
     }
 
     auto instanceId = instanceIdDb.next(mctp_eid);
-    std::vector<uint8_t> requestMsg(
-        sizeof(pldm_msg_hdr) + PLDM_GET_FRU_RECORD_TABLE_REQ_BYTES);
+    PldmMsg<PLDM_GET_FRU_RECORD_TABLE_REQ_BYTES> requestMsg;
 
     // send the getFruRecordTable command
-    auto request = new (requestMsg.data()) pldm_msg;
+    auto request = requestMsg.msg();
     auto rc = encode_get_fru_record_table_req(
         instanceId, 0, PLDM_GET_FIRSTPART, request,
         requestMsg.size() - sizeof(pldm_msg_hdr));
@@ -1024,10 +1476,14 @@ void HostPDRHandler::getFRURecordTableByRemote(const PDRList& fruRecordSetPDRs,
     }
 
     auto getFruRecordTableResponseHandler = [totalTableRecords, this,
-                                             fruRecordSetPDRs](
+                                             exchange = pdrExchange](
                                                 mctp_eid_t /*eid*/,
                                                 const pldm_msg* response,
                                                 size_t respMsgLen) {
+        if (exchange != pdrExchange)
+        {
+            return;
+        }
         if (response == nullptr || !respMsgLen)
         {
             error("Failed to receive response for the get fru record table");
@@ -1065,7 +1521,8 @@ void HostPDRHandler::getFRURecordTableByRemote(const PDRList& fruRecordSetPDRs,
             return;
         }
 
-        this->setFRUDataOnDBus(fruRecordSetPDRs, fruRecordData);
+        fruRecordTableReceived = true;
+        this->setFRUDataOnDBusIfReady();
     };
 
     rc = handler->registerRequest(
@@ -1077,13 +1534,19 @@ void HostPDRHandler::getFRURecordTableByRemote(const PDRList& fruRecordSetPDRs,
     }
 }
 
-std::optional<uint16_t> HostPDRHandler::getRSI(const PDRList& fruRecordSetPDRs,
-                                               const pldm_entity& entity)
+std::optional<uint16_t> HostPDRHandler::getRSI(
+    const PDRRecordHandles& fruRecordSetPDRs, const pldm_entity& entity)
 {
-    for (const auto& pdr : fruRecordSetPDRs)
+    for (const auto& recordHandle : fruRecordSetPDRs)
     {
+        auto pdr = getRepoRecord(recordHandle);
+        if (pdr.size() <
+            sizeof(pldm_pdr_hdr) + sizeof(pldm_pdr_fru_record_set))
+        {
+            continue;
+        }
         auto fruPdr = reinterpret_cast<const pldm_pdr_fru_record_set*>(
-            const_cast<uint8_t*>(pdr.data()) + sizeof(pldm_pdr_hdr));
+            pdr.data() + sizeof(pldm_pdr_hdr));
 
         if (fruPdr->entity_type == entity.entity_type &&
             fruPdr->entity_instance == entity.entity_instance_num &&
@@ -1097,7 +1560,7 @@ std::optional<uint16_t> HostPDRHandler::getRSI(const PDRList& fruRecordSetPDRs,
 }
 
 void HostPDRHandler::setFRUDataOnDBus(
-    [[maybe_unused]] const PDRList& fruRecordSetPDRs,
+    [[maybe_unused]] const PDRRecordHandles& fruRecordSetPDRs,
     [[maybe_unused]] const std::vector<
         responder::pdr_utils::FruRecordDataFormat>& fruRecordData)
 {
@@ -1144,70 +1607,121 @@ void HostPDRHandler::setAvailabilityState(const std::string& path)
     CustomDBus::getCustomDBus().setAvailabilityState(path, true);
 }
 
-void HostPDRHandler::createDbusObjects(const PDRList& fruRecordSetPDRs)
+void HostPDRHandler::createDbusObjects(
+    const PDRRecordHandles& fruRecordSetPDRs)
 {
-    // Creating and Refreshing dbus hosted by remote PLDM entity Fru PDRs
+    // Creating and Refreshing dbus hosted by remote PLDM entity Fru PDRs,
+    // the object paths are taken now as objPathMap may change meanwhile
+    inventoryObjects.clear();
+    for (const auto& [path, node] : objPathMap)
+    {
+        inventoryObjects.emplace_back(path, pldm_entity_extract(node));
+    }
+    nextInventoryObject = 0;
+    inventoryFruRecordSetPDRs = fruRecordSetPDRs;
+    dbusObjectsCreated = false;
+    deferredCreateDbusObjects.reset();
 
-    for (const auto& entity : objPathMap)
+    if (!fruRecordTableRequested)
     {
-        // update the Present Property
-        setPresentPropertyStatus(entity.first);
-        // Implement & update the Availability to true
-        setAvailabilityState(entity.first);
+        getFRURecordTableMetadataByRemote();
+    }
+    createDbusObjectsBatch();
+}
 
-        pldm_entity node = pldm_entity_extract(entity.second);
-        switch (node.entity_type)
+void HostPDRHandler::createDbusObjectsBatch()
+{
+    auto start = std::chrono::steady_clock::now();
+    while (nextInventoryObject < inventoryObjects.size())
+    {
+        const auto& [path, entity] = inventoryObjects[nextInventoryObject++];
+        createDbusObject(path, entity);
+
+        if (nextInventoryObject < inventoryObjects.size() &&
+            std::chrono::steady_clock::now() - start >= inventoryBatchTime)
         {
-            case PLDM_ENTITY_PROC | 0x8000:
-                CustomDBus::getCustomDBus().implementCpuCoreInterface(
-                    entity.first);
-                break;
-            case PLDM_ENTITY_SYSTEM_CHASSIS:
-                CustomDBus::getCustomDBus().implementChassisInterface(
-                    entity.first);
-                break;
-            case PLDM_ENTITY_POWER_SUPPLY:
-                CustomDBus::getCustomDBus().implementPowerSupplyInterface(
-                    entity.first);
-                break;
-            case PLDM_ENTITY_CHASSIS_FRONT_PANEL_BOARD:
-                CustomDBus::getCustomDBus().implementPanelInterface(
-                    entity.first);
-                break;
-            case PLDM_ENTITY_POWER_CONVERTER:
-                CustomDBus::getCustomDBus().implementVRMInterface(entity.first);
-                break;
-            case PLDM_ENTITY_SLOT:
-                CustomDBus::getCustomDBus().implementPCIeSlotInterface(
-                    entity.first);
-                break;
-            case PLDM_ENTITY_CONNECTOR:
-                CustomDBus::getCustomDBus().implementConnecterInterface(
-                    entity.first);
-                break;
-            case PLDM_ENTITY_BOARD:
-                CustomDBus::getCustomDBus().implementBoard(entity.first);
-                break;
-            case PLDM_ENTITY_CARD:
-                CustomDBus::getCustomDBus().implementPCIeDeviceInterface(
-                    entity.first);
-                break;
-            case PLDM_ENTITY_SYS_BOARD:
-                CustomDBus::getCustomDBus().implementMotherboardInterface(
-                    entity.first);
-                break;
-            case PLDM_ENTITY_FAN:
-                CustomDBus::getCustomDBus().implementFanInterface(entity.first);
-                break;
-            case PLDM_ENTITY_IO_MODULE:
-                CustomDBus::getCustomDBus().implementFabricAdapter(
-                    entity.first);
-                break;
-            default:
-                break;
+            // Let the event loop serve the requests before the next batch
+            if (!deferredCreateDbusObjects)
+            {
+                deferredCreateDbusObjects =
+                    std::make_unique<sdeventplus::source::Defer>(
+                        event, [this](sdeventplus::source::EventBase&) {
+                            stats::DaemonStats::getInstance().setLoopActivity(
+                                "HostPDRHandler D-Bus objects");
+                            createDbusObjectsBatch();
+                        });
+            }
+            return;
         }
     }
-    getFRURecordTableMetadataByRemote(fruRecordSetPDRs);
+
+    deferredCreateDbusObjects.reset();
+    inventoryObjects.clear();
+    dbusObjectsCreated = true;
+    setFRUDataOnDBusIfReady();
+}
+
+void HostPDRHandler::createDbusObject(const std::string& path,
+                                      const pldm_entity& node)
+{
+    // update the Present Property
+    setPresentPropertyStatus(path);
+    // Implement & update the Availability to true
+    setAvailabilityState(path);
+
+    switch (node.entity_type)
+    {
+        case PLDM_ENTITY_PROC | 0x8000:
+            CustomDBus::getCustomDBus().implementCpuCoreInterface(path);
+            break;
+        case PLDM_ENTITY_SYSTEM_CHASSIS:
+            CustomDBus::getCustomDBus().implementChassisInterface(path);
+            break;
+        case PLDM_ENTITY_POWER_SUPPLY:
+            CustomDBus::getCustomDBus().implementPowerSupplyInterface(path);
+            break;
+        case PLDM_ENTITY_CHASSIS_FRONT_PANEL_BOARD:
+            CustomDBus::getCustomDBus().implementPanelInterface(path);
+            break;
+        case PLDM_ENTITY_POWER_CONVERTER:
+            CustomDBus::getCustomDBus().implementVRMInterface(path);
+            break;
+        case PLDM_ENTITY_SLOT:
+            CustomDBus::getCustomDBus().implementPCIeSlotInterface(path);
+            break;
+        case PLDM_ENTITY_CONNECTOR:
+            CustomDBus::getCustomDBus().implementConnecterInterface(path);
+            break;
+        case PLDM_ENTITY_BOARD:
+            CustomDBus::getCustomDBus().implementBoard(path);
+            break;
+        case PLDM_ENTITY_CARD:
+            CustomDBus::getCustomDBus().implementPCIeDeviceInterface(path);
+            break;
+        case PLDM_ENTITY_SYS_BOARD:
+            CustomDBus::getCustomDBus().implementMotherboardInterface(path);
+            break;
+        case PLDM_ENTITY_FAN:
+            CustomDBus::getCustomDBus().implementFanInterface(path);
+            break;
+        case PLDM_ENTITY_IO_MODULE:
+            CustomDBus::getCustomDBus().implementFabricAdapter(path);
+            break;
+        default:
+            break;
+    }
+}
+
+void HostPDRHandler::setFRUDataOnDBusIfReady()
+{
+    if (!fruRecordTableReceived || !dbusObjectsCreated)
+    {
+        return;
+    }
+    fruRecordTableReceived = false;
+    setFRUDataOnDBus(inventoryFruRecordSetPDRs, fruRecordData);
+    fruTableComplete = true;
+    notifyHostState(HostStateEvent::fruTableComplete);
 }
 
 } // namespace pldm
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/instance_id.hpp"
+#include "common/pdr_cache.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
 #include "libpldmresponder/event_parser.hpp"
@@ -15,12 +16,20 @@
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
 
+#include <array>
 #include <deque>
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
 #include <vector>
 
+class TestHostPDRHandler;
+
 namespace pldm
 {
 // vector which would hold the PDR record handle data returned by
@@ -52,7 +61,19 @@ struct SensorEntry
 };
 
 using HostStateSensorMap = std::map<SensorEntry, pdr::SensorInfo>;
-using PDRList = std::vector<std::vector<uint8_t>>;
+
+/** @brief Changes of the state of Host notified by HostPDRHandler */
+enum class HostStateEvent
+{
+    running,             //!< CurrentHostState became Running
+    transitioningToOff,  //!< CurrentHostState became TransitioningToOff
+    off,                 //!< CurrentHostState became Off
+    firmwareUp,          //!< the PLDM stack of Host responded
+    pdrExchangeComplete, //!< the PDRs of Host are in the BMC's PDR repo
+    fruTableComplete,    //!< the FRU record table of Host is on D-Bus
+};
+
+using HostStateCallback = std::function<void(HostStateEvent)>;
 
 /** @class HostPDRHandler
  *  @brief This class can fetch and process PDRs from host firmware
@@ -66,6 +87,8 @@ using PDRList = std::vector<std::vector<uint8_t>>;
 class HostPDRHandler
 {
   public:
+    friend class ::TestHostPDRHandler;
+
     HostPDRHandler() = delete;
     HostPDRHandler(const HostPDRHandler&) = delete;
     HostPDRHandler(HostPDRHandler&&) = delete;
@@ -81,13 +104,17 @@ class HostPDRHandler
      *  @param[in] mctp_fd - fd of MCTP communications socket
      *  @param[in] mctp_eid - MCTP EID of host firmware
      *  @param[in] event - reference of main event loop of pldmd
-     *  @param[in] repo - pointer to BMC's primary PDR repo
+     *  @param[in] repo - pointer to BMC's primary PDR repo, the PDRs of the
+     *                    first host are added to it
      *  @param[in] eventsJsonDir - directory path which has the config JSONs
      *  @param[in] entityTree - Pointer to BMC and Host entity association tree
      *  @param[in] bmcEntityTree - pointer to BMC's entity association tree
      *  @param[in] instanceIdDb - reference to an InstanceIdDb object
      *  @param[in] handler - PLDM request handler
-     *  @param[in] oemUtilsHandler - pointer oem utils handler
+     *  @param[in] hostId - index of the host, of its state object. The hosts
+     *                      after the first keep their PDRs in a repo of
+     *                      their own, their record and terminus handles
+     *                      would collide with the ones of the first host.
      */
     explicit HostPDRHandler(
         int mctp_fd, uint8_t mctp_eid, sdeventplus::Event& event,
@@ -95,7 +122,36 @@ class HostPDRHandler
         pldm_entity_association_tree* entityTree,
         pldm_entity_association_tree* bmcEntityTree,
         pldm::InstanceIdDb& instanceIdDb,
-        pldm::requester::Handler<pldm::requester::Request>* handler);
+        pldm::requester::Handler<pldm::requester::Request>* handler,
+        uint8_t hostId = 0);
+
+    /** @brief Get the PDR repo the PDRs of the host are added to */
+    pldm_pdr* getRepo() const
+    {
+        return repo;
+    }
+
+    /** @brief Remove the PDRs of the termini of the host with a TID, before
+     *         the host refreshes its entire repository
+     *
+     *  @param[in] tid - TID of the termini
+     */
+    void removeTerminusPDRs(pdr::TerminusID tid);
+
+    /** @brief Get the MCTP EID of the host firmware */
+    uint8_t getHostEID() const
+    {
+        return mctp_eid;
+    }
+
+    /** @brief Get the TID the host firmware is addressed with, which the
+     *         flight recorder keeps the messages of the host under. The
+     *         transport maps each TID to the MCTP EID of the same value.
+     */
+    pldm_tid_t getHostTID() const
+    {
+        return static_cast<pldm_tid_t>(mctp_eid);
+    }
 
     /** @brief fetch PDRs from host firmware. See @class.
      *  @param[in] recordHandles - list of record handles pointing to host's
@@ -104,8 +160,9 @@ class HostPDRHandler
 
     void fetchPDR(PDRRecordHandles&& recordHandles);
 
-    /** @brief Send a PLDM event to host firmware containing a list of record
-     *  handles of PDRs that the host firmware has to fetch.
+    /** @brief Send a PLDM event to host firmware containing the record
+     *  handles of the PDRs added, deleted or modified since the previous
+     *  event, so the host firmware only fetches the touched PDRs.
      *  @param[in] pdrTypes - list of PDR types that need to be looked up in the
      *                        BMC repo
      *  @param[in] eventDataFormat - format for PDRRepositoryChgEvent in DSP0248
@@ -113,6 +170,15 @@ class HostPDRHandler
     void sendPDRRepositoryChgEvent(std::vector<uint8_t>&& pdrTypes,
                                    uint8_t eventDataFormat);
 
+    /** @brief Send a PLDM event to host firmware containing the record
+     *  handles of BMC PDRs changed outside of the PDR exchange, like the
+     *  FRU PDRs following the inventory. Nothing is sent while the host is
+     *  down, it fetches all the PDRs once up.
+     *  @param[in] changes - the changed records
+     */
+    void sendPDRRepositoryChgEvent(
+        pldm::responder::pdr_utils::PdrChanges&& changes);
+
     /** @brief Lookup host sensor info corresponding to requested SensorEntry
      *
      *  @param[in] entry - TerminusID and SensorID
@@ -139,14 +205,19 @@ class HostPDRHandler
     /** @brief Parse state sensor PDRs and populate the sensorMap lookup data
      *         structure
      *
-     *  @param[in] stateSensorPDRs - host state sensor PDRs
+     *  @param[in] stateSensorPDRs - record handles of the host state sensor
+     *                              PDRs in the BMC's PDR repo
      *
      */
-    void parseStateSensorPDRs(const PDRList& stateSensorPDRs);
+    void parseStateSensorPDRs(const PDRRecordHandles& stateSensorPDRs);
 
     /** @brief this function sends a GetPDR request to Host firmware.
      *  And processes the PDRs based on type
      *
+     *  When nextRecordHandle is 0 and the record handles to fetch are known,
+     *  up to REQUEST_WINDOW_SIZE GetPDR requests are kept in flight until
+     *  all of them are fetched.
+     *
      *  @param[in] - nextRecordHandle - the next record handle to ask for
      */
     void getHostPDR(uint32_t nextRecordHandle = 0);
@@ -157,9 +228,37 @@ class HostPDRHandler
 
     /** @brief set HostSensorStates when pldmd starts or restarts
      *  and updates the D-Bus property
-     *  @param[in] stateSensorPDRs - host state sensor PDRs
+     *  @param[in] stateSensorPDRs - record handles of the host state sensor
+     *                              PDRs in the BMC's PDR repo
+     */
+    void setHostSensorState(const PDRRecordHandles& stateSensorPDRs);
+
+    /** @brief send the queued GetStateSensorReadings requests while fewer
+     *  than REQUEST_WINDOW_SIZE are in flight
      */
-    void setHostSensorState(const PDRList& stateSensorPDRs);
+    void sendHostSensorReads();
+
+    /** @brief update the D-Bus properties with the GetStateSensorReadings
+     *  response of a host state sensor as soon as it arrives
+     *  @param[in] tid - terminus ID of the sensor
+     *  @param[in] sensorId - sensor ID
+     *  @param[in] instanceId - instance ID of the request
+     *  @param[in] response - the response, nullptr if none was received
+     *  @param[in] respMsgLen - length of the response
+     */
+    void processHostSensorReading(pdr::TerminusID tid, pdr::SensorID sensorId,
+                                  uint8_t instanceId, const pldm_msg* response,
+                                  size_t respMsgLen);
+
+    /** @brief update the D-Bus properties with the reading of a host state
+     *  sensor
+     *  @param[in] tid - terminus ID of the sensor
+     *  @param[in] sensorId - sensor ID
+     *  @param[in] stateFields - states of the composite sensors
+     */
+    void setHostSensorReading(
+        uint8_t tid, uint16_t sensorId,
+        std::span<const get_sensor_state_field> stateFields);
 
     /** @brief whether we received PLDM_RECORDS_MODIFIED event data operation
      *  from host
@@ -170,6 +269,30 @@ class HostPDRHandler
      */
     bool isHostUp();
 
+    /** @brief check whether the PDRs of the last PDR exchange with Host are
+     *  all in the BMC's PDR repo
+     */
+    bool isPdrExchangeComplete() const
+    {
+        return pdrExchangeComplete;
+    }
+
+    /** @brief check whether the FRU record table of Host is set on D-Bus */
+    bool isFruTableComplete() const
+    {
+        return fruTableComplete;
+    }
+
+    /** @brief Register a callback notified of the changes of the state of
+     *  Host, in place of watching the state of Host over D-Bus
+     *
+     *  @param[in] callback - called with each change, from the event loop
+     */
+    void subscribeHostState(HostStateCallback callback)
+    {
+        hostStateCallbacks.emplace_back(std::move(callback));
+    }
+
     /* @brief Method to set the oem platform handler in host pdr handler class
      *
      * @param[in] handler - oem platform handler
@@ -192,7 +315,20 @@ class HostPDRHandler
     /** @brief map that captures various terminus information **/
     TLPDRMap tlPDRInfo;
 
+    /** @brief log of the remote PDRs the host firmware was told about by
+     *  sendPDRRepositoryChgEvent
+     */
+    pldm::responder::pdr_utils::PdrChangeLog pdrChangeLog;
+
   private:
+    /** @brief Encode and send a PDR repository change event
+     *  @param[in] changes - the changed records
+     *  @param[in] logged - the changes come from pdrChangeLog, committed once
+     *                      the host acknowledged them
+     */
+    void sendPDRChanges(pldm::responder::pdr_utils::PdrChanges&& changes,
+                        bool logged);
+
     /** @brief deferred function to fetch PDR from Host, scheduled to work on
      *  the event loop. The PDR exchg with the host is async.
      *  @param[in] source - sdeventplus event source
@@ -202,39 +338,97 @@ class HostPDRHandler
     /** @brief Merge host firmware's entity association PDRs into BMC's
      *  @details A merge operation involves adding a pldm_entity under the
      *  appropriate parent, and updating container ids.
+     *  @param[in] entityIndex - index of the nodes of the BMC's tree
      *  @param[in] pdr - entity association pdr
      *  @param[in] size - size of input PDR record in bytes
      *  @param[in] record_handle - record handle of the PDR
      */
     void mergeEntityAssociations(
+        hostbmc::utils::EntityNodeIndex& entityIndex,
         const std::vector<uint8_t>& pdr, [[maybe_unused]] const uint32_t& size,
         [[maybe_unused]] const uint32_t& record_handle);
 
+    /** @brief Drop the PDRs and the state of the host once it is powered
+     *  off
+     */
+    void processHostOff();
+
+    /** @brief Merge the entity association PDRs of Host fetched so far in one
+     *  pass, then update the container IDs of the PDRs of Host in the BMC's
+     *  repo to the ones of the merged entities
+     */
+    void mergeHostEntityAssociations();
+
     /** @brief process the Host's PDR and add to BMC's PDR repo
      *  @param[in] eid - MCTP id of Host
      *  @param[in] response - response from Host for GetPDR
      *  @param[in] respMsgLen - response message length
+     *  @return the next record handle sent by Host, std::nullopt once the
+     *          PDR exchange is over
      */
-    void processHostPDRs(mctp_eid_t eid, const pldm_msg* response,
-                         size_t respMsgLen);
+    std::optional<uint32_t> processHostPDRs(
+        mctp_eid_t eid, const pldm_msg* response, size_t respMsgLen);
 
-    /** @brief send PDR Repo change after merging Host's PDR to BMC PDR repo
-     *  @param[in] source - sdeventplus event source
+    /** @brief add the Host's PDR to BMC's PDR repo, and process the PDRs of
+     *  Host once the last one is added
+     *  @param[in] pdr - PDR of Host, updated with the container IDs of BMC
+     *  @param[in] rh - record handle of the PDR, 0 to take the one of its
+     *                  header
+     *  @param[in] nextRecordHandle - next record handle sent by Host
+     *  @return the next record handle, std::nullopt once the PDR exchange is
+     *          over
      */
-    void _processPDRRepoChgEvent(sdeventplus::source::EventBase& source);
+    std::optional<uint32_t> addHostPDR(std::vector<uint8_t>& pdr, uint32_t rh,
+                                       uint32_t nextRecordHandle);
+
+    /** @brief ask Host for the signature of its PDR repository, and add the
+     *  cached PDRs of Host if they match it rather than fetching them
+     */
+    void getHostPDRRepositoryInfo();
+
+    /** @brief add the cached PDRs of Host to BMC's PDR repo
+     *  @param[in] pdrs - PDRs of Host as they were fetched
+     */
+    void addCachedHostPDRs(const pdr::PdrArena& pdrs);
+
+    /** @brief send a GetPDR request to Host firmware
+     *  @param[in] recordHandle - record handle of the PDR to ask for
+     *  @return true if the request was registered
+     */
+    bool requestHostPDR(uint32_t recordHandle);
+
+    /** @brief send GetPDR requests for the known record handles left to
+     *  fetch, while fewer than REQUEST_WINDOW_SIZE requests are in flight
+     *  @return false if no known record handle is left to fetch
+     */
+    bool requestKnownHostPDRs();
+
+    /** @brief handle the response to a GetPDR request, in the order the
+     *  requests were sent, and ask for the next PDR once the responses to
+     *  all the requests in flight are processed
+     *  @param[in] seq - sequence number of the request
+     *  @param[in] eid - MCTP id of Host
+     *  @param[in] response - response from Host for GetPDR
+     *  @param[in] respMsgLen - response message length
+     */
+    void handleHostPDRResponse(uint32_t seq, mctp_eid_t eid,
+                               const pldm_msg* response, size_t respMsgLen);
 
-    /** @brief fetch the next PDR based on the record handle sent by Host
-     *  @param[in] nextRecordHandle - next record handle
+    /** @brief Get a PDR held in the BMC's PDR repo
+     *  @param[in] recordHandle - record handle of the PDR
+     *  @return the PDR, empty if the repo no longer holds it
+     */
+    std::span<const uint8_t> getRepoRecord(uint32_t recordHandle) const;
+
+    /** @brief send PDR Repo change after merging Host's PDR to BMC PDR repo
      *  @param[in] source - sdeventplus event source
      */
-    void _processFetchPDREvent(uint32_t nextRecordHandle,
-                               sdeventplus::source::EventBase& source);
+    void _processPDRRepoChgEvent(sdeventplus::source::EventBase& source);
 
-    /** @brief Get FRU record table metadata by remote PLDM terminus
-     *
-     *  @param[out] uint16_t    - total table records
+    /** @brief Get FRU record table metadata by remote PLDM terminus, then
+     *         the FRU record table
      */
-    void getFRURecordTableMetadataByRemote(const PDRList& fruRecordSetPDRs);
+    void getFRURecordTableMetadataByRemote();
 
     /** @brief Set Location Code in the dbus objects
      *
@@ -243,26 +437,55 @@ class HostPDRHandler
      */
 
     void setFRUDataOnDBus(
-        const PDRList& fruRecordSetPDRs,
+        const PDRRecordHandles& fruRecordSetPDRs,
         const std::vector<responder::pdr_utils::FruRecordDataFormat>&
             fruRecordData);
 
     /** @brief Get FRU record table by remote PLDM terminus
      *
-     *  @param[in] fruRecordSetPDRs  - the Fru Record set PDR's
      *  @param[in] totalTableRecords - the Number of total table records
      *  @return
      */
-    void getFRURecordTableByRemote(const PDRList& fruRecordSetPDRs,
-                                   uint16_t totalTableRecords);
+    void getFRURecordTableByRemote(uint16_t totalTableRecords);
 
     /** @brief Create Dbus objects by remote PLDM entity Fru PDRs
+     *
+     *  The objects are created in batches of inventoryBatchTime from the
+     *  event loop.
      *
      *  @param[in] fruRecordSetPDRs - fru record set pdr
      *
      * @ return
      */
-    void createDbusObjects(const PDRList& fruRecordSetPDRs);
+    void createDbusObjects(const PDRRecordHandles& fruRecordSetPDRs);
+
+    /** @brief Create the next batch of inventoryObjects, defer the next one
+     *         to the event loop
+     */
+    void createDbusObjectsBatch();
+
+    /** @brief Create and refresh the D-Bus object of a remote PLDM entity
+     *
+     *  @param[in] path - object path
+     *  @param[in] node - PLDM entity of the object
+     */
+    void createDbusObject(const std::string& path, const pldm_entity& node);
+
+    /** @brief Set the FRU record table on D-Bus once it was received and the
+     *         D-Bus objects are created
+     */
+    void setFRUDataOnDBusIfReady();
+
+    /** @brief Record that the PLDM stack of Host responded, and notify the
+     *         subscribers the first time it does
+     */
+    void setHostUp();
+
+    /** @brief Notify the subscribers of a change of the state of Host
+     *
+     *  @param[in] event - the change
+     */
+    void notifyHostState(HostStateEvent event);
 
     /** @brief set the FRU presence based on the remote PLDM terminus off signal
      */
@@ -284,21 +507,32 @@ class HostPDRHandler
      *  @param[in] entity           - PLDM entity information
      *  @return
      */
-    std::optional<uint16_t> getRSI(const PDRList& fruRecordSetPDRs,
+    std::optional<uint16_t> getRSI(const PDRRecordHandles& fruRecordSetPDRs,
                                    const pldm_entity& entity);
 
     /** @brief MCTP EID of host firmware */
     uint8_t mctp_eid;
+    /** @brief index of the host, of its state object */
+    uint8_t hostId;
     /** @brief reference of main event loop of pldmd, primarily used to schedule
      *  work.
      */
     sdeventplus::Event& event;
-    /** @brief pointer to BMC's primary PDR repo, host PDRs are added here */
+    /** @brief pointer to the PDR repo host PDRs are added to, the BMC's
+     *  primary PDR repo or hostRepo
+     */
     pldm_pdr* repo;
+    /** @brief PDR repo of a host after the first */
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> hostRepo{
+        nullptr, pldm_pdr_destroy};
+    /** @brief repo, looked up by record handle through its record index */
+    pldm::responder::pdr_utils::Repo indexedRepo{nullptr};
 
     pldm::responder::events::StateSensorHandler stateSensorHandler;
     /** @brief Pointer to BMC's and Host's entity association tree */
     pldm_entity_association_tree* entityTree;
+    /** @brief Pointer to BMC's entity association tree */
+    pldm_entity_association_tree* bmcEntityTree;
 
     /** @brief reference to Instance ID database object, used to obtain PLDM
      * instance IDs
@@ -310,7 +544,6 @@ class HostPDRHandler
 
     /** @brief sdeventplus event source */
     std::unique_ptr<sdeventplus::source::Defer> pdrFetchEvent;
-    std::unique_ptr<sdeventplus::source::Defer> deferredFetchPDREvent;
     std::unique_ptr<sdeventplus::source::Defer> deferredPDRRepoChgEvent;
 
     /** @brief list of PDR record handles pointing to host's PDRs */
@@ -322,6 +555,84 @@ class HostPDRHandler
     /** @brief list of PDR record handles modified pointing to host PDRs */
     PDRRecordHandles modifiedPDRRecordHandles;
 
+    /** @brief record handles of the host state sensor PDRs added to the BMC's
+     *  PDR repo during the ongoing PDR exchange
+     */
+    PDRRecordHandles hostStateSensorPDRs;
+
+    /** @brief record handles of the host FRU record set PDRs added to the
+     *  BMC's PDR repo during the ongoing PDR exchange
+     */
+    PDRRecordHandles hostFruRecordSetPDRs;
+
+    /** @brief sequence number of the next GetPDR request sent to Host */
+    uint32_t pdrRequestSeq = 0;
+
+    /** @brief sequence number of the next GetPDR response to process, the
+     *  responses to earlier requests are dropped
+     */
+    uint32_t pdrResponseSeq = 0;
+
+    /** @brief GetPDR responses received ahead of the responses to earlier
+     *  requests, by sequence number of their request
+     */
+    std::map<uint32_t, std::vector<uint8_t>> pdrResponses;
+
+    /** @brief PDR exchange the outstanding requests belong to */
+    uint32_t pdrExchange = 0;
+
+    /** @brief PDRs of Host kept across BMC reboots, reused while the
+     *  repository of Host keeps the same signature
+     */
+    pdr::PdrCache hostPdrCache{PDR_CACHE_DIR};
+
+    /** @brief Key of the PDRs of Host in the PDR cache */
+    std::string hostPdrCacheKey;
+
+    /** @brief whether the ongoing PDR exchange fetches the whole repository
+     *  of Host, to be cached
+     */
+    bool fullHostPDRFetch = false;
+
+    /** @brief signature of the repository of Host being fetched */
+    pdr::PdrRepositorySignature hostPdrSignature{};
+
+    /** @brief PDRs of Host fetched during the ongoing PDR exchange, as Host
+     *  sent them
+     */
+    pdr::PdrArena fetchedHostPDRs;
+
+    /** @brief entity association PDRs of Host to merge, as Host sent them */
+    pdr::PdrArena hostEntityAssociationPDRs;
+
+    /** @brief record handles of hostEntityAssociationPDRs */
+    std::vector<uint32_t> hostEntityAssociationHandles;
+
+    /** @brief record handles and types of the PDRs of Host in the BMC's repo
+     *  whose container IDs are updated once the entity associations are
+     *  merged
+     */
+    std::vector<std::pair<uint32_t, uint8_t>> hostContainedPDRs;
+
+    /** @brief whether entity association PDRs of Host were merged during the
+     *  ongoing PDR exchange
+     */
+    bool entityAssociationsMerged = false;
+
+    /** @brief host state sensors to read, with the EID and terminus ID of
+     *  their terminus
+     */
+    std::deque<std::tuple<mctp_eid_t, pdr::TerminusID, pdr::SensorID>>
+        hostSensorReads;
+
+    /** @brief number of GetStateSensorReadings requests in flight */
+    size_t hostSensorReadsInFlight = 0;
+
+    /** @brief buffer the PDRs of the GetPDR responses are decoded into,
+     *  reused across the responses of a PDR exchange
+     */
+    std::vector<uint8_t> pdrBuffer;
+
     /** @brief D-Bus property changed signal match */
     std::unique_ptr<sdbusplus::bus::match_t> hostOffMatch;
 
@@ -334,11 +645,25 @@ class HostPDRHandler
     /** @brief whether response received from Host */
     bool responseReceived;
 
+    /** @brief whether the last PDR exchange with Host completed */
+    bool pdrExchangeComplete = false;
+
+    /** @brief whether the FRU record table of Host is set on D-Bus */
+    bool fruTableComplete = false;
+
+    /** @brief callbacks notified of the changes of the state of Host */
+    std::vector<HostStateCallback> hostStateCallbacks;
+
     /** @brief variable that captures if the first entity association PDR
      *         from host is merged into the BMC tree
      */
     bool mergedHostParents;
 
+    /** @brief whether host entities were added to the entity association tree
+     *         since it was last restored from the BMC tree
+     */
+    bool hostEntitiesMerged = false;
+
     /** @brief maps an object path to pldm_entity from the BMC's entity
      *         association tree
      */
@@ -352,6 +677,33 @@ class HostPDRHandler
      */
     std::vector<responder::pdr_utils::FruRecordDataFormat> fruRecordData;
 
+    /** @brief whether the FRU record table was requested during the ongoing
+     *  PDR exchange
+     */
+    bool fruRecordTableRequested = false;
+
+    /** @brief whether fruRecordData holds a FRU record table not set on
+     *  D-Bus yet
+     */
+    bool fruRecordTableReceived = false;
+
+    /** @brief object paths and entities of the D-Bus objects being created */
+    std::vector<std::pair<std::string, pldm_entity>> inventoryObjects;
+
+    /** @brief index of the next D-Bus object of inventoryObjects to create */
+    size_t nextInventoryObject = 0;
+
+    /** @brief FRU record set PDRs of the D-Bus objects created */
+    PDRRecordHandles inventoryFruRecordSetPDRs;
+
+    /** @brief whether the D-Bus objects of the last PDR exchange are all
+     *  created
+     */
+    bool dbusObjectsCreated = false;
+
+    /** @brief creates the next batch of D-Bus objects */
+    std::unique_ptr<sdeventplus::source::Defer> deferredCreateDbusObjects;
+
     /** @OEM platform handler */
     pldm::responder::oem_platform::Handler* oemPlatformHandler = nullptr;
 
@@ -0,0 +1,435 @@
+#include "common/instance_id.hpp"
+#include "common/utils.hpp"
+#include "host-bmc/host_pdr_handler.hpp"
+#include "test/test_instance_id.hpp"
+
+#include <libpldm/entity.h>
+#include <libpldm/pdr.h>
+#include <libpldm/platform.h>
+#include <libpldm/state_set.h>
+
+#include <sdbusplus/bus/match.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using namespace pldm;
+
+class TestHostPDRHandler : public testing::Test
+{
+  protected:
+    TestHostPDRHandler() :
+        event(sdeventplus::Event::get_default()),
+        repo(pldm_pdr_init(), pldm_pdr_destroy),
+        entityTree(pldm_entity_association_tree_init(),
+                   pldm_entity_association_tree_destroy),
+        hostEntityTree(pldm_entity_association_tree_init(),
+                       pldm_entity_association_tree_destroy),
+        bmcEntityTree(pldm_entity_association_tree_init(),
+                      pldm_entity_association_tree_destroy),
+        host0(-1, host0Eid, event, repo.get(), "", entityTree.get(),
+              bmcEntityTree.get(), instanceIdDb, nullptr),
+        host1(-1, host1Eid, event, repo.get(), "", hostEntityTree.get(),
+              bmcEntityTree.get(), instanceIdDb, nullptr, 1)
+    {
+        // A PDR of the BMC
+        auto pdr = stateSensorPDR(0x100, TERMINUS_HANDLE);
+        uint32_t handle = 0x100;
+        pldm_pdr_add(repo.get(), pdr.data(), pdr.size(), false,
+                     TERMINUS_HANDLE, &handle);
+
+        // The hosts are up, an invalid terminus locator does not end the
+        // PDR exchange
+        host0.responseReceived = true;
+        host1.responseReceived = true;
+    }
+
+    /** @brief Terminus locator PDR with the MCTP EID of a terminus */
+    static std::vector<uint8_t> terminusLocatorPDR(
+        uint32_t recordHandle, uint16_t terminusHandle, uint8_t tid,
+        uint8_t eid, uint8_t validity)
+    {
+        std::vector<uint8_t> pdr(sizeof(pldm_terminus_locator_pdr));
+        auto tl = new (pdr.data()) pldm_terminus_locator_pdr;
+        tl->hdr.record_handle = recordHandle;
+        tl->hdr.version = 1;
+        tl->hdr.type = PLDM_TERMINUS_LOCATOR_PDR;
+        tl->hdr.length = pdr.size() - sizeof(pldm_pdr_hdr);
+        tl->terminus_handle = terminusHandle;
+        tl->validity = validity;
+        tl->tid = tid;
+        tl->terminus_locator_type = PLDM_TERMINUS_LOCATOR_TYPE_MCTP_EID;
+        tl->terminus_locator_value_size =
+            sizeof(pldm_terminus_locator_type_mctp_eid);
+        tl->terminus_locator_value[0] = eid;
+        return pdr;
+    }
+
+    /** @brief State sensor PDR with one composite sensor */
+    static std::vector<uint8_t> stateSensorPDR(uint32_t recordHandle,
+                                               uint16_t terminusHandle)
+    {
+        std::vector<uint8_t> pdr(sizeof(pldm_state_sensor_pdr) - 1 +
+                                 sizeof(state_sensor_possible_states));
+        auto sensor = new (pdr.data()) pldm_state_sensor_pdr;
+        sensor->hdr.record_handle = recordHandle;
+        sensor->hdr.version = 1;
+        sensor->hdr.type = PLDM_STATE_SENSOR_PDR;
+        sensor->hdr.length = pdr.size() - sizeof(pldm_pdr_hdr);
+        sensor->terminus_handle = terminusHandle;
+        sensor->sensor_id = 1;
+        sensor->entity_type = PLDM_ENTITY_PROC;
+        sensor->entity_instance = 1;
+        sensor->composite_sensor_count = 1;
+        auto states =
+            new (sensor->possible_states) state_sensor_possible_states;
+        states->state_set_id = PLDM_STATE_SET_OPERATIONAL_RUNNING_STATUS;
+        states->possible_states_size = 1;
+        states->states[0].byte = 0x06;
+        return pdr;
+    }
+
+    /** @brief The host sends the same PDRs as the other hosts, with the
+     *         same record and terminus handles
+     */
+    static void fetch(HostPDRHandler& host, uint8_t eid,
+                      uint8_t validity = PLDM_TL_PDR_VALID)
+    {
+        auto tl = terminusLocatorPDR(1, 1, 1, eid, validity);
+        addHostPDR(host, tl, 2);
+        auto sensor = stateSensorPDR(2, 1);
+        addHostPDR(host, sensor, 3);
+    }
+
+    static void addHostPDR(HostPDRHandler& host, std::vector<uint8_t>& pdr,
+                           uint32_t nextRecordHandle)
+    {
+        host.addHostPDR(pdr, 0, nextRecordHandle);
+    }
+
+    static void removeTerminusPDRs(HostPDRHandler& host, uint8_t tid)
+    {
+        host.removeTerminusPDRs(tid);
+    }
+
+    static void hostOff(HostPDRHandler& host)
+    {
+        host.processHostOff();
+    }
+
+    static std::span<const uint8_t> getRepoRecord(const HostPDRHandler& host,
+                                                  uint32_t recordHandle)
+    {
+        return host.getRepoRecord(recordHandle);
+    }
+
+    static void mergeHostEntityAssociations(HostPDRHandler& host)
+    {
+        host.mergeHostEntityAssociations();
+    }
+
+    static void parseStateSensorPDRs(HostPDRHandler& host,
+                                     const PDRRecordHandles& handles)
+    {
+        host.parseStateSensorPDRs(handles);
+    }
+
+    static void setReadsInFlight(HostPDRHandler& host, size_t count)
+    {
+        host.hostSensorReadsInFlight = count;
+    }
+
+    /** @brief Feed a GetStateSensorReadings response with one composite
+     *         sensor, the read of the other sensors stays in flight
+     */
+    static void sensorReadingResponse(HostPDRHandler& host, uint16_t sensorId,
+                                      uint8_t completionCode,
+                                      uint8_t presentState)
+    {
+        constexpr auto payloadLength =
+            PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES;
+        std::vector<uint8_t> response(sizeof(pldm_msg_hdr) + payloadLength);
+        auto msg = new (response.data()) pldm_msg;
+        get_sensor_state_field field{PLDM_SENSOR_ENABLED, presentState,
+                                     PLDM_SENSOR_UNKNOWN, PLDM_SENSOR_UNKNOWN};
+        ASSERT_EQ(encode_get_state_sensor_readings_resp(0, completionCode, 1,
+                                                        &field, msg),
+                  PLDM_SUCCESS);
+        host.processHostSensorReading(1, sensorId, 0, msg, payloadLength);
+    }
+
+    /** @brief Collect the StateSensorEvent signals sent so far */
+    static void collectSignals()
+    {
+        auto& bus = pldm::utils::DBusHandler::getBus();
+        for (int i = 0; i < 10; ++i)
+        {
+            bus.wait(std::chrono::milliseconds(10));
+            while (bus.process_discard())
+            {}
+        }
+    }
+
+    /** @brief Add the PDRs of a host from a cache, the host is down so
+     *         completing the PDR exchange sends no request
+     */
+    static void addCachedHostPDRs(HostPDRHandler& host,
+                                  const pdr::PdrArena& pdrs)
+    {
+        host.responseReceived = false;
+        host.fruRecordTableRequested = true;
+        host.addCachedHostPDRs(pdrs);
+    }
+
+    static const HostPDRHandler::TLPDRMap& tlPDRInfo(
+        const HostPDRHandler& host)
+    {
+        return host.tlPDRInfo;
+    }
+
+    /** @brief Count the records of a repo with a record handle */
+    static size_t countRecords(const pldm_pdr* repo, uint32_t recordHandle)
+    {
+        size_t count = 0;
+        uint8_t* data = nullptr;
+        uint32_t size = 0;
+        uint32_t nextRecordHandle = 0;
+        auto record =
+            pldm_pdr_find_record(repo, 0, &data, &size, &nextRecordHandle);
+        while (record)
+        {
+            if (pldm_pdr_get_record_handle(repo, record) == recordHandle)
+            {
+                count++;
+            }
+            record = pldm_pdr_get_next_record(repo, record, &data, &size,
+                                              &nextRecordHandle);
+        }
+        return count;
+    }
+
+    static constexpr uint8_t host0Eid = 9;
+    static constexpr uint8_t host1Eid = 10;
+
+    sdeventplus::Event event;
+    TestInstanceIdDb instanceIdDb;
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> repo;
+    using EntityTree =
+        std::unique_ptr<pldm_entity_association_tree,
+                        decltype(&pldm_entity_association_tree_destroy)>;
+    EntityTree entityTree;
+    EntityTree hostEntityTree;
+    EntityTree bmcEntityTree;
+    HostPDRHandler host0;
+    HostPDRHandler host1;
+};
+
+TEST_F(TestHostPDRHandler, hostsKeepTheirPDRsApart)
+{
+    fetch(host0, host0Eid);
+    fetch(host1, host1Eid);
+
+    EXPECT_EQ(host0.getRepo(), repo.get());
+    EXPECT_NE(host1.getRepo(), repo.get());
+
+    // GetPDR serves each record handle once
+    EXPECT_EQ(pldm_pdr_get_record_count(repo.get()), 3u);
+    EXPECT_EQ(countRecords(repo.get(), 1), 1u);
+    EXPECT_EQ(countRecords(repo.get(), 2), 1u);
+    EXPECT_EQ(pldm_pdr_get_record_count(host1.getRepo()), 2u);
+}
+
+TEST_F(TestHostPDRHandler, hostOffKeepsOtherHostPDRs)
+{
+    fetch(host0, host0Eid);
+    fetch(host1, host1Eid);
+
+    hostOff(host1);
+    EXPECT_EQ(pldm_pdr_get_record_count(host1.getRepo()), 0u);
+    EXPECT_EQ(pldm_pdr_get_record_count(repo.get()), 3u);
+    EXPECT_EQ(tlPDRInfo(host0).size(), 1u);
+
+    // The PDRs of the BMC stay
+    hostOff(host0);
+    EXPECT_EQ(pldm_pdr_get_record_count(repo.get()), 1u);
+    EXPECT_EQ(countRecords(repo.get(), 0x100), 1u);
+}
+
+TEST_F(TestHostPDRHandler, refreshRemovesOwnTerminusPDRs)
+{
+    fetch(host0, host0Eid);
+    fetch(host1, host1Eid);
+
+    // Both hosts use TID 1
+    removeTerminusPDRs(host1, 1);
+    EXPECT_EQ(pldm_pdr_get_record_count(host1.getRepo()), 0u);
+    EXPECT_TRUE(tlPDRInfo(host1).empty());
+    EXPECT_EQ(pldm_pdr_get_record_count(repo.get()), 3u);
+    EXPECT_EQ(tlPDRInfo(host0).size(), 1u);
+
+    removeTerminusPDRs(host0, 1);
+    EXPECT_EQ(pldm_pdr_get_record_count(repo.get()), 1u);
+}
+
+TEST_F(TestHostPDRHandler, invalidTerminusLocatorOfOtherHost)
+{
+    fetch(host0, host0Eid);
+    fetch(host1, host1Eid);
+
+    auto tl = terminusLocatorPDR(1, 1, 1, host1Eid, PLDM_TL_PDR_NOT_VALID);
+    addHostPDR(host1, tl, 3);
+
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t nextRecordHandle = 0;
+    ASSERT_NE(pldm_pdr_find_record(repo.get(), 1, &data, &size,
+                                   &nextRecordHandle),
+              nullptr);
+    auto tlpdr = reinterpret_cast<const pldm_terminus_locator_pdr*>(data);
+    EXPECT_EQ(tlpdr->validity, PLDM_TL_PDR_VALID);
+
+    ASSERT_NE(pldm_pdr_find_record(host1.getRepo(), 1, &data, &size,
+                                   &nextRecordHandle),
+              nullptr);
+    tlpdr = reinterpret_cast<const pldm_terminus_locator_pdr*>(data);
+    EXPECT_EQ(tlpdr->validity, PLDM_TL_PDR_NOT_VALID);
+}
+
+TEST_F(TestHostPDRHandler, repoRecordsByHandle)
+{
+    fetch(host0, host0Eid);
+
+    auto tl = getRepoRecord(host0, 1);
+    ASSERT_EQ(tl.size(), sizeof(pldm_terminus_locator_pdr));
+    EXPECT_EQ(reinterpret_cast<const pldm_pdr_hdr*>(tl.data())->type,
+              PLDM_TERMINUS_LOCATOR_PDR);
+    auto sensor = getRepoRecord(host0, 2);
+    ASSERT_FALSE(sensor.empty());
+    EXPECT_EQ(reinterpret_cast<const pldm_pdr_hdr*>(sensor.data())->type,
+              PLDM_STATE_SENSOR_PDR);
+    EXPECT_FALSE(getRepoRecord(host0, 0x100).empty());
+    EXPECT_TRUE(getRepoRecord(host0, 3).empty());
+
+    // The index follows the records removed and added again
+    removeTerminusPDRs(host0, 1);
+    EXPECT_TRUE(getRepoRecord(host0, 2).empty());
+    EXPECT_FALSE(getRepoRecord(host0, 0x100).empty());
+    fetch(host0, host0Eid);
+    EXPECT_FALSE(getRepoRecord(host0, 2).empty());
+
+    // Each host looks up its own repo
+    fetch(host1, host1Eid);
+    EXPECT_TRUE(getRepoRecord(host1, 0x100).empty());
+    EXPECT_FALSE(getRepoRecord(host1, 2).empty());
+}
+
+TEST_F(TestHostPDRHandler, mergeUpdatesContainerIdInRepo)
+{
+    constexpr uint16_t remoteContainerId = 5;
+
+    auto tl = terminusLocatorPDR(1, 1, 1, host0Eid, PLDM_TL_PDR_VALID);
+    addHostPDR(host0, tl, 2);
+    auto pdr = stateSensorPDR(2, 1);
+    reinterpret_cast<pldm_state_sensor_pdr*>(pdr.data())->container_id =
+        remoteContainerId;
+    addHostPDR(host0, pdr, 3);
+
+    pldm_entity system{PLDM_ENTITY_SYSTEM_CHASSIS, 1, 0};
+    auto parent = pldm_entity_association_tree_add_entity(
+        entityTree.get(), &system, 1, nullptr,
+        PLDM_ENTITY_ASSOCIAION_PHYSICAL, true, true, 0xffff);
+    ASSERT_NE(parent, nullptr);
+    pldm_entity proc{PLDM_ENTITY_PROC, 1, remoteContainerId};
+    auto node = pldm_entity_association_tree_add_entity(
+        entityTree.get(), &proc, 1, parent, PLDM_ENTITY_ASSOCIAION_PHYSICAL,
+        true, true, 0xffff);
+    ASSERT_NE(node, nullptr);
+    auto containerId = pldm_entity_extract(node).entity_container_id;
+
+    mergeHostEntityAssociations(host0);
+
+    auto record = getRepoRecord(host0, 2);
+    ASSERT_GE(record.size(), sizeof(pldm_state_sensor_pdr));
+    EXPECT_EQ(reinterpret_cast<const pldm_state_sensor_pdr*>(record.data())
+                  ->container_id,
+              containerId);
+}
+
+TEST_F(TestHostPDRHandler, sensorReadingPublishedOnArrival)
+{
+    fetch(host0, host0Eid);
+    parseStateSensorPDRs(host0, {2});
+
+    std::vector<std::tuple<uint8_t, uint16_t, uint8_t>> events;
+    namespace rules = sdbusplus::bus::match::rules;
+    sdbusplus::bus::match_t match(
+        pldm::utils::DBusHandler::getBus(),
+        rules::type::signal() + rules::member("StateSensorEvent") +
+            rules::interface("xyz.openbmc_project.PLDM.Event"),
+        [&events](sdbusplus::message_t& msg) {
+            uint8_t tid = 0;
+            uint16_t sensorId = 0;
+            uint8_t offset = 0;
+            uint8_t state = 0;
+            uint8_t previousState = 0;
+            msg.read(tid, sensorId, offset, state, previousState);
+            events.emplace_back(tid, sensorId, state);
+        });
+
+    // The other host state sensors are still being read
+    setReadsInFlight(host0, 2);
+    sensorReadingResponse(host0, 1, PLDM_SUCCESS, 1);
+    collectSignals();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0], std::make_tuple(uint8_t{1}, uint16_t{1}, uint8_t{1}));
+
+    // A failed read publishes nothing
+    sensorReadingResponse(host0, 1, PLDM_ERROR, 2);
+    collectSignals();
+    EXPECT_EQ(events.size(), 1u);
+}
+
+TEST_F(TestHostPDRHandler, cachedPDRsAddedAsFetched)
+{
+    char tmpdir[] = "/tmp/pldm_host_pdr_cache.XXXXXX";
+    fs::path dir(mkdtemp(tmpdir));
+    pdr::PdrRepositorySignature signature{};
+    signature.recordCount = 2;
+
+    pdr::PdrArena pdrs;
+    pdrs.emplace_back(terminusLocatorPDR(1, 1, 1, host1Eid, PLDM_TL_PDR_VALID));
+    pdrs.emplace_back(stateSensorPDR(2, 1));
+    pdr::PdrCache cache(dir);
+    ASSERT_TRUE(cache.store("host1", signature, pdrs));
+
+    // A changed repository does not use the cached PDRs
+    auto changed = signature;
+    changed.recordCount++;
+    EXPECT_FALSE(cache.load("host1", changed));
+    EXPECT_FALSE(cache.load("host", signature));
+
+    auto cached = cache.load("host1", signature);
+    ASSERT_TRUE(cached);
+    ASSERT_EQ(cached->size(), 2u);
+    addCachedHostPDRs(host1, *cached);
+
+    EXPECT_EQ(pldm_pdr_get_record_count(host1.getRepo()), 2u);
+    EXPECT_EQ(tlPDRInfo(host1).size(), 1u);
+    auto sensor = getRepoRecord(host1, 2);
+    ASSERT_FALSE(sensor.empty());
+    EXPECT_EQ(reinterpret_cast<const pldm_pdr_hdr*>(sensor.data())->type,
+              PLDM_STATE_SENSOR_PDR);
+    // The PDRs of the first host are untouched
+    EXPECT_EQ(pldm_pdr_get_record_count(repo.get()), 1u);
+
+    fs::remove_all(dir);
+}
@@ -114,3 +114,37 @@ TEST(EntityAssociation, addObjectPathEntityAssociations1)
     EXPECT_EQ(index, retObjectMaps.size());
     pldm_entity_association_tree_destroy(tree);
 }
+
+TEST(EntityNodeIndex, findAndAdd)
+{
+    auto tree = pldm_entity_association_tree_init();
+
+    pldm_entity chassis{PLDM_ENTITY_SYSTEM_CHASSIS, 1, 0};
+    auto root = pldm_entity_association_tree_add_entity(
+        tree, &chassis, 1, nullptr, PLDM_ENTITY_ASSOCIAION_PHYSICAL, false,
+        true, 0xFFFF);
+    ASSERT_NE(root, nullptr);
+
+    EntityNodeIndex index(tree);
+    auto bmcChassis = pldm_entity_extract(root);
+    EXPECT_EQ(index.find(bmcChassis, false), root);
+    // The second lookup is answered by the index
+    EXPECT_EQ(index.find(bmcChassis, false), root);
+
+    // A board of the host, in the container the host numbered 5
+    pldm_entity board{PLDM_ENTITY_BOARD, 1, 5};
+    auto node = index.add(board, 1, root, PLDM_ENTITY_ASSOCIAION_PHYSICAL,
+                          true, true, 0xFFFF);
+    ASSERT_NE(node, nullptr);
+
+    auto lookup = board;
+    EXPECT_EQ(index.find(board, true),
+              pldm_entity_association_tree_find_with_locality(tree, &lookup,
+                                                              true));
+    EXPECT_EQ(index.find(board, true), node);
+
+    pldm_entity missing{PLDM_ENTITY_FAN, 1, 5};
+    EXPECT_EQ(index.find(missing, true), nullptr);
+
+    pldm_entity_association_tree_destroy(tree);
+}
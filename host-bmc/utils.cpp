@@ -1,9 +1,16 @@
 #include "utils.hpp"
 
+#include "common/json_cache.hpp"
+
 #include <libpldm/entity.h>
 
 #include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <optional>
+#include <set>
+#include <tuple>
 
 using namespace pldm::utils;
 
@@ -13,52 +20,46 @@ namespace hostbmc
 {
 namespace utils
 {
+/** @brief Key of a host entity: type, instance and remote container ID */
+using EntityKey = std::tuple<uint16_t, uint16_t, uint16_t>;
+
+static EntityKey entityKey(pldm_entity_node* node)
+{
+    pldm_entity entity = pldm_entity_extract(node);
+    return {entity.entity_type, entity.entity_instance_num,
+            pldm_entity_node_get_remote_container_id(node)};
+}
+
+/** @brief Indices of the associations in entityAssoc by their parent */
+using AssociationIndex = std::multimap<EntityKey, size_t>;
+
 Entities getParentEntites(const EntityAssociations& entityAssoc)
 {
-    Entities parents{};
-    for (const auto& et : entityAssoc)
+    // The parents which are the child of no other association
+    std::set<EntityKey> children;
+    for (const auto& evs : entityAssoc)
     {
-        parents.push_back(et[0]);
+        for (size_t i = 1; i < evs.size(); i++)
+        {
+            children.insert(entityKey(evs[i]));
+        }
     }
 
-    bool found = false;
-    for (auto it = parents.begin(); it != parents.end();
-         it = found ? parents.erase(it) : std::next(it))
+    Entities parents{};
+    for (const auto& et : entityAssoc)
     {
-        uint16_t parent_contained_id =
-            pldm_entity_node_get_remote_container_id(*it);
-        found = false;
-        for (const auto& evs : entityAssoc)
+        if (!children.contains(entityKey(et[0])))
         {
-            for (size_t i = 1; i < evs.size() && !found; i++)
-            {
-                uint16_t node_contained_id =
-                    pldm_entity_node_get_remote_container_id(evs[i]);
-
-                pldm_entity parent_entity = pldm_entity_extract(*it);
-                pldm_entity node_entity = pldm_entity_extract(evs[i]);
-
-                if (node_entity.entity_type == parent_entity.entity_type &&
-                    node_entity.entity_instance_num ==
-                        parent_entity.entity_instance_num &&
-                    node_contained_id == parent_contained_id)
-                {
-                    found = true;
-                }
-            }
-            if (found)
-            {
-                break;
-            }
+            parents.push_back(et[0]);
         }
     }
-
     return parents;
 }
 
-void addObjectPathEntityAssociations(
-    const EntityAssociations& entityAssoc, pldm_entity_node* entity,
-    const fs::path& path, ObjectPathMaps& objPathMap, EntityMaps entityMaps,
+static void addObjectPathEntityAssociations(
+    const EntityAssociations& entityAssoc, const AssociationIndex& index,
+    pldm_entity_node* entity, const fs::path& path, ObjectPathMaps& objPathMap,
+    const EntityMaps& entityMaps,
     pldm::responder::oem_platform::Handler* oemPlatformHandler)
 {
     if (entity == nullptr)
@@ -66,9 +67,9 @@ void addObjectPathEntityAssociations(
         return;
     }
 
-    bool found = false;
     pldm_entity node_entity = pldm_entity_extract(entity);
-    if (!entityMaps.contains(node_entity.entity_type))
+    auto entityName = entityMaps.find(node_entity.entity_type);
+    if (entityName == entityMaps.end())
     {
         // entityMaps doesn't contain entity type which are not required to
         // build entity object path, so returning from here because this is a
@@ -76,81 +77,40 @@ void addObjectPathEntityAssociations(
         return;
     }
 
-    std::string entityName = entityMaps.at(node_entity.entity_type);
-    for (const auto& ev : entityAssoc)
+    fs::path p =
+        path / fs::path{entityName->second +
+                        std::to_string(node_entity.entity_instance_num)};
+    std::string entity_path = p.string();
+    if (oemPlatformHandler)
     {
-        pldm_entity ev_entity = pldm_entity_extract(ev[0]);
-        if (ev_entity.entity_instance_num == node_entity.entity_instance_num &&
-            ev_entity.entity_type == node_entity.entity_type)
+        oemPlatformHandler->updateOemDbusPaths(entity_path);
+    }
+    try
+    {
+        pldm::utils::DBusHandler().getService(entity_path.c_str(), nullptr);
+        // If the entity obtained from the remote PLDM terminal is not in the
+        // MAP, or there is no auxiliary name PDR, add it directly. Otherwise,
+        // check whether the DBus service of entity_path exists, and overwrite
+        // the entity if it does not exist.
+        if (objPathMap.contains(entity_path))
         {
-            uint16_t node_contained_id =
-                pldm_entity_node_get_remote_container_id(ev[0]);
-            uint16_t entity_contained_id =
-                pldm_entity_node_get_remote_container_id(entity);
-
-            if (node_contained_id != entity_contained_id)
-            {
-                continue;
-            }
-
-            fs::path p =
-                path /
-                fs::path{entityName +
-                         std::to_string(node_entity.entity_instance_num)};
-            std::string entity_path = p.string();
-            if (oemPlatformHandler)
-            {
-                oemPlatformHandler->updateOemDbusPaths(entity_path);
-            }
-            try
-            {
-                pldm::utils::DBusHandler().getService(entity_path.c_str(),
-                                                      nullptr);
-                // If the entity obtained from the remote PLDM terminal is not
-                // in the MAP, or there is no auxiliary name PDR, add it
-                // directly. Otherwise, check whether the DBus service of
-                // entity_path exists, and overwrite the entity if it does not
-                // exist.
-                if (objPathMap.contains(entity_path))
-                {
-                    objPathMap[entity_path] = entity;
-                }
-            }
-            catch (const std::exception&)
-            {
-                objPathMap[entity_path] = entity;
-            }
-
-            for (size_t i = 1; i < ev.size(); i++)
-            {
-                addObjectPathEntityAssociations(entityAssoc, ev[i], p,
-                                                objPathMap, entityMaps,
-                                                oemPlatformHandler);
-            }
-            found = true;
+            objPathMap[entity_path] = entity;
         }
     }
+    catch (const std::exception&)
+    {
+        objPathMap[entity_path] = entity;
+    }
 
-    if (!found)
+    auto [first, last] = index.equal_range(entityKey(entity));
+    for (auto it = first; it != last; ++it)
     {
-        std::string dbusPath =
-            path / fs::path{entityName +
-                            std::to_string(node_entity.entity_instance_num)};
-        if (oemPlatformHandler)
-        {
-            oemPlatformHandler->updateOemDbusPaths(dbusPath);
-        }
-        try
+        const auto& ev = entityAssoc[it->second];
+        for (size_t i = 1; i < ev.size(); i++)
         {
-            pldm::utils::DBusHandler().getService(dbusPath.c_str(), nullptr);
-            if (objPathMap.contains(dbusPath))
-            {
-                objPathMap[dbusPath] = entity;
-            }
-        }
-        catch (const std::exception&)
-        {
-            objPathMap[dbusPath] = entity;
+            addObjectPathEntityAssociations(entityAssoc, index, ev[i], p,
+                                            objPathMap, entityMaps,
+                                            oemPlatformHandler);
         }
     }
 }
@@ -158,64 +118,74 @@ void addObjectPathEntityAssociations(
 void updateEntityAssociation(
     const EntityAssociations& entityAssoc,
     pldm_entity_association_tree* entityTree, ObjectPathMaps& objPathMap,
-    EntityMaps entityMaps,
+    const EntityMaps& entityMaps,
     pldm::responder::oem_platform::Handler* oemPlatformHandler)
 {
-    std::vector<pldm_entity_node*> parentsEntity =
-        getParentEntites(entityAssoc);
-    for (const auto& entity : parentsEntity)
+    AssociationIndex index;
+    for (size_t i = 0; i < entityAssoc.size(); i++)
     {
-        fs::path path{"/xyz/openbmc_project/inventory"};
-        std::deque<std::string> paths{};
-        pldm_entity node_entity = pldm_entity_extract(entity);
-        auto node = pldm_entity_association_tree_find_with_locality(
-            entityTree, &node_entity, false);
-        if (!node)
+        index.emplace(entityKey(entityAssoc[i][0]), i);
+    }
+
+    // Inventory paths of the ancestors already walked, the parents of the
+    // associations often share them
+    std::map<pldm_entity_node*, std::optional<fs::path>> ancestorPaths;
+    std::function<std::optional<fs::path>(pldm_entity_node*)> nodePath =
+        [&](pldm_entity_node* node) -> std::optional<fs::path> {
+        if (!pldm_entity_is_exist_parent(node))
         {
-            continue;
+            return fs::path{"/xyz/openbmc_project/inventory"};
         }
-
-        bool found = true;
-        while (node)
+        if (auto it = ancestorPaths.find(node); it != ancestorPaths.end())
         {
-            if (!pldm_entity_is_exist_parent(node))
-            {
-                break;
-            }
+            return it->second;
+        }
 
-            pldm_entity parent = pldm_entity_get_parent(node);
-            try
-            {
-                paths.push_back(entityMaps.at(parent.entity_type) +
-                                std::to_string(parent.entity_instance_num));
-            }
-            catch (const std::exception& e)
+        std::optional<fs::path> path;
+        pldm_entity parent = pldm_entity_get_parent(node);
+        auto parentName = entityMaps.find(parent.entity_type);
+        if (parentName == entityMaps.end())
+        {
+            lg2::error(
+                "Parent entity not found in the entityMaps, type: {ENTITY_TYPE}, num: {NUM}",
+                "ENTITY_TYPE", (int)parent.entity_type, "NUM",
+                (int)parent.entity_instance_num);
+        }
+        else
+        {
+            auto parentNode = pldm_entity_association_tree_find_with_locality(
+                entityTree, &parent, false);
+            path = parentNode ? nodePath(parentNode)
+                              : fs::path{"/xyz/openbmc_project/inventory"};
+            if (path)
             {
-                lg2::error(
-                    "Parent entity not found in the entityMaps, type: {ENTITY_TYPE}, num: {NUM}, e: {ERROR}",
-                    "ENTITY_TYPE", (int)parent.entity_type, "NUM",
-                    (int)parent.entity_instance_num, "ERROR", e);
-                found = false;
-                break;
+                *path /= parentName->second +
+                         std::to_string(parent.entity_instance_num);
             }
-
-            node = pldm_entity_association_tree_find_with_locality(
-                entityTree, &parent, false);
         }
+        ancestorPaths.emplace(node, path);
+        return path;
+    };
 
-        if (!found)
+    for (const auto& entity : getParentEntites(entityAssoc))
+    {
+        pldm_entity node_entity = pldm_entity_extract(entity);
+        auto node = pldm_entity_association_tree_find_with_locality(
+            entityTree, &node_entity, false);
+        if (!node)
         {
             continue;
         }
 
-        while (!paths.empty())
+        auto path = nodePath(node);
+        if (!path)
         {
-            path = path / fs::path{paths.back()};
-            paths.pop_back();
+            continue;
         }
 
-        addObjectPathEntityAssociations(entityAssoc, entity, path, objPathMap,
-                                        entityMaps, oemPlatformHandler);
+        addObjectPathEntityAssociations(entityAssoc, index, entity, *path,
+                                        objPathMap, entityMaps,
+                                        oemPlatformHandler);
     }
 }
 
@@ -223,8 +193,7 @@ EntityMaps parseEntityMap(const fs::path& filePath)
 {
     const Json emptyJson{};
     EntityMaps entityMaps{};
-    std::ifstream jsonFile(filePath);
-    auto data = Json::parse(jsonFile);
+    auto data = pldm::utils::JsonCache::getInstance().parse(filePath);
     if (data.is_discarded())
     {
         error("Failed parsing of EntityMap data from json file: '{JSON_PATH}'",
@@ -253,6 +222,47 @@ EntityMaps parseEntityMap(const fs::path& filePath)
     return entityMaps;
 }
 
+pldm_entity_node* EntityNodeIndex::find(const pldm_entity& entity,
+                                        bool isRemote)
+{
+    auto it = nodes.find(key(entity, isRemote));
+    if (it != nodes.end())
+    {
+        return it->second;
+    }
+
+    // An entity the tree doesn't hold yet may be added later, only the
+    // nodes found are kept
+    auto lookup = entity;
+    auto node =
+        pldm_entity_association_tree_find_with_locality(tree, &lookup, isRemote);
+    if (node)
+    {
+        nodes.emplace(key(entity, isRemote), node);
+    }
+    return node;
+}
+
+pldm_entity_node* EntityNodeIndex::add(
+    const pldm_entity& entity, uint16_t instanceNumber,
+    pldm_entity_node* parent, uint8_t associationType, bool isRemote,
+    bool isUpdateContainerId, uint16_t containerId)
+{
+    auto added = entity;
+    auto node = pldm_entity_association_tree_add_entity(
+        tree, &added, instanceNumber, parent, associationType, isRemote,
+        isUpdateContainerId, containerId);
+    if (node && isRemote)
+    {
+        // A remote node is looked up with the container ID of the terminus
+        auto remote = pldm_entity_extract(node);
+        remote.entity_container_id =
+            pldm_entity_node_get_remote_container_id(node);
+        nodes.insert_or_assign(key(remote, true), node);
+    }
+    return node;
+}
+
 } // namespace utils
 } // namespace hostbmc
 } // namespace pldm
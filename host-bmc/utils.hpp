@@ -10,6 +10,7 @@
 #include <fstream>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -31,7 +32,8 @@ namespace utils
 void updateEntityAssociation(
     const pldm::utils::EntityAssociations& entityAssoc,
     pldm_entity_association_tree* entityTree,
-    pldm::utils::ObjectPathMaps& objPathMap, pldm::utils::EntityMaps entityMaps,
+    pldm::utils::ObjectPathMaps& objPathMap,
+    const pldm::utils::EntityMaps& entityMaps,
     pldm::responder::oem_platform::Handler* oemPlatformHandler);
 
 /** @brief Parsing entity to DBus string mapping from json file
@@ -42,6 +44,58 @@ void updateEntityAssociation(
  */
 pldm::utils::EntityMaps parseEntityMap(const fs::path& filePath);
 
+/** @class EntityNodeIndex
+ *
+ *  Nodes of an entity association tree by entity and locality, filled as the
+ *  nodes are looked up or added, so merging a large host topology does not
+ *  search the whole tree for every entity. The index holds pointers to the
+ *  nodes and is only valid while no node is removed from the tree.
+ */
+class EntityNodeIndex
+{
+  public:
+    /** @brief Constructor
+     *  @param[in] tree - entity association tree
+     */
+    explicit EntityNodeIndex(pldm_entity_association_tree* tree) : tree(tree)
+    {}
+
+    /** @brief Find the node of an entity, as
+     *         pldm_entity_association_tree_find_with_locality() does
+     *  @param[in] entity - entity to find
+     *  @param[in] isRemote - whether the container ID of entity is the one
+     *                        of the remote terminus
+     *  @return the node, nullptr if the tree has none
+     */
+    pldm_entity_node* find(const pldm_entity& entity, bool isRemote);
+
+    /** @brief Add an entity to the tree, as
+     *         pldm_entity_association_tree_add_entity() does, and index its
+     *         node
+     *  @return the node, nullptr if the entity couldn't be added
+     */
+    pldm_entity_node* add(const pldm_entity& entity, uint16_t instanceNumber,
+                          pldm_entity_node* parent, uint8_t associationType,
+                          bool isRemote, bool isUpdateContainerId,
+                          uint16_t containerId);
+
+  private:
+    /** @brief Pack an entity and a locality into a key */
+    static uint64_t key(const pldm_entity& entity, bool isRemote)
+    {
+        return (static_cast<uint64_t>(entity.entity_type) << 33) |
+               (static_cast<uint64_t>(entity.entity_instance_num) << 17) |
+               (static_cast<uint64_t>(entity.entity_container_id) << 1) |
+               isRemote;
+    }
+
+    /** @brief entity association tree */
+    pldm_entity_association_tree* tree;
+
+    /** @brief nodes of the tree by key */
+    std::unordered_map<uint64_t, pldm_entity_node*> nodes;
+};
+
 } // namespace utils
 } // namespace hostbmc
 } // namespace pldm
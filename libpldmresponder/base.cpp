@@ -1,5 +1,6 @@
 #include "base.hpp"
 
+#include "common/bios_utils.hpp"
 #include "common/utils.hpp"
 #include "libpldmresponder/pdr.hpp"
 
@@ -8,9 +9,11 @@
 #include <libpldm/fru.h>
 #include <libpldm/platform.h>
 
+#include <phosphor-logging/lg2.hpp>
+
 #include <array>
-#include <cstring>
 #include <map>
+#include <optional>
 #include <stdexcept>
 #include <vector>
 
@@ -19,6 +22,8 @@
 #include <libpldm/oem/ibm/host.h>
 #endif
 
+PHOSPHOR_LOG2_USING;
+
 namespace pldm
 {
 using Type = uint8_t;
@@ -39,7 +44,8 @@ static const std::map<Type, Cmd> capabilities{
     {PLDM_BIOS,
      {PLDM_GET_DATE_TIME, PLDM_SET_DATE_TIME, PLDM_GET_BIOS_TABLE,
       PLDM_GET_BIOS_ATTRIBUTE_CURRENT_VALUE_BY_HANDLE,
-      PLDM_SET_BIOS_ATTRIBUTE_CURRENT_VALUE, PLDM_SET_BIOS_TABLE}},
+      PLDM_SET_BIOS_ATTRIBUTE_CURRENT_VALUE, PLDM_SET_BIOS_TABLE,
+      pldm::bios::utils::getBIOSTableTagsCommand}},
     {PLDM_FRU,
      {PLDM_GET_FRU_RECORD_TABLE_METADATA, PLDM_GET_FRU_RECORD_TABLE,
       PLDM_GET_FRU_RECORD_BY_OPTION}},
@@ -65,9 +71,38 @@ static const std::map<Type, ver32_t> versions{
 
 namespace base
 {
-Response Handler::getPLDMTypes(const pldm_msg* request,
-                               size_t /*payloadLength*/)
+/** @brief Encode a response template
+ *
+ *  @param[in] payloadLength - length of the response payload
+ *  @param[in] encode - encoder of the response in the message given
+ *
+ *  @return the response, std::nullopt if it failed to encode
+ */
+template <typename Encoder>
+static std::optional<Response> encodeTemplate(size_t payloadLength,
+                                              Encoder encode)
 {
+    Response response(sizeof(pldm_msg_hdr) + payloadLength);
+    auto rc = encode(reinterpret_cast<pldm_msg*>(response.data()));
+    if (rc != PLDM_SUCCESS)
+    {
+        error("Failed to encode a response template, response code '{RC}'",
+              "RC", rc);
+        return std::nullopt;
+    }
+    return response;
+}
+
+const Handler::ResponseTemplates& Handler::getResponseTemplates()
+{
+    if (responseTemplates)
+    {
+        return *responseTemplates;
+    }
+
+    ResponseTemplates templates;
+    constexpr uint8_t instanceId = 0;
+
     // DSP0240 has this as a bitfield8[N], where N = 0 to 7
     std::array<bitfield8_t, 8> types{};
     for (const auto& type : capabilities)
@@ -77,27 +112,74 @@ Response Handler::getPLDMTypes(const pldm_msg* request,
         auto bit = type.first - (index * 8);
         types[index].byte |= 1 << bit;
     }
+    templates.types =
+        encodeTemplate(PLDM_GET_TYPES_RESP_BYTES, [&types](pldm_msg* msg) {
+            return encode_get_types_resp(instanceId, PLDM_SUCCESS,
+                                         types.data(), msg);
+        });
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_TYPES_RESP_BYTES, 0);
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-    auto rc = encode_get_types_resp(request->hdr.instance_id, PLDM_SUCCESS,
-                                    types.data(), responsePtr);
-    if (rc != PLDM_SUCCESS)
+    for (const auto& [type, commands] : capabilities)
     {
-        return CmdHandler::ccOnlyResponse(request, rc);
+        // DSP0240 has this as a bitfield8[N], where N = 0 to 31
+        std::array<bitfield8_t, 32> cmds{};
+        for (const auto& cmd : commands)
+        {
+            auto index = cmd / 8;
+            // <Type Number> = <Array Index> * 8 + <bit position>
+            auto bit = cmd - (index * 8);
+            cmds[index].byte |= 1 << bit;
+        }
+        templates.commands[type] = encodeTemplate(
+            PLDM_GET_COMMANDS_RESP_BYTES, [&cmds](pldm_msg* msg) {
+                return encode_get_commands_resp(instanceId, PLDM_SUCCESS,
+                                                cmds.data(), msg);
+            });
+    }
+
+    for (const auto& [type, version] : versions)
+    {
+        templates.versions[type] = encodeTemplate(
+            PLDM_GET_VERSION_RESP_BYTES, [&version](pldm_msg* msg) {
+                return encode_get_version_resp(
+                    instanceId, PLDM_SUCCESS, 0, PLDM_START_AND_END, &version,
+                    sizeof(pldm_version), msg);
+            });
+    }
+
+    templates.tid =
+        encodeTemplate(PLDM_GET_TID_RESP_BYTES, [](pldm_msg* msg) {
+            return encode_get_tid_resp(instanceId, PLDM_SUCCESS, TERMINUS_ID,
+                                       msg);
+        });
+
+    return responseTemplates.emplace(std::move(templates));
+}
+
+Response Handler::fromTemplate(const pldm_msg* request,
+                               const std::optional<Response>& responseTemplate)
+{
+    if (!responseTemplate)
+    {
+        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR);
     }
 
+    Response response(*responseTemplate);
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    responsePtr->hdr.instance_id = request->hdr.instance_id;
     return response;
 }
 
+Response Handler::getPLDMTypes(const pldm_msg* request,
+                               size_t /*payloadLength*/)
+{
+    return fromTemplate(request, getResponseTemplates().types);
+}
+
 Response Handler::getPLDMCommands(const pldm_msg* request, size_t payloadLength)
 {
     ver32_t version{};
     Type type;
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_COMMANDS_RESP_BYTES, 0);
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-
     auto rc = decode_get_commands_req(request, payloadLength, &type, &version);
 
     if (rc != PLDM_SUCCESS)
@@ -105,30 +187,15 @@ Response Handler::getPLDMCommands(const pldm_msg* request, size_t payloadLength)
         return CmdHandler::ccOnlyResponse(request, rc);
     }
 
-    // DSP0240 has this as a bitfield8[N], where N = 0 to 31
-    std::array<bitfield8_t, 32> cmds{};
-    if (!capabilities.contains(type))
+    const auto& commands = getResponseTemplates().commands;
+    auto search = commands.find(type);
+    if (search == commands.end())
     {
         return CmdHandler::ccOnlyResponse(request,
                                           PLDM_ERROR_INVALID_PLDM_TYPE);
     }
 
-    for (const auto& cmd : capabilities.at(type))
-    {
-        auto index = cmd / 8;
-        // <Type Number> = <Array Index> * 8 + <bit position>
-        auto bit = cmd - (index * 8);
-        cmds[index].byte |= 1 << bit;
-    }
-
-    rc = encode_get_commands_resp(request->hdr.instance_id, PLDM_SUCCESS,
-                                  cmds.data(), responsePtr);
-    if (rc != PLDM_SUCCESS)
-    {
-        return ccOnlyResponse(request, rc);
-    }
-
-    return response;
+    return fromTemplate(request, search->second);
 }
 
 Response Handler::getPLDMVersion(const pldm_msg* request, size_t payloadLength)
@@ -137,9 +204,6 @@ Response Handler::getPLDMVersion(const pldm_msg* request, size_t payloadLength)
     Type type;
     uint8_t transferFlag;
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_VERSION_RESP_BYTES, 0);
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-
     uint8_t rc = decode_get_version_req(request, payloadLength, &transferHandle,
                                         &transferFlag, &type);
 
@@ -148,25 +212,16 @@ Response Handler::getPLDMVersion(const pldm_msg* request, size_t payloadLength)
         return CmdHandler::ccOnlyResponse(request, rc);
     }
 
-    ver32_t version{};
-    auto search = versions.find(type);
+    const auto& versionResponses = getResponseTemplates().versions;
+    auto search = versionResponses.find(type);
 
-    if (search == versions.end())
+    if (search == versionResponses.end())
     {
         return CmdHandler::ccOnlyResponse(request,
                                           PLDM_ERROR_INVALID_PLDM_TYPE);
     }
 
-    memcpy(&version, &(search->second), sizeof(version));
-    rc = encode_get_version_resp(request->hdr.instance_id, PLDM_SUCCESS, 0,
-                                 PLDM_START_AND_END, &version,
-                                 sizeof(pldm_version), responsePtr);
-    if (rc != PLDM_SUCCESS)
-    {
-        return ccOnlyResponse(request, rc);
-    }
-
-    return response;
+    return fromTemplate(request, search->second);
 }
 
 void Handler::_processSetEventReceiver(sdeventplus::source::EventBase&
@@ -178,14 +233,7 @@ void Handler::_processSetEventReceiver(sdeventplus::source::EventBase&
 
 Response Handler::getTID(const pldm_msg* request, size_t /*payloadLength*/)
 {
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_TID_RESP_BYTES, 0);
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-    auto rc = encode_get_tid_resp(request->hdr.instance_id, PLDM_SUCCESS,
-                                  TERMINUS_ID, responsePtr);
-    if (rc != PLDM_SUCCESS)
-    {
-        return ccOnlyResponse(request, rc);
-    }
+    auto response = fromTemplate(request, getResponseTemplates().tid);
 
     if (oemPlatformHandler)
     {
@@ -7,6 +7,8 @@
 #include <sdeventplus/source/event.hpp>
 
 #include <cstdint>
+#include <map>
+#include <optional>
 #include <vector>
 
 using namespace pldm::responder;
@@ -105,6 +107,36 @@ class Handler : public CmdHandler
 
     /** @brief sdeventplus event source */
     std::unique_ptr<sdeventplus::source::Defer> survEvent;
+
+    /** @struct ResponseTemplates
+     *
+     *  Responses which only depend on the request parameters, encoded with
+     *  instance ID 0 and patched with the instance ID of each request, or
+     *  std::nullopt if they failed to encode
+     */
+    struct ResponseTemplates
+    {
+        std::optional<Response> types;
+        std::map<uint8_t, std::optional<Response>> commands;
+        std::map<uint8_t, std::optional<Response>> versions;
+        std::optional<Response> tid;
+    };
+
+    /** @brief Get the response templates, built on first use */
+    const ResponseTemplates& getResponseTemplates();
+
+    /** @brief Copy a response template for a request
+     *
+     *  @param[in] request - Request message
+     *  @param[in] responseTemplate - the response template
+     *  @return PLDM response message, a PLDM_ERROR response if the template
+     *          failed to encode
+     */
+    static Response fromTemplate(
+        const pldm_msg* request,
+        const std::optional<Response>& responseTemplate);
+
+    std::optional<ResponseTemplates> responseTemplates;
 };
 
 } // namespace base
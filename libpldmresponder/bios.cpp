@@ -1,11 +1,13 @@
 #include "bios.hpp"
 
+#include "common/bios_utils.hpp"
 #include "common/utils.hpp"
 
 #include <phosphor-logging/lg2.hpp>
 
 #include <array>
 #include <chrono>
+#include <cstring>
 #include <ctime>
 #include <stdexcept>
 #include <string>
@@ -64,6 +66,9 @@ namespace bios
 {
 using EpochTimeUS = uint64_t;
 
+/** @brief Largest BIOS table accepted with SetBIOSTable */
+constexpr size_t maxBIOSTableSize = 1024 * 1024;
+
 DBusHandler dbusHandler;
 
 Handler::Handler(
@@ -71,9 +76,20 @@ Handler::Handler(
     pldm::requester::Handler<pldm::requester::Request>* handler,
     pldm::responder::platform_config::Handler* platformConfigHandler,
     pldm::responder::bios::Callback requestPLDMServiceName) :
-    biosConfig(BIOS_JSONS_DIR, BIOS_TABLES_DIR, &dbusHandler, fd, eid,
-               instanceIdDb, handler, platformConfigHandler,
-               requestPLDMServiceName)
+    Handler(BIOS_JSONS_DIR, BIOS_TABLES_DIR, &dbusHandler, fd, eid,
+            instanceIdDb, handler, platformConfigHandler,
+            requestPLDMServiceName)
+{}
+
+Handler::Handler(
+    const char* jsonDir, const char* tableDir,
+    pldm::utils::DBusHandler* biosDBusHandler, int fd, uint8_t eid,
+    pldm::InstanceIdDb* instanceIdDb,
+    pldm::requester::Handler<pldm::requester::Request>* handler,
+    pldm::responder::platform_config::Handler* platformConfigHandler,
+    pldm::responder::bios::Callback requestPLDMServiceName) :
+    biosConfig(jsonDir, tableDir, biosDBusHandler, fd, eid, instanceIdDb,
+               handler, platformConfigHandler, requestPLDMServiceName)
 {
     handlers.emplace(
         PLDM_SET_DATE_TIME,
@@ -87,13 +103,20 @@ Handler::Handler(
         });
     handlers.emplace(
         PLDM_GET_BIOS_TABLE,
+        [this](pldm_tid_t tid, const pldm_msg* request,
+               size_t payloadLength) {
+            return this->getBIOSTable(tid, request, payloadLength);
+        });
+    handlers.emplace(
+        pldm::bios::utils::getBIOSTableTagsCommand,
         [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
-            return this->getBIOSTable(request, payloadLength);
+            return this->getBIOSTableTags(request, payloadLength);
         });
     handlers.emplace(
         PLDM_SET_BIOS_TABLE,
-        [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
-            return this->setBIOSTable(request, payloadLength);
+        [this](pldm_tid_t tid, const pldm_msg* request,
+               size_t payloadLength) {
+            return this->setBIOSTable(tid, request, payloadLength);
         });
     handlers.emplace(
         PLDM_GET_BIOS_ATTRIBUTE_CURRENT_VALUE_BY_HANDLE,
@@ -119,7 +142,7 @@ Response Handler::getDateTime(const pldm_msg* request, size_t /*payloadLength*/)
 
     constexpr auto timeInterface = "xyz.openbmc_project.Time.EpochTime";
     constexpr auto bmcTimePath = "/xyz/openbmc_project/time/bmc";
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_DATE_TIME_RESP_BYTES, 0);
+    auto response = makeResponse(PLDM_GET_DATE_TIME_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     EpochTimeUS timeUsec;
 
@@ -224,7 +247,8 @@ Response Handler::setDateTime(const pldm_msg* request, size_t payloadLength)
     return ccOnlyResponse(request, PLDM_SUCCESS);
 }
 
-Response Handler::getBIOSTable(const pldm_msg* request, size_t payloadLength)
+Response Handler::getBIOSTable(pldm_tid_t tid, const pldm_msg* request,
+                               size_t payloadLength)
 {
     uint32_t transferHandle{};
     uint8_t transferOpFlag{};
@@ -236,21 +260,75 @@ Response Handler::getBIOSTable(const pldm_msg* request, size_t payloadLength)
     {
         return ccOnlyResponse(request, rc);
     }
-
-    auto table =
-        biosConfig.getBIOSTable(static_cast<pldm_bios_table_types>(tableType));
-    if (!table)
+    if (tableType > PLDM_BIOS_ATTR_VAL_TABLE)
     {
         return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
     }
 
-    Response response(sizeof(pldm_msg_hdr) +
-                      PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES + table->size());
+    // The transfer handle is the offset of the part in the table, each
+    // requester reads its own snapshot
+    TransferKey key{tid, tableType};
+    std::shared_ptr<const Table> table;
+    if (transferOpFlag == PLDM_GET_FIRSTPART)
+    {
+        getTransfers.erase(key);
+        table =
+            biosConfig.getTable(static_cast<pldm_bios_table_types>(tableType));
+        if (!table)
+        {
+            return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
+        }
+        transferHandle = 0;
+    }
+    else
+    {
+        auto it = getTransfers.find(key);
+        if (transferOpFlag != PLDM_GET_NEXTPART || it == getTransfers.end() ||
+            !transferHandle || transferHandle >= it->second->size())
+        {
+            return ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+        }
+        table = it->second;
+    }
+
+    size_t length = table->size() - transferHandle;
+    if (tableTransferSize && length > tableTransferSize)
+    {
+        length = tableTransferSize;
+    }
+    uint32_t nextTransferHandle = transferHandle + length;
+    bool last = nextTransferHandle == table->size();
+    uint8_t transferFlag{};
+    if (!transferHandle)
+    {
+        transferFlag = last ? PLDM_START_AND_END : PLDM_START;
+    }
+    else
+    {
+        transferFlag = last ? PLDM_END : PLDM_MIDDLE;
+    }
+
+    auto response = makeResponse(PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES + length);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
-    rc = encode_get_bios_table_resp(
-        request->hdr.instance_id, PLDM_SUCCESS, 0 /* nxtTransferHandle */,
-        PLDM_START_AND_END, table->data(), response.size(), responsePtr);
+    // The table is a shared read-only snapshot, the encoder only fills in
+    // the fixed fields and the part is copied after them
+    rc = encode_get_bios_table_resp(request->hdr.instance_id, PLDM_SUCCESS,
+                                    last ? 0 : nextTransferHandle, transferFlag,
+                                    nullptr, response.size(), responsePtr);
+    if (rc == PLDM_SUCCESS)
+    {
+        std::memcpy(responsePtr->payload + PLDM_GET_BIOS_TABLE_MIN_RESP_BYTES,
+                    table->data() + transferHandle, length);
+    }
+    if (last)
+    {
+        getTransfers.erase(key);
+    }
+    else
+    {
+        getTransfers.insert_or_assign(key, std::move(table));
+    }
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
@@ -259,7 +337,48 @@ Response Handler::getBIOSTable(const pldm_msg* request, size_t payloadLength)
     return response;
 }
 
-Response Handler::setBIOSTable(const pldm_msg* request, size_t payloadLength)
+Response Handler::getBIOSTableTags(const pldm_msg* request,
+                                   size_t payloadLength)
+{
+    // NumberOfTables, then the type of each table
+    if (payloadLength < 1 || payloadLength != 1U + request->payload[0])
+    {
+        return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+    }
+    auto count = request->payload[0];
+
+    auto response = makeResponse(1 + count * sizeof(uint32_t));
+    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+    pldm_header_info header{};
+    header.msg_type = PLDM_RESPONSE;
+    header.instance = request->hdr.instance_id;
+    header.pldm_type = PLDM_BIOS;
+    header.command = pldm::bios::utils::getBIOSTableTagsCommand;
+    if (pack_pldm_header(&header, &responsePtr->hdr) != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, PLDM_ERROR);
+    }
+
+    responsePtr->payload[0] = PLDM_SUCCESS;
+    for (size_t i = 0; i < count; i++)
+    {
+        auto table = biosConfig.getTable(
+            static_cast<pldm_bios_table_types>(request->payload[1 + i]));
+        auto tag = table ? pldm::bios::utils::getTableTag(*table)
+                         : std::nullopt;
+        if (!tag)
+        {
+            return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
+        }
+        auto value = htole32(*tag);
+        std::memcpy(responsePtr->payload + 1 + i * sizeof(value), &value,
+                    sizeof(value));
+    }
+    return response;
+}
+
+Response Handler::setBIOSTable(pldm_tid_t tid, const pldm_msg* request,
+                               size_t payloadLength)
 {
     uint32_t transferHandle{};
     uint8_t transferOpFlag{};
@@ -272,19 +391,64 @@ Response Handler::setBIOSTable(const pldm_msg* request, size_t payloadLength)
     {
         return ccOnlyResponse(request, rc);
     }
+    if (tableType > PLDM_BIOS_ATTR_VAL_TABLE)
+    {
+        return ccOnlyResponse(request, PLDM_INVALID_BIOS_TABLE_TYPE);
+    }
 
-    Table table(field.ptr, field.ptr + field.length);
-    rc = biosConfig.setBIOSTable(tableType, table);
-    if (rc != PLDM_SUCCESS)
+    // The parts are staged by requester until the last one, the transfer
+    // handle is the offset of the part in the table
+    TransferKey key{tid, tableType};
+    auto staged = setTransfers.find(key);
+    if (transferOpFlag == PLDM_START || transferOpFlag == PLDM_START_AND_END)
     {
-        return ccOnlyResponse(request, rc);
+        staged = setTransfers.insert_or_assign(key, Table{}).first;
+    }
+    else if ((transferOpFlag != PLDM_MIDDLE && transferOpFlag != PLDM_END) ||
+             staged == setTransfers.end() ||
+             transferHandle != staged->second.size())
+    {
+        setTransfers.erase(key);
+        return ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
+    }
+
+    auto& parts = staged->second;
+    if (parts.size() + field.length > maxBIOSTableSize)
+    {
+        setTransfers.erase(staged);
+        return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+    }
+    parts.insert(parts.end(), field.ptr, field.ptr + field.length);
+
+    uint32_t nextTransferHandle = 0;
+    if (transferOpFlag == PLDM_START || transferOpFlag == PLDM_MIDDLE)
+    {
+        nextTransferHandle = parts.size();
+    }
+    else
+    {
+        Table table = std::move(parts);
+        setTransfers.erase(staged);
+        if (tableType == PLDM_BIOS_ATTR_VAL_TABLE)
+        {
+            rc = biosConfig.checkAttrValues(table);
+            if (rc != PLDM_SUCCESS)
+            {
+                return ccOnlyResponse(request, rc);
+            }
+        }
+        rc = biosConfig.setBIOSTable(tableType, std::move(table));
+        if (rc != PLDM_SUCCESS)
+        {
+            return ccOnlyResponse(request, rc);
+        }
     }
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_SET_BIOS_TABLE_RESP_BYTES);
+    auto response = makeResponse(PLDM_SET_BIOS_TABLE_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_set_bios_table_resp(request->hdr.instance_id, PLDM_SUCCESS,
-                                    0 /* nxtTransferHandle */, responsePtr);
+                                    nextTransferHandle, responsePtr);
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
@@ -308,7 +472,7 @@ Response Handler::getBIOSAttributeCurrentValueByHandle(const pldm_msg* request,
         return ccOnlyResponse(request, rc);
     }
 
-    auto table = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    auto table = biosConfig.getTable(PLDM_BIOS_ATTR_VAL_TABLE);
     if (!table)
     {
         return ccOnlyResponse(request, PLDM_BIOS_TABLE_UNAVAILABLE);
@@ -322,10 +486,8 @@ Response Handler::getBIOSAttributeCurrentValueByHandle(const pldm_msg* request,
     }
 
     auto entryLength = pldm_bios_table_attr_value_entry_length(entry);
-    Response response(sizeof(pldm_msg_hdr) +
-                          PLDM_GET_BIOS_ATTR_CURR_VAL_BY_HANDLE_MIN_RESP_BYTES +
-                          entryLength,
-                      0);
+    auto response = makeResponse(
+        PLDM_GET_BIOS_ATTR_CURR_VAL_BY_HANDLE_MIN_RESP_BYTES + entryLength);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     rc = encode_get_bios_current_value_by_handle_resp(
         request->hdr.instance_id, PLDM_SUCCESS, 0, PLDM_START_AND_END,
@@ -356,8 +518,7 @@ Response Handler::setBIOSAttributeCurrentValue(const pldm_msg* request,
     rc = biosConfig.setAttrValue(attributeField.ptr, attributeField.length,
                                  false);
 
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_SET_BIOS_ATTR_CURR_VAL_RESP_BYTES, 0);
+    auto response = makeResponse(PLDM_SET_BIOS_ATTR_CURR_VAL_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     encode_set_bios_attribute_current_value_resp(request->hdr.instance_id, rc,
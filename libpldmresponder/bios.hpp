@@ -14,8 +14,12 @@
 #include <ctime>
 #include <functional>
 #include <map>
+#include <memory>
+#include <utility>
 #include <vector>
 
+class TestBIOSHandler;
+
 namespace pldm
 {
 
@@ -43,6 +47,26 @@ class Handler : public CmdHandler
             pldm::responder::platform_config::Handler* platformConfigHandler,
             pldm::responder::bios::Callback requestPLDMServiceName);
 
+    /** @brief Constructor
+     *
+     *  @param[in] jsonDir - directory of the BIOS attribute JSONs
+     *  @param[in] tableDir - directory the BIOS tables are persisted in
+     *  @param[in] biosDBusHandler - D-Bus handler of the BIOS attributes
+     *  @param[in] fd - socket descriptor to communicate to host
+     *  @param[in] eid - MCTP EID of host firmware
+     *  @param[in] instanceIdDb - pointer to an InstanceIdDb object
+     *  @param[in] handler - PLDM request handler
+     *  @param[in] platformConfigHandler - pointer to platform config object
+     *  @param[in] requestPLDMServiceName - Callback for registering the PLDM
+     *                                      service
+     */
+    Handler(const char* jsonDir, const char* tableDir,
+            pldm::utils::DBusHandler* biosDBusHandler, int fd, uint8_t eid,
+            pldm::InstanceIdDb* instanceIdDb,
+            pldm::requester::Handler<pldm::requester::Request>* handler,
+            pldm::responder::platform_config::Handler* platformConfigHandler,
+            pldm::responder::bios::Callback requestPLDMServiceName);
+
     /** @brief Handler for GetDateTime
      *
      *  @param[in] request - Request message payload
@@ -52,19 +76,32 @@ class Handler : public CmdHandler
 
     /** @brief Handler for GetBIOSTable
      *
+     *  @param[in] tid - TID of the requester
      *  @param[in] request - Request message
      *  @param[in] payload_length - Request message payload length
      *  @return Response - PLDM Response message
      */
-    Response getBIOSTable(const pldm_msg* request, size_t payloadLength);
+    Response getBIOSTable(pldm_tid_t tid, const pldm_msg* request,
+                          size_t payloadLength);
+
+    /** @brief Handler for GetBIOSTableTags, returning the CRC32 checksum of
+     *         each requested table
+     *
+     *  @param[in] request - Request message
+     *  @param[in] payloadLength - Request message payload length
+     *  @return Response - PLDM Response message
+     */
+    Response getBIOSTableTags(const pldm_msg* request, size_t payloadLength);
 
     /** @brief Handler for SetBIOSTable
      *
+     *  @param[in] tid - TID of the requester
      *  @param[in] request - Request message
      *  @param[in] payload_length - Request message payload length
      *  @return Response - PLDM Response message
      */
-    Response setBIOSTable(const pldm_msg* request, size_t payloadLength);
+    Response setBIOSTable(pldm_tid_t tid, const pldm_msg* request,
+                          size_t payloadLength);
 
     /** @brief Handler for GetBIOSAttributeCurrentValueByHandle
      *
@@ -93,7 +130,23 @@ class Handler : public CmdHandler
                                           size_t payloadLength);
 
   private:
+    friend class ::TestBIOSHandler;
+
+    /** @brief A multipart transfer, by requester TID and table type */
+    using TransferKey = std::pair<pldm_tid_t, uint8_t>;
+
     BIOSConfig biosConfig;
+
+    /** @brief Maximum size of a part of a table, 0 for no limit */
+    size_t tableTransferSize = BIOS_TABLE_TRANSFER_SIZE;
+
+    /** @brief Snapshot of each table being read with GetBIOSTable, the parts
+     *         of a multipart transfer are served from the same snapshot
+     */
+    std::map<TransferKey, std::shared_ptr<const Table>> getTransfers;
+
+    /** @brief Parts of each table received so far with SetBIOSTable */
+    std::map<TransferKey, Table> setTransfers;
 };
 
 } // namespace bios
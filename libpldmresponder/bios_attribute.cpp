@@ -3,8 +3,13 @@
 #include "bios_config.hpp"
 #include "common/utils.hpp"
 
+#include <phosphor-logging/lg2.hpp>
+
+#include <stdexcept>
 #include <variant>
 
+PHOSPHOR_LOG2_USING;
+
 using namespace pldm::utils;
 
 namespace pldm
@@ -14,15 +19,70 @@ namespace responder
 namespace bios
 {
 
-BIOSAttribute::BIOSAttribute(const Json& entry,
-                             DBusHandler* const dbusHandler) :
-    name(entry.at("attribute_name")), readOnly(false),
-    displayName(entry.at("display_name")), helpText(entry.at("help_text")),
-    dbusHandler(dbusHandler)
+namespace
+{
+
+/** @brief Convert the D-Bus value of a possible value of an enum attribute */
+PropertyValue toDbusValue(const std::string& type, const Json& value)
+{
+    if (type == "uint8_t")
+    {
+        return static_cast<uint8_t>(value);
+    }
+    else if (type == "uint16_t")
+    {
+        return static_cast<uint16_t>(value);
+    }
+    else if (type == "uint32_t")
+    {
+        return static_cast<uint32_t>(value);
+    }
+    else if (type == "uint64_t")
+    {
+        return static_cast<uint64_t>(value);
+    }
+    else if (type == "int16_t")
+    {
+        return static_cast<int16_t>(value);
+    }
+    else if (type == "int32_t")
+    {
+        return static_cast<int32_t>(value);
+    }
+    else if (type == "int64_t")
+    {
+        return static_cast<int64_t>(value);
+    }
+    else if (type == "bool")
+    {
+        return static_cast<bool>(value);
+    }
+    else if (type == "double")
+    {
+        return static_cast<double>(value);
+    }
+    else if (type == "string")
+    {
+        return static_cast<std::string>(value);
+    }
+    error("Unknown D-Bus property type '{TYPE}'", "TYPE", type);
+    throw std::invalid_argument("Unknown D-BUS property type");
+}
+
+} // namespace
+
+AttributeSchema AttributeSchema::fromJson(const Json& entry,
+                                          const std::string& type)
 {
+    AttributeSchema schema;
+    schema.type = type;
+    schema.name = entry.at("attribute_name");
+    schema.displayName = entry.at("display_name");
+    schema.helpText = entry.at("help_text");
+
     try
     {
-        readOnly = entry.at("read_only");
+        schema.readOnly = entry.at("read_only");
     }
     catch (const std::exception&)
     {
@@ -36,19 +96,91 @@ BIOSAttribute::BIOSAttribute(const Json& entry,
         std::string propertyName = entry.at("dbus").at("property_name");
         std::string propertyType = entry.at("dbus").at("property_type");
 
-        dBusMap = {objectPath, interface, propertyName, propertyType};
+        schema.dBusMap = {objectPath, interface, propertyName, propertyType};
     }
     catch (const std::exception&)
     {
         // No action required, dBusMap will have no value
     }
+
+    if (type == "string")
+    {
+        schema.stringType = entry.at("string_type");
+        schema.minLength = entry.at("minimum_string_length");
+        schema.maxLength = entry.at("maximum_string_length");
+        schema.defaultString = entry.at("default_string");
+    }
+    else if (type == "integer")
+    {
+        schema.lowerBound = entry.at("lower_bound");
+        schema.upperBound = entry.at("upper_bound");
+        schema.scalarIncrement = entry.at("scalar_increment");
+        schema.defaultValue = entry.at("default_value");
+    }
+    else if (type == "enum")
+    {
+        for (const auto& value : entry.at("possible_values"))
+        {
+            schema.possibleValues.emplace_back(value);
+        }
+        for (const auto& value : entry.at("default_values"))
+        {
+            schema.defaultValues.emplace_back(value);
+        }
+        for (const auto& value : entry.at("value_names"))
+        {
+            schema.valueNames.emplace_back(value);
+        }
+        if (schema.dBusMap)
+        {
+            for (const auto& value :
+                 entry.at("dbus").at("property_values"))
+            {
+                schema.dbusValues.emplace_back(
+                    toDbusValue(schema.dBusMap->propertyType, value));
+            }
+        }
+    }
+    return schema;
 }
 
+BIOSAttribute::BIOSAttribute(const AttributeSchema& schema,
+                             DBusHandler* const dbusHandler) :
+    name(schema.name), readOnly(schema.readOnly),
+    displayName(schema.displayName), helpText(schema.helpText),
+    dBusMap(schema.dBusMap), dbusHandler(dbusHandler)
+{}
+
 std::optional<DBusMapping> BIOSAttribute::getDBusMap()
 {
     return dBusMap;
 }
 
+void BIOSAttribute::setPrefetchedValue(std::optional<PropertyValue> value)
+{
+    prefetchedValue = std::move(value);
+    prefetched = true;
+}
+
+PropertyValue BIOSAttribute::getDbusPropertyValue()
+{
+    if (prefetched)
+    {
+        prefetched = false;
+        if (!prefetchedValue)
+        {
+            throw std::runtime_error("Failed to read the D-Bus property");
+        }
+        auto value = std::move(*prefetchedValue);
+        prefetchedValue.reset();
+        return value;
+    }
+
+    return dbusHandler->getDbusPropertyVariant(dBusMap->objectPath.c_str(),
+                                               dBusMap->propertyName.c_str(),
+                                               dBusMap->interface.c_str());
+}
+
 } // namespace bios
 } // namespace responder
 } // namespace pldm
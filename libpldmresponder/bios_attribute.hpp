@@ -24,6 +24,50 @@ namespace bios
 using Json = nlohmann::json;
 using ValueDisplayNamesMap = std::map<uint16_t, std::vector<std::string>>;
 
+/** @struct AttributeSchema
+ *  @brief Fields of an entry of the BIOS attribute JSON file, the attributes
+ *         are constructed from them. The fields of the other attribute
+ *         types are left empty.
+ */
+struct AttributeSchema
+{
+    /** @brief Parse an entry of the BIOS attribute JSON file
+     *  @param[in] entry - Json Object
+     *  @param[in] type - attribute type, "string", "integer" or "enum"
+     *  @return the fields of the entry
+     */
+    static AttributeSchema fromJson(const Json& entry, const std::string& type);
+
+    std::string type;
+    std::string name;
+    std::string displayName;
+    std::string helpText;
+    bool readOnly = false;
+    std::optional<pldm::utils::DBusMapping> dBusMap;
+
+    /** @brief Fields of a string attribute */
+    std::string stringType;
+    uint16_t minLength = 0;
+    uint16_t maxLength = 0;
+    std::string defaultString;
+
+    /** @brief Fields of an integer attribute */
+    uint64_t lowerBound = 0;
+    uint64_t upperBound = 0;
+    uint32_t scalarIncrement = 0;
+    uint64_t defaultValue = 0;
+
+    /** @brief Fields of an enum attribute, dbusValues holds the D-Bus value
+     *         of each possible value when the attribute is mapped to D-Bus
+     */
+    std::vector<std::string> possibleValues;
+    std::vector<std::string> defaultValues;
+    std::vector<std::string> valueNames;
+    std::vector<pldm::utils::PropertyValue> dbusValues;
+};
+
+using AttributeSchemas = std::vector<AttributeSchema>;
+
 /** @class BIOSAttribute
  *  @brief Provide interfaces to implement specific types of attributes
  */
@@ -31,10 +75,10 @@ class BIOSAttribute
 {
   public:
     /** @brief Construct a bios attribute
-     *  @param[in] entry - Json Object
+     *  @param[in] schema - fields of the attribute
      *  @param[in] dbusHandler - Dbus Handler
      */
-    BIOSAttribute(const Json& entry,
+    BIOSAttribute(const AttributeSchema& schema,
                   pldm::utils::DBusHandler* const dbusHandler);
 
     /** Virtual destructor
@@ -90,6 +134,14 @@ class BIOSAttribute
     /** @brief Method to return the D-Bus map */
     std::optional<pldm::utils::DBusMapping> getDBusMap();
 
+    /** @brief Provide the value of the D-Bus property, read ahead of the
+     *         construction of the table entries. It replaces the next read
+     *         of the property.
+     *  @param[in] value - the value of the D-Bus property, std::nullopt if
+     *                     the read failed
+     */
+    void setPrefetchedValue(std::optional<pldm::utils::PropertyValue> value);
+
     /** @brief Type of the attribute */
     const std::string type;
 
@@ -106,11 +158,26 @@ class BIOSAttribute
     ValueDisplayNamesMap valueDisplayNamesMap;
 
   protected:
+    /** @brief Read the value of the D-Bus property, the prefetched value if
+     *         there is one
+     *  @return the value of the D-Bus property
+     */
+    pldm::utils::PropertyValue getDbusPropertyValue();
+
     /** @brief dbus backend, nullopt if this attribute is read-only*/
     std::optional<pldm::utils::DBusMapping> dBusMap;
 
     /** @brief dbus handler */
     pldm::utils::DBusHandler* const dbusHandler;
+
+  private:
+    /** @brief Prefetched value of the D-Bus property */
+    std::optional<pldm::utils::PropertyValue> prefetchedValue;
+
+    /** @brief The next read is served by the prefetch, which may have
+     *         failed
+     */
+    bool prefetched = false;
 };
 
 } // namespace bios
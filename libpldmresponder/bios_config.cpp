@@ -5,12 +5,17 @@
 #include "bios_string_attribute.hpp"
 #include "bios_table.hpp"
 #include "common/bios_utils.hpp"
+#include "common/json_cache.hpp"
 
 #include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/event.hpp>
 #include <xyz/openbmc_project/BIOSConfig/Manager/server.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
-#include <fstream>
+#include <span>
+#include <tuple>
 
 #ifdef OEM_IBM
 #include "oem/ibm/libpldmresponder/platform_oem_ibm.hpp"
@@ -36,6 +41,7 @@ constexpr auto attributesJsonFile = "bios_attrs.json";
 constexpr auto stringTableFile = "stringTable";
 constexpr auto attrTableFile = "attributeTable";
 constexpr auto attrValueTableFile = "attributeValueTable";
+constexpr auto schemaCacheFile = "schemaCache";
 
 } // namespace
 
@@ -52,6 +58,9 @@ BIOSConfig::BIOSConfig(
 {
     fs::create_directories(tableDir);
     removeTables();
+#ifdef BIOS_SCHEMA_CACHE
+    schemaCache = BIOSSchemaCache(this->tableDir / schemaCacheFile);
+#endif
 
 #ifdef SYSTEM_SPECIFIC_BIOS_JSON
     checkSystemTypeAvailability();
@@ -107,38 +116,184 @@ void BIOSConfig::initBIOSAttributes(const std::string& systemType,
 
 void BIOSConfig::buildTables()
 {
-    auto stringTable = buildAndStoreStringTable();
-    if (stringTable)
+    if (buildAndStoreStringTable())
     {
-        buildAndStoreAttrTables(*stringTable);
+        buildAndStoreAttrTables();
     }
 }
 
 std::optional<Table> BIOSConfig::getBIOSTable(pldm_bios_table_types tableType)
 {
-    fs::path tablePath;
+    auto table = getTable(tableType);
+    if (!table)
+    {
+        return std::nullopt;
+    }
+    return *table;
+}
+
+std::shared_ptr<const Table> BIOSConfig::getTable(
+    pldm_bios_table_types tableType)
+{
+    if (tableType > PLDM_BIOS_ATTR_VAL_TABLE)
+    {
+        return nullptr;
+    }
+    auto& table = tables[tableType];
+    if (!table)
+    {
+        if (auto loaded = loadTable(tablePath(tableType)))
+        {
+            table = std::make_shared<const Table>(std::move(*loaded));
+        }
+    }
+    return table;
+}
+
+fs::path BIOSConfig::tablePath(pldm_bios_table_types tableType) const
+{
     switch (tableType)
     {
         case PLDM_BIOS_STRING_TABLE:
-            tablePath = tableDir / stringTableFile;
-            break;
+            return tableDir / stringTableFile;
         case PLDM_BIOS_ATTR_TABLE:
-            tablePath = tableDir / attrTableFile;
-            break;
+            return tableDir / attrTableFile;
         case PLDM_BIOS_ATTR_VAL_TABLE:
-            tablePath = tableDir / attrValueTableFile;
-            break;
+            return tableDir / attrValueTableFile;
     }
-    return loadTable(tablePath);
+    return {};
 }
 
-int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
-                             bool updateBaseBIOSTable)
+void BIOSConfig::setTable(pldm_bios_table_types tableType, Table&& table)
+{
+    tables[tableType] = std::make_shared<const Table>(std::move(table));
+    unpersisted[tableType] = true;
+    if (tableType == PLDM_BIOS_STRING_TABLE)
+    {
+        stringTableView.reset();
+    }
+    else if (tableType == PLDM_BIOS_ATTR_TABLE)
+    {
+        attrTableIndex.reset();
+    }
+    if (!persistEvent)
+    {
+        persistEvent = std::make_unique<sdeventplus::source::Defer>(
+            sdeventplus::Event::get_default(),
+            [this](sdeventplus::source::EventBase&) { persistTables(); });
+    }
+}
+
+const BIOSStringTable* BIOSConfig::getStringTable()
+{
+    if (!stringTableView)
+    {
+        auto table = getTable(PLDM_BIOS_STRING_TABLE);
+        if (!table)
+        {
+            return nullptr;
+        }
+        stringTableView.emplace(std::move(table));
+    }
+    return &*stringTableView;
+}
+
+const BIOSConfig::AttrTableIndex* BIOSConfig::getAttrTableIndex()
+{
+    auto table = getTable(PLDM_BIOS_ATTR_TABLE);
+    if (!table)
+    {
+        return nullptr;
+    }
+    if (attrTableIndex)
+    {
+        return &*attrTableIndex;
+    }
+
+    auto& index = attrTableIndex.emplace();
+    for (auto entry : pldm::bios::utils::BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(
+             table->data(), table->size()))
+    {
+        auto header = table::attribute::decodeHeader(entry);
+        auto offset = reinterpret_cast<const uint8_t*>(entry) - table->data();
+        index.byHandle.emplace(header.attrHandle, offset);
+        index.byStringHandle.emplace(header.stringHandle, offset);
+
+        AttrValueLimits limits{header.attrType, 0, 0};
+        switch (header.attrType)
+        {
+            case PLDM_BIOS_ENUMERATION:
+            case PLDM_BIOS_ENUMERATION_READ_ONLY:
+            {
+                uint8_t pvNum = 0;
+                // Preconditions are upheld therefore no error check necessary
+                pldm_bios_table_attr_entry_enum_decode_pv_num(entry, &pvNum);
+                limits.upper = pvNum;
+                break;
+            }
+            case PLDM_BIOS_INTEGER:
+            case PLDM_BIOS_INTEGER_READ_ONLY:
+            {
+                auto [lower, upper, scalar,
+                      def] = table::attribute::decodeIntegerEntry(entry);
+                limits.lower = lower;
+                limits.upper = upper;
+                break;
+            }
+            case PLDM_BIOS_STRING:
+            case PLDM_BIOS_STRING_READ_ONLY:
+            {
+                limits.lower =
+                    pldm_bios_table_attr_entry_string_decode_min_length(entry);
+                limits.upper =
+                    pldm_bios_table_attr_entry_string_decode_max_length(entry);
+                break;
+            }
+            default:
+                break;
+        }
+        index.limits.emplace(header.attrHandle, limits);
+    }
+    return &*attrTableIndex;
+}
+
+const pldm_bios_attr_table_entry* BIOSConfig::findAttrEntry(
+    uint16_t handle, bool byStringHandle)
 {
-    fs::path stringTablePath(tableDir / stringTableFile);
-    fs::path attrTablePath(tableDir / attrTableFile);
-    fs::path attrValueTablePath(tableDir / attrValueTableFile);
+    auto index = getAttrTableIndex();
+    if (!index)
+    {
+        return nullptr;
+    }
+
+    const auto& offsets =
+        byStringHandle ? index->byStringHandle : index->byHandle;
+    auto it = offsets.find(handle);
+    if (it == offsets.end())
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const pldm_bios_attr_table_entry*>(
+        getTable(PLDM_BIOS_ATTR_TABLE)->data() + it->second);
+}
+
+void BIOSConfig::persistTables()
+{
+    persistEvent.reset();
+    for (auto tableType : {PLDM_BIOS_STRING_TABLE, PLDM_BIOS_ATTR_TABLE,
+                           PLDM_BIOS_ATTR_VAL_TABLE})
+    {
+        if (unpersisted[tableType] && tables[tableType])
+        {
+            storeTable(tablePath(tableType), *tables[tableType]);
+        }
+        unpersisted[tableType] = false;
+    }
+}
 
+int BIOSConfig::setBIOSTable(uint8_t tableType, Table table,
+                             bool updateBaseBIOSTable)
+{
     if (!pldm_bios_table_checksum(table.data(), table.size()))
     {
         return PLDM_INVALID_BIOS_TABLE_DATA_INTEGRITY_CHECK;
@@ -146,12 +301,11 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
 
     if (tableType == PLDM_BIOS_STRING_TABLE)
     {
-        storeTable(stringTablePath, table);
+        setTable(PLDM_BIOS_STRING_TABLE, std::move(table));
     }
     else if (tableType == PLDM_BIOS_ATTR_TABLE)
     {
-        BIOSTable biosStringTable(stringTablePath.c_str());
-        if (biosStringTable.isEmpty())
+        if (!getTable(PLDM_BIOS_STRING_TABLE))
         {
             return PLDM_INVALID_BIOS_TABLE_TYPE;
         }
@@ -162,24 +316,18 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
             return rc;
         }
 
-        storeTable(attrTablePath, table);
+        setTable(PLDM_BIOS_ATTR_TABLE, std::move(table));
     }
     else if (tableType == PLDM_BIOS_ATTR_VAL_TABLE)
     {
-        BIOSTable biosStringTable(stringTablePath.c_str());
-        BIOSTable biosStringValueTable(attrTablePath.c_str());
-        if (biosStringTable.isEmpty() || biosStringValueTable.isEmpty())
+        if (!getTable(PLDM_BIOS_STRING_TABLE) ||
+            !getTable(PLDM_BIOS_ATTR_TABLE))
         {
             return PLDM_INVALID_BIOS_TABLE_TYPE;
         }
 
-        auto rc = checkAttributeValueTable(table);
-        if (rc != PLDM_SUCCESS)
-        {
-            return rc;
-        }
-
-        storeTable(attrValueTablePath, table);
+        buildBaseBIOSTableMaps(table);
+        setTable(PLDM_BIOS_ATTR_VAL_TABLE, std::move(table));
     }
     else
     {
@@ -197,7 +345,7 @@ int BIOSConfig::setBIOSTable(uint8_t tableType, const Table& table,
 int BIOSConfig::checkAttributeTable(const Table& table)
 {
     using namespace pldm::bios::utils;
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    auto stringTable = getTable(PLDM_BIOS_STRING_TABLE);
     for (auto entry :
          BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(table.data(), table.size()))
     {
@@ -269,11 +417,11 @@ int BIOSConfig::checkAttributeTable(const Table& table)
     return PLDM_SUCCESS;
 }
 
-int BIOSConfig::checkAttributeValueTable(const Table& table)
+void BIOSConfig::buildBaseBIOSTableMaps(const Table& table)
 {
     using namespace pldm::bios::utils;
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+    auto stringTable = getTable(PLDM_BIOS_STRING_TABLE);
+    auto attrTable = getTable(PLDM_BIOS_ATTR_TABLE);
 
     baseBIOSTableMaps.clear();
 
@@ -302,7 +450,7 @@ int BIOSConfig::checkAttributeValueTable(const Table& table)
             attrTable->data(), attrTable->size(), attrValueHandle);
         if (attrEntry == nullptr)
         {
-            return PLDM_INVALID_BIOS_ATTR_HANDLE;
+            continue;
         }
         auto attrHandle =
             pldm_bios_table_attr_entry_decode_attribute_handle(attrEntry);
@@ -313,7 +461,7 @@ int BIOSConfig::checkAttributeValueTable(const Table& table)
             stringTable->data(), stringTable->size(), attrNameHandle);
         if (stringEntry == nullptr)
         {
-            return PLDM_INVALID_BIOS_ATTR_HANDLE;
+            continue;
         }
         auto strLength =
             pldm_bios_table_string_entry_decode_string_length(stringEntry);
@@ -488,7 +636,7 @@ int BIOSConfig::checkAttributeValueTable(const Table& table)
                 break;
             }
             default:
-                return PLDM_INVALID_BIOS_ATTR_HANDLE;
+                continue;
         }
         baseBIOSTableMaps.emplace(
             std::move(attributeName),
@@ -496,8 +644,6 @@ int BIOSConfig::checkAttributeValueTable(const Table& table)
                             description, menuPath, currentValue, defaultValue,
                             std::move(options)));
     }
-
-    return PLDM_SUCCESS;
 }
 
 void BIOSConfig::updateBaseBIOSTableProperty()
@@ -514,6 +660,56 @@ void BIOSConfig::updateBaseBIOSTableProperty()
         return;
     }
 
+    // Unless the attribute table was replaced, only the current values can
+    // differ from the published ones
+    auto attrTable = getTable(PLDM_BIOS_ATTR_TABLE);
+    bool sameAttributes =
+        attrTable && publishedAttrTable.lock() == attrTable &&
+        baseBIOSTableMaps.size() == publishedValues.size();
+    BaseBIOSTable changed{};
+    for (const auto& [name, attr] : baseBIOSTableMaps)
+    {
+        if (!sameAttributes)
+        {
+            break;
+        }
+        const auto& value =
+            std::get<static_cast<uint8_t>(Index::currentValue)>(attr);
+        auto it = publishedValues.find(name);
+        if (it == publishedValues.end())
+        {
+            sameAttributes = false;
+        }
+        else if (it->second != value)
+        {
+            changed.emplace(name, attr);
+        }
+    }
+    if (sameAttributes && changed.empty())
+    {
+        return;
+    }
+
+    auto setPublished = [this, &attrTable]() {
+        publishedValues.clear();
+        for (const auto& [name, attr] : baseBIOSTableMaps)
+        {
+            publishedValues.emplace(
+                name,
+                std::get<static_cast<uint8_t>(Index::currentValue)>(attr));
+        }
+        publishedAttrTable = attrTable;
+    };
+
+#ifdef BIOS_ATTRIBUTE_DELTA_SIGNAL
+    // Only the current values changed, consumers follow the signal
+    if (sameAttributes && emitBaseBIOSTableChanged(changed))
+    {
+        setPublished();
+        return;
+    }
+#endif
+
     try
     {
         auto& bus = dbusHandler->getBus();
@@ -521,9 +717,20 @@ void BIOSConfig::updateBaseBIOSTableProperty()
             dbusHandler->getService(biosConfigPath, biosConfigInterface);
         auto method = bus.new_method_call(service.c_str(), biosConfigPath,
                                           dbusProperties, "Set");
-        std::variant<BaseBIOSTable> value = baseBIOSTableMaps;
-        method.append(biosConfigInterface, biosConfigPropertyName, value);
+        // Lend the table to the variant rather than copying it
+        std::variant<BaseBIOSTable> value = std::move(baseBIOSTableMaps);
+        try
+        {
+            method.append(biosConfigInterface, biosConfigPropertyName, value);
+        }
+        catch (...)
+        {
+            baseBIOSTableMaps = std::move(std::get<BaseBIOSTable>(value));
+            throw;
+        }
+        baseBIOSTableMaps = std::move(std::get<BaseBIOSTable>(value));
         bus.call_noreply(method, dbusTimeout);
+        setPublished();
     }
     catch (const std::exception& e)
     {
@@ -532,32 +739,96 @@ void BIOSConfig::updateBaseBIOSTableProperty()
     }
 }
 
-void BIOSConfig::constructAttributes()
+bool BIOSConfig::emitBaseBIOSTableChanged(const BaseBIOSTable& changed)
 {
-    info("Bios Attribute file path: {PATH}", "PATH",
-         (jsonDir / sysType / attributesJsonFile));
-    load(jsonDir / sysType / attributesJsonFile, [this](const Json& entry) {
-        std::string attrType = entry.at("attribute_type");
-        if (attrType == "string")
-        {
-            constructAttribute<BIOSStringAttribute>(entry);
-        }
-        else if (attrType == "integer")
+    try
+    {
+        auto& bus = dbusHandler->getBus();
+        auto msg = bus.new_signal("/xyz/openbmc_project/pldm",
+                                  "xyz.openbmc_project.PLDM.BIOS",
+                                  "BaseBIOSTableChanged");
+        msg.append(changed);
+        msg.signal_send();
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to emit BaseBIOSTableChanged signal, error - {ERROR}",
+              "ERROR", e);
+        return false;
+    }
+
+    return true;
+}
+
+void BIOSConfig::prefetchAttrValues(BaseBIOSTable&& biosTable)
+{
+    struct State
+    {
+        BaseBIOSTable biosTable;
+        uint64_t build;
+        size_t pending = 1;
+    };
+    auto state =
+        std::make_shared<State>(std::move(biosTable), ++attrTablesBuild);
+
+    auto replied = [this, state]() {
+        if (--state->pending || state->build != attrTablesBuild)
         {
-            constructAttribute<BIOSIntegerAttribute>(entry);
+            return;
         }
-        else if (attrType == "enum")
+        storeAttrTables(state->biosTable);
+    };
+
+    for (auto& attr : biosAttributes)
+    {
+        auto dBusMap = attr->getDBusMap();
+        if (!dBusMap || state->biosTable.contains(attr->name))
         {
-            constructAttribute<BIOSEnumAttribute>(entry);
+            continue;
         }
-    });
+        state->pending++;
+        dbusHandler->getDbusPropertyVariantAsync(
+            *dBusMap, [this, state, replied, attr = attr.get()](
+                          int rc, PropertyValue&& value) {
+                // The attributes of a later build may have replaced this one
+                if (state->build == attrTablesBuild)
+                {
+                    attr->setPrefetchedValue(
+                        rc ? std::nullopt
+                           : std::optional<PropertyValue>(std::move(value)));
+                }
+                replied();
+            });
+    }
+
+    // Every call was sent, the tables are stored with the last reply
+    replied();
 }
 
-void BIOSConfig::buildAndStoreAttrTables(const Table& stringTable)
+void BIOSConfig::constructAttributes()
 {
-    BIOSStringTable biosStringTable(stringTable);
+    info("Bios Attribute file path: {PATH}", "PATH",
+         (jsonDir / sysType / attributesJsonFile));
+    load(jsonDir / sysType / attributesJsonFile,
+         [this](const AttributeSchema& schema) {
+             if (schema.type == "string")
+             {
+                 constructAttribute<BIOSStringAttribute>(schema);
+             }
+             else if (schema.type == "integer")
+             {
+                 constructAttribute<BIOSIntegerAttribute>(schema);
+             }
+             else if (schema.type == "enum")
+             {
+                 constructAttribute<BIOSEnumAttribute>(schema);
+             }
+         });
+}
 
-    if (biosAttributes.empty())
+void BIOSConfig::buildAndStoreAttrTables()
+{
+    if (biosAttributes.empty() || !getStringTable())
     {
         return;
     }
@@ -588,6 +859,18 @@ void BIOSConfig::buildAndStoreAttrTables(const Table& stringTable)
               e);
     }
 
+    prefetchAttrValues(std::move(biosTable));
+}
+
+void BIOSConfig::storeAttrTables(const BaseBIOSTable& biosTable)
+{
+    auto stringTable = getStringTable();
+    if (!stringTable)
+    {
+        return;
+    }
+    const auto& biosStringTable = *stringTable;
+
     Table attrTable, attrValueTable;
 
     for (auto& attr : biosAttributes)
@@ -618,32 +901,23 @@ void BIOSConfig::buildAndStoreAttrTables(const Table& stringTable)
 
     table::appendPadAndChecksum(attrTable);
     table::appendPadAndChecksum(attrValueTable);
-    setBIOSTable(PLDM_BIOS_ATTR_TABLE, attrTable);
-    setBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE, attrValueTable);
+    setBIOSTable(PLDM_BIOS_ATTR_TABLE, std::move(attrTable));
+    setBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE, std::move(attrValueTable));
 }
 
-std::optional<Table> BIOSConfig::buildAndStoreStringTable()
+bool BIOSConfig::buildAndStoreStringTable()
 {
     std::set<std::string> strings;
-    load(jsonDir / sysType / attributesJsonFile, [&strings](const Json& entry) {
-        if (entry.at("attribute_type") == "enum")
-        {
-            strings.emplace(entry.at("attribute_name"));
-            auto possibleValues = entry.at("possible_values");
-            for (auto& pv : possibleValues)
-            {
-                strings.emplace(pv);
-            }
-        }
-        else
-        {
-            strings.emplace(entry.at("attribute_name"));
-        }
-    });
+    load(jsonDir / sysType / attributesJsonFile,
+         [&strings](const AttributeSchema& schema) {
+             strings.emplace(schema.name);
+             strings.insert(schema.possibleValues.begin(),
+                            schema.possibleValues.end());
+         });
 
     if (strings.empty())
     {
-        return std::nullopt;
+        return false;
     }
 
     Table table;
@@ -653,8 +927,8 @@ std::optional<Table> BIOSConfig::buildAndStoreStringTable()
     }
 
     table::appendPadAndChecksum(table);
-    setBIOSTable(PLDM_BIOS_STRING_TABLE, table);
-    return table;
+    return setBIOSTable(PLDM_BIOS_STRING_TABLE, std::move(table)) ==
+           PLDM_SUCCESS;
 }
 
 void BIOSConfig::storeTable(const fs::path& path, const Table& table)
@@ -676,35 +950,62 @@ std::optional<Table> BIOSConfig::loadTable(const fs::path& path)
     return table;
 }
 
-void BIOSConfig::load(const fs::path& filePath, ParseHandler handler)
+void BIOSConfig::load(const fs::path& filePath, SchemaHandler handler)
 {
-    std::ifstream file;
-    Json jsonConf;
-    if (fs::exists(filePath))
+    if (!fs::exists(filePath))
     {
+        return;
+    }
+
+    auto key = schemaCache.enabled()
+                   ? BIOSSchemaCache::computeKey(filePath, sysType)
+                   : 0;
+    auto schemas = schemaCache.load(key);
+    if (!schemas)
+    {
+        Json entries;
         try
         {
-            file.open(filePath);
-            jsonConf = Json::parse(file);
-            auto entries = jsonConf.at("entries");
-            for (auto& entry : entries)
-            {
-                try
-                {
-                    handler(entry);
-                }
-                catch (const std::exception& e)
-                {
-                    error(
-                        "Failed to parse JSON config file at path '{PATH}', error - {ERROR}",
-                        "PATH", filePath, "ERROR", e);
-                }
-            }
+            auto jsonConf =
+                pldm::utils::JsonCache::getInstance().parse(filePath);
+            entries = jsonConf.at("entries");
         }
         catch (const std::exception& e)
         {
             error("Failed to parse JSON config file '{PATH}', error - {ERROR}",
                   "PATH", filePath, "ERROR", e);
+            return;
+        }
+
+        schemas.emplace();
+        for (const auto& entry : entries)
+        {
+            try
+            {
+                schemas->push_back(AttributeSchema::fromJson(
+                    entry, entry.at("attribute_type")));
+            }
+            catch (const std::exception& e)
+            {
+                error(
+                    "Failed to parse JSON config file at path '{PATH}', error - {ERROR}",
+                    "PATH", filePath, "ERROR", e);
+            }
+        }
+        schemaCache.store(key, *schemas);
+    }
+
+    for (const auto& schema : *schemas)
+    {
+        try
+        {
+            handler(schema);
+        }
+        catch (const std::exception& e)
+        {
+            error(
+                "Failed to process the BIOS attribute '{ATTRIBUTE}' of '{PATH}', error - {ERROR}",
+                "ATTRIBUTE", schema.name, "PATH", filePath, "ERROR", e);
         }
     }
 }
@@ -722,11 +1023,11 @@ std::string BIOSConfig::decodeStringFromStringEntry(
 }
 
 std::string BIOSConfig::displayStringHandle(
-    uint16_t handle, uint8_t index, const std::optional<Table>& attrTable,
-    const std::optional<Table>& stringTable)
+    uint16_t handle, uint8_t index, const Table& attrTable,
+    const Table& stringTable)
 {
     auto attrEntry = pldm_bios_table_attr_find_by_handle(
-        attrTable->data(), attrTable->size(), handle);
+        attrTable.data(), attrTable.size(), handle);
     uint8_t pvNum;
     int rc = pldm_bios_table_attr_entry_enum_decode_pv_num(attrEntry, &pvNum);
     if (rc != PLDM_SUCCESS)
@@ -746,7 +1047,7 @@ std::string BIOSConfig::displayStringHandle(
     std::string displayString = std::to_string(pvHandls[index]);
 
     auto stringEntry = pldm_bios_table_string_find_by_handle(
-        stringTable->data(), stringTable->size(), pvHandls[index]);
+        stringTable.data(), stringTable.size(), pvHandls[index]);
 
     auto decodedStr = decodeStringFromStringEntry(stringEntry);
 
@@ -757,14 +1058,14 @@ void BIOSConfig::traceBIOSUpdate(
     const pldm_bios_attr_val_table_entry* attrValueEntry,
     const pldm_bios_attr_table_entry* attrEntry, bool isBMC)
 {
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+    auto stringTable = getTable(PLDM_BIOS_STRING_TABLE);
+    auto attrTable = getTable(PLDM_BIOS_ATTR_TABLE);
 
     auto [attrHandle,
           attrType] = table::attribute_value::decodeHeader(attrValueEntry);
 
     auto attrHeader = table::attribute::decodeHeader(attrEntry);
-    BIOSStringTable biosStringTable(*stringTable);
+    const auto& biosStringTable = *getStringTable();
     auto attrName = biosStringTable.findString(attrHeader.stringHandle);
 
     switch (attrType)
@@ -780,8 +1081,8 @@ void BIOSConfig::traceBIOSUpdate(
 
             for (uint8_t handle : handles)
             {
-                auto nwVal = displayStringHandle(attrHandle, handle, attrTable,
-                                                 stringTable);
+                auto nwVal = displayStringHandle(attrHandle, handle,
+                                                 *attrTable, *stringTable);
                 auto chkBMC = isBMC ? "true" : "false";
                 info(
                     "BIOS attribute '{ATTRIBUTE}' updated to value '{VALUE}' by BMC '{CHECK_BMC}'",
@@ -818,30 +1119,41 @@ void BIOSConfig::traceBIOSUpdate(
 
 int BIOSConfig::checkAttrValueToUpdate(
     const pldm_bios_attr_val_table_entry* attrValueEntry,
-    const pldm_bios_attr_table_entry* attrEntry, Table&)
+    const AttrValueLimits& limits)
 
 {
     auto [attrHandle,
           attrType] = table::attribute_value::decodeHeader(attrValueEntry);
 
+    // The read-only bit is not part of the type
+    if ((attrType & 0x7f) != (limits.attrType & 0x7f))
+    {
+        error(
+            "Type '{TYPE}' of the value does not match the type '{ATTR_TYPE}' of BIOS attribute '{HANDLE}'",
+            "TYPE", attrType, "ATTR_TYPE", limits.attrType, "HANDLE",
+            attrHandle);
+        return PLDM_ERROR_INVALID_DATA;
+    }
+
     switch (attrType)
     {
         case PLDM_BIOS_ENUMERATION:
         case PLDM_BIOS_ENUMERATION_READ_ONLY:
         {
-            auto value =
-                table::attribute_value::decodeEnumEntry(attrValueEntry);
-            auto [pvHdls,
-                  defIndex] = table::attribute::decodeEnumEntry(attrEntry);
-            if (!(value.size() == 1))
+            auto number = pldm_bios_table_attr_value_entry_enum_decode_number(
+                attrValueEntry);
+            if (number != 1)
             {
                 return PLDM_ERROR_INVALID_LENGTH;
             }
-            if (value[0] >= pvHdls.size())
+            uint8_t index = 0;
+            pldm_bios_table_attr_value_entry_enum_decode_handles(
+                attrValueEntry, &index, 1);
+            if (index >= limits.upper)
             {
                 error(
                     "Invalid index '{INDEX}' encountered for Enum type BIOS attribute",
-                    "INDEX", value[0]);
+                    "INDEX", index);
                 return PLDM_ERROR_INVALID_DATA;
             }
             return PLDM_SUCCESS;
@@ -851,15 +1163,12 @@ int BIOSConfig::checkAttrValueToUpdate(
         {
             auto value =
                 table::attribute_value::decodeIntegerEntry(attrValueEntry);
-            auto [lower, upper, scalar,
-                  def] = table::attribute::decodeIntegerEntry(attrEntry);
-
-            if (value < lower || value > upper)
+            if (value < limits.lower || value > limits.upper)
             {
                 error(
-                    "Out of range index '{ATTRIBUTE_VALUE}' encountered for Integer type BIOS attribute for the lower bound '{LOWER}', the upper bound '{UPPER}' and the scalar value '{SCALAR}'.",
-                    "ATTRIBUTE_VALUE", value, "LOWER", lower, "UPPER", upper,
-                    "SCALAR", scalar);
+                    "Out of range index '{ATTRIBUTE_VALUE}' encountered for Integer type BIOS attribute for the lower bound '{LOWER}' and the upper bound '{UPPER}'.",
+                    "ATTRIBUTE_VALUE", value, "LOWER", limits.lower, "UPPER",
+                    limits.upper);
                 return PLDM_ERROR_INVALID_DATA;
             }
             return PLDM_SUCCESS;
@@ -867,16 +1176,15 @@ int BIOSConfig::checkAttrValueToUpdate(
         case PLDM_BIOS_STRING:
         case PLDM_BIOS_STRING_READ_ONLY:
         {
-            auto stringConf = table::attribute::decodeStringEntry(attrEntry);
-            auto value =
-                table::attribute_value::decodeStringEntry(attrValueEntry);
-            if (value.size() < stringConf.minLength ||
-                value.size() > stringConf.maxLength)
+            auto length =
+                pldm_bios_table_attr_value_entry_string_decode_length(
+                    attrValueEntry);
+            if (length < limits.lower || length > limits.upper)
             {
                 error(
-                    "Invalid length '{LENGTH}' encountered for string type BIOS attribute value '{ATTRIBUTE_VALUE}' when minimum string entry length '{MIN_LEN}' and maximum string entry length '{MAX_LEN}'",
-                    "ATTRIBUTE_VALUE", value, "LENGTH", value.size(), "MIN_LEN",
-                    stringConf.minLength, "MAX_LEN", stringConf.maxLength);
+                    "Invalid length '{LENGTH}' encountered for string type BIOS attribute when minimum string entry length '{MIN_LEN}' and maximum string entry length '{MAX_LEN}'",
+                    "LENGTH", length, "MIN_LEN", limits.lower, "MAX_LEN",
+                    limits.upper);
                 return PLDM_ERROR_INVALID_LENGTH;
             }
             return PLDM_SUCCESS;
@@ -887,78 +1195,182 @@ int BIOSConfig::checkAttrValueToUpdate(
     };
 }
 
-int BIOSConfig::setAttrValue(const void* entry, size_t size, bool isBMC,
-                             bool updateDBus, bool updateBaseBIOSTable)
+int BIOSConfig::checkAttrValues(const Table& table)
 {
-    auto attrValueTable = getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    if (!attrValueTable || !attrTable || !stringTable)
+    auto index = getAttrTableIndex();
+    if (!index)
     {
         return PLDM_BIOS_TABLE_UNAVAILABLE;
     }
 
-    auto attrValueEntry =
-        reinterpret_cast<const pldm_bios_attr_val_table_entry*>(entry);
-
-    auto attrValHeader = table::attribute_value::decodeHeader(attrValueEntry);
-
-    auto attrEntry =
-        table::attribute::findByHandle(*attrTable, attrValHeader.attrHandle);
-    if (!attrEntry)
-    {
-        return PLDM_ERROR;
-    }
-
-    auto rc = checkAttrValueToUpdate(attrValueEntry, attrEntry, *stringTable);
-    if (rc != PLDM_SUCCESS)
+    for (auto entry : pldm::bios::utils::BIOSTableIter<
+             PLDM_BIOS_ATTR_VAL_TABLE>(table.data(), table.size()))
     {
-        return rc;
+        auto header = table::attribute_value::decodeHeader(entry);
+        auto it = index->limits.find(header.attrHandle);
+        if (it == index->limits.end())
+        {
+            return PLDM_INVALID_BIOS_ATTR_HANDLE;
+        }
+        auto rc = checkAttrValueToUpdate(entry, it->second);
+        if (rc != PLDM_SUCCESS)
+        {
+            return rc;
+        }
     }
+    return PLDM_SUCCESS;
+}
 
-    auto destTable =
-        table::attribute_value::updateTable(*attrValueTable, entry, size);
+int BIOSConfig::setAttrValue(const void* entry, size_t size, bool isBMC,
+                             bool updateDBus, bool updateBaseBIOSTable)
+{
+    std::span<const uint8_t> attrValueEntry(
+        static_cast<const uint8_t*>(entry), size);
+    return setAttrValues({&attrValueEntry, 1}, isBMC, updateDBus,
+                         updateBaseBIOSTable);
+}
 
-    if (!destTable)
+int BIOSConfig::setAttrValues(std::span<const std::span<const uint8_t>> entries,
+                              bool isBMC, bool updateDBus,
+                              bool updateBaseBIOSTable)
+{
+    auto attrValueTable = getTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    auto attrTable = getTable(PLDM_BIOS_ATTR_TABLE);
+    auto stringTable = getTable(PLDM_BIOS_STRING_TABLE);
+    if (!attrValueTable || !attrTable || !stringTable)
     {
-        return PLDM_ERROR;
+        return PLDM_BIOS_TABLE_UNAVAILABLE;
     }
-
-    try
+    const auto& biosStringTable = *getStringTable();
+
+    // Validate all the entries and merge them into one table before
+    // updating anything
+    using Update = std::tuple<const pldm_bios_attr_val_table_entry*,
+                              const pldm_bios_attr_table_entry*,
+                              BIOSAttribute*>;
+    std::vector<Update> updates;
+    updates.reserve(entries.size());
+    std::optional<Table> destTable;
+    for (const auto& entry : entries)
     {
-        auto attrHeader = table::attribute::decodeHeader(attrEntry);
+        auto attrValueEntry =
+            reinterpret_cast<const pldm_bios_attr_val_table_entry*>(
+                entry.data());
+
+        auto attrValHeader =
+            table::attribute_value::decodeHeader(attrValueEntry);
+
+        auto attrEntry = findAttrEntry(attrValHeader.attrHandle);
+        if (!attrEntry)
+        {
+            return PLDM_ERROR;
+        }
 
-        BIOSStringTable biosStringTable(*stringTable);
-        auto attrName = biosStringTable.findString(attrHeader.stringHandle);
-        auto iter = std::find_if(
-            biosAttributes.begin(), biosAttributes.end(),
-            [&attrName](const auto& attr) { return attr->name == attrName; });
+        const auto& limits =
+            attrTableIndex->limits.at(attrValHeader.attrHandle);
+        auto rc = checkAttrValueToUpdate(attrValueEntry, limits);
+        if (rc != PLDM_SUCCESS)
+        {
+            return rc;
+        }
 
-        if (iter == biosAttributes.end())
+        destTable = table::attribute_value::updateTable(
+            destTable ? *destTable : *attrValueTable, entry.data(),
+            entry.size());
+        if (!destTable)
         {
             return PLDM_ERROR;
         }
-        if (updateDBus)
+
+        try
         {
-            (*iter)->setAttrValueOnDbus(attrValueEntry, attrEntry,
-                                        biosStringTable);
+            auto attrHeader = table::attribute::decodeHeader(attrEntry);
+            auto attrName =
+                biosStringTable.findString(attrHeader.stringHandle);
+            auto iter = attributesByName.find(attrName);
+            if (iter == attributesByName.end())
+            {
+                return PLDM_ERROR;
+            }
+            updates.emplace_back(attrValueEntry, attrEntry, iter->second);
+        }
+        catch (const std::exception& e)
+        {
+            error("Set attribute value error - {ERROR}", "ERROR", e);
+            return PLDM_ERROR;
         }
     }
-    catch (const std::exception& e)
+    if (!destTable)
+    {
+        return PLDM_SUCCESS;
+    }
+
+    if (updateDBus)
     {
-        error("Set attribute value error - {ERROR}", "ERROR", e);
-        return PLDM_ERROR;
+        size_t updated = 0;
+        try
+        {
+            for (; updated < updates.size(); ++updated)
+            {
+                const auto& [attrValueEntry, attrEntry, attribute] =
+                    updates[updated];
+                attribute->setAttrValueOnDbus(attrValueEntry, attrEntry,
+                                              biosStringTable);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            error("Set attribute value error - {ERROR}", "ERROR", e);
+            // Put the properties already set back to the values of the
+            // attribute value table, which is left unchanged
+            for (size_t i = 0; i < updated; ++i)
+            {
+                const auto& [attrValueEntry, attrEntry, attribute] =
+                    updates[i];
+                auto current = pldm_bios_table_attr_value_find_by_handle(
+                    attrValueTable->data(), attrValueTable->size(),
+                    table::attribute_value::decodeHeader(attrValueEntry)
+                        .attrHandle);
+                if (!current)
+                {
+                    continue;
+                }
+                try
+                {
+                    attribute->setAttrValueOnDbus(current, attrEntry,
+                                                  biosStringTable);
+                }
+                catch (const std::exception& restoreError)
+                {
+                    error(
+                        "Failed to restore the BIOS attribute '{ATTRIBUTE}', error - {ERROR}",
+                        "ATTRIBUTE", attribute->name, "ERROR", restoreError);
+                }
+            }
+            return PLDM_ERROR;
+        }
     }
 
-    setBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE, *destTable, updateBaseBIOSTable);
+    setBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE, std::move(*destTable),
+                 updateBaseBIOSTable);
 
-    traceBIOSUpdate(attrValueEntry, attrEntry, isBMC);
+    for (const auto& [attrValueEntry, attrEntry, attribute] : updates)
+    {
+        traceBIOSUpdate(attrValueEntry, attrEntry, isBMC);
+    }
 
     return PLDM_SUCCESS;
 }
 
 void BIOSConfig::removeTables()
 {
+    tables = {};
+    unpersisted = {};
+    persistEvent.reset();
+    stringTableView.reset();
+    attrTableIndex.reset();
+    publishedValues.clear();
+    publishedAttrTable.reset();
     try
     {
         fs::remove(tableDir / stringTableFile);
@@ -985,13 +1397,13 @@ void BIOSConfig::processBiosAttrChangeNotification(
     }
 
     PropertyValue newPropVal = it->second;
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    if (!stringTable.has_value())
+    auto stringTable = getTable(PLDM_BIOS_STRING_TABLE);
+    if (!stringTable)
     {
         error("BIOS string table unavailable");
         return;
     }
-    BIOSStringTable biosStringTable(*stringTable);
+    const auto& biosStringTable = *getStringTable();
     uint16_t attrNameHdl{};
     try
     {
@@ -1005,14 +1417,14 @@ void BIOSConfig::processBiosAttrChangeNotification(
         return;
     }
 
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-    if (!attrTable.has_value())
+    auto attrTable = getTable(PLDM_BIOS_ATTR_TABLE);
+    if (!attrTable)
     {
         error("BIOS Attribute table not present");
         return;
     }
     const struct pldm_bios_attr_table_entry* tableEntry =
-        table::attribute::findByStringHandle(*attrTable, attrNameHdl);
+        findAttrEntry(attrNameHdl, true);
     if (tableEntry == nullptr)
     {
         error(
@@ -1024,9 +1436,9 @@ void BIOSConfig::processBiosAttrChangeNotification(
     auto [attrHdl, attrType,
           stringHdl] = table::attribute::decodeHeader(tableEntry);
 
-    auto attrValueSrcTable = getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    auto attrValueSrcTable = getTable(PLDM_BIOS_ATTR_VAL_TABLE);
 
-    if (!attrValueSrcTable.has_value())
+    if (!attrValueSrcTable)
     {
         error("Attribute value table not present");
         return;
@@ -1046,7 +1458,7 @@ void BIOSConfig::processBiosAttrChangeNotification(
         *attrValueSrcTable, newValue.data(), newValue.size());
     if (destTable.has_value())
     {
-        storeTable(tableDir / attrValueTableFile, *destTable);
+        setTable(PLDM_BIOS_ATTR_VAL_TABLE, std::move(*destTable));
     }
 
     rc = setAttrValue(newValue.data(), newValue.size(), true, false);
@@ -1060,46 +1472,39 @@ void BIOSConfig::processBiosAttrChangeNotification(
 
 uint16_t BIOSConfig::findAttrHandle(const std::string& attrName)
 {
-    auto stringTable = getBIOSTable(PLDM_BIOS_STRING_TABLE);
-    auto attrTable = getBIOSTable(PLDM_BIOS_ATTR_TABLE);
-
-    BIOSStringTable biosStringTable(*stringTable);
-    pldm::bios::utils::BIOSTableIter<PLDM_BIOS_ATTR_TABLE> attrTableIter(
-        attrTable->data(), attrTable->size());
-    auto stringHandle = biosStringTable.findHandle(attrName);
-
-    for (auto entry : pldm::bios::utils::BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(
-             attrTable->data(), attrTable->size()))
+    auto biosStringTable = getStringTable();
+    if (!biosStringTable)
     {
-        auto header = table::attribute::decodeHeader(entry);
-        if (header.stringHandle == stringHandle)
-        {
-            return header.attrHandle;
-        }
+        throw std::invalid_argument("Unknown attribute Name");
     }
+    auto stringHandle = biosStringTable->findHandle(attrName);
 
-    throw std::invalid_argument("Unknown attribute Name");
+    auto entry = findAttrEntry(stringHandle, true);
+    if (!entry)
+    {
+        throw std::invalid_argument("Unknown attribute Name");
+    }
+    return table::attribute::decodeHeader(entry).attrHandle;
 }
 
 void BIOSConfig::constructPendingAttribute(
     const PendingAttributes& pendingAttributes)
 {
     std::vector<uint16_t> listOfHandles{};
+    std::vector<Table> attrValueEntries;
+    attrValueEntries.reserve(pendingAttributes.size());
 
+    // The pending attributes are applied together or not at all
     for (auto& attribute : pendingAttributes)
     {
         std::string attributeName = attribute.first;
         auto& [attributeType, attributevalue] = attribute.second;
 
-        auto iter = std::find_if(biosAttributes.begin(), biosAttributes.end(),
-                                 [&attributeName](const auto& attr) {
-                                     return attr->name == attributeName;
-                                 });
-
-        if (iter == biosAttributes.end())
+        auto iter = attributesByName.find(attributeName);
+        if (iter == attributesByName.end())
         {
             error("Wrong attribute name {NAME}", "NAME", attributeName);
-            continue;
+            return;
         }
 
         Table attrValueEntry(sizeof(pldm_bios_attr_val_table_entry), 0);
@@ -1116,7 +1521,7 @@ void BIOSConfig::constructPendingAttribute(
         {
             error("Attribute type '{TYPE}' not supported", "TYPE",
                   attributeType);
-            continue;
+            return;
         }
 
         const auto [attrType, readonlyStatus, displayName, description,
@@ -1131,22 +1536,71 @@ void BIOSConfig::constructPendingAttribute(
             listOfHandles.emplace_back(htole16(handler));
         }
 
-        (*iter)->generateAttributeEntry(attributevalue, attrValueEntry);
+        iter->second->generateAttributeEntry(attributevalue, attrValueEntry);
+        attrValueEntries.emplace_back(std::move(attrValueEntry));
+    }
 
-        setAttrValue(attrValueEntry.data(), attrValueEntry.size(), true);
+    std::vector<std::span<const uint8_t>> entries(attrValueEntries.begin(),
+                                                  attrValueEntries.end());
+    auto rc = setAttrValues(entries, true);
+    if (rc != PLDM_SUCCESS)
+    {
+        error(
+            "Failed to apply {COUNT} pending BIOS attributes, response code '{RC}'",
+            "COUNT", entries.size(), "RC", rc);
+        return;
     }
 
     if (listOfHandles.size())
     {
+        notifyAttrChanges(listOfHandles);
+    }
+}
+
+void BIOSConfig::notifyAttrChanges(const std::vector<uint16_t>& handles)
+{
+    changedAttrHandles.insert(handles.begin(), handles.end());
+    if (!BIOS_ATTRIBUTE_EVENT_DEBOUNCE_MS)
+    {
+        sendAttrUpdateEvent();
+        return;
+    }
+
+    if (!attrUpdateEventTimer)
+    {
+        attrUpdateEventTimer = std::make_unique<
+            sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
+            sdeventplus::Event::get_default(),
+            [this](auto&) { sendAttrUpdateEvent(); });
+    }
+    // The window starts with the first change, later changes join it
+    if (!attrUpdateEventTimer->isEnabled())
+    {
+        attrUpdateEventTimer->restartOnce(
+            std::chrono::milliseconds(BIOS_ATTRIBUTE_EVENT_DEBOUNCE_MS));
+    }
+}
+
+void BIOSConfig::sendAttrUpdateEvent()
+{
+    if (changedAttrHandles.empty())
+    {
+        return;
+    }
+    std::vector<uint16_t> handles(changedAttrHandles.begin(),
+                                  changedAttrHandles.end());
+    changedAttrHandles.clear();
+
 #ifdef OEM_IBM
-        auto rc = pldm::responder::platform::sendBiosAttributeUpdateEvent(
-            eid, instanceIdDb, listOfHandles, handler);
-        if (rc != PLDM_SUCCESS)
-        {
-            return;
-        }
-#endif
+    auto rc = pldm::responder::platform::sendBiosAttributeUpdateEvent(
+        eid, instanceIdDb, handles, handler);
+    if (rc != PLDM_SUCCESS)
+    {
+        error(
+            "Failed to send the BIOS attribute update event of {COUNT} attributes, response code '{RC}'",
+            "COUNT", handles.size(), "RC", rc);
     }
+#endif
 }
 
 void BIOSConfig::listenPendingAttributes()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "bios_attribute.hpp"
+#include "bios_schema_cache.hpp"
 #include "bios_table.hpp"
 #include "common/instance_id.hpp"
 #include "oem_handler.hpp"
@@ -11,13 +12,18 @@
 
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/source/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
 
+#include <array>
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <optional>
 #include <set>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -71,7 +77,10 @@ class BIOSConfig
     BIOSConfig(BIOSConfig&&) = delete;
     BIOSConfig& operator=(const BIOSConfig&) = delete;
     BIOSConfig& operator=(BIOSConfig&&) = delete;
-    ~BIOSConfig() = default;
+    ~BIOSConfig()
+    {
+        persistTables();
+    }
 
     /** @brief Construct BIOSConfig
      *  @param[in] jsonDir - The directory where json file exists
@@ -106,6 +115,23 @@ class BIOSConfig
     int setAttrValue(const void* entry, size_t size, bool isBMC,
                      bool updateDBus = true, bool updateBaseBIOSTable = true);
 
+    /** @brief Set attribute values on dbus and attribute value table, as one
+     *         update. Nothing is updated if one of the entries is invalid,
+     *         the D-Bus properties already set are restored if setting
+     *         another one fails, the attribute value table is replaced and
+     *         persisted once.
+     *  @param[in] entries - attribute value entries
+     *  @param[in] isBMC - indicates if the attributes are set by BMC
+     *  @param[in] updateDBus          - update Attr value D-Bus properties
+     *                                   if this is set to true
+     *  @param[in] updateBaseBIOSTable - update BaseBIOSTable D-Bus property
+     *                                   if this is set to true
+     *  @return pldm_completion_codes
+     */
+    int setAttrValues(std::span<const std::span<const uint8_t>> entries,
+                      bool isBMC, bool updateDBus = true,
+                      bool updateBaseBIOSTable = true);
+
     /** @brief Remove the persistent tables */
     void removeTables();
 
@@ -118,6 +144,20 @@ class BIOSConfig
      */
     std::optional<Table> getBIOSTable(pldm_bios_table_types tableType);
 
+    /** @brief Get the resident BIOS table of specified type, without copying
+     *         it. The table is never modified, updates replace it.
+     *  @param[in] tableType - The table type
+     *  @return The bios table, nullptr if the table is unavailable
+     */
+    std::shared_ptr<const Table> getTable(pldm_bios_table_types tableType);
+
+    /** @brief Check all the values of an attribute value table against the
+     *         current attribute table, in one pass over the table
+     *  @param[in] table - The attribute value table
+     *  @return pldm_completion_codes
+     */
+    int checkAttrValues(const Table& table);
+
     /** @brief set BIOS table
      *  @param[in] tableType - Indicates what table is being transferred
      *             {BIOSStringTable=0x0, BIOSAttributeTable=0x1,
@@ -127,7 +167,7 @@ class BIOSConfig
      *                                   if this is set to true
      *  @return pldm_completion_codes
      */
-    int setBIOSTable(uint8_t tableType, const Table& table,
+    int setBIOSTable(uint8_t tableType, Table table,
                      bool updateBaseBIOSTable = true);
 
     /** @brief Construct the BIOS Attributes and build the tables
@@ -160,6 +200,19 @@ class BIOSConfig
     pldm::utils::DBusHandler* const dbusHandler;
     BaseBIOSTable baseBIOSTableMaps;
 
+    /** @brief Current values of the BaseBIOSTable as last published on
+     *         D-Bus, to publish the changes only
+     */
+    std::map<AttributeName, CurrentValue> publishedValues;
+
+    /** @brief Attribute table the BaseBIOSTable was last published for */
+    std::weak_ptr<const Table> publishedAttrTable;
+
+    /** @brief Build of the attribute tables in progress, the replies of the
+     *         earlier builds are dropped
+     */
+    uint64_t attrTablesBuild = 0;
+
     /** @brief MCTP EID of host firmware */
     uint8_t eid;
 
@@ -177,10 +230,72 @@ class BIOSConfig
     /** @brief Callback for registering the PLDM service name */
     pldm::responder::bios::Callback requestPLDMServiceName;
 
+    /** @brief The tables, indexed by pldm_bios_table_types. They are the
+     *  reference once built, the files only persist them.
+     */
+    std::array<std::shared_ptr<const Table>, PLDM_BIOS_ATTR_VAL_TABLE + 1>
+        tables;
+
+    /** @brief Tables updated since they were last persisted */
+    std::array<bool, PLDM_BIOS_ATTR_VAL_TABLE + 1> unpersisted{};
+
+    /** @brief Persists the updated tables once the current burst of updates
+     *  is processed
+     */
+    std::unique_ptr<sdeventplus::source::Defer> persistEvent;
+
+    /** @brief Handles of the attributes changed since the last attribute
+     *         update event sent to the host
+     */
+    std::set<uint16_t> changedAttrHandles;
+
+    /** @brief Ends the debounce window of the attribute update events */
+    std::unique_ptr<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        attrUpdateEventTimer;
+
+    /** @brief Lookups in the string table, for the current string table */
+    std::optional<BIOSStringTable> stringTableView;
+
+    /** @struct AttrValueLimits
+     *  @brief Valid values of an attribute, decoded once from its attribute
+     *         table entry
+     */
+    struct AttrValueLimits
+    {
+        uint8_t attrType;
+        /** @brief Integer bounds or string length bounds, upper is the
+         *         number of possible values of an enumeration
+         */
+        uint64_t lower;
+        uint64_t upper;
+    };
+
+    /** @struct AttrTableIndex
+     *  @brief Offsets and value limits of the entries of the attribute table
+     */
+    struct AttrTableIndex
+    {
+        std::unordered_map<uint16_t, size_t> byHandle;
+        std::unordered_map<uint16_t, size_t> byStringHandle;
+        std::unordered_map<uint16_t, AttrValueLimits> limits;
+    };
+
+    /** @brief Index of the current attribute table */
+    std::optional<AttrTableIndex> attrTableIndex;
+
     // vector persists all attributes
     using BIOSAttributes = std::vector<std::unique_ptr<BIOSAttribute>>;
     BIOSAttributes biosAttributes;
 
+    /** @brief Schemas parsed from the BIOS attribute JSON file, kept in the
+     *         table directory
+     */
+    BIOSSchemaCache schemaCache;
+
+    /** @brief The attributes of biosAttributes by name */
+    std::unordered_map<std::string, BIOSAttribute*> attributesByName;
+
     using propName = std::string;
     using DbusChObjProperties = std::map<propName, pldm::utils::PropertyValue>;
 
@@ -212,15 +327,17 @@ class BIOSConfig
 
     /** @brief Construct an attribute and persist it
      *  @tparam T - attribute type
-     *  @param[in] entry - json entry
+     *  @param[in] schema - fields of the attribute
      */
     template <typename T>
-    void constructAttribute(const Json& entry)
+    void constructAttribute(const AttributeSchema& schema)
     {
         try
         {
-            biosAttributes.push_back(std::make_unique<T>(entry, dbusHandler));
+            biosAttributes.push_back(std::make_unique<T>(schema, dbusHandler));
             auto biosAttrIndex = biosAttributes.size() - 1;
+            attributesByName.emplace(biosAttributes.back()->name,
+                                     biosAttributes.back().get());
             auto dBusMap = biosAttributes[biosAttrIndex]->getDBusMap();
 
             if (dBusMap.has_value())
@@ -268,26 +385,71 @@ class BIOSConfig
     /** Construct attributes and persist them */
     void constructAttributes();
 
-    using ParseHandler = std::function<void(const Json& entry)>;
+    using SchemaHandler = std::function<void(const AttributeSchema& schema)>;
 
-    /** @brief Helper function to parse json
+    /** @brief Helper function to parse json, the schemas are taken from the
+     *         schema cache while the file and the system type are unchanged
      *  @param[in] filePath - Path of json file
-     *  @param[in] handler - Handler to process each entry in the json
+     *  @param[in] handler - Handler to process the schema of each entry
      */
-    void load(const fs::path& filePath, ParseHandler handler);
+    void load(const fs::path& filePath, SchemaHandler handler);
 
     /** @brief Build String Table and persist it
-     *  @return The built string table, std::nullopt if it fails.
+     *  @return true if the string table was built
      */
-    std::optional<Table> buildAndStoreStringTable();
+    bool buildAndStoreStringTable();
 
     /** @brief Build attribute table and attribute value table and persist them
      *         Read the BaseBIOSTable from the bios-settings-manager and update
-     *         attribute table and attribute value table.
+     *         attribute table and attribute value table. The attributes
+     *         refer to the current string table. The tables are stored once
+     *         the D-Bus properties of the attributes were read.
+     */
+    void buildAndStoreAttrTables();
+
+    /** @brief Read the D-Bus properties of the attributes missing from the
+     *         BaseBIOSTable, all the calls in flight at once, then store the
+     *         attribute tables from the event loop. The attributes whose read
+     *         failed take their default value.
      *
-     *  @param[in] stringTable - The string Table
+     *  @param[in] biosTable - BaseBIOSTable read from bios-settings-manager
      */
-    void buildAndStoreAttrTables(const Table& stringTable);
+    void prefetchAttrValues(BaseBIOSTable&& biosTable);
+
+    /** @brief Construct and store the attribute tables
+     *
+     *  @param[in] biosTable - BaseBIOSTable read from bios-settings-manager
+     */
+    void storeAttrTables(const BaseBIOSTable& biosTable);
+
+    /** @brief Replace a table and schedule persisting it
+     *  @param[in] tableType - The table type
+     *  @param[in] table - The table
+     */
+    void setTable(pldm_bios_table_types tableType, Table&& table);
+
+    /** @brief Persist the tables updated since they were last persisted */
+    void persistTables();
+
+    /** @brief Get the lookups in the current string table
+     *  @return the lookups, nullptr if the table is unavailable
+     */
+    const BIOSStringTable* getStringTable();
+
+    /** @brief Find an entry of the current attribute table
+     *  @param[in] handle - attribute handle, or string handle of the
+     *                      attribute name if byStringHandle is set
+     *  @param[in] byStringHandle - look up by string handle of the name
+     *  @return the entry, nullptr if it is not found
+     */
+    const pldm_bios_attr_table_entry* findAttrEntry(
+        uint16_t handle, bool byStringHandle = false);
+
+    /** @brief Path persisting a table
+     *  @param[in] tableType - The table type
+     *  @return the path
+     */
+    fs::path tablePath(pldm_bios_table_types tableType) const;
 
     /** @brief Persist the table
      *  @param[in] path - Path to persist the table
@@ -320,8 +482,8 @@ class BIOSConfig
      * name handle
      */
     std::string displayStringHandle(uint16_t handle, uint8_t index,
-                                    const std::optional<Table>& attrTable,
-                                    const std::optional<Table>& stringTable);
+                                    const Table& attrTable,
+                                    const Table& stringTable);
 
     /** @brief Method to trace the bios attribute which got changed
      *
@@ -335,13 +497,18 @@ class BIOSConfig
 
     /** @brief Check the attribute value to update
      *  @param[in] attrValueEntry - The attribute value entry to update
-     *  @param[in] attrEntry - The attribute table entry
-     *  @param[in] stringTable - The string  table
+     *  @param[in] limits - The valid values of the attribute
      *  @return pldm_completion_codes
      */
     int checkAttrValueToUpdate(
         const pldm_bios_attr_val_table_entry* attrValueEntry,
-        const pldm_bios_attr_table_entry* attrEntry, Table& stringTable);
+        const AttrValueLimits& limits);
+
+    /** @brief Get the index of the current attribute table, built on first
+     *         use
+     *  @return the index, nullptr if there is no attribute table
+     */
+    const AttrTableIndex* getAttrTableIndex();
 
     /** @brief Check the attribute table
      *  @param[in] table - The table
@@ -349,16 +516,25 @@ class BIOSConfig
      */
     int checkAttributeTable(const Table& table);
 
-    /** @brief Check the attribute value table
+    /** @brief Build the BaseBIOSTable property from the attribute value
+     *         table, whose values are checked by checkAttrValues()
      *  @param[in] table - The table
-     *  @return pldm_completion_codes
      */
-    int checkAttributeValueTable(const Table& table);
+    void buildBaseBIOSTableMaps(const Table& table);
 
-    /** @brief Update the BaseBIOSTable property of the D-Bus interface
+    /** @brief Update the BaseBIOSTable property of the D-Bus interface,
+     *         nothing is published when no attribute changed since the last
+     *         update
      */
     void updateBaseBIOSTableProperty();
 
+    /** @brief Emit the BaseBIOSTableChanged signal
+     *
+     *  @param[in] changed - the attributes whose entry changed
+     *  @return true if the signal was sent
+     */
+    bool emitBaseBIOSTableChanged(const BaseBIOSTable& changed);
+
     /** @brief Listen the PendingAttributes property of the D-Bus interface and
      *         update BaseBIOSTable
      */
@@ -375,6 +551,15 @@ class BIOSConfig
      *  @param[in] msg - Data associated with subscribed signal
      */
     void constructPendingAttribute(const PendingAttributes& pendingAttributes);
+
+    /** @brief Notify the host of changed attributes. The changes are
+     *         collected over the debounce window and sent as one event.
+     *  @param[in] handles - handles of the changed attributes
+     */
+    void notifyAttrChanges(const std::vector<uint16_t>& handles);
+
+    /** @brief Send the attribute update event of the collected changes */
+    void sendAttrUpdateEvent();
 };
 
 } // namespace bios
@@ -14,38 +14,25 @@ namespace responder
 {
 namespace bios
 {
-BIOSEnumAttribute::BIOSEnumAttribute(const Json& entry,
+BIOSEnumAttribute::BIOSEnumAttribute(const AttributeSchema& schema,
                                      DBusHandler* const dbusHandler) :
-    BIOSAttribute(entry, dbusHandler)
+    BIOSAttribute(schema, dbusHandler), possibleValues(schema.possibleValues),
+    valueDisplayNames(schema.valueNames)
 {
-    std::string attrName = entry.at("attribute_name");
-    Json pv = entry.at("possible_values");
-    for (auto& val : pv)
-    {
-        possibleValues.emplace_back(val);
-    }
-
-    std::vector<std::string> defaultValues;
-    Json dv = entry.at("default_values");
-    for (auto& val : dv)
-    {
-        defaultValues.emplace_back(val);
-    }
-
-    Json vdn = entry.at("value_names");
-    for (auto& val : vdn)
+    assert(schema.defaultValues.size() == 1);
+    defaultValue = schema.defaultValues[0];
+    auto count = std::min(schema.dbusValues.size(), possibleValues.size());
+    for (size_t pos = 0; pos < count; ++pos)
     {
-        valueDisplayNames.emplace_back(val);
-    }
-    assert(defaultValues.size() == 1);
-    defaultValue = defaultValues[0];
-    if (dBusMap.has_value())
-    {
-        auto dbusValues = entry.at("dbus").at("property_values");
-        buildValMap(dbusValues);
+        valMap.emplace(schema.dbusValues[pos], possibleValues[pos]);
     }
 }
 
+BIOSEnumAttribute::BIOSEnumAttribute(const Json& entry,
+                                     DBusHandler* const dbusHandler) :
+    BIOSEnumAttribute(AttributeSchema::fromJson(entry, "enum"), dbusHandler)
+{}
+
 uint8_t BIOSEnumAttribute::getValueIndex(const std::string& value,
                                          const std::vector<std::string>& pVs)
 {
@@ -72,62 +59,6 @@ std::vector<uint16_t> BIOSEnumAttribute::getPossibleValuesHandle(
     return possibleValuesHandle;
 }
 
-void BIOSEnumAttribute::buildValMap(const Json& dbusVals)
-{
-    PropertyValue value;
-    size_t pos = 0;
-    for (auto it = dbusVals.begin(); it != dbusVals.end(); ++it, ++pos)
-    {
-        if (dBusMap->propertyType == "uint8_t")
-        {
-            value = static_cast<uint8_t>(it.value());
-        }
-        else if (dBusMap->propertyType == "uint16_t")
-        {
-            value = static_cast<uint16_t>(it.value());
-        }
-        else if (dBusMap->propertyType == "uint32_t")
-        {
-            value = static_cast<uint32_t>(it.value());
-        }
-        else if (dBusMap->propertyType == "uint64_t")
-        {
-            value = static_cast<uint64_t>(it.value());
-        }
-        else if (dBusMap->propertyType == "int16_t")
-        {
-            value = static_cast<int16_t>(it.value());
-        }
-        else if (dBusMap->propertyType == "int32_t")
-        {
-            value = static_cast<int32_t>(it.value());
-        }
-        else if (dBusMap->propertyType == "int64_t")
-        {
-            value = static_cast<int64_t>(it.value());
-        }
-        else if (dBusMap->propertyType == "bool")
-        {
-            value = static_cast<bool>(it.value());
-        }
-        else if (dBusMap->propertyType == "double")
-        {
-            value = static_cast<double>(it.value());
-        }
-        else if (dBusMap->propertyType == "string")
-        {
-            value = static_cast<std::string>(it.value());
-        }
-        else
-        {
-            error("Unknown D-Bus property type '{TYPE}'", "TYPE",
-                  dBusMap->propertyType);
-            throw std::invalid_argument("Unknown D-BUS property type");
-        }
-        valMap.emplace(value, possibleValues[pos]);
-    }
-}
-
 uint8_t BIOSEnumAttribute::getAttrValueIndex()
 {
     auto defaultValueIndex = getValueIndex(defaultValue, possibleValues);
@@ -138,9 +69,7 @@ uint8_t BIOSEnumAttribute::getAttrValueIndex()
 
     try
     {
-        auto propValue = dbusHandler->getDbusPropertyVariant(
-            dBusMap->objectPath.c_str(), dBusMap->propertyName.c_str(),
-            dBusMap->interface.c_str());
+        auto propValue = getDbusPropertyValue();
         auto iter = valMap.find(propValue);
         if (iter == valMap.end())
         {
@@ -24,6 +24,13 @@ class BIOSEnumAttribute : public BIOSAttribute
 {
   public:
     friend class ::TestBIOSEnumAttribute;
+    /** @brief Construct a bios enum attribute
+     *  @param[in] schema - fields of the attribute
+     *  @param[in] dbusHandler - Dbus Handler
+     */
+    BIOSEnumAttribute(const AttributeSchema& schema,
+                      pldm::utils::DBusHandler* const dbusHandler);
+
     /** @brief Construct a bios enum attribute
      *  @param[in] entry - Json Object
      *  @param[in] dbusHandler - Dbus Handler
@@ -99,11 +106,6 @@ class BIOSEnumAttribute : public BIOSAttribute
     /** @brief Map of value on dbus and pldm */
     ValMap valMap;
 
-    /** @brief Build the map of dbus value to pldm enum value
-     *  @param[in] dbusVals - The dbus values in the json's dbus section
-     */
-    void buildValMap(const Json& dbusVals);
-
     /** @brief Get index of the current value in possible values
      *  @return The index of the current value in possible values
      */
@@ -14,16 +14,14 @@ namespace responder
 {
 namespace bios
 {
-BIOSIntegerAttribute::BIOSIntegerAttribute(const Json& entry,
+BIOSIntegerAttribute::BIOSIntegerAttribute(const AttributeSchema& schema,
                                            DBusHandler* const dbusHandler) :
-    BIOSAttribute(entry, dbusHandler)
+    BIOSAttribute(schema, dbusHandler)
 {
-    std::string attr = entry.at("attribute_name");
-
-    integerInfo.lowerBound = entry.at("lower_bound");
-    integerInfo.upperBound = entry.at("upper_bound");
-    integerInfo.scalarIncrement = entry.at("scalar_increment");
-    integerInfo.defaultValue = entry.at("default_value");
+    integerInfo.lowerBound = schema.lowerBound;
+    integerInfo.upperBound = schema.upperBound;
+    integerInfo.scalarIncrement = schema.scalarIncrement;
+    integerInfo.defaultValue = schema.defaultValue;
     pldm_bios_table_attr_entry_integer_info info = {
         0,
         readOnly,
@@ -38,7 +36,7 @@ BIOSIntegerAttribute::BIOSIntegerAttribute(const Json& entry,
     {
         error(
             "Wrong field for integer attribute '{ATTRIBUTE}', error '{ERROR}', lower bound '{LOW_BOUND}', upper bound '{UPPER_BOUND}', default value '{DEFAULT_VALUE}' and scalar increment '{SCALAR_INCREMENT}'",
-            "ATTRIBUTE", attr, "ERROR", errmsg, "LOW_BOUND",
+            "ATTRIBUTE", name, "ERROR", errmsg, "LOW_BOUND",
             integerInfo.lowerBound, "UPPER_BOUND", integerInfo.upperBound,
             "DEFAULT_VALUE", integerInfo.defaultValue, "SCALAR_INCREMENT",
             integerInfo.scalarIncrement);
@@ -46,6 +44,12 @@ BIOSIntegerAttribute::BIOSIntegerAttribute(const Json& entry,
     }
 }
 
+BIOSIntegerAttribute::BIOSIntegerAttribute(const Json& entry,
+                                           DBusHandler* const dbusHandler) :
+    BIOSIntegerAttribute(AttributeSchema::fromJson(entry, "integer"),
+                         dbusHandler)
+{}
+
 void BIOSIntegerAttribute::setAttrValueOnDbus(
     const pldm_bios_attr_val_table_entry* attrValueEntry,
     const pldm_bios_attr_table_entry*, const BIOSStringTable&)
@@ -193,9 +197,7 @@ uint64_t BIOSIntegerAttribute::getAttrValue()
 
     try
     {
-        auto propertyValue = dbusHandler->getDbusPropertyVariant(
-            dBusMap->objectPath.c_str(), dBusMap->propertyName.c_str(),
-            dBusMap->interface.c_str());
+        auto propertyValue = getDbusPropertyValue();
 
         return getAttrValue(propertyValue);
     }
@@ -20,6 +20,13 @@ class BIOSIntegerAttribute : public BIOSAttribute
   public:
     friend class ::TestBIOSIntegerAttribute;
 
+    /** @brief Construct a bios integer attribute
+     *  @param[in] schema - fields of the attribute
+     *  @param[in] dbusHandler - Dbus Handler
+     */
+    BIOSIntegerAttribute(const AttributeSchema& schema,
+                         pldm::utils::DBusHandler* const dbusHandler);
+
     /** @brief Construct a bios integer attribute
      *  @param[in] entry - Json Object
      *  @param[in] dbusHandler - Dbus Handler
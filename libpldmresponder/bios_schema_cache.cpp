@@ -0,0 +1,480 @@
+#include "bios_schema_cache.hpp"
+
+#include "common/fnv_hash.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+namespace bios
+{
+
+namespace
+{
+
+/** @brief Magic identifying a BIOS schema cache file */
+constexpr std::array<char, 8> biosSchemaMagic = {'P', 'L', 'D', 'M',
+                                                 'B', 'I', 'O', 'S'};
+constexpr uint32_t biosSchemaVersion = 2;
+
+/** @brief Size of the magic, version and key before the entries */
+constexpr size_t biosSchemaHeaderSize =
+    sizeof(biosSchemaMagic) + sizeof(biosSchemaVersion) + sizeof(uint64_t);
+
+/** @brief Append the fields of the schemas to the cache file data */
+class SchemaWriter
+{
+  public:
+    explicit SchemaWriter(std::vector<uint8_t>& data) : data(data) {}
+
+    template <typename T>
+    void write(T value)
+    {
+        static_assert(std::is_arithmetic_v<T>);
+        auto bytes = reinterpret_cast<const uint8_t*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(value));
+    }
+
+    void write(const std::string& value)
+    {
+        write(static_cast<uint32_t>(value.size()));
+        data.insert(data.end(), value.begin(), value.end());
+    }
+
+    void write(const std::vector<std::string>& values)
+    {
+        write(static_cast<uint32_t>(values.size()));
+        for (const auto& value : values)
+        {
+            write(value);
+        }
+    }
+
+    /** @brief Write a D-Bus value of an enum attribute, the strings are
+     *         written as is, the other types as 64 bits
+     */
+    void write(const pldm::utils::PropertyValue& value)
+    {
+        std::visit(
+            [this](const auto& v) {
+                using V = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<V, std::string>)
+                {
+                    write(v);
+                }
+                else if constexpr (std::is_same_v<V, double>)
+                {
+                    write(std::bit_cast<uint64_t>(v));
+                }
+                else if constexpr (std::is_arithmetic_v<V>)
+                {
+                    write(static_cast<uint64_t>(v));
+                }
+                else
+                {
+                    throw std::invalid_argument(
+                        "Unsupported D-Bus value of an enum attribute");
+                }
+            },
+            value);
+    }
+
+    void write(const AttributeSchema& schema)
+    {
+        write(schema.type);
+        write(schema.name);
+        write(schema.displayName);
+        write(schema.helpText);
+        write(static_cast<uint8_t>(schema.readOnly));
+        write(static_cast<uint8_t>(schema.dBusMap.has_value()));
+        if (schema.dBusMap)
+        {
+            write(schema.dBusMap->objectPath);
+            write(schema.dBusMap->interface);
+            write(schema.dBusMap->propertyName);
+            write(schema.dBusMap->propertyType);
+        }
+        write(schema.stringType);
+        write(schema.minLength);
+        write(schema.maxLength);
+        write(schema.defaultString);
+        write(schema.lowerBound);
+        write(schema.upperBound);
+        write(schema.scalarIncrement);
+        write(schema.defaultValue);
+        write(schema.possibleValues);
+        write(schema.defaultValues);
+        write(schema.valueNames);
+        write(static_cast<uint32_t>(schema.dbusValues.size()));
+        for (const auto& value : schema.dbusValues)
+        {
+            write(value);
+        }
+    }
+
+  private:
+    std::vector<uint8_t>& data;
+};
+
+/** @brief Read the schemas back from the cache file data, every read fails
+ *         once the data is exhausted
+ */
+class SchemaReader
+{
+  public:
+    explicit SchemaReader(std::span<const uint8_t> data) : data(data) {}
+
+    template <typename T>
+    bool read(T& value)
+    {
+        static_assert(std::is_arithmetic_v<T>);
+        if (data.size() < sizeof(value))
+        {
+            return false;
+        }
+        std::memcpy(&value, data.data(), sizeof(value));
+        data = data.subspan(sizeof(value));
+        return true;
+    }
+
+    bool read(bool& value)
+    {
+        uint8_t byte = 0;
+        if (!read(byte) || byte > 1)
+        {
+            return false;
+        }
+        value = byte;
+        return true;
+    }
+
+    bool read(std::string& value)
+    {
+        uint32_t size = 0;
+        if (!read(size) || data.size() < size)
+        {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(data.data()), size);
+        data = data.subspan(size);
+        return true;
+    }
+
+    bool read(std::vector<std::string>& values)
+    {
+        uint32_t count = 0;
+        if (!read(count) || data.size() < count * sizeof(uint32_t))
+        {
+            return false;
+        }
+        values.resize(count);
+        for (auto& value : values)
+        {
+            if (!read(value))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** @brief Read a D-Bus value of an enum attribute of the given type */
+    bool read(const std::string& type, pldm::utils::PropertyValue& value)
+    {
+        if (type == "string")
+        {
+            std::string str;
+            if (!read(str))
+            {
+                return false;
+            }
+            value = std::move(str);
+            return true;
+        }
+
+        uint64_t raw = 0;
+        if (!read(raw))
+        {
+            return false;
+        }
+        if (type == "uint8_t")
+        {
+            value = static_cast<uint8_t>(raw);
+        }
+        else if (type == "uint16_t")
+        {
+            value = static_cast<uint16_t>(raw);
+        }
+        else if (type == "uint32_t")
+        {
+            value = static_cast<uint32_t>(raw);
+        }
+        else if (type == "uint64_t")
+        {
+            value = raw;
+        }
+        else if (type == "int16_t")
+        {
+            value = static_cast<int16_t>(raw);
+        }
+        else if (type == "int32_t")
+        {
+            value = static_cast<int32_t>(raw);
+        }
+        else if (type == "int64_t")
+        {
+            value = static_cast<int64_t>(raw);
+        }
+        else if (type == "bool")
+        {
+            value = raw != 0;
+        }
+        else if (type == "double")
+        {
+            value = std::bit_cast<double>(raw);
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    bool read(AttributeSchema& schema)
+    {
+        bool hasDbus = false;
+        if (!read(schema.type) || !read(schema.name) ||
+            !read(schema.displayName) || !read(schema.helpText) ||
+            !read(schema.readOnly) || !read(hasDbus))
+        {
+            return false;
+        }
+        if (hasDbus)
+        {
+            schema.dBusMap.emplace();
+            if (!read(schema.dBusMap->objectPath) ||
+                !read(schema.dBusMap->interface) ||
+                !read(schema.dBusMap->propertyName) ||
+                !read(schema.dBusMap->propertyType))
+            {
+                return false;
+            }
+        }
+
+        uint32_t count = 0;
+        if (!read(schema.stringType) || !read(schema.minLength) ||
+            !read(schema.maxLength) || !read(schema.defaultString) ||
+            !read(schema.lowerBound) || !read(schema.upperBound) ||
+            !read(schema.scalarIncrement) || !read(schema.defaultValue) ||
+            !read(schema.possibleValues) || !read(schema.defaultValues) ||
+            !read(schema.valueNames) || !read(count))
+        {
+            return false;
+        }
+        if (count && (!hasDbus || data.size() < count * sizeof(uint32_t)))
+        {
+            return false;
+        }
+        schema.dbusValues.resize(count);
+        for (auto& value : schema.dbusValues)
+        {
+            if (!read(schema.dBusMap->propertyType, value))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** @brief Check that the whole data was read */
+    bool done() const
+    {
+        return data.empty();
+    }
+
+  private:
+    std::span<const uint8_t> data;
+};
+
+} // namespace
+
+uint64_t BIOSSchemaCache::computeKey(const std::filesystem::path& file,
+                                     const std::string& systemType)
+{
+    uint64_t hash = pldm::utils::fnvOffsetBasis;
+    std::array<char, 4096> buffer{};
+    pldm::utils::fnvHash(hash, file.native());
+    std::ifstream stream(file, std::ios::binary);
+    while (stream.read(buffer.data(), buffer.size()) || stream.gcount())
+    {
+        pldm::utils::fnvHash(
+            hash, std::string_view(buffer.data(), stream.gcount()));
+    }
+    pldm::utils::fnvHash(hash, 0xff);
+    pldm::utils::fnvHash(hash, systemType);
+    return hash;
+}
+
+std::optional<AttributeSchemas> BIOSSchemaCache::load(uint64_t key) const
+{
+    if (!enabled())
+    {
+        return std::nullopt;
+    }
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return std::nullopt;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) < 0 ||
+        static_cast<size_t>(st.st_size) <= biosSchemaHeaderSize)
+    {
+        close(fd);
+        return std::nullopt;
+    }
+
+    auto size = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        error("Failed to map BIOS schema cache {PATH}, error {ERROR}", "PATH",
+              path.string(), "ERROR", errno);
+        return std::nullopt;
+    }
+
+    auto data = static_cast<const uint8_t*>(mapped);
+    std::array<char, 8> magic{};
+    uint32_t version = 0;
+    uint64_t cacheKey = 0;
+    std::memcpy(magic.data(), data, sizeof(magic));
+    std::memcpy(&version, data + sizeof(magic), sizeof(version));
+    std::memcpy(&cacheKey, data + sizeof(magic) + sizeof(version),
+                sizeof(cacheKey));
+
+    std::optional<AttributeSchemas> schemas;
+    if (magic == biosSchemaMagic && version == biosSchemaVersion &&
+        cacheKey == key)
+    {
+        SchemaReader reader(
+            std::span(data, size).subspan(biosSchemaHeaderSize));
+        uint32_t count = 0;
+        AttributeSchemas loaded;
+        bool valid = reader.read(count);
+        for (uint32_t i = 0; valid && i < count; ++i)
+        {
+            valid = reader.read(loaded.emplace_back());
+        }
+        if (valid && reader.done())
+        {
+            schemas = std::move(loaded);
+        }
+    }
+    munmap(mapped, size);
+
+    if (!schemas)
+    {
+        info("BIOS schema cache {PATH} is stale or corrupted", "PATH",
+             path.string());
+    }
+    return schemas;
+}
+
+bool BIOSSchemaCache::store(uint64_t key,
+                            const AttributeSchemas& schemas) const
+{
+    if (!enabled())
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> data(biosSchemaHeaderSize);
+    std::memcpy(data.data(), biosSchemaMagic.data(), sizeof(biosSchemaMagic));
+    std::memcpy(data.data() + sizeof(biosSchemaMagic), &biosSchemaVersion,
+                sizeof(biosSchemaVersion));
+    std::memcpy(data.data() + sizeof(biosSchemaMagic) +
+                    sizeof(biosSchemaVersion),
+                &key, sizeof(key));
+    try
+    {
+        SchemaWriter writer(data);
+        writer.write(static_cast<uint32_t>(schemas.size()));
+        for (const auto& schema : schemas)
+        {
+            writer.write(schema);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to encode BIOS schema cache {PATH}, error {ERROR}",
+              "PATH", path.string(), "ERROR", e);
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    if (ec)
+    {
+        error(
+            "Failed to create BIOS schema cache directory {DIR}, error {ERROR}",
+            "DIR", path.parent_path().string(), "ERROR", ec.message());
+        return false;
+    }
+
+    /* Write a temporary file and rename it, a crash must not leave a
+     * partially written cache behind */
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        file.close();
+        if (!file)
+        {
+            error("Failed to write BIOS schema cache {PATH}", "PATH",
+                  tmpPath.string());
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec)
+    {
+        error("Failed to update BIOS schema cache {PATH}, error {ERROR}",
+              "PATH", path.string(), "ERROR", ec.message());
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace bios
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "bios_attribute.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace pldm
+{
+namespace responder
+{
+namespace bios
+{
+
+/**
+ * @brief BIOSSchemaCache
+ *
+ * Keeps the attribute schemas parsed from the BIOS attribute JSON file in a
+ * binary file, so the JSON file is not parsed again on the next start of
+ * pldmd and the attributes are built from the schemas without a JSON DOM.
+ * The cache is identified by a key computed from the content of the JSON file
+ * and the system type, a cache stored for another key is ignored.
+ */
+class BIOSSchemaCache
+{
+  public:
+    BIOSSchemaCache() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] path - File holding the cache, empty to disable the cache
+     */
+    explicit BIOSSchemaCache(const std::filesystem::path& path) : path(path)
+    {}
+
+    /** @brief Check if the cache is enabled */
+    bool enabled() const
+    {
+        return !path.empty();
+    }
+
+    /** @brief Compute the key of the attribute entries of a JSON file
+     *
+     *  @param[in] file - the BIOS attribute JSON file
+     *  @param[in] systemType - the system type the file is used for
+     *  @return the key
+     */
+    static uint64_t computeKey(const std::filesystem::path& file,
+                               const std::string& systemType);
+
+    /** @brief Load the attribute schemas
+     *
+     *  @param[in] key - Key of the current JSON file
+     *  @return the schemas, std::nullopt if there are none, the cache is
+     *          corrupted or was stored for a different key
+     */
+    std::optional<AttributeSchemas> load(uint64_t key) const;
+
+    /** @brief Store the attribute schemas, replacing the previous ones
+     *
+     *  @param[in] key - Key of the JSON file the schemas were parsed from
+     *  @param[in] schemas - the attribute schemas
+     *  @return true if the cache was written
+     */
+    bool store(uint64_t key, const AttributeSchemas& schemas) const;
+
+  private:
+    /** @brief File holding the cache */
+    std::filesystem::path path;
+};
+
+} // namespace bios
+} // namespace responder
+} // namespace pldm
@@ -17,23 +17,22 @@ namespace responder
 {
 namespace bios
 {
-BIOSStringAttribute::BIOSStringAttribute(const Json& entry,
+BIOSStringAttribute::BIOSStringAttribute(const AttributeSchema& schema,
                                          DBusHandler* const dbusHandler) :
-    BIOSAttribute(entry, dbusHandler)
+    BIOSAttribute(schema, dbusHandler)
 {
-    std::string strTypeTmp = entry.at("string_type");
-    auto iter = strTypeMap.find(strTypeTmp);
+    auto iter = strTypeMap.find(schema.stringType);
     if (iter == strTypeMap.end())
     {
         error("Wrong string type '{TYPE}' for attribute '{ATTRIBUTE}'", "TYPE",
-              strTypeTmp, "ATTRIBUTE", name);
+              schema.stringType, "ATTRIBUTE", name);
         throw std::invalid_argument("Wrong string type");
     }
     stringInfo.stringType = static_cast<uint8_t>(iter->second);
 
-    stringInfo.minLength = entry.at("minimum_string_length");
-    stringInfo.maxLength = entry.at("maximum_string_length");
-    stringInfo.defString = entry.at("default_string");
+    stringInfo.minLength = schema.minLength;
+    stringInfo.maxLength = schema.maxLength;
+    stringInfo.defString = schema.defaultString;
     stringInfo.defLength =
         static_cast<uint16_t>((stringInfo.defString).length());
 
@@ -61,6 +60,12 @@ BIOSStringAttribute::BIOSStringAttribute(const Json& entry,
     }
 }
 
+BIOSStringAttribute::BIOSStringAttribute(const Json& entry,
+                                         DBusHandler* const dbusHandler) :
+    BIOSStringAttribute(AttributeSchema::fromJson(entry, "string"),
+                        dbusHandler)
+{}
+
 void BIOSStringAttribute::setAttrValueOnDbus(
     const pldm_bios_attr_val_table_entry* attrValueEntry,
     const pldm_bios_attr_table_entry*, const BIOSStringTable&)
@@ -83,9 +88,7 @@ std::string BIOSStringAttribute::getAttrValue()
     }
     try
     {
-        return dbusHandler->getDbusProperty<std::string>(
-            dBusMap->objectPath.c_str(), dBusMap->propertyName.c_str(),
-            dBusMap->interface.c_str());
+        return std::get<std::string>(getDbusPropertyValue());
     }
     catch (const std::exception& e)
     {
@@ -43,6 +43,13 @@ class BIOSStringAttribute : public BIOSAttribute
         {"UTF-16LE", Encoding::UTF_16LE},
         {"Vendor Specific", Encoding::VENDOR_SPECIFIC}};
 
+    /** @brief Construct a bios string attribute
+     *  @param[in] schema - fields of the attribute
+     *  @param[in] dbusHandler - Dbus Handler
+     */
+    BIOSStringAttribute(const AttributeSchema& schema,
+                        pldm::utils::DBusHandler* const dbusHandler);
+
     /** @brief Construct a bios string attribute
      *  @param[in] entry - Json Object
      *  @param[in] dbusHandler - Dbus Handler
@@ -1,5 +1,7 @@
 #include "bios_table.hpp"
 
+#include "common/bios_utils.hpp"
+
 #include <libpldm/base.h>
 #include <libpldm/bios_table.h>
 #include <libpldm/utils.h>
@@ -48,35 +50,59 @@ void BIOSTable::load(Response& response) const
 }
 
 BIOSStringTable::BIOSStringTable(const Table& stringTable) :
-    stringTable(stringTable)
+    stringTable(std::make_shared<const Table>(stringTable))
+{}
+
+BIOSStringTable::BIOSStringTable(std::shared_ptr<const Table> stringTable) :
+    stringTable(std::move(stringTable))
 {}
 
 BIOSStringTable::BIOSStringTable(const BIOSTable& biosTable)
 {
-    biosTable.load(stringTable);
+    Table table;
+    biosTable.load(table);
+    stringTable = std::make_shared<const Table>(std::move(table));
+}
+
+void BIOSStringTable::buildIndex() const
+{
+    if (indexed)
+    {
+        return;
+    }
+    for (auto entry : pldm::bios::utils::BIOSTableIter<PLDM_BIOS_STRING_TABLE>(
+             stringTable->data(), stringTable->size()))
+    {
+        auto handle = table::string::decodeHandle(entry);
+        offsets.emplace(handle, reinterpret_cast<const uint8_t*>(entry) -
+                                    stringTable->data());
+        handles.emplace(table::string::decodeString(entry), handle);
+    }
+    indexed = true;
 }
 
 std::string BIOSStringTable::findString(uint16_t handle) const
 {
-    auto stringEntry = pldm_bios_table_string_find_by_handle(
-        stringTable.data(), stringTable.size(), handle);
-    if (stringEntry == nullptr)
+    buildIndex();
+    auto it = offsets.find(handle);
+    if (it == offsets.end())
     {
         throw std::invalid_argument("Invalid String Handle");
     }
-    return table::string::decodeString(stringEntry);
+    return table::string::decodeString(
+        reinterpret_cast<const pldm_bios_string_table_entry*>(
+            stringTable->data() + it->second));
 }
 
 uint16_t BIOSStringTable::findHandle(const std::string& name) const
 {
-    auto stringEntry = pldm_bios_table_string_find_by_string(
-        stringTable.data(), stringTable.size(), name.c_str());
-    if (stringEntry == nullptr)
+    buildIndex();
+    auto it = handles.find(name);
+    if (it == handles.end())
     {
         throw std::invalid_argument("Invalid String Name");
     }
-
-    return table::string::decodeHandle(stringEntry);
+    return it->second;
 }
 
 namespace table
@@ -5,8 +5,10 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace pldm
@@ -108,6 +110,12 @@ class BIOSStringTable : public BIOSStringTableInterface
      */
     BIOSStringTable(const Table& stringTable);
 
+    /** @brief Constructs BIOSStringTable sharing a table, without copying it
+     *
+     *  @param[in] stringTable - The stringTable in RAM, never modified
+     */
+    explicit BIOSStringTable(std::shared_ptr<const Table> stringTable);
+
     /** @brief Constructs BIOSStringTable
      *
      *  @param[in] biosTable - The BIOSTable
@@ -131,7 +139,18 @@ class BIOSStringTable : public BIOSStringTableInterface
     uint16_t findHandle(const std::string& name) const override;
 
   private:
-    Table stringTable;
+    /** @brief Index the entries of the table, on the first lookup */
+    void buildIndex() const;
+
+    std::shared_ptr<const Table> stringTable;
+
+    mutable bool indexed = false;
+
+    /** @brief Offset of the entry of each string handle */
+    mutable std::unordered_map<uint16_t, size_t> offsets;
+
+    /** @brief Handle of each string, the first one for duplicated strings */
+    mutable std::unordered_map<std::string, uint16_t> handles;
 };
 
 namespace table
@@ -1,10 +1,11 @@
 #include "event_parser.hpp"
 
+#include "common/json_cache.hpp"
+
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
 #include <filesystem>
-#include <fstream>
 #include <set>
 
 PHOSPHOR_LOG2_USING;
@@ -34,9 +35,8 @@ StateSensorHandler::StateSensorHandler(const std::string& dirPath)
 
     for (auto& file : fs::directory_iterator(dirPath))
     {
-        std::ifstream jsonFile(file.path());
-
-        auto data = Json::parse(jsonFile, nullptr, false);
+        auto data = pldm::utils::JsonCache::getInstance().parse(file.path(),
+                                                                false);
         if (data.is_discarded())
         {
             error("Failed to parse event state sensor JSON file at '{PATH}'",
@@ -96,9 +96,21 @@ StateSensorHandler::StateSensorHandler(const std::string& dirPath)
 
             auto eventStateMap = mapStateToDBusVal(eventStates, propertyValues,
                                                    dbusInfo.propertyType);
-            eventMap.emplace(
-                stateSensorEntry,
-                std::make_tuple(std::move(dbusInfo), std::move(eventStateMap)));
+            auto& events =
+                stateSensorEntry.skipContainerId
+                    ? anyContainerEventMap[eventKey(stateSensorEntry, 0)]
+                    : eventMap[eventKey(stateSensorEntry,
+                                        stateSensorEntry.containerId)];
+            if (stateSensorEntry.sensorOffset >= events.size())
+            {
+                events.resize(stateSensorEntry.sensorOffset + 1);
+            }
+            // The first entry of a sensor wins, as with a map
+            auto& event = events[stateSensorEntry.sensorOffset];
+            if (!event)
+            {
+                event.emplace(std::move(dbusInfo), std::move(eventStateMap));
+            }
         }
     }
 }
@@ -122,40 +134,32 @@ StateToDBusValue StateSensorHandler::mapStateToDBusVal(
 int StateSensorHandler::eventAction(const StateSensorEntry& entry,
                                     pdr::EventState state)
 {
-    try
-    {
-        const auto& [dbusMapping, eventStateMap] = eventMap.at(entry);
-        utils::PropertyValue propValue{};
-        try
-        {
-            propValue = eventStateMap.at(state);
-        }
-        catch (const std::out_of_range& e)
-        {
-            error("Invalid event state '{EVENT_STATE}', error - {ERROR}",
-                  "EVENT_STATE", state, "ERROR", e);
-            return PLDM_ERROR_INVALID_DATA;
-        }
-
-        try
-        {
-            pldm::utils::DBusHandler().setDbusProperty(dbusMapping, propValue);
-        }
-        catch (const std::exception& e)
-        {
-            error(
-                "Failed to  set property '{PROPERTY}' on interface '{INTERFACE}' at path '{PATH}', error - {ERROR}",
-                "PROPERTY", dbusMapping.propertyName, "INTERFACE",
-                dbusMapping.interface, "PATH", dbusMapping.objectPath, "ERROR",
-                e);
-            return PLDM_ERROR;
-        }
-    }
-    catch (const std::out_of_range&)
+    auto info = findEventInfo(entry);
+    if (!info)
     {
         // There is no BMC action for this PLDM event
         return PLDM_SUCCESS;
     }
+
+    const auto& [dbusMapping, eventStateMap] = *info;
+    auto propValue = eventStateMap.find(state);
+    if (!propValue)
+    {
+        error("Invalid event state '{EVENT_STATE}'", "EVENT_STATE", state);
+        return PLDM_ERROR_INVALID_DATA;
+    }
+
+    pldm::utils::AsyncDBusHandler().setDbusProperty(
+        dbusMapping, *propValue, [dbusMapping](int rc) {
+            if (rc)
+            {
+                error(
+                    "Failed to  set property '{PROPERTY}' on interface '{INTERFACE}' at path '{PATH}', response code '{RC}'",
+                    "PROPERTY", dbusMapping.propertyName, "INTERFACE",
+                    dbusMapping.interface, "PATH", dbusMapping.objectPath,
+                    "RC", rc);
+            }
+        });
     return PLDM_SUCCESS;
 }
 
@@ -6,9 +6,11 @@
 #include <nlohmann/json.hpp>
 
 #include <filesystem>
-#include <map>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace pldm::responder::events
@@ -18,8 +20,7 @@ namespace pldm::responder::events
  *
  *  StateSensorEntry is a key to uniquely identify a state sensor, so that a
  *  D-Bus action can be defined for PlatformEventMessage command with
- *  sensorEvent type. This struct is used as a key in a std::map so implemented
- *  operator== and operator<.
+ *  sensorEvent type.
  */
 struct StateSensorEntry
 {
@@ -29,48 +30,73 @@ struct StateSensorEntry
     pdr::SensorOffset sensorOffset;
     pdr::StateSetId stateSetid;
     bool skipContainerId;
+};
 
-    bool operator==(const StateSensorEntry& e) const
+/** @class StateToDBusValue
+ *
+ *  D-Bus property values of the event states of a sensor, indexed by the
+ *  event state.
+ */
+class StateToDBusValue
+{
+  public:
+    /** @brief Set the property value of an event state
+     *
+     *  @param[in] state - event state
+     *  @param[in] value - D-Bus property value
+     */
+    void emplace(pdr::EventState state, pldm::utils::PropertyValue&& value)
     {
-        if (!skipContainerId)
-        {
-            return ((containerId == e.containerId) &&
-                    (entityType == e.entityType) &&
-                    (entityInstance == e.entityInstance) &&
-                    (sensorOffset == e.sensorOffset) &&
-                    (stateSetid == e.stateSetid));
-        }
-        else
+        if (state >= values.size())
         {
-            return ((entityType == e.entityType) &&
-                    (entityInstance == e.entityInstance) &&
-                    (sensorOffset == e.sensorOffset) &&
-                    (stateSetid == e.stateSetid));
+            values.resize(state + 1);
         }
+        values[state] = std::move(value);
     }
 
-    bool operator<(const StateSensorEntry& e) const
+    /** @brief Get the property value of an event state
+     *
+     *  @param[in] state - event state
+     *
+     *  @return the property value, nullptr if the state has none
+     */
+    const pldm::utils::PropertyValue* find(pdr::EventState state) const
     {
-        if (!skipContainerId)
+        if (state >= values.size() || !values[state])
         {
-            return std::tie(entityType, entityInstance, containerId,
-                            sensorOffset, stateSetid) <
-                   std::tie(e.entityType, e.entityInstance, e.containerId,
-                            e.sensorOffset, e.stateSetid);
+            return nullptr;
         }
-        else
+        return &*values[state];
+    }
+
+    /** @brief Get the property value of an event state
+     *
+     *  @param[in] state - event state
+     *
+     *  @return the property value
+     *  @throw std::out_of_range if the state has no value
+     */
+    const pldm::utils::PropertyValue& at(pdr::EventState state) const
+    {
+        auto value = find(state);
+        if (!value)
         {
-            return std::tie(entityType, entityInstance, sensorOffset,
-                            stateSetid) <
-                   std::tie(e.entityType, e.entityInstance, e.sensorOffset,
-                            e.stateSetid);
+            throw std::out_of_range("No property value for the event state");
         }
+        return *value;
     }
+
+  private:
+    std::vector<std::optional<pldm::utils::PropertyValue>> values;
 };
 
-using StateToDBusValue = std::map<pdr::EventState, pldm::utils::PropertyValue>;
 using EventDBusInfo = std::tuple<pldm::utils::DBusMapping, StateToDBusValue>;
-using EventMap = std::map<StateSensorEntry, EventDBusInfo>;
+/** @brief D-Bus information of the sensors of an entity and state set, indexed
+ *         by sensor offset
+ */
+using SensorOffsetEvents = std::vector<std::optional<EventDBusInfo>>;
+/** @brief Events of the entity and state set packed by eventKey() */
+using EventMap = std::unordered_map<uint64_t, SensorOffsetEvents>;
 using Json = nlohmann::json;
 
 /** @class StateSensorHandler
@@ -104,7 +130,7 @@ class StateSensorHandler
      *  @param[in] entry - state sensor entry
      *  @param[in] state - event state
      *
-     *  @return PLDM completion code
+     *  @return PLDM completion code, the property is set once this returned
      */
     int eventAction(const StateSensorEntry& entry, pdr::EventState state);
 
@@ -113,14 +139,82 @@ class StateSensorHandler
      *  @param[in] entry - state sensor entry
      *
      *  @return D-Bus information corresponding to the SensorEntry
+     *  @throw std::out_of_range if no action is defined for the sensor
      */
     const EventDBusInfo& getEventInfo(const StateSensorEntry& entry) const
     {
-        return eventMap.at(entry);
+        auto info = findEventInfo(entry);
+        if (!info)
+        {
+            throw std::out_of_range("No event defined for the state sensor");
+        }
+        return *info;
     }
 
   private:
-    EventMap eventMap; //!< a map of StateSensorEntry to D-Bus information
+    /** @brief Events of the sensors configured with a container ID */
+    EventMap eventMap;
+    /** @brief Events of the sensors configured without a container ID,
+     *         matching any container
+     */
+    EventMap anyContainerEventMap;
+
+    /** @brief Pack the entity and state set of a sensor into a key of the
+     *         event maps
+     *
+     *  @param[in] entry - state sensor entry
+     *  @param[in] containerId - container ID to key the entry with
+     *
+     *  @return the key
+     */
+    static uint64_t eventKey(const StateSensorEntry& entry,
+                             pdr::ContainerID containerId)
+    {
+        return (static_cast<uint64_t>(entry.entityType) << 48) |
+               (static_cast<uint64_t>(entry.entityInstance) << 32) |
+               (static_cast<uint64_t>(containerId) << 16) | entry.stateSetid;
+    }
+
+    /** @brief Look the D-Bus information of a sensor up in an event map
+     *
+     *  @param[in] map - event map
+     *  @param[in] key - key of the entity and state set of the sensor
+     *  @param[in] sensorOffset - sensor offset
+     *
+     *  @return the D-Bus information, nullptr if there is none
+     */
+    static const EventDBusInfo* findEventInfo(const EventMap& map,
+                                              uint64_t key,
+                                              pdr::SensorOffset sensorOffset)
+    {
+        auto it = map.find(key);
+        if (it == map.end() || sensorOffset >= it->second.size() ||
+            !it->second[sensorOffset])
+        {
+            return nullptr;
+        }
+        return &*it->second[sensorOffset];
+    }
+
+    /** @brief Get the D-Bus information of a sensor, the sensors configured
+     *         with its container ID take precedence over the ones configured
+     *         without one
+     *
+     *  @param[in] entry - state sensor entry
+     *
+     *  @return the D-Bus information, nullptr if there is none
+     */
+    const EventDBusInfo* findEventInfo(const StateSensorEntry& entry) const
+    {
+        if (auto info = findEventInfo(
+                eventMap, eventKey(entry, entry.containerId),
+                entry.sensorOffset))
+        {
+            return info;
+        }
+        return findEventInfo(anyContainerEventMap, eventKey(entry, 0),
+                             entry.sensorOffset);
+    }
 
     /** @brief Create a map of EventState to D-Bus property values from
      *         the information provided in the event state configuration
@@ -130,7 +224,7 @@ class StateSensorHandler
      *  @param[in] propertyValues - a JSON array of D-Bus property values
      *  @param[in] type - the type of D-Bus property
      *
-     *  @return a map of EventState to D-Bus property values
+     *  @return the D-Bus property values indexed by EventState
      */
     StateToDBusValue mapStateToDBusVal(const Json& eventStates,
                                        const Json& propertyValues,
@@ -1,5 +1,6 @@
 #include "fru.hpp"
 
+#include "common/startup_profiler.hpp"
 #include "common/utils.hpp"
 
 #include <libpldm/entity.h>
@@ -9,9 +10,11 @@
 #include <phosphor-logging/lg2.hpp>
 #include <sdbusplus/bus.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <optional>
 #include <set>
-#include <stack>
 
 PHOSPHOR_LOG2_USING;
 
@@ -22,21 +25,21 @@ namespace responder
 
 constexpr auto root = "/xyz/openbmc_project/inventory/";
 
+/** @brief Types of the PDRs the FRUs are described by */
+static const std::vector<uint8_t> fruPdrTypes{PLDM_PDR_ENTITY_ASSOCIATION,
+                                              PLDM_PDR_FRU_RECORD_SET};
+
 std::optional<pldm_entity> FruImpl::getEntityByObjectPath(
     const dbus::InterfaceMap& intfMaps)
 {
     for (const auto& intfMap : intfMaps)
     {
-        try
+        if (auto entityType = parser.findEntityType(intfMap.first))
         {
             pldm_entity entity{};
-            entity.entity_type = parser.getEntityType(intfMap.first);
+            entity.entity_type = *entityType;
             return entity;
         }
-        catch (const std::exception&)
-        {
-            continue;
-        }
     }
 
     return std::nullopt;
@@ -45,96 +48,87 @@ std::optional<pldm_entity> FruImpl::getEntityByObjectPath(
 void FruImpl::updateAssociationTree(const dbus::ObjectValueTree& objects,
                                     const std::string& path)
 {
-    if (path.find(root) == std::string::npos)
+    if (path.find(root) == std::string::npos || objToEntityNode.contains(path))
     {
         return;
     }
 
-    std::stack<std::string> tmpObjPaths{};
-    tmpObjPaths.emplace(path);
-
-    auto obj = pldm::utils::findParent(path);
-    while ((obj + '/') != root)
+    // Walk up to the closest ancestor already in the tree, the objects are
+    // processed parents first so it is usually the parent itself
+    std::vector<std::string> newPaths{path};
+    pldm_entity_node* parent = nullptr;
+    for (auto obj = pldm::utils::findParent(path); (obj + '/') != root;
+         obj = pldm::utils::findParent(obj))
     {
-        tmpObjPaths.emplace(obj);
-        obj = pldm::utils::findParent(obj);
+        if (auto it = objToEntityNode.find(obj); it != objToEntityNode.end())
+        {
+            parent = it->second;
+            break;
+        }
+        newPaths.push_back(obj);
     }
 
-    std::stack<std::string> tmpObj = tmpObjPaths;
-    while (!tmpObj.empty())
+    // Add the missing entities top down, the chain stops at the first
+    // object which is not an entity. The instance numbers are assigned by
+    // the tree among the siblings of the same type.
+    for (auto it = newPaths.rbegin(); it != newPaths.rend(); ++it)
     {
-        std::string s = tmpObj.top();
-        tmpObj.pop();
-    }
-    // Update pldm entity to association tree
-    std::string prePath = tmpObjPaths.top();
-    while (!tmpObjPaths.empty())
-    {
-        std::string currPath = tmpObjPaths.top();
-        tmpObjPaths.pop();
-
-        do
+        auto object = objects.find(*it);
+        if (object == objects.end())
         {
-            if (objToEntityNode.contains(currPath))
-            {
-                pldm_entity node =
-                    pldm_entity_extract(objToEntityNode.at(currPath));
-                if (pldm_entity_association_tree_find_with_locality(
-                        entityTree, &node, false))
-                {
-                    break;
-                }
-            }
-            else
-            {
-                if (!objects.contains(currPath))
-                {
-                    break;
-                }
-
-                auto entityPtr = getEntityByObjectPath(objects.at(currPath));
-                if (!entityPtr)
-                {
-                    break;
-                }
+            return;
+        }
 
-                pldm_entity entity = *entityPtr;
+        auto entity = getEntityByObjectPath(object->second);
+        if (!entity)
+        {
+            return;
+        }
 
-                for (const auto& it : objToEntityNode)
-                {
-                    pldm_entity node = pldm_entity_extract(it.second);
-                    if (node.entity_type == entity.entity_type)
-                    {
-                        entity.entity_instance_num =
-                            node.entity_instance_num + 1;
-                        break;
-                    }
-                }
+        auto node = pldm_entity_association_tree_add_entity(
+            entityTree, &*entity, 0xFFFF, parent,
+            PLDM_ENTITY_ASSOCIAION_PHYSICAL, false, true, 0xFFFF);
+        if (!node)
+        {
+            return;
+        }
+        objToEntityNode[*it] = node;
+        objToEntity[*it] = pldm_entity_extract(node);
+        parent = node;
+    }
+}
 
-                if (currPath == prePath)
-                {
-                    auto node = pldm_entity_association_tree_add_entity(
-                        entityTree, &entity, 0xFFFF, nullptr,
-                        PLDM_ENTITY_ASSOCIAION_PHYSICAL, false, true, 0xFFFF);
-                    objToEntityNode[currPath] = node;
-                }
-                else
-                {
-                    if (objToEntityNode.contains(prePath))
-                    {
-                        auto node = pldm_entity_association_tree_add_entity(
-                            entityTree, &entity, 0xFFFF,
-                            objToEntityNode[prePath],
-                            PLDM_ENTITY_ASSOCIAION_PHYSICAL, false, true,
-                            0xFFFF);
-                        objToEntityNode[currPath] = node;
-                    }
-                }
-            }
-        } while (0);
+/** @brief Check the presence of a FRU, from its inventory interfaces when
+ *         they hold the Present property
+ */
+static bool isFruPresent(const std::string& objPath,
+                         const dbus::InterfaceMap& interfaces)
+{
+    auto item = interfaces.find("xyz.openbmc_project.Inventory.Item");
+    if (item != interfaces.end())
+    {
+        auto present = item->second.find("Present");
+        if (present != item->second.end() &&
+            std::holds_alternative<bool>(present->second))
+        {
+            return std::get<bool>(present->second);
+        }
+    }
+    return pldm::utils::checkForFruPresence(objPath);
+}
 
-        prePath = currPath;
+/** @brief Size of the FRU record at the start of a buffer, with its fields
+ */
+static size_t fruRecordSize(const uint8_t* data)
+{
+    auto record = reinterpret_cast<const pldm_fru_record_data_format*>(data);
+    size_t size = FruImpl::recHeaderSize;
+    for (uint8_t i = 0; i < record->num_fru_fields; i++)
+    {
+        auto tlv = reinterpret_cast<const pldm_fru_record_tlv*>(data + size);
+        size += offsetof(pldm_fru_record_tlv, value) + tlv->length;
     }
+    return size;
 }
 
 void FruImpl::buildFRUTable()
@@ -143,14 +137,18 @@ void FruImpl::buildFRUTable()
     {
         return;
     }
+    auto begin = std::chrono::steady_clock::now();
 
     fru_parser::DBusLookupInfo dbusInfo;
 
     try
     {
         dbusInfo = parser.inventoryLookup();
-        objects = pldm::utils::DBusHandler::getInventoryObjects<
-            pldm::utils::DBusHandler>();
+        if (!objectsFetched)
+        {
+            objects = pldm::utils::DBusHandler::getInventoryObjects<
+                pldm::utils::DBusHandler>();
+        }
     }
     catch (const std::exception& e)
     {
@@ -160,51 +158,11 @@ void FruImpl::buildFRUTable()
         return;
     }
 
-    auto itemIntfsLookup = std::get<2>(dbusInfo);
+    itemInterfaces = std::get<2>(dbusInfo);
 
-    for (const auto& object : objects)
+    for (const auto& [path, interfaces] : objects)
     {
-        const auto& interfaces = object.second;
-        for (const auto& interface : interfaces)
-        {
-            if (itemIntfsLookup.contains(interface.first))
-            {
-                // checking fru present property is available or not.
-                if (!pldm::utils::checkForFruPresence(object.first.str))
-                {
-                    continue;
-                }
-
-                // An exception will be thrown by getRecordInfo, if the item
-                // D-Bus interface name specified in FRU_Master.json does
-                // not have corresponding config jsons
-                try
-                {
-                    updateAssociationTree(objects, object.first.str);
-                    pldm_entity entity{};
-                    if (objToEntityNode.contains(object.first.str))
-                    {
-                        pldm_entity_node* node =
-                            objToEntityNode.at(object.first.str);
-
-                        entity = pldm_entity_extract(node);
-                    }
-
-                    auto recordInfos = parser.getRecordInfo(interface.first);
-                    populateRecords(interfaces, recordInfos, entity);
-
-                    associatedEntityMap.emplace(object.first, entity);
-                    break;
-                }
-                catch (const std::exception& e)
-                {
-                    error(
-                        "Config JSONs missing for the item '{INTERFACE}', error - {ERROR}",
-                        "INTERFACE", interface.first, "ERROR", e);
-                    break;
-                }
-            }
-        }
+        addFru(path.str, interfaces);
     }
 
     int rc = pldm_entity_association_pdr_add(entityTree, pdrRepo, false,
@@ -220,7 +178,342 @@ void FruImpl::buildFRUTable()
     // save a copy of bmc's entity association tree
     pldm_entity_association_tree_copy_root(entityTree, bmcEntityTree);
 
+    // The PDRs are fetched once the table is built, the hotplug reports the
+    // changes from there
+    pdrChangeLog.update(pdrRepo, fruPdrTypes, pdr_utils::PdrOrigin::local);
+    watchInventory();
     isBuilt = true;
+    stats::StartupProfiler::getInstance().phase("FruTable", begin);
+}
+
+std::optional<std::string> FruImpl::findItemInterface(
+    const dbus::InterfaceMap& interfaces) const
+{
+    for (const auto& [interface, properties] : interfaces)
+    {
+        if (itemInterfaces.contains(interface))
+        {
+            return interface;
+        }
+    }
+    return std::nullopt;
+}
+
+void FruImpl::addFru(const dbus::ObjectPath& path,
+                     const dbus::InterfaceMap& interfaces)
+{
+    if (!findItemInterface(interfaces) || !isFruPresent(path, interfaces))
+    {
+        return;
+    }
+
+    updateAssociationTree(objects, path);
+    pldm_entity entity{};
+    if (auto it = objToEntityNode.find(path); it != objToEntityNode.end())
+    {
+        entity = pldm_entity_extract(it->second);
+    }
+    if (addRecords(path, interfaces, entity))
+    {
+        associatedEntityMap.emplace(path, entity);
+    }
+}
+
+bool FruImpl::addRecords(const dbus::ObjectPath& path,
+                         const dbus::InterfaceMap& interfaces,
+                         const pldm_entity& entity)
+{
+    auto interface = findItemInterface(interfaces);
+    if (!interface)
+    {
+        return false;
+    }
+
+    // An exception will be thrown by getRecordInfo, if the item D-Bus
+    // interface name specified in FRU_Master.json does not have
+    // corresponding config jsons
+    try
+    {
+        const auto& recordInfos = parser.getRecordInfo(*interface);
+        auto recordSet = populateRecords(interfaces, recordInfos, entity);
+        if (recordSet)
+        {
+            objToRSI[path] = recordSet;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Config JSONs missing for the item '{INTERFACE}', error - {ERROR}",
+            "INTERFACE", *interface, "ERROR", e);
+        return false;
+    }
+    return true;
+}
+
+void FruImpl::removeRecords(const dbus::ObjectPath& path)
+{
+    auto it = objToRSI.find(path);
+    if (it == objToRSI.end())
+    {
+        return;
+    }
+    auto recordSet = it->second;
+    objToRSI.erase(it);
+    numRecordSets--;
+
+    uint32_t recordHandle = 0;
+    pldm_pdr_remove_fru_record_set_by_rsi(pdrRepo, recordSet, false,
+                                          &recordHandle);
+    pdr_utils::Repo::invalidateIndex(pdrRepo);
+
+    // Drop the records of the set, the records of the other sets keep
+    // their order
+    size_t kept = 0;
+    size_t offset = 0;
+    while (offset + recHeaderSize <= table.size())
+    {
+        auto record = reinterpret_cast<const pldm_fru_record_data_format*>(
+            table.data() + offset);
+        auto recordSize = fruRecordSize(table.data() + offset);
+        if (le16toh(record->record_set_id) == recordSet)
+        {
+            numRecs--;
+        }
+        else
+        {
+            std::copy_n(table.begin() + offset, recordSize,
+                        table.begin() + kept);
+            kept += recordSize;
+        }
+        offset += recordSize;
+    }
+    table.resize(kept);
+    tableChanged();
+}
+
+void FruImpl::removeFru(const dbus::ObjectPath& path)
+{
+    removeRecords(path);
+
+    auto it = associatedEntityMap.find(path);
+    if (it == associatedEntityMap.end())
+    {
+        return;
+    }
+    auto entity = it->second;
+    associatedEntityMap.erase(it);
+
+    // The entity stays while it contains others, like a chassis whose
+    // boards are still present
+    auto node = objToEntityNode.find(path);
+    if (node == objToEntityNode.end() ||
+        pldm_entity_is_node_parent(node->second))
+    {
+        return;
+    }
+    objToEntityNode.erase(node);
+    objToEntity.erase(path);
+
+    uint32_t recordHandle = 0;
+    pldm_entity_association_pdr_remove_contained_entity(pdrRepo, &entity,
+                                                        false, &recordHandle);
+    pdr_utils::Repo::invalidateIndex(pdrRepo);
+    pldm_entity_association_tree_delete_node(entityTree, &entity);
+    pldm_entity_association_tree_delete_node(bmcEntityTree, &entity);
+}
+
+void FruImpl::addEntityAssociations(
+    const std::vector<dbus::ObjectPath>& paths)
+{
+    for (const auto& path : paths)
+    {
+        auto node = objToEntityNode.at(path);
+        auto entity = pldm_entity_extract(node);
+        auto parent = pldm_entity_get_parent(node);
+        auto parentNode = pldm_entity_association_tree_find_with_locality(
+            entityTree, &parent, false);
+        if (!parentNode)
+        {
+            continue;
+        }
+
+        // A new association PDR of the container lists the added entity
+        std::vector<pldm_entity> entities{parent, entity};
+        auto entitiesPtr = entities.data();
+        int rc = pldm_entity_association_pdr_add_from_node(
+            parentNode, pdrRepo, &entitiesPtr, entities.size(), false,
+            TERMINUS_HANDLE);
+        if (rc)
+        {
+            error(
+                "Failed to add entity association PDR of {PATH}, response code '{RC}'",
+                "PATH", path, "RC", rc);
+        }
+
+        auto bmcParentNode = pldm_entity_association_tree_find_with_locality(
+            bmcEntityTree, &parent, false);
+        if (bmcParentNode)
+        {
+            pldm_entity_association_tree_add_entity(
+                bmcEntityTree, &entity, entity.entity_instance_num,
+                bmcParentNode, PLDM_ENTITY_ASSOCIAION_PHYSICAL, false, true,
+                entity.entity_container_id);
+        }
+    }
+}
+
+void FruImpl::reportPdrChanges()
+{
+    auto changes =
+        pdrChangeLog.update(pdrRepo, fruPdrTypes, pdr_utils::PdrOrigin::local);
+    if (!changes.empty() && pdrChangedHandler)
+    {
+        pdrChangedHandler(std::move(changes));
+    }
+}
+
+void FruImpl::refreshEntityNodes()
+{
+    // The host PDR handler restores the tree from the BMC tree when the
+    // host powers off, so the nodes are looked up again by entity
+    for (auto it = objToEntity.begin(); it != objToEntity.end();)
+    {
+        auto node = pldm_entity_association_tree_find_with_locality(
+            entityTree, &it->second, false);
+        if (node)
+        {
+            objToEntityNode[it->first] = node;
+            ++it;
+        }
+        else
+        {
+            objToEntityNode.erase(it->first);
+            it = objToEntity.erase(it);
+        }
+    }
+}
+
+void FruImpl::watchInventory()
+{
+    using namespace sdbusplus::bus::match::rules;
+
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    fruAddedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        bus, interfacesAdded(pldm::utils::inventoryPath),
+        std::bind_front(&FruImpl::onInterfacesAdded, this));
+    fruRemovedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        bus, interfacesRemoved(pldm::utils::inventoryPath),
+        std::bind_front(&FruImpl::onInterfacesRemoved, this));
+}
+
+void FruImpl::onInterfacesAdded(sdbusplus::message_t& msg)
+{
+    sdbusplus::message::object_path objPath;
+    dbus::InterfaceMap interfaces;
+    try
+    {
+        msg.read(objPath, interfaces);
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to read the added inventory interfaces, error - {ERROR}",
+              "ERROR", e);
+        return;
+    }
+
+    auto& objInterfaces = objects[objPath];
+    for (auto& [interface, properties] : interfaces)
+    {
+        objInterfaces[interface] = std::move(properties);
+    }
+
+    refreshEntityNodes();
+    const auto& path = objPath.str;
+    if (auto it = associatedEntityMap.find(path);
+        it != associatedEntityMap.end())
+    {
+        // Rebuild the records of a known FRU with the added properties
+        auto entity = it->second;
+        removeRecords(path);
+        addRecords(path, objInterfaces, entity);
+        reportPdrChanges();
+        return;
+    }
+
+    std::set<dbus::ObjectPath> knownPaths;
+    for (const auto& [knownPath, node] : objToEntityNode)
+    {
+        knownPaths.insert(knownPath);
+    }
+    addFru(path, objInterfaces);
+    if (!associatedEntityMap.contains(path))
+    {
+        return;
+    }
+
+    std::vector<dbus::ObjectPath> addedPaths;
+    for (const auto& [entityPath, node] : objToEntityNode)
+    {
+        if (!knownPaths.contains(entityPath))
+        {
+            addedPaths.push_back(entityPath);
+        }
+    }
+    addEntityAssociations(addedPaths);
+    reportPdrChanges();
+    info("Added FRU {PATH} to the FRU table", "PATH", path);
+}
+
+void FruImpl::onInterfacesRemoved(sdbusplus::message_t& msg)
+{
+    sdbusplus::message::object_path objPath;
+    std::vector<std::string> interfaces;
+    try
+    {
+        msg.read(objPath, interfaces);
+    }
+    catch (const std::exception& e)
+    {
+        error(
+            "Failed to read the removed inventory interfaces, error - {ERROR}",
+            "ERROR", e);
+        return;
+    }
+
+    auto it = objects.find(objPath);
+    if (it == objects.end())
+    {
+        return;
+    }
+    for (const auto& interface : interfaces)
+    {
+        it->second.erase(interface);
+    }
+
+    const auto& path = objPath.str;
+    if (associatedEntityMap.contains(path))
+    {
+        refreshEntityNodes();
+        if (findItemInterface(it->second))
+        {
+            // Rebuild the records of the FRU without the removed properties
+            auto entity = associatedEntityMap.at(path);
+            removeRecords(path);
+            addRecords(path, it->second, entity);
+        }
+        else
+        {
+            removeFru(path);
+            info("Removed FRU {PATH} from the FRU table", "PATH", path);
+        }
+        reportPdrChanges();
+    }
+
+    if (it->second.empty())
+    {
+        objects.erase(it);
+    }
 }
 std::string FruImpl::populatefwVersion()
 {
@@ -251,7 +544,7 @@ std::string FruImpl::populatefwVersion()
     }
     return currentBmcVersion;
 }
-void FruImpl::populateRecords(
+uint16_t FruImpl::populateRecords(
     const pldm::responder::dbus::InterfaceMap& interfaces,
     const fru_parser::FruRecordInfos& recordInfos, const pldm_entity& entity)
 {
@@ -269,21 +562,26 @@ void FruImpl::populateRecords(
         {
             try
             {
-                pldm::responder::dbus::Value propValue;
+                // The property is read in place, only the firmware version
+                // is fetched
+                pldm::responder::dbus::Value fwVersion;
+                const pldm::responder::dbus::Value* propValue = nullptr;
 
                 // Assuming that 0 container Id is assigned to the System (as
                 // that should be the top most container as per dbus hierarchy)
                 if (entity.entity_container_id == 0 && prop == "Version")
                 {
-                    propValue = populatefwVersion();
+                    fwVersion = populatefwVersion();
+                    propValue = &fwVersion;
                 }
                 else
                 {
-                    propValue = interfaces.at(intf).at(prop);
+                    propValue = &interfaces.at(intf).at(prop);
                 }
                 if (propType == "bytearray")
                 {
-                    auto byteArray = std::get<std::vector<uint8_t>>(propValue);
+                    const auto& byteArray =
+                        std::get<std::vector<uint8_t>>(*propValue);
                     if (!byteArray.size())
                     {
                         continue;
@@ -292,12 +590,11 @@ void FruImpl::populateRecords(
                     numFRUFields++;
                     tlvs.emplace_back(fieldTypeNum);
                     tlvs.emplace_back(byteArray.size());
-                    std::move(std::begin(byteArray), std::end(byteArray),
-                              std::back_inserter(tlvs));
+                    tlvs.insert(tlvs.end(), byteArray.begin(), byteArray.end());
                 }
                 else if (propType == "string")
                 {
-                    auto str = std::get<std::string>(propValue);
+                    const auto& str = std::get<std::string>(*propValue);
                     if (!str.size())
                     {
                         continue;
@@ -306,8 +603,7 @@ void FruImpl::populateRecords(
                     numFRUFields++;
                     tlvs.emplace_back(fieldTypeNum);
                     tlvs.emplace_back(str.size());
-                    std::move(std::begin(str), std::end(str),
-                              std::back_inserter(tlvs));
+                    tlvs.insert(tlvs.end(), str.begin(), str.end());
                 }
             }
             catch (const std::out_of_range&)
@@ -335,54 +631,87 @@ void FruImpl::populateRecords(
             }
             auto curSize = table.size();
             table.resize(curSize + recHeaderSize + tlvs.size());
+            tableChanged();
             encode_fru_record(table.data(), table.size(), &curSize,
                               recordSetIdentifier, recType, numFRUFields,
                               encType, tlvs.data(), tlvs.size());
             numRecs++;
         }
     }
+
+    return recordSetIdentifier;
 }
 
-std::vector<uint8_t> FruImpl::tableResize()
+void FruImpl::updateChecksum()
 {
-    std::vector<uint8_t> tempTable;
+    if (checksumValid)
+    {
+        return;
+    }
 
+    padBytes = 0;
+    checksum = 0;
     if (table.size())
     {
-        std::copy(table.begin(), table.end(), std::back_inserter(tempTable));
-        padBytes = pldm::utils::getNumPadBytes(table.size());
-        tempTable.resize(tempTable.size() + padBytes, 0);
+        // The checksum covers the pad bytes, append them for the computation
+        auto tableSize = table.size();
+        padBytes = pldm::utils::getNumPadBytes(tableSize);
+        table.resize(tableSize + padBytes, 0);
+        checksum = crc32(table.data(), table.size());
+        table.resize(tableSize);
     }
-    return tempTable;
+    checksumValid = true;
 }
 
 void FruImpl::getFRUTable(Response& response)
 {
-    auto hdrSize = response.size();
-    std::vector<uint8_t> tempTable;
+    updateChecksum();
 
-    if (table.size())
-    {
-        tempTable = tableResize();
-        checksum = crc32(tempTable.data(), tempTable.size());
-    }
-    response.resize(hdrSize + tempTable.size() + sizeof(checksum), 0);
-    std::copy(tempTable.begin(), tempTable.end(), response.begin() + hdrSize);
+    auto hdrSize = response.size();
+    response.resize(hdrSize + table.size() + padBytes + sizeof(checksum), 0);
+    std::copy(table.begin(), table.end(), response.begin() + hdrSize);
 
-    // Copy the checksum to response data
-    auto iter = response.begin() + hdrSize + tempTable.size();
+    // Copy the checksum to response data, after the zeroed pad bytes
+    auto iter = response.begin() + hdrSize + table.size() + padBytes;
     std::copy_n(reinterpret_cast<const uint8_t*>(&checksum), sizeof(checksum),
                 iter);
 }
 
+std::shared_ptr<const std::vector<uint8_t>> FruImpl::getFRUTableSnapshot()
+{
+    if (!tableSnapshot)
+    {
+        auto snapshot = std::make_shared<std::vector<uint8_t>>();
+        getFRUTable(*snapshot);
+        tableSnapshot = std::move(snapshot);
+    }
+    return tableSnapshot;
+}
+
 void FruImpl::getFRURecordTableMetadata()
 {
-    std::vector<uint8_t> tempTable;
-    if (table.size())
+    updateChecksum();
+}
+
+void FruImpl::buildRecordIndex()
+{
+    if (recordIndexValid)
     {
-        tempTable = tableResize();
-        checksum = crc32(tempTable.data(), tempTable.size());
+        return;
     }
+
+    recordIndex.clear();
+    size_t offset = 0;
+    while (offset + recHeaderSize <= table.size())
+    {
+        auto record = reinterpret_cast<const pldm_fru_record_data_format*>(
+            table.data() + offset);
+        auto size = fruRecordSize(table.data() + offset);
+        recordIndex[le16toh(record->record_set_id)].emplace_back(
+            offset, size, record->record_type);
+        offset += size;
+    }
+    recordIndexValid = true;
 }
 
 int FruImpl::getFRURecordByOption(
@@ -391,33 +720,93 @@ int FruImpl::getFRURecordByOption(
 {
     using sum = uint32_t;
 
+    /* Bound the responses kept, the requester picks the options */
+    constexpr size_t maxRecordsByOption = 256;
+
     // FRU table is built lazily, build if not done.
     buildFRUTable();
 
-    /* 7 is sizeof(checksum,4) + padBytesMax(3)
-     * We can not know size of the record table got by options in advance, but
-     * it must be less than the source table. So it's safe to use sizeof the
-     * source table + 7 as the buffer length
-     */
-    size_t recordTableSize = table.size() - padBytes + 7;
-    fruData.resize(recordTableSize, 0);
+    auto option = std::make_tuple(recordSetIdentifer, recordType, fieldType);
+    if (auto it = recordsByOption.find(option); it != recordsByOption.end())
+    {
+        fruData = it->second;
+        return PLDM_SUCCESS;
+    }
+
+    fruData.clear();
+    if (recordSetIdentifer)
+    {
+        // Only the records of the set are filtered, found from the index
+        buildRecordIndex();
+        auto it = recordIndex.find(recordSetIdentifer);
+        if (it == recordIndex.end())
+        {
+            return PLDM_FRU_DATA_STRUCTURE_TABLE_UNAVAILABLE;
+        }
+
+        for (const auto& [offset, size, type] : it->second)
+        {
+            if (recordType && type != recordType)
+            {
+                continue;
+            }
+
+            auto record = table.begin() + offset;
+            if (!fieldType)
+            {
+                fruData.insert(fruData.end(), record, record + size);
+                continue;
+            }
 
-    int rc = get_fru_record_by_option(
-        table.data(), table.size() - padBytes, fruData.data(), &recordTableSize,
-        recordSetIdentifer, recordType, fieldType);
+            auto curSize = fruData.size();
+            size_t recordSize = size;
+            fruData.resize(curSize + size);
+            int rc = get_fru_record_by_option(
+                table.data() + offset, size, fruData.data() + curSize,
+                &recordSize, recordSetIdentifer, recordType, fieldType);
+            if (rc != PLDM_SUCCESS)
+            {
+                return PLDM_FRU_DATA_STRUCTURE_TABLE_UNAVAILABLE;
+            }
+            fruData.resize(curSize + recordSize);
+        }
+    }
+    else
+    {
+        /* We can not know size of the record table got by options in
+         * advance, but it must be less than the source table.
+         */
+        size_t recordTableSize = table.size();
+        fruData.resize(recordTableSize, 0);
+
+        int rc = get_fru_record_by_option(
+            table.data(), table.size(), fruData.data(), &recordTableSize,
+            recordSetIdentifer, recordType, fieldType);
+        if (rc != PLDM_SUCCESS)
+        {
+            return PLDM_FRU_DATA_STRUCTURE_TABLE_UNAVAILABLE;
+        }
+        fruData.resize(recordTableSize);
+    }
 
-    if (rc != PLDM_SUCCESS || recordTableSize == 0)
+    if (fruData.empty())
     {
         return PLDM_FRU_DATA_STRUCTURE_TABLE_UNAVAILABLE;
     }
 
+    // The checksum covers the returned records and their pad bytes
+    auto recordTableSize = fruData.size();
     auto pads = pldm::utils::getNumPadBytes(recordTableSize);
-    crc32(fruData.data(), recordTableSize + pads);
+    fruData.resize(recordTableSize + pads, 0);
+    sum recordsChecksum = crc32(fruData.data(), fruData.size());
+    auto bytes = reinterpret_cast<const uint8_t*>(&recordsChecksum);
+    fruData.insert(fruData.end(), bytes, bytes + sizeof(sum));
 
-    auto iter = fruData.begin() + recordTableSize + pads;
-    std::copy_n(reinterpret_cast<const uint8_t*>(&checksum), sizeof(checksum),
-                iter);
-    fruData.resize(recordTableSize + pads + sizeof(sum));
+    if (recordsByOption.size() >= maxRecordsByOption)
+    {
+        recordsByOption.clear();
+    }
+    recordsByOption.emplace(option, fruData);
 
     return PLDM_SUCCESS;
 }
@@ -452,9 +841,7 @@ Response Handler::getFRURecordTableMetadata(const pldm_msg* request,
     constexpr uint8_t minor = 0x00;
     constexpr uint32_t maxSize = 0xFFFFFFFF;
 
-    Response response(sizeof(pldm_msg_hdr) +
-                          PLDM_GET_FRU_RECORD_TABLE_METADATA_RESP_BYTES,
-                      0);
+    auto response = makeResponse(PLDM_GET_FRU_RECORD_TABLE_METADATA_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     impl.getFRURecordTableMetadata();
@@ -471,7 +858,7 @@ Response Handler::getFRURecordTableMetadata(const pldm_msg* request,
     return response;
 }
 
-Response Handler::getFRURecordTable(const pldm_msg* request,
+Response Handler::getFRURecordTable(pldm_tid_t tid, const pldm_msg* request,
                                     size_t payloadLength)
 {
     // FRU table is built lazily, build if not done.
@@ -482,19 +869,88 @@ Response Handler::getFRURecordTable(const pldm_msg* request,
         return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
     }
 
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES, 0);
+    uint32_t transferHandle{};
+    uint8_t transferOpFlag{};
+    auto rc = decode_get_fru_record_table_req(request, payloadLength,
+                                              &transferHandle, &transferOpFlag);
+    if (rc != PLDM_SUCCESS)
+    {
+        return ccOnlyResponse(request, rc);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::erase_if(tableTransfers, [now](const auto& transfer) {
+        return transfer.second.expiry <= now;
+    });
+
+    // The transfer handle is the offset of the part in the table, the parts
+    // of a transfer come from the table of its first part
+    std::shared_ptr<const Table> table;
+    if (transferOpFlag == PLDM_GET_FIRSTPART)
+    {
+        table = impl.getFRUTableSnapshot();
+        transferHandle = 0;
+    }
+    else if (transferOpFlag == PLDM_GET_NEXTPART)
+    {
+        // Only the next part, or the last one sent again, may be asked for
+        auto it = tableTransfers.find(tid);
+        if (it == tableTransfers.end() ||
+            (transferHandle != it->second.nextOffset &&
+             transferHandle != it->second.offset))
+        {
+            return ccOnlyResponse(request,
+                                  PLDM_FRU_INVALID_DATA_TRANSFER_HANDLE);
+        }
+        table = it->second.table;
+    }
+    else
+    {
+        return ccOnlyResponse(request, PLDM_FRU_INVALID_TRANSFER_FLAG);
+    }
+
+    size_t length = table->size() - transferHandle;
+    if (tableTransferSize && length > tableTransferSize)
+    {
+        length = tableTransferSize;
+    }
+    uint32_t nextTransferHandle = transferHandle + length;
+    bool last = nextTransferHandle == table->size();
+    uint8_t transferFlag{};
+    if (!transferHandle)
+    {
+        transferFlag = last ? PLDM_START_AND_END : PLDM_START;
+    }
+    else
+    {
+        transferFlag = last ? PLDM_END : PLDM_MIDDLE;
+    }
+
+    if (last)
+    {
+        tableTransfers.erase(tid);
+    }
+    else
+    {
+        tableTransfers[tid] = {table, transferHandle, nextTransferHandle,
+                               now + tableTransferTimeout};
+    }
+
+    auto response =
+        makeResponse(PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES + length);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
-    auto rc =
-        encode_get_fru_record_table_resp(request->hdr.instance_id, PLDM_SUCCESS,
-                                         0, PLDM_START_AND_END, responsePtr);
+    rc = encode_get_fru_record_table_resp(
+        request->hdr.instance_id, PLDM_SUCCESS, last ? 0 : nextTransferHandle,
+        transferFlag, responsePtr);
     if (rc != PLDM_SUCCESS)
     {
         return ccOnlyResponse(request, rc);
     }
 
-    impl.getFRUTable(response);
+    std::copy_n(table->begin() + transferHandle, length,
+                response.begin() + sizeof(pldm_msg_hdr) +
+                    PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES);
 
     return response;
 }
@@ -535,7 +991,7 @@ Response Handler::getFRURecordByOption(const pldm_msg* request,
 
     auto respPayloadLength =
         PLDM_GET_FRU_RECORD_BY_OPTION_MIN_RESP_BYTES + fruData.size();
-    Response response(sizeof(pldm_msg_hdr) + respPayloadLength, 0);
+    auto response = makeResponse(respPayloadLength);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_get_fru_record_by_option_resp(
@@ -572,8 +1028,7 @@ Response Handler::setFRURecordTable(const pldm_msg* request,
         return ccOnlyResponse(request, rc);
     }
 
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_SET_FRU_RECORD_TABLE_RESP_BYTES);
+    auto response = makeResponse(PLDM_SET_FRU_RECORD_TABLE_RESP_BYTES);
     struct pldm_msg* responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_set_fru_record_table_resp(
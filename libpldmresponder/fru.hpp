@@ -8,13 +8,21 @@
 #include <libpldm/fru.h>
 #include <libpldm/pdr.h>
 
+#include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/message.hpp>
 
+#include <chrono>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
+#include <tuple>
 #include <variant>
 #include <vector>
 
+class TestFruHotplug;
+class TestFruHandler;
+
 namespace pldm
 {
 
@@ -42,6 +50,9 @@ using AssociatedEntityMap = std::map<ObjectPath, pldm_entity>;
 class FruImpl
 {
   public:
+    friend class ::TestFruHotplug;
+    friend class ::TestFruHandler;
+
     /* @brief Header size for FRU record, it includes the FRU record set
      *        identifier, FRU record type, Number of FRU fields, Encoding type
      *        of FRU fields
@@ -96,7 +107,7 @@ class FruImpl
      */
     uint16_t numRSI() const
     {
-        return rsi;
+        return numRecordSets;
     }
 
     /** @brief The number of FRU records in the table
@@ -114,6 +125,13 @@ class FruImpl
      */
     void getFRUTable(Response& response);
 
+    /** @brief Get the FRU table with its pad bytes and checksum, as a
+     *         snapshot which stays valid while the records change
+     *
+     *  @return the FRU table
+     */
+    std::shared_ptr<const std::vector<uint8_t>> getFRUTableSnapshot();
+
     /** @brief Get the Fru Table MetaData
      *
      */
@@ -133,10 +151,28 @@ class FruImpl
 
     /** @brief FRU table is built by processing the D-Bus inventory namespace
      *         based on the config files for FRU. The table is populated based
-     *         on the isBuilt flag.
+     *         on the isBuilt flag. Once built, the table and the entity
+     *         association PDRs follow the FRUs added to and removed from the
+     *         inventory.
      */
     void buildFRUTable();
 
+    /** @brief Provide the inventory objects fetched ahead, so building the
+     *         FRU table does not query them
+     *
+     *  @param[in] inventoryObjects - the objects managed by the inventory
+     *                                manager
+     */
+    void setInventoryObjects(dbus::ObjectValueTree inventoryObjects)
+    {
+        if (isBuilt)
+        {
+            return;
+        }
+        objects = std::move(inventoryObjects);
+        objectsFetched = true;
+    }
+
     /** @brief Get std::map associated with the entity
      *         key: object path
      *         value: pldm_entity
@@ -185,11 +221,10 @@ class FruImpl
      */
     std::string populatefwVersion();
 
-    /* @brief Method to resize the table
-     *
-     * @return resized table
+    /* @brief Compute the pad bytes and the checksum of the table, if the
+     *        records changed since they were last computed
      */
-    std::vector<uint8_t> tableResize();
+    void updateChecksum();
 
     /* @brief set FRU Record Table
      *
@@ -208,9 +243,25 @@ class FruImpl
         oemFruHandler = handler;
     }
 
+    /** @brief Handler of the changes made to the FRU PDRs by the inventory
+     *         hotplug
+     */
+    using PdrChangedHandler = std::function<void(pdr_utils::PdrChanges&&)>;
+
+    /* @brief Method to set the handler told about the FRU PDRs changed by
+     *        the inventory hotplug
+     *
+     * @param[in] handler - handler of the changes
+     */
+    void setPdrChangedHandler(PdrChangedHandler handler)
+    {
+        pdrChangedHandler = std::move(handler);
+    }
+
   private:
     uint16_t nextRSI()
     {
+        numRecordSets++;
         return ++rsi;
     }
 
@@ -221,12 +272,40 @@ class FruImpl
 
     uint32_t rh = 0;
     uint16_t rsi = 0;
+    uint16_t numRecordSets = 0;
     uint16_t numRecs = 0;
     uint8_t padBytes = 0;
     std::vector<uint8_t> table;
     uint32_t checksum = 0;
+
+    /** @brief padBytes and checksum are computed for the current table */
+    bool checksumValid = false;
     bool isBuilt = false;
 
+    /** @brief Location of a FRU record in the table */
+    struct RecordRange
+    {
+        size_t offset;
+        size_t size;
+        uint8_t recordType;
+    };
+
+    /** @brief Records of each record set identifier, in table order */
+    std::map<uint16_t, std::vector<RecordRange>> recordIndex;
+
+    /** @brief recordIndex is built for the current table */
+    bool recordIndexValid = false;
+
+    /** @brief GetFRURecordByOption response data, with the pad bytes and
+     *         the checksum, keyed by record set identifier, record type and
+     *         field type
+     */
+    std::map<std::tuple<uint16_t, uint8_t, uint8_t>, std::vector<uint8_t>>
+        recordsByOption;
+
+    /** @brief Snapshot of the table returned by getFRUTableSnapshot() */
+    std::shared_ptr<const std::vector<uint8_t>> tableSnapshot;
+
     fru_parser::FruParser parser;
     pldm_pdr* pdrRepo;
     pldm_entity_association_tree* entityTree;
@@ -234,8 +313,30 @@ class FruImpl
     pldm::responder::oem_fru::Handler* oemFruHandler = nullptr;
     dbus::ObjectValueTree objects;
 
+    /** @brief objects were provided by setInventoryObjects() */
+    bool objectsFetched = false;
+
     std::map<dbus::ObjectPath, pldm_entity_node*> objToEntityNode{};
 
+    /** @brief Entities of objToEntityNode, to find their nodes again after
+     *         the entity association tree was restored
+     */
+    std::map<dbus::ObjectPath, pldm_entity> objToEntity{};
+
+    /** @brief FRU record set identifier of the FRUs with records */
+    std::map<dbus::ObjectPath, uint16_t> objToRSI{};
+
+    /** @brief Item interfaces of the inventory objects which are FRUs */
+    fru_parser::Interfaces itemInterfaces;
+
+    std::unique_ptr<sdbusplus::bus::match_t> fruAddedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> fruRemovedMatch;
+
+    /** @brief The FRU PDRs as last reported to pdrChangedHandler */
+    pdr_utils::PdrChangeLog pdrChangeLog;
+
+    PdrChangedHandler pdrChangedHandler;
+
     /** @brief populateRecord builds the FRU records for an instance of FRU and
      *         updates the FRU table with the FRU records.
      *
@@ -243,10 +344,84 @@ class FruImpl
      *                          values for the FRU
      *  @param[in] recordInfos - FRU record info to build the FRU records
      *  @param[in/out] entity - PLDM entity corresponding to FRU instance
+     *
+     *  @return the FRU record set identifier, 0 if no record was built
+     */
+    uint16_t populateRecords(const dbus::InterfaceMap& interfaces,
+                             const fru_parser::FruRecordInfos& recordInfos,
+                             const pldm_entity& entity);
+
+    /** @brief Find the item interface of an inventory object which is a FRU
+     *
+     *  @param[in] interfaces - D-Bus interfaces of the object
+     *
+     *  @return the interface, std::nullopt if the object is not a FRU
      */
-    void populateRecords(const dbus::InterfaceMap& interfaces,
-                         const fru_parser::FruRecordInfos& recordInfos,
-                         const pldm_entity& entity);
+    std::optional<std::string> findItemInterface(
+        const dbus::InterfaceMap& interfaces) const;
+
+    /** @brief Add a present FRU to the entity association tree and its
+     *         records to the FRU table
+     *
+     *  @param[in] path - object path of the FRU
+     *  @param[in] interfaces - D-Bus interfaces of the FRU
+     */
+    void addFru(const dbus::ObjectPath& path,
+                const dbus::InterfaceMap& interfaces);
+
+    /** @brief Build the records of a FRU already in the entity association
+     *         tree
+     *
+     *  @param[in] path - object path of the FRU
+     *  @param[in] interfaces - D-Bus interfaces of the FRU
+     *  @param[in] entity - PLDM entity of the FRU
+     *
+     *  @return false if the FRU has no record configuration
+     */
+    bool addRecords(const dbus::ObjectPath& path,
+                    const dbus::InterfaceMap& interfaces,
+                    const pldm_entity& entity);
+
+    /** @brief Remove the records and the FRU record set PDR of a FRU */
+    void removeRecords(const dbus::ObjectPath& path);
+
+    /** @brief Remove a FRU and its records, with its entity when it contains
+     *         no other entity
+     */
+    void removeFru(const dbus::ObjectPath& path);
+
+    /** @brief Add the entity association PDRs of the entities added to the
+     *         tree after it was built, and mirror them into the BMC tree
+     *
+     *  @param[in] paths - object paths of the added entities, parents first
+     */
+    void addEntityAssociations(const std::vector<dbus::ObjectPath>& paths);
+
+    /** @brief Drop what is computed from the records, when they change */
+    void tableChanged()
+    {
+        checksumValid = false;
+        recordIndexValid = false;
+        recordsByOption.clear();
+        tableSnapshot.reset();
+    }
+
+    /** @brief Build recordIndex, if the records changed since it was built */
+    void buildRecordIndex();
+
+    /** @brief Report the FRU PDRs changed since the last report to
+     *         pdrChangedHandler
+     */
+    void reportPdrChanges();
+
+    /** @brief Point objToEntityNode to the nodes of the current tree */
+    void refreshEntityNodes();
+
+    /** @brief Follow the FRUs added to and removed from the inventory */
+    void watchInventory();
+
+    void onInterfacesAdded(sdbusplus::message_t& msg);
+    void onInterfacesRemoved(sdbusplus::message_t& msg);
 
     /** @brief Associate sensor/effecter to FRU entity
      */
@@ -272,8 +447,9 @@ class Handler : public CmdHandler
             });
         handlers.emplace(
             PLDM_GET_FRU_RECORD_TABLE,
-            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
-                return this->getFRURecordTable(request, payloadLength);
+            [this](pldm_tid_t tid, const pldm_msg* request,
+                   size_t payloadLength) {
+                return this->getFRURecordTable(tid, request, payloadLength);
             });
         handlers.emplace(
             PLDM_GET_FRU_RECORD_BY_OPTION,
@@ -299,12 +475,14 @@ class Handler : public CmdHandler
 
     /** @brief Handler for GetFRURecordTable
      *
+     *  @param[in] tid - TID of the requester
      *  @param[in] request - Request message payload
      *  @param[in] payloadLength - Request payload length
      *
      *  @return PLDM response message
      */
-    Response getFRURecordTable(const pldm_msg* request, size_t payloadLength);
+    Response getFRURecordTable(pldm_tid_t tid, const pldm_msg* request,
+                               size_t payloadLength);
 
     /** @brief Build FRU table is bnot already built
      *
@@ -314,6 +492,15 @@ class Handler : public CmdHandler
         impl.buildFRUTable();
     }
 
+    /** @brief Provide the inventory objects fetched ahead
+     *
+     *  @param[in] objects - the objects managed by the inventory manager
+     */
+    void setInventoryObjects(dbus::ObjectValueTree objects)
+    {
+        impl.setInventoryObjects(std::move(objects));
+    }
+
     /** @brief Get std::map associated with the entity
      *         key: object path
      *         value: pldm_entity
@@ -354,10 +541,47 @@ class Handler : public CmdHandler
         impl.setOemFruHandler(handler);
     }
 
+    /* @brief Method to set the handler told about the FRU PDRs changed by
+     *        the inventory hotplug
+     *
+     * @param[in] handler - handler of the changes
+     */
+    void setPdrChangedHandler(FruImpl::PdrChangedHandler handler)
+    {
+        impl.setPdrChangedHandler(std::move(handler));
+    }
+
     using Table = std::vector<uint8_t>;
 
   private:
+    friend class ::TestFruHandler;
+
+    /** @brief A multipart GetFRURecordTable transfer of a requester */
+    struct TableTransfer
+    {
+        /** @brief The table the parts are served from */
+        std::shared_ptr<const Table> table;
+
+        /** @brief Offset of the part last sent, asked again on a retry */
+        uint32_t offset;
+
+        /** @brief Offset of the next part */
+        uint32_t nextOffset;
+
+        /** @brief The transfer is dropped when not continued by then */
+        std::chrono::steady_clock::time_point expiry;
+    };
+
+    /** @brief Time a requester has to ask for the next part of the table */
+    static constexpr std::chrono::seconds tableTransferTimeout{30};
+
+    /** @brief Maximum size of a part of the table, 0 for no limit */
+    size_t tableTransferSize = FRU_TABLE_TRANSFER_SIZE;
+
     FruImpl impl;
+
+    /** @brief The multipart transfers in progress, by requester TID */
+    std::map<pldm_tid_t, TableTransfer> tableTransfers;
 };
 
 } // namespace fru
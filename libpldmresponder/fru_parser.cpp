@@ -1,11 +1,12 @@
 #include "fru_parser.hpp"
 
+#include "common/json_cache.hpp"
+
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/lg2.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 
 #include <filesystem>
-#include <fstream>
 
 PHOSPHOR_LOG2_USING;
 
@@ -44,8 +45,8 @@ void FruParser::setupDefaultDBusLookup(const fs::path& masterJsonPath)
 {
     constexpr auto service = "xyz.openbmc_project.Inventory.Manager";
     constexpr auto rootPath = "/xyz/openbmc_project/inventory";
-    std::ifstream jsonFile(masterJsonPath);
-    auto data = Json::parse(jsonFile, nullptr, false);
+    auto data = pldm::utils::JsonCache::getInstance().parse(masterJsonPath,
+                                                            false);
     if (data.is_discarded())
     {
         error("Failed to parse FRU Dbus Lookup Map config file '{PATH}'",
@@ -102,9 +103,12 @@ void FruParser::setupDefaultFruRecordMap()
              "string", 10},
         }};
 
-    for (auto [intf, entityType] : intfToEntityType)
+    auto generalRecordInfos =
+        std::make_shared<const FruRecordInfos>(FruRecordInfos{
+            generalRecordInfo});
+    for (const auto& [intf, entityType] : intfToEntityType)
     {
-        recordMap[intf] = {generalRecordInfo};
+        recordMap[intf] = generalRecordInfos;
     }
 }
 
@@ -113,8 +117,8 @@ void FruParser::setupFruRecordMap(const std::string& dirPath)
     for (auto& file : fs::directory_iterator(dirPath))
     {
         auto fileName = file.path().filename().string();
-        std::ifstream jsonFile(file.path());
-        auto data = Json::parse(jsonFile, nullptr, false);
+        auto data = pldm::utils::JsonCache::getInstance().parse(file.path(),
+                                                                false);
         if (data.is_discarded())
         {
             error("Failed to parse FRU config file at '{PATH}'", "PATH",
@@ -159,12 +163,17 @@ void FruParser::setupFruRecordMap(const std::string& dirPath)
             // to the same data.
             if (search != recordMap.end())
             {
-                search->second.emplace_back(std::move(fruInfo));
+                // The record infos may be shared, append to a copy
+                auto recordInfos =
+                    std::make_shared<FruRecordInfos>(*search->second);
+                recordInfos->emplace_back(std::move(fruInfo));
+                search->second = std::move(recordInfos);
             }
             else
             {
-                FruRecordInfos recordInfos{fruInfo};
-                recordMap.emplace(dbusIntfName, recordInfos);
+                recordMap.emplace(dbusIntfName,
+                                  std::make_shared<const FruRecordInfos>(
+                                      FruRecordInfos{std::move(fruInfo)}));
             }
         }
         catch (const std::exception&)
@@ -2,6 +2,7 @@
 
 #include <filesystem>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
@@ -57,7 +58,12 @@ using FruRecordInfo =
 using FruRecordInfos = std::vector<FruRecordInfo>;
 
 using ItemIntfName = std::string;
-using FruRecordMap = std::map<ItemIntfName, FruRecordInfos>;
+
+/** @brief Record infos of the item interfaces, the interfaces without a FRU
+ *         config JSON share the default record infos
+ */
+using FruRecordMap =
+    std::map<ItemIntfName, std::shared_ptr<const FruRecordInfos>>;
 
 /** @class FruParser
  *
@@ -99,7 +105,7 @@ class FruParser
     const FruRecordInfos& getRecordInfo(
         const pldm::responder::dbus::Interface& intf) const
     {
-        return recordMap.at(intf);
+        return *recordMap.at(intf);
     }
 
     pldm::responder::dbus::EntityType getEntityType(
@@ -108,6 +114,24 @@ class FruParser
         return intfToEntityType.at(intf);
     }
 
+    /** @brief Get the entity type of an item interface
+     *
+     *  @param[in] intf - name of the interface
+     *
+     *  @return the entity type, std::nullopt if the interface is not the item
+     *          interface of a FRU
+     */
+    std::optional<pldm::responder::dbus::EntityType> findEntityType(
+        const pldm::responder::dbus::Interface& intf) const
+    {
+        auto it = intfToEntityType.find(intf);
+        if (it == intfToEntityType.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
   private:
     /** @brief Parse the FRU Configuration JSON file in the directory path
      *         except the FRU_Master.json and build the FRU record information
@@ -36,16 +36,7 @@ void getRepoByType(const Repo& inRepo, Repo& outRepo, Type pdrType)
 const pldm_pdr_record* getRecordByHandle(
     const RepoInterface& pdrRepo, RecordHandle recordHandle, PdrEntry& pdrEntry)
 {
-    uint8_t* pdrData = nullptr;
-    auto record =
-        pldm_pdr_find_record(pdrRepo.getPdr(), recordHandle, &pdrData,
-                             &pdrEntry.size, &pdrEntry.handle.nextRecordHandle);
-    if (record)
-    {
-        pdrEntry.data = pdrData;
-    }
-
-    return record;
+    return pdrRepo.findRecord(recordHandle, pdrEntry);
 }
 
 } // namespace pdr
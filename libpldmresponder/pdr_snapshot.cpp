@@ -0,0 +1,422 @@
+#include "pdr_snapshot.hpp"
+
+#include "common/fnv_hash.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <variant>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+
+namespace
+{
+
+/** @brief Magic identifying a PDR snapshot file */
+constexpr std::array<char, 8> pdrSnapshotMagic = {'P', 'L', 'D', 'M',
+                                                  'B', 'P', 'D', 'R'};
+constexpr uint32_t pdrSnapshotVersion = 1;
+
+/** @brief Serialize the snapshot into a buffer */
+class Writer
+{
+  public:
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void write(const T& value)
+    {
+        auto bytes = reinterpret_cast<const uint8_t*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(value));
+    }
+
+    void write(const std::string& value)
+    {
+        write(static_cast<uint32_t>(value.size()));
+        data.insert(data.end(), value.begin(), value.end());
+    }
+
+    void write(const std::vector<uint8_t>& value)
+    {
+        write(static_cast<uint32_t>(value.size()));
+        data.insert(data.end(), value.begin(), value.end());
+    }
+
+    void write(const std::vector<std::string>& value)
+    {
+        write(static_cast<uint32_t>(value.size()));
+        for (const auto& item : value)
+        {
+            write(item);
+        }
+    }
+
+    void write(const pldm::utils::PropertyValue& value)
+    {
+        write(static_cast<uint8_t>(value.index()));
+        std::visit([this](const auto& v) { write(v); }, value);
+    }
+
+    void write(const PdrSnapshotObjMaps& maps)
+    {
+        write(static_cast<uint32_t>(maps.size()));
+        for (const auto& [id, objMaps] : maps)
+        {
+            const auto& [dbusMappings, dbusValMaps] = objMaps;
+            write(id);
+            write(static_cast<uint32_t>(dbusMappings.size()));
+            for (const auto& mapping : dbusMappings)
+            {
+                write(mapping.objectPath);
+                write(mapping.interface);
+                write(mapping.propertyName);
+                write(mapping.propertyType);
+            }
+            write(static_cast<uint32_t>(dbusValMaps.size()));
+            for (const auto& valMap : dbusValMaps)
+            {
+                write(static_cast<uint32_t>(valMap.size()));
+                for (const auto& [state, value] : valMap)
+                {
+                    write(state);
+                    write(value);
+                }
+            }
+        }
+    }
+
+    std::vector<uint8_t> data;
+};
+
+/** @brief Deserialize the snapshot from the mapped file, every read is
+ *         checked against the end of the file
+ */
+class Reader
+{
+  public:
+    explicit Reader(std::span<const uint8_t> data) : data(data) {}
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    bool read(T& value)
+    {
+        if (data.size() - offset < sizeof(value))
+        {
+            return false;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(value));
+        offset += sizeof(value);
+        return true;
+    }
+
+    bool read(std::string& value)
+    {
+        uint32_t size = 0;
+        if (!read(size) || data.size() - offset < size)
+        {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(data.data() + offset),
+                     size);
+        offset += size;
+        return true;
+    }
+
+    bool read(std::vector<uint8_t>& value)
+    {
+        uint32_t size = 0;
+        if (!read(size) || data.size() - offset < size)
+        {
+            return false;
+        }
+        value.assign(data.begin() + offset, data.begin() + offset + size);
+        offset += size;
+        return true;
+    }
+
+    bool read(std::vector<std::string>& value)
+    {
+        uint32_t size = 0;
+        if (!read(size) || data.size() - offset < size)
+        {
+            return false;
+        }
+        value.resize(size);
+        for (auto& item : value)
+        {
+            if (!read(item))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool read(pldm::utils::PropertyValue& value)
+    {
+        uint8_t index = 0;
+        if (!read(index))
+        {
+            return false;
+        }
+        return readAlternative(
+            index, value,
+            std::make_index_sequence<
+                std::variant_size_v<pldm::utils::PropertyValue>>{});
+    }
+
+    bool read(PdrSnapshotObjMaps& maps)
+    {
+        uint32_t count = 0;
+        if (!read(count))
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint16_t id = 0;
+            uint32_t mappingCount = 0;
+            if (!read(id) || !read(mappingCount) ||
+                data.size() - offset < mappingCount)
+            {
+                return false;
+            }
+            auto& [dbusMappings, dbusValMaps] = maps[id];
+            dbusMappings.resize(mappingCount);
+            for (auto& mapping : dbusMappings)
+            {
+                if (!read(mapping.objectPath) || !read(mapping.interface) ||
+                    !read(mapping.propertyName) || !read(mapping.propertyType))
+                {
+                    return false;
+                }
+            }
+
+            uint32_t valMapCount = 0;
+            if (!read(valMapCount) || data.size() - offset < valMapCount)
+            {
+                return false;
+            }
+            dbusValMaps.resize(valMapCount);
+            for (auto& valMap : dbusValMaps)
+            {
+                uint32_t stateCount = 0;
+                if (!read(stateCount))
+                {
+                    return false;
+                }
+                for (uint32_t j = 0; j < stateCount; j++)
+                {
+                    pdr_utils::State state = 0;
+                    pldm::utils::PropertyValue value;
+                    if (!read(state) || !read(value))
+                    {
+                        return false;
+                    }
+                    valMap.emplace(state, std::move(value));
+                }
+            }
+        }
+        return true;
+    }
+
+    bool atEnd() const
+    {
+        return offset == data.size();
+    }
+
+  private:
+    template <size_t... I>
+    bool readAlternative(uint8_t index, pldm::utils::PropertyValue& value,
+                         std::index_sequence<I...>)
+    {
+        bool ok = false;
+        static_cast<void>(
+            ((index == I && (ok = readAs<I>(value), true)) || ...));
+        return ok;
+    }
+
+    template <size_t I>
+    bool readAs(pldm::utils::PropertyValue& value)
+    {
+        std::variant_alternative_t<I, pldm::utils::PropertyValue> v{};
+        if (!read(v))
+        {
+            return false;
+        }
+        value = std::move(v);
+        return true;
+    }
+
+    std::span<const uint8_t> data;
+    size_t offset = 0;
+};
+
+} // namespace
+
+uint64_t PdrSnapshot::computeKey(
+    const std::vector<std::filesystem::path>& files, const std::string& salt)
+{
+    uint64_t hash = pldm::utils::fnvOffsetBasis;
+    std::array<char, 4096> buffer{};
+    for (const auto& file : files)
+    {
+        pldm::utils::fnvHash(hash, file.native());
+        std::ifstream stream(file, std::ios::binary);
+        while (stream.read(buffer.data(), buffer.size()) || stream.gcount())
+        {
+            pldm::utils::fnvHash(
+                hash, std::string_view(buffer.data(), stream.gcount()));
+        }
+        /* Separate the files, moving bytes between two of them must change
+         * the key */
+        pldm::utils::fnvHash(hash, 0xff);
+    }
+    pldm::utils::fnvHash(hash, salt);
+    return hash;
+}
+
+std::optional<PdrSnapshotData> PdrSnapshot::load(uint64_t key) const
+{
+    if (!enabled())
+    {
+        return std::nullopt;
+    }
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return std::nullopt;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) < 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return std::nullopt;
+    }
+
+    auto size = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        error("Failed to map PDR snapshot {PATH}, error {ERROR}", "PATH",
+              path.string(), "ERROR", errno);
+        return std::nullopt;
+    }
+
+    Reader reader(std::span(static_cast<const uint8_t*>(mapped), size));
+    std::array<char, 8> magic{};
+    uint32_t version = 0;
+    uint64_t snapshotKey = 0;
+    PdrSnapshotData data;
+    uint32_t pdrCount = 0;
+    bool valid = reader.read(magic) && reader.read(version) &&
+                 magic == pdrSnapshotMagic && version == pdrSnapshotVersion &&
+                 reader.read(snapshotKey) && snapshotKey == key &&
+                 reader.read(data.nextSensorId) &&
+                 reader.read(data.nextEffecterId) && reader.read(pdrCount);
+    if (valid)
+    {
+        data.pdrs.reserve(std::min<size_t>(pdrCount, size));
+        for (uint32_t i = 0; valid && i < pdrCount; i++)
+        {
+            valid = reader.read(data.pdrs.emplace_back()) &&
+                    data.pdrs.back().size() >= sizeof(pldm_pdr_hdr);
+        }
+    }
+    valid = valid && reader.read(data.sensorDbusObjMaps) &&
+            reader.read(data.effecterDbusObjMaps) && reader.atEnd();
+    munmap(mapped, size);
+
+    if (!valid)
+    {
+        info("PDR snapshot {PATH} is stale or corrupted", "PATH",
+             path.string());
+        return std::nullopt;
+    }
+
+    return data;
+}
+
+bool PdrSnapshot::store(uint64_t key, const PdrSnapshotData& data) const
+{
+    if (!enabled())
+    {
+        return false;
+    }
+
+    Writer writer;
+    writer.write(pdrSnapshotMagic);
+    writer.write(pdrSnapshotVersion);
+    writer.write(key);
+    writer.write(data.nextSensorId);
+    writer.write(data.nextEffecterId);
+    writer.write(static_cast<uint32_t>(data.pdrs.size()));
+    for (const auto& pdr : data.pdrs)
+    {
+        writer.write(pdr);
+    }
+    writer.write(data.sensorDbusObjMaps);
+    writer.write(data.effecterDbusObjMaps);
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    if (ec)
+    {
+        error(
+            "Failed to create PDR snapshot directory {DIR}, error {ERROR}",
+            "DIR", path.parent_path().string(), "ERROR", ec.message());
+        return false;
+    }
+
+    /* Write a temporary file and rename it, a crash must not leave a
+     * partially written snapshot behind */
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(writer.data.data()),
+                   writer.data.size());
+        file.close();
+        if (!file)
+        {
+            error("Failed to write PDR snapshot {PATH}", "PATH",
+                  tmpPath.string());
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec)
+    {
+        error("Failed to update PDR snapshot {PATH}, error {ERROR}", "PATH",
+              path.string(), "ERROR", ec.message());
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "pdr_utils.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace pldm
+{
+namespace responder
+{
+
+/** @brief D-Bus mappings of the sensors or effecters, keyed by their ID */
+using PdrSnapshotObjMaps =
+    std::map<uint16_t,
+             std::tuple<pdr_utils::DbusMappings, pdr_utils::DbusValMaps>>;
+
+/** @struct PdrSnapshotData
+ *
+ *  What generating the PDRs of the PDR JSON files produces: the PDRs, in
+ *  repository order and without record handle, and the D-Bus mappings of
+ *  their sensors and effecters.
+ */
+struct PdrSnapshotData
+{
+    std::vector<std::vector<uint8_t>> pdrs;
+    PdrSnapshotObjMaps sensorDbusObjMaps;
+    PdrSnapshotObjMaps effecterDbusObjMaps;
+    uint16_t nextSensorId = 0;
+    uint16_t nextEffecterId = 0;
+};
+
+/**
+ * @brief PdrSnapshot
+ *
+ * Keeps the PDRs generated from the PDR JSON files in a binary file, so the
+ * JSON files are not parsed again on the next start of pldmd. The snapshot
+ * is identified by a key computed from the content of the JSON files and
+ * the other inputs of the generation, a snapshot stored for another key is
+ * ignored.
+ */
+class PdrSnapshot
+{
+  public:
+    PdrSnapshot() = default;
+
+    /** @brief Constructor
+     *
+     *  @param[in] path - File holding the snapshot, empty to disable the
+     *                    snapshot
+     */
+    explicit PdrSnapshot(const std::filesystem::path& path) : path(path) {}
+
+    /** @brief Check if the snapshot is enabled */
+    bool enabled() const
+    {
+        return !path.empty();
+    }
+
+    /** @brief Compute the key of the PDRs generated from files
+     *
+     *  @param[in] files - the PDR JSON files
+     *  @param[in] salt - the other inputs of the generation, like the system
+     *                    type
+     *  @return the key
+     */
+    static uint64_t computeKey(const std::vector<std::filesystem::path>& files,
+                               const std::string& salt);
+
+    /** @brief Load the snapshot
+     *
+     *  @param[in] key - Key of the current inputs
+     *  @return the snapshot, std::nullopt if there is none, it is corrupted or
+     *          was stored for a different key
+     */
+    std::optional<PdrSnapshotData> load(uint64_t key) const;
+
+    /** @brief Store the snapshot, replacing the previous one
+     *
+     *  @param[in] key - Key of the inputs the data was generated from
+     *  @param[in] data - the generated PDRs and D-Bus mappings
+     *  @return true if the snapshot was written
+     */
+    bool store(uint64_t key, const PdrSnapshotData& data) const;
+
+  private:
+    /** @brief File holding the snapshot */
+    std::filesystem::path path;
+};
+
+} // namespace responder
+} // namespace pldm
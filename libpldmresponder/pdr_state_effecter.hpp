@@ -159,6 +159,7 @@ void generateStateEffecterPDR(const DBusInterface& dBusIntf, const Json& json,
                 error(
                     "Failed to create effecter PDR, D-Bus object '{PATH}' returned error - {ERROR}",
                     "PATH", objectPath, "ERROR", e);
+                handler.setPDRBuildPartial();
                 break;
             }
             dbusMappings.emplace_back(std::move(dbusMapping));
@@ -170,6 +171,10 @@ void generateStateEffecterPDR(const DBusInterface& dBusIntf, const Json& json,
             handler.addDbusObjMaps(pdr->effecter_id,
                                    std::make_tuple(std::move(dbusMappings),
                                                    std::move(dbusValMaps)));
+            if (e.value("fire_and_forget", false))
+            {
+                handler.addFireAndForgetEffecter(pdr->effecter_id);
+            }
             pldm::responder::pdr_utils::PdrEntry pdrEntry{};
             pdrEntry.data = entry.data();
             pdrEntry.size = pdrSize;
@@ -170,6 +170,7 @@ void generateStateSensorPDR(const DBusInterface& dBusIntf, const Json& json,
                 error(
                     "Failed to create sensor PDR, D-Bus object '{PATH}' returned error - {ERROR}",
                     "PATH", objectPath, "ERROR", e);
+                handler.setPDRBuildPartial();
                 break;
             }
             dbusMappings.emplace_back(std::move(dbusMapping));
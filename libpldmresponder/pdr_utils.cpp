@@ -1,11 +1,17 @@
 #include "pdr.hpp"
 
+#include "common/fnv_hash.hpp"
+
 #include <libpldm/fru.h>
 #include <libpldm/platform.h>
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <climits>
+#include <cstddef>
+#include <map>
+#include <optional>
 
 PHOSPHOR_LOG2_USING;
 
@@ -26,6 +32,57 @@ static constexpr uint8_t fruRecordDataFormatLength = 7;
 // // 2: 1byte FRU Field Type, 1byte FRU Field Length
 static constexpr uint8_t fruFieldTypeLength = 2;
 
+/** @brief The indexes of the PDR repositories, to invalidate them */
+static std::multimap<const pldm_pdr*, std::weak_ptr<RecordIndex>>&
+    recordIndexes()
+{
+    static std::multimap<const pldm_pdr*, std::weak_ptr<RecordIndex>> indexes;
+    return indexes;
+}
+
+/** @brief Get the sensor or effecter ID of a PDR
+ *
+ *  @return the ID, std::nullopt if the PDR is not a sensor or effecter PDR
+ */
+static std::optional<uint16_t> getSensorOrEffecterId(const uint8_t* data,
+                                                     uint32_t size)
+{
+    // The terminus handle and the sensor or effecter ID follow the header
+    // in the sensor and effecter PDRs
+    constexpr size_t idOffset = sizeof(pldm_pdr_hdr) + sizeof(uint16_t);
+    if (size < idOffset + sizeof(uint16_t))
+    {
+        return std::nullopt;
+    }
+
+    switch (reinterpret_cast<const pldm_pdr_hdr*>(data)->type)
+    {
+        case PLDM_STATE_SENSOR_PDR:
+        case PLDM_NUMERIC_SENSOR_PDR:
+        case PLDM_STATE_EFFECTER_PDR:
+        case PLDM_NUMERIC_EFFECTER_PDR:
+            return static_cast<uint16_t>(data[idOffset] |
+                                         (data[idOffset + 1] << 8));
+        default:
+            return std::nullopt;
+    }
+}
+
+const pldm_pdr_record* RepoInterface::findRecord(RecordHandle recordHandle,
+                                                 PdrEntry& pdrEntry) const
+{
+    uint8_t* pdrData = nullptr;
+    auto record =
+        pldm_pdr_find_record(getPdr(), recordHandle, &pdrData, &pdrEntry.size,
+                             &pdrEntry.handle.nextRecordHandle);
+    if (record)
+    {
+        pdrEntry.data = pdrData;
+    }
+
+    return record;
+}
+
 pldm_pdr* Repo::getPdr() const
 {
     return repo;
@@ -79,6 +136,231 @@ uint32_t Repo::getRecordHandle(const pldm_pdr_record* record) const
     return pldm_pdr_get_record_handle(getPdr(), record);
 }
 
+const RecordIndex& Repo::getIndex() const
+{
+    if (!index)
+    {
+        auto& indexes = recordIndexes();
+        std::erase_if(indexes,
+                      [](const auto& entry) { return entry.second.expired(); });
+        index = std::make_shared<RecordIndex>();
+        indexes.emplace(repo, index);
+    }
+
+    auto recordCount = pldm_pdr_get_record_count(repo);
+    if (index->valid && index->recordCount == recordCount)
+    {
+        return *index;
+    }
+
+    index->predecessors.clear();
+    index->ids.clear();
+    index->stateSets.clear();
+    index->predecessors.reserve(recordCount);
+
+    uint8_t* pdrData = nullptr;
+    uint32_t pdrSize = 0;
+    uint32_t nextRecordHandle = 0;
+    const pldm_pdr_record* previous = nullptr;
+    auto record = pldm_pdr_find_record(repo, 0, &pdrData, &pdrSize,
+                                       &nextRecordHandle);
+    while (record)
+    {
+        auto recordHandle = pldm_pdr_get_record_handle(repo, record);
+        index->predecessors.emplace(recordHandle, previous);
+        auto id = getSensorOrEffecterId(pdrData, pdrSize);
+        if (id)
+        {
+            auto type = reinterpret_cast<const pldm_pdr_hdr*>(pdrData)->type;
+            index->ids.emplace(static_cast<uint32_t>(type) << 16 | *id,
+                               recordHandle);
+        }
+
+        previous = record;
+        record = pldm_pdr_get_next_record(repo, record, &pdrData, &pdrSize,
+                                          &nextRecordHandle);
+    }
+
+    index->recordCount = recordCount;
+    index->valid = true;
+    return *index;
+}
+
+const pldm_pdr_record* Repo::findRecord(RecordHandle recordHandle,
+                                        PdrEntry& pdrEntry) const
+{
+    // Record handle 0 is the first record of the repository
+    if (!recordHandle)
+    {
+        return RepoInterface::findRecord(recordHandle, pdrEntry);
+    }
+
+    const auto& predecessors = getIndex().predecessors;
+    auto it = predecessors.find(recordHandle);
+    if (it == predecessors.end())
+    {
+        return nullptr;
+    }
+
+    uint8_t* pdrData = nullptr;
+    auto record =
+        it->second
+            ? pldm_pdr_get_next_record(repo, it->second, &pdrData,
+                                       &pdrEntry.size,
+                                       &pdrEntry.handle.nextRecordHandle)
+            : pldm_pdr_find_record(repo, 0, &pdrData, &pdrEntry.size,
+                                   &pdrEntry.handle.nextRecordHandle);
+    if (record)
+    {
+        pdrEntry.data = pdrData;
+    }
+
+    return record;
+}
+
+const pldm_pdr_record* Repo::findSensorOrEffecter(Type pdrType, uint16_t id,
+                                                  PdrEntry& pdrEntry) const
+{
+    const auto& ids = getIndex().ids;
+    auto it = ids.find(static_cast<uint32_t>(pdrType) << 16 | id);
+    if (it == ids.end())
+    {
+        return nullptr;
+    }
+    return findRecord(it->second, pdrEntry);
+}
+
+/** @brief Find a state set in a state sensor or effecter PDR
+ *
+ *  @return the sensor or effecter ID and the index of the state set,
+ *          std::nullopt if the PDR is not of the entity type or has no
+ *          composite sensor or effecter with the state set
+ */
+static std::optional<StateSetMatch> findStateSetInPdr(
+    Type pdrType, const uint8_t* data, uint32_t size, uint16_t entityType,
+    uint16_t stateSetId)
+{
+    uint16_t id = 0;
+    uint16_t pdrEntityType = 0;
+    uint8_t compositeCount = 0;
+    size_t pos = 0;
+    if (pdrType == PLDM_STATE_SENSOR_PDR)
+    {
+        pos = offsetof(pldm_state_sensor_pdr, possible_states);
+        if (size < pos)
+        {
+            return std::nullopt;
+        }
+        auto pdr = reinterpret_cast<const pldm_state_sensor_pdr*>(data);
+        id = pdr->sensor_id;
+        pdrEntityType = pdr->entity_type;
+        compositeCount = pdr->composite_sensor_count;
+    }
+    else
+    {
+        pos = offsetof(pldm_state_effecter_pdr, possible_states);
+        if (size < pos)
+        {
+            return std::nullopt;
+        }
+        auto pdr = reinterpret_cast<const pldm_state_effecter_pdr*>(data);
+        id = pdr->effecter_id;
+        pdrEntityType = pdr->entity_type;
+        compositeCount = pdr->composite_effecter_count;
+    }
+    if (pdrEntityType != entityType)
+    {
+        return std::nullopt;
+    }
+
+    // The sensor and effecter possible states have the same layout
+    constexpr size_t possibleStatesHdrSize =
+        offsetof(state_sensor_possible_states, states);
+    for (uint8_t compositeIndex = 0; compositeIndex < compositeCount;
+         compositeIndex++)
+    {
+        if (size - pos < possibleStatesHdrSize)
+        {
+            return std::nullopt;
+        }
+        auto possibleStates =
+            reinterpret_cast<const state_sensor_possible_states*>(data + pos);
+        if (possibleStates->state_set_id == stateSetId)
+        {
+            return StateSetMatch{id, compositeIndex};
+        }
+        pos += possibleStatesHdrSize + possibleStates->possible_states_size;
+        if (pos > size)
+        {
+            return std::nullopt;
+        }
+    }
+    return std::nullopt;
+}
+
+const StateSetRecords& Repo::getStateSetRecords(
+    Type pdrType, uint16_t entityType, uint16_t stateSetId) const
+{
+    // Drops the results of the lookups if the repository changed
+    getIndex();
+
+    std::tuple<Type, uint16_t, uint16_t> key{pdrType, entityType, stateSetId};
+    auto it = index->stateSets.find(key);
+    if (it != index->stateSets.end())
+    {
+        return it->second;
+    }
+
+    StateSetRecords records;
+    uint8_t* pdrData = nullptr;
+    uint32_t pdrSize = 0;
+    const pldm_pdr_record* record = nullptr;
+    while ((record = pldm_pdr_find_record_by_type(repo, pdrType, record,
+                                                  &pdrData, &pdrSize)))
+    {
+        auto match = findStateSetInPdr(pdrType, pdrData, pdrSize, entityType,
+                                       stateSetId);
+        if (match)
+        {
+            records.pdrs.emplace_back(pdrData, pdrData + pdrSize);
+            records.last = match;
+        }
+    }
+
+    // Only the matches are kept, the callers can't grow the cache past the
+    // state sets of the repository with lookups of arbitrary keys
+    static const StateSetRecords none{};
+    if (records.pdrs.empty())
+    {
+        return none;
+    }
+    return index->stateSets.emplace(key, std::move(records)).first->second;
+}
+
+std::optional<StateSetMatch> Repo::findStateSet(
+    Type pdrType, uint16_t entityType, uint16_t stateSetId) const
+{
+    return getStateSetRecords(pdrType, entityType, stateSetId).last;
+}
+
+const std::vector<std::vector<uint8_t>>& Repo::findStateSetPdrs(
+    Type pdrType, uint16_t entityType, uint16_t stateSetId) const
+{
+    return getStateSetRecords(pdrType, entityType, stateSetId).pdrs;
+}
+
+void Repo::invalidateIndex(const pldm_pdr* repo)
+{
+    auto [begin, end] = recordIndexes().equal_range(repo);
+    for (auto it = begin; it != end; ++it)
+    {
+        if (auto index = it->second.lock())
+        {
+            index->valid = false;
+        }
+    }
+}
+
 uint32_t Repo::getRecordCount()
 {
     return pldm_pdr_get_record_count(getPdr());
@@ -89,6 +371,101 @@ bool Repo::empty()
     return !getRecordCount();
 }
 
+PdrChanges PdrChangeLog::diff(const pldm_pdr* repo,
+                              const std::vector<uint8_t>& pdrTypes,
+                              PdrOrigin origin) const
+{
+    std::unordered_map<RecordHandle, uint64_t> current;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t nextRecordHandle = 0;
+    for (auto record =
+             pldm_pdr_find_record(repo, 0, &data, &size, &nextRecordHandle);
+         record; record = pldm_pdr_get_next_record(repo, record, &data, &size,
+                                                   &nextRecordHandle))
+    {
+        if (size < sizeof(pldm_pdr_hdr) ||
+            (origin != PdrOrigin::any && pldm_pdr_record_is_remote(record) !=
+                                             (origin == PdrOrigin::remote)))
+        {
+            continue;
+        }
+        auto hdr = reinterpret_cast<const pldm_pdr_hdr*>(data);
+        if (!pdrTypes.empty() &&
+            std::find(pdrTypes.begin(), pdrTypes.end(), hdr->type) ==
+                pdrTypes.end())
+        {
+            continue;
+        }
+
+        /* The record change number is left out, it changes with the
+         * repository and not with the record */
+        uint64_t hash = pldm::utils::fnvOffsetBasis;
+        for (uint32_t i = 0; i < size; i++)
+        {
+            if (i == offsetof(pldm_pdr_hdr, record_change_num) ||
+                i == offsetof(pldm_pdr_hdr, record_change_num) + 1)
+            {
+                continue;
+            }
+            pldm::utils::fnvHash(hash, data[i]);
+        }
+        current.emplace(pldm_pdr_get_record_handle(repo, record), hash);
+    }
+
+    PdrChanges changes;
+    for (const auto& [handle, hash] : current)
+    {
+        auto it = records.find(handle);
+        if (it == records.end())
+        {
+            changes.added.push_back(handle);
+        }
+        else if (it->second != hash)
+        {
+            changes.modified.push_back(handle);
+        }
+    }
+    for (const auto& [handle, hash] : records)
+    {
+        if (!current.contains(handle))
+        {
+            changes.deleted.push_back(handle);
+        }
+    }
+    std::ranges::sort(changes.added);
+    std::ranges::sort(changes.deleted);
+    std::ranges::sort(changes.modified);
+
+    changes.records = std::move(current);
+    changes.generation = generation;
+    return changes;
+}
+
+bool PdrChangeLog::commit(const PdrChanges& changes)
+{
+    if (changes.generation != generation)
+    {
+        return false;
+    }
+    records = changes.records;
+    generation++;
+    if (!changes.empty())
+    {
+        logVersion++;
+    }
+    return true;
+}
+
+PdrChanges PdrChangeLog::update(const pldm_pdr* repo,
+                                const std::vector<uint8_t>& pdrTypes,
+                                PdrOrigin origin)
+{
+    auto changes = diff(repo, pdrTypes, origin);
+    commit(changes);
+    return changes;
+}
+
 StatestoDbusVal populateMapping(const std::string& type, const Json& dBusValues,
                                 const PossibleValues& pv)
 {
@@ -159,7 +536,7 @@ StatestoDbusVal populateMapping(const std::string& type, const Json& dBusValues,
 }
 
 std::tuple<TerminusHandle, SensorID, SensorInfo> parseStateSensorPDR(
-    const std::vector<uint8_t>& stateSensorPdr)
+    std::span<const uint8_t> stateSensorPdr)
 {
     auto pdr =
         reinterpret_cast<const pldm_state_sensor_pdr*>(stateSensorPdr.data());
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/json_cache.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
 
@@ -14,7 +15,14 @@
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 PHOSPHOR_LOG2_USING;
 
@@ -95,6 +103,11 @@ inline Json readJson(const std::string& path)
         throw InternalFailure();
     }
 
+    if (auto json = pldm::utils::JsonCache::getInstance().take(path))
+    {
+        return std::move(*json);
+    }
+
     std::ifstream jsonFile(path);
     if (!jsonFile.is_open())
     {
@@ -173,6 +186,17 @@ class RepoInterface
      */
     virtual uint32_t getRecordHandle(const pldm_pdr_record* record) const = 0;
 
+    /** @brief Find a PDR record by its record handle
+     *
+     *  @param[in] recordHandle - record handle of the PDR
+     *  @param[out] pdrEntry - PDR records entry(data, size, nextRecordHandle)
+     *
+     *  @return opaque pointer acting as PDR record handle, will be NULL if
+     *          record was not found
+     */
+    virtual const pldm_pdr_record* findRecord(RecordHandle recordHandle,
+                                              PdrEntry& pdrEntry) const;
+
     /** @brief Get number of records in a PDR repository
      *
      *  @return uint32_t - number of records
@@ -189,12 +213,70 @@ class RepoInterface
     pldm_pdr* repo;
 };
 
+/** @struct StateSetMatch
+ *
+ *  State sensor or effecter found by entity type and state set
+ */
+struct StateSetMatch
+{
+    uint16_t id;            //!< sensor or effecter ID
+    uint8_t compositeIndex; //!< index of the state set in the composite
+                            //!< sensor or effecter
+};
+
+/** @struct StateSetRecords
+ *
+ *  State sensor or effecter PDRs of an entity type with a state set
+ */
+struct StateSetRecords
+{
+    /** @brief Copies of the matching PDRs, in repository order */
+    std::vector<std::vector<uint8_t>> pdrs;
+
+    /** @brief The last match */
+    std::optional<StateSetMatch> last;
+};
+
+/** @struct RecordIndex
+ *
+ *  Lookup tables of the records of a PDR repository. The records are opaque
+ *  and only reachable from the record before them, so a record is indexed by
+ *  the record preceding it in the repository.
+ */
+struct RecordIndex
+{
+    /** @brief Cleared when records are removed from the repository */
+    bool valid = false;
+
+    /** @brief Number of records when the index was built */
+    uint32_t recordCount = 0;
+
+    /** @brief Record preceding each record handle, nullptr for the first
+     *         record
+     */
+    std::unordered_map<RecordHandle, const pldm_pdr_record*> predecessors;
+
+    /** @brief Record handle of the first sensor or effecter PDR of each PDR
+     *         type and sensor or effecter ID, keyed by type << 16 | ID
+     */
+    std::unordered_map<uint32_t, RecordHandle> ids;
+
+    /** @brief Results of the state set lookups which matched, by PDR type,
+     *         entity type and state set ID, filled by the lookups
+     */
+    std::map<std::tuple<Type, uint16_t, uint16_t>, StateSetRecords> stateSets;
+};
+
 /**
  *  @class Repo
  *
  *  Wrapper class to handle the PDR APIs
  *
- *  This class wraps operations used to handle PDR APIs.
+ *  This class wraps operations used to handle PDR APIs. Lookups by record
+ *  handle and by sensor or effecter ID use an index of the repository, built
+ *  on the first lookup and again after records are added. Code removing
+ *  records from the repository outside of this class must call
+ *  invalidateIndex().
  */
 class Repo : public RepoInterface
 {
@@ -212,9 +294,180 @@ class Repo : public RepoInterface
 
     uint32_t getRecordHandle(const pldm_pdr_record* record) const override;
 
+    const pldm_pdr_record* findRecord(RecordHandle recordHandle,
+                                      PdrEntry& pdrEntry) const override;
+
+    /** @brief Find the first sensor or effecter PDR of a type with an ID
+     *
+     *  @param[in] pdrType - PLDM_STATE_SENSOR_PDR, PLDM_NUMERIC_SENSOR_PDR,
+     *                       PLDM_STATE_EFFECTER_PDR or
+     *                       PLDM_NUMERIC_EFFECTER_PDR
+     *  @param[in] id - sensor or effecter ID
+     *  @param[out] pdrEntry - PDR records entry(data, size, nextRecordHandle)
+     *
+     *  @return opaque pointer acting as PDR record handle, will be NULL if
+     *          record was not found
+     */
+    const pldm_pdr_record* findSensorOrEffecter(Type pdrType, uint16_t id,
+                                                PdrEntry& pdrEntry) const;
+
+    /** @brief Find the state sensor or effecter of an entity type with a
+     *         state set, the last one of the repository if several match
+     *
+     *  The result is kept until the repository changes.
+     *
+     *  @param[in] pdrType - PLDM_STATE_SENSOR_PDR or PLDM_STATE_EFFECTER_PDR
+     *  @param[in] entityType - entity type of the sensor or effecter
+     *  @param[in] stateSetId - state set ID of one of its composite sensors
+     *                          or effecters
+     *
+     *  @return the sensor or effecter ID and the index of the state set,
+     *          std::nullopt if not found
+     */
+    std::optional<StateSetMatch> findStateSet(Type pdrType,
+                                              uint16_t entityType,
+                                              uint16_t stateSetId) const;
+
+    /** @brief Find the state sensor or effecter PDRs of an entity type with
+     *         a state set
+     *
+     *  The PDRs are copied once and kept until the repository changes.
+     *
+     *  @param[in] pdrType - PLDM_STATE_SENSOR_PDR or PLDM_STATE_EFFECTER_PDR
+     *  @param[in] entityType - entity type of the sensors or effecters
+     *  @param[in] stateSetId - state set ID of one of their composite
+     *                          sensors or effecters
+     *
+     *  @return the matching PDRs, valid until the repository changes
+     */
+    const std::vector<std::vector<uint8_t>>& findStateSetPdrs(
+        Type pdrType, uint16_t entityType, uint16_t stateSetId) const;
+
     uint32_t getRecordCount() override;
 
     bool empty() override;
+
+    /** @brief Invalidate the indexes of a PDR repository after removing
+     *         records from it
+     *
+     *  @param[in] repo - the PDR repository
+     */
+    static void invalidateIndex(const pldm_pdr* repo);
+
+  private:
+    /** @brief Get the index of the repository, rebuilt if outdated */
+    const RecordIndex& getIndex() const;
+
+    /** @brief Get the state sensor or effecter PDRs of an entity type with a
+     *         state set, looked up in the repository on first use
+     */
+    const StateSetRecords& getStateSetRecords(Type pdrType, uint16_t entityType,
+                                              uint16_t stateSetId) const;
+
+    /** @brief Index shared by the copies of this Repo */
+    mutable std::shared_ptr<RecordIndex> index;
+};
+
+/** @struct PdrChanges
+ *
+ *  Record handles of the records added, deleted and modified in a PDR
+ *  repository between two versions of a PdrChangeLog
+ */
+struct PdrChanges
+{
+    std::vector<RecordHandle> added;
+    std::vector<RecordHandle> deleted;
+    std::vector<RecordHandle> modified;
+
+    /** @brief Content hash of the records of the version the changes lead
+     *         to, and the generation of the log they were computed against
+     */
+    std::unordered_map<RecordHandle, uint64_t> records;
+    uint64_t generation = 0;
+
+    bool empty() const
+    {
+        return added.empty() && deleted.empty() && modified.empty();
+    }
+};
+
+/** @brief Records of a PDR repository tracked by a PdrChangeLog */
+enum class PdrOrigin
+{
+    any,    //!< all the records
+    local,  //!< the records of this terminus
+    remote, //!< the records fetched from other termini
+};
+
+/**
+ *  @class PdrChangeLog
+ *
+ *  Versioned log of the records of a PDR repository a remote terminus was
+ *  told about. Each update compares the repository with the records of the
+ *  last version, by record handle and content, so the change event sent to
+ *  the terminus lists the touched records only. The changes are committed
+ *  once the terminus acknowledged them, so a lost event is reported again.
+ */
+class PdrChangeLog
+{
+  public:
+    /** @brief Compare the current records of a repository with the last
+     *         version, without recording them
+     *
+     *  @param[in] repo - the PDR repository
+     *  @param[in] pdrTypes - PDR types to track, all the types if empty
+     *  @param[in] origin - records to track
+     *
+     *  @return the records changed since the last version
+     */
+    PdrChanges diff(const pldm_pdr* repo, const std::vector<uint8_t>& pdrTypes,
+                    PdrOrigin origin) const;
+
+    /** @brief Record the records of the changes as a new version
+     *
+     *  @param[in] changes - the changes returned by diff
+     *
+     *  @return false if the log changed since the changes were computed, the
+     *          changes are dropped then
+     */
+    bool commit(const PdrChanges& changes);
+
+    /** @brief Record the current records of a repository as a new version
+     *
+     *  @param[in] repo - the PDR repository
+     *  @param[in] pdrTypes - PDR types to track, all the types if empty
+     *  @param[in] origin - records to track
+     *
+     *  @return the records changed since the previous version
+     */
+    PdrChanges update(const pldm_pdr* repo,
+                      const std::vector<uint8_t>& pdrTypes, PdrOrigin origin);
+
+    /** @brief Forget the recorded records, the next update reports all the
+     *         tracked records as added
+     */
+    void reset()
+    {
+        records.clear();
+        generation++;
+    }
+
+    /** @brief Version of the log, incremented by each update with changes */
+    uint32_t version() const
+    {
+        return logVersion;
+    }
+
+  private:
+    /** @brief Content hash of the records of the last version */
+    std::unordered_map<RecordHandle, uint64_t> records;
+
+    uint32_t logVersion = 0;
+
+    /** @brief Incremented by each commit and reset, the changes computed
+     *         against an older generation are stale
+     */
+    uint64_t generation = 0;
 };
 
 /** @brief Parse the State Sensor PDR and return the parsed sensor info which
@@ -227,7 +480,7 @@ class Repo : public RepoInterface
  */
 std::tuple<pldm::pdr::TerminusHandle, pldm::pdr::SensorID,
            pldm::pdr::SensorInfo>
-    parseStateSensorPDR(const std::vector<uint8_t>& stateSensorPdr);
+    parseStateSensorPDR(std::span<const uint8_t> stateSensorPdr);
 
 /** @brief Parse FRU record table and return the vector of the FRU record data
  *         format structure
@@ -1,5 +1,6 @@
 #include "platform.hpp"
 
+#include "common/startup_profiler.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
 #include "event_parser.hpp"
@@ -20,6 +21,8 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <format>
+
 PHOSPHOR_LOG2_USING;
 
 using namespace pldm::utils;
@@ -37,6 +40,20 @@ using InternalFailure =
 
 static const Json empty{};
 
+/** @brief Collects the D-Bus writes of an effecter handler, so they are made
+ *         without blocking once the handler validated the request
+ */
+struct DBusWriteRecorder
+{
+    void setDbusProperty(const DBusMapping& dBusMap,
+                         const PropertyValue& value) const
+    {
+        writes.emplace_back(dBusMap, value);
+    }
+
+    mutable AsyncDBusHandler::PropertyWrites writes;
+};
+
 void Handler::addDbusObjMaps(
     uint16_t id,
     std::tuple<pdr_utils::DbusMappings, pdr_utils::DbusValMaps> dbusObj,
@@ -68,16 +85,41 @@ const std::tuple<pdr_utils::DbusMappings, pdr_utils::DbusValMaps>&
 void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
                        const std::vector<fs::path>& dir, Repo& repo)
 {
+    for (const auto& path : getPDRJsonFiles(dir))
+    {
+        generatePDRs(dBusIntf, path, repo);
+    }
+}
+
+std::vector<fs::path> Handler::getPDRJsonFiles(const std::vector<fs::path>& dir)
+{
+    std::vector<fs::path> files;
     for (const auto& directory : dir)
     {
         info("Checking if directory '{DIRECTORY}' exists", "DIRECTORY",
              directory);
         if (!fs::exists(directory))
         {
-            return;
+            return {};
         }
     }
 
+    for (const auto& directory : dir)
+    {
+        for (const auto& dirEntry : fs::directory_iterator(directory))
+        {
+            if (fs::is_regular_file(dirEntry.path().string()))
+            {
+                files.emplace_back(dirEntry.path());
+            }
+        }
+    }
+    return files;
+}
+
+void Handler::generatePDRs(const pldm::utils::DBusHandler& dBusIntf,
+                           const fs::path& path, Repo& repo)
+{
     // A map of PDR type to a lambda that handles creation of that PDR type.
     // The lambda essentially would parse the platform specific PDR JSONs to
     // generate the PDR structures. This function iterates through the map to
@@ -106,115 +148,315 @@ void Handler::generate(const pldm::utils::DBusHandler& dBusIntf,
          }}};
 
     Type pdrType{};
-    for (const auto& directory : dir)
+    try
     {
-        for (const auto& dirEntry : fs::directory_iterator(directory))
+        auto json = readJson(path.string());
+        if (!json.empty())
         {
-            try
+            auto effecterPDRs = json.value("effecterPDRs", empty);
+            for (const auto& effecter : effecterPDRs)
+            {
+                pdrType = effecter.value("pdrType", 0);
+                generateHandlers.at(pdrType)(dBusIntf, effecter, repo);
+            }
+
+            auto sensorPDRs = json.value("sensorPDRs", empty);
+            for (const auto& sensor : sensorPDRs)
+            {
+                pdrType = sensor.value("pdrType", 0);
+                generateHandlers.at(pdrType)(dBusIntf, sensor, repo);
+            }
+        }
+    }
+    catch (const InternalFailure& e)
+    {
+        error(
+            "PDR config directory '{PATH}' does not exist or empty for '{TYPE}' pdr, error - {ERROR}",
+            "PATH", path, "TYPE", pdrType, "ERROR", e);
+    }
+    catch (const Json::exception& e)
+    {
+        error("Failed to parse PDR JSON file for '{TYPE}' pdr, error - {ERROR}",
+              "TYPE", pdrType, "ERROR", e);
+        pldm::utils::reportError(
+            "xyz.openbmc_project.PLDM.Error.Generate.PDRJsonFileParseFail");
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to parse PDR JSON file for '{TYPE}' pdr, error - {ERROR}",
+              "TYPE", pdrType, "ERROR", e);
+        pldm::utils::reportError(
+            "xyz.openbmc_project.PLDM.Error.Generate.PDRJsonFileParseFail");
+    }
+}
+
+void Handler::startPDRBuild()
+{
+    if (pdrCreated || pdrBuildStage != PDRBuildStage::NotStarted)
+    {
+        return;
+    }
+
+    info("Start building the PDR repository");
+    pdrBuildStage = PDRBuildStage::DBusSnapshot;
+    pdrBuildBegin = std::chrono::steady_clock::now();
+    pdrBuildTimer = std::make_unique<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
+        event, [this](auto&) { buildPDRStep(); });
+    pdrBuildTimer->restartOnce(std::chrono::microseconds(0));
+}
+
+void Handler::buildPDRStep()
+{
+    switch (pdrBuildStage)
+    {
+        case PDRBuildStage::DBusSnapshot:
+            if (oemPlatformHandler &&
+                oemPlatformHandler->checkBMCState() != PLDM_SUCCESS)
+            {
+                pdrBuildTimer->restartOnce(pdrBuildRetryInterval);
+                return;
+            }
+            fetchDBusSnapshot();
+            return;
+
+        case PDRBuildStage::FRUTable:
+            // Build FRU table first, since entity association PDR's are
+            // built when the FRU table is constructed.
+            if (fruHandler)
             {
-                if (fs::is_regular_file(dirEntry.path().string()))
+                fruHandler->buildFRUTable();
+            }
+            pdrBuildStage = PDRBuildStage::BMCPDRs;
+            break;
+
+        case PDRBuildStage::BMCPDRs:
+            generateTerminusLocatorPDR(pdrRepo);
+            if (platformConfigHandler)
+            {
+                auto systemType = platformConfigHandler->getPlatformName();
+                if (systemType.has_value())
                 {
-                    auto json = readJson(dirEntry.path().string());
-                    if (!json.empty())
-                    {
-                        auto effecterPDRs = json.value("effecterPDRs", empty);
-                        for (const auto& effecter : effecterPDRs)
-                        {
-                            pdrType = effecter.value("pdrType", 0);
-                            generateHandlers.at(
-                                pdrType)(dBusIntf, effecter, repo);
-                        }
-
-                        auto sensorPDRs = json.value("sensorPDRs", empty);
-                        for (const auto& sensor : sensorPDRs)
-                        {
-                            pdrType = sensor.value("pdrType", 0);
-                            generateHandlers.at(
-                                pdrType)(dBusIntf, sensor, repo);
-                        }
-                    }
+                    // In case of normal poweron , the system type would have
+                    // been already filled by entity manager when ever BMC
+                    // reaches Ready state. If this is not filled by the time
+                    // the BMC is ready we can assume that the entity manager
+                    // service is not present on this system & continue to
+                    // build the common PDR's.
+                    pdrJsonsDir.push_back(pdrJsonDir / systemType.value());
                 }
             }
-            catch (const InternalFailure& e)
+
+            if (oemPlatformHandler != nullptr)
             {
-                error(
-                    "PDR config directory '{PATH}' does not exist or empty for '{TYPE}' pdr, error - {ERROR}",
-                    "PATH", dirEntry.path(), "TYPE", pdrType, "ERROR", e);
+                oemPlatformHandler->buildOEMPDR(pdrRepo);
             }
-            catch (const Json::exception& e)
+            pdrBuildFiles = getPDRJsonFiles(pdrJsonsDir);
+            pdrBuildNext = 0;
+            pdrBuildPartial = false;
+            if (pdrSnapshot.enabled())
             {
-                error(
-                    "Failed to parse PDR JSON file for '{TYPE}' pdr, error - {ERROR}",
-                    "TYPE", pdrType, "ERROR", e);
-                pldm::utils::reportError(
-                    "xyz.openbmc_project.PLDM.Error.Generate.PDRJsonFileParseFail");
+                pdrSnapshotFirstRecord = pdrRepo.getRecordCount();
+                pdrSnapshotKey = PdrSnapshot::computeKey(pdrBuildFiles,
+                                                         getPDRSnapshotSalt());
+                if (loadPDRSnapshot())
+                {
+                    pdrBuildFiles.clear();
+                    finishPDRBuild();
+                    return;
+                }
             }
-            catch (const std::exception& e)
+            pdrBuildStage = PDRBuildStage::PDRJsons;
+            break;
+
+        case PDRBuildStage::PDRJsons:
+        {
+            auto start = std::chrono::steady_clock::now();
+            while (pdrBuildNext < pdrBuildFiles.size() &&
+                   std::chrono::steady_clock::now() - start < pdrBuildSlice)
             {
-                error(
-                    "Failed to parse PDR JSON file for '{TYPE}' pdr, error - {ERROR}",
-                    "TYPE", pdrType, "ERROR", e);
-                pldm::utils::reportError(
-                    "xyz.openbmc_project.PLDM.Error.Generate.PDRJsonFileParseFail");
+                generatePDRs(*dBusIntf, pdrBuildFiles[pdrBuildNext++],
+                             pdrRepo);
+            }
+            if (pdrBuildNext < pdrBuildFiles.size())
+            {
+                break;
             }
+
+            pdrBuildFiles.clear();
+            // A D-Bus object which is not up yet would be missing from the
+            // PDRs of every later start
+            if (pdrSnapshot.enabled() && pdrBuildPartial)
+            {
+                info(
+                    "Not storing the PDR snapshot, PDRs of missing D-Bus objects were skipped");
+            }
+            else if (pdrSnapshot.enabled())
+            {
+                storePDRSnapshot();
+            }
+            finishPDRBuild();
+            return;
         }
+
+        case PDRBuildStage::NotStarted:
+        case PDRBuildStage::Done:
+            return;
     }
+
+    // Yield to the event loop before the next slice
+    pdrBuildTimer->restartOnce(std::chrono::microseconds(0));
 }
 
-Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
+void Handler::fetchDBusSnapshot()
 {
-    if (oemPlatformHandler)
+    // Go on with the build from the event loop
+    auto fetched = [this]() {
+        pdrBuildStage = PDRBuildStage::FRUTable;
+        pdrBuildTimer->restartOnce(std::chrono::microseconds(0));
+    };
+    if (!fruHandler)
     {
-        auto rc = oemPlatformHandler->checkBMCState();
-        if (rc != PLDM_SUCCESS)
-        {
-            return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
-        }
+        fetched();
+        return;
     }
 
-    // Build FRU table if not built, since entity association PDR's
-    // are built when the FRU table is constructed.
-    if (fruHandler)
+    // A failed call only means the FRU table queries the objects one by one
+    AsyncDBusHandler().getManagedObj(
+        inventoryManager::interface, inventoryPath,
+        [this, fetched](int rc, ObjectValueTree&& objects) {
+            if (rc)
+            {
+                error(
+                    "Failed to get the inventory objects for the FRU table, error - {ERROR}",
+                    "ERROR", -rc);
+            }
+            else
+            {
+                fruHandler->setInventoryObjects(std::move(objects));
+            }
+            fetched();
+        });
+}
+
+void Handler::finishPDRBuild()
+{
+    pdrBuildStage = PDRBuildStage::Done;
+    pdrCreated = true;
+    info("Built the PDR repository, {COUNT} records", "COUNT",
+         pdrRepo.getRecordCount());
+    stats::StartupProfiler::getInstance().phase("PdrRepository", pdrBuildBegin);
+
+    if (dbusToPLDMEventHandler)
     {
-        fruHandler->buildFRUTable();
+        deferredGetPDREvent = std::make_unique<sdeventplus::source::Defer>(
+            event, [this](sdeventplus::source::EventBase& source) {
+                _processPostGetPDRActions(source);
+            });
     }
+}
 
-    if (!pdrCreated)
+std::string Handler::getPDRSnapshotSalt()
+{
+    // The PDRs depend on the system type selecting the JSON directories, on
+    // the PDRs and IDs allocated before them and on the entities of the FRU
+    // table they are associated with
+    std::string salt;
+    for (const auto& directory : pdrJsonsDir)
     {
-        generateTerminusLocatorPDR(pdrRepo);
-        if (platformConfigHandler)
+        salt += directory.string() + '\n';
+    }
+    salt += std::format("{} {} {}\n", pdrRepo.getRecordCount(), nextSensorId,
+                        nextEffecterId);
+    if (fruHandler)
+    {
+        for (const auto& [path, entity] : fruHandler->getAssociateEntityMap())
         {
-            auto systemType = platformConfigHandler->getPlatformName();
-            if (systemType.has_value())
-            {
-                // In case of normal poweron , the system type would have been
-                // already filled by entity manager when ever BMC reaches Ready
-                // state. If this is not filled by time we get a getpdr request
-                // we can assume that the entity manager service is not present
-                // on this system & continue to build the common PDR's.
-                pdrJsonsDir.push_back(pdrJsonDir / systemType.value());
-            }
+            salt += std::format("{} {} {} {}\n", path, entity.entity_type,
+                                entity.entity_instance_num,
+                                entity.entity_container_id);
         }
+    }
+    return salt;
+}
 
-        if (oemPlatformHandler != nullptr)
+bool Handler::loadPDRSnapshot()
+{
+    auto snapshot = pdrSnapshot.load(pdrSnapshotKey);
+    if (!snapshot)
+    {
+        return false;
+    }
+
+    for (auto& pdr : snapshot->pdrs)
+    {
+        pdr_utils::PdrEntry pdrEntry{};
+        pdrEntry.data = pdr.data();
+        pdrEntry.size = pdr.size();
+        pdrRepo.addRecord(pdrEntry);
+    }
+
+    sensorDbusObjMaps.merge(snapshot->sensorDbusObjMaps);
+    effecterDbusObjMaps.merge(snapshot->effecterDbusObjMaps);
+    nextSensorId = snapshot->nextSensorId;
+    nextEffecterId = snapshot->nextEffecterId;
+    info("Loaded {COUNT} PDRs from the PDR snapshot", "COUNT",
+         snapshot->pdrs.size());
+    return true;
+}
+
+void Handler::storePDRSnapshot()
+{
+    PdrSnapshotData snapshot;
+    snapshot.sensorDbusObjMaps = sensorDbusObjMaps;
+    snapshot.effecterDbusObjMaps = effecterDbusObjMaps;
+    snapshot.nextSensorId = nextSensorId;
+    snapshot.nextEffecterId = nextEffecterId;
+
+    uint32_t index = 0;
+    pdr_utils::PdrEntry pdrEntry{};
+    for (auto record = pdrRepo.getFirstRecord(pdrEntry); record;
+         record = pdrRepo.getNextRecord(record, pdrEntry), index++)
+    {
+        if (index < pdrSnapshotFirstRecord)
         {
-            oemPlatformHandler->buildOEMPDR(pdrRepo);
+            continue;
         }
-        generate(*dBusIntf, pdrJsonsDir, pdrRepo);
 
-        pdrCreated = true;
+        // The repository assigns the record handle when the PDR is added
+        auto& pdr = snapshot.pdrs.emplace_back(pdrEntry.data,
+                                               pdrEntry.data + pdrEntry.size);
+        reinterpret_cast<pldm_pdr_hdr*>(pdr.data())->record_handle = 0;
+    }
 
-        if (dbusToPLDMEventHandler)
+    pdrSnapshot.store(pdrSnapshotKey, snapshot);
+}
+
+Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
+{
+    if (oemPlatformHandler)
+    {
+        auto rc = oemPlatformHandler->checkBMCState();
+        if (rc != PLDM_SUCCESS)
         {
-            deferredGetPDREvent = std::make_unique<sdeventplus::source::Defer>(
-                event,
-                std::bind(std::mem_fn(&pldm::responder::platform::Handler::
-                                          _processPostGetPDRActions),
-                          this, std::placeholders::_1));
+            return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
         }
     }
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_MIN_RESP_BYTES, 0);
+    // The repository is built in the background, the requester retries
+    if (!pdrCreated)
+    {
+        startPDRBuild();
+        return ccOnlyResponse(request, PLDM_ERROR_NOT_READY);
+    }
+    stats::StartupProfiler::getInstance().milestone("FirstGetPdr");
+
+    // Build FRU table if not built, since entity association PDR's
+    // are built when the FRU table is constructed.
+    if (fruHandler)
+    {
+        fruHandler->buildFRUTable();
+    }
 
     if (payloadLength != PLDM_GET_PDR_REQ_BYTES)
     {
@@ -256,9 +498,8 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
             }
             recordData = e.data;
         }
-        response.resize(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_MIN_RESP_BYTES +
-                            respSizeBytes,
-                        0);
+        auto response = makeResponse(PLDM_GET_PDR_MIN_RESP_BYTES +
+                                     respSizeBytes);
         auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
         rc = encode_get_pdr_resp(
             request->hdr.instance_id, PLDM_SUCCESS, e.handle.nextRecordHandle,
@@ -267,6 +508,7 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
         {
             return ccOnlyResponse(request, rc);
         }
+        return response;
     }
     catch (const std::exception& e)
     {
@@ -275,15 +517,12 @@ Response Handler::getPDR(const pldm_msg* request, size_t payloadLength)
             "RECORD_HANDLE", recordHandle, "ERROR", e);
         return CmdHandler::ccOnlyResponse(request, PLDM_ERROR);
     }
-    return response;
 }
 
-Response Handler::setStateEffecterStates(const pldm_msg* request,
-                                         size_t payloadLength)
+void Handler::setStateEffecterStates(const pldm_msg* request,
+                                     size_t payloadLength,
+                                     ResponseCompletion complete)
 {
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_SET_STATE_EFFECTER_STATES_RESP_BYTES, 0);
-    auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     uint16_t effecterId;
     uint8_t compEffecterCnt;
     constexpr auto maxCompositeEffecterCnt = 8;
@@ -294,7 +533,9 @@ Response Handler::setStateEffecterStates(const pldm_msg* request,
         (payloadLength < sizeof(effecterId) + sizeof(compEffecterCnt) +
                              sizeof(set_effecter_state_field)))
     {
-        return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+        complete(
+            CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH));
+        return;
     }
 
     int rc = decode_set_state_effecter_states_req(
@@ -303,11 +544,11 @@ Response Handler::setStateEffecterStates(const pldm_msg* request,
 
     if (rc != PLDM_SUCCESS)
     {
-        return CmdHandler::ccOnlyResponse(request, rc);
+        complete(CmdHandler::ccOnlyResponse(request, rc));
+        return;
     }
 
     stateField.resize(compEffecterCnt);
-    const pldm::utils::DBusHandler dBusIntf;
     uint16_t entityType{};
     uint16_t entityInstance{};
     uint16_t stateSetId{};
@@ -320,26 +561,21 @@ Response Handler::setStateEffecterStates(const pldm_msg* request,
         rc = oemPlatformHandler->oemSetStateEffecterStatesHandler(
             entityType, entityInstance, stateSetId, compEffecterCnt, stateField,
             effecterId);
-    }
-    else
-    {
-        rc = platform_state_effecter::setStateEffecterStatesHandler<
-            pldm::utils::DBusHandler, Handler>(dBusIntf, *this, effecterId,
-                                               stateField);
-    }
-    if (rc != PLDM_SUCCESS)
-    {
-        return CmdHandler::ccOnlyResponse(request, rc);
-    }
-
-    rc = encode_set_state_effecter_states_resp(request->hdr.instance_id, rc,
-                                               responsePtr);
-    if (rc != PLDM_SUCCESS)
-    {
-        return ccOnlyResponse(request, rc);
+        complete(CmdHandler::ccOnlyResponse(request, rc));
+        return;
     }
 
-    return response;
+    // The states are checked and mapped to D-Bus values first, the writes
+    // recorded along the way are then made without blocking, the services
+    // of the composite effecter in parallel. The states mapped before an
+    // unsupported one are still set, as they were when the writes were made
+    // in place.
+    const DBusWriteRecorder dBusIntf;
+    rc = platform_state_effecter::setStateEffecterStatesHandler<
+        DBusWriteRecorder, Handler>(dBusIntf, *this, effecterId, stateField);
+    setEffecterProperties(std::move(dBusIntf.writes), request->hdr, rc,
+                          std::move(complete),
+                          !fireAndForgetEffecters.contains(effecterId));
 }
 
 Response Handler::platformEventMessage(const pldm_msg* request,
@@ -399,8 +635,7 @@ Response Handler::platformEventMessage(const pldm_msg* request,
             return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_DATA);
         }
     }
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_PLATFORM_EVENT_MESSAGE_RESP_BYTES, 0);
+    auto response = makeResponse(PLDM_PLATFORM_EVENT_MESSAGE_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = encode_platform_event_message_resp(request->hdr.instance_id, rc,
@@ -455,7 +690,8 @@ int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
                                    previousEventState);
 
         // If there are no HOST PDR's, there is no further action
-        if (hostPDRHandler == nullptr)
+        auto hostHandler = getHostPDRHandler(tid);
+        if (hostHandler == nullptr)
         {
             return PLDM_SUCCESS;
         }
@@ -470,7 +706,7 @@ int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
         try
         {
             std::tie(entityInfo, compositeSensorStates, stateSetIds) =
-                hostPDRHandler->lookupSensorInfo(sensorEntry);
+                hostHandler->lookupSensorInfo(sensorEntry);
         }
         catch (const std::out_of_range&)
         {
@@ -481,7 +717,7 @@ int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
             {
                 sensorEntry.terminusID = PLDM_TID_RESERVED;
                 std::tie(entityInfo, compositeSensorStates, stateSetIds) =
-                    hostPDRHandler->lookupSensorInfo(sensorEntry);
+                    hostHandler->lookupSensorInfo(sensorEntry);
             }
             // If there is no mapping for events return PLDM_SUCCESS
             catch (const std::out_of_range&)
@@ -509,8 +745,8 @@ int Handler::sensorEvent(const pldm_msg* request, size_t payloadLength,
             sensorOffset,
             stateSetIds[sensorOffset],
             false};
-        return hostPDRHandler->handleStateSensorEvent(stateSensorEntry,
-                                                      eventState);
+        return hostHandler->handleStateSensorEvent(stateSensorEntry,
+                                                   eventState);
     }
     else
     {
@@ -541,6 +777,7 @@ int Handler::pldmPDRRepositoryChgEvent(
     }
 
     PDRRecordHandles pdrRecordHandles;
+    auto hostHandler = getHostPDRHandler(tid);
 
     if (eventDataFormat == FORMAT_IS_PDR_TYPES)
     {
@@ -569,9 +806,10 @@ int Handler::pldmPDRRepositoryChgEvent(
             if (eventDataOperation == PLDM_RECORDS_ADDED ||
                 eventDataOperation == PLDM_RECORDS_MODIFIED)
             {
-                if (eventDataOperation == PLDM_RECORDS_MODIFIED)
+                if (eventDataOperation == PLDM_RECORDS_MODIFIED &&
+                    hostHandler)
                 {
-                    hostPDRHandler->isHostPdrModified = true;
+                    hostHandler->isHostPdrModified = true;
                 }
 
                 rc = getPDRRecordHandles(
@@ -593,7 +831,7 @@ int Handler::pldmPDRRepositoryChgEvent(
                 dataOffset + (numberOfChangeEntries * sizeof(ChangeEntry));
         }
     }
-    if (hostPDRHandler)
+    if (hostHandler)
     {
         // if we get a Repository change event with the eventDataFormat
         // as REFRESH_ENTIRE_REPOSITORY, then delete all the PDR's that
@@ -602,23 +840,9 @@ int Handler::pldmPDRRepositoryChgEvent(
         {
             // We cannot get the Repo change event from the Terminus
             // that is not already added to the BMC repository
-
-            for (auto it = hostPDRHandler->tlPDRInfo.cbegin();
-                 it != hostPDRHandler->tlPDRInfo.cend();)
-            {
-                if (std::get<0>(it->second) == tid)
-                {
-                    pldm_pdr_remove_pdrs_by_terminus_handle(pdrRepo.getPdr(),
-                                                            it->first);
-                    hostPDRHandler->tlPDRInfo.erase(it++);
-                }
-                else
-                {
-                    ++it;
-                }
-            }
+            hostHandler->removeTerminusPDRs(tid);
         }
-        hostPDRHandler->fetchPDR(std::move(pdrRecordHandles));
+        hostHandler->fetchPDR(std::move(pdrRecordHandles));
     }
 
     return PLDM_SUCCESS;
@@ -655,7 +879,7 @@ Response Handler::getNumericEffecterValue(const pldm_msg* request,
         return ccOnlyResponse(request, rc);
     }
 
-    const pldm::utils::DBusHandler dBusIntf;
+    const auto dBusIntf = getCachedDBusHandler();
     uint8_t effecterDataSize{};
     pldm::utils::PropertyValue dbusValue;
     std::string propertyType;
@@ -663,7 +887,7 @@ Response Handler::getNumericEffecterValue(const pldm_msg* request,
     using completionCode = uint8_t;
 
     rc = platform_numeric_effecter::getNumericEffecterData<
-        pldm::utils::DBusHandler, Handler>(
+        pldm::state_sensor::CachedDBusHandler, Handler>(
         dBusIntf, *this, effecterId, effecterDataSize, propertyType, dbusValue);
 
     if (rc != PLDM_SUCCESS)
@@ -683,7 +907,7 @@ Response Handler::getNumericEffecterValue(const pldm_msg* request,
         getEffecterDataSize(effecterDataSize) +
         getEffecterDataSize(effecterDataSize);
 
-    Response response(responsePayloadLength + sizeof(pldm_msg_hdr));
+    auto response = makeResponse(responsePayloadLength);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     rc = platform_numeric_effecter::getNumericEffecterValueHandler(
@@ -700,11 +924,10 @@ Response Handler::getNumericEffecterValue(const pldm_msg* request,
     return response;
 }
 
-Response Handler::setNumericEffecterValue(const pldm_msg* request,
-                                          size_t payloadLength)
+void Handler::setNumericEffecterValue(const pldm_msg* request,
+                                      size_t payloadLength,
+                                      ResponseCompletion complete)
 {
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_SET_NUMERIC_EFFECTER_VALUE_RESP_BYTES);
     uint16_t effecterId{};
     uint8_t effecterDataSize{};
     uint8_t effecterValue[4] = {};
@@ -713,22 +936,56 @@ Response Handler::setNumericEffecterValue(const pldm_msg* request,
                              sizeof(union_effecter_data_size)) ||
         (payloadLength < sizeof(effecterId) + sizeof(effecterDataSize) + 1))
     {
-        return ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
+        complete(ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH));
+        return;
     }
 
     int rc = decode_set_numeric_effecter_value_req(
         request, payloadLength, &effecterId, &effecterDataSize, effecterValue);
 
+    const DBusWriteRecorder dBusIntf;
     if (rc == PLDM_SUCCESS)
     {
-        const pldm::utils::DBusHandler dBusIntf;
         rc = platform_numeric_effecter::setNumericEffecterValueHandler<
-            pldm::utils::DBusHandler, Handler>(
-            dBusIntf, *this, effecterId, effecterDataSize, effecterValue,
-            sizeof(effecterValue));
+            DBusWriteRecorder, Handler>(dBusIntf, *this, effecterId,
+                                        effecterDataSize, effecterValue,
+                                        sizeof(effecterValue));
     }
 
-    return ccOnlyResponse(request, rc);
+    setEffecterProperties(std::move(dBusIntf.writes), request->hdr, rc,
+                          std::move(complete));
+}
+
+void Handler::setEffecterProperties(AsyncDBusHandler::PropertyWrites writes,
+                                    const pldm_msg_hdr& hdr, int rc,
+                                    ResponseCompletion complete, bool wait)
+{
+    if (dbusToPLDMEventHandler)
+    {
+        // Read the values back from D-Bus rather than caching the values
+        // before their conversion to the D-Bus types
+        auto& cache = dbusToPLDMEventHandler->getPropertyCache();
+        for (const auto& [dBusMap, value] : writes)
+        {
+            cache.erase(dBusMap.objectPath, dBusMap.interface,
+                        dBusMap.propertyName);
+        }
+    }
+
+    if (!wait)
+    {
+        // The failures of the writes are only logged
+        complete(ccOnlyResponse(hdr, rc));
+        AsyncDBusHandler().setDbusPropertiesPerService(std::move(writes),
+                                                       [](int) {});
+        return;
+    }
+
+    AsyncDBusHandler().setDbusPropertiesPerService(
+        std::move(writes),
+        [hdr, rc, complete = std::move(complete)](int writeRc) {
+            complete(ccOnlyResponse(hdr, writeRc ? PLDM_ERROR : rc));
+        });
 }
 
 void Handler::generateTerminusLocatorPDR(Repo& repo)
@@ -789,7 +1046,7 @@ Response Handler::getStateSensorReadings(const pldm_msg* request,
     uint8_t sensorRearmCount = std::popcount(sensorRearm.byte);
     std::vector<get_sensor_state_field> stateField(sensorRearmCount);
     uint8_t comSensorCnt{};
-    const pldm::utils::DBusHandler dBusIntf;
+    const auto dBusIntf = getCachedDBusHandler();
 
     uint16_t entityType{};
     uint16_t entityInstance{};
@@ -806,10 +1063,13 @@ Response Handler::getStateSensorReadings(const pldm_msg* request,
     }
     else
     {
+        static const stateSensorCacheMaps noSensorCache{};
         rc = platform_state_sensor::getStateSensorReadingsHandler<
-            pldm::utils::DBusHandler, Handler>(
+            pldm::state_sensor::CachedDBusHandler, Handler>(
             dBusIntf, *this, sensorId, sensorRearmCount, comSensorCnt,
-            stateField, dbusToPLDMEventHandler->getSensorCache());
+            stateField,
+            dbusToPLDMEventHandler ? dbusToPLDMEventHandler->getSensorCache()
+                                   : noSensorCache);
     }
 
     if (rc != PLDM_SUCCESS)
@@ -817,8 +1077,8 @@ Response Handler::getStateSensorReadings(const pldm_msg* request,
         return ccOnlyResponse(request, rc);
     }
 
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES +
+    auto response = makeResponse(
+        PLDM_GET_STATE_SENSOR_READINGS_MIN_RESP_BYTES +
         sizeof(get_sensor_state_field) * comSensorCnt);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     rc = encode_get_state_sensor_readings_resp(
@@ -844,69 +1104,44 @@ bool isOemStateSensor(Handler& handler, uint16_t sensorId,
                       uint16_t& entityType, uint16_t& entityInstance,
                       uint16_t& stateSetId, uint16_t& containerId)
 {
-    pldm_state_sensor_pdr* pdr = nullptr;
-
-    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> stateSensorPdrRepo(
-        pldm_pdr_init(), pldm_pdr_destroy);
-    if (!stateSensorPdrRepo)
+    PdrEntry pdrEntry{};
+    auto pdrRecord = handler.getRepo().findSensorOrEffecter(
+        PLDM_STATE_SENSOR_PDR, sensorId, pdrEntry);
+    if (!pdrRecord)
     {
-        error("Failed to instantiate state sensor PDR repository");
         return false;
     }
-    Repo stateSensorPDRs(stateSensorPdrRepo.get());
-    getRepoByType(handler.getRepo(), stateSensorPDRs, PLDM_STATE_SENSOR_PDR);
-    if (stateSensorPDRs.empty())
+
+    auto pdr = reinterpret_cast<pldm_state_sensor_pdr*>(pdrEntry.data);
+    assert(pdr != nullptr);
+    auto tmpEntityType = pdr->entity_type;
+    auto tmpEntityInstance = pdr->entity_instance;
+    auto tmpEntityContainerId = pdr->container_id;
+    auto tmpCompSensorCnt = pdr->composite_sensor_count;
+    auto tmpPossibleStates =
+        reinterpret_cast<state_sensor_possible_states*>(pdr->possible_states);
+    auto tmpStateSetId = tmpPossibleStates->state_set_id;
+
+    if (sensorRearmCount > tmpCompSensorCnt)
     {
-        error("Failed to get record by PDR type");
+        error(
+            "The requester sent wrong sensor rearm count '{SENSOR_REARM_COUNT}' for the sensor ID '{SENSORID}'.",
+            "SENSOR_REARM_COUNT", (uint16_t)sensorRearmCount, "SENSORID",
+            sensorId);
         return false;
     }
 
-    PdrEntry pdrEntry{};
-    auto pdrRecord = stateSensorPDRs.getFirstRecord(pdrEntry);
-    while (pdrRecord)
+    if ((tmpEntityType >= PLDM_OEM_ENTITY_TYPE_START &&
+         tmpEntityType <= PLDM_OEM_ENTITY_TYPE_END) ||
+        (tmpStateSetId >= PLDM_OEM_STATE_SET_ID_START &&
+         tmpStateSetId < PLDM_OEM_STATE_SET_ID_END))
     {
-        pdr = reinterpret_cast<pldm_state_sensor_pdr*>(pdrEntry.data);
-        assert(pdr != nullptr);
-        if (pdr->sensor_id != sensorId)
-        {
-            pdr = nullptr;
-            pdrRecord = stateSensorPDRs.getNextRecord(pdrRecord, pdrEntry);
-            continue;
-        }
-        auto tmpEntityType = pdr->entity_type;
-        auto tmpEntityInstance = pdr->entity_instance;
-        auto tmpEntityContainerId = pdr->container_id;
-        auto tmpCompSensorCnt = pdr->composite_sensor_count;
-        auto tmpPossibleStates =
-            reinterpret_cast<state_sensor_possible_states*>(
-                pdr->possible_states);
-        auto tmpStateSetId = tmpPossibleStates->state_set_id;
-
-        if (sensorRearmCount > tmpCompSensorCnt)
-        {
-            error(
-                "The requester sent wrong sensor rearm count '{SENSOR_REARM_COUNT}' for the sensor ID '{SENSORID}'.",
-                "SENSOR_REARM_COUNT", (uint16_t)sensorRearmCount, "SENSORID",
-                sensorId);
-            break;
-        }
-
-        if ((tmpEntityType >= PLDM_OEM_ENTITY_TYPE_START &&
-             tmpEntityType <= PLDM_OEM_ENTITY_TYPE_END) ||
-            (tmpStateSetId >= PLDM_OEM_STATE_SET_ID_START &&
-             tmpStateSetId < PLDM_OEM_STATE_SET_ID_END))
-        {
-            entityType = tmpEntityType;
-            entityInstance = tmpEntityInstance;
-            stateSetId = tmpStateSetId;
-            compSensorCnt = tmpCompSensorCnt;
-            containerId = tmpEntityContainerId;
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        entityType = tmpEntityType;
+        entityInstance = tmpEntityInstance;
+        stateSetId = tmpStateSetId;
+        compSensorCnt = tmpCompSensorCnt;
+        containerId = tmpEntityContainerId;
+        return true;
     }
     return false;
 }
@@ -915,76 +1150,48 @@ bool isOemStateEffecter(Handler& handler, uint16_t effecterId,
                         uint8_t compEffecterCnt, uint16_t& entityType,
                         uint16_t& entityInstance, uint16_t& stateSetId)
 {
-    pldm_state_effecter_pdr* pdr = nullptr;
-
-    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> stateEffecterPdrRepo(
-        pldm_pdr_init(), pldm_pdr_destroy);
-    if (!stateEffecterPdrRepo)
+    PdrEntry pdrEntry{};
+    auto pdrRecord = handler.getRepo().findSensorOrEffecter(
+        PLDM_STATE_EFFECTER_PDR, effecterId, pdrEntry);
+    if (!pdrRecord)
     {
-        error("Failed to instantiate state effecter PDR repository");
         return false;
     }
-    Repo stateEffecterPDRs(stateEffecterPdrRepo.get());
-    getRepoByType(handler.getRepo(), stateEffecterPDRs,
-                  PLDM_STATE_EFFECTER_PDR);
-    if (stateEffecterPDRs.empty())
+
+    auto pdr = reinterpret_cast<pldm_state_effecter_pdr*>(pdrEntry.data);
+    assert(pdr != nullptr);
+    auto tmpEntityType = pdr->entity_type;
+    auto tmpEntityInstance = pdr->entity_instance;
+    auto tmpPossibleStates =
+        reinterpret_cast<state_effecter_possible_states*>(pdr->possible_states);
+    auto tmpStateSetId = tmpPossibleStates->state_set_id;
+
+    if (compEffecterCnt > pdr->composite_effecter_count)
     {
-        error("Failed to get record by PDR type");
+        error(
+            "The requester sent wrong composite effecter count '{COMPOSITE_EFFECTER_COUNT}' for the effecter ID '{EFFECTERID}'.",
+            "COMPOSITE_EFFECTER_COUNT", compEffecterCnt, "EFFECTERID",
+            effecterId);
         return false;
     }
 
-    PdrEntry pdrEntry{};
-    auto pdrRecord = stateEffecterPDRs.getFirstRecord(pdrEntry);
-    while (pdrRecord)
+    if ((tmpEntityType >= PLDM_OEM_ENTITY_TYPE_START &&
+         tmpEntityType <= PLDM_OEM_ENTITY_TYPE_END) ||
+        (tmpStateSetId >= PLDM_OEM_STATE_SET_ID_START &&
+         tmpStateSetId < PLDM_OEM_STATE_SET_ID_END))
     {
-        pdr = reinterpret_cast<pldm_state_effecter_pdr*>(pdrEntry.data);
-        assert(pdr != nullptr);
-        if (pdr->effecter_id != effecterId)
-        {
-            pdr = nullptr;
-            pdrRecord = stateEffecterPDRs.getNextRecord(pdrRecord, pdrEntry);
-            continue;
-        }
-
-        auto tmpEntityType = pdr->entity_type;
-        auto tmpEntityInstance = pdr->entity_instance;
-        auto tmpPossibleStates =
-            reinterpret_cast<state_effecter_possible_states*>(
-                pdr->possible_states);
-        auto tmpStateSetId = tmpPossibleStates->state_set_id;
-
-        if (compEffecterCnt > pdr->composite_effecter_count)
-        {
-            error(
-                "The requester sent wrong composite effecter count '{COMPOSITE_EFFECTER_COUNT}' for the effecter ID '{EFFECTERID}'.",
-                "COMPOSITE_EFFECTER_COUNT", compEffecterCnt, "EFFECTERID",
-                effecterId);
-            return false;
-        }
-
-        if ((tmpEntityType >= PLDM_OEM_ENTITY_TYPE_START &&
-             tmpEntityType <= PLDM_OEM_ENTITY_TYPE_END) ||
-            (tmpStateSetId >= PLDM_OEM_STATE_SET_ID_START &&
-             tmpStateSetId < PLDM_OEM_STATE_SET_ID_END))
-        {
-            entityType = tmpEntityType;
-            entityInstance = tmpEntityInstance;
-            stateSetId = tmpStateSetId;
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        entityType = tmpEntityType;
+        entityInstance = tmpEntityInstance;
+        stateSetId = tmpStateSetId;
+        return true;
     }
     return false;
 }
 
 void Handler::setEventReceiver()
 {
-    std::vector<uint8_t> requestMsg(
-        sizeof(pldm_msg_hdr) + PLDM_SET_EVENT_RECEIVER_REQ_BYTES);
-    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    PldmMsg<PLDM_SET_EVENT_RECEIVER_REQ_BYTES> requestMsg;
+    auto request = requestMsg.msg();
     auto instanceId = instanceIdDb->next(eid);
     uint8_t eventMessageGlobalEnable =
         PLDM_EVENT_MESSAGE_GLOBAL_ENABLE_ASYNC_KEEP_ALIVE;
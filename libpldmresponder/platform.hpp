@@ -6,6 +6,7 @@
 #include "host-bmc/dbus_to_event_handler.hpp"
 #include "host-bmc/host_pdr_handler.hpp"
 #include "libpldmresponder/pdr.hpp"
+#include "libpldmresponder/pdr_snapshot.hpp"
 #include "libpldmresponder/pdr_utils.hpp"
 #include "libpldmresponder/platform_config.hpp"
 #include "oem_handler.hpp"
@@ -16,9 +17,12 @@
 #include <libpldm/states.h>
 
 #include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/utility/timer.hpp>
 
+#include <chrono>
 #include <cstdint>
 #include <map>
+#include <set>
 
 PHOSPHOR_LOG2_USING;
 
@@ -77,20 +81,24 @@ class Handler : public CmdHandler
             [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
                 return this->getPDR(request, payloadLength);
             });
-        handlers.emplace(
+        deferredHandlers.emplace(
             PLDM_SET_NUMERIC_EFFECTER_VALUE,
-            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
-                return this->setNumericEffecterValue(request, payloadLength);
+            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength,
+                   ResponseCompletion complete) {
+                this->setNumericEffecterValue(request, payloadLength,
+                                              std::move(complete));
             });
         handlers.emplace(
             PLDM_GET_NUMERIC_EFFECTER_VALUE,
             [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
                 return this->getNumericEffecterValue(request, payloadLength);
             });
-        handlers.emplace(
+        deferredHandlers.emplace(
             PLDM_SET_STATE_EFFECTER_STATES,
-            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
-                return this->setStateEffecterStates(request, payloadLength);
+            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength,
+                   ResponseCompletion complete) {
+                this->setStateEffecterStates(request, payloadLength,
+                                             std::move(complete));
             });
         handlers.emplace(
             PLDM_PLATFORM_EVENT_MESSAGE,
@@ -186,6 +194,43 @@ class Handler : public CmdHandler
         return ++nextSensorId;
     }
 
+    /** @brief Note that a PDR of the PDR JSON files could not be generated
+     *         as its D-Bus object was missing, the PDRs are then not stored
+     *         in the PDR snapshot
+     */
+    void setPDRBuildPartial()
+    {
+        pdrBuildPartial = true;
+    }
+
+    /** @brief Whether a PDR of the PDR JSON files could not be generated */
+    bool isPDRBuildPartial() const
+    {
+        return pdrBuildPartial;
+    }
+
+    /** @brief Add the handler of the PDRs of another host, its events are
+     *         routed to it rather than to the handler of the first host
+     *
+     *  @param[in] tid - TID of the host, its MCTP EID
+     *  @param[in] handler - handler of the PDRs of the host
+     */
+    void addHostPDRHandler(pldm_tid_t tid, HostPDRHandler* handler)
+    {
+        hostPDRHandlers.insert_or_assign(tid, handler);
+    }
+
+    /** @brief Answer the SetStateEffecterStates requests of an effecter
+     *         without waiting for its D-Bus properties to be set
+     *
+     *  @param[in] effecterId - the effecter, marked fire_and_forget in the
+     *                          PDR JSON
+     */
+    void addFireAndForgetEffecter(uint16_t effecterId)
+    {
+        fireAndForgetEffecters.insert(effecterId);
+    }
+
     /** @brief Parse PDR JSONs and build PDR repository
      *
      *  @param[in] dBusIntf - The interface object
@@ -196,6 +241,15 @@ class Handler : public CmdHandler
                   const std::vector<fs::path>& dir,
                   pldm::responder::pdr_utils::Repo& repo);
 
+    /** @brief Start building the PDR repository in the background
+     *
+     *  The FRU table, the BMC PDRs and the PDRs of each JSON file are built
+     *  in slices run from the event loop, GetPDR is answered with
+     *  PLDM_ERROR_NOT_READY until the build completes. Does nothing if the
+     *  repository was built already.
+     */
+    void startPDRBuild();
+
     /** @brief Parse PDR JSONs and build state effecter PDR repository
      *
      *  @param[in] json - platform specific PDR JSON files
@@ -244,13 +298,15 @@ class Handler : public CmdHandler
     Response getPDR(const pldm_msg* request, size_t payloadLength);
 
     /** @brief Handler for setNumericEffecterValue
+     *
+     *  The response is completed once the D-Bus property is set.
      *
      *  @param[in] request - Request message
      *  @param[in] payloadLength - Request payload length
-     *  @return Response - PLDM Response message
+     *  @param[in] complete - completes the PLDM Response message
      */
-    Response setNumericEffecterValue(const pldm_msg* request,
-                                     size_t payloadLength);
+    void setNumericEffecterValue(const pldm_msg* request, size_t payloadLength,
+                                 ResponseCompletion complete);
 
     /** @brief Handler for getNumericEffecterValue
      *
@@ -271,13 +327,15 @@ class Handler : public CmdHandler
                                     size_t payloadLength);
 
     /** @brief Handler for setStateEffecterStates
+     *
+     *  The response is completed once the D-Bus properties are set.
      *
      *  @param[in] request - Request message
      *  @param[in] payloadLength - Request payload length
-     *  @return Response - PLDM Response message
+     *  @param[in] complete - completes the PLDM Response message
      */
-    Response setStateEffecterStates(const pldm_msg* request,
-                                    size_t payloadLength);
+    void setStateEffecterStates(const pldm_msg* request, size_t payloadLength,
+                                ResponseCompletion complete);
 
     /** @brief Handler for PlatformEventMessage
      *
@@ -503,16 +561,126 @@ class Handler : public CmdHandler
         }
     }
 
+    /** @brief Set the D-Bus properties of an effecter without blocking, then
+     *         complete the response of the request
+     *
+     *  @param[in] writes - the D-Bus properties and their values
+     *  @param[in] hdr - header of the request
+     *  @param[in] rc - completion code once the properties are set
+     *  @param[in] complete - completes the cc only PLDM Response message
+     *  @param[in] wait - complete the response once the properties are set,
+     *                    else at once
+     */
+    void setEffecterProperties(
+        pldm::utils::AsyncDBusHandler::PropertyWrites writes,
+        const pldm_msg_hdr& hdr, int rc, ResponseCompletion complete,
+        bool wait = true);
+
+    /** @brief Get a D-Bus handler reading the properties of the sensors and
+     *         effecters from the property cache of the host, if any
+     */
+    inline pldm::state_sensor::CachedDBusHandler getCachedDBusHandler()
+    {
+        return pldm::state_sensor::CachedDBusHandler(
+            dbusToPLDMEventHandler ? &dbusToPLDMEventHandler->getPropertyCache()
+                                   : nullptr);
+    }
+
     /** @brief process the actions that needs to be performed after a GetPDR
      *         call is received
      *  @param[in] source - sdeventplus event source
      */
     void _processPostGetPDRActions(sdeventplus::source::EventBase& source);
 
+    /** @brief Check if the PDR repository is fully built */
+    bool isPDRBuilt() const
+    {
+        return pdrCreated;
+    }
+
     /** @brief Method for setEventreceiver */
     void setEventReceiver();
 
   private:
+    /** @brief Get the handler of the PDRs of the host an event is from
+     *
+     *  @param[in] tid - TID of the terminus sending the event
+     *
+     *  @return the handler of the host of the TID, else of the first host
+     */
+    HostPDRHandler* getHostPDRHandler(uint8_t tid) const
+    {
+        auto it = hostPDRHandlers.find(tid);
+        return it != hostPDRHandlers.end() ? it->second : hostPDRHandler;
+    }
+
+    /** @brief Stages of the background PDR build */
+    enum class PDRBuildStage
+    {
+        NotStarted,
+        DBusSnapshot,
+        FRUTable,
+        BMCPDRs,
+        PDRJsons,
+        Done
+    };
+
+    /** @brief Run the next slice of the background PDR build */
+    void buildPDRStep();
+
+    /** @brief Fetch the inventory objects the FRU table is built from with
+     *         one call, the build moves on to the FRU table once the reply
+     *         arrived
+     */
+    void fetchDBusSnapshot();
+
+    /** @brief Mark the background PDR build complete */
+    void finishPDRBuild();
+
+    /** @brief Get the inputs of the PDR generation other than the PDR JSON
+     *         files, the PDR snapshot is stored for
+     */
+    std::string getPDRSnapshotSalt();
+
+    /** @brief Add the PDRs and D-Bus mappings of the PDR snapshot instead of
+     *         generating them from the PDR JSON files
+     *
+     *  @return true if a valid snapshot was applied
+     */
+    bool loadPDRSnapshot();
+
+    /** @brief Store the PDRs generated from the PDR JSON files and their
+     *         D-Bus mappings in the PDR snapshot
+     */
+    void storePDRSnapshot();
+
+    /** @brief Get the PDR JSON files of the directories
+     *
+     *  @param[in] dir - directories housing platform specific PDR JSON files
+     *  @return the files, none if one of the directories does not exist
+     */
+    std::vector<fs::path> getPDRJsonFiles(const std::vector<fs::path>& dir);
+
+    /** @brief Parse one PDR JSON file and add its PDRs to the repository
+     *
+     *  @param[in] dBusIntf - The interface object
+     *  @param[in] path - the PDR JSON file
+     *  @param[in] repo - instance of concrete implementation of Repo
+     */
+    void generatePDRs(const pldm::utils::DBusHandler& dBusIntf,
+                      const fs::path& path,
+                      pldm::responder::pdr_utils::Repo& repo);
+
+    /** @brief Longest time a slice of the background PDR build may take
+     *         before yielding to the event loop
+     */
+    static constexpr auto pdrBuildSlice = std::chrono::milliseconds(10);
+
+    /** @brief Delay before starting the background PDR build again when the
+     *         BMC is not ready
+     */
+    static constexpr auto pdrBuildRetryInterval = std::chrono::seconds(1);
+
     uint8_t eid;
     InstanceIdDb* instanceIdDb;
     pdr_utils::Repo pdrRepo;
@@ -520,6 +688,14 @@ class Handler : public CmdHandler
     uint16_t nextSensorId{};
     DbusObjMaps effecterDbusObjMaps{};
     DbusObjMaps sensorDbusObjMaps{};
+
+    /** @brief Handlers of the PDRs of the hosts other than the first, by
+     *         TID
+     */
+    std::map<pldm_tid_t, HostPDRHandler*> hostPDRHandlers;
+
+    /** @brief Effecters answered before their D-Bus properties are set */
+    std::set<uint16_t> fireAndForgetEffecters;
     HostPDRHandler* hostPDRHandler;
     pldm::state_sensor::DbusToPLDMEvent* dbusToPLDMEventHandler;
     fru::Handler* fruHandler;
@@ -532,6 +708,17 @@ class Handler : public CmdHandler
     bool pdrCreated;
     std::vector<fs::path> pdrJsonsDir;
     std::unique_ptr<sdeventplus::source::Defer> deferredGetPDREvent;
+    PDRBuildStage pdrBuildStage = PDRBuildStage::NotStarted;
+    std::vector<fs::path> pdrBuildFiles;
+    size_t pdrBuildNext = 0;
+    std::chrono::steady_clock::time_point pdrBuildBegin;
+    PdrSnapshot pdrSnapshot{PDR_SNAPSHOT_PATH};
+    uint64_t pdrSnapshotKey = 0;
+    uint32_t pdrSnapshotFirstRecord = 0;
+    bool pdrBuildPartial = false;
+    std::unique_ptr<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        pdrBuildTimer;
 };
 
 /** @brief Function to check if a sensor falls in OEM range
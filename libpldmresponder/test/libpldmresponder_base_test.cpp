@@ -7,6 +7,7 @@
 
 #include <sdeventplus/event.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 
@@ -153,3 +154,26 @@ TEST_F(TestBaseCommands, testGetTIDGoodRequest)
     ASSERT_EQ(payload[0], 0);
     ASSERT_EQ(payload[1], 1);
 }
+
+TEST_F(TestBaseCommands, testResponseTemplateInstanceId)
+{
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_COMMANDS_REQ_BYTES>
+        requestPayload{};
+    auto request = reinterpret_cast<pldm_msg*>(requestPayload.data());
+    size_t requestPayloadLength = requestPayload.size() - sizeof(pldm_msg_hdr);
+    base::Handler handler(event);
+
+    request->hdr.instance_id = 5;
+    auto first = handler.getPLDMCommands(request, requestPayloadLength);
+    request->hdr.instance_id = 9;
+    auto second = handler.getPLDMCommands(request, requestPayloadLength);
+
+    auto firstPtr = reinterpret_cast<pldm_msg*>(first.data());
+    auto secondPtr = reinterpret_cast<pldm_msg*>(second.data());
+    EXPECT_EQ(firstPtr->hdr.instance_id, 5);
+    EXPECT_EQ(secondPtr->hdr.instance_id, 9);
+    EXPECT_EQ(firstPtr->hdr.request, PLDM_RESPONSE);
+    ASSERT_EQ(first.size(), second.size());
+    EXPECT_TRUE(std::equal(first.begin() + sizeof(pldm_msg_hdr), first.end(),
+                           second.begin() + sizeof(pldm_msg_hdr)));
+}
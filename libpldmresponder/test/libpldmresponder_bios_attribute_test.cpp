@@ -11,7 +11,7 @@ class TestAttribute : public BIOSAttribute
 {
   public:
     TestAttribute(const Json& entry, DBusHandler* const dbusHandler) :
-        BIOSAttribute(entry, dbusHandler)
+        BIOSAttribute(AttributeSchema::fromJson(entry, ""), dbusHandler)
     {}
 
     void setAttrValueOnDbus(const pldm_bios_attr_val_table_entry*,
@@ -6,10 +6,16 @@
 #include "libpldmresponder/platform_config.hpp"
 #include "mocked_bios.hpp"
 
+#include <libpldm/utils.h>
+
 #include <nlohmann/json.hpp>
 
+#include <cerrno>
 #include <fstream>
+#include <functional>
 #include <memory>
+#include <span>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -277,6 +283,67 @@ TEST_F(TestBIOSConfig, setBIOSTable)
     EXPECT_TRUE(stringTable);
 }
 
+TEST_F(TestBIOSConfig, tableSnapshots)
+{
+    MockdBusHandler dbusHandler;
+    MockSystemConfig mockSystemConfig;
+
+    Table table;
+    table::string::constructEntry(table, "pvm_system_name");
+    table::appendPadAndChecksum(table);
+
+    {
+        BIOSConfig biosConfig("./", tableDir.c_str(), &dbusHandler, 0, 0,
+                              nullptr, nullptr, &mockSystemConfig, []() {});
+        ASSERT_EQ(biosConfig.setBIOSTable(PLDM_BIOS_STRING_TABLE, table),
+                  PLDM_SUCCESS);
+        auto snapshot = biosConfig.getTable(PLDM_BIOS_STRING_TABLE);
+        ASSERT_TRUE(snapshot);
+        EXPECT_EQ(*snapshot, table);
+
+        // An update replaces the table, snapshots already taken are kept
+        Table updated;
+        table::string::constructEntry(updated, "fw_boot_side");
+        table::appendPadAndChecksum(updated);
+        ASSERT_EQ(biosConfig.setBIOSTable(PLDM_BIOS_STRING_TABLE, updated),
+                  PLDM_SUCCESS);
+        EXPECT_EQ(*snapshot, table);
+        EXPECT_EQ(*biosConfig.getTable(PLDM_BIOS_STRING_TABLE), updated);
+    }
+
+    // The updated tables were persisted
+    BIOSTable stringTable((tableDir / "stringTable").c_str());
+    EXPECT_FALSE(stringTable.isEmpty());
+}
+
+TEST_F(TestBIOSConfig, tableTags)
+{
+    MockdBusHandler dbusHandler;
+    MockSystemConfig mockSystemConfig;
+
+    BIOSConfig biosConfig("./", tableDir.c_str(), &dbusHandler, 0, 0, nullptr,
+                          nullptr, &mockSystemConfig, []() {});
+
+    Table table;
+    table::string::constructEntry(table, "pvm_system_name");
+    table::appendPadAndChecksum(table);
+    ASSERT_EQ(biosConfig.setBIOSTable(PLDM_BIOS_STRING_TABLE, table),
+              PLDM_SUCCESS);
+    auto tag = getTableTag(*biosConfig.getTable(PLDM_BIOS_STRING_TABLE));
+    ASSERT_TRUE(tag);
+    EXPECT_EQ(*tag, crc32(table.data(), table.size() - 4));
+
+    // Any change of the table changes its tag
+    Table updated;
+    table::string::constructEntry(updated, "fw_boot_side");
+    table::appendPadAndChecksum(updated);
+    ASSERT_EQ(biosConfig.setBIOSTable(PLDM_BIOS_STRING_TABLE, updated),
+              PLDM_SUCCESS);
+    EXPECT_NE(getTableTag(*biosConfig.getTable(PLDM_BIOS_STRING_TABLE)), tag);
+
+    EXPECT_FALSE(getTableTag(Table{0, 1}));
+}
+
 TEST_F(TestBIOSConfig, getBIOSTableFailure)
 {
     MockdBusHandler dbusHandler;
@@ -388,3 +455,116 @@ TEST_F(TestBIOSConfig, setAttrValue)
     EXPECT_THAT(std::vector<uint8_t>(p, p + attrValueEntry.size()),
                 ElementsAreArray(attrValueEntry));
 }
+
+TEST_F(TestBIOSConfig, setAttrValuesAllOrNothing)
+{
+    MockdBusHandler dbusHandler;
+    MockSystemConfig mockSystemConfig;
+
+    BIOSConfig biosConfig("./bios_jsons", tableDir.c_str(), &dbusHandler, 0, 0,
+                          nullptr, nullptr, &mockSystemConfig, []() {});
+
+    auto stringTable = biosConfig.getBIOSTable(PLDM_BIOS_STRING_TABLE);
+    auto attrTable = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_TABLE);
+    auto attrValueTable = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+
+    BIOSStringTable biosStringTable(*stringTable);
+    auto stringHandle = biosStringTable.findHandle("str_example1");
+    uint16_t attrHandle{};
+    for (auto entry : BIOSTableIter<PLDM_BIOS_ATTR_TABLE>(attrTable->data(),
+                                                          attrTable->size()))
+    {
+        auto header = table::attribute::decodeHeader(entry);
+        if (header.stringHandle == stringHandle)
+        {
+            attrHandle = header.attrHandle;
+            break;
+        }
+    }
+    EXPECT_NE(attrHandle, 0);
+
+    std::vector<uint8_t> validEntry{
+        static_cast<uint8_t>(attrHandle & 0xff),
+        static_cast<uint8_t>((attrHandle >> 8) & 0xff),
+        1,                  /* attr type string read-write */
+        4,   0,             /* current string length */
+        'a', 'b', 'c', 'd', /* current string */
+    };
+    std::vector<uint8_t> invalidEntry{
+        0xff, 0xff,          /* unknown attr handle */
+        1,                   /* attr type string read-write */
+        4,    0,             /* current string length */
+        'a',  'b', 'c', 'd', /* current string */
+    };
+
+    /* Nothing is applied when one of the entries is invalid */
+    EXPECT_CALL(dbusHandler, setDbusProperty(_, _)).Times(0);
+    std::vector<std::span<const uint8_t>> entries{validEntry, invalidEntry};
+    auto rc = biosConfig.setAttrValues(entries, false);
+    EXPECT_NE(rc, PLDM_SUCCESS);
+
+    auto unchanged = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    ASSERT_TRUE(unchanged);
+    EXPECT_EQ(*attrValueTable, *unchanged);
+}
+
+TEST_F(TestBIOSConfig, checkAttrValues)
+{
+    MockdBusHandler dbusHandler;
+    MockSystemConfig mockSystemConfig;
+
+    BIOSConfig biosConfig("./bios_jsons", tableDir.c_str(), &dbusHandler, 0, 0,
+                          nullptr, nullptr, &mockSystemConfig, []() {});
+
+    auto attrValueTable = biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE);
+    ASSERT_TRUE(attrValueTable);
+    EXPECT_EQ(biosConfig.checkAttrValues(*attrValueTable), PLDM_SUCCESS);
+
+    /* The first entry refers to an attribute missing from the table */
+    auto invalidTable = *attrValueTable;
+    invalidTable[0] = 0xff;
+    invalidTable[1] = 0xff;
+    EXPECT_EQ(biosConfig.checkAttrValues(invalidTable),
+              PLDM_INVALID_BIOS_ATTR_HANDLE);
+}
+
+/** @brief D-Bus handler holding the replies of the asynchronous reads */
+class DeferredDBusHandler : public MockdBusHandler
+{
+  public:
+    void getDbusPropertyVariantAsync(
+        const DBusMapping&,
+        std::function<void(int, PropertyValue&&)> callback) const override
+    {
+        callbacks.emplace_back(std::move(callback));
+    }
+
+    mutable std::vector<std::function<void(int, PropertyValue&&)>> callbacks;
+};
+
+TEST_F(TestBIOSConfig, attrTablesWaitForPropertyReads)
+{
+    DeferredDBusHandler dbusHandler;
+    MockSystemConfig mockSystemConfig;
+
+    // A failed read takes the default value, it is not read again
+    EXPECT_CALL(dbusHandler, getDbusPropertyVariant(_, _, _)).Times(0);
+
+    BIOSConfig biosConfig("./bios_jsons", tableDir.c_str(), &dbusHandler, 0, 0,
+                          nullptr, nullptr, &mockSystemConfig, []() {});
+
+    EXPECT_TRUE(biosConfig.getBIOSTable(PLDM_BIOS_STRING_TABLE));
+    EXPECT_FALSE(biosConfig.getBIOSTable(PLDM_BIOS_ATTR_TABLE));
+    ASSERT_FALSE(dbusHandler.callbacks.empty());
+
+    auto callbacks = std::move(dbusHandler.callbacks);
+    for (size_t i = 1; i < callbacks.size(); i++)
+    {
+        callbacks[i](-ETIMEDOUT, {});
+    }
+    EXPECT_FALSE(biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE));
+
+    callbacks[0](-ETIMEDOUT, {});
+    EXPECT_TRUE(biosConfig.getBIOSTable(PLDM_BIOS_ATTR_TABLE));
+    EXPECT_TRUE(biosConfig.getBIOSTable(PLDM_BIOS_ATTR_VAL_TABLE));
+}
@@ -0,0 +1,155 @@
+#include "libpldmresponder/bios_schema_cache.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using namespace pldm::responder::bios;
+using Json = nlohmann::json;
+
+class BIOSSchemaCacheTest : public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pldm_bios_schema_cache.XXXXXX";
+        dir = fs::path(mkdtemp(tmpdir));
+
+        entries = R"([
+            {
+                "attribute_type" : "string",
+                "attribute_name" : "str_example1",
+                "string_type" : "ASCII",
+                "minimum_string_length" : 1,
+                "maximum_string_length" : 100,
+                "default_string" : "abc",
+                "help_text" : "HelpText",
+                "display_name" : "DisplayName",
+                "dbus" : {
+                    "object_path" : "/xyz/abc/def",
+                    "interface" : "xyz.openbmc_project.str_example1.value",
+                    "property_name" : "Str_example1",
+                    "property_type" : "string"
+                }
+            },
+            {
+                "attribute_type" : "enum",
+                "attribute_name" : "Led",
+                "possible_values" : ["On", "Off"],
+                "default_values" : ["On"],
+                "help_text" : "HelpText",
+                "display_name" : "DisplayName",
+                "dbus" : {
+                    "object_path" : "/xyz/abc/def",
+                    "interface" : "xyz.openbmc_project.led.value",
+                    "property_name" : "Led",
+                    "property_type" : "int32_t",
+                    "property_values" : [1, -1]
+                }
+            },
+            {
+                "attribute_type" : "integer",
+                "attribute_name" : "Count",
+                "lower_bound" : 1,
+                "upper_bound" : 15,
+                "scalar_increment" : 1,
+                "default_value" : 2,
+                "read_only" : true,
+                "help_text" : "HelpText",
+                "display_name" : "DisplayName"
+            }
+        ])"_json;
+
+        for (const auto& entry : entries)
+        {
+            schemas.push_back(
+                AttributeSchema::fromJson(entry, entry.at("attribute_type")));
+        }
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(dir);
+    }
+
+    fs::path dir;
+    Json entries;
+    AttributeSchemas schemas;
+};
+
+TEST_F(BIOSSchemaCacheTest, storeLoad)
+{
+    BIOSSchemaCache cache(dir / "cache");
+    EXPECT_FALSE(cache.load(1).has_value());
+
+    EXPECT_TRUE(cache.store(1, schemas));
+    auto loaded = cache.load(1);
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_EQ(loaded->size(), schemas.size());
+
+    const auto& str = (*loaded)[0];
+    EXPECT_EQ(str.type, "string");
+    EXPECT_EQ(str.name, "str_example1");
+    EXPECT_EQ(str.stringType, "ASCII");
+    EXPECT_EQ(str.minLength, 1);
+    EXPECT_EQ(str.maxLength, 100);
+    EXPECT_EQ(str.defaultString, "abc");
+    ASSERT_TRUE(str.dBusMap.has_value());
+    EXPECT_EQ(str.dBusMap->objectPath, "/xyz/abc/def");
+    EXPECT_EQ(str.dBusMap->propertyType, "string");
+
+    const auto& led = (*loaded)[1];
+    EXPECT_EQ(led.possibleValues, schemas[1].possibleValues);
+    EXPECT_EQ(led.defaultValues, schemas[1].defaultValues);
+    EXPECT_EQ(led.dbusValues, schemas[1].dbusValues);
+    EXPECT_EQ(std::get<int32_t>(led.dbusValues[1]), -1);
+
+    const auto& count = (*loaded)[2];
+    EXPECT_TRUE(count.readOnly);
+    EXPECT_FALSE(count.dBusMap.has_value());
+    EXPECT_EQ(count.lowerBound, 1);
+    EXPECT_EQ(count.upperBound, 15);
+    EXPECT_EQ(count.scalarIncrement, 1);
+    EXPECT_EQ(count.defaultValue, 2);
+
+    /* Stored for other inputs */
+    EXPECT_FALSE(cache.load(2).has_value());
+}
+
+TEST_F(BIOSSchemaCacheTest, corruptedCache)
+{
+    auto path = dir / "cache";
+    BIOSSchemaCache cache(path);
+    ASSERT_TRUE(cache.store(1, schemas));
+
+    fs::resize_file(path, fs::file_size(path) - 1);
+    EXPECT_FALSE(cache.load(1).has_value());
+
+    std::ofstream(path, std::ios::trunc) << "garbage";
+    EXPECT_FALSE(cache.load(1).has_value());
+}
+
+TEST_F(BIOSSchemaCacheTest, computeKey)
+{
+    auto file = dir / "bios_attrs.json";
+    std::ofstream(file) << R"({"entries": []})";
+    auto key = BIOSSchemaCache::computeKey(file, "system1");
+    EXPECT_EQ(key, BIOSSchemaCache::computeKey(file, "system1"));
+    EXPECT_NE(key, BIOSSchemaCache::computeKey(file, "system2"));
+
+    std::ofstream(file) << R"({"entries": [{}]})";
+    EXPECT_NE(key, BIOSSchemaCache::computeKey(file, "system1"));
+}
+
+TEST_F(BIOSSchemaCacheTest, disabled)
+{
+    BIOSSchemaCache cache;
+    EXPECT_FALSE(cache.enabled());
+    EXPECT_FALSE(cache.store(1, schemas));
+    EXPECT_FALSE(cache.load(1).has_value());
+}
@@ -159,6 +159,12 @@ TEST_F(TestBIOSStringAttribute, ConstructEntry)
 
     checkConstructEntry(stringReadWrite, biosStringTable, expectedAttrEntry,
                         expectedAttrValueEntry);
+
+    /* A prefetched value replaces the next D-Bus read */
+    EXPECT_CALL(dbusHandler, getDbusPropertyVariant(_, _, _)).Times(0);
+    stringReadWrite.setPrefetchedValue(std::string("abcd"));
+    checkConstructEntry(stringReadWrite, biosStringTable, expectedAttrEntry,
+                        expectedAttrValueEntry);
 }
 
 TEST_F(TestBIOSStringAttribute, setAttrValueOnDbus)
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <memory>
+#include <stdexcept>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -58,3 +60,22 @@ TEST_F(TestBIOSTable, testLoadOntoExisting)
     ASSERT_EQ(out[0], 99);
     ASSERT_EQ(out[1], 99);
 }
+
+TEST(BIOSStringTable, indexedLookup)
+{
+    Table table;
+    auto firstHandle = table::string::decodeHandle(
+        table::string::constructEntry(table, "pvm_system_name"));
+    auto secondHandle = table::string::decodeHandle(
+        table::string::constructEntry(table, "fw_boot_side"));
+    table::appendPadAndChecksum(table);
+
+    BIOSStringTable stringTable(std::make_shared<const Table>(table));
+    EXPECT_EQ(stringTable.findString(firstHandle), "pvm_system_name");
+    EXPECT_EQ(stringTable.findString(secondHandle), "fw_boot_side");
+    EXPECT_EQ(stringTable.findHandle("fw_boot_side"), secondHandle);
+    EXPECT_THROW(stringTable.findHandle("fw_next_boot_side"),
+                 std::invalid_argument);
+    EXPECT_THROW(stringTable.findString(secondHandle + 1),
+                 std::invalid_argument);
+}
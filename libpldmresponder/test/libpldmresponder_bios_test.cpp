@@ -1,13 +1,19 @@
+#include "common/test/mocked_utils.hpp"
 #include "libpldmresponder/bios.hpp"
 #include "libpldmresponder/bios_table.hpp"
 
 #include <libpldm/base.h>
 #include <libpldm/bios.h>
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <ctime>
 #include <filesystem>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -61,3 +67,261 @@ TEST(timeToEpoch, testTime0)
 
     EXPECT_EQ(ret, timeSec);
 }
+
+class TestBIOSHandler : public ::testing::Test
+{
+  protected:
+    TestBIOSHandler() :
+        tableDir(makeTableDir()),
+        handler("./jsons", tableDir.c_str(), &dbusHandler, 0, 0, nullptr,
+                nullptr, nullptr, []() {})
+    {
+        for (int i = 0; i < 20; i++)
+        {
+            table::string::constructEntry(stringTable,
+                                          "string_" + std::to_string(i));
+        }
+        table::appendPadAndChecksum(stringTable);
+    }
+
+    ~TestBIOSHandler()
+    {
+        std::filesystem::remove_all(tableDir);
+    }
+
+    static std::filesystem::path makeTableDir()
+    {
+        char tmpdir[] = "/tmp/pldm_bios_handler.XXXXXX";
+        return mkdtemp(tmpdir);
+    }
+
+    void setTransferSize(size_t size)
+    {
+        handler.tableTransferSize = size;
+    }
+
+    /** @brief A part of a table received with GetBIOSTable */
+    struct Part
+    {
+        uint8_t completionCode;
+        uint32_t nextTransferHandle;
+        uint8_t transferFlag;
+        std::vector<uint8_t> data;
+    };
+
+    Part getPart(pldm_tid_t tid, uint32_t transferHandle, uint8_t opFlag)
+    {
+        std::array<uint8_t,
+                   sizeof(pldm_msg_hdr) + PLDM_GET_BIOS_TABLE_REQ_BYTES>
+            request{};
+        auto requestPtr = reinterpret_cast<pldm_msg*>(request.data());
+        EXPECT_EQ(encode_get_bios_table_req(0, transferHandle, opFlag,
+                                            PLDM_BIOS_STRING_TABLE, requestPtr),
+                  PLDM_SUCCESS);
+        auto response = handler.getBIOSTable(tid, requestPtr,
+                                             PLDM_GET_BIOS_TABLE_REQ_BYTES);
+        auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+        Part part{responsePtr->payload[0], 0, 0, {}};
+        if (part.completionCode != PLDM_SUCCESS)
+        {
+            return part;
+        }
+        size_t offset = 0;
+        EXPECT_EQ(decode_get_bios_table_resp(
+                      responsePtr, response.size() - sizeof(pldm_msg_hdr),
+                      &part.completionCode, &part.nextTransferHandle,
+                      &part.transferFlag, &offset),
+                  PLDM_SUCCESS);
+        part.data.assign(responsePtr->payload + offset,
+                         response.data() + response.size());
+        return part;
+    }
+
+    /** @brief Send a part of the string table with SetBIOSTable
+     *
+     *  @return the completion code and the next transfer handle
+     */
+    std::pair<uint8_t, uint32_t> setPart(pldm_tid_t tid,
+                                         uint32_t transferHandle,
+                                         uint8_t transferFlag,
+                                         std::span<const uint8_t> data)
+    {
+        std::vector<uint8_t> request(sizeof(pldm_msg_hdr) +
+                                     PLDM_SET_BIOS_TABLE_MIN_REQ_BYTES +
+                                     data.size());
+        auto requestPtr = reinterpret_cast<pldm_msg*>(request.data());
+        auto payloadLength = request.size() - sizeof(pldm_msg_hdr);
+        EXPECT_EQ(encode_set_bios_table_req(
+                      0, transferHandle, transferFlag, PLDM_BIOS_STRING_TABLE,
+                      data.data(), data.size(), requestPtr, payloadLength),
+                  PLDM_SUCCESS);
+        auto response = handler.setBIOSTable(tid, requestPtr, payloadLength);
+        auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+        uint8_t completionCode = responsePtr->payload[0];
+        uint32_t nextTransferHandle = 0;
+        if (completionCode == PLDM_SUCCESS)
+        {
+            EXPECT_EQ(decode_set_bios_table_resp(
+                          responsePtr, response.size() - sizeof(pldm_msg_hdr),
+                          &completionCode, &nextTransferHandle),
+                      PLDM_SUCCESS);
+        }
+        return {completionCode, nextTransferHandle};
+    }
+
+    /** @brief Set the string table in a single part */
+    void setStringTable()
+    {
+        ASSERT_EQ(setPart(1, 0, PLDM_START_AND_END, stringTable).first,
+                  PLDM_SUCCESS);
+    }
+
+    std::filesystem::path tableDir;
+    MockdBusHandler dbusHandler;
+    pldm::responder::bios::Handler handler;
+    Table stringTable;
+};
+
+TEST_F(TestBIOSHandler, getTableInParts)
+{
+    setStringTable();
+    setTransferSize(32);
+
+    auto part = getPart(1, 0, PLDM_GET_FIRSTPART);
+    ASSERT_EQ(part.completionCode, PLDM_SUCCESS);
+    EXPECT_EQ(part.transferFlag, PLDM_START);
+    EXPECT_EQ(part.nextTransferHandle, 32u);
+    auto table = part.data;
+    while (part.transferFlag != PLDM_END)
+    {
+        part = getPart(1, part.nextTransferHandle, PLDM_GET_NEXTPART);
+        ASSERT_EQ(part.completionCode, PLDM_SUCCESS);
+        ASSERT_TRUE(part.transferFlag == PLDM_MIDDLE ||
+                    part.transferFlag == PLDM_END);
+        table.insert(table.end(), part.data.begin(), part.data.end());
+    }
+    EXPECT_EQ(part.nextTransferHandle, 0u);
+    EXPECT_EQ(table, stringTable);
+
+    // Without a part size limit the table is sent at once
+    setTransferSize(0);
+    part = getPart(1, 0, PLDM_GET_FIRSTPART);
+    EXPECT_EQ(part.transferFlag, PLDM_START_AND_END);
+    EXPECT_EQ(part.data, stringTable);
+}
+
+TEST_F(TestBIOSHandler, getTableBadTransferHandle)
+{
+    setStringTable();
+    setTransferSize(32);
+
+    // No transfer in progress
+    EXPECT_EQ(getPart(1, 32, PLDM_GET_NEXTPART).completionCode,
+              PLDM_ERROR_INVALID_DATA);
+
+    auto part = getPart(1, 0, PLDM_GET_FIRSTPART);
+    ASSERT_EQ(part.completionCode, PLDM_SUCCESS);
+    EXPECT_EQ(getPart(1, 0, PLDM_GET_NEXTPART).completionCode,
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(getPart(1, stringTable.size(), PLDM_GET_NEXTPART).completionCode,
+              PLDM_ERROR_INVALID_DATA);
+
+    // A bad handle does not end the transfer, nor does a retried part
+    part = getPart(1, part.nextTransferHandle, PLDM_GET_NEXTPART);
+    EXPECT_EQ(part.completionCode, PLDM_SUCCESS);
+    EXPECT_EQ(getPart(1, 32, PLDM_GET_NEXTPART).completionCode, PLDM_SUCCESS);
+}
+
+TEST_F(TestBIOSHandler, getTransfersPerRequester)
+{
+    setStringTable();
+    setTransferSize(32);
+
+    auto part1 = getPart(1, 0, PLDM_GET_FIRSTPART);
+    ASSERT_EQ(part1.completionCode, PLDM_SUCCESS);
+
+    // Another requester reads the whole table meanwhile
+    auto part2 = getPart(2, 0, PLDM_GET_FIRSTPART);
+    while (part2.completionCode == PLDM_SUCCESS &&
+           part2.transferFlag != PLDM_END)
+    {
+        part2 = getPart(2, part2.nextTransferHandle, PLDM_GET_NEXTPART);
+    }
+    EXPECT_EQ(part2.completionCode, PLDM_SUCCESS);
+
+    // The first requester goes on where it was
+    part1 = getPart(1, part1.nextTransferHandle, PLDM_GET_NEXTPART);
+    EXPECT_EQ(part1.completionCode, PLDM_SUCCESS);
+    EXPECT_TRUE(std::ranges::equal(
+        part1.data, std::span(stringTable).subspan(32, part1.data.size())));
+}
+
+TEST_F(TestBIOSHandler, setTableInParts)
+{
+    auto table = std::span<const uint8_t>(stringTable);
+    auto [cc, next] = setPart(1, 0, PLDM_START, table.first(40));
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+    EXPECT_EQ(next, 40u);
+    std::tie(cc, next) = setPart(1, next, PLDM_MIDDLE, table.subspan(40, 40));
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+    EXPECT_EQ(next, 80u);
+    std::tie(cc, next) = setPart(1, next, PLDM_END, table.subspan(80));
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+    EXPECT_EQ(next, 0u);
+
+    auto part = getPart(1, 0, PLDM_GET_FIRSTPART);
+    ASSERT_EQ(part.completionCode, PLDM_SUCCESS);
+    EXPECT_EQ(part.data, stringTable);
+}
+
+TEST_F(TestBIOSHandler, setTableOutOfOrder)
+{
+    auto table = std::span<const uint8_t>(stringTable);
+
+    // No transfer in progress
+    EXPECT_EQ(setPart(1, 0, PLDM_MIDDLE, table.first(40)).first,
+              PLDM_ERROR_INVALID_DATA);
+
+    // A part at the wrong offset drops the transfer
+    ASSERT_EQ(setPart(1, 0, PLDM_START, table.first(40)).first, PLDM_SUCCESS);
+    EXPECT_EQ(setPart(1, 80, PLDM_MIDDLE, table.subspan(80, 40)).first,
+              PLDM_ERROR_INVALID_DATA);
+    EXPECT_EQ(setPart(1, 40, PLDM_END, table.subspan(40)).first,
+              PLDM_ERROR_INVALID_DATA);
+
+    EXPECT_EQ(getPart(1, 0, PLDM_GET_FIRSTPART).completionCode,
+              PLDM_BIOS_TABLE_UNAVAILABLE);
+}
+
+TEST_F(TestBIOSHandler, setTableSizeLimit)
+{
+    constexpr size_t partSize = 64 * 1024;
+    std::vector<uint8_t> data(partSize);
+    ASSERT_EQ(setPart(1, 0, PLDM_START, data).first, PLDM_SUCCESS);
+    uint32_t offset = partSize;
+    for (; offset < 1024 * 1024; offset += partSize)
+    {
+        ASSERT_EQ(setPart(1, offset, PLDM_MIDDLE, data).first, PLDM_SUCCESS);
+    }
+
+    // The table would exceed 1 MiB, the transfer is dropped
+    EXPECT_EQ(setPart(1, offset, PLDM_MIDDLE, data).first,
+              PLDM_ERROR_INVALID_LENGTH);
+    EXPECT_EQ(setPart(1, offset, PLDM_END, std::span(data).first(1)).first,
+              PLDM_ERROR_INVALID_DATA);
+}
+
+TEST_F(TestBIOSHandler, setTransfersPerRequester)
+{
+    auto table = std::span<const uint8_t>(stringTable);
+    ASSERT_EQ(setPart(1, 0, PLDM_START, table.first(40)).first, PLDM_SUCCESS);
+    ASSERT_EQ(setPart(2, 0, PLDM_START, table.first(80)).first, PLDM_SUCCESS);
+
+    // Each requester continues its own transfer
+    EXPECT_EQ(setPart(1, 40, PLDM_END, table.subspan(40)).first, PLDM_SUCCESS);
+    EXPECT_EQ(setPart(2, 80, PLDM_END, table.subspan(80)).first, PLDM_SUCCESS);
+
+    auto part = getPart(1, 0, PLDM_GET_FIRSTPART);
+    ASSERT_EQ(part.completionCode, PLDM_SUCCESS);
+    EXPECT_EQ(part.data, stringTable);
+}
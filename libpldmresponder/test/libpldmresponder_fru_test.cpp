@@ -4,9 +4,14 @@
 
 #include <config.h>
 #include <libpldm/pdr.h>
+#include <libpldm/utils.h>
 
 #include <sdbusplus/message.hpp>
 
+#include <array>
+#include <tuple>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 TEST(FruParser, allScenarios)
@@ -182,3 +187,541 @@ TEST(FruImpl, entityByObjectPath)
     entityPtr = mockedFruHandler.getEntityByObjectPath(invalidIface);
     ASSERT_TRUE(!entityPtr);
 }
+
+class TestFruHotplug : public ::testing::Test
+{
+  protected:
+    TestFruHotplug() :
+        pdrRepo(pldm_pdr_init(), pldm_pdr_destroy),
+        entityTree(pldm_entity_association_tree_init(),
+                   pldm_entity_association_tree_destroy),
+        bmcEntityTree(pldm_entity_association_tree_init(),
+                      pldm_entity_association_tree_destroy),
+        fru("", "./fru_jsons/fru_master/fru_master.json", pdrRepo.get(),
+            entityTree.get(), bmcEntityTree.get())
+    {
+        fru.itemInterfaces = std::get<2>(fru.parser.inventoryLookup());
+        addObject(systemPath, "xyz.openbmc_project.Inventory.Item.System");
+        addObject(chassisPath, "xyz.openbmc_project.Inventory.Item.Chassis");
+        fru.addFru(chassisPath, fru.objects.at(chassisPath));
+    }
+
+    /** @brief Add an inventory object with the item interface and a part
+     *         number, present
+     */
+    void addObject(const std::string& path, const std::string& interface)
+    {
+        fru.objects[sdbusplus::message::object_path(path)] = {
+            {interface, {}},
+            {"xyz.openbmc_project.Inventory.Item", {{"Present", true}}},
+            {"xyz.openbmc_project.Inventory.Decorator.Asset",
+             {{"PartNumber", std::string("PN") + path.back()}}}};
+    }
+
+    void plug(const std::string& path)
+    {
+        addObject(path, "xyz.openbmc_project.Inventory.Item.Board");
+        fru.addFru(path, fru.objects.at(path));
+    }
+
+    void unplug(const std::string& path)
+    {
+        fru.removeFru(path);
+        fru.objects.erase(sdbusplus::message::object_path(path));
+    }
+
+    /** @brief Add the entity association PDRs, like buildFRUTable */
+    void addEntityAssociationPdrs()
+    {
+        ASSERT_EQ(pldm_entity_association_pdr_add(
+                      entityTree.get(), pdrRepo.get(), false, TERMINUS_HANDLE),
+                  0);
+        pldm_entity_association_tree_copy_root(entityTree.get(),
+                                               bmcEntityTree.get());
+    }
+
+    /** @brief Handle of the FRU record set PDR of an object */
+    uint32_t recordSetHandle(const std::string& path)
+    {
+        uint16_t terminusHandle = 0;
+        uint16_t entityType = 0;
+        uint16_t entityInstance = 0;
+        uint16_t containerId = 0;
+        auto record = pldm_pdr_fru_record_set_find_by_rsi(
+            pdrRepo.get(), fru.objToRSI.at(path), &terminusHandle,
+            &entityType, &entityInstance, &containerId);
+        return record ? pldm_pdr_get_record_handle(pdrRepo.get(), record) : 0;
+    }
+
+    /** @brief Check that the index of the repository finds every record */
+    void expectIndexed(const pldm::responder::pdr_utils::Repo& repo)
+    {
+        uint8_t* data = nullptr;
+        uint32_t size = 0;
+        uint32_t nextRecordHandle = 0;
+        auto record = pldm_pdr_find_record(pdrRepo.get(), 0, &data, &size,
+                                           &nextRecordHandle);
+        while (record)
+        {
+            pldm::responder::pdr_utils::PdrEntry entry{};
+            auto handle = pldm_pdr_get_record_handle(pdrRepo.get(), record);
+            EXPECT_EQ(repo.findRecord(handle, entry), record);
+            EXPECT_EQ(entry.data, data);
+            EXPECT_EQ(entry.size, size);
+            record = pldm_pdr_get_next_record(pdrRepo.get(), record, &data,
+                                              &size, &nextRecordHandle);
+        }
+    }
+
+    bool hasEntity(const std::string& path) const
+    {
+        return fru.objToEntityNode.contains(path);
+    }
+
+    bool isAssociated(const std::string& path) const
+    {
+        return fru.associatedEntityMap.contains(path);
+    }
+
+    bool hasRecords(const std::string& path) const
+    {
+        return fru.objToRSI.contains(path);
+    }
+
+    const std::vector<uint8_t>& table() const
+    {
+        return fru.table;
+    }
+
+    void removeRecords(const std::string& path)
+    {
+        fru.removeRecords(path);
+    }
+
+    void removeFru(const std::string& path)
+    {
+        fru.removeFru(path);
+    }
+
+    void reportPdrChanges()
+    {
+        fru.reportPdrChanges();
+    }
+
+    static constexpr auto systemPath = "/xyz/openbmc_project/inventory/system";
+    static constexpr auto chassisPath =
+        "/xyz/openbmc_project/inventory/system/chassis";
+    static constexpr auto board1Path =
+        "/xyz/openbmc_project/inventory/system/chassis/board1";
+    static constexpr auto board2Path =
+        "/xyz/openbmc_project/inventory/system/chassis/board2";
+
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo;
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        entityTree;
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        bmcEntityTree;
+    pldm::responder::FruImpl fru;
+};
+
+TEST_F(TestFruHotplug, removedRecordSetLeavesIndex)
+{
+    pldm::responder::pdr_utils::Repo repo(pdrRepo.get());
+    plug(board1Path);
+    auto board1Handle = recordSetHandle(board1Path);
+    ASSERT_NE(board1Handle, 0u);
+    expectIndexed(repo);
+
+    // The record count is the same once board2 replaces board1, only the
+    // invalidation tells the index that the records changed
+    unplug(board1Path);
+    plug(board2Path);
+    auto board2Handle = recordSetHandle(board2Path);
+    ASSERT_NE(board2Handle, 0u);
+
+    pldm::responder::pdr_utils::PdrEntry entry{};
+    EXPECT_EQ(repo.findRecord(board1Handle, entry), nullptr);
+    EXPECT_NE(repo.findRecord(board2Handle, entry), nullptr);
+    expectIndexed(repo);
+}
+
+TEST_F(TestFruHotplug, removedContainedEntityLeavesIndex)
+{
+    pldm::responder::pdr_utils::Repo repo(pdrRepo.get());
+    plug(board1Path);
+    plug(board2Path);
+    addEntityAssociationPdrs();
+    auto count = pldm_pdr_get_record_count(pdrRepo.get());
+    expectIndexed(repo);
+
+    unplug(board1Path);
+    EXPECT_LT(pldm_pdr_get_record_count(pdrRepo.get()), count);
+    expectIndexed(repo);
+
+    unplug(board2Path);
+    expectIndexed(repo);
+}
+
+class TestFruHandler : public ::testing::Test
+{
+  protected:
+    TestFruHandler() :
+        pdrRepo(pldm_pdr_init(), pldm_pdr_destroy),
+        entityTree(pldm_entity_association_tree_init(),
+                   pldm_entity_association_tree_destroy),
+        bmcEntityTree(pldm_entity_association_tree_init(),
+                      pldm_entity_association_tree_destroy),
+        handler("", "./fru_jsons/fru_master/fru_master.json", pdrRepo.get(),
+                entityTree.get(), bmcEntityTree.get())
+    {
+        auto& fru = handler.impl;
+        fru.itemInterfaces = std::get<2>(fru.parser.inventoryLookup());
+        addObject(systemPath, "xyz.openbmc_project.Inventory.Item.System");
+        addObject(chassisPath, "xyz.openbmc_project.Inventory.Item.Chassis");
+        addObject(boardPath, "xyz.openbmc_project.Inventory.Item.Board");
+        for (const auto& [path, interfaces] : fru.objects)
+        {
+            fru.addFru(path.str, interfaces);
+        }
+        // The table is built from the objects above, not from D-Bus
+        fru.isBuilt = true;
+    }
+
+    /** @brief Add an inventory object with the item interface and a part
+     *         number, present
+     */
+    void addObject(const std::string& path, const std::string& interface)
+    {
+        handler.impl.objects[sdbusplus::message::object_path(path)] = {
+            {interface, {}},
+            {"xyz.openbmc_project.Inventory.Item", {{"Present", true}}},
+            {"xyz.openbmc_project.Inventory.Decorator.Asset",
+             {{"PartNumber", std::string("PN") + path.back()}}}};
+    }
+
+    /** @brief Send GetFRURecordTable, the part is appended to table
+     *
+     *  @return completion code, next transfer handle and transfer flag
+     */
+    std::tuple<uint8_t, uint32_t, uint8_t> getPart(
+        uint32_t transferHandle, uint8_t transferOpFlag,
+        std::vector<uint8_t>& table)
+    {
+        std::array<uint8_t,
+                   sizeof(pldm_msg_hdr) + PLDM_GET_FRU_RECORD_TABLE_REQ_BYTES>
+            requestMsg{};
+        auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+        EXPECT_EQ(encode_get_fru_record_table_req(
+                      0, transferHandle, transferOpFlag, request,
+                      PLDM_GET_FRU_RECORD_TABLE_REQ_BYTES),
+                  PLDM_SUCCESS);
+        auto response = handler.getFRURecordTable(
+            tid, request, PLDM_GET_FRU_RECORD_TABLE_REQ_BYTES);
+
+        uint8_t cc = 0;
+        uint32_t nextTransferHandle = 0;
+        uint8_t transferFlag = 0;
+        std::vector<uint8_t> data(response.size());
+        size_t length = 0;
+        auto rc = decode_get_fru_record_table_resp(
+            reinterpret_cast<pldm_msg*>(response.data()),
+            response.size() - sizeof(pldm_msg_hdr), &cc, &nextTransferHandle,
+            &transferFlag, data.data(), &length);
+        if (rc != PLDM_SUCCESS || cc != PLDM_SUCCESS)
+        {
+            return {cc ? cc : rc, 0, 0};
+        }
+        table.insert(table.end(), data.begin(), data.begin() + length);
+        return {cc, nextTransferHandle, transferFlag};
+    }
+
+    /** @brief GetFRURecordByOption data filtered from the whole table, with
+     *         the pad bytes and the checksum
+     */
+    std::vector<uint8_t> recordsOf(uint16_t recordSetIdentifier,
+                                   uint8_t recordType, uint8_t fieldType)
+    {
+        const auto& table = handler.impl.table;
+        std::vector<uint8_t> records(table.size());
+        size_t size = table.size();
+        EXPECT_EQ(get_fru_record_by_option(table.data(), table.size(),
+                                           records.data(), &size,
+                                           recordSetIdentifier, recordType,
+                                           fieldType),
+                  PLDM_SUCCESS);
+        records.resize(size + pldm::utils::getNumPadBytes(size), 0);
+        auto checksum = crc32(records.data(), records.size());
+        auto bytes = reinterpret_cast<const uint8_t*>(&checksum);
+        records.insert(records.end(), bytes, bytes + sizeof(checksum));
+        return records;
+    }
+
+    void setTransferSize(size_t size)
+    {
+        handler.tableTransferSize = size;
+    }
+
+    pldm::responder::FruImpl& fru()
+    {
+        return handler.impl;
+    }
+
+    uint16_t recordSetOf(const std::string& path) const
+    {
+        return handler.impl.objToRSI.at(path);
+    }
+
+    size_t numCachedOptions() const
+    {
+        return handler.impl.recordsByOption.size();
+    }
+
+    void plug(const std::string& path)
+    {
+        addObject(path, "xyz.openbmc_project.Inventory.Item.Board");
+        handler.impl.addFru(path, handler.impl.objects.at(path));
+    }
+
+    void unplug(const std::string& path)
+    {
+        handler.impl.removeFru(path);
+    }
+
+    static constexpr pldm_tid_t tid = 1;
+    static constexpr auto systemPath = "/xyz/openbmc_project/inventory/system";
+    static constexpr auto chassisPath =
+        "/xyz/openbmc_project/inventory/system/chassis";
+    static constexpr auto boardPath =
+        "/xyz/openbmc_project/inventory/system/chassis/board1";
+
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo;
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        entityTree;
+    std::unique_ptr<pldm_entity_association_tree,
+                    decltype(&pldm_entity_association_tree_destroy)>
+        bmcEntityTree;
+    pldm::responder::fru::Handler handler;
+};
+
+TEST_F(TestFruHandler, tableSentInParts)
+{
+    std::vector<uint8_t> whole;
+    auto [cc, next, flag] = getPart(0, PLDM_GET_FIRSTPART, whole);
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+    ASSERT_EQ(flag, PLDM_START_AND_END);
+    ASSERT_GT(whole.size(), 16u);
+
+    setTransferSize(16);
+    std::vector<uint8_t> table;
+    std::tie(cc, next, flag) = getPart(0, PLDM_GET_FIRSTPART, table);
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+    EXPECT_EQ(flag, PLDM_START);
+    EXPECT_EQ(next, 16u);
+
+    while (flag != PLDM_END)
+    {
+        ASSERT_EQ(next, table.size());
+        std::tie(cc, next, flag) = getPart(next, PLDM_GET_NEXTPART, table);
+        ASSERT_EQ(cc, PLDM_SUCCESS);
+    }
+    EXPECT_EQ(table, whole);
+
+    // The transfer ended
+    EXPECT_EQ(std::get<0>(getPart(16, PLDM_GET_NEXTPART, table)),
+              PLDM_FRU_INVALID_DATA_TRANSFER_HANDLE);
+}
+
+TEST_F(TestFruHandler, nextPartOffsetChecked)
+{
+    setTransferSize(8);
+    std::vector<uint8_t> table;
+    auto [cc, next, flag] = getPart(0, PLDM_GET_FIRSTPART, table);
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+    ASSERT_EQ(flag, PLDM_START);
+
+    // Only the offset of the next part is taken
+    std::vector<uint8_t> other;
+    EXPECT_EQ(std::get<0>(getPart(1, PLDM_GET_NEXTPART, other)),
+              PLDM_FRU_INVALID_DATA_TRANSFER_HANDLE);
+    EXPECT_EQ(std::get<0>(getPart(next + 1, PLDM_GET_NEXTPART, other)),
+              PLDM_FRU_INVALID_DATA_TRANSFER_HANDLE);
+    EXPECT_EQ(std::get<0>(getPart(next * 2, PLDM_GET_NEXTPART, other)),
+              PLDM_FRU_INVALID_DATA_TRANSFER_HANDLE);
+    EXPECT_TRUE(other.empty());
+
+    std::vector<uint8_t> part;
+    std::tie(cc, next, flag) = getPart(8, PLDM_GET_NEXTPART, part);
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+    EXPECT_EQ(next, 16u);
+
+    // The part last sent is sent again on a retry, not the one before it
+    std::vector<uint8_t> retry;
+    std::tie(cc, next, flag) = getPart(8, PLDM_GET_NEXTPART, retry);
+    ASSERT_EQ(cc, PLDM_SUCCESS);
+    EXPECT_EQ(next, 16u);
+    EXPECT_EQ(retry, part);
+    EXPECT_EQ(std::get<0>(getPart(0, PLDM_GET_NEXTPART, retry)),
+              PLDM_FRU_INVALID_DATA_TRANSFER_HANDLE);
+}
+
+TEST_F(TestFruHandler, recordsByOptionFromIndex)
+{
+    auto boardSet = recordSetOf(boardPath);
+    auto chassisSet = recordSetOf(chassisPath);
+
+    std::vector<uint8_t> records;
+    ASSERT_EQ(fru().getFRURecordByOption(records, 0, boardSet, 0, 0),
+              PLDM_SUCCESS);
+    EXPECT_EQ(records, recordsOf(boardSet, 0, 0));
+
+    ASSERT_EQ(fru().getFRURecordByOption(records, 0, chassisSet,
+                                         PLDM_FRU_RECORD_TYPE_GENERAL, 3),
+              PLDM_SUCCESS);
+    EXPECT_EQ(records, recordsOf(chassisSet, PLDM_FRU_RECORD_TYPE_GENERAL, 3));
+
+    EXPECT_EQ(fru().getFRURecordByOption(records, 0, boardSet,
+                                         PLDM_FRU_RECORD_TYPE_OEM, 0),
+              PLDM_FRU_DATA_STRUCTURE_TABLE_UNAVAILABLE);
+    EXPECT_EQ(fru().getFRURecordByOption(records, 0, 0xffff, 0, 0),
+              PLDM_FRU_DATA_STRUCTURE_TABLE_UNAVAILABLE);
+}
+
+TEST_F(TestFruHandler, recordsByOptionCacheDroppedOnChange)
+{
+    auto boardSet = recordSetOf(boardPath);
+
+    std::vector<uint8_t> records;
+    ASSERT_EQ(fru().getFRURecordByOption(records, 0, boardSet, 0, 0),
+              PLDM_SUCCESS);
+    EXPECT_EQ(numCachedOptions(), 1u);
+    std::vector<uint8_t> cached;
+    ASSERT_EQ(fru().getFRURecordByOption(cached, 0, boardSet, 0, 0),
+              PLDM_SUCCESS);
+    EXPECT_EQ(cached, records);
+
+    // The records of a new set are found once the table changed
+    constexpr auto board2Path =
+        "/xyz/openbmc_project/inventory/system/chassis/board2";
+    plug(board2Path);
+    EXPECT_EQ(numCachedOptions(), 0u);
+    auto board2Set = recordSetOf(board2Path);
+    ASSERT_EQ(fru().getFRURecordByOption(records, 0, board2Set, 0, 0),
+              PLDM_SUCCESS);
+    EXPECT_EQ(records, recordsOf(board2Set, 0, 0));
+
+    unplug(boardPath);
+    EXPECT_EQ(fru().getFRURecordByOption(records, 0, boardSet, 0, 0),
+              PLDM_FRU_DATA_STRUCTURE_TABLE_UNAVAILABLE);
+}
+
+TEST_F(TestFruHotplug, pluggedFruGetsRecords)
+{
+    auto numRecords = fru.numRecords();
+    auto numRSI = fru.numRSI();
+    plug(board1Path);
+
+    EXPECT_TRUE(hasEntity(board1Path));
+    EXPECT_TRUE(isAssociated(board1Path));
+    EXPECT_NE(recordSetHandle(board1Path), 0u);
+    EXPECT_GT(fru.numRecords(), numRecords);
+    EXPECT_EQ(fru.numRSI(), numRSI + 1);
+}
+
+TEST_F(TestFruHotplug, unpluggedFruLeavesNothing)
+{
+    auto records = table();
+    auto numRecords = fru.numRecords();
+    auto numRSI = fru.numRSI();
+    auto count = pldm_pdr_get_record_count(pdrRepo.get());
+
+    plug(board1Path);
+    unplug(board1Path);
+
+    EXPECT_FALSE(hasEntity(board1Path));
+    EXPECT_FALSE(isAssociated(board1Path));
+    EXPECT_FALSE(hasRecords(board1Path));
+    EXPECT_EQ(table(), records);
+    EXPECT_EQ(fru.numRecords(), numRecords);
+    EXPECT_EQ(fru.numRSI(), numRSI);
+    EXPECT_EQ(pldm_pdr_get_record_count(pdrRepo.get()), count);
+}
+
+TEST_F(TestFruHotplug, repluggedFruGetsRecordsAgain)
+{
+    plug(board1Path);
+    auto recordsSize = table().size();
+    auto numRecords = fru.numRecords();
+    unplug(board1Path);
+    plug(board1Path);
+
+    EXPECT_TRUE(isAssociated(board1Path));
+    EXPECT_NE(recordSetHandle(board1Path), 0u);
+    EXPECT_EQ(table().size(), recordsSize);
+    EXPECT_EQ(fru.numRecords(), numRecords);
+}
+
+TEST_F(TestFruHotplug, removedRecordsCompactTable)
+{
+    auto chassisRecords = table();
+    plug(board1Path);
+    auto board1Size = table().size() - chassisRecords.size();
+    plug(board2Path);
+    auto board2Records = std::vector<uint8_t>(
+        table().begin() + chassisRecords.size() + board1Size,
+        table().end());
+    ASSERT_FALSE(board2Records.empty());
+
+    // The records before and after those of board1 close the gap
+    removeRecords(board1Path);
+    auto expected = chassisRecords;
+    expected.insert(expected.end(), board2Records.begin(),
+                    board2Records.end());
+    EXPECT_EQ(table(), expected);
+    EXPECT_FALSE(hasRecords(board1Path));
+    EXPECT_TRUE(hasRecords(board2Path));
+}
+
+TEST_F(TestFruHotplug, removedFruKeepsEntityContainingOthers)
+{
+    plug(board1Path);
+    removeFru(chassisPath);
+
+    // The chassis records are gone, its entity still contains board1
+    EXPECT_FALSE(hasRecords(chassisPath));
+    EXPECT_FALSE(isAssociated(chassisPath));
+    EXPECT_TRUE(hasEntity(chassisPath));
+    EXPECT_TRUE(hasEntity(board1Path));
+
+    unplug(board1Path);
+    EXPECT_TRUE(hasEntity(chassisPath));
+    EXPECT_FALSE(hasEntity(board1Path));
+}
+
+TEST_F(TestFruHotplug, hotplugReportsPdrChanges)
+{
+    // The PDRs of the chassis were fetched with the table
+    reportPdrChanges();
+    std::vector<pldm::responder::pdr_utils::PdrChanges> reports;
+    fru.setPdrChangedHandler(
+        [&reports](pldm::responder::pdr_utils::PdrChanges&& changes) {
+            reports.push_back(std::move(changes));
+        });
+
+    plug(board1Path);
+    auto handle = recordSetHandle(board1Path);
+    reportPdrChanges();
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_EQ(reports[0].added, std::vector<uint32_t>{handle});
+
+    // Nothing changed, nothing is reported
+    reportPdrChanges();
+    EXPECT_EQ(reports.size(), 1u);
+
+    unplug(board1Path);
+    reportPdrChanges();
+    ASSERT_EQ(reports.size(), 2u);
+    EXPECT_EQ(reports[1].deleted, std::vector<uint32_t>{handle});
+}
@@ -7,6 +7,8 @@
 #include <sdbusplus/test/sdbus_mock.hpp>
 #include <sdeventplus/event.hpp>
 
+#include <stdexcept>
+
 #include <gtest/gtest.h>
 
 using namespace pldm::responder;
@@ -17,6 +19,7 @@ using namespace pldm::responder::pdr_utils;
 using ::testing::_;
 using ::testing::Return;
 using ::testing::StrEq;
+using ::testing::Throw;
 
 TEST(GeneratePDRByStateSensor, testGoodJson)
 {
@@ -65,6 +68,32 @@ TEST(GeneratePDRByStateSensor, testGoodJson)
     ASSERT_EQ(dbusMappings[0].interface, "xyz.openbmc_project.Foo.Bar");
     ASSERT_EQ(dbusMappings[0].propertyName, "propertyName");
     ASSERT_EQ(dbusMappings[0].propertyType, "string");
+    EXPECT_FALSE(handler.isPDRBuildPartial());
+
+    pldm_pdr_destroy(inPDRRepo);
+    pldm_pdr_destroy(outPDRRepo);
+}
+
+TEST(GeneratePDRByStateSensor, testMissingDbusObject)
+{
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
+        .Times(1)
+        .WillRepeatedly(Throw(std::runtime_error("no such object")));
+
+    auto inPDRRepo = pldm_pdr_init();
+    auto outPDRRepo = pldm_pdr_init();
+    Repo outRepo(outPDRRepo);
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, 0, nullptr, "./pdr_jsons/state_sensor/good",
+                    inPDRRepo, nullptr, nullptr, nullptr, nullptr, nullptr,
+                    event);
+    Repo inRepo(inPDRRepo);
+    getRepoByType(inRepo, outRepo, PLDM_STATE_SENSOR_PDR);
+
+    // The PDR is skipped, the build must not be stored in the PDR snapshot
+    EXPECT_EQ(outRepo.getRecordCount(), 0);
+    EXPECT_TRUE(handler.isPDRBuildPartial());
 
     pldm_pdr_destroy(inPDRRepo);
     pldm_pdr_destroy(outPDRRepo);
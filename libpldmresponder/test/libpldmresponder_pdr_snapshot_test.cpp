@@ -0,0 +1,107 @@
+#include "libpldmresponder/pdr_snapshot.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using namespace pldm::responder;
+
+class PdrSnapshotTest : public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+        char tmpdir[] = "/tmp/pldm_pdr_snapshot.XXXXXX";
+        dir = fs::path(mkdtemp(tmpdir));
+
+        data.pdrs.emplace_back(std::vector<uint8_t>(16, 0x11));
+        data.pdrs.emplace_back(std::vector<uint8_t>(24, 0x22));
+        data.nextSensorId = 3;
+        data.nextEffecterId = 5;
+
+        pdr_utils::StatestoDbusVal states{
+            {1, std::string("xyz.openbmc_project.State.On")},
+            {2, uint8_t(7)},
+            {3, std::vector<std::string>{"a", "b"}}};
+        data.effecterDbusObjMaps[1] = {
+            {{"/foo/bar", "xyz.openbmc_project.Foo", "Bar", "string"}},
+            {states}};
+        data.sensorDbusObjMaps[2] = {
+            {{"/foo/baz", "xyz.openbmc_project.Foo", "Baz", "bool"}},
+            {{{0, false}, {1, true}}}};
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(dir);
+    }
+
+    fs::path dir;
+    PdrSnapshotData data;
+};
+
+TEST_F(PdrSnapshotTest, storeLoad)
+{
+    PdrSnapshot snapshot(dir / "snapshot");
+    EXPECT_FALSE(snapshot.load(1).has_value());
+
+    EXPECT_TRUE(snapshot.store(1, data));
+    auto loaded = snapshot.load(1);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(data.pdrs, loaded->pdrs);
+    EXPECT_EQ(3, loaded->nextSensorId);
+    EXPECT_EQ(5, loaded->nextEffecterId);
+
+    ASSERT_EQ(1, loaded->effecterDbusObjMaps.size());
+    const auto& [mappings, valMaps] = loaded->effecterDbusObjMaps.at(1);
+    ASSERT_EQ(1, mappings.size());
+    EXPECT_EQ("/foo/bar", mappings[0].objectPath);
+    EXPECT_EQ("Bar", mappings[0].propertyName);
+    EXPECT_EQ(std::get<0>(data.effecterDbusObjMaps.at(1)).size(),
+              mappings.size());
+    EXPECT_EQ(std::get<1>(data.effecterDbusObjMaps.at(1)), valMaps);
+    EXPECT_EQ(std::get<1>(data.sensorDbusObjMaps.at(2)),
+              std::get<1>(loaded->sensorDbusObjMaps.at(2)));
+
+    /* Stored for other inputs */
+    EXPECT_FALSE(snapshot.load(2).has_value());
+}
+
+TEST_F(PdrSnapshotTest, corruptedSnapshot)
+{
+    auto path = dir / "snapshot";
+    PdrSnapshot snapshot(path);
+    ASSERT_TRUE(snapshot.store(1, data));
+
+    fs::resize_file(path, fs::file_size(path) - 1);
+    EXPECT_FALSE(snapshot.load(1).has_value());
+
+    std::ofstream(path, std::ios::trunc) << "garbage";
+    EXPECT_FALSE(snapshot.load(1).has_value());
+}
+
+TEST_F(PdrSnapshotTest, computeKey)
+{
+    auto file = dir / "pdr.json";
+    std::ofstream(file) << R"({"effecterPDRs": []})";
+    auto key = PdrSnapshot::computeKey({file}, "system1");
+    EXPECT_EQ(key, PdrSnapshot::computeKey({file}, "system1"));
+    EXPECT_NE(key, PdrSnapshot::computeKey({file}, "system2"));
+    EXPECT_NE(key, PdrSnapshot::computeKey({}, "system1"));
+
+    std::ofstream(file) << R"({"sensorPDRs": []})";
+    EXPECT_NE(key, PdrSnapshot::computeKey({file}, "system1"));
+}
+
+TEST_F(PdrSnapshotTest, disabled)
+{
+    PdrSnapshot snapshot;
+    EXPECT_FALSE(snapshot.enabled());
+    EXPECT_FALSE(snapshot.store(1, data));
+    EXPECT_FALSE(snapshot.load(1).has_value());
+}
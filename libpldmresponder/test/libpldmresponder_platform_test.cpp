@@ -223,6 +223,278 @@ TEST(getPDR, testFindPDR)
     pldm_pdr_destroy(pdrRepo);
 }
 
+TEST(Repo, indexedLookup)
+{
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+
+    auto addSensorPDR = [pdrRepo](uint16_t sensorId, bool isRemote) {
+        std::vector<uint8_t> pdr(sizeof(pldm_state_sensor_pdr));
+        auto sensorPdr = reinterpret_cast<pldm_state_sensor_pdr*>(pdr.data());
+        sensorPdr->hdr.type = PLDM_STATE_SENSOR_PDR;
+        sensorPdr->hdr.length = pdr.size() - sizeof(pldm_pdr_hdr);
+        sensorPdr->sensor_id = sensorId;
+        uint32_t handle = 0;
+        EXPECT_EQ(pldm_pdr_add(pdrRepo, pdr.data(), pdr.size(), isRemote, 1,
+                               &handle),
+                  0);
+        return handle;
+    };
+    auto sensorId = [](const PdrEntry& pdrEntry) {
+        return reinterpret_cast<pldm_state_sensor_pdr*>(pdrEntry.data)
+            ->sensor_id;
+    };
+
+    auto first = addSensorPDR(1, false);
+    auto second = addSensorPDR(2, false);
+
+    PdrEntry pdrEntry{};
+    ASSERT_NE(repo.findRecord(second, pdrEntry), nullptr);
+    EXPECT_EQ(sensorId(pdrEntry), 2);
+    EXPECT_EQ(pdrEntry.handle.nextRecordHandle, 0);
+    ASSERT_NE(repo.findRecord(0, pdrEntry), nullptr);
+    EXPECT_EQ(pdrEntry.handle.nextRecordHandle, second);
+    EXPECT_EQ(repo.findRecord(second + 1, pdrEntry), nullptr);
+
+    ASSERT_NE(repo.findSensorOrEffecter(PLDM_STATE_SENSOR_PDR, 1, pdrEntry),
+              nullptr);
+    EXPECT_EQ(pdrEntry.handle.nextRecordHandle, second);
+    EXPECT_EQ(repo.findSensorOrEffecter(PLDM_STATE_EFFECTER_PDR, 1, pdrEntry),
+              nullptr);
+    EXPECT_EQ(repo.findSensorOrEffecter(PLDM_STATE_SENSOR_PDR, 3, pdrEntry),
+              nullptr);
+
+    // Records added after the index was built
+    auto remote = addSensorPDR(3, true);
+    ASSERT_NE(repo.findSensorOrEffecter(PLDM_STATE_SENSOR_PDR, 3, pdrEntry),
+              nullptr);
+    ASSERT_NE(repo.findRecord(second, pdrEntry), nullptr);
+    EXPECT_EQ(pdrEntry.handle.nextRecordHandle, remote);
+
+    // Records removed and replaced, leaving the same count
+    pldm_pdr_remove_remote_pdrs(pdrRepo);
+    Repo::invalidateIndex(pdrRepo);
+    addSensorPDR(4, true);
+    EXPECT_EQ(repo.findSensorOrEffecter(PLDM_STATE_SENSOR_PDR, 3, pdrEntry),
+              nullptr);
+    ASSERT_NE(repo.findSensorOrEffecter(PLDM_STATE_SENSOR_PDR, 4, pdrEntry),
+              nullptr);
+    EXPECT_EQ(sensorId(pdrEntry), 4);
+    ASSERT_NE(repo.findRecord(first, pdrEntry), nullptr);
+    EXPECT_EQ(pdrEntry.handle.nextRecordHandle, second);
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
+TEST(Repo, stateSetLookup)
+{
+    auto pdrRepo = pldm_pdr_init();
+    Repo repo(pdrRepo);
+
+    // State sensor PDR with composite sensors of one state each
+    auto addSensorPDR = [pdrRepo](uint16_t sensorId, uint16_t entityType,
+                                  std::vector<uint16_t> stateSetIds,
+                                  bool isRemote) {
+        std::vector<uint8_t> pdr(offsetof(pldm_state_sensor_pdr,
+                                          possible_states) +
+                                 stateSetIds.size() * 4);
+        auto sensorPdr = reinterpret_cast<pldm_state_sensor_pdr*>(pdr.data());
+        sensorPdr->hdr.type = PLDM_STATE_SENSOR_PDR;
+        sensorPdr->hdr.length = pdr.size() - sizeof(pldm_pdr_hdr);
+        sensorPdr->sensor_id = sensorId;
+        sensorPdr->entity_type = entityType;
+        sensorPdr->composite_sensor_count = stateSetIds.size();
+        auto possibleStates = sensorPdr->possible_states;
+        for (auto stateSetId : stateSetIds)
+        {
+            auto states =
+                reinterpret_cast<state_sensor_possible_states*>(possibleStates);
+            states->state_set_id = stateSetId;
+            states->possible_states_size = 1;
+            possibleStates += 4;
+        }
+        uint32_t handle = 0;
+        EXPECT_EQ(pldm_pdr_add(pdrRepo, pdr.data(), pdr.size(), isRemote, 1,
+                               &handle),
+                  0);
+        return handle;
+    };
+
+    addSensorPDR(1, PLDM_ENTITY_SYSTEM_CHASSIS, {10, 129}, false);
+
+    auto match = repo.findStateSet(PLDM_STATE_SENSOR_PDR,
+                                   PLDM_ENTITY_SYSTEM_CHASSIS, 129);
+    ASSERT_TRUE(match);
+    EXPECT_EQ(match->id, 1);
+    EXPECT_EQ(match->compositeIndex, 1);
+    EXPECT_FALSE(repo.findStateSet(PLDM_STATE_EFFECTER_PDR,
+                                   PLDM_ENTITY_SYSTEM_CHASSIS, 129));
+    EXPECT_FALSE(
+        repo.findStateSet(PLDM_STATE_SENSOR_PDR, PLDM_ENTITY_SYSTEM_CHASSIS, 11));
+
+    // The last match wins, the cached result is dropped on changes
+    addSensorPDR(2, PLDM_ENTITY_SYSTEM_CHASSIS, {129}, true);
+    match = repo.findStateSet(PLDM_STATE_SENSOR_PDR, PLDM_ENTITY_SYSTEM_CHASSIS,
+                              129);
+    ASSERT_TRUE(match);
+    EXPECT_EQ(match->id, 2);
+    EXPECT_EQ(match->compositeIndex, 0);
+    const auto& pdrs = repo.findStateSetPdrs(PLDM_STATE_SENSOR_PDR,
+                                             PLDM_ENTITY_SYSTEM_CHASSIS, 129);
+    ASSERT_EQ(pdrs.size(), 2);
+    EXPECT_EQ(
+        reinterpret_cast<const pldm_state_sensor_pdr*>(pdrs[1].data())
+            ->sensor_id,
+        2);
+
+    pldm_pdr_remove_remote_pdrs(pdrRepo);
+    Repo::invalidateIndex(pdrRepo);
+    match = repo.findStateSet(PLDM_STATE_SENSOR_PDR, PLDM_ENTITY_SYSTEM_CHASSIS,
+                              129);
+    ASSERT_TRUE(match);
+    EXPECT_EQ(match->id, 1);
+
+    // A miss is not kept, the PDR is then updated in place
+    EXPECT_FALSE(
+        repo.findStateSet(PLDM_STATE_SENSOR_PDR, PLDM_ENTITY_SYSTEM_CHASSIS, 11));
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t nextRecordHandle = 0;
+    ASSERT_NE(pldm_pdr_find_record(pdrRepo, 0, &data, &size, &nextRecordHandle),
+              nullptr);
+    auto sensorPdr = reinterpret_cast<pldm_state_sensor_pdr*>(data);
+    reinterpret_cast<state_sensor_possible_states*>(sensorPdr->possible_states)
+        ->state_set_id = 11;
+    match = repo.findStateSet(PLDM_STATE_SENSOR_PDR, PLDM_ENTITY_SYSTEM_CHASSIS,
+                              11);
+    ASSERT_TRUE(match);
+    EXPECT_EQ(match->compositeIndex, 0);
+
+    // The kept matches are dropped once the PDRs updated in place
+    sensorPdr->entity_type = PLDM_ENTITY_PROC;
+    Repo::invalidateIndex(pdrRepo);
+    EXPECT_FALSE(
+        repo.findStateSet(PLDM_STATE_SENSOR_PDR, PLDM_ENTITY_SYSTEM_CHASSIS, 11));
+    EXPECT_TRUE(
+        repo.findStateSet(PLDM_STATE_SENSOR_PDR, PLDM_ENTITY_PROC, 129));
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
+TEST(PdrChangeLog, perRecordChanges)
+{
+    auto pdrRepo = pldm_pdr_init();
+
+    auto addPDR = [pdrRepo](uint8_t type, uint8_t value, bool isRemote) {
+        std::vector<uint8_t> pdr(sizeof(pldm_pdr_hdr) + 1, value);
+        auto hdr = reinterpret_cast<pldm_pdr_hdr*>(pdr.data());
+        hdr->type = type;
+        hdr->length = 1;
+        uint32_t handle = 0;
+        EXPECT_EQ(pldm_pdr_add(pdrRepo, pdr.data(), pdr.size(), isRemote, 1,
+                               &handle),
+                  0);
+        return handle;
+    };
+
+    auto local = addPDR(PLDM_PDR_ENTITY_ASSOCIATION, 1, false);
+    auto first = addPDR(PLDM_PDR_ENTITY_ASSOCIATION, 2, true);
+    addPDR(PLDM_STATE_SENSOR_PDR, 3, true);
+
+    PdrChangeLog changeLog;
+    auto changes = changeLog.update(pdrRepo, {PLDM_PDR_ENTITY_ASSOCIATION},
+                                    PdrOrigin::remote);
+    EXPECT_EQ(changes.added, std::vector<RecordHandle>{first});
+    EXPECT_TRUE(changes.deleted.empty());
+    EXPECT_TRUE(changes.modified.empty());
+    EXPECT_EQ(changeLog.version(), 1);
+
+    // The local records are tracked apart
+    PdrChangeLog localChangeLog;
+    EXPECT_EQ(localChangeLog
+                  .update(pdrRepo, {PLDM_PDR_ENTITY_ASSOCIATION},
+                          PdrOrigin::local)
+                  .added,
+              std::vector<RecordHandle>{local});
+
+    // No change, no new version
+    changes = changeLog.update(pdrRepo, {PLDM_PDR_ENTITY_ASSOCIATION},
+                               PdrOrigin::remote);
+    EXPECT_TRUE(changes.empty());
+    EXPECT_EQ(changeLog.version(), 1);
+
+    // The remote records are replaced: one with the same handle and new
+    // content, one new
+    pldm_pdr_remove_remote_pdrs(pdrRepo);
+    uint32_t handle = first;
+    std::vector<uint8_t> pdr(sizeof(pldm_pdr_hdr) + 1, 4);
+    auto hdr = reinterpret_cast<pldm_pdr_hdr*>(pdr.data());
+    hdr->record_handle = first;
+    hdr->type = PLDM_PDR_ENTITY_ASSOCIATION;
+    hdr->length = 1;
+    ASSERT_EQ(pldm_pdr_add(pdrRepo, pdr.data(), pdr.size(), true, 1, &handle),
+              0);
+    auto second = addPDR(PLDM_PDR_ENTITY_ASSOCIATION, 5, true);
+
+    changes = changeLog.update(pdrRepo, {PLDM_PDR_ENTITY_ASSOCIATION},
+                               PdrOrigin::remote);
+    EXPECT_EQ(changes.added, std::vector<RecordHandle>{second});
+    EXPECT_TRUE(changes.deleted.empty());
+    EXPECT_EQ(changes.modified, std::vector<RecordHandle>{first});
+    EXPECT_EQ(changeLog.version(), 2);
+
+    pldm_pdr_remove_remote_pdrs(pdrRepo);
+    changes = changeLog.update(pdrRepo, {PLDM_PDR_ENTITY_ASSOCIATION},
+                               PdrOrigin::remote);
+    EXPECT_TRUE(changes.added.empty());
+    EXPECT_EQ(changes.deleted, (std::vector<RecordHandle>{first, second}));
+    EXPECT_EQ(changeLog.version(), 3);
+
+    // All the types, local records included
+    changeLog.reset();
+    changes = changeLog.update(pdrRepo, {}, PdrOrigin::any);
+    EXPECT_EQ(changes.added, std::vector<RecordHandle>{local});
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
+TEST(PdrChangeLog, commitAfterAcknowledge)
+{
+    auto pdrRepo = pldm_pdr_init();
+    std::vector<uint8_t> pdr(sizeof(pldm_pdr_hdr) + 1, 1);
+    auto hdr = reinterpret_cast<pldm_pdr_hdr*>(pdr.data());
+    hdr->type = PLDM_PDR_ENTITY_ASSOCIATION;
+    hdr->length = 1;
+    uint32_t handle = 0;
+    ASSERT_EQ(pldm_pdr_add(pdrRepo, pdr.data(), pdr.size(), true, 1, &handle),
+              0);
+
+    PdrChangeLog changeLog;
+    auto lost = changeLog.diff(pdrRepo, {}, PdrOrigin::remote);
+    EXPECT_EQ(lost.added, std::vector<RecordHandle>{handle});
+    EXPECT_EQ(changeLog.version(), 0);
+
+    // The first event was not acknowledged, the change is reported again
+    auto changes = changeLog.diff(pdrRepo, {}, PdrOrigin::remote);
+    EXPECT_EQ(changes.added, std::vector<RecordHandle>{handle});
+    EXPECT_TRUE(changeLog.commit(changes));
+    EXPECT_EQ(changeLog.version(), 1);
+    EXPECT_TRUE(changeLog.diff(pdrRepo, {}, PdrOrigin::remote).empty());
+
+    // A late acknowledge of the older event is dropped
+    EXPECT_FALSE(changeLog.commit(lost));
+    EXPECT_EQ(changeLog.version(), 1);
+
+    // The changes computed before a reset are stale
+    changes = changeLog.diff(pdrRepo, {}, PdrOrigin::remote);
+    changeLog.reset();
+    EXPECT_FALSE(changeLog.commit(changes));
+    EXPECT_EQ(changeLog.diff(pdrRepo, {}, PdrOrigin::remote).added,
+              std::vector<RecordHandle>{handle});
+
+    pldm_pdr_destroy(pdrRepo);
+}
+
 TEST(setStateEffecterStatesHandler, testGoodRequest)
 {
     std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
@@ -271,6 +543,43 @@ TEST(setStateEffecterStatesHandler, testGoodRequest)
     pldm_pdr_destroy(outPDRRepo);
 }
 
+TEST(setStateEffecterStates, fireAndForgetAnsweredFirst)
+{
+    MockdBusHandler mockedUtils;
+    EXPECT_CALL(mockedUtils, getService(StrEq("/foo/bar"), _))
+        .WillRepeatedly(Return("foo.bar"));
+
+    auto inPDRRepo = pldm_pdr_init();
+    auto event = sdeventplus::Event::get_default();
+    Handler handler(&mockedUtils, 0, nullptr,
+                    "./pdr_jsons/state_effecter/fire_and_forget", inPDRRepo,
+                    nullptr, nullptr, nullptr, nullptr, nullptr, event);
+
+    std::array<uint8_t,
+               sizeof(pldm_msg_hdr) + PLDM_SET_STATE_EFFECTER_STATES_REQ_BYTES>
+        requestMsg{};
+    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    std::array<set_effecter_state_field, 8> stateField{};
+    stateField[0] = {PLDM_REQUEST_SET, 1};
+    ASSERT_EQ(encode_set_state_effecter_states_req(0, 0x1, 1,
+                                                   stateField.data(), request),
+              PLDM_SUCCESS);
+
+    std::vector<pldm::Response> responses;
+    handler.setStateEffecterStates(
+        request, PLDM_SET_STATE_EFFECTER_STATES_REQ_BYTES,
+        [&responses](pldm::Response&& response) {
+            responses.emplace_back(std::move(response));
+        });
+
+    // Answered once the states are validated, before the D-Bus write ends
+    ASSERT_EQ(responses.size(), 1);
+    auto response = reinterpret_cast<const pldm_msg*>(responses[0].data());
+    EXPECT_EQ(response->payload[0], PLDM_SUCCESS);
+
+    pldm_pdr_destroy(inPDRRepo);
+}
+
 TEST(setStateEffecterStatesHandler, testBadRequest)
 {
     std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES>
@@ -635,6 +944,7 @@ TEST(StateSensorHandler, allScenarios)
         PropertyValue value1{std::in_place_type<uint8_t>, 10};
         ASSERT_EQ(value0 == propValue0, true);
         ASSERT_EQ(value1 == propValue1, true);
+        ASSERT_THROW(eventStateMap.at(eventState0), std::out_of_range);
     }
 
     // Event Entry 3
@@ -737,6 +1047,12 @@ TEST(StateSensorHandler, allScenarios)
         StateSensorEntry entry{0, 0, 0, 0, 1, false};
         ASSERT_THROW(handler.getEventInfo(entry), std::out_of_range);
     }
+
+    // Sensor offset without an entry
+    {
+        StateSensorEntry entry{1, 64, 1, 2, 1, false};
+        ASSERT_THROW(handler.getEventInfo(entry), std::out_of_range);
+    }
 }
 
 TEST(TerminusLocatorPDR, BMCTerminusLocatorPDR)
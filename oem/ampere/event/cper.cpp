@@ -6,8 +6,12 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <ranges>
+#include <span>
+#include <utility>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -17,77 +21,105 @@ namespace pldm
 namespace oem_ampere
 {
 
-// Returns one if two EFI GUIDs are equal, zero otherwise.
-int guid_equal(EFI_GUID* a, EFI_GUID* b)
-{
-    // Check top base 3 components.
-    if (a->Data1 != b->Data1 || a->Data2 != b->Data2 || a->Data3 != b->Data3)
-    {
-        return 0;
-    }
+/* The decoders read the CPER structures in place, in the received event
+ * data, which relies on their packed layout */
+static_assert(alignof(EFI_COMMON_ERROR_RECORD_HEADER) == 1);
+static_assert(alignof(EFI_ERROR_SECTION_DESCRIPTOR) == 1);
+static_assert(alignof(EFI_ARM_ERROR_RECORD) == 1);
+static_assert(alignof(EFI_ARM_CONTEXT_INFORMATION_HEADER) == 1);
+static_assert(alignof(EFI_PLATFORM_MEMORY_ERROR_DATA) == 1);
+static_assert(alignof(EFI_PCIE_ERROR_DATA) == 1);
 
-    // Check Data4 array for equality.
-    for (int i = 0; i < 8; i++)
+/** @brief Get a structure of the CPER record, in place
+ *
+ *  @param[in] data - bytes holding the structure
+ *  @param[in] offset - offset of the structure in data
+ *  @param[in] count - number of consecutive structures
+ *
+ *  @return the structure, nullptr if it is not within data
+ */
+template <typename T>
+static const T* viewAt(std::span<const uint8_t> data, size_t offset,
+                       size_t count = 1)
+{
+    if (offset > data.size() || (data.size() - offset) / sizeof(T) < count)
     {
-        if (a->Data4[i] != b->Data4[i])
-        {
-            return 0;
-        }
+        return nullptr;
     }
-
-    return 1;
+    return reinterpret_cast<const T*>(data.data() + offset);
 }
 
-static void decodeSecAmpere(void* section, EFI_AMPERE_ERROR_DATA* ampSpecHdr)
+// Returns true if two EFI GUIDs are equal.
+static bool guidEqual(const EFI_GUID& a, const EFI_GUID& b)
 {
-    std::memcpy(ampSpecHdr, section, sizeof(EFI_AMPERE_ERROR_DATA));
+    return !std::memcmp(&a, &b, sizeof(EFI_GUID));
 }
 
-static void decodeSecArm(void* section, EFI_AMPERE_ERROR_DATA* ampSpecHdr)
+static void decodeSecAmpere(std::span<const uint8_t> section,
+                            EFI_AMPERE_ERROR_DATA* ampSpecHdr)
 {
-    int len;
-    EFI_ARM_ERROR_RECORD* proc;
-    EFI_ARM_ERROR_INFORMATION_ENTRY* errInfo;
-    EFI_ARM_CONTEXT_INFORMATION_HEADER* ctxInfo;
-
-    proc = reinterpret_cast<EFI_ARM_ERROR_RECORD*>(section);
-    errInfo = reinterpret_cast<EFI_ARM_ERROR_INFORMATION_ENTRY*>(proc + 1);
+    if (section.size() < sizeof(EFI_AMPERE_ERROR_DATA))
+    {
+        lg2::error("Ampere section is too small, section_length {LENGTH}",
+                   "LENGTH", section.size());
+        return;
+    }
+    std::memcpy(ampSpecHdr, section.data(), sizeof(EFI_AMPERE_ERROR_DATA));
+}
 
-    len = proc->SectionLength -
-          (sizeof(EFI_ARM_ERROR_RECORD) +
-           proc->ErrInfoNum * (sizeof(EFI_ARM_ERROR_INFORMATION_ENTRY)));
-    if (len < 0)
+static void decodeSecArm(std::span<const uint8_t> section,
+                         EFI_AMPERE_ERROR_DATA* ampSpecHdr)
+{
+    auto proc = viewAt<EFI_ARM_ERROR_RECORD>(section, 0);
+    if (!proc || proc->SectionLength > section.size() ||
+        !viewAt<EFI_ARM_ERROR_INFORMATION_ENTRY>(
+            section.first(proc->SectionLength), sizeof(EFI_ARM_ERROR_RECORD),
+            proc->ErrInfoNum))
     {
         lg2::error("Section length is too small, section_length {LENGTH}",
-                   "LENGTH", static_cast<int>(proc->SectionLength));
+                   "LENGTH", section.size());
         return;
     }
+    section = section.first(proc->SectionLength);
 
-    ctxInfo = reinterpret_cast<EFI_ARM_CONTEXT_INFORMATION_HEADER*>(
-        errInfo + proc->ErrInfoNum);
-
+    /* The Ampere specific data follows the error information and the
+     * context information */
+    size_t pos = sizeof(EFI_ARM_ERROR_RECORD) +
+                 proc->ErrInfoNum * sizeof(EFI_ARM_ERROR_INFORMATION_ENTRY);
     for ([[maybe_unused]] const auto& i :
          std::views::iota(0, static_cast<int>(proc->ContextInfoNum)))
     {
-        int size = sizeof(EFI_ARM_CONTEXT_INFORMATION_HEADER) +
-                   ctxInfo->RegisterArraySize;
-        len -= size;
-        ctxInfo = reinterpret_cast<EFI_ARM_CONTEXT_INFORMATION_HEADER*>(
-            (long)ctxInfo + size);
+        auto ctxInfo =
+            viewAt<EFI_ARM_CONTEXT_INFORMATION_HEADER>(section, pos);
+        if (!ctxInfo || section.size() - pos -
+                                sizeof(EFI_ARM_CONTEXT_INFORMATION_HEADER) <
+                            ctxInfo->RegisterArraySize)
+        {
+            lg2::error("ARM context information exceeds the section");
+            return;
+        }
+        pos += sizeof(EFI_ARM_CONTEXT_INFORMATION_HEADER) +
+               ctxInfo->RegisterArraySize;
     }
 
-    if (len > 0)
+    if (section.size() - pos >= sizeof(EFI_AMPERE_ERROR_DATA))
     {
         /* Get Ampere Specific header data */
-        std::memcpy(ampSpecHdr, (void*)ctxInfo, sizeof(EFI_AMPERE_ERROR_DATA));
+        std::memcpy(ampSpecHdr, section.data() + pos,
+                    sizeof(EFI_AMPERE_ERROR_DATA));
     }
 }
 
-static void decodeSecPlatformMemory(void* section,
+static void decodeSecPlatformMemory(std::span<const uint8_t> section,
                                     EFI_AMPERE_ERROR_DATA* ampSpecHdr)
 {
-    EFI_PLATFORM_MEMORY_ERROR_DATA* mem =
-        reinterpret_cast<EFI_PLATFORM_MEMORY_ERROR_DATA*>(section);
+    auto mem = viewAt<EFI_PLATFORM_MEMORY_ERROR_DATA>(section, 0);
+    if (!mem)
+    {
+        lg2::error("Memory section is too small, section_length {LENGTH}",
+                   "LENGTH", section.size());
+        return;
+    }
     if (mem->ErrorType == MEM_ERROR_TYPE_PARITY)
     {
         /* IP Type from bit 0 to 11 of TypeId */
@@ -96,10 +128,16 @@ static void decodeSecPlatformMemory(void* section,
     }
 }
 
-static void decodeSecPcie(void* section, EFI_AMPERE_ERROR_DATA* ampSpecHdr)
+static void decodeSecPcie(std::span<const uint8_t> section,
+                          EFI_AMPERE_ERROR_DATA* ampSpecHdr)
 {
-    EFI_PCIE_ERROR_DATA* pcieErr =
-        reinterpret_cast<EFI_PCIE_ERROR_DATA*>(section);
+    auto pcieErr = viewAt<EFI_PCIE_ERROR_DATA>(section, 0);
+    if (!pcieErr)
+    {
+        lg2::error("PCIe section is too small, section_length {LENGTH}",
+                   "LENGTH", section.size());
+        return;
+    }
     if (pcieErr->ValidFields & CPER_PCIE_VALID_PORT_TYPE)
     {
         if (pcieErr->PortType == CPER_PCIE_PORT_TYPE_ROOT_PORT)
@@ -113,71 +151,76 @@ static void decodeSecPcie(void* section, EFI_AMPERE_ERROR_DATA* ampSpecHdr)
     }
 }
 
-static void decodeCperSection(const uint8_t* data, long basePos,
+/** @brief Decoders of the section types contributing to the SEL summary,
+ *         the other sections are only kept in the CPER dump
+ */
+static const std::array<
+    std::pair<const EFI_GUID*, void (*)(std::span<const uint8_t>,
+                                        EFI_AMPERE_ERROR_DATA*)>,
+    4>
+    sectionDecoders{{
+        {&gEfiAmpereErrorSectionGuid, decodeSecAmpere},
+        {&gEfiArmProcessorErrorSectionGuid, decodeSecArm},
+        {&gEfiPlatformMemoryErrorSectionGuid, decodeSecPlatformMemory},
+        {&gEfiPcieErrorSectionGuid, decodeSecPcie},
+    }};
+
+static void decodeCperSection(std::span<const uint8_t> record,
                               EFI_AMPERE_ERROR_DATA* ampSpecHdr,
-                              EFI_ERROR_SECTION_DESCRIPTOR* secDesc)
+                              const EFI_ERROR_SECTION_DESCRIPTOR& secDesc)
 {
-    long pos = basePos + secDesc->SectionOffset;
-    char* section = new char[secDesc->SectionLength];
-    std::memcpy(section, &data[pos], secDesc->SectionLength);
-    pos += secDesc->SectionLength;
-    EFI_GUID* ptr = reinterpret_cast<EFI_GUID*>(&secDesc->SectionType);
-    if (guid_equal(ptr, &gEfiAmpereErrorSectionGuid))
-    {
-        lg2::info("RAS Section Type : Ampere Specific");
-        decodeSecAmpere(section, ampSpecHdr);
-    }
-    else if (guid_equal(ptr, &gEfiArmProcessorErrorSectionGuid))
+    auto decoder = std::ranges::find_if(sectionDecoders, [&](const auto& d) {
+        return guidEqual(secDesc.SectionType, *d.first);
+    });
+    if (decoder == sectionDecoders.end())
     {
-        lg2::info("RAS Section Type : ARM");
-        decodeSecArm(section, ampSpecHdr);
-    }
-    else if (guid_equal(ptr, &gEfiPlatformMemoryErrorSectionGuid))
-    {
-        lg2::info("RAS Section Type : Memory");
-        decodeSecPlatformMemory(section, ampSpecHdr);
-    }
-    else if (guid_equal(ptr, &gEfiPcieErrorSectionGuid))
-    {
-        lg2::info("RAS Section Type : PCIE");
-        decodeSecPcie(section, ampSpecHdr);
+        lg2::debug("Section Type is not supported");
+        return;
     }
-    else
+
+    if (secDesc.SectionOffset > record.size() ||
+        record.size() - secDesc.SectionOffset < secDesc.SectionLength)
     {
-        lg2::error("Section Type is not supported");
+        lg2::error(
+            "Section exceeds the CPER record, offset {OFFSET} length {LENGTH}",
+            "OFFSET", secDesc.SectionOffset, "LENGTH", secDesc.SectionLength);
+        return;
     }
-
-    delete[] section;
+    decoder->second(
+        record.subspan(secDesc.SectionOffset, secDesc.SectionLength),
+        ampSpecHdr);
 }
 
-void decodeCperRecord(const uint8_t* data, size_t /* eventDataSize */,
+bool decodeCperRecord(const uint8_t* data, size_t eventDataSize,
                       EFI_AMPERE_ERROR_DATA* ampSpecHdr)
 {
-    EFI_COMMON_ERROR_RECORD_HEADER cperHeader;
-    long pos = sizeof(CommonEventData);
-    long basePos = sizeof(CommonEventData);
-
-    std::memcpy(&cperHeader, &data[pos],
-                sizeof(EFI_COMMON_ERROR_RECORD_HEADER));
-    pos += sizeof(EFI_COMMON_ERROR_RECORD_HEADER);
-
-    EFI_ERROR_SECTION_DESCRIPTOR* secDesc =
-        new EFI_ERROR_SECTION_DESCRIPTOR[cperHeader.SectionCount];
-    for ([[maybe_unused]] const auto& i :
-         std::views::iota(0, static_cast<int>(cperHeader.SectionCount)))
+    if (eventDataSize < sizeof(CommonEventData))
     {
-        std::memcpy(&secDesc[i], &data[pos],
-                    sizeof(EFI_ERROR_SECTION_DESCRIPTOR));
-        pos += sizeof(EFI_ERROR_SECTION_DESCRIPTOR);
+        lg2::error("CPER event data is too small, size {SIZE}", "SIZE",
+                   eventDataSize);
+        return false;
     }
+    std::span<const uint8_t> record(data + sizeof(CommonEventData),
+                                    eventDataSize - sizeof(CommonEventData));
 
-    for ([[maybe_unused]] const auto& i :
-         std::views::iota(0, static_cast<int>(cperHeader.SectionCount)))
+    auto cperHeader = viewAt<EFI_COMMON_ERROR_RECORD_HEADER>(record, 0);
+    auto secDesc = cperHeader ? viewAt<EFI_ERROR_SECTION_DESCRIPTOR>(
+                                    record,
+                                    sizeof(EFI_COMMON_ERROR_RECORD_HEADER),
+                                    cperHeader->SectionCount)
+                              : nullptr;
+    if (!secDesc)
     {
-        decodeCperSection(data, basePos, ampSpecHdr, &secDesc[i]);
+        lg2::error("CPER record is truncated, size {SIZE}", "SIZE",
+                   record.size());
+        return false;
     }
 
-    delete[] secDesc;
+    for (const auto& desc : std::span(secDesc, cperHeader->SectionCount))
+    {
+        decodeCperSection(record, ampSpecHdr, desc);
+    }
+    return true;
 }
 
 void addCperSELLog(pldm_tid_t tid, uint16_t eventID, EFI_AMPERE_ERROR_DATA* p)
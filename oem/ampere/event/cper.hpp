@@ -34,7 +34,16 @@ typedef struct
     uint16_t length;
 } __attribute__((packed)) CommonEventData;
 
-void decodeCperRecord(const uint8_t* data, size_t eventDataSize,
+/** @brief Get the SEL summary of a CPER record, from the sections decoded
+ *         in place in the event data
+ *
+ *  @param[in] data - CPER event data
+ *  @param[in] eventDataSize - size of the CPER event data
+ *  @param[out] ampSpecHdr - Ampere specific data of the sections
+ *
+ *  @return false if the record is truncated
+ */
+bool decodeCperRecord(const uint8_t* data, size_t eventDataSize,
                       EFI_AMPERE_ERROR_DATA* ampSpecHdr);
 void addCperSELLog(uint8_t TID, uint16_t eventID, EFI_AMPERE_ERROR_DATA* p);
 
@@ -2,6 +2,7 @@
 
 #include "libcper/Cper.h"
 
+#include "common/event_log_limiter.hpp"
 #include "cper.hpp"
 #include "requester/handler.hpp"
 #include "requester/request.hpp"
@@ -15,11 +16,16 @@
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
 #include <algorithm>
+#include <array>
+#include <format>
+#include <iterator>
 #include <map>
+#include <optional>
+#include <ranges>
 #include <set>
-#include <sstream>
+#include <span>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 
 namespace pldm
 {
@@ -45,23 +51,47 @@ constexpr auto maxDIMMInstantNum = 24;
 
 const std::set<uint16_t> rasUESensorIDs = {CORE_UE, MCU_UE, PCIE_UE, SOC_UE};
 
+/*
+    A message of a status or event code.
+*/
+struct CodeMsg
+{
+    uint16_t code;
+    std::string_view msg;
+};
+
+/*
+    Find the message of a code in a table of CodeMsg.
+*/
+constexpr std::optional<std::string_view> findMsg(
+    std::span<const CodeMsg> table, uint16_t code)
+{
+    auto it = std::ranges::find(table, code, &CodeMsg::code);
+    if (it == table.end())
+    {
+        return std::nullopt;
+    }
+    return it->msg;
+}
+
 /*
     An array of possible boot status of a boot stage.
     The index maps with byte 0 of boot code.
 */
-std::array<std::string, 3> bootStatMsg = {" booting", " completed", " failed"};
+constexpr std::array<std::string_view, 3> bootStatMsg = {
+    " booting", " completed", " failed"};
 
 /*
     An array of possible boot status of DDR training stage.
     The index maps with byte 0 of boot code.
 */
-std::array<std::string, 3> ddrTrainingMsg = {
+constexpr std::array<std::string_view, 3> ddrTrainingMsg = {
     " progress started", " in-progress", " progress completed"};
 
 /*
     A map between PMIC status and logging strings.
 */
-std::array<std::string, 8> pmicTempAlertMsg = {
+constexpr std::array<std::string_view, 8> pmicTempAlertMsg = {
     "Below 85°C", "85°C",  "95°C",  "105°C",
     "115°C",      "125°C", "135°C", "Equal or greater than 140°C"};
 
@@ -73,209 +103,285 @@ std::array<std::string, 8> pmicTempAlertMsg = {
     mctpd will set the EID 0x14 for S0 and 0x16 for S1 (if available).
     pldmd will always use TID 1 for S0 and TID 2 for S1 (if available).
 */
-EventToMsgMap_t tidToSocketNameMap = {{1, "SOCKET 0"}, {2, "SOCKET 1"}};
+constexpr std::array<CodeMsg, 2> tidToSocketNameMap = {
+    {{1, "SOCKET 0"}, {2, "SOCKET 1"}}};
 
 /*
     A map between sensor IDs and their names in string.
     Using pldm::oem::sensor_ids
 */
-EventToMsgMap_t sensorIdToStrMap = {
-    {DDR_STATUS, "DDR_STATUS"},
-    {PCP_VR_STATE, "PCP_VR_STATE"},
-    {SOC_VR_STATE, "SOC_VR_STATE"},
-    {DPHY_VR1_STATE, "DPHY_VR1_STATE"},
-    {DPHY_VR2_STATE, "DPHY_VR2_STATE"},
-    {D2D_VR_STATE, "D2D_VR_STATE"},
-    {IOC_VR1_STATE, "IOC_VR1_STATE"},
-    {IOC_VR2_STATE, "IOC_VR2_STATE"},
-    {PCI_D_VR_STATE, "PCI_D_VR_STATE"},
-    {PCI_A_VR_STATE, "PCI_A_VR_STATE"},
-    {PCIE_HOT_PLUG, "PCIE_HOT_PLUG"},
-    {BOOT_OVERALL, "BOOT_OVERALL"},
-    {SOC_HEALTH_AVAILABILITY, "SOC_HEALTH_AVAILABILITY"},
-    {WATCH_DOG, "WATCH_DOG"}};
+constexpr std::array<CodeMsg, 14> sensorIdToStrMap = {
+    {{DDR_STATUS, "DDR_STATUS"},
+     {PCP_VR_STATE, "PCP_VR_STATE"},
+     {SOC_VR_STATE, "SOC_VR_STATE"},
+     {DPHY_VR1_STATE, "DPHY_VR1_STATE"},
+     {DPHY_VR2_STATE, "DPHY_VR2_STATE"},
+     {D2D_VR_STATE, "D2D_VR_STATE"},
+     {IOC_VR1_STATE, "IOC_VR1_STATE"},
+     {IOC_VR2_STATE, "IOC_VR2_STATE"},
+     {PCI_D_VR_STATE, "PCI_D_VR_STATE"},
+     {PCI_A_VR_STATE, "PCI_A_VR_STATE"},
+     {PCIE_HOT_PLUG, "PCIE_HOT_PLUG"},
+     {BOOT_OVERALL, "BOOT_OVERALL"},
+     {SOC_HEALTH_AVAILABILITY, "SOC_HEALTH_AVAILABILITY"},
+     {WATCH_DOG, "WATCH_DOG"}}};
 
 /*
     A map between the boot stages and logging strings.
     Using pldm::oem::boot::stage::boot_stage
 */
-EventToMsgMap_t bootStageToMsgMap = {
-    {boot_stage::SECPRO, "SECpro"},
-    {boot_stage::MPRO, "Mpro"},
-    {boot_stage::ATF_BL1, "ATF BL1"},
-    {boot_stage::ATF_BL2, "ATF BL2"},
-    {boot_stage::DDR_INITIALIZATION, "DDR initialization"},
-    {boot_stage::DDR_TRAINING, "DDR training"},
-    {boot_stage::S0_DDR_TRAINING_FAILURE, "DDR training failure"},
-    {boot_stage::ATF_BL31, "ATF BL31"},
-    {boot_stage::ATF_BL32, "ATF BL32"},
-    {boot_stage::S1_DDR_TRAINING_FAILURE, "DDR training failure"},
-    {boot_stage::UEFI_STATUS_CLASS_CODE_MIN,
-     "ATF BL33 (UEFI) booting status = "}};
+constexpr std::array<CodeMsg, 11> bootStageToMsgMap = {
+    {{boot_stage::SECPRO, "SECpro"},
+     {boot_stage::MPRO, "Mpro"},
+     {boot_stage::ATF_BL1, "ATF BL1"},
+     {boot_stage::ATF_BL2, "ATF BL2"},
+     {boot_stage::DDR_INITIALIZATION, "DDR initialization"},
+     {boot_stage::DDR_TRAINING, "DDR training"},
+     {boot_stage::S0_DDR_TRAINING_FAILURE, "DDR training failure"},
+     {boot_stage::ATF_BL31, "ATF BL31"},
+     {boot_stage::ATF_BL32, "ATF BL32"},
+     {boot_stage::S1_DDR_TRAINING_FAILURE, "DDR training failure"},
+     {boot_stage::UEFI_STATUS_CLASS_CODE_MIN,
+      "ATF BL33 (UEFI) booting status = "}}};
 
 /*
     A map between DDR status and logging strings.
     Using pldm::oem::ddr::status::ddr_status
 */
-EventToMsgMap_t ddrStatusToMsgMap = {
-    {ddr_status::NO_SYSTEM_LEVEL_ERROR, "has no system level error"},
-    {ddr_status::ECC_INITIALIZATION_FAILURE, "has ECC initialization failure"},
-    {ddr_status::CONFIGURATION_FAILURE, "has configuration failure at DIMMs:"},
-    {ddr_status::TRAINING_FAILURE, "has training failure at DIMMs:"},
-    {ddr_status::OTHER_FAILURE, "has other failure"},
-    {ddr_status::BOOT_FAILURE_NO_VALID_CONFIG,
-     "has boot failure due to no configuration"},
-    {ddr_status::FAILSAFE_ACTIVATED_NEXT_BOOT_SUCCESS,
-     "failsafe activated but boot success with the next valid configuration"}};
+constexpr std::array<CodeMsg, 7> ddrStatusToMsgMap = {
+    {{ddr_status::NO_SYSTEM_LEVEL_ERROR, "has no system level error"},
+     {ddr_status::ECC_INITIALIZATION_FAILURE, "has ECC initialization failure"},
+     {ddr_status::CONFIGURATION_FAILURE, "has configuration failure at DIMMs:"},
+     {ddr_status::TRAINING_FAILURE, "has training failure at DIMMs:"},
+     {ddr_status::OTHER_FAILURE, "has other failure"},
+     {ddr_status::BOOT_FAILURE_NO_VALID_CONFIG,
+      "has boot failure due to no configuration"},
+     {ddr_status::FAILSAFE_ACTIVATED_NEXT_BOOT_SUCCESS,
+      "failsafe activated but boot success with the next valid configuration"}}};
 
 /*
     A map between DIMM status and logging strings.
     Using pldm::oem::dimm::status::dimm_status
 */
-EventToMsgMap_t dimmStatusToMsgMap = {
-    {dimm_status::INSTALLED_NO_ERROR, "is installed and no error"},
-    {dimm_status::NOT_INSTALLED, "is not installed"},
-    {dimm_status::OTHER_FAILURE, "has other failure"},
-    {dimm_status::INSTALLED_BUT_DISABLED, "is installed but disabled"},
-    {dimm_status::TRAINING_FAILURE, "has training failure; "},
-    {dimm_status::PMIC_TEMP_ALERT, "has PMIC temperature alert"}};
+constexpr std::array<CodeMsg, 6> dimmStatusToMsgMap = {
+    {{dimm_status::INSTALLED_NO_ERROR, "is installed and no error"},
+     {dimm_status::NOT_INSTALLED, "is not installed"},
+     {dimm_status::OTHER_FAILURE, "has other failure"},
+     {dimm_status::INSTALLED_BUT_DISABLED, "is installed but disabled"},
+     {dimm_status::TRAINING_FAILURE, "has training failure; "},
+     {dimm_status::PMIC_TEMP_ALERT, "has PMIC temperature alert"}}};
 
 /*
     A map between PHY training failure syndrome and logging strings.
     Using
    pldm::oem::dimm::training_faillure::phy_syndrome::phy_training_failure_syndrome
 */
-EventToMsgMap_t phyTrainingFailureSyndromeToMsgMap = {
-    {phy_syndrome::NA, "(N/A)"},
-    {phy_syndrome::PHY_TRAINING_SETUP_FAILURE, "(PHY training setup failure)"},
-    {phy_syndrome::CA_LEVELING, "(CA leveling)"},
-    {phy_syndrome::PHY_WRITE_LEVEL_FAILURE,
-     "(PHY write level failure - see syndrome 1)"},
-    {phy_syndrome::PHY_READ_GATE_LEVELING_FAILURE,
-     "(PHY read gate leveling failure)"},
-    {phy_syndrome::PHY_READ_LEVEL_FAILURE, "(PHY read level failure)"},
-    {phy_syndrome::WRITE_DQ_LEVELING, "(Write DQ leveling)"},
-    {phy_syndrome::PHY_SW_TRAINING_FAILURE, "(PHY SW training failure)"}};
+constexpr std::array<CodeMsg, 8> phyTrainingFailureSyndromeToMsgMap = {
+    {{phy_syndrome::NA, "(N/A)"},
+     {phy_syndrome::PHY_TRAINING_SETUP_FAILURE, "(PHY training setup failure)"},
+     {phy_syndrome::CA_LEVELING, "(CA leveling)"},
+     {phy_syndrome::PHY_WRITE_LEVEL_FAILURE,
+      "(PHY write level failure - see syndrome 1)"},
+     {phy_syndrome::PHY_READ_GATE_LEVELING_FAILURE,
+      "(PHY read gate leveling failure)"},
+     {phy_syndrome::PHY_READ_LEVEL_FAILURE, "(PHY read level failure)"},
+     {phy_syndrome::WRITE_DQ_LEVELING, "(Write DQ leveling)"},
+     {phy_syndrome::PHY_SW_TRAINING_FAILURE, "(PHY SW training failure)"}}};
 
 /*
     A map between DIMM training failure syndrome and logging strings.
     Using
    pldm::oem::dimm::training_faillure::dimm_syndrome::dimm_training_failure_syndrome
 */
-EventToMsgMap_t dimmTrainingFailureSyndromeToMsgMap = {
-    {dimm_syndrome::NA, "(N/A)"},
-    {dimm_syndrome::DRAM_VREFDQ_TRAINING_FAILURE,
-     "(DRAM VREFDQ training failure)"},
-    {dimm_syndrome::LRDIMM_DB_TRAINING_FAILURE, "(LRDIMM DB training failure)"},
-    {dimm_syndrome::LRDRIMM_DB_SW_TRAINING_FAILURE,
-     "(LRDRIMM DB SW training failure)"}};
+constexpr std::array<CodeMsg, 4> dimmTrainingFailureSyndromeToMsgMap = {
+    {{dimm_syndrome::NA, "(N/A)"},
+     {dimm_syndrome::DRAM_VREFDQ_TRAINING_FAILURE,
+      "(DRAM VREFDQ training failure)"},
+     {dimm_syndrome::LRDIMM_DB_TRAINING_FAILURE,
+      "(LRDIMM DB training failure)"},
+     {dimm_syndrome::LRDRIMM_DB_SW_TRAINING_FAILURE,
+      "(LRDRIMM DB SW training failure)"}}};
+
+/*
+    A DIMM training failure type, its logging string and syndrome map.
+*/
+struct TrainingFailureMsg
+{
+    uint8_t type;
+    std::string_view msg;
+    std::span<const CodeMsg> syndromes;
+};
 
 /*
     A map between DIMM training failure type and a pair of <logging strings -
    syndrome map>. Using
    pldm::oem::dimm::training_faillure::dimm_training_failure_type
 */
-std::unordered_map<uint8_t, std::pair<std::string, EventToMsgMap_t>>
-    dimmTrainingFailureTypeMap = {
-        {training_failure::PHY_TRAINING_FAILURE_TYPE,
-         std::make_pair("PHY training failure",
-                        phyTrainingFailureSyndromeToMsgMap)},
-        {training_failure::DIMM_TRAINING_FAILURE_TYPE,
-         std::make_pair("DIMM training failure",
-                        dimmTrainingFailureSyndromeToMsgMap)}};
+constexpr std::array<TrainingFailureMsg, 2> dimmTrainingFailureTypeMap = {
+    {{training_failure::PHY_TRAINING_FAILURE_TYPE, "PHY training failure",
+      phyTrainingFailureSyndromeToMsgMap},
+     {training_failure::DIMM_TRAINING_FAILURE_TYPE, "DIMM training failure",
+      dimmTrainingFailureSyndromeToMsgMap}}};
 
 /*
     A map between log level and the registry used for Redfish SEL log
-    Using pldm::oem::log_level
+    Using pldm::oem::log_level, indexed by the log level
+*/
+constexpr std::array<const char*, 4> logLevelToRedfishMsgIdMap = {
+    ampereEventRegistry, ampereWarningRegistry, ampereCriticalRegistry,
+    BIOSFWPanicRegistry};
+
+/*
+    A state of a state sensor component, its log level and logging string.
+*/
+struct StateMsg
+{
+    uint8_t state;
+    log_level level;
+    std::string_view msg;
+};
+
+/*
+    A component of a state sensor, by sensor offset, and its states.
+*/
+struct StateComponentMsg
+{
+    std::string_view name;
+    std::span<const StateMsg> states;
+};
+
+constexpr std::array<StateMsg, 4> socHealthStates = {
+    {{1, log_level::OK, "Normal"},
+     {2, log_level::WARNING, "Non-Critical"},
+     {3, log_level::CRITICAL, "Critical"},
+     {4, log_level::CRITICAL, "Fatal"}}};
+
+constexpr std::array<StateMsg, 3> socAvailabilityStates = {
+    {{1, log_level::OK, "Enabled"},
+     {2, log_level::WARNING, "Disabled"},
+     {3, log_level::CRITICAL, "Shutdown"}}};
+
+constexpr std::array<StateMsg, 2> watchdogStates = {
+    {{1, log_level::OK, "Normal"},
+     {2, log_level::CRITICAL, "Timer Expired"}}};
+
+constexpr std::array<StateComponentMsg, 2> socHealthAvailabilityComponents = {
+    {{"SoC Health", socHealthStates},
+     {"SoC Availability", socAvailabilityStates}}};
+
+constexpr std::array<StateComponentMsg, 3> watchdogComponents = {
+    {{"Global Watch Dog", watchdogStates},
+     {"Secure Watch Dog", watchdogStates},
+     {"Non-secure Watch Dog", watchdogStates}}};
+
+/*
+    A state sensor and its components.
 */
-std::unordered_map<log_level, std::string> logLevelToRedfishMsgIdMap = {
-    {log_level::OK, ampereEventRegistry},
-    {log_level::WARNING, ampereWarningRegistry},
-    {log_level::CRITICAL, ampereCriticalRegistry},
-    {log_level::BIOSFWPANIC, BIOSFWPanicRegistry}};
-
-std::unordered_map<
-    uint16_t,
-    std::vector<std::pair<
-        std::string,
-        std::unordered_map<uint8_t, std::pair<log_level, std::string>>>>>
-    stateSensorToMsgMap = {
-        {SOC_HEALTH_AVAILABILITY,
-         {{"SoC Health",
-           {{1, {log_level::OK, "Normal"}},
-            {2, {log_level::WARNING, "Non-Critical"}},
-            {3, {log_level::CRITICAL, "Critical"}},
-            {4, {log_level::CRITICAL, "Fatal"}}}},
-          {"SoC Availability",
-           {{1, {log_level::OK, "Enabled"}},
-            {2, {log_level::WARNING, "Disabled"}},
-            {3, {log_level::CRITICAL, "Shutdown"}}}}}},
-        {WATCH_DOG,
-         {{"Global Watch Dog",
-           {{1, {log_level::OK, "Normal"}},
-            {2, {log_level::CRITICAL, "Timer Expired"}}}},
-          {"Secure Watch Dog",
-           {{1, {log_level::OK, "Normal"}},
-            {2, {log_level::CRITICAL, "Timer Expired"}}}},
-          {"Non-secure Watch Dog",
-           {{1, {log_level::OK, "Normal"}},
-            {2, {log_level::CRITICAL, "Timer Expired"}}}}}}};
-
-std::string OemEventManager::prefixMsgStrCreation(pldm_tid_t tid,
-                                                  uint16_t sensorId)
+struct StateSensorMsg
 {
-    std::string description;
-    if (!tidToSocketNameMap.contains(tid))
+    uint16_t sensorId;
+    std::span<const StateComponentMsg> components;
+};
+
+constexpr std::array<StateSensorMsg, 2> stateSensorToMsgMap = {
+    {{SOC_HEALTH_AVAILABILITY, socHealthAvailabilityComponents},
+     {WATCH_DOG, watchdogComponents}}};
+
+/*
+    Find the state of a state sensor component, nullptr if not found.
+*/
+constexpr const StateMsg* findState(std::span<const StateMsg> states,
+                                    uint8_t state)
+{
+    auto it = std::ranges::find(states, state, &StateMsg::state);
+    return it != states.end() ? &*it : nullptr;
+}
+
+/*
+    A range of numeric sensor IDs, every step IDs from first to last, and
+    the handler of their events.
+*/
+struct NumericSensorHandler
+{
+    uint16_t first;
+    uint16_t last;
+    uint16_t step;
+    void (OemEventManager::*handler)(pldm_tid_t, uint16_t, uint32_t);
+};
+
+void OemEventManager::appendPrefix(pldm_tid_t tid, uint16_t sensorId)
+{
+    if (auto name = findMsg(tidToSocketNameMap, tid))
     {
-        description += "TID " + std::to_string(tid) + ": ";
+        std::format_to(std::back_inserter(msgBuffer), "{}: ", *name);
     }
     else
     {
-        description += tidToSocketNameMap[tid] + ": ";
+        std::format_to(std::back_inserter(msgBuffer), "TID {}: ", tid);
     }
 
-    if (!sensorIdToStrMap.contains(sensorId))
+    if (auto name = findMsg(sensorIdToStrMap, sensorId))
     {
-        description += "Sensor ID " + std::to_string(sensorId) + ": ";
+        std::format_to(std::back_inserter(msgBuffer), "{}: ", *name);
     }
     else
     {
-        description += sensorIdToStrMap[sensorId] + ": ";
+        std::format_to(std::back_inserter(msgBuffer), "Sensor ID {}: ",
+                       sensorId);
     }
-
-    return description;
 }
 
 void OemEventManager::sendJournalRedfish(const std::string& description,
-                                         log_level& logLevel)
+                                         log_level logLevel)
 {
     if (description.empty())
     {
         return;
     }
 
-    if (!logLevelToRedfishMsgIdMap.contains(logLevel))
+    auto level = static_cast<size_t>(logLevel);
+    if (level >= logLevelToRedfishMsgIdMap.size())
     {
         lg2::error("Invalid {LEVEL} Description {DES}", "LEVEL", logLevel,
                    "DES", description);
         return;
     }
-    auto redfishMsgId = logLevelToRedfishMsgIdMap[logLevel];
+    auto redfishMsgId = logLevelToRedfishMsgIdMap[level];
     lg2::info("MESSAGE={DES}", "DES", description, "REDFISH_MESSAGE_ID",
               redfishMsgId, "REDFISH_MESSAGE_ARGS", description);
 }
 
-std::string OemEventManager::dimmIdxsToString(uint32_t dimmIdxs)
+void OemEventManager::sendJournalRedfish(pldm_tid_t tid, uint16_t sensorId,
+                                         const std::string& description,
+                                         log_level logLevel)
+{
+    if (!pldm::utils::EventLogLimiter::getInstance().admit(
+            {pldm::utils::EventLogSource::Oem, tid, sensorId,
+             static_cast<uint8_t>(logLevel)},
+            [this, &description, logLevel]() {
+                return [this, description, logLevel](
+                           uint64_t suppressed, std::chrono::seconds interval) {
+                    sendJournalRedfish(
+                        std::format("{} (repeated {} more times in {}s)",
+                                    description, suppressed, interval.count()),
+                        logLevel);
+                };
+            }))
+    {
+        return;
+    }
+    sendJournalRedfish(description, logLevel);
+}
+
+void OemEventManager::appendDIMMIdxs(uint32_t dimmIdxs)
 {
-    std::string description;
     for (const auto bitIdx : std::views::iota(0, maxDIMMIdxBitNum))
     {
         if (dimmIdxs & (static_cast<uint32_t>(1) << bitIdx))
         {
-            description += " #" + std::to_string(bitIdx);
+            std::format_to(std::back_inserter(msgBuffer), " #{}", bitIdx);
         }
     }
-    return description;
 }
 
 uint8_t OemEventManager::sensorIdToDIMMIdx(const uint16_t& sensorId)
@@ -291,11 +397,15 @@ uint8_t OemEventManager::sensorIdToDIMMIdx(const uint16_t& sensorId)
 }
 
 void OemEventManager::handleBootOverallEvent(
-    pldm_tid_t /*tid*/, uint16_t /*sensorId*/, uint32_t presentReading)
+    pldm_tid_t tid, uint16_t /*sensorId*/, uint32_t presentReading)
 {
     log_level logLevel{log_level::OK};
-    std::string description;
-    std::stringstream strStream;
+
+    // The SoC reports its boot progress, get the queued events quickly
+    pollSoon(tid);
+
+    msgBuffer.clear();
+    auto out = std::back_inserter(msgBuffer);
 
     uint8_t byte0 = (presentReading & 0x000000ff);
     uint8_t byte1 = (presentReading & 0x0000ff00) >> 8;
@@ -305,10 +415,10 @@ void OemEventManager::handleBootOverallEvent(
      * Handle SECpro, Mpro, ATF BL1, ATF BL2, ATF BL31,
      * ATF BL32 and DDR initialization
      */
-    if (bootStageToMsgMap.contains(byte3))
+    if (auto stage = findMsg(bootStageToMsgMap, byte3))
     {
         // Boot stage adding
-        description += bootStageToMsgMap[byte3];
+        msgBuffer += *stage;
 
         switch (byte3)
         {
@@ -316,38 +426,38 @@ void OemEventManager::handleBootOverallEvent(
                 if (byte0 >= ddrTrainingMsg.size())
                 {
                     logLevel = log_level::BIOSFWPANIC;
-                    description += " unknown status";
+                    msgBuffer += " unknown status";
                 }
                 else
                 {
-                    description += ddrTrainingMsg[byte0];
+                    msgBuffer += ddrTrainingMsg[byte0];
                 }
                 if (0x01 == byte0)
                 {
                     // Add complete percentage
-                    description += " at " + std::to_string(byte1) + "%";
+                    std::format_to(out, " at {}%", byte1);
                 }
                 break;
             case boot_stage::S0_DDR_TRAINING_FAILURE:
             case boot_stage::S1_DDR_TRAINING_FAILURE:
                 // ddr_training_status_msg()
                 logLevel = log_level::BIOSFWPANIC;
-                description += " at DIMMs:";
+                msgBuffer += " at DIMMs:";
                 // dimmIdxs = presentReading & 0x00ffffff;
-                description += dimmIdxsToString(presentReading & 0x00ffffff);
-                description += " of socket ";
-                description +=
-                    (boot_stage::S0_DDR_TRAINING_FAILURE == byte3) ? "0" : "1";
+                appendDIMMIdxs(presentReading & 0x00ffffff);
+                std::format_to(
+                    out, " of socket {}",
+                    (boot_stage::S0_DDR_TRAINING_FAILURE == byte3) ? 0 : 1);
                 break;
             default:
                 if (byte0 >= bootStatMsg.size())
                 {
                     logLevel = log_level::BIOSFWPANIC;
-                    description += " unknown status";
+                    msgBuffer += " unknown status";
                 }
                 else
                 {
-                    description += bootStatMsg[byte0];
+                    msgBuffer += bootStatMsg[byte0];
                 }
                 break;
         }
@@ -362,25 +472,19 @@ void OemEventManager::handleBootOverallEvent(
     {
         if (byte3 <= boot_stage::UEFI_STATUS_CLASS_CODE_MAX)
         {
-            description +=
-                bootStageToMsgMap[boot_stage::UEFI_STATUS_CLASS_CODE_MIN];
-
-            strStream
-                << "Segment (0x" << std::setfill('0') << std::hex
-                << std::setw(8) << static_cast<uint32_t>(presentReading)
-                << "); Status Class (0x" << std::setw(2)
-                << static_cast<uint32_t>(byte3) << "); Status SubClass (0x"
-                << std::setw(2) << static_cast<uint32_t>(byte2)
-                << "); Operation Code (0x" << std::setw(4)
-                << static_cast<uint32_t>((presentReading & 0xffff0000) >> 16)
-                << ")" << std::dec;
-
-            description += strStream.str();
+            msgBuffer += *findMsg(bootStageToMsgMap,
+                                  boot_stage::UEFI_STATUS_CLASS_CODE_MIN);
+            std::format_to(
+                out,
+                "Segment (0x{:08x}); Status Class (0x{:02x}); Status SubClass "
+                "(0x{:02x}); Operation Code (0x{:04x})",
+                presentReading, byte3, byte2,
+                (presentReading & 0xffff0000) >> 16);
         }
     }
 
-    // Log to Redfish event
-    sendJournalRedfish(description, logLevel);
+    // Log to Redfish event, every boot stage is logged
+    sendJournalRedfish(msgBuffer, logLevel);
 }
 
 int OemEventManager::processNumericSensorEvent(
@@ -402,55 +506,40 @@ int OemEventManager::processNumericSensorEvent(
         return rc;
     }
 
-    // DIMMx_Status sensorID 4+2*index (index 0 -> maxDIMMInstantNum-1)
-    if (auto dimmIdx = sensorIdToDIMMIdx(sensorId); dimmIdx < maxDIMMInstantNum)
+    static constexpr std::array<NumericSensorHandler, 6> handlers = {{
+        // DIMMx_Status sensorID 4+2*index (index 0 -> maxDIMMInstantNum-1)
+        {4, 4 + 2 * (maxDIMMInstantNum - 1), 2,
+         &OemEventManager::handleDIMMStatusEvent},
+        {BOOT_OVERALL, BOOT_OVERALL, 1,
+         &OemEventManager::handleBootOverallEvent},
+        {PCIE_HOT_PLUG, PCIE_HOT_PLUG, 1,
+         &OemEventManager::handlePCIeHotPlugEvent},
+        {DDR_STATUS, DDR_STATUS, 1, &OemEventManager::handleDDRStatusEvent},
+        // The VR state sensors, PCP_VR_STATE to PCI_A_VR_STATE
+        {PCP_VR_STATE, PCI_A_VR_STATE, SOC_VR_STATE - PCP_VR_STATE,
+         &OemEventManager::handleVRDStatusEvent},
+        {WATCH_DOG, WATCH_DOG, 1,
+         &OemEventManager::handleNumericWatchdogEvent},
+    }};
+
+    auto it = std::ranges::find_if(handlers, [sensorId](const auto& entry) {
+        return sensorId >= entry.first && sensorId <= entry.last &&
+               (sensorId - entry.first) % entry.step == 0;
+    });
+    if (it != handlers.end())
     {
-        handleDIMMStatusEvent(tid, sensorId, presentReading);
+        (this->*(it->handler))(tid, sensorId, presentReading);
         return PLDM_SUCCESS;
     }
 
-    switch (sensorId)
-    {
-        case BOOT_OVERALL:
-            handleBootOverallEvent(tid, sensorId, presentReading);
-            break;
-        case PCIE_HOT_PLUG:
-            handlePCIeHotPlugEvent(tid, sensorId, presentReading);
-            break;
-        case DDR_STATUS:
-            handleDDRStatusEvent(tid, sensorId, presentReading);
-            break;
-        case PCP_VR_STATE:
-        case SOC_VR_STATE:
-        case DPHY_VR1_STATE:
-        case DPHY_VR2_STATE:
-        case D2D_VR_STATE:
-        case IOC_VR1_STATE:
-        case IOC_VR2_STATE:
-        case PCI_D_VR_STATE:
-        case PCI_A_VR_STATE:
-            handleVRDStatusEvent(tid, sensorId, presentReading);
-            break;
-        case WATCH_DOG:
-            handleNumericWatchdogEvent(tid, sensorId, presentReading);
-            break;
-        default:
-            std::string description;
-            std::stringstream strStream;
-
-            description += "SENSOR_EVENT : NUMERIC_SENSOR_STATE: ";
-            description += prefixMsgStrCreation(tid, sensorId);
-            strStream << std::setfill('0') << std::hex << "eventState 0x"
-                      << std::setw(2) << static_cast<uint32_t>(eventState)
-                      << " previousEventState 0x" << std::setw(2)
-                      << static_cast<uint32_t>(previousEventState)
-                      << " sensorDataSize 0x" << std::setw(2)
-                      << static_cast<uint32_t>(sensorDataSize)
-                      << " presentReading 0x" << std::setw(8)
-                      << static_cast<uint32_t>(presentReading) << std::dec;
-            description += strStream.str();
-            std::cout << description << "\n";
-    }
+    msgBuffer.assign("SENSOR_EVENT : NUMERIC_SENSOR_STATE: ");
+    appendPrefix(tid, sensorId);
+    std::format_to(std::back_inserter(msgBuffer),
+                   "eventState 0x{:02x} previousEventState 0x{:02x} "
+                   "sensorDataSize 0x{:02x} presentReading 0x{:08x}",
+                   eventState, previousEventState, sensorDataSize,
+                   presentReading);
+    std::cout << msgBuffer << "\n";
     return PLDM_SUCCESS;
 }
 
@@ -473,60 +562,53 @@ int OemEventManager::processStateSensorEvent(pldm_tid_t tid, uint16_t sensorId,
         return rc;
     }
 
-    std::string description;
+    msgBuffer.clear();
+    auto out = std::back_inserter(msgBuffer);
 
-    if (stateSensorToMsgMap.contains(sensorId))
+    auto sensor = std::ranges::find(stateSensorToMsgMap, sensorId,
+                                    &StateSensorMsg::sensorId);
+    if (sensor != stateSensorToMsgMap.end())
     {
         log_level logLevel = log_level::OK;
 
-        description += prefixMsgStrCreation(tid, sensorId);
-        auto componentMap = stateSensorToMsgMap[sensorId];
-        if (sensorOffset < componentMap.size())
+        appendPrefix(tid, sensorId);
+        if (sensorOffset < sensor->components.size())
         {
-            description += std::get<0>(componentMap[sensorOffset]);
-            auto stateMap = std::get<1>(componentMap[sensorOffset]);
-            if (stateMap.contains(eventState))
+            const auto& component = sensor->components[sensorOffset];
+            msgBuffer += component.name;
+            if (auto state = findState(component.states, eventState))
             {
-                logLevel = std::get<0>(stateMap[eventState]);
-                description += " state : " + std::get<1>(stateMap[eventState]);
-                if (stateMap.contains(previousEventState))
-                {
-                    description += "; previous state: " +
-                                   std::get<1>(stateMap[previousEventState]);
-                }
+                logLevel = state->level;
+                std::format_to(out, " state : {}", state->msg);
             }
             else
             {
-                description += " sends unsupported event state: " +
-                               std::to_string(eventState);
-                if (stateMap.contains(previousEventState))
-                {
-                    description += "; previous state: " +
-                                   std::get<1>(stateMap[previousEventState]);
-                }
+                std::format_to(out, " sends unsupported event state: {}",
+                               eventState);
+            }
+            if (auto previous =
+                    findState(component.states, previousEventState))
+            {
+                std::format_to(out, "; previous state: {}", previous->msg);
             }
         }
         else
         {
-            description += "sends unsupported component sensor offset " +
-                           std::to_string(sensorOffset);
+            std::format_to(out, "sends unsupported component sensor offset {}",
+                           sensorOffset);
         }
 
-        sendJournalRedfish(description, logLevel);
+        sendJournalRedfish(tid, sensorId, msgBuffer, logLevel);
     }
     else
     {
-        std::stringstream strStream;
-        description += "SENSOR_EVENT : STATE_SENSOR_STATE: ";
-        description += prefixMsgStrCreation(tid, sensorId);
-        strStream << std::setfill('0') << std::hex << "sensorOffset 0x"
-                  << std::setw(2) << static_cast<uint32_t>(sensorOffset)
-                  << "eventState 0x" << std::setw(2)
-                  << static_cast<uint32_t>(eventState)
-                  << " previousEventState 0x" << std::setw(2)
-                  << static_cast<uint32_t>(previousEventState) << std::dec;
-        description += strStream.str();
-        std::cout << description << "\n";
+        msgBuffer += "SENSOR_EVENT : STATE_SENSOR_STATE: ";
+        appendPrefix(tid, sensorId);
+        std::format_to(out,
+                       "sensorOffset 0x{:02x}eventState 0x{:02x} "
+                       "previousEventState 0x{:02x}",
+                       sensorOffset, eventState, previousEventState);
+        std::cout << msgBuffer << "\n";
     }
 
     return PLDM_SUCCESS;
@@ -549,17 +631,12 @@ int OemEventManager::processSensorOpStateEvent(
         return rc;
     }
 
-    std::string description;
-    std::stringstream strStream;
-
-    description += "SENSOR_EVENT : SENSOR_OP_STATE: ";
-    description += prefixMsgStrCreation(tid, sensorId);
-    strStream << std::setfill('0') << std::hex << "present_op_state 0x"
-              << std::setw(2) << static_cast<uint32_t>(present_op_state)
-              << "previous_op_state 0x" << std::setw(2)
-              << static_cast<uint32_t>(previous_op_state) << std::dec;
-    description += strStream.str();
-    std::cout << description << "\n";
+    msgBuffer.assign("SENSOR_EVENT : SENSOR_OP_STATE: ");
+    appendPrefix(tid, sensorId);
+    std::format_to(std::back_inserter(msgBuffer),
+                   "present_op_state 0x{:02x}previous_op_state 0x{:02x}",
+                   present_op_state, previous_op_state);
+    std::cout << msgBuffer << "\n";
 
     return PLDM_SUCCESS;
 }
@@ -569,7 +646,7 @@ int OemEventManager::handleSensorEvent(
     pldm_tid_t tid, size_t eventDataOffset)
 {
     /* This OEM event handler is only used for SoC terminus*/
-    if (!tidToSocketNameMap.contains(tid))
+    if (!findMsg(tidToSocketNameMap, tid))
     {
         return PLDM_SUCCESS;
     }
@@ -610,25 +687,17 @@ int OemEventManager::handleSensorEvent(
                                              sensorDataLength);
         }
         default:
-            std::string description;
-            std::stringstream strStream;
-
-            description += "SENSOR_EVENT : Unsupported Sensor Class " +
-                           std::to_string(sensorEventClassType) + ": ";
-            description += prefixMsgStrCreation(tid, sensorId);
-            strStream << std::setfill('0') << std::hex
-                      << std::setw(sizeof(sensorData) * 2) << "Sensor data: ";
-
-            auto dataPtr = sensorData;
-            for ([[maybe_unused]] const auto& i :
-                 std::views::iota(0, (int)sensorDataLength))
+            msgBuffer.clear();
+            auto out = std::back_inserter(msgBuffer);
+            std::format_to(out, "SENSOR_EVENT : Unsupported Sensor Class {}: ",
+                           sensorEventClassType);
+            appendPrefix(tid, sensorId);
+            msgBuffer += "Sensor data: ";
+            for (auto byte : std::span(sensorData, sensorDataLength))
             {
-                strStream << "0x" << static_cast<uint32_t>(*dataPtr);
-                dataPtr += sizeof(sensorData);
+                std::format_to(out, "0x{:x}", byte);
             }
-
-            description += strStream.str();
-            std::cout << description << "\n";
+            std::cout << msgBuffer << "\n";
     }
 
     return PLDM_ERROR;
@@ -637,91 +706,66 @@ int OemEventManager::handleSensorEvent(
 void OemEventManager::handlePCIeHotPlugEvent(pldm_tid_t tid, uint16_t sensorId,
                                              uint32_t presentReading)
 {
-    std::string description;
-    std::stringstream strStream;
     PCIeHotPlugEventRecord_t record{presentReading};
 
-    std::string sAction = (!record.bits.action) ? "Insertion" : "Removal";
-    std::string sOpStatus = (!record.bits.opStatus) ? "Successful" : "Failed";
+    std::string_view sAction = (!record.bits.action) ? "Insertion" : "Removal";
+    std::string_view sOpStatus =
+        (!record.bits.opStatus) ? "Successful" : "Failed";
     log_level logLevel =
         (!record.bits.opStatus) ? log_level::OK : log_level::WARNING;
 
-    description += prefixMsgStrCreation(tid, sensorId);
-
-    strStream << "Segment (0x" << std::setfill('0') << std::hex << std::setw(2)
-              << static_cast<uint32_t>(record.bits.segment) << "); Bus (0x"
-              << std::setw(2) << static_cast<uint32_t>(record.bits.bus)
-              << "); Device (0x" << std::setw(2)
-              << static_cast<uint32_t>(record.bits.device) << "); Function (0x"
-              << std::setw(2) << static_cast<uint32_t>(record.bits.function)
-              << "); Action (" << sAction << "); Operation status ("
-              << sOpStatus << "); Media slot number (" << std::dec
-              << static_cast<uint32_t>(record.bits.mediaSlot) << ")";
+    msgBuffer.clear();
+    appendPrefix(tid, sensorId);
 
-    description += strStream.str();
+    std::format_to(
+        std::back_inserter(msgBuffer),
+        "Segment (0x{:02x}); Bus (0x{:02x}); Device (0x{:02x}); Function "
+        "(0x{:02x}); Action ({}); Operation status ({}); Media slot number "
+        "({})",
+        static_cast<uint32_t>(record.bits.segment),
+        static_cast<uint32_t>(record.bits.bus),
+        static_cast<uint32_t>(record.bits.device),
+        static_cast<uint32_t>(record.bits.function), sAction, sOpStatus,
+        static_cast<uint32_t>(record.bits.mediaSlot));
 
     // Log to Redfish event
-    sendJournalRedfish(description, logLevel);
+    sendJournalRedfish(tid, sensorId, msgBuffer, logLevel);
 }
 
-std::string OemEventManager::dimmTrainingFailureToMsg(uint32_t failureInfo)
+void OemEventManager::appendDIMMTrainingFailure(uint32_t failureInfo)
 {
-    std::string description;
     DIMMTrainingFailure_t failure{failureInfo};
+    auto out = std::back_inserter(msgBuffer);
 
-    if (dimmTrainingFailureTypeMap.contains(failure.bits.type))
-    {
-        auto failureInfoMap = dimmTrainingFailureTypeMap[failure.bits.type];
-
-        description += std::get<0>(failureInfoMap);
-
-        description += "; MCU rank index " +
-                       std::to_string(failure.bits.mcuRankIdx);
-
-        description += "; Slice number " +
-                       std::to_string(failure.bits.sliceNum);
-
-        description += "; Upper nibble error status: ";
-        description += (!failure.bits.upperNibbStatErr)
-                           ? "No error"
-                           : "Found no rising edge";
-
-        description += "; Lower nibble error status: ";
-        description += (!failure.bits.lowerNibbStatErr)
-                           ? "No error"
-                           : "Found no rising edge";
-
-        description += "; Failure syndrome 0: ";
-
-        auto& syndromeMap = std::get<1>(failureInfoMap);
-        if (syndromeMap.contains(failure.bits.syndrome))
-        {
-            description += syndromeMap[failure.bits.syndrome];
-        }
-        else
-        {
-            description += "(Unknown syndrome)";
-        }
-    }
-    else
+    auto type = std::ranges::find(dimmTrainingFailureTypeMap,
+                                  static_cast<uint8_t>(failure.bits.type),
+                                  &TrainingFailureMsg::type);
+    if (type == dimmTrainingFailureTypeMap.end())
     {
-        description += "Unknown training failure type " +
-                       std::to_string(failure.bits.type);
+        std::format_to(out, "Unknown training failure type {}",
+                       static_cast<uint32_t>(failure.bits.type));
+        return;
     }
 
-    return description;
+    std::format_to(
+        out,
+        "{}; MCU rank index {}; Slice number {}; Upper nibble error status: "
+        "{}; Lower nibble error status: {}; Failure syndrome 0: {}",
+        type->msg, static_cast<uint32_t>(failure.bits.mcuRankIdx),
+        static_cast<uint32_t>(failure.bits.sliceNum),
+        (!failure.bits.upperNibbStatErr) ? "No error" : "Found no rising edge",
+        (!failure.bits.lowerNibbStatErr) ? "No error" : "Found no rising edge",
+        findMsg(type->syndromes, failure.bits.syndrome)
+            .value_or("(Unknown syndrome)"));
 }
 
 void OemEventManager::handleDIMMStatusEvent(pldm_tid_t tid, uint16_t sensorId,
                                             uint32_t presentReading)
 {
     log_level logLevel{log_level::WARNING};
-    std::string description;
     uint8_t byte3 = (presentReading & 0xff000000) >> 24;
     uint32_t byte012 = presentReading & 0xffffff;
 
-    description += prefixMsgStrCreation(tid, sensorId);
-
     // DIMMx_Status sensorID 4+2*index (index 0 -> maxDIMMInstantNum-1)
     auto dimmIdx = sensorIdToDIMMIdx(sensorId);
     if (dimmIdx >= maxDIMMIdxBitNum)
@@ -729,9 +773,12 @@ void OemEventManager::handleDIMMStatusEvent(pldm_tid_t tid, uint16_t sensorId,
         return;
     }
 
-    description += "DIMM " + std::to_string(dimmIdx) + " ";
+    msgBuffer.clear();
+    auto out = std::back_inserter(msgBuffer);
+    appendPrefix(tid, sensorId);
+    std::format_to(out, "DIMM {} ", dimmIdx);
 
-    if (dimmStatusToMsgMap.contains(byte3))
+    if (auto status = findMsg(dimmStatusToMsgMap, byte3))
     {
         if (byte3 == dimm_status::INSTALLED_NO_ERROR ||
             byte3 == dimm_status::INSTALLED_BUT_DISABLED)
@@ -739,18 +786,19 @@ void OemEventManager::handleDIMMStatusEvent(pldm_tid_t tid, uint16_t sensorId,
             logLevel = log_level::OK;
         }
 
-        description += dimmStatusToMsgMap[byte3];
+        msgBuffer += *status;
 
         if (byte3 == dimm_status::TRAINING_FAILURE)
         {
-            description += "; " + dimmTrainingFailureToMsg(byte012);
+            msgBuffer += "; ";
+            appendDIMMTrainingFailure(byte012);
         }
         else if (byte3 == dimm_status::PMIC_TEMP_ALERT)
         {
             uint8_t byte0 = (byte012 & 0xff);
             if (byte0 < pmicTempAlertMsg.size())
             {
-                description += ": " + pmicTempAlertMsg[byte0];
+                std::format_to(out, ": {}", pmicTempAlertMsg[byte0]);
             }
         }
     }
@@ -761,158 +809,157 @@ void OemEventManager::handleDIMMStatusEvent(pldm_tid_t tid, uint16_t sensorId,
             case dimm_status::PMIC_HIGH_TEMP:
                 if (byte012 == 0x01)
                 {
-                    description += "has PMIC high temp condition";
+                    msgBuffer += "has PMIC high temp condition";
                 }
                 break;
             case dimm_status::TSx_HIGH_TEMP:
                 switch (byte012)
                 {
                     case 0x01:
-                        description += "has TS0";
+                        msgBuffer += "has TS0";
                         break;
                     case 0x02:
-                        description += "has TS1";
+                        msgBuffer += "has TS1";
                         break;
                     case 0x03:
-                        description += "has TS0 and TS1";
+                        msgBuffer += "has TS0 and TS1";
                         break;
                 }
-                description += " exceeding their high temperature threshold";
+                msgBuffer += " exceeding their high temperature threshold";
                 break;
             case dimm_status::SPD_HUB_HIGH_TEMP:
                 if (byte012 == 0x01)
                 {
-                    description += "has SPD/HUB high temp condition";
+                    msgBuffer += "has SPD/HUB high temp condition";
                 }
                 break;
             default:
-                description += "has unsupported status " +
-                               std::to_string(byte3);
+                std::format_to(out, "has unsupported status {}", byte3);
                 break;
         }
     }
 
     // Log to Redfish event
-    sendJournalRedfish(description, logLevel);
+    sendJournalRedfish(tid, sensorId, msgBuffer, logLevel);
 }
 
 void OemEventManager::handleDDRStatusEvent(pldm_tid_t tid, uint16_t sensorId,
                                            uint32_t presentReading)
 {
     log_level logLevel{log_level::WARNING};
-    std::string description;
     uint8_t byte3 = (presentReading & 0xff000000) >> 24;
     uint32_t byte012 = presentReading & 0xffffff;
 
-    description += prefixMsgStrCreation(tid, sensorId);
+    msgBuffer.clear();
+    appendPrefix(tid, sensorId);
 
-    description += "DDR ";
-    if (ddrStatusToMsgMap.contains(byte3))
+    msgBuffer += "DDR ";
+    if (auto status = findMsg(ddrStatusToMsgMap, byte3))
     {
         if (byte3 == ddr_status::NO_SYSTEM_LEVEL_ERROR)
         {
             logLevel = log_level::OK;
         }
 
-        description += ddrStatusToMsgMap[byte3];
+        msgBuffer += *status;
 
         if (byte3 == ddr_status::CONFIGURATION_FAILURE ||
             byte3 == ddr_status::TRAINING_FAILURE)
         {
             // List out failed DIMMs
-            description += dimmIdxsToString(byte012);
+            appendDIMMIdxs(byte012);
         }
     }
     else
     {
-        description += "has unsupported status " + std::to_string(byte3);
+        std::format_to(std::back_inserter(msgBuffer),
+                       "has unsupported status {}", byte3);
     }
 
     // Log to Redfish event
-    sendJournalRedfish(description, logLevel);
+    sendJournalRedfish(tid, sensorId, msgBuffer, logLevel);
 }
 
 void OemEventManager::handleVRDStatusEvent(pldm_tid_t tid, uint16_t sensorId,
                                            uint32_t presentReading)
 {
     log_level logLevel{log_level::WARNING};
-    std::string description;
-    std::stringstream strStream;
-
-    description += prefixMsgStrCreation(tid, sensorId);
+    std::string_view condition;
 
     VRDStatus_t status{presentReading};
 
     if (status.bits.warning && status.bits.critical)
     {
-        description += "A VR warning and a VR critical";
+        condition = "A VR warning and a VR critical";
         logLevel = log_level::CRITICAL;
     }
     else
     {
         if (status.bits.warning)
         {
-            description += "A VR warning";
+            condition = "A VR warning";
         }
         else if (status.bits.critical)
         {
-            description += "A VR critical";
+            condition = "A VR critical";
             logLevel = log_level::CRITICAL;
         }
         else
         {
-            description += "No VR warning or critical";
+            condition = "No VR warning or critical";
             logLevel = log_level::OK;
         }
     }
-    description += " condition observed";
-
-    strStream << "; VR status byte high is 0x" << std::setfill('0') << std::hex
-              << std::setw(2)
-              << static_cast<uint32_t>(status.bits.vr_status_byte_high)
-              << "; VR status byte low is 0x" << std::setw(2)
-              << static_cast<uint32_t>(status.bits.vr_status_byte_low)
-              << "; Reading is 0x" << std::setw(2)
-              << static_cast<uint32_t>(presentReading) << ";";
 
-    description += strStream.str();
+    msgBuffer.clear();
+    appendPrefix(tid, sensorId);
+    std::format_to(std::back_inserter(msgBuffer),
+                   "{} condition observed; VR status byte high is 0x{:02x}; "
+                   "VR status byte low is 0x{:02x}; Reading is 0x{:02x};",
+                   condition,
+                   static_cast<uint32_t>(status.bits.vr_status_byte_high),
+                   static_cast<uint32_t>(status.bits.vr_status_byte_low),
+                   presentReading);
 
     // Log to Redfish event
-    sendJournalRedfish(description, logLevel);
+    sendJournalRedfish(tid, sensorId, msgBuffer, logLevel);
 }
 
 void OemEventManager::handleNumericWatchdogEvent(
     pldm_tid_t tid, uint16_t sensorId, uint32_t presentReading)
 {
-    std::string description;
     log_level logLevel = log_level::CRITICAL;
 
-    description += prefixMsgStrCreation(tid, sensorId);
+    msgBuffer.clear();
+    appendPrefix(tid, sensorId);
 
     if (presentReading & 0x01)
     {
-        description += "Global watchdog expired;";
+        msgBuffer += "Global watchdog expired;";
     }
     if (presentReading & 0x02)
     {
-        description += "Secure watchdog expired;";
+        msgBuffer += "Secure watchdog expired;";
     }
     if (presentReading & 0x04)
     {
-        description += "Non-secure watchdog expired;";
+        msgBuffer += "Non-secure watchdog expired;";
     }
 
     // Log to Redfish event
-    sendJournalRedfish(description, logLevel);
+    sendJournalRedfish(tid, sensorId, msgBuffer, logLevel);
 }
 
 int OemEventManager::processOemMsgPollEvent(pldm_tid_t tid, uint16_t eventId,
                                             const uint8_t* eventData,
                                             size_t eventDataSize)
 {
-    EFI_AMPERE_ERROR_DATA ampHdr;
+    EFI_AMPERE_ERROR_DATA ampHdr{};
 
-    decodeCperRecord(eventData, eventDataSize, &ampHdr);
+    if (!decodeCperRecord(eventData, eventDataSize, &ampHdr))
+    {
+        return PLDM_ERROR_INVALID_DATA;
+    }
 
     addCperSELLog(tid, eventId, &ampHdr);
 
@@ -947,7 +994,7 @@ int OemEventManager::handlepldmMessagePollEvent(
     pldm_tid_t tid, size_t eventDataOffset)
 {
     /* This OEM event handler is only used for SoC terminus*/
-    if (!tidToSocketNameMap.contains(tid))
+    if (!findMsg(tidToSocketNameMap, tid))
     {
         return PLDM_SUCCESS;
     }
@@ -966,6 +1013,11 @@ int OemEventManager::handlepldmMessagePollEvent(
         return rc;
     }
 
+    /* The SoC signals its events, the OEM polls only catch missed signals */
+    auto& pollState = pollStates[tid];
+    pollState.eventDriven = true;
+    pollState.interval = MAX_EVENT_POLLING_TIME;
+
     auto sensorID = poll_event.event_id;
     /* The UE errors */
     if (rasUESensorIDs.contains(sensorID))
@@ -989,30 +1041,60 @@ int OemEventManager::handlepldmMessagePollEvent(
     return PLDM_SUCCESS;
 }
 
+void OemEventManager::pollSoon(pldm_tid_t tid)
+{
+    pollStates[tid].interval = MIN_EVENT_POLLING_TIME;
+}
+
 exec::task<int> OemEventManager::oemPollForPlatformEvent(pldm_tid_t tid)
 {
     uint64_t t0 = 0;
 
     /* This OEM event handler is only used for SoC terminus */
-    if (!tidToSocketNameMap.contains(tid))
+    if (!findMsg(tidToSocketNameMap, tid))
     {
         co_return PLDM_SUCCESS;
     }
 
-    if (!timeStampMap.contains(tid))
+    sd_event_now(event.get(), CLOCK_MONOTONIC, &t0);
+    auto [it, inserted] = pollStates.try_emplace(tid);
+    auto& state = it->second;
+    if (inserted || !state.lastPoll)
     {
-        sd_event_now(event.get(), CLOCK_MONOTONIC, &t0);
-        timeStampMap.emplace(std::make_pair(tid, t0));
+        state.lastPoll = t0;
+        co_return PLDM_SUCCESS;
     }
-    else
+    if (t0 - state.lastPoll < state.interval)
     {
-        sd_event_now(event.get(), CLOCK_MONOTONIC, &t0);
-        uint64_t elapsed = t0 - timeStampMap[tid];
-        if (elapsed >= NORMAL_EVENT_POLLING_TIME)
+        co_return PLDM_SUCCESS;
+    }
+
+    /* The drained events are counted by the terminus */
+    auto drainedEvents = [this, tid]() -> uint64_t {
+        const auto& termini = manager->getTermini();
+        auto terminus = termini.find(tid);
+        if (terminus == termini.end() || !terminus->second)
         {
-            co_await manager->pollForPlatformEvent(tid, 0, 0);
-            timeStampMap[tid] = t0;
+            return 0;
         }
+        return terminus->second->polledEventStats.events;
+    };
+    auto before = drainedEvents();
+    co_await manager->drainPlatformEvents(tid);
+    state.lastPoll = t0;
+
+    if (drainedEvents() != before)
+    {
+        state.interval = MIN_EVENT_POLLING_TIME;
+    }
+    else if (state.eventDriven)
+    {
+        state.interval = MAX_EVENT_POLLING_TIME;
+    }
+    else
+    {
+        state.interval = std::min<uint64_t>(state.interval * 2,
+                                            MAX_EVENT_POLLING_TIME);
     }
 
     co_return PLDM_SUCCESS;
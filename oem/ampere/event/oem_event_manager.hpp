@@ -9,14 +9,35 @@
 
 #include <libpldm/pldm.h>
 
+#include <string>
+
 namespace pldm
 {
 namespace oem_ampere
 {
 using namespace pldm::pdr;
-#define NORMAL_EVENT_POLLING_TIME 5000000 // ms
-
-using EventToMsgMap_t = std::unordered_map<uint8_t, std::string>;
+#define NORMAL_EVENT_POLLING_TIME 5000000 // us
+/* Interval after an event or a boot progress, bounded by the sensor polling
+ * interval which drives the OEM polls */
+#define MIN_EVENT_POLLING_TIME 500000 // us
+/* Interval the idle polls back off to */
+#define MAX_EVENT_POLLING_TIME 60000000 // us
+
+/** @struct OemPollState
+ *
+ *  OEM polling state of a SoC terminus. The interval drops to
+ *  MIN_EVENT_POLLING_TIME when events arrive or the SoC boots, and doubles
+ *  up to MAX_EVENT_POLLING_TIME with each poll finding no event. Once the
+ *  SoC signals its events with pldmMessagePollEvent, an empty poll goes
+ *  back to MAX_EVENT_POLLING_TIME at once, the polls only catch missed
+ *  signals.
+ */
+struct OemPollState
+{
+    uint64_t lastPoll = 0; //!< monotonic time of the last poll, us
+    uint64_t interval = NORMAL_EVENT_POLLING_TIME; //!< time between polls, us
+    bool eventDriven = false; //!< the SoC sent a pldmMessagePollEvent
+};
 
 enum sensor_ids
 {
@@ -295,14 +316,12 @@ class OemEventManager
     exec::task<int> oemPollForPlatformEvent(pldm_tid_t tid);
 
   protected:
-    /** @brief Create prefix string for logging message.
+    /** @brief Append the prefix of a logging message to msgBuffer.
      *
      *  @param[in] tid - TID
      *  @param[in] sensorId - Sensor ID
-     *
-     *  @return std::string - the prefeix string
      */
-    std::string prefixMsgStrCreation(pldm_tid_t tid, uint16_t sensorId);
+    void appendPrefix(pldm_tid_t tid, uint16_t sensorId);
 
     /** @brief Log the message into Redfish SEL.
      *
@@ -310,16 +329,26 @@ class OemEventManager
      *  @param[in] logLevel - the logging level
      */
     void sendJournalRedfish(const std::string& description,
-                            log_level& logLevel);
+                            log_level logLevel);
 
-    /** @brief Convert the one-hot DIMM index byte into a string of DIMM
-     * indexes.
+    /** @brief Log the message of an event of a sensor into Redfish SEL, the
+     *         repeated events of the sensor at a level are summarized
      *
-     *  @param[in] dimmIdxs - the one-hot DIMM index byte
+     *  @param[in] tid - TID
+     *  @param[in] sensorId - Sensor ID
+     *  @param[in] description - the logging message
+     *  @param[in] logLevel - the logging level
+     */
+    void sendJournalRedfish(pldm_tid_t tid, uint16_t sensorId,
+                            const std::string& description,
+                            log_level logLevel);
+
+    /** @brief Append the DIMM indexes of a one-hot DIMM index byte to
+     * msgBuffer.
      *
-     *  @return std::string - the string of DIMM indexes
+     *  @param[in] dimmIdxs - the one-hot DIMM index byte
      */
-    std::string dimmIdxsToString(uint32_t dimmIdxs);
+    void appendDIMMIdxs(uint32_t dimmIdxs);
 
     /** @brief Convert sensor ID to DIMM index. Return maxDIMMInstantNum
      * in failure.
@@ -330,13 +359,19 @@ class OemEventManager
      */
     uint8_t sensorIdToDIMMIdx(const uint16_t& sensorId);
 
-    /** @brief Convert the DIMM training failure into logging string.
+    /** @brief Append the logging string of a DIMM training failure to
+     * msgBuffer.
      *
-     *  @param[in] failureInfo - the one-hot DIMM index byte
+     *  @param[in] failureInfo - the DIMM training failure information
+     */
+    void appendDIMMTrainingFailure(uint32_t failureInfo);
+
+    /** @brief Poll a SoC terminus at the shortest interval, events are
+     *  expected.
      *
-     *  @return std::string - the returned logging string
+     *  @param[in] tid - TID
      */
-    std::string dimmTrainingFailureToMsg(uint32_t failureInfo);
+    void pollSoon(pldm_tid_t tid);
 
     /** @brief Handle numeric sensor event message from PCIe hot-plug sensor.
      *
@@ -353,7 +388,7 @@ class OemEventManager
      *  @param[in] sensorId - Sensor ID
      *  @param[in] presentReading - the present reading of the sensor
      */
-    void handleBootOverallEvent(pldm_tid_t /*tid*/, uint16_t /*sensorId*/,
+    void handleBootOverallEvent(pldm_tid_t tid, uint16_t /*sensorId*/,
                                 uint32_t presentReading);
 
     /** @brief Handle numeric sensor event message from DIMM status sensor.
@@ -436,11 +471,16 @@ class OemEventManager
      */
     sdeventplus::Event& event;
 
-    /** @brief Latest OEM PollForPlatformEvent message timeStamp. */
-    std::map<pldm_tid_t, uint64_t> timeStampMap;
+    /** @brief OEM PollForPlatformEvent state of the SoC termini. */
+    std::map<pldm_tid_t, OemPollState> pollStates;
 
     /** @brief A Manager interface for calling the hook functions */
     platform_mc::Manager* manager;
+
+    /** @brief Buffer the logging messages are formatted into, reused across
+     *  the events
+     */
+    std::string msgBuffer;
 };
 } // namespace oem_ampere
 } // namespace pldm
@@ -0,0 +1,195 @@
+#include "oem/ampere/event/cper.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::oem_ampere;
+
+/** @brief Builds the CPER event data of a record */
+class CperRecord
+{
+  public:
+    CperRecord()
+    {
+        data.resize(sizeof(CommonEventData) +
+                    sizeof(EFI_COMMON_ERROR_RECORD_HEADER));
+    }
+
+    /** @brief Add a section, the descriptors are written by event() */
+    void addSection(const EFI_GUID& type, const std::vector<uint8_t>& body)
+    {
+        sections.emplace_back(type, body);
+    }
+
+    /** @brief Get the event data, a section length is set to length when
+     *         not 0
+     */
+    std::vector<uint8_t> event(uint32_t length = 0) const
+    {
+        auto eventData = data;
+        EFI_COMMON_ERROR_RECORD_HEADER header{};
+        header.SectionCount = static_cast<uint16_t>(sections.size());
+        std::memcpy(eventData.data() + sizeof(CommonEventData), &header,
+                    sizeof(header));
+
+        size_t offset = sizeof(EFI_COMMON_ERROR_RECORD_HEADER) +
+                        sections.size() * sizeof(EFI_ERROR_SECTION_DESCRIPTOR);
+        for (const auto& [type, body] : sections)
+        {
+            EFI_ERROR_SECTION_DESCRIPTOR desc{};
+            desc.SectionType = type;
+            desc.SectionOffset = offset;
+            desc.SectionLength = length ? length : body.size();
+            auto bytes = reinterpret_cast<const uint8_t*>(&desc);
+            eventData.insert(eventData.end(), bytes, bytes + sizeof(desc));
+            offset += body.size();
+        }
+        for (const auto& section : sections)
+        {
+            eventData.insert(eventData.end(), section.second.begin(),
+                             section.second.end());
+        }
+        return eventData;
+    }
+
+  private:
+    std::vector<uint8_t> data;
+    std::vector<std::pair<EFI_GUID, std::vector<uint8_t>>> sections;
+};
+
+template <typename T>
+static std::vector<uint8_t> bytesOf(const T& value)
+{
+    auto bytes = reinterpret_cast<const uint8_t*>(&value);
+    return {bytes, bytes + sizeof(T)};
+}
+
+static EFI_AMPERE_ERROR_DATA ampereData()
+{
+    EFI_AMPERE_ERROR_DATA ampere{};
+    ampere.TypeId = 0x1234;
+    ampere.SubtypeId = 0x56;
+    return ampere;
+}
+
+TEST(CperRecord, truncatedRecordRejected)
+{
+    EFI_AMPERE_ERROR_DATA hdr{};
+    std::vector<uint8_t> event(sizeof(CommonEventData) - 1);
+    EXPECT_FALSE(decodeCperRecord(event.data(), event.size(), &hdr));
+
+    CperRecord record;
+    record.addSection(gEfiAmpereErrorSectionGuid, bytesOf(ampereData()));
+    event = record.event();
+    // The section descriptor is cut
+    auto size = sizeof(CommonEventData) +
+                sizeof(EFI_COMMON_ERROR_RECORD_HEADER) +
+                sizeof(EFI_ERROR_SECTION_DESCRIPTOR) - 1;
+    EXPECT_FALSE(decodeCperRecord(event.data(), size, &hdr));
+    EXPECT_TRUE(decodeCperRecord(event.data(), event.size(), &hdr));
+}
+
+TEST(CperRecord, ampereSectionCopied)
+{
+    CperRecord record;
+    record.addSection(gEfiAmpereErrorSectionGuid, bytesOf(ampereData()));
+    auto event = record.event();
+
+    EFI_AMPERE_ERROR_DATA hdr{};
+    ASSERT_TRUE(decodeCperRecord(event.data(), event.size(), &hdr));
+    EXPECT_EQ(hdr.TypeId, 0x1234);
+    EXPECT_EQ(hdr.SubtypeId, 0x56);
+}
+
+TEST(CperRecord, sectionOutsideRecordSkipped)
+{
+    CperRecord record;
+    record.addSection(gEfiAmpereErrorSectionGuid, bytesOf(ampereData()));
+    auto event = record.event(sizeof(EFI_AMPERE_ERROR_DATA) + 1);
+
+    EFI_AMPERE_ERROR_DATA hdr{};
+    ASSERT_TRUE(decodeCperRecord(event.data(), event.size(), &hdr));
+    EXPECT_EQ(hdr.TypeId, 0);
+    EXPECT_EQ(hdr.SubtypeId, 0);
+
+    // The section is cut, it is shorter than the Ampere data
+    CperRecord shortRecord;
+    auto body = bytesOf(ampereData());
+    body.pop_back();
+    shortRecord.addSection(gEfiAmpereErrorSectionGuid, body);
+    event = shortRecord.event();
+    ASSERT_TRUE(decodeCperRecord(event.data(), event.size(), &hdr));
+    EXPECT_EQ(hdr.TypeId, 0);
+}
+
+TEST(CperRecord, pcieSectionDecoded)
+{
+    EFI_PCIE_ERROR_DATA pcie{};
+    pcie.ValidFields = CPER_PCIE_VALID_PORT_TYPE;
+    pcie.PortType = CPER_PCIE_PORT_TYPE_ROOT_PORT;
+    CperRecord record;
+    record.addSection(gEfiAmpereErrorSectionGuid, bytesOf(ampereData()));
+    record.addSection(gEfiPcieErrorSectionGuid, bytesOf(pcie));
+    auto event = record.event();
+
+    EFI_AMPERE_ERROR_DATA hdr{};
+    ASSERT_TRUE(decodeCperRecord(event.data(), event.size(), &hdr));
+    EXPECT_EQ(hdr.TypeId, 0x1234);
+    EXPECT_EQ(hdr.SubtypeId, ERROR_SUBTYPE_PCIE_AER_ROOT_PORT);
+
+    // The PCIe data is not all in the section
+    auto body = bytesOf(pcie);
+    body.pop_back();
+    CperRecord shortRecord;
+    shortRecord.addSection(gEfiPcieErrorSectionGuid, body);
+    event = shortRecord.event();
+    hdr.SubtypeId = ERROR_SUBTYPE_PCIE_AER_DEVICE;
+    ASSERT_TRUE(decodeCperRecord(event.data(), event.size(), &hdr));
+    EXPECT_EQ(hdr.SubtypeId, ERROR_SUBTYPE_PCIE_AER_DEVICE);
+}
+
+/** @brief ARM processor section with a context and the Ampere data */
+static std::vector<uint8_t> armSection(uint32_t registerArraySize)
+{
+    EFI_ARM_ERROR_RECORD proc{};
+    proc.ErrInfoNum = 1;
+    proc.ContextInfoNum = 1;
+    EFI_ARM_CONTEXT_INFORMATION_HEADER ctx{};
+    ctx.RegisterArraySize = registerArraySize;
+
+    auto section = bytesOf(proc);
+    section.resize(section.size() + sizeof(EFI_ARM_ERROR_INFORMATION_ENTRY));
+    auto ctxBytes = bytesOf(ctx);
+    section.insert(section.end(), ctxBytes.begin(), ctxBytes.end());
+    section.resize(section.size() + 16);
+    auto ampere = bytesOf(ampereData());
+    section.insert(section.end(), ampere.begin(), ampere.end());
+
+    auto length = static_cast<uint32_t>(section.size());
+    std::memcpy(section.data() + offsetof(EFI_ARM_ERROR_RECORD, SectionLength),
+                &length, sizeof(length));
+    return section;
+}
+
+TEST(CperRecord, armContextsChecked)
+{
+    CperRecord record;
+    record.addSection(gEfiArmProcessorErrorSectionGuid, armSection(16));
+    auto event = record.event();
+
+    EFI_AMPERE_ERROR_DATA hdr{};
+    ASSERT_TRUE(decodeCperRecord(event.data(), event.size(), &hdr));
+    EXPECT_EQ(hdr.TypeId, 0x1234);
+    EXPECT_EQ(hdr.SubtypeId, 0x56);
+
+    // The register array exceeds the section
+    CperRecord badRecord;
+    badRecord.addSection(gEfiArmProcessorErrorSectionGuid, armSection(4096));
+    event = badRecord.event();
+    hdr = {};
+    ASSERT_TRUE(decodeCperRecord(event.data(), event.size(), &hdr));
+    EXPECT_EQ(hdr.TypeId, 0);
+}
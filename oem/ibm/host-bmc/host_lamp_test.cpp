@@ -111,10 +111,10 @@ uint8_t HostLampTest::setHostStateEffecter(uint16_t effecterID)
     constexpr uint8_t effecterCount = 1;
     auto instanceId = instanceIdDb.next(mctp_eid);
 
-    std::vector<uint8_t> requestMsg(
+    RequestMsg requestMsg(
         sizeof(pldm_msg_hdr) + sizeof(effecterID) + sizeof(effecterCount) +
         sizeof(set_effecter_state_field));
-    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    auto request = requestMsg.msg();
     set_effecter_state_field stateField{PLDM_REQUEST_SET,
                                         PLDM_STATE_SET_IDENTIFY_STATE_ASSERTED};
     auto rc = encode_set_state_effecter_states_req(
@@ -4,6 +4,8 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+
 PHOSPHOR_LOG2_USING;
 
 namespace pldm
@@ -13,28 +15,52 @@ namespace responder
 using namespace oem_ibm_platform;
 void SlotHandler::timeOutHandler()
 {
-    info(
-        "Timer expired waiting for Event from Inventory on following pldm_entity: [ {ENTITY_TYP}, {ENTITY_NUM}, {ENTITY_ID} ]",
-        "ENTITY_TYP",
-        static_cast<unsigned>(currentOnGoingSlotEntity.entity_type),
-        "ENTITY_NUM",
-        static_cast<unsigned>(currentOnGoingSlotEntity.entity_instance_num),
-        "ENTITY_ID",
-        static_cast<unsigned>(currentOnGoingSlotEntity.entity_container_id));
-    // Disable the timer
-    timer.setEnabled(false);
-
-    // obtain the sensor Id
-    auto sensorId = pldm::utils::findStateSensorId(
-        pdrRepo, 0, PLDM_ENTITY_SLOT,
-        currentOnGoingSlotEntity.entity_instance_num,
-        currentOnGoingSlotEntity.entity_container_id,
-        PLDM_OEM_IBM_PCIE_SLOT_SENSOR_STATE);
-
-    // send the sensor event to host with error state
-    sendStateSensorEvent(sensorId, PLDM_STATE_SENSOR_STATE, 0,
-                         PLDM_OEM_IBM_PCIE_SLOT_SENSOR_STATE_ERROR,
-                         PLDM_OEM_IBM_PCIE_SLOT_SENSOR_STATE_UNKOWN);
+    auto now = std::chrono::steady_clock::now();
+    for (auto it = slotOperations.begin(); it != slotOperations.end();)
+    {
+        if (it->second.deadline > now)
+        {
+            ++it;
+            continue;
+        }
+        auto entity = it->second.entity;
+        it = slotOperations.erase(it);
+
+        info(
+            "Timer expired waiting for Event from Inventory on following pldm_entity: [ {ENTITY_TYP}, {ENTITY_NUM}, {ENTITY_ID} ]",
+            "ENTITY_TYP", static_cast<unsigned>(entity.entity_type),
+            "ENTITY_NUM", static_cast<unsigned>(entity.entity_instance_num),
+            "ENTITY_ID", static_cast<unsigned>(entity.entity_container_id));
+
+        // obtain the sensor Id
+        auto sensorId = pldm::utils::findStateSensorId(
+            pdrRepo, 0, PLDM_ENTITY_SLOT, entity.entity_instance_num,
+            entity.entity_container_id, PLDM_OEM_IBM_PCIE_SLOT_SENSOR_STATE);
+
+        // send the sensor event to host with error state
+        sendStateSensorEvent(sensorId, PLDM_STATE_SENSOR_STATE, 0,
+                             PLDM_OEM_IBM_PCIE_SLOT_SENSOR_STATE_ERROR,
+                             PLDM_OEM_IBM_PCIE_SLOT_SENSOR_STATE_UNKOWN);
+    }
+    restartTimer();
+}
+
+void SlotHandler::restartTimer()
+{
+    if (slotOperations.empty())
+    {
+        timer.setEnabled(false);
+        fruPresenceMatch = nullptr;
+        return;
+    }
+
+    auto earliest = std::ranges::min_element(
+        slotOperations, {},
+        [](const auto& operation) { return operation.second.deadline; });
+    auto now = std::chrono::steady_clock::now();
+    timer.restartOnce(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::max(earliest->second.deadline - now,
+                 std::chrono::steady_clock::duration::zero())));
 }
 
 void SlotHandler::enableSlot(uint16_t effecterId,
@@ -52,11 +78,6 @@ void SlotHandler::enableSlot(uint16_t effecterId,
             entity.entity_type == value.entity_type &&
             entity.entity_container_id == value.entity_container_id)
         {
-            this->currentOnGoingSlotEntity.entity_type = value.entity_type;
-            this->currentOnGoingSlotEntity.entity_instance_num =
-                value.entity_instance_num;
-            this->currentOnGoingSlotEntity.entity_container_id =
-                value.entity_container_id;
             processSlotOperations(key, value, stateFileValue);
         }
     }
@@ -85,14 +106,21 @@ void SlotHandler::processSlotOperations(const std::string& slotObjectPath,
     info(
         "CM: Found an adapter under the slot, adapter object:{ADAPTER_OBJ_PATH}",
         "ADAPTER_OBJ_PATH", adapterObjPath);
-    // create a presence match for the adpter present property
-    createPresenceMatch(adapterObjPath, entity, stateFieldValue);
+    // wait for the adapter present property, a new operation on the slot
+    // replaces the one in progress
+    slotOperations.insert_or_assign(
+        adapterObjPath,
+        SlotOperation{entity, stateFieldValue,
+                      std::chrono::steady_clock::now() + slotOperationTimeout});
+    createPresenceMatch();
 
     // call the VPD Manager to collect/remove VPD objects
     callVPDManager(adapterObjPath, stateFieldValue);
 
-    // start the 1 min timer
-    timer.restart(std::chrono::seconds(60));
+    if (!timer.isEnabled())
+    {
+        restartTimer();
+    }
 }
 
 void SlotHandler::callVPDManager(const std::string& adapterObjPath,
@@ -153,16 +181,22 @@ std::optional<std::string> SlotHandler::getAdapterObjPath(
     return std::nullopt;
 }
 
-void SlotHandler::createPresenceMatch(const std::string& adapterObjectPath,
-                                      const pldm_entity& entity,
-                                      uint8_t stateFieldValue)
+void SlotHandler::createPresenceMatch()
 {
+    if (fruPresenceMatch)
+    {
+        return;
+    }
     fruPresenceMatch = std::make_unique<sdbusplus::bus::match_t>(
         pldm::utils::DBusHandler::getBus(),
-        propertiesChanged(adapterObjectPath,
-                          "xyz.openbmc_project.Inventory.Item"),
-        [this, adapterObjectPath, stateFieldValue,
-         entity](sdbusplus::message_t& msg) {
+        propertiesChangedNamespace("/xyz/openbmc_project/inventory",
+                                   "xyz.openbmc_project.Inventory.Item"),
+        [this](sdbusplus::message_t& msg) {
+            std::string adapterObjectPath = msg.get_path();
+            if (!slotOperations.contains(adapterObjectPath))
+            {
+                return;
+            }
             pldm::utils::DbusChangedProps props{};
             std::string intf;
             msg.read(intf, props);
@@ -171,22 +205,31 @@ void SlotHandler::createPresenceMatch(const std::string& adapterObjectPath,
             {
                 bool value = std::get<bool>(itr->second);
                 // Present Property is found
-                this->processPresentPropertyChange(value, stateFieldValue,
-                                                   entity);
+                this->processPresentPropertyChange(value, adapterObjectPath);
             }
         });
 }
 
 void SlotHandler::processPresentPropertyChange(
-    bool presentValue, uint8_t stateFiledvalue, const pldm_entity& entity)
+    bool presentValue, const std::string& adapterObjectPath)
 {
-    // irrespective of true->false or false->true change, we should stop the
-    // timer
-    timer.setEnabled(false);
+    // irrespective of true->false or false->true change, the operation on
+    // the slot is complete
+    auto it = slotOperations.find(adapterObjectPath);
+    if (it == slotOperations.end())
+    {
+        return;
+    }
+    auto entity = it->second.entity;
+    auto stateFiledvalue = it->second.stateFieldValue;
+    slotOperations.erase(it);
 
-    // remove the prence match so that it does not monitor the change
-    // even after we captured the property changed signal
-    fruPresenceMatch = nullptr;
+    // stop the timer and remove the presence match once no operation is
+    // left, so that they do not monitor the change any more
+    if (slotOperations.empty())
+    {
+        restartTimer();
+    }
 
     // obtain the sensor id attached with this slot
     auto sensorId = pldm::utils::findStateSensorId(
@@ -9,7 +9,12 @@
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/utility/timer.hpp>
 
+#include <chrono>
+#include <map>
 #include <memory>
+#include <string>
+
+class TestSlotHandler;
 
 namespace pldm
 {
@@ -22,12 +27,18 @@ namespace responder
 using ObjectPath = std::string;
 using AssociatedEntityMap = std::map<ObjectPath, pldm_entity>;
 
+/** @brief Time given to the inventory to update an adapter */
+constexpr auto slotOperationTimeout = std::chrono::seconds(60);
+
 /** @class SlotHandler
  *
  *  @brief This class performs the necessary operation in pldm for
  *         Slot Enable operation. That includes taking actions on the
  *         setStateEffecterStates calls from Host and also sending
  *         notification to inventory manager application
+ *
+ *         The operations on several slots proceed in parallel, each waits
+ *         for the Present property of its adapter until its own deadline.
  */
 class SlotHandler
 {
@@ -51,9 +62,6 @@ class SlotHandler
         pdrRepo(repo)
     {
         fruPresenceMatch = nullptr;
-        currentOnGoingSlotEntity.entity_type = 0;
-        currentOnGoingSlotEntity.entity_instance_num = 0;
-        currentOnGoingSlotEntity.entity_container_id = 0;
     }
 
     /** @brief Method to be called when enabling a Slot for ADD/REMOVE/REPLACE
@@ -79,11 +87,27 @@ class SlotHandler
     void setOemPlatformHandler(pldm::responder::oem_platform::Handler* handler);
 
   private:
+    friend class ::TestSlotHandler;
+
+    /** @brief Slot operation waiting for the inventory to update the adapter
+     */
+    struct SlotOperation
+    {
+        pldm_entity entity;      //!< slot pldm entity under operation
+        uint8_t stateFieldValue; //!< effecter stateFieldValue of operation
+        std::chrono::steady_clock::time_point deadline; //!< end of the wait
+    };
+
     /** @brief call back method called when the timer is expired. This handler
-     *  is called when the change of state cannot be made for a slot.
+     *  is called when the change of state cannot be made for the slots whose
+     *  operation reached its deadline.
      */
     void timeOutHandler();
 
+    /** @brief Arm the timer for the earliest deadline of the slot operations
+     */
+    void restartTimer();
+
     /** @brief Abstracted method for obtaining the entityID from effecterID
      *  @param[in]  effecterID - The effecterID of the BMC effecter
      *  @return - pldm entity ID for the given effecter ID
@@ -115,24 +139,17 @@ class SlotHandler
     void callVPDManager(const std::string& adapterObjPath,
                         uint8_t stateFieldValue);
 
-    /** @brief Method to create a matcher to catch the property change signal
-     *  @param[in] adapterObjectPath - The adapter D-Bus object path
-     *  @param[in] stateFieldvalue - The current stateField value from set
-     *                               effecter call
-     *  @param[in] entity - the current slot pldm entity under operation
+    /** @brief Method to create the matcher catching the property change
+     *  signals of the adapters, shared by the slot operations in progress
      */
-    void createPresenceMatch(const std::string& adapterObjectPath,
-                             const pldm_entity& entity,
-                             uint8_t stateFieldValue);
+    void createPresenceMatch();
 
     /** @brief Method to process the Property change signal from Preset Property
      *  @param[in] presentValue - The current value of present Value
-     *  @param[in] stateFieldvalue - The current stateField value from set
-     *                               effecter call
-     *  @param[in] entity - the current slot pldm entity under operation
+     *  @param[in] adapterObjectPath - The adapter D-Bus object path
      */
-    void processPresentPropertyChange(
-        bool presentValue, uint8_t stateFieldvalue, const pldm_entity& entity);
+    void processPresentPropertyChange(bool presentValue,
+                                      const std::string& adapterObjectPath);
 
     /** @brief Get the sensor state from D-Bus
      *  @param[in] adapterObjectPath - reference of the Adapter dbus object path
@@ -156,17 +173,19 @@ class SlotHandler
     pldm::responder::oem_platform::Handler* oemPlatformHandler =
         nullptr; //!< oem platform handler
 
-    /** @brief pointer to tha matcher for Present State for adapter object*/
+    /** @brief pointer to tha matcher for Present State for adapter objects,
+     *  installed while slot operations are in progress
+     */
     std::unique_ptr<sdbusplus::bus::match_t> fruPresenceMatch;
 
-    /** @brief Timer used for Slot VPD Collection operation */
+    /** @brief Timer of the earliest deadline of the slot operations */
     sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer;
 
     /** @brief pointer to BMC's primary PDR repo */
     const pldm_pdr* pdrRepo;
 
-    /** @brief variable to store the current slot entity under operation */
-    pldm_entity currentOnGoingSlotEntity;
+    /** @brief Slot operations in progress, by adapter D-Bus object path */
+    std::map<std::string, SlotOperation> slotOperations;
 };
 
 } // namespace responder
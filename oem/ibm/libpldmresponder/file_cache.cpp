@@ -0,0 +1,216 @@
+#include "file_cache.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+
+CachedFile::~CachedFile()
+{
+    if (mapping)
+    {
+        munmap(mapping, size());
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+}
+
+int CachedFile::read(uint32_t offset, uint32_t length, char* data) const
+{
+    if (mapping)
+    {
+        memcpy(data, static_cast<const char*>(mapping) + offset, length);
+        return 0;
+    }
+
+    size_t done = 0;
+    while (done < length)
+    {
+        auto rc = pread(fd, data + done, length - done, offset + done);
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -errno;
+        }
+        if (rc == 0)
+        {
+            // The file was truncated since it was checked
+            return -EIO;
+        }
+        done += rc;
+    }
+    return 0;
+}
+
+int CachedFile::write(uint32_t offset, const char* data, uint32_t length)
+{
+    size_t done = 0;
+    while (done < length)
+    {
+        auto rc = pwrite(fd, data + done, length - done, offset + done);
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -errno;
+        }
+        done += rc;
+    }
+
+    // Keep the file matching its path, the write changed its size and time
+    if (fstat(fd, &st) < 0)
+    {
+        return -errno;
+    }
+    return 0;
+}
+
+void CachedFile::map()
+{
+    if (mapping || writable || !size())
+    {
+        return;
+    }
+    auto mem = mmap(nullptr, size(), PROT_READ, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == mem)
+    {
+        error("Failed to mmap file of size '{SIZE}', error number - {ERRNO}",
+              "SIZE", size(), "ERRNO", errno);
+        return;
+    }
+    mapping = mem;
+}
+
+bool CachedFile::matches(const struct stat& current) const
+{
+    return current.st_dev == st.st_dev && current.st_ino == st.st_ino &&
+           current.st_size == st.st_size &&
+           current.st_mtim.tv_sec == st.st_mtim.tv_sec &&
+           current.st_mtim.tv_nsec == st.st_mtim.tv_nsec;
+}
+
+FileCache& FileCache::get()
+{
+    static FileCache cache;
+    return cache;
+}
+
+FileCache::FileCache() :
+    timer(sdeventplus::Event::get_default(), [this](auto&) { evictIdle(); })
+{}
+
+std::shared_ptr<CachedFile> FileCache::open(const fs::path& path,
+                                            bool writable, bool mapped)
+{
+    struct stat current{};
+    if (stat(path.c_str(), &current) < 0)
+    {
+        auto savedErrno = errno;
+        files.erase(path);
+        errno = savedErrno;
+        return nullptr;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    auto it = files.find(path);
+    if (it != files.end() && it->second->matches(current) &&
+        (it->second->writable || !writable))
+    {
+        auto file = it->second;
+        file->lastUse = now;
+        if (mapped)
+        {
+            file->map();
+        }
+        return file;
+    }
+
+    auto fd = ::open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+    if (fstat(fd, &current) < 0)
+    {
+        auto savedErrno = errno;
+        close(fd);
+        errno = savedErrno;
+        return nullptr;
+    }
+
+    // Files still used by a request are released when it completes
+    files.erase(path);
+    if (files.size() >= maxCachedFiles)
+    {
+        evictOldest();
+    }
+
+    auto file = std::make_shared<CachedFile>(fd, writable, current);
+    file->lastUse = now;
+    if (mapped)
+    {
+        file->map();
+    }
+    files.emplace(path, file);
+
+    if (!timer.isEnabled())
+    {
+        timer.restartOnce(fileCacheIdleTimeout);
+    }
+    return file;
+}
+
+void FileCache::clear()
+{
+    files.clear();
+    timer.setEnabled(false);
+}
+
+void FileCache::evictIdle()
+{
+    auto now = std::chrono::steady_clock::now();
+    std::erase_if(files, [now](const auto& entry) {
+        return now - entry.second->lastUse >= fileCacheIdleTimeout;
+    });
+
+    if (!files.empty())
+    {
+        auto oldest = std::ranges::min_element(
+            files, {}, [](const auto& entry) { return entry.second->lastUse; });
+        timer.restartOnce(std::chrono::duration_cast<std::chrono::microseconds>(
+            oldest->second->lastUse + fileCacheIdleTimeout - now));
+    }
+}
+
+void FileCache::evictOldest()
+{
+    auto oldest = std::ranges::min_element(
+        files, {}, [](const auto& entry) { return entry.second->lastUse; });
+    if (oldest != files.end())
+    {
+        files.erase(oldest);
+    }
+}
+
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <sys/stat.h>
+
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace pldm
+{
+namespace responder
+{
+
+namespace fs = std::filesystem;
+
+/** @brief Time after which a file not accessed is closed */
+constexpr auto fileCacheIdleTimeout = std::chrono::seconds(30);
+
+/** @brief Maximum number of files kept open */
+constexpr size_t maxCachedFiles = 16;
+
+/** @class CachedFile
+ *
+ *  File kept open by the FileCache, read with pread or from its mapping and
+ *  written with pwrite, without moving a file offset.
+ */
+class CachedFile
+{
+  public:
+    CachedFile(const CachedFile&) = delete;
+    CachedFile(CachedFile&&) = delete;
+    CachedFile& operator=(const CachedFile&) = delete;
+    CachedFile& operator=(CachedFile&&) = delete;
+
+    /** @brief Take ownership of an open file
+     *
+     *  @param[in] fd - file descriptor
+     *  @param[in] writable - true if fd is open for writing
+     *  @param[in] st - status of fd
+     */
+    CachedFile(int fd, bool writable, const struct stat& st) :
+        fd(fd), writable(writable), st(st)
+    {}
+
+    ~CachedFile();
+
+    /** @brief Size of the file when it was last checked */
+    size_t size() const
+    {
+        return st.st_size;
+    }
+
+    /** @brief Read from the file
+     *
+     *  @param[in] offset - offset to read from
+     *  @param[in] length - number of bytes to read, within the file
+     *  @param[out] data - buffer of length bytes
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    int read(uint32_t offset, uint32_t length, char* data) const;
+
+    /** @brief Write to the file
+     *
+     *  @param[in] offset - offset to write at
+     *  @param[in] data - data to write
+     *  @param[in] length - number of bytes to write
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    int write(uint32_t offset, const char* data, uint32_t length);
+
+  private:
+    friend class FileCache;
+
+    /** @brief Map a read only file, reads fall back to pread on failure */
+    void map();
+
+    /** @brief Check if the file at the path is still this file, unchanged
+     *
+     *  @param[in] current - status of the path
+     */
+    bool matches(const struct stat& current) const;
+
+    int fd = -1;
+    bool writable = false;
+    struct stat st{};
+
+    /** @brief Mapping of the whole file, if read only and mapped */
+    void* mapping = nullptr;
+
+    /** @brief Last access, for idle eviction */
+    std::chrono::steady_clock::time_point lastUse{};
+};
+
+/** @class FileCache
+ *
+ *  Files read and written by the host in small inline chunks, kept open
+ *  across the requests instead of opened and closed for each of them. A file
+ *  is identified by its path: the path of a file handle and type may change,
+ *  as for the LIDs of the side to boot, and resolving it is cheap compared
+ *  to opening it. The path is checked on each access, a file replaced or
+ *  modified by another writer is reopened. Files not accessed for
+ *  fileCacheIdleTimeout are closed. The cache is only used from the event
+ *  loop.
+ */
+class FileCache
+{
+  public:
+    FileCache(const FileCache&) = delete;
+    FileCache(FileCache&&) = delete;
+    FileCache& operator=(const FileCache&) = delete;
+    FileCache& operator=(FileCache&&) = delete;
+
+    /** @brief Get the cache of the process */
+    static FileCache& get();
+
+    /** @brief Get an open file
+     *
+     *  @param[in] path - path of the file
+     *  @param[in] writable - open the file for writing
+     *  @param[in] mapped - serve the reads from a mapping of the file, for
+     *                      files which are only read
+     *
+     *  @return the file, nullptr with errno set on failure
+     */
+    std::shared_ptr<CachedFile> open(const fs::path& path, bool writable,
+                                     bool mapped = false);
+
+    /** @brief Close all the files */
+    void clear();
+
+  private:
+    FileCache();
+
+    /** @brief Close the files idle for fileCacheIdleTimeout */
+    void evictIdle();
+
+    /** @brief Close the least recently used file */
+    void evictOldest();
+
+    /** @brief Open files by path */
+    std::unordered_map<std::string, std::shared_ptr<CachedFile>> files;
+
+    /** @brief Timer of the idle eviction, armed while files are open */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer;
+};
+
+} // namespace responder
+} // namespace pldm
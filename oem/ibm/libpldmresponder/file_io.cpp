@@ -1,5 +1,7 @@
 #include "file_io.hpp"
 
+#include "common/worker_pool.hpp"
+#include "file_cache.hpp"
 #include "file_io_by_type.hpp"
 #include "file_table.hpp"
 #include "utils.hpp"
@@ -7,16 +9,28 @@
 
 #include <fcntl.h>
 #include <libpldm/base.h>
+#include <poll.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 #include <phosphor-logging/lg2.hpp>
-
+#include <sdeventplus/event.hpp>
+#include <sdeventplus/utility/timer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
-#include <fstream>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <utility>
 
 PHOSPHOR_LOG2_USING;
 
@@ -47,7 +61,394 @@ struct AspeedXdmaOp
 
 constexpr auto xdmaDev = "/dev/aspeed-xdma";
 
-int DMA::transferHostDataToSocket(int fd, uint32_t length, uint64_t address)
+/** @brief The VGA window is unmapped once no transfer ran for this long */
+constexpr auto xdmaIdleTimeout = std::chrono::seconds(30);
+
+/** @brief Longest wait for the completion of an interrupted DMA operation */
+constexpr auto xdmaSettleTimeout = std::chrono::seconds(5);
+
+/** @class XdmaEngine
+ *
+ *  XDMA device of the process. The device is opened and its VGA window
+ *  mapped for the largest transfer, and both are reused by the transfers
+ *  rather than opened and mapped again for each chunk, until the engine is
+ *  idle for xdmaIdleTimeout. The transfers share the VGA window and are
+ *  serialized, the queued ones run one at a time on the worker pool, at
+ *  most maxQueuedTransfers at once, and the file I/O of a large transfer
+ *  overlaps its DMA on another worker. A DMA operation whose wait was
+ *  interrupted runs on, the window is not reused nor unmapped until it
+ *  completed.
+ */
+class XdmaEngine
+{
+  public:
+    XdmaEngine(const XdmaEngine&) = delete;
+    XdmaEngine(XdmaEngine&&) = delete;
+    XdmaEngine& operator=(const XdmaEngine&) = delete;
+    XdmaEngine& operator=(XdmaEngine&&) = delete;
+
+    /** @brief Get the engine of the process */
+    static XdmaEngine& get()
+    {
+        static XdmaEngine engine;
+        return engine;
+    }
+
+    /** @brief Open the device and map the VGA window if not done yet, a
+     *         failure is retried by the next transfer. Wait for the
+     *         completion of an interrupted DMA operation first.
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    int map()
+    {
+        if (settle(xdmaSettleTimeout) < 0)
+        {
+            error(
+                "The interrupted DMA operation did not complete, the VGA window is still in use");
+            return -EBUSY;
+        }
+        if (window)
+        {
+            return 0;
+        }
+
+        if (xdmaFd < 0)
+        {
+            xdmaFd = open(device.c_str(), O_RDWR);
+            if (xdmaFd < 0)
+            {
+                auto rc = -errno;
+                error(
+                    "Failed to open the XDMA device with response code '{RC}'",
+                    "RC", rc);
+                return rc;
+            }
+        }
+
+        static const size_t pageSize = getpagesize();
+        auto length = (maxSize + pageSize - 1) / pageSize * pageSize;
+        auto mem = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED,
+                        xdmaFd, 0);
+        if (MAP_FAILED == mem)
+        {
+            auto rc = -errno;
+            error(
+                "Failed to mmap the XDMA device with response code '{RC}'",
+                "RC", rc);
+            return rc;
+        }
+        window = static_cast<char*>(mem);
+        windowLength = length;
+        return 0;
+    }
+
+    /** @brief Start a DMA operation and wait for its completion
+     *
+     *  @param[in] address - DMA address on the host
+     *  @param[in] length - length of the data to transfer
+     *  @param[in] upstream - true for a transfer to the host
+     *
+     *  @return 0 on success, negative errno on failure
+     */
+    int transfer(uint64_t address, uint32_t length, bool upstream)
+    {
+        AspeedXdmaOp xdmaOp;
+        xdmaOp.upstream = upstream ? 1 : 0;
+        xdmaOp.hostAddr = address;
+        xdmaOp.len = length;
+
+        if (write(xdmaFd, &xdmaOp, sizeof(xdmaOp)) < 0)
+        {
+            auto rc = -errno;
+            // Only the wait was interrupted, the DMA operation runs on
+            inFlight = rc == -EINTR;
+            return rc;
+        }
+        return 0;
+    }
+
+    /** @brief Unmap the VGA window and close the device once no transfer
+     *         ran for xdmaIdleTimeout, called from the default event loop
+     */
+    void scheduleRelease()
+    {
+        if (!idleTimer)
+        {
+            idleTimer = std::make_unique<
+                sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
+                sdeventplus::Event::get_default(),
+                [this](auto&) { release(); });
+        }
+        idleTimer->restartOnce(xdmaIdleTimeout);
+    }
+
+    /** @brief path of the device, the XDMA device unless benchmarked */
+    fs::path device = xdmaDev;
+
+    /** @brief VGA window, nullptr until mapped */
+    char* window = nullptr;
+
+    /** @brief length of the VGA window */
+    size_t windowLength = 0;
+
+    /** @brief serializes the transfers sharing the VGA window */
+    std::mutex mutex;
+
+    /** @brief Queue a job, the jobs run one at a time on the worker pool
+     *
+     *  @param[in] job - run by a worker, returns 0 or a negative errno
+     *  @param[in] completion - called from the default event loop with the
+     *                          result of job
+     *
+     *  @return false if maxQueuedTransfers jobs are already queued or
+     *          running, or if the pool can't be started, completion is then
+     *          not called
+     */
+    bool post(std::function<int()>&& job,
+              std::function<void(int)>&& completion)
+    {
+        if (jobs.size() + (busy ? 1 : 0) >= maxQueuedTransfers)
+        {
+            return false;
+        }
+        jobs.emplace_back(std::move(job), std::move(completion));
+        if (!runNext())
+        {
+            jobs.pop_back();
+            return false;
+        }
+        return true;
+    }
+
+    /** @brief Cancel the queued jobs and stop the running one at its next
+     *         chunk, their completion is called with -ECANCELED
+     */
+    void cancel()
+    {
+        cancelled = busy;
+        decltype(jobs) dropped;
+        dropped.swap(jobs);
+        for (auto& [job, completion] : dropped)
+        {
+            completion(-ECANCELED);
+        }
+    }
+
+    /** @brief set while the running job is cancelled */
+    std::atomic<bool> cancelled = false;
+
+  private:
+    XdmaEngine() = default;
+
+    /** @brief Wait for the completion of an interrupted DMA operation, the
+     *         caller holds the mutex
+     *
+     *  @param[in] timeout - longest wait
+     *
+     *  @return 0 once no DMA operation is in flight, -EBUSY otherwise
+     */
+    int settle(std::chrono::milliseconds timeout)
+    {
+        if (!inFlight)
+        {
+            return 0;
+        }
+        pollfd pfd{xdmaFd, POLLIN, 0};
+        if (poll(&pfd, 1, timeout.count()) <= 0)
+        {
+            return -EBUSY;
+        }
+        inFlight = false;
+        return 0;
+    }
+
+    /** @brief Unmap the VGA window and close the device, unless a transfer
+     *         runs or a DMA operation is still in flight
+     */
+    void release()
+    {
+        std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+        if (busy || !jobs.empty())
+        {
+            return;
+        }
+        if (!lock.owns_lock() || settle(std::chrono::milliseconds(0)) < 0)
+        {
+            idleTimer->restartOnce(xdmaIdleTimeout);
+            return;
+        }
+        if (window)
+        {
+            munmap(window, windowLength);
+            window = nullptr;
+            windowLength = 0;
+        }
+        if (xdmaFd >= 0)
+        {
+            close(xdmaFd);
+            xdmaFd = -1;
+        }
+    }
+
+    ~XdmaEngine()
+    {
+        if (window)
+        {
+            munmap(window, windowLength);
+        }
+        if (xdmaFd >= 0)
+        {
+            close(xdmaFd);
+        }
+    }
+
+    /** @brief Hand the next queued job to the worker pool, unless a job
+     *         already runs
+     *
+     *  @return false if the pool can't be started
+     */
+    bool runNext()
+    {
+        if (busy || jobs.empty())
+        {
+            return true;
+        }
+        auto rc = std::make_shared<int>(0);
+        auto& [job, completion] = jobs.front();
+        try
+        {
+            pldm::utils::WorkerPool::getInstance().post(
+                [run = std::move(job), rc] { *rc = run(); },
+                [this, complete = std::move(completion), rc] {
+                    auto result = cancelled ? -ECANCELED : *rc;
+                    busy = false;
+                    cancelled = false;
+                    runNext();
+                    if (!busy)
+                    {
+                        scheduleRelease();
+                    }
+                    complete(result);
+                });
+        }
+        catch (const std::system_error& e)
+        {
+            error("Failed to start the DMA job, error - {ERROR}", "ERROR", e);
+            return false;
+        }
+        jobs.pop_front();
+        busy = true;
+        return true;
+    }
+
+    /** @brief file descriptor of the XDMA device */
+    int xdmaFd = -1;
+
+    /** @brief jobs waiting for the running one, with their completion, only
+     *         used from the event loop
+     */
+    std::deque<std::pair<std::function<int()>, std::function<void(int)>>>
+        jobs;
+
+    /** @brief whether a job runs on the worker pool */
+    bool busy = false;
+
+    /** @brief set when the wait for a DMA operation was interrupted, until
+     *         the operation completed, guarded by the mutex
+     */
+    bool inFlight = false;
+
+    /** @brief unmaps the VGA window of an idle engine */
+    std::unique_ptr<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        idleTimer;
+};
+
+/** @class StagedChunk
+ *
+ *  File I/O or DMA of a chunk of a large transfer, posted to the worker
+ *  pool to overlap the other stage of the previous chunk. The waiter runs
+ *  it inline if no worker picked it up yet, so the transfer still
+ *  progresses when all the workers are busy.
+ */
+class StagedChunk
+{
+  public:
+    /** @brief Post the stage to the worker pool
+     *
+     *  @param[in] work - the stage, returns 0 or a negative errno, it must
+     *                    stay valid until wait returned
+     */
+    explicit StagedChunk(std::function<int()>&& work) :
+        state(std::make_shared<State>())
+    {
+        state->work = std::move(work);
+        try
+        {
+            pldm::utils::WorkerPool::getInstance().post(
+                [state = state] {
+                    if (state->claim())
+                    {
+                        state->finish(state->work());
+                    }
+                },
+                [] {});
+        }
+        catch (const std::system_error&)
+        {
+            // Run by the waiter
+        }
+    }
+
+    /** @brief Wait for the stage, running it if no worker took it
+     *
+     *  @param[in] run - false to drop the stage if it didn't start
+     *
+     *  @return result of the stage, -ECANCELED if dropped
+     */
+    int wait(bool run = true)
+    {
+        if (state->claim())
+        {
+            return run ? state->work() : -ECANCELED;
+        }
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->done.wait(lock, [this] { return state->rc.has_value(); });
+        return *state->rc;
+    }
+
+  private:
+    struct State
+    {
+        /** @brief Take the stage, false if already taken */
+        bool claim()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return !std::exchange(claimed, true);
+        }
+
+        /** @brief Publish the result of the stage run by a worker */
+        void finish(int result)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            rc = result;
+            done.notify_all();
+        }
+
+        std::function<int()> work;
+        std::mutex mutex;
+        std::condition_variable done;
+        bool claimed = false;
+        std::optional<int> rc;
+    };
+
+    /** @brief shared with the posted job, which may outlive the waiter */
+    std::shared_ptr<State> state;
+};
+
+/** @brief Round a transfer length up to a whole number of pages */
+static uint32_t pageAligned(uint32_t length)
 {
     static const size_t pageSize = getpagesize();
     uint32_t numPages = length / pageSize;
@@ -57,120 +458,172 @@ int DMA::transferHostDataToSocket(int fd, uint32_t length, uint64_t address)
     {
         pageAlignedLength += pageSize;
     }
+    return pageAlignedLength;
+}
 
-    auto mmapCleanup = [pageAlignedLength](void* vgaMem) {
-        munmap(vgaMem, pageAlignedLength);
-    };
+using Clock = std::chrono::steady_clock;
 
-    int dmaFd = -1;
-    int rc = 0;
-    dmaFd = open(xdmaDev, O_RDWR);
-    if (dmaFd < 0)
+/** @brief Microseconds since a time point */
+static uint64_t microsecondsSince(Clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               Clock::now() - start)
+        .count();
+}
+
+/** @brief guards transferStats, recorded from the worker threads */
+static std::mutex transferStatsMutex;
+
+/** @brief statistics of the transfers by file type */
+static TransferStatsMap transferStats;
+
+/** @brief Add a transfer to the statistics of its file type
+ *
+ *  @param[in] fileType - PLDM file type of the transfer
+ *  @param[in] sample - bytes, chunks and times of the transfer
+ *  @param[in] start - time the transfer was requested
+ *  @param[in] rc - result of the transfer
+ */
+static void recordTransfer(uint16_t fileType, const TransferStats& sample,
+                           Clock::time_point start, int rc)
+{
+    auto elapsed = microsecondsSince(start);
+    std::lock_guard<std::mutex> lock(transferStatsMutex);
+    auto& stats = transferStats[fileType];
+    stats.transfers++;
+    stats.failures += rc < 0 ? 1 : 0;
+    stats.bytes += sample.bytes;
+    stats.chunks += sample.chunks;
+    stats.elapsedUs += elapsed;
+    stats.waitUs += sample.waitUs;
+    stats.dmaUs += sample.dmaUs;
+    stats.fileUs += sample.fileUs;
+}
+
+TransferStatsMap getTransferStats()
+{
+    std::lock_guard<std::mutex> lock(transferStatsMutex);
+    return transferStats;
+}
+
+/** @brief Start a DMA operation, and add it to the statistics of the
+ *         transfer once done
+ */
+static int timedTransfer(XdmaEngine& engine, TransferStats& sample,
+                         uint64_t address, uint32_t length, bool upstream)
+{
+    auto start = Clock::now();
+    auto rc = engine.transfer(address, length, upstream);
+    sample.dmaUs += microsecondsSince(start);
+    if (rc == 0)
     {
-        rc = -errno;
-        error(
-            "Failed to open the XDMA device for transferring remote terminus data to socket with response code '{RC}'",
-            "RC", rc);
-        return rc;
+        sample.bytes += length;
+        sample.chunks++;
     }
+    return rc;
+}
 
-    pldm::utils::CustomFD xdmaFd(dmaFd);
-
-    void* vgaMem;
-    vgaMem =
-        mmap(nullptr, pageAlignedLength, PROT_READ, MAP_SHARED, xdmaFd(), 0);
-    if (MAP_FAILED == vgaMem)
+/** @brief Transfer host data to a socket, the caller holds the engine
+ *         mutex
+ */
+static int transferToSocket(XdmaEngine& engine, TransferStats& sample, int fd,
+                            uint32_t length, uint64_t address)
+{
+    int rc = engine.map();
+    if (rc < 0)
     {
-        rc = -errno;
         error(
-            "Failed to mmap the XDMA device for transferring remote terminus data to socket with response code '{RC}'",
+            "Failed to map the XDMA device for transferring remote terminus data to socket with response code '{RC}'",
             "RC", rc);
         return rc;
     }
+    if (pageAligned(length) > engine.windowLength)
+    {
+        error(
+            "Failed to transfer remote terminus data to socket, length '{LENGTH}' exceeds the DMA maximum size",
+            "LENGTH", length);
+        return -EINVAL;
+    }
 
-    std::unique_ptr<void, decltype(mmapCleanup)> vgaMemPtr(vgaMem, mmapCleanup);
-
-    AspeedXdmaOp xdmaOp;
-    xdmaOp.upstream = 0;
-    xdmaOp.hostAddr = address;
-    xdmaOp.len = length;
-
-    rc = write(xdmaFd(), &xdmaOp, sizeof(xdmaOp));
+    rc = timedTransfer(engine, sample, address, length, false);
     if (rc < 0)
     {
-        rc = -errno;
         error(
             "Failed to execute the DMA operation for transferring remote terminus data to socket at address '{ADDRESS}' and length '{LENGTH}' with response code '{RC}'",
             "RC", rc, "ADDRESS", address, "LENGTH", length);
         return rc;
     }
 
-    rc = writeToUnixSocket(fd, static_cast<const char*>(vgaMemPtr.get()),
-                           length);
+    auto writeStart = Clock::now();
+    rc = writeToUnixSocket(fd, engine.window, length);
+    sample.fileUs += microsecondsSince(writeStart);
     if (rc < 0)
     {
         rc = -errno;
-        close(fd);
         error(
-            "Failed to write to Unix socket, closing socket for transferring remote terminus data to socket with response code '{RC}'",
+            "Failed to write to Unix socket for transferring remote terminus data to socket with response code '{RC}'",
             "RC", rc);
         return rc;
     }
     return 0;
 }
 
-int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
-                          uint64_t address, bool upstream)
+bool DMA::transferHostDataToSocketAsync(
+    std::shared_ptr<pldm::utils::CustomFD> fd, uint32_t length,
+    uint64_t address, std::function<void(int)> completion)
 {
-    static const size_t pageSize = getpagesize();
-    uint32_t numPages = length / pageSize;
-    uint32_t pageAlignedLength = numPages * pageSize;
-
-    if (length > pageAlignedLength)
-    {
-        pageAlignedLength += pageSize;
-    }
-
-    int rc = 0;
-    auto mmapCleanup = [pageAlignedLength, &rc](void* vgaMem) {
-        if (rc != -EINTR)
-        {
-            munmap(vgaMem, pageAlignedLength);
-        }
-        else
-        {
-            error(
-                "Received interrupt during DMA transfer for data between BMC and remote terminus. Skipping Unmap.");
-        }
-    };
+    return XdmaEngine::get().post(
+        [fd = std::move(fd), fileType = fileType, start = Clock::now(), length,
+         address] {
+            TransferStats sample{};
+            int rc = 0;
+            {
+                auto& engine = XdmaEngine::get();
+                std::lock_guard<std::mutex> lock(engine.mutex);
+                sample.waitUs = microsecondsSince(start);
+                for (uint32_t sent = 0; !rc && sent < length; sent += maxSize)
+                {
+                    if (engine.cancelled)
+                    {
+                        rc = -ECANCELED;
+                        break;
+                    }
+                    rc = transferToSocket(
+                        engine, sample, (*fd)(),
+                        std::min<uint32_t>(maxSize, length - sent),
+                        address + sent);
+                }
+            }
+            recordTransfer(fileType, sample, start, rc);
+            return rc;
+        },
+        std::move(completion));
+}
 
-    int dmaFd = -1;
-    dmaFd = open(xdmaDev, O_RDWR);
-    if (dmaFd < 0)
+/** @brief Transfer a chunk between a file and host through the VGA window,
+ *         the caller holds the engine mutex
+ */
+static int transferChunk(XdmaEngine& engine, TransferStats& sample, int fd,
+                         uint32_t offset, uint32_t length, uint64_t address,
+                         bool upstream)
+{
+    int rc = engine.map();
+    if (rc < 0)
     {
-        rc = -errno;
         error(
-            "Failed to open the XDMA device for data transfer between BMC and remote terminus with response code '{RC}'",
+            "Failed to map the XDMA device for data transfer between BMC and remote terminus with response code '{RC}'",
             "RC", rc);
         return rc;
     }
-
-    pldm::utils::CustomFD xdmaFd(dmaFd);
-
-    void* vgaMem;
-    vgaMem = mmap(nullptr, pageAlignedLength, upstream ? PROT_WRITE : PROT_READ,
-                  MAP_SHARED, xdmaFd(), 0);
-    if (MAP_FAILED == vgaMem)
+    if (pageAligned(length) > engine.windowLength)
     {
-        rc = -errno;
         error(
-            "Failed to mmap the XDMA device for data transfer between BMC and remote terminus with response code '{RC}'",
-            "RC", rc);
-        return rc;
+            "Failed to transfer data between BMC and remote terminus, length '{LENGTH}' exceeds the DMA maximum size",
+            "LENGTH", length);
+        return -EINVAL;
     }
 
-    std::unique_ptr<void, decltype(mmapCleanup)> vgaMemPtr(vgaMem, mmapCleanup);
-
+    auto ioStart = Clock::now();
     if (upstream)
     {
         rc = lseek(fd, offset, SEEK_SET);
@@ -182,12 +635,9 @@ int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
             return rc;
         }
 
-        // Writing to the VGA memory should be aligned at page boundary,
-        // otherwise write data into a buffer aligned at page boundary and
-        // then write to the VGA memory.
-        std::vector<char> buffer{};
-        buffer.resize(pageAlignedLength);
-        rc = read(fd, buffer.data(), length);
+        // The VGA window is mapped at a page boundary, the file is read
+        // into it directly rather than through a bounce buffer
+        rc = read(fd, engine.window, length);
         if (rc == -1)
         {
             error(
@@ -203,19 +653,14 @@ int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
                 "UPSTREAM", upstream, "LENGTH", length, "RC", rc);
             return -1;
         }
-        memcpy(static_cast<char*>(vgaMemPtr.get()), buffer.data(),
-               pageAlignedLength);
+        sample.fileUs += microsecondsSince(ioStart);
     }
 
-    AspeedXdmaOp xdmaOp;
-    xdmaOp.upstream = upstream ? 1 : 0;
-    xdmaOp.hostAddr = address;
-    xdmaOp.len = length;
-
-    rc = write(xdmaFd(), &xdmaOp, sizeof(xdmaOp));
+    // An interrupted transfer leaves the DMA operation in flight, the next
+    // map waits for it before the VGA window is touched again
+    rc = timedTransfer(engine, sample, address, length, upstream);
     if (rc < 0)
     {
-        rc = -errno;
         error(
             "Failed to execute the DMA operation on data between BMC and remote terminus for upstream '{UPSTREAM}' of length '{LENGTH}' at address '{ADDRESS}', response code '{RC}'",
             "RC", rc, "UPSTREAM", upstream, "ADDRESS", address, "LENGTH",
@@ -225,6 +670,7 @@ int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
 
     if (!upstream)
     {
+        ioStart = Clock::now();
         rc = lseek(fd, offset, SEEK_SET);
         if (rc == -1)
         {
@@ -233,7 +679,7 @@ int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
                 "ERROR_NUM", errno, "UPSTREAM", upstream, "OFFSET", offset);
             return rc;
         }
-        rc = write(fd, static_cast<const char*>(vgaMemPtr.get()), length);
+        rc = write(fd, engine.window, length);
         if (rc == -1)
         {
             error(
@@ -242,11 +688,269 @@ int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
                 "OFFSET", offset);
             return rc;
         }
+        sample.fileUs += microsecondsSince(ioStart);
     }
 
     return 0;
 }
 
+int DMA::transferDataHost(int fd, uint32_t offset, uint32_t length,
+                          uint64_t address, bool upstream)
+{
+    auto start = Clock::now();
+    TransferStats sample{};
+    int rc = 0;
+    {
+        auto& engine = XdmaEngine::get();
+        std::lock_guard<std::mutex> lock(engine.mutex);
+        sample.waitUs = microsecondsSince(start);
+        rc = transferChunk(engine, sample, fd, offset, length, address,
+                           upstream);
+    }
+    XdmaEngine::get().scheduleRelease();
+    recordTransfer(fileType, sample, start, rc);
+    return rc;
+}
+
+/** @brief Run a two stage pipeline over chunks, through two staging slots
+ *
+ *  produce fills the slot of a chunk, on the worker pool, while consume
+ *  drains the slot of the previous chunk on the calling thread.
+ *
+ *  @return 0 on success, the first negative errno of a stage on failure
+ */
+static int runPipeline(size_t chunks,
+                       const std::function<int(size_t, char*)>& produce,
+                       const std::function<int(size_t, char*)>& consume,
+                       std::array<std::vector<char>, 2>& slots)
+{
+    auto stage = [&](size_t i) {
+        return std::make_unique<StagedChunk>(
+            [&produce, &slots, i] { return produce(i, slots[i % 2].data()); });
+    };
+
+    int rc = 0;
+    auto next = stage(0);
+    for (size_t i = 0; !rc && i < chunks; ++i)
+    {
+        rc = next->wait();
+        next.reset();
+        if (rc < 0)
+        {
+            break;
+        }
+        if (i + 1 < chunks)
+        {
+            next = stage(i + 1);
+        }
+        rc = consume(i, slots[i % 2].data());
+    }
+    if (next)
+    {
+        next->wait(false);
+    }
+    return rc;
+}
+
+/** @brief Transfer a file region of any length, see DMA::transferFile, the
+ *         caller holds the engine mutex
+ */
+static int transferFileChunks(XdmaEngine& engine, TransferStats& sample,
+                              int fd, uint32_t offset, uint32_t length,
+                              uint64_t address, bool upstream)
+{
+    if (length <= maxSize)
+    {
+        return transferChunk(engine, sample, fd, offset, length, address,
+                             upstream);
+    }
+
+    int rc = engine.map();
+    if (rc < 0)
+    {
+        error(
+            "Failed to map the XDMA device for data transfer between BMC and remote terminus with response code '{RC}'",
+            "RC", rc);
+        return rc;
+    }
+
+    // The XDMA operations always use the start of the VGA window, so the
+    // file I/O of a chunk overlaps the DMA of the next or previous one
+    // through staging buffers rather than window halves
+    size_t chunks = (length + maxSize - 1) / maxSize;
+    auto chunkLength = [&](size_t i) {
+        return std::min<uint32_t>(maxSize, length - i * maxSize);
+    };
+    std::array<std::vector<char>, 2> slots;
+    slots[0].resize(maxSize);
+    slots[1].resize(maxSize);
+
+    // The stages run on two threads, each only updates its own times
+    auto fileStage = [&](size_t i, char* slot) {
+        auto len = chunkLength(i);
+        auto pos = static_cast<off_t>(offset + i * maxSize);
+        auto ioStart = Clock::now();
+        auto count = upstream ? pread(fd, slot, len, pos)
+                              : pwrite(fd, slot, len, pos);
+        sample.fileUs += microsecondsSince(ioStart);
+        if (count != static_cast<ssize_t>(len))
+        {
+            int ioRc = count < 0 ? -errno : -EIO;
+            error(
+                "Failed to transfer data between BMC and remote terminus with file I/O on upstream '{UPSTREAM}' of length '{LENGTH}' at offset '{OFFSET}', response code '{RC}'",
+                "UPSTREAM", upstream, "LENGTH", len, "OFFSET", pos, "RC", ioRc);
+            return ioRc;
+        }
+        return 0;
+    };
+    auto dmaStage = [&](size_t i, char* slot) {
+        if (engine.cancelled)
+        {
+            return -ECANCELED;
+        }
+        auto len = chunkLength(i);
+        if (upstream)
+        {
+            memcpy(engine.window, slot, len);
+        }
+        auto dmaRc =
+            timedTransfer(engine, sample, address + i * maxSize, len, upstream);
+        if (dmaRc < 0)
+        {
+            error(
+                "Failed to execute the DMA operation on data between BMC and remote terminus for upstream '{UPSTREAM}' of length '{LENGTH}' at address '{ADDRESS}', response code '{RC}'",
+                "RC", dmaRc, "UPSTREAM", upstream, "ADDRESS",
+                address + i * maxSize, "LENGTH", len);
+            return dmaRc;
+        }
+        if (!upstream)
+        {
+            memcpy(slot, engine.window, len);
+        }
+        return 0;
+    };
+
+    return upstream ? runPipeline(chunks, fileStage, dmaStage, slots)
+                    : runPipeline(chunks, dmaStage, fileStage, slots);
+}
+
+/** @brief Transfer a file region and record it, waiting for the engine
+ *
+ *  @param[in] fileType - PLDM file type the transfer is recorded under
+ *  @param[in] start - time the transfer was requested, it may have been
+ *                     queued since
+ */
+static int transferFileFrom(uint16_t fileType, Clock::time_point start, int fd,
+                            uint32_t offset, uint32_t length, uint64_t address,
+                            bool upstream)
+{
+    TransferStats sample{};
+    int rc = 0;
+    {
+        auto& engine = XdmaEngine::get();
+        std::lock_guard<std::mutex> lock(engine.mutex);
+        sample.waitUs = microsecondsSince(start);
+        rc = transferFileChunks(engine, sample, fd, offset, length, address,
+                                upstream);
+    }
+    recordTransfer(fileType, sample, start, rc);
+    return rc;
+}
+
+int DMA::transferFile(int fd, uint32_t offset, uint32_t length,
+                      uint64_t address, bool upstream)
+{
+    return transferFileFrom(fileType, Clock::now(), fd, offset, length,
+                            address, upstream);
+}
+
+bool DMA::transferFileAsync(std::shared_ptr<pldm::utils::CustomFD> fd,
+                            uint32_t offset, uint32_t length, uint64_t address,
+                            bool upstream, std::function<void(int)> completion)
+{
+    return XdmaEngine::get().post(
+        [fd = std::move(fd), fileType = fileType, start = Clock::now(), offset,
+         length, address, upstream] {
+            return transferFileFrom(fileType, start, (*fd)(), offset, length,
+                                    address, upstream);
+        },
+        std::move(completion));
+}
+
+void DMA::cancelTransfers()
+{
+    XdmaEngine::get().cancel();
+}
+
+void DMA::setDevice(const fs::path& path)
+{
+    XdmaEngine::get().device = path;
+}
+
+void transferAsync(uint16_t fileType, const fs::path& path, int flags,
+                   uint32_t offset, uint32_t length, uint64_t address,
+                   bool upstream, std::function<Response(int, uint32_t)> encode,
+                   ResponseCompletion complete)
+{
+    int file = open(path.string().c_str(), flags);
+    if (file == -1)
+    {
+        error("File at path '{PATH}' does not exist", "PATH", path);
+        complete(encode(PLDM_ERROR, 0));
+        return;
+    }
+
+    DMA intf(fileType);
+    auto queued = intf.transferFileAsync(
+        std::make_shared<pldm::utils::CustomFD>(file), offset, length,
+        address, upstream, [encode, complete, length](int rc) {
+            if (rc < 0)
+            {
+                complete(encode(PLDM_ERROR, 0));
+                return;
+            }
+            complete(encode(PLDM_SUCCESS, length));
+        });
+    if (!queued)
+    {
+        error(
+            "Failed to queue the DMA transfer of '{PATH}', {MAX} transfers are in progress",
+            "PATH", path, "MAX", maxQueuedTransfers);
+        complete(encode(PLDM_ERROR_NOT_READY, 0));
+    }
+}
+
+void transferAllAsync(uint8_t command, const fs::path& path, uint32_t offset,
+                      uint32_t length, uint64_t address, bool upstream,
+                      uint8_t instanceId, ResponseCompletion complete)
+{
+    int flags{};
+    if (upstream)
+    {
+        flags = O_RDONLY;
+    }
+    else if (fs::exists(path))
+    {
+        flags = O_RDWR;
+    }
+    else
+    {
+        flags = O_WRONLY;
+    }
+
+    transferAsync(
+        untypedTransfers, path, flags, offset, length, address, upstream,
+        [command, instanceId](int rc, uint32_t transferred) {
+            auto response =
+                CmdHandler::makeResponse(PLDM_RW_FILE_MEM_RESP_BYTES);
+            auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+            encode_rw_file_memory_resp(instanceId, command, rc, transferred,
+                                       responsePtr);
+            return response;
+        },
+        std::move(complete));
+}
+
 } // namespace dma
 
 namespace oem_ibm
@@ -342,14 +1046,15 @@ void encodeFileAckResponseHandler(uint8_t instance_id, uint8_t completion_code,
 }
 
 Response Handler::readFileIntoMemory(const pldm_msg* request,
-                                     size_t payloadLength)
+                                     size_t payloadLength,
+                                     ResponseCompletion complete)
 {
     uint32_t fileHandle = 0;
     uint32_t offset = 0;
     uint32_t length = 0;
     uint64_t address = 0;
 
-    Response response((sizeof(pldm_msg_hdr) + PLDM_RW_FILE_MEM_RESP_BYTES), 0);
+    auto response = CmdHandler::makeResponse(PLDM_RW_FILE_MEM_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     if (payloadLength != PLDM_RW_FILE_MEM_REQ_BYTES)
     {
@@ -438,6 +1143,13 @@ Response Handler::readFileIntoMemory(const pldm_msg* request,
     }
 
     using namespace dma;
+    if (complete)
+    {
+        transferAllAsync(PLDM_READ_FILE_INTO_MEMORY, value.fsPath, offset,
+                         length, address, true, request->hdr.instance_id,
+                         std::move(complete));
+        return {};
+    }
     DMA intf;
     return transferAll<DMA>(&intf, PLDM_READ_FILE_INTO_MEMORY, value.fsPath,
                             offset, length, address, true,
@@ -445,14 +1157,15 @@ Response Handler::readFileIntoMemory(const pldm_msg* request,
 }
 
 Response Handler::writeFileFromMemory(const pldm_msg* request,
-                                      size_t payloadLength)
+                                      size_t payloadLength,
+                                      ResponseCompletion complete)
 {
     uint32_t fileHandle = 0;
     uint32_t offset = 0;
     uint32_t length = 0;
     uint64_t address = 0;
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_RW_FILE_MEM_RESP_BYTES, 0);
+    auto response = CmdHandler::makeResponse(PLDM_RW_FILE_MEM_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     if (payloadLength != PLDM_RW_FILE_MEM_REQ_BYTES)
@@ -534,6 +1247,13 @@ Response Handler::writeFileFromMemory(const pldm_msg* request,
     }
 
     using namespace dma;
+    if (complete)
+    {
+        transferAllAsync(PLDM_WRITE_FILE_FROM_MEMORY, value.fsPath, offset,
+                         length, address, false, request->hdr.instance_id,
+                         std::move(complete));
+        return {};
+    }
     DMA intf;
     return transferAll<DMA>(&intf, PLDM_WRITE_FILE_FROM_MEMORY, value.fsPath,
                             offset, length, address, false,
@@ -546,8 +1266,8 @@ Response Handler::getFileTable(const pldm_msg* request, size_t payloadLength)
     uint8_t transferFlag = 0;
     uint8_t tableType = 0;
 
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_GET_FILE_TABLE_MIN_RESP_BYTES);
+    auto response =
+        CmdHandler::makeResponse(PLDM_GET_FILE_TABLE_MIN_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     if (payloadLength != PLDM_GET_FILE_TABLE_REQ_BYTES)
@@ -585,11 +1305,7 @@ Response Handler::getFileTable(const pldm_msg* request, size_t payloadLength)
     }
 
     using namespace pldm::filetable;
-    auto table = buildFileTable(FILE_TABLE_JSON);
-    auto attrTable = table();
-    response.resize(response.size() + attrTable.size());
-    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
-
+    const auto& attrTable = refreshFileTable(FILE_TABLE_JSON)();
     if (attrTable.empty())
     {
         error("PLDM file attribute table is empty");
@@ -599,6 +1315,8 @@ Response Handler::getFileTable(const pldm_msg* request, size_t payloadLength)
         return response;
     }
 
+    response.resize(response.size() + attrTable.size());
+    responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     encodeGetFileResponseHandler(request->hdr.instance_id, PLDM_SUCCESS, 0,
                                  PLDM_START_AND_END, attrTable.data(),
                                  attrTable.size(), responsePtr);
@@ -611,7 +1329,7 @@ Response Handler::readFile(const pldm_msg* request, size_t payloadLength)
     uint32_t offset = 0;
     uint32_t length = 0;
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_READ_FILE_RESP_BYTES);
+    auto response = CmdHandler::makeResponse(PLDM_READ_FILE_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     if (payloadLength != PLDM_READ_FILE_REQ_BYTES)
@@ -656,7 +1374,8 @@ Response Handler::readFile(const pldm_msg* request, size_t payloadLength)
         return response;
     }
 
-    if (!fs::exists(value.fsPath))
+    auto file = FileCache::get().open(value.fsPath, false);
+    if (!file)
     {
         error("File '{PATH}' and handle {FILE_HANDLE} does not exist", "PATH",
               value.fsPath, "FILE_HANDLE", fileHandle);
@@ -666,7 +1385,7 @@ Response Handler::readFile(const pldm_msg* request, size_t payloadLength)
         return response;
     }
 
-    auto fileSize = fs::file_size(value.fsPath);
+    auto fileSize = file->size();
     if (!fileSize)
     {
         error("Failed to read file {PATH} with size '{SIZE}'", "PATH",
@@ -698,9 +1417,18 @@ Response Handler::readFile(const pldm_msg* request, size_t payloadLength)
     auto fileDataPos = reinterpret_cast<char*>(responsePtr);
     fileDataPos += sizeof(pldm_msg_hdr) + sizeof(uint8_t) + sizeof(length);
 
-    std::ifstream stream(value.fsPath, std::ios::in | std::ios::binary);
-    stream.seekg(offset);
-    stream.read(fileDataPos, length);
+    rc = file->read(offset, length, fileDataPos);
+    if (rc < 0)
+    {
+        error(
+            "Failed to read file '{PATH}' at offset '{OFFSET}' for length '{LENGTH}', response code '{RC}'",
+            "PATH", value.fsPath, "OFFSET", offset, "LENGTH", length, "RC", rc);
+        response.resize(sizeof(pldm_msg_hdr) + PLDM_READ_FILE_RESP_BYTES);
+        responsePtr = reinterpret_cast<pldm_msg*>(response.data());
+        encodeReadResponseHandler(request->hdr.instance_id, PLDM_ERROR, 0,
+                                  responsePtr);
+        return response;
+    }
 
     encodeReadResponseHandler(request->hdr.instance_id, PLDM_SUCCESS, length,
                               responsePtr);
@@ -715,7 +1443,7 @@ Response Handler::writeFile(const pldm_msg* request, size_t payloadLength)
     uint32_t length = 0;
     size_t fileDataOffset = 0;
 
-    Response response(sizeof(pldm_msg_hdr) + PLDM_WRITE_FILE_RESP_BYTES);
+    auto response = CmdHandler::makeResponse(PLDM_WRITE_FILE_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     if (payloadLength < PLDM_WRITE_FILE_REQ_BYTES)
@@ -758,7 +1486,8 @@ Response Handler::writeFile(const pldm_msg* request, size_t payloadLength)
         return response;
     }
 
-    if (!fs::exists(value.fsPath))
+    auto file = FileCache::get().open(value.fsPath, true);
+    if (!file)
     {
         error("File '{PATH}' and handle {FILE_HANDLE} does not exist", "PATH",
               value.fsPath, "FILE_HANDLE", fileHandle);
@@ -767,7 +1496,7 @@ Response Handler::writeFile(const pldm_msg* request, size_t payloadLength)
         return response;
     }
 
-    auto fileSize = fs::file_size(value.fsPath);
+    auto fileSize = file->size();
 
     if (!fileSize)
     {
@@ -789,10 +1518,16 @@ Response Handler::writeFile(const pldm_msg* request, size_t payloadLength)
     auto fileDataPos =
         reinterpret_cast<const char*>(request->payload) + fileDataOffset;
 
-    std::ofstream stream(value.fsPath,
-                         std::ios::in | std::ios::out | std::ios::binary);
-    stream.seekp(offset);
-    stream.write(fileDataPos, length);
+    rc = file->write(offset, fileDataPos, length);
+    if (rc < 0)
+    {
+        error(
+            "Failed to write file '{PATH}' at offset '{OFFSET}' for length '{LENGTH}', response code '{RC}'",
+            "PATH", value.fsPath, "OFFSET", offset, "LENGTH", length, "RC", rc);
+        encodeWriteResponseHandler(request->hdr.instance_id, PLDM_ERROR, 0,
+                                   responsePtr);
+        return response;
+    }
 
     encodeWriteResponseHandler(request->hdr.instance_id, PLDM_SUCCESS, length,
                                responsePtr);
@@ -800,12 +1535,18 @@ Response Handler::writeFile(const pldm_msg* request, size_t payloadLength)
     return response;
 }
 
+/** @brief Handle a read or write of a file type into host memory, the DMA
+ *         transfer runs off the event loop
+ *
+ *  @return PLDM response message, empty when complete completes it
+ */
 Response rwFileByTypeIntoMemory(uint8_t cmd, const pldm_msg* request,
                                 size_t payloadLength,
-                                oem_platform::Handler* oemPlatformHandler)
+                                oem_platform::Handler* oemPlatformHandler,
+                                ResponseCompletion complete)
 {
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_RW_FILE_BY_TYPE_MEM_RESP_BYTES, 0);
+    auto response =
+        CmdHandler::makeResponse(PLDM_RW_FILE_BY_TYPE_MEM_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     if (payloadLength != PLDM_RW_FILE_BY_TYPE_MEM_REQ_BYTES)
@@ -863,33 +1604,51 @@ Response rwFileByTypeIntoMemory(uint8_t cmd, const pldm_msg* request,
         return response;
     }
 
-    rc = cmd == PLDM_WRITE_FILE_BY_TYPE_FROM_MEMORY
-             ? handler->writeFromMemory(offset, length, address,
-                                        oemPlatformHandler)
-             : handler->readIntoMemory(offset, length, address,
-                                       oemPlatformHandler);
-    encodeRWTypeMemoryResponseHandler(request->hdr.instance_id, cmd, rc, length,
-                                      responsePtr);
-    return response;
+    // The handler lives until its transfer is done
+    std::shared_ptr<FileHandler> fileHandler = std::move(handler);
+    auto done = [fileHandler, cmd, instanceId = request->hdr.instance_id,
+                 complete = std::move(complete)](int rc, uint32_t length) {
+        auto response =
+            CmdHandler::makeResponse(PLDM_RW_FILE_BY_TYPE_MEM_RESP_BYTES);
+        encodeRWTypeMemoryResponseHandler(
+            instanceId, cmd, rc, length,
+            reinterpret_cast<pldm_msg*>(response.data()));
+        complete(std::move(response));
+    };
+    if (cmd == PLDM_WRITE_FILE_BY_TYPE_FROM_MEMORY)
+    {
+        fileHandler->writeFromMemory(offset, length, address,
+                                     oemPlatformHandler, std::move(done));
+    }
+    else
+    {
+        fileHandler->readIntoMemory(offset, length, address,
+                                    oemPlatformHandler, std::move(done));
+    }
+    return {};
 }
 
 Response Handler::writeFileByTypeFromMemory(const pldm_msg* request,
-                                            size_t payloadLength)
+                                            size_t payloadLength,
+                                            ResponseCompletion complete)
 {
     return rwFileByTypeIntoMemory(PLDM_WRITE_FILE_BY_TYPE_FROM_MEMORY, request,
-                                  payloadLength, oemPlatformHandler);
+                                  payloadLength, oemPlatformHandler,
+                                  std::move(complete));
 }
 
 Response Handler::readFileByTypeIntoMemory(const pldm_msg* request,
-                                           size_t payloadLength)
+                                           size_t payloadLength,
+                                           ResponseCompletion complete)
 {
     return rwFileByTypeIntoMemory(PLDM_READ_FILE_BY_TYPE_INTO_MEMORY, request,
-                                  payloadLength, oemPlatformHandler);
+                                  payloadLength, oemPlatformHandler,
+                                  std::move(complete));
 }
 
 Response Handler::writeFileByType(const pldm_msg* request, size_t payloadLength)
 {
-    Response response(sizeof(pldm_msg_hdr) + PLDM_RW_FILE_BY_TYPE_RESP_BYTES);
+    auto response = CmdHandler::makeResponse(PLDM_RW_FILE_BY_TYPE_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     if (payloadLength < PLDM_RW_FILE_BY_TYPE_REQ_BYTES)
@@ -946,7 +1705,7 @@ Response Handler::writeFileByType(const pldm_msg* request, size_t payloadLength)
 
 Response Handler::readFileByType(const pldm_msg* request, size_t payloadLength)
 {
-    Response response(sizeof(pldm_msg_hdr) + PLDM_RW_FILE_BY_TYPE_RESP_BYTES);
+    auto response = CmdHandler::makeResponse(PLDM_RW_FILE_BY_TYPE_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     if (payloadLength != PLDM_RW_FILE_BY_TYPE_REQ_BYTES)
@@ -1002,7 +1761,7 @@ Response Handler::readFileByType(const pldm_msg* request, size_t payloadLength)
 
 Response Handler::fileAck(const pldm_msg* request, size_t payloadLength)
 {
-    Response response(sizeof(pldm_msg_hdr) + PLDM_FILE_ACK_RESP_BYTES);
+    auto response = CmdHandler::makeResponse(PLDM_FILE_ACK_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     if (payloadLength != PLDM_FILE_ACK_REQ_BYTES)
@@ -1048,7 +1807,7 @@ Response Handler::fileAck(const pldm_msg* request, size_t payloadLength)
 
 Response Handler::getAlertStatus(const pldm_msg* request, size_t payloadLength)
 {
-    Response response(sizeof(pldm_msg_hdr) + PLDM_GET_ALERT_STATUS_RESP_BYTES);
+    auto response = CmdHandler::makeResponse(PLDM_GET_ALERT_STATUS_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     if (payloadLength != PLDM_GET_ALERT_STATUS_REQ_BYTES)
     {
@@ -1097,7 +1856,7 @@ Response Handler::getAlertStatus(const pldm_msg* request, size_t payloadLength)
 Response Handler::newFileAvailable(const pldm_msg* request,
                                    size_t payloadLength)
 {
-    Response response(sizeof(pldm_msg_hdr) + PLDM_NEW_FILE_RESP_BYTES);
+    auto response = CmdHandler::makeResponse(PLDM_NEW_FILE_RESP_BYTES);
 
     if (payloadLength != PLDM_NEW_FILE_REQ_BYTES)
     {
@@ -1148,8 +1907,8 @@ Response Handler::newFileAvailable(const pldm_msg* request,
 Response Handler::fileAckWithMetaData(const pldm_msg* request,
                                       size_t payloadLength)
 {
-    Response response(
-        sizeof(pldm_msg_hdr) + PLDM_FILE_ACK_WITH_META_DATA_RESP_BYTES);
+    auto response =
+        CmdHandler::makeResponse(PLDM_FILE_ACK_WITH_META_DATA_RESP_BYTES);
 
     if (payloadLength != PLDM_FILE_ACK_WITH_META_DATA_REQ_BYTES)
     {
@@ -1196,8 +1955,8 @@ Response Handler::fileAckWithMetaData(const pldm_msg* request,
 Response Handler::newFileAvailableWithMetaData(const pldm_msg* request,
                                                size_t payloadLength)
 {
-    Response response(sizeof(pldm_msg_hdr) +
-                      PLDM_NEW_FILE_AVAILABLE_WITH_META_DATA_RESP_BYTES);
+    auto response = CmdHandler::makeResponse(
+        PLDM_NEW_FILE_AVAILABLE_WITH_META_DATA_RESP_BYTES);
     if (payloadLength != PLDM_NEW_FILE_AVAILABLE_WITH_META_DATA_REQ_BYTES)
     {
         return CmdHandler::ccOnlyResponse(request, PLDM_ERROR_INVALID_LENGTH);
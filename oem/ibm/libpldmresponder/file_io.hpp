@@ -18,7 +18,10 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -34,8 +37,43 @@ constexpr uint32_t minSize = 16;
 
 constexpr size_t maxSize = DMA_MAXSIZE;
 
+// The maximum number of DMA transfers queued or running off the event loop
+constexpr size_t maxQueuedTransfers = 4;
+
 namespace fs = std::filesystem;
 
+/** @brief Key the transfers not made for a file type are recorded under, as
+ *  the ones of the file handle commands
+ */
+constexpr uint16_t untypedTransfers = 0xFFFF;
+
+/** @struct TransferStats
+ *
+ *  Statistics of the DMA transfers of a file type. The file I/O of a chunk
+ *  overlaps the DMA of the next or previous one, so the time in DMA and in
+ *  file I/O may add up to more than the elapsed time.
+ */
+struct TransferStats
+{
+    uint64_t transfers = 0; //!< transfers started
+    uint64_t failures = 0;  //!< transfers failed or cancelled
+    uint64_t bytes = 0;     //!< bytes of the DMA operations done
+    uint64_t chunks = 0;    //!< DMA operations done
+    uint64_t elapsedUs = 0; //!< time from the request to the end of the
+                            //!< transfers
+    uint64_t waitUs = 0;    //!< time queued or waiting for the XDMA device
+    uint64_t dmaUs = 0;     //!< time in the DMA operations
+    uint64_t fileUs = 0;    //!< time in the file or socket I/O
+};
+
+/** @brief Statistics of the DMA transfers by PLDM file type */
+using TransferStatsMap = std::map<uint16_t, TransferStats>;
+
+/** @brief Get the statistics of the DMA transfers of the process, recorded
+ *  since it started
+ */
+TransferStatsMap getTransferStats();
+
 /**
  * @class DMA
  *
@@ -43,11 +81,20 @@ namespace fs = std::filesystem;
  *
  * This class only exposes the public API transferDataHost to transfer data
  * between BMC and host using DMA. This allows for mocking the transferDataHost
- * for unit testing purposes.
+ * for unit testing purposes. The transfers reuse the XDMA device and VGA
+ * window mapping kept open for the process.
  */
 class DMA
 {
   public:
+    DMA() = default;
+
+    /** @brief Constructor to record the transfers under a file type
+     *
+     * @param[in] fileType - PLDM file type the data is transferred for
+     */
+    explicit DMA(uint16_t fileType) : fileType(fileType) {}
+
     /** @brief API to transfer data between BMC and host using DMA
      *
      * @param[in] path     - pathname of the file to transfer data from or to
@@ -62,15 +109,83 @@ class DMA
     int transferDataHost(int fd, uint32_t offset, uint32_t length,
                          uint64_t address, bool upstream);
 
-    /** @brief API to transfer data on to unix socket from host using DMA
+
+    /** @brief API to transfer a file region of any length between BMC and
+     *  host using DMA
      *
-     * @param[in] path     - pathname of the file to transfer data from or to
+     *  The region is transferred in chunks of the DMA maximum size. While
+     *  the DMA of a chunk is in flight, the next chunk is read from the file
+     *  or the previous one written to it, through staging buffers.
+     *
+     * @param[in] fd       - file descriptor of the file
+     * @param[in] offset   - offset in the file
      * @param[in] length   - length of the data to transfer
      * @param[in] address  - DMA address on the host
+     * @param[in] upstream - indicates direction of the transfer; true indicates
+     *                       transfer to the host
      *
      * @return returns 0 on success, negative errno on failure
      */
-    int transferHostDataToSocket(int fd, uint32_t length, uint64_t address);
+    int transferFile(int fd, uint32_t offset, uint32_t length,
+                     uint64_t address, bool upstream);
+
+    /** @brief API to run transferFile off the event loop
+     *
+     * The transfers are queued to a worker thread, completion is called from
+     * the default event loop with the result of transferFile.
+     *
+     * @param[in] fd         - file descriptor of the file, kept open until
+     *                         the transfer is done
+     * @param[in] offset     - offset in the file
+     * @param[in] length     - length of the data to transfer
+     * @param[in] address    - DMA address on the host
+     * @param[in] upstream   - true for a transfer to the host
+     * @param[in] completion - called with 0 or a negative errno,
+     *                         -ECANCELED when cancelled
+     *
+     * @return false if maxQueuedTransfers transfers are already queued or
+     *         running, completion is then not called
+     */
+    bool transferFileAsync(std::shared_ptr<pldm::utils::CustomFD> fd,
+                           uint32_t offset, uint32_t length, uint64_t address,
+                           bool upstream, std::function<void(int)> completion);
+
+    /** @brief API to transfer host data on to a unix socket using DMA, off
+     * the event loop
+     *
+     * The data is sent in chunks of the DMA maximum size, completion is
+     * called from the default event loop.
+     *
+     * @param[in] fd         - the socket, kept open until the transfer is
+     *                         done
+     * @param[in] length     - length of the data to transfer
+     * @param[in] address    - DMA address on the host
+     * @param[in] completion - called with 0 or a negative errno,
+     *                         -ECANCELED when cancelled
+     *
+     * @return false if maxQueuedTransfers transfers are already queued or
+     *         running, completion is then not called
+     */
+    bool transferHostDataToSocketAsync(
+        std::shared_ptr<pldm::utils::CustomFD> fd, uint32_t length,
+        uint64_t address, std::function<void(int)> completion);
+
+    /** @brief API to cancel the transfers queued by transferFileAsync and
+     *  stop the running one at its next chunk, for instance when the host
+     *  powers off
+     */
+    static void cancelTransfers();
+
+    /** @brief API to use another device than the XDMA device, for the
+     *  benchmarks, before the first transfer
+     *
+     * @param[in] path - path of the device
+     */
+    static void setDevice(const fs::path& path);
+
+  private:
+    /** @brief PLDM file type the transfers are recorded under */
+    uint16_t fileType = untypedTransfers;
 };
 
 /** @brief Transfer the data between BMC and host using DMA.
@@ -98,7 +213,7 @@ Response transferAll(DMAInterface* intf, uint8_t command, fs::path& path,
                      bool upstream, uint8_t instanceId)
 {
     uint32_t origLength = length;
-    Response response(sizeof(pldm_msg_hdr) + PLDM_RW_FILE_MEM_RESP_BYTES, 0);
+    auto response = CmdHandler::makeResponse(PLDM_RW_FILE_MEM_RESP_BYTES);
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     int flags{};
@@ -153,6 +268,46 @@ Response transferAll(DMAInterface* intf, uint8_t command, fs::path& path,
     return response;
 }
 
+/** @brief Transfer a file between BMC and host using DMA, off the event loop
+ *
+ *  The response is PLDM_ERROR_NOT_READY when maxQueuedTransfers transfers are
+ *  in progress, and PLDM_ERROR when the transfer fails or is cancelled.
+ *
+ * @param[in] fileType - PLDM file type the transfer is recorded under
+ * @param[in] path     - pathname of the file to transfer data from or to
+ * @param[in] flags    - flags the file is opened with
+ * @param[in] offset   - offset in the file
+ * @param[in] length   - length of the data to transfer
+ * @param[in] address  - DMA address on the host
+ * @param[in] upstream - true for a transfer to the host
+ * @param[in] encode   - encodes the response from a completion code and the
+ *                       length transferred
+ * @param[in] complete - completes the PLDM response message
+ */
+void transferAsync(uint16_t fileType, const fs::path& path, int flags,
+                   uint32_t offset, uint32_t length, uint64_t address,
+                   bool upstream, std::function<Response(int, uint32_t)> encode,
+                   ResponseCompletion complete);
+
+/** @brief Transfer the data between BMC and host using DMA, off the event
+ *         loop
+ *
+ *  Same as transferAll, the response is completed once the transfer is done.
+ *
+ * @param[in] command  - PLDM command
+ * @param[in] path     - pathname of the file to transfer data from or to
+ * @param[in] offset   - offset in the file
+ * @param[in] length   - length of the data to transfer
+ * @param[in] address  - DMA address on the host
+ * @param[in] upstream - indicates direction of the transfer; true indicates
+ *                       transfer to the host
+ * @param[in] instanceId - Message's instance id
+ * @param[in] complete - completes the PLDM response message
+ */
+void transferAllAsync(uint8_t command, const fs::path& path, uint32_t offset,
+                      uint32_t length, uint64_t address, bool upstream,
+                      uint8_t instanceId, ResponseCompletion complete);
+
 } // namespace dma
 
 namespace oem_ibm
@@ -171,25 +326,50 @@ class Handler : public CmdHandler
             pldm::requester::Handler<pldm::requester::Request>* handler) :
         oemPlatformHandler(oemPlatformHandler)
     {
-        handlers.emplace(
+        deferredHandlers.emplace(
             PLDM_READ_FILE_INTO_MEMORY,
-            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
-                return this->readFileIntoMemory(request, payloadLength);
+            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength,
+                   ResponseCompletion complete) {
+                auto response =
+                    this->readFileIntoMemory(request, payloadLength, complete);
+                if (!response.empty())
+                {
+                    complete(std::move(response));
+                }
             });
-        handlers.emplace(
+        deferredHandlers.emplace(
             PLDM_WRITE_FILE_FROM_MEMORY,
-            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
-                return this->writeFileFromMemory(request, payloadLength);
+            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength,
+                   ResponseCompletion complete) {
+                auto response =
+                    this->writeFileFromMemory(request, payloadLength, complete);
+                if (!response.empty())
+                {
+                    complete(std::move(response));
+                }
             });
-        handlers.emplace(
+        deferredHandlers.emplace(
             PLDM_WRITE_FILE_BY_TYPE_FROM_MEMORY,
-            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
-                return this->writeFileByTypeFromMemory(request, payloadLength);
+            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength,
+                   ResponseCompletion complete) {
+                auto response = this->writeFileByTypeFromMemory(
+                    request, payloadLength, complete);
+                if (!response.empty())
+                {
+                    complete(std::move(response));
+                }
             });
-        handlers.emplace(
+        deferredHandlers.emplace(
             PLDM_READ_FILE_BY_TYPE_INTO_MEMORY,
-            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength) {
-                return this->readFileByTypeIntoMemory(request, payloadLength);
+            [this](pldm_tid_t, const pldm_msg* request, size_t payloadLength,
+                   ResponseCompletion complete) {
+                auto response =
+                    this->readFileByTypeIntoMemory(request, payloadLength,
+                                                   complete);
+                if (!response.empty())
+                {
+                    complete(std::move(response));
+                }
             });
         handlers.emplace(
             PLDM_READ_FILE_BY_TYPE,
@@ -333,40 +513,51 @@ class Handler : public CmdHandler
      *
      *  @param[in] request - pointer to PLDM request payload
      *  @param[in] payloadLength - length of the message
+     *  @param[in] complete - when set, the DMA transfer runs off the event
+     *                        loop and completes the response
      *
-     *  @return PLDM response message
+     *  @return PLDM response message, empty when complete completes it
      */
-    Response readFileIntoMemory(const pldm_msg* request, size_t payloadLength);
+    Response readFileIntoMemory(const pldm_msg* request, size_t payloadLength,
+                                ResponseCompletion complete = nullptr);
 
     /** @brief Handler for writeFileIntoMemory command
      *
      *  @param[in] request - pointer to PLDM request payload
      *  @param[in] payloadLength - length of the message
+     *  @param[in] complete - when set, the DMA transfer runs off the event
+     *                        loop and completes the response
      *
-     *  @return PLDM response message
+     *  @return PLDM response message, empty when complete completes it
      */
-    Response writeFileFromMemory(const pldm_msg* request, size_t payloadLength);
+    Response writeFileFromMemory(const pldm_msg* request, size_t payloadLength,
+                                 ResponseCompletion complete = nullptr);
 
     /** @brief Handler for writeFileByTypeFromMemory command
      *
      *  @param[in] request - pointer to PLDM request payload
      *  @param[in] payloadLength - length of the message
+     *  @param[in] complete - completes the response once the DMA transfer,
+     *                        which runs off the event loop, is done
      *
-     *  @return PLDM response message
+     *  @return PLDM response message, empty when complete completes it
      */
-
     Response writeFileByTypeFromMemory(const pldm_msg* request,
-                                       size_t payloadLength);
+                                       size_t payloadLength,
+                                       ResponseCompletion complete);
 
     /** @brief Handler for readFileByTypeIntoMemory command
      *
      *  @param[in] request - pointer to PLDM request payload
      *  @param[in] payloadLength - length of the message
+     *  @param[in] complete - completes the response once the DMA transfer,
+     *                        which runs off the event loop, is done
      *
-     *  @return PLDM response message
+     *  @return PLDM response message, empty when complete completes it
      */
     Response readFileByTypeIntoMemory(const pldm_msg* request,
-                                      size_t payloadLength);
+                                      size_t payloadLength,
+                                      ResponseCompletion complete);
 
     /** @brief Handler for writeFileByType command
      *
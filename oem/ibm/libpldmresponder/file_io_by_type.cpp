@@ -1,6 +1,7 @@
 #include "file_io_by_type.hpp"
 
 #include "common/utils.hpp"
+#include "file_cache.hpp"
 #include "file_io_type_cert.hpp"
 #include "file_io_type_dump.hpp"
 #include "file_io_type_lid.hpp"
@@ -20,7 +21,7 @@
 #include <cstdint>
 #include <exception>
 #include <filesystem>
-#include <fstream>
+#include <memory>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -31,49 +32,89 @@ namespace responder
 {
 using namespace sdbusplus::xyz::openbmc_project::Common::Error;
 
-int FileHandler::transferFileData(int32_t fd, bool upstream, uint32_t offset,
-                                  uint32_t& length, uint64_t address)
+/** @brief Queue the DMA transfer of a file or socket off the event loop
+ *
+ *  @param[in] type - PLDM file type the transfer is recorded under
+ *  @param[in] toSocket - whether the host data is sent to a socket
+ */
+static void queueTransfer(uint16_t type, bool toSocket,
+                          std::shared_ptr<pldm::utils::CustomFD> fd,
+                          bool upstream, uint32_t offset, uint32_t length,
+                          uint64_t address,
+                          FileHandler::TransferCompletion done)
 {
-    dma::DMA xdmaInterface;
-    while (length > dma::maxSize)
-    {
-        auto rc = xdmaInterface.transferDataHost(fd, offset, dma::maxSize,
-                                                 address, upstream);
+    dma::DMA xdmaInterface(type);
+    auto completion = [done, length](int rc) {
         if (rc < 0)
         {
-            return PLDM_ERROR;
+            done(PLDM_ERROR, 0);
+            return;
         }
-        offset += dma::maxSize;
-        length -= dma::maxSize;
-        address += dma::maxSize;
+        done(PLDM_SUCCESS, length);
+    };
+    auto queued =
+        toSocket
+            ? xdmaInterface.transferHostDataToSocketAsync(
+                  std::move(fd), length, address, std::move(completion))
+            : xdmaInterface.transferFileAsync(std::move(fd), offset, length,
+                                              address, upstream,
+                                              std::move(completion));
+    if (!queued)
+    {
+        error(
+            "Failed to queue the DMA transfer of file type '{TYPE}', {MAX} transfers are in progress",
+            "TYPE", type, "MAX", dma::maxQueuedTransfers);
+        done(PLDM_ERROR_NOT_READY, 0);
     }
-    auto rc =
-        xdmaInterface.transferDataHost(fd, offset, length, address, upstream);
-    return rc < 0 ? PLDM_ERROR : PLDM_SUCCESS;
 }
 
-int FileHandler::transferFileDataToSocket(int32_t fd, uint32_t& length,
-                                          uint64_t address)
+/** @brief Duplicate a file descriptor of the caller for a queued transfer
+ *
+ *  @return the duplicate, nullptr on failure
+ */
+static std::shared_ptr<pldm::utils::CustomFD> duplicateFD(int fd)
 {
-    dma::DMA xdmaInterface;
-    while (length > dma::maxSize)
+    int dupFd = dup(fd);
+    if (dupFd < 0)
     {
-        auto rc =
-            xdmaInterface.transferHostDataToSocket(fd, dma::maxSize, address);
-        if (rc < 0)
-        {
-            return PLDM_ERROR;
-        }
-        length -= dma::maxSize;
-        address += dma::maxSize;
+        error("Failed to duplicate file descriptor, error number - {ERRNO}",
+              "ERRNO", errno);
+        return nullptr;
+    }
+    return std::make_shared<pldm::utils::CustomFD>(dupFd);
+}
+
+void FileHandler::transferFileData(int32_t fd, bool upstream, uint32_t offset,
+                                   uint32_t length, uint64_t address,
+                                   TransferCompletion done)
+{
+    auto file = duplicateFD(fd);
+    if (!file)
+    {
+        done(PLDM_ERROR, 0);
+        return;
+    }
+    queueTransfer(transferType, false, std::move(file), upstream, offset,
+                  length, address, std::move(done));
+}
+
+void FileHandler::transferFileDataToSocket(int32_t fd, uint32_t length,
+                                           uint64_t address,
+                                           TransferCompletion done)
+{
+    auto sock = duplicateFD(fd);
+    if (!sock)
+    {
+        done(PLDM_ERROR, 0);
+        return;
     }
-    auto rc = xdmaInterface.transferHostDataToSocket(fd, length, address);
-    return rc < 0 ? PLDM_ERROR : PLDM_SUCCESS;
+    queueTransfer(transferType, true, std::move(sock), true, 0, length,
+                  address, std::move(done));
 }
 
-int FileHandler::transferFileData(const fs::path& path, bool upstream,
-                                  uint32_t offset, uint32_t& length,
-                                  uint64_t address)
+void FileHandler::transferFileData(const fs::path& path, bool upstream,
+                                   uint32_t offset, uint32_t length,
+                                   uint64_t address, TransferCompletion done)
 {
     bool fileExists = false;
     if (upstream)
@@ -82,7 +123,8 @@ int FileHandler::transferFileData(const fs::path& path, bool upstream,
         if (!fileExists)
         {
             error("File '{PATH}' does not exist.", "PATH", path);
-            return PLDM_INVALID_FILE_HANDLE;
+            done(PLDM_INVALID_FILE_HANDLE, 0);
+            return;
         }
 
         size_t fileSize = fs::file_size(path);
@@ -91,7 +133,8 @@ int FileHandler::transferFileData(const fs::path& path, bool upstream,
             error(
                 "Offset '{OFFSET}' exceeds file size '{SIZE}' for file handle {FILE_HANDLE}",
                 "OFFSET", offset, "SIZE", fileSize, "FILE_HANDLE", fileHandle);
-            return PLDM_DATA_OUT_OF_RANGE;
+            done(PLDM_DATA_OUT_OF_RANGE, 0);
+            return;
         }
         if (offset + length > fileSize)
         {
@@ -116,15 +159,18 @@ int FileHandler::transferFileData(const fs::path& path, bool upstream,
     if (file == -1)
     {
         error("File '{PATH}' does not exist.", "PATH", path);
-        return PLDM_ERROR;
+        done(PLDM_ERROR, 0);
+        return;
     }
-    utils::CustomFD fd(file);
 
-    return transferFileData(fd(), upstream, offset, length, address);
+    queueTransfer(transferType, false,
+                  std::make_shared<pldm::utils::CustomFD>(file), upstream,
+                  offset, length, address, std::move(done));
 }
 
-std::unique_ptr<FileHandler> getHandlerByType(uint16_t fileType,
-                                              uint32_t fileHandle)
+/** @brief Create the file handler of a file type */
+static std::unique_ptr<FileHandler> createHandler(uint16_t fileType,
+                                                  uint32_t fileHandle)
 {
     switch (fileType)
     {
@@ -184,17 +230,36 @@ std::unique_ptr<FileHandler> getHandlerByType(uint16_t fileType,
     return nullptr;
 }
 
+std::unique_ptr<FileHandler> getHandlerByType(uint16_t fileType,
+                                              uint32_t fileHandle)
+{
+    auto handler = createHandler(fileType, fileHandle);
+    if (handler)
+    {
+        handler->setTransferType(fileType);
+    }
+    return handler;
+}
+
 int FileHandler::readFile(const std::string& filePath, uint32_t offset,
                           uint32_t& length, Response& response)
 {
-    if (!fs::exists(filePath))
+    return readCachedFile(filePath, offset, length, response, false);
+}
+
+int FileHandler::readCachedFile(const std::string& filePath, uint32_t offset,
+                                uint32_t& length, Response& response,
+                                bool mapped)
+{
+    auto file = FileCache::get().open(filePath, false, mapped);
+    if (!file)
     {
         error("File '{PATH}' and handle {FILE_HANDLE} does not exist", "PATH",
               filePath, "FILE_HANDLE", fileHandle);
         return PLDM_INVALID_FILE_HANDLE;
     }
 
-    size_t fileSize = fs::file_size(filePath);
+    size_t fileSize = file->size();
     if (offset >= fileSize)
     {
         error(
@@ -212,16 +277,15 @@ int FileHandler::readFile(const std::string& filePath, uint32_t offset,
     response.resize(currSize + length);
     auto filePos = reinterpret_cast<char*>(response.data());
     filePos += currSize;
-    std::ifstream stream(filePath, std::ios::in | std::ios::binary);
-    if (stream)
+    auto rc = file->read(offset, length, filePos);
+    if (rc == 0)
     {
-        stream.seekg(offset);
-        stream.read(filePos, length);
         return PLDM_SUCCESS;
     }
+    response.resize(currSize);
     error(
-        "Unable to read file '{PATH}' at offset '{OFFSET}' for length '{LENGTH}'",
-        "PATH", filePath, "OFFSET", offset, "LENGTH", length);
+        "Unable to read file '{PATH}' at offset '{OFFSET}' for length '{LENGTH}', response code '{RC}'",
+        "PATH", filePath, "OFFSET", offset, "LENGTH", length, "RC", rc);
     return PLDM_ERROR;
 }
 
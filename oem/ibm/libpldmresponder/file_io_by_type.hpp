@@ -2,6 +2,9 @@
 
 #include "file_io.hpp"
 
+#include <functional>
+#include <optional>
+
 namespace pldm
 {
 
@@ -18,33 +21,42 @@ namespace fs = std::filesystem;
 class FileHandler
 {
   public:
+    /** @brief Called on the event loop once a memory command is done, with
+     *  its PLDM status code and the length transferred
+     */
+    using TransferCompletion = std::function<void(int rc, uint32_t length)>;
+
     /** @brief Method to write an oem file type from host memory. Individual
      *  file types need to override this method to do the file specific
-     *  processing
+     *  processing. The DMA transfer runs off the event loop.
      *  @param[in] offset - offset to read/write
      *  @param[in] length - length to be read/write mentioned by Host
      *  @param[in] address - DMA address
      *  @param[in] oemPlatformHandler - oem handler for PLDM platform related
      *                                  tasks
-     *  @return PLDM status code
+     *  @param[in] done - called once the file is written, possibly before
+     *                    the method returns
      */
-    virtual int writeFromMemory(uint32_t offset, uint32_t length,
-                                uint64_t address,
-                                oem_platform::Handler* oemPlatformHandler) = 0;
+    virtual void writeFromMemory(uint32_t offset, uint32_t length,
+                                 uint64_t address,
+                                 oem_platform::Handler* oemPlatformHandler,
+                                 TransferCompletion done) = 0;
 
     /** @brief Method to read an oem file type into host memory. Individual
      *  file types need to override this method to do the file specific
-     *  processing
+     *  processing. The DMA transfer runs off the event loop.
      *  @param[in] offset - offset to read
      *  @param[in] length - length to be read mentioned by Host
      *  @param[in] address - DMA address
      *  @param[in] oemPlatformHandler - oem handler for PLDM platform related
      *                                  tasks
-     *  @return PLDM status code
+     *  @param[in] done - called once the file is read, possibly before the
+     *                    method returns
      */
-    virtual int readIntoMemory(uint32_t offset, uint32_t length,
-                               uint64_t address,
-                               oem_platform::Handler* oemPlatformHandler) = 0;
+    virtual void readIntoMemory(uint32_t offset, uint32_t length,
+                                uint64_t address,
+                                oem_platform::Handler* oemPlatformHandler,
+                                TransferCompletion done) = 0;
 
     /** @brief Method to read an oem file type's content into the PLDM response.
      *  @param[in] offset - offset to read
@@ -89,6 +101,19 @@ class FileHandler
     virtual int readFile(const std::string& filePath, uint32_t offset,
                          uint32_t& length, Response& response);
 
+    /** @brief Method to read a file kept open across the requests into the
+     *  PLDM response.
+     *  @param[in] filePath - file to read from
+     *  @param[in] offset - offset to read
+     *  @param[in/out] length - length to be read
+     *  @param[in] response - PLDM response
+     *  @param[in] mapped - read from a mapping of the file, for files which
+     *                      are only read
+     *  @return PLDM status code
+     */
+    int readCachedFile(const std::string& filePath, uint32_t offset,
+                       uint32_t& length, Response& response, bool mapped);
+
     /** @brief Method to process a file ack with meta data notification from the
      *  host. The bmc can chose to do different actions based on the file type.
      *
@@ -105,27 +130,36 @@ class FileHandler
         uint32_t metaDataValue3, uint32_t metaDataValue4) = 0;
 
     /** @brief Method to do the file content transfer ove DMA between host and
-     *  bmc. This method is made virtual to be overridden in test case. And need
-     *  not be defined in other child classes
+     *  bmc, off the event loop. This method is made virtual to be overridden
+     *  in test case. And need not be defined in other child classes
      *
      *  @param[in] path - file system path  where read/write will be done
      *  @param[in] upstream - direction of DMA transfer. "false" means a
      *                        transfer from host to BMC
      *  @param[in] offset - offset to read/write
-     *  @param[in/out] length - length to be read/write mentioned by Host
+     *  @param[in] length - length to be read/write mentioned by Host, a read
+     *                      stops at the end of the file
      *  @param[in] address - DMA address
-     *
-     *  @return PLDM status code
+     *  @param[in] done - called with the PLDM status code and the length
+     *                    transferred
      */
-    virtual int transferFileData(const fs::path& path, bool upstream,
-                                 uint32_t offset, uint32_t& length,
-                                 uint64_t address);
+    virtual void transferFileData(const fs::path& path, bool upstream,
+                                  uint32_t offset, uint32_t length,
+                                  uint64_t address, TransferCompletion done);
 
-    virtual int transferFileData(int fd, bool upstream, uint32_t offset,
-                                 uint32_t& length, uint64_t address);
+    /** @brief Same as above, for a file already open, which the caller may
+     *  close once the method returned
+     */
+    virtual void transferFileData(int fd, bool upstream, uint32_t offset,
+                                  uint32_t length, uint64_t address,
+                                  TransferCompletion done);
 
-    virtual int transferFileDataToSocket(int fd, uint32_t& length,
-                                         uint64_t address);
+    /** @brief Method to transfer host data on to a socket over DMA, off the
+     *  event loop, see transferFileData
+     */
+    virtual void transferFileDataToSocket(int fd, uint32_t length,
+                                          uint64_t address,
+                                          TransferCompletion done);
 
     /** @brief method to process a new file available metadata notification from
      *  the host
@@ -150,8 +184,20 @@ class FileHandler
      */
     virtual ~FileHandler() {}
 
+    /** @brief Method to set the file type the DMA transfers of the handler
+     *  are recorded under
+     *  @param[in] type - PLDM file type
+     */
+    void setTransferType(uint16_t type)
+    {
+        transferType = type;
+    }
+
   protected:
     uint32_t fileHandle; //!< file handle indicating name of file or invalid
+
+    /** @brief PLDM file type the DMA transfers are recorded under */
+    uint16_t transferType = dma::untypedTransfers;
 };
 
 /** @brief Method to create individual file handler objects based on file type
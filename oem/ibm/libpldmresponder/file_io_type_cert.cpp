@@ -7,6 +7,7 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <cstdint>
 
 PHOSPHOR_LOG2_USING;
@@ -23,9 +24,10 @@ static constexpr auto certFilePath = "/var/lib/ibm/bmcweb/";
 
 CertMap CertHandler::certMap;
 
-int CertHandler::writeFromMemory(uint32_t offset, uint32_t length,
-                                 uint64_t address,
-                                 oem_platform::Handler* /*oemPlatformHandler*/)
+void CertHandler::writeFromMemory(uint32_t offset, uint32_t length,
+                                  uint64_t address,
+                                  oem_platform::Handler* /*oemPlatformHandler*/,
+                                  TransferCompletion done)
 {
     auto it = certMap.find(certType);
     if (it == certMap.end())
@@ -33,41 +35,48 @@ int CertHandler::writeFromMemory(uint32_t offset, uint32_t length,
         error(
             "Failed to find file type '{TYPE}' in certificate map. Write from memory during certificate exchange failed",
             "TYPE", certType);
-        return PLDM_ERROR;
+        done(PLDM_ERROR, 0);
+        return;
     }
 
     auto fd = std::get<0>(it->second);
-    auto& remSize = std::get<1>(it->second);
-    auto rc = transferFileData(fd, false, offset, length, address);
-    if (rc == PLDM_SUCCESS)
-    {
-        remSize -= length;
-        if (!remSize)
-        {
-            close(fd);
-            certMap.erase(it);
-        }
-    }
-    return rc;
+    transferFileData(
+        fd, false, offset, length, address,
+        [certType = certType, done](int rc, uint32_t length) {
+            // The certificate may have been reset while the data was in
+            // flight
+            auto it = certMap.find(certType);
+            if (rc == PLDM_SUCCESS && it != certMap.end())
+            {
+                auto& remSize = std::get<1>(it->second);
+                remSize -= std::min<RemainingSize>(remSize, length);
+                if (!remSize)
+                {
+                    close(std::get<0>(it->second));
+                    certMap.erase(it);
+                }
+            }
+            done(rc, length);
+        });
 }
 
-int CertHandler::readIntoMemory(uint32_t offset, uint32_t length,
-                                uint64_t address,
-                                oem_platform::Handler* /*oemPlatformHandler*/)
+void CertHandler::readIntoMemory(uint32_t offset, uint32_t length,
+                                 uint64_t address,
+                                 oem_platform::Handler* /*oemPlatformHandler*/,
+                                 TransferCompletion done)
 {
     std::string filePath = certFilePath;
     filePath += "CSR_" + std::to_string(fileHandle);
     if (certType != PLDM_FILE_TYPE_CERT_SIGNING_REQUEST)
     {
-        return PLDM_ERROR_INVALID_DATA;
-    }
-    auto rc = transferFileData(filePath.c_str(), true, offset, length, address);
-    fs::remove(filePath);
-    if (rc)
-    {
-        return PLDM_ERROR;
+        done(PLDM_ERROR_INVALID_DATA, 0);
+        return;
     }
-    return PLDM_SUCCESS;
+    transferFileData(filePath, true, offset, length, address,
+                     [filePath, done](int rc, uint32_t length) {
+                         fs::remove(filePath);
+                         done(rc ? PLDM_ERROR : PLDM_SUCCESS, length);
+                     });
 }
 
 int CertHandler::read(uint32_t offset, uint32_t& length, Response& response,
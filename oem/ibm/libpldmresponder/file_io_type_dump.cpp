@@ -172,8 +172,9 @@ std::string DumpHandler::getOffloadUri(uint32_t fileHandle)
     return socketInterface;
 }
 
-int DumpHandler::writeFromMemory(uint32_t, uint32_t length, uint64_t address,
-                                 oem_platform::Handler* /*oemPlatformHandler*/)
+void DumpHandler::writeFromMemory(uint32_t, uint32_t length, uint64_t address,
+                                  oem_platform::Handler* /*oemPlatformHandler*/,
+                                  TransferCompletion done)
 {
     if (DumpHandler::fd == -1)
     {
@@ -187,12 +188,22 @@ int DumpHandler::writeFromMemory(uint32_t, uint32_t length, uint64_t address,
                 "Failed to setup Unix socket while write from memory for interface '{INTERFACE}', response code '{SOCKET_RC}'",
                 "INTERFACE", socketInterface, "SOCKET_RC", sock);
             std::remove(socketInterface.c_str());
-            return PLDM_ERROR;
+            done(PLDM_ERROR, 0);
+            return;
         }
 
         DumpHandler::fd = sock;
     }
-    return transferFileDataToSocket(DumpHandler::fd, length, address);
+    transferFileDataToSocket(
+        DumpHandler::fd, length, address, [done](int rc, uint32_t length) {
+            // The next chunk sets the socket up again
+            if (rc != PLDM_SUCCESS && DumpHandler::fd >= 0)
+            {
+                close(DumpHandler::fd);
+                DumpHandler::fd = -1;
+            }
+            done(rc, length);
+        });
 }
 
 int DumpHandler::write(const char* buffer, uint32_t, uint32_t& length,
@@ -327,15 +338,18 @@ int DumpHandler::fileAck(uint8_t fileStatus)
     return PLDM_ERROR;
 }
 
-int DumpHandler::readIntoMemory(uint32_t offset, uint32_t length,
-                                uint64_t address,
-                                oem_platform::Handler* /*oemPlatformHandler*/)
+void DumpHandler::readIntoMemory(uint32_t offset, uint32_t length,
+                                 uint64_t address,
+                                 oem_platform::Handler* /*oemPlatformHandler*/,
+                                 TransferCompletion done)
 {
     if (dumpType != PLDM_FILE_TYPE_RESOURCE_DUMP_PARMS)
     {
-        return PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
+        done(PLDM_ERROR_UNSUPPORTED_PLDM_CMD, 0);
+        return;
     }
-    return transferFileData(resDumpDirPath, true, offset, length, address);
+    transferFileData(resDumpDirPath, true, offset, length, address,
+                     std::move(done));
 }
 
 int DumpHandler::read(uint32_t offset, uint32_t& length, Response& response,
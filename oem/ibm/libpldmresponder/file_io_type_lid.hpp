@@ -94,11 +94,11 @@ class LidHandler : public FileHandler
         return true;
     }
 
-    virtual int writeFromMemory(uint32_t offset, uint32_t length,
-                                uint64_t address,
-                                oem_platform::Handler* oemPlatformHandler)
+    virtual void writeFromMemory(uint32_t offset, uint32_t length,
+                                 uint64_t address,
+                                 oem_platform::Handler* oemPlatformHandler,
+                                 TransferCompletion done)
     {
-        int rc = PLDM_SUCCESS;
         bool codeUpdateInProgress = false;
         if (oemPlatformHandler != nullptr)
         {
@@ -131,51 +131,61 @@ class LidHandler : public FileHandler
         {
             error("Failed to open file '{LID_PATH}' for writing", "LID_PATH",
                   lidPath);
-            return PLDM_ERROR;
+            done(PLDM_ERROR, 0);
+            return;
         }
         close(fd);
 
-        rc = transferFileData(lidPath, false, offset, length, address);
-        if (rc != PLDM_SUCCESS)
-        {
-            error("Failed to write file from memory with response code '{RC}'",
-                  "RC", rc);
-            return rc;
-        }
-        if (lidType == PLDM_FILE_TYPE_LID_MARKER)
-        {
-            markerLIDremainingSize -= length;
-            if (markerLIDremainingSize == 0)
-            {
-                pldm::responder::oem_ibm_platform::Handler*
-                    oemIbmPlatformHandler = dynamic_cast<
-                        pldm::responder::oem_ibm_platform::Handler*>(
-                        oemPlatformHandler);
-                auto sensorId =
-                    oemIbmPlatformHandler->codeUpdate->getMarkerLidSensor();
-                using namespace pldm::responder::oem_ibm_platform;
-                oemIbmPlatformHandler->sendStateSensorEvent(
-                    sensorId, PLDM_STATE_SENSOR_STATE, 0, VALID, VALID);
-                // rc = validate api;
-                rc = PLDM_SUCCESS;
-            }
-        }
-        else if (codeUpdateInProgress)
-        {
-            rc = processCodeUpdateLid(lidPath);
-        }
-        return rc;
+        transferFileData(
+            lidPath, false, offset, length, address,
+            [this, oemPlatformHandler, codeUpdateInProgress,
+             done](int rc, uint32_t length) {
+                if (rc != PLDM_SUCCESS)
+                {
+                    error(
+                        "Failed to write file from memory with response code '{RC}'",
+                        "RC", rc);
+                    done(rc, length);
+                    return;
+                }
+                if (lidType == PLDM_FILE_TYPE_LID_MARKER)
+                {
+                    markerLIDremainingSize -= length;
+                    if (markerLIDremainingSize == 0)
+                    {
+                        pldm::responder::oem_ibm_platform::Handler*
+                            oemIbmPlatformHandler = dynamic_cast<
+                                pldm::responder::oem_ibm_platform::Handler*>(
+                                oemPlatformHandler);
+                        auto sensorId = oemIbmPlatformHandler->codeUpdate
+                                            ->getMarkerLidSensor();
+                        using namespace pldm::responder::oem_ibm_platform;
+                        oemIbmPlatformHandler->sendStateSensorEvent(
+                            sensorId, PLDM_STATE_SENSOR_STATE, 0, VALID, VALID);
+                        // rc = validate api;
+                        rc = PLDM_SUCCESS;
+                    }
+                }
+                else if (codeUpdateInProgress)
+                {
+                    rc = processCodeUpdateLid(lidPath);
+                }
+                done(rc, length);
+            });
     }
 
-    virtual int readIntoMemory(uint32_t offset, uint32_t length,
-                               uint64_t address,
-                               oem_platform::Handler* oemPlatformHandler)
+    virtual void readIntoMemory(uint32_t offset, uint32_t length,
+                                uint64_t address,
+                                oem_platform::Handler* oemPlatformHandler,
+                                TransferCompletion done)
     {
         if (constructLIDPath(oemPlatformHandler))
         {
-            return transferFileData(lidPath, true, offset, length, address);
+            transferFileData(lidPath, true, offset, length, address,
+                             std::move(done));
+            return;
         }
-        return PLDM_ERROR;
+        done(PLDM_ERROR, 0);
     }
 
     virtual int write(const char* buffer, uint32_t offset, uint32_t& length,
@@ -287,7 +297,8 @@ class LidHandler : public FileHandler
     {
         if (constructLIDPath(oemPlatformHandler))
         {
-            return readFile(lidPath, offset, length, response);
+            // LIDs are read in small chunks and only replaced by a code update
+            return readCachedFile(lidPath, offset, length, response, true);
         }
         return PLDM_ERROR;
     }
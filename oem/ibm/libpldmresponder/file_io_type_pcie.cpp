@@ -5,7 +5,10 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <string>
 
 PHOSPHOR_LOG2_USING;
 
@@ -89,9 +92,9 @@ PCIeInfoHandler::PCIeInfoHandler(uint32_t fileHandle, uint16_t fileType) :
     receivedFiles.emplace(infoType, false);
 }
 
-int PCIeInfoHandler::writeFromMemory(
+void PCIeInfoHandler::writeFromMemory(
     uint32_t offset, uint32_t length, uint64_t address,
-    oem_platform::Handler* /*oemPlatformHandler*/)
+    oem_platform::Handler* /*oemPlatformHandler*/, TransferCompletion done)
 {
     if (!fs::exists(pciePath))
     {
@@ -109,21 +112,25 @@ int PCIeInfoHandler::writeFromMemory(
     try
     {
         std::ofstream pcieData(infoFile, std::ios::out | std::ios::binary);
-        auto rc = transferFileData(infoFile, false, offset, length, address);
-        if (rc != PLDM_SUCCESS)
-        {
-            error("TransferFileData failed in PCIeTopology with error {ERROR}",
-                  "ERROR", rc);
-            return rc;
-        }
-        return PLDM_SUCCESS;
     }
     catch (const std::exception& e)
     {
         error("Create/Write data to the File type {TYPE}, failed {ERROR}",
               "TYPE", infoType, "ERROR", e);
-        return PLDM_ERROR;
+        done(PLDM_ERROR, 0);
+        return;
     }
+
+    transferFileData(infoFile, false, offset, length, address,
+                     [done](int rc, uint32_t length) {
+                         if (rc != PLDM_SUCCESS)
+                         {
+                             error(
+                                 "TransferFileData failed in PCIeTopology with error {ERROR}",
+                                 "ERROR", rc);
+                         }
+                         done(rc, length);
+                     });
 }
 
 int PCIeInfoHandler::write(const char* buffer, uint32_t, uint32_t& length,
@@ -177,6 +184,89 @@ int PCIeInfoHandler::fileAck(uint8_t /*fileStatus*/)
     return PLDM_SUCCESS;
 }
 
+/** @class BlobView
+ *
+ *  Bounds checked view of a file written by the host. The records are read
+ *  in place from the mapping of the file, and a record or a string crossing
+ *  the end of the file is rejected rather than read past the mapping.
+ */
+class BlobView
+{
+  public:
+    BlobView(const void* data, size_t size) :
+        data(static_cast<const uint8_t*>(data)), size(size)
+    {}
+
+    /** @brief Get a record of the file
+     *
+     *  @param[in] offset - offset of the record in the file
+     *  @param[in] length - length of the record
+     *
+     *  @return the record, nullptr if it does not fit in the file
+     */
+    template <typename T>
+    const T* at(size_t offset, size_t length = sizeof(T)) const
+    {
+        if (offset > size || length > size - offset)
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<const T*>(data + offset);
+    }
+
+    /** @brief Get a string of the file
+     *
+     *  @param[in] offset - offset of the string in the file
+     *  @param[in] length - length of the string
+     *
+     *  @return the string, std::nullopt if it does not fit in the file
+     */
+    std::optional<std::string> string(size_t offset, size_t length) const
+    {
+        auto str = at<char>(offset, length);
+        if (!str)
+        {
+            return std::nullopt;
+        }
+        return std::string(str, length);
+    }
+
+  private:
+    const uint8_t* data;
+    size_t size;
+};
+
+/** @brief Update a cache with the information parsed from a new file,
+ *         leaving the unchanged entries untouched
+ *
+ *  @param[in,out] cache - information of the previous file
+ *  @param[in] parsed - information of the new file
+ *
+ *  @return number of entries added, changed or removed
+ */
+template <typename Map>
+static size_t updateCache(Map& cache, Map&& parsed)
+{
+    size_t changed = std::erase_if(cache, [&parsed](const auto& entry) {
+        return !parsed.contains(entry.first);
+    });
+    for (auto& [key, value] : parsed)
+    {
+        auto it = cache.find(key);
+        if (it == cache.end())
+        {
+            cache.emplace(key, std::move(value));
+            ++changed;
+        }
+        else if (it->second != value)
+        {
+            it->second = std::move(value);
+            ++changed;
+        }
+    }
+    return changed;
+}
+
 void PCIeInfoHandler::parseTopologyData()
 {
     int fd = open((fs::path(pciePath) / topologyFile).string().c_str(),
@@ -218,11 +308,15 @@ void PCIeInfoHandler::parseTopologyData()
     std::unique_ptr<void, decltype(topologyCleanup)> topologyPtr(
         fileInMemory, topologyCleanup);
 
-    auto pcieLinkList = reinterpret_cast<struct topologyBlob*>(fileInMemory);
+    BlobView blob(fileInMemory, sb.st_size);
+    constexpr size_t topologyHeaderSize = offsetof(topologyBlob, pciLinkEntry);
+    auto pcieLinkList = blob.at<topologyBlob>(0, topologyHeaderSize);
     uint16_t numOfLinks = 0;
     if (!pcieLinkList)
     {
-        error("Parsing of topology file failed : pcieLinkList is null");
+        error("Parsing of topology file failed : file of size {SIZE} is "
+              "truncated",
+              "SIZE", sb.st_size);
         return;
     }
 
@@ -241,24 +335,28 @@ void PCIeInfoHandler::parseTopologyData()
 
     numOfLinks = htobe16(pcieLinkList->numPcieLinkEntries);
 
-    // To fetch the PCIe link from the topology data, moving the pointer
-    // by 8 bytes based on the size of other elements of the structure
-    struct pcieLinkEntry* singleEntryData =
-        reinterpret_cast<struct pcieLinkEntry*>(
-            reinterpret_cast<uint8_t*>(pcieLinkList) + 8);
-
-    if (!singleEntryData)
-    {
-        error("Parsing of topology file failed : single_link is null");
-        return;
-    }
-
-    auto singleEntryDataCharStream = reinterpret_cast<char*>(singleEntryData);
+    // The links are parsed into new maps first, a truncated file leaves the
+    // information of the previous topology in place
+    decltype(topologyInformation) links;
+    decltype(linkTypeInfo) linkTypes;
 
     // iterate over every pcie link and get the link specific attributes
+    constexpr size_t linkEntrySize =
+        offsetof(pcieLinkEntry, pciLinkEntryLocCode);
+    size_t entryOffset = topologyHeaderSize;
     for ([[maybe_unused]] const auto& link :
          std::views::iota(0) | std::views::take(numOfLinks))
     {
+        auto singleEntryData =
+            blob.at<pcieLinkEntry>(entryOffset, linkEntrySize);
+        if (!singleEntryData)
+        {
+            error(
+                "Parsing of topology file failed : link entry at offset {OFFSET} is truncated",
+                "OFFSET", entryOffset);
+            return;
+        }
+
         // get the link id
         auto linkId = htobe16(singleEntryData->linkId);
 
@@ -272,7 +370,7 @@ void PCIeInfoHandler::parseTopologyData()
         auto type = singleEntryData->linkType;
         if (type != pldm::responder::linkTypeData::Unknown)
         {
-            linkTypeInfo[linkId] = type;
+            linkTypes[linkId] = type;
         }
 
         // get link speed
@@ -282,88 +380,64 @@ void PCIeInfoHandler::parseTopologyData()
         auto width = singleEntryData->linkWidth;
 
         // get the PCIe Host Bridge Location
-        size_t pcieLocCodeSize = singleEntryData->pcieHostBridgeLocCodeSize;
-        std::vector<char> pcieHostBridgeLocation(
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->pcieHostBridgeLocCodeOff),
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->pcieHostBridgeLocCodeOff) +
-                static_cast<int>(pcieLocCodeSize));
-        std::string pcieHostBridgeLocationCode(pcieHostBridgeLocation.begin(),
-                                               pcieHostBridgeLocation.end());
+        auto pcieHostBridgeLocationCode = blob.string(
+            entryOffset + htobe16(singleEntryData->pcieHostBridgeLocCodeOff),
+            singleEntryData->pcieHostBridgeLocCodeSize);
 
         // get the local port - top location
-        size_t localTopPortLocSize = singleEntryData->topLocalPortLocCodeSize;
-        std::vector<char> localTopPortLocation(
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->topLocalPortLocCodeOff),
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->topLocalPortLocCodeOff) +
-                static_cast<int>(localTopPortLocSize));
-        std::string localTopPortLocationCode(localTopPortLocation.begin(),
-                                             localTopPortLocation.end());
+        auto localTopPortLocationCode = blob.string(
+            entryOffset + htobe16(singleEntryData->topLocalPortLocCodeOff),
+            singleEntryData->topLocalPortLocCodeSize);
 
         // get the local port - bottom location
-        size_t localBottomPortLocSize =
-            singleEntryData->bottomLocalPortLocCodeSize;
-        std::vector<char> localBottomPortLocation(
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->bottomLocalPortLocCodeOff),
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->bottomLocalPortLocCodeOff) +
-                static_cast<int>(localBottomPortLocSize));
-        std::string localBottomPortLocationCode(localBottomPortLocation.begin(),
-                                                localBottomPortLocation.end());
+        auto localBottomPortLocationCode = blob.string(
+            entryOffset + htobe16(singleEntryData->bottomLocalPortLocCodeOff),
+            singleEntryData->bottomLocalPortLocCodeSize);
 
         // get the remote port - top location
-        size_t remoteTopPortLocSize = singleEntryData->topRemotePortLocCodeSize;
-        std::vector<char> remoteTopPortLocation(
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->topRemotePortLocCodeOff),
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->topRemotePortLocCodeOff) +
-                static_cast<int>(remoteTopPortLocSize));
-        std::string remoteTopPortLocationCode(remoteTopPortLocation.begin(),
-                                              remoteTopPortLocation.end());
+        auto remoteTopPortLocationCode = blob.string(
+            entryOffset + htobe16(singleEntryData->topRemotePortLocCodeOff),
+            singleEntryData->topRemotePortLocCodeSize);
 
         // get the remote port - bottom location
-        size_t remoteBottomLocSize =
-            singleEntryData->bottomRemotePortLocCodeSize;
-        std::vector<char> remoteBottomPortLocation(
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->bottomRemotePortLocCodeOff),
-            singleEntryDataCharStream +
-                htobe16(singleEntryData->bottomRemotePortLocCodeOff) +
-                static_cast<int>(remoteBottomLocSize));
-        std::string remoteBottomPortLocationCode(
-            remoteBottomPortLocation.begin(), remoteBottomPortLocation.end());
-
-        struct slotLocCode* slotData = reinterpret_cast<struct slotLocCode*>(
-            (reinterpret_cast<uint8_t*>(singleEntryData)) +
-            htobe16(singleEntryData->slotLocCodesOffset));
+        auto remoteBottomPortLocationCode = blob.string(
+            entryOffset + htobe16(singleEntryData->bottomRemotePortLocCodeOff),
+            singleEntryData->bottomRemotePortLocCodeSize);
+
+        if (!pcieHostBridgeLocationCode || !localTopPortLocationCode ||
+            !localBottomPortLocationCode || !remoteTopPortLocationCode ||
+            !remoteBottomPortLocationCode)
+        {
+            error(
+                "Parsing of topology file failed : location codes of link {LINK_ID} are truncated",
+                "LINK_ID", linkId);
+            return;
+        }
+
+        size_t slotOffset =
+            entryOffset + htobe16(singleEntryData->slotLocCodesOffset);
+        auto slotData =
+            blob.at<slotLocCode>(slotOffset, slotLocationDataMemberSize);
         if (!slotData)
         {
-            error("Parsing the topology file failed : slotData is null");
+            error("Parsing the topology file failed : slotData is truncated");
             return;
         }
         // get the Slot location code common part
         size_t numOfSlots = slotData->numSlotLocCodes;
-        size_t slotLocCodeCompartSize = slotData->slotLocCodesCmnPrtSize;
-        std::vector<char> slotLocation(
-            reinterpret_cast<char*>(slotData->slotLocCodesCmnPrt),
-            (reinterpret_cast<char*>(slotData->slotLocCodesCmnPrt) +
-             static_cast<int>(slotLocCodeCompartSize)));
-        std::string slotLocationCode(slotLocation.begin(), slotLocation.end());
-
-        uint8_t* suffixData =
-            reinterpret_cast<uint8_t*>(slotData) + slotLocationDataMemberSize +
-            slotData->slotLocCodesCmnPrtSize;
-        if (!suffixData)
+        auto slotLocationCode =
+            blob.string(slotOffset + slotLocationDataMemberSize,
+                        slotData->slotLocCodesCmnPrtSize);
+        if (!slotLocationCode)
         {
-            error("slot location suffix data is nullptr");
+            error("Parsing the topology file failed : slot location code "
+                  "common part is truncated");
             return;
         }
 
+        size_t suffixOffset = slotOffset + slotLocationDataMemberSize +
+                              slotData->slotLocCodesCmnPrtSize;
+
         // create the full slot location code by combining common part and
         // suffix part
         std::string slotSuffixLocationCode;
@@ -371,49 +445,61 @@ void PCIeInfoHandler::parseTopologyData()
         for ([[maybe_unused]] const auto& slot :
              std::views::iota(0) | std::views::take(numOfSlots))
         {
-            struct slotLocCodeSuf* slotLocSufData =
-                reinterpret_cast<struct slotLocCodeSuf*>(suffixData);
+            auto slotLocSufData = blob.at<slotLocCodeSuf>(
+                suffixOffset, sizeOfSuffixSizeDataMember);
             if (!slotLocSufData)
             {
-                error("slot location suffix data is nullptr");
-                break;
+                error("slot location suffix data is truncated");
+                return;
             }
 
             size_t slotLocCodeSuffixSize = slotLocSufData->slotLocCodeSz;
             if (slotLocCodeSuffixSize > 0)
             {
-                std::vector<char> slotSuffixLocation(
-                    reinterpret_cast<char*>(slotLocSufData) + 1,
-                    reinterpret_cast<char*>(slotLocSufData) + 1 +
-                        static_cast<int>(slotLocCodeSuffixSize));
-                std::string slotSuffLocationCode(slotSuffixLocation.begin(),
-                                                 slotSuffixLocation.end());
-
-                slotSuffixLocationCode = slotSuffLocationCode;
+                auto slotSuffLocationCode =
+                    blob.string(suffixOffset + sizeOfSuffixSizeDataMember,
+                                slotLocCodeSuffixSize);
+                if (!slotSuffLocationCode)
+                {
+                    error("slot location suffix is truncated");
+                    return;
+                }
+                slotSuffixLocationCode = std::move(*slotSuffLocationCode);
             }
-            std::string slotFullLocationCode =
-                slotLocationCode + slotSuffixLocationCode;
-            slotFinaLocationCode.push_back(slotFullLocationCode);
+            slotFinaLocationCode.push_back(*slotLocationCode +
+                                           slotSuffixLocationCode);
 
-            // move the pointer to next slot
-            suffixData += sizeOfSuffixSizeDataMember + slotLocCodeSuffixSize;
+            // move the offset to next slot
+            suffixOffset += sizeOfSuffixSizeDataMember + slotLocCodeSuffixSize;
         }
 
         // store the information into a map
-        topologyInformation[linkId] = std::make_tuple(
+        links[linkId] = std::make_tuple(
             linkStateMap[linkStatus], type, linkSpeed, linkWidth[width],
-            pcieHostBridgeLocationCode,
-            std::make_pair(localTopPortLocationCode,
-                           localBottomPortLocationCode),
-            std::make_pair(remoteTopPortLocationCode,
-                           remoteBottomPortLocationCode),
-            slotFinaLocationCode, parentLinkId);
-
-        // move the pointer to next link
-        singleEntryData = reinterpret_cast<struct pcieLinkEntry*>(
-            reinterpret_cast<uint8_t*>(singleEntryData) +
-            htobe16(singleEntryData->entryLength));
+            std::move(*pcieHostBridgeLocationCode),
+            std::make_pair(std::move(*localTopPortLocationCode),
+                           std::move(*localBottomPortLocationCode)),
+            std::make_pair(std::move(*remoteTopPortLocationCode),
+                           std::move(*remoteBottomPortLocationCode)),
+            std::move(slotFinaLocationCode), parentLinkId);
+
+        // move the offset to next link
+        auto entryLength = htobe16(singleEntryData->entryLength);
+        if (entryLength < linkEntrySize)
+        {
+            error(
+                "Parsing of topology file failed : invalid length {LENGTH} of link {LINK_ID}",
+                "LENGTH", entryLength, "LINK_ID", linkId);
+            return;
+        }
+        entryOffset += entryLength;
     }
+
+    linkTypeInfo = std::move(linkTypes);
+    auto changed = updateCache(topologyInformation, std::move(links));
+    info("Parsed PCIe topology of {LINKS} links, {CHANGED} changed", "LINKS",
+         numOfLinks, "CHANGED", changed);
+
     // Need to call cable info at the end , because we dont want to parse
     // cable info without parsing the successful topology successfully
     // Having partial information is of no use.
@@ -461,56 +547,83 @@ void PCIeInfoHandler::parseCableInfo()
     std::unique_ptr<void, decltype(cableInfoCleanup)> cablePtr(
         fileInMemory, cableInfoCleanup);
 
-    auto cableList =
-        reinterpret_cast<struct cableAttributesList*>(fileInMemory);
+    BlobView blob(fileInMemory, sb.st_size);
+    auto cableList = blob.at<cableAttributesList>(
+        0, offsetof(cableAttributesList, pciLinkCableAttr));
+    if (!cableList)
+    {
+        error("Cable info parsing failed : file of size {SIZE} is truncated",
+              "SIZE", sb.st_size);
+        return;
+    }
 
     // get number of cable links
     auto numOfCableLinks = htobe16(cableList->numOfCables);
 
-    struct pcieLinkCableAttr* cableData =
-        reinterpret_cast<struct pcieLinkCableAttr*>(
-            (reinterpret_cast<uint8_t*>(cableList)) +
-            (sizeof(struct cableAttributesList) - 1));
-
-    if (!cableData)
-    {
-        error("Cable info parsing failed , cableData = nullptr");
-        return;
-    }
+    decltype(cableInformation) cables;
 
     // iterate over each pci cable link
+    constexpr size_t cableEntrySize =
+        offsetof(pcieLinkCableAttr, cableAttrLocCode);
+    size_t entryOffset = sizeof(struct cableAttributesList) - 1;
     for (const auto& cable :
          std::views::iota(0) | std::views::take(numOfCableLinks))
     {
+        auto cableData = blob.at<pcieLinkCableAttr>(entryOffset, cableEntrySize);
+        if (!cableData)
+        {
+            error(
+                "Cable info parsing failed : cable entry at offset {OFFSET} is truncated",
+                "OFFSET", entryOffset);
+            return;
+        }
+
         // get the link id
         auto linkId = htobe16(cableData->linkId);
-        char* cableDataPtr = reinterpret_cast<char*>(cableData);
 
-        std::string localPortLocCode(
-            cableDataPtr + htobe16(cableData->hostPortLocationCodeOffset),
+        auto localPortLocCode = blob.string(
+            entryOffset + htobe16(cableData->hostPortLocationCodeOffset),
             cableData->hostPortLocationCodeSize);
 
-        std::string ioSlotLocationCode(
-            cableDataPtr +
-                htobe16(cableData->ioEnclosurePortLocationCodeOffset),
+        auto ioSlotLocationCode = blob.string(
+            entryOffset + htobe16(cableData->ioEnclosurePortLocationCodeOffset),
             cableData->ioEnclosurePortLocationCodeSize);
 
-        std::string cablePartNum(
-            cableDataPtr + htobe16(cableData->cablePartNumberOffset),
+        auto cablePartNum = blob.string(
+            entryOffset + htobe16(cableData->cablePartNumberOffset),
             cableData->cablePartNumberSize);
 
+        if (!localPortLocCode || !ioSlotLocationCode || !cablePartNum)
+        {
+            error(
+                "Cable info parsing failed : attributes of the cable of link {LINK_ID} are truncated",
+                "LINK_ID", linkId);
+            return;
+        }
+
         // cache the data into a map
-        cableInformation[cable] = std::make_tuple(
-            linkId, localPortLocCode, ioSlotLocationCode, cablePartNum,
+        cables[cable] = std::make_tuple(
+            linkId, std::move(*localPortLocCode),
+            std::move(*ioSlotLocationCode), std::move(*cablePartNum),
             cableLengthMap[cableData->cableLength],
             cableTypeMap[cableData->cableType],
             cableStatusMap[cableData->cableStatus]);
-        // move the cable data pointer
 
-        cableData = reinterpret_cast<struct pcieLinkCableAttr*>(
-            (reinterpret_cast<uint8_t*>(cableData)) +
-            htobe16(cableData->entryLength));
+        // move the offset to the next cable
+        auto entryLength = htobe16(cableData->entryLength);
+        if (entryLength < cableEntrySize)
+        {
+            error(
+                "Cable info parsing failed : invalid length {LENGTH} of the cable of link {LINK_ID}",
+                "LENGTH", entryLength, "LINK_ID", linkId);
+            return;
+        }
+        entryOffset += entryLength;
     }
+
+    auto changed = updateCache(cableInformation, std::move(cables));
+    info("Parsed PCIe cable info of {CABLES} cables, {CHANGED} changed",
+         "CABLES", numOfCableLinks, "CHANGED", changed);
 }
 
 } // namespace responder
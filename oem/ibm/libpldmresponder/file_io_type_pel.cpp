@@ -16,7 +16,8 @@
 #include <cstdint>
 #include <exception>
 #include <filesystem>
-#include <fstream>
+#include <memory>
+#include <string>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -37,11 +38,11 @@ namespace detail
  * The severity byte is at offset 10 in the User Header section,
  * which is always after the 48 byte Private Header section.
  *
- * @param[in] pelFileName - The file containing the PEL
+ * @param[in] fd - The open file containing the PEL
  *
  * @return Entry::Level - The severity value for the Entry
  */
-Entry::Level getEntryLevelFromPEL(const std::string& pelFileName)
+Entry::Level getEntryLevelFromPEL(int fd)
 {
     const std::map<uint8_t, Entry::Level> severityMap{
         {0x00, Entry::Level::Informational}, // Informational event
@@ -55,44 +56,33 @@ Entry::Level getEntryLevelFromPEL(const std::string& pelFileName)
 
     const size_t severityOffset = 0x3A;
 
-    size_t size = 0;
-    if (fs::exists(pelFileName))
+    uint8_t sev{};
+    auto rc = pread(fd, &sev, sizeof(sev), severityOffset);
+    if (rc == sizeof(sev))
     {
-        size = fs::file_size(pelFileName);
-    }
-
-    if (size > severityOffset)
-    {
-        std::ifstream pel{pelFileName};
-        if (pel.good())
-        {
-            pel.seekg(severityOffset);
+        // Get the type
+        sev = sev & 0xF0;
 
-            uint8_t sev;
-            pel.read(reinterpret_cast<char*>(&sev), 1);
-
-            // Get the type
-            sev = sev & 0xF0;
-
-            auto entry = severityMap.find(sev);
-            if (entry != severityMap.end())
-            {
-                return entry->second;
-            }
-        }
-        else
+        auto entry = severityMap.find(sev);
+        if (entry != severityMap.end())
         {
-            error("Unable to open PEL file '{FILE}'", "FILE", pelFileName);
+            return entry->second;
         }
     }
+    else if (rc < 0)
+    {
+        error("Unable to read PEL severity, error number - {ERROR_NUM}",
+              "ERROR_NUM", errno);
+    }
 
     return Entry::Level::Error;
 }
 } // namespace detail
 
-int PelHandler::readIntoMemory(uint32_t offset, uint32_t length,
-                               uint64_t address,
-                               oem_platform::Handler* /*oemPlatformHandler*/)
+void PelHandler::readIntoMemory(uint32_t offset, uint32_t length,
+                                uint64_t address,
+                                oem_platform::Handler* /*oemPlatformHandler*/,
+                                TransferCompletion done)
 {
     static constexpr auto logObjPath = "/xyz/openbmc_project/logging";
     static constexpr auto logInterface = "org.open_power.Logging.PEL";
@@ -109,18 +99,15 @@ int PelHandler::readIntoMemory(uint32_t offset, uint32_t length,
         auto reply = bus.call(method, dbusTimeout);
         sdbusplus::message::unix_fd fd{};
         reply.read(fd);
-        auto rc = transferFileData(fd, true, offset, length, address);
-        return rc;
+        transferFileData(fd, true, offset, length, address, std::move(done));
     }
     catch (const std::exception& e)
     {
         error(
             "Failed to get PEL D-Bus call for PEL ID '{FILE_HANDLE}', error - {ERROR}",
             "FILE_HANDLE", lg2::hex, fileHandle, "ERROR", e);
-        return PLDM_ERROR;
+        done(PLDM_ERROR, 0);
     }
-
-    return PLDM_SUCCESS;
 }
 
 int PelHandler::read(uint32_t offset, uint32_t& length, Response& response,
@@ -195,27 +182,37 @@ int PelHandler::read(uint32_t offset, uint32_t& length, Response& response,
     return PLDM_SUCCESS;
 }
 
-int PelHandler::writeFromMemory(uint32_t offset, uint32_t length,
-                                uint64_t address,
-                                oem_platform::Handler* /*oemPlatformHandler*/)
+void PelHandler::writeFromMemory(uint32_t offset, uint32_t length,
+                                 uint64_t address,
+                                 oem_platform::Handler* /*oemPlatformHandler*/,
+                                 TransferCompletion done)
 {
     char tmpFile[] = "/tmp/pel.XXXXXX";
-    int fd = mkstemp(tmpFile);
-    if (fd == -1)
+    int file = mkstemp(tmpFile);
+    if (file == -1)
     {
         error("Failed to create a temporary pel, error number - {ERROR_NUM}",
               "ERROR_NUM", errno);
-        return PLDM_ERROR;
+        done(PLDM_ERROR, 0);
+        return;
     }
-    close(fd);
-    fs::path path(tmpFile);
-
-    auto rc = transferFileData(path, false, offset, length, address);
-    if (rc == PLDM_SUCCESS)
-    {
-        rc = storePel(path.string());
-    }
-    return rc;
+    auto fd = std::make_shared<pldm::utils::CustomFD>(file);
+
+    // The PEL is written by the DMA straight into the file handed over
+    transferFileData(
+        (*fd)(), false, offset, length, address,
+        [this, fd, path = std::string(tmpFile), done](int rc,
+                                                      uint32_t length) {
+            if (rc == PLDM_SUCCESS)
+            {
+                rc = storePel(std::string(path), (*fd)());
+            }
+            else
+            {
+                fs::remove(path);
+            }
+            done(rc, length);
+        });
 }
 
 int PelHandler::fileAck(uint8_t fileStatus)
@@ -299,7 +296,7 @@ int PelHandler::fileAck(uint8_t fileStatus)
     return PLDM_SUCCESS;
 }
 
-int PelHandler::storePel(std::string&& pelFileName)
+int PelHandler::storePel(std::string&& pelFileName, int fd)
 {
     static constexpr auto logObjPath = "/xyz/openbmc_project/logging";
     static constexpr auto logInterface = "xyz.openbmc_project.Logging.Create";
@@ -314,7 +311,7 @@ int PelHandler::storePel(std::string&& pelFileName)
         std::map<std::string, std::string> addlData{};
         auto severity =
             sdbusplus::xyz::openbmc_project::Logging::server::convertForMessage(
-                detail::getEntryLevelFromPEL(pelFileName));
+                detail::getEntryLevelFromPEL(fd));
         addlData.emplace("RAWPEL", std::move(pelFileName));
 
         auto method = bus.new_method_call(service.c_str(), logObjPath,
@@ -356,25 +353,25 @@ int PelHandler::write(const char* buffer, uint32_t offset, uint32_t& length,
     }
 
     char tmpFile[] = "/tmp/pel.XXXXXX";
-    auto fd = mkstemp(tmpFile);
-    if (fd == -1)
+    auto file = mkstemp(tmpFile);
+    if (file == -1)
     {
         error("Failed to create a temporary PEL, error number - {ERROR_NUM}",
               "ERROR_NUM", errno);
         return PLDM_ERROR;
     }
+    pldm::utils::CustomFD fd(file);
 
     size_t written = 0;
     do
     {
-        if ((rc = ::write(fd, buffer, length - written)) == -1)
+        if ((rc = ::write(fd(), buffer, length - written)) == -1)
         {
             break;
         }
         written += rc;
         buffer += rc;
     } while (rc && written < length);
-    close(fd);
 
     if (rc == -1)
     {
@@ -387,8 +384,7 @@ int PelHandler::write(const char* buffer, uint32_t offset, uint32_t& length,
 
     if (written == length)
     {
-        fs::path path(tmpFile);
-        rc = storePel(path.string());
+        rc = storePel(tmpFile, fd());
         if (rc != PLDM_SUCCESS)
         {
             error(
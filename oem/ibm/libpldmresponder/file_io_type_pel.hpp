@@ -19,13 +19,15 @@ class PelHandler : public FileHandler
      */
     PelHandler(uint32_t fileHandle) : FileHandler(fileHandle) {}
 
-    virtual int writeFromMemory(uint32_t offset, uint32_t length,
-                                uint64_t address,
-                                oem_platform::Handler* /*oemPlatformHandler*/);
+    virtual void writeFromMemory(uint32_t offset, uint32_t length,
+                                 uint64_t address,
+                                 oem_platform::Handler* /*oemPlatformHandler*/,
+                                 TransferCompletion done);
 
-    virtual int readIntoMemory(uint32_t offset, uint32_t length,
-                               uint64_t address,
-                               oem_platform::Handler* /*oemPlatformHandler*/);
+    virtual void readIntoMemory(uint32_t offset, uint32_t length,
+                                uint64_t address,
+                                oem_platform::Handler* /*oemPlatformHandler*/,
+                                TransferCompletion done);
 
     virtual int read(uint32_t offset, uint32_t& length, Response& response,
                      oem_platform::Handler* /*oemPlatformHandler*/);
@@ -48,8 +50,9 @@ class PelHandler : public FileHandler
      *  d-bus notification to pel daemon that it is ready for consumption
      *
      *  @param[in] pelFileName - the pel file path
+     *  @param[in] fd - the pel file, still open from being written
      */
-    virtual int storePel(std::string&& pelFileName);
+    virtual int storePel(std::string&& pelFileName, int fd);
 
     virtual int newFileAvailable(uint64_t /*length*/)
     {
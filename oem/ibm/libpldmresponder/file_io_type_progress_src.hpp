@@ -20,21 +20,23 @@ class ProgressCodeHandler : public FileHandler
      */
     ProgressCodeHandler(uint32_t fileHandle) : FileHandler(fileHandle) {}
 
-    int writeFromMemory(uint32_t /*offset*/, uint32_t /*length*/,
-                        uint64_t /*address*/,
-                        oem_platform::Handler* /*oemPlatformHandler*/) override
+    void writeFromMemory(uint32_t /*offset*/, uint32_t /*length*/,
+                         uint64_t /*address*/,
+                         oem_platform::Handler* /*oemPlatformHandler*/,
+                         TransferCompletion done) override
     {
-        return PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
+        done(PLDM_ERROR_UNSUPPORTED_PLDM_CMD, 0);
     }
 
     int write(const char* buffer, uint32_t offset, uint32_t& length,
               oem_platform::Handler* oemPlatformHandler) override;
 
-    int readIntoMemory(uint32_t /*offset*/, uint32_t /*length*/,
-                       uint64_t /*address*/,
-                       oem_platform::Handler* /*oemPlatformHandler*/) override
+    void readIntoMemory(uint32_t /*offset*/, uint32_t /*length*/,
+                        uint64_t /*address*/,
+                        oem_platform::Handler* /*oemPlatformHandler*/,
+                        TransferCompletion done) override
     {
-        return PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
+        done(PLDM_ERROR_UNSUPPORTED_PLDM_CMD, 0);
     }
 
     int read(uint32_t /*offset*/, uint32_t& /*length*/, Response& /*response*/,
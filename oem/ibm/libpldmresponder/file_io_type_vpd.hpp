@@ -20,17 +20,19 @@ class keywordHandler : public FileHandler
     keywordHandler(uint32_t fileHandle, uint16_t /* fileType */) :
         FileHandler(fileHandle)
     {}
-    virtual int writeFromMemory(uint32_t /*offset*/, uint32_t /*length*/,
-                                uint64_t /*address*/,
-                                oem_platform::Handler* /*oemPlatformHandler*/)
+    virtual void writeFromMemory(uint32_t /*offset*/, uint32_t /*length*/,
+                                 uint64_t /*address*/,
+                                 oem_platform::Handler* /*oemPlatformHandler*/,
+                                 TransferCompletion done)
     {
-        return PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
+        done(PLDM_ERROR_UNSUPPORTED_PLDM_CMD, 0);
     }
-    virtual int readIntoMemory(uint32_t /*offset*/, uint32_t /*length*/,
-                               uint64_t /*address*/,
-                               oem_platform::Handler* /*oemPlatformHandler*/)
+    virtual void readIntoMemory(uint32_t /*offset*/, uint32_t /*length*/,
+                                uint64_t /*address*/,
+                                oem_platform::Handler* /*oemPlatformHandler*/,
+                                TransferCompletion done)
     {
-        return PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
+        done(PLDM_ERROR_UNSUPPORTED_PLDM_CMD, 0);
     }
     virtual int read(uint32_t offset, uint32_t& length, Response& response,
                      oem_platform::Handler* /*oemPlatformHandler*/);
@@ -4,6 +4,7 @@
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <fstream>
 
 PHOSPHOR_LOG2_USING;
@@ -12,8 +13,12 @@ namespace pldm
 {
 namespace filetable
 {
-FileTable::FileTable(const std::string& fileTableConfigPath)
+FileTable::FileTable(const std::string& fileTableConfigPath) :
+    configPath(fileTableConfigPath)
 {
+    std::error_code ec;
+    configTime = fs::last_write_time(fileTableConfigPath, ec);
+
     std::ifstream jsonFile(fileTableConfigPath);
     if (!jsonFile.is_open())
     {
@@ -102,10 +107,16 @@ FileTable::FileTable(const std::string& fileTableConfigPath)
         entry.traits.value = traits;
 
         // Insert the file entries in the map
+        fileSizes.emplace_back(entry.fsPath, fileSize);
         tableEntries.emplace(handle, std::move(entry));
         handle++;
     }
 
+    if (fileTable.empty())
+    {
+        return;
+    }
+
     constexpr uint8_t padWidth = 4;
     tableSize = fileTable.size();
     // Add pad bytes
@@ -115,18 +126,36 @@ FileTable::FileTable(const std::string& fileTableConfigPath)
         fileTable.resize(tableSize + padCount, 0);
     }
 
-    // Calculate the checksum
+    // Calculate the checksum and append it, the table is served as is
     checkSum = crc32(fileTable.data(), fileTable.size());
+    tableSize = fileTable.size();
+    fileTable.resize(tableSize + sizeof(checkSum));
+    std::copy_n(reinterpret_cast<const uint8_t*>(&checkSum), sizeof(checkSum),
+                fileTable.begin() + tableSize);
 }
 
-Table FileTable::operator()() const
+bool FileTable::isStale() const
 {
-    Table table(fileTable);
-    table.resize(fileTable.size() + sizeof(checkSum));
-    auto iter = table.begin() + fileTable.size();
-    std::copy_n(reinterpret_cast<const uint8_t*>(&checkSum), sizeof(checkSum),
-                iter);
-    return table;
+    std::error_code ec;
+    if (fs::last_write_time(configPath, ec) != configTime)
+    {
+        return true;
+    }
+
+    return std::ranges::any_of(fileSizes, [](const auto& file) {
+        std::error_code ec;
+        auto size = fs::file_size(file.first, ec);
+        return ec || size != file.second;
+    });
+}
+
+void FileTable::refresh()
+{
+    if (isStale())
+    {
+        auto path = configPath;
+        *this = FileTable(path);
+    }
 }
 
 FileTable& buildFileTable(const std::string& fileTablePath)
@@ -139,5 +168,12 @@ FileTable& buildFileTable(const std::string& fileTablePath)
     return table;
 }
 
+FileTable& refreshFileTable(const std::string& fileTablePath)
+{
+    auto& table = buildFileTable(fileTablePath);
+    table.refresh();
+    return table;
+}
+
 } // namespace filetable
 } // namespace pldm
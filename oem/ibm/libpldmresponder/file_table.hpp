@@ -6,6 +6,8 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace pldm
@@ -60,9 +62,25 @@ class FileTable
 
     /** @brief Get the file attribute table
      *
-     * @return Table- contents of the file attribute table
+     * @return Table- contents of the file attribute table, including the pad
+     *                bytes and the checksum
      */
-    Table operator()() const;
+    const Table& operator()() const
+    {
+        return fileTable;
+    }
+
+    /** @brief Check if the file attribute table no longer describes the
+     *         files, because the config file or the size of a file changed
+     *
+     * @return bool - true if the table should be built again
+     */
+    bool isStale() const;
+
+    /** @brief Build the file attribute table again from its config file if
+     *         it is stale
+     */
+    void refresh();
 
     /** @brief Get the FileEntry at the file handle
      *
@@ -93,13 +111,16 @@ class FileTable
         fileTable.clear();
         padCount = 0;
         checkSum = 0;
+        configPath.clear();
+        configTime = {};
+        fileSizes.clear();
     }
 
   private:
     /** @brief handle to FileEntry mappings for lookups based on file handle */
     std::unordered_map<Handle, FileEntry> tableEntries;
 
-    /** @brief file attribute table including the pad bytes, except the checksum
+    /** @brief file attribute table including the pad bytes and the checksum
      */
     std::vector<uint8_t> fileTable;
 
@@ -109,6 +130,15 @@ class FileTable
 
     /** @brief the checksum of the file attribute table */
     uint32_t checkSum = 0;
+
+    /** @brief path of the config file the table was built from */
+    std::string configPath;
+
+    /** @brief modification time of the config file */
+    fs::file_time_type configTime{};
+
+    /** @brief size of the files when the table was built */
+    std::vector<std::pair<fs::path, uint32_t>> fileSizes;
 };
 
 /** @brief Build the file attribute table if not already built using the
@@ -121,5 +151,15 @@ class FileTable
 
 FileTable& buildFileTable(const std::string& fileTablePath);
 
+/** @brief Build the file attribute table if not already built using the
+ *         file table config, or again if its config or the size of a file
+ *         changed since it was built.
+ *
+ *  @param[in] fileTablePath - path of the file table config
+ *
+ *  @return FileTable& - Reference to instance of file table
+ */
+FileTable& refreshFileTable(const std::string& fileTablePath);
+
 } // namespace filetable
 } // namespace pldm
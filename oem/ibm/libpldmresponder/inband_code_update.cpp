@@ -1,18 +1,30 @@
 #include "inband_code_update.hpp"
 
+#include "common/worker_pool.hpp"
 #include "libpldmresponder/pdr.hpp"
 #include "oem_ibm_handler.hpp"
 #include "xyz/openbmc_project/Common/error.hpp"
 
 #include <arpa/inet.h>
+#include <fcntl.h>
 #include <libpldm/entity.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <phosphor-logging/lg2.hpp>
 #include <sdbusplus/server.hpp>
 #include <xyz/openbmc_project/Dump/NewDump/server.hpp>
 
+#include <deque>
 #include <exception>
 #include <fstream>
+#include <functional>
+#include <memory>
+#include <set>
+#include <system_error>
+#include <utility>
+#include <vector>
 
 PHOSPHOR_LOG2_USING;
 
@@ -463,6 +475,198 @@ int executeCmd(const T&... t)
     return 0;
 }
 
+/** @brief Copy a LID without its header to a file
+ *
+ *  @param[in] filePath - path of the LID as written by the host
+ *  @param[in] headerSize - size of the LID header
+ *  @param[in] target - file the LID content is written to
+ *  @param[in] append - append to target rather than replace it
+ *
+ *  @return 0 on success, negative errno on failure
+ */
+static int stripLidHeader(const fs::path& filePath, uint32_t headerSize,
+                          const fs::path& target, bool append)
+{
+    CustomFD in(open(filePath.c_str(), O_RDONLY | O_CLOEXEC));
+    if (in() < 0)
+    {
+        return -errno;
+    }
+    CustomFD out(open(target.c_str(),
+                      O_WRONLY | O_CREAT | O_CLOEXEC |
+                          (append ? O_APPEND : O_TRUNC),
+                      S_IRUSR | S_IWUSR));
+    if (out() < 0)
+    {
+        return -errno;
+    }
+
+    struct stat st{};
+    if (fstat(in(), &st) < 0)
+    {
+        return -errno;
+    }
+
+    // The content is copied by the kernel, without a user space buffer
+    off_t offset = headerSize;
+    while (offset < st.st_size)
+    {
+        auto rc = sendfile(out(), in(), &offset, st.st_size - offset);
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -errno;
+        }
+        if (rc == 0)
+        {
+            return -EIO;
+        }
+    }
+    return 0;
+}
+
+/** @class LidProcessor
+ *
+ *  Strips the header of the LIDs of an inband code update on the worker
+ *  pool as each of them is completely written, so that it overlaps with the
+ *  transfer of the next LIDs instead of delaying the write responses on the
+ *  event loop. The LIDs are processed one at a time, which keeps the BMC
+ *  LIDs concatenated to the tarball in the order they were completed. The
+ *  processor is only used from the event loop.
+ */
+class LidProcessor
+{
+  public:
+    LidProcessor(const LidProcessor&) = delete;
+    LidProcessor(LidProcessor&&) = delete;
+    LidProcessor& operator=(const LidProcessor&) = delete;
+    LidProcessor& operator=(LidProcessor&&) = delete;
+
+    /** @brief Get the processor of the process */
+    static LidProcessor& get()
+    {
+        static LidProcessor processor;
+        return processor;
+    }
+
+    /** @brief Queue a completely written LID to the worker pool
+     *
+     *  A LID already queued is not queued again: the host may write its
+     *  final chunk again, which completes the LID a second time.
+     *
+     *  @param[in] lid - path of the LID as written by the host
+     *  @param[in] job - strips the header of the LID, returns 0 or a
+     *                   negative errno
+     *
+     *  @return false if the worker pool could not be started, job is then
+     *          left to the caller
+     */
+    bool post(const fs::path& lid, std::function<int()>&& job)
+    {
+        if (!queuedLids.insert(lid).second)
+        {
+            info("LID '{PATH}' is already queued for processing", "PATH",
+                 lid);
+            return true;
+        }
+        jobs.emplace_back(lid, std::move(job));
+        if (!runNext())
+        {
+            job = std::move(jobs.back().second);
+            jobs.pop_back();
+            queuedLids.erase(lid);
+            return false;
+        }
+        return true;
+    }
+
+    /** @brief Call a callback once the queued LIDs are processed, right
+     *         away if none is queued
+     *
+     *  @param[in] callback - called with false if a LID failed to be
+     *                        processed since the last callback
+     */
+    void whenIdle(std::function<void(bool)>&& callback)
+    {
+        if (busy)
+        {
+            idleCallbacks.emplace_back(std::move(callback));
+            return;
+        }
+        callback(!std::exchange(failed, false));
+    }
+
+  private:
+    LidProcessor() = default;
+
+    /** @brief Hand the next queued job to the worker pool, unless a job
+     *         already runs, or call the idle callbacks once none is left
+     *
+     *  @return false if the worker pool could not be started
+     */
+    bool runNext()
+    {
+        if (busy)
+        {
+            return true;
+        }
+        if (jobs.empty())
+        {
+            std::vector<std::function<void(bool)>> callbacks;
+            callbacks.swap(idleCallbacks);
+            auto processed = !std::exchange(failed, false);
+            for (auto& callback : callbacks)
+            {
+                callback(processed);
+            }
+            return true;
+        }
+
+        auto rc = std::make_shared<int>(0);
+        auto& [lid, next] = jobs.front();
+        auto job = std::make_shared<std::function<int()>>(std::move(next));
+        try
+        {
+            WorkerPool::getInstance().post(
+                [job, rc] { *rc = (*job)(); },
+                [this, lid = lid, rc] {
+                    busy = false;
+                    failed = failed || *rc < 0;
+                    queuedLids.erase(lid);
+                    runNext();
+                });
+        }
+        catch (const std::system_error& e)
+        {
+            error("Failed to start the LID processing, error - {ERROR}",
+                  "ERROR", e);
+            next = std::move(*job);
+            return false;
+        }
+        jobs.pop_front();
+        busy = true;
+        return true;
+    }
+
+    /** @brief jobs waiting for the running one, by LID */
+    std::deque<std::pair<fs::path, std::function<int()>>> jobs;
+
+    /** @brief LIDs queued or being processed */
+    std::set<fs::path> queuedLids;
+
+    /** @brief whether a job runs on the worker pool */
+    bool busy = false;
+
+    /** @brief set when a job failed, until reported to a callback */
+    bool failed = false;
+
+    /** @brief callbacks waiting for the queued jobs */
+    std::vector<std::function<void(bool)>> idleCallbacks;
+};
+
 int processCodeUpdateLid(const std::string& filePath)
 {
     struct LidHeader
@@ -487,6 +691,7 @@ int processCodeUpdateLid(const std::string& filePath)
     }
     ifs.seekg(0);
     ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+    ifs.close();
 
     // File size should be the value of lid size minus the header size
     auto fileSize = fs::file_size(filePath);
@@ -494,7 +699,6 @@ int processCodeUpdateLid(const std::string& filePath)
     if (fileSize < htonl(header.lidSize))
     {
         // File is not completely written yet
-        ifs.close();
         return PLDM_SUCCESS;
     }
 
@@ -502,42 +706,55 @@ int processCodeUpdateLid(const std::string& filePath)
     if (htons(header.magicNumber) != magicNumber)
     {
         error("Invalid magic number for file '{PATH}'", "PATH", filePath);
-        ifs.close();
         return PLDM_ERROR;
     }
 
     fs::create_directories(imageDirPath);
     fs::create_directories(lidDirPath);
 
+    fs::path target;
     constexpr auto bmcClass = 0x2000;
-    if (htons(header.lidClass) == bmcClass)
+    bool bmcLid = htons(header.lidClass) == bmcClass;
+    if (bmcLid)
     {
         // Skip the header and concatenate the BMC LIDs into a tar file
-        std::ofstream ofs(tarImagePath,
-                          std::ios::out | std::ios::binary | std::ios::app);
-        ifs.seekg(htonl(header.headerSize));
-        ofs << ifs.rdbuf();
-        ofs.flush();
-        ofs.close();
+        target = tarImagePath;
     }
     else
     {
         std::stringstream lidFileName;
         lidFileName << std::hex << htonl(header.lidNumber) << ".lid";
-        auto lidNoHeaderPath = fs::path(lidDirPath) / lidFileName.str();
-        std::ofstream ofs(lidNoHeaderPath,
-                          std::ios::out | std::ios::binary | std::ios::trunc);
-        ifs.seekg(htonl(header.headerSize));
-        ofs << ifs.rdbuf();
-        ofs.flush();
-        ofs.close();
+        target = fs::path(lidDirPath) / lidFileName.str();
     }
 
-    ifs.close();
-    fs::remove(filePath);
+    std::function<int()> job = [path = fs::path(filePath),
+                                headerSize = htonl(header.headerSize),
+                                target = std::move(target), bmcLid]() {
+        auto rc = stripLidHeader(path, headerSize, target, bmcLid);
+        if (rc < 0)
+        {
+            error(
+                "Failed to copy LID '{PATH}' without its header to '{TARGET}', response code '{RC}'",
+                "PATH", path, "TARGET", target, "RC", rc);
+            return rc;
+        }
+        std::error_code ec;
+        fs::remove(path, ec);
+        return 0;
+    };
+
+    if (!LidProcessor::get().post(filePath, std::move(job)))
+    {
+        return job() < 0 ? PLDM_ERROR : PLDM_SUCCESS;
+    }
     return PLDM_SUCCESS;
 }
 
+void whenCodeUpdateLidsProcessed(std::function<void(bool)>&& callback)
+{
+    LidProcessor::get().whenIdle(std::move(callback));
+}
+
 int CodeUpdate::assembleCodeUpdateImage()
 {
     pid_t pid = fork();
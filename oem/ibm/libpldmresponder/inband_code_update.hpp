@@ -4,6 +4,7 @@
 #include "libpldmresponder/pdr_utils.hpp"
 #include "libpldmresponder/platform.hpp"
 
+#include <functional>
 #include <string>
 
 namespace pldm
@@ -227,11 +228,20 @@ int setBootSide(uint16_t entityInstance, uint8_t currState,
                 CodeUpdate* codeUpdate);
 
 /* @brief Method to process LIDs during inband update, such as verifying and
- *        removing the header to get them ready to be written to flash
+ *        removing the header to get them ready to be written to flash. The
+ *        header of a completely written LID is removed on the worker pool.
  * @param[in] filePath - Path to the LID file
  * @return - PLDM_SUCCESS codes
  */
 int processCodeUpdateLid(const std::string& filePath);
 
+/* @brief Method to wait for the LIDs of an inband update to be processed
+ *        before the image is assembled
+ * @param[in] callback - called from the event loop once the completely
+ *                       written LIDs are processed, with false if one of
+ *                       them failed
+ */
+void whenCodeUpdateLidsProcessed(std::function<void(bool)>&& callback);
+
 } // namespace responder
 } // namespace pldm
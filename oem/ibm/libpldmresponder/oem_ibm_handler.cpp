@@ -10,7 +10,9 @@
 #include <libpldm/pldm.h>
 
 #include <phosphor-logging/lg2.hpp>
-#include <xyz/openbmc_project/State/BMC/client.hpp>
+
+#include <algorithm>
+#include <utility>
 
 PHOSPHOR_LOG2_USING;
 
@@ -455,32 +457,66 @@ void pldm::responder::oem_ibm_platform::Handler::setPlatformHandler(
 }
 
 int pldm::responder::oem_ibm_platform::Handler::sendEventToHost(
-    std::vector<uint8_t>& requestMsg, uint8_t instanceId)
+    pldm::Request&& requestMsg, uint8_t retries)
 {
-    if (requestMsg.size())
+    if (requestMsg.size() < sizeof(pldm_msg_hdr))
     {
-        std::ostringstream tempStream;
-        for (int byte : requestMsg)
-        {
-            tempStream << std::setfill('0') << std::setw(2) << std::hex << byte
-                       << " ";
-        }
-        std::cout << tempStream.str() << std::endl;
-    }
-    auto oemPlatformEventMessageResponseHandler = [](mctp_eid_t /*eid*/,
-                                                     const pldm_msg* response,
-                                                     size_t respMsgLen) {
-        uint8_t completionCode{};
-        uint8_t status{};
-        auto rc = decode_platform_event_message_resp(response, respMsgLen,
-                                                     &completionCode, &status);
-        if (rc || completionCode)
-        {
-            error(
-                "Failed to decode platform event message response for code update event with response code '{RC}' and completion code '{CC}'",
-                "RC", rc, "CC", completionCode);
-        }
-    };
+        error("Invalid event message to the host, size '{SIZE}'", "SIZE",
+              requestMsg.size());
+        hostEventStats.dropped++;
+        return PLDM_ERROR_INVALID_LENGTH;
+    }
+
+    uint8_t instanceId{};
+    try
+    {
+        instanceId = instanceIdDb.next(mctp_eid);
+    }
+    catch (const std::exception& e)
+    {
+        error("Failed to get an instance ID for the event, error - {ERROR}",
+              "ERROR", e);
+        retryEventToHost(std::move(requestMsg), retries);
+        return PLDM_ERROR;
+    }
+    // Only the instance ID changes when the event is sent again
+    reinterpret_cast<pldm_msg*>(requestMsg.data())->hdr.instance_id =
+        instanceId;
+
+    std::ostringstream tempStream;
+    for (int byte : requestMsg)
+    {
+        tempStream << std::setfill('0') << std::setw(2) << std::hex << byte
+                   << " ";
+    }
+    std::cout << tempStream.str() << std::endl;
+    auto oemPlatformEventMessageResponseHandler =
+        [this, requestMsg, retries](mctp_eid_t /*eid*/,
+                                    const pldm_msg* response,
+                                    size_t respMsgLen) mutable {
+            if (!response || !respMsgLen)
+            {
+                error("No response to the platform event message");
+                hostEventStats.dropped++;
+                return;
+            }
+            uint8_t completionCode{};
+            uint8_t status{};
+            auto rc = decode_platform_event_message_resp(
+                response, respMsgLen, &completionCode, &status);
+            if (rc == PLDM_SUCCESS && completionCode == PLDM_ERROR_NOT_READY)
+            {
+                retryEventToHost(std::move(requestMsg), retries);
+                return;
+            }
+            if (rc || completionCode)
+            {
+                error(
+                    "Failed to decode platform event message response for code update event with response code '{RC}' and completion code '{CC}'",
+                    "RC", rc, "CC", completionCode);
+                hostEventStats.dropped++;
+            }
+        };
     auto rc = handler->registerRequest(
         mctp_eid, instanceId, PLDM_PLATFORM, PLDM_PLATFORM_EVENT_MESSAGE,
         std::move(requestMsg),
@@ -488,11 +524,52 @@ int pldm::responder::oem_ibm_platform::Handler::sendEventToHost(
     if (rc)
     {
         error("Failed to send BIOS attribute change event message ");
+        // The request was not queued, nothing frees its instance ID
+        instanceIdDb.free(mctp_eid, instanceId);
+        hostEventStats.dropped++;
+        return rc;
     }
 
+    hostEventStats.sent++;
     return rc;
 }
 
+void pldm::responder::oem_ibm_platform::Handler::retryEventToHost(
+    pldm::Request&& requestMsg, uint8_t retries)
+{
+    if (retries >= maxHostEventRetries)
+    {
+        error("Dropping the event to the host after {RETRIES} retries",
+              "RETRIES", retries);
+        hostEventStats.dropped++;
+        return;
+    }
+
+    retryEvents.emplace_back(std::move(requestMsg),
+                             static_cast<uint8_t>(retries + 1));
+    updateHostEventQueueDepth();
+    if (!hostEventRetryTimer.isEnabled())
+    {
+        hostEventRetryTimer.restartOnce(hostEventRetryInterval);
+    }
+}
+
+void pldm::responder::oem_ibm_platform::Handler::sendRetryEvents()
+{
+    auto events = std::exchange(retryEvents, {});
+    for (auto& retryEvent : events)
+    {
+        hostEventStats.retried++;
+        sendEventToHost(std::move(retryEvent.requestMsg), retryEvent.retries);
+    }
+}
+
+void pldm::responder::oem_ibm_platform::Handler::updateHostEventQueueDepth()
+{
+    hostEventStats.maxDepth =
+        std::max<uint64_t>(hostEventStats.maxDepth, hostEventQueueDepth());
+}
+
 int encodeEventMsg(uint8_t eventType, const std::vector<uint8_t>& eventDataVec,
                    std::vector<uint8_t>& requestMsg, uint8_t instanceId)
 {
@@ -510,56 +587,96 @@ void pldm::responder::oem_ibm_platform::Handler::sendStateSensorEvent(
     uint16_t sensorId, enum sensor_event_class_states sensorEventClass,
     uint8_t sensorOffset, uint8_t eventState, uint8_t prevEventState)
 {
-    std::vector<uint8_t> sensorEventDataVec{};
-    size_t sensorEventSize = PLDM_SENSOR_EVENT_DATA_MIN_LENGTH + 1;
-    sensorEventDataVec.resize(sensorEventSize);
-    auto eventData = reinterpret_cast<struct pldm_sensor_event_data*>(
-        sensorEventDataVec.data());
-    eventData->sensor_id = sensorId;
-    eventData->sensor_event_class_type = sensorEventClass;
-    auto eventClassStart = eventData->event_class;
-    auto eventClass =
-        reinterpret_cast<struct pldm_sensor_event_state_sensor_state*>(
-            eventClassStart);
-    eventClass->sensor_offset = sensorOffset;
-    eventClass->event_state = eventState;
-    eventClass->previous_event_state = prevEventState;
-    auto instanceId = instanceIdDb.next(mctp_eid);
-    std::vector<uint8_t> requestMsg(
-        sizeof(pldm_msg_hdr) + PLDM_PLATFORM_EVENT_MESSAGE_MIN_REQ_BYTES +
-        sensorEventDataVec.size());
-    auto rc = encodeEventMsg(PLDM_SENSOR_EVENT, sensorEventDataVec, requestMsg,
-                             instanceId);
-    if (rc != PLDM_SUCCESS)
+    hostEventStats.queued++;
+    auto it = std::ranges::find_if(pendingSensorEvents, [&](const auto& e) {
+        return e.sensorId == sensorId &&
+               e.sensorEventClass == sensorEventClass &&
+               e.sensorOffset == sensorOffset;
+    });
+    if (it != pendingSensorEvents.end())
     {
-        error("Failed to encode state sensor event with response code '{RC}'",
-              "RC", rc);
-        instanceIdDb.free(mctp_eid, instanceId);
-        return;
+        // The host gets the latest state, from the state it last knew
+        it->eventState = eventState;
+        hostEventStats.coalesced++;
     }
-    rc = sendEventToHost(requestMsg, instanceId);
-    if (rc != PLDM_SUCCESS)
+    else
     {
-        error(
-            "Failed to send event to remote terminus with response code '{RC}'",
-            "RC", rc);
+        pendingSensorEvents.emplace_back(sensorId, sensorEventClass,
+                                         sensorOffset, eventState,
+                                         prevEventState);
+        updateHostEventQueueDepth();
+    }
+
+    if (hostEventCoalesceInterval.count() == 0)
+    {
+        sendPendingSensorEvents();
+    }
+    else if (!hostEventTimer.isEnabled())
+    {
+        hostEventTimer.restartOnce(hostEventCoalesceInterval);
+    }
+}
+
+void pldm::responder::oem_ibm_platform::Handler::sendPendingSensorEvents()
+{
+    auto events = std::exchange(pendingSensorEvents, {});
+    for (const auto& pending : events)
+    {
+        std::vector<uint8_t> sensorEventDataVec{};
+        size_t sensorEventSize = PLDM_SENSOR_EVENT_DATA_MIN_LENGTH + 1;
+        sensorEventDataVec.resize(sensorEventSize);
+        auto eventData = reinterpret_cast<struct pldm_sensor_event_data*>(
+            sensorEventDataVec.data());
+        eventData->sensor_id = pending.sensorId;
+        eventData->sensor_event_class_type = pending.sensorEventClass;
+        auto eventClassStart = eventData->event_class;
+        auto eventClass =
+            reinterpret_cast<struct pldm_sensor_event_state_sensor_state*>(
+                eventClassStart);
+        eventClass->sensor_offset = pending.sensorOffset;
+        eventClass->event_state = pending.eventState;
+        eventClass->previous_event_state = pending.prevEventState;
+        // The instance ID is set when the event is sent
+        std::vector<uint8_t> requestMsg(
+            sizeof(pldm_msg_hdr) + PLDM_PLATFORM_EVENT_MESSAGE_MIN_REQ_BYTES +
+            sensorEventDataVec.size());
+        auto rc = encodeEventMsg(PLDM_SENSOR_EVENT, sensorEventDataVec,
+                                 requestMsg, 0);
+        if (rc != PLDM_SUCCESS)
+        {
+            error(
+                "Failed to encode state sensor event with response code '{RC}'",
+                "RC", rc);
+            hostEventStats.dropped++;
+            continue;
+        }
+        rc = sendEventToHost(std::move(requestMsg));
+        if (rc != PLDM_SUCCESS)
+        {
+            error(
+                "Failed to send event to remote terminus with response code '{RC}'",
+                "RC", rc);
+        }
     }
-    return;
 }
 
 void pldm::responder::oem_ibm_platform::Handler::_processEndUpdate(
     sdeventplus::source::EventBase& /*source */)
 {
     assembleImageEvent.reset();
-    int retc = codeUpdate->assembleCodeUpdateImage();
-    if (retc != PLDM_SUCCESS)
-    {
-        codeUpdate->setCodeUpdateProgress(false);
-        auto sensorId = codeUpdate->getFirmwareUpdateSensor();
-        sendStateSensorEvent(sensorId, PLDM_STATE_SENSOR_STATE, 0,
-                             uint8_t(CodeUpdateState::FAIL),
-                             uint8_t(CodeUpdateState::START));
-    }
+    // The last LIDs may still be processed off the event loop
+    whenCodeUpdateLidsProcessed([this](bool processed) {
+        int retc = processed ? codeUpdate->assembleCodeUpdateImage()
+                             : PLDM_ERROR;
+        if (retc != PLDM_SUCCESS)
+        {
+            codeUpdate->setCodeUpdateProgress(false);
+            auto sensorId = codeUpdate->getFirmwareUpdateSensor();
+            sendStateSensorEvent(sensorId, PLDM_STATE_SENSOR_STATE, 0,
+                                 uint8_t(CodeUpdateState::FAIL),
+                                 uint8_t(CodeUpdateState::START));
+        }
+    });
 }
 
 void pldm::responder::oem_ibm_platform::Handler::_processStartUpdate(
@@ -693,46 +810,58 @@ void pldm::responder::oem_ibm_platform::Handler::checkAndDisableWatchDog()
 
 bool pldm::responder::oem_ibm_platform::Handler::watchDogRunning()
 {
-    static constexpr auto watchDogObjectPath =
-        "/xyz/openbmc_project/watchdog/host0";
-    static constexpr auto watchDogEnablePropName = "Enabled";
-    static constexpr auto watchDogInterface =
-        "xyz.openbmc_project.State.Watchdog";
-    bool isWatchDogRunning = false;
-    try
+    if (!watchDogEnabled)
     {
-        isWatchDogRunning = pldm::utils::DBusHandler().getDbusProperty<bool>(
-            watchDogObjectPath, watchDogEnablePropName, watchDogInterface);
+        // Assume the watchdog is stopped until its service is (re)started
+        watchDogEnabled = false;
+        try
+        {
+            updateWatchDogState(dBusIntf->getDbusPropertiesVariant(
+                watchDogService, watchDogObjectPath, watchDogInterface));
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+    }
+    return *watchDogEnabled;
+}
+
+void pldm::responder::oem_ibm_platform::Handler::updateWatchDogState(
+    const pldm::utils::PropertyMap& props)
+{
+    auto it = props.find("Enabled");
+    if (it != props.end() && std::holds_alternative<bool>(it->second))
+    {
+        watchDogEnabled = std::get<bool>(it->second);
+        // The next heartbeat resets the timer
+        lastWatchDogReset.reset();
     }
-    catch (const std::exception&)
+    it = props.find("Interval");
+    if (it != props.end() && std::holds_alternative<uint64_t>(it->second))
     {
-        return false;
+        watchDogInterval =
+            std::chrono::milliseconds(std::get<uint64_t>(it->second));
     }
-    return isWatchDogRunning;
 }
 
 void pldm::responder::oem_ibm_platform::Handler::resetWatchDogTimer()
 {
-    static constexpr auto watchDogService = "xyz.openbmc_project.Watchdog";
-    static constexpr auto watchDogObjectPath =
-        "/xyz/openbmc_project/watchdog/host0";
-    static constexpr auto watchDogInterface =
-        "xyz.openbmc_project.State.Watchdog";
-    static constexpr auto watchDogResetPropName = "ResetTimeRemaining";
-
     bool wdStatus = watchDogRunning();
     if (wdStatus == false)
     {
         return;
     }
+
+    auto now = std::chrono::steady_clock::now();
+    if (lastWatchDogReset && now - *lastWatchDogReset < watchDogInterval / 2)
+    {
+        return;
+    }
     try
     {
-        auto& bus = pldm::utils::DBusHandler::getBus();
-        auto resetMethod =
-            bus.new_method_call(watchDogService, watchDogObjectPath,
-                                watchDogInterface, watchDogResetPropName);
-        resetMethod.append(true);
-        bus.call_noreply(resetMethod, dbusTimeout);
+        resetWatchDogTimeRemaining();
+        lastWatchDogReset = now;
     }
     catch (const std::exception& e)
     {
@@ -741,12 +870,23 @@ void pldm::responder::oem_ibm_platform::Handler::resetWatchDogTimer()
     }
 }
 
+void pldm::responder::oem_ibm_platform::Handler::resetWatchDogTimeRemaining()
+{
+    static constexpr auto watchDogResetPropName = "ResetTimeRemaining";
+
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    auto resetMethod =
+        bus.new_method_call(watchDogService, watchDogObjectPath,
+                            watchDogInterface, watchDogResetPropName);
+    resetMethod.append(true);
+    bus.call_noreply(resetMethod, dbusTimeout);
+}
+
 void pldm::responder::oem_ibm_platform::Handler::disableWatchDogTimer()
 {
     setEventReceiverCnt = 0;
-    pldm::utils::DBusMapping dbusMapping{
-        "/xyz/openbmc_project/watchdog/host0",
-        "xyz.openbmc_project.State.Watchdog", "Enabled", "bool"};
+    pldm::utils::DBusMapping dbusMapping{watchDogObjectPath, watchDogInterface,
+                                         "Enabled", "bool"};
     bool wdStatus = watchDogRunning();
 
     if (!wdStatus)
@@ -756,39 +896,78 @@ void pldm::responder::oem_ibm_platform::Handler::disableWatchDogTimer()
     try
     {
         pldm::utils::DBusHandler().setDbusProperty(dbusMapping, false);
+        watchDogEnabled = false;
     }
     catch (const std::exception& e)
     {
         error("Failed to disable watchdog timer, error - {ERROR}", "ERROR", e);
     }
 }
-int pldm::responder::oem_ibm_platform::Handler::checkBMCState()
+
+void pldm::responder::oem_ibm_platform::Handler::hostStateChanged(
+    pldm::HostStateEvent event)
 {
-    using BMC = sdbusplus::client::xyz::openbmc_project::state::BMC<>;
-    auto bmcPath = sdbusplus::message::object_path(BMC::namespace_path::value) /
-                   BMC::namespace_path::bmc;
-    try
+    switch (event)
     {
-        pldm::utils::PropertyValue propertyValue =
-            pldm::utils::DBusHandler().getDbusPropertyVariant(
-                bmcPath.str.c_str(), "CurrentBMCState", BMC::interface);
+        case pldm::HostStateEvent::off:
+            hostOff = true;
+            setEventReceiverCnt = 0;
+            disableWatchDogTimer();
+            startStopTimer(false);
+            // The host no longer waits for its file transfers
+            dma::DMA::cancelTransfers();
+            break;
+        case pldm::HostStateEvent::running:
+            hostOff = false;
+            hostTransitioningToOff = false;
+            break;
+        case pldm::HostStateEvent::transitioningToOff:
+            hostTransitioningToOff = true;
+            break;
+        default:
+            break;
+    }
+}
 
-        if (std::get<std::string>(propertyValue) ==
-            "xyz.openbmc_project.State.BMC.BMCState.NotReady")
+int pldm::responder::oem_ibm_platform::Handler::checkBMCState()
+{
+    if (!bmcNotReady)
+    {
+        try
         {
-            error("GetPDR : PLDM stack is not ready for PDR exchange");
-            return PLDM_ERROR_NOT_READY;
+            updateBMCState(pldm::utils::PropertyMap{
+                {"CurrentBMCState",
+                 dBusIntf->getDbusPropertyVariant(bmcStateObjectPath,
+                                                  "CurrentBMCState",
+                                                  bmcStateInterface)}});
+        }
+        catch (const std::exception& e)
+        {
+            error("Error getting the current BMC state, error - {ERROR}",
+                  "ERROR", e);
+            return PLDM_ERROR;
         }
     }
-    catch (const std::exception& e)
+
+    if (bmcNotReady.value_or(false))
     {
-        error("Error getting the current BMC state, error - {ERROR}", "ERROR",
-              e);
-        return PLDM_ERROR;
+        error("GetPDR : PLDM stack is not ready for PDR exchange");
+        return PLDM_ERROR_NOT_READY;
     }
     return PLDM_SUCCESS;
 }
 
+void pldm::responder::oem_ibm_platform::Handler::updateBMCState(
+    const pldm::utils::PropertyMap& props)
+{
+    auto it = props.find("CurrentBMCState");
+    if (it != props.end() && std::holds_alternative<std::string>(it->second))
+    {
+        bmcNotReady = std::get<std::string>(it->second) ==
+                      "xyz.openbmc_project.State.BMC.BMCState.NotReady";
+    }
+}
+
 const pldm_pdr_record*
     pldm::responder::oem_ibm_platform::Handler::fetchLastBMCRecord(
         const pldm_pdr* repo)
@@ -16,6 +16,10 @@
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/utility/timer.hpp>
 
+#include <chrono>
+#include <deque>
+#include <optional>
+
 typedef ibm_oem_pldm_state_set_firmware_update_state_values CodeUpdateState;
 
 namespace pldm
@@ -38,6 +42,41 @@ const pldm::pdr::TerminusID HYPERVISOR_TID = 208;
 
 static constexpr uint8_t HEARTBEAT_TIMEOUT_DELTA = 10;
 
+static constexpr auto watchDogService = "xyz.openbmc_project.Watchdog";
+static constexpr auto watchDogObjectPath =
+    "/xyz/openbmc_project/watchdog/host0";
+static constexpr auto watchDogInterface =
+    "xyz.openbmc_project.State.Watchdog";
+
+static constexpr auto bmcStateService = "xyz.openbmc_project.State.BMC";
+static constexpr auto bmcStateObjectPath = "/xyz/openbmc_project/state/bmc0";
+static constexpr auto bmcStateInterface = "xyz.openbmc_project.State.BMC";
+
+/** @brief Time the state sensor events to the host are gathered before being
+ *         sent, once per sensor offset with its latest state
+ */
+constexpr auto hostEventCoalesceInterval =
+    std::chrono::milliseconds(SENSOR_EVENT_COALESCE_INTERVAL);
+
+/** @brief Time before sending again an event the host was not ready for */
+constexpr auto hostEventRetryInterval = std::chrono::milliseconds(500);
+
+/** @brief Maximum number of times an event is sent again to a busy host */
+constexpr uint8_t maxHostEventRetries = 3;
+
+/** @struct HostEventQueueStats
+ *  Counters of the queue of the state sensor events sent to the host
+ */
+struct HostEventQueueStats
+{
+    uint64_t queued = 0;    //!< state changes queued
+    uint64_t coalesced = 0; //!< changes merged into a queued one
+    uint64_t sent = 0;      //!< events sent, retries included
+    uint64_t retried = 0;   //!< events sent again to a busy host
+    uint64_t dropped = 0;   //!< events which could not be delivered
+    uint64_t maxDepth = 0;  //!< most events waiting to be sent at once
+};
+
 enum SetEventReceiverCount
 {
     SET_EVENT_RECEIVER_SENT = 0x2,
@@ -58,46 +97,47 @@ class Handler : public oem_platform::Handler
         handler(handler),
         timer(event, std::bind(std::mem_fn(&Handler::setSurvTimer), this,
                                HYPERVISOR_TID, false)),
+        hostEventTimer(event, [this](auto&) { sendPendingSensorEvents(); }),
+        hostEventRetryTimer(event, [this](auto&) { sendRetryEvents(); }),
         hostTransitioningToOff(true)
     {
         codeUpdate->setVersions();
         setEventReceiverCnt = 0;
 
         using namespace sdbusplus::bus::match::rules;
-        hostOffMatch = std::make_unique<sdbusplus::bus::match_t>(
+        watchDogMatch = std::make_unique<sdbusplus::bus::match_t>(
             pldm::utils::DBusHandler::getBus(),
-            propertiesChanged("/xyz/openbmc_project/state/host0",
-                              "xyz.openbmc_project.State.Host"),
+            propertiesChanged(watchDogObjectPath, watchDogInterface),
             [this](sdbusplus::message_t& msg) {
                 pldm::utils::DbusChangedProps props{};
                 std::string intf;
                 msg.read(intf, props);
-                const auto itr = props.find("CurrentHostState");
-                if (itr != props.end())
-                {
-                    pldm::utils::PropertyValue value = itr->second;
-                    auto propVal = std::get<std::string>(value);
-                    if (propVal ==
-                        "xyz.openbmc_project.State.Host.HostState.Off")
-                    {
-                        hostOff = true;
-                        setEventReceiverCnt = 0;
-                        disableWatchDogTimer();
-                        startStopTimer(false);
-                    }
-                    else if (propVal ==
-                             "xyz.openbmc_project.State.Host.HostState.Running")
-                    {
-                        hostOff = false;
-                        hostTransitioningToOff = false;
-                    }
-                    else if (
-                        propVal ==
-                        "xyz.openbmc_project.State.Host.HostState.TransitioningToOff")
-                    {
-                        hostTransitioningToOff = true;
-                    }
-                }
+                updateWatchDogState(props);
+            });
+        watchDogOwnerMatch = std::make_unique<sdbusplus::bus::match_t>(
+            pldm::utils::DBusHandler::getBus(),
+            nameOwnerChanged(watchDogService),
+            [this](sdbusplus::message_t&) {
+                // Read the state of the restarted watchdog on next use
+                watchDogEnabled.reset();
+                lastWatchDogReset.reset();
+            });
+
+        bmcStateMatch = std::make_unique<sdbusplus::bus::match_t>(
+            pldm::utils::DBusHandler::getBus(),
+            propertiesChanged(bmcStateObjectPath, bmcStateInterface),
+            [this](sdbusplus::message_t& msg) {
+                pldm::utils::DbusChangedProps props{};
+                std::string intf;
+                msg.read(intf, props);
+                updateBMCState(props);
+            });
+        bmcStateOwnerMatch = std::make_unique<sdbusplus::bus::match_t>(
+            pldm::utils::DBusHandler::getBus(),
+            nameOwnerChanged(bmcStateService),
+            [this](sdbusplus::message_t&) {
+                // Read the state from the restarted BMC state manager
+                bmcNotReady.reset();
             });
 
         powerStateOffMatch = std::make_unique<sdbusplus::bus::match_t>(
@@ -205,6 +245,10 @@ class Handler : public oem_platform::Handler
     void buildOEMPDR(pdr_utils::Repo& repo);
 
     /** @brief Method to send code update event to host
+     *
+     *  The event is queued for hostEventCoalesceInterval, a later change of
+     *  the same sensor offset meanwhile replaces its state.
+     *
      * @param[in] sensorId - sendor ID
      * @param[in] sensorEventClass - event class of sensor
      * @param[in] sensorOffset - sensor offset
@@ -218,11 +262,27 @@ class Handler : public oem_platform::Handler
                               uint8_t prevEventState);
 
     /** @brief Method to send encoded request msg of code update event to host
+     *
+     *  The message is sent with a new instance id. It is sent again,
+     *  without being encoded again, if the host is not ready for it.
+     *
      *  @param[in] requestMsg - encoded request msg
-     *  @param[in] instanceId - instance id of the message
+     *  @param[in] retries - number of times the message was sent already
      *  @return PLDM status code
      */
-    int sendEventToHost(std::vector<uint8_t>& requestMsg, uint8_t instanceId);
+    int sendEventToHost(pldm::Request&& requestMsg, uint8_t retries = 0);
+
+    /** @brief Number of events waiting to be sent to the host */
+    size_t hostEventQueueDepth() const
+    {
+        return pendingSensorEvents.size() + retryEvents.size();
+    }
+
+    /** @brief Counters of the events sent to the host */
+    const HostEventQueueStats& getHostEventQueueStats() const
+    {
+        return hostEventStats;
+    }
 
     /** @brief _processEndUpdate processes the actual work that needs
      *  to be carried out after EndUpdate effecter is set. This is done async
@@ -255,6 +315,9 @@ class Handler : public oem_platform::Handler
     void checkAndDisableWatchDog();
 
     /** @brief To check if the watchdog app is running
+     *
+     *  The state of the watchdog is read once, then kept up to date from its
+     *  property changes, the heartbeats of the host don't query it.
      *
      *  @return the running status of watchdog app
      */
@@ -262,13 +325,32 @@ class Handler : public oem_platform::Handler
 
     /** @brief Method to reset the Watchdog timer on receiving platform Event
      *  Message for heartbeat elapsed time from Hostboot
+     *
+     *  The heartbeats are coalesced, the timer is only reset once half of
+     *  its interval has elapsed since the last reset.
      */
     void resetWatchDogTimer();
 
+    /** @brief Call ResetTimeRemaining of the watchdog
+     *
+     *  @throw sdbusplus::exception_t if the call fails
+     */
+    virtual void resetWatchDogTimeRemaining();
+
     /** @brief To disable to the watchdog timer on host poweron completion*/
     void disableWatchDogTimer();
 
-    /** @brief to check the BMC state*/
+    /** @brief Track the state of Host notified by the host PDR handler
+     *
+     *  @param[in] event - change of the state of Host
+     */
+    void hostStateChanged(pldm::HostStateEvent event);
+
+    /** @brief to check the BMC state
+     *
+     *  The state of the BMC is read once, then kept up to date from its
+     *  property changes, the GetPDR requests of the host don't query it.
+     */
     int checkBMCState();
 
     /** @brief update the dbus object paths */
@@ -353,21 +435,109 @@ class Handler : public oem_platform::Handler
      */
     void startStopTimer(bool value);
 
+    /** @brief Update the cached state of the watchdog
+     *
+     *  @param[in] props - properties of the watchdog interface
+     */
+    void updateWatchDogState(const pldm::utils::PropertyMap& props);
+
+    /** @brief Update the cached state of the BMC
+     *
+     *  @param[in] props - properties of the BMC state interface
+     */
+    void updateBMCState(const pldm::utils::PropertyMap& props);
+
+    /** @brief Send the queued state sensor events to the host */
+    void sendPendingSensorEvents();
+
+    /** @brief Queue an event the host was not ready for, to send it again
+     *
+     *  @param[in] requestMsg - encoded request msg
+     *  @param[in] retries - number of times the message was sent already
+     */
+    void retryEventToHost(pldm::Request&& requestMsg, uint8_t retries);
+
+    /** @brief Send again the events the host was not ready for */
+    void sendRetryEvents();
+
+    /** @brief Record the number of events waiting to be sent */
+    void updateHostEventQueueDepth();
+
+    /** @struct PendingSensorEvent
+     *  A state sensor event queued to the host, not encoded yet
+     */
+    struct PendingSensorEvent
+    {
+        uint16_t sensorId;
+        enum sensor_event_class_states sensorEventClass;
+        uint8_t sensorOffset;
+        uint8_t eventState;
+        uint8_t prevEventState;
+    };
+
+    /** @struct RetryEvent
+     *  An encoded event to send again to the host
+     */
+    struct RetryEvent
+    {
+        pldm::Request requestMsg;
+        uint8_t retries;
+    };
+
+    /** @brief State sensor events waiting for the coalescing window, in the
+     *         order of their first change
+     */
+    std::vector<PendingSensorEvent> pendingSensorEvents;
+
+    /** @brief Events waiting to be sent again */
+    std::deque<RetryEvent> retryEvents;
+
+    /** @brief Counters of the events sent to the host */
+    HostEventQueueStats hostEventStats;
+
+    /** @brief Enabled property of the watchdog, unset until read */
+    std::optional<bool> watchDogEnabled;
+
+    /** @brief Interval property of the watchdog, 0 if unknown */
+    std::chrono::milliseconds watchDogInterval{0};
+
+    /** @brief Time of the last reset of the watchdog by the heartbeats */
+    std::optional<std::chrono::steady_clock::time_point> lastWatchDogReset;
+
+    /** @brief D-Bus property changed signal match of the watchdog */
+    std::unique_ptr<sdbusplus::bus::match_t> watchDogMatch;
+
+    /** @brief D-Bus name owner changed signal match of the watchdog */
+    std::unique_ptr<sdbusplus::bus::match_t> watchDogOwnerMatch;
+
+    /** @brief True if the BMC is NotReady, unset until read */
+    std::optional<bool> bmcNotReady;
+
+    /** @brief D-Bus property changed signal match of the BMC state */
+    std::unique_ptr<sdbusplus::bus::match_t> bmcStateMatch;
+
+    /** @brief D-Bus name owner changed signal match of the BMC state */
+    std::unique_ptr<sdbusplus::bus::match_t> bmcStateOwnerMatch;
+
     /** @brief D-Bus property changed signal match for CurrentPowerState*/
     std::unique_ptr<sdbusplus::bus::match_t> chassisOffMatch;
 
     /** @brief PLDM request handler */
     pldm::requester::Handler<pldm::requester::Request>* handler;
 
-    /** @brief D-Bus property changed signal match */
-    std::unique_ptr<sdbusplus::bus::match_t> hostOffMatch;
-
     /** @brief D-Bus property changed signal match */
     std::unique_ptr<sdbusplus::bus::match_t> powerStateOffMatch;
 
     /** @brief Timer used for monitoring surveillance pings from host */
     sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> timer;
 
+    /** @brief Sends the queued state sensor events */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic> hostEventTimer;
+
+    /** @brief Sends again the events the host was not ready for */
+    sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>
+        hostEventRetryTimer;
+
     bool hostOff = true;
 
     bool hostTransitioningToOff;
@@ -63,12 +63,11 @@ int sendBiosAttributeUpdateEvent(
 
     auto instanceId = instanceIdDb->next(eid);
 
-    std::vector<uint8_t> requestMsg(
+    RequestMsg requestMsg(
         sizeof(pldm_msg_hdr) + sizeof(pldm_bios_attribute_update_event_req) -
-            1 + (handles.size() * sizeof(uint16_t)),
-        0);
+            1 + (handles.size() * sizeof(uint16_t)));
 
-    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    auto request = requestMsg.msg();
 
     auto rc = encode_bios_attribute_update_event_req(
         instanceId, PLDM_PLATFORM_EVENT_MESSAGE_FORMAT_VERSION, TERMINUS_ID,
@@ -1,11 +1,20 @@
 #include "dbus_to_file_handler.hpp"
 
 #include "common/utils.hpp"
+#include "common/worker_pool.hpp"
 
 #include <libpldm/oem/ibm/file_io.h>
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <cerrno>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <system_error>
+#include <utility>
+#include <vector>
+
 PHOSPHOR_LOG2_USING;
 
 namespace pldm
@@ -22,6 +31,135 @@ static constexpr auto resDumpProgressIntf =
 static constexpr auto resDumpStatus =
     "xyz.openbmc_project.Common.Progress.OperationStatus.Failed";
 
+/** @class FileJobs
+ *
+ *  Writes the files offered to the host on the worker pool, so that large
+ *  certificate or ACF payloads don't block the event loop, and completes
+ *  each of them on the event loop where the NewFileAvailable request is
+ *  sent. The jobs run one at a time, which keeps the files written in the
+ *  order requested, the resource dump parameters always go to the same
+ *  file. The jobs are only queued from the event loop.
+ */
+class FileJobs
+{
+  public:
+    FileJobs(const FileJobs&) = delete;
+    FileJobs(FileJobs&&) = delete;
+    FileJobs& operator=(const FileJobs&) = delete;
+    FileJobs& operator=(FileJobs&&) = delete;
+
+    /** @brief The result of a job, the size of the file written or a
+     *         negative errno
+     */
+    using Result = int64_t;
+
+    /** @brief Get the jobs of the process */
+    static FileJobs& get()
+    {
+        static FileJobs jobs;
+        return jobs;
+    }
+
+    /** @brief Queue a job to the worker pool
+     *
+     *  @param[in] job - writes the file, off the event loop
+     *  @param[in] done - called with the result of job on the event loop
+     *
+     *  @return false if the worker pool could not be started
+     */
+    bool post(std::function<Result()>&& job,
+              std::function<void(Result)>&& done)
+    {
+        jobs.emplace_back(std::move(job), std::move(done));
+        if (!runNext())
+        {
+            jobs.pop_back();
+            return false;
+        }
+        return true;
+    }
+
+  private:
+    FileJobs() = default;
+
+    /** @brief Hand the next queued job to the worker pool, unless a job
+     *         already runs
+     *
+     *  @return false if the worker pool could not be started
+     */
+    bool runNext()
+    {
+        if (busy || jobs.empty())
+        {
+            return true;
+        }
+        auto result = std::make_shared<Result>(0);
+        auto& [job, done] = jobs.front();
+        try
+        {
+            WorkerPool::getInstance().post(
+                [run = std::move(job), result] { *result = run(); },
+                [this, complete = std::move(done), result] {
+                    busy = false;
+                    runNext();
+                    complete(*result);
+                });
+        }
+        catch (const std::system_error& e)
+        {
+            error("Failed to start the file job, error - {ERROR}", "ERROR",
+                  e);
+            return false;
+        }
+        jobs.pop_front();
+        busy = true;
+        return true;
+    }
+
+    /** @brief jobs waiting for the running one, with their completion */
+    std::deque<
+        std::pair<std::function<Result()>, std::function<void(Result)>>>
+        jobs;
+
+    /** @brief whether a job runs on the worker pool */
+    bool busy = false;
+};
+
+/** @brief Write a file of parameters, each preceded by its size
+ *
+ *  @param[in] filePath - path of the file
+ *  @param[in] params - the parameters
+ *
+ *  @return the size of the file, negative errno on failure
+ */
+static FileJobs::Result writeParamsFile(const fs::path& filePath,
+                                        const std::vector<std::string>& params)
+{
+    std::ofstream fileHandle;
+    fileHandle.open(filePath, std::ios::out | std::ofstream::binary);
+    if (!fileHandle)
+    {
+        return -EIO;
+    }
+
+    // Fill up the file with resource dump parameters and respective sizes
+    for (const auto& paramBuf : params)
+    {
+        uint32_t paramSize = paramBuf.size();
+        fileHandle.write((char*)&paramSize, sizeof(paramSize));
+        fileHandle << paramBuf;
+    }
+
+    fileHandle.close();
+    if (!fileHandle)
+    {
+        return -EIO;
+    }
+    std::error_code ec;
+    auto fileSize = fs::file_size(filePath, ec);
+    return ec ? -ec.value() : static_cast<FileJobs::Result>(fileSize);
+}
+
 DbusToFileHandler::DbusToFileHandler(
     int /* mctp_fd */, uint8_t mctp_eid, pldm::InstanceIdDb* instanceIdDb,
     sdbusplus::message::object_path resDumpCurrentObjPath,
@@ -41,9 +179,8 @@ void DbusToFileHandler::sendNewFileAvailableCmd(uint64_t fileSize)
         return;
     }
     auto instanceId = instanceIdDb->next(mctp_eid);
-    std::vector<uint8_t> requestMsg(
-        sizeof(pldm_msg_hdr) + PLDM_NEW_FILE_REQ_BYTES);
-    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    PldmMsg<PLDM_NEW_FILE_REQ_BYTES> requestMsg;
+    auto request = requestMsg.msg();
     // Need to revisit this logic at the time of multiple resource dump support
     uint32_t fileHandle = 1;
 
@@ -133,62 +270,50 @@ void DbusToFileHandler::processNewResourceDump(
             resDumpProgressIntf);
     }
 
-    namespace fs = std::filesystem;
-    const fs::path resDumpDirPath = "/var/lib/pldm/resourcedump";
-
-    if (!fs::exists(resDumpDirPath))
-    {
-        fs::create_directories(resDumpDirPath);
-    }
-
     // Need to reconsider this logic to set the value as "1" when we have the
     // support to handle multiple resource dumps
-    fs::path resDumpFilePath = resDumpDirPath / "1";
-
-    std::ofstream fileHandle;
-    fileHandle.open(resDumpFilePath, std::ios::out | std::ofstream::binary);
+    auto job = [vspString, resDumpReqPass]() -> FileJobs::Result {
+        const fs::path resDumpDirPath = "/var/lib/pldm/resourcedump";
+        std::error_code ec;
+        fs::create_directories(resDumpDirPath, ec);
 
-    if (!fileHandle)
-    {
-        error("Failed to open resource dump file '{PATH}'", "PATH",
-              resDumpFilePath);
-        PropertyValue value{resDumpStatus};
-        DBusMapping dbusMapping{resDumpCurrentObjPath, resDumpProgressIntf,
-                                "Status", "string"};
-        try
+        std::string acf;
+        if (!resDumpReqPass.empty())
         {
-            pldm::utils::DBusHandler().setDbusProperty(dbusMapping, value);
+            acf = getAcfFileContent();
         }
-        catch (const std::exception& e)
+        return writeParamsFile(resDumpDirPath / "1",
+                               {vspString, resDumpReqPass, acf});
+    };
+
+    auto done = [this](FileJobs::Result fileSize) {
+        if (fileSize < 0)
         {
             error(
-                "Failed to set resource dump operation status, error - {ERROR}",
-                "ERROR", e);
+                "Failed to write resource dump file, error number - {ERROR_NUM}",
+                "ERROR_NUM", -fileSize);
+            PropertyValue value{resDumpStatus};
+            DBusMapping dbusMapping{resDumpCurrentObjPath, resDumpProgressIntf,
+                                    "Status", "string"};
+            try
+            {
+                pldm::utils::DBusHandler().setDbusProperty(dbusMapping, value);
+            }
+            catch (const std::exception& e)
+            {
+                error(
+                    "Failed to set resource dump operation status, error - {ERROR}",
+                    "ERROR", e);
+            }
+            return;
         }
-        return;
-    }
-
-    // Fill up the file with resource dump parameters and respective sizes
-    auto fileFunc = [&fileHandle](auto& paramBuf) {
-        uint32_t paramSize = paramBuf.size();
-        fileHandle.write((char*)&paramSize, sizeof(paramSize));
-        fileHandle << paramBuf;
+        sendNewFileAvailableCmd(fileSize);
     };
-    fileFunc(vspString);
-    fileFunc(resDumpReqPass);
 
-    std::string str;
-    if (!resDumpReqPass.empty())
+    if (!FileJobs::get().post(std::move(job), std::move(done)))
     {
-        str = getAcfFileContent();
+        reportResourceDumpFailure("WriteResourceDumpFile");
     }
-
-    fileFunc(str);
-
-    fileHandle.close();
-    size_t fileSize = fs::file_size(resDumpFilePath);
-
-    sendNewFileAvailableCmd(fileSize);
 }
 
 std::string DbusToFileHandler::getAcfFileContent()
@@ -210,36 +335,53 @@ std::string DbusToFileHandler::getAcfFileContent()
 void DbusToFileHandler::newCsrFileAvailable(const std::string& csr,
                                             const std::string fileHandle)
 {
-    namespace fs = std::filesystem;
-    std::string dirPath = "/var/lib/ibm/bmcweb";
-    const fs::path certDirPath = dirPath;
+    auto handle = static_cast<uint32_t>(stoi(fileHandle));
 
-    if (!fs::exists(certDirPath))
-    {
-        fs::create_directories(certDirPath);
-        fs::permissions(certDirPath,
-                        fs::perms::others_read | fs::perms::owner_write);
-    }
+    auto job = [csr, fileHandle]() -> FileJobs::Result {
+        const fs::path certDirPath = "/var/lib/ibm/bmcweb";
+        std::error_code ec;
+        if (!fs::exists(certDirPath, ec))
+        {
+            fs::create_directories(certDirPath, ec);
+            fs::permissions(certDirPath,
+                            fs::perms::others_read | fs::perms::owner_write,
+                            ec);
+        }
 
-    fs::path certFilePath = certDirPath / ("CSR_" + fileHandle);
-    std::ofstream certFile;
+        fs::path certFilePath = certDirPath / ("CSR_" + fileHandle);
+        std::ofstream certFile;
 
-    certFile.open(certFilePath, std::ios::out | std::ofstream::binary);
+        certFile.open(certFilePath, std::ios::out | std::ofstream::binary);
 
-    if (!certFile)
-    {
-        error("Failed to open certificate file '{PATH}'", "PATH", certFilePath);
-        return;
-    }
+        if (!certFile)
+        {
+            error("Failed to open certificate file '{PATH}'", "PATH",
+                  certFilePath);
+            return -EIO;
+        }
 
-    // Add csr to file
-    certFile << csr << std::endl;
+        // Add csr to file
+        certFile << csr << std::endl;
 
-    certFile.close();
-    uint32_t fileSize = fs::file_size(certFilePath);
+        certFile.close();
+        auto fileSize = fs::file_size(certFilePath, ec);
+        return ec ? -ec.value() : static_cast<FileJobs::Result>(fileSize);
+    };
+
+    auto done = [this, handle](FileJobs::Result fileSize) {
+        if (fileSize < 0)
+        {
+            return;
+        }
+        newFileAvailableSendToHost(fileSize, handle,
+                                   PLDM_FILE_TYPE_CERT_SIGNING_REQUEST);
+    };
 
-    newFileAvailableSendToHost(fileSize, (uint32_t)stoi(fileHandle),
-                               PLDM_FILE_TYPE_CERT_SIGNING_REQUEST);
+    if (!FileJobs::get().post(std::move(job), std::move(done)))
+    {
+        pldm::utils::reportError(
+            "xyz.openbmc_project.bmc.pldm.InternalFailure");
+    }
 }
 
 void DbusToFileHandler::newFileAvailableSendToHost(
@@ -253,9 +395,8 @@ void DbusToFileHandler::newFileAvailableSendToHost(
         return;
     }
     auto instanceId = instanceIdDb->next(mctp_eid);
-    std::vector<uint8_t> requestMsg(
-        sizeof(pldm_msg_hdr) + PLDM_NEW_FILE_REQ_BYTES);
-    auto request = reinterpret_cast<pldm_msg*>(requestMsg.data());
+    PldmMsg<PLDM_NEW_FILE_REQ_BYTES> requestMsg;
+    auto request = requestMsg.msg();
 
     auto rc =
         encode_new_file_req(instanceId, type, fileHandle, fileSize, request);
@@ -20,7 +20,8 @@ using ResDumpStatus = std::string;
 /** @class DbusToFileHandler
  *  @brief This class can process resource dump parameters and send PLDM
  *         new file available cmd to the hypervisor. This class can be used
- *         as a pldm requester in oem-ibm path.
+ *         as a pldm requester in oem-ibm path. The files are written off
+ *         the event loop, the command is sent once they are written.
  */
 class DbusToFileHandler
 {
@@ -77,8 +78,9 @@ class DbusToFileHandler
      */
     void reportResourceDumpFailure(const std::string_view& str);
 
-    /** @brief method to get the acf file contents */
-    std::string getAcfFileContent();
+    /** @brief method to get the acf file contents, called off the event loop
+     */
+    static std::string getAcfFileContent();
 
     /** @brief MCTP EID of host firmware */
     uint8_t mctp_eid;
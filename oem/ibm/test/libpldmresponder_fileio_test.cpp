@@ -1,4 +1,5 @@
 
+#include "libpldmresponder/file_cache.hpp"
 #include "libpldmresponder/file_io.hpp"
 #include "libpldmresponder/file_io_by_type.hpp"
 #include "libpldmresponder/file_io_type_cert.hpp"
@@ -524,6 +525,22 @@ TEST_F(TestFileTable, ValidateFileTable)
               std::equal(attrTable.begin(), attrTable.end(), table.begin()));
 }
 
+TEST_F(TestFileTable, RefreshFileTable)
+{
+    FileTable tableObj(fileTableConfig.c_str());
+    ASSERT_EQ(false, tableObj.isStale());
+    auto size = tableObj().size();
+
+    // Growing a file changes its size in the file attribute table
+    fs::resize_file(imageFile, 2048);
+    ASSERT_EQ(true, tableObj.isStale());
+    tableObj.refresh();
+    ASSERT_EQ(false, tableObj.isStale());
+    ASSERT_EQ(size, tableObj().size());
+    ASSERT_EQ(false, std::equal(attrTable.begin(), attrTable.end(),
+                                tableObj().begin()));
+}
+
 TEST_F(TestFileTable, GetFileTableCommand)
 {
     // Initialise the file table with a valid handle of 0 & 1
@@ -832,7 +849,8 @@ TEST(writeFileByTypeFromMemory, testBadPath)
     std::unique_ptr<oem_platform::Handler> oemPlatformHandler{};
     oem_ibm::Handler handler(oemPlatformHandler.get(), hostSocketFd, host_eid,
                              nullptr, nullptr);
-    auto response = handler.writeFileByTypeFromMemory(req, 0);
+    auto response =
+        handler.writeFileByTypeFromMemory(req, 0, [](Response&&) {});
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     struct pldm_read_write_file_by_type_memory_resp* resp =
@@ -840,7 +858,8 @@ TEST(writeFileByTypeFromMemory, testBadPath)
             responsePtr->payload);
     ASSERT_EQ(PLDM_ERROR_INVALID_LENGTH, resp->completion_code);
 
-    response = handler.writeFileByTypeFromMemory(req, requestPayloadLength);
+    response = handler.writeFileByTypeFromMemory(req, requestPayloadLength,
+                                                 [](Response&&) {});
     responsePtr = reinterpret_cast<pldm_msg*>(response.data());
 
     resp = reinterpret_cast<struct pldm_read_write_file_by_type_memory_resp*>(
@@ -920,7 +939,8 @@ TEST(readFileByTypeIntoMemory, testBadPath)
     std::unique_ptr<oem_platform::Handler> oemPlatformHandler{};
     oem_ibm::Handler handler(oemPlatformHandler.get(), hostSocketFd, host_eid,
                              nullptr, nullptr);
-    auto response = handler.readFileByTypeIntoMemory(req, 0);
+    auto response =
+        handler.readFileByTypeIntoMemory(req, 0, [](Response&&) {});
     auto responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     struct pldm_read_write_file_by_type_memory_resp* resp =
         reinterpret_cast<struct pldm_read_write_file_by_type_memory_resp*>(
@@ -928,7 +948,7 @@ TEST(readFileByTypeIntoMemory, testBadPath)
     ASSERT_EQ(PLDM_ERROR_INVALID_LENGTH, resp->completion_code);
 
     response = handler.readFileByTypeIntoMemory(
-        req, PLDM_RW_FILE_BY_TYPE_MEM_REQ_BYTES);
+        req, PLDM_RW_FILE_BY_TYPE_MEM_REQ_BYTES, [](Response&&) {});
     responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     resp = reinterpret_cast<struct pldm_read_write_file_by_type_memory_resp*>(
         responsePtr->payload);
@@ -936,7 +956,7 @@ TEST(readFileByTypeIntoMemory, testBadPath)
 
     request->length = 16;
     response = handler.readFileByTypeIntoMemory(
-        req, PLDM_RW_FILE_BY_TYPE_MEM_REQ_BYTES);
+        req, PLDM_RW_FILE_BY_TYPE_MEM_REQ_BYTES, [](Response&&) {});
     responsePtr = reinterpret_cast<pldm_msg*>(response.data());
     resp = reinterpret_cast<struct pldm_read_write_file_by_type_memory_resp*>(
         responsePtr->payload);
@@ -998,3 +1018,41 @@ TEST(readFileByType, testReadFile)
     ASSERT_EQ(response.size(), in.size());
     ASSERT_EQ(std::equal(in.begin(), in.end(), response.begin()), true);
 }
+
+TEST(readFileByType, testReadReplacedFile)
+{
+    LidHandler handler(0, true);
+
+    char tmplt[] = "/tmp/lid.XXXXXX";
+    auto fd = mkstemp(tmplt);
+    std::vector<uint8_t> in = {100, 10, 56, 78, 34, 56, 79, 235, 111};
+    auto rc = write(fd, in.data(), in.size());
+    ASSERT_NE(rc, PLDM_ERROR);
+    close(fd);
+
+    Response response;
+    uint32_t length = in.size();
+    rc = handler.readCachedFile(tmplt, 0, length, response, true);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(response.size(), in.size());
+
+    // A file replaced at the same path is read again, not the cached one
+    char replacement[] = "/tmp/lid.XXXXXX";
+    fd = mkstemp(replacement);
+    std::vector<uint8_t> update = {1, 2, 3, 4};
+    rc = write(fd, update.data(), update.size());
+    ASSERT_NE(rc, PLDM_ERROR);
+    close(fd);
+    fs::rename(replacement, tmplt);
+
+    response.clear();
+    length = in.size();
+    rc = handler.readCachedFile(tmplt, 0, length, response, true);
+    ASSERT_EQ(rc, PLDM_SUCCESS);
+    ASSERT_EQ(length, update.size());
+    ASSERT_EQ(std::equal(update.begin(), update.end(), response.begin()),
+              true);
+
+    FileCache::get().clear();
+    fs::remove(tmplt);
+}
@@ -73,6 +73,7 @@ class MockOemPlatformHandler : public oem_ibm_platform::Handler
     MOCK_METHOD(uint16_t, getNextSensorId, ());
     MOCK_METHOD((const AssociatedEntityMap&), getAssociateEntityMap, (),
                 (override));
+    MOCK_METHOD(void, resetWatchDogTimeRemaining, (), (override));
 };
 
 TEST(OemSetStateEffecterStatesHandler, testGoodRequest)
@@ -457,6 +458,39 @@ TEST(updateOemDbusPath, testgoodpath)
     EXPECT_EQ(dbuspath, "/inventory/system/chassis/motherboard/dcm0");
 }
 
+TEST(sendStateSensorEvent, testCoalescing)
+{
+    if (oem_ibm_platform::hostEventCoalesceInterval.count() == 0)
+    {
+        GTEST_SKIP() << "State sensor events are not coalesced";
+    }
+
+    TestInstanceIdDb instanceIdDb;
+    auto mockDbusHandler = std::make_unique<MockdBusHandler>();
+    auto event = sdeventplus::Event::get_default();
+    std::unique_ptr<CodeUpdate> mockCodeUpdate =
+        std::make_unique<MockCodeUpdate>(mockDbusHandler.get());
+    std::unique_ptr<oem_ibm_platform::Handler> mockoemPlatformHandler =
+        std::make_unique<MockOemPlatformHandler>(
+            mockDbusHandler.get(), mockCodeUpdate.get(), nullptr, 0x1, 0x9,
+            instanceIdDb, event);
+
+    mockoemPlatformHandler->sendStateSensorEvent(1, PLDM_STATE_SENSOR_STATE, 0,
+                                                 1, 0);
+    mockoemPlatformHandler->sendStateSensorEvent(2, PLDM_STATE_SENSOR_STATE, 0,
+                                                 1, 0);
+    mockoemPlatformHandler->sendStateSensorEvent(1, PLDM_STATE_SENSOR_STATE, 0,
+                                                 2, 1);
+
+    // The events wait for the coalescing window, one per sensor offset
+    EXPECT_EQ(mockoemPlatformHandler->hostEventQueueDepth(), 2);
+    const auto& stats = mockoemPlatformHandler->getHostEventQueueStats();
+    EXPECT_EQ(stats.queued, 3);
+    EXPECT_EQ(stats.coalesced, 1);
+    EXPECT_EQ(stats.sent, 0);
+    EXPECT_EQ(stats.maxDepth, 2);
+}
+
 TEST(SetCoreCount, testgoodpath)
 {
     pldm::utils::EntityMaps entityMaps = pldm::hostbmc::utils::parseEntityMap(
@@ -539,3 +573,232 @@ TEST(SetCoreCount, testgoodpath)
     EXPECT_EQ(coreCount, 2);
     pldm_entity_association_tree_destroy(tree);
 }
+
+TEST(resetWatchDogTimer, heartbeatsCoalesced)
+{
+    TestInstanceIdDb instanceIdDb;
+    auto mockDbusHandler = std::make_unique<MockdBusHandler>();
+    auto event = sdeventplus::Event::get_default();
+    std::unique_ptr<CodeUpdate> mockCodeUpdate =
+        std::make_unique<MockCodeUpdate>(mockDbusHandler.get());
+    auto mockoemPlatformHandler = std::make_unique<MockOemPlatformHandler>(
+        mockDbusHandler.get(), mockCodeUpdate.get(), nullptr, 0x1, 0x9,
+        instanceIdDb, event);
+
+    // The watchdog state is read once, the heartbeats within half of the
+    // interval of the last reset don't reset it again
+    EXPECT_CALL(*mockDbusHandler,
+                getDbusPropertiesVariant(::testing::_, ::testing::_,
+                                         ::testing::_))
+        .WillOnce(Return(PropertyMap{{"Enabled", true},
+                                     {"Interval", uint64_t(3600000)}}));
+    EXPECT_CALL(*mockoemPlatformHandler, resetWatchDogTimeRemaining())
+        .Times(1);
+
+    mockoemPlatformHandler->resetWatchDogTimer();
+    mockoemPlatformHandler->resetWatchDogTimer();
+    mockoemPlatformHandler->resetWatchDogTimer();
+    EXPECT_TRUE(mockoemPlatformHandler->watchDogRunning());
+}
+
+TEST(resetWatchDogTimer, failedResetRetried)
+{
+    TestInstanceIdDb instanceIdDb;
+    auto mockDbusHandler = std::make_unique<MockdBusHandler>();
+    auto event = sdeventplus::Event::get_default();
+    std::unique_ptr<CodeUpdate> mockCodeUpdate =
+        std::make_unique<MockCodeUpdate>(mockDbusHandler.get());
+    auto mockoemPlatformHandler = std::make_unique<MockOemPlatformHandler>(
+        mockDbusHandler.get(), mockCodeUpdate.get(), nullptr, 0x1, 0x9,
+        instanceIdDb, event);
+
+    EXPECT_CALL(*mockDbusHandler,
+                getDbusPropertiesVariant(::testing::_, ::testing::_,
+                                         ::testing::_))
+        .WillOnce(Return(PropertyMap{{"Enabled", true},
+                                     {"Interval", uint64_t(3600000)}}));
+    EXPECT_CALL(*mockoemPlatformHandler, resetWatchDogTimeRemaining())
+        .WillOnce(::testing::Throw(std::runtime_error("no reply")))
+        .WillOnce(::testing::Return());
+
+    mockoemPlatformHandler->resetWatchDogTimer();
+    mockoemPlatformHandler->resetWatchDogTimer();
+    mockoemPlatformHandler->resetWatchDogTimer();
+}
+
+TEST(resetWatchDogTimer, unreachableWatchDogStopped)
+{
+    TestInstanceIdDb instanceIdDb;
+    auto mockDbusHandler = std::make_unique<MockdBusHandler>();
+    auto event = sdeventplus::Event::get_default();
+    std::unique_ptr<CodeUpdate> mockCodeUpdate =
+        std::make_unique<MockCodeUpdate>(mockDbusHandler.get());
+    auto mockoemPlatformHandler = std::make_unique<MockOemPlatformHandler>(
+        mockDbusHandler.get(), mockCodeUpdate.get(), nullptr, 0x1, 0x9,
+        instanceIdDb, event);
+
+    // The watchdog is not queried again until its service restarts
+    EXPECT_CALL(*mockDbusHandler,
+                getDbusPropertiesVariant(::testing::_, ::testing::_,
+                                         ::testing::_))
+        .WillOnce(::testing::Throw(std::runtime_error("no service")));
+    EXPECT_CALL(*mockoemPlatformHandler, resetWatchDogTimeRemaining())
+        .Times(0);
+
+    mockoemPlatformHandler->resetWatchDogTimer();
+    mockoemPlatformHandler->resetWatchDogTimer();
+    EXPECT_FALSE(mockoemPlatformHandler->watchDogRunning());
+}
+
+TEST(checkBMCState, stateCached)
+{
+    TestInstanceIdDb instanceIdDb;
+    auto mockDbusHandler = std::make_unique<MockdBusHandler>();
+    auto event = sdeventplus::Event::get_default();
+    std::unique_ptr<CodeUpdate> mockCodeUpdate =
+        std::make_unique<MockCodeUpdate>(mockDbusHandler.get());
+    auto mockoemPlatformHandler = std::make_unique<MockOemPlatformHandler>(
+        mockDbusHandler.get(), mockCodeUpdate.get(), nullptr, 0x1, 0x9,
+        instanceIdDb, event);
+
+    // A failed read is not cached, the state read next is
+    EXPECT_CALL(*mockDbusHandler,
+                getDbusPropertyVariant(::testing::StrEq(bmcStateObjectPath),
+                                       ::testing::StrEq("CurrentBMCState"),
+                                       ::testing::StrEq(bmcStateInterface)))
+        .WillOnce(::testing::Throw(std::runtime_error("no service")))
+        .WillOnce(Return(PropertyValue{
+            std::string("xyz.openbmc_project.State.BMC.BMCState.NotReady")}));
+
+    EXPECT_EQ(mockoemPlatformHandler->checkBMCState(), PLDM_ERROR);
+    EXPECT_EQ(mockoemPlatformHandler->checkBMCState(), PLDM_ERROR_NOT_READY);
+    EXPECT_EQ(mockoemPlatformHandler->checkBMCState(), PLDM_ERROR_NOT_READY);
+}
+
+TEST(checkBMCState, readyStateCached)
+{
+    TestInstanceIdDb instanceIdDb;
+    auto mockDbusHandler = std::make_unique<MockdBusHandler>();
+    auto event = sdeventplus::Event::get_default();
+    std::unique_ptr<CodeUpdate> mockCodeUpdate =
+        std::make_unique<MockCodeUpdate>(mockDbusHandler.get());
+    auto mockoemPlatformHandler = std::make_unique<MockOemPlatformHandler>(
+        mockDbusHandler.get(), mockCodeUpdate.get(), nullptr, 0x1, 0x9,
+        instanceIdDb, event);
+
+    EXPECT_CALL(*mockDbusHandler,
+                getDbusPropertyVariant(::testing::StrEq(bmcStateObjectPath),
+                                       ::testing::StrEq("CurrentBMCState"),
+                                       ::testing::StrEq(bmcStateInterface)))
+        .WillOnce(Return(PropertyValue{
+            std::string("xyz.openbmc_project.State.BMC.BMCState.Ready")}));
+
+    EXPECT_EQ(mockoemPlatformHandler->checkBMCState(), PLDM_SUCCESS);
+    EXPECT_EQ(mockoemPlatformHandler->checkBMCState(), PLDM_SUCCESS);
+}
+
+class TestSlotHandler : public ::testing::Test
+{
+  protected:
+    TestSlotHandler() :
+        event(sdeventplus::Event::get_default()),
+        pdrRepo(pldm_pdr_init(), pldm_pdr_destroy),
+        slotHandler(event, pdrRepo.get())
+    {}
+
+    /** @brief Start an operation on the slot of an adapter, as
+     *         processSlotOperations does once the VPD manager was called
+     */
+    void startOperation(const std::string& adapter, uint16_t instance,
+                        std::chrono::steady_clock::duration timeout)
+    {
+        slotHandler.slotOperations.insert_or_assign(
+            adapter,
+            SlotHandler::SlotOperation{
+                {PLDM_ENTITY_SLOT, instance, 1},
+                PLDM_OEM_IBM_PCIE_SLOT_EFFECTER_ADD,
+                std::chrono::steady_clock::now() + timeout});
+        slotHandler.createPresenceMatch();
+        slotHandler.restartTimer();
+    }
+
+    bool inProgress(const std::string& adapter) const
+    {
+        return slotHandler.slotOperations.contains(adapter);
+    }
+
+    /** @brief The inventory reports the Present property of an adapter */
+    void present(bool value, const std::string& adapter)
+    {
+        slotHandler.processPresentPropertyChange(value, adapter);
+    }
+
+    void timeOut()
+    {
+        slotHandler.timeOutHandler();
+    }
+
+    bool timerEnabled() const
+    {
+        return slotHandler.timer.isEnabled();
+    }
+
+    auto timerRemaining() const
+    {
+        return slotHandler.timer.getRemaining();
+    }
+
+    bool watchingPresence() const
+    {
+        return slotHandler.fruPresenceMatch != nullptr;
+    }
+
+    static constexpr auto adapter1 =
+        "/xyz/openbmc_project/inventory/system/chassis/slot1/adapter1";
+    static constexpr auto adapter2 =
+        "/xyz/openbmc_project/inventory/system/chassis/slot2/adapter2";
+
+    sdeventplus::Event event;
+    std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo;
+    SlotHandler slotHandler;
+};
+
+TEST_F(TestSlotHandler, slotsCompleteIndependently)
+{
+    startOperation(adapter1, 1, std::chrono::seconds(60));
+    startOperation(adapter2, 2, std::chrono::seconds(60));
+
+    // An adapter with no operation in progress is ignored
+    present(true,
+            "/xyz/openbmc_project/inventory/system/chassis/slot3/adapter3");
+    EXPECT_TRUE(inProgress(adapter1));
+    EXPECT_TRUE(inProgress(adapter2));
+
+    present(true, adapter1);
+    EXPECT_FALSE(inProgress(adapter1));
+    EXPECT_TRUE(inProgress(adapter2));
+    EXPECT_TRUE(timerEnabled());
+    EXPECT_TRUE(watchingPresence());
+
+    present(false, adapter2);
+    EXPECT_FALSE(inProgress(adapter2));
+    EXPECT_FALSE(timerEnabled());
+    EXPECT_FALSE(watchingPresence());
+}
+
+TEST_F(TestSlotHandler, slotsTimeOutOnTheirOwnDeadline)
+{
+    startOperation(adapter1, 1, std::chrono::seconds(0));
+    startOperation(adapter2, 2, std::chrono::seconds(60));
+
+    // Only the operation past its deadline ends, the timer is armed for
+    // the deadline of the other one
+    timeOut();
+    EXPECT_FALSE(inProgress(adapter1));
+    EXPECT_TRUE(inProgress(adapter2));
+    EXPECT_TRUE(timerEnabled());
+    EXPECT_GT(timerRemaining(), std::chrono::seconds(50));
+
+    present(true, adapter2);
+    EXPECT_FALSE(timerEnabled());
+}
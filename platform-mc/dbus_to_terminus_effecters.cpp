@@ -1,5 +1,7 @@
 #include "dbus_to_terminus_effecters.hpp"
 
+#include "common/json_cache.hpp"
+
 #include <libpldm/pdr.h>
 #include <libpldm/platform.h>
 
@@ -8,7 +10,9 @@
 #include <xyz/openbmc_project/State/Boot/Progress/client.hpp>
 #include <xyz/openbmc_project/State/OperatingSystem/Status/server.hpp>
 
-#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <span>
 
 PHOSPHOR_LOG2_USING;
 
@@ -52,8 +56,8 @@ void HostEffecterParser::parseEffecterJson(const std::string& jsonPath)
         throw InternalFailure();
     }
 
-    std::ifstream jsonFile(jsonFilePath);
-    auto data = Json::parse(jsonFile, nullptr, false);
+    auto data = pldm::utils::JsonCache::getInstance().parse(jsonFilePath,
+                                                            false);
     if (data.is_discarded())
     {
         error("Failed to parse json file {PATH}", "PATH", jsonFilePath);
@@ -101,6 +105,8 @@ void HostEffecterParser::parseEffecterJson(const std::string& jsonPath)
                 auto jsonDbusInfo = effecter.value("dbus_info", empty);
                 dbusInfo.dataSize = effecter.value("effecterDataSize", 0);
                 dbusInfo.unitModifier = effecter.value("unitModifier", 0);
+                dbusInfo.unitDivisor =
+                    std::pow(10, signed(dbusInfo.unitModifier));
                 dbusInfo.resolution = effecter.value("resolution", 1);
                 dbusInfo.offset = effecter.value("offset", 0);
                 dbusInfo.dbusMap.objectPath =
@@ -173,6 +179,12 @@ void HostEffecterParser::parseEffecterJson(const std::string& jsonPath)
             {
                 dbusInfo.state.states.emplace_back(s);
             }
+            // The first state of a D-Bus value listed twice is kept
+            for (size_t index = 0; index < states.size(); index++)
+            {
+                dbusInfo.stateValues.emplace(dbusInfo.propertyValues[index],
+                                             dbusInfo.state.states[index]);
+            }
 
             auto effecterInfoIndex = hostEffecterInfo.size();
             auto dbusInfoIndex = effecterInfo.dbusInfo.size();
@@ -183,33 +195,49 @@ void HostEffecterParser::parseEffecterJson(const std::string& jsonPath)
         }
         hostEffecterInfo.emplace_back(std::move(effecterInfo));
     }
+
+    createEffecterMatches();
+}
+
+using BootProgress =
+    sdbusplus::client::xyz::openbmc_project::state::boot::Progress<>;
+constexpr auto hostStatePath = "/xyz/openbmc_project/state/host0";
+
+/** @brief Check that a BootProgress stage has the host up to set effecters
+ *
+ *  @param[in] stage - BootProgress property value
+ *  @return true if the host is on
+ */
+static bool isHostOnStage(const std::string& stage)
+{
+    using Stages = BootProgress::ProgressStages;
+    auto currHostState =
+        sdbusplus::message::convert_from_string<Stages>(stage);
+    if (!currHostState || (*currHostState != Stages::SystemInitComplete &&
+                           *currHostState != Stages::OSRunning &&
+                           *currHostState != Stages::SystemSetup &&
+                           *currHostState != Stages::OEM))
+    {
+        info(
+            "Remote terminus is not up/active, current remote terminus state is: '{CURRENT_HOST_STATE}'",
+            "CURRENT_HOST_STATE", stage);
+        return false;
+    }
+    return true;
 }
 
 bool HostEffecterParser::isHostOn(void)
 {
-    using BootProgress =
-        sdbusplus::client::xyz::openbmc_project::state::boot::Progress<>;
-    constexpr auto hostStatePath = "/xyz/openbmc_project/state/host0";
+    if (hostOn)
+    {
+        return *hostOn;
+    }
+
     try
     {
         auto propVal = dbusHandler->getDbusPropertyVariant(
             hostStatePath, "BootProgress", BootProgress::interface);
-
-        using Stages = BootProgress::ProgressStages;
-        auto currHostState = sdbusplus::message::convert_from_string<Stages>(
-                                 std::get<std::string>(propVal))
-                                 .value();
-
-        if (currHostState != Stages::SystemInitComplete &&
-            currHostState != Stages::OSRunning &&
-            currHostState != Stages::SystemSetup &&
-            currHostState != Stages::OEM)
-        {
-            info(
-                "Remote terminus is not up/active, current remote terminus state is: '{CURRENT_HOST_STATE}'",
-                "CURRENT_HOST_STATE", currHostState);
-            return false;
-        }
+        hostOn = isHostOnStage(std::get<std::string>(propVal));
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -219,7 +247,43 @@ bool HostEffecterParser::isHostOn(void)
         return false;
     }
 
-    return true;
+    return *hostOn;
+}
+
+void HostEffecterParser::processHostStateChanged(sdbusplus::message_t& msg)
+{
+    DbusChgHostEffecterProps props;
+    std::string iface;
+    try
+    {
+        msg.read(iface, props);
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        error(
+            "Failed to read the remote terminus state change signal, error - {ERROR}",
+            "ERROR", e);
+        return;
+    }
+    auto it = props.find("BootProgress");
+    if (it == props.end() || !std::holds_alternative<std::string>(it->second))
+    {
+        return;
+    }
+
+    hostOn = isHostOnStage(std::get<std::string>(it->second));
+    if (!*hostOn)
+    {
+        return;
+    }
+
+    /* The writes held while the host was off, one per effecter */
+    auto held = std::move(heldEffecterWrites);
+    heldEffecterWrites.clear();
+    for (const auto& [effecterInfoIndex, effecterId] : held)
+    {
+        scheduleEffecterWrite(effecterInfoIndex, effecterId);
+    }
 }
 
 void HostEffecterParser::processHostEffecterChangeNotification(
@@ -268,11 +332,6 @@ void HostEffecterParser::processHostEffecterChangeNotification(
         }
     }
 
-    if (!isHostOn())
-    {
-        return;
-    }
-
     uint8_t newState{};
     try
     {
@@ -299,24 +358,143 @@ void HostEffecterParser::processHostEffecterChangeNotification(
             stateField.push_back({PLDM_NO_CHANGE, 0});
         }
     }
-    int rc{};
-    try
+    queueStateEffecterWrite(effecterInfoIndex, stateField, effecterId);
+}
+
+void HostEffecterParser::queueStateEffecterWrite(
+    size_t effecterInfoIndex,
+    const std::vector<set_effecter_state_field>& stateField,
+    uint16_t effecterId)
+{
+    auto& pending = effecterWrites[{effecterInfoIndex, effecterId}];
+    if (pending.stateField.size() < stateField.size())
     {
-        rc = setHostStateEffecter(effecterInfoIndex, stateField, effecterId);
+        pending.stateField.resize(stateField.size(), {PLDM_NO_CHANGE, 0});
     }
-    catch (const std::runtime_error& e)
+    for (size_t i = 0; i < stateField.size(); i++)
     {
-        error(
-            "Failed to set remote terminus state effecter for effecter ID '{EFFECTERID}', error - {ERROR}",
-            "ERROR", e, "EFFECTERID", effecterId);
+        if (stateField[i].set_request == PLDM_REQUEST_SET)
+        {
+            pending.stateField[i] = stateField[i];
+        }
+    }
+
+    scheduleEffecterWrite(effecterInfoIndex, effecterId);
+}
+
+void HostEffecterParser::queueNumericEffecterWrite(
+    size_t effecterInfoIndex, size_t dbusInfoIndex, uint16_t effecterId,
+    double value, double rawValue)
+{
+    auto& pending = effecterWrites[{effecterInfoIndex, effecterId}];
+    pending.rawValue = rawValue;
+    pending.value = value;
+    pending.dbusInfoIndex = dbusInfoIndex;
+
+    scheduleEffecterWrite(effecterInfoIndex, effecterId);
+}
+
+void HostEffecterParser::scheduleEffecterWrite(size_t effecterInfoIndex,
+                                               uint16_t effecterId)
+{
+    const auto& effecterInfo = hostEffecterInfo[effecterInfoIndex];
+    if ((effecterInfo.effecterPdrType != PLDM_NUMERIC_EFFECTER_PDR ||
+         effecterInfo.checkHostState) &&
+        !isHostOn())
+    {
+        /* Sent, merged with the later writes, once the host is on */
+        heldEffecterWrites.emplace(effecterInfoIndex, effecterId);
         return;
     }
-    if (rc != PLDM_SUCCESS)
+
+    auto& pending = effecterWrites[{effecterInfoIndex, effecterId}];
+    if (pending.timer && pending.timer->isRunning())
     {
-        error(
-            "Failed to set the remote terminus state effecter for effecter ID '{EFFECTERID}', response code '{RC}'",
-            "EFFECTERID", effecterId, "RC", rc);
+        /* Sent with the pending write */
+        return;
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - pending.lastSent;
+    if (elapsed >= effecterWriteInterval)
+    {
+        sendEffecterWrite(effecterInfoIndex, effecterId);
+        return;
+    }
+
+    if (!pending.timer)
+    {
+        pending.timer = std::make_unique<sdbusplus::Timer>(
+            [this, effecterInfoIndex, effecterId]() {
+                sendEffecterWrite(effecterInfoIndex, effecterId);
+            });
     }
+    pending.timer->start(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            effecterWriteInterval - elapsed));
+}
+
+void HostEffecterParser::sendEffecterWrite(size_t effecterInfoIndex,
+                                           uint16_t effecterId)
+{
+    auto& pending = effecterWrites[{effecterInfoIndex, effecterId}];
+    pending.lastSent = std::chrono::steady_clock::now();
+
+    if (!pending.stateField.empty())
+    {
+        auto stateField = std::move(pending.stateField);
+        pending.stateField.clear();
+
+        int rc{};
+        try
+        {
+            rc = setHostStateEffecter(effecterInfoIndex, stateField,
+                                      effecterId);
+        }
+        catch (const std::runtime_error& e)
+        {
+            error(
+                "Failed to set remote terminus state effecter for effecter ID '{EFFECTERID}', error - {ERROR}",
+                "ERROR", e, "EFFECTERID", effecterId);
+            return;
+        }
+        if (rc != PLDM_SUCCESS)
+        {
+            error(
+                "Failed to set the remote terminus state effecter for effecter ID '{EFFECTERID}', response code '{RC}'",
+                "EFFECTERID", effecterId, "RC", rc);
+        }
+        return;
+    }
+
+    if (!pending.rawValue)
+    {
+        return;
+    }
+
+    auto rawValue = *pending.rawValue;
+    pending.rawValue.reset();
+    auto& propValues = hostEffecterInfo[effecterInfoIndex]
+                           .dbusNumericEffecterInfo[pending.dbusInfoIndex];
+    try
+    {
+        auto rc = setTerminusNumericEffecter(effecterInfoIndex, effecterId,
+                                             propValues.dataSize, rawValue);
+        if (rc)
+        {
+            error(
+                "Could not set the numeric effecter ID '{EFFECTERID}' return code '{RC}'",
+                "EFFECTERID", effecterId, "RC", rc);
+            return;
+        }
+    }
+    catch (const std::runtime_error& e)
+    {
+        error("Could not set numeric effecter ID= '{EFFECTERID}'", "EFFECTERID",
+              effecterId);
+        return;
+    }
+
+    propValues.propertyValue = pending.value;
 }
 
 double HostEffecterParser::adjustValue(double value, double offset,
@@ -330,7 +508,6 @@ void HostEffecterParser::processTerminusNumericEffecterChangeNotification(
     const DbusChgHostEffecterProps& chProperties, size_t effecterInfoIndex,
     size_t dbusInfoIndex, uint16_t effecterId)
 {
-    const auto& checkHost = hostEffecterInfo[effecterInfoIndex].checkHostState;
     const auto& propValues = hostEffecterInfo[effecterInfoIndex]
                                  .dbusNumericEffecterInfo[dbusInfoIndex];
     const auto& propertyName = propValues.dbusMap.propertyName;
@@ -382,67 +559,37 @@ void HostEffecterParser::processTerminusNumericEffecterChangeNotification(
         return;
     }
 
-    /* Setting value equals the D-Bus value which is real value of effecter */
-    if (val == propValues.propertyValue)
-    {
-        return;
-    }
-
-    double rawValue = adjustValue(val, propValues.offset, propValues.resolution,
-                                  propValues.unitModifier);
-
-    if (checkHost && !isHostOn())
-    {
-        return;
-    }
-
-    try
+    /* Setting value equals the D-Bus value which is real value of effecter,
+     * unless it supersedes a pending write of another value */
+    auto pending = effecterWrites.find({effecterInfoIndex, effecterId});
+    if (val == propValues.propertyValue &&
+        (pending == effecterWrites.end() || !pending->second.rawValue))
     {
-        auto rc = setTerminusNumericEffecter(effecterInfoIndex, effecterId,
-                                             propValues.dataSize, rawValue);
-        if (rc)
-        {
-            error(
-                "Could not set the numeric effecter ID '{EFFECTERID}' return code '{RC}'",
-                "EFFECTERID", effecterId, "RC", rc);
-            return;
-        }
-    }
-    catch (const std::runtime_error& e)
-    {
-        error("Could not set numeric effecter ID= '{EFFECTERID}'", "EFFECTERID",
-              effecterId);
         return;
     }
 
-    hostEffecterInfo[effecterInfoIndex]
-        .dbusNumericEffecterInfo[dbusInfoIndex]
-        .propertyValue = val;
+    /* adjustValue, with the unit modifier computed once */
+    double rawValue = std::round((val - propValues.offset) *
+                                 propValues.resolution /
+                                 propValues.unitDivisor);
 
-    return;
+    queueNumericEffecterWrite(effecterInfoIndex, dbusInfoIndex, effecterId,
+                              val, rawValue);
 }
 
 uint8_t HostEffecterParser::findNewStateValue(
     size_t effecterInfoIndex, size_t dbusInfoIndex,
     const PropertyValue& propertyValue)
 {
-    const auto& propValues = hostEffecterInfo[effecterInfoIndex]
-                                 .dbusInfo[dbusInfoIndex]
-                                 .propertyValues;
-    auto it = std::find(propValues.begin(), propValues.end(), propertyValue);
-    uint8_t newState{};
-    if (it != propValues.end())
-    {
-        auto index = std::distance(propValues.begin(), it);
-        newState = hostEffecterInfo[effecterInfoIndex]
-                       .dbusInfo[dbusInfoIndex]
-                       .state.states[index];
-    }
-    else
+    const auto& stateValues = hostEffecterInfo[effecterInfoIndex]
+                                  .dbusInfo[dbusInfoIndex]
+                                  .stateValues;
+    auto it = stateValues.find(propertyValue);
+    if (it == stateValues.end())
     {
         throw std::out_of_range("new state not found in json");
     }
-    return newState;
+    return it->second;
 }
 
 size_t getEffecterDataSize(uint8_t effecterDataSize)
@@ -466,25 +613,50 @@ size_t getEffecterDataSize(uint8_t effecterDataSize)
     }
 }
 
-int HostEffecterParser::setTerminusNumericEffecter(
-    size_t effecterInfoIndex, uint16_t effecterId, uint8_t dataSize,
-    double rawValue)
+/** @brief Write a raw effecter value in its data size, little endian as
+ *         encode_set_numeric_effecter_value_req does
+ *
+ *  @param[in] dataSize - effecter data size, PLDM_EFFECTER_DATA_SIZE_*
+ *  @param[in] rawValue - raw value
+ *  @param[out] bytes - value bytes of the request
+ */
+static void encodeEffecterValue(uint8_t dataSize, double rawValue,
+                                std::span<uint8_t> bytes)
 {
-    std::string terminusName = hostEffecterInfo[effecterInfoIndex].terminusName;
-    uint8_t& mctpEid = hostEffecterInfo[effecterInfoIndex].mctpEid;
-    if (!terminusName.empty())
+    uint32_t bits = 0;
+    switch (dataSize)
     {
-        auto tmpEid = platformManager->getActiveEidByName(terminusName);
-        if (tmpEid)
-        {
-            mctpEid = tmpEid.value();
-        }
+        case PLDM_EFFECTER_DATA_SIZE_UINT8:
+            bits = static_cast<uint8_t>(rawValue);
+            break;
+        case PLDM_EFFECTER_DATA_SIZE_SINT8:
+            bits = static_cast<uint8_t>(static_cast<int8_t>(rawValue));
+            break;
+        case PLDM_EFFECTER_DATA_SIZE_UINT16:
+            bits = static_cast<uint16_t>(rawValue);
+            break;
+        case PLDM_EFFECTER_DATA_SIZE_SINT16:
+            bits = static_cast<uint16_t>(static_cast<int16_t>(rawValue));
+            break;
+        case PLDM_EFFECTER_DATA_SIZE_UINT32:
+            bits = static_cast<uint32_t>(rawValue);
+            break;
+        case PLDM_EFFECTER_DATA_SIZE_SINT32:
+            bits = static_cast<uint32_t>(static_cast<int32_t>(rawValue));
+            break;
+        default:
+            break;
     }
+    for (size_t i = 0; i < bytes.size(); i++)
+    {
+        bytes[i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+}
 
-    auto instanceId = instanceIdDb->next(mctpEid);
-    int rc = PLDM_ERROR;
-    std::vector<uint8_t> requestMsg;
-
+int HostEffecterParser::encodeNumericEffecterRequest(
+    uint8_t instanceId, uint16_t effecterId, uint8_t dataSize, double rawValue,
+    RequestMsg& requestMsg)
+{
     /**
      * PLDM_SET_NUMERIC_EFFECTER_VALUE_MIN_REQ_BYTES = 4. It includes the 1 byte
      * value for effecterValue as `Table 48 - SetNumericEffecterValue command
@@ -492,70 +664,59 @@ int HostEffecterParser::setTerminusNumericEffecter(
      * request message will be payload_length =
      * PLDM_SET_NUMERIC_EFFECTER_VALUE_MIN_REQ_BYTES - 1 + sizeof(dataType)
      */
-    size_t payload_length = PLDM_SET_NUMERIC_EFFECTER_VALUE_MIN_REQ_BYTES - 1 +
-                            getEffecterDataSize(dataSize);
-    requestMsg.resize(sizeof(pldm_msg_hdr) + payload_length);
-    auto request = new (requestMsg.data()) pldm_msg;
-    switch (dataSize)
+    auto valueSize = getEffecterDataSize(dataSize);
+    size_t payload_length =
+        PLDM_SET_NUMERIC_EFFECTER_VALUE_MIN_REQ_BYTES - 1 + valueSize;
+    auto encoded = numericEffecterRequests.find({effecterId, dataSize});
+    if (encoded == numericEffecterRequests.end())
     {
-        case PLDM_EFFECTER_DATA_SIZE_UINT8:
+        if (!valueSize)
         {
-            auto value_uint8 = (uint8_t)rawValue;
-            rc = encode_set_numeric_effecter_value_req(
-                instanceId, effecterId, dataSize,
-                reinterpret_cast<uint8_t*>(&value_uint8), request,
-                payload_length);
-            break;
-        }
-        case PLDM_EFFECTER_DATA_SIZE_SINT8:
-        {
-            auto value_int8 = (int8_t)rawValue;
-            rc = encode_set_numeric_effecter_value_req(
-                instanceId, effecterId, dataSize,
-                reinterpret_cast<uint8_t*>(&value_int8), request,
-                payload_length);
-            break;
+            return PLDM_ERROR_INVALID_DATA;
         }
-        case PLDM_EFFECTER_DATA_SIZE_UINT16:
-        {
-            auto value_uint16 = (uint16_t)rawValue;
-            rc = encode_set_numeric_effecter_value_req(
-                instanceId, effecterId, dataSize,
-                reinterpret_cast<uint8_t*>(&value_uint16), request,
-                payload_length);
-            break;
-        }
-        case PLDM_EFFECTER_DATA_SIZE_SINT16:
-        {
-            auto value_int16 = (int16_t)rawValue;
-            rc = encode_set_numeric_effecter_value_req(
-                instanceId, effecterId, dataSize,
-                reinterpret_cast<uint8_t*>(&value_int16), request,
-                payload_length);
-            break;
-        }
-        case PLDM_EFFECTER_DATA_SIZE_UINT32:
+        RequestMsg templateMsg(sizeof(pldm_msg_hdr) + payload_length);
+        uint32_t zero = 0;
+        auto rc = encode_set_numeric_effecter_value_req(
+            0, effecterId, dataSize, reinterpret_cast<uint8_t*>(&zero),
+            templateMsg.msg(), payload_length);
+        if (rc)
         {
-            auto value_uint32 = (uint32_t)rawValue;
-            rc = encode_set_numeric_effecter_value_req(
-                instanceId, effecterId, dataSize,
-                reinterpret_cast<uint8_t*>(&value_uint32), request,
-                payload_length);
-            break;
+            return rc;
         }
-        case PLDM_EFFECTER_DATA_SIZE_SINT32:
+        encoded = numericEffecterRequests
+                      .emplace(std::make_pair(effecterId, dataSize),
+                               std::move(templateMsg))
+                      .first;
+    }
+
+    requestMsg = encoded->second;
+    requestMsg.msg()->hdr.instance_id = instanceId;
+    encodeEffecterValue(
+        dataSize, rawValue,
+        std::span(requestMsg.msg()->payload + payload_length - valueSize,
+                  valueSize));
+    return PLDM_SUCCESS;
+}
+
+int HostEffecterParser::setTerminusNumericEffecter(
+    size_t effecterInfoIndex, uint16_t effecterId, uint8_t dataSize,
+    double rawValue)
+{
+    std::string terminusName = hostEffecterInfo[effecterInfoIndex].terminusName;
+    uint8_t& mctpEid = hostEffecterInfo[effecterInfoIndex].mctpEid;
+    if (!terminusName.empty())
+    {
+        auto tmpEid = platformManager->getActiveEidByName(terminusName);
+        if (tmpEid)
         {
-            auto value_int32 = (int32_t)rawValue;
-            rc = encode_set_numeric_effecter_value_req(
-                instanceId, effecterId, dataSize,
-                reinterpret_cast<uint8_t*>(&value_int32), request,
-                payload_length);
-            break;
+            mctpEid = tmpEid.value();
         }
-        default:
-            break;
     }
 
+    auto instanceId = instanceIdDb->next(mctpEid);
+    RequestMsg requestMsg;
+    auto rc = encodeNumericEffecterRequest(instanceId, effecterId, dataSize,
+                                           rawValue, requestMsg);
     if (rc)
     {
         error(
@@ -622,11 +783,10 @@ int HostEffecterParser::setHostStateEffecter(
     uint8_t& compEffCnt = hostEffecterInfo[effecterInfoIndex].compEffecterCnt;
     auto instanceId = instanceIdDb->next(mctpEid);
 
-    std::vector<uint8_t> requestMsg(
+    RequestMsg requestMsg(
         sizeof(pldm_msg_hdr) + sizeof(effecterId) + sizeof(compEffCnt) +
-            sizeof(set_effecter_state_field) * compEffCnt,
-        0);
-    auto request = new (requestMsg.data()) pldm_msg;
+            sizeof(set_effecter_state_field) * compEffCnt);
+    auto request = requestMsg.msg();
     auto rc = encode_set_state_effecter_states_req(
         instanceId, effecterId, compEffCnt, stateField.data(), request);
 
@@ -686,18 +846,76 @@ void HostEffecterParser::createHostEffecterMatch(
     const std::string& objectPath, const std::string& interface,
     size_t effecterInfoIndex, size_t dbusInfoIndex, uint16_t effecterId)
 {
+    effecterDispatch[objectPath].emplace_back(
+        interface, effecterInfoIndex, dbusInfoIndex, effecterId);
+}
+
+void HostEffecterParser::createEffecterMatches()
+{
+    /* Deepest path namespace holding all the objects of each interface */
+    std::map<std::string, std::string> pathNamespaces;
+    for (const auto& [objectPath, entries] : effecterDispatch)
+    {
+        for (const auto& entry : entries)
+        {
+            pldm::utils::widenPathNamespace(pathNamespaces[entry.interface],
+                                            objectPath);
+        }
+    }
+
     using namespace sdbusplus::bus::match::rules;
-    effecterInfoMatch.emplace_back(std::make_unique<sdbusplus::bus::match_t>(
-        pldm::utils::DBusHandler::getBus(),
-        propertiesChanged(objectPath, interface),
-        [this, effecterInfoIndex, dbusInfoIndex,
-         effecterId](sdbusplus::message_t& msg) {
-            DbusChgHostEffecterProps props;
-            std::string iface;
-            msg.read(iface, props);
-            processHostEffecterChangeNotification(props, effecterInfoIndex,
-                                                  dbusInfoIndex, effecterId);
-        }));
+    for (const auto& [iface, pathNamespace] : pathNamespaces)
+    {
+        effecterInfoMatch.emplace_back(
+            std::make_unique<sdbusplus::bus::match_t>(
+                pldm::utils::DBusHandler::getBus(),
+                type::signal() + member("PropertiesChanged") +
+                    path_namespace(pathNamespace) +
+                    interface(pldm::utils::dbusProperties) + argN(0, iface),
+                std::bind_front(&HostEffecterParser::processPropertiesChanged,
+                                this)));
+    }
+
+    if (!effecterDispatch.empty())
+    {
+        hostStateMatch = std::make_unique<sdbusplus::bus::match_t>(
+            pldm::utils::DBusHandler::getBus(),
+            propertiesChanged(hostStatePath, BootProgress::interface),
+            std::bind_front(&HostEffecterParser::processHostStateChanged,
+                            this));
+    }
+}
+
+void HostEffecterParser::processPropertiesChanged(sdbusplus::message_t& msg)
+{
+    auto it = effecterDispatch.find(msg.get_path());
+    if (it == effecterDispatch.end())
+    {
+        return;
+    }
+
+    DbusChgHostEffecterProps props;
+    std::string iface;
+    try
+    {
+        msg.read(iface, props);
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        error(
+            "Failed to read the PropertiesChanged signal of '{PATH}', error - {ERROR}",
+            "PATH", msg.get_path(), "ERROR", e);
+        return;
+    }
+    for (const auto& entry : it->second)
+    {
+        if (entry.interface == iface)
+        {
+            processHostEffecterChangeNotification(
+                props, entry.effecterInfoIndex, entry.dbusInfoIndex,
+                entry.effecterId);
+        }
+    }
 }
 
 } // namespace host_effecters
@@ -7,9 +7,19 @@
 #include "requester/handler.hpp"
 
 #include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/timer.hpp>
 
+#include <chrono>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <variant>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -33,6 +43,40 @@ struct PossibleState
     std::vector<uint8_t> states; //!< Possible states
 };
 
+/** @struct PropertyValueHash
+ *  Hash of a D-Bus property value, of the type held and its value
+ */
+struct PropertyValueHash
+{
+    size_t operator()(const pldm::utils::PropertyValue& value) const
+    {
+        auto hash = std::visit(
+            [](const auto& v) -> size_t {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<T, std::vector<uint8_t>>)
+                {
+                    return std::hash<std::string_view>{}(std::string_view(
+                        reinterpret_cast<const char*>(v.data()), v.size()));
+                }
+                else if constexpr (std::is_same_v<T, std::vector<std::string>>)
+                {
+                    size_t h = v.size();
+                    for (const auto& str : v)
+                    {
+                        h = h * 31 + std::hash<std::string>{}(str);
+                    }
+                    return h;
+                }
+                else
+                {
+                    return std::hash<T>{}(v);
+                }
+            },
+            value);
+        return hash ^ value.index();
+    }
+};
+
 /** @struct DBusEffecterMapping
  *  Contains the D-Bus information for an effecter
  */
@@ -42,6 +86,8 @@ struct DBusEffecterMapping
     std::vector<pldm::utils::PropertyValue>
         propertyValues;  //!< D-Bus property values
     PossibleState state; //!< Corresponding effecter states
+    std::unordered_map<pldm::utils::PropertyValue, uint8_t, PropertyValueHash>
+        stateValues;     //!< Effecter state of each D-Bus property value
 };
 
 /** @struct DBusEffecterMapping
@@ -55,6 +101,7 @@ struct DBusNumericEffecterMapping
     double offset;        //!< Numeric effecter PDR offset
     int8_t unitModifier;  //!< Numeric effecter PDR unitModifier
     double propertyValue; //!< D-Bus property values
+    double unitDivisor;   //!< 10 to the power of unitModifier
 };
 
 /** @struct EffecterInfo
@@ -76,6 +123,32 @@ struct EffecterInfo
         dbusNumericEffecterInfo; //!< D-Bus information for the effecter id
 };
 
+/** @struct EffecterMatchEntry
+ *  An effecter monitoring the D-Bus properties of an object
+ */
+struct EffecterMatchEntry
+{
+    std::string interface;    //!< D-Bus interface of the properties
+    size_t effecterInfoIndex; //!< index of effecterInfo in hostEffecterInfo
+    size_t dbusInfoIndex;     //!< index of dbusInfo within effecterInfo
+    uint16_t effecterId;      //!< host effecter id
+};
+
+/** @struct EffecterWrite
+ *  The write pending for an effecter while the minimum interval between two
+ *  set requests to it has not elapsed. A newer write supersedes the pending
+ *  one, the states of a composite state effecter are merged.
+ */
+struct EffecterWrite
+{
+    std::vector<set_effecter_state_field> stateField; //!< Pending states
+    std::optional<double> rawValue; //!< Pending numeric effecter raw value
+    double value;                   //!< D-Bus value of rawValue
+    size_t dbusInfoIndex;           //!< dbusNumericEffecterInfo of rawValue
+    std::chrono::steady_clock::time_point lastSent; //!< Last set request
+    std::unique_ptr<sdbusplus::Timer> timer; //!< Sends the pending write
+};
+
 /** @class HostEffecterParser
  *
  *  @brief This class parses the Host Effecter json file and monitors for the
@@ -204,7 +277,8 @@ class HostEffecterParser
                               const pldm::utils::PropertyValue& propertyValue);
 
     /* @brief Subscribes for D-Bus property change signal on the specified
-     *        object
+     *        object. The signals are received by one match per interface
+     *        created once the json is parsed and dispatched by object path.
      *
      * @param[in] objectPath - D-Bus object path to look for
      * @param[in] interface - D-Bus interface
@@ -230,14 +304,99 @@ class HostEffecterParser
     double adjustValue(double value, double offset, double resolution,
                        int8_t modify);
 
+    /* @brief Queue a write of state effecter states. It is sent at once
+     *        unless the effecter was set less than effecterWriteInterval
+     *        ago, the states are then merged into the pending write.
+     *
+     * @param[in] effecterInfoIndex - index of effecterInfo pointer in
+     *                                hostEffecterInfo
+     * @param[in] stateField - state fields of the composite effecter
+     * @param[in] effecterId - host effecter id
+     */
+    void queueStateEffecterWrite(
+        size_t effecterInfoIndex,
+        const std::vector<set_effecter_state_field>& stateField,
+        uint16_t effecterId);
+
+    /* @brief Queue a write of a numeric effecter value. It is sent at once
+     *        unless the effecter was set less than effecterWriteInterval
+     *        ago, it then supersedes the pending write.
+     *
+     * @param[in] effecterInfoIndex - index of effecterInfo pointer in
+     *                                hostEffecterInfo
+     * @param[in] dbusInfoIndex - index of dbusNumericEffecterInfo
+     * @param[in] effecterId - terminus numeric effecter id
+     * @param[in] value - D-Bus value
+     * @param[in] rawValue - raw value
+     */
+    void queueNumericEffecterWrite(size_t effecterInfoIndex,
+                                   size_t dbusInfoIndex, uint16_t effecterId,
+                                   double value, double rawValue);
+
   private:
-    /* @brief Verify host On state before configure the host effecters
+    /* @brief Verify host On state before configure the host effecters. The
+     *        state is read from D-Bus once, then kept up to date by the
+     *        BootProgress PropertiesChanged signals.
      *
      * @return - true if host is on and false for others cases
      */
     bool isHostOn(void);
 
+    /* @brief Track the host state from its BootProgress PropertiesChanged
+     *        signals, sending the writes held while the host was off once
+     *        it is on
+     *
+     * @param[in] msg - PropertiesChanged signal
+     */
+    void processHostStateChanged(sdbusplus::message_t& msg);
+
+    /* @brief Create one PropertiesChanged match per monitored interface,
+     *        restricted to the deepest path namespace holding all the
+     *        monitored objects of it
+     */
+    void createEffecterMatches();
+
+    /* @brief Dispatch a PropertiesChanged signal to the effecters monitoring
+     *        the object it was sent from
+     *
+     * @param[in] msg - PropertiesChanged signal
+     */
+    void processPropertiesChanged(sdbusplus::message_t& msg);
+
+    /* @brief Send the pending write of an effecter now, or once
+     *        effecterWriteInterval elapsed since the last one. The writes
+     *        needing the host are held while it is off.
+     *
+     * @param[in] effecterInfoIndex - index of effecterInfo pointer in
+     *                                hostEffecterInfo
+     * @param[in] effecterId - host effecter id
+     */
+    void scheduleEffecterWrite(size_t effecterInfoIndex, uint16_t effecterId);
+
+    /* @brief Send the pending write of an effecter
+     *
+     * @param[in] effecterInfoIndex - index of effecterInfo pointer in
+     *                                hostEffecterInfo
+     * @param[in] effecterId - host effecter id
+     */
+    void sendEffecterWrite(size_t effecterInfoIndex, uint16_t effecterId);
+
   protected:
+    /* @brief Encode a SetNumericEffecterValue request, from the request
+     *        encoded once per effecter id and data size with only the
+     *        instance ID and the value patched
+     *
+     * @param[in] instanceId - instance ID of the request
+     * @param[in] effecterId - host effecter id
+     * @param[in] dataSize - data size
+     * @param[in] rawValue - raw value
+     * @param[out] requestMsg - the request
+     * @return - PLDM status code
+     */
+    int encodeNumericEffecterRequest(uint8_t instanceId, uint16_t effecterId,
+                                     uint8_t dataSize, double rawValue,
+                                     RequestMsg& requestMsg);
+
     pldm::InstanceIdDb* instanceIdDb; //!< Reference to the InstanceIdDb object
                                       //!< to obtain instance id
     int sockFd;                       //!< Socket fd to send message to host
@@ -246,12 +405,37 @@ class HostEffecterParser
     std::vector<std::unique_ptr<sdbusplus::bus::match_t>>
         effecterInfoMatch; //!< vector to catch the D-Bus property change
                            //!< signals for the effecters
+    std::unordered_map<std::string, std::vector<EffecterMatchEntry>>
+        effecterDispatch; //!< effecters monitoring each D-Bus object path
     const pldm::utils::DBusHandler* dbusHandler; //!< D-bus Handler
     /** @brief PLDM request handler */
     pldm::requester::Handler<pldm::requester::Request>* handler;
 
     /** @brief MC Platform manager*/
     platform_mc::Manager* platformManager = nullptr;
+
+    /** @brief Minimum interval between two set requests to an effecter */
+    const std::chrono::milliseconds effecterWriteInterval{
+        EFFECTER_WRITE_MIN_INTERVAL};
+
+    /** @brief Writes of the effecters, keyed by the effecterInfo index and
+     *         the effecter id
+     */
+    std::map<std::pair<size_t, uint16_t>, EffecterWrite> effecterWrites;
+
+    /** @brief SetNumericEffecterValue requests encoded once per effecter id
+     *         and data size, each write patches the instance ID and value
+     */
+    std::map<std::pair<uint16_t, uint8_t>, RequestMsg> numericEffecterRequests;
+
+    /** @brief Host state, std::nullopt until read from D-Bus */
+    std::optional<bool> hostOn;
+
+    /** @brief Keeps hostOn up to date */
+    std::unique_ptr<sdbusplus::bus::match_t> hostStateMatch;
+
+    /** @brief Writes of effecterWrites held until the host is on */
+    std::set<std::pair<size_t, uint16_t>> heldEffecterWrites;
 };
 
 } // namespace host_effecters
@@ -1,7 +1,9 @@
 #include "event_manager.hpp"
 
+#include "common/event_log_limiter.hpp"
 #include "terminus_manager.hpp"
 
+#include <fcntl.h>
 #include <libpldm/platform.h>
 #include <libpldm/utils.h>
 
@@ -9,7 +11,11 @@
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
 #include <cerrno>
+#include <chrono>
+#include <cstring>
 #include <memory>
+#include <optional>
+#include <tuple>
 
 PHOSPHOR_LOG2_USING;
 
@@ -19,6 +25,43 @@ namespace platform_mc
 {
 namespace fs = std::filesystem;
 
+const std::array<EventManager::ClassHandler, UINT8_MAX + 1>
+    EventManager::classHandlers = [] {
+        std::array<ClassHandler, UINT8_MAX + 1> handlers{};
+        /* EventClass sensorEvent `Table 11 - PLDM Event Types` DSP0248 */
+        handlers[PLDM_SENSOR_EVENT] = [](EventManager& self, pldm_tid_t tid,
+                                         uint16_t, const uint8_t* eventData,
+                                         size_t eventDataSize) {
+            return self.processSensorEvent(tid, eventData, eventDataSize);
+        };
+        /* EventClass CPEREvent as `Table 11 - PLDM Event Types` DSP0248
+         * V1.3.0 */
+        handlers[PLDM_CPER_EVENT] = [](EventManager& self, pldm_tid_t tid,
+                                       uint16_t eventId,
+                                       const uint8_t* eventData,
+                                       size_t eventDataSize) {
+            return self.processCperEvent(tid, eventId, eventData,
+                                         eventDataSize);
+        };
+        /* EventClass pldmPDRRepositoryChgEvent `Table 11 - PLDM Event
+         * Types` DSP0248 */
+        handlers[PLDM_PDR_REPOSITORY_CHG_EVENT] =
+            [](EventManager& self, pldm_tid_t tid, uint16_t,
+               const uint8_t* eventData, size_t eventDataSize) {
+                return self.processPdrRepositoryChgEvent(tid, eventData,
+                                                         eventDataSize);
+            };
+        /* EventClass pldmMessagePollEvent `Table 11 - PLDM Event Types`
+         * DSP0248 */
+        handlers[PLDM_MESSAGE_POLL_EVENT] =
+            [](EventManager& self, pldm_tid_t tid, uint16_t,
+               const uint8_t* eventData, size_t eventDataSize) {
+                return self.processMessagePollEvent(tid, eventData,
+                                                    eventDataSize);
+            };
+        return handlers;
+    }();
+
 int EventManager::handlePlatformEvent(
     pldm_tid_t tid, uint16_t eventId, uint8_t eventClass,
     const uint8_t* eventData, size_t eventDataSize)
@@ -31,79 +74,182 @@ int EventManager::handlePlatformEvent(
         return PLDM_ERROR;
     }
 
-    /* EventClass sensorEvent `Table 11 - PLDM Event Types` DSP0248 */
-    if (eventClass == PLDM_SENSOR_EVENT)
+    auto handler = classHandlers[eventClass];
+    if (!handler)
     {
-        uint16_t sensorId = 0;
-        uint8_t sensorEventClassType = 0;
-        size_t eventClassDataOffset = 0;
-        auto rc = decode_sensor_event_data(eventData, eventDataSize, &sensorId,
-                                           &sensorEventClassType,
-                                           &eventClassDataOffset);
-        if (rc)
-        {
-            lg2::error(
-                "Failed to decode sensor event data from terminus ID {TID}, event class {CLASS}, event ID {EVENTID} with return code {RC}.",
-                "TID", tid, "CLASS", eventClass, "EVENTID", eventId, "RC", rc);
-            return rc;
-        }
-        switch (sensorEventClassType)
+        lg2::info(
+            "Unsupported class type {CLASSTYPE} of the event {EVENTID} from terminus ID {TID}",
+            "CLASSTYPE", eventClass, "EVENTID", eventId, "TID", tid);
+        return PLDM_ERROR;
+    }
+    return handler(*this, tid, eventId, eventData, eventDataSize);
+}
+
+int EventManager::processSensorEvent(pldm_tid_t tid, const uint8_t* eventData,
+                                     size_t eventDataSize)
+{
+    uint16_t sensorId = 0;
+    uint8_t sensorEventClassType = 0;
+    size_t eventClassDataOffset = 0;
+    auto rc = decode_sensor_event_data(eventData, eventDataSize, &sensorId,
+                                       &sensorEventClassType,
+                                       &eventClassDataOffset);
+    if (rc)
+    {
+        lg2::error(
+            "Failed to decode sensor event data from terminus ID {TID}, event class {CLASS} with return code {RC}.",
+            "TID", tid, "CLASS", PLDM_SENSOR_EVENT, "RC", rc);
+        return rc;
+    }
+    switch (sensorEventClassType)
+    {
+        case PLDM_NUMERIC_SENSOR_STATE:
         {
-            case PLDM_NUMERIC_SENSOR_STATE:
-            {
-                const uint8_t* sensorData = eventData + eventClassDataOffset;
-                size_t sensorDataLength = eventDataSize - eventClassDataOffset;
-                return processNumericSensorEvent(tid, sensorId, sensorData,
-                                                 sensorDataLength);
-            }
-            case PLDM_STATE_SENSOR_STATE:
-            case PLDM_SENSOR_OP_STATE:
-            default:
-                lg2::info(
-                    "Unsupported class type {CLASSTYPE} for the sensor event from terminus ID {TID} sensorId {SID}",
-                    "CLASSTYPE", sensorEventClassType, "TID", tid, "SID",
-                    sensorId);
-                return PLDM_ERROR;
+            const uint8_t* sensorData = eventData + eventClassDataOffset;
+            size_t sensorDataLength = eventDataSize - eventClassDataOffset;
+            return processNumericSensorEvent(tid, sensorId, sensorData,
+                                             sensorDataLength);
         }
+        case PLDM_STATE_SENSOR_STATE:
+        case PLDM_SENSOR_OP_STATE:
+        default:
+            lg2::info(
+                "Unsupported class type {CLASSTYPE} for the sensor event from terminus ID {TID} sensorId {SID}",
+                "CLASSTYPE", sensorEventClassType, "TID", tid, "SID",
+                sensorId);
+            return PLDM_ERROR;
     }
+}
 
-    /* EventClass CPEREvent as `Table 11 - PLDM Event Types` DSP0248 V1.3.0 */
-    if (eventClass == PLDM_CPER_EVENT)
+int EventManager::processMessagePollEvent(
+    pldm_tid_t tid, const uint8_t* eventData, size_t eventDataSize)
+{
+    lg2::info("Received pldmMessagePollEvent for terminus {TID}", "TID", tid);
+    pldm_message_poll_event poll_event{};
+    auto rc = decode_pldm_message_poll_event_data(eventData, eventDataSize,
+                                                  &poll_event);
+    if (rc)
     {
-        return processCperEvent(tid, eventId, eventData, eventDataSize);
+        lg2::error("Failed to decode PldmMessagePollEvent event, error {RC} ",
+                   "RC", rc);
+        return rc;
     }
 
-    /* EventClass pldmMessagePollEvent `Table 11 - PLDM Event Types` DSP0248 */
-    if (eventClass == PLDM_MESSAGE_POLL_EVENT)
+    auto it = termini.find(tid);
+    if (it != termini.end())
     {
-        lg2::info("Received pldmMessagePollEvent for terminus {TID}", "TID",
-                  tid);
-        pldm_message_poll_event poll_event{};
-        auto rc = decode_pldm_message_poll_event_data(eventData, eventDataSize,
-                                                      &poll_event);
-        if (rc)
-        {
-            lg2::error(
-                "Failed to decode PldmMessagePollEvent event, error {RC} ",
-                "RC", rc);
-            return rc;
-        }
+        auto& terminus = it->second; // Reference for clarity
+        terminus->pollEvent = true;
+        terminus->pollEventId = poll_event.event_id;
+        terminus->pollDataTransferHandle = poll_event.data_transfer_handle;
+    }
 
-        auto it = termini.find(tid);
-        if (it != termini.end())
+    return PLDM_SUCCESS;
+}
+
+int EventManager::processPdrRepositoryChgEvent(
+    pldm_tid_t tid, const uint8_t* eventData, size_t eventDataSize)
+{
+    uint8_t eventDataFormat = 0;
+    uint8_t numberOfChangeRecords = 0;
+    size_t dataOffset = 0;
+    auto rc = decode_pldm_pdr_repository_chg_event_data(
+        eventData, eventDataSize, &eventDataFormat, &numberOfChangeRecords,
+        &dataOffset);
+    if (rc)
+    {
+        lg2::error(
+            "Failed to decode pldmPDRRepositoryChgEvent from terminus ID {TID}, error {RC}.",
+            "TID", tid, "RC", rc);
+        return rc;
+    }
+
+    PdrRepositoryChanges changes{};
+    /* PDR types can not be mapped to records without fetching the whole
+     * repository, refresh it */
+    if (eventDataFormat != FORMAT_IS_PDR_HANDLES)
+    {
+        changes.refreshAll = true;
+    }
+    else
+    {
+        auto changeRecordData = eventData + dataOffset;
+        auto changeRecordDataSize = eventDataSize - dataOffset;
+        for (uint8_t i = 0; i < numberOfChangeRecords; i++)
         {
-            auto& terminus = it->second; // Reference for clarity
-            terminus->pollEvent = true;
-            terminus->pollEventId = poll_event.event_id;
-            terminus->pollDataTransferHandle = poll_event.data_transfer_handle;
-        }
+            uint8_t eventDataOperation = 0;
+            uint8_t numberOfChangeEntries = 0;
+            rc = decode_pldm_pdr_repository_change_record_data(
+                changeRecordData, changeRecordDataSize, &eventDataOperation,
+                &numberOfChangeEntries, &dataOffset);
+            if (rc)
+            {
+                lg2::error(
+                    "Failed to decode change record {INDEX} of pldmPDRRepositoryChgEvent from terminus ID {TID}, error {RC}.",
+                    "INDEX", i, "TID", tid, "RC", rc);
+                return rc;
+            }
 
-        return PLDM_SUCCESS;
+            size_t recordSize =
+                dataOffset + numberOfChangeEntries * sizeof(RecordHandle);
+            if (changeRecordDataSize < recordSize)
+            {
+                lg2::error(
+                    "Truncated change record {INDEX} of pldmPDRRepositoryChgEvent from terminus ID {TID}.",
+                    "INDEX", i, "TID", tid);
+                return PLDM_ERROR_INVALID_LENGTH;
+            }
+
+            /* Later change records override the earlier ones */
+            PdrRepositoryChanges recordChanges{};
+            for (uint8_t entry = 0; entry < numberOfChangeEntries; entry++)
+            {
+                RecordHandle handle = 0;
+                memcpy(&handle,
+                       changeRecordData + dataOffset + entry * sizeof(handle),
+                       sizeof(handle));
+                handle = le32toh(handle);
+                if (eventDataOperation == PLDM_RECORDS_DELETED)
+                {
+                    recordChanges.deletedRecords.insert(handle);
+                }
+                else
+                {
+                    recordChanges.changedRecords.insert(handle);
+                }
+            }
+            if (eventDataOperation != PLDM_RECORDS_DELETED &&
+                eventDataOperation != PLDM_RECORDS_ADDED &&
+                eventDataOperation != PLDM_RECORDS_MODIFIED)
+            {
+                recordChanges.refreshAll = true;
+            }
+            changes.merge(recordChanges);
+
+            changeRecordData += recordSize;
+            changeRecordDataSize -= recordSize;
+        }
     }
 
-    lg2::info("Unsupported class type {CLASSTYPE}", "CLASSTYPE", eventClass);
+    lg2::info(
+        "Received pldmPDRRepositoryChgEvent from terminus ID {TID}: refresh {REFRESH}, {CHANGED} changed and {DELETED} deleted records.",
+        "TID", tid, "REFRESH", changes.refreshAll, "CHANGED",
+        changes.changedRecords.size(), "DELETED",
+        changes.deletedRecords.size());
+
+    /* Looked up rather than indexed, indexing would add an empty terminus
+     * for a TID platform-mc does not manage */
+    auto it = termini.find(tid);
+    if (it == termini.end() || !it->second)
+    {
+        lg2::error(
+            "Terminus ID {TID} of the pldmPDRRepositoryChgEvent is not in the managing list.",
+            "TID", tid);
+        return PLDM_ERROR;
+    }
+    it->second->pdrChanges.merge(changes);
 
-    return PLDM_ERROR;
+    return PLDM_SUCCESS;
 }
 
 int EventManager::processNumericSensorEvent(pldm_tid_t tid, uint16_t sensorId,
@@ -126,10 +272,24 @@ int EventManager::processNumericSensorEvent(pldm_tid_t tid, uint16_t sensorId,
     }
 
     double value = static_cast<double>(presentReading);
-    lg2::error(
-        "processNumericSensorEvent tid {TID}, sensorID {SID} value {VAL} previousState {PSTATE} eventState {ESTATE}",
-        "TID", tid, "SID", sensorId, "VAL", value, "PSTATE", previousEventState,
-        "ESTATE", eventState);
+    if (pldm::utils::EventLogLimiter::getInstance().admit(
+            {pldm::utils::EventLogSource::NumericSensorEvent, tid, sensorId,
+             eventState},
+            [tid, sensorId, eventState]() {
+                return [tid, sensorId, eventState](
+                           uint64_t suppressed, std::chrono::seconds interval) {
+                    lg2::error(
+                        "processNumericSensorEvent tid {TID}, sensorID {SID} eventState {ESTATE} repeated {COUNT} more times in {INTERVAL}s",
+                        "TID", tid, "SID", sensorId, "ESTATE", eventState,
+                        "COUNT", suppressed, "INTERVAL", interval.count());
+                };
+            }))
+    {
+        lg2::error(
+            "processNumericSensorEvent tid {TID}, sensorID {SID} value {VAL} previousState {PSTATE} eventState {ESTATE}",
+            "TID", tid, "SID", sensorId, "VAL", value, "PSTATE",
+            previousEventState, "ESTATE", eventState);
+    }
 
     if (!termini.contains(tid) || !termini[tid])
     {
@@ -149,6 +309,33 @@ int EventManager::processNumericSensorEvent(pldm_tid_t tid, uint16_t sensorId,
         return PLDM_ERROR;
     }
 
+    /* The reading of an asynchronous event stands for a poll of the
+     * sensor, the sensor manager only keeps polling it at the keep-alive
+     * rate */
+    if (terminus->asyncSensorEvents)
+    {
+        double reading = value;
+        switch (sensorDataSize)
+        {
+            case PLDM_SENSOR_DATA_SIZE_SINT8:
+            case PLDM_SENSOR_DATA_SIZE_SINT16:
+            case PLDM_SENSOR_DATA_SIZE_SINT32:
+                reading = static_cast<int32_t>(presentReading);
+                break;
+            default:
+                break;
+        }
+        sensor->eventDriven = true;
+        /* steady_clock is CLOCK_MONOTONIC, the clock of the poll queue */
+        sensor->timeStamp =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        sensor->updateReading(true, true, reading);
+        sensor->history.push(sensor->timeStamp, sensor->getValue());
+        sensor->emitPropertiesChanged();
+    }
+
     switch (previousEventState)
     {
         case PLDM_SENSOR_UNKNOWN:
@@ -358,25 +545,26 @@ int EventManager::processCperEvent(pldm_tid_t tid, uint16_t eventId,
             "EVENTID", eventId);
         return PLDM_ERROR;
     }
-    const size_t cperEventDataSize =
-        eventDataSize - PLDM_PLATFORM_CPER_EVENT_MIN_LENGTH;
-    const size_t msgDataLen =
-        sizeof(pldm_platform_cper_event) + cperEventDataSize;
-    std::string terminusName = "";
-    auto msgData = std::make_unique<unsigned char[]>(msgDataLen);
-    auto cperEvent = new (msgData.get()) pldm_platform_cper_event;
 
-    auto rc = decode_pldm_platform_cper_event(eventData, eventDataSize,
-                                              cperEvent, msgDataLen);
-
-    if (rc)
+    /* The CPER record is written to the dump file straight from the polled
+     * event data, formatVersion, formatType and a 16-bit eventDataLength are
+     * followed by the record */
+    const uint8_t formatType = eventData[1];
+    const uint16_t cperDataLength =
+        static_cast<uint16_t>(eventData[2] | (eventData[3] << 8));
+    const uint8_t* cperData = eventData + PLDM_PLATFORM_CPER_EVENT_MIN_LENGTH;
+    if ((formatType != PLDM_PLATFORM_CPER_EVENT_WITH_HEADER &&
+         formatType != PLDM_PLATFORM_CPER_EVENT_WITHOUT_HEADER) ||
+        cperDataLength >
+            eventDataSize - PLDM_PLATFORM_CPER_EVENT_MIN_LENGTH)
     {
         lg2::error(
-            "Failed to decode CPER event for eventId {EVENTID} of terminus ID {TID} error {RC}.",
-            "EVENTID", eventId, "TID", tid, "RC", rc);
-        return rc;
+            "Failed to decode CPER event for eventId {EVENTID} of terminus ID {TID}.",
+            "EVENTID", eventId, "TID", tid);
+        return PLDM_ERROR_INVALID_DATA;
     }
 
+    std::string terminusName = "";
     if (termini.contains(tid) && termini[tid])
     {
         auto tmp = termini[tid]->getTerminusName();
@@ -409,40 +597,68 @@ int EventManager::processCperEvent(pldm_tid_t tid, uint16_t eventId,
     }
 
     std::string fileName{dirName.string() + "/cper-XXXXXX"};
-    auto fd = mkstemp(fileName.data());
-    if (fd < 0)
     {
-        lg2::error("Failed to generate temp file, error {ERRORNO}", "ERRORNO",
-                   std::strerror(errno));
-        return PLDM_ERROR;
-    }
-    close(fd);
-
-    std::ofstream ofs;
-    ofs.exceptions(std::ofstream::failbit | std::ofstream::badbit |
-                   std::ofstream::eofbit);
+        pldm::utils::CustomFD fd(mkstemp(fileName.data()));
+        if (fd() < 0)
+        {
+            lg2::error("Failed to generate temp file, error {ERRORNO}",
+                       "ERRORNO", std::strerror(errno));
+            return PLDM_ERROR;
+        }
 
-    try
-    {
-        ofs.open(fileName);
-        ofs.write(reinterpret_cast<const char*>(
-                      pldm_platform_cper_event_event_data(cperEvent)),
-                  cperEvent->event_data_length);
-        if (cperEvent->format_type == PLDM_PLATFORM_CPER_EVENT_WITH_HEADER)
+        /* Size the file once instead of growing it on every write */
+        int err = 0;
+        if (cperDataLength)
         {
-            rc = createCperDumpEntry("CPER", fileName, terminusName);
+            err = posix_fallocate(fd(), 0, cperDataLength);
         }
-        else
+        size_t written = 0;
+        while (!err && written < cperDataLength)
+        {
+            auto ret =
+                write(fd(), cperData + written, cperDataLength - written);
+            if (ret < 0 && errno != EINTR)
+            {
+                err = errno;
+            }
+            else if (ret > 0)
+            {
+                written += ret;
+            }
+        }
+        if (err)
         {
-            rc = createCperDumpEntry("CPERSection", fileName, terminusName);
+            lg2::error("Failed to save CPER to '{FILENAME}', error - {ERROR}.",
+                       "FILENAME", fileName, "ERROR", std::strerror(err));
+            unlink(fileName.c_str());
+            return PLDM_ERROR;
         }
-        ofs.close();
     }
-    catch (const std::ofstream::failure& e)
+
+    /* The file is closed, the dump manager reads it complete */
+    auto rc = createCperDumpEntry(
+        formatType == PLDM_PLATFORM_CPER_EVENT_WITH_HEADER ? "CPER"
+                                                           : "CPERSection",
+        fileName, terminusName);
+
+    /* Every CPER record is kept, an error storm only logs one line per
+     * interval */
+    if (pldm::utils::EventLogLimiter::getInstance().admit(
+            {pldm::utils::EventLogSource::Cper, tid, 0, formatType},
+            [tid, terminusName]() {
+                return [tid, terminusName](uint64_t suppressed,
+                                           std::chrono::seconds interval) {
+                    lg2::info(
+                        "Saved {COUNT} more CPER events of terminus ID {TID} {NAME} in {INTERVAL}s",
+                        "COUNT", suppressed, "TID", tid, "NAME", terminusName,
+                        "INTERVAL", interval.count());
+                };
+            }))
     {
-        lg2::error("Failed to save CPER to '{FILENAME}', error - {ERROR}.",
-                   "FILENAME", fileName, "ERROR", e);
-        return PLDM_ERROR;
+        lg2::info(
+            "Saved CPER event {EVENTID} of terminus ID {TID} {NAME} to '{FILENAME}'",
+            "EVENTID", eventId, "TID", tid, "NAME", terminusName, "FILENAME",
+            fileName);
     }
     return rc;
 }
@@ -486,7 +702,8 @@ int EventManager::createCperDumpEntry(const std::string& dataType,
 }
 
 int EventManager::getNextPartParameters(
-    uint16_t eventId, std::vector<uint8_t> eventMessage, uint8_t transferFlag,
+    uint16_t eventId, const std::vector<uint8_t>& eventMessage,
+    uint8_t transferFlag,
     uint32_t eventDataIntegrityChecksum, uint32_t nextDataTransferHandle,
     uint8_t* transferOperationFlag, uint32_t* dataTransferHandle,
     uint32_t* eventIdToAcknowledge)
@@ -522,26 +739,24 @@ void EventManager::callPolledEventHandlers(pldm_tid_t tid, uint8_t eventClass,
                                            uint16_t eventId,
                                            std::vector<uint8_t>& eventMessage)
 {
-    try
+    const auto& handlers = eventHandlers[eventClass];
+    if (handlers.empty())
     {
-        const auto& handlers = eventHandlers.at(eventClass);
-        for (const auto& handler : handlers)
-        {
-            auto rc =
-                handler(tid, eventId, eventMessage.data(), eventMessage.size());
-            if (rc != PLDM_SUCCESS)
-            {
-                lg2::error(
-                    "Failed to handle platform event msg for terminus {TID}, event {EVENTID} return {RET}",
-                    "TID", tid, "EVENTID", eventId, "RET", rc);
-            }
-        }
+        lg2::error(
+            "No handler of the platform event msg for terminus {TID}, event {EVENTID} class {CLASS}",
+            "TID", tid, "EVENTID", eventId, "CLASS", eventClass);
+        return;
     }
-    catch (const std::out_of_range& e)
+    for (const auto& handler : handlers)
     {
-        lg2::error(
-            "Failed to handle platform event msg for terminus {TID}, event {EVENTID} error - {ERROR}",
-            "TID", tid, "EVENTID", eventId, "ERROR", e);
+        auto rc =
+            handler(tid, eventId, eventMessage.data(), eventMessage.size());
+        if (rc != PLDM_SUCCESS)
+        {
+            lg2::error(
+                "Failed to handle platform event msg for terminus {TID}, event {EVENTID} return {RET}",
+                "TID", tid, "EVENTID", eventId, "RET", rc);
+        }
     }
 }
 
@@ -558,9 +773,48 @@ exec::task<int> EventManager::pollForPlatformEventTask(
     uint16_t polledEventId = PLDM_PLATFORM_EVENT_ID_NONE;
     pldm_tid_t polledEventTid = 0;
     uint8_t polledEventClass = 0;
+    size_t drainedEvents = 0;
 
     std::vector<uint8_t> eventMessage{};
 
+    /* An acknowledged event, handled while the next poll is in flight */
+    std::optional<std::tuple<pldm_tid_t, uint8_t, uint16_t,
+                             std::vector<uint8_t>>>
+        acknowledgedEvent;
+    auto handleAcknowledgedEvent = [this, &acknowledgedEvent]() {
+        if (!acknowledgedEvent)
+        {
+            return;
+        }
+        auto& [eventTid, eventClass, ackedEventId, message] =
+            *acknowledgedEvent;
+        if (!eventHandlers[eventClass].empty())
+        {
+            callPolledEventHandlers(eventTid, eventClass, ackedEventId,
+                                    message);
+        }
+        acknowledgedEvent.reset();
+    };
+    auto recordDrain = [this, tid, &drainedEvents](bool budgetExhausted) {
+        if (!termini.contains(tid) || !termini[tid])
+        {
+            return;
+        }
+        auto& stats = termini[tid]->polledEventStats;
+        stats.events += drainedEvents;
+        stats.lastDrainDepth = drainedEvents;
+        if (budgetExhausted)
+        {
+            stats.budgetExhausted++;
+            /* Continue at the next polling tick */
+            termini[tid]->pollEvent = true;
+            termini[tid]->pollDataTransferHandle = 0;
+            lg2::info(
+                "Terminus ID {TID}: drained {COUNT} polled events, more are queued.",
+                "TID", tid, "COUNT", drainedEvents);
+        }
+    };
+
     // Reset and mark terminus as available
     updateAvailableState(tid, true);
 
@@ -579,22 +833,41 @@ exec::task<int> EventManager::pollForPlatformEventTask(
         /* Stop event polling */
         if (!getAvailableState(tid))
         {
+            handleAcknowledgedEvent();
             lg2::info(
                 "Terminus ID {TID} is not available for PLDM request from {NOW}.",
                 "TID", tid, "NOW", pldm::utils::getCurrentSystemTime());
             co_await stdexec::just_stopped();
         }
 
-        rc = co_await pollForPlatformEventMessage(
-            tid, formatVersion, transferOperationFlag, dataTransferHandle,
-            eventIdToAcknowledge, completionCode, eventTid, eventId,
-            nextDataTransferHandle, transferFlag, eventClass, eventDataSize,
-            eventData, eventDataIntegrityChecksum);
+        /* The request is sent when spawning, the acknowledged event is
+         * handled while waiting for the response */
+        std::optional<int> pollRc;
+        exec::async_scope pollScope;
+        pollScope.spawn(
+            stdexec::just() | stdexec::let_value([&] -> exec::task<void> {
+                pollRc = co_await pollForPlatformEventMessage(
+                    tid, formatVersion, transferOperationFlag,
+                    dataTransferHandle, eventIdToAcknowledge, completionCode,
+                    eventTid, eventId, nextDataTransferHandle, transferFlag,
+                    eventClass, eventDataSize, eventData,
+                    eventDataIntegrityChecksum);
+            }),
+            exec::default_task_context<void>(exec::inline_scheduler{}));
+        handleAcknowledgedEvent();
+        co_await pollScope.on_empty();
+        if (!pollRc)
+        {
+            co_await stdexec::just_stopped();
+        }
+
+        rc = *pollRc;
         if (rc || completionCode != PLDM_SUCCESS)
         {
             lg2::error(
                 "Failed to pollForPlatformEventMessage for terminus {TID}, event {EVENTID}, error {RC}, complete code {CC}",
                 "TID", tid, "EVENTID", eventId, "RC", rc, "CC", completionCode);
+            recordDrain(false);
             co_return rc;
         }
 
@@ -607,18 +880,24 @@ exec::task<int> EventManager::pollForPlatformEventTask(
         if (transferOperationFlag == PLDM_ACKNOWLEDGEMENT_ONLY)
         {
             /* Handle the polled event after finish ACK it */
-            if (eventHandlers.contains(polledEventClass))
-            {
-                callPolledEventHandlers(polledEventTid, polledEventClass,
-                                        polledEventId, eventMessage);
-            }
+            acknowledgedEvent.emplace(polledEventTid, polledEventClass,
+                                      polledEventId, std::move(eventMessage));
             eventMessage.clear();
+            drainedEvents++;
 
             if (eventId == PLDM_PLATFORM_EVENT_ID_ACK)
             {
                 transferOperationFlag = PLDM_GET_FIRSTPART;
                 dataTransferHandle = 0;
                 eventIdToAcknowledge = PLDM_PLATFORM_EVENT_ID_NULL;
+
+                /* Leave the rest of the queue to the next polling tick */
+                if (drainedEvents >= pollEventBudget)
+                {
+                    handleAcknowledgedEvent();
+                    recordDrain(true);
+                    co_return PLDM_SUCCESS;
+                }
             }
         }
         else
@@ -632,6 +911,7 @@ exec::task<int> EventManager::pollForPlatformEventTask(
                 lg2::error(
                     "Failed to process data of pollForPlatformEventMessage for terminus {TID}, event {EVENTID} return {RET}",
                     "TID", tid, "EVENTID", eventId, "RET", ret);
+                recordDrain(false);
                 co_return PLDM_ERROR_INVALID_DATA;
             }
 
@@ -646,6 +926,9 @@ exec::task<int> EventManager::pollForPlatformEventTask(
         }
     }
 
+    handleAcknowledgedEvent();
+    recordDrain(false);
+
     co_return PLDM_SUCCESS;
 }
 
@@ -657,9 +940,8 @@ exec::task<int> EventManager::pollForPlatformEventMessage(
     uint8_t& eventClass, uint32_t& eventDataSize, uint8_t*& eventData,
     uint32_t& eventDataIntegrityChecksum)
 {
-    Request request(
-        sizeof(pldm_msg_hdr) + PLDM_POLL_FOR_PLATFORM_EVENT_MESSAGE_REQ_BYTES);
-    auto requestMsg = new (request.data()) pldm_msg;
+    PldmMsg<PLDM_POLL_FOR_PLATFORM_EVENT_MESSAGE_REQ_BYTES> request;
+    auto requestMsg = request.msg();
     auto rc = encode_poll_for_platform_event_message_req(
         0, formatVersion, transferOperationFlag, dataTransferHandle,
         eventIdToAcknowledge, requestMsg, request.size());
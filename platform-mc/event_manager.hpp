@@ -10,17 +10,27 @@
 #include <libpldm/platform.h>
 #include <libpldm/pldm.h>
 
+#include <array>
+#include <cstdint>
+
 namespace pldm
 {
 namespace platform_mc
 {
 
 using EventType = uint8_t;
+
+/** @brief Handler of a polled event class, called with the decoded terminus
+ *         ID and event ID and with the class specific event data, which the
+ *         handler decodes in the format of its own class
+ */
 using HandlerFunc =
     std::function<int(pldm_tid_t tid, uint16_t eventId,
                       const uint8_t* eventData, size_t eventDataSize)>;
 using HandlerFuncs = std::vector<HandlerFunc>;
-using EventMap = std::map<EventType, HandlerFuncs>;
+
+/** @brief Handlers of the polled events, indexed by event class */
+using EventHandlerTable = std::array<HandlerFuncs, UINT8_MAX + 1>;
 
 /**
  * @brief EventManager
@@ -53,6 +63,14 @@ class EventManager
                                                  PLDM_MESSAGE_POLL_EVENT,
                                                  eventData, eventDataSize);
             }});
+        registerPolledEventHandler(
+            PLDM_PDR_REPOSITORY_CHG_EVENT,
+            {[this](pldm_tid_t tid, uint16_t eventId, const uint8_t* eventData,
+                    size_t eventDataSize) {
+                return this->handlePlatformEvent(
+                    tid, eventId, PLDM_PDR_REPOSITORY_CHG_EVENT, eventData,
+                    eventDataSize);
+            }});
         registerPolledEventHandler(
             PLDM_CPER_EVENT,
             {[this](pldm_tid_t tid, uint16_t eventId, const uint8_t* eventData,
@@ -98,7 +116,12 @@ class EventManager
         return availableState[tid];
     };
 
-    /** @brief A Coroutine to poll all events from terminus
+    /** @brief A Coroutine to poll the queued events from terminus
+     *
+     *  At most pollEventBudget events are drained, the remaining ones are
+     *  left to the next call with the terminus pollEvent flag set again.
+     *  The handlers of an acknowledged event run while the request for the
+     *  next event is in flight.
      *
      *  @param[in] tid - the destination TID
      *  @param[in] pollDataTransferHandle - the dataTransferHandle from
@@ -114,16 +137,56 @@ class EventManager
     void registerPolledEventHandler(uint8_t eventClass,
                                     pldm::platform_mc::HandlerFuncs handlers)
     {
-        auto [iter, inserted] = eventHandlers.try_emplace(
-            eventClass, pldm::platform_mc::HandlerFuncs{});
-
-        for (const auto& handler : handlers)
+        auto& registered = eventHandlers[eventClass];
+        for (auto& handler : handlers)
         {
-            iter->second.emplace_back(handler);
+            registered.emplace_back(std::move(handler));
         }
     }
 
   protected:
+    /** @brief Handler of an event class of DSP0248
+     *
+     *  @param[in] self - the event manager
+     *  @param[in] tid - tid where the event is from
+     *  @param[in] eventId - event Id
+     *  @param[in] eventData - event data
+     *  @param[in] eventDataSize - size of event data
+     *  @return PLDM completion code
+     */
+    using ClassHandler = int (*)(EventManager& self, pldm_tid_t tid,
+                                 uint16_t eventId, const uint8_t* eventData,
+                                 size_t eventDataSize);
+
+    /** @brief Handlers of the event classes of DSP0248, indexed by event
+     *         class, null for the classes not handled
+     */
+    static const std::array<ClassHandler, UINT8_MAX + 1> classHandlers;
+
+    /** @brief Helper method to process the PLDM sensor event class, the
+     *         sensor event classes are dispatched to their handlers
+     *
+     *  @param[in] tid - tid where the event is from
+     *  @param[in] eventData - sensorEvent event data
+     *  @param[in] eventDataSize - event data length
+     *
+     *  @return PLDM completion code
+     */
+    int processSensorEvent(pldm_tid_t tid, const uint8_t* eventData,
+                           size_t eventDataSize);
+
+    /** @brief Helper method to process the PLDM message poll event class,
+     *         the events are polled by the sensor polling task
+     *
+     *  @param[in] tid - tid where the event is from
+     *  @param[in] eventData - pldmMessagePollEvent event data
+     *  @param[in] eventDataSize - event data length
+     *
+     *  @return PLDM completion code
+     */
+    int processMessagePollEvent(pldm_tid_t tid, const uint8_t* eventData,
+                                size_t eventDataSize);
+
     /** @brief Helper method to process the PLDM Numeric sensor event class
      *
      *  @param[in] tid - tid where the event is from
@@ -150,6 +213,19 @@ class EventManager
                                  const uint8_t* eventData,
                                  const size_t eventDataSize);
 
+    /** @brief Helper method to process the PLDM PDR repository change event
+     *         class. The changes are applied by the sensor polling task of
+     *         the terminus.
+     *
+     *  @param[in] tid - tid where the event is from
+     *  @param[in] eventData - pldmPDRRepositoryChgEvent event data
+     *  @param[in] eventDataSize - event data length
+     *
+     *  @return PLDM completion code
+     */
+    int processPdrRepositoryChgEvent(pldm_tid_t tid, const uint8_t* eventData,
+                                     size_t eventDataSize);
+
     /** @brief Helper method to create CPER dump log
      *
      *  @param[in] dataType - CPER event data type
@@ -204,7 +280,7 @@ class EventManager
      *  @return return_value - PLDM completion code
      */
     int getNextPartParameters(
-        uint16_t eventId, std::vector<uint8_t> eventMessage,
+        uint16_t eventId, const std::vector<uint8_t>& eventMessage,
         uint8_t transferFlag, uint32_t eventDataIntegrityChecksum,
         uint32_t nextDataTransferHandle, uint8_t* transferOperationFlag,
         uint32_t* dataTransferHandle, uint32_t* eventIdToAcknowledge);
@@ -230,8 +306,13 @@ class EventManager
     /** @brief Available state for pldm request of terminus */
     std::unordered_map<pldm_tid_t, Availability> availableState;
 
-    /** @brief map of PLDM event type of polled event to EventHandlers */
-    pldm::platform_mc::EventMap eventHandlers;
+    /** @brief Maximum number of events drained by one
+     *         pollForPlatformEventTask
+     */
+    const size_t pollEventBudget = POLL_EVENT_BUDGET;
+
+    /** @brief EventHandlers of the polled events, by event class */
+    pldm::platform_mc::EventHandlerTable eventHandlers;
 };
 } // namespace platform_mc
 } // namespace pldm
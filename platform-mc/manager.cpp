@@ -1,5 +1,7 @@
 #include "manager.hpp"
 
+#include "common/startup_profiler.hpp"
+
 #include <phosphor-logging/lg2.hpp>
 
 PHOSPHOR_LOG2_USING;
@@ -19,6 +21,7 @@ exec::task<int> Manager::beforeDiscoverTerminus()
 exec::task<int> Manager::afterDiscoverTerminus()
 {
     auto rc = co_await platformManager.initTerminus();
+    stats::StartupProfiler::getInstance().milestone("TerminusDiscovery");
     if (rc != PLDM_SUCCESS)
     {
         lg2::error("Failed to initialize platform manager, error {RC}", "RC",
@@ -37,10 +40,11 @@ exec::task<int> Manager::pollForPlatformEvent(
     auto it = termini.find(tid);
     if (it != termini.end())
     {
-        auto& terminus = it->second;
+        /* Set again when the drain leaves events queued or a new
+         * pldmMessagePollEvent arrives meanwhile */
+        it->second->pollEvent = false;
         co_await eventManager.pollForPlatformEventTask(tid,
                                                        pollDataTransferHandle);
-        terminus->pollEvent = false;
     }
     co_return PLDM_SUCCESS;
 }
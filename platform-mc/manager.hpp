@@ -39,7 +39,7 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
                      pldm::InstanceIdDb& instanceIdDb) :
         terminusManager(event, handler, instanceIdDb, termini, this,
                         pldm::BmcMctpEid),
-        platformManager(terminusManager, termini, this),
+        platformManager(terminusManager, termini, this, PDR_CACHE_DIR),
         sensorManager(event, terminusManager, termini, this),
         eventManager(terminusManager, termini)
     {}
@@ -89,6 +89,17 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
         auto tid = terminusManager.toTid(mctpInfo);
         if (tid)
         {
+            /* A terminus which stopped responding is used again once it
+             * answers a probe, the probe in flight of a recovering one
+             * decides */
+            auto health = terminusManager.getTerminusHealth(*tid);
+            if (availability && (health == TerminusHealth::Unreachable ||
+                                 health == TerminusHealth::Recovering))
+            {
+                terminusManager.probeTerminusNow(*tid);
+                return;
+            }
+
             if (availability)
             {
                 sensorManager.startSensorPollTimer(tid.value());
@@ -123,6 +134,29 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
         }
     }
 
+    /** @brief Get the discovered termini */
+    const TerminiMapper& getTermini() const
+    {
+        return termini;
+    }
+
+    /** @brief Get the sensor polling statistics of the termini */
+    std::map<pldm_tid_t, SensorPollStats> getSensorPollStats() const
+    {
+        return sensorManager.getPollStats();
+    }
+
+    /** @brief Drain the events queued by the terminus from OEM event
+     *         polling, skipped while a drain of the terminus is in progress
+     *
+     *  @param[in] tid - Terminus ID
+     *  @return coroutine return_value - PLDM completion code
+     */
+    exec::task<int> drainPlatformEvents(pldm_tid_t tid)
+    {
+        return sensorManager.pollForPlatformEvent(tid);
+    }
+
     /** @brief Helper function to stop sensor polling of the terminus TID
      */
     void stopSensorPolling(pldm_tid_t tid)
@@ -176,6 +210,29 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
         return PLDM_SUCCESS;
     }
 
+    /** @brief PDR repository change event handler function
+     *
+     *  @param[in] request - Event message
+     *  @param[in] payloadLength - Event message payload size
+     *  @param[in] tid - Terminus ID
+     *  @param[in] eventDataOffset - Event data offset
+     *
+     *  @return PLDM error code: PLDM_SUCCESS when there is no error in handling
+     *          the event
+     */
+    int handlePdrRepositoryChgEvent(
+        const pldm_msg* request, size_t payloadLength,
+        uint8_t /* formatVersion */, uint8_t tid, size_t eventDataOffset)
+    {
+        auto eventData = reinterpret_cast<const uint8_t*>(request->payload) +
+                         eventDataOffset;
+        auto eventDataSize = payloadLength - eventDataOffset;
+        eventManager.handlePlatformEvent(
+            tid, PLDM_PLATFORM_EVENT_ID_NULL, PLDM_PDR_REPOSITORY_CHG_EVENT,
+            eventData, eventDataSize);
+        return PLDM_SUCCESS;
+    }
+
     /** @brief PLDM POLL event handler function
      *
      *  @param[in] request - Event message
@@ -210,6 +267,16 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
     exec::task<int> pollForPlatformEvent(pldm_tid_t tid, uint16_t pollEventId,
                                          uint32_t pollDataTransferHandle);
 
+    /** @brief Apply the pending PDR repository changes of the terminus
+     *
+     *  @param[in] tid - Terminus ID
+     *  @return coroutine return_value - PLDM completion code
+     */
+    exec::task<int> syncPDRs(pldm_tid_t tid)
+    {
+        return platformManager.syncPDRs(tid);
+    }
+
     /** @brief Handle Polled CPER event
      *
      *  @param[in] tid - tid where the event is from
@@ -248,6 +315,15 @@ class Manager : public pldm::MctpDiscoveryHandlerIntf
         pollHandlers.push_back(std::move(handler));
     }
 
+    /** @brief Register OEM command reading several sensors in one request
+     *
+     *  @param[in] handler - Batch read handler
+     */
+    void registerSensorReadBatchHandler(SensorReadBatchHandler handler)
+    {
+        sensorManager.registerSensorReadBatchHandler(std::move(handler));
+    }
+
     /** @brief OEM task to do OEM event polling
      *
      *  @param[in] tid - Destination TID
@@ -1,10 +1,13 @@
 #include "numeric_sensor.hpp"
 
+#include "common/event_log_limiter.hpp"
 #include "common/utils.hpp"
 #include "requester/handler.hpp"
 
 #include <libpldm/platform.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <regex>
 
@@ -15,6 +18,26 @@ namespace pldm
 namespace platform_mc
 {
 
+/** @brief Create an interface of the sensor object without emitting
+ *         InterfacesAdded
+ *
+ *  The sensor emits a single InterfacesAdded for all its interfaces once the
+ *  last one is created, rather than one signal per interface for the
+ *  ObjectMapper to process.
+ *
+ *  @param[in] bus - the D-Bus connection
+ *  @param[in] path - object path of the sensor
+ *  @param[in] args - further arguments of the interface constructor
+ *  @return the interface
+ */
+template <typename Intf, typename... Args>
+static std::unique_ptr<Intf> makeSensorIntf(
+    sdbusplus::bus_t& bus, const std::string& path, Args&&... args)
+{
+    return std::make_unique<Intf>(bus, path.c_str(), Intf::action::defer_emit,
+                                  std::forward<Args>(args)...);
+}
+
 inline bool NumericSensor::createInventoryPath(
     const std::string& associationPath, const std::string& sensorName,
     const uint16_t entityType, const uint16_t entityInstanceNum,
@@ -152,22 +175,28 @@ void NumericSensor::setSensorUnit(uint8_t baseUnit)
     }
 }
 
+void NumericSensor::setSensorPath()
+{
+    sensorPath.insert(0, sensorNameSpace);
+    sensorName = std::string_view(sensorPath).substr(sensorNameSpace.size());
+}
+
 NumericSensor::NumericSensor(
     const pldm_tid_t tid, const bool sensorDisabled,
     std::shared_ptr<pldm_numeric_sensor_value_pdr> pdr, std::string& sensorName,
-    std::string& associationPath) : tid(tid), sensorName(sensorName)
+    std::string& associationPath) : tid(tid), sensorPath(sensorName)
 {
+    this->sensorName = sensorPath;
     if (!pdr)
     {
         throw sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument();
     }
 
     sensorId = pdr->sensor_id;
-    std::string path;
     MetricUnit metricUnit = MetricUnit::Count;
     setSensorUnit(pdr->base_unit);
-
-    path = sensorNameSpace + sensorName;
+    setSensorPath();
+    const auto& path = sensorPath;
     try
     {
         std::string tmp{};
@@ -194,7 +223,7 @@ NumericSensor::NumericSensor(
     try
     {
         associationDefinitionsIntf =
-            std::make_unique<AssociationDefinitionsInft>(bus, path.c_str());
+            makeSensorIntf<AssociationDefinitionsInft>(bus, path);
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -251,6 +280,9 @@ NumericSensor::NumericSensor(
     resolution = pdr->resolution;
     offset = pdr->offset;
     baseUnitModifier = pdr->unit_modifier;
+    initConversion();
+    setPublishPolicy(
+        SensorPublishPolicy::getInstance().get(sensorNameSpace, sensorName));
     timeStamp = 0;
 
     /**
@@ -267,7 +299,7 @@ NumericSensor::NumericSensor(
     {
         try
         {
-            valueIntf = std::make_unique<ValueIntf>(bus, path.c_str());
+            valueIntf = makeSensorIntf<ValueIntf>(bus, path);
         }
         catch (const sdbusplus::exception_t& e)
         {
@@ -285,7 +317,7 @@ NumericSensor::NumericSensor(
     {
         try
         {
-            metricIntf = std::make_unique<MetricIntf>(bus, path.c_str());
+            metricIntf = makeSensorIntf<MetricIntf>(bus, path);
         }
         catch (const sdbusplus::exception_t& e)
         {
@@ -310,8 +342,7 @@ NumericSensor::NumericSensor(
 
     try
     {
-        availabilityIntf =
-            std::make_unique<AvailabilityIntf>(bus, path.c_str());
+        availabilityIntf = makeSensorIntf<AvailabilityIntf>(bus, path);
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -325,7 +356,7 @@ NumericSensor::NumericSensor(
     try
     {
         operationalStatusIntf =
-            std::make_unique<OperationalStatusIntf>(bus, path.c_str());
+            makeSensorIntf<OperationalStatusIntf>(bus, path);
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -340,8 +371,8 @@ NumericSensor::NumericSensor(
     {
         try
         {
-            thresholdWarningIntf =
-                std::make_unique<ThresholdWarningIntf>(bus, path.c_str());
+            thresholdWarningIntf = makeSensorIntf<ThresholdWarning>(
+                bus, path, [this]() { cacheThresholds(); });
         }
         catch (const sdbusplus::exception_t& e)
         {
@@ -359,8 +390,8 @@ NumericSensor::NumericSensor(
     {
         try
         {
-            thresholdCriticalIntf =
-                std::make_unique<ThresholdCriticalIntf>(bus, path.c_str());
+            thresholdCriticalIntf = makeSensorIntf<ThresholdCritical>(
+                bus, path, [this]() { cacheThresholds(); });
         }
         catch (const sdbusplus::exception_t& e)
         {
@@ -373,25 +404,27 @@ NumericSensor::NumericSensor(
         thresholdCriticalIntf->criticalHigh(unitModifier(criticalHigh));
         thresholdCriticalIntf->criticalLow(unitModifier(criticalLow));
     }
+
+    associationDefinitionsIntf->emit_object_added();
 }
 
 NumericSensor::NumericSensor(
     const pldm_tid_t tid, const bool sensorDisabled,
     std::shared_ptr<pldm_compact_numeric_sensor_pdr> pdr,
     std::string& sensorName, std::string& associationPath) :
-    tid(tid), sensorName(sensorName)
+    tid(tid), sensorPath(sensorName)
 {
+    this->sensorName = sensorPath;
     if (!pdr)
     {
         throw sdbusplus::xyz::openbmc_project::Common::Error::InvalidArgument();
     }
 
     sensorId = pdr->sensor_id;
-    std::string path;
     MetricUnit metricUnit = MetricUnit::Count;
     setSensorUnit(pdr->base_unit);
-
-    path = sensorNameSpace + sensorName;
+    setSensorPath();
+    const auto& path = sensorPath;
     try
     {
         std::string tmp{};
@@ -418,7 +451,7 @@ NumericSensor::NumericSensor(
     try
     {
         associationDefinitionsIntf =
-            std::make_unique<AssociationDefinitionsInft>(bus, path.c_str());
+            makeSensorIntf<AssociationDefinitionsInft>(bus, path);
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -465,6 +498,9 @@ NumericSensor::NumericSensor(
     resolution = std::numeric_limits<double>::quiet_NaN();
     offset = std::numeric_limits<double>::quiet_NaN();
     baseUnitModifier = pdr->unit_modifier;
+    initConversion();
+    setPublishPolicy(
+        SensorPublishPolicy::getInstance().get(sensorNameSpace, sensorName));
     timeStamp = 0;
     hysteresis = 0;
 
@@ -478,7 +514,7 @@ NumericSensor::NumericSensor(
     {
         try
         {
-            valueIntf = std::make_unique<ValueIntf>(bus, path.c_str());
+            valueIntf = makeSensorIntf<ValueIntf>(bus, path);
         }
         catch (const sdbusplus::exception_t& e)
         {
@@ -496,7 +532,7 @@ NumericSensor::NumericSensor(
     {
         try
         {
-            metricIntf = std::make_unique<MetricIntf>(bus, path.c_str());
+            metricIntf = makeSensorIntf<MetricIntf>(bus, path);
         }
         catch (const sdbusplus::exception_t& e)
         {
@@ -521,8 +557,7 @@ NumericSensor::NumericSensor(
 
     try
     {
-        availabilityIntf =
-            std::make_unique<AvailabilityIntf>(bus, path.c_str());
+        availabilityIntf = makeSensorIntf<AvailabilityIntf>(bus, path);
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -536,7 +571,7 @@ NumericSensor::NumericSensor(
     try
     {
         operationalStatusIntf =
-            std::make_unique<OperationalStatusIntf>(bus, path.c_str());
+            makeSensorIntf<OperationalStatusIntf>(bus, path);
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -551,8 +586,8 @@ NumericSensor::NumericSensor(
     {
         try
         {
-            thresholdWarningIntf =
-                std::make_unique<ThresholdWarningIntf>(bus, path.c_str());
+            thresholdWarningIntf = makeSensorIntf<ThresholdWarning>(
+                bus, path, [this]() { cacheThresholds(); });
         }
         catch (const sdbusplus::exception_t& e)
         {
@@ -570,8 +605,8 @@ NumericSensor::NumericSensor(
     {
         try
         {
-            thresholdCriticalIntf =
-                std::make_unique<ThresholdCriticalIntf>(bus, path.c_str());
+            thresholdCriticalIntf = makeSensorIntf<ThresholdCritical>(
+                bus, path, [this]() { cacheThresholds(); });
         }
         catch (const sdbusplus::exception_t& e)
         {
@@ -584,6 +619,8 @@ NumericSensor::NumericSensor(
         thresholdCriticalIntf->criticalHigh(unitModifier(criticalHigh));
         thresholdCriticalIntf->criticalLow(unitModifier(criticalLow));
     }
+
+    associationDefinitionsIntf->emit_object_added();
 }
 
 double NumericSensor::conversionFormula(double value)
@@ -600,6 +637,29 @@ double NumericSensor::conversionFormula(double value)
     return convertedValue;
 }
 
+void NumericSensor::initConversion()
+{
+    auto multiplier = std::pow(10, baseUnitModifier);
+    readingScale = (std::isfinite(resolution) ? resolution : 1) * multiplier;
+    readingOffset = (std::isfinite(offset) ? offset : 0) * multiplier;
+    valueDeadband = 0;
+    if (std::isfinite(resolution))
+    {
+        valueDeadband =
+            std::abs(resolution) * multiplier * SENSOR_VALUE_DEADBAND;
+    }
+}
+
+void NumericSensor::convertReadings(std::span<const double> rawValues,
+                                    std::span<double> values) const
+{
+    auto count = std::min(rawValues.size(), values.size());
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = convertReading(rawValues[i]);
+    }
+}
+
 double NumericSensor::unitModifier(double value)
 {
     if (!std::isfinite(value))
@@ -620,8 +680,16 @@ void NumericSensor::updateReading(bool available, bool functional, double value)
             "NAME", sensorName);
         return;
     }
-    availabilityIntf->available(available);
-    operationalStatusIntf->functional(functional);
+    if (availabilityIntf->available() != available)
+    {
+        availabilityIntf->available(available, true);
+        pendingSignals |= availabilitySignal;
+    }
+    if (operationalStatusIntf->functional() != functional)
+    {
+        operationalStatusIntf->functional(functional, true);
+        pendingSignals |= operationalStatusSignal;
+    }
     double curValue = 0;
     if (!useMetricInterface)
     {
@@ -635,38 +703,126 @@ void NumericSensor::updateReading(bool available, bool functional, double value)
     double newValue = std::numeric_limits<double>::quiet_NaN();
     if (functional && available)
     {
-        newValue = unitModifier(conversionFormula(value));
-        if (newValue != curValue &&
-            (std::isfinite(newValue) || std::isfinite(curValue)))
+        newValue = convertReading(value);
+        if (valueChanged(curValue, newValue))
         {
+            setValue(newValue);
             if (!useMetricInterface)
             {
-                valueIntf->value(newValue);
                 updateThresholds();
             }
-            else
-            {
-                metricIntf->value(newValue);
-            }
         }
     }
     else
     {
-        if (newValue != curValue &&
-            (std::isfinite(newValue) || std::isfinite(curValue)))
+        if (valueChanged(curValue, newValue))
         {
-            if (!useMetricInterface)
-            {
-                valueIntf->value(std::numeric_limits<double>::quiet_NaN());
-            }
-            else
-            {
-                metricIntf->value(std::numeric_limits<double>::quiet_NaN());
-            }
+            setValue(std::numeric_limits<double>::quiet_NaN());
         }
     }
 }
 
+bool NumericSensor::valueChanged(double curValue, double newValue)
+{
+    if (!std::isfinite(newValue) && !std::isfinite(curValue))
+    {
+        return false;
+    }
+    if (!std::isfinite(newValue) || !std::isfinite(curValue))
+    {
+        return true;
+    }
+    if (newValue == curValue)
+    {
+        return false;
+    }
+
+    /* Alarm latency does not suffer from the deadband or the interval */
+    if (!thresholdsQuiet(newValue))
+    {
+        return true;
+    }
+
+    /* Ignore jitter within SENSOR_VALUE_DEADBAND resolution steps */
+    if (std::abs(newValue - curValue) <
+        std::max(valueDeadband, publishDeadband))
+    {
+        return false;
+    }
+    return minPublishInterval.count() == 0 ||
+           std::chrono::steady_clock::now() - lastPublish >= minPublishInterval;
+}
+
+void NumericSensor::setValue(double value)
+{
+    if (minPublishInterval.count())
+    {
+        lastPublish = std::chrono::steady_clock::now();
+    }
+    if (!useMetricInterface)
+    {
+        valueIntf->value(value, true);
+    }
+    else
+    {
+        metricIntf->value(value, true);
+    }
+    pendingSignals |= valueSignal;
+}
+
+double NumericSensor::getValue() const
+{
+    if (!useMetricInterface)
+    {
+        return valueIntf ? valueIntf->value()
+                         : std::numeric_limits<double>::quiet_NaN();
+    }
+    return metricIntf ? metricIntf->value()
+                      : std::numeric_limits<double>::quiet_NaN();
+}
+
+bool NumericSensor::isAvailable() const
+{
+    return availabilityIntf && availabilityIntf->available();
+}
+
+bool NumericSensor::isFunctional() const
+{
+    return operationalStatusIntf && operationalStatusIntf->functional();
+}
+
+void NumericSensor::emitPropertiesChanged()
+{
+    if (!pendingSignals)
+    {
+        return;
+    }
+
+    auto bus = pldm::utils::DBusHandler::getBus().get();
+    auto emit = [this, bus](uint8_t signal, const char* interface,
+                            const char* property) {
+        if (!(pendingSignals & signal))
+        {
+            return;
+        }
+        auto rc = sd_bus_emit_properties_changed(bus, sensorPath.c_str(),
+                                                 interface, property, nullptr);
+        if (rc < 0)
+        {
+            lg2::error(
+                "Failed to emit {PROPERTY} change of sensor {NAME}, error {RC}",
+                "PROPERTY", property, "NAME", sensorName, "RC", rc);
+        }
+    };
+
+    emit(availabilitySignal, AvailabilityIntf::interface, "Available");
+    emit(operationalStatusSignal, OperationalStatusIntf::interface,
+         "Functional");
+    emit(valueSignal,
+         useMetricInterface ? METRIC_VALUE_INTF : SENSOR_VALUE_INTF, "Value");
+    pendingSignals = 0;
+}
+
 void NumericSensor::handleErrGetSensorReading()
 {
     if (!operationalStatusIntf || (!useMetricInterface && !valueIntf) ||
@@ -677,14 +833,16 @@ void NumericSensor::handleErrGetSensorReading()
             "NAME", sensorName);
         return;
     }
-    operationalStatusIntf->functional(false);
-    if (!useMetricInterface)
+    if (operationalStatusIntf->functional())
     {
-        valueIntf->value(std::numeric_limits<double>::quiet_NaN());
+        operationalStatusIntf->functional(false, true);
+        pendingSignals |= operationalStatusSignal;
     }
-    else
+    double curValue = useMetricInterface ? metricIntf->value()
+                                         : valueIntf->value();
+    if (std::isfinite(curValue))
     {
-        metricIntf->value(std::numeric_limits<double>::quiet_NaN());
+        setValue(std::numeric_limits<double>::quiet_NaN());
     }
 }
 
@@ -716,107 +874,187 @@ bool NumericSensor::checkThreshold(bool alarm, bool direction, double value,
     return alarm;
 }
 
-void NumericSensor::updateThresholds()
+void NumericSensor::cacheThresholds()
 {
-    double value = std::numeric_limits<double>::quiet_NaN();
+    thresholdBandCount = 0;
+    quietLow = -std::numeric_limits<double>::infinity();
+    quietHigh = std::numeric_limits<double>::infinity();
 
-    if ((!useMetricInterface && !valueIntf) ||
-        (useMetricInterface && !metricIntf))
+    auto addBand = [this](pldm::utils::Level level,
+                          pldm::utils::Direction direction, double threshold) {
+        if (!std::isfinite(threshold))
+        {
+            return;
+        }
+        thresholdBands[thresholdBandCount++] = {level, direction, threshold};
+        if (direction == pldm::utils::Direction::HIGH)
+        {
+            quietHigh = std::min(quietHigh, threshold);
+        }
+        else
+        {
+            quietLow = std::max(quietLow, threshold);
+        }
+    };
+
+    if (thresholdWarningIntf)
     {
-        lg2::error(
-            "Failed to update thresholds sensor {NAME} D-Bus interfaces don't exist.",
-            "NAME", sensorName);
-        return;
+        addBand(pldm::utils::Level::WARNING, pldm::utils::Direction::HIGH,
+                thresholdWarningIntf->warningHigh());
+        addBand(pldm::utils::Level::WARNING, pldm::utils::Direction::LOW,
+                thresholdWarningIntf->warningLow());
     }
-    if (!useMetricInterface)
+    if (thresholdCriticalIntf)
     {
-        value = valueIntf->value();
+        addBand(pldm::utils::Level::CRITICAL, pldm::utils::Direction::HIGH,
+                thresholdCriticalIntf->criticalHigh());
+        addBand(pldm::utils::Level::CRITICAL, pldm::utils::Direction::LOW,
+                thresholdCriticalIntf->criticalLow());
     }
-    else
+}
+
+bool NumericSensor::getThresholdAlarm(const ThresholdBand& band) const
+{
+    bool high = band.direction == pldm::utils::Direction::HIGH;
+    if (band.level == pldm::utils::Level::WARNING)
     {
-        value = metricIntf->value();
+        return high ? thresholdWarningIntf->warningAlarmHigh()
+                    : thresholdWarningIntf->warningAlarmLow();
     }
-    if (thresholdWarningIntf &&
-        std::isfinite(thresholdWarningIntf->warningHigh()))
+    return high ? thresholdCriticalIntf->criticalAlarmHigh()
+                : thresholdCriticalIntf->criticalAlarmLow();
+}
+
+void NumericSensor::setThresholdAlarm(const ThresholdBand& band, bool alarm,
+                                      double value)
+{
+    bool high = band.direction == pldm::utils::Direction::HIGH;
+    bool signal = admitThresholdSignal(band.level, band.direction, alarm);
+    if (band.level == pldm::utils::Level::WARNING)
     {
-        auto threshold = thresholdWarningIntf->warningHigh();
-        auto alarm = thresholdWarningIntf->warningAlarmHigh();
-        auto newAlarm =
-            checkThreshold(alarm, true, value, threshold, hysteresis);
-        if (alarm != newAlarm)
+        if (high)
         {
-            thresholdWarningIntf->warningAlarmHigh(newAlarm);
-            if (newAlarm)
+            thresholdWarningIntf->warningAlarmHigh(alarm);
+            if (signal && alarm)
             {
                 thresholdWarningIntf->warningHighAlarmAsserted(value);
             }
-            else
+            else if (signal)
             {
                 thresholdWarningIntf->warningHighAlarmDeasserted(value);
             }
         }
-    }
-
-    if (thresholdWarningIntf &&
-        std::isfinite(thresholdWarningIntf->warningLow()))
-    {
-        auto threshold = thresholdWarningIntf->warningLow();
-        auto alarm = thresholdWarningIntf->warningAlarmLow();
-        auto newAlarm =
-            checkThreshold(alarm, false, value, threshold, hysteresis);
-        if (alarm != newAlarm)
+        else
         {
-            thresholdWarningIntf->warningAlarmLow(newAlarm);
-            if (newAlarm)
+            thresholdWarningIntf->warningAlarmLow(alarm);
+            if (signal && alarm)
             {
                 thresholdWarningIntf->warningLowAlarmAsserted(value);
             }
-            else
+            else if (signal)
             {
                 thresholdWarningIntf->warningLowAlarmDeasserted(value);
             }
         }
+        return;
     }
-
-    if (thresholdCriticalIntf &&
-        std::isfinite(thresholdCriticalIntf->criticalHigh()))
+    if (high)
     {
-        auto threshold = thresholdCriticalIntf->criticalHigh();
-        auto alarm = thresholdCriticalIntf->criticalAlarmHigh();
-        auto newAlarm =
-            checkThreshold(alarm, true, value, threshold, hysteresis);
-        if (alarm != newAlarm)
+        thresholdCriticalIntf->criticalAlarmHigh(alarm);
+        if (signal && alarm)
         {
-            thresholdCriticalIntf->criticalAlarmHigh(newAlarm);
-            if (newAlarm)
-            {
-                thresholdCriticalIntf->criticalHighAlarmAsserted(value);
-            }
-            else
-            {
-                thresholdCriticalIntf->criticalHighAlarmDeasserted(value);
-            }
+            thresholdCriticalIntf->criticalHighAlarmAsserted(value);
         }
+        else if (signal)
+        {
+            thresholdCriticalIntf->criticalHighAlarmDeasserted(value);
+        }
+    }
+    else
+    {
+        thresholdCriticalIntf->criticalAlarmLow(alarm);
+        if (signal && alarm)
+        {
+            thresholdCriticalIntf->criticalLowAlarmAsserted(value);
+        }
+        else if (signal)
+        {
+            thresholdCriticalIntf->criticalLowAlarmDeasserted(value);
+        }
+    }
+}
+
+bool NumericSensor::admitThresholdSignal(pldm::utils::Level level,
+                                         pldm::utils::Direction direction,
+                                         bool assert)
+{
+    pldm::utils::EventLogKey key{
+        pldm::utils::EventLogSource::Threshold, tid, sensorId,
+        static_cast<uint8_t>(static_cast<uint8_t>(level) << 3 |
+                             static_cast<uint8_t>(direction) << 1 | assert)};
+    return pldm::utils::EventLogLimiter::getInstance().admit(
+        key, [this, level, direction, assert]() {
+            return [name = std::string(sensorName), level, direction, assert](
+                       uint64_t suppressed, std::chrono::seconds interval) {
+                lg2::warning(
+                    "Sensor {NAME} threshold level {LEVEL} direction {DIRECTION} assert {ASSERT} transitioned {COUNT} more times in {INTERVAL}s, not signalled",
+                    "NAME", name, "LEVEL", level, "DIRECTION", direction,
+                    "ASSERT", assert, "COUNT", suppressed, "INTERVAL",
+                    interval.count());
+            };
+        });
+}
+
+bool NumericSensor::thresholdsQuiet(double value) const
+{
+    return value > quietLow && value < quietHigh &&
+           std::ranges::none_of(
+               std::span(thresholdBands).first(thresholdBandCount),
+               [this](const ThresholdBand& band) {
+                   return getThresholdAlarm(band);
+               });
+}
+
+void NumericSensor::updateThresholds()
+{
+    double value = std::numeric_limits<double>::quiet_NaN();
+
+    if ((!useMetricInterface && !valueIntf) ||
+        (useMetricInterface && !metricIntf))
+    {
+        lg2::error(
+            "Failed to update thresholds sensor {NAME} D-Bus interfaces don't exist.",
+            "NAME", sensorName);
+        return;
+    }
+    if (!useMetricInterface)
+    {
+        value = valueIntf->value();
+    }
+    else
+    {
+        value = metricIntf->value();
+    }
+    if (std::isnan(value))
+    {
+        return;
     }
 
-    if (thresholdCriticalIntf &&
-        std::isfinite(thresholdCriticalIntf->criticalLow()))
+    /* The common case, a reading between the thresholds and no alarm */
+    if (thresholdsQuiet(value))
     {
-        auto threshold = thresholdCriticalIntf->criticalLow();
-        auto alarm = thresholdCriticalIntf->criticalAlarmLow();
-        auto newAlarm =
-            checkThreshold(alarm, false, value, threshold, hysteresis);
+        return;
+    }
+
+    for (const auto& band : std::span(thresholdBands).first(thresholdBandCount))
+    {
+        auto alarm = getThresholdAlarm(band);
+        bool high = band.direction == pldm::utils::Direction::HIGH;
+        auto newAlarm = checkThreshold(alarm, high, value, band.threshold,
+                                       hysteresis);
         if (alarm != newAlarm)
         {
-            thresholdCriticalIntf->criticalAlarmLow(newAlarm);
-            if (newAlarm)
-            {
-                thresholdCriticalIntf->criticalLowAlarmAsserted(value);
-            }
-            else
-            {
-                thresholdCriticalIntf->criticalLowAlarmDeasserted(value);
-            }
+            setThresholdAlarm(band, newAlarm, value);
         }
     }
 }
@@ -833,11 +1071,19 @@ int NumericSensor::triggerThresholdEvent(
         return PLDM_ERROR;
     }
 
-    auto value = unitModifier(conversionFormula(rawValue));
-    lg2::error(
-        "triggerThresholdEvent eventType {TID}, direction {SID} value {VAL} newAlarm {PSTATE} assert {ESTATE}",
-        "TID", eventType, "SID", direction, "VAL", value, "PSTATE", newAlarm,
-        "ESTATE", assert);
+    auto value = convertReading(rawValue);
+    /* The transitions of a flapping sensor are summarized */
+    auto signal = [&]() {
+        if (!admitThresholdSignal(eventType, direction, assert))
+        {
+            return false;
+        }
+        lg2::error(
+            "triggerThresholdEvent eventType {TID}, direction {SID} value {VAL} newAlarm {PSTATE} assert {ESTATE}",
+            "TID", eventType, "SID", direction, "VAL", value, "PSTATE",
+            newAlarm, "ESTATE", assert);
+        return true;
+    };
 
     switch (eventType)
     {
@@ -859,6 +1105,10 @@ int NumericSensor::triggerThresholdEvent(
                     return PLDM_SUCCESS;
                 }
                 thresholdWarningIntf->warningAlarmHigh(newAlarm);
+                if (!signal())
+                {
+                    return PLDM_SUCCESS;
+                }
                 if (assert)
                 {
                     thresholdWarningIntf->warningHighAlarmAsserted(value);
@@ -877,6 +1127,10 @@ int NumericSensor::triggerThresholdEvent(
                     return PLDM_SUCCESS;
                 }
                 thresholdWarningIntf->warningAlarmLow(newAlarm);
+                if (!signal())
+                {
+                    return PLDM_SUCCESS;
+                }
                 if (assert)
                 {
                     thresholdWarningIntf->warningLowAlarmAsserted(value);
@@ -906,6 +1160,10 @@ int NumericSensor::triggerThresholdEvent(
                     return PLDM_SUCCESS;
                 }
                 thresholdCriticalIntf->criticalAlarmHigh(newAlarm);
+                if (!signal())
+                {
+                    return PLDM_SUCCESS;
+                }
                 if (assert)
                 {
                     thresholdCriticalIntf->criticalHighAlarmAsserted(value);
@@ -924,6 +1182,10 @@ int NumericSensor::triggerThresholdEvent(
                     return PLDM_SUCCESS;
                 }
                 thresholdCriticalIntf->criticalAlarmLow(newAlarm);
+                if (!signal())
+                {
+                    return PLDM_SUCCESS;
+                }
                 if (assert)
                 {
                     thresholdCriticalIntf->criticalLowAlarmAsserted(value);
@@ -2,6 +2,8 @@
 
 #include "common/types.hpp"
 #include "common/utils.hpp"
+#include "sensor_history.hpp"
+#include "sensor_publish_policy.hpp"
 
 #include <libpldm/platform.h>
 #include <libpldm/pldm.h>
@@ -16,8 +18,16 @@
 #include <xyz/openbmc_project/State/Decorator/Availability/server.hpp>
 #include <xyz/openbmc_project/State/Decorator/OperationalStatus/server.hpp>
 
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <span>
 #include <string>
 
+class TestNumericSensor;
+
 namespace pldm
 {
 namespace platform_mc
@@ -46,6 +56,72 @@ using AssociationDefinitionsInft = sdbusplus::server::object_t<
 using EntityIntf = sdbusplus::server::object_t<
     sdbusplus::xyz::openbmc_project::Inventory::Source::PLDM::server::Entity>;
 
+/** @class ThresholdWarning
+ *  @brief Warning thresholds of a NumericSensor, calling back the sensor
+ *         when one is set, by the sensor or over D-Bus
+ */
+class ThresholdWarning : public ThresholdWarningIntf
+{
+  public:
+    ThresholdWarning(sdbusplus::bus_t& bus, const char* path, action act,
+                     std::function<void()> onSet) :
+        ThresholdWarningIntf(bus, path, act), onSet(std::move(onSet))
+    {}
+
+    using ThresholdWarningIntf::warningHigh;
+    using ThresholdWarningIntf::warningLow;
+
+    double warningHigh(double value) override
+    {
+        auto result = ThresholdWarningIntf::warningHigh(value);
+        onSet();
+        return result;
+    }
+
+    double warningLow(double value) override
+    {
+        auto result = ThresholdWarningIntf::warningLow(value);
+        onSet();
+        return result;
+    }
+
+  private:
+    std::function<void()> onSet;
+};
+
+/** @class ThresholdCritical
+ *  @brief Critical thresholds of a NumericSensor, calling back the sensor
+ *         when one is set, by the sensor or over D-Bus
+ */
+class ThresholdCritical : public ThresholdCriticalIntf
+{
+  public:
+    ThresholdCritical(sdbusplus::bus_t& bus, const char* path, action act,
+                      std::function<void()> onSet) :
+        ThresholdCriticalIntf(bus, path, act), onSet(std::move(onSet))
+    {}
+
+    using ThresholdCriticalIntf::criticalHigh;
+    using ThresholdCriticalIntf::criticalLow;
+
+    double criticalHigh(double value) override
+    {
+        auto result = ThresholdCriticalIntf::criticalHigh(value);
+        onSet();
+        return result;
+    }
+
+    double criticalLow(double value) override
+    {
+        auto result = ThresholdCriticalIntf::criticalLow(value);
+        onSet();
+        return result;
+    }
+
+  private:
+    std::function<void()> onSet;
+};
+
 /**
  * @brief NumericSensor
  *
@@ -55,6 +131,8 @@ using EntityIntf = sdbusplus::server::object_t<
 class NumericSensor
 {
   public:
+    friend class ::TestNumericSensor;
+
     NumericSensor(const pldm_tid_t tid, const bool sensorDisabled,
                   std::shared_ptr<pldm_numeric_sensor_value_pdr> pdr,
                   std::string& sensorName, std::string& associationPath);
@@ -65,15 +143,49 @@ class NumericSensor
 
     ~NumericSensor() {};
 
+    /* sensorName is a view of sensorPath */
+    NumericSensor(const NumericSensor&) = delete;
+    NumericSensor& operator=(const NumericSensor&) = delete;
+
     /** @brief The function called by Sensor Manager to set sensor to
      * error status.
      */
     void handleErrGetSensorReading();
 
+    /** @brief Set when the new readings are published on D-Bus
+     *
+     *  @param[in] policy - the publish policy of the sensor
+     */
+    void setPublishPolicy(const PublishPolicy& policy)
+    {
+        publishDeadband = policy.deadband;
+        minPublishInterval = policy.minInterval;
+    }
+
     /** @brief Updating the sensor status to D-Bus interface
+     *
+     *  The new values are visible to D-Bus readers right away, the
+     *  PropertiesChanged signals are held until emitPropertiesChanged().
      */
     void updateReading(bool available, bool functional, double value = 0);
 
+    /** @brief Emit one PropertiesChanged signal per interface for the values
+     *         changed since the last call
+     */
+    void emitPropertiesChanged();
+
+    /** @brief Get the value published on D-Bus
+     *
+     *  @return double - the value, NaN when it is not available
+     */
+    double getValue() const;
+
+    /** @brief Get the Available property published on D-Bus */
+    bool isAvailable() const;
+
+    /** @brief Get the Functional property published on D-Bus */
+    bool isFunctional() const;
+
     /** @brief ConversionFormula is used to convert raw value to the unit
      * specified in PDR
      *
@@ -89,6 +201,30 @@ class NumericSensor
      */
     double unitModifier(double value);
 
+    /** @brief Convert a raw reading to the sensor value in Units, the same as
+     *  unitModifier(conversionFormula(value)) with the coefficients folded
+     *  at PDR parse time
+     *
+     *  @param[in] value - raw value
+     *  @return double - converted value
+     */
+    double convertReading(double value) const
+    {
+        if (!std::isfinite(value))
+        {
+            return value;
+        }
+        return value * readingScale + readingOffset;
+    }
+
+    /** @brief Convert the raw readings of a polling cycle at once
+     *
+     *  @param[in] rawValues - raw values
+     *  @param[out] values - converted values, same size as rawValues
+     */
+    void convertReadings(std::span<const double> rawValues,
+                         std::span<double> values) const;
+
     /** @brief Check if value is over threshold.
      *
      *  @param[in] alarm - previous alarm state
@@ -203,11 +339,19 @@ class NumericSensor
     /** @brief  The time of sensor update interval in usec */
     uint64_t updateTime;
 
-    /** @brief  sensorName */
-    std::string sensorName;
+    /** @brief  The readings of the sensor come with sensorEvents, polling
+     *          only keeps it alive
+     */
+    bool eventDriven = false;
+
+    /** @brief  The recent readings of the sensor */
+    SensorHistory history{SENSOR_HISTORY_SIZE};
+
+    /** @brief  sensorName, the last part of the sensor object path */
+    std::string_view sensorName;
 
-    /** @brief  sensorNameSpace */
-    std::string sensorNameSpace;
+    /** @brief  sensorNameSpace, one of the D-Bus namespaces of the units */
+    std::string_view sensorNameSpace;
 
     /** @brief Sensor Unit */
     SensorUnit sensorUnit;
@@ -219,11 +363,76 @@ class NumericSensor
      */
     void updateThresholds();
 
+    /** @brief A finite threshold, checked by checkThreshold with the
+     *         hysteresis of the sensor
+     */
+    struct ThresholdBand
+    {
+        pldm::utils::Level level;
+        pldm::utils::Direction direction;
+        double threshold;
+    };
+
+    /** @brief Cache the thresholds of the interfaces as bands, called when
+     *         a threshold is set
+     */
+    void cacheThresholds();
+
+    /** @brief Check that a reading changes no threshold alarm: it is
+     *         between the thresholds and no alarm is asserted
+     */
+    bool thresholdsQuiet(double value) const;
+
+    /** @brief Get the alarm of a threshold band */
+    bool getThresholdAlarm(const ThresholdBand& band) const;
+
+    /** @brief Set the alarm of a threshold band and signal the transition
+     *
+     *  @param[in] band - the threshold band
+     *  @param[in] alarm - the new alarm state
+     *  @param[in] value - the reading causing the transition
+     */
+    void setThresholdAlarm(const ThresholdBand& band, bool alarm,
+                           double value);
+
+    /** @brief Check if a threshold alarm transition is signalled, the
+     *         transitions of a flapping sensor are summarized instead
+     *
+     *  @param[in] level - level of the threshold
+     *  @param[in] direction - direction of the threshold
+     *  @param[in] assert - the alarm is asserted
+     *
+     *  @return true to signal the transition
+     */
+    bool admitThresholdSignal(pldm::utils::Level level,
+                              pldm::utils::Direction direction, bool assert);
+
+    /** @brief Check if the sensor value should be updated on D-Bus
+     *
+     *  @param[in] curValue - value on D-Bus
+     *  @param[in] newValue - new reading
+     *  @return bool - true when the value changed by more than the deadband,
+     *          at least minPublishInterval after the last one, or when a
+     *          threshold alarm may change
+     */
+    bool valueChanged(double curValue, double newValue);
+
+    /** @brief Set the Value property without signalling it
+     *
+     *  @param[in] value - new value
+     */
+    void setValue(double value);
+
     /**
      * @brief Update the object units based on the PDR baseUnit
      */
     void setSensorUnit(uint8_t baseUnit);
 
+    /** @brief Prefix the sensor name with sensorNameSpace into the sensor
+     *         object path
+     */
+    void setSensorPath();
+
     /** @brief Create the sensor inventory path.
      *
      *  @param[in] associationPath - sensor association path
@@ -241,17 +450,40 @@ class NumericSensor
 
     std::unique_ptr<MetricIntf> metricIntf = nullptr;
     std::unique_ptr<ValueIntf> valueIntf = nullptr;
-    std::unique_ptr<ThresholdWarningIntf> thresholdWarningIntf = nullptr;
-    std::unique_ptr<ThresholdCriticalIntf> thresholdCriticalIntf = nullptr;
+    std::unique_ptr<ThresholdWarning> thresholdWarningIntf = nullptr;
+    std::unique_ptr<ThresholdCritical> thresholdCriticalIntf = nullptr;
     std::unique_ptr<AvailabilityIntf> availabilityIntf = nullptr;
     std::unique_ptr<OperationalStatusIntf> operationalStatusIntf = nullptr;
+    /** @brief Emits InterfacesAdded and InterfacesRemoved for all the
+     *         interfaces of the sensor object, declared after them to be
+     *         destroyed while they are all still there
+     */
     std::unique_ptr<AssociationDefinitionsInft> associationDefinitionsIntf =
         nullptr;
     std::unique_ptr<EntityIntf> entityIntf = nullptr;
 
+    /** @brief Properties waiting for emitPropertiesChanged() */
+    static constexpr uint8_t availabilitySignal = 0x01;
+    static constexpr uint8_t operationalStatusSignal = 0x02;
+    static constexpr uint8_t valueSignal = 0x04;
+    uint8_t pendingSignals = 0;
+
+    /** @brief D-Bus object path of the sensor */
+    std::string sensorPath;
+
     /** @brief Amount of hysteresis associated with the sensor thresholds */
     double hysteresis;
 
+    /** @brief The finite thresholds, the first thresholdBandCount ones */
+    std::array<ThresholdBand, 4> thresholdBands{};
+    size_t thresholdBandCount = 0;
+
+    /** @brief Readings strictly between these cross no threshold, no alarm
+     *         changes there while none is asserted
+     */
+    double quietLow = -std::numeric_limits<double>::infinity();
+    double quietHigh = std::numeric_limits<double>::infinity();
+
     /** @brief The resolution of sensor in Units */
     double resolution;
 
@@ -261,6 +493,31 @@ class NumericSensor
 
     /** @brief A power-of-10 multiplier for baseUnit */
     int8_t baseUnitModifier;
+
+    /** @brief Fold resolution, offset and unit modifier into readingScale
+     *  and readingOffset
+     */
+    void initConversion();
+
+    /** @brief raw reading to Units multiplier, see convertReading() */
+    double readingScale = 1;
+
+    /** @brief raw reading to Units offset, see convertReading() */
+    double readingOffset = 0;
+
+    /** @brief Minimum change of the value published on D-Bus */
+    double valueDeadband = 0;
+
+    /** @brief Minimum change of the value published on D-Bus, set by the
+     *         publish policy of the sensor
+     */
+    double publishDeadband = 0;
+
+    /** @brief Minimum time between two values published on D-Bus */
+    std::chrono::milliseconds minPublishInterval{0};
+
+    /** @brief When the value was last published on D-Bus */
+    std::chrono::steady_clock::time_point lastPublish{};
     bool useMetricInterface = false;
 };
 } // namespace platform_mc
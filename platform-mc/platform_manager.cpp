@@ -1,11 +1,21 @@
 #include "platform_manager.hpp"
 
+#include "common/startup_profiler.hpp"
+
 #include "manager.hpp"
 #include "terminus_manager.hpp"
 
+#include <libpldm/utils.h>
+
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <format>
+#include <map>
 #include <ranges>
+#include <set>
+#include <span>
+#include <utility>
 
 PHOSPHOR_LOG2_USING;
 
@@ -16,49 +26,48 @@ namespace platform_mc
 
 exec::task<int> PlatformManager::initTerminus()
 {
-    for (auto& [tid, terminus] : termini)
+    /* Fetch the FRU record tables of the new termini in parallel, up to
+     * TERMINUS_DISCOVERY_CONCURRENCY at a time */
+    std::map<pldm_tid_t, std::vector<uint8_t>> fruTables;
     {
-        if (terminus->initialized)
+        const size_t concurrency = std::max(TERMINUS_DISCOVERY_CONCURRENCY, 1);
+        exec::async_scope fruScope;
+        size_t inFlight = 0;
+        for (auto& [tid, terminus] : termini)
         {
-            continue;
-        }
-
-        /* Get Fru */
-        uint16_t totalTableRecords = 0;
-        if (terminus->doesSupportCommand(PLDM_FRU,
-                                         PLDM_GET_FRU_RECORD_TABLE_METADATA))
-        {
-            auto rc =
-                co_await getFRURecordTableMetadata(tid, &totalTableRecords);
-            if (rc)
+            if (terminus->initialized)
             {
-                lg2::error(
-                    "Failed to get FRU Metadata for terminus {TID}, error {ERROR}",
-                    "TID", tid, "ERROR", rc);
+                continue;
             }
-            if (!totalTableRecords)
+
+            fruScope.spawn(
+                fetchFruRecordTable(tid, fruTables[tid]) |
+                    stdexec::then([](int) {}),
+                exec::default_task_context<void>(exec::inline_scheduler{}));
+            if (++inFlight == concurrency)
             {
-                lg2::info("Fru record table meta data has 0 records");
+                co_await fruScope.on_empty();
+                inFlight = 0;
             }
         }
+        co_await fruScope.on_empty();
+    }
 
-        std::vector<uint8_t> fruData{};
-        if ((totalTableRecords != 0) &&
-            terminus->doesSupportCommand(PLDM_FRU, PLDM_GET_FRU_RECORD_TABLE))
+    for (auto& [tid, terminus] : termini)
+    {
+        if (terminus->initialized)
         {
-            auto rc =
-                co_await getFRURecordTables(tid, totalTableRecords, fruData);
-            if (rc)
-            {
-                lg2::error(
-                    "Failed to get Fru Record table for terminus {TID}, error {ERROR}",
-                    "TID", tid, "ERROR", rc);
-            }
+            continue;
         }
 
+        auto& fruData = fruTables[tid];
+
         if (terminus->doesSupportCommand(PLDM_PLATFORM, PLDM_GET_PDR))
         {
+            auto begin = std::chrono::steady_clock::now();
             auto rc = co_await getPDRs(terminus);
+            stats::StartupProfiler::getInstance().phase(
+                std::format("Terminus{}.PdrDownload", tid), begin);
             if (rc)
             {
                 lg2::error(
@@ -77,6 +86,7 @@ exec::task<int> PlatformManager::initTerminus()
         if (fruData.size())
         {
             updateInventoryWithFru(tid, fruData.data(), fruData.size());
+            fruTables.erase(tid);
         }
 
         uint16_t terminusMaxBufferSize = terminus->maxBufferSize;
@@ -110,6 +120,8 @@ exec::task<int> PlatformManager::initTerminus()
                 "TID", tid, "ERROR", rc);
         }
         terminus->initialized = true;
+        stats::StartupProfiler::getInstance().milestone(
+            std::format("Terminus{}.Initialized", tid));
         if (manager)
         {
             manager->startSensorPolling(tid);
@@ -125,6 +137,47 @@ exec::task<int> PlatformManager::initTerminus()
     co_return PLDM_SUCCESS;
 }
 
+exec::task<int> PlatformManager::fetchFruRecordTable(
+    pldm_tid_t tid, std::vector<uint8_t>& fruData)
+{
+    auto& terminus = termini[tid];
+    uint16_t totalTableRecords = 0;
+    uint32_t tableLength = 0;
+    if (terminus->doesSupportCommand(PLDM_FRU,
+                                     PLDM_GET_FRU_RECORD_TABLE_METADATA))
+    {
+        auto rc = co_await getFRURecordTableMetadata(tid, &totalTableRecords,
+                                                     &tableLength);
+        if (rc)
+        {
+            lg2::error(
+                "Failed to get FRU Metadata for terminus {TID}, error {ERROR}",
+                "TID", tid, "ERROR", rc);
+        }
+        if (!totalTableRecords)
+        {
+            lg2::info("Fru record table meta data has 0 records");
+        }
+    }
+
+    if (!totalTableRecords ||
+        !terminus->doesSupportCommand(PLDM_FRU, PLDM_GET_FRU_RECORD_TABLE))
+    {
+        co_return PLDM_SUCCESS;
+    }
+
+    auto rc = co_await getFRURecordTables(tid, totalTableRecords, tableLength,
+                                          fruData);
+    if (rc)
+    {
+        lg2::error(
+            "Failed to get Fru Record table for terminus {TID}, error {ERROR}",
+            "TID", tid, "ERROR", rc);
+        fruData.clear();
+    }
+    co_return rc;
+}
+
 exec::task<int> PlatformManager::configEventReceiver(pldm_tid_t tid)
 {
     if (!termini.contains(tid))
@@ -133,6 +186,8 @@ exec::task<int> PlatformManager::configEventReceiver(pldm_tid_t tid)
     }
 
     auto& terminus = termini[tid];
+    terminus->asyncSensorEvents = false;
+    bool sensorEventSupported = false;
     if (!terminus->doesSupportCommand(PLDM_PLATFORM,
                                       PLDM_EVENT_MESSAGE_SUPPORTED))
     {
@@ -159,6 +214,11 @@ exec::task<int> PlatformManager::configEventReceiver(pldm_tid_t tid)
                 "TID", tid, "ERROR", rc);
             terminus->synchronyConfigurationSupported.byte = 0;
         }
+        else
+        {
+            sensorEventSupported = std::ranges::contains(eventClass,
+                                                         PLDM_SENSOR_EVENT);
+        }
     }
 
     if (!terminus->doesSupportCommand(PLDM_PLATFORM, PLDM_SET_EVENT_RECEIVER))
@@ -216,6 +276,14 @@ exec::task<int> PlatformManager::configEventReceiver(pldm_tid_t tid)
                 "Failed to set event receiver for terminus with TID: {TID}, error: {ERROR}",
                 "TID", tid, "ERROR", rc);
         }
+        else if (sensorEventSupported &&
+                 eventMessageGlobalEnable !=
+                     PLDM_EVENT_MESSAGE_GLOBAL_ENABLE_POLLING)
+        {
+            terminus->asyncSensorEvents = true;
+            lg2::info("Terminus {TID} sends sensor events asynchronously",
+                      "TID", tid);
+        }
     }
 
     co_return PLDM_SUCCESS;
@@ -231,12 +299,14 @@ exec::task<int> PlatformManager::getPDRs(std::shared_ptr<Terminus> terminus)
     uint32_t recordCount = std::numeric_limits<uint32_t>::max();
     uint32_t repositorySize = 0;
     uint32_t largestRecordSize = std::numeric_limits<uint32_t>::max();
+    pdr::PdrRepositorySignature signature{};
+    std::optional<std::string> cacheKey;
     if (terminus->doesSupportCommand(PLDM_PLATFORM,
                                      PLDM_GET_PDR_REPOSITORY_INFO))
     {
-        auto rc =
-            co_await getPDRRepositoryInfo(tid, repositoryState, recordCount,
-                                          repositorySize, largestRecordSize);
+        auto rc = co_await getPDRRepositoryInfo(
+            tid, repositoryState, recordCount, repositorySize,
+            largestRecordSize, signature.updateTime, signature.oemUpdateTime);
         if (rc)
         {
             lg2::error(
@@ -245,6 +315,17 @@ exec::task<int> PlatformManager::getPDRs(std::shared_ptr<Terminus> terminus)
         }
         else
         {
+            signature.recordCount = recordCount;
+            signature.repositorySize = repositorySize;
+            signature.largestRecordSize = largestRecordSize;
+            /* Without an update time a changed repository of the same size
+             * can not be told apart from the cached one */
+            if (pdrCache.enabled() &&
+                std::ranges::any_of(signature.updateTime,
+                                    [](uint8_t byte) { return byte != 0; }))
+            {
+                cacheKey = getPdrCacheKey(tid);
+            }
             recordCount =
                 std::min(recordCount + 1, std::numeric_limits<uint32_t>::max());
             largestRecordSize = std::min(largestRecordSize + 1,
@@ -257,79 +338,247 @@ exec::task<int> PlatformManager::getPDRs(std::shared_ptr<Terminus> terminus)
         co_return PLDM_ERROR_NOT_READY;
     }
 
+    if (cacheKey)
+    {
+        auto cachedPdrs = pdrCache.load(*cacheKey, signature);
+        if (cachedPdrs)
+        {
+            terminus->pdrs = std::move(*cachedPdrs);
+            lg2::info("Loaded {COUNT} cached PDRs for terminus {TID}", "COUNT",
+                      terminus->pdrs.size(), "TID", tid);
+            co_return PLDM_SUCCESS;
+        }
+    }
+
     uint32_t recordHndl = 0;
     uint32_t nextRecordHndl = 0;
-    uint32_t nextDataTransferHndl = 0;
-    uint8_t transferFlag = 0;
-    uint16_t responseCnt = 0;
-    constexpr uint16_t recvBufSize = PLDM_PLATFORM_GETPDR_MAX_RECORD_BYTES;
-    std::vector<uint8_t> recvBuf(recvBufSize);
-    uint8_t transferCrc = 0;
 
     terminus->pdrs.clear();
+    if (signature.recordCount)
+    {
+        terminus->pdrs.reserve(signature.recordCount, repositorySize);
+    }
     uint32_t receivedRecordCount = 0;
 
+    /* Each record is copied into the arena, the buffer is reused */
+    std::vector<uint8_t> record;
     do
     {
-        auto rc =
-            co_await getPDR(tid, recordHndl, 0, PLDM_GET_FIRSTPART, recvBufSize,
-                            0, nextRecordHndl, nextDataTransferHndl,
-                            transferFlag, responseCnt, recvBuf, transferCrc);
+        auto rc = co_await getPDRRecord(tid, recordHndl, largestRecordSize,
+                                        nextRecordHndl, record);
+        if (rc)
+        {
+            terminus->pdrs.clear();
+            co_return rc;
+        }
+
+        if (!record.empty())
+        {
+            terminus->pdrs.emplace_back(record);
+            recordHndl = nextRecordHndl;
+        }
+        receivedRecordCount++;
+    } while (nextRecordHndl != 0 && receivedRecordCount < recordCount);
+    terminus->pdrs.shrink_to_fit();
+
+    if (cacheKey)
+    {
+        pdrCache.store(*cacheKey, signature, terminus->pdrs);
+    }
+
+    co_return PLDM_SUCCESS;
+}
+
+std::optional<std::string> PlatformManager::getPdrCacheKey(pldm_tid_t tid)
+{
+    auto mctpInfo = terminusManager.toMctpInfo(tid);
+    if (!mctpInfo)
+    {
+        return std::nullopt;
+    }
+
+    const auto& uuid = std::get<1>(mctpInfo.value());
+    if (!uuid.empty() && uuid != emptyUUID)
+    {
+        return "uuid_" + uuid;
+    }
 
+    return std::format("network{}_eid{}", std::get<3>(mctpInfo.value()),
+                       std::get<0>(mctpInfo.value()));
+}
+
+exec::task<int> PlatformManager::getPDRRecord(
+    const pldm_tid_t tid, const uint32_t recordHndl,
+    const uint32_t largestRecordSize, uint32_t& nextRecordHndl,
+    std::vector<uint8_t>& record)
+{
+    uint32_t dataTransferHndl = 0;
+    uint32_t nextDataTransferHndl = 0;
+    uint8_t transferOpFlag = PLDM_GET_FIRSTPART;
+    uint8_t transferFlag = 0;
+    uint16_t recordChgNum = 0;
+    uint16_t responseCnt = 0;
+    uint8_t transferCrc = 0;
+
+    /* The parts are received straight into the record */
+    record.clear();
+    record.reserve(std::min<size_t>(
+        largestRecordSize,
+        sizeof(pldm_pdr_hdr) + std::numeric_limits<uint16_t>::max()));
+    do
+    {
+        auto offset = record.size();
+        record.resize(offset + pdrTransferSize);
+        auto rc = co_await getPDR(
+            tid, recordHndl, dataTransferHndl, transferOpFlag,
+            pdrTransferSize, recordChgNum, nextRecordHndl,
+            nextDataTransferHndl, transferFlag, responseCnt,
+            std::span(record).subspan(offset), transferCrc);
         if (rc)
         {
             lg2::error(
-                "Failed to get PDRs for terminus {TID}, error: {RC}, first part of record handle {RECORD}",
-                "TID", tid, "RC", rc, "RECORD", recordHndl);
-            terminus->pdrs.clear();
+                "Failed to get PDRs for terminus {TID}, error: {RC}, part at offset {OFFSET} of record handle {RECORD}",
+                "TID", tid, "RC", rc, "OFFSET", offset, "RECORD", recordHndl);
+            record.clear();
             co_return rc;
         }
+        record.resize(offset + responseCnt);
 
         if (transferFlag == PLDM_PLATFORM_TRANSFER_START_AND_END)
         {
             // single-part
-            terminus->pdrs.emplace_back(std::vector<uint8_t>(
-                recvBuf.begin(), recvBuf.begin() + responseCnt));
-            recordHndl = nextRecordHndl;
+            co_return PLDM_SUCCESS;
         }
-        else
+
+        if (transferOpFlag == PLDM_GET_FIRSTPART &&
+            record.size() >= sizeof(pldm_pdr_hdr))
         {
-            // multipart transfer
-            uint32_t receivedRecordSize = responseCnt;
-            auto pdrHdr = new (recvBuf.data()) pldm_pdr_hdr;
-            uint16_t recordChgNum = le16toh(pdrHdr->record_change_num);
-            std::vector<uint8_t> receivedPdr(recvBuf.begin(),
-                                             recvBuf.begin() + responseCnt);
-            do
+            auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(record.data());
+            recordChgNum = le16toh(pdrHdr->record_change_num);
+        }
+
+        if (transferFlag == PLDM_PLATFORM_TRANSFER_END)
+        {
+            /* The CRC of the last part covers the whole record */
+            if (crc8(record.data(), record.size()) != transferCrc)
             {
-                rc = co_await getPDR(
-                    tid, recordHndl, nextDataTransferHndl, PLDM_GET_NEXTPART,
-                    recvBufSize, recordChgNum, nextRecordHndl,
-                    nextDataTransferHndl, transferFlag, responseCnt, recvBuf,
-                    transferCrc);
-                if (rc)
-                {
-                    lg2::error(
-                        "Failed to get PDRs for terminus {TID}, error: {RC}, get middle part of record handle {RECORD}",
-                        "TID", tid, "RC", rc, "RECORD", recordHndl);
-                    terminus->pdrs.clear();
-                    co_return rc;
-                }
-
-                receivedPdr.insert(receivedPdr.end(), recvBuf.begin(),
-                                   recvBuf.begin() + responseCnt);
-                receivedRecordSize += responseCnt;
-
-                if (transferFlag == PLDM_PLATFORM_TRANSFER_END)
-                {
-                    terminus->pdrs.emplace_back(std::move(receivedPdr));
-                    recordHndl = nextRecordHndl;
-                }
-            } while (nextDataTransferHndl != 0 &&
-                     receivedRecordSize < largestRecordSize);
+                lg2::error(
+                    "Mismatched CRC of multipart record handle {RECORD} from terminus {TID}",
+                    "RECORD", recordHndl, "TID", tid);
+                record.clear();
+                co_return PLDM_ERROR;
+            }
+            co_return PLDM_SUCCESS;
         }
-        receivedRecordCount++;
-    } while (nextRecordHndl != 0 && receivedRecordCount < recordCount);
+
+        transferOpFlag = PLDM_GET_NEXTPART;
+        dataTransferHndl = nextDataTransferHndl;
+    } while (nextDataTransferHndl != 0 && record.size() < largestRecordSize);
+
+    record.clear();
+    co_return PLDM_SUCCESS;
+}
+
+exec::task<int> PlatformManager::syncPDRs(pldm_tid_t tid)
+{
+    if (!termini.contains(tid) || !termini[tid])
+    {
+        co_return PLDM_ERROR;
+    }
+
+    auto terminus = termini[tid];
+    auto changes = std::exchange(terminus->pdrChanges, {});
+    if (changes.empty())
+    {
+        co_return PLDM_SUCCESS;
+    }
+
+    /* The updated repository is cached on the next full fetch */
+    if (pdrCache.enabled())
+    {
+        auto cacheKey = getPdrCacheKey(tid);
+        if (cacheKey)
+        {
+            pdrCache.remove(*cacheKey);
+        }
+    }
+
+    auto recordHandle = [](std::span<const uint8_t> pdr) {
+        auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(pdr.data());
+        return static_cast<RecordHandle>(le32toh(pdrHdr->record_handle));
+    };
+
+    std::map<RecordHandle, std::vector<uint8_t>> records;
+    std::set<RecordHandle> deletedRecords;
+    if (changes.refreshAll)
+    {
+        /* Fetch the whole repository and only apply the records which
+         * differ from the stored ones */
+        auto storedPdrs = std::move(terminus->pdrs);
+        auto rc = co_await getPDRs(terminus);
+        auto fetchedPdrs = std::exchange(terminus->pdrs, std::move(storedPdrs));
+        if (rc)
+        {
+            lg2::error(
+                "Failed to refresh PDRs for terminus with TID: {TID}, error: {ERROR}",
+                "TID", tid, "ERROR", rc);
+            terminus->pdrChanges.merge(changes);
+            co_return rc;
+        }
+
+        std::map<RecordHandle, std::span<const uint8_t>> stored;
+        for (auto pdr : terminus->pdrs)
+        {
+            stored.emplace(recordHandle(pdr), pdr);
+        }
+        for (auto pdr : fetchedPdrs)
+        {
+            auto handle = recordHandle(pdr);
+            auto it = stored.find(handle);
+            if (it == stored.end() || !std::ranges::equal(it->second, pdr))
+            {
+                records.emplace(handle,
+                                std::vector<uint8_t>(pdr.begin(), pdr.end()));
+            }
+            if (it != stored.end())
+            {
+                stored.erase(it);
+            }
+        }
+        for (const auto& [handle, pdr] : stored)
+        {
+            deletedRecords.insert(handle);
+        }
+    }
+    else
+    {
+        for (auto handle : changes.changedRecords)
+        {
+            uint32_t nextRecordHndl = 0;
+            std::vector<uint8_t> record;
+            auto rc = co_await getPDRRecord(
+                tid, handle, std::numeric_limits<uint32_t>::max(),
+                nextRecordHndl, record);
+            if (rc || record.empty())
+            {
+                lg2::error(
+                    "Failed to get changed PDR {RECORD} for terminus with TID: {TID}, error: {ERROR}",
+                    "RECORD", handle, "TID", tid, "ERROR", rc);
+                terminus->pdrChanges.merge(changes);
+                co_return rc ? rc : PLDM_ERROR;
+            }
+            records.emplace(handle, std::move(record));
+        }
+        deletedRecords = std::move(changes.deletedRecords);
+    }
+
+    /* The terminus may have been removed while fetching */
+    if (!termini.contains(tid) || termini[tid] != terminus)
+    {
+        co_return PLDM_ERROR;
+    }
+
+    terminus->updateTerminusPDRs(records, deletedRecords);
 
     co_return PLDM_SUCCESS;
 }
@@ -340,10 +589,10 @@ exec::task<int> PlatformManager::getPDR(
     const uint16_t requestCnt, const uint16_t recordChgNum,
     uint32_t& nextRecordHndl, uint32_t& nextDataTransferHndl,
     uint8_t& transferFlag, uint16_t& responseCnt,
-    std::vector<uint8_t>& recordData, uint8_t& transferCrc)
+    std::span<uint8_t> recordData, uint8_t& transferCrc)
 {
-    Request request(sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES);
-    auto requestMsg = new (request.data()) pldm_msg;
+    PldmMsg<PLDM_GET_PDR_REQ_BYTES> request;
+    auto requestMsg = request.msg();
     auto rc = encode_get_pdr_req(0, recordHndl, dataTransferHndl,
                                  transferOpFlag, requestCnt, recordChgNum,
                                  requestMsg, PLDM_GET_PDR_REQ_BYTES);
@@ -392,10 +641,12 @@ exec::task<int> PlatformManager::getPDR(
 
 exec::task<int> PlatformManager::getPDRRepositoryInfo(
     const pldm_tid_t tid, uint8_t& repositoryState, uint32_t& recordCount,
-    uint32_t& repositorySize, uint32_t& largestRecordSize)
+    uint32_t& repositorySize, uint32_t& largestRecordSize,
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE>& updateTime,
+    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE>& oemUpdateTime)
 {
-    Request request(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
-    auto requestMsg = new (request.data()) pldm_msg;
+    PldmMsg<sizeof(uint8_t)> request;
+    auto requestMsg = request.msg();
     auto rc = encode_pldm_header_only(PLDM_REQUEST, 0, PLDM_PLATFORM,
                                       PLDM_GET_PDR_REPOSITORY_INFO, requestMsg);
     if (rc)
@@ -419,8 +670,6 @@ exec::task<int> PlatformManager::getPDRRepositoryInfo(
     }
 
     uint8_t completionCode = 0;
-    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> updateTime = {};
-    std::array<uint8_t, PLDM_TIMESTAMP104_SIZE> oemUpdateTime = {};
     uint8_t dataTransferHandleTimeout = 0;
 
     rc = decode_get_pdr_repository_info_resp(
@@ -450,9 +699,8 @@ exec::task<int> PlatformManager::eventMessageBufferSize(
     pldm_tid_t tid, uint16_t receiverMaxBufferSize,
     uint16_t& terminusBufferSize)
 {
-    Request request(
-        sizeof(pldm_msg_hdr) + PLDM_EVENT_MESSAGE_BUFFER_SIZE_REQ_BYTES);
-    auto requestMsg = new (request.data()) pldm_msg;
+    PldmMsg<PLDM_EVENT_MESSAGE_BUFFER_SIZE_REQ_BYTES> request;
+    auto requestMsg = request.msg();
     auto rc = encode_event_message_buffer_size_req(0, receiverMaxBufferSize,
                                                    requestMsg);
     if (rc)
@@ -511,8 +759,8 @@ exec::task<int> PlatformManager::setEventReceiver(
     {
         requestBytes = requestBytes - sizeof(heartbeatTimer);
     }
-    Request request(sizeof(pldm_msg_hdr) + requestBytes);
-    auto requestMsg = new (request.data()) pldm_msg;
+    RequestMsg request(sizeof(pldm_msg_hdr) + requestBytes);
+    auto requestMsg = request.msg();
     auto rc = encode_set_event_receiver_req(
         0, eventMessageGlobalEnable, protocolType,
         terminusManager.getLocalEid(), heartbeatTimer, requestMsg);
@@ -563,9 +811,8 @@ exec::task<int> PlatformManager::eventMessageSupported(
     bitfield8_t& synchronyConfigurationSupported,
     uint8_t& numberEventClassReturned, std::vector<uint8_t>& eventClass)
 {
-    Request request(
-        sizeof(pldm_msg_hdr) + PLDM_EVENT_MESSAGE_SUPPORTED_REQ_BYTES);
-    auto requestMsg = new (request.data()) pldm_msg;
+    PldmMsg<PLDM_EVENT_MESSAGE_SUPPORTED_REQ_BYTES> request;
+    auto requestMsg = request.msg();
     auto rc = encode_event_message_supported_req(0, formatVersion, requestMsg);
     if (rc)
     {
@@ -615,12 +862,11 @@ exec::task<int> PlatformManager::eventMessageSupported(
     co_return completionCode;
 }
 
-exec::task<int> PlatformManager::getFRURecordTableMetadata(pldm_tid_t tid,
-                                                           uint16_t* total)
+exec::task<int> PlatformManager::getFRURecordTableMetadata(
+    pldm_tid_t tid, uint16_t* total, uint32_t* tableLength)
 {
-    Request request(
-        sizeof(pldm_msg_hdr) + PLDM_GET_FRU_RECORD_TABLE_METADATA_REQ_BYTES);
-    auto requestMsg = new (request.data()) pldm_msg;
+    PldmMsg<PLDM_GET_FRU_RECORD_TABLE_METADATA_REQ_BYTES> request;
+    auto requestMsg = request.msg();
 
     auto rc = encode_get_fru_record_table_metadata_req(
         0, requestMsg, PLDM_GET_FRU_RECORD_TABLE_METADATA_REQ_BYTES);
@@ -655,12 +901,12 @@ exec::task<int> PlatformManager::getFRURecordTableMetadata(pldm_tid_t tid,
     }
 
     uint8_t fru_data_major_version, fru_data_minor_version;
-    uint32_t fru_table_maximum_size, fru_table_length;
+    uint32_t fru_table_maximum_size;
     uint16_t total_record_set_identifiers;
     uint32_t checksum;
     rc = decode_get_fru_record_table_metadata_resp(
         responseMsg, responseLen, &completionCode, &fru_data_major_version,
-        &fru_data_minor_version, &fru_table_maximum_size, &fru_table_length,
+        &fru_data_minor_version, &fru_table_maximum_size, tableLength,
         &total_record_set_identifiers, total, &checksum);
 
     if (rc)
@@ -688,8 +934,8 @@ exec::task<int> PlatformManager::getFRURecordTable(
     uint8_t* transferFlag, size_t* responseCnt,
     std::vector<uint8_t>& recordData)
 {
-    Request request(sizeof(pldm_msg_hdr) + PLDM_GET_FRU_RECORD_TABLE_REQ_BYTES);
-    auto requestMsg = new (request.data()) pldm_msg;
+    PldmMsg<PLDM_GET_FRU_RECORD_TABLE_REQ_BYTES> request;
+    auto requestMsg = request.msg();
 
     auto rc = encode_get_fru_record_table_req(
         0, dataTransferHndl, transferOpFlag, requestMsg,
@@ -723,10 +969,21 @@ exec::task<int> PlatformManager::getFRURecordTable(
         co_return rc;
     }
 
+    /* The part is decoded straight into the end of the table, sized for
+     * the largest part the response can hold */
+    auto payloadLength = responseLen - sizeof(pldm_msg_hdr);
+    auto offset = recordData.size();
+    if (payloadLength > PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES)
+    {
+        recordData.resize(offset + payloadLength -
+                          PLDM_GET_FRU_RECORD_TABLE_MIN_RESP_BYTES);
+    }
     auto responsePtr = reinterpret_cast<const struct pldm_msg*>(responseMsg);
+    *responseCnt = 0;
     rc = decode_get_fru_record_table_resp(
-        responsePtr, responseLen - sizeof(pldm_msg_hdr), &completionCode,
-        nextDataTransferHndl, transferFlag, recordData.data(), responseCnt);
+        responsePtr, payloadLength, &completionCode, nextDataTransferHndl,
+        transferFlag, recordData.data() + offset, responseCnt);
+    recordData.resize(offset + *responseCnt);
 
     if (rc)
     {
@@ -761,7 +1018,7 @@ void PlatformManager::updateInventoryWithFru(
 
 exec::task<int> PlatformManager::getFRURecordTables(
     pldm_tid_t tid, const uint16_t& totalTableRecords,
-    std::vector<uint8_t>& fruData)
+    const uint32_t tableLength, std::vector<uint8_t>& fruData)
 {
     if (!totalTableRecords)
     {
@@ -769,20 +1026,21 @@ exec::task<int> PlatformManager::getFRURecordTables(
         co_return PLDM_ERROR;
     }
 
+    /* The length comes from the terminus, cap what is reserved up front */
+    constexpr size_t maxReservedFruTableSize = 64 * 1024;
+    fruData.clear();
+    fruData.reserve(std::min<size_t>(tableLength, maxReservedFruTableSize));
+
     uint32_t dataTransferHndl = 0;
     uint32_t nextDataTransferHndl = 0;
     uint8_t transferFlag = 0;
     uint8_t transferOpFlag = PLDM_GET_FIRSTPART;
     size_t responseCnt = 0;
-    std::vector<uint8_t> recvBuf(PLDM_PLATFORM_GETPDR_MAX_RECORD_BYTES);
-
-    size_t fruLength = 0;
-    std::vector<uint8_t> receivedFru(0);
     do
     {
         auto rc = co_await getFRURecordTable(
             tid, dataTransferHndl, transferOpFlag, &nextDataTransferHndl,
-            &transferFlag, &responseCnt, recvBuf);
+            &transferFlag, &responseCnt, fruData);
 
         if (rc)
         {
@@ -792,9 +1050,6 @@ exec::task<int> PlatformManager::getFRURecordTables(
             co_return rc;
         }
 
-        receivedFru.insert(receivedFru.end(), recvBuf.begin(),
-                           recvBuf.begin() + responseCnt);
-        fruLength += responseCnt;
         if (transferFlag == PLDM_PLATFORM_TRANSFER_START_AND_END ||
             transferFlag == PLDM_PLATFORM_TRANSFER_END)
         {
@@ -807,16 +1062,6 @@ exec::task<int> PlatformManager::getFRURecordTables(
 
     } while (nextDataTransferHndl != 0);
 
-    if (fruLength != receivedFru.size())
-    {
-        lg2::error(
-            "Size of Fru Record Data {SIZE} for terminus {TID} is different the responded size {RSPSIZE}.",
-            "SIZE", receivedFru.size(), "RSPSIZE", fruLength);
-        co_return PLDM_ERROR_INVALID_LENGTH;
-    }
-
-    fruData = receivedFru;
-
     co_return PLDM_SUCCESS;
 }
 
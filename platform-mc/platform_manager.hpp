@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/pdr_cache.hpp"
 #include "terminus.hpp"
 #include "terminus_manager.hpp"
 
@@ -7,6 +8,11 @@
 #include <libpldm/platform.h>
 #include <libpldm/pldm.h>
 
+#include <array>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
 #include <vector>
 
 namespace pldm
@@ -30,9 +36,19 @@ class PlatformManager
     PlatformManager& operator=(PlatformManager&&) = delete;
     ~PlatformManager() = default;
 
+    /** @brief Constructor
+     *
+     *  @param[in] terminusManager - TerminusManager sending the requests
+     *  @param[in] termini - Managed termini list
+     *  @param[in] manager - Platform-mc manager, may be nullptr
+     *  @param[in] pdrCacheDir - Directory of the persistent PDR cache, empty
+     *                           to always fetch the PDRs from the termini
+     */
     explicit PlatformManager(TerminusManager& terminusManager,
-                             TerminiMapper& termini, Manager* manager) :
-        terminusManager(terminusManager), termini(termini), manager(manager)
+                             TerminiMapper& termini, Manager* manager,
+                             const std::filesystem::path& pdrCacheDir = {}) :
+        terminusManager(terminusManager), termini(termini), manager(manager),
+        pdrCache(pdrCacheDir)
     {}
 
     /** @brief Initialize terminus which supports PLDM Type 2
@@ -48,6 +64,17 @@ class PlatformManager
      */
     exec::task<int> configEventReceiver(pldm_tid_t tid);
 
+    /** @brief Apply the PDR repository changes reported by a terminus
+     *
+     *  Only the added and modified PDRs are fetched, unless the terminus
+     *  asked for a refresh of the whole repository. Changes which could not
+     *  be fetched stay pending.
+     *
+     *  @param[in] tid - Destination TID
+     *  @return coroutine return_value - PLDM completion code
+     */
+    exec::task<int> syncPDRs(pldm_tid_t tid);
+
   private:
     /** @brief Fetch all PDRs from terminus.
      *
@@ -56,6 +83,31 @@ class PlatformManager
      */
     exec::task<int> getPDRs(std::shared_ptr<Terminus> terminus);
 
+    /** @brief Get the key of a terminus in the PDR cache
+     *
+     *  The endpoint UUID identifies the terminus across reboots and MCTP
+     *  resets, the network and EID are used when the endpoint has no UUID.
+     *
+     *  @param[in] tid - TID of the terminus
+     *  @return the cache key, std::nullopt if the TID is not mapped
+     */
+    std::optional<std::string> getPdrCacheKey(pldm_tid_t tid);
+
+    /** @brief Fetch one complete PDR from terminus
+     *
+     *  @param[in] tid - Destination TID
+     *  @param[in] recordHndl - Record handle
+     *  @param[in] largestRecordSize - Size limit of a multipart record, also
+     *                                  preallocated for the record
+     *  @param[out] nextRecordHndl - Next record handle
+     *  @param[out] record - The PDR, empty if the transfer did not complete
+     *  @return coroutine return_value - PLDM completion code
+     */
+    exec::task<int> getPDRRecord(
+        const pldm_tid_t tid, const uint32_t recordHndl,
+        const uint32_t largestRecordSize, uint32_t& nextRecordHndl,
+        std::vector<uint8_t>& record);
+
     /** @brief Fetch PDR from terminus
      *
      *  @param[in] tid - Destination TID
@@ -68,7 +120,8 @@ class PlatformManager
      *  @param[out] nextDataTransferHndl - Next data transfer handle
      *  @param[out] transferFlag - Transfer flag
      *  @param[out] responseCnt - Response count of record data
-     *  @param[out] recordData - Returned record data
+     *  @param[out] recordData - Buffer receiving the record data, of at least
+     *                           requestCnt bytes
      *  @param[out] transferCrc - CRC value when record data is last part of PDR
      *  @return coroutine return_value - PLDM completion code
      */
@@ -78,7 +131,7 @@ class PlatformManager
         const uint16_t requestCnt, const uint16_t recordChgNum,
         uint32_t& nextRecordHndl, uint32_t& nextDataTransferHndl,
         uint8_t& transferFlag, uint16_t& responseCnt,
-        std::vector<uint8_t>& recordData, uint8_t& transferCrc);
+        std::span<uint8_t> recordData, uint8_t& transferCrc);
 
     /** @brief get PDR repository information.
      *
@@ -87,12 +140,16 @@ class PlatformManager
      *  @param[out] recordCount - number of records
      *  @param[out] repositorySize - repository size
      *  @param[out] largestRecordSize - largest record size
+     *  @param[out] updateTime - time of the last repository update
+     *  @param[out] oemUpdateTime - time of the last OEM repository update
      * *
      *  @return coroutine return_value - PLDM completion code
      */
     exec::task<int> getPDRRepositoryInfo(
         const pldm_tid_t tid, uint8_t& repositoryState, uint32_t& recordCount,
-        uint32_t& repositorySize, uint32_t& largestRecordSize);
+        uint32_t& repositorySize, uint32_t& largestRecordSize,
+        std::array<uint8_t, PLDM_TIMESTAMP104_SIZE>& updateTime,
+        std::array<uint8_t, PLDM_TIMESTAMP104_SIZE>& oemUpdateTime);
 
     /** @brief Send setEventReceiver command to destination EID.
      *
@@ -139,13 +196,24 @@ class PlatformManager
         bitfield8_t& synchronyConfigurationSupported,
         uint8_t& numerEventClassReturned, std::vector<uint8_t>& eventClass);
 
+    /** @brief Fetch the FRU record table of a terminus supporting it
+     *
+     *  @param[in] tid - Destination TID
+     *  @param[out] fruData - Returned fru record table data, empty if the
+     *                        terminus has none or it could not be fetched
+     */
+    exec::task<int> fetchFruRecordTable(pldm_tid_t tid,
+                                        std::vector<uint8_t>& fruData);
+
     /** @brief Get FRU Record Tables from remote MCTP Endpoint
      *
      *  @param[in] tid - Destination TID
      *  @param[in] total - Total number of record in table
+     *  @param[in] tableLength - Length of the table from its metadata
      *  @param[out] fruData - Returned fru record table data
      */
     exec::task<int> getFRURecordTables(pldm_tid_t tid, const uint16_t& total,
+                                       const uint32_t tableLength,
                                        std::vector<uint8_t>& fruData);
 
     /** @brief Fetch FRU Record Data from terminus
@@ -156,7 +224,7 @@ class PlatformManager
      *  @param[out] nextDataTransferHndl - Next data transfer handle
      *  @param[out] transferFlag - Transfer flag
      *  @param[out] responseCnt - Response count of record data
-     *  @param[out] recordData - Returned record data
+     *  @param[in,out] recordData - The record data of the part is appended
      *
      *  @return coroutine return_value - PLDM completion code
      */
@@ -170,8 +238,10 @@ class PlatformManager
      *
      *  @param[in] tid - Destination TID
      *  @param[out] total - Total number of record in table
+     *  @param[out] tableLength - Length of the table in bytes
      */
-    exec::task<int> getFRURecordTableMetadata(pldm_tid_t tid, uint16_t* total);
+    exec::task<int> getFRURecordTableMetadata(pldm_tid_t tid, uint16_t* total,
+                                              uint32_t* tableLength);
 
     /** @brief Parse record data from FRU table
      *
@@ -193,6 +263,12 @@ class PlatformManager
      *        and other platform-level PLDM operations.
      */
     Manager* manager;
+
+    /** @brief Record data bytes requested by each GetPDR */
+    const uint16_t pdrTransferSize = PDR_TRANSFER_SIZE;
+
+    /** @brief PDRs of the termini kept across restarts */
+    pdr::PdrCache pdrCache;
 };
 } // namespace platform_mc
 } // namespace pldm
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace pldm
+{
+namespace platform_mc
+{
+
+/** @struct SensorSample
+ *
+ *  One reading of a numeric sensor
+ */
+struct SensorSample
+{
+    uint64_t timeStamp; //!< time of the reading in usec, CLOCK_MONOTONIC
+    double value;       //!< value in the sensor Units, NaN when unavailable
+
+    bool operator==(const SensorSample&) const = default;
+};
+
+/**
+ * @brief SensorHistory
+ *
+ * Ring of the most recent readings of a sensor, allocated once for its
+ * capacity. The average is kept up to date as samples come and go, the
+ * minimum and maximum are only searched again when the sample holding them
+ * leaves the window. Unavailable readings are kept but not aggregated.
+ */
+class SensorHistory
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] capacity - number of samples kept, 0 keeps none
+     */
+    explicit SensorHistory(size_t capacity = 0) : samples(capacity) {}
+
+    /** @brief Maximum number of samples kept */
+    size_t capacity() const
+    {
+        return samples.size();
+    }
+
+    /** @brief Number of samples kept */
+    size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return !count;
+    }
+
+    /** @brief Add a sample, replacing the oldest one once full */
+    void push(uint64_t timeStamp, double value)
+    {
+        if (samples.empty())
+        {
+            return;
+        }
+
+        if (count == samples.size())
+        {
+            auto& oldest = samples[head];
+            if (std::isfinite(oldest.value))
+            {
+                finiteCount--;
+                sum -= oldest.value;
+                if (oldest.value <= minValue || oldest.value >= maxValue)
+                {
+                    extremaValid = false;
+                }
+            }
+        }
+        else
+        {
+            count++;
+        }
+
+        samples[head] = {timeStamp, value};
+        head = (head + 1) % samples.size();
+
+        if (!std::isfinite(value))
+        {
+            return;
+        }
+        if (!finiteCount++)
+        {
+            /* Nothing left to drift from */
+            sum = 0;
+            minValue = value;
+            maxValue = value;
+            extremaValid = true;
+        }
+        sum += value;
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+
+    /** @brief Remove all the samples */
+    void clear()
+    {
+        head = 0;
+        count = 0;
+        finiteCount = 0;
+        sum = 0;
+        extremaValid = true;
+    }
+
+    /** @brief Get the samples, the oldest first */
+    std::vector<SensorSample> getSamples() const
+    {
+        std::vector<SensorSample> ordered;
+        if (!count)
+        {
+            return ordered;
+        }
+        ordered.reserve(count);
+        auto first = (head + samples.size() - count) % samples.size();
+        for (size_t i = 0; i < count; i++)
+        {
+            ordered.emplace_back(samples[(first + i) % samples.size()]);
+        }
+        return ordered;
+    }
+
+    /** @brief Lowest available value in the window, NaN if none */
+    double min() const
+    {
+        updateExtrema();
+        return finiteCount ? minValue
+                           : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    /** @brief Highest available value in the window, NaN if none */
+    double max() const
+    {
+        updateExtrema();
+        return finiteCount ? maxValue
+                           : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    /** @brief Average of the available values in the window, NaN if none */
+    double average() const
+    {
+        return finiteCount ? sum / finiteCount
+                           : std::numeric_limits<double>::quiet_NaN();
+    }
+
+  private:
+    /** @brief Search the extrema again once the sample with one left */
+    void updateExtrema() const
+    {
+        if (extremaValid)
+        {
+            return;
+        }
+
+        minValue = std::numeric_limits<double>::infinity();
+        maxValue = -std::numeric_limits<double>::infinity();
+        auto first = (head + samples.size() - count) % samples.size();
+        for (size_t i = 0; i < count; i++)
+        {
+            auto value = samples[(first + i) % samples.size()].value;
+            if (std::isfinite(value))
+            {
+                minValue = std::min(minValue, value);
+                maxValue = std::max(maxValue, value);
+            }
+        }
+        extremaValid = true;
+    }
+
+    /** @brief Ring of samples, allocated for the capacity */
+    std::vector<SensorSample> samples;
+
+    /** @brief Index the next sample is written at */
+    size_t head = 0;
+
+    /** @brief Number of samples kept */
+    size_t count = 0;
+
+    /** @brief Number of available samples kept */
+    size_t finiteCount = 0;
+
+    /** @brief Sum of the available samples kept */
+    double sum = 0;
+
+    mutable double minValue = 0;
+    mutable double maxValue = 0;
+    mutable bool extremaValid = true;
+};
+
+} // namespace platform_mc
+} // namespace pldm
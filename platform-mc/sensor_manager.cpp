@@ -1,11 +1,18 @@
 #include "sensor_manager.hpp"
 
+#include "common/daemon_stats.hpp"
+#include "common/startup_profiler.hpp"
+#include "common/trace.hpp"
 #include "manager.hpp"
 #include "terminus_manager.hpp"
 
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
 #include <exception>
+#include <format>
+#include <utility>
+#include <vector>
 
 namespace pldm
 {
@@ -16,31 +23,45 @@ SensorManager::SensorManager(sdeventplus::Event& event,
                              TerminusManager& terminusManager,
                              TerminiMapper& termini, Manager* manager) :
     event(event), terminusManager(terminusManager), termini(termini),
-    pollingTime(SENSOR_POLLING_TIME), manager(manager)
+    pollingTime(SENSOR_POLLING_TIME),
+    pollingConcurrency(std::max(SENSOR_POLLING_CONCURRENCY, 1)),
+    eventKeepAliveTime(SENSOR_EVENT_KEEPALIVE_INTERVAL * 1000000ULL),
+    manager(manager)
 {}
 
 void SensorManager::startPolling(pldm_tid_t tid)
 {
-    if (!termini.contains(tid))
+    auto it = termini.find(tid);
+    if (it == termini.end())
     {
         return;
     }
 
-    /* tid already initializes roundRobinSensors list */
-    if (sensorPollTimers.contains(tid))
+    auto& state = pollStates[tid];
+    /* tid already initializes its sensor polling queue */
+    if (state.timer)
     {
         lg2::info("Terminus ID {TID}: sensor poll timer already exists.", "TID",
                   tid);
         return;
     }
 
-    roundRobinSensorItMap[tid] = 0;
+    state.terminus = it->second;
+    state.queue.clear();
 
     updateAvailableState(tid, true);
 
-    sensorPollTimers[tid] = std::make_unique<sdbusplus::Timer>(
-        event.get(),
-        std::bind_front(&SensorManager::doSensorPolling, this, tid));
+    state.timer = std::make_unique<sdbusplus::Timer>(event.get(), [this, tid] {
+        stats::DaemonStats::getInstance().setLoopActivity(
+            "SensorManager polling", tid);
+        // The first cycle is phase shifted, settle on the period
+        auto& state = pollStates[tid];
+        if (std::exchange(state.phased, false))
+        {
+            state.timer->start(getPollingTime(tid), true);
+        }
+        doSensorPolling(tid);
+    });
 
     startSensorPollTimer(tid);
 }
@@ -49,12 +70,12 @@ void SensorManager::startSensorPollTimer(pldm_tid_t tid)
 {
     try
     {
-        if (sensorPollTimers[tid] && !sensorPollTimers[tid]->isRunning())
+        auto& state = pollStates[tid];
+        if (state.timer && !state.timer->isRunning())
         {
-            sensorPollTimers[tid]->start(
-                duration_cast<std::chrono::milliseconds>(
-                    std::chrono::milliseconds(pollingTime)),
-                true);
+            auto phase = getPollingPhase(tid);
+            state.phased = phase.count() != 0;
+            state.timer->start(getPollingTime(tid) + phase, true);
         }
     }
     catch (const std::exception& e)
@@ -84,49 +105,65 @@ void SensorManager::disableTerminusSensors(pldm_tid_t tid)
     {
         sensor->updateReading(true, false,
                               std::numeric_limits<double>::quiet_NaN());
+        sensor->emitPropertiesChanged();
     }
 }
 
 void SensorManager::stopPolling(pldm_tid_t tid)
 {
+    auto& state = pollStates[tid];
+
     /* Stop polling timer */
-    if (sensorPollTimers.contains(tid))
+    if (state.timer)
+    {
+        state.timer->stop();
+        state.timer.reset();
+    }
+    state.phased = false;
+
+    state.queue.clear();
+    state.stats = {};
+
+    /* Outstanding reads complete stopped, resuming the polling task */
+    if (state.readScope)
     {
-        sensorPollTimers[tid]->stop();
-        sensorPollTimers.erase(tid);
+        state.readScope->request_stop();
+        state.readScope.reset();
     }
 
-    roundRobinSensorItMap.erase(tid);
+    if (state.eventPollScope)
+    {
+        state.eventPollScope->request_stop();
+        state.eventPollScope.reset();
+    }
+    state.eventPollInProgress = false;
 
-    if (doSensorPollingTaskHandles.contains(tid))
+    if (state.taskScope)
     {
-        auto& [scope, rcOpt] = doSensorPollingTaskHandles[tid];
-        scope.request_stop();
-        doSensorPollingTaskHandles.erase(tid);
+        state.taskScope->request_stop();
+        state.taskScope.reset();
     }
+    state.taskRc.reset();
 
-    availableState.erase(tid);
+    state.available = false;
+    state.terminus.reset();
 }
 
 void SensorManager::doSensorPolling(pldm_tid_t tid)
 {
-    auto it = doSensorPollingTaskHandles.find(tid);
-    if (it != doSensorPollingTaskHandles.end())
+    auto& state = pollStates[tid];
+    if (state.taskScope)
     {
-        auto& [scope, rcOpt] = it->second;
-        if (!rcOpt.has_value())
+        if (!state.taskRc.has_value())
         {
             return;
         }
-        doSensorPollingTaskHandles.erase(tid);
+        state.taskScope.reset();
     }
 
-    auto& [scope, rcOpt] =
-        doSensorPollingTaskHandles
-            .emplace(std::piecewise_construct, std::forward_as_tuple(tid),
-                     std::forward_as_tuple())
-            .first->second;
-    scope.spawn(
+    auto& rcOpt = state.taskRc;
+    rcOpt.reset();
+    state.taskScope.emplace().spawn(
         stdexec::just() | stdexec::let_value([this, &rcOpt,
                                               tid] -> exec::task<void> {
             auto res =
@@ -140,11 +177,9 @@ void SensorManager::doSensorPolling(pldm_tid_t tid)
                 lg2::info("Stopped polling for Terminus ID {TID}", "TID", tid);
                 try
                 {
-                    if (sensorPollTimers.contains(tid) &&
-                        sensorPollTimers[tid] &&
-                        sensorPollTimers[tid]->isRunning())
+                    if (isPolling(tid))
                     {
-                        sensorPollTimers[tid]->stop();
+                        pollStates[tid].timer->stop();
                     }
                 }
                 catch (const std::exception& e)
@@ -159,23 +194,46 @@ void SensorManager::doSensorPolling(pldm_tid_t tid)
         exec::default_task_context<void>(exec::inline_scheduler{}));
 }
 
+exec::task<int> SensorManager::pollForPlatformEvent(pldm_tid_t tid)
+{
+    if (!manager || pollStates[tid].eventPollInProgress)
+    {
+        co_return PLDM_SUCCESS;
+    }
+
+    pollStates[tid].eventPollInProgress = true;
+    co_return co_await drainPolledEvents(tid, 0, 0);
+}
+
+exec::task<int> SensorManager::drainPolledEvents(
+    pldm_tid_t tid, uint16_t pollEventId, uint32_t pollDataTransferHandle)
+{
+    auto rc = co_await manager->pollForPlatformEvent(tid, pollEventId,
+                                                     pollDataTransferHandle);
+    pollStates[tid].eventPollInProgress = false;
+    co_return rc;
+}
+
 exec::task<int> SensorManager::doSensorPollingTask(pldm_tid_t tid)
 {
+    auto& state = pollStates[tid];
     uint64_t t0 = 0;
     uint64_t t1 = 0;
-    uint64_t elapsed = 0;
-    uint64_t pollingTimeInUsec = pollingTime * 1000;
-    uint8_t rc = PLDM_SUCCESS;
+    uint64_t pollingTimeInUsec =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            getPollingTime(tid))
+            .count();
 
     do
     {
-        if ((!sensorPollTimers.contains(tid)) ||
-            (sensorPollTimers[tid] && !sensorPollTimers[tid]->isRunning()))
+        if (!isPolling(tid))
         {
             co_return PLDM_ERROR;
         }
 
         sd_event_now(event.get(), CLOCK_MONOTONIC, &t0);
+        PLDM_TRACE_ASYNC_SPAN("sensor.poll", "sensor", tid);
+        uint64_t sensorsRead = 0;
 
         /**
          * Terminus is not available for PLDM request.
@@ -192,12 +250,8 @@ exec::task<int> SensorManager::doSensorPollingTask(pldm_tid_t tid)
             co_await stdexec::just_stopped();
         }
 
-        if (!termini.contains(tid))
-        {
-            co_return PLDM_SUCCESS;
-        }
-
-        auto& terminus = termini[tid];
+        /* Held for the cycle, stopPolling drops the one of the state */
+        auto terminus = state.terminus;
         if (!terminus)
         {
             lg2::info(
@@ -206,10 +260,26 @@ exec::task<int> SensorManager::doSensorPollingTask(pldm_tid_t tid)
             co_return PLDM_ERROR;
         }
 
-        if (manager && terminus->pollEvent)
+        /* Queued events are drained by their own task, the sensors are
+         * read meanwhile instead of waiting behind an event storm */
+        if (manager && terminus->pollEvent && !state.eventPollInProgress)
         {
-            co_await manager->pollForPlatformEvent(
-                tid, terminus->pollEventId, terminus->pollDataTransferHandle);
+            state.eventPollInProgress = true;
+            if (!state.eventPollScope)
+            {
+                state.eventPollScope.emplace();
+            }
+            state.eventPollScope->spawn(
+                stdexec::just() |
+                    stdexec::let_value(
+                        [this, tid, pollEventId = terminus->pollEventId,
+                         pollDataTransferHandle =
+                             terminus->pollDataTransferHandle]
+                            -> exec::task<void> {
+                            co_await drainPolledEvents(tid, pollEventId,
+                                                       pollDataTransferHandle);
+                        }),
+                exec::default_task_context<void>(exec::inline_scheduler{}));
         }
 
         if (manager && (!terminus->pollEvent))
@@ -217,21 +287,56 @@ exec::task<int> SensorManager::doSensorPollingTask(pldm_tid_t tid)
             co_await manager->oemPollForPlatformEvent(tid);
         }
 
+        /* Apply the PDR repository changes the terminus reported, the
+         * sensors of the changed PDRs are recreated */
+        if (manager && !terminus->pdrChanges.empty())
+        {
+            co_await manager->syncPDRs(tid);
+            state.queue.clear();
+        }
+
         sd_event_now(event.get(), CLOCK_MONOTONIC, &t1);
 
         auto& numericSensors = terminus->numericSensors;
-        auto toBeUpdated = numericSensors.size();
 
-        if (!roundRobinSensorItMap.contains(tid))
+        if (!state.timer)
         {
             lg2::info(
-                "Terminus ID {TID} does not have a round robin sensor iteration {NOW}.",
+                "Terminus ID {TID} does not have a sensor polling queue {NOW}.",
                 "TID", tid, "NOW", pldm::utils::getCurrentSystemTime());
             co_return PLDM_ERROR;
         }
-        auto& sensorIt = roundRobinSensorItMap[tid];
+        auto& pollQueue = state.queue;
+        // Rebuilt on any change of the sensors, a sensor replaced by another
+        // leaves the count unchanged
+        if (pollQueue.size() != numericSensors.size() ||
+            state.queueGeneration != terminus->sensorsGeneration)
+        {
+            state.queueGeneration = terminus->sensorsGeneration;
+            pollQueue.clear();
+            for (const auto& sensor : numericSensors)
+            {
+                pollQueue.push(sensor->timeStamp
+                                   ? sensor->timeStamp + pollInterval(*sensor)
+                                   : 0,
+                               sensor);
+            }
+        }
+        if (!state.readScope)
+        {
+            state.readScope.emplace();
+        }
+        auto& readScope = *state.readScope;
+
+        /* Sensors being read along with their time stamp before the read */
+        std::vector<std::pair<std::shared_ptr<NumericSensor>, uint64_t>> issued;
+        issued.reserve(pollingConcurrency);
+
+        /* Sensors waiting for a batch read, per batch read handler */
+        std::vector<std::vector<std::shared_ptr<NumericSensor>>> batches;
 
-        while (((t1 - t0) < pollingTimeInUsec) && (toBeUpdated > 0))
+        while (((t1 - t0) < pollingTimeInUsec) && !pollQueue.empty() &&
+               (pollQueue.top().due <= t1))
         {
             if (!getAvailableState(tid))
             {
@@ -241,50 +346,229 @@ exec::task<int> SensorManager::doSensorPollingTask(pldm_tid_t tid)
                 co_await stdexec::just_stopped();
             }
 
-            if (sensorIt >= numericSensors.size())
+            /* Issue up to pollingConcurrency requests for the due sensors,
+             * the most overdue first, and wait for all of them. A terminus
+             * not responding gets one request at a time, not to hold the
+             * requester with timeouts meant for the responding ones. The
+             * sensors a batch read handler accepts share a request. */
+            issued.clear();
+            auto concurrency = terminusManager.getTerminusHealth(tid) ==
+                                       TerminusHealth::Healthy
+                                   ? pollingConcurrency
+                                   : 1;
+            size_t requests = 0;
+            batches.resize(sensorReadBatchHandlers.size());
+            auto spawnBatch = [&](size_t index) {
+                readScope.spawn(
+                    stdexec::just() |
+                        stdexec::let_value(
+                            [this, tid,
+                             handler = sensorReadBatchHandlers[index],
+                             sensors = std::exchange(batches[index], {})]
+                                -> exec::task<void> {
+                                co_await readSensorBatch(tid, handler,
+                                                         sensors);
+                            }),
+                    exec::default_task_context<void>(exec::inline_scheduler{}));
+            };
+            while (!pollQueue.empty() && (pollQueue.top().due <= t1))
             {
-                sensorIt = 0;
-            }
-
-            auto sensor = numericSensors[sensorIt];
+                auto batchIndex =
+                    findSensorReadBatchHandler(*pollQueue.top().sensor);
+                /* Sensors joining a started batch need no request */
+                if (requests >= concurrency &&
+                    (!batchIndex || batches[*batchIndex].empty()))
+                {
+                    break;
+                }
 
-            sd_event_now(event.get(), CLOCK_MONOTONIC, &t1);
-            elapsed = t1 - sensor->timeStamp;
-            if ((sensor->updateTime <= elapsed) || (!sensor->timeStamp))
-            {
-                rc = co_await getSensorReading(sensor);
+                auto sensor = pollQueue.pop();
 
-                if ((!sensorPollTimers.contains(tid)) ||
-                    (sensorPollTimers[tid] &&
-                     !sensorPollTimers[tid]->isRunning()))
+                /* An event updated the sensor since it was queued */
+                auto due = sensor->timeStamp + pollInterval(*sensor);
+                if (sensor->eventDriven && due > t1)
                 {
-                    co_return PLDM_ERROR;
+                    pollQueue.push(due, sensor);
+                    continue;
                 }
-                sd_event_now(event.get(), CLOCK_MONOTONIC, &t1);
-                if (rc == PLDM_SUCCESS)
+
+                issued.emplace_back(sensor, sensor->timeStamp);
+                if (batchIndex)
                 {
-                    sensor->timeStamp = t1;
+                    auto& batch = batches[*batchIndex];
+                    if (batch.empty())
+                    {
+                        requests++;
+                    }
+                    batch.emplace_back(sensor);
+                    if (batch.size() >=
+                        sensorReadBatchHandlers[*batchIndex].maxSensors)
+                    {
+                        spawnBatch(*batchIndex);
+                    }
+                    continue;
                 }
-                else
+
+                requests++;
+                readScope.spawn(
+                    stdexec::just() |
+                        stdexec::let_value(
+                            [this, tid, sensor] -> exec::task<void> {
+                                co_await readSensor(tid, sensor);
+                            }),
+                    exec::default_task_context<void>(exec::inline_scheduler{}));
+            }
+
+            /* Send the partial batches */
+            for (size_t index = 0; index < batches.size(); index++)
+            {
+                if (!batches[index].empty())
                 {
-                    lg2::error(
-                        "Failed to get sensor value for terminus {TID}, error: {RC}",
-                        "TID", tid, "RC", rc);
+                    spawnBatch(index);
                 }
             }
 
-            toBeUpdated--;
-            sensorIt++;
+            sensorsRead += issued.size();
+            co_await readScope.on_empty();
+
+            /* Signal the changes of this batch, one signal per interface */
+            for (const auto& [sensor, timeStamp] : issued)
+            {
+                sensor->emitPropertiesChanged();
+            }
+
+            if (!isPolling(tid))
+            {
+                co_return PLDM_ERROR;
+            }
 
             sd_event_now(event.get(), CLOCK_MONOTONIC, &t1);
+
+            /* A sensor whose read failed is retried at the next polling tick */
+            for (const auto& [sensor, timeStamp] : issued)
+            {
+                pollQueue.push(sensor->timeStamp != timeStamp
+                                   ? sensor->timeStamp + pollInterval(*sensor)
+                                   : t1 + pollingTimeInUsec,
+                               sensor);
+            }
         }
 
         sd_event_now(event.get(), CLOCK_MONOTONIC, &t1);
+
+        auto& stats = state.stats;
+        stats.cycles++;
+        stats.sensorsRead += sensorsRead;
+        stats.lastCycleUs = t1 - t0;
+        stats.maxCycleUs = std::max(stats.maxCycleUs, t1 - t0);
+        stats.totalCycleUs += t1 - t0;
+        if (stats.cycles == 1)
+        {
+            pldm::stats::StartupProfiler::getInstance().milestone(
+                std::format("Terminus{}.FirstPoll", tid));
+        }
     } while ((t1 - t0) >= pollingTimeInUsec);
 
     co_return PLDM_SUCCESS;
 }
 
+exec::task<void> SensorManager::readSensor(pldm_tid_t tid,
+                                           std::shared_ptr<NumericSensor> sensor)
+{
+    auto rc = co_await getSensorReading(sensor);
+
+    uint64_t now = 0;
+    sd_event_now(event.get(), CLOCK_MONOTONIC, &now);
+    if (rc == PLDM_SUCCESS)
+    {
+        sensor->timeStamp = now;
+    }
+    else
+    {
+        lg2::error("Failed to get sensor value for terminus {TID}, error: {RC}",
+                   "TID", tid, "RC", rc);
+    }
+}
+
+std::optional<size_t> SensorManager::findSensorReadBatchHandler(
+    const NumericSensor& sensor) const
+{
+    for (size_t index = 0; index < sensorReadBatchHandlers.size(); index++)
+    {
+        if (sensorReadBatchHandlers[index].accepts(sensor))
+        {
+            return index;
+        }
+    }
+    return std::nullopt;
+}
+
+exec::task<int> SensorManager::readSensorBatch(
+    pldm_tid_t tid, SensorReadBatchHandler handler,
+    std::vector<std::shared_ptr<NumericSensor>> sensors)
+{
+    Request encoded;
+    auto rc = handler.encode(tid, sensors, encoded);
+    if (!rc && encoded.size() < sizeof(pldm_msg_hdr))
+    {
+        rc = PLDM_ERROR_INVALID_LENGTH;
+    }
+    if (rc)
+    {
+        lg2::error(
+            "Failed to encode the batch read of {COUNT} sensors for terminus ID {TID}, error {RC}.",
+            "COUNT", sensors.size(), "TID", tid, "RC", rc);
+        co_return rc;
+    }
+
+    if (!getAvailableState(tid))
+    {
+        lg2::info(
+            "Terminus ID {TID} is not available for PLDM request from {NOW}.",
+            "TID", tid, "NOW", pldm::utils::getCurrentSystemTime());
+        co_await stdexec::just_stopped();
+    }
+
+    RequestMsg request(std::move(encoded));
+    const pldm_msg* responseMsg = nullptr;
+    size_t responseLen = 0;
+    rc = co_await terminusManager.sendRecvPldmMsg(tid, request, &responseMsg,
+                                                  &responseLen);
+    if (rc)
+    {
+        lg2::error(
+            "Failed to send the batch read of {COUNT} sensors for terminus {TID}, error {RC}",
+            "COUNT", sensors.size(), "TID", tid, "RC", rc);
+        co_return rc;
+    }
+
+    if (!isPolling(tid))
+    {
+        co_return PLDM_ERROR;
+    }
+
+    rc = handler.decode(tid, sensors, responseMsg, responseLen);
+    if (rc)
+    {
+        lg2::error(
+            "Failed to decode the batch read of {COUNT} sensors for terminus ID {TID}, error {RC}.",
+            "COUNT", sensors.size(), "TID", tid, "RC", rc);
+        co_return rc;
+    }
+
+    uint64_t now = 0;
+    sd_event_now(event.get(), CLOCK_MONOTONIC, &now);
+    for (const auto& sensor : sensors)
+    {
+        sensor->timeStamp = now;
+        if (sensor->isAvailable() && sensor->isFunctional())
+        {
+            sensor->history.push(now, sensor->getValue());
+        }
+    }
+    co_return PLDM_SUCCESS;
+}
+
 exec::task<int> SensorManager::getSensorReading(
     std::shared_ptr<NumericSensor> sensor)
 {
@@ -296,8 +580,8 @@ exec::task<int> SensorManager::getSensorReading(
 
     auto tid = sensor->tid;
     auto sensorId = sensor->sensorId;
-    Request request(sizeof(pldm_msg_hdr) + PLDM_GET_SENSOR_READING_REQ_BYTES);
-    auto requestMsg = new (request.data()) pldm_msg;
+    PldmMsg<PLDM_GET_SENSOR_READING_REQ_BYTES> request;
+    auto requestMsg = request.msg();
     auto rc = encode_get_sensor_reading_req(0, sensorId, false, requestMsg);
     if (rc)
     {
@@ -327,8 +611,7 @@ exec::task<int> SensorManager::getSensorReading(
         co_return rc;
     }
 
-    if ((!sensorPollTimers.contains(tid)) ||
-        (sensorPollTimers[tid] && !sensorPollTimers[tid]->isRunning()))
+    if (!isPolling(tid))
     {
         co_return PLDM_ERROR;
     }
@@ -406,6 +689,12 @@ exec::task<int> SensorManager::getSensorReading(
     }
 
     sensor->updateReading(true, true, value);
+    if (sensor->history.capacity())
+    {
+        uint64_t now = 0;
+        sd_event_now(event.get(), CLOCK_MONOTONIC, &now);
+        sensor->history.push(now, sensor->getValue());
+    }
     co_return completionCode;
 }
 
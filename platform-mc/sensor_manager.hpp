@@ -5,12 +5,19 @@
 #include "terminus.hpp"
 #include "terminus_manager.hpp"
 
+#include <libpldm/instance-id.h>
 #include <libpldm/platform.h>
 #include <libpldm/pldm.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -21,6 +28,179 @@ namespace platform_mc
 
 using namespace pldm::pdr;
 
+/**
+ * @brief SensorPollQueue
+ *
+ * Min-heap of the numeric sensors of a terminus, keyed by the time each
+ * sensor is next due. Sensors due at the same time keep insertion order.
+ */
+class SensorPollQueue
+{
+  public:
+    /** @brief A sensor waiting in the queue */
+    struct Entry
+    {
+        uint64_t due;      //!< CLOCK_MONOTONIC in usec the sensor is due at
+        uint64_t sequence; //!< insertion order
+        std::shared_ptr<NumericSensor> sensor;
+
+        bool operator>(const Entry& other) const
+        {
+            return std::tie(due, sequence) >
+                   std::tie(other.due, other.sequence);
+        }
+    };
+
+    /** @brief Queue a sensor
+     *
+     *  @param[in] due - time the sensor is due at, in usec
+     *  @param[in] sensor - the sensor
+     */
+    void push(uint64_t due, std::shared_ptr<NumericSensor> sensor)
+    {
+        heap.emplace_back(due, sequence++, std::move(sensor));
+        std::push_heap(heap.begin(), heap.end(), std::greater<>{});
+    }
+
+    /** @brief Remove the sensor due first
+     *
+     *  @return the sensor
+     */
+    std::shared_ptr<NumericSensor> pop()
+    {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<>{});
+        auto sensor = std::move(heap.back().sensor);
+        heap.pop_back();
+        return sensor;
+    }
+
+    /** @brief Get the sensor due first */
+    const Entry& top() const
+    {
+        return heap.front();
+    }
+
+    bool empty() const
+    {
+        return heap.empty();
+    }
+
+    size_t size() const
+    {
+        return heap.size();
+    }
+
+    void clear()
+    {
+        heap.clear();
+    }
+
+  private:
+    std::vector<Entry> heap;
+    uint64_t sequence = 0;
+};
+
+/** @brief Encode the request reading a batch of sensors
+ *
+ *  @param[in] tid - Destination TID
+ *  @param[in] sensors - the sensors to read
+ *  @param[out] request - the request message
+ *  @return PLDM completion code
+ */
+using SensorReadBatchEncoder = std::function<int(
+    pldm_tid_t tid, std::span<const std::shared_ptr<NumericSensor>> sensors,
+    Request& request)>;
+
+/** @brief Decode the response to a batch read and update the sensors
+ *
+ *  @param[in] tid - Destination TID
+ *  @param[in] sensors - the sensors read
+ *  @param[in] responseMsg - the response message
+ *  @param[in] responseLen - length of the response payload
+ *  @return PLDM completion code
+ */
+using SensorReadBatchDecoder = std::function<int(
+    pldm_tid_t tid, std::span<const std::shared_ptr<NumericSensor>> sensors,
+    const pldm_msg* responseMsg, size_t responseLen)>;
+
+/** @struct SensorReadBatchHandler
+ *
+ *  A command reading several sensors of a terminus in one request, usually
+ *  OEM. The decoder updates the reading of every sensor of the batch, like
+ *  getSensorReading does for one sensor.
+ */
+struct SensorReadBatchHandler
+{
+    /** @brief Check if a sensor can be read by the command */
+    std::function<bool(const NumericSensor& sensor)> accepts;
+
+    /** @brief Maximum number of sensors per request */
+    size_t maxSensors = 1;
+
+    SensorReadBatchEncoder encode;
+    SensorReadBatchDecoder decode;
+};
+
+/** @struct SensorPollStats
+ *
+ *  Polling of the sensors of a terminus, over the cycles run so far.
+ */
+struct SensorPollStats
+{
+    uint64_t cycles = 0;       //!< polling cycles run
+    uint64_t sensorsRead = 0;  //!< sensor reads issued
+    uint64_t lastCycleUs = 0;  //!< duration of the last cycle
+    uint64_t maxCycleUs = 0;   //!< duration of the longest cycle
+    uint64_t totalCycleUs = 0; //!< duration of all the cycles
+};
+
+/** @struct TerminusPollState
+ *
+ *  Polling state of a terminus. SensorManager keeps one per TID in a flat
+ *  table, the polling task finds all of it with one indexed load.
+ */
+struct TerminusPollState
+{
+    /** @brief the terminus polled, set by startPolling */
+    std::shared_ptr<Terminus> terminus;
+
+    /** @brief sensor polling timer */
+    std::unique_ptr<sdbusplus::Timer> timer;
+
+    /** @brief the timer runs the phase-shifted first cycle */
+    bool phased = false;
+
+    /** @brief polling period, sensor-polling-time when unset */
+    std::optional<std::chrono::milliseconds> pollingTime;
+
+    /** @brief Available state for pldm request of terminus */
+    Availability available = false;
+
+    /** @brief scope of doSensorPollingTask */
+    std::optional<exec::async_scope> taskScope;
+
+    /** @brief completion code of doSensorPollingTask once done */
+    std::optional<int> taskRc;
+
+    /** @brief scope of the sensor reads in flight */
+    std::optional<exec::async_scope> readScope;
+
+    /** @brief scope of the polled event drain */
+    std::optional<exec::async_scope> eventPollScope;
+
+    /** @brief a polled event drain is in progress */
+    bool eventPollInProgress = false;
+
+    /** @brief Sensors ordered by due time */
+    SensorPollQueue queue;
+
+    /** @brief Terminus::sensorsGeneration the queue was built from */
+    uint64_t queueGeneration = 0;
+
+    /** @brief Polling statistics, no cycle run while cycles is 0 */
+    SensorPollStats stats;
+};
+
 /**
  * @brief SensorManager
  *
@@ -47,9 +227,54 @@ class SensorManager
     void startPolling(pldm_tid_t tid);
 
     /** @brief Helper function to start sensor polling timer
+     *
+     *  The first cycle of a terminus runs one period plus its phase offset
+     *  after the start, then every period, so that termini started together
+     *  do not poll in lockstep.
      */
     void startSensorPollTimer(pldm_tid_t tid);
 
+    /** @brief Set the sensor polling period of a terminus
+     *
+     *  @param[in] tid - Terminus ID
+     *  @param[in] period - polling period, the sensor-polling-time option
+     *                      applies to termini without one
+     */
+    void setPollingTime(pldm_tid_t tid, std::chrono::milliseconds period)
+    {
+        pollStates[tid].pollingTime = std::max<std::chrono::milliseconds>(
+            period, std::chrono::milliseconds(1));
+    }
+
+    /** @brief Get the sensor polling period of a terminus
+     *
+     *  @param[in] tid - Terminus ID
+     *  @return the polling period
+     */
+    std::chrono::milliseconds getPollingTime(pldm_tid_t tid) const
+    {
+        return pollStates[tid].pollingTime.value_or(
+            std::chrono::milliseconds(pollingTime));
+    }
+
+    /** @brief Get the phase offset of the polling cycles of a terminus
+     *
+     *  The offset is the fractional part of TID times the golden ratio, of
+     *  the period. Consecutive TIDs, as assigned at discovery, land far
+     *  apart in the period however many termini there are.
+     *
+     *  @param[in] tid - Terminus ID
+     *  @return the offset, less than the polling period
+     */
+    std::chrono::milliseconds getPollingPhase(pldm_tid_t tid) const
+    {
+        // 2^16 divided by the golden ratio
+        constexpr uint32_t goldenRatio16 = 40503;
+        uint32_t fraction = (tid * goldenRatio16) & 0xffff;
+        return std::chrono::milliseconds(
+            getPollingTime(tid).count() * fraction >> 16);
+    }
+
     /** @brief Helper function to set all terminus sensor as nan when the
      *  terminus is not available for pldm request
      */
@@ -63,25 +288,77 @@ class SensorManager
      */
     void updateAvailableState(pldm_tid_t tid, Availability state)
     {
-        availableState[tid] = state;
+        pollStates[tid].available = state;
     };
 
     /** @brief Get available state of terminus for pldm request.
      */
-    bool getAvailableState(pldm_tid_t tid)
+    bool getAvailableState(pldm_tid_t tid) const
     {
-        if (!availableState.contains(tid))
+        return pollStates[tid].available;
+    };
+
+    /** @brief Register a command reading several sensors in one request
+     *
+     *  The due sensors accepted by the handler are grouped into batches of
+     *  up to maxSensors, instead of one GetSensorReading each. The first
+     *  handler accepting a sensor is used.
+     *
+     *  @param[in] handler - the batch read handler
+     */
+    void registerSensorReadBatchHandler(SensorReadBatchHandler handler)
+    {
+        if (handler.accepts && handler.encode && handler.decode &&
+            handler.maxSensors)
         {
-            return false;
+            sensorReadBatchHandlers.emplace_back(std::move(handler));
         }
-        return availableState[tid];
-    };
+    }
+
+    /** @brief Drain the events queued by the terminus, unless a drain of
+     *         the terminus is already in progress
+     *
+     *  Entry point of the OEM event polling, a drain started by the
+     *  polling task is never run twice at once.
+     *
+     *  @param[in] tid - Terminus ID
+     *  @return coroutine return_value - PLDM completion code
+     */
+    exec::task<int> pollForPlatformEvent(pldm_tid_t tid);
+
+    /** @brief Get the polling statistics of the termini polled at least
+     *         once
+     */
+    std::map<pldm_tid_t, SensorPollStats> getPollStats() const
+    {
+        std::map<pldm_tid_t, SensorPollStats> stats;
+        for (size_t tid = 0; tid < pollStates.size(); tid++)
+        {
+            if (pollStates[tid].stats.cycles)
+            {
+                stats.emplace(tid, pollStates[tid].stats);
+            }
+        }
+        return stats;
+    }
 
   protected:
     /** @brief start a coroutine for polling all sensors.
      */
     virtual void doSensorPolling(pldm_tid_t tid);
 
+    /** @brief Drain the events queued by the terminus, with
+     *         eventPollInProgress set by the caller and cleared once done
+     *
+     *  @param[in] tid - Terminus ID
+     *  @param[in] pollEventId - The source eventID from pldmMessagePollEvent
+     *  @param[in] pollDataTransferHandle - The dataTransferHandle from
+     *             pldmMessagePollEvent event
+     *  @return coroutine return_value - PLDM completion code
+     */
+    exec::task<int> drainPolledEvents(pldm_tid_t tid, uint16_t pollEventId,
+                                      uint32_t pollDataTransferHandle);
+
     /** @brief polling all sensors in each terminus
      *
      *  @param[in] tid - Destination TID
@@ -96,6 +373,55 @@ class SensorManager
      */
     exec::task<int> getSensorReading(std::shared_ptr<NumericSensor> sensor);
 
+    /** @brief Read a sensor and record the time of a successful reading
+     *
+     *  @param[in] tid - Destination TID
+     *  @param[in] sensor - the sensor to be updated
+     */
+    exec::task<void> readSensor(pldm_tid_t tid,
+                                std::shared_ptr<NumericSensor> sensor);
+
+    /** @brief Read a batch of sensors in one request and record the time of
+     *         a successful reading
+     *
+     *  @param[in] tid - Destination TID
+     *  @param[in] handler - the batch read handler
+     *  @param[in] sensors - the sensors to be updated
+     *  @return coroutine return_value - PLDM completion code
+     */
+    exec::task<int> readSensorBatch(
+        pldm_tid_t tid, SensorReadBatchHandler handler,
+        std::vector<std::shared_ptr<NumericSensor>> sensors);
+
+    /** @brief Get the batch read handler of a sensor
+     *
+     *  @param[in] sensor - the sensor
+     *  @return index in sensorReadBatchHandlers, std::nullopt to read the
+     *          sensor with GetSensorReading
+     */
+    std::optional<size_t> findSensorReadBatchHandler(
+        const NumericSensor& sensor) const;
+
+    /** @brief Get the interval a sensor is polled at
+     *
+     *  @param[in] sensor - the sensor
+     *  @return interval in usec, the keep-alive interval for the sensors
+     *          updated by sensorEvents
+     */
+    uint64_t pollInterval(const NumericSensor& sensor) const
+    {
+        return sensor.eventDriven
+                   ? std::max(eventKeepAliveTime, sensor.updateTime)
+                   : sensor.updateTime;
+    }
+
+    /** @brief Check if the polling timer of a terminus runs */
+    bool isPolling(pldm_tid_t tid) const
+    {
+        const auto& timer = pollStates[tid].timer;
+        return timer && timer->isRunning();
+    }
+
     /** @brief Reference to to PLDM daemon's main event loop.
      */
     sdeventplus::Event& event;
@@ -109,18 +435,19 @@ class SensorManager
     /** @brief sensor polling interval in ms. */
     uint32_t pollingTime;
 
-    /** @brief sensor polling timers */
-    std::map<pldm_tid_t, std::unique_ptr<sdbusplus::Timer>> sensorPollTimers;
+    /** @brief maximum number of sensor reads in flight per terminus */
+    size_t pollingConcurrency;
 
-    /** @brief coroutine handle of doSensorPollingTasks */
-    std::map<pldm_tid_t, std::pair<exec::async_scope, std::optional<int>>>
-        doSensorPollingTaskHandles;
+    /** @brief polling interval in usec of the sensors updated by
+     *         sensorEvents
+     */
+    uint64_t eventKeepAliveTime;
 
-    /** @brief Available state for pldm request of terminus */
-    std::map<pldm_tid_t, Availability> availableState;
+    /** @brief Polling state of the termini, indexed by TID */
+    std::array<TerminusPollState, PLDM_MAX_TIDS> pollStates;
 
-    /** @brief Round robin sensor iter of terminus */
-    std::map<pldm_tid_t, SensorID> roundRobinSensorItMap;
+    /** @brief Registered batch read commands */
+    std::vector<SensorReadBatchHandler> sensorReadBatchHandlers;
 
     /** @brief pointer to Manager */
     Manager* manager;
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace pldm
+{
+namespace platform_mc
+{
+
+/** @struct PublishPolicy
+ *
+ *  When a new reading of a numeric sensor is published on D-Bus. Readings
+ *  crossing a threshold, or with an alarm asserted, are published at once
+ *  whatever the policy.
+ */
+struct PublishPolicy
+{
+    /** @brief Minimum change of the value published, in the sensor Units,
+     *         on top of the SENSOR_VALUE_DEADBAND resolution steps
+     */
+    double deadband = 0;
+
+    /** @brief Minimum time between two values published */
+    std::chrono::milliseconds minInterval{0};
+
+    bool operator==(const PublishPolicy&) const = default;
+};
+
+/** @class SensorPublishPolicy
+ *
+ *  Publish policies of the numeric sensors by unit class, the last component
+ *  of the D-Bus namespace of the sensor as voltage or current, and by sensor
+ *  name, the latter taking precedence. The policies are read from a JSON
+ *  file like
+ *
+ *  {
+ *      "namespaces": [
+ *          {
+ *              "namespace": "voltage",
+ *              "deadband": 0.01,
+ *              "min_publish_interval_ms": 1000
+ *          }
+ *      ],
+ *      "sensors": [
+ *          { "name": "PLDM_Device_1_VR_Vout", "deadband": 0.005 }
+ *      ]
+ *  }
+ */
+class SensorPublishPolicy
+{
+  public:
+    SensorPublishPolicy() = default;
+
+    /** @brief Constructor, reading the policies from a JSON file
+     *
+     *  @param[in] path - path of the JSON file, a missing file has no
+     *                    policy
+     */
+    explicit SensorPublishPolicy(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            return;
+        }
+
+        auto json = nlohmann::json::parse(file, nullptr, false);
+        if (json.is_discarded() || !json.is_object())
+        {
+            lg2::error("Failed to parse the sensor publish policy '{PATH}'",
+                       "PATH", path);
+            return;
+        }
+
+        auto parseEntries = [&path, &json](const char* section,
+                                           const char* key, auto& policies) {
+            for (const auto& entry :
+                 json.value(section, nlohmann::json::array()))
+            {
+                try
+                {
+                    PublishPolicy policy{
+                        entry.value("deadband", 0.0),
+                        std::chrono::milliseconds(
+                            entry.value("min_publish_interval_ms", 0u))};
+                    if (policy.deadband < 0)
+                    {
+                        throw std::invalid_argument("negative deadband");
+                    }
+                    policies.insert_or_assign(
+                        entry.at(key).template get<std::string>(), policy);
+                }
+                catch (const std::exception& e)
+                {
+                    lg2::error(
+                        "Invalid entry in the sensor publish policy '{PATH}', error - {ERROR}",
+                        "PATH", path, "ERROR", e);
+                }
+            }
+        };
+        parseEntries("namespaces", "namespace", namespacePolicies);
+        parseEntries("sensors", "name", sensorPolicies);
+    }
+
+    /** @brief The policies of SENSOR_PUBLISH_POLICY_JSON, read once */
+    static const SensorPublishPolicy& getInstance()
+    {
+        static const SensorPublishPolicy policy(SENSOR_PUBLISH_POLICY_JSON);
+        return policy;
+    }
+
+    /** @brief Get the publish policy of a sensor
+     *
+     *  @param[in] nameSpace - D-Bus namespace of the sensor, as
+     *                         /xyz/openbmc_project/sensors/voltage/
+     *  @param[in] name - name of the sensor
+     *  @return the policy of the sensor name, else of its unit class, else
+     *          the default one publishing every change
+     */
+    PublishPolicy get(std::string_view nameSpace, std::string_view name) const
+    {
+        if (auto it = sensorPolicies.find(name); it != sensorPolicies.end())
+        {
+            return it->second;
+        }
+
+        while (nameSpace.ends_with('/'))
+        {
+            nameSpace.remove_suffix(1);
+        }
+        if (auto pos = nameSpace.rfind('/'); pos != std::string_view::npos)
+        {
+            nameSpace.remove_prefix(pos + 1);
+        }
+        if (auto it = namespacePolicies.find(nameSpace);
+            it != namespacePolicies.end())
+        {
+            return it->second;
+        }
+        return {};
+    }
+
+    size_t size() const
+    {
+        return namespacePolicies.size() + sensorPolicies.size();
+    }
+
+  private:
+    std::map<std::string, PublishPolicy, std::less<>> namespacePolicies;
+    std::map<std::string, PublishPolicy, std::less<>> sensorPolicies;
+};
+
+} // namespace platform_mc
+} // namespace pldm
@@ -1,5 +1,7 @@
 #include "terminus.hpp"
 
+#include "common/fnv_hash.hpp"
+#include "common/string_pool.hpp"
 #include "dbus_impl_fru.hpp"
 #include "terminus_manager.hpp"
 
@@ -7,7 +9,11 @@
 
 #include <common/utils.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <ranges>
+#include <span>
 
 namespace pldm
 {
@@ -106,6 +112,8 @@ bool Terminus::createInventoryPath(std::string tName)
         inventoryItemBoardInft =
             std::make_unique<pldm::dbus_api::PldmEntityReq>(
                 utils::DBusHandler::getBus(), inventoryPath.c_str());
+        publishedFruHash.reset();
+        publishedFruFields.clear();
         return true;
     }
     catch (const sdbusplus::exception_t& e)
@@ -118,11 +126,71 @@ bool Terminus::createInventoryPath(std::string tName)
     return false;
 }
 
-void Terminus::parseTerminusPDRs()
+size_t Terminus::dropUnusedPDRs()
+{
+    auto used = [](std::span<const uint8_t> pdr) {
+        if (pdr.size() < sizeof(pldm_pdr_hdr))
+        {
+            return false;
+        }
+        switch (reinterpret_cast<const pldm_pdr_hdr*>(pdr.data())->type)
+        {
+            case PLDM_SENSOR_AUXILIARY_NAMES_PDR:
+            case PLDM_NUMERIC_SENSOR_PDR:
+            case PLDM_COMPACT_NUMERIC_SENSOR_PDR:
+            case PLDM_ENTITY_AUXILIARY_NAMES_PDR:
+                return true;
+            default:
+                return false;
+        }
+    };
+
+    size_t count = 0;
+    size_t bytes = 0;
+    for (auto pdr : pdrs)
+    {
+        if (used(pdr))
+        {
+            count++;
+            bytes += pdr.size();
+        }
+    }
+    if (count == pdrs.size())
+    {
+        return 0;
+    }
+
+    pdr::PdrArena usedPdrs;
+    usedPdrs.reserve(count, bytes);
+    for (auto pdr : pdrs)
+    {
+        if (used(pdr))
+        {
+            usedPdrs.emplace_back(pdr);
+        }
+    }
+
+    auto dropped = pdrs.size() - count;
+    lg2::info(
+        "Terminus ID {TID}: dropped {COUNT} PDRs of {BYTES} bytes not used at runtime.",
+        "TID", tid, "COUNT", dropped, "BYTES", pdrs.bytes() - bytes);
+    pdrs = std::move(usedPdrs);
+    return dropped;
+}
+
+void Terminus::parsePDRTables()
 {
-    for (auto& pdr : pdrs)
+    sensorAuxiliaryNamesTbl.clear();
+    sensorPdrs.clear();
+    entityAuxiliaryNamesTbl.clear();
+#ifdef TERMINUS_LEAN_PDRS
+    dropUnusedPDRs();
+#endif
+
+    for (size_t idx = 0; idx < pdrs.size(); idx++)
     {
-        auto pdrHdr = new (pdr.data()) pldm_pdr_hdr;
+        auto pdr = pdrs[idx];
+        auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(pdr.data());
         switch (pdrHdr->type)
         {
             case PLDM_SENSOR_AUXILIARY_NAMES_PDR:
@@ -141,22 +209,13 @@ void Terminus::parseTerminusPDRs()
             }
             case PLDM_NUMERIC_SENSOR_PDR:
             {
-                auto parsedPdr = parseNumericSensorPDR(pdr);
-                if (!parsedPdr)
-                {
-                    lg2::error(
-                        "Failed to parse PDR with type {TYPE} handle {HANDLE}",
-                        "TYPE", pdrHdr->type, "HANDLE",
-                        static_cast<uint32_t>(pdrHdr->record_handle));
-                    continue;
-                }
-                numericSensorPdrs.emplace_back(std::move(parsedPdr));
+                /* Decoded when the sensor is created */
+                sensorPdrs.emplace_back(idx);
                 break;
             }
             case PLDM_COMPACT_NUMERIC_SENSOR_PDR:
             {
-                auto parsedPdr = parseCompactNumericSensorPDR(pdr);
-                if (!parsedPdr)
+                if (pdr.size() < sizeof(pldm_compact_numeric_sensor_pdr))
                 {
                     lg2::error(
                         "Failed to parse PDR with type {TYPE} handle {HANDLE}",
@@ -173,7 +232,7 @@ void Terminus::parseTerminusPDRs()
                         static_cast<uint32_t>(pdrHdr->record_handle));
                     continue;
                 }
-                compactNumericSensorPdrs.emplace_back(std::move(parsedPdr));
+                sensorPdrs.emplace_back(idx);
                 sensorAuxiliaryNamesTbl.emplace_back(std::move(sensorAuxNames));
                 break;
             }
@@ -201,6 +260,22 @@ void Terminus::parseTerminusPDRs()
         }
     }
 
+    /* Numeric sensors stay ahead of compact ones of the same priority */
+    std::ranges::stable_sort(sensorPdrs, {}, [this](size_t idx) {
+        auto pdr = pdrs[idx];
+        auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(pdr.data());
+        return std::make_pair(sensorCreationPriority(pdr),
+                              pdrHdr->type == PLDM_COMPACT_NUMERIC_SENSOR_PDR);
+    });
+
+    /* Sorted for the lookups by sensor ID, the first PDR of a sensor ID
+     * stays first */
+    std::ranges::stable_sort(
+        sensorAuxiliaryNamesTbl, {},
+        [](const std::shared_ptr<SensorAuxiliaryNames>& names) {
+            return std::get<0>(*names);
+        });
+
     auto tName = findTerminusName();
     if (tName && !tName.value().empty())
     {
@@ -208,9 +283,13 @@ void Terminus::parseTerminusPDRs()
                   "NAME", tName.value());
         terminusName = static_cast<std::string>(tName.value());
     }
+}
+
+void Terminus::parseTerminusPDRs()
+{
+    parsePDRTables();
 
-    if (terminusName.empty() &&
-        (numericSensorPdrs.size() || compactNumericSensorPdrs.size()))
+    if (terminusName.empty() && sensorPdrs.size())
     {
         lg2::error(
             "Terminus ID {TID}: DOES NOT have name. Skip Adding sensors.",
@@ -227,6 +306,141 @@ void Terminus::parseTerminusPDRs()
     addNextSensorFromPDRs();
 }
 
+void Terminus::updateTerminusPDRs(
+    const std::map<RecordHandle, std::vector<uint8_t>>& records,
+    const std::set<RecordHandle>& deletedRecords)
+{
+    std::set<SensorId> changedSensors;
+    bool renamed = false;
+    auto collect = [&](std::span<const uint8_t> pdr) {
+        auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(pdr.data());
+        switch (pdrHdr->type)
+        {
+            case PLDM_NUMERIC_SENSOR_PDR:
+            case PLDM_COMPACT_NUMERIC_SENSOR_PDR:
+            case PLDM_SENSOR_AUXILIARY_NAMES_PDR:
+                /* All of them start with terminus handle and sensor ID */
+                if (pdr.size() >= sizeof(pldm_pdr_hdr) + 2 * sizeof(uint16_t))
+                {
+                    uint16_t sensorId = 0;
+                    memcpy(&sensorId,
+                           pdr.data() + sizeof(pldm_pdr_hdr) + sizeof(uint16_t),
+                           sizeof(sensorId));
+                    changedSensors.insert(le16toh(sensorId));
+                }
+                break;
+            case PLDM_ENTITY_AUXILIARY_NAMES_PDR:
+                renamed = true;
+                break;
+            default:
+                break;
+        }
+    };
+    auto recordHandle = [](std::span<const uint8_t> pdr) {
+        auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(pdr.data());
+        return static_cast<RecordHandle>(le32toh(pdrHdr->record_handle));
+    };
+
+    /* Modified records keep their position, the sensors are created in
+     * the order of the repository */
+    pdr::PdrArena updatedPdrs;
+    updatedPdrs.reserve(pdrs.size() + records.size(), pdrs.bytes());
+    std::set<RecordHandle> updated;
+    for (auto pdr : pdrs)
+    {
+        auto handle = recordHandle(pdr);
+        if (deletedRecords.contains(handle))
+        {
+            collect(pdr);
+            continue;
+        }
+
+        auto it = records.find(handle);
+        if (it != records.end())
+        {
+            collect(pdr);
+            collect(it->second);
+            updatedPdrs.emplace_back(it->second);
+            updated.insert(handle);
+            continue;
+        }
+        updatedPdrs.emplace_back(pdr);
+    }
+    for (const auto& [handle, pdr] : records)
+    {
+        if (!updated.contains(handle))
+        {
+            collect(pdr);
+            updatedPdrs.emplace_back(pdr);
+        }
+    }
+    pdrs = std::move(updatedPdrs);
+
+    auto previousName = terminusName;
+    terminusName.clear();
+    parsePDRTables();
+    renamed = renamed && (terminusName != previousName);
+
+    if (renamed)
+    {
+        lg2::info("Terminus ID {TID}: renamed from {OLD} to {NAME}.", "TID",
+                  tid, "OLD", previousName, "NAME", terminusName);
+        numericSensors.clear();
+        sensorIndex.clear();
+        sensorsGeneration++;
+        inventoryItemBoardInft.reset();
+        createInventoryPath(terminusName);
+    }
+    else
+    {
+        std::erase_if(numericSensors,
+                      [&](const std::shared_ptr<NumericSensor>& sensor) {
+                          return !sensor ||
+                                 changedSensors.contains(sensor->sensorId);
+                      });
+        indexSensors();
+    }
+
+    lg2::info(
+        "Terminus ID {TID}: applied {CHANGED} changed and {DELETED} deleted PDRs.",
+        "TID", tid, "CHANGED", records.size(), "DELETED",
+        deletedRecords.size());
+
+    /* Sensors still in place are skipped while walking the sensor PDRs */
+    sensorPdrIt = 0;
+    addNextSensorFromPDRs();
+}
+
+bool Terminus::hasSensor(SensorId id) const
+{
+    return std::ranges::binary_search(sensorIndex, id, {},
+                                      &SensorIndexEntry::first);
+}
+
+void Terminus::insertSensor(std::shared_ptr<NumericSensor> sensor)
+{
+    auto it = std::ranges::upper_bound(sensorIndex, sensor->sensorId, {},
+                                       &SensorIndexEntry::first);
+    sensorIndex.emplace(it, sensor->sensorId, sensor);
+    numericSensors.emplace_back(std::move(sensor));
+    sensorsGeneration++;
+}
+
+void Terminus::indexSensors()
+{
+    sensorsGeneration++;
+    sensorIndex.clear();
+    sensorIndex.reserve(numericSensors.size());
+    for (const auto& sensor : numericSensors)
+    {
+        if (sensor)
+        {
+            sensorIndex.emplace_back(sensor->sensorId, sensor);
+        }
+    }
+    std::ranges::stable_sort(sensorIndex, {}, &SensorIndexEntry::first);
+}
+
 void Terminus::addNextSensorFromPDRs()
 {
     sensorCreationEvent.reset();
@@ -239,102 +453,237 @@ void Terminus::addNextSensorFromPDRs()
         return;
     }
 
-    auto pdrIt = sensorPdrIt;
-
-    if (pdrIt < numericSensorPdrs.size())
+    if (sensorPdrIt >= sensorPdrs.size())
     {
-        const auto& pdr = numericSensorPdrs[pdrIt];
-        // Defer adding the next Numeric Sensor
-        sensorCreationEvent = std::make_unique<sdeventplus::source::Defer>(
-            event,
-            std::bind(std::mem_fn(&Terminus::addNumericSensor), this, pdr));
+        sensorPdrIt = 0;
+        return;
     }
-    else if (pdrIt < numericSensorPdrs.size() + compactNumericSensorPdrs.size())
+
+    /* One sensor per event loop iteration, so the sensors created first
+     * are published and polled while the others are still pending */
+    auto pdrIdx = sensorPdrs[sensorPdrIt];
+    auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(pdrs[pdrIdx].data());
+    if (pdrHdr->type == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
     {
-        pdrIt -= numericSensorPdrs.size();
-        const auto& pdr = compactNumericSensorPdrs[pdrIt];
         // Defer adding the next Compact Numeric Sensor
         sensorCreationEvent = std::make_unique<sdeventplus::source::Defer>(
             event, std::bind(std::mem_fn(&Terminus::addCompactNumericSensor),
-                             this, pdr));
+                             this, pdrIdx));
     }
     else
     {
-        sensorPdrIt = 0;
-        return;
+        // Defer adding the next Numeric Sensor
+        sensorCreationEvent = std::make_unique<sdeventplus::source::Defer>(
+            event,
+            std::bind(std::mem_fn(&Terminus::addNumericSensor), this, pdrIdx));
     }
 
     // Move the iteration to the next sensor PDR
     sensorPdrIt++;
 }
 
+uint8_t Terminus::sensorCreationPriority(std::span<const uint8_t> pdr)
+{
+    /* Offsets in the Numeric Sensor PDR, DSP0248 Table 78 */
+    constexpr size_t baseUnitOffset = 22;
+    constexpr size_t sensorDataSizeOffset = 32;
+    constexpr size_t hysteresisOffset = 45;
+    constexpr uint8_t lowestPriority = 3;
+
+    uint8_t baseUnit = PLDM_SENSOR_UNIT_NONE;
+    bool hasThresholds = false;
+    auto pdrHdr = reinterpret_cast<const pldm_pdr_hdr*>(pdr.data());
+    if (pdrHdr->type == PLDM_COMPACT_NUMERIC_SENSOR_PDR)
+    {
+        if (pdr.size() < sizeof(pldm_compact_numeric_sensor_pdr))
+        {
+            return lowestPriority;
+        }
+        auto compactPdr =
+            reinterpret_cast<const pldm_compact_numeric_sensor_pdr*>(
+                pdr.data());
+        baseUnit = compactPdr->base_unit;
+        /* warning and critical limits */
+        hasThresholds = compactPdr->range_field_support.byte & 0x0f;
+    }
+    else
+    {
+        if (pdr.size() <= sensorDataSizeOffset)
+        {
+            return lowestPriority;
+        }
+        baseUnit = pdr[baseUnitOffset];
+
+        /* The hysteresis has the size of the sensor readings and is
+         * followed by supportedThresholds */
+        size_t hysteresisSize = 0;
+        switch (pdr[sensorDataSizeOffset])
+        {
+            case PLDM_SENSOR_DATA_SIZE_UINT8:
+            case PLDM_SENSOR_DATA_SIZE_SINT8:
+                hysteresisSize = sizeof(uint8_t);
+                break;
+            case PLDM_SENSOR_DATA_SIZE_UINT16:
+            case PLDM_SENSOR_DATA_SIZE_SINT16:
+                hysteresisSize = sizeof(uint16_t);
+                break;
+            case PLDM_SENSOR_DATA_SIZE_UINT32:
+            case PLDM_SENSOR_DATA_SIZE_SINT32:
+                hysteresisSize = sizeof(uint32_t);
+                break;
+            default:
+                return lowestPriority;
+        }
+        auto thresholdsOffset = hysteresisOffset + hysteresisSize;
+        hasThresholds = pdr.size() > thresholdsOffset && pdr[thresholdsOffset];
+    }
+
+    bool critical = false;
+    switch (baseUnit)
+    {
+        case PLDM_SENSOR_UNIT_DEGRESS_C:
+        case PLDM_SENSOR_UNIT_DEGRESS_F:
+        case PLDM_SENSOR_UNIT_KELVINS:
+        case PLDM_SENSOR_UNIT_WATTS:
+            critical = true;
+            break;
+        default:
+            break;
+    }
+
+    return (critical ? 0 : 2) + (hasThresholds ? 0 : 1);
+}
+
 std::shared_ptr<SensorAuxiliaryNames> Terminus::getSensorAuxiliaryNames(
     SensorId id)
 {
-    auto it = std::find_if(
-        sensorAuxiliaryNamesTbl.begin(), sensorAuxiliaryNamesTbl.end(),
-        [id](
-            const std::shared_ptr<SensorAuxiliaryNames>& sensorAuxiliaryNames) {
-            const auto& [sensorId, sensorCnt, sensorNames] =
-                *sensorAuxiliaryNames;
-            return sensorId == id;
+    auto it = std::ranges::lower_bound(
+        sensorAuxiliaryNamesTbl, id, {},
+        [](const std::shared_ptr<SensorAuxiliaryNames>& sensorAuxiliaryNames) {
+            return std::get<0>(*sensorAuxiliaryNames);
         });
 
-    if (it != sensorAuxiliaryNamesTbl.end())
+    if (it != sensorAuxiliaryNamesTbl.end() && std::get<0>(**it) == id)
     {
         return *it;
     }
     return nullptr;
 };
 
+/** @brief Decode a null terminated UTF-16BE name of a PDR to UTF-8
+ *
+ *  One pass over the PDR bytes, the plain ASCII names of most PDRs are copied
+ *  a character at a time. Unpaired surrogates decode to U+FFFD.
+ *
+ *  @param[in] data - the name and the rest of the PDR
+ *  @param[out] name - the decoded name, without the terminator
+ *
+ *  @return the bytes of the name with its terminator, 0 if it is not
+ *          terminated within data or PLDM_STR_UTF_16_MAX_LEN characters
+ */
+static size_t decodeUtf16BeName(std::span<const uint8_t> data,
+                                std::string& name)
+{
+    name.clear();
+    auto units = std::min<size_t>(data.size() / sizeof(uint16_t),
+                                  PLDM_STR_UTF_16_MAX_LEN);
+    auto unitAt = [&data](size_t i) -> char32_t {
+        return (data[2 * i] << 8) | data[2 * i + 1];
+    };
+    for (size_t i = 0; i < units; i++)
+    {
+        auto code = unitAt(i);
+        if (code == 0)
+        {
+            return (i + 1) * sizeof(uint16_t);
+        }
+        if (code < 0x80)
+        {
+            name.push_back(static_cast<char>(code));
+            continue;
+        }
+        if (code >= 0xd800 && code < 0xdc00 && i + 1 < units &&
+            unitAt(i + 1) >= 0xdc00 && unitAt(i + 1) < 0xe000)
+        {
+            code = 0x10000 + ((code - 0xd800) << 10) + (unitAt(i + 1) - 0xdc00);
+            i++;
+        }
+        else if (code >= 0xd800 && code < 0xe000)
+        {
+            code = 0xfffd;
+        }
+
+        if (code < 0x800)
+        {
+            name.push_back(static_cast<char>(0xc0 | (code >> 6)));
+        }
+        else if (code < 0x10000)
+        {
+            name.push_back(static_cast<char>(0xe0 | (code >> 12)));
+            name.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+        }
+        else
+        {
+            name.push_back(static_cast<char>(0xf0 | (code >> 18)));
+            name.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3f)));
+            name.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+        }
+        name.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+    }
+    return 0;
+}
+
 std::shared_ptr<SensorAuxiliaryNames> Terminus::parseSensorAuxiliaryNamesPDR(
-    const std::vector<uint8_t>& pdrData)
+    std::span<const uint8_t> pdrData)
 {
-    constexpr uint8_t nullTerminator = 0;
+    auto namesOffset = offsetof(pldm_sensor_auxiliary_names_pdr, names);
+    if (pdrData.size() < namesOffset)
+    {
+        lg2::error("Sensor Auxiliary Names PDR too short.");
+        return nullptr;
+    }
     auto pdr = reinterpret_cast<const struct pldm_sensor_auxiliary_names_pdr*>(
         pdrData.data());
-    const uint8_t* ptr = pdr->names;
+    auto names = pdrData.subspan(namesOffset);
     std::vector<AuxiliaryNames> sensorAuxNames{};
-    char16_t alignedBuffer[PLDM_STR_UTF_16_MAX_LEN];
+    sensorAuxNames.reserve(pdr->sensor_count);
+    std::string nameString;
     for ([[maybe_unused]] const auto& sensor :
          std::views::iota(0, static_cast<int>(pdr->sensor_count)))
     {
-        const uint8_t nameStringCount = static_cast<uint8_t>(*ptr);
-        ptr += sizeof(uint8_t);
+        if (names.empty())
+        {
+            lg2::error("Sensor Auxiliary Names PDR truncated.");
+            return nullptr;
+        }
+        const uint8_t nameStringCount = names[0];
+        names = names.subspan(sizeof(uint8_t));
         AuxiliaryNames nameStrings{};
+        nameStrings.reserve(nameStringCount);
         for ([[maybe_unused]] const auto& count :
              std::views::iota(0, static_cast<int>(nameStringCount)))
         {
-            std::string_view nameLanguageTag(
-                reinterpret_cast<const char*>(ptr));
-            ptr += nameLanguageTag.size() + sizeof(nullTerminator);
-
-            int u16NameStringLen = 0;
-            for (int i = 0; ptr[i] != 0 || ptr[i + 1] != 0; i += 2)
+            auto tagEnd = std::ranges::find(names, 0);
+            if (tagEnd == names.end())
             {
-                u16NameStringLen++;
+                lg2::error("Sensor Auxiliary Names PDR truncated.");
+                return nullptr;
             }
-            /* include terminator */
-            u16NameStringLen++;
+            std::string_view nameLanguageTag(
+                reinterpret_cast<const char*>(names.data()),
+                std::distance(names.begin(), tagEnd));
+            names = names.subspan(nameLanguageTag.size() + 1);
 
-            std::fill(std::begin(alignedBuffer), std::end(alignedBuffer), 0);
-            if (u16NameStringLen > PLDM_STR_UTF_16_MAX_LEN)
+            auto nameSize = decodeUtf16BeName(names, nameString);
+            if (!nameSize)
             {
                 lg2::error("Sensor name too long.");
                 return nullptr;
             }
-            memcpy(alignedBuffer, ptr, u16NameStringLen * sizeof(uint16_t));
-            std::u16string u16NameString(alignedBuffer, u16NameStringLen);
-            ptr += u16NameString.size() * sizeof(uint16_t);
-            std::transform(u16NameString.cbegin(), u16NameString.cend(),
-                           u16NameString.begin(),
-                           [](uint16_t utf16) { return be16toh(utf16); });
-            std::string nameString =
-                std::wstring_convert<std::codecvt_utf8_utf16<char16_t>,
-                                     char16_t>{}
-                    .to_bytes(u16NameString);
-            nameStrings.emplace_back(std::make_pair(
-                nameLanguageTag, pldm::utils::trimNameForDbus(nameString)));
+            names = names.subspan(nameSize);
+            nameStrings.emplace_back(
+                pldm::utils::StringPool::getInstance().intern(nameLanguageTag),
+                pldm::utils::trimNameForDbus(nameString));
         }
         sensorAuxNames.emplace_back(std::move(nameStrings));
     }
@@ -343,7 +692,7 @@ std::shared_ptr<SensorAuxiliaryNames> Terminus::parseSensorAuxiliaryNamesPDR(
 }
 
 std::shared_ptr<EntityAuxiliaryNames> Terminus::parseEntityAuxiliaryNamesPDR(
-    const std::vector<uint8_t>& pdrData)
+    std::span<const uint8_t> pdrData)
 {
     auto names_offset = sizeof(struct pldm_pdr_hdr) +
                         PLDM_PDR_ENTITY_AUXILIARY_NAME_PDR_MIN_LENGTH;
@@ -378,23 +727,27 @@ std::shared_ptr<EntityAuxiliaryNames> Terminus::parseEntityAuxiliaryNamesPDR(
     }
 
     AuxiliaryNames nameStrings{};
+    nameStrings.reserve(decodedPdr->name_string_count);
+    std::string nameString;
     for (const auto& count :
          std::views::iota(0, static_cast<int>(decodedPdr->name_string_count)))
     {
         std::string_view nameLanguageTag =
             static_cast<std::string_view>(decodedPdr->names[count].tag);
+        /* The names are still big endian, decoded with their terminator */
         const size_t u16NameStringLen =
             std::char_traits<char16_t>::length(decodedPdr->names[count].name);
-        std::u16string u16NameString(decodedPdr->names[count].name,
-                                     u16NameStringLen);
-        std::transform(u16NameString.cbegin(), u16NameString.cend(),
-                       u16NameString.begin(),
-                       [](uint16_t utf16) { return be16toh(utf16); });
-        std::string nameString =
-            std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>{}
-                .to_bytes(u16NameString);
-        nameStrings.emplace_back(std::make_pair(
-            nameLanguageTag, pldm::utils::trimNameForDbus(nameString)));
+        std::span name(
+            reinterpret_cast<const uint8_t*>(decodedPdr->names[count].name),
+            (u16NameStringLen + 1) * sizeof(char16_t));
+        if (!decodeUtf16BeName(name, nameString))
+        {
+            lg2::error("Entity name too long.");
+            return nullptr;
+        }
+        nameStrings.emplace_back(
+            pldm::utils::StringPool::getInstance().intern(nameLanguageTag),
+            pldm::utils::trimNameForDbus(nameString));
     }
 
     EntityKey key{decodedPdr->container.entity_type,
@@ -405,8 +758,15 @@ std::shared_ptr<EntityAuxiliaryNames> Terminus::parseEntityAuxiliaryNamesPDR(
 }
 
 std::shared_ptr<pldm_numeric_sensor_value_pdr> Terminus::parseNumericSensorPDR(
-    const std::vector<uint8_t>& pdr)
+    std::span<const uint8_t> pdr)
 {
+    /* The PDR may have been replaced since it was indexed */
+    if (pdr.size() < sizeof(pldm_pdr_hdr) ||
+        reinterpret_cast<const pldm_pdr_hdr*>(pdr.data())->type !=
+            PLDM_NUMERIC_SENSOR_PDR)
+    {
+        return nullptr;
+    }
     const uint8_t* ptr = pdr.data();
     auto parsedPdr = std::make_shared<pldm_numeric_sensor_value_pdr>();
     auto rc = decode_numeric_sensor_pdr_data(ptr, pdr.size(), parsedPdr.get());
@@ -417,18 +777,26 @@ std::shared_ptr<pldm_numeric_sensor_value_pdr> Terminus::parseNumericSensorPDR(
     return parsedPdr;
 }
 
-void Terminus::addNumericSensor(
-    const std::shared_ptr<pldm_numeric_sensor_value_pdr> pdr)
+void Terminus::addNumericSensor(size_t pdrIdx)
 {
+    auto pdr = pdrIdx < pdrs.size() ? parseNumericSensorPDR(pdrs[pdrIdx])
+                                    : nullptr;
     if (!pdr)
     {
         lg2::error(
-            "Terminus ID {TID}: Skip adding Numeric Sensor - invalid pointer to PDR.",
+            "Terminus ID {TID}: Skip adding Numeric Sensor - failed to parse PDR.",
             "TID", tid);
         addNextSensorFromPDRs();
+        return;
     }
 
     auto sensorId = pdr->sensor_id;
+    if (hasSensor(sensorId))
+    {
+        addNextSensorFromPDRs();
+        return;
+    }
+
     auto sensorNames = getSensorNames(sensorId);
 
     if (sensorNames.empty())
@@ -446,7 +814,7 @@ void Terminus::addNumericSensor(
         auto sensor = std::make_shared<NumericSensor>(
             tid, true, pdr, sensorName, inventoryPath);
         lg2::info("Created NumericSensor {NAME}", "NAME", sensorName);
-        numericSensors.emplace_back(sensor);
+        insertSensor(std::move(sensor));
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -459,7 +827,7 @@ void Terminus::addNumericSensor(
 }
 
 std::shared_ptr<SensorAuxiliaryNames> Terminus::parseCompactNumericSensorNames(
-    const std::vector<uint8_t>& sPdr)
+    std::span<const uint8_t> sPdr)
 {
     std::vector<std::vector<std::pair<NameLanguageTag, SensorName>>>
         sensorAuxNames{};
@@ -492,11 +860,12 @@ std::shared_ptr<SensorAuxiliaryNames> Terminus::parseCompactNumericSensorNames(
 }
 
 std::shared_ptr<pldm_compact_numeric_sensor_pdr>
-    Terminus::parseCompactNumericSensorPDR(const std::vector<uint8_t>& sPdr)
+    Terminus::parseCompactNumericSensorPDR(std::span<const uint8_t> sPdr)
 {
     auto pdr =
         reinterpret_cast<const pldm_compact_numeric_sensor_pdr*>(sPdr.data());
-    if (sPdr.size() < sizeof(pldm_compact_numeric_sensor_pdr))
+    if (sPdr.size() < sizeof(pldm_compact_numeric_sensor_pdr) ||
+        pdr->hdr.type != PLDM_COMPACT_NUMERIC_SENSOR_PDR)
     {
         // Handle error: input data too small to contain valid pdr
         return nullptr;
@@ -523,18 +892,27 @@ std::shared_ptr<pldm_compact_numeric_sensor_pdr>
     return parsedPdr;
 }
 
-void Terminus::addCompactNumericSensor(
-    const std::shared_ptr<pldm_compact_numeric_sensor_pdr> pdr)
+void Terminus::addCompactNumericSensor(size_t pdrIdx)
 {
+    auto pdr = pdrIdx < pdrs.size()
+                   ? parseCompactNumericSensorPDR(pdrs[pdrIdx])
+                   : nullptr;
     if (!pdr)
     {
         lg2::error(
-            "Terminus ID {TID}: Skip adding Compact Numeric Sensor - invalid pointer to PDR.",
+            "Terminus ID {TID}: Skip adding Compact Numeric Sensor - failed to parse PDR.",
             "TID", tid);
         addNextSensorFromPDRs();
+        return;
     }
 
     auto sensorId = pdr->sensor_id;
+    if (hasSensor(sensorId))
+    {
+        addNextSensorFromPDRs();
+        return;
+    }
+
     auto sensorNames = getSensorNames(sensorId);
 
     if (sensorNames.empty())
@@ -552,7 +930,7 @@ void Terminus::addCompactNumericSensor(
         auto sensor = std::make_shared<NumericSensor>(
             tid, true, pdr, sensorName, inventoryPath);
         lg2::info("Created Compact NumericSensor {NAME}", "NAME", sensorName);
-        numericSensors.emplace_back(sensor);
+        insertSensor(std::move(sensor));
     }
     catch (const sdbusplus::exception_t& e)
     {
@@ -580,17 +958,11 @@ std::shared_ptr<NumericSensor> Terminus::getSensorObject(SensorId id)
         return nullptr;
     }
 
-    for (auto& sensor : numericSensors)
+    auto it = std::ranges::lower_bound(sensorIndex, id, {},
+                                       &SensorIndexEntry::first);
+    if (it != sensorIndex.end() && it->first == id)
     {
-        if (!sensor)
-        {
-            continue;
-        }
-
-        if (sensor->sensorId == id)
-        {
-            return sensor;
-        }
+        return it->second;
     }
 
     return nullptr;
@@ -624,6 +996,19 @@ void Terminus::updateInventoryWithFru(const uint8_t* fruData,
     {
         lg2::info("Terminus ID {TID}: Created Inventory path.", "TID", tid);
     }
+    if (!inventoryItemBoardInft)
+    {
+        return;
+    }
+
+    // Rediscovery and recovery fetch the same FRU table again, there is
+    // nothing to publish then
+    uint64_t hash = pldm::utils::fnvOffsetBasis;
+    pldm::utils::fnvHash(hash, std::span(fruData, fruLen));
+    if (publishedFruHash == hash)
+    {
+        return;
+    }
 
     auto ptr = fruData;
     while (!isTableEnd(fruData, ptr, fruLen))
@@ -672,11 +1057,15 @@ void Terminus::updateInventoryWithFru(const uint8_t* fruData,
                 }
                 fruField = strOptional.value();
 
-                if (fruField.empty())
+                // Only the changed fields are set, each set signals the
+                // inventory consumers
+                auto& published = publishedFruFields[tlv->type];
+                if (fruField.empty() || fruField == published)
                 {
                     ptr += sizeof(pldm_fru_record_tlv) - 1 + tlv->length;
                     continue;
                 }
+                published = fruField;
             }
 
             switch (tlv->type)
@@ -722,6 +1111,9 @@ void Terminus::updateInventoryWithFru(const uint8_t* fruData,
             ptr += sizeof(pldm_fru_record_tlv) - 1 + tlv->length;
         }
     }
+
+    // Only a table published in full is skipped when fetched again
+    publishedFruHash = hash;
 }
 
 std::vector<std::string> Terminus::getSensorNames(const SensorId& sensorId)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "common/pdr_arena.hpp"
 #include "common/types.hpp"
 #include "dbus_impl_fru.hpp"
 #include "numeric_sensor.hpp"
@@ -14,7 +15,12 @@
 
 #include <algorithm>
 #include <bitset>
+#include <map>
+#include <optional>
+#include <set>
+#include <span>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -30,7 +36,10 @@ using EntityName = std::string;
 using EntityType = uint16_t;
 using SensorId = uint16_t;
 using SensorCnt = uint8_t;
-using NameLanguageTag = std::string;
+/** @brief Language tag of an auxiliary name, interned in
+ *         pldm::utils::StringPool, the same few tags repeat for every name
+ */
+using NameLanguageTag = std::string_view;
 using SensorName = std::string;
 using SensorAuxiliaryNames = std::tuple<
     SensorId, SensorCnt,
@@ -58,6 +67,53 @@ struct EntityKey
 using AuxiliaryNames = std::vector<std::pair<NameLanguageTag, std::string>>;
 using EntityKey = struct EntityKey;
 using EntityAuxiliaryNames = std::tuple<EntityKey, AuxiliaryNames>;
+using RecordHandle = uint32_t;
+
+/** @struct PdrRepositoryChanges
+ *
+ *  Changes of the terminus PDR repository reported by
+ *  pldmPDRRepositoryChgEvent which are not applied yet.
+ */
+struct PdrRepositoryChanges
+{
+    bool refreshAll = false;                 //!< whole repository changed
+    std::set<RecordHandle> changedRecords{}; //!< added or modified records
+    std::set<RecordHandle> deletedRecords{}; //!< deleted records
+
+    bool empty() const
+    {
+        return !refreshAll && changedRecords.empty() && deletedRecords.empty();
+    }
+
+    /** @brief Merge newer changes into the pending ones */
+    void merge(const PdrRepositoryChanges& changes)
+    {
+        refreshAll |= changes.refreshAll;
+        for (auto handle : changes.changedRecords)
+        {
+            deletedRecords.erase(handle);
+            changedRecords.insert(handle);
+        }
+        for (auto handle : changes.deletedRecords)
+        {
+            changedRecords.erase(handle);
+            deletedRecords.insert(handle);
+        }
+    }
+};
+
+/** @struct PolledEventStats
+ *
+ *  Statistics of the events drained with PollForPlatformEventMessage. The
+ *  terminus does not report the depth of its event queue, the number of
+ *  events drained in one run is the lower bound of it.
+ */
+struct PolledEventStats
+{
+    uint64_t events = 0;          //!< events drained
+    uint64_t budgetExhausted = 0; //!< runs stopped with events left queued
+    uint32_t lastDrainDepth = 0;  //!< events drained by the last run
+};
 
 /**
  * @brief Terminus
@@ -133,6 +189,28 @@ class Terminus
      */
     void parseTerminusPDRs();
 
+    /** @brief Drop the stored PDRs of the types not parsed
+     *
+     *  Only the sensor PDRs and the auxiliary names PDRs are read again, to
+     *  create the sensors or rebuild them on a repository change. A change
+     *  adding back records dropped is harmless, they are dropped again.
+     *
+     *  @return the number of PDRs dropped
+     */
+    size_t dropUnusedPDRs();
+
+    /** @brief Apply a change of the PDR repository to the stored PDRs
+     *
+     *  Only the sensors whose PDRs were added, modified or deleted are
+     *  recreated or removed, unless the change renames the terminus.
+     *
+     *  @param[in] records - added and modified PDRs by record handle
+     *  @param[in] deletedRecords - handles of the deleted PDRs
+     */
+    void updateTerminusPDRs(
+        const std::map<RecordHandle, std::vector<uint8_t>>& records,
+        const std::set<RecordHandle>& deletedRecords);
+
     /** @brief The getter to return terminus's TID */
     pldm_tid_t getTid()
     {
@@ -156,8 +234,8 @@ class Terminus
      */
     void updateInventoryWithFru(const uint8_t* fruData, const size_t fruLen);
 
-    /** @brief A list of PDRs fetched from Terminus */
-    std::vector<std::vector<uint8_t>> pdrs{};
+    /** @brief The PDRs fetched from Terminus */
+    pdr::PdrArena pdrs{};
 
     /** @brief A flag to indicate if terminus has been initialized */
     bool initialized = false;
@@ -173,6 +251,11 @@ class Terminus
     /** @brief A list of numericSensors */
     std::vector<std::shared_ptr<NumericSensor>> numericSensors{};
 
+    /** @brief Incremented whenever sensors are added to or removed from
+     *         numericSensors, the polling queue is rebuilt on a change
+     */
+    uint64_t sensorsGeneration = 0;
+
     /** @brief The flag indicates that the terminus FIFO contains a large
      *         message that will require a multipart transfer via the
      *         PollForPlatformEvent command
@@ -188,6 +271,20 @@ class Terminus
      */
     uint32_t pollDataTransferHandle;
 
+    /** @brief Statistics of the polled events */
+    PolledEventStats polledEventStats{};
+
+    /** @brief PDR repository changes waiting to be fetched from the
+     *         terminus
+     */
+    PdrRepositoryChanges pdrChanges{};
+
+    /** @brief The terminus sends sensorEvents asynchronously, the sensors
+     *         reporting their readings with events are polled at the
+     *         keep-alive rate only
+     */
+    bool asyncSensorEvents = false;
+
     /** @brief Get Sensor Auxiliary Names by sensorID
      *
      *  @param[in] id - sensor ID
@@ -210,14 +307,31 @@ class Terminus
      */
     std::optional<std::string_view> findTerminusName();
 
+    /** @brief Parse the PDRs into the sensor PDR and auxiliary name tables
+     *         and update the terminus name
+     */
+    void parsePDRTables();
+
+    /** @brief Check if a sensor object exists for the sensor ID
+     *
+     *  @param[in] id - sensor ID
+     *  @return true if the terminus has a sensor object with that ID
+     */
+    bool hasSensor(SensorId id) const;
+
+    /** @brief Add a sensor object to numericSensors and the sensor index */
+    void insertSensor(std::shared_ptr<NumericSensor> sensor);
+
+    /** @brief Rebuild the sensor index from numericSensors */
+    void indexSensors();
+
     /** @brief Construct the NumericSensor sensor class for the PLDM sensor.
      *         The NumericSensor class will handle create D-Bus object path,
      *         provide the APIs to update sensor value, threshold...
      *
-     *  @param[in] pdr - the numeric sensor PDR info
+     *  @param[in] pdrIdx - index of the numeric sensor PDR in pdrs
      */
-    void addNumericSensor(
-        const std::shared_ptr<pldm_numeric_sensor_value_pdr> pdr);
+    void addNumericSensor(size_t pdrIdx);
 
     /** @brief Parse the numeric sensor PDRs
      *
@@ -225,31 +339,38 @@ class Terminus
      *  @return pointer to numeric sensor info struct
      */
     std::shared_ptr<pldm_numeric_sensor_value_pdr> parseNumericSensorPDR(
-        const std::vector<uint8_t>& pdrData);
+        std::span<const uint8_t> pdrData);
 
     /** @brief Parse the sensor Auxiliary name PDRs
+     *
+     *  Names longer than PLDM_STR_UTF_16_MAX_LEN characters with their
+     *  terminator, or running past the end of the PDR, fail the whole PDR.
+     *  Unpaired surrogates decode to U+FFFD.
      *
      *  @param[in] pdrData - the response PDRs from GetPDR command
      *  @return pointer to sensor Auxiliary name info struct
      */
     std::shared_ptr<SensorAuxiliaryNames> parseSensorAuxiliaryNamesPDR(
-        const std::vector<uint8_t>& pdrData);
+        std::span<const uint8_t> pdrData);
 
     /** @brief Parse the Entity Auxiliary name PDRs
+     *
+     *  Names longer than PLDM_STR_UTF_16_MAX_LEN characters with their
+     *  terminator fail the whole PDR, longer names used to be accepted.
+     *  Unpaired surrogates decode to U+FFFD.
      *
      *  @param[in] pdrData - the response PDRs from GetPDR command
      *  @return pointer to Entity Auxiliary name info struct
      */
     std::shared_ptr<EntityAuxiliaryNames> parseEntityAuxiliaryNamesPDR(
-        const std::vector<uint8_t>& pdrData);
+        std::span<const uint8_t> pdrData);
 
     /** @brief Construct the NumericSensor sensor class for the compact numeric
      *         PLDM sensor.
      *
-     *  @param[in] pdr - the compact numeric sensor PDR info
+     *  @param[in] pdrIdx - index of the compact numeric sensor PDR in pdrs
      */
-    void addCompactNumericSensor(
-        const std::shared_ptr<pldm_compact_numeric_sensor_pdr> pdr);
+    void addCompactNumericSensor(size_t pdrIdx);
 
     /** @brief Parse the compact numeric sensor PDRs
      *
@@ -257,7 +378,7 @@ class Terminus
      *  @return pointer to compact numeric sensor info struct
      */
     std::shared_ptr<pldm_compact_numeric_sensor_pdr>
-        parseCompactNumericSensorPDR(const std::vector<uint8_t>& pdrData);
+        parseCompactNumericSensorPDR(std::span<const uint8_t> pdrData);
 
     /** @brief Parse the sensor Auxiliary name from compact numeric sensor PDRs
      *
@@ -265,7 +386,7 @@ class Terminus
      *  @return pointer to sensor Auxiliary name info struct
      */
     std::shared_ptr<SensorAuxiliaryNames> parseCompactNumericSensorNames(
-        const std::vector<uint8_t>& pdrData);
+        std::span<const uint8_t> pdrData);
 
     /** @brief Create the terminus inventory path to
      *         /xyz/openbmc_project/inventory/Item/Board/.
@@ -290,6 +411,17 @@ class Terminus
      */
     void addNextSensorFromPDRs();
 
+    /** @brief Get the creation priority of a sensor from its raw PDR
+     *
+     *  Thresholded temperature and power sensors come first since the fan
+     *  control needs them, then the other temperature and power sensors,
+     *  then the other thresholded sensors and the rest.
+     *
+     *  @param[in] pdr - the numeric or compact numeric sensor PDR
+     *  @return priority, lower is created first
+     */
+    static uint8_t sensorCreationPriority(std::span<const uint8_t> pdr);
+
     /* @brief The terminus's TID */
     pldm_tid_t tid;
 
@@ -309,7 +441,7 @@ class Terminus
     /* @brief The PLDM supported type version */
     std::map<uint8_t, ver32_t> supportedTypeVersions;
 
-    /* @brief Sensor Auxiliary Name list */
+    /* @brief Sensor Auxiliary Name list, sorted by sensor ID */
     std::vector<std::shared_ptr<SensorAuxiliaryNames>>
         sensorAuxiliaryNamesTbl{};
 
@@ -326,6 +458,14 @@ class Terminus
     /* @brief Inventory D-Bus object path of the terminus */
     std::string inventoryPath;
 
+    /** @brief Hash of the FRU table last published to the inventory object */
+    std::optional<uint64_t> publishedFruHash;
+
+    /** @brief FRU fields last published to the inventory object, by field
+     *         type
+     */
+    std::map<uint8_t, std::string> publishedFruFields;
+
     /** @brief reference of main event loop of pldmd, primarily used to schedule
      *  work
      */
@@ -334,13 +474,17 @@ class Terminus
     /** @brief The event source to defer sensor creation tasks to event loop*/
     std::unique_ptr<sdeventplus::source::Defer> sensorCreationEvent;
 
-    /** @brief Numeric Sensor PDR list */
-    std::vector<std::shared_ptr<pldm_numeric_sensor_value_pdr>>
-        numericSensorPdrs{};
+    /** @brief Indexes of the Numeric and Compact Numeric Sensor PDRs in
+     *         pdrs, in sensor creation order. They are only decoded when
+     *         creating the sensor
+     */
+    std::vector<size_t> sensorPdrs{};
+
+    using SensorIndexEntry =
+        std::pair<SensorId, std::shared_ptr<NumericSensor>>;
 
-    /** @brief Compact Numeric Sensor PDR list */
-    std::vector<std::shared_ptr<pldm_compact_numeric_sensor_pdr>>
-        compactNumericSensorPdrs{};
+    /** @brief numericSensors sorted by sensor ID */
+    std::vector<SensorIndexEntry> sensorIndex{};
 
     /** @brief Iteration to loop through sensor PDRs when adding sensors */
     SensorId sensorPdrIt = 0;
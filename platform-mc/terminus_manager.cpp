@@ -1,5 +1,6 @@
 #include "terminus_manager.hpp"
 
+#include "common/daemon_stats.hpp"
 #include "manager.hpp"
 
 #include <phosphor-logging/lg2.hpp>
@@ -194,15 +195,31 @@ exec::task<int> TerminusManager::discoverMctpTerminusTask()
         }
 
         const MctpInfos& mctpInfos = queuedMctpInfos.front();
+
+        /* Initialize up to discoveryConcurrency new termini at a time */
+        exec::async_scope initScope;
+        size_t inFlight = 0;
         for (const auto& mctpInfo : mctpInfos)
         {
-            auto it = findTerminusPtr(mctpInfo);
-            if (it == termini.end())
+            if (findTerminusPtr(mctpInfo) != termini.end())
             {
-                mctpInfoAvailTable[mctpInfo] = true;
-                co_await initMctpTerminus(mctpInfo);
+                continue;
             }
 
+            mctpInfoAvailTable[mctpInfo] = true;
+            initScope.spawn(
+                initMctpTerminus(mctpInfo) | stdexec::then([](int) {}),
+                exec::default_task_context<void>(exec::inline_scheduler{}));
+            if (++inFlight == discoveryConcurrency)
+            {
+                co_await initScope.on_empty();
+                inFlight = 0;
+            }
+        }
+        co_await initScope.on_empty();
+
+        for (const auto& mctpInfo : mctpInfos)
+        {
             /* Get TID of initialized terminus */
             auto tid = toTid(mctpInfo);
             if (!tid)
@@ -226,6 +243,7 @@ exec::task<int> TerminusManager::discoverMctpTerminusTask()
 
 void TerminusManager::removeMctpTerminus(const MctpInfos& mctpInfos)
 {
+    bool removed = false;
     // remove terminus
     for (const auto& mctpInfo : mctpInfos)
     {
@@ -240,9 +258,16 @@ void TerminusManager::removeMctpTerminus(const MctpInfos& mctpInfos)
             manager->stopSensorPolling(it->second->getTid());
         }
 
+        terminusHealth.erase(it->first);
         unmapTid(it->first);
         termini.erase(it);
         mctpInfoAvailTable.erase(mctpInfo);
+        removed = true;
+    }
+    if (removed)
+    {
+        // The PDRs and sensors of the termini were freed at once
+        pldm::utils::releaseFreedMemory();
     }
 }
 
@@ -291,6 +316,11 @@ exec::task<int> TerminusManager::initMctpTerminus(const MctpInfo& mctpInfo)
                 isMapped = false;
             }
         }
+        /* The TID is claimed by a terminus still being initialized */
+        else if (tidPool[tid])
+        {
+            isMapped = false;
+        }
         /* Use the terminus TID for mapping */
         else
         {
@@ -364,56 +394,75 @@ exec::task<int> TerminusManager::initMctpTerminus(const MctpInfo& mctpInfo)
         co_return PLDM_ERROR;
     }
 
-    uint8_t type = PLDM_BASE;
+    /* Query the version and commands of all supported types together */
     auto size = PLDM_MAX_TYPES * (PLDM_MAX_CMDS_PER_TYPE / 8);
     std::vector<uint8_t> pldmCmds(size);
-    while ((type < PLDM_MAX_TYPES))
+    exec::async_scope typeScope;
+    for (uint8_t type = PLDM_BASE; type < PLDM_MAX_TYPES; type++)
     {
-        if (!termini[tid]->doesSupportType(type))
+        if (termini[tid]->doesSupportType(type))
         {
-            type++;
-            continue;
-        }
-
-        ver32_t version{0xFF, 0xFF, 0xFF, 0xFF};
-        auto rc = co_await getPLDMVersion(tid, type, &version);
-        if (rc)
-        {
-            lg2::error(
-                "Failed to Get PLDM Version for terminus {TID}, PLDM Type {TYPE}, error {ERROR}",
-                "TID", tid, "TYPE", type, "ERROR", rc);
-        }
-        termini[tid]->setSupportedTypeVersions(type, version);
-        std::vector<bitfield8_t> cmds(PLDM_MAX_CMDS_PER_TYPE / 8);
-        rc = co_await getPLDMCommands(tid, type, version, cmds.data());
-        if (rc)
-        {
-            lg2::error(
-                "Failed to Get PLDM Commands for terminus {TID}, error {ERROR}",
-                "TID", tid, "ERROR", rc);
+            typeScope.spawn(
+                getPLDMTypeInfo(tid, type, pldmCmds),
+                exec::default_task_context<void>(exec::inline_scheduler{}));
         }
+    }
+    co_await typeScope.on_empty();
 
-        for (size_t i = 0; i < cmds.size(); i++)
-        {
-            auto idx = type * (PLDM_MAX_CMDS_PER_TYPE / 8) + i;
-            if (idx >= pldmCmds.size())
-            {
-                lg2::error(
-                    "Calculated index {IDX} out of bounds for pldmCmds, type {TYPE}, command index {CMD_IDX}",
-                    "IDX", idx, "TYPE", type, "CMD_IDX", i);
-                continue;
-            }
-            pldmCmds[idx] = cmds[i].byte;
-        }
-        type++;
+    if (!termini.contains(tid))
+    {
+        co_return PLDM_ERROR;
     }
     termini[tid]->setSupportedCommands(pldmCmds);
 
     co_return PLDM_SUCCESS;
 }
 
+exec::task<void> TerminusManager::getPLDMTypeInfo(
+    pldm_tid_t tid, uint8_t type, std::vector<uint8_t>& pldmCmds)
+{
+    ver32_t version{0xFF, 0xFF, 0xFF, 0xFF};
+    auto rc = co_await getPLDMVersion(tid, type, &version);
+    if (rc)
+    {
+        lg2::error(
+            "Failed to Get PLDM Version for terminus {TID}, PLDM Type {TYPE}, error {ERROR}",
+            "TID", tid, "TYPE", type, "ERROR", rc);
+    }
+
+    /* The terminus may have been removed while waiting */
+    auto it = termini.find(tid);
+    if (it == termini.end() || !it->second)
+    {
+        co_return;
+    }
+    it->second->setSupportedTypeVersions(type, version);
+
+    std::vector<bitfield8_t> cmds(PLDM_MAX_CMDS_PER_TYPE / 8);
+    rc = co_await getPLDMCommands(tid, type, version, cmds.data());
+    if (rc)
+    {
+        lg2::error(
+            "Failed to Get PLDM Commands for terminus {TID}, error {ERROR}",
+            "TID", tid, "ERROR", rc);
+    }
+
+    for (size_t i = 0; i < cmds.size(); i++)
+    {
+        auto idx = type * (PLDM_MAX_CMDS_PER_TYPE / 8) + i;
+        if (idx >= pldmCmds.size())
+        {
+            lg2::error(
+                "Calculated index {IDX} out of bounds for pldmCmds, type {TYPE}, command index {CMD_IDX}",
+                "IDX", idx, "TYPE", type, "CMD_IDX", i);
+            continue;
+        }
+        pldmCmds[idx] = cmds[i].byte;
+    }
+}
+
 exec::task<int> TerminusManager::sendRecvPldmMsgOverMctp(
-    mctp_eid_t eid, Request& request, const pldm_msg** responseMsg,
+    mctp_eid_t eid, RequestMsg& request, const pldm_msg** responseMsg,
     size_t* responseLen)
 {
     int rc = 0;
@@ -443,8 +492,8 @@ exec::task<int> TerminusManager::sendRecvPldmMsgOverMctp(
 exec::task<int> TerminusManager::getTidOverMctp(mctp_eid_t eid, pldm_tid_t* tid)
 {
     auto instanceId = instanceIdDb.next(eid);
-    Request request(sizeof(pldm_msg_hdr));
-    auto requestMsg = new (request.data()) pldm_msg;
+    PldmMsg<0> request;
+    auto requestMsg = request.msg();
     auto rc = encode_get_tid_req(instanceId, requestMsg);
     if (rc)
     {
@@ -489,8 +538,8 @@ exec::task<int> TerminusManager::getTidOverMctp(mctp_eid_t eid, pldm_tid_t* tid)
 exec::task<int> TerminusManager::setTidOverMctp(mctp_eid_t eid, pldm_tid_t tid)
 {
     auto instanceId = instanceIdDb.next(eid);
-    Request request(sizeof(pldm_msg_hdr) + sizeof(pldm_set_tid_req));
-    auto requestMsg = new (request.data()) pldm_msg;
+    PldmMsg<sizeof(pldm_set_tid_req)> request;
+    auto requestMsg = request.msg();
     auto rc = encode_set_tid_req(instanceId, tid, requestMsg);
     if (rc)
     {
@@ -526,8 +575,8 @@ exec::task<int> TerminusManager::setTidOverMctp(mctp_eid_t eid, pldm_tid_t tid)
 exec::task<int> TerminusManager::getPLDMTypes(pldm_tid_t tid,
                                               uint64_t& supportedTypes)
 {
-    Request request(sizeof(pldm_msg_hdr));
-    auto requestMsg = new (request.data()) pldm_msg;
+    PldmMsg<0> request;
+    auto requestMsg = request.msg();
     auto rc = encode_get_types_req(0, requestMsg);
     if (rc)
     {
@@ -573,8 +622,8 @@ exec::task<int> TerminusManager::getPLDMTypes(pldm_tid_t tid,
 exec::task<int> TerminusManager::getPLDMCommands(
     pldm_tid_t tid, uint8_t type, ver32_t version, bitfield8_t* supportedCmds)
 {
-    Request request(sizeof(pldm_msg_hdr) + PLDM_GET_COMMANDS_REQ_BYTES);
-    auto requestMsg = new (request.data()) pldm_msg;
+    PldmMsg<PLDM_GET_COMMANDS_REQ_BYTES> request;
+    auto requestMsg = request.msg();
 
     auto rc = encode_get_commands_req(0, type, version, requestMsg);
     if (rc)
@@ -621,7 +670,7 @@ exec::task<int> TerminusManager::getPLDMCommands(
 }
 
 exec::task<int> TerminusManager::sendRecvPldmMsg(
-    pldm_tid_t tid, Request& request, const pldm_msg** responseMsg,
+    pldm_tid_t tid, RequestMsg& request, const pldm_msg** responseMsg,
     size_t* responseLen)
 {
     /**
@@ -661,31 +710,165 @@ exec::task<int> TerminusManager::sendRecvPldmMsg(
     }
 
     auto eid = std::get<0>(mctpInfo.value());
-    auto requestMsg = new (request.data()) pldm_msg;
+    auto requestMsg = request.msg();
     requestMsg->hdr.instance_id = instanceIdDb.next(eid);
     auto rc = co_await sendRecvPldmMsgOverMctp(eid, request, responseMsg,
                                                responseLen);
 
-    if (rc == PLDM_ERROR_NOT_READY)
+    updateTerminusHealth(tid, mctpInfo.value(), rc);
+
+    co_return rc;
+}
+
+void TerminusManager::updateTerminusHealth(pldm_tid_t tid,
+                                           const MctpInfo& mctpInfo, int rc)
+{
+    if (rc == PLDM_SUCCESS)
     {
-        // Call Recover() to check enpoint's availability
-        // Set endpoint's availability in mctpInfoTable to false in advance
-        // to prevent message forwarding through this endpoint while mctpd
-        // is checking the endpoint.
-        std::string endpointObjPath =
-            constructEndpointObjPath(mctpInfo.value());
-        pldm::utils::recoverMctpEndpoint(endpointObjPath);
-        updateMctpEndpointAvailability(mctpInfo.value(), false);
+        auto it = terminusHealth.find(tid);
+        if (it != terminusHealth.end() &&
+            it->second.health == TerminusHealth::Degraded)
+        {
+            lg2::info("Terminus ID {TID} is responding again.", "TID", tid);
+            terminusHealth.erase(it);
+        }
+        return;
     }
 
-    co_return rc;
+    /* Only a missing response tells about the liveness of the terminus */
+    if (rc != PLDM_ERROR_NOT_READY)
+    {
+        return;
+    }
+
+    auto& state = terminusHealth[tid];
+    if (state.health == TerminusHealth::Unreachable ||
+        state.health == TerminusHealth::Recovering)
+    {
+        return;
+    }
+
+    if (++state.failures < healthFailureThreshold)
+    {
+        state.health = TerminusHealth::Degraded;
+        return;
+    }
+
+    lg2::error(
+        "Terminus ID {TID} did not respond to {COUNT} requests, it is unreachable.",
+        "TID", tid, "COUNT", state.failures);
+    state.health = TerminusHealth::Unreachable;
+
+    // Call Recover() to check enpoint's availability
+    // Set endpoint's availability in mctpInfoTable to false in advance
+    // to prevent message forwarding through this endpoint while mctpd
+    // is checking the endpoint.
+    std::string endpointObjPath = constructEndpointObjPath(mctpInfo);
+    pldm::utils::recoverMctpEndpoint(endpointObjPath);
+    updateMctpEndpointAvailability(mctpInfo, false);
+
+    scheduleTerminusProbe(tid);
+}
+
+TerminusHealth TerminusManager::getTerminusHealth(pldm_tid_t tid) const
+{
+    auto it = terminusHealth.find(tid);
+    if (it == terminusHealth.end())
+    {
+        return TerminusHealth::Healthy;
+    }
+    return it->second.health;
+}
+
+void TerminusManager::scheduleTerminusProbe(pldm_tid_t tid)
+{
+    auto& state = terminusHealth[tid];
+    state.backoff = state.backoff.count()
+                        ? std::min(state.backoff * 2, probeMaxInterval)
+                        : probeMinInterval;
+
+    /* Up to a quarter of jitter, termini lost together are not probed in
+     * lockstep */
+    auto jitterRange = state.backoff.count() / 4;
+    std::uniform_int_distribution<int64_t> jitter(-jitterRange, jitterRange);
+    auto delay = state.backoff + std::chrono::milliseconds(jitter(probeJitter));
+
+    if (!state.probeTimer)
+    {
+        state.probeTimer =
+            std::make_unique<sdbusplus::Timer>(event.get(), [this, tid]() {
+                stats::DaemonStats::getInstance().setLoopActivity(
+                    "TerminusManager probe", tid);
+                probeScope.spawn(
+                    probeTerminus(tid),
+                    exec::default_task_context<void>(exec::inline_scheduler{}));
+            });
+    }
+    state.probeTimer->start(
+        std::chrono::duration_cast<std::chrono::microseconds>(delay));
+}
+
+void TerminusManager::probeTerminusNow(pldm_tid_t tid)
+{
+    auto it = terminusHealth.find(tid);
+    if (it == terminusHealth.end() ||
+        it->second.health != TerminusHealth::Unreachable)
+    {
+        return;
+    }
+
+    if (it->second.probeTimer)
+    {
+        it->second.probeTimer->stop();
+    }
+    probeScope.spawn(
+        probeTerminus(tid),
+        exec::default_task_context<void>(exec::inline_scheduler{}));
+}
+
+exec::task<void> TerminusManager::probeTerminus(pldm_tid_t tid)
+{
+    auto mctpInfo = toMctpInfo(tid);
+    if (!mctpInfo || !terminusHealth.contains(tid))
+    {
+        co_return;
+    }
+    terminusHealth[tid].health = TerminusHealth::Recovering;
+
+    pldm_tid_t probedTid = PLDM_TID_RESERVED;
+    auto rc = co_await getTidOverMctp(std::get<0>(*mctpInfo), &probedTid);
+
+    /* The terminus was removed meanwhile */
+    if (!terminusHealth.contains(tid))
+    {
+        co_return;
+    }
+
+    if (rc != PLDM_SUCCESS || probedTid != tid)
+    {
+        terminusHealth[tid].health = TerminusHealth::Unreachable;
+        scheduleTerminusProbe(tid);
+        co_return;
+    }
+
+    lg2::info("Terminus ID {TID} responds to GetTID, it is available again.",
+              "TID", tid);
+    terminusHealth.erase(tid);
+    if (manager)
+    {
+        manager->updateMctpEndpointAvailability(*mctpInfo, true);
+    }
+    else
+    {
+        updateMctpEndpointAvailability(*mctpInfo, true);
+    }
 }
 
 exec::task<int> TerminusManager::getPLDMVersion(pldm_tid_t tid, uint8_t type,
                                                 ver32_t* version)
 {
-    Request request(sizeof(pldm_msg_hdr) + PLDM_GET_VERSION_REQ_BYTES);
-    auto requestMsg = new (request.data()) pldm_msg;
+    PldmMsg<PLDM_GET_VERSION_REQ_BYTES> request;
+    auto requestMsg = request.msg();
 
     auto rc =
         encode_get_version_req(0, 0, PLDM_GET_FIRSTPART, type, requestMsg);
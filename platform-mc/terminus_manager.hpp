@@ -9,11 +9,16 @@
 #include <libpldm/platform.h>
 #include <libpldm/pldm.h>
 
+#include <sdbusplus/timer.hpp>
+
+#include <algorithm>
+#include <chrono>
 #include <limits>
 #include <map>
 #include <memory>
 #include <optional>
 #include <queue>
+#include <random>
 #include <utility>
 #include <vector>
 
@@ -36,6 +41,29 @@ using RequesterHandler = requester::Handler<requester::Request>;
 using TerminiMapper = std::map<pldm_tid_t, std::shared_ptr<Terminus>>;
 
 class Manager;
+
+/** @brief Health of a terminus, as seen from the responses to its requests
+ */
+enum class TerminusHealth
+{
+    Healthy,     //!< Responding
+    Degraded,    //!< Recent requests got no response
+    Unreachable, //!< Marked unavailable, probed with back-off
+    Recovering,  //!< Liveness probe in flight
+};
+
+/** @struct TerminusHealthState
+ *
+ *  Health of a terminus and the state of its liveness probing
+ */
+struct TerminusHealthState
+{
+    TerminusHealth health = TerminusHealth::Healthy;
+    size_t failures = 0;                      //!< requests without response
+    std::chrono::milliseconds backoff{0};     //!< delay of the last probe
+    std::unique_ptr<sdbusplus::Timer> probeTimer; //!< starts the next probe
+};
+
 /**
  * @brief TerminusManager
  *
@@ -87,7 +115,7 @@ class TerminusManager
      *  @param[out] responseLen - length of response PLDM message
      *  @return coroutine return_value - PLDM completion code
      */
-    exec::task<int> sendRecvPldmMsg(pldm_tid_t tid, Request& request,
+    exec::task<int> sendRecvPldmMsg(pldm_tid_t tid, RequestMsg& request,
                                     const pldm_msg** responseMsg,
                                     size_t* responseLen);
 
@@ -101,7 +129,7 @@ class TerminusManager
      *  @return coroutine return_value - PLDM completion code
      */
     virtual exec::task<int> sendRecvPldmMsgOverMctp(
-        mctp_eid_t eid, Request& request, const pldm_msg** responseMsg,
+        mctp_eid_t eid, RequestMsg& request, const pldm_msg** responseMsg,
         size_t* responseLen);
 
     /** @brief member functions to map/unmap tid
@@ -181,7 +209,47 @@ class TerminusManager
     std::optional<mctp_eid_t> getActiveEidByName(
         const std::string& terminusName);
 
+    /** @brief Get the health of a terminus
+     *
+     *  @param[in] tid - Terminus TID
+     *
+     *  @return the health, Healthy for a terminus never failing a request
+     */
+    TerminusHealth getTerminusHealth(pldm_tid_t tid) const;
+
+    /** @brief Probe an unreachable terminus now instead of at its next
+     *         back-off, e.g. when its MCTP endpoint becomes available again.
+     *         The terminus is made available once it responds to GetTID.
+     *         A recovering terminus is left to its probe in flight.
+     *
+     *  @param[in] tid - Terminus TID
+     */
+    void probeTerminusNow(pldm_tid_t tid);
+
   private:
+    /** @brief Update the health of a terminus from the result of a request
+     *
+     *  @param[in] tid - Terminus TID
+     *  @param[in] mctpInfo - MCTP endpoint of the terminus
+     *  @param[in] rc - result of the request
+     */
+    void updateTerminusHealth(pldm_tid_t tid, const MctpInfo& mctpInfo,
+                              int rc);
+
+    /** @brief Start the probe timer of an unreachable terminus, doubling the
+     *         back-off with jitter up to the maximum probe interval
+     *
+     *  @param[in] tid - Terminus TID
+     */
+    void scheduleTerminusProbe(pldm_tid_t tid);
+
+    /** @brief Send GetTID to an unreachable terminus and make it available
+     *         again when it responds
+     *
+     *  @param[in] tid - Terminus TID
+     */
+    exec::task<void> probeTerminus(pldm_tid_t tid);
+
     /** @brief Find the terminus object pointer in termini list.
      *
      *  @param[in] mctpInfos - list information of the MCTP endpoints
@@ -253,6 +321,17 @@ class TerminusManager
                                     ver32_t version,
                                     bitfield8_t* supportedCmds);
 
+    /** @brief Send getPLDMVersion and getPLDMCommands for one PLDM type and
+     *         store the results in the terminus
+     *
+     *  @param[in] tid - Destination TID
+     *  @param[in] type - PLDM Type
+     *  @param[out] pldmCmds - supported commands of all types, the bytes of
+     *                         this type are filled in
+     */
+    exec::task<void> getPLDMTypeInfo(pldm_tid_t tid, uint8_t type,
+                                     std::vector<uint8_t>& pldmCmds);
+
     /** @brief Reference to a Handler object that manages the request/response
      *         logic.
      */
@@ -280,6 +359,10 @@ class TerminusManager
     std::optional<std::pair<exec::async_scope, std::optional<int>>>
         discoverMctpTerminusTaskHandle{};
 
+    /** @brief maximum number of termini initialized at the same time */
+    size_t discoveryConcurrency =
+        std::max(TERMINUS_DISCOVERY_CONCURRENCY, 1);
+
     /** @brief A Manager interface for calling the hook functions **/
     Manager* manager;
 
@@ -289,6 +372,26 @@ class TerminusManager
     /** @brief MCTP Endpoint available status mapping */
     std::map<MctpInfo, Availability> mctpInfoAvailTable;
 
+    /** @brief Health of the termini failing requests */
+    std::map<pldm_tid_t, TerminusHealthState> terminusHealth;
+
+    /** @brief Consecutive requests without response making a terminus
+     *         unreachable
+     */
+    static constexpr size_t healthFailureThreshold = 3;
+
+    /** @brief First and maximum back-off of the liveness probes */
+    const std::chrono::milliseconds probeMinInterval{
+        TERMINUS_PROBE_MIN_INTERVAL};
+    const std::chrono::milliseconds probeMaxInterval{
+        std::max(TERMINUS_PROBE_MAX_INTERVAL, TERMINUS_PROBE_MIN_INTERVAL)};
+
+    /** @brief Jitter of the probe back-off */
+    std::minstd_rand probeJitter{std::random_device{}()};
+
+    /** @brief scope of the liveness probes in flight */
+    exec::async_scope probeScope;
+
     /** @brief reference of main event loop of pldmd, primarily used to schedule
      *  work
      */
@@ -1,8 +1,16 @@
 #include "common/test/mocked_utils.hpp"
 #include "common/utils.hpp"
 #include "platform-mc/dbus_to_terminus_effecters.hpp"
+#include "utils_test.hpp"
 
 #include <nlohmann/json.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -32,6 +40,8 @@ class MockHostEffecterParser : public HostEffecterParser
     {
         return hostEffecterInfo;
     }
+
+    using HostEffecterParser::encodeNumericEffecterRequest;
 };
 
 TEST(HostEffecterParser, parseEffecterJsonGoodPath)
@@ -90,6 +100,7 @@ TEST(HostEffecterParser, parseEffecterJsonGoodPath)
     ASSERT_EQ(tempNumeric.resolution == dbusInfoNumeric.resolution, true);
     ASSERT_EQ(tempNumeric.offset == dbusInfoNumeric.offset, true);
     ASSERT_EQ(tempNumeric.unitModifier == dbusInfoNumeric.unitModifier, true);
+    ASSERT_DOUBLE_EQ(tempNumeric.unitDivisor, 0.001);
 }
 
 TEST(HostEffecterParser, parseEffecterJsonBadPath)
@@ -142,3 +153,93 @@ TEST(HostEffecterParser, adjustValue)
     realVal = hostEffecterParser.adjustValue(2.35, 0, 1, -1);
     ASSERT_EQ(realVal, 24);
 }
+
+TEST(HostEffecterParser, coalesceStateEffecterWrites)
+{
+    MockdBusHandler dbusHandler;
+    int sockfd{};
+    auto event = sdeventplus::Event::get_default();
+    MockHostEffecterParser hostEffecterParser(sockfd, nullptr, &dbusHandler,
+                                              "./host_effecter_jsons/good");
+
+    std::vector<uint8_t> sentStates;
+    EXPECT_CALL(hostEffecterParser, setHostStateEffecter(0, testing::_, 4))
+        .Times(2)
+        .WillRepeatedly(
+            [&sentStates](size_t,
+                          std::vector<set_effecter_state_field>& stateField,
+                          uint16_t) {
+                EXPECT_EQ(1, stateField.size());
+                EXPECT_EQ(PLDM_REQUEST_SET, stateField[0].set_request);
+                sentStates.emplace_back(stateField[0].effecter_state);
+                return PLDM_SUCCESS;
+            });
+
+    /* The first write is sent at once, the next ones within the interval
+     * are coalesced into one write of the latest state */
+    hostEffecterParser.queueStateEffecterWrite(0, {{PLDM_REQUEST_SET, 1}}, 4);
+    hostEffecterParser.queueStateEffecterWrite(0, {{PLDM_REQUEST_SET, 2}}, 4);
+    hostEffecterParser.queueStateEffecterWrite(0, {{PLDM_REQUEST_SET, 3}}, 4);
+    EXPECT_EQ(std::vector<uint8_t>({1}), sentStates);
+
+    utils::runEventLoopForSeconds(event, 1);
+    EXPECT_EQ(std::vector<uint8_t>({1, 3}), sentStates);
+}
+
+TEST(HostEffecterParser, numericEffecterRequestMatchesEncoder)
+{
+    MockdBusHandler dbusHandler;
+    int sockfd{};
+    MockHostEffecterParser hostEffecterParser(sockfd, nullptr, &dbusHandler,
+                                              "./host_effecter_jsons/good");
+
+    struct Write
+    {
+        uint8_t dataSize;
+        double rawValue;
+        std::vector<uint8_t> value; // as the effecter data size
+    };
+    auto bytesOf = [](auto value) {
+        std::vector<uint8_t> bytes(sizeof(value));
+        std::memcpy(bytes.data(), &value, sizeof(value));
+        return bytes;
+    };
+    std::vector<Write> writes{
+        {PLDM_EFFECTER_DATA_SIZE_UINT8, 200, bytesOf(uint8_t{200})},
+        {PLDM_EFFECTER_DATA_SIZE_SINT8, -100, bytesOf(int8_t{-100})},
+        {PLDM_EFFECTER_DATA_SIZE_UINT16, 0xbeef, bytesOf(uint16_t{0xbeef})},
+        {PLDM_EFFECTER_DATA_SIZE_SINT16, -1234, bytesOf(int16_t{-1234})},
+        {PLDM_EFFECTER_DATA_SIZE_UINT32, 0xdeadbeef,
+         bytesOf(uint32_t{0xdeadbeef})},
+        {PLDM_EFFECTER_DATA_SIZE_SINT32, -123456, bytesOf(int32_t{-123456})},
+    };
+
+    // The second round patches the requests encoded by the first one
+    for (uint8_t instanceId : {1, 31})
+    {
+        for (const auto& [dataSize, rawValue, value] : writes)
+        {
+            auto payloadLength = PLDM_SET_NUMERIC_EFFECTER_VALUE_MIN_REQ_BYTES -
+                                 1 + value.size();
+            std::vector<uint8_t> expected(sizeof(pldm_msg_hdr) + payloadLength);
+            ASSERT_EQ(PLDM_SUCCESS,
+                      encode_set_numeric_effecter_value_req(
+                          instanceId, 0x1234, dataSize,
+                          const_cast<uint8_t*>(value.data()),
+                          reinterpret_cast<pldm_msg*>(expected.data()),
+                          payloadLength));
+
+            pldm::RequestMsg requestMsg;
+            ASSERT_EQ(PLDM_SUCCESS,
+                      hostEffecterParser.encodeNumericEffecterRequest(
+                          instanceId, 0x1234, dataSize, rawValue, requestMsg));
+            std::span<const uint8_t> request = requestMsg;
+            EXPECT_TRUE(std::ranges::equal(expected, request))
+                << "data size " << static_cast<int>(dataSize);
+        }
+    }
+
+    pldm::RequestMsg requestMsg;
+    EXPECT_NE(PLDM_SUCCESS, hostEffecterParser.encodeNumericEffecterRequest(
+                                1, 0x1234, 0xff, 0, requestMsg));
+}
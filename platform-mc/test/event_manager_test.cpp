@@ -166,6 +166,189 @@ TEST_F(EventManagerTest, processNumericSensorEventTest)
         tid, 0x00, PLDM_SENSOR_EVENT, eventData.data(), eventData.size());
     EXPECT_EQ(PLDM_SUCCESS, rc);
     EXPECT_EQ(PLDM_EVENT_NO_LOGGING, platformEventStatus);
+
+    /* Without asynchronous sensor events the sensor keeps being polled */
+    auto sensor = termini[tid]->getSensorObject(1);
+    ASSERT_NE(nullptr, sensor);
+    EXPECT_FALSE(sensor->eventDriven);
+
+    /* The reading of an asynchronous event updates the sensor */
+    termini[tid]->asyncSensorEvents = true;
+    rc = eventManager.handlePlatformEvent(
+        tid, 0x00, PLDM_SENSOR_EVENT, eventData.data(), eventData.size());
+    EXPECT_EQ(PLDM_SUCCESS, rc);
+    EXPECT_TRUE(sensor->eventDriven);
+    EXPECT_NE(0, sensor->timeStamp);
+}
+
+TEST_F(EventManagerTest, processPdrRepositoryChgEventTest)
+{
+    pldm_tid_t tid = 1;
+    termini[tid] = std::make_shared<pldm::platform_mc::Terminus>(
+        tid, 1 << PLDM_BASE | 1 << PLDM_PLATFORM, event);
+    auto terminus = termini[tid];
+
+    auto numericSensorPdr = [](uint8_t recordHandle, uint8_t sensorId,
+                               uint8_t warningHigh) {
+        return std::vector<uint8_t>{
+            recordHandle, 0x0, 0x0, 0x0,            // record handle
+            0x1,                                    // PDRHeaderVersion
+            PLDM_NUMERIC_SENSOR_PDR,                // PDRType
+            0x0, 0x0,                               // recordChangeNumber
+            PLDM_PDR_NUMERIC_SENSOR_PDR_MIN_LENGTH, 0, // dataLength
+            0, 0,                                   // PLDMTerminusHandle
+            sensorId, 0x0,                          // sensorID
+            PLDM_ENTITY_POWER_SUPPLY, 0,            // entityType
+            1, 0,                                   // entityInstanceNumber
+            1, 0,                                   // containerID=1
+            PLDM_NO_INIT,                           // sensorInit
+            false,                       // sensorAuxiliaryNamesPDR
+            PLDM_SENSOR_UNIT_DEGRESS_C,  // baseUint(2)=degrees C
+            0,                           // unitModifier = 0
+            0,                           // rateUnit
+            0,                           // baseOEMUnitHandle
+            0,                           // auxUnit
+            0,                           // auxUnitModifier
+            0,                           // auxRateUnit
+            0,                           // rel
+            0,                           // auxOEMUnitHandle
+            true,                        // isLinear
+            PLDM_SENSOR_DATA_SIZE_UINT8, // sensorDataSize
+            0, 0, 0x80, 0x3f,            // resolution=1.0
+            0, 0, 0, 0,                  // offset=0
+            0, 0,                        // accuracy
+            0,                           // plusTolerance
+            0,                           // minusTolerance
+            2,                           // hysteresis = 2
+            0x1b,                        // supportedThresholds
+            0,                           // thresholdAndHysteresisVolatility
+            0, 0, 0x80, 0x3f,            // stateTransistionInterval=1.0
+            0, 0, 0x80, 0x3f,            // updateInverval=1.0
+            255,                         // maxReadable
+            0,                           // minReadable
+            PLDM_RANGE_FIELD_FORMAT_UINT8, // rangeFieldFormat
+            0x18,                          // rangeFieldsupport
+            0,                             // nominalValue
+            0,                             // normalMax
+            0,                             // normalMin
+            warningHigh,                   // warningHigh
+            20,                            // warningLow
+            60,                            // criticalHigh
+            10,                            // criticalLow
+            0,                             // fatalHigh
+            0                              // fatalLow
+        };
+    };
+
+    std::vector<uint8_t> entityAuxNamesPdr{
+        0x3, 0x0, 0x0,
+        0x0,                             // record handle
+        0x1,                             // PDRHeaderVersion
+        PLDM_ENTITY_AUXILIARY_NAMES_PDR, // PDRType
+        0x1,
+        0x0,                             // recordChangeNumber
+        0x11,
+        0,                               // dataLength
+        /* Entity Auxiliary Names PDR Data*/
+        3,
+        0x80, // entityType system software
+        0x1,
+        0x0,  // Entity instance number =1
+        0,
+        0,    // Overal system
+        0,    // shared Name Count one name only
+        01,   // nameStringCount
+        0x65, 0x6e, 0x00,
+        0x00, // Language Tag "en"
+        0x53, 0x00, 0x30, 0x00,
+        0x00  // Entity Name "S0"
+    };
+
+    terminus->pdrs.emplace_back(numericSensorPdr(1, 1, 45));
+    terminus->pdrs.emplace_back(numericSensorPdr(2, 2, 45));
+    terminus->pdrs.emplace_back(entityAuxNamesPdr);
+    terminus->parseTerminusPDRs();
+    utils::runEventLoopForSeconds(event, 1);
+    ASSERT_EQ(2, terminus->numericSensors.size());
+    auto sensor1 = terminus->getSensorObject(1);
+    auto sensor2 = terminus->getSensorObject(2);
+
+    /* Record 2 modified and deleted, record 1 modified */
+    std::vector<uint8_t> eventData{
+        FORMAT_IS_PDR_HANDLES,
+        2,                     // numberOfChangeRecords
+        PLDM_RECORDS_MODIFIED,
+        2,                     // numberOfChangeEntries
+        0x1, 0x0, 0x0, 0x0,    // record handle 1
+        0x2, 0x0, 0x0, 0x0,    // record handle 2
+        PLDM_RECORDS_DELETED,
+        1,                     // numberOfChangeEntries
+        0x2, 0x0, 0x0, 0x0     // record handle 2
+    };
+    auto rc = eventManager.handlePlatformEvent(
+        tid, 0x00, PLDM_PDR_REPOSITORY_CHG_EVENT, eventData.data(),
+        eventData.size());
+    EXPECT_EQ(PLDM_SUCCESS, rc);
+    EXPECT_FALSE(terminus->pdrChanges.refreshAll);
+    EXPECT_EQ(std::set<pldm::platform_mc::RecordHandle>{1},
+              terminus->pdrChanges.changedRecords);
+    EXPECT_EQ(std::set<pldm::platform_mc::RecordHandle>{2},
+              terminus->pdrChanges.deletedRecords);
+
+    /* A truncated change record is rejected */
+    eventData.pop_back();
+    rc = eventManager.handlePlatformEvent(
+        tid, 0x00, PLDM_PDR_REPOSITORY_CHG_EVENT, eventData.data(),
+        eventData.size());
+    EXPECT_NE(PLDM_SUCCESS, rc);
+
+    /* Only the sensor of the modified record is recreated */
+    terminus->updateTerminusPDRs({{1, numericSensorPdr(1, 1, 50)}},
+                                 terminus->pdrChanges.deletedRecords);
+    utils::runEventLoopForSeconds(event, 1);
+    EXPECT_EQ(2, terminus->pdrs.size());
+    ASSERT_EQ(1, terminus->numericSensors.size());
+    EXPECT_NE(sensor1, terminus->getSensorObject(1));
+    EXPECT_EQ(nullptr, terminus->getSensorObject(2));
+
+    /* An added record only creates its sensor */
+    sensor1 = terminus->getSensorObject(1);
+    terminus->updateTerminusPDRs({{2, numericSensorPdr(2, 2, 45)}}, {});
+    utils::runEventLoopForSeconds(event, 1);
+    EXPECT_EQ(3, terminus->pdrs.size());
+    ASSERT_EQ(2, terminus->numericSensors.size());
+    EXPECT_EQ(sensor1, terminus->getSensorObject(1));
+    EXPECT_NE(nullptr, terminus->getSensorObject(2));
+
+    std::vector<uint8_t> refreshEventData{REFRESH_ENTIRE_REPOSITORY, 0};
+    rc = eventManager.handlePlatformEvent(
+        tid, 0x00, PLDM_PDR_REPOSITORY_CHG_EVENT, refreshEventData.data(),
+        refreshEventData.size());
+    EXPECT_EQ(PLDM_SUCCESS, rc);
+    EXPECT_TRUE(terminus->pdrChanges.refreshAll);
+}
+
+TEST_F(EventManagerTest, processPdrRepositoryChgEventUnknownTerminus)
+{
+    pldm_tid_t tid = 1;
+    pldm_tid_t unknownTid = 2;
+    termini[tid] = std::make_shared<pldm::platform_mc::Terminus>(
+        tid, 1 << PLDM_BASE | 1 << PLDM_PLATFORM, event);
+
+    std::vector<uint8_t> eventData{REFRESH_ENTIRE_REPOSITORY, 0};
+    auto rc = eventManager.handlePlatformEvent(
+        unknownTid, 0x00, PLDM_PDR_REPOSITORY_CHG_EVENT, eventData.data(),
+        eventData.size());
+    EXPECT_NE(PLDM_SUCCESS, rc);
+    rc = eventManager.processPdrRepositoryChgEvent(
+        unknownTid, eventData.data(), eventData.size());
+    EXPECT_NE(PLDM_SUCCESS, rc);
+
+    /* No terminus is added for the TID, initializing the termini does not
+     * come across an empty one */
+    EXPECT_FALSE(termini.contains(unknownTid));
+    EXPECT_EQ(1, termini.size());
+    EXPECT_FALSE(termini[tid]->pdrChanges.refreshAll);
 }
 
 TEST_F(EventManagerTest, SetEventReceiverTest)
@@ -384,6 +567,8 @@ TEST_F(EventManagerTest, SetEventReceiverTest)
     EXPECT_EQ(true, terminus->initialized);
     EXPECT_EQ(32, terminus->maxBufferSize);
     EXPECT_EQ(0x06, terminus->synchronyConfigurationSupported.byte);
+    /* Asynchronous events including the sensorEvent class */
+    EXPECT_TRUE(terminus->asyncSensorEvents);
     EXPECT_EQ(2, terminus->pdrs.size());
     EXPECT_EQ(1, terminus->numericSensors.size());
 }
@@ -503,4 +688,11 @@ TEST_F(EventManagerTest, pollForPlatformEventTaskMultipartTransferTest)
     // start task to poll event from terminus
     // should finish immediately
     stdexec::sync_wait(eventManager.pollForPlatformEventTask(tid, 0x0000));
+
+    /* One event drained, within the budget */
+    auto& stats = termini[tid]->polledEventStats;
+    EXPECT_EQ(1, stats.events);
+    EXPECT_EQ(1, stats.lastDrainDepth);
+    EXPECT_EQ(0, stats.budgetExhausted);
+    EXPECT_FALSE(termini[tid]->pollEvent);
 }
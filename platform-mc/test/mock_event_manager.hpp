@@ -15,6 +15,8 @@ class MockEventManager : public EventManager
     MockEventManager(TerminusManager& terminusManager, TerminiMapper& termini) :
         EventManager(terminusManager, termini) {};
 
+    using EventManager::processPdrRepositoryChgEvent;
+
     MOCK_METHOD(int, processCperEvent,
                 (pldm_tid_t tid, uint16_t eventId, const uint8_t* eventData,
                  size_t eventDataSize),
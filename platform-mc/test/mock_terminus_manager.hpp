@@ -22,13 +22,13 @@ class MockTerminusManager : public TerminusManager
     {}
 
     exec::task<int> sendRecvPldmMsgOverMctp(
-        mctp_eid_t /*eid*/, Request& /*request*/, const pldm_msg** responseMsg,
-        size_t* responseLen) override
+        mctp_eid_t /*eid*/, RequestMsg& /*request*/,
+        const pldm_msg** responseMsg, size_t* responseLen) override
     {
         if (responseMsgs.empty() || responseMsg == nullptr ||
             responseLen == nullptr)
         {
-            co_return PLDM_ERROR;
+            co_return noResponseRc;
         }
 
         *responseMsg = responseMsgs.front();
@@ -68,6 +68,8 @@ class MockTerminusManager : public TerminusManager
 
     std::queue<pldm_msg*> responseMsgs;
     std::queue<size_t> responseLens;
+    /* Returned when no response is queued */
+    int noResponseRc = PLDM_ERROR;
 };
 
 } // namespace platform_mc
@@ -5,6 +5,10 @@
 #include <libpldm/entity.h>
 #include <libpldm/platform.h>
 
+#include <limits>
+#include <memory>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 TEST(NumericSensor, conversionFormula)
@@ -101,6 +105,14 @@ TEST(NumericSensor, conversionFormula)
 
     // (40*1.5 + 1.0 ) * 10^1 = 610
     EXPECT_EQ(610, convertedValue);
+    EXPECT_DOUBLE_EQ(convertedValue, sensor.convertReading(reading));
+
+    std::vector<double> rawValues{0, 40, 100};
+    std::vector<double> values(rawValues.size());
+    sensor.convertReadings(rawValues, values);
+    EXPECT_DOUBLE_EQ(10, values[0]);
+    EXPECT_DOUBLE_EQ(610, values[1]);
+    EXPECT_DOUBLE_EQ(1510, values[2]);
 }
 
 TEST(NumericSensor, checkThreshold)
@@ -270,3 +282,172 @@ TEST(NumericSensor, checkThreshold)
                                      hysteresis);
     EXPECT_EQ(false, lowAlarm);
 }
+
+class TestNumericSensor : public testing::Test
+{
+  protected:
+    /** @brief A sensor read as is, with hysteresis 2 and the thresholds
+     *         critical low 20, warning low 30, warning high 40 and critical
+     *         high 50
+     */
+    TestNumericSensor()
+    {
+        std::vector<uint8_t> pdr{
+            0x1, 0x0, 0x0, 0x0,      // record handle
+            0x1,                     // PDRHeaderVersion
+            PLDM_NUMERIC_SENSOR_PDR, // PDRType
+            0x0, 0x0,                // recordChangeNumber
+            PLDM_PDR_NUMERIC_SENSOR_PDR_FIXED_LENGTH +
+                PLDM_PDR_NUMERIC_SENSOR_PDR_VARIED_SENSOR_DATA_SIZE_MIN_LENGTH +
+                PLDM_PDR_NUMERIC_SENSOR_PDR_VARIED_RANGE_FIELD_MIN_LENGTH,
+            0,                             // dataLength
+            0, 0,                          // PLDMTerminusHandle
+            0x2, 0x0,                      // sensorID=2
+            PLDM_ENTITY_POWER_SUPPLY, 0,   // entityType=Power Supply(120)
+            1, 0,                          // entityInstanceNumber
+            0x1, 0x0,                      // containerID=1
+            PLDM_NO_INIT,                  // sensorInit
+            false,                         // sensorAuxiliaryNamesPDR
+            PLDM_SENSOR_UNIT_DEGRESS_C,    // baseUint(2)=degrees C
+            0,                             // unitModifier = 0
+            0,                             // rateUnit
+            0,                             // baseOEMUnitHandle
+            0,                             // auxUnit
+            0,                             // auxUnitModifier
+            0,                             // auxRateUnit
+            0,                             // rel
+            0,                             // auxOEMUnitHandle
+            true,                          // isLinear
+            PLDM_RANGE_FIELD_FORMAT_UINT8, // sensorDataSize
+            0, 0, 0x80, 0x3f,              // resolution=1.0
+            0, 0, 0, 0,                    // offset=0
+            0, 0,                          // accuracy
+            0,                             // plusTolerance
+            0,                             // minusTolerance
+            2,                             // hysteresis
+            0x1b,                          // supportedThresholds
+            0,                             // thresholdAndHysteresisVolatility
+            0, 0, 0x80, 0x3f,              // stateTransistionInterval=1.0
+            0, 0, 0x80, 0x3f,              // updateInverval=1.0
+            255,                           // maxReadable
+            0,                             // minReadable
+            PLDM_RANGE_FIELD_FORMAT_UINT8, // rangeFieldFormat
+            0,                             // rangeFieldsupport
+            0,                             // nominalValue
+            0,                             // normalMax
+            0,                             // normalMin
+            40,                            // warningHigh
+            30,                            // warningLow
+            50,                            // criticalHigh
+            20,                            // criticalLow
+            0,                             // fatalHigh
+            0                              // fatalLow
+        };
+        auto numericSensorPdr =
+            std::make_shared<pldm_numeric_sensor_value_pdr>();
+        EXPECT_EQ(decode_numeric_sensor_pdr_data(pdr.data(), pdr.size(),
+                                                 numericSensorPdr.get()),
+                  PLDM_SUCCESS);
+        std::string sensorName{"thresholds"};
+        std::string inventoryPath{
+            "/xyz/openbmc_project/inventroy/Item/Board/PLDM_device_1"};
+        sensor = std::make_unique<pldm::platform_mc::NumericSensor>(
+            0x01, false, numericSensorPdr, sensorName, inventoryPath);
+    }
+
+    pldm::platform_mc::ThresholdWarning& warning()
+    {
+        return *sensor->thresholdWarningIntf;
+    }
+
+    pldm::platform_mc::ThresholdCritical& critical()
+    {
+        return *sensor->thresholdCriticalIntf;
+    }
+
+    size_t bandCount() const
+    {
+        return sensor->thresholdBandCount;
+    }
+
+    bool quiet(double value) const
+    {
+        return sensor->thresholdsQuiet(value);
+    }
+
+    std::unique_ptr<pldm::platform_mc::NumericSensor> sensor;
+};
+
+TEST_F(TestNumericSensor, cacheThresholds)
+{
+    EXPECT_EQ(bandCount(), 4);
+    EXPECT_TRUE(quiet(35));
+    EXPECT_FALSE(quiet(40));
+    EXPECT_FALSE(quiet(30));
+
+    // A threshold set over D-Bus is cached right away
+    warning().warningHigh(45);
+    EXPECT_TRUE(quiet(42));
+    EXPECT_FALSE(quiet(45));
+
+    // A threshold cleared has no band
+    critical().criticalLow(std::numeric_limits<double>::quiet_NaN());
+    EXPECT_EQ(bandCount(), 3);
+    warning().warningLow(std::numeric_limits<double>::quiet_NaN());
+    EXPECT_EQ(bandCount(), 2);
+    EXPECT_TRUE(quiet(0));
+}
+
+TEST_F(TestNumericSensor, updateThresholds)
+{
+    // reading      35->41->39->37->51->47->35->29->31->33->19
+    // warningHigh   F->T ->T ->F ->T ->T ->F ->F ->F ->F ->F
+    // criticalHigh  F->F ->F ->F ->T ->F ->F ->F ->F ->F ->F
+    // warningLow    F->F ->F ->F ->F ->F ->F ->T ->T ->F ->T
+    // criticalLow   F->F ->F ->F ->F ->F ->F ->F ->F ->F ->T
+    struct Step
+    {
+        double reading;
+        bool warningHigh;
+        bool criticalHigh;
+        bool warningLow;
+        bool criticalLow;
+    };
+    std::vector<Step> steps{
+        {35, false, false, false, false}, {41, true, false, false, false},
+        {39, true, false, false, false},  {37, false, false, false, false},
+        {51, true, true, false, false},   {47, true, false, false, false},
+        {35, false, false, false, false}, {29, false, false, true, false},
+        {31, false, false, true, false},  {33, false, false, false, false},
+        {19, false, false, true, true},
+    };
+    for (const auto& step : steps)
+    {
+        sensor->updateReading(true, true, step.reading);
+        EXPECT_EQ(warning().warningAlarmHigh(), step.warningHigh)
+            << step.reading;
+        EXPECT_EQ(critical().criticalAlarmHigh(), step.criticalHigh)
+            << step.reading;
+        EXPECT_EQ(warning().warningAlarmLow(), step.warningLow)
+            << step.reading;
+        EXPECT_EQ(critical().criticalAlarmLow(), step.criticalLow)
+            << step.reading;
+    }
+}
+
+TEST_F(TestNumericSensor, quietReadingsLeaveAlarms)
+{
+    // Between the thresholds with no alarm, the bands are not evaluated
+    sensor->updateReading(true, true, 35);
+    EXPECT_TRUE(quiet(35));
+
+    // A reading asserting an alarm leaves the fast path until deasserted
+    sensor->updateReading(true, true, 41);
+    EXPECT_TRUE(warning().warningAlarmHigh());
+    EXPECT_FALSE(quiet(39));
+    sensor->updateReading(true, true, 39);
+    EXPECT_TRUE(warning().warningAlarmHigh());
+    sensor->updateReading(true, true, 37);
+    EXPECT_FALSE(warning().warningAlarmHigh());
+    EXPECT_TRUE(quiet(37));
+}
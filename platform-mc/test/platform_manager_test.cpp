@@ -4,8 +4,11 @@
 #include "test/test_instance_id.hpp"
 #include "utils_test.hpp"
 
+#include <libpldm/utils.h>
+
 #include <sdeventplus/event.hpp>
 
+#include <algorithm>
 #include <bitset>
 
 #include <gtest/gtest.h>
@@ -359,6 +362,86 @@ TEST_F(PlatformManagerTest, parseTerminusNameTest)
     EXPECT_EQ("S0", terminus->getTerminusName().value());
 }
 
+TEST_F(PlatformManagerTest, multipartGetPDRTest)
+{
+    // Add terminus
+    auto mappedTid = mockTerminusManager.mapTid(pldm::MctpInfo(10, "", "", 1));
+    auto tid = mappedTid.value();
+    termini[tid] = std::make_shared<pldm::platform_mc::Terminus>(
+        tid, 1 << PLDM_BASE | 1 << PLDM_PLATFORM, event);
+    auto terminus = termini[tid];
+
+    /* Set supported command by terminus */
+    auto size = PLDM_MAX_TYPES * (PLDM_MAX_CMDS_PER_TYPE / 8);
+    std::vector<uint8_t> pldmCmds(size);
+    uint8_t type = PLDM_PLATFORM;
+    uint8_t cmd = PLDM_GET_PDR;
+    auto idx = type * (PLDM_MAX_CMDS_PER_TYPE / 8) + (cmd / 8);
+    pldmCmds[idx] = pldmCmds[idx] | (1 << (cmd % 8));
+    termini[tid]->setSupportedCommands(pldmCmds);
+
+    std::vector<uint8_t> auxNamePdr{
+        // Common PDR Header
+        0x1, 0x0, 0x0,
+        0x0,                             // record handle
+        0x1,                             // PDRHeaderVersion
+        PLDM_ENTITY_AUXILIARY_NAMES_PDR, // PDRType
+        0x1,
+        0x0,                             // recordChangeNumber
+        0x11,
+        0,                               // dataLength
+        /* Entity Auxiliary Names PDR Data*/
+        3,
+        0x80, // entityType system software
+        0x1,
+        0x0,  // Entity instance number =1
+        0,
+        0,    // Overall system
+        0,    // shared Name Count one name only
+        01,   // nameStringCount
+        0x65, 0x6e, 0x00,
+        0x00, // Language Tag "en"
+        0x53, 0x00, 0x30, 0x00,
+        0x00  // Entity Name "S0"
+    };
+
+    // queue the record as a start part and an end part carrying the CRC
+    const size_t firstPartLen = 15;
+    std::vector<uint8_t> startResp{
+        0x0, 0x02, 0x51, PLDM_SUCCESS, 0x0, 0x0, 0x0,
+        0x0,                // nextRecordHandle
+        0x1, 0x0, 0x0, 0x0, // nextDataTransferHandle
+        PLDM_PLATFORM_TRANSFER_START, // transferFlag
+        firstPartLen, 0x0,  // responseCount
+    };
+    startResp.insert(startResp.end(), auxNamePdr.begin(),
+                     auxNamePdr.begin() + firstPartLen);
+    auto rc = mockTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(startResp.data()), startResp.size());
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    std::vector<uint8_t> endResp{
+        0x0, 0x02, 0x51, PLDM_SUCCESS, 0x0, 0x0, 0x0,
+        0x0,                // nextRecordHandle
+        0x0, 0x0, 0x0, 0x0, // nextDataTransferHandle
+        PLDM_PLATFORM_TRANSFER_END, // transferFlag
+        static_cast<uint8_t>(auxNamePdr.size() - firstPartLen),
+        0x0, // responseCount
+    };
+    endResp.insert(endResp.end(), auxNamePdr.begin() + firstPartLen,
+                   auxNamePdr.end());
+    endResp.push_back(crc8(auxNamePdr.data(), auxNamePdr.size()));
+    rc = mockTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(endResp.data()), endResp.size());
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    stdexec::sync_wait(platformManager.initTerminus());
+    EXPECT_EQ(true, terminus->initialized);
+    ASSERT_EQ(1, terminus->pdrs.size());
+    EXPECT_TRUE(std::ranges::equal(auxNamePdr, terminus->pdrs[0]));
+    EXPECT_EQ("S0", terminus->getTerminusName().value());
+}
+
 TEST_F(PlatformManagerTest, initTerminusDontSupportGetPDRTest)
 {
     // Add terminus
@@ -0,0 +1,63 @@
+#include "platform-mc/sensor_history.hpp"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::platform_mc;
+
+TEST(SensorHistoryTest, window)
+{
+    SensorHistory history(3);
+    EXPECT_EQ(3, history.capacity());
+    EXPECT_TRUE(history.empty());
+    EXPECT_TRUE(std::isnan(history.average()));
+
+    history.push(1, 10);
+    history.push(2, 30);
+    EXPECT_EQ(std::vector<SensorSample>({{1, 10}, {2, 30}}),
+              history.getSamples());
+    EXPECT_EQ(10, history.min());
+    EXPECT_EQ(30, history.max());
+    EXPECT_EQ(20, history.average());
+
+    /* The oldest sample, holding the minimum, leaves the window */
+    history.push(3, 20);
+    history.push(4, 40);
+    EXPECT_EQ(3, history.size());
+    EXPECT_EQ(std::vector<SensorSample>({{2, 30}, {3, 20}, {4, 40}}),
+              history.getSamples());
+    EXPECT_EQ(20, history.min());
+    EXPECT_EQ(40, history.max());
+    EXPECT_EQ(30, history.average());
+}
+
+TEST(SensorHistoryTest, unavailableReadings)
+{
+    SensorHistory history(2);
+    history.push(1, 5);
+    history.push(2, std::numeric_limits<double>::quiet_NaN());
+    EXPECT_EQ(2, history.size());
+    EXPECT_EQ(5, history.min());
+    EXPECT_EQ(5, history.average());
+
+    history.push(3, std::numeric_limits<double>::quiet_NaN());
+    EXPECT_TRUE(std::isnan(history.min()));
+    EXPECT_TRUE(std::isnan(history.max()));
+    EXPECT_TRUE(std::isnan(history.average()));
+
+    history.push(4, 7);
+    EXPECT_EQ(7, history.min());
+    EXPECT_EQ(7, history.max());
+    EXPECT_EQ(7, history.average());
+}
+
+TEST(SensorHistoryTest, disabled)
+{
+    SensorHistory history;
+    history.push(1, 5);
+    EXPECT_TRUE(history.empty());
+    EXPECT_TRUE(history.getSamples().empty());
+}
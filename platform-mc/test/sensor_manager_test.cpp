@@ -1,16 +1,184 @@
 #include "common/instance_id.hpp"
 #include "common/types.hpp"
 #include "mock_sensor_manager.hpp"
+#include "mock_terminus_manager.hpp"
 #include "platform-mc/terminus_manager.hpp"
 #include "test/test_instance_id.hpp"
 #include "utils_test.hpp"
 
 #include <sdeventplus/event.hpp>
 
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 using namespace ::testing;
 
+class BatchSensorManager : public pldm::platform_mc::MockSensorManager
+{
+  public:
+    using MockSensorManager::MockSensorManager;
+    using SensorManager::findSensorReadBatchHandler;
+    using SensorManager::readSensorBatch;
+};
+
+/** @brief Sensor manager polling the sensors itself */
+class PollingSensorManager : public pldm::platform_mc::SensorManager
+{
+  public:
+    using SensorManager::pollingConcurrency;
+    using SensorManager::SensorManager;
+};
+
+/** @brief Requests kept outstanding until the test completes them, the
+ *         stopped ones are dropped
+ */
+class PendingReads
+{
+  public:
+    class Read
+    {
+      public:
+        virtual void complete() = 0;
+
+      protected:
+        ~Read() = default;
+    };
+
+    void add(Read* read)
+    {
+        reads.emplace_back(read);
+        started++;
+        maxOutstanding = std::max(maxOutstanding, reads.size());
+    }
+
+    void remove(Read* read)
+    {
+        std::erase(reads, read);
+    }
+
+    /** @brief Complete the outstanding requests, not the ones they start */
+    void completeAll()
+    {
+        for (auto read : std::exchange(reads, {}))
+        {
+            read->complete();
+        }
+    }
+
+    size_t outstanding() const
+    {
+        return reads.size();
+    }
+
+    size_t started = 0;
+    size_t maxOutstanding = 0;
+
+  private:
+    std::vector<Read*> reads;
+};
+
+template <stdexec::receiver R>
+class PendingReadOperation final : public PendingReads::Read
+{
+  public:
+    PendingReadOperation(PendingReads& reads, R&& r) :
+        reads(reads), receiver(std::move(r))
+    {}
+
+    friend void tag_invoke(stdexec::start_t, PendingReadOperation& op) noexcept
+    {
+        auto stopToken = stdexec::get_stop_token(stdexec::get_env(op.receiver));
+        if (stopToken.stop_requested())
+        {
+            return stdexec::set_stopped(std::move(op.receiver));
+        }
+        op.reads.add(&op);
+        if (stopToken.stop_possible())
+        {
+            op.stopCallback.emplace(std::move(stopToken), StopRequest{&op});
+        }
+    }
+
+    void complete() override
+    {
+        stopCallback.reset();
+        reads.remove(this);
+        stdexec::set_value(std::move(receiver));
+    }
+
+  private:
+    struct StopRequest
+    {
+        PendingReadOperation* op;
+
+        void operator()() noexcept
+        {
+            op->reads.remove(op);
+            stdexec::set_stopped(std::move(op->receiver));
+        }
+    };
+
+    PendingReads& reads;
+    R receiver;
+    std::optional<typename stdexec::stop_token_of_t<
+        stdexec::env_of_t<R>>::template callback_type<StopRequest>>
+        stopCallback = std::nullopt;
+};
+
+struct PendingReadSender
+{
+    using is_sender = void;
+
+    PendingReads& reads;
+
+    friend auto tag_invoke(stdexec::get_completion_signatures_t,
+                           const PendingReadSender&, auto)
+        -> stdexec::completion_signatures<stdexec::set_value_t(),
+                                          stdexec::set_stopped_t()>;
+
+    template <stdexec::receiver R>
+    friend auto tag_invoke(stdexec::connect_t, PendingReadSender&& self, R r)
+    {
+        return PendingReadOperation<R>(self.reads, std::move(r));
+    }
+};
+
+/** @brief Terminus manager whose requests stay outstanding until the test
+ *         completes them, without a response
+ */
+class PendingTerminusManager : public pldm::platform_mc::TerminusManager
+{
+  public:
+    PendingTerminusManager(sdeventplus::Event& event,
+                           pldm::platform_mc::RequesterHandler& handler,
+                           pldm::InstanceIdDb& instanceIdDb,
+                           pldm::platform_mc::TerminiMapper& termini) :
+        TerminusManager(event, handler, instanceIdDb, termini, nullptr,
+                        pldm::BmcMctpEid),
+        db(instanceIdDb)
+    {}
+
+    exec::task<int> sendRecvPldmMsgOverMctp(
+        mctp_eid_t eid, pldm::RequestMsg& request, const pldm_msg** responseMsg,
+        size_t* responseLen) override
+    {
+        db.free(eid, request.msg()->hdr.instance_id);
+        co_await PendingReadSender{reads};
+        *responseMsg = nullptr;
+        *responseLen = 0;
+        co_return PLDM_ERROR;
+    }
+
+    PendingReads reads;
+
+  private:
+    pldm::InstanceIdDb& db;
+};
+
 class SensorManagerTest : public testing::Test
 {
   protected:
@@ -136,8 +304,8 @@ TEST_F(SensorManagerTest, sensorPollingTest)
     uint64_t seconds = 10;
     pldm_tid_t tid = 1;
     termini[tid] = std::make_shared<pldm::platform_mc::Terminus>(tid, 0, event);
-    termini[tid]->pdrs.push_back(pdr1);
-    termini[tid]->pdrs.push_back(pdr2);
+    termini[tid]->pdrs.emplace_back(pdr1);
+    termini[tid]->pdrs.emplace_back(pdr2);
     termini[tid]->parseTerminusPDRs();
 
     uint64_t t0, t1;
@@ -158,3 +326,217 @@ TEST_F(SensorManagerTest, sensorPollingTest)
 
     sensorManager.stopPolling(tid);
 }
+
+TEST_F(SensorManagerTest, sensorPollingPhaseTest)
+{
+    using std::chrono::milliseconds;
+    EXPECT_EQ(sensorManager.getPollingTime(1),
+              milliseconds(SENSOR_POLLING_TIME));
+    sensorManager.setPollingTime(2, milliseconds(1000));
+    EXPECT_EQ(sensorManager.getPollingTime(2), milliseconds(1000));
+
+    // Termini discovered together are spread over the period
+    sensorManager.setPollingTime(1, milliseconds(1000));
+    sensorManager.setPollingTime(3, milliseconds(1000));
+    std::vector<milliseconds> phases;
+    for (pldm_tid_t tid = 1; tid <= 3; tid++)
+    {
+        phases.push_back(sensorManager.getPollingPhase(tid));
+        EXPECT_LT(phases.back(), milliseconds(1000));
+    }
+    std::ranges::sort(phases);
+    EXPECT_GE(phases[1] - phases[0], milliseconds(200));
+    EXPECT_GE(phases[2] - phases[1], milliseconds(200));
+}
+
+TEST_F(SensorManagerTest, pollStateLifecycleTest)
+{
+    using std::chrono::milliseconds;
+    pldm_tid_t tid = 1;
+    termini[tid] = std::make_shared<pldm::platform_mc::Terminus>(tid, 0, event);
+    sensorManager.setPollingTime(tid, milliseconds(500));
+
+    // Termini not discovered are not polled
+    sensorManager.startPolling(2);
+    EXPECT_FALSE(sensorManager.getAvailableState(2));
+
+    sensorManager.startPolling(tid);
+    EXPECT_TRUE(sensorManager.getAvailableState(tid));
+    sensorManager.updateAvailableState(tid, false);
+    EXPECT_FALSE(sensorManager.getAvailableState(tid));
+    sensorManager.updateAvailableState(tid, true);
+
+    // The polling period outlives the polling
+    sensorManager.stopPolling(tid);
+    EXPECT_FALSE(sensorManager.getAvailableState(tid));
+    EXPECT_TRUE(sensorManager.getPollStats().empty());
+    EXPECT_EQ(sensorManager.getPollingTime(tid), milliseconds(500));
+
+    // and polling restarts
+    sensorManager.startPolling(tid);
+    EXPECT_TRUE(sensorManager.getAvailableState(tid));
+    sensorManager.stopPolling(tid);
+}
+
+TEST_F(SensorManagerTest, sensorPollQueueOrderTest)
+{
+    pldm_tid_t tid = 1;
+    termini[tid] = std::make_shared<pldm::platform_mc::Terminus>(tid, 0, event);
+    termini[tid]->pdrs.emplace_back(pdr1);
+    termini[tid]->pdrs.emplace_back(pdr2);
+    termini[tid]->parseTerminusPDRs();
+    auto& sensors = termini[tid]->numericSensors;
+    ASSERT_FALSE(sensors.empty());
+
+    pldm::platform_mc::SensorPollQueue queue;
+    queue.push(300, sensors[0]);
+    queue.push(100, sensors[0]);
+    queue.push(200, sensors[0]);
+    queue.push(100, sensors[0]);
+    EXPECT_EQ(queue.size(), 4);
+
+    std::vector<uint64_t> order;
+    while (!queue.empty())
+    {
+        order.push_back(queue.top().due);
+        queue.pop();
+    }
+    EXPECT_EQ(order, (std::vector<uint64_t>{100, 100, 200, 300}));
+}
+
+TEST_F(SensorManagerTest, sensorReadBatchTest)
+{
+    pldm::platform_mc::MockTerminusManager mockTerminusManager(
+        event, reqHandler, instanceIdDb, termini, nullptr);
+    BatchSensorManager batchSensorManager(event, mockTerminusManager, termini,
+                                          nullptr);
+
+    auto tid = mockTerminusManager.mapTid(pldm::MctpInfo(10, "", "", 1));
+    ASSERT_TRUE(tid.has_value());
+    termini[*tid] =
+        std::make_shared<pldm::platform_mc::Terminus>(*tid, 0, event);
+    auto pdr3 = pdr1;
+    pdr3[0] = 0x2;  // record handle
+    pdr3[12] = 0x2; // sensorID=2
+    termini[*tid]->pdrs.emplace_back(pdr1);
+    termini[*tid]->pdrs.emplace_back(pdr3);
+    termini[*tid]->pdrs.emplace_back(pdr2);
+    termini[*tid]->parseTerminusPDRs();
+    auto& sensors = termini[*tid]->numericSensors;
+    ASSERT_EQ(sensors.size(), 2);
+
+    EXPECT_FALSE(batchSensorManager.findSensorReadBatchHandler(*sensors[0]));
+
+    /* A command reading the raw values of sensors 1 and 2, one byte each */
+    std::vector<uint16_t> encoded;
+    pldm::platform_mc::SensorReadBatchHandler handler{
+        [](const pldm::platform_mc::NumericSensor& sensor) {
+            return sensor.sensorId <= 2;
+        },
+        8,
+        [&encoded](pldm_tid_t, auto batch, pldm::Request& request) {
+            for (const auto& sensor : batch)
+            {
+                encoded.emplace_back(sensor->sensorId);
+            }
+            request.resize(sizeof(pldm_msg_hdr) + batch.size());
+            return PLDM_SUCCESS;
+        },
+        [](pldm_tid_t, auto batch, const pldm_msg* responseMsg,
+           size_t responseLen) {
+            if (responseLen != batch.size() + 1 ||
+                responseMsg->payload[0] != PLDM_SUCCESS)
+            {
+                return PLDM_ERROR_INVALID_LENGTH;
+            }
+            for (size_t i = 0; i < batch.size(); i++)
+            {
+                batch[i]->updateReading(true, true,
+                                        responseMsg->payload[i + 1]);
+            }
+            return PLDM_SUCCESS;
+        }};
+    batchSensorManager.registerSensorReadBatchHandler(handler);
+    EXPECT_EQ(batchSensorManager.findSensorReadBatchHandler(*sensors[1]),
+              std::optional<size_t>(0));
+
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + 3> response{
+        0x0, 0x3f, 0x01, PLDM_SUCCESS, 10, 20};
+    EXPECT_EQ(mockTerminusManager.enqueueResponse(
+                  reinterpret_cast<pldm_msg*>(response.data()),
+                  response.size()),
+              PLDM_SUCCESS);
+    mockTerminusManager.updateMctpEndpointAvailability(
+        pldm::MctpInfo(10, "", "", 1), true);
+
+    EXPECT_CALL(batchSensorManager, doSensorPolling(*tid))
+        .Times(AnyNumber())
+        .WillRepeatedly(Return());
+    batchSensorManager.startPolling(*tid);
+
+    auto result = stdexec::sync_wait(
+        batchSensorManager.readSensorBatch(*tid, handler, sensors));
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(std::get<0>(*result), PLDM_SUCCESS);
+
+    /* Both sensors were read by one request */
+    EXPECT_EQ(encoded, (std::vector<uint16_t>{1, 2}));
+    EXPECT_TRUE(mockTerminusManager.responseMsgs.empty());
+    for (const auto& sensor : sensors)
+    {
+        EXPECT_NE(sensor->timeStamp, 0);
+        EXPECT_FALSE(std::isnan(sensor->getValue()));
+    }
+    EXPECT_LT(sensors[0]->getValue(), sensors[1]->getValue());
+
+    batchSensorManager.stopPolling(*tid);
+}
+
+TEST_F(SensorManagerTest, sensorPollingConcurrencyTest)
+{
+    PendingTerminusManager pendingTerminusManager(event, reqHandler,
+                                                  instanceIdDb, termini);
+    PollingSensorManager pollingSensorManager(event, pendingTerminusManager,
+                                              termini, nullptr);
+    auto concurrency = pollingSensorManager.pollingConcurrency;
+
+    pldm::MctpInfo mctpInfo(10, "", "", 1);
+    auto tid = pendingTerminusManager.mapTid(mctpInfo);
+    ASSERT_TRUE(tid.has_value());
+    termini[*tid] =
+        std::make_shared<pldm::platform_mc::Terminus>(*tid, 0, event);
+    /* Two sensors more than the reads in flight */
+    for (size_t id = 1; id <= concurrency + 2; id++)
+    {
+        auto pdr = pdr1;
+        pdr[0] = static_cast<uint8_t>(id);  // record handle
+        pdr[12] = static_cast<uint8_t>(id); // sensorID
+        termini[*tid]->pdrs.emplace_back(pdr);
+    }
+    termini[*tid]->pdrs.emplace_back(pdr2);
+    termini[*tid]->parseTerminusPDRs();
+    ASSERT_EQ(termini[*tid]->numericSensors.size(), concurrency + 2);
+    pendingTerminusManager.updateMctpEndpointAvailability(mctpInfo, true);
+
+    auto& reads = pendingTerminusManager.reads;
+    pollingSensorManager.setPollingTime(*tid, std::chrono::milliseconds(10));
+    pollingSensorManager.startPolling(*tid);
+    for (int i = 0; i < 100 && !reads.outstanding(); i++)
+    {
+        sd_event_run(event.get(), 10000);
+    }
+    EXPECT_EQ(reads.outstanding(), concurrency);
+
+    /* The reads completing start the reads of the other sensors */
+    reads.completeAll();
+    EXPECT_GT(reads.outstanding(), 0u);
+    EXPECT_LE(reads.outstanding(), concurrency);
+    EXPECT_EQ(reads.maxOutstanding, concurrency);
+
+    /* Stopping drops the reads in flight and ends the polling task */
+    pollingSensorManager.stopPolling(*tid);
+    EXPECT_EQ(reads.outstanding(), 0u);
+    auto started = reads.started;
+    utils::runEventLoopForSeconds(event, 1);
+    EXPECT_EQ(reads.started, started);
+}
@@ -0,0 +1,56 @@
+#include "platform-mc/sensor_publish_policy.hpp"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::platform_mc;
+using namespace std::chrono_literals;
+
+TEST(SensorPublishPolicy, loadAndMatch)
+{
+    char tmpfile[] = "/tmp/pldm_sensor_publish_policy.XXXXXX";
+    auto fd = mkstemp(tmpfile);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    std::ofstream(tmpfile) << R"({
+        "namespaces": [
+            {
+                "namespace": "voltage",
+                "deadband": 0.01,
+                "min_publish_interval_ms": 1000
+            },
+            { "namespace": "current", "deadband": -1 },
+            { "deadband": 0.5 }
+        ],
+        "sensors": [
+            { "name": "PLDM_Device_1_Vout", "deadband": 0.005 }
+        ]
+    })";
+
+    SensorPublishPolicy policies(tmpfile);
+    std::filesystem::remove(tmpfile);
+    EXPECT_EQ(policies.size(), 2);
+
+    EXPECT_EQ(policies.get("/xyz/openbmc_project/sensors/voltage/",
+                           "PLDM_Device_1_Vin"),
+              (PublishPolicy{0.01, 1000ms}));
+    EXPECT_EQ(policies.get("/xyz/openbmc_project/sensors/voltage/",
+                           "PLDM_Device_1_Vout"),
+              (PublishPolicy{0.005, 0ms}));
+    EXPECT_EQ(policies.get("/xyz/openbmc_project/sensors/current/",
+                           "PLDM_Device_1_Iout"),
+              PublishPolicy{});
+}
+
+TEST(SensorPublishPolicy, missingFile)
+{
+    SensorPublishPolicy policies("/nonexistent/sensor_publish_policy.json");
+    EXPECT_EQ(policies.size(), 0);
+    EXPECT_EQ(policies.get("/xyz/openbmc_project/sensors/voltage/", "Vin"),
+              PublishPolicy{});
+}
@@ -0,0 +1,59 @@
+#include "common/utils.hpp"
+#include "platform-mc/numeric_sensor.hpp"
+#include "platform-mc/terminus.hpp"
+#include "pldmd/dbus_impl_sensor_snapshot.hpp"
+
+#include <libpldm/platform.h>
+
+#include <sdeventplus/event.hpp>
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::dbus_api;
+
+/** @brief Add a numeric sensor with a reading to a terminus */
+static void addSensor(pldm::platform_mc::Terminus& terminus,
+                      pldm::platform_mc::SensorId sensorId, double value)
+{
+    auto pdr = std::make_shared<pldm_compact_numeric_sensor_pdr>();
+    pdr->sensor_id = sensorId;
+    pdr->base_unit = PLDM_SENSOR_UNIT_DEGRESS_C;
+    std::string sensorName = "snapshot_" + std::to_string(sensorId);
+    std::string inventoryPath =
+        "/xyz/openbmc_project/inventory/Item/Board/PLDM_device_1";
+    auto sensor = std::make_shared<pldm::platform_mc::NumericSensor>(
+        terminus.getTid(), false, pdr, sensorName, inventoryPath);
+    sensor->updateReading(true, true, value);
+    terminus.numericSensors.emplace_back(sensor);
+}
+
+TEST(SensorSnapshot, nullEntriesSkipped)
+{
+    auto event = sdeventplus::Event::get_default();
+    pldm::platform_mc::TerminiMapper termini;
+    auto terminus = std::make_shared<pldm::platform_mc::Terminus>(
+        1, 1 << PLDM_PLATFORM, event);
+    addSensor(*terminus, 3, 42.0);
+    terminus->numericSensors.emplace_back(nullptr);
+    termini[1] = terminus;
+    termini[2] = nullptr;
+
+    SensorSnapshot snapshot(pldm::utils::DBusHandler::getBus(),
+                            "/xyz/openbmc_project/pldm", termini);
+
+    auto entries = snapshot.getSensorSnapshot(PLDM_TID_RESERVED);
+    ASSERT_EQ(entries.size(), 1u);
+    [[maybe_unused]] auto [tid, sensorId, value, timeStamp, status] =
+        entries.front();
+    EXPECT_EQ(tid, 1);
+    EXPECT_EQ(sensorId, 3);
+    EXPECT_DOUBLE_EQ(value, 42.0);
+    EXPECT_EQ(status, sensorSnapshotAvailable | sensorSnapshotFunctional);
+
+    EXPECT_EQ(snapshot.getSensorSnapshot(1).size(), 1u);
+    EXPECT_TRUE(snapshot.getSensorSnapshot(2).empty());
+    EXPECT_TRUE(snapshot.getSensorSnapshot(3).empty());
+}
@@ -7,6 +7,7 @@
 #include "requester/mctp_endpoint_discovery.hpp"
 #include "requester/request.hpp"
 #include "test/test_instance_id.hpp"
+#include "utils_test.hpp"
 
 #include <libpldm/base.h>
 #include <libpldm/bios.h>
@@ -716,3 +717,42 @@ TEST_F(TerminusManagerTest, getActiveEidByNameTest)
     EXPECT_EQ(10, terminusManager.getActiveEidByName("S0").value());
     EXPECT_EQ(false, terminusManager.getActiveEidByName("S1").has_value());
 }
+
+TEST_F(TerminusManagerTest, terminusHealthTest)
+{
+    using pldm::platform_mc::TerminusHealth;
+    pldm::MctpInfo mctpInfo(12, "", "", 1);
+    auto tid = mockTerminusManager.mapTid(mctpInfo);
+    ASSERT_TRUE(tid.has_value());
+    mockTerminusManager.updateMctpEndpointAvailability(mctpInfo, true);
+    EXPECT_EQ(TerminusHealth::Healthy,
+              mockTerminusManager.getTerminusHealth(*tid));
+
+    /* Requests without response degrade the terminus, then make it
+     * unreachable */
+    mockTerminusManager.noResponseRc = PLDM_ERROR_NOT_READY;
+    pldm::PldmMsg<0> request;
+    const pldm_msg* responseMsg = nullptr;
+    size_t responseLen = 0;
+    for (int i = 0; i < 2; i++)
+    {
+        stdexec::sync_wait(mockTerminusManager.sendRecvPldmMsg(
+            *tid, request, &responseMsg, &responseLen));
+        EXPECT_EQ(TerminusHealth::Degraded,
+                  mockTerminusManager.getTerminusHealth(*tid));
+    }
+    stdexec::sync_wait(mockTerminusManager.sendRecvPldmMsg(
+        *tid, request, &responseMsg, &responseLen));
+    EXPECT_EQ(TerminusHealth::Unreachable,
+              mockTerminusManager.getTerminusHealth(*tid));
+
+    /* The liveness probe brings it back once GetTID is answered */
+    std::array<uint8_t, sizeof(pldm_msg_hdr) + PLDM_GET_TID_RESP_BYTES>
+        getTidResp{0x00, 0x02, 0x02, 0x00, *tid};
+    mockTerminusManager.enqueueResponse(
+        reinterpret_cast<pldm_msg*>(getTidResp.data()), sizeof(getTidResp));
+    utils::runEventLoopForSeconds(event, 2);
+    EXPECT_EQ(TerminusHealth::Healthy,
+              mockTerminusManager.getTerminusHealth(*tid));
+    mockTerminusManager.noResponseRc = PLDM_ERROR;
+}
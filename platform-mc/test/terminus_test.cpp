@@ -1,8 +1,13 @@
 #include "platform-mc/numeric_sensor.hpp"
 #include "platform-mc/terminus.hpp"
+#include "utils_test.hpp"
 
 #include <libpldm/entity.h>
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 TEST(TerminusTest, supportedTypeTest)
@@ -388,3 +393,236 @@ TEST(TerminusTest, parsePDRTestNoSensorPDR)
     auto sensorAuxNames = t1.getSensorAuxiliaryNames(1);
     EXPECT_EQ(nullptr, sensorAuxNames);
 }
+
+TEST(TerminusTest, sensorCreationPriorityTest)
+{
+    auto event = sdeventplus::Event::get_default();
+    auto t1 = pldm::platform_mc::Terminus(1, 1 << PLDM_BASE, event);
+
+    auto numericSensorPdr = [](uint8_t recordHandle, uint8_t sensorId,
+                               uint8_t baseUnit, uint8_t thresholds) {
+        return std::vector<uint8_t>{
+            recordHandle, 0x0, 0x0, 0x0,            // record handle
+            0x1,                                    // PDRHeaderVersion
+            PLDM_NUMERIC_SENSOR_PDR,                // PDRType
+            0x0, 0x0,                               // recordChangeNumber
+            PLDM_PDR_NUMERIC_SENSOR_PDR_MIN_LENGTH, 0, // dataLength
+            0, 0,                                   // PLDMTerminusHandle
+            sensorId, 0x0,                          // sensorID
+            PLDM_ENTITY_POWER_SUPPLY, 0,            // entityType
+            1, 0,                                   // entityInstanceNumber
+            1, 0,                                   // containerID=1
+            PLDM_NO_INIT,                           // sensorInit
+            false,                       // sensorAuxiliaryNamesPDR
+            baseUnit,                    // baseUint
+            0,                           // unitModifier = 0
+            0,                           // rateUnit
+            0,                           // baseOEMUnitHandle
+            0,                           // auxUnit
+            0,                           // auxUnitModifier
+            0,                           // auxRateUnit
+            0,                           // rel
+            0,                           // auxOEMUnitHandle
+            true,                        // isLinear
+            PLDM_SENSOR_DATA_SIZE_UINT8, // sensorDataSize
+            0, 0, 0x80, 0x3f,            // resolution=1.0
+            0, 0, 0, 0,                  // offset=0
+            0, 0,                        // accuracy
+            0,                           // plusTolerance
+            0,                           // minusTolerance
+            2,                           // hysteresis = 2
+            thresholds,                  // supportedThresholds
+            0,                           // thresholdAndHysteresisVolatility
+            0, 0, 0x80, 0x3f,            // stateTransistionInterval=1.0
+            0, 0, 0x80, 0x3f,            // updateInverval=1.0
+            255,                         // maxReadable
+            0,                           // minReadable
+            PLDM_RANGE_FIELD_FORMAT_UINT8, // rangeFieldFormat
+            0x18,                          // rangeFieldsupport
+            0,                             // nominalValue
+            0,                             // normalMax
+            0,                             // normalMin
+            70,                            // warningHigh
+            20,                            // warningLow
+            80,                            // criticalHigh
+            10,                            // criticalLow
+            0,                             // fatalHigh
+            0                              // fatalLow
+        };
+    };
+
+    std::vector<uint8_t> entityAuxNamesPdr{
+        0x5, 0x0, 0x0,
+        0x0,                             // record handle
+        0x1,                             // PDRHeaderVersion
+        PLDM_ENTITY_AUXILIARY_NAMES_PDR, // PDRType
+        0x1,
+        0x0,                             // recordChangeNumber
+        0x11,
+        0,                               // dataLength
+        /* Entity Auxiliary Names PDR Data*/
+        3,
+        0x80, // entityType system software
+        0x1,
+        0x0,  // Entity instance number =1
+        0,
+        0,    // Overall system
+        0,    // shared Name Count one name only
+        01,   // nameStringCount
+        0x65, 0x6e, 0x00,
+        0x00, // Language Tag "en"
+        0x53, 0x00, 0x30, 0x00,
+        0x00  // Entity Name "S0"
+    };
+
+    t1.pdrs.emplace_back(numericSensorPdr(1, 1, PLDM_SENSOR_UNIT_VOLTS, 0));
+    t1.pdrs.emplace_back(
+        numericSensorPdr(2, 2, PLDM_SENSOR_UNIT_VOLTS, 0x1b));
+    t1.pdrs.emplace_back(
+        numericSensorPdr(3, 3, PLDM_SENSOR_UNIT_DEGRESS_C, 0));
+    t1.pdrs.emplace_back(
+        numericSensorPdr(4, 4, PLDM_SENSOR_UNIT_DEGRESS_C, 0x1b));
+    t1.pdrs.emplace_back(entityAuxNamesPdr);
+    t1.parseTerminusPDRs();
+    utils::runEventLoopForSeconds(event, 1);
+
+    /* Thresholded temperatures first, then the other temperatures, then
+     * the other thresholded sensors */
+    std::vector<pldm::platform_mc::SensorId> order;
+    for (const auto& sensor : t1.numericSensors)
+    {
+        order.emplace_back(sensor->sensorId);
+    }
+    EXPECT_EQ((std::vector<pldm::platform_mc::SensorId>{4, 3, 2, 1}), order);
+}
+
+TEST(TerminusTest, dropUnusedPDRsTest)
+{
+    auto event = sdeventplus::Event::get_default();
+    auto t1 = pldm::platform_mc::Terminus(
+        1, 1 << PLDM_BASE | 1 << PLDM_PLATFORM, event);
+    std::vector<uint8_t> entityAuxNamesPdr{
+        0x1, 0x0, 0x0, 0x0, 0x1, PLDM_ENTITY_AUXILIARY_NAMES_PDR, 0x1, 0x0,
+        0x0, 0x0};
+    std::vector<uint8_t> stateEffecterPdr{
+        0x2, 0x0, 0x0, 0x0, 0x1, PLDM_STATE_EFFECTER_PDR, 0x1, 0x0, 0x2,
+        0x0, 0xaa, 0xbb};
+
+    t1.pdrs.emplace_back(stateEffecterPdr);
+    t1.pdrs.emplace_back(entityAuxNamesPdr);
+    t1.pdrs.emplace_back(stateEffecterPdr);
+
+    EXPECT_EQ(2u, t1.dropUnusedPDRs());
+    ASSERT_EQ(1u, t1.pdrs.size());
+    EXPECT_TRUE(std::ranges::equal(entityAuxNamesPdr, t1.pdrs[0]));
+    EXPECT_EQ(entityAuxNamesPdr.size(), t1.pdrs.bytes());
+
+    EXPECT_EQ(0u, t1.dropUnusedPDRs());
+}
+
+/** @brief Build an auxiliary names PDR, with one "en" name per PDR
+ *
+ *  @param[in] type - PLDM_SENSOR_AUXILIARY_NAMES_PDR or
+ *                    PLDM_ENTITY_AUXILIARY_NAMES_PDR
+ *  @param[in] name - UTF-16 units of the name, without the terminator
+ */
+static std::vector<uint8_t> auxNamesPdr(uint8_t type,
+                                        const std::vector<uint16_t>& name)
+{
+    std::vector<uint8_t> pdr{0x1, 0x0, 0x0, 0x0, 0x1, type, 0x0, 0x0, 0x0, 0x0};
+    if (type == PLDM_SENSOR_AUXILIARY_NAMES_PDR)
+    {
+        // terminus handle, sensor ID 1, sensor count, name count
+        pdr.insert(pdr.end(), {0x0, 0x0, 0x1, 0x0, 0x1, 0x1});
+    }
+    else
+    {
+        // overall system, no shared name, name count
+        pdr.insert(pdr.end(), {0x3, 0x80, 0x1, 0x0, 0x0, 0x0, 0x0, 0x1});
+    }
+    pdr.insert(pdr.end(), {'e', 'n', 0x0});
+    for (auto unit : name)
+    {
+        pdr.push_back(unit >> 8);
+        pdr.push_back(unit & 0xff);
+    }
+    pdr.insert(pdr.end(), {0x0, 0x0});
+    auto dataLength = pdr.size() - sizeof(pldm_pdr_hdr);
+    pdr[8] = dataLength & 0xff;
+    pdr[9] = dataLength >> 8;
+    return pdr;
+}
+
+TEST(TerminusTest, auxiliaryNamesSurrogatesTest)
+{
+    auto event = sdeventplus::Event::get_default();
+    auto t1 = pldm::platform_mc::Terminus(
+        1, 1 << PLDM_BASE | 1 << PLDM_PLATFORM, event);
+    // A pair, an unpaired high surrogate and an unpaired low surrogate
+    t1.pdrs.emplace_back(
+        auxNamesPdr(PLDM_SENSOR_AUXILIARY_NAMES_PDR,
+                    {'T', 0xd83d, 0xde00, 0xd800, 'A', 0xdc00, 0x00e9}));
+    // The name ends on an unpaired high surrogate
+    t1.pdrs.emplace_back(
+        auxNamesPdr(PLDM_ENTITY_AUXILIARY_NAMES_PDR, {'S', 0xd83d}));
+    t1.parseTerminusPDRs();
+
+    auto sensorAuxNames = t1.getSensorAuxiliaryNames(1);
+    ASSERT_NE(nullptr, sensorAuxNames);
+    const auto& names = std::get<2>(*sensorAuxNames);
+    ASSERT_EQ(1, names.size());
+    ASSERT_EQ(1, names[0].size());
+    EXPECT_EQ("T\xf0\x9f\x98\x80\xef\xbf\xbd"
+              "A\xef\xbf\xbd\xc3\xa9",
+              names[0][0].second);
+    EXPECT_EQ("S\xef\xbf\xbd", t1.getTerminusName().value());
+}
+
+TEST(TerminusTest, truncatedSensorAuxiliaryNamesPDRTest)
+{
+    auto event = sdeventplus::Event::get_default();
+    auto t1 = pldm::platform_mc::Terminus(
+        1, 1 << PLDM_BASE | 1 << PLDM_PLATFORM, event);
+    auto pdr = auxNamesPdr(PLDM_SENSOR_AUXILIARY_NAMES_PDR, {'T', 'E'});
+
+    // Cut in the name, in the language tag and before the name count
+    for (size_t size : {pdr.size() - 1, sizeof(pldm_pdr_hdr) + 7,
+                        sizeof(pldm_pdr_hdr) + 5})
+    {
+        std::vector<uint8_t> truncated(pdr.begin(), pdr.begin() + size);
+        t1.pdrs.clear();
+        t1.pdrs.emplace_back(truncated);
+        t1.parseTerminusPDRs();
+        EXPECT_EQ(nullptr, t1.getSensorAuxiliaryNames(1)) << size;
+    }
+
+    t1.pdrs.clear();
+    t1.pdrs.emplace_back(pdr);
+    t1.parseTerminusPDRs();
+    EXPECT_NE(nullptr, t1.getSensorAuxiliaryNames(1));
+}
+
+TEST(TerminusTest, auxiliaryNameLengthLimitTest)
+{
+    auto event = sdeventplus::Event::get_default();
+    auto t1 = pldm::platform_mc::Terminus(
+        1, 1 << PLDM_BASE | 1 << PLDM_PLATFORM, event);
+
+    // The terminator is counted in PLDM_STR_UTF_16_MAX_LEN
+    std::vector<uint16_t> name(PLDM_STR_UTF_16_MAX_LEN - 1, 'S');
+    t1.pdrs.emplace_back(auxNamesPdr(PLDM_ENTITY_AUXILIARY_NAMES_PDR, name));
+    t1.pdrs.emplace_back(auxNamesPdr(PLDM_SENSOR_AUXILIARY_NAMES_PDR, name));
+    t1.parseTerminusPDRs();
+    EXPECT_EQ(std::string(name.size(), 'S'), t1.getTerminusName().value());
+    EXPECT_NE(nullptr, t1.getSensorAuxiliaryNames(1));
+
+    // Longer names fail the whole PDR
+    auto t2 = pldm::platform_mc::Terminus(
+        2, 1 << PLDM_BASE | 1 << PLDM_PLATFORM, event);
+    name.push_back('S');
+    t2.pdrs.emplace_back(auxNamesPdr(PLDM_ENTITY_AUXILIARY_NAMES_PDR, name));
+    t2.pdrs.emplace_back(auxNamesPdr(PLDM_SENSOR_AUXILIARY_NAMES_PDR, name));
+    t2.parseTerminusPDRs();
+    EXPECT_FALSE(t2.getTerminusName().has_value());
+    EXPECT_EQ(nullptr, t2.getSensorAuxiliaryNames(1));
+}
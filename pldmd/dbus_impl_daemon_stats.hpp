@@ -0,0 +1,155 @@
+#pragma once
+
+#include "common/daemon_stats.hpp"
+#include "common/startup_profiler.hpp"
+#include "platform-mc/manager.hpp"
+#include "pldmd/dbus_method.hpp"
+
+#include <libpldm/pdr.h>
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief D-Bus interface publishing the performance counters of pldmd */
+static constexpr auto daemonStatsInterface =
+    "xyz.openbmc_project.PLDM.DaemonStatistics";
+
+/** @brief One entry of GetSensorPollStatistics: TID, polling cycles,
+ *         sensor reads, and microseconds of the last, the longest and all
+ *         the cycles
+ */
+using SensorPollStatsEntry =
+    std::tuple<uint8_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t>;
+
+/** @class DaemonStats
+ *  @brief Read-only view of the pldmd performance counters on D-Bus
+ *  @details Implements the GetStatistics method returning a{st}, the
+ *  counters of stats::DaemonStats, the size of the PDR repositories and the
+ *  startup timings of stats::StartupProfiler, Startup.<phase>.AtUs and
+ *  Startup.<phase>.DurationUs, by name, Startup.Ready.AtUs being the time
+ *  to ready, and the GetSensorPollStatistics method returning a(yttttt), one
+ *  entry per terminus polled by platform-mc. The counters only grow, rates
+ *  are the difference of two reads over the difference of UptimeUs.
+ */
+class DaemonStats
+{
+  public:
+    DaemonStats() = delete;
+    DaemonStats(const DaemonStats&) = delete;
+    DaemonStats& operator=(const DaemonStats&) = delete;
+    DaemonStats(DaemonStats&&) = delete;
+    DaemonStats& operator=(DaemonStats&&) = delete;
+    ~DaemonStats() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] pdrRepo - PDR repository of the BMC
+     *  @param[in] platformManager - platform-mc manager of the termini
+     */
+    DaemonStats(sdbusplus::bus_t& bus, const std::string& path,
+                const pldm_pdr* pdrRepo,
+                const platform_mc::Manager& platformManager) :
+        pdrRepo(pdrRepo), platformManager(platformManager),
+        interface(bus, path.c_str(), daemonStatsInterface, vtable, this)
+    {}
+
+    /** @brief Implementation of GetStatistics */
+    std::map<std::string, uint64_t> getStatistics() const
+    {
+        const auto& stats = stats::DaemonStats::getInstance();
+        std::map<std::string, uint64_t> counters{
+            {"UptimeUs", stats.getUptime().count()},
+            {"LoopIterations", stats.loopIterations},
+            {"LoopBusyUs", stats.loopBusyUs},
+            {"LoopMaxIterationUs", stats.loopMaxIterationUs},
+            {"LoopStalls", stats.loopStalls},
+            {"Responses", stats.responses},
+            {"ResponseBytes", stats.responseBytes},
+            {"PdrRepoRecords", pldm_pdr_get_record_count(pdrRepo)},
+            {"PdrRepoBytes", pldm_pdr_get_repo_size(pdrRepo)},
+        };
+
+        const auto& rxMessages = stats.getRxMessages();
+        for (size_t type = 0; type < rxMessages.size(); type++)
+        {
+            if (rxMessages[type])
+            {
+                counters.emplace("RxMessages.Type" + std::to_string(type),
+                                 rxMessages[type]);
+            }
+        }
+        for (const auto& [method, calls] : stats.getDbusCalls())
+        {
+            counters.emplace("DBusCalls." + method, calls);
+        }
+
+        uint64_t terminusPdrRecords = 0;
+        uint64_t terminusPdrBytes = 0;
+        for (const auto& [tid, terminus] : platformManager.getTermini())
+        {
+            if (terminus)
+            {
+                terminusPdrRecords += terminus->pdrs.size();
+                terminusPdrBytes += terminus->pdrs.bytes();
+            }
+        }
+        counters.emplace("TerminusPdrRecords", terminusPdrRecords);
+        counters.emplace("TerminusPdrBytes", terminusPdrBytes);
+
+        for (const auto& [phase, timing] :
+             stats::StartupProfiler::getInstance().getTimings())
+        {
+            counters.emplace("Startup." + phase + ".AtUs", timing.at.count());
+            counters.emplace("Startup." + phase + ".DurationUs",
+                             timing.duration.count());
+        }
+        return counters;
+    }
+
+    /** @brief Implementation of GetSensorPollStatistics */
+    std::vector<SensorPollStatsEntry> getSensorPollStatistics() const
+    {
+        const auto& stats = platformManager.getSensorPollStats();
+        std::vector<SensorPollStatsEntry> entries;
+        entries.reserve(stats.size());
+        for (const auto& [tid, value] : stats)
+        {
+            entries.emplace_back(tid, value.cycles, value.sensorsRead,
+                                 value.lastCycleUs, value.maxCycleUs,
+                                 value.totalCycleUs);
+        }
+        return entries;
+    }
+
+  private:
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method("GetStatistics", "", "a{st}",
+                                  methodCallback<&DaemonStats::getStatistics>,
+                                  SD_BUS_VTABLE_UNPRIVILEGED),
+        sdbusplus::vtable::method(
+            "GetSensorPollStatistics", "", "a(yttttt)",
+            methodCallback<&DaemonStats::getSensorPollStatistics>,
+            SD_BUS_VTABLE_UNPRIVILEGED),
+        sdbusplus::vtable::end()};
+
+    const pldm_pdr* pdrRepo;
+    const platform_mc::Manager& platformManager;
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "oem/ibm/libpldmresponder/file_io.hpp"
+#include "pldmd/dbus_method.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <tuple>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief D-Bus interface publishing the DMA transfer statistics */
+static constexpr auto dmaStatsInterface =
+    "xyz.openbmc_project.PLDM.DMAStatistics";
+
+/** @brief One entry of GetStatistics: PLDM file type, transfers, failures,
+ *         bytes, chunks, and microseconds elapsed, waiting, in DMA and in
+ *         file I/O
+ */
+using DMAStatsEntry =
+    std::tuple<uint16_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t,
+               uint64_t, uint64_t, uint64_t>;
+
+/** @class DMAStats
+ *  @brief Read-only view of the DMA transfer statistics on D-Bus
+ *  @details Implements the GetStatistics method returning a(qtttttttt), one
+ *  entry per file type transferred, see responder::dma::TransferStats. The
+ *  transfers of the file handle commands are under file type 0xFFFF.
+ */
+class DMAStats
+{
+  public:
+    DMAStats() = delete;
+    DMAStats(const DMAStats&) = delete;
+    DMAStats& operator=(const DMAStats&) = delete;
+    DMAStats(DMAStats&&) = delete;
+    DMAStats& operator=(DMAStats&&) = delete;
+    ~DMAStats() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     */
+    DMAStats(sdbusplus::bus_t& bus, const std::string& path) :
+        interface(bus, path.c_str(), dmaStatsInterface, vtable, this)
+    {}
+
+    /** @brief Implementation of GetStatistics */
+    std::vector<DMAStatsEntry> getStatistics() const
+    {
+        auto stats = responder::dma::getTransferStats();
+        std::vector<DMAStatsEntry> entries;
+        entries.reserve(stats.size());
+        for (const auto& [fileType, value] : stats)
+        {
+            entries.emplace_back(fileType, value.transfers, value.failures,
+                                 value.bytes, value.chunks, value.elapsedUs,
+                                 value.waitUs, value.dmaUs, value.fileUs);
+        }
+        return entries;
+    }
+
+  private:
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method("GetStatistics", "", "a(qtttttttt)",
+                                  methodCallback<&DMAStats::getStatistics>,
+                                  SD_BUS_VTABLE_UNPRIVILEGED),
+        sdbusplus::vtable::end()};
+
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
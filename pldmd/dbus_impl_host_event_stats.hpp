@@ -0,0 +1,81 @@
+#pragma once
+
+#include "oem/ibm/libpldmresponder/oem_ibm_handler.hpp"
+#include "pldmd/dbus_method.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <tuple>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief D-Bus interface publishing the statistics of the events queued to
+ *         the host
+ */
+static constexpr auto hostEventStatsInterface =
+    "xyz.openbmc_project.PLDM.HostEventQueue";
+
+/** @brief Reply of GetStatistics: events waiting, most events waiting at
+ *         once, state changes queued, coalesced, events sent, retried and
+ *         dropped
+ */
+using HostEventStatsEntry = std::tuple<uint64_t, uint64_t, uint64_t, uint64_t,
+                                       uint64_t, uint64_t, uint64_t>;
+
+/** @class HostEventStats
+ *  @brief Read-only view of the queue of the state sensor events to the host
+ *  @details Implements the GetStatistics method returning (ttttttt), see
+ *  responder::oem_ibm_platform::HostEventQueueStats.
+ */
+class HostEventStats
+{
+  public:
+    HostEventStats() = delete;
+    HostEventStats(const HostEventStats&) = delete;
+    HostEventStats& operator=(const HostEventStats&) = delete;
+    HostEventStats(HostEventStats&&) = delete;
+    HostEventStats& operator=(HostEventStats&&) = delete;
+    ~HostEventStats() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] handler - IBM OEM platform handler sending the events
+     */
+    HostEventStats(sdbusplus::bus_t& bus, const std::string& path,
+                   const responder::oem_ibm_platform::Handler& handler) :
+        handler(handler),
+        interface(bus, path.c_str(), hostEventStatsInterface, vtable, this)
+    {}
+
+    /** @brief Implementation of GetStatistics */
+    HostEventStatsEntry getStatistics() const
+    {
+        const auto& stats = handler.getHostEventQueueStats();
+        return {handler.hostEventQueueDepth(), stats.maxDepth, stats.queued,
+                stats.coalesced, stats.sent, stats.retried, stats.dropped};
+    }
+
+  private:
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method(
+            "GetStatistics", "", "(ttttttt)",
+            methodCallback<&HostEventStats::getStatistics>,
+            SD_BUS_VTABLE_UNPRIVILEGED),
+        sdbusplus::vtable::end()};
+
+    const responder::oem_ibm_platform::Handler& handler;
+
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
@@ -0,0 +1,333 @@
+#pragma once
+
+#include "common/instance_id.hpp"
+#include "pldmd/dbus_method.hpp"
+#include "xyz/openbmc_project/Common/error.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <phosphor-logging/lg2.hpp>
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/timer.hpp>
+#include <sdbusplus/vtable.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <exception>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief D-Bus interface leasing blocks of instance IDs to requesters */
+static constexpr auto instanceIdLeaseInterface =
+    "xyz.openbmc_project.PLDM.InstanceIdLease";
+
+/** @class InstanceIdLease
+ *  @brief Batch allocation of instance IDs for requesters outside pldmd
+ *  @details Implements the GetInstanceIds method, taking an EID and a count
+ *  and returning up to count instance IDs as ay, the FreeInstanceIds method,
+ *  taking an EID and the IDs to free, and the RenewInstanceIds method, taking
+ *  an EID and the IDs whose lease restarts. The IDs are leased to the
+ *  caller, identified by its unique bus name. They are freed by pldmd when
+ *  the caller leaves the bus, and the ones it neither frees nor renews within
+ *  the lease timeout are freed too, a crashed or hung requester does not leak
+ *  them. Unlike Requester.GetInstanceId a requester needs one D-Bus call for
+ *  a block of messages.
+ */
+class InstanceIdLease
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    InstanceIdLease() = delete;
+    InstanceIdLease(const InstanceIdLease&) = delete;
+    InstanceIdLease& operator=(const InstanceIdLease&) = delete;
+    InstanceIdLease(InstanceIdLease&&) = delete;
+    InstanceIdLease& operator=(InstanceIdLease&&) = delete;
+    ~InstanceIdLease()
+    {
+        for (const auto& [key, lease] : leases)
+        {
+            release(key.first, key.second);
+        }
+    }
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] event - event loop expiring the leases
+     *  @param[in] db - The database to use for allocating instance IDs
+     *  @param[in] timeout - time after which unfreed IDs are freed
+     */
+    InstanceIdLease(
+        sdbusplus::bus_t& bus, const std::string& path,
+        sdeventplus::Event& event, InstanceIdDb& db,
+        std::chrono::seconds timeout =
+            std::chrono::seconds(INSTANCE_ID_CLIENT_LEASE_TIMEOUT)) :
+        db(db), timeout(timeout),
+        expiryTimer(event.get(), [this]() { expireLeases(); }),
+        ownerMatch(bus, sdbusplus::bus::match::rules::nameOwnerChanged(),
+                   [this](sdbusplus::message_t& msg) { ownerChanged(msg); }),
+        interface(bus, path.c_str(), instanceIdLeaseInterface, vtable, this)
+    {}
+
+    /** @brief Implementation of GetInstanceIds
+     *
+     *  @param[in] owner - unique bus name of the caller
+     *  @param[in] eid - MCTP EID the IDs are allocated for
+     *  @param[in] count - number of IDs wanted
+     *
+     *  @return between 1 and count IDs, fewer when the other requesters hold
+     *          the rest
+     *
+     *  @throw TooManyResources if no ID is free
+     */
+    std::vector<uint8_t> getInstanceIds(const std::string& owner, uint8_t eid,
+                                        uint8_t count)
+    {
+        if (!count || count > maxInstanceIds)
+        {
+            throw std::invalid_argument("Invalid instance ID count");
+        }
+
+        std::vector<uint8_t> ids;
+        auto expiry = Clock::now() + timeout;
+        while (ids.size() < count)
+        {
+            uint8_t id;
+            try
+            {
+                // As Requester.GetInstanceId, the EID is used as the TID
+                id = db.next(eid);
+            }
+            catch (const std::runtime_error&)
+            {
+                break;
+            }
+            ids.emplace_back(id);
+            leases.insert_or_assign({eid, id}, Lease{owner, expiry});
+        }
+        if (ids.empty())
+        {
+            throw sdbusplus::xyz::openbmc_project::Common::Error::
+                TooManyResources();
+        }
+
+        if (!expiryTimer.isEnabled())
+        {
+            expiryTimer.start(timeout, true);
+        }
+        return ids;
+    }
+
+    /** @brief Implementation of FreeInstanceIds
+     *
+     *  @param[in] owner - unique bus name of the caller
+     *  @param[in] eid - MCTP EID the IDs were allocated for
+     *  @param[in] ids - IDs to free, leased to the caller
+     */
+    void freeInstanceIds(const std::string& owner, uint8_t eid,
+                         const std::vector<uint8_t>& ids)
+    {
+        checkOwner(owner, eid, ids);
+        for (auto id : ids)
+        {
+            leases.erase({eid, id});
+            release(eid, id);
+        }
+        if (leases.empty())
+        {
+            expiryTimer.stop();
+        }
+    }
+
+    /** @brief Implementation of RenewInstanceIds
+     *
+     *  @param[in] owner - unique bus name of the caller
+     *  @param[in] eid - MCTP EID the IDs were allocated for
+     *  @param[in] ids - IDs leased to the caller, their lease restarts
+     */
+    void renewInstanceIds(const std::string& owner, uint8_t eid,
+                          const std::vector<uint8_t>& ids)
+    {
+        checkOwner(owner, eid, ids);
+        auto expiry = Clock::now() + timeout;
+        for (auto id : ids)
+        {
+            leases.at({eid, id}).expiry = expiry;
+        }
+    }
+
+    /** @brief Free the IDs leased to a requester that left the bus
+     *
+     *  @param[in] owner - unique bus name of the requester
+     */
+    void reclaimLeases(const std::string& owner)
+    {
+        for (auto it = leases.begin(); it != leases.end();)
+        {
+            if (it->second.owner != owner)
+            {
+                ++it;
+                continue;
+            }
+            const auto& [eid, id] = it->first;
+            lg2::info(
+                "Instance ID {ID} for EID {EID} leased to {OWNER} which left the bus, freeing it",
+                "ID", id, "EID", eid, "OWNER", owner);
+            release(eid, id);
+            it = leases.erase(it);
+        }
+        if (leases.empty())
+        {
+            expiryTimer.stop();
+        }
+    }
+
+  private:
+    /** @struct Lease
+     *  @brief Requester holding an instance ID and until when
+     */
+    struct Lease
+    {
+        std::string owner;
+        Clock::time_point expiry;
+    };
+
+    /** @brief Check that IDs are leased to a requester
+     *
+     *  @throw std::invalid_argument if one is not
+     */
+    void checkOwner(const std::string& owner, uint8_t eid,
+                    const std::vector<uint8_t>& ids) const
+    {
+        for (auto id : ids)
+        {
+            auto it = leases.find({eid, id});
+            if (it == leases.end() || it->second.owner != owner)
+            {
+                throw std::invalid_argument(
+                    "Instance ID " + std::to_string(id) + " for EID " +
+                    std::to_string(eid) + " is not leased to the caller");
+            }
+        }
+    }
+
+    /** @brief Reclaim the leases of a unique bus name losing its owner */
+    void ownerChanged(sdbusplus::message_t& msg)
+    {
+        try
+        {
+            std::string name;
+            std::string oldOwner;
+            std::string newOwner;
+            msg.read(name, oldOwner, newOwner);
+            if (newOwner.empty() && name.starts_with(':'))
+            {
+                reclaimLeases(name);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Failed to read NameOwnerChanged, error - {ERROR}",
+                       "ERROR", e);
+        }
+    }
+
+    /** @brief Free the IDs whose lease expired */
+    void expireLeases()
+    {
+        auto now = Clock::now();
+        for (auto it = leases.begin(); it != leases.end();)
+        {
+            if (it->second.expiry > now)
+            {
+                ++it;
+                continue;
+            }
+            const auto& [eid, id] = it->first;
+            lg2::info(
+                "Instance ID {ID} for EID {EID} leased to {OWNER} expired, freeing it",
+                "ID", id, "EID", eid, "OWNER", it->second.owner);
+            release(eid, id);
+            it = leases.erase(it);
+        }
+        if (leases.empty())
+        {
+            expiryTimer.stop();
+        }
+    }
+
+    void release(uint8_t eid, uint8_t id)
+    {
+        try
+        {
+            db.free(eid, id);
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error(
+                "Failed to free instance ID {ID} for EID {EID}, error - {ERROR}",
+                "ID", id, "EID", eid, "ERROR", e);
+        }
+    }
+
+    /** @brief GetInstanceIds, FreeInstanceIds and RenewInstanceIds for the
+     *         sender of a method call
+     */
+    std::vector<uint8_t> getSenderInstanceIds(sdbusplus::message_t& call,
+                                              uint8_t eid, uint8_t count)
+    {
+        return getInstanceIds(call.get_sender(), eid, count);
+    }
+
+    void freeSenderInstanceIds(sdbusplus::message_t& call, uint8_t eid,
+                               const std::vector<uint8_t>& ids)
+    {
+        freeInstanceIds(call.get_sender(), eid, ids);
+    }
+
+    void renewSenderInstanceIds(sdbusplus::message_t& call, uint8_t eid,
+                                const std::vector<uint8_t>& ids)
+    {
+        renewInstanceIds(call.get_sender(), eid, ids);
+    }
+
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method(
+            "GetInstanceIds", "yy", "ay",
+            methodCallback<&InstanceIdLease::getSenderInstanceIds>),
+        sdbusplus::vtable::method(
+            "FreeInstanceIds", "yay", "",
+            methodCallback<&InstanceIdLease::freeSenderInstanceIds>),
+        sdbusplus::vtable::method(
+            "RenewInstanceIds", "yay", "",
+            methodCallback<&InstanceIdLease::renewSenderInstanceIds>),
+        sdbusplus::vtable::end()};
+
+    InstanceIdDb& db;
+    std::chrono::seconds timeout;
+
+    /** @brief Leased instance IDs, by EID and ID */
+    std::map<std::pair<uint8_t, uint8_t>, Lease> leases;
+
+    sdbusplus::Timer expiryTimer;
+
+    /** @brief Reclaims the leases of the requesters leaving the bus */
+    sdbusplus::bus::match_t ownerMatch;
+
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
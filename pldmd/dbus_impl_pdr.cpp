@@ -14,10 +14,12 @@ namespace dbus_api
 {
 
 std::vector<std::vector<uint8_t>> Pdr::findStateEffecterPDR(
-    uint8_t tid, uint16_t entityID, uint16_t stateSetId)
+    uint8_t /*tid*/, uint16_t entityID, uint16_t stateSetId)
 {
-    auto pdrs =
-        pldm::utils::findStateEffecterPDR(tid, entityID, stateSetId, pdrRepo);
+    // The PDRs of all the termini are in the repository, the TID is not
+    // used for the lookups
+    const auto& pdrs = repoIntf.findStateSetPdrs(PLDM_STATE_EFFECTER_PDR,
+                                                 entityID, stateSetId);
 
     if (pdrs.empty())
     {
@@ -28,15 +30,41 @@ std::vector<std::vector<uint8_t>> Pdr::findStateEffecterPDR(
 }
 
 std::vector<std::vector<uint8_t>> Pdr::findStateSensorPDR(
-    uint8_t tid, uint16_t entityID, uint16_t stateSetId)
+    uint8_t /*tid*/, uint16_t entityID, uint16_t stateSetId)
 {
-    auto pdrs =
-        pldm::utils::findStateSensorPDR(tid, entityID, stateSetId, pdrRepo);
+    const auto& pdrs = repoIntf.findStateSetPdrs(PLDM_STATE_SENSOR_PDR,
+                                                 entityID, stateSetId);
     if (pdrs.empty())
     {
         throw ResourceNotFound();
     }
     return pdrs;
 }
+
+std::tuple<uint16_t, uint8_t> Pdr::findStateSet(
+    uint8_t pdrType, uint16_t entityID, uint16_t stateSetId) const
+{
+    auto match = repoIntf.findStateSet(pdrType, entityID, stateSetId);
+    if (!match)
+    {
+        throw ResourceNotFound();
+    }
+    return {match->id, match->compositeIndex};
+}
+
+const sdbusplus::vtable_t Pdr::vtable[] = {
+    sdbusplus::vtable::start(),
+    sdbusplus::vtable::method(
+        "FindStateEffecter", "yqq", "qy",
+        methodCallback<&Pdr::findStateSetOf<PLDM_STATE_EFFECTER_PDR>,
+                       Reply::outArgs>,
+        SD_BUS_VTABLE_UNPRIVILEGED),
+    sdbusplus::vtable::method(
+        "FindStateSensor", "yqq", "qy",
+        methodCallback<&Pdr::findStateSetOf<PLDM_STATE_SENSOR_PDR>,
+                       Reply::outArgs>,
+        SD_BUS_VTABLE_UNPRIVILEGED),
+    sdbusplus::vtable::end()};
+
 } // namespace dbus_api
 } // namespace pldm
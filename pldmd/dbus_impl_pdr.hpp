@@ -1,13 +1,19 @@
 #pragma once
 
+#include "libpldmresponder/pdr_utils.hpp"
+#include "pldmd/dbus_method.hpp"
 #include "xyz/openbmc_project/PLDM/PDR/server.hpp"
 
 #include <libpldm/pdr.h>
 #include <libpldm/platform.h>
+#include <systemd/sd-bus.h>
 
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
 #include <sdbusplus/server/object.hpp>
+#include <sdbusplus/vtable.hpp>
 
+#include <tuple>
 #include <vector>
 
 namespace pldm
@@ -18,10 +24,19 @@ namespace dbus_api
 using PdrIntf = sdbusplus::server::object_t<
     sdbusplus::xyz::openbmc_project::PLDM::server::PDR>;
 
+/** @brief D-Bus interface looking up state sensors and effecters */
+static constexpr auto pdrLookupInterface = "xyz.openbmc_project.PLDM.PDRLookup";
+
 /** @class Pdr
  *  @brief OpenBMC PLDM.PDR Implementation
  *  @details A concrete implementation for the
- *  xyz.openbmc_project.PLDM.PDR DBus APIs.
+ *  xyz.openbmc_project.PLDM.PDR DBus APIs, and of the
+ *  xyz.openbmc_project.PLDM.PDRLookup methods FindStateEffecter and
+ *  FindStateSensor. These take the same yqq arguments as
+ *  FindStateEffecterPDR and FindStateSensorPDR and return qy, the ID and
+ *  composite index of the last match, instead of the matching PDRs. The
+ *  results of the lookups which match are kept until the PDR repository
+ *  changes.
  */
 class Pdr : public PdrIntf
 {
@@ -38,8 +53,9 @@ class Pdr : public PdrIntf
      *  @param[in] path - Path to attach at.
      *  @param[in] repo - pointer to BMC's primary PDR repo
      */
-    Pdr(sdbusplus::bus_t& bus, const std::string& path, const pldm_pdr* repo) :
-        PdrIntf(bus, path.c_str()), pdrRepo(repo) {};
+    Pdr(sdbusplus::bus_t& bus, const std::string& path, pldm_pdr* repo) :
+        PdrIntf(bus, path.c_str()), repoIntf(repo),
+        lookup(bus, path.c_str(), pdrLookupInterface, vtable, this) {};
 
     /** @brief Implementation for PdrIntf.FindStateEffecterPDR
      *  @param[in] tid - PLDM terminus ID.
@@ -57,9 +73,36 @@ class Pdr : public PdrIntf
     std::vector<std::vector<uint8_t>> findStateSensorPDR(
         uint8_t tid, uint16_t entityID, uint16_t stateSetId) override;
 
+    /** @brief Implementation of PDRLookup.FindStateEffecter and
+     *         PDRLookup.FindStateSensor
+     *  @param[in] pdrType - PLDM_STATE_EFFECTER_PDR or PLDM_STATE_SENSOR_PDR
+     *  @param[in] entityID - entity that can be associated with PLDM State set.
+     *  @param[in] stateSetId - value that identifies PLDM State set.
+     *  @return the effecter or sensor ID and the composite index of the
+     *          state set
+     *  @throw ResourceNotFound if no effecter or sensor matches
+     */
+    std::tuple<uint16_t, uint8_t> findStateSet(
+        uint8_t pdrType, uint16_t entityID, uint16_t stateSetId) const;
+
   private:
-    /** @brief pointer to BMC's primary PDR repo */
-    const pldm_pdr* pdrRepo;
+    /** @brief findStateSet for the PDR type of a PDRLookup method, the PDRs
+     *         of all the termini are in the repository, the TID is not used
+     */
+    template <uint8_t pdrType>
+    std::tuple<uint16_t, uint8_t> findStateSetOf(
+        uint8_t /*tid*/, uint16_t entityID, uint16_t stateSetId) const
+    {
+        return findStateSet(pdrType, entityID, stateSetId);
+    }
+
+    static const sdbusplus::vtable_t vtable[];
+
+    /** @brief BMC's primary PDR repo, caching the lookup results */
+    responder::pdr_utils::Repo repoIntf;
+
+    /** @brief PDRLookup interface */
+    sdbusplus::server::interface_t lookup;
 };
 
 } // namespace dbus_api
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "pldmd/dbus_method.hpp"
+#include "requester/handler.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <tuple>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief D-Bus interface publishing requester::Handler statistics */
+static constexpr auto requestStatsInterface =
+    "xyz.openbmc_project.PLDM.RequestStatistics";
+
+/** @brief One entry of GetStatistics: EID, PLDM type, PLDM command, sent,
+ *         retried, timed out, responses and the latency histogram
+ */
+using RequestStatsEntry =
+    std::tuple<uint8_t, uint8_t, uint8_t, uint64_t, uint64_t, uint64_t,
+               uint64_t, std::vector<uint64_t>>;
+
+/** @class RequestStats
+ *  @brief Read-only view of the requester statistics on D-Bus
+ *  @details Implements the GetStatistics method returning a(yyyttttat),
+ *  one entry per (EID, type, command) requested. The buckets of the latency
+ *  histogram are described by requester::RequestStats.
+ */
+class RequestStats
+{
+  public:
+    RequestStats() = delete;
+    RequestStats(const RequestStats&) = delete;
+    RequestStats& operator=(const RequestStats&) = delete;
+    RequestStats(RequestStats&&) = delete;
+    RequestStats& operator=(RequestStats&&) = delete;
+    ~RequestStats() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] stats - statistics of the requester handler
+     */
+    RequestStats(sdbusplus::bus_t& bus, const std::string& path,
+                 const requester::RequestStatsMap& stats) :
+        stats(stats),
+        interface(bus, path.c_str(), requestStatsInterface, vtable, this)
+    {}
+
+    /** @brief Implementation of GetStatistics */
+    std::vector<RequestStatsEntry> getStatistics() const
+    {
+        std::vector<RequestStatsEntry> entries;
+        entries.reserve(stats.size());
+        for (const auto& [key, value] : stats)
+        {
+            const auto& [eid, type, command] = key;
+            entries.emplace_back(
+                eid, type, command, value.sent, value.retried, value.timedOut,
+                value.responses,
+                std::vector<uint64_t>(value.latency.begin(),
+                                      value.latency.end()));
+        }
+        return entries;
+    }
+
+  private:
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method("GetStatistics", "", "a(yyyttttat)",
+                                  methodCallback<&RequestStats::getStatistics>,
+                                  SD_BUS_VTABLE_UNPRIVILEGED),
+        sdbusplus::vtable::end()};
+
+    const requester::RequestStatsMap& stats;
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "common/instance_id.hpp"
+#include "common/pldm_msg.hpp"
+#include "pldmd/dbus_method.hpp"
+#include "requester/handler.hpp"
+#include "requester/request.hpp"
+
+#include <libpldm/base.h>
+#include <libpldm/fru.h>
+#include <libpldm/platform.h>
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <cstring>
+#include <exception>
+#include <map>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief D-Bus interface sending PLDM requests on behalf of other daemons */
+static constexpr auto sendRecvInterface = "xyz.openbmc_project.PLDM.SendRecv";
+
+/** @brief PLDM commands SendRecv forwards, by PLDM type */
+using SendRecvCommands = std::map<uint8_t, std::set<uint8_t>>;
+
+/** @brief Commands SendRecv forwards by default, the ones reading the state
+ *  of a terminus. Setting effecters, updating the firmware or changing the
+ *  PDRs of a terminus stays with pldmd.
+ */
+inline const SendRecvCommands defaultSendRecvCommands{
+    {PLDM_BASE,
+     {PLDM_GET_TID, PLDM_GET_PLDM_VERSION, PLDM_GET_PLDM_TYPES,
+      PLDM_GET_PLDM_COMMANDS}},
+    {PLDM_PLATFORM,
+     {PLDM_GET_SENSOR_READING, PLDM_GET_STATE_SENSOR_READINGS,
+      PLDM_GET_NUMERIC_EFFECTER_VALUE, PLDM_GET_PDR_REPOSITORY_INFO,
+      PLDM_GET_PDR}},
+    {PLDM_FRU,
+     {PLDM_GET_FRU_RECORD_TABLE_METADATA, PLDM_GET_FRU_RECORD_TABLE,
+      PLDM_GET_FRU_RECORD_BY_OPTION}}};
+
+/** @class SendRecv
+ *  @brief PLDM requests of other daemons sent by the requester of pldmd
+ *  @details Implements the SendRecv method, taking an MCTP EID and an
+ *  encoded PLDM request, header included, and returning the PLDM response,
+ *  header included. The method replies once the response arrives, a caller
+ *  may have any number of requests outstanding. pldmd sets the instance ID
+ *  of the request and queues it in requester::Handler with its own requests,
+ *  sharing their window, retries and priority classes, instead of the caller
+ *  opening its own socket and competing with pldmd for the endpoint. A
+ *  request without a response fails with a Timeout error. Only root peers
+ *  may call the method, and only for the commands allowed.
+ */
+class SendRecv
+{
+  public:
+    SendRecv() = delete;
+    SendRecv(const SendRecv&) = delete;
+    SendRecv& operator=(const SendRecv&) = delete;
+    SendRecv(SendRecv&&) = delete;
+    SendRecv& operator=(SendRecv&&) = delete;
+    ~SendRecv() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] db - The database to use for allocating instance IDs
+     *  @param[in] handler - requester sending the requests
+     *  @param[in] commands - commands forwarded
+     */
+    SendRecv(sdbusplus::bus_t& bus, const std::string& path, InstanceIdDb& db,
+             requester::Handler<requester::Request>& handler,
+             SendRecvCommands commands = defaultSendRecvCommands) :
+        db(db), handler(handler), commands(std::move(commands)),
+        interface(bus, path.c_str(), sendRecvInterface, vtable, this)
+    {}
+
+    /** @brief Check that a peer may have a request forwarded
+     *
+     *  @param[in] commands - commands forwarded
+     *  @param[in] uid - effective UID of the peer, std::nullopt if unknown
+     *  @param[in] request - encoded PLDM request, header included
+     *
+     *  @return the sd-bus error to reply with, nullptr if allowed
+     */
+    static const char* checkRequest(const SendRecvCommands& commands,
+                                    std::optional<uid_t> uid,
+                                    const std::vector<uint8_t>& request)
+    {
+        if (!uid || *uid != 0)
+        {
+            return SD_BUS_ERROR_ACCESS_DENIED;
+        }
+        if (request.size() < sizeof(pldm_msg_hdr))
+        {
+            return SD_BUS_ERROR_INVALID_ARGS;
+        }
+        auto hdr = reinterpret_cast<const pldm_msg_hdr*>(request.data());
+        if (!hdr->request)
+        {
+            return SD_BUS_ERROR_INVALID_ARGS;
+        }
+        auto type = commands.find(hdr->type);
+        if (type == commands.end() || !type->second.contains(hdr->command))
+        {
+            return SD_BUS_ERROR_ACCESS_DENIED;
+        }
+        return nullptr;
+    }
+
+  private:
+    /** @brief Queue a request, replying to the method call on its response
+     *
+     *  @param[in] call - the SendRecv method call
+     *  @param[in] eid - MCTP EID of the responder
+     *  @param[in] request - encoded PLDM request, header included
+     *
+     *  @throw MethodError if the caller may not have the request forwarded
+     */
+    void sendRecv(sdbusplus::message_t& call, uint8_t eid,
+                  const std::vector<uint8_t>& request)
+    {
+        if (auto denied =
+                checkRequest(commands, senderUid(call.get()), request))
+        {
+            throw MethodError(denied, "PLDM request not allowed");
+        }
+
+        RequestMsg requestMsg(request.size());
+        std::memcpy(requestMsg.data(), request.data(), request.size());
+        auto hdr = &requestMsg.msg()->hdr;
+        auto type = hdr->type;
+        auto command = hdr->command;
+
+        // As Requester.GetInstanceId, the EID is used as the TID
+        auto instanceId = db.next(eid);
+        hdr->instance_id = instanceId;
+
+        auto rc = handler.registerRequest(
+            eid, instanceId, type, command, std::move(requestMsg),
+            [call](mctp_eid_t, const pldm_msg* response,
+                   size_t respMsgLen) mutable {
+                if (!response)
+                {
+                    sd_bus_reply_method_errorf(
+                        call.get(), SD_BUS_ERROR_TIMEOUT,
+                        "No response to the PLDM request");
+                    return;
+                }
+                auto bytes = reinterpret_cast<const uint8_t*>(response);
+                try
+                {
+                    auto reply = call.new_method_return();
+                    reply.append(std::vector<uint8_t>(
+                        bytes, bytes + sizeof(pldm_msg_hdr) + respMsgLen));
+                    reply.method_return();
+                }
+                catch (const std::exception& e)
+                {
+                    sd_bus_reply_method_errorf(call.get(), SD_BUS_ERROR_FAILED,
+                                               "%s", e.what());
+                }
+            });
+        if (rc)
+        {
+            db.free(eid, instanceId);
+            throw std::runtime_error("Failed to queue the PLDM request");
+        }
+    }
+
+    /** @brief Get the effective UID of the sender of a method call */
+    static std::optional<uid_t> senderUid(sd_bus_message* msg)
+    {
+        sd_bus_creds* creds = nullptr;
+        uid_t uid{};
+        auto rc = sd_bus_query_sender_creds(msg, SD_BUS_CREDS_EUID, &creds);
+        if (rc >= 0)
+        {
+            rc = sd_bus_creds_get_euid(creds, &uid);
+        }
+        sd_bus_creds_unref(creds);
+        if (rc < 0)
+        {
+            return std::nullopt;
+        }
+        return uid;
+    }
+
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method(
+            "SendRecv", "yay", "ay",
+            methodCallback<&SendRecv::sendRecv, Reply::deferred>),
+        sdbusplus::vtable::end()};
+
+    InstanceIdDb& db;
+    requester::Handler<requester::Request>& handler;
+    SendRecvCommands commands;
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "platform-mc/terminus_manager.hpp"
+#include "pldmd/dbus_method.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/interface.hpp>
+#include <sdbusplus/vtable.hpp>
+
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief D-Bus interface publishing the readings of the terminus sensors */
+static constexpr auto sensorSnapshotInterface =
+    "xyz.openbmc_project.PLDM.SensorSnapshot";
+
+/** @brief Bits of the status of a SensorSnapshotEntry */
+static constexpr uint8_t sensorSnapshotAvailable = 0x01;
+static constexpr uint8_t sensorSnapshotFunctional = 0x02;
+
+/** @brief One entry of GetSensorSnapshot: TID, sensor ID, value, time stamp
+ *         of the reading in usec of the monotonic clock and status
+ */
+using SensorSnapshotEntry =
+    std::tuple<uint8_t, uint16_t, double, uint64_t, uint8_t>;
+
+/** @brief Reply of GetSensorHistory: the samples, oldest first, as time stamp
+ *         in usec of the monotonic clock and value, then the minimum, maximum
+ *         and average of the window
+ */
+using SensorHistoryReply =
+    std::tuple<std::vector<std::tuple<uint64_t, double>>, double, double,
+               double>;
+
+/** @class SensorSnapshot
+ *  @brief Bulk read of the numeric sensors of the termini on D-Bus
+ *  @details Implements the GetSensorSnapshot method returning a(yqdty), the
+ *  readings of all the numeric sensors of one terminus, or of all the termini
+ *  for TID 0xFF, as kept in memory by platform-mc. One call replaces a
+ *  property Get per sensor. The GetSensorHistory method returns a(td)ddd,
+ *  the recent readings of one sensor when the sensor history is enabled.
+ */
+class SensorSnapshot
+{
+  public:
+    SensorSnapshot() = delete;
+    SensorSnapshot(const SensorSnapshot&) = delete;
+    SensorSnapshot& operator=(const SensorSnapshot&) = delete;
+    SensorSnapshot(SensorSnapshot&&) = delete;
+    SensorSnapshot& operator=(SensorSnapshot&&) = delete;
+    ~SensorSnapshot() = default;
+
+    /** @brief Constructor to put object onto bus at a dbus path.
+     *  @param[in] bus - Bus to attach to.
+     *  @param[in] path - Path to attach at.
+     *  @param[in] termini - termini managed by platform-mc
+     */
+    SensorSnapshot(sdbusplus::bus_t& bus, const std::string& path,
+                   const platform_mc::TerminiMapper& termini) :
+        termini(termini),
+        interface(bus, path.c_str(), sensorSnapshotInterface, vtable, this)
+    {}
+
+    /** @brief Implementation of GetSensorSnapshot
+     *  @param[in] tid - TID of the terminus, PLDM_TID_RESERVED for all
+     */
+    std::vector<SensorSnapshotEntry> getSensorSnapshot(uint8_t tid) const
+    {
+        std::vector<SensorSnapshotEntry> entries;
+        for (const auto& [terminusTid, terminus] : termini)
+        {
+            if (!terminus || (tid != PLDM_TID_RESERVED && tid != terminusTid))
+            {
+                continue;
+            }
+
+            entries.reserve(entries.size() + terminus->numericSensors.size());
+            for (const auto& sensor : terminus->numericSensors)
+            {
+                if (!sensor)
+                {
+                    continue;
+                }
+
+                uint8_t status = 0;
+                if (sensor->isAvailable())
+                {
+                    status |= sensorSnapshotAvailable;
+                }
+                if (sensor->isFunctional())
+                {
+                    status |= sensorSnapshotFunctional;
+                }
+                entries.emplace_back(terminusTid, sensor->sensorId,
+                                     sensor->getValue(), sensor->timeStamp,
+                                     status);
+            }
+        }
+        return entries;
+    }
+
+    /** @brief Implementation of GetSensorHistory
+     *  @param[in] tid - TID of the terminus
+     *  @param[in] sensorId - ID of the numeric sensor
+     */
+    SensorHistoryReply getSensorHistory(uint8_t tid, uint16_t sensorId) const
+    {
+        auto it = termini.find(tid);
+        if (it == termini.end() || !it->second)
+        {
+            throw std::invalid_argument("Unknown terminus");
+        }
+        auto sensor = it->second->getSensorObject(sensorId);
+        if (!sensor)
+        {
+            throw std::invalid_argument("Unknown sensor");
+        }
+
+        const auto& history = sensor->history;
+        std::vector<std::tuple<uint64_t, double>> samples;
+        samples.reserve(history.size());
+        for (const auto& sample : history.getSamples())
+        {
+            samples.emplace_back(sample.timeStamp, sample.value);
+        }
+        return {std::move(samples), history.min(), history.max(),
+                history.average()};
+    }
+
+  private:
+    static constexpr sdbusplus::vtable_t vtable[] = {
+        sdbusplus::vtable::start(),
+        sdbusplus::vtable::method(
+            "GetSensorSnapshot", "y", "a(yqdty)",
+            methodCallback<&SensorSnapshot::getSensorSnapshot>,
+            SD_BUS_VTABLE_UNPRIVILEGED),
+        sdbusplus::vtable::method(
+            "GetSensorHistory", "yq", "a(td)ddd",
+            methodCallback<&SensorSnapshot::getSensorHistory, Reply::outArgs>,
+            SD_BUS_VTABLE_UNPRIVILEGED),
+        sdbusplus::vtable::end()};
+
+    const platform_mc::TerminiMapper& termini;
+    sdbusplus::server::interface_t interface;
+};
+
+} // namespace dbus_api
+} // namespace pldm
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <systemd/sd-bus.h>
+
+#include <sdbusplus/exception.hpp>
+#include <sdbusplus/message.hpp>
+
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace pldm
+{
+namespace dbus_api
+{
+
+/** @brief How methodCallback replies to a method call
+ *
+ *  result - the value returned by the implementation, if any, is the out
+ *           argument
+ *  outArgs - the implementation returns a std::tuple, each element is an out
+ *            argument
+ *  deferred - the implementation keeps the method call and replies later
+ */
+enum class Reply
+{
+    result,
+    outArgs,
+    deferred
+};
+
+/** @class MethodError
+ *  @brief Exception replied to a method call as the D-Bus error given
+ */
+class MethodError : public std::runtime_error
+{
+  public:
+    /** @brief Constructor
+     *  @param[in] name - name of the D-Bus error, a static string
+     *  @param[in] message - message of the D-Bus error
+     */
+    MethodError(const char* name, const std::string& message) :
+        std::runtime_error(message), errorName(name)
+    {}
+
+    const char* name() const noexcept
+    {
+        return errorName;
+    }
+
+  private:
+    const char* errorName;
+};
+
+/** @brief Set the D-Bus error of a method call from the exception being
+ *         handled
+ *
+ *  MethodError and the sdbusplus errors keep their name,
+ *  std::invalid_argument is an InvalidArgs error and any other exception a
+ *  Failed error.
+ *
+ *  @param[out] error - error of the method call
+ *
+ *  @return the negative errno of the error, as the sd-bus callbacks return
+ */
+inline int methodError(sd_bus_error* error) noexcept
+{
+    try
+    {
+        throw;
+    }
+    catch (const MethodError& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.what());
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        return sd_bus_error_set(error, e.name(), e.description());
+    }
+    catch (const std::invalid_argument& e)
+    {
+        return sd_bus_error_set(error, SD_BUS_ERROR_INVALID_ARGS, e.what());
+    }
+    catch (const std::exception& e)
+    {
+        return sd_bus_error_set(error, SD_BUS_ERROR_FAILED, e.what());
+    }
+    catch (...)
+    {
+        return sd_bus_error_set(error, SD_BUS_ERROR_FAILED, "Unknown error");
+    }
+}
+
+namespace details
+{
+
+/** @brief Read the in arguments of a method call and call the member
+ *         function implementing the method with them
+ */
+template <typename... Args>
+struct MethodInvoker
+{
+    template <auto method, typename Object>
+    static decltype(auto) invoke(Object* self, sdbusplus::message_t& call)
+    {
+        std::tuple<std::decay_t<Args>...> args;
+        if constexpr (sizeof...(Args) > 0)
+        {
+            std::apply([&call](auto&... arg) { call.read(arg...); }, args);
+        }
+        return std::apply(
+            [self](auto&... arg) { return std::invoke(method, self, arg...); },
+            args);
+    }
+};
+
+/** @brief A member function taking the method call first gets it before the
+ *         in arguments, to know the sender or to reply later
+ */
+template <typename... Args>
+struct MethodInvoker<sdbusplus::message_t&, Args...>
+{
+    template <auto method, typename Object>
+    static decltype(auto) invoke(Object* self, sdbusplus::message_t& call)
+    {
+        std::tuple<std::decay_t<Args>...> args;
+        if constexpr (sizeof...(Args) > 0)
+        {
+            std::apply([&call](auto&... arg) { call.read(arg...); }, args);
+        }
+        return std::apply(
+            [self, &call](auto&... arg) {
+                return std::invoke(method, self, call, arg...);
+            },
+            args);
+    }
+};
+
+template <typename>
+struct Method;
+
+template <typename Object, typename Return, typename... Args>
+struct Method<Return (Object::*)(Args...)>
+{
+    using Type = Object;
+    using Result = Return;
+    using Invoker = MethodInvoker<Args...>;
+};
+
+template <typename Object, typename Return, typename... Args>
+struct Method<Return (Object::*)(Args...) const>
+{
+    using Type = const Object;
+    using Result = Return;
+    using Invoker = MethodInvoker<Args...>;
+};
+
+} // namespace details
+
+/** @brief sd-bus callback of a method implemented by a member function
+ *
+ *  The object registered with the interface implements the method: its in
+ *  arguments are read from the method call, the member function is called
+ *  with them and the reply carries what it returns. An exception thrown is
+ *  replied as a D-Bus error, see methodError.
+ *
+ *  @tparam method - member function implementing the method
+ *  @tparam reply - how the method call is replied to
+ */
+template <auto method, Reply reply = Reply::result>
+int methodCallback(sd_bus_message* msg, void* context, sd_bus_error* error)
+{
+    using Method = details::Method<decltype(method)>;
+    try
+    {
+        auto self = static_cast<typename Method::Type*>(context);
+        auto call = sdbusplus::message_t(msg);
+        if constexpr (reply == Reply::deferred)
+        {
+            Method::Invoker::template invoke<method>(self, call);
+        }
+        else if constexpr (std::is_void_v<typename Method::Result>)
+        {
+            Method::Invoker::template invoke<method>(self, call);
+            call.new_method_return().method_return();
+        }
+        else
+        {
+            auto result = Method::Invoker::template invoke<method>(self, call);
+            auto response = call.new_method_return();
+            if constexpr (reply == Reply::outArgs)
+            {
+                auto append = [&response](const auto&... arg) {
+                    response.append(arg...);
+                };
+                std::apply(append, result);
+            }
+            else
+            {
+                response.append(result);
+            }
+            response.method_return();
+        }
+    }
+    catch (...)
+    {
+        return methodError(error);
+    }
+    return 1;
+}
+
+} // namespace dbus_api
+} // namespace pldm
@@ -1,10 +1,16 @@
 #pragma once
 
+#include "common/trace.hpp"
+
 #include <libpldm/base.h>
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <functional>
+#include <limits>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace pldm
@@ -20,6 +26,83 @@ class CmdHandler;
 using HandlerFunc = std::function<Response(
     pldm_tid_t tid, const pldm_msg* request, size_t reqMsgLen)>;
 
+/** @brief Hands over the response of a deferred handler, called once */
+using ResponseCompletion = std::function<void(Response&& response)>;
+
+/** @brief Handler which may complete its response after returning, for
+ *         instance once a D-Bus call completed. request is only valid until
+ *         the handler returns.
+ */
+using DeferredHandlerFunc =
+    std::function<void(pldm_tid_t tid, const pldm_msg* request,
+                       size_t reqMsgLen, ResponseCompletion complete)>;
+
+/** @brief Sends a response completed after its handler returned */
+using ResponseSender = std::function<void(pldm_tid_t tid, Response&& response)>;
+
+/** @class ResponsePool
+ *
+ *  Response buffers given back once sent, reused with their capacity by the
+ *  next responses so building a response does not allocate. pldmd handles
+ *  messages on one thread, the pool is not locked.
+ */
+class ResponsePool
+{
+  public:
+    ResponsePool(const ResponsePool&) = delete;
+    ResponsePool& operator=(const ResponsePool&) = delete;
+
+    static ResponsePool& getInstance()
+    {
+        static ResponsePool pool;
+        return pool;
+    }
+
+    /** @brief Get a zeroed response
+     *
+     *  @param[in] size - length of the response, header included
+     *  @return the response, of exactly size bytes
+     */
+    Response get(size_t size)
+    {
+        if (idle.empty())
+        {
+            return Response(size, 0);
+        }
+        auto response = std::move(idle.back());
+        idle.pop_back();
+        response.assign(size, 0);
+        return response;
+    }
+
+    /** @brief Give back a response once sent
+     *
+     *  @param[in] response - the response, left empty
+     */
+    void put(Response&& response)
+    {
+        if (idle.size() < maxIdle && response.capacity() &&
+            response.capacity() <= maxCapacity)
+        {
+            idle.emplace_back(std::move(response));
+        }
+        response.clear();
+    }
+
+  private:
+    ResponsePool() = default;
+
+    /** @brief Most buffers kept for reuse */
+    static constexpr size_t maxIdle = 8;
+
+    /** @brief Larger buffers, such as those of the table transfers, are
+     *         freed rather than kept
+     */
+    static constexpr size_t maxCapacity = 4096;
+
+    std::vector<Response> idle;
+};
+
 class CmdHandler
 {
   public:
@@ -36,7 +119,116 @@ class CmdHandler
     Response handle(pldm_tid_t tid, Command pldmCommand,
                     const pldm_msg* request, size_t reqMsgLen)
     {
-        return handlers.at(pldmCommand)(tid, request, reqMsgLen);
+        Response response;
+        handle(tid, pldmCommand, request, reqMsgLen, response);
+        return response;
+    }
+
+    /** @brief Invoke a PLDM command handler, into a caller response
+     *
+     *  Handlers hand over the buffer they built, usually taken from the
+     *  ResponsePool by makeResponse().
+     *
+     *  @param[in] tid - PLDM request TID
+     *  @param[in] pldmCommand - PLDM command code
+     *  @param[in] request - PLDM request message
+     *  @param[in] reqMsgLen - PLDM request message size
+     *  @param[out] response - PLDM response message
+     */
+    void handle(pldm_tid_t tid, Command pldmCommand, const pldm_msg* request,
+                size_t reqMsgLen, Response& response)
+    {
+        PLDM_TRACE_SPAN("handler", "responder", pldmCommand);
+        if (auto func = dispatchTable[pldmCommand])
+        {
+            response = (*func)(tid, request, reqMsgLen);
+            return;
+        }
+        if (auto func = deferredDispatchTable[pldmCommand])
+        {
+            handleDeferred(tid, *func, request, reqMsgLen, response);
+            return;
+        }
+
+        // Registered after buildDispatchTable(), or not registered at all
+        if (auto it = deferredHandlers.find(pldmCommand);
+            it != deferredHandlers.end())
+        {
+            handleDeferred(tid, it->second, request, reqMsgLen, response);
+            return;
+        }
+        response = handlers.at(pldmCommand)(tid, request, reqMsgLen);
+    }
+
+    /** @brief Set how responses completed after their handler returned are
+     *         sent
+     *
+     *  Without a sender such responses are dropped.
+     *
+     *  @param[in] sender - sends a response
+     */
+    void setResponseSender(ResponseSender sender)
+    {
+        responseSender = std::move(sender);
+    }
+
+    /** @brief Flatten the registered handlers into tables indexed by command
+     *
+     *  Called once the derived class has registered its handlers, usually by
+     *  Invoker::registerHandler(). Lookups for those commands then are an
+     *  array index rather than a tree walk. Commands registered afterwards
+     *  are still found through the maps.
+     */
+    void buildDispatchTable()
+    {
+        dispatchTable.fill(nullptr);
+        deferredDispatchTable.fill(nullptr);
+        for (const auto& [command, func] : handlers)
+        {
+            dispatchTable[command] = &func;
+        }
+        for (const auto& [command, func] : deferredHandlers)
+        {
+            deferredDispatchTable[command] = &func;
+        }
+    }
+
+    /** @brief Get the command codes this handler serves
+     *
+     *  @return sorted command codes
+     */
+    std::vector<Command> getCommands() const
+    {
+        std::vector<Command> commands;
+        commands.reserve(handlers.size() + deferredHandlers.size());
+        for (const auto& [command, _] : handlers)
+        {
+            commands.push_back(command);
+        }
+        for (const auto& [command, _] : deferredHandlers)
+        {
+            if (!handlers.contains(command))
+            {
+                commands.push_back(command);
+            }
+        }
+        std::ranges::sort(commands);
+        return commands;
+    }
+
+    /** @brief Create a response message of a known payload length
+     *
+     *  The buffer comes from the ResponsePool, sized once to the exact
+     *  length and zeroed: encode into it without resizing it again.
+     *
+     *  @param[in] payloadLength - length of the response payload, usually
+     *                             PLDM_*_RESP_BYTES
+     *  @return PLDM response message
+     */
+    static Response makeResponse(size_t payloadLength)
+    {
+        return ResponsePool::getInstance().get(sizeof(pldm_msg_hdr) +
+                                               payloadLength);
     }
 
     /** @brief Create a response message containing only cc
@@ -47,7 +239,7 @@ class CmdHandler
      */
     static Response ccOnlyResponse(const pldm_msg* request, uint8_t cc)
     {
-        Response response(sizeof(pldm_msg), 0);
+        auto response = makeResponse(PLDM_CC_ONLY_RESP_BYTES);
         auto ptr = new (response.data()) pldm_msg;
         auto rc =
             encode_cc_only_resp(request->hdr.instance_id, request->hdr.type,
@@ -56,11 +248,101 @@ class CmdHandler
         return response;
     }
 
+    /** @brief Create a response message containing only cc, for a request
+     *         which is no longer available
+     *
+     *  @param[in] hdr - header of the PLDM request message
+     *  @param[in] cc - Completion Code
+     *  @return PLDM response message
+     */
+    static Response ccOnlyResponse(const pldm_msg_hdr& hdr, uint8_t cc)
+    {
+        auto response = makeResponse(PLDM_CC_ONLY_RESP_BYTES);
+        auto ptr = new (response.data()) pldm_msg;
+        auto rc = encode_cc_only_resp(hdr.instance_id, hdr.type, hdr.command,
+                                      cc, ptr);
+        assert(rc == PLDM_SUCCESS);
+        return response;
+    }
+
+    /** @brief Encode a response message containing only cc into response
+     *
+     *  @param[in] request - PLDM request message
+     *  @param[in] cc - Completion Code
+     *  @param[out] response - PLDM response message
+     */
+    static void ccOnlyResponse(const pldm_msg* request, uint8_t cc,
+                               Response& response)
+    {
+        response.assign(sizeof(pldm_msg), 0);
+        auto ptr = new (response.data()) pldm_msg;
+        auto rc =
+            encode_cc_only_resp(request->hdr.instance_id, request->hdr.type,
+                                request->hdr.command, cc, ptr);
+        assert(rc == PLDM_SUCCESS);
+    }
+
   protected:
     /** @brief map of PLDM command code to handler - to be populated by derived
      *         classes.
      */
     std::map<Command, HandlerFunc> handlers;
+
+    /** @brief map of PLDM command code to handlers that may complete their
+     *         response later - to be populated by derived classes.
+     */
+    std::map<Command, DeferredHandlerFunc> deferredHandlers;
+
+  private:
+    /** @brief Invoke a deferred handler
+     *
+     *  A response completed before the handler returns is returned in
+     *  response, like the response of any other handler. One completed
+     *  later goes to the response sender, response is then left empty.
+     */
+    void handleDeferred(pldm_tid_t tid, const DeferredHandlerFunc& func,
+                        const pldm_msg* request, size_t reqMsgLen,
+                        Response& response)
+    {
+        struct State
+        {
+            bool returned = false;
+            bool completed = false;
+            Response response;
+        };
+        auto state = std::make_shared<State>();
+
+        func(tid, request, reqMsgLen, [this, tid, state](Response&& resp) {
+            if (!state->returned)
+            {
+                state->response = std::move(resp);
+                state->completed = true;
+            }
+            else if (responseSender)
+            {
+                responseSender(tid, std::move(resp));
+            }
+        });
+
+        state->returned = true;
+        response.clear();
+        if (state->completed)
+        {
+            response = std::move(state->response);
+        }
+    }
+
+    static constexpr size_t maxCommands =
+        std::numeric_limits<Command>::max() + 1;
+
+    /** @brief handlers indexed by command code, see buildDispatchTable() */
+    std::array<const HandlerFunc*, maxCommands> dispatchTable{};
+
+    /** @brief deferredHandlers indexed by command code */
+    std::array<const DeferredHandlerFunc*, maxCommands> deferredDispatchTable{};
+
+    /** @brief sends the responses of deferred handlers */
+    ResponseSender responseSender;
 };
 
 } // namespace responder
@@ -1,11 +1,18 @@
 #pragma once
 
+#include "common/trace.hpp"
 #include "handler.hpp"
 
 #include <libpldm/base.h>
 
+#include <array>
+#include <limits>
 #include <map>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace pldm
 {
@@ -19,13 +26,35 @@ class Invoker
 {
   public:
     /** @brief Register a handler for a PLDM Type
+     *
+     *  The handler's commands are flattened into its dispatch table, so the
+     *  handler must have registered its commands by now.
      *
      *  @param[in] pldmType - PLDM type code
      *  @param[in] handler - PLDM Type handler
      */
     void registerHandler(Type pldmType, std::unique_ptr<CmdHandler> handler)
     {
-        handlers.emplace(pldmType, std::move(handler));
+        auto [it, inserted] = handlers.emplace(pldmType, std::move(handler));
+        if (inserted)
+        {
+            it->second->buildDispatchTable();
+            it->second->setResponseSender(responseSender);
+            typeTable[pldmType] = it->second.get();
+        }
+    }
+
+    /** @brief Set how the responses of deferred handlers are sent
+     *
+     *  @param[in] sender - sends a response
+     */
+    void setResponseSender(ResponseSender sender)
+    {
+        responseSender = std::move(sender);
+        for (auto& [_, handler] : handlers)
+        {
+            handler->setResponseSender(responseSender);
+        }
     }
 
     /** @brief Invoke a PLDM command handler
@@ -40,12 +69,65 @@ class Invoker
     Response handle(pldm_tid_t tid, Type pldmType, Command pldmCommand,
                     const pldm_msg* request, size_t reqMsgLen)
     {
-        return handlers.at(pldmType)->handle(tid, pldmCommand, request,
-                                             reqMsgLen);
+        PLDM_TRACE_SPAN("dispatch", "responder", pldmType);
+        return getHandler(pldmType).handle(tid, pldmCommand, request,
+                                           reqMsgLen);
+    }
+
+    /** @brief Invoke a PLDM command handler, encoding into a caller buffer
+     *
+     *  @param[in] tid - PLDM request TID
+     *  @param[in] pldmType - PLDM type code
+     *  @param[in] pldmCommand - PLDM command code
+     *  @param[in] request - PLDM request message
+     *  @param[in] reqMsgLen - PLDM request message size
+     *  @param[out] response - PLDM response message
+     */
+    void handle(pldm_tid_t tid, Type pldmType, Command pldmCommand,
+                const pldm_msg* request, size_t reqMsgLen, Response& response)
+    {
+        PLDM_TRACE_SPAN("dispatch", "responder", pldmType);
+        getHandler(pldmType).handle(tid, pldmCommand, request, reqMsgLen,
+                                    response);
+    }
+
+    /** @brief Get the (type, command) pairs that can be dispatched
+     *
+     *  @return dispatchable pairs, sorted by type then command
+     */
+    std::vector<std::pair<Type, Command>> getDispatchTable() const
+    {
+        std::vector<std::pair<Type, Command>> table;
+        for (const auto& [type, handler] : handlers)
+        {
+            for (auto command : handler->getCommands())
+            {
+                table.emplace_back(type, command);
+            }
+        }
+        return table;
     }
 
   private:
+    CmdHandler& getHandler(Type pldmType) const
+    {
+        auto handler = typeTable[pldmType];
+        if (!handler)
+        {
+            throw std::out_of_range(
+                "No handler registered for PLDM type " +
+                std::to_string(pldmType));
+        }
+        return *handler;
+    }
+
     std::map<Type, std::unique_ptr<CmdHandler>> handlers;
+
+    /** @brief handlers indexed by PLDM type */
+    std::array<CmdHandler*, std::numeric_limits<Type>::max() + 1> typeTable{};
+
+    /** @brief sends the responses of deferred handlers */
+    ResponseSender responseSender;
 };
 
 } // namespace responder
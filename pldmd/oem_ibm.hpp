@@ -6,6 +6,8 @@
 #include "../oem/ibm/libpldmresponder/oem_ibm_handler.hpp"
 #include "../oem/ibm/libpldmresponder/utils.hpp"
 #include "common/utils.hpp"
+#include "dbus_impl_dma_stats.hpp"
+#include "dbus_impl_host_event_stats.hpp"
 #include "dbus_impl_requester.hpp"
 #include "host-bmc/dbus_to_event_handler.hpp"
 #include "invoker.hpp"
@@ -87,8 +89,14 @@ class OemIBM
 
         createOemIbmPlatformHandler();
         oemIbmPlatformHandler->setPlatformHandler(platformHandler);
+        hostPDRHandler->subscribeHostState(
+            [handler = oemIbmPlatformHandler](HostStateEvent event) {
+                handler->hostStateChanged(event);
+            });
 
         createHostLampTestHandler();
+        createDMAStats();
+        createHostEventStats();
 
         registerHandler();
     }
@@ -156,6 +164,24 @@ class OemIBM
             instanceIdDb, repo, reqHandler);
     }
 
+    /** @brief Method for publishing the DMA transfer statistics */
+    void createDMAStats()
+    {
+        auto& bus = pldm::utils::DBusHandler::getBus();
+        dmaStats = std::make_unique<pldm::dbus_api::DMAStats>(
+            bus, "/xyz/openbmc_project/pldm");
+    }
+
+    /** @brief Method for publishing the statistics of the events queued to
+     *         the host
+     */
+    void createHostEventStats()
+    {
+        auto& bus = pldm::utils::DBusHandler::getBus();
+        hostEventStats = std::make_unique<pldm::dbus_api::HostEventStats>(
+            bus, "/xyz/openbmc_project/pldm", *oemIbmPlatformHandler);
+    }
+
     /** @brief Method for registering PLDM OEM handler */
     void registerHandler()
     {
@@ -214,6 +240,12 @@ class OemIBM
 
     std::unique_ptr<pldm::led::HostLampTest> hostLampTest;
 
+    /** @brief DMA transfer statistics on D-Bus */
+    std::unique_ptr<pldm::dbus_api::DMAStats> dmaStats;
+
+    /** @brief Statistics of the events queued to the host on D-Bus */
+    std::unique_ptr<pldm::dbus_api::HostEventStats> hostEventStats;
+
     /** @brief oem IBM Utils handler*/
     std::unique_ptr<responder::oem_utils::Handler> oemUtilsHandler;
 };
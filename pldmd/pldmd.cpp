@@ -1,9 +1,18 @@
 
+#include "common/daemon_stats.hpp"
 #include "common/flight_recorder.hpp"
 #include "common/instance_id.hpp"
+#include "common/json_cache.hpp"
+#include "common/startup_profiler.hpp"
+#include "common/trace.hpp"
 #include "common/transport.hpp"
 #include "common/utils.hpp"
+#include "dbus_impl_daemon_stats.hpp"
+#include "dbus_impl_instance_id_lease.hpp"
+#include "dbus_impl_request_stats.hpp"
 #include "dbus_impl_requester.hpp"
+#include "dbus_impl_send_recv.hpp"
+#include "dbus_impl_sensor_snapshot.hpp"
 #include "fw-update/manager.hpp"
 #include "invoker.hpp"
 #include "platform-mc/dbus_to_terminus_effecters.hpp"
@@ -11,6 +20,8 @@
 #include "requester/handler.hpp"
 #include "requester/mctp_endpoint_discovery.hpp"
 #include "requester/request.hpp"
+#include "response_sender.hpp"
+#include "rx_queue.hpp"
 
 #include <err.h>
 #include <getopt.h>
@@ -27,10 +38,13 @@
 
 #include <phosphor-logging/lg2.hpp>
 #include <sdeventplus/event.hpp>
+#include <sdeventplus/source/event.hpp>
 #include <sdeventplus/source/io.hpp>
 #include <sdeventplus/source/signal.hpp>
 #include <stdplus/signal.hpp>
 
+#include <charconv>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -38,10 +52,13 @@
 #include <iomanip>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 PHOSPHOR_LOG2_USING;
@@ -70,6 +87,10 @@ PHOSPHOR_LOG2_USING;
 
 constexpr const char* PLDMService = "xyz.openbmc_project.PLDM";
 
+/** @brief D-Bus name of this pldmd, PLDMService.<name> for an instance
+ *         given a name */
+static std::string pldmServiceName = PLDMService;
+
 using namespace pldm;
 using namespace sdeventplus;
 using namespace sdeventplus::source;
@@ -86,24 +107,38 @@ void interruptFlightRecorderCallBack(Signal& /*signal*/,
     FlightRecorder::GetInstance().playRecorder();
 }
 
+void interruptTraceCallBack(Signal& /*signal*/, const struct signalfd_siginfo*)
+{
+    info("Received SIGUSR2(12) Signal interrupt");
+    pldm::trace::Recorder::getInstance().dump();
+}
+
 void requestPLDMServiceName()
 {
     try
     {
         auto& bus = pldm::utils::DBusHandler::getBus();
-        bus.request_name(PLDMService);
+        bus.request_name(pldmServiceName.c_str());
     }
     catch (const sdbusplus::exception_t& e)
     {
         error("Failed to request D-Bus name {NAME} with error {ERROR}.", "NAME",
-              PLDMService, "ERROR", e);
+              pldmServiceName, "ERROR", e);
     }
 }
 
-static std::optional<Response> processRxMsg(
-    const std::vector<uint8_t>& requestMsg, Invoker& invoker,
-    requester::Handler<requester::Request>& handler,
-    fw_update::Manager* fwManager, pldm_tid_t tid)
+/** @brief Process a received PLDM message in place
+ *
+ *  @param[in] requestMsg - the message, as handed out by the transport
+ *  @param[out] response - buffer reused across messages for the response
+ *
+ *  @return true if response holds a message to send back
+ */
+static bool processRxMsg(std::span<const uint8_t> requestMsg,
+                         Invoker& invoker,
+                         requester::Handler<requester::Request>& handler,
+                         fw_update::Manager* fwManager, pldm_tid_t tid,
+                         Response& response)
 {
     uint8_t eid = tid;
 
@@ -112,21 +147,25 @@ static std::optional<Response> processRxMsg(
     if (PLDM_SUCCESS != unpack_pldm_header(hdr, &hdrFields))
     {
         error("Empty PLDM request header");
-        return std::nullopt;
+        return false;
     }
+    auto& daemonStats = stats::DaemonStats::getInstance();
+    daemonStats.addRxMessage(hdrFields.pldm_type);
+    // The Rx dispatch stops after a message over its budget, the last
+    // message declared is the one stalling the event loop
+    daemonStats.setLoopActivity("PLDM message", tid, hdrFields.pldm_type,
+                                hdrFields.command);
 
     if (PLDM_RESPONSE != hdrFields.msg_type)
     {
-        Response response;
         auto request = reinterpret_cast<const pldm_msg*>(hdr);
         size_t requestLen = requestMsg.size() - sizeof(struct pldm_msg_hdr);
         try
         {
             if (hdrFields.pldm_type != PLDM_FWUP)
             {
-                response =
-                    invoker.handle(tid, hdrFields.pldm_type, hdrFields.command,
-                                   request, requestLen);
+                invoker.handle(tid, hdrFields.pldm_type, hdrFields.command,
+                               request, requestLen, response);
             }
             else
             {
@@ -137,7 +176,7 @@ static std::optional<Response> processRxMsg(
         catch (const std::out_of_range& e)
         {
             uint8_t completion_code = PLDM_ERROR_UNSUPPORTED_PLDM_CMD;
-            response.resize(sizeof(pldm_msg_hdr));
+            response.assign(sizeof(pldm_msg_hdr), 0);
             auto responseHdr = new (response.data()) pldm_msg_hdr;
             pldm_header_info header{};
             header.msg_type = PLDM_RESPONSE;
@@ -149,11 +188,11 @@ static std::optional<Response> processRxMsg(
                 error(
                     "Failed to add response header for processing Rx, error - {ERROR}",
                     "ERROR", e);
-                return std::nullopt;
+                return false;
             }
             response.insert(response.end(), completion_code);
         }
-        return response;
+        return !response.empty();
     }
     else if (PLDM_RESPONSE == hdrFields.msg_type)
     {
@@ -162,7 +201,7 @@ static std::optional<Response> processRxMsg(
         handler.handleResponse(eid, hdrFields.instance, hdrFields.pldm_type,
                                hdrFields.command, response, responseLen);
     }
-    return std::nullopt;
+    return false;
 }
 
 void optionUsage(void)
@@ -170,32 +209,122 @@ void optionUsage(void)
     info("Usage: pldmd [options]");
     info("Options:");
     info(" [--verbose] - would enable verbosity");
+    info(" [--instance <name>] - publish as xyz.openbmc_project.PLDM.<name>");
+    info(" [--network <id>] - handle the MCTP endpoints of a network only");
+    info(" [--no-host] - leave the host firmware to another instance");
+}
+
+/** @brief Parse an integer option of pldmd
+ *
+ *  @param[in] arg - the option argument
+ *  @param[in] max - the largest value allowed
+ *
+ *  @return the value, std::nullopt if arg is not a number up to max
+ */
+static std::optional<uint32_t> parseOptionValue(std::string_view arg,
+                                                uint32_t max)
+{
+    uint32_t value = 0;
+    auto [ptr, ec] = std::from_chars(arg.data(), arg.data() + arg.size(),
+                                     value);
+    if (ec != std::errc() || ptr != arg.data() + arg.size() || value > max)
+    {
+        return std::nullopt;
+    }
+    return value;
 }
 
 int main(int argc, char** argv)
 {
     bool verbose = false;
+    bool host = true;
+    MctpEndpointFilter endpointFilter;
     static struct option long_options[] = {
-        {"verbose", no_argument, nullptr, 'v'}, {nullptr, 0, nullptr, 0}};
+        {"verbose", no_argument, nullptr, 'v'},
+        {"instance", required_argument, nullptr, 'i'},
+        {"network", required_argument, nullptr, 'n'},
+        {"no-host", no_argument, nullptr, 'H'},
+        {nullptr, 0, nullptr, 0}};
+
+    int argflag;
+    while ((argflag = getopt_long(argc, argv, "vi:n:H", long_options,
+                                  nullptr)) != -1)
+    {
+        switch (argflag)
+        {
+            case 'v':
+                verbose = true;
+                break;
+            case 'i':
+                pldmServiceName = std::string(PLDMService) + "." + optarg;
+                break;
+            case 'n':
+                // The instance binds the PLDM message type of its own
+                // network, the messages of its termini reach it only
+                if (auto network = parseOptionValue(optarg, UINT32_MAX);
+                    network && endpointFilter.networks.empty())
+                {
+                    endpointFilter.networks.emplace(*network);
+                    break;
+                }
+                optionUsage();
+                exit(EXIT_FAILURE);
+            case 'H':
+                host = false;
+                break;
+            default:
+                optionUsage();
+                exit(EXIT_FAILURE);
+        }
+    }
 
-    auto argflag = getopt_long(argc, argv, "v", long_options, nullptr);
-    switch (argflag)
+    // An instance claiming a network binds the PLDM message type on that
+    // network only, the instances of the other networks bind it too
+    if (!endpointFilter.networks.empty())
     {
-        case 'v':
-            verbose = true;
-            break;
-        case -1:
-            break;
-        default:
-            optionUsage();
-            exit(EXIT_FAILURE);
+        auto network = *endpointFilter.networks.begin();
+        pldm::transport::setMctpNetwork(network);
+        info(
+            "Instance {NAME} claims the MCTP endpoints of network {NETWORK}, host firmware {HOST}",
+            "NAME", pldmServiceName, "NETWORK", network, "HOST", host);
     }
+
+    auto& startup = stats::StartupProfiler::getInstance();
+    auto phaseBegin = std::chrono::steady_clock::now();
+
+#ifdef LIBPLDMRESPONDER
+    // The JSON configuration of the subsystems is independent, parse it all
+    // at once on the worker pool, the handlers below take it from the cache
+    auto configLoad = pldm::utils::JsonCache::getInstance().preload(
+        {PDR_JSONS_DIR, EVENTS_JSONS_DIR, HOST_JSONS_DIR, FRU_JSONS_DIR,
+         FRU_MASTER_JSON, BIOS_JSONS_DIR, ENTITY_MAP_JSON});
+    info(
+        "Preloaded {FILES} JSON files of {BYTES} bytes in {ELAPSED_US} us, {PARSING_US} us of parsing, {FAILED} failed",
+        "FILES", configLoad.files, "BYTES", configLoad.bytes, "ELAPSED_US",
+        configLoad.elapsed.count(), "PARSING_US", configLoad.parsing.count(),
+        "FAILED", configLoad.failed);
+    // The last reader is the PDR repository build, the files still cached
+    // then are not read at startup
+    startup.whenReached("PdrRepository", [] {
+        auto evicted = pldm::utils::JsonCache::getInstance().evict();
+        if (evicted)
+        {
+            info("Evicted {FILES} preloaded JSON files not read at startup",
+                 "FILES", evicted);
+        }
+    });
+    phaseBegin = startup.phase("Config", phaseBegin);
+#endif
+
     // Setup PLDM requester transport
-    auto hostEID = pldm::utils::readHostEID();
+    auto hostEIDs = host ? pldm::utils::readHostEIDs()
+                         : std::vector<uint8_t>{};
+    uint8_t hostEID = hostEIDs.empty() ? 0 : hostEIDs.front();
     /* To maintain current behaviour until we have the infrastructure to find
      * and use the correct TIDs */
     pldm_tid_t TID = hostEID;
     PldmTransport pldmTransport{};
+    phaseBegin = startup.phase("Transport", phaseBegin);
     auto event = Event::get_default();
     auto& bus = pldm::utils::DBusHandler::getBus();
     sdbusplus::server::manager_t objManager(bus,
@@ -206,12 +335,18 @@ int main(int argc, char** argv)
     InstanceIdDb instanceIdDb;
     dbus_api::Requester dbusImplReq(bus, "/xyz/openbmc_project/pldm",
                                     instanceIdDb);
+    dbus_api::InstanceIdLease dbusImplInstanceIdLease(
+        bus, "/xyz/openbmc_project/pldm", event, instanceIdDb);
     sdbusplus::server::manager_t inventoryManager(
         bus, "/xyz/openbmc_project/inventory");
 
     Invoker invoker{};
     requester::Handler<requester::Request> reqHandler(&pldmTransport, event,
                                                       instanceIdDb, verbose);
+    dbus_api::RequestStats dbusImplReqStats(bus, "/xyz/openbmc_project/pldm",
+                                            reqHandler.getStats());
+    dbus_api::SendRecv dbusImplSendRecv(bus, "/xyz/openbmc_project/pldm",
+                                        instanceIdDb, reqHandler);
 
     std::unique_ptr<pldm_pdr, decltype(&pldm_pdr_destroy)> pdrRepo(
         pldm_pdr_init(), pldm_pdr_destroy);
@@ -219,10 +354,19 @@ int main(int argc, char** argv)
     {
         throw std::runtime_error("Failed to instantiate PDR repository");
     }
+#ifdef DBUS_SERVICE_CACHE_WARM_START
+    DBusHandler::enableServiceCache(DBUS_SERVICE_CACHE_SIZE, true);
+#else
+    DBusHandler::enableServiceCache(DBUS_SERVICE_CACHE_SIZE, false);
+#endif
     DBusHandler dbusHandler;
 
     std::unique_ptr<platform_mc::Manager> platformManager =
         std::make_unique<platform_mc::Manager>(event, reqHandler, instanceIdDb);
+    dbus_api::SensorSnapshot dbusImplSensorSnapshot(
+        bus, "/xyz/openbmc_project/pldm", platformManager->getTermini());
+    dbus_api::DaemonStats dbusImplDaemonStats(
+        bus, "/xyz/openbmc_project/pldm", pdrRepo.get(), *platformManager);
 
     std::unique_ptr<pldm::host_effecters::HostEffecterParser>
         hostEffecterParser =
@@ -252,6 +396,11 @@ int main(int argc, char** argv)
             "Failed to instantiate BMC PDR entity association tree");
     }
     std::shared_ptr<HostPDRHandler> hostPDRHandler;
+    using EntityTree =
+        std::unique_ptr<pldm_entity_association_tree,
+                        decltype(&pldm_entity_association_tree_destroy)>;
+    std::vector<EntityTree> hostEntityTrees;
+    std::vector<std::unique_ptr<HostPDRHandler>> otherHostPDRHandlers;
     std::unique_ptr<DbusToPLDMEvent> dbusToPLDMEventHandler;
     std::unique_ptr<platform_config::Handler> platformConfigHandler{};
     platformConfigHandler =
@@ -264,6 +413,25 @@ int main(int argc, char** argv)
             EVENTS_JSONS_DIR, entityTree.get(), bmcEntityTree.get(),
             instanceIdDb, &reqHandler);
 
+        // The other hosts exchange their PDRs on their own, at the same time
+        // as the first one, each merging its entities into its own copy of
+        // the BMC entity tree and keeping its PDRs in its own repo
+        for (size_t hostId = 1; hostId < hostEIDs.size(); hostId++)
+        {
+            auto& hostEntityTree = hostEntityTrees.emplace_back(
+                pldm_entity_association_tree_init(),
+                pldm_entity_association_tree_destroy);
+            if (!hostEntityTree)
+            {
+                throw std::runtime_error(
+                    "Failed to instantiate host PDR entity association tree");
+            }
+            otherHostPDRHandlers.emplace_back(std::make_unique<HostPDRHandler>(
+                pldmTransport.getEventSource(), hostEIDs[hostId], event,
+                pdrRepo.get(), EVENTS_JSONS_DIR, hostEntityTree.get(),
+                bmcEntityTree.get(), instanceIdDb, &reqHandler, hostId));
+        }
+
         // HostFirmware interface needs access to hostPDR to know if host
         // is running
         dbusImplHost.setHostPdrObj(hostPDRHandler);
@@ -275,6 +443,14 @@ int main(int argc, char** argv)
     auto fruHandler = std::make_unique<fru::Handler>(
         FRU_JSONS_DIR, FRU_MASTER_JSON, pdrRepo.get(), entityTree.get(),
         bmcEntityTree.get());
+    if (hostPDRHandler)
+    {
+        // The host is told about the FRU PDRs following the inventory
+        fruHandler->setPdrChangedHandler(
+            [handler = hostPDRHandler.get()](pdr_utils::PdrChanges&& changes) {
+                handler->sendPDRRepositoryChgEvent(std::move(changes));
+            });
+    }
 
     // FRU table is built lazily when a FRU command or Get PDR command is
     // handled. To enable building FRU table, the FRU handler is passed to the
@@ -301,6 +477,13 @@ int main(int argc, char** argv)
                              size_t eventDataOffset) {
              return platformManager->handleSensorEvent(
                  request, payloadLength, formatVersion, tid, eventDataOffset);
+         }}},
+        {PLDM_PDR_REPOSITORY_CHG_EVENT,
+         {[&platformManager](const pldm_msg* request, size_t payloadLength,
+                             uint8_t formatVersion, uint8_t tid,
+                             size_t eventDataOffset) {
+             return platformManager->handlePdrRepositoryChgEvent(
+                 request, payloadLength, formatVersion, tid, eventDataOffset);
          }}}};
 
     auto platformHandler = std::make_unique<platform::Handler>(
@@ -308,6 +491,11 @@ int main(int argc, char** argv)
         hostPDRHandler.get(), dbusToPLDMEventHandler.get(), fruHandler.get(),
         platformConfigHandler.get(), &reqHandler, event, true,
         addOnEventHandlers);
+    for (const auto& otherHostPDRHandler : otherHostPDRHandlers)
+    {
+        platformHandler->addHostPDRHandler(otherHostPDRHandler->getHostEID(),
+                                           otherHostPDRHandler.get());
+    }
 
     auto biosHandler = std::make_unique<bios::Handler>(
         pldmTransport.getEventSource(), hostEID, &instanceIdDb, &reqHandler,
@@ -331,6 +519,10 @@ int main(int argc, char** argv)
         &reqHandler);
 #endif
 
+    // Build the PDR repository in the background once the OEM handlers are
+    // set, not on the first GetPDR from the host
+    platformHandler->startPDRBuild();
+
     invoker.registerHandler(PLDM_BIOS, std::move(biosHandler));
     invoker.registerHandler(PLDM_PLATFORM, std::move(platformHandler));
     invoker.registerHandler(PLDM_FRU, std::move(fruHandler));
@@ -344,11 +536,65 @@ int main(int argc, char** argv)
 
     std::unique_ptr<fw_update::Manager> fwManager =
         std::make_unique<fw_update::Manager>(event, reqHandler, instanceIdDb);
+    phaseBegin = startup.phase("Handlers", phaseBegin);
     std::unique_ptr<MctpDiscovery> mctpDiscoveryHandler =
         std::make_unique<MctpDiscovery>(
-            bus, std::initializer_list<MctpDiscoveryHandlerIntf*>{
-                     fwManager.get(), platformManager.get()});
-    auto callback = [verbose, &invoker, &reqHandler, &fwManager, &pldmTransport,
+            bus,
+            std::initializer_list<MctpDiscoveryHandlerIntf*>{
+                fwManager.get(), platformManager.get()},
+            std::move(endpointFilter));
+    phaseBegin = startup.phase("MctpDiscovery", phaseBegin);
+    // Response of the message being handled, given back to the
+    // ResponsePool once sent.
+    Response responseBuf;
+    // Responses go back to the terminus which sent the request
+    ResponseSender sendResponse(pldmTransport, verbose);
+    // Responses of handlers completing once a D-Bus call returned
+    invoker.setResponseSender(
+        [&sendResponse](pldm_tid_t tid, Response&& response) {
+            sendResponse(tid, response);
+            ResponsePool::getInstance().put(std::move(response));
+        });
+    // Received messages are queued by priority class and terminus, and
+    // dispatched from a source running after the readers. A terminus
+    // flooding requests then neither delays the requests of the other
+    // termini nor the more urgent requests, and each dispatch round is
+    // bounded in time.
+    RxQueue rxQueue;
+    rxQueue.loadClasses(RX_PRIORITY_JSON);
+    Defer rxDispatch(event, [&rxQueue, &invoker, &reqHandler, &fwManager,
+                             &responseBuf,
+                             &sendResponse](EventBase& source) {
+        constexpr std::chrono::microseconds budget(RX_DISPATCH_BUDGET_US);
+        auto start = std::chrono::steady_clock::now();
+        do
+        {
+            auto message = rxQueue.pop();
+            if (!message)
+            {
+                break;
+            }
+            PLDM_TRACE_SPAN("message", "pldmd", message->tid);
+            // process message and send response
+            if (processRxMsg(message->data(), invoker, reqHandler,
+                             fwManager.get(), message->tid, responseBuf))
+            {
+                sendResponse(message->tid, responseBuf);
+            }
+            // The next handler builds its response in a released buffer
+            ResponsePool::getInstance().put(std::move(responseBuf));
+        } while (!rxQueue.empty() &&
+                 std::chrono::steady_clock::now() - start < budget);
+
+        if (rxQueue.empty())
+        {
+            source.set_enabled(Enabled::Off);
+        }
+    });
+    rxDispatch.set_priority(SD_EVENT_PRIORITY_NORMAL + 1);
+    rxDispatch.set_enabled(Enabled::Off);
+
+    auto callback = [&rxQueue, &rxDispatch, verbose, &pldmTransport,
                      TID](IO& io, int fd, uint32_t revents) mutable {
         if (!(revents & EPOLLIN))
         {
@@ -359,87 +605,128 @@ int main(int argc, char** argv)
             return;
         }
 
-        int returnCode = 0;
-        void* requestMsg;
-        size_t recvDataLength;
-        returnCode = pldmTransport.recvMsg(TID, requestMsg, recvDataLength);
-
-        if (returnCode == PLDM_REQUESTER_SUCCESS)
+        // Drain every message pending, a burst is served by one wakeup and
+        // the buffers come from the pool of the transport backend
+        while (true)
         {
-            std::vector<uint8_t> requestMsgVec(
-                static_cast<uint8_t*>(requestMsg),
-                static_cast<uint8_t*>(requestMsg) + recvDataLength);
-            FlightRecorder::GetInstance().saveRecord(requestMsgVec, false);
-            if (verbose)
+            pldm::transport::RxBuffer requestMsg;
+            size_t recvDataLength = 0;
+            auto returnCode =
+                pldmTransport.recvMsg(TID, requestMsg, recvDataLength);
+            if (returnCode == PLDM_REQUESTER_TRANSPORT_BUSY)
             {
-                printBuffer(Rx, requestMsgVec);
+                // Packets were consumed but no complete message is available
+                break;
             }
-            // process message and send response
-            auto response = processRxMsg(requestMsgVec, invoker, reqHandler,
-                                         fwManager.get(), TID);
-            if (response.has_value())
+
+            if (returnCode == PLDM_REQUESTER_SUCCESS)
             {
-                FlightRecorder::GetInstance().saveRecord(*response, true);
+                // The queue takes over the transport's buffer
+                std::span<const uint8_t> requestMsgSpan(
+                    static_cast<const uint8_t*>(requestMsg.get()),
+                    recvDataLength);
+                FlightRecorder::GetInstance().saveRecord(requestMsgSpan, false,
+                                                         TID);
+                PLDM_TRACE_INSTANT("rx", "pldmd", TID);
                 if (verbose)
                 {
-                    printBuffer(Tx, *response);
-                }
-
-                returnCode = pldmTransport.sendMsg(TID, (*response).data(),
-                                                   (*response).size());
-                if (returnCode != PLDM_REQUESTER_SUCCESS)
-                {
-                    warning(
-                        "Failed to send pldmTransport message for TID '{TID}', response code '{RETURN_CODE}'",
-                        "TID", TID, "RETURN_CODE", returnCode);
+                    printBuffer(Rx, requestMsgSpan);
                 }
+                rxQueue.push(
+                    RxMessage(TID, std::move(requestMsg), recvDataLength));
+                rxDispatch.set_enabled(Enabled::On);
+                continue;
+            }
+            // TODO check that we get here if mctp-demux dies?
+            else if (returnCode == PLDM_REQUESTER_RECV_FAIL)
+            {
+                // MCTP daemon has closed the socket this daemon is connected
+                // to. This may or may not be an error scenario, in either
+                // case the recovery mechanism for this daemon is to restart,
+                // and hence exit the event loop, that will cause this daemon
+                // to exit with a failure code.
+                error(
+                    "MCTP daemon closed the socket, IO exiting with response code '{RC}'",
+                    "RC", returnCode);
+                io.get_event().exit(0);
+                break;
+            }
+            else if (returnCode == PLDM_REQUESTER_INVALID_RECV_LEN)
+            {
+                error("Empty PLDM request header");
+                continue;
             }
-        }
-        // TODO check that we get here if mctp-demux dies?
-        else if (returnCode == PLDM_REQUESTER_RECV_FAIL)
-        {
-            // MCTP daemon has closed the socket this daemon is connected to.
-            // This may or may not be an error scenario, in either case the
-            // recovery mechanism for this daemon is to restart, and hence exit
-            // the event loop, that will cause this daemon to exit with a
-            // failure code.
-            error(
-                "MCTP daemon closed the socket, IO exiting with response code '{RC}'",
-                "RC", returnCode);
-            io.get_event().exit(0);
-        }
-        else
-        {
             warning(
                 "Failed to receive PLDM request for pldmTransport, response code '{RETURN_CODE}'",
                 "RETURN_CODE", returnCode);
+            break;
         }
-        /* Free requestMsg after using */
-        free(requestMsg);
     };
 
     bus.attach_event(event.get(), SD_EVENT_PRIORITY_NORMAL);
+    auto& daemonStats = stats::DaemonStats::getInstance();
+    daemonStats.setStallThreshold(
+        std::chrono::milliseconds(EVENT_LOOP_STALL_THRESHOLD_MS));
+    if (auto rc = daemonStats.monitorEventLoop(event.get()); rc < 0)
+    {
+        warning(
+            "Failed to measure the event loop iterations, response code '{RC}'",
+            "RC", rc);
+    }
+    if (auto rc = daemonStats.monitorDbus(bus.get()); rc < 0)
+    {
+        warning(
+            "Failed to attribute the event loop stalls to D-Bus messages, response code '{RC}'",
+            "RC", rc);
+    }
 #ifndef SYSTEM_SPECIFIC_BIOS_JSON
     try
     {
-        bus.request_name(PLDMService);
+        bus.request_name(pldmServiceName.c_str());
     }
     catch (const sdbusplus::exception_t& e)
     {
         error("Failed to request D-Bus name {NAME} with error {ERROR}.", "NAME",
-              PLDMService, "ERROR", e);
+              pldmServiceName, "ERROR", e);
     }
 #endif
     IO io(event, pldmTransport.getEventSource(), EPOLLIN, std::move(callback));
+    // Fragments queued on the I2C binding are drained one per dispatch so a
+    // multi-packet message does not stall the rest of the event loop.
+    std::optional<IO> txIO;
+    if (pldmTransport.getTxEventSource() >= 0)
+    {
+        txIO.emplace(event, pldmTransport.getTxEventSource(), EPOLLIN,
+                     [&pldmTransport](IO&, int, uint32_t revents) {
+                         if (revents & EPOLLIN)
+                         {
+                             pldmTransport.processTx();
+                         }
+                     });
+    }
 #ifdef LIBPLDMRESPONDER
     if (hostPDRHandler)
     {
         hostPDRHandler->setHostFirmwareCondition();
     }
+    for (const auto& otherHostPDRHandler : otherHostPDRHandlers)
+    {
+        otherHostPDRHandler->setHostFirmwareCondition();
+    }
 #endif
     stdplus::signal::block(SIGUSR1);
     sdeventplus::source::Signal sigUsr1(
         event, SIGUSR1, std::bind_front(&interruptFlightRecorderCallBack));
+    stdplus::signal::block(SIGUSR2);
+    sdeventplus::source::Signal sigUsr2(
+        event, SIGUSR2, std::bind_front(&interruptTraceCallBack));
+    startup.phase("DBus", phaseBegin);
+    startup.milestone("EventLoop");
+#ifdef LIBPLDMRESPONDER
+    startup.require({"EventLoop", "PdrRepository", "TerminusDiscovery"});
+#else
+    startup.require({"EventLoop", "TerminusDiscovery"});
+#endif
     int returnCode = event.loop();
     if (returnCode)
     {
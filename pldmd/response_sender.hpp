@@ -0,0 +1,68 @@
+#pragma once
+
+#include "common/daemon_stats.hpp"
+#include "common/flight_recorder.hpp"
+#include "common/transport.hpp"
+#include "common/types.hpp"
+#include "common/utils.hpp"
+
+#include <libpldm/base.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+namespace pldm
+{
+namespace responder
+{
+
+/** @class ResponseSender
+ *
+ *  Sends the responses of pldmd to the terminus their request came from,
+ *  both the responses of the handlers answering at once and those of the
+ *  handlers completing later.
+ */
+class ResponseSender
+{
+  public:
+    /** @brief Constructor
+     *
+     *  @param[in] transport - transport the requests were received from
+     *  @param[in] verbose - print the responses sent
+     */
+    ResponseSender(PldmTransport& transport, bool verbose) :
+        transport(transport), verbose(verbose)
+    {}
+
+    /** @brief Send a response
+     *
+     *  @param[in] tid - TID of the terminus which sent the request
+     *  @param[in] response - the response
+     */
+    void operator()(pldm_tid_t tid, const Response& response) const
+    {
+        flightrecorder::FlightRecorder::GetInstance().saveRecord(response, true,
+                                                                 tid);
+        if (verbose)
+        {
+            utils::printBuffer(utils::Tx, response);
+        }
+
+        auto returnCode =
+            transport.sendMsg(tid, response.data(), response.size());
+        if (returnCode != PLDM_REQUESTER_SUCCESS)
+        {
+            lg2::warning(
+                "Failed to send pldmTransport message for TID '{TID}', response code '{RETURN_CODE}'",
+                "TID", tid, "RETURN_CODE", returnCode);
+            return;
+        }
+        stats::DaemonStats::getInstance().addResponse(response.size());
+    }
+
+  private:
+    PldmTransport& transport;
+    bool verbose;
+};
+
+} // namespace responder
+} // namespace pldm
@@ -0,0 +1,274 @@
+#pragma once
+
+#include "common/transport_backend.hpp"
+
+#include <libpldm/base.h>
+#include <libpldm/platform.h>
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+
+PHOSPHOR_LOG2_USING;
+
+namespace pldm
+{
+namespace responder
+{
+
+/** @brief Priority classes of the received messages, the first served first
+ */
+enum class RxClass : uint8_t
+{
+    Control, //!< responses and platform control commands
+    Normal,  //!< base, monitoring, BIOS, FRU and firmware update commands
+    Bulk,    //!< bulk transfers, like the OEM file IO commands
+};
+
+/** @struct RxMessage
+ *
+ *  A message received from a terminus, owning the buffer handed out by the
+ *  transport
+ */
+struct RxMessage
+{
+    /** @brief Constructor, for a buffer released with free() */
+    RxMessage(pldm_tid_t tid, void* msg, size_t len) :
+        tid(tid), msg(msg), len(len)
+    {}
+
+    /** @brief Constructor, for a buffer released to its pool */
+    RxMessage(pldm_tid_t tid, transport::RxBuffer&& msg, size_t len) :
+        tid(tid), msg(std::move(msg)), len(len)
+    {}
+
+    std::span<const uint8_t> data() const
+    {
+        return {static_cast<const uint8_t*>(msg.get()), len};
+    }
+
+    pldm_tid_t tid;
+    transport::RxBuffer msg;
+    size_t len;
+};
+
+/**
+ *  @class RxQueue
+ *
+ *  Queues the received messages between the transport and their dispatch.
+ *  Messages are served by priority class, and within a class round robin
+ *  across the terminus IDs, so one terminus flooding requests does not delay
+ *  the requests of another. The messages of a terminus stay in order within
+ *  a class.
+ *
+ *  The classes of the requests can be reassigned from a JSON file like
+ *
+ *  {
+ *      "types": [{ "type": 3, "class": "bulk" }],
+ *      "commands": [{ "type": 63, "command": 1, "class": "control" }]
+ *  }
+ *
+ *  where "class" is one of "control", "normal" and "bulk". A command entry
+ *  overrides the class of its PLDM type.
+ */
+class RxQueue
+{
+  public:
+    RxQueue()
+    {
+        typeClasses.fill(RxClass::Normal);
+        typeClasses[PLDM_OEM] = RxClass::Bulk;
+        for (auto command :
+             {PLDM_SET_STATE_EFFECTER_STATES, PLDM_SET_NUMERIC_EFFECTER_VALUE,
+              PLDM_PLATFORM_EVENT_MESSAGE, PLDM_SET_EVENT_RECEIVER})
+        {
+            commandClasses[{PLDM_PLATFORM, command}] = RxClass::Control;
+        }
+    }
+
+    /** @brief Set the priority class of the requests of a PLDM type */
+    void setTypeClass(uint8_t pldmType, RxClass rxClass)
+    {
+        typeClasses[pldmType] = rxClass;
+    }
+
+    /** @brief Set the priority class of the requests of a command, overriding
+     *         the class of its PLDM type
+     */
+    void setCommandClass(uint8_t pldmType, uint8_t command, RxClass rxClass)
+    {
+        commandClasses[{pldmType, command}] = rxClass;
+    }
+
+    /** @brief Reassign the priority classes from a JSON file
+     *
+     *  @param[in] path - path of the JSON file, a missing file keeps the
+     *                    default classes
+     */
+    void loadClasses(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            return;
+        }
+
+        auto json = nlohmann::json::parse(file, nullptr, false);
+        if (json.is_discarded() || !json.is_object())
+        {
+            error("Failed to parse the request priority config '{PATH}'",
+                  "PATH", path);
+            return;
+        }
+
+        static const std::map<std::string, RxClass> classNames{
+            {"control", RxClass::Control},
+            {"normal", RxClass::Normal},
+            {"bulk", RxClass::Bulk}};
+        auto load = [&](const char* key, auto&& set) {
+            for (const auto& entry : json.value(key, nlohmann::json::array()))
+            {
+                try
+                {
+                    auto it = classNames.find(
+                        entry.at("class").get<std::string>());
+                    if (it == classNames.end())
+                    {
+                        error(
+                            "Unknown class in the request priority config '{PATH}'",
+                            "PATH", path);
+                        continue;
+                    }
+                    set(entry, it->second);
+                }
+                catch (const std::exception& e)
+                {
+                    error(
+                        "Invalid entry in the request priority config '{PATH}', error - {ERROR}",
+                        "PATH", path, "ERROR", e);
+                }
+            }
+        };
+        load("types", [this](const nlohmann::json& entry, RxClass rxClass) {
+            setTypeClass(entry.at("type").get<uint8_t>(), rxClass);
+        });
+        load("commands",
+             [this](const nlohmann::json& entry, RxClass rxClass) {
+                 setCommandClass(entry.at("type").get<uint8_t>(),
+                                 entry.at("command").get<uint8_t>(), rxClass);
+             });
+    }
+
+    /** @brief Get the priority class of a message
+     *
+     *  @param[in] hdr - PLDM header of the message
+     *  @return the class, RxClass::Control for responses
+     */
+    RxClass classify(const pldm_msg_hdr& hdr) const
+    {
+        if (!hdr.request)
+        {
+            // Requesters are waiting with a timeout
+            return RxClass::Control;
+        }
+        if (auto it = commandClasses.find({hdr.type, hdr.command});
+            it != commandClasses.end())
+        {
+            return it->second;
+        }
+        return typeClasses[hdr.type];
+    }
+
+    /** @brief Queue a message, it must hold at least a PLDM header */
+    void push(RxMessage&& message)
+    {
+        auto hdr = reinterpret_cast<const pldm_msg_hdr*>(message.msg.get());
+        auto& queue = queues[static_cast<size_t>(classify(*hdr))];
+        auto& tidQueue = queue.messages[message.tid];
+        if (tidQueue.empty())
+        {
+            queue.ready.push_back(message.tid);
+        }
+        tidQueue.push_back(std::move(message));
+        count++;
+    }
+
+    /** @brief Take the next message to dispatch
+     *
+     *  @return the message, std::nullopt if the queue is empty
+     */
+    std::optional<RxMessage> pop()
+    {
+        for (auto& queue : queues)
+        {
+            if (queue.ready.empty())
+            {
+                continue;
+            }
+            auto tid = queue.ready.front();
+            queue.ready.pop_front();
+            auto it = queue.messages.find(tid);
+            auto message = std::move(it->second.front());
+            it->second.pop_front();
+            if (it->second.empty())
+            {
+                queue.messages.erase(it);
+            }
+            else
+            {
+                queue.ready.push_back(tid);
+            }
+            count--;
+            return message;
+        }
+        return std::nullopt;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return !count;
+    }
+
+  private:
+    /** @brief Messages of a class */
+    struct ClassQueue
+    {
+        /** @brief Queued messages of each terminus */
+        std::map<pldm_tid_t, std::deque<RxMessage>> messages;
+
+        /** @brief Terminus IDs with queued messages, in serving order */
+        std::deque<pldm_tid_t> ready;
+    };
+
+    static constexpr size_t numClasses =
+        static_cast<size_t>(RxClass::Bulk) + 1;
+
+    std::array<ClassQueue, numClasses> queues;
+
+    std::array<RxClass, UINT8_MAX + 1> typeClasses{};
+
+    std::map<std::pair<uint8_t, uint8_t>, RxClass> commandClasses;
+
+    size_t count = 0;
+};
+
+} // namespace responder
+} // namespace pldm
@@ -9,6 +9,8 @@
 
 #include <iostream>
 #include <string>
+#include <tuple>
+#include <vector>
 namespace pldmtool
 {
 
@@ -27,6 +29,82 @@ const std::map<const char*, pldm_fileio_table_type> pldmFileIOTableTypes{
 
 constexpr uint8_t CHKSUM_PADDING = 8;
 
+/** @brief PLDM file type, transfers, failures, bytes, chunks, and
+ *         microseconds elapsed, waiting, in DMA and in file I/O, as returned
+ *         by pldmd's GetStatistics
+ */
+using DMAStatsEntry =
+    std::tuple<uint16_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t,
+               uint64_t, uint64_t, uint64_t>;
+
+/** @brief Name of a PLDM file type in the DMA statistics */
+std::string fileTypeName(uint16_t fileType)
+{
+    static const std::map<uint16_t, std::string> names{
+        {PLDM_FILE_TYPE_PEL, "PEL"},
+        {PLDM_FILE_TYPE_LID_PERM, "LIDPerm"},
+        {PLDM_FILE_TYPE_LID_TEMP, "LIDTemp"},
+        {PLDM_FILE_TYPE_DUMP, "Dump"},
+        {PLDM_FILE_TYPE_CERT_SIGNING_REQUEST, "CertSigningRequest"},
+        {PLDM_FILE_TYPE_SIGNED_CERT, "SignedCert"},
+        {PLDM_FILE_TYPE_ROOT_CERT, "RootCert"},
+        {PLDM_FILE_TYPE_LID_MARKER, "LIDMarker"},
+        {PLDM_FILE_TYPE_RESOURCE_DUMP_PARMS, "ResourceDumpParms"},
+        {PLDM_FILE_TYPE_RESOURCE_DUMP, "ResourceDump"},
+        {PLDM_FILE_TYPE_PROGRESS_SRC, "ProgressSRC"},
+        {PLDM_FILE_TYPE_LID_RUNNING, "LIDRunning"},
+        {PLDM_FILE_TYPE_PSPD_VPD_PDD_KEYWORD, "VPDKeyword"},
+        {PLDM_FILE_TYPE_PCIE_TOPOLOGY, "PCIeTopology"},
+        {PLDM_FILE_TYPE_CABLE_INFO, "CableInfo"},
+        // The transfers of the file handle commands
+        {0xFFFF, "FileHandle"},
+    };
+    auto it = names.find(fileType);
+    return it != names.end() ? it->second : std::to_string(fileType);
+}
+
+void getDMAStatistics()
+{
+    std::vector<DMAStatsEntry> entries;
+    try
+    {
+        auto& bus = pldm::utils::DBusHandler::getBus();
+        auto method = bus.new_method_call(
+            "xyz.openbmc_project.PLDM", "/xyz/openbmc_project/pldm",
+            "xyz.openbmc_project.PLDM.DMAStatistics", "GetStatistics");
+        auto reply = bus.call(method);
+        reply.read(entries);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to read the DMA statistics of pldmd, error - "
+                  << e.what() << "\n";
+        return;
+    }
+
+    ordered_json data = ordered_json::array();
+    for (const auto& [fileType, transfers, failures, bytes, chunks, elapsed,
+                      wait, dma, file] : entries)
+    {
+        ordered_json entry;
+        entry["FileType"] = fileTypeName(fileType);
+        entry["Transfers"] = transfers;
+        entry["Failures"] = failures;
+        entry["Bytes"] = bytes;
+        entry["Chunks"] = chunks;
+        entry["ElapsedUs"] = elapsed;
+        entry["WaitUs"] = wait;
+        entry["DMAUs"] = dma;
+        entry["FileIOUs"] = file;
+        entry["KiBPerSecond"] =
+            elapsed ? static_cast<uint64_t>(static_cast<double>(bytes) *
+                                            1000000 / 1024 / elapsed)
+                    : 0;
+        data.emplace_back(std::move(entry));
+    }
+    DisplayInJson(data);
+}
+
 } // namespace
 
 class GetAlertStatus : public CommandInterface
@@ -109,6 +187,12 @@ class GetFileTable : public CommandInterface
     }
 
     void parseResponseMsg(pldm_msg*, size_t) override {}
+
+    bool singleRequest() const override
+    {
+        return false;
+    }
+
     void exec() override
     {
         std::vector<uint8_t> requestMsg(
@@ -198,6 +282,8 @@ class GetFileTable : public CommandInterface
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto oem_ibm = app.add_subcommand("oem-ibm", "oem type command");
     oem_ibm->require_subcommand(1);
 
@@ -211,6 +297,10 @@ void registerCommand(CLI::App& app)
 
     commands.push_back(std::make_unique<GetFileTable>("oem_ibm", "getFileTable",
                                                       getFileTable));
+
+    auto dmaStatistics = oem_ibm->add_subcommand(
+        "DMAStatistics", "show the DMA transfer statistics of pldmd");
+    dmaStatistics->callback(getDMAStatistics);
 }
 } // namespace oem_ibm
 } // namespace pldmtool
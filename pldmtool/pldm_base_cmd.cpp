@@ -9,6 +9,7 @@
 #include <libpldm/oem/ibm/host.h>
 #endif
 
+#include <algorithm>
 #include <string>
 
 namespace pldmtool
@@ -396,8 +397,40 @@ class GetPLDMCommands : public CommandInterface
     }
 };
 
+std::string getCommandName(uint8_t type, uint8_t command)
+{
+    auto lookup = [command](const auto& commands) -> std::string {
+        auto it = std::ranges::find_if(commands, [command](const auto& entry) {
+            return entry.second == command;
+        });
+        return it == commands.end() ? "" : it->first;
+    };
+    switch (type)
+    {
+        case PLDM_BASE:
+            return lookup(pldmBaseCmds);
+        case PLDM_PLATFORM:
+            return lookup(pldmPlatformCmds);
+        case PLDM_BIOS:
+            return lookup(pldmBiosCmds);
+        case PLDM_FRU:
+            return lookup(pldmFruCmds);
+#ifdef OEM_IBM
+        case PLDM_OEM:
+        {
+            auto name = lookup(pldmIBMFileIOCmds);
+            return name.empty() ? lookup(pldmIBMHostCmds) : name;
+        }
+#endif
+        default:
+            return "";
+    }
+}
+
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto base = app.add_subcommand("base", "base type command");
     base->require_subcommand(1);
 
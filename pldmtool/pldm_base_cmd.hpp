@@ -2,6 +2,9 @@
 
 #include <CLI/CLI.hpp>
 
+#include <cstdint>
+#include <string>
+
 namespace pldmtool
 {
 
@@ -9,6 +12,15 @@ namespace base
 {
 
 void registerCommand(CLI::App& app);
-}
+
+/** @brief Name of a PLDM command, as listed by GetPLDMCommands
+ *
+ *  @param[in] type - PLDM type of the command
+ *  @param[in] command - command code
+ *
+ *  @return the name of the command, empty if it is unknown
+ */
+std::string getCommandName(uint8_t type, uint8_t command);
+} // namespace base
 
 } // namespace pldmtool
@@ -0,0 +1,291 @@
+#include "pldm_bench_cmd.hpp"
+
+#include "pldm_cmd_helper.hpp"
+
+#ifdef OEM_IBM
+#include <libpldm/oem/ibm/file_io.h>
+#endif
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace pldmtool
+{
+
+namespace bench
+{
+
+namespace
+{
+
+using namespace pldmtool::helper;
+
+std::vector<std::unique_ptr<CommandInterface>> commands;
+
+/** @brief Commands the benchmark can send */
+enum class Request
+{
+    getTID,
+    getSensorReading,
+    getPDR,
+#ifdef OEM_IBM
+    readFile,
+#endif
+};
+
+const std::map<std::string, Request> requests{
+    {"GetTID", Request::getTID},
+    {"GetSensorReading", Request::getSensorReading},
+    {"GetPDR", Request::getPDR},
+#ifdef OEM_IBM
+    {"ReadFile", Request::readFile},
+#endif
+};
+
+} // namespace
+
+class Bench : public CommandInterface
+{
+  public:
+    ~Bench() = default;
+    Bench() = delete;
+    Bench(const Bench&) = delete;
+    Bench(Bench&&) = default;
+    Bench& operator=(const Bench&) = delete;
+    Bench& operator=(Bench&&) = delete;
+
+    explicit Bench(const char* type, const char* name, CLI::App* app) :
+        CommandInterface(type, name, app)
+    {
+        std::string names;
+        for (const auto& [command, request] : requests)
+        {
+            names += (names.empty() ? "" : ", ") + command;
+        }
+        app->add_option("--mix", mix,
+                        "comma separated commands to send, each optionally "
+                        "followed by :weight, among " +
+                            names + " (GetTID)")
+            ->delimiter(',');
+        app->add_option("-c, --count", count,
+                        "number of requests to send (1000)");
+        app->add_option("-w, --window", window,
+                        "maximum number of outstanding requests (1)");
+        app->add_option("-r, --rate", rate,
+                        "requests sent per second, as fast as the responses "
+                        "allow if 0 (0)");
+        app->add_option("-i, --sensor_id", sensorId,
+                        "sensor ID of GetSensorReading (1)");
+        app->add_option("--record_handle", recordHandle,
+                        "record handle of GetPDR (0)");
+#ifdef OEM_IBM
+        app->add_option("--file_handle", fileHandle,
+                        "file handle of ReadFile (0)");
+        app->add_option("--length", length,
+                        "bytes read by each ReadFile (128)");
+#endif
+    }
+
+    std::pair<int, std::vector<uint8_t>> createRequestMsg() override
+    {
+        return {PLDM_ERROR, {}};
+    }
+
+    void parseResponseMsg(pldm_msg*, size_t) override {}
+
+    bool singleRequest() const override
+    {
+        return false;
+    }
+
+    void exec() override
+    {
+        std::vector<Request> schedule;
+        for (const auto& entry : mix)
+        {
+            auto separator = entry.find(':');
+            auto it = requests.find(entry.substr(0, separator));
+            size_t weight = 1;
+            try
+            {
+                if (separator != std::string::npos)
+                {
+                    weight = std::stoul(entry.substr(separator + 1));
+                }
+            }
+            catch (const std::exception&)
+            {
+                weight = 0;
+            }
+            if (it == requests.end() || !weight)
+            {
+                std::cerr << "Invalid command in the mix: " << entry << "\n";
+                return;
+            }
+            schedule.insert(schedule.end(), weight, it->second);
+        }
+        if (schedule.empty())
+        {
+            schedule.push_back(Request::getTID);
+        }
+
+        std::map<Request, Result> results;
+        std::vector<std::chrono::steady_clock::time_point> sent(count);
+        std::vector<uint64_t> latencies;
+        latencies.reserve(count);
+        uint64_t failed = 0;
+        uint64_t errors = 0;
+        std::chrono::microseconds interval{};
+        if (rate)
+        {
+            interval = std::chrono::microseconds(1000000 / rate);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        sendRecvPipelined(
+            count, window,
+            [&](size_t index, uint8_t instanceId) {
+                auto requestMsg =
+                    encode(schedule[index % schedule.size()], instanceId);
+                sent[index] = std::chrono::steady_clock::now();
+                return requestMsg;
+            },
+            [&](size_t index, pldm_msg* response, size_t payloadLength) {
+                auto& result = results[schedule[index % schedule.size()]];
+                result.requests++;
+                if (!response)
+                {
+                    result.failed++;
+                    failed++;
+                    return;
+                }
+                auto latency =
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - sent[index])
+                        .count();
+                latencies.push_back(latency);
+                result.latencies.push_back(latency);
+                if (!payloadLength || response->payload[0] != PLDM_SUCCESS)
+                {
+                    result.errors++;
+                    errors++;
+                }
+            },
+            interval);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+
+        ordered_json data;
+        data["Requests"] = count;
+        data["Window"] = window;
+        data["Rate"] = rate;
+        data["ElapsedUs"] = elapsed.count();
+        data["Throughput"] =
+            elapsed.count() ? latencies.size() * 1000000.0 / elapsed.count()
+                            : 0.0;
+        data["Failed"] = failed;
+        data["Errors"] = errors;
+        data["LatencyUs"] = summarizeLatencies(latencies);
+        for (const auto& [command, request] : requests)
+        {
+            auto it = results.find(request);
+            if (it == results.end())
+            {
+                continue;
+            }
+            ordered_json entry;
+            entry["Requests"] = it->second.requests;
+            entry["Failed"] = it->second.failed;
+            entry["Errors"] = it->second.errors;
+            entry["LatencyUs"] = summarizeLatencies(it->second.latencies);
+            data["Commands"][command] = std::move(entry);
+        }
+        DisplayInJson(data);
+    }
+
+  private:
+    /** @struct Result
+     *  Outcome of the requests of a command: requests without response,
+     *  responses with an error completion code and response latencies
+     */
+    struct Result
+    {
+        uint64_t requests = 0;
+        uint64_t failed = 0;
+        uint64_t errors = 0;
+        std::vector<uint64_t> latencies;
+    };
+
+    /** @brief Encode a request of the benchmark
+     *
+     *  @return the request message, empty on failure
+     */
+    std::vector<uint8_t> encode(Request request, uint8_t instanceId)
+    {
+        int rc = PLDM_ERROR;
+        std::vector<uint8_t> requestMsg;
+        switch (request)
+        {
+            case Request::getTID:
+                requestMsg.resize(sizeof(pldm_msg_hdr));
+                rc = encode_get_tid_req(instanceId,
+                                        new (requestMsg.data()) pldm_msg);
+                break;
+            case Request::getSensorReading:
+                requestMsg.resize(sizeof(pldm_msg_hdr) +
+                                  PLDM_GET_SENSOR_READING_REQ_BYTES);
+                rc = encode_get_sensor_reading_req(
+                    instanceId, sensorId, false,
+                    new (requestMsg.data()) pldm_msg);
+                break;
+            case Request::getPDR:
+                requestMsg.resize(sizeof(pldm_msg_hdr) +
+                                  PLDM_GET_PDR_REQ_BYTES);
+                rc = encode_get_pdr_req(instanceId, recordHandle, 0,
+                                        PLDM_GET_FIRSTPART, UINT16_MAX, 0,
+                                        new (requestMsg.data()) pldm_msg,
+                                        PLDM_GET_PDR_REQ_BYTES);
+                break;
+#ifdef OEM_IBM
+            case Request::readFile:
+                requestMsg.resize(sizeof(pldm_msg_hdr) +
+                                  PLDM_READ_FILE_REQ_BYTES);
+                rc = encode_read_file_req(instanceId, fileHandle, 0, length,
+                                          new (requestMsg.data()) pldm_msg);
+                break;
+#endif
+        }
+        if (rc != PLDM_SUCCESS)
+        {
+            return {};
+        }
+        return requestMsg;
+    }
+
+    std::vector<std::string> mix;
+    size_t count = 1000;
+    size_t window = 1;
+    size_t rate = 0;
+    uint16_t sensorId = 1;
+    uint32_t recordHandle = 0;
+#ifdef OEM_IBM
+    uint32_t fileHandle = 0;
+    uint32_t length = 128;
+#endif
+};
+
+void registerCommand(CLI::App& app)
+{
+    commands.clear();
+
+    auto bench = app.add_subcommand(
+        "bench", "measure the latency and throughput of PLDM requests to "
+                 "an endpoint");
+    commands.push_back(std::make_unique<Bench>("bench", "bench", bench));
+}
+
+} // namespace bench
+
+} // namespace pldmtool
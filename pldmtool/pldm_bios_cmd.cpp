@@ -7,6 +7,12 @@
 #include <libpldm/bios_table.h>
 #include <libpldm/utils.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <map>
 #include <optional>
 
@@ -22,9 +28,15 @@ namespace
 using namespace pldmtool::helper;
 using namespace pldm::bios::utils;
 using namespace pldm::utils;
+namespace fs = std::filesystem;
 
 std::vector<std::unique_ptr<CommandInterface>> commands;
 
+/** @brief Directory of the BIOS tables cached by pldmtool, with a
+ *         subdirectory per endpoint
+ */
+constexpr auto biosTableCacheDir = "/var/cache/pldmtool/bios";
+
 const std::map<const char*, pldm_bios_table_types> pldmBIOSTableTypes{
     {"StringTable", PLDM_BIOS_STRING_TABLE},
     {"AttributeTable", PLDM_BIOS_ATTR_TABLE},
@@ -193,49 +205,179 @@ class GetBIOSTableHandler : public CommandInterface
 
     void parseResponseMsg(pldm_msg*, size_t) override {}
 
+    bool singleRequest() const override
+    {
+        return false;
+    }
+
+    /** @brief Get a BIOS table, from the cache of pldmtool if its tag
+     *         still matches the tag of the endpoint
+     *
+     *  The endpoints without GetBIOSTableTags always send the table.
+     */
     std::optional<Table> getBIOSTable(pldm_bios_table_types tableType)
     {
-        std::vector<uint8_t> requestMsg(
-            sizeof(pldm_msg_hdr) + PLDM_GET_BIOS_TABLE_REQ_BYTES);
-        auto request = new (requestMsg.data()) pldm_msg;
+        auto tag = getBIOSTableTag(tableType);
+        auto path = fs::path(biosTableCacheDir) /
+                    std::to_string(getMCTPEID()) / std::to_string(tableType);
+        if (tag)
+        {
+            std::ifstream file(path, std::ios::binary);
+            Table cached((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+            if (getTableTag(cached) == tag &&
+                pldm_bios_table_checksum(cached.data(), cached.size()))
+            {
+                return cached;
+            }
+        }
 
-        auto rc = encode_get_bios_table_req(instanceId, 0, PLDM_GET_FIRSTPART,
-                                            tableType, request);
-        if (rc != PLDM_SUCCESS)
+        auto table = fetchBIOSTable(tableType);
+        // The table may have changed since its tag was read
+        if (table && tag && getTableTag(*table) == tag)
         {
-            std::cerr << "Encode GetBIOSTable Error, tableType=," << tableType
-                      << " ,rc=" << rc << std::endl;
-            return std::nullopt;
+            std::error_code ec;
+            fs::create_directories(path.parent_path(), ec);
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(table->data()),
+                       table->size());
+            if (!file)
+            {
+                file.close();
+                fs::remove(path, ec);
+            }
         }
-        std::vector<uint8_t> responseMsg;
-        rc = pldmSendRecv(requestMsg, responseMsg);
-        if (rc != PLDM_SUCCESS)
+        return table;
+    }
+
+    /** @brief Get the tag of a BIOS table of the endpoint
+     *
+     *  The tags of all the tables are read with a single GetBIOSTableTags
+     *  request, once per endpoint.
+     *
+     *  @return the tag, std::nullopt if the endpoint did not send it
+     */
+    std::optional<uint32_t> getBIOSTableTag(pldm_bios_table_types tableType)
+    {
+        auto [it, inserted] = tableTags.try_emplace(getMCTPEID());
+        if (inserted)
+        {
+            constexpr std::array<uint8_t, 3> tableTypes{
+                PLDM_BIOS_STRING_TABLE, PLDM_BIOS_ATTR_TABLE,
+                PLDM_BIOS_ATTR_VAL_TABLE};
+            std::vector<uint8_t> requestMsg(sizeof(pldm_msg_hdr) + 1 +
+                                            tableTypes.size());
+            auto request = new (requestMsg.data()) pldm_msg;
+            pldm_header_info header{};
+            header.msg_type = PLDM_REQUEST;
+            header.instance = instanceId;
+            header.pldm_type = PLDM_BIOS;
+            header.command = getBIOSTableTagsCommand;
+            if (pack_pldm_header(&header, &request->hdr) != PLDM_SUCCESS)
+            {
+                return std::nullopt;
+            }
+            request->payload[0] = tableTypes.size();
+            std::ranges::copy(tableTypes, request->payload + 1);
+
+            std::vector<uint8_t> responseMsg;
+            if (pldmSendRecv(requestMsg, responseMsg) != PLDM_SUCCESS ||
+                responseMsg.size() != sizeof(pldm_msg_hdr) + 1 +
+                                          tableTypes.size() * sizeof(uint32_t))
+            {
+                return std::nullopt;
+            }
+            auto response = reinterpret_cast<pldm_msg*>(responseMsg.data());
+            if (response->payload[0] != PLDM_SUCCESS)
+            {
+                return std::nullopt;
+            }
+            std::array<uint32_t, tableTypes.size()> tags{};
+            for (size_t i = 0; i < tags.size(); i++)
+            {
+                std::memcpy(&tags[i],
+                            response->payload + 1 + i * sizeof(uint32_t),
+                            sizeof(uint32_t));
+                tags[i] = le32toh(tags[i]);
+            }
+            it->second = tags;
+        }
+        if (!it->second || tableType > PLDM_BIOS_ATTR_VAL_TABLE)
         {
-            std::cerr << "PLDM: Communication Error, rc =" << rc << std::endl;
             return std::nullopt;
         }
+        return (*it->second)[tableType];
+    }
 
-        uint8_t cc = 0, transferFlag = 0;
-        uint32_t nextTransferHandle = 0;
-        size_t bios_table_offset;
-        auto responsePtr = new (responseMsg.data()) pldm_msg;
-        auto payloadLength = responseMsg.size() - sizeof(pldm_msg_hdr);
-
-        rc = decode_get_bios_table_resp(responsePtr, payloadLength, &cc,
-                                        &nextTransferHandle, &transferFlag,
-                                        &bios_table_offset);
+    /** @brief Read a BIOS table of the endpoint with GetBIOSTable */
+    std::optional<Table> fetchBIOSTable(pldm_bios_table_types tableType)
+    {
+        Table table;
+        uint32_t transferHandle = 0;
+        uint8_t transferOpFlag = PLDM_GET_FIRSTPART;
 
-        if (rc != PLDM_SUCCESS || cc != PLDM_SUCCESS)
+        while (true)
         {
-            std::cerr << "GetBIOSTable Response Error: tableType=" << tableType
-                      << ", rc=" << rc << ", cc=" << (int)cc << std::endl;
-            return std::nullopt;
+            std::vector<uint8_t> requestMsg(
+                sizeof(pldm_msg_hdr) + PLDM_GET_BIOS_TABLE_REQ_BYTES);
+            auto request = new (requestMsg.data()) pldm_msg;
+
+            auto rc = encode_get_bios_table_req(
+                instanceId, transferHandle, transferOpFlag, tableType, request);
+            if (rc != PLDM_SUCCESS)
+            {
+                std::cerr << "Encode GetBIOSTable Error, tableType=,"
+                          << tableType << " ,rc=" << rc << std::endl;
+                return std::nullopt;
+            }
+            std::vector<uint8_t> responseMsg;
+            rc = pldmSendRecv(requestMsg, responseMsg);
+            if (rc != PLDM_SUCCESS)
+            {
+                std::cerr << "PLDM: Communication Error, rc =" << rc
+                          << std::endl;
+                return std::nullopt;
+            }
+
+            uint8_t cc = 0, transferFlag = 0;
+            uint32_t nextTransferHandle = 0;
+            size_t bios_table_offset;
+            auto responsePtr = new (responseMsg.data()) pldm_msg;
+            auto payloadLength = responseMsg.size() - sizeof(pldm_msg_hdr);
+
+            rc = decode_get_bios_table_resp(responsePtr, payloadLength, &cc,
+                                            &nextTransferHandle, &transferFlag,
+                                            &bios_table_offset);
+
+            if (rc != PLDM_SUCCESS || cc != PLDM_SUCCESS)
+            {
+                std::cerr << "GetBIOSTable Response Error: tableType="
+                          << tableType << ", rc=" << rc
+                          << ", cc=" << (int)cc << std::endl;
+                return std::nullopt;
+            }
+            auto tableData = reinterpret_cast<char*>(
+                (responsePtr->payload) + bios_table_offset);
+            auto tableSize = payloadLength - sizeof(nextTransferHandle) -
+                             sizeof(transferFlag) - sizeof(cc);
+            table.insert(table.end(), tableData, tableData + tableSize);
+
+            if (transferFlag == PLDM_START_AND_END || transferFlag == PLDM_END)
+            {
+                break;
+            }
+            if (!nextTransferHandle)
+            {
+                std::cerr << "GetBIOSTable Response Error: tableType="
+                          << tableType << ", no next transfer handle"
+                          << std::endl;
+                return std::nullopt;
+            }
+            transferHandle = nextTransferHandle;
+            transferOpFlag = PLDM_GET_NEXTPART;
         }
-        auto tableData =
-            reinterpret_cast<char*>((responsePtr->payload) + bios_table_offset);
-        auto tableSize = payloadLength - sizeof(nextTransferHandle) -
-                         sizeof(transferFlag) - sizeof(cc);
-        return std::make_optional<Table>(tableData, tableData + tableSize);
+
+        return table;
     }
 
     const pldm_bios_attr_table_entry* findAttrEntryByName(
@@ -440,6 +582,12 @@ class GetBIOSTableHandler : public CommandInterface
             }
         }
     }
+
+  private:
+    /** @brief Tags of the BIOS tables of each endpoint, std::nullopt if the
+     *         endpoint did not send them
+     */
+    std::map<uint8_t, std::optional<std::array<uint32_t, 3>>> tableTags;
 };
 
 class GetBIOSTable : public GetBIOSTableHandler
@@ -952,6 +1100,8 @@ class SetBIOSAttributeCurrentValue : public GetBIOSTableHandler
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto bios = app.add_subcommand("bios", "bios type command");
     bios->require_subcommand(1);
     auto getDateTime = bios->add_subcommand("GetDateTime", "get date time");
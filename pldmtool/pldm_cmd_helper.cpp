@@ -12,7 +12,12 @@
 #include <sdbusplus/server.hpp>
 #include <xyz/openbmc_project/Logging/Entry/server.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <exception>
+#include <map>
+#include <sstream>
 
 using namespace pldm::utils;
 
@@ -21,6 +26,258 @@ namespace pldmtool
 namespace helper
 {
 
+namespace
+{
+
+/** @brief Transport of the process, kept open for the next commands of a
+ *         batch
+ */
+PldmTransport& getTransport()
+{
+    static PldmTransport pldmTransport{};
+    return pldmTransport;
+}
+
+} // namespace
+
+pldm::InstanceIdDb& CommandInterface::getInstanceIdDb()
+{
+    static pldm::InstanceIdDb instanceIdDb;
+    return instanceIdDb;
+}
+
+std::vector<CommandInterface*>& CommandInterface::registeredCommands()
+{
+    static std::vector<CommandInterface*> commands;
+    return commands;
+}
+
+CommandInterface* CommandInterface::find(const std::string& type,
+                                         const std::string& name)
+{
+    auto equal = [](const std::string& a, const std::string& b) {
+        return std::ranges::equal(a, b, [](char x, char y) {
+            return std::tolower(x) == std::tolower(y);
+        });
+    };
+    auto it = std::ranges::find_if(registeredCommands(), [&](auto command) {
+        return command->pldmType == type && equal(command->commandName, name);
+    });
+    return it == registeredCommands().end() ? nullptr : *it;
+}
+
+ordered_json summarizeLatencies(std::vector<uint64_t> latencies)
+{
+    ordered_json data;
+    if (latencies.empty())
+    {
+        return data;
+    }
+    std::ranges::sort(latencies);
+    auto percentile = [&latencies](double p) {
+        auto rank = static_cast<size_t>(p * latencies.size());
+        return latencies[std::min(rank, latencies.size() - 1)];
+    };
+    data["min"] = latencies.front();
+    data["p50"] = percentile(0.5);
+    data["p99"] = percentile(0.99);
+    data["p999"] = percentile(0.999);
+    data["max"] = latencies.back();
+    return data;
+}
+
+void CommandInterface::run()
+{
+    if (mctpEids.size() <= 1)
+    {
+        if (!mctpEids.empty())
+        {
+            mctp_eid = mctpEids.front();
+        }
+        exec();
+        return;
+    }
+
+    if (singleRequest())
+    {
+        fanOut();
+        return;
+    }
+    for (auto eid : mctpEids)
+    {
+        mctp_eid = eid;
+        exec();
+    }
+}
+
+void CommandInterface::fanOut()
+{
+    sendRecvEndpoints(
+        mctpEids,
+        [this](uint8_t eid, uint8_t id) -> std::vector<uint8_t> {
+            mctp_eid = eid;
+            instanceId = id;
+            auto [rc, requestMsg] = createRequestMsg();
+            if (rc != PLDM_SUCCESS)
+            {
+                std::cerr << "Failed to encode request message for "
+                          << pldmType << ":" << commandName << " rc = " << rc
+                          << "\n";
+                return {};
+            }
+            return requestMsg;
+        },
+        [this](uint8_t eid, pldm_msg* response, size_t payloadLength) {
+            if (!response)
+            {
+                return;
+            }
+
+            // Tag the output of the command with the endpoint it came from
+            mctp_eid = eid;
+            instanceId = response->hdr.instance_id;
+            std::ostringstream output;
+            auto coutBuf = std::cout.rdbuf(output.rdbuf());
+            parseResponseMsg(response, payloadLength);
+            std::cout.rdbuf(coutBuf);
+
+            auto parsed = ordered_json::parse(output.str(), nullptr, false);
+            ordered_json data;
+            data["mctp_eid"] = eid;
+            if (parsed.is_discarded())
+            {
+                data["output"] = output.str();
+            }
+            else
+            {
+                data["response"] = std::move(parsed);
+            }
+            DisplayInJson(data);
+        });
+}
+
+void CommandInterface::sendRecvEndpoints(const std::vector<uint8_t>& eids,
+                                         const EncodeEndpointRequest& encode,
+                                         const HandleEndpointResponse& handle)
+{
+    struct Target
+    {
+        uint8_t eid;
+        uint8_t instanceId;
+        pldm_msg_hdr hdr;
+        bool done;
+    };
+    std::vector<Target> targets;
+    auto& pldmTransport = getTransport();
+
+    for (auto eid : eids)
+    {
+        uint8_t id{};
+        try
+        {
+            id = instanceIdDb.next(eid);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to get an instance ID for EID "
+                      << unsigned(eid) << ": " << e.what() << "\n";
+            handle(eid, nullptr, 0);
+            continue;
+        }
+        auto requestMsg = encode(eid, id);
+        if (requestMsg.size() < sizeof(pldm_msg_hdr))
+        {
+            instanceIdDb.free(eid, id);
+            handle(eid, nullptr, 0);
+            continue;
+        }
+        if (pldmVerbose)
+        {
+            std::cout << "pldmtool: EID " << unsigned(eid) << " ";
+            printBuffer(Tx, requestMsg);
+        }
+        if (pldmTransport.sendMsg(eid, requestMsg.data(), requestMsg.size()))
+        {
+            instanceIdDb.free(eid, id);
+            std::cerr << "Failed to send the request to EID " << unsigned(eid)
+                      << "\n";
+            handle(eid, nullptr, 0);
+            continue;
+        }
+        targets.emplace_back(
+            eid, id, *reinterpret_cast<const pldm_msg_hdr*>(requestMsg.data()),
+            false);
+    }
+    if (pldmTransport.flush())
+    {
+        std::cerr << "Failed to send some of the requests\n";
+    }
+
+    // The endpoints answer concurrently, all within the response timeout
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(RESPONSE_TIME_OUT);
+    auto pending = targets.size();
+    pollfd pfd{pldmTransport.getEventSource(), POLLIN, 0};
+    while (pending)
+    {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0)
+        {
+            break;
+        }
+        int ret = poll(&pfd, 1, remaining.count());
+        if (ret < 0 && errno != EINTR)
+        {
+            break;
+        }
+
+        pldm_tid_t tid{};
+        void* msg = nullptr;
+        size_t len = 0;
+        while (pending &&
+               pldmTransport.recvMsg(tid, msg, len) == PLDM_REQUESTER_SUCCESS)
+        {
+            auto rspHdr = static_cast<const pldm_msg_hdr*>(msg);
+            auto it = std::ranges::find_if(targets, [&](const auto& target) {
+                return !target.done && target.eid == tid && !rspHdr->request &&
+                       rspHdr->instance_id == target.hdr.instance_id &&
+                       rspHdr->type == target.hdr.type &&
+                       rspHdr->command == target.hdr.command;
+            });
+            if (it == targets.end())
+            {
+                free(msg);
+                continue;
+            }
+            it->done = true;
+            pending--;
+
+            std::vector<uint8_t> responseMsg(static_cast<uint8_t*>(msg),
+                                             static_cast<uint8_t*>(msg) + len);
+            free(msg);
+            if (pldmVerbose)
+            {
+                std::cout << "pldmtool: EID " << unsigned(tid) << " ";
+                printBuffer(Rx, responseMsg);
+            }
+            handle(tid, reinterpret_cast<pldm_msg*>(responseMsg.data()),
+                   responseMsg.size() - sizeof(pldm_msg_hdr));
+        }
+    }
+
+    for (const auto& target : targets)
+    {
+        if (!target.done)
+        {
+            std::cerr << "No response from EID " << unsigned(target.eid)
+                      << "\n";
+            handle(target.eid, nullptr, 0);
+        }
+        instanceIdDb.free(target.eid, target.instanceId);
+    }
+}
+
 void CommandInterface::exec()
 {
     instanceId = instanceIdDb.next(mctp_eid);
@@ -48,6 +305,190 @@ void CommandInterface::exec()
     instanceIdDb.free(mctp_eid, instanceId);
 }
 
+void CommandInterface::sendRecvPipelined(size_t count, size_t window,
+                                         const EncodeRequest& encode,
+                                         const HandleResponse& handle,
+                                         std::chrono::microseconds interval)
+{
+    struct Outstanding
+    {
+        size_t index;
+        pldm_msg_hdr hdr;
+        std::chrono::steady_clock::time_point deadline;
+        std::chrono::steady_clock::time_point expiry;
+    };
+    std::map<uint8_t, Outstanding> outstanding;
+    // The instance IDs of the requests timed out, with their expiry, a late
+    // response must not match a newer request using the same ID
+    std::map<uint8_t, std::chrono::steady_clock::time_point> expiring;
+    auto& pldmTransport = getTransport();
+    pollfd pfd{pldmTransport.getEventSource(), POLLIN, 0};
+    auto timeout = std::chrono::milliseconds(RESPONSE_TIME_OUT);
+    auto idExpiry = std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL);
+    auto eid = mctp_eid;
+    size_t next = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto dueAt = [&](size_t index) { return start + index * interval; };
+
+    auto complete = [&](auto it, pldm_msg* response, size_t payloadLength) {
+        auto index = it->second.index;
+        instanceIdDb.free(eid, it->first);
+        outstanding.erase(it);
+        handle(index, response, payloadLength);
+    };
+
+    while (next < count || !outstanding.empty() || !expiring.empty())
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::erase_if(expiring, [&](const auto& entry) {
+            if (entry.second > now)
+            {
+                return false;
+            }
+            instanceIdDb.free(eid, entry.first);
+            return true;
+        });
+
+        bool waitForId = false;
+        while (next < count &&
+               outstanding.size() < std::max<size_t>(window, 1) &&
+               dueAt(next) <= std::chrono::steady_clock::now())
+        {
+            uint8_t id{};
+            try
+            {
+                id = instanceIdDb.next(eid);
+            }
+            catch (const std::exception& e)
+            {
+                if (!outstanding.empty() || !expiring.empty())
+                {
+                    // Wait for a response or an expiry to free an ID
+                    waitForId = true;
+                    break;
+                }
+                std::cerr << "Failed to get an instance ID: " << e.what()
+                          << "\n";
+                handle(next++, nullptr, 0);
+                continue;
+            }
+
+            auto index = next++;
+            auto requestMsg = encode(index, id);
+            if (requestMsg.size() < sizeof(pldm_msg_hdr))
+            {
+                instanceIdDb.free(eid, id);
+                handle(index, nullptr, 0);
+                continue;
+            }
+            if (pldmVerbose)
+            {
+                std::cout << "pldmtool: ";
+                printBuffer(Tx, requestMsg);
+            }
+            if (pldmTransport.sendMsg(eid, requestMsg.data(),
+                                      requestMsg.size()))
+            {
+                instanceIdDb.free(eid, id);
+                handle(index, nullptr, 0);
+                continue;
+            }
+            auto sentAt = std::chrono::steady_clock::now();
+            outstanding.emplace(
+                id, Outstanding{index,
+                                *reinterpret_cast<const pldm_msg_hdr*>(
+                                    requestMsg.data()),
+                                sentAt + timeout, sentAt + idExpiry});
+        }
+        if (pldmTransport.flush())
+        {
+            std::cerr << "Failed to send some of the requests\n";
+        }
+
+        now = std::chrono::steady_clock::now();
+        for (auto it = outstanding.begin(); it != outstanding.end();)
+        {
+            auto current = it++;
+            if (current->second.deadline <= now)
+            {
+                auto index = current->second.index;
+                std::cerr << "No response to request " << index << "\n";
+                expiring.emplace(current->first, current->second.expiry);
+                outstanding.erase(current);
+                handle(index, nullptr, 0);
+            }
+        }
+
+        // Wake up for the earliest deadline, or to send the next request
+        auto wakeUp = std::chrono::steady_clock::time_point::max();
+        if (next < count && !waitForId &&
+            outstanding.size() < std::max<size_t>(window, 1))
+        {
+            wakeUp = dueAt(next);
+        }
+        if (!outstanding.empty())
+        {
+            auto earliest = std::ranges::min_element(
+                outstanding, {},
+                [](const auto& entry) { return entry.second.deadline; });
+            wakeUp = std::min(wakeUp, earliest->second.deadline);
+        }
+        if (!expiring.empty())
+        {
+            auto earliest = std::ranges::min_element(
+                expiring, {}, [](const auto& entry) { return entry.second; });
+            wakeUp = std::min(wakeUp, earliest->second);
+        }
+        if (wakeUp == std::chrono::steady_clock::time_point::max())
+        {
+            continue;
+        }
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+            std::max(wakeUp - now, std::chrono::steady_clock::duration{}));
+        int ret = poll(&pfd, 1, remaining.count());
+        if (ret < 0 && errno != EINTR)
+        {
+            std::cerr << "Failed to poll the transport, errno = " << errno
+                      << "\n";
+            while (!outstanding.empty())
+            {
+                complete(outstanding.begin(), nullptr, 0);
+            }
+            for (const auto& [id, expiry] : expiring)
+            {
+                instanceIdDb.free(eid, id);
+            }
+            return;
+        }
+
+        pldm_tid_t tid{};
+        void* msg = nullptr;
+        size_t len = 0;
+        while (pldmTransport.recvMsg(tid, msg, len) == PLDM_REQUESTER_SUCCESS)
+        {
+            std::vector<uint8_t> responseMsg(static_cast<uint8_t*>(msg),
+                                             static_cast<uint8_t*>(msg) + len);
+            free(msg);
+
+            auto rspHdr = reinterpret_cast<pldm_msg_hdr*>(responseMsg.data());
+            auto it = outstanding.find(rspHdr->instance_id);
+            if (tid != eid || rspHdr->request || it == outstanding.end() ||
+                rspHdr->type != it->second.hdr.type ||
+                rspHdr->command != it->second.hdr.command)
+            {
+                continue;
+            }
+            if (pldmVerbose)
+            {
+                std::cout << "pldmtool: ";
+                printBuffer(Rx, responseMsg);
+            }
+            complete(it, reinterpret_cast<pldm_msg*>(responseMsg.data()),
+                     responseMsg.size() - sizeof(pldm_msg_hdr));
+        }
+    }
+}
+
 int CommandInterface::pldmSendRecv(std::vector<uint8_t>& requestMsg,
                                    std::vector<uint8_t>& responseMsg)
 {
@@ -64,7 +505,7 @@ int CommandInterface::pldmSendRecv(std::vector<uint8_t>& requestMsg,
     }
 
     auto tid = mctp_eid;
-    PldmTransport pldmTransport{};
+    auto& pldmTransport = getTransport();
     uint8_t retry = 0;
     int rc = PLDM_ERROR;
 
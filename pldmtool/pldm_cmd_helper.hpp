@@ -15,10 +15,14 @@
 #include <CLI/CLI.hpp>
 #include <nlohmann/json.hpp>
 
+#include <chrono>
 #include <cstring>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace pldmtool
 {
@@ -29,6 +33,9 @@ namespace helper
 constexpr uint8_t PLDM_ENTITY_ID = 8;
 using ordered_json = nlohmann::ordered_json;
 
+/** @brief Print each JSON output on a single line, set in batch mode */
+inline bool jsonLines = false;
+
 /** @brief print the input message if pldmverbose is enabled
  *
  *  @param[in]  pldmVerbose - verbosity flag - true/false
@@ -57,9 +64,18 @@ void Logger(bool pldmverbose, const char* msg, const T& data)
  */
 static inline void DisplayInJson(const ordered_json& data)
 {
-    std::cout << data.dump(4) << std::endl;
+    std::cout << data.dump(jsonLines ? -1 : 4) << std::endl;
 }
 
+/** @brief Summarize latencies with their percentiles
+ *
+ *  @param[in] latencies - latencies, in microseconds
+ *
+ *  @return min, p50, p99, p999 and max of the latencies, empty if there is
+ *          none
+ */
+ordered_json summarizeLatencies(std::vector<uint64_t> latencies);
+
 /** @brief MCTP socket read/receive
  *
  *  @param[in]  requestMsg - Request message to compare against loopback
@@ -81,14 +97,32 @@ class CommandInterface
         pldmType(type), commandName(name), mctp_eid(PLDM_ENTITY_ID),
         pldmVerbose(false), instanceId(0)
     {
-        app->add_option("-m,--mctp_eid", mctp_eid, "MCTP endpoint ID");
+        app->add_option("-m,--mctp_eid", mctpEids,
+                        "MCTP endpoint ID, or comma separated IDs to send "
+                        "the command to several endpoints at once")
+            ->delimiter(',');
         app->add_flag("-v, --verbose", pldmVerbose);
         app->add_option("-n, --retry-count", numRetries,
                         "Number of retry when PLDM request message is failed");
-        app->callback([&]() { exec(); });
+        app->callback([&]() { run(); });
+        registeredCommands().push_back(this);
     }
 
-    virtual ~CommandInterface() = default;
+    virtual ~CommandInterface()
+    {
+        std::erase(registeredCommands(), this);
+    }
+
+    /** @brief Find a registered command
+     *
+     *  @param[in] type - PLDM type of the command, as given on the command
+     *                    line
+     *  @param[in] name - name of the command, compared case insensitively
+     *
+     *  @return the command, nullptr if none is registered with that name
+     */
+    static CommandInterface* find(const std::string& type,
+                                  const std::string& name);
 
     virtual std::pair<int, std::vector<uint8_t>> createRequestMsg() = 0;
 
@@ -97,9 +131,98 @@ class CommandInterface
 
     virtual void exec();
 
+    /** @brief Run the command on each of the requested endpoints
+     *
+     *  A command made of a single request is sent to all the endpoints at
+     *  once and their responses are parsed as they arrive, within the
+     *  response timeout. Other commands run on one endpoint after the other.
+     */
+    virtual void run();
+
+    /** @brief Check if the command is a single request and its response
+     *
+     *  @return false if the command overrides exec() to send several
+     *          requests
+     */
+    virtual bool singleRequest() const
+    {
+        return true;
+    }
+
     int pldmSendRecv(std::vector<uint8_t>& requestMsg,
                      std::vector<uint8_t>& responseMsg);
 
+    /** @brief Encode a request of sendRecvPipelined
+     *
+     *  @param[in] index - index of the request
+     *  @param[in] instanceId - instance ID of the request
+     *
+     *  @return the request message, empty on failure
+     */
+    using EncodeRequest =
+        std::function<std::vector<uint8_t>(size_t index, uint8_t instanceId)>;
+
+    /** @brief Handle a response of sendRecvPipelined
+     *
+     *  @param[in] index - index of the request
+     *  @param[in] response - the response, nullptr if the request failed or
+     *                        timed out
+     *  @param[in] payloadLength - payload length of the response
+     */
+    using HandleResponse = std::function<void(
+        size_t index, pldm_msg* response, size_t payloadLength)>;
+
+    /** @brief Send requests to the endpoint, keeping up to window of them
+     *         outstanding, each with its own instance ID
+     *
+     *  The responses are handled as they arrive, the requests without
+     *  response within the response timeout are handled as failed. Their
+     *  instance ID stays reserved until it expires, a late response is
+     *  dropped rather than matched to a newer request.
+     *
+     *  @param[in] count - number of requests
+     *  @param[in] window - maximum number of outstanding requests
+     *  @param[in] encode - encodes the requests
+     *  @param[in] handle - handles the responses
+     *  @param[in] interval - minimum time between the start of two requests,
+     *                        sends the requests at a fixed rate if not 0
+     */
+    void sendRecvPipelined(size_t count, size_t window,
+                           const EncodeRequest& encode,
+                           const HandleResponse& handle,
+                           std::chrono::microseconds interval = {});
+
+    /** @brief Encode the request of an endpoint of sendRecvEndpoints
+     *
+     *  @param[in] eid - MCTP endpoint ID
+     *  @param[in] instanceId - instance ID of the request
+     *
+     *  @return the request message, empty on failure
+     */
+    using EncodeEndpointRequest =
+        std::function<std::vector<uint8_t>(uint8_t eid, uint8_t instanceId)>;
+
+    /** @brief Handle the response of an endpoint of sendRecvEndpoints
+     *
+     *  @param[in] eid - MCTP endpoint ID
+     *  @param[in] response - the response, nullptr if the request failed or
+     *                        timed out
+     *  @param[in] payloadLength - payload length of the response
+     */
+    using HandleEndpointResponse = std::function<void(
+        uint8_t eid, pldm_msg* response, size_t payloadLength)>;
+
+    /** @brief Send a request to each endpoint at once and handle the
+     *         responses as they arrive, within the response timeout
+     *
+     *  @param[in] eids - MCTP endpoint IDs
+     *  @param[in] encode - encodes the requests
+     *  @param[in] handle - handles the responses
+     */
+    void sendRecvEndpoints(const std::vector<uint8_t>& eids,
+                           const EncodeEndpointRequest& encode,
+                           const HandleEndpointResponse& handle);
+
     /**
      * @brief get MCTP endpoint ID
      *
@@ -110,6 +233,16 @@ class CommandInterface
         return mctp_eid;
     }
 
+    /**
+     * @brief get the MCTP endpoint IDs given on the command line
+     *
+     * @return the endpoint IDs, the default one if none was given
+     */
+    inline std::vector<uint8_t> getMCTPEIDs()
+    {
+        return mctpEids.empty() ? std::vector<uint8_t>{mctp_eid} : mctpEids;
+    }
+
     /**
      * @brief get PLDM type
      *
@@ -131,14 +264,28 @@ class CommandInterface
     }
 
   private:
+    /** @brief Send the request of the command to all the endpoints at once
+     *         and parse each response as it arrives
+     */
+    void fanOut();
+
     const std::string pldmType;
     const std::string commandName;
     uint8_t mctp_eid;
+    std::vector<uint8_t> mctpEids;
     bool pldmVerbose;
 
+    /** @brief Commands constructed and not destroyed yet */
+    static std::vector<CommandInterface*>& registeredCommands();
+
+    /** @brief Instance ID database shared by the commands of the process, so
+     *         that its lease of instance IDs lasts across the commands
+     */
+    static pldm::InstanceIdDb& getInstanceIdDb();
+
   protected:
     uint8_t instanceId;
-    pldm::InstanceIdDb instanceIdDb;
+    pldm::InstanceIdDb& instanceIdDb = getInstanceIdDb();
     uint8_t numRetries = 0;
 };
 
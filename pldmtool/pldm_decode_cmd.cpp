@@ -0,0 +1,202 @@
+#include "pldm_decode_cmd.hpp"
+
+#include "common/flight_recorder.hpp"
+#include "pldm_base_cmd.hpp"
+#include "pldm_cmd_helper.hpp"
+
+#include <libpldm/base.h>
+
+#include <format>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace pldmtool
+{
+
+namespace decode
+{
+
+namespace
+{
+
+using namespace pldmtool::helper;
+using namespace pldm::flightrecorder;
+
+/** @brief pldmtool type of the commands of each PLDM type */
+const std::map<uint8_t, std::string> commandTypes{
+    {PLDM_BASE, "base"},     {PLDM_PLATFORM, "platform"}, {PLDM_BIOS, "bios"},
+    {PLDM_FRU, "fru"},       {PLDM_FWUP, "fw_update"},
+#ifdef OEM_IBM
+    {PLDM_OEM, "oem_ibm"},
+#endif
+};
+
+std::string dumpFile;
+bool summaryOnly = false;
+
+std::string toHex(const std::vector<uint8_t>& data)
+{
+    std::string hex;
+    for (auto byte : data)
+    {
+        hex += std::format("{}{:02x}", hex.empty() ? "" : " ", byte);
+    }
+    return hex;
+}
+
+/** @brief Decode a response with the parser of its pldmtool command
+ *
+ *  @return the JSON printed by the parser, or its output as a string if
+ *          it is not JSON, null if no command parses the response
+ */
+ordered_json parseResponse(const std::string& type, const std::string& name,
+                           std::vector<uint8_t>& msg)
+{
+    auto command = CommandInterface::find(type, name);
+    if (!command)
+    {
+        return nullptr;
+    }
+
+    std::ostringstream output;
+    auto coutBuf = std::cout.rdbuf(output.rdbuf());
+    auto cerrBuf = std::cerr.rdbuf(output.rdbuf());
+    command->parseResponseMsg(reinterpret_cast<pldm_msg*>(msg.data()),
+                              msg.size() - sizeof(pldm_msg_hdr));
+    std::cout.rdbuf(coutBuf);
+    std::cerr.rdbuf(cerrBuf);
+
+    auto response = ordered_json::parse(output.str(), nullptr, false);
+    if (response.is_discarded())
+    {
+        return output.str();
+    }
+    return response;
+}
+
+/** @brief Decode the messages of a flight recorder dump, pairing each
+ *         response with its request
+ */
+void decodeDump()
+{
+    auto records = readDump(dumpFile);
+    if (!records)
+    {
+        std::cerr << "Failed to read the flight recorder dump " << dumpFile
+                  << "\n";
+        return;
+    }
+
+    // Requests waiting for their response, by TID, instance ID, type and
+    // command, with their timestamp
+    std::map<std::tuple<uint8_t, uint8_t, uint8_t, uint8_t>, uint64_t>
+        requests;
+    std::map<std::string, std::vector<uint64_t>> latencies;
+    ordered_json messages = ordered_json::array();
+    for (auto& [slot, payload] : *records)
+    {
+        if ((slot.flags & flightRecorderMarkFlag) ||
+            payload.size() < sizeof(pldm_msg_hdr))
+        {
+            continue;
+        }
+
+        auto hdr = reinterpret_cast<const pldm_msg_hdr*>(payload.data());
+        std::tuple key{slot.tid, hdr->instance_id, hdr->type, hdr->command};
+        auto type = commandTypes.contains(hdr->type)
+                        ? commandTypes.at(hdr->type)
+                        : std::to_string(hdr->type);
+        auto name = base::getCommandName(hdr->type, hdr->command);
+        if (name.empty())
+        {
+            name = std::to_string(hdr->command);
+        }
+
+        ordered_json message;
+        message["Sequence"] = slot.sequence;
+        message["TimestampNs"] = slot.timestamp;
+        message["TID"] = slot.tid;
+        message["Direction"] = (slot.flags & flightRecorderTx) ? "Tx" : "Rx";
+        message["Type"] = type;
+        message["Command"] = name;
+        message["InstanceId"] = hdr->instance_id;
+        if (hdr->request)
+        {
+            message["Request"] = true;
+            requests[key] = slot.timestamp;
+        }
+        else
+        {
+            message["Request"] = false;
+            auto it = requests.find(key);
+            if (it != requests.end())
+            {
+                auto latency = (slot.timestamp - it->second) / 1000;
+                message["LatencyUs"] = latency;
+                latencies[type + " " + name].push_back(latency);
+                requests.erase(it);
+            }
+        }
+
+        if (slot.length > payload.size())
+        {
+            message["Truncated"] = slot.length;
+        }
+        else if (!hdr->request)
+        {
+            auto response = parseResponse(type, name, payload);
+            if (!response.is_null())
+            {
+                message["Response"] = std::move(response);
+            }
+        }
+        if (!message.contains("Response"))
+        {
+            message["Data"] = toHex(payload);
+        }
+        if (!summaryOnly)
+        {
+            messages.emplace_back(std::move(message));
+        }
+    }
+
+    ordered_json summary;
+    for (auto& [command, values] : latencies)
+    {
+        ordered_json entry;
+        entry["Exchanges"] = values.size();
+        entry["LatencyUs"] = summarizeLatencies(std::move(values));
+        summary[command] = std::move(entry);
+    }
+
+    ordered_json data;
+    if (!summaryOnly)
+    {
+        data["Messages"] = std::move(messages);
+    }
+    data["Commands"] = std::move(summary);
+    data["Unanswered"] = requests.size();
+    DisplayInJson(data);
+}
+
+} // namespace
+
+void registerCommand(CLI::App& app)
+{
+    auto decode = app.add_subcommand(
+        "decode", "decode the messages of a pldmd flight recorder dump and "
+                  "the latency of each request");
+    decode->add_option("-f, --file", dumpFile,
+                       "flight recorder dump, as written by pldmd on SIGUSR1")
+        ->required();
+    decode->add_flag("-s, --summary", summaryOnly,
+                     "print the per-command latencies only");
+    decode->callback(decodeDump);
+}
+
+} // namespace decode
+
+} // namespace pldmtool
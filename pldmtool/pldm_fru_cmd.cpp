@@ -9,6 +9,8 @@
 #include <endian.h>
 
 #include <functional>
+#include <sstream>
+#include <string>
 #include <tuple>
 
 namespace pldmtool
@@ -85,19 +87,50 @@ class GetFruRecordTableMetadata : public CommandInterface
 class FRUTablePrint
 {
   public:
-    explicit FRUTablePrint(const uint8_t* table, size_t table_size) :
-        table(table), table_size(table_size)
+    /** @struct Filter
+     *  Records printed, by record set identifier and record type, 0 for any
+     */
+    struct Filter
+    {
+        uint16_t recordSetId = 0;
+        uint8_t recordType = 0;
+    };
+
+    explicit FRUTablePrint(const uint8_t* table, size_t table_size,
+                           Filter filter = {}, bool lines = false) :
+        table(table), table_size(table_size), filter(filter), lines(lines)
     {}
 
+    /** @brief Print the records of the table as they are decoded
+     *
+     *  The records are printed as a JSON array, or one per line if lines
+     *  is set, without holding the whole table in a JSON document. The
+     *  records not matching the filter are skipped without decoding their
+     *  fields.
+     */
     void print()
     {
         auto p = table;
-        ordered_json frutable;
-        ordered_json output;
+        size_t printed = 0;
         while (!isTableEnd(p))
         {
             auto record =
                 reinterpret_cast<const pldm_fru_record_data_format*>(p);
+            if ((filter.recordSetId &&
+                 le16toh(record->record_set_id) != filter.recordSetId) ||
+                (filter.recordType && record->record_type != filter.recordType))
+            {
+                p += sizeof(pldm_fru_record_data_format) -
+                     sizeof(pldm_fru_record_tlv);
+                for (int i = 0; i < record->num_fru_fields; i++)
+                {
+                    auto tlv = reinterpret_cast<const pldm_fru_record_tlv*>(p);
+                    p += sizeof(pldm_fru_record_tlv) - 1 + tlv->length;
+                }
+                continue;
+            }
+
+            ordered_json output;
             output["FRU Record Set Identifier"] =
                 (int)le16toh(record->record_set_id);
             output["FRU Record Type"] =
@@ -190,14 +223,55 @@ class FRUTablePrint
                 }
                 p += sizeof(pldm_fru_record_tlv) - 1 + tlv->length;
             }
-            frutable.emplace_back(frufielddata);
+            printRecord(frufielddata, printed++);
+        }
+
+        if (lines)
+        {
+            std::cout.flush();
+        }
+        else if (!printed)
+        {
+            std::cout << "[]" << std::endl;
+        }
+        else
+        {
+            std::cout << (jsonLines ? "]" : "\n]") << std::endl;
         }
-        pldmtool::helper::DisplayInJson(frutable);
     }
 
   private:
     const uint8_t* table;
     size_t table_size;
+    Filter filter;
+    bool lines;
+
+    /** @brief Print a record as an element of the JSON array of the table,
+     *         formatted as DisplayInJson would, or on its own line
+     */
+    void printRecord(const ordered_json& record, size_t index)
+    {
+        if (lines)
+        {
+            std::cout << record.dump(-1) << "\n";
+            return;
+        }
+        if (jsonLines)
+        {
+            std::cout << (index ? "," : "[") << record.dump(-1);
+            return;
+        }
+
+        std::cout << (index ? ",\n" : "[\n");
+        std::istringstream text(record.dump(4));
+        std::string line;
+        bool first = true;
+        while (std::getline(text, line))
+        {
+            std::cout << (first ? "" : "\n") << "    " << line;
+            first = false;
+        }
+    }
 
     bool isTableEnd(const uint8_t* p)
     {
@@ -408,7 +482,17 @@ class GetFruRecordTable : public CommandInterface
     GetFruRecordTable& operator=(const GetFruRecordTable&) = delete;
     GetFruRecordTable& operator=(GetFruRecordTable&&) = delete;
 
-    using CommandInterface::CommandInterface;
+    explicit GetFruRecordTable(const char* type, const char* name,
+                               CLI::App* app) :
+        CommandInterface(type, name, app)
+    {
+        app->add_option("-i, --identifier", filter.recordSetId,
+                        "only print the records of this record set");
+        app->add_option("-r, --record", filter.recordType,
+                        "only print the records of this record type");
+        app->add_flag("-l, --lines", lines,
+                      "print one record per line, as JSON lines");
+    }
     std::pair<int, std::vector<uint8_t>> createRequestMsg() override
     {
         std::vector<uint8_t> requestMsg(
@@ -441,13 +525,19 @@ class GetFruRecordTable : public CommandInterface
         }
 
         FRUTablePrint tablePrint(fru_record_table_data.data(),
-                                 fru_record_table_length);
+                                 fru_record_table_length, filter, lines);
         tablePrint.print();
     }
+
+  private:
+    FRUTablePrint::Filter filter;
+    bool lines = false;
 };
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto fru = app.add_subcommand("fru", "FRU type command");
     fru->require_subcommand(1);
     auto getFruRecordTableMetadata = fru->add_subcommand(
@@ -5,6 +5,13 @@
 
 #include <libpldm/firmware_update.h>
 
+#include <algorithm>
+#include <format>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
 namespace pldmtool
 {
 
@@ -19,6 +26,91 @@ using namespace pldm::fw_update;
 
 std::vector<std::unique_ptr<CommandInterface>> commands;
 
+/** @brief Component identifier, microseconds in UpdateComponent, transfer,
+ *         verify and apply, bytes, requests and retries, as returned by
+ *         pldmd's GetStatistics
+ */
+using ComponentStatisticsEntry =
+    std::tuple<uint16_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t,
+               uint64_t, uint64_t>;
+
+/** @brief EID, microseconds in RequestUpdate, PassComponentTable and
+ *         ActivateFirmware, and the components, as returned by pldmd's
+ *         GetStatistics
+ */
+using UpdateStatisticsEntry =
+    std::tuple<uint8_t, uint64_t, uint64_t, uint64_t,
+               std::vector<ComponentStatisticsEntry>>;
+
+constexpr auto updateStatisticsInterface =
+    "xyz.openbmc_project.PLDM.FirmwareUpdateStatistics";
+
+void getUpdateStatistics()
+{
+    ordered_json data = ordered_json::array();
+    try
+    {
+        auto& bus = pldm::utils::DBusHandler::getBus();
+        auto subtree = pldm::utils::DBusHandler().getSubtree(
+            "/xyz/openbmc_project/software", 0, {updateStatisticsInterface});
+        for (const auto& [path, services] : subtree)
+        {
+            for (const auto& [service, interfaces] : services)
+            {
+                std::vector<UpdateStatisticsEntry> entries;
+                auto method = bus.new_method_call(
+                    service.c_str(), path.c_str(), updateStatisticsInterface,
+                    "GetStatistics");
+                auto reply = bus.call(method);
+                reply.read(entries);
+
+                ordered_json devices = ordered_json::array();
+                for (const auto& [eid, requestUpdate, passComponentTable,
+                                  activate, components] : entries)
+                {
+                    ordered_json comps = ordered_json::array();
+                    for (const auto& [identifier, updateComponent, transfer,
+                                      verify, apply, bytes, chunks, retries] :
+                         components)
+                    {
+                        ordered_json comp;
+                        comp["ComponentIdentifier"] = identifier;
+                        comp["UpdateComponentUs"] = updateComponent;
+                        comp["TransferUs"] = transfer;
+                        comp["VerifyUs"] = verify;
+                        comp["ApplyUs"] = apply;
+                        comp["Bytes"] = bytes;
+                        comp["Requests"] = chunks;
+                        comp["Retries"] = retries;
+                        comps.emplace_back(std::move(comp));
+                    }
+
+                    ordered_json device;
+                    device["EID"] = eid;
+                    device["RequestUpdateUs"] = requestUpdate;
+                    device["PassComponentTableUs"] = passComponentTable;
+                    device["ActivateFirmwareUs"] = activate;
+                    device["Components"] = std::move(comps);
+                    devices.emplace_back(std::move(device));
+                }
+
+                ordered_json object;
+                object["Path"] = path;
+                object["Devices"] = std::move(devices);
+                data.emplace_back(std::move(object));
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr
+            << "Failed to read the firmware update statistics of pldmd, error - "
+            << e.what() << "\n";
+        return;
+    }
+    DisplayInJson(data);
+}
+
 } // namespace
 
 const std::map<uint8_t, std::string> fdStateMachine{
@@ -408,6 +500,194 @@ class GetFwParams : public CommandInterface
     }
 };
 
+class Inventory : public CommandInterface
+{
+  public:
+    ~Inventory() = default;
+    Inventory() = delete;
+    Inventory(const Inventory&) = delete;
+    Inventory(Inventory&&) = default;
+    Inventory& operator=(const Inventory&) = delete;
+    Inventory& operator=(Inventory&&) = delete;
+
+    explicit Inventory(const char* type, const char* name, CLI::App* app) :
+        CommandInterface(type, name, app)
+    {
+        app->add_flag("-a, --all-discovered", allDiscovered,
+                      "query all the PLDM endpoints published by mctpd "
+                      "instead of the ones given with -m");
+        app->add_flag("-j, --json", json, "print the versions as JSON");
+    }
+
+    std::pair<int, std::vector<uint8_t>> createRequestMsg() override
+    {
+        return {PLDM_ERROR, {}};
+    }
+
+    void parseResponseMsg(pldm_msg*, size_t) override {}
+
+    /** @brief Query the firmware parameters of all the endpoints at once
+     *         and print one row per component
+     */
+    void run() override
+    {
+        auto eids = allDiscovered ? discoverEndpoints() : getMCTPEIDs();
+        std::vector<Row> rows;
+        sendRecvEndpoints(
+            eids,
+            [](uint8_t, uint8_t instanceId) -> std::vector<uint8_t> {
+                std::vector<uint8_t> requestMsg(
+                    sizeof(pldm_msg_hdr) +
+                    PLDM_GET_FIRMWARE_PARAMETERS_REQ_BYTES);
+                auto request = new (requestMsg.data()) pldm_msg;
+                if (encode_get_firmware_parameters_req(
+                        instanceId, PLDM_GET_FIRMWARE_PARAMETERS_REQ_BYTES,
+                        request) != PLDM_SUCCESS)
+                {
+                    return {};
+                }
+                return requestMsg;
+            },
+            [&rows](uint8_t eid, pldm_msg* response, size_t payloadLength) {
+                if (response)
+                {
+                    decodeVersions(eid, response, payloadLength, rows);
+                }
+            });
+        std::ranges::sort(rows, {}, [](const Row& row) {
+            return std::tie(row.eid, row.component);
+        });
+
+        if (json)
+        {
+            ordered_json data = ordered_json::array();
+            for (const auto& row : rows)
+            {
+                data.push_back({{"EID", row.eid},
+                                {"Component", row.component},
+                                {"Active", row.active},
+                                {"Pending", row.pending}});
+            }
+            DisplayInJson(data);
+            return;
+        }
+
+        std::cout << std::format("{:>3}  {:<12}  {:<24}  {}\n", "EID",
+                                 "Component", "Active", "Pending");
+        for (const auto& row : rows)
+        {
+            std::cout << std::format("{:>3}  {:<12}  {:<24}  {}\n", row.eid,
+                                     row.component, row.active, row.pending);
+        }
+    }
+
+  private:
+    /** @struct Row
+     *  Versions of a component of a firmware device, the component image set
+     *  is the component "set"
+     */
+    struct Row
+    {
+        unsigned eid;
+        std::string component;
+        std::string active;
+        std::string pending;
+    };
+
+    /** @brief PLDM endpoints published by mctpd */
+    static std::vector<uint8_t> discoverEndpoints()
+    {
+        constexpr auto mctpPath = "/au/com/codeconstruct/mctp1";
+        constexpr auto mctpEndpointInterface =
+            "xyz.openbmc_project.MCTP.Endpoint";
+        constexpr uint8_t mctpTypePLDM = 1;
+
+        std::set<uint8_t> eids;
+        try
+        {
+            pldm::utils::DBusHandler handler;
+            auto subtree =
+                handler.getSubtree(mctpPath, 0, {mctpEndpointInterface});
+            for (const auto& [path, services] : subtree)
+            {
+                for (const auto& [service, interfaces] : services)
+                {
+                    auto properties = handler.getDbusPropertiesVariant(
+                        service.c_str(), path.c_str(), mctpEndpointInterface);
+                    if (!properties.contains("EID") ||
+                        !properties.contains("SupportedMessageTypes"))
+                    {
+                        continue;
+                    }
+                    auto types = std::get<std::vector<uint8_t>>(
+                        properties.at("SupportedMessageTypes"));
+                    if (std::ranges::contains(types, mctpTypePLDM))
+                    {
+                        eids.insert(std::get<uint8_t>(properties.at("EID")));
+                    }
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Failed to discover the MCTP endpoints, error - "
+                      << e.what() << "\n";
+        }
+        return {eids.begin(), eids.end()};
+    }
+
+    /** @brief Add the versions of a GetFirmwareParameters response */
+    static void decodeVersions(uint8_t eid, pldm_msg* response,
+                               size_t payloadLength, std::vector<Row>& rows)
+    {
+        pldm_get_firmware_parameters_resp fwParams{};
+        variable_field activeSetVersion{};
+        variable_field pendingSetVersion{};
+        variable_field compParameterTable{};
+        auto rc = decode_get_firmware_parameters_resp(
+            response, payloadLength, &fwParams, &activeSetVersion,
+            &pendingSetVersion, &compParameterTable);
+        if (rc != PLDM_SUCCESS || fwParams.completion_code != PLDM_SUCCESS)
+        {
+            std::cerr << "EID " << unsigned(eid) << " is not a firmware "
+                      << "device: rc=" << rc
+                      << ",cc=" << (int)fwParams.completion_code << "\n";
+            return;
+        }
+        rows.emplace_back(eid, "set", pldm::utils::toString(activeSetVersion),
+                          pldm::utils::toString(pendingSetVersion));
+
+        auto compParamPtr = compParameterTable.ptr;
+        auto compParamTableLen = compParameterTable.length;
+        while (fwParams.comp_count-- && compParamTableLen > 0)
+        {
+            pldm_component_parameter_entry compEntry{};
+            variable_field activeVersion{};
+            variable_field pendingVersion{};
+            if (decode_get_firmware_parameters_resp_comp_entry(
+                    compParamPtr, compParamTableLen, &compEntry,
+                    &activeVersion, &pendingVersion))
+            {
+                break;
+            }
+            rows.emplace_back(
+                eid,
+                std::format("{:#06x}",
+                            static_cast<uint16_t>(compEntry.comp_identifier)),
+                pldm::utils::toString(activeVersion),
+                pldm::utils::toString(pendingVersion));
+
+            auto entryLength = sizeof(pldm_component_parameter_entry) +
+                               activeVersion.length + pendingVersion.length;
+            compParamPtr += entryLength;
+            compParamTableLen -= entryLength;
+        }
+    }
+
+    bool allDiscovered = false;
+    bool json = false;
+};
+
 class QueryDeviceIdentifiers : public CommandInterface
 {
   public:
@@ -613,6 +893,8 @@ void QueryDeviceIdentifiers::parseResponseMsg(pldm_msg* responsePtr,
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto fwUpdate =
         app.add_subcommand("fw_update", "firmware update type commands");
     fwUpdate->require_subcommand(1);
@@ -626,10 +908,20 @@ void registerCommand(CLI::App& app)
     commands.push_back(
         std::make_unique<GetFwParams>("fw_update", "GetFwParams", getFwParams));
 
+    auto inventory = fwUpdate->add_subcommand(
+        "Inventory", "query the firmware versions of several FDs at once");
+    commands.push_back(
+        std::make_unique<Inventory>("fw_update", "Inventory", inventory));
+
     auto queryDeviceIdentifiers = fwUpdate->add_subcommand(
         "QueryDeviceIdentifiers", "To query device identifiers of the FD");
     commands.push_back(std::make_unique<QueryDeviceIdentifiers>(
         "fw_update", "QueryDeviceIdentifiers", queryDeviceIdentifiers));
+
+    auto updateStatistics = fwUpdate->add_subcommand(
+        "UpdateStatistics",
+        "show the phase timings of the firmware update in progress in pldmd");
+    updateStatistics->callback(getUpdateStatistics);
 }
 
 } // namespace fw_update
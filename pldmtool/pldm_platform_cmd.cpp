@@ -6,11 +6,16 @@
 #include <libpldm/state_set.h>
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstddef>
 #include <format>
+#include <fstream>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <ranges>
+#include <set>
 
 #ifdef OEM_IBM
 #include "oem/ibm/oem_ibm_state_set.hpp"
@@ -70,6 +75,42 @@ std::string getEffecterOpState(uint8_t state)
 
 std::vector<std::unique_ptr<CommandInterface>> commands;
 
+/** @brief Read a file of PDRs written by getpdr --output, each PDR following
+ *         the previous one
+ *
+ *  @param[in] path - path of the file
+ *  @param[out] pdrs - the PDRs of the file, up to a truncated PDR
+ *
+ *  @return false if the file could not be read
+ */
+bool readPDRFile(const std::string& path,
+                 std::vector<std::vector<uint8_t>>& pdrs)
+{
+    std::ifstream input(path, std::ios::binary);
+    if (!input)
+    {
+        std::cerr << "Failed to open " << path << "\n";
+        return false;
+    }
+    std::vector<uint8_t> data{std::istreambuf_iterator<char>(input),
+                              std::istreambuf_iterator<char>()};
+
+    size_t offset = 0;
+    while (offset + sizeof(pldm_pdr_hdr) <= data.size())
+    {
+        auto pdr = reinterpret_cast<const pldm_pdr_hdr*>(data.data() + offset);
+        size_t size = sizeof(pldm_pdr_hdr) + pdr->length;
+        if (offset + size > data.size())
+        {
+            std::cerr << "Truncated PDR at offset " << offset << "\n";
+            break;
+        }
+        pdrs.emplace_back(data.begin() + offset, data.begin() + offset + size);
+        offset += size;
+    }
+    return true;
+}
+
 } // namespace
 
 using ordered_json = nlohmann::ordered_json;
@@ -116,10 +157,20 @@ class GetPDR : public CommandInterface
             "supported IDs:\n [1, 2, 208...]");
 
         allPDRs = false;
-        pdrOptionGroup->add_flag("-a, --all", allPDRs,
-                                 "retrieve all PDRs from a PDR repository");
+        auto allOption = pdrOptionGroup->add_flag(
+            "-a, --all", allPDRs, "retrieve all PDRs from a PDR repository");
+
+        pdrOptionGroup->add_option(
+            "-f, --file", pdrInputFile,
+            "decode the PDRs of a file written by --output, without "
+            "requesting them");
 
         pdrOptionGroup->require_option(1);
+
+        app->add_option("-o, --output", pdrOutputFile,
+                        "with --all, write the raw PDRs to a file instead of "
+                        "decoding them, decode the file with --file")
+            ->needs(allOption);
     }
 
     void parseGetPDROptions()
@@ -162,8 +213,46 @@ class GetPDR : public CommandInterface
         }
     }
 
+    /** @brief Decode the PDRs of a file written by --output */
+    void decodePDRFile()
+    {
+        std::vector<std::vector<uint8_t>> pdrs;
+        if (!readPDRFile(pdrInputFile, pdrs))
+        {
+            return;
+        }
+
+        std::cout << "[\n";
+        for (size_t i = 0; i < pdrs.size(); i++)
+        {
+            if (i)
+            {
+                std::cout << ",";
+            }
+            uint32_t nextRecordHndl =
+                i + 1 < pdrs.size()
+                    ? reinterpret_cast<pldm_pdr_hdr*>(pdrs[i + 1].data())
+                          ->record_handle
+                    : 0;
+            printPDRMsg(nextRecordHndl, pdrs[i].size(), pdrs[i].data(),
+                        std::nullopt);
+        }
+        std::cout << "]\n";
+    }
+
+    bool singleRequest() const override
+    {
+        return false;
+    }
+
     void exec() override
     {
+        if (!pdrInputFile.empty())
+        {
+            decodePDRFile();
+            return;
+        }
+
         if (allPDRs || !pdrRecType.empty())
         {
             if (!pdrRecType.empty())
@@ -172,8 +261,24 @@ class GetPDR : public CommandInterface
                                pdrRecType.begin(), tolower);
             }
 
+            // The PDRs are written as received, and only decoded by --file
+            if (!pdrOutputFile.empty())
+            {
+                pdrOutput.open(pdrOutputFile,
+                               std::ios::binary | std::ios::trunc);
+                if (!pdrOutput)
+                {
+                    std::cerr << "Failed to open " << pdrOutputFile << "\n";
+                    return;
+                }
+            }
+            bool dump = pdrOutput.is_open();
+
             // start the array
-            std::cout << "[\n";
+            if (!dump)
+            {
+                std::cout << "[\n";
+            }
 
             // Retrieve all PDR records starting from the first
             recordHandle = 0;
@@ -203,13 +308,28 @@ class GetPDR : public CommandInterface
                 }
                 prevRecordHandle = recordHandle;
 
-                if (recordHandle != 0)
+                if (recordHandle != 0 && !dump)
                 {
                     // close the array
                     std::cout << ",";
                 }
             } while (recordHandle != 0);
 
+            if (dump)
+            {
+                pdrOutput.close();
+                if (!pdrOutput)
+                {
+                    std::cerr << "Failed to write " << pdrOutputFile << "\n";
+                    return;
+                }
+                ordered_json data;
+                data["file"] = pdrOutputFile;
+                data["pdrs"] = pdrsWritten;
+                pldmtool::helper::DisplayInJson(data);
+                return;
+            }
+
             // close the array
             std::cout << "]\n";
         }
@@ -281,8 +401,18 @@ class GetPDR : public CommandInterface
             if (transferFlag == PLDM_PLATFORM_TRANSFER_END ||
                 transferFlag == PLDM_PLATFORM_TRANSFER_START_AND_END)
             {
-                printPDRMsg(nextRecordHndl, respCnt, recordData.data(),
-                            terminusHandle);
+                if (pdrOutput.is_open())
+                {
+                    pdrOutput.write(
+                        reinterpret_cast<const char*>(recordData.data()),
+                        recordData.size());
+                    pdrsWritten++;
+                }
+                else
+                {
+                    printPDRMsg(nextRecordHndl, respCnt, recordData.data(),
+                                terminusHandle);
+                }
                 nextPartRequired = false;
                 recordHandle = nextRecordHndl;
                 dataTransferHandle = 0;
@@ -1595,6 +1725,10 @@ class GetPDR : public CommandInterface
     uint16_t recordChangeNumber;
     std::vector<uint8_t> recordData;
     bool nextPartRequired;
+    std::string pdrInputFile;
+    std::string pdrOutputFile;
+    std::ofstream pdrOutput;
+    size_t pdrsWritten = 0;
 };
 
 class SetStateEffecter : public CommandInterface
@@ -2024,6 +2158,402 @@ class GetSensorReading : public CommandInterface
     }
 };
 
+class Sweep : public CommandInterface
+{
+  public:
+    ~Sweep() = default;
+    Sweep() = delete;
+    Sweep(const Sweep&) = delete;
+    Sweep(Sweep&&) = default;
+    Sweep& operator=(const Sweep&) = delete;
+    Sweep& operator=(Sweep&&) = delete;
+
+    explicit Sweep(const char* type, const char* name, CLI::App* app) :
+        CommandInterface(type, name, app)
+    {
+        app->add_option("-f, --file", pdrFile,
+                        "read the PDRs from a file written by getpdr --output "
+                        "instead of requesting them");
+        app->add_option("-w, --window", window,
+                        "number of sensor readings requested at once");
+        app->add_flag("-c, --csv", csv, "print CSV instead of a table");
+    }
+
+    std::pair<int, std::vector<uint8_t>> createRequestMsg() override
+    {
+        return {PLDM_ERROR, {}};
+    }
+
+    void parseResponseMsg(pldm_msg*, size_t) override {}
+
+    bool singleRequest() const override
+    {
+        return false;
+    }
+
+    void exec() override
+    {
+        std::vector<std::vector<uint8_t>> pdrs;
+        if (pdrFile.empty() ? !fetchPDRs(pdrs) : !readPDRFile(pdrFile, pdrs))
+        {
+            return;
+        }
+        sensors.clear();
+        for (const auto& pdr : pdrs)
+        {
+            addSensor(pdr);
+        }
+
+        sendRecvPipelined(
+            sensors.size(), window,
+            [this](size_t index, uint8_t instanceId) {
+                return encodeReading(sensors[index], instanceId);
+            },
+            [this](size_t index, pldm_msg* response, size_t payloadLength) {
+                if (response)
+                {
+                    decodeReading(sensors[index], response, payloadLength);
+                }
+            });
+
+        printSensors();
+    }
+
+  private:
+    /** @struct Sensor
+     *  A numeric or state sensor of the PDRs and its reading
+     */
+    struct Sensor
+    {
+        uint16_t id;
+        uint8_t pdrType;
+        uint16_t entityType;
+        uint16_t entityInstance;
+        uint16_t containerId;
+        double resolution = 1;
+        double offset = 0;
+        int8_t unitModifier = 0;
+        uint8_t baseUnit = 0;
+        std::string value = "-";
+        std::string opState = "-";
+    };
+
+    /** @brief Request the PDRs of the endpoint, one after the other
+     *
+     *  @param[out] pdrs - the PDRs
+     *
+     *  @return false if a request failed
+     */
+    bool fetchPDRs(std::vector<std::vector<uint8_t>>& pdrs)
+    {
+        auto eid = getMCTPEID();
+        std::vector<uint8_t> recordData(UINT16_MAX);
+        std::set<uint32_t> seen;
+        uint32_t recordHandle = 0;
+        do
+        {
+            if (!seen.insert(recordHandle).second)
+            {
+                std::cerr << "Record handle " << recordHandle
+                          << " has multiple references\n";
+                return false;
+            }
+
+            std::vector<uint8_t> record;
+            uint32_t dataTransferHandle = 0;
+            uint8_t operationFlag = PLDM_GET_FIRSTPART;
+            uint16_t recordChangeNumber = 0;
+            while (true)
+            {
+                auto id = instanceIdDb.next(eid);
+                std::vector<uint8_t> requestMsg(
+                    sizeof(pldm_msg_hdr) + PLDM_GET_PDR_REQ_BYTES);
+                auto request = new (requestMsg.data()) pldm_msg;
+                auto rc = encode_get_pdr_req(
+                    id, recordHandle, dataTransferHandle, operationFlag,
+                    UINT16_MAX, recordChangeNumber, request,
+                    PLDM_GET_PDR_REQ_BYTES);
+                std::vector<uint8_t> responseMsg;
+                if (rc == PLDM_SUCCESS)
+                {
+                    rc = pldmSendRecv(requestMsg, responseMsg);
+                }
+                instanceIdDb.free(eid, id);
+                if (rc != PLDM_SUCCESS ||
+                    responseMsg.size() < sizeof(pldm_msg_hdr))
+                {
+                    std::cerr << "Failed to get the PDR of record handle "
+                              << recordHandle << "\n";
+                    return false;
+                }
+
+                uint8_t completionCode = 0;
+                uint32_t nextRecordHandle = 0;
+                uint32_t nextDataTransferHandle = 0;
+                uint8_t transferFlag = 0;
+                uint16_t respCnt = 0;
+                uint8_t transferCRC = 0;
+                rc = decode_get_pdr_resp(
+                    reinterpret_cast<pldm_msg*>(responseMsg.data()),
+                    responseMsg.size() - sizeof(pldm_msg_hdr), &completionCode,
+                    &nextRecordHandle, &nextDataTransferHandle, &transferFlag,
+                    &respCnt, recordData.data(), recordData.size(),
+                    &transferCRC);
+                if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
+                {
+                    std::cerr << "Response Message Error: "
+                              << "rc=" << rc << ",cc=" << (int)completionCode
+                              << std::endl;
+                    return false;
+                }
+
+                if (record.empty() && respCnt >= sizeof(pldm_pdr_hdr))
+                {
+                    recordChangeNumber =
+                        reinterpret_cast<pldm_pdr_hdr*>(recordData.data())
+                            ->record_change_num;
+                }
+                record.insert(record.end(), recordData.begin(),
+                              recordData.begin() + respCnt);
+                if (transferFlag == PLDM_PLATFORM_TRANSFER_END ||
+                    transferFlag == PLDM_PLATFORM_TRANSFER_START_AND_END)
+                {
+                    recordHandle = nextRecordHandle;
+                    break;
+                }
+                dataTransferHandle = nextDataTransferHandle;
+                operationFlag = PLDM_GET_NEXTPART;
+            }
+            if (record.size() >= sizeof(pldm_pdr_hdr))
+            {
+                pdrs.emplace_back(std::move(record));
+            }
+        } while (recordHandle != 0);
+        return true;
+    }
+
+    /** @brief Add the sensor described by a PDR, if it is a sensor */
+    void addSensor(const std::vector<uint8_t>& pdr)
+    {
+        auto hdr = reinterpret_cast<const pldm_pdr_hdr*>(pdr.data());
+        switch (hdr->type)
+        {
+            case PLDM_NUMERIC_SENSOR_PDR:
+            {
+                pldm_numeric_sensor_value_pdr numeric{};
+                if (decode_numeric_sensor_pdr_data(pdr.data(), pdr.size(),
+                                                   &numeric) != PLDM_SUCCESS)
+                {
+                    return;
+                }
+                auto& sensor = sensors.emplace_back(
+                    numeric.sensor_id, hdr->type, numeric.entity_type,
+                    numeric.entity_instance_num, numeric.container_id);
+                sensor.resolution = numeric.resolution;
+                sensor.offset = numeric.offset;
+                sensor.unitModifier = numeric.unit_modifier;
+                sensor.baseUnit = numeric.base_unit;
+                break;
+            }
+            case PLDM_COMPACT_NUMERIC_SENSOR_PDR:
+            {
+                if (pdr.size() < sizeof(pldm_compact_numeric_sensor_pdr))
+                {
+                    return;
+                }
+                auto compact =
+                    reinterpret_cast<const pldm_compact_numeric_sensor_pdr*>(
+                        pdr.data());
+                auto& sensor = sensors.emplace_back(
+                    compact->sensor_id, hdr->type, compact->entity_type,
+                    compact->entity_instance, compact->container_id);
+                sensor.unitModifier = compact->unit_modifier;
+                sensor.baseUnit = compact->base_unit;
+                break;
+            }
+            case PLDM_STATE_SENSOR_PDR:
+            {
+                if (pdr.size() < sizeof(pldm_state_sensor_pdr))
+                {
+                    return;
+                }
+                auto state =
+                    reinterpret_cast<const pldm_state_sensor_pdr*>(pdr.data());
+                sensors.emplace_back(state->sensor_id, hdr->type,
+                                     state->entity_type, state->entity_instance,
+                                     state->container_id);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    /** @brief Encode the reading request of a sensor */
+    std::vector<uint8_t> encodeReading(const Sensor& sensor, uint8_t id)
+    {
+        if (sensor.pdrType == PLDM_STATE_SENSOR_PDR)
+        {
+            std::vector<uint8_t> requestMsg(
+                sizeof(pldm_msg_hdr) +
+                PLDM_GET_STATE_SENSOR_READINGS_REQ_BYTES);
+            bitfield8_t rearm{};
+            if (encode_get_state_sensor_readings_req(
+                    id, sensor.id, rearm, 0,
+                    new (requestMsg.data()) pldm_msg) != PLDM_SUCCESS)
+            {
+                return {};
+            }
+            return requestMsg;
+        }
+
+        std::vector<uint8_t> requestMsg(
+            sizeof(pldm_msg_hdr) + PLDM_GET_SENSOR_READING_REQ_BYTES);
+        if (encode_get_sensor_reading_req(id, sensor.id, false,
+                                          new (requestMsg.data()) pldm_msg) !=
+            PLDM_SUCCESS)
+        {
+            return {};
+        }
+        return requestMsg;
+    }
+
+    /** @brief Decode the reading of a sensor, numeric readings are converted
+     *         with the coefficients of their PDR
+     */
+    void decodeReading(Sensor& sensor, pldm_msg* response,
+                       size_t payloadLength)
+    {
+        uint8_t completionCode = 0;
+        if (sensor.pdrType == PLDM_STATE_SENSOR_PDR)
+        {
+            uint8_t compSensorCount = 0;
+            std::array<get_sensor_state_field, 8> stateField{};
+            auto rc = decode_get_state_sensor_readings_resp(
+                response, payloadLength, &completionCode, &compSensorCount,
+                stateField.data());
+            if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS ||
+                !compSensorCount)
+            {
+                sensor.opState = std::format("cc={}", completionCode);
+                return;
+            }
+            sensor.value.clear();
+            for (size_t i = 0; i < compSensorCount; i++)
+            {
+                sensor.value += std::format("{}{}", i ? " " : "",
+                                            stateField[i].present_state);
+            }
+            sensor.opState = getOpState(stateField[0].sensor_op_state);
+            return;
+        }
+
+        uint8_t dataSize = 0;
+        uint8_t opState = 0;
+        uint8_t eventMessageEnable = 0;
+        uint8_t presentState = 0;
+        uint8_t previousState = 0;
+        uint8_t eventState = 0;
+        std::array<uint8_t, sizeof(uint32_t)> reading{};
+        auto rc = decode_get_sensor_reading_resp(
+            response, payloadLength, &completionCode, &dataSize, &opState,
+            &eventMessageEnable, &presentState, &previousState, &eventState,
+            reading.data());
+        if (rc != PLDM_SUCCESS || completionCode != PLDM_SUCCESS)
+        {
+            sensor.opState = std::format("cc={}", completionCode);
+            return;
+        }
+        sensor.opState = getOpState(opState);
+        if (opState != PLDM_SENSOR_ENABLED)
+        {
+            return;
+        }
+
+        double raw = 0;
+        switch (dataSize)
+        {
+            case PLDM_SENSOR_DATA_SIZE_UINT8:
+                raw = *reinterpret_cast<uint8_t*>(reading.data());
+                break;
+            case PLDM_SENSOR_DATA_SIZE_SINT8:
+                raw = *reinterpret_cast<int8_t*>(reading.data());
+                break;
+            case PLDM_SENSOR_DATA_SIZE_UINT16:
+                raw = *reinterpret_cast<uint16_t*>(reading.data());
+                break;
+            case PLDM_SENSOR_DATA_SIZE_SINT16:
+                raw = *reinterpret_cast<int16_t*>(reading.data());
+                break;
+            case PLDM_SENSOR_DATA_SIZE_UINT32:
+                raw = *reinterpret_cast<uint32_t*>(reading.data());
+                break;
+            case PLDM_SENSOR_DATA_SIZE_SINT32:
+                raw = *reinterpret_cast<int32_t*>(reading.data());
+                break;
+            default:
+                return;
+        }
+        auto value = raw;
+        if (std::isfinite(sensor.resolution))
+        {
+            value *= sensor.resolution;
+        }
+        if (std::isfinite(sensor.offset))
+        {
+            value += sensor.offset;
+        }
+        sensor.value =
+            std::format("{:g}", value * std::pow(10, sensor.unitModifier));
+    }
+
+    static std::string getOpState(uint8_t state)
+    {
+        return sensorOpState.contains(state) ? sensorOpState.at(state)
+                                             : std::to_string(state);
+    }
+
+    /** @brief Print the readings as a table or as CSV */
+    void printSensors() const
+    {
+        auto typeName = [](uint8_t pdrType) {
+            return pdrType == PLDM_STATE_SENSOR_PDR ? "state" : "numeric";
+        };
+        if (csv)
+        {
+            std::cout << "sensor_id,type,entity_type,entity_instance,"
+                         "container_id,value,base_unit,op_state\n";
+            for (const auto& sensor : sensors)
+            {
+                std::cout << std::format(
+                    "{},{},{},{},{},{},{},{}\n", sensor.id,
+                    typeName(sensor.pdrType), sensor.entityType,
+                    sensor.entityInstance, sensor.containerId, sensor.value,
+                    sensor.baseUnit, sensor.opState);
+            }
+            return;
+        }
+
+        std::cout << std::format("{:>9} {:<7} {:>6} {:>8} {:>9} {:>14} {:>4} "
+                                 "{}\n",
+                                 "SensorID", "Type", "Entity", "Instance",
+                                 "Container", "Value", "Unit", "OpState");
+        for (const auto& sensor : sensors)
+        {
+            std::cout << std::format(
+                "{:>9} {:<7} {:>6} {:>8} {:>9} {:>14} {:>4} {}\n", sensor.id,
+                typeName(sensor.pdrType), sensor.entityType,
+                sensor.entityInstance, sensor.containerId, sensor.value,
+                sensor.baseUnit, sensor.opState);
+        }
+    }
+
+    std::string pdrFile;
+    size_t window = 8;
+    bool csv = false;
+    std::vector<Sensor> sensors;
+};
+
 class GetStateEffecterStates : public CommandInterface
 {
   public:
@@ -2222,6 +2752,8 @@ class GetNumericEffecterValue : public CommandInterface
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto platform = app.add_subcommand("platform", "platform type command");
     platform->require_subcommand(1);
 
@@ -2254,6 +2786,10 @@ void registerCommand(CLI::App& app)
     commands.push_back(std::make_unique<GetSensorReading>(
         "platform", "getSensorReading", getSensorReading));
 
+    auto sweep = platform->add_subcommand(
+        "sweep", "read all the numeric and state sensors of the PDRs");
+    commands.push_back(std::make_unique<Sweep>("platform", "sweep", sweep));
+
     auto getStateEffecterStates = platform->add_subcommand(
         "GetStateEffecterStates", "get the state effecter states");
     commands.push_back(std::make_unique<GetStateEffecterStates>(
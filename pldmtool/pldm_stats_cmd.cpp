@@ -0,0 +1,97 @@
+#include "pldm_stats_cmd.hpp"
+
+#include "pldm_cmd_helper.hpp"
+
+#include <tuple>
+#include <vector>
+
+namespace pldmtool
+{
+
+namespace stats
+{
+
+namespace
+{
+
+using namespace pldmtool::helper;
+
+/** @brief EID, type, command, sent, retried, timed out, responses and latency
+ *         histogram, as returned by pldmd's GetStatistics
+ */
+using RequestStatsEntry =
+    std::tuple<uint8_t, uint8_t, uint8_t, uint64_t, uint64_t, uint64_t,
+               uint64_t, std::vector<uint64_t>>;
+
+/** @brief Label of a latency histogram bucket, see requester::RequestStats */
+std::string bucketLabel(size_t bucket, size_t buckets)
+{
+    if (bucket == 0)
+    {
+        return "<1ms";
+    }
+    if (bucket == buckets - 1)
+    {
+        return ">=" + std::to_string(1ULL << (bucket - 1)) + "ms";
+    }
+    return "<" + std::to_string(1ULL << bucket) + "ms";
+}
+
+void getRequestStats()
+{
+    std::vector<RequestStatsEntry> entries;
+    try
+    {
+        auto& bus = pldm::utils::DBusHandler::getBus();
+        auto method = bus.new_method_call(
+            "xyz.openbmc_project.PLDM", "/xyz/openbmc_project/pldm",
+            "xyz.openbmc_project.PLDM.RequestStatistics", "GetStatistics");
+        auto reply = bus.call(method);
+        reply.read(entries);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Failed to read the request statistics of pldmd, error - "
+                  << e.what() << "\n";
+        return;
+    }
+
+    ordered_json data = ordered_json::array();
+    for (const auto& [eid, type, command, sent, retried, timedOut, responses,
+                      latency] : entries)
+    {
+        ordered_json histogram;
+        for (size_t i = 0; i < latency.size(); i++)
+        {
+            if (latency[i])
+            {
+                histogram[bucketLabel(i, latency.size())] = latency[i];
+            }
+        }
+
+        ordered_json entry;
+        entry["EID"] = eid;
+        entry["Type"] = type;
+        entry["Command"] = command;
+        entry["Sent"] = sent;
+        entry["Retried"] = retried;
+        entry["TimedOut"] = timedOut;
+        entry["Responses"] = responses;
+        entry["Latency"] = histogram;
+        data.emplace_back(std::move(entry));
+    }
+    DisplayInJson(data);
+}
+
+} // namespace
+
+void registerCommand(CLI::App& app)
+{
+    auto stats = app.add_subcommand(
+        "stats", "show the per-endpoint request statistics of pldmd");
+    stats->callback(getRequestStats);
+}
+
+} // namespace stats
+
+} // namespace pldmtool
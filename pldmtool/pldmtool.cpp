@@ -1,14 +1,23 @@
 #include "pldm_base_cmd.hpp"
+#include "pldm_bench_cmd.hpp"
 #include "pldm_bios_cmd.hpp"
 #include "pldm_cmd_helper.hpp"
+#include "pldm_decode_cmd.hpp"
 #include "pldm_fru_cmd.hpp"
 #include "pldm_fw_update_cmd.hpp"
 #include "pldm_platform_cmd.hpp"
+#include "pldm_stats_cmd.hpp"
 #include "pldmtool/oem/ibm/pldm_oem_ibm.hpp"
 
 #include <CLI/CLI.hpp>
 
-#include "common/mctp.hpp"
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
 
 namespace pldmtool
 {
@@ -36,9 +45,14 @@ class RawOp : public CommandInterface
     explicit RawOp(const char* type, const char* name, CLI::App* app) :
         CommandInterface(type, name, app)
     {
-        app->add_option("-d,--data", rawData, "raw data")
-            ->required()
-            ->expected(-3);
+        auto data =
+            app->add_option("-d,--data", rawData, "raw data")->expected(-3);
+        auto file = app->add_option(
+            "-f,--file", streamFile,
+            "file of raw requests, one per line in hex, - for stdin");
+        data->excludes(file);
+        app->add_option("-w,--window", window,
+                        "maximum number of requests of the file in flight");
     }
     std::pair<int, std::vector<uint8_t>> createRequestMsg() override
 
@@ -51,26 +65,146 @@ class RawOp : public CommandInterface
                           size_t /* payloadLength */) override
     {}
 
+    bool singleRequest() const override
+    {
+        return streamFile.empty();
+    }
+
+    void exec() override
+    {
+        if (!streamFile.empty())
+        {
+            stream();
+            return;
+        }
+        if (rawData.size() < sizeof(pldm_msg_hdr))
+        {
+            std::cerr << "raw requires --data or --file\n";
+            return;
+        }
+        CommandInterface::exec();
+    }
+
   private:
+    /** @brief Send the requests of the file with up to window of them in
+     *         flight, and print each response as a JSON line as it arrives
+     *
+     *  The instance ID of each request is replaced by a free one. Empty
+     *  lines and lines starting with # are skipped.
+     */
+    void stream()
+    {
+        std::ifstream file;
+        if (streamFile != "-")
+        {
+            file.open(streamFile);
+            if (!file)
+            {
+                std::cerr << "Failed to open " << streamFile << "\n";
+                return;
+            }
+        }
+        std::istream& input = streamFile == "-" ? std::cin : file;
+
+        std::vector<std::vector<uint8_t>> requests;
+        std::string line;
+        for (size_t lineNumber = 1; std::getline(input, line); lineNumber++)
+        {
+            std::istringstream tokens(line);
+            std::vector<uint8_t> request;
+            std::string token;
+            bool valid = true;
+            while (valid && tokens >> token && token[0] != '#')
+            {
+                try
+                {
+                    size_t end = 0;
+                    auto byte = std::stoul(token, &end, 16);
+                    valid = end == token.size() && byte <= UINT8_MAX;
+                    request.push_back(byte);
+                }
+                catch (const std::exception&)
+                {
+                    valid = false;
+                }
+            }
+            if (request.empty() && valid)
+            {
+                continue;
+            }
+            if (!valid || request.size() < sizeof(pldm_msg_hdr))
+            {
+                std::cerr << "Invalid request on line " << lineNumber << "\n";
+                continue;
+            }
+            requests.emplace_back(std::move(request));
+        }
+
+        using namespace std::chrono;
+        std::vector<steady_clock::time_point> sent(requests.size());
+        auto start = steady_clock::now();
+        auto toHex = [](const uint8_t* data, size_t length) {
+            std::string hex;
+            for (size_t i = 0; i < length; i++)
+            {
+                hex += std::format("{}{:02x}", i ? " " : "", data[i]);
+            }
+            return hex;
+        };
+        sendRecvPipelined(
+            requests.size(), window,
+            [&](size_t index, uint8_t id) {
+                auto& request = requests[index];
+                request[0] = (request[0] & 0xe0) | id;
+                sent[index] = steady_clock::now();
+                return request;
+            },
+            [&](size_t index, pldm_msg* response, size_t payloadLength) {
+                auto now = steady_clock::now();
+                ordered_json data;
+                data["index"] = index;
+                data["timestamp_us"] =
+                    duration_cast<microseconds>(now - start).count();
+                data["request"] =
+                    toHex(requests[index].data(), requests[index].size());
+                if (response)
+                {
+                    data["latency_us"] =
+                        duration_cast<microseconds>(now - sent[index]).count();
+                    data["response"] =
+                        toHex(reinterpret_cast<const uint8_t*>(response),
+                              sizeof(pldm_msg_hdr) + payloadLength);
+                }
+                else
+                {
+                    data["error"] = "no response";
+                }
+                std::cout << data.dump(-1) << "\n";
+            });
+        std::cout.flush();
+    }
+
     std::vector<uint8_t> rawData;
+    std::string streamFile;
+    size_t window = 1;
 };
 
 void registerCommand(CLI::App& app)
 {
+    commands.clear();
+
     auto raw =
         app.add_subcommand("raw", "send a raw request and print response");
     commands.push_back(std::make_unique<RawOp>("raw", "raw", raw));
 }
 
 } // namespace raw
-} // namespace pldmtool
 
-int main(int argc, char** argv)
+/** @brief Register the commands of all the PLDM types, replacing the
+ *         commands registered before
+ */
+void registerCommands(CLI::App& app)
 {
-
-    MCTP::init();
-
-    CLI::App app{"PLDM requester tool for OpenBMC"};
     app.require_subcommand(1)->ignore_case();
 
     pldmtool::raw::registerCommand(app);
@@ -79,12 +213,93 @@ int main(int argc, char** argv)
     pldmtool::platform::registerCommand(app);
     pldmtool::fru::registerCommand(app);
     pldmtool::fw_update::registerCommand(app);
+    pldmtool::stats::registerCommand(app);
+    pldmtool::bench::registerCommand(app);
+    pldmtool::decode::registerCommand(app);
 
 #ifdef OEM_IBM
     pldmtool::oem_ibm::registerCommand(app);
 #endif
+}
+
+namespace batch
+{
+
+/** @brief Run the commands of a stream, one per line, with the arguments of
+ *         a pldmtool command line
+ *
+ *  The commands share the MCTP transport and the instance ID database of
+ *  the process. Each command is parsed by new commands, so no option is
+ *  carried over from a previous line. Empty lines and lines starting with #
+ *  are skipped.
+ *
+ *  @param[in] input - stream of commands
+ *
+ *  @return 0 if all the commands were parsed, 1 otherwise
+ */
+int run(std::istream& input)
+{
+    helper::jsonLines = true;
+
+    int rc = 0;
+    std::string line;
+    while (std::getline(input, line))
+    {
+        auto start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] == '#')
+        {
+            continue;
+        }
+
+        CLI::App app{"PLDM requester tool for OpenBMC"};
+        registerCommands(app);
+        try
+        {
+            app.parse(line.substr(start), false);
+            pldmtool::platform::parseGetPDROption();
+        }
+        catch (const CLI::ParseError& e)
+        {
+            if (app.exit(e))
+            {
+                rc = 1;
+            }
+        }
+        std::cout.flush();
+    }
+    return rc;
+}
+
+} // namespace batch
+} // namespace pldmtool
+
+int main(int argc, char** argv)
+{
+    CLI::App app{"PLDM requester tool for OpenBMC"};
+    pldmtool::registerCommands(app);
+
+    std::string batchFile;
+    auto batch = app.add_subcommand(
+        "batch", "run pldmtool commands read from a file or stdin, one per "
+                 "line, printing their JSON output one object per line");
+    batch->add_option("-f,--file", batchFile,
+                      "file of commands, stdin if not given");
 
     CLI11_PARSE(app, argc, argv);
+    if (*batch)
+    {
+        if (batchFile.empty())
+        {
+            return pldmtool::batch::run(std::cin);
+        }
+        std::ifstream input(batchFile);
+        if (!input)
+        {
+            std::cerr << "Failed to open " << batchFile << "\n";
+            return 1;
+        }
+        return pldmtool::batch::run(input);
+    }
     pldmtool::platform::parseGetPDROption();
     return 0;
 }
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "common/instance_id.hpp"
+#include "common/pldm_msg.hpp"
+#include "common/trace.hpp"
 #include "common/transport.hpp"
 #include "common/types.hpp"
 #include "request.hpp"
 
 #include <libpldm/base.h>
+#include <libpldm/platform.h>
 #include <sys/socket.h>
 
 #include <phosphor-logging/lg2.hpp>
@@ -14,15 +17,23 @@
 #include <sdeventplus/event.hpp>
 #include <sdeventplus/source/event.hpp>
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <chrono>
 #include <deque>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
+#include <set>
+#include <span>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 PHOSPHOR_LOG2_USING;
 
@@ -78,6 +89,53 @@ using ResponseHandler = std::function<void(
  */
 using SendRecvCoResp = std::tuple<int, const pldm_msg*, size_t>;
 
+/** @brief Classes of requests, sent first to last while queued for the
+ *         same endpoint
+ */
+enum class RequestPriority : uint8_t
+{
+    control = 0, //!< Effecter writes, power and thermal control
+    sensor = 1,  //!< Sensor readings, events and the other commands
+    bulk = 2,    //!< PDR, FRU and BIOS table transfers, firmware update
+};
+
+/** @brief Number of RequestPriority classes */
+constexpr size_t requestPriorities = 3;
+
+/** @brief Get the class of a request from its command
+ *
+ *  @param[in] type - PLDM type
+ *  @param[in] command - PLDM command
+ *
+ *  @return the class the request is queued in unless one is given
+ */
+inline RequestPriority requestPriority(uint8_t type, uint8_t command)
+{
+    switch (type)
+    {
+        case PLDM_PLATFORM:
+            switch (command)
+            {
+                case PLDM_SET_NUMERIC_EFFECTER_VALUE:
+                case PLDM_SET_STATE_EFFECTER_STATES:
+                case PLDM_SET_NUMERIC_EFFECTER_ENABLE:
+                case PLDM_SET_STATE_EFFECTER_ENABLES:
+                    return RequestPriority::control;
+                case PLDM_GET_PDR:
+                case PLDM_GET_PDR_REPOSITORY_INFO:
+                    return RequestPriority::bulk;
+                default:
+                    return RequestPriority::sensor;
+            }
+        case PLDM_BIOS:
+        case PLDM_FRU:
+        case PLDM_FWUP:
+            return RequestPriority::bulk;
+        default:
+            return RequestPriority::sensor;
+    }
+}
+
 /** @struct RegisteredRequest
  *
  *  This struct is used to store the registered request to one endpoint.
@@ -85,25 +143,197 @@ using SendRecvCoResp = std::tuple<int, const pldm_msg*, size_t>;
 struct RegisteredRequest
 {
     RequestKey key;                  //!< Responder MCTP endpoint ID
-    std::vector<uint8_t> reqMsg;     //!< Request messages queue
+    pldm::RequestMsg reqMsg;         //!< Request messages queue
     ResponseHandler responseHandler; //!< Waiting for response flag
+    RequestPriority priority;        //!< Class the request is queued in
+    std::chrono::steady_clock::time_point queued; //!< Time it was queued
+};
+
+/** @brief Upper bound of the per-endpoint in-flight window, DSP0240 allows
+ *         32 outstanding instance IDs per terminus
+ */
+constexpr uint8_t maxRequestWindowSize = 32;
+
+/** @struct ResponseTimeEstimator
+ *
+ *  Tracks the response time of one endpoint the way RFC 6298 tracks TCP
+ *  round trip times: an EWMA of the observed latency and of its deviation.
+ *  The response timeout of the endpoint is derived from both.
+ */
+struct ResponseTimeEstimator
+{
+    std::chrono::microseconds srtt{0};   //!< smoothed response time
+    std::chrono::microseconds rttvar{0}; //!< response time deviation
+    bool valid = false;                  //!< at least one sample was taken
+
+    /** @brief Account for a response time sample
+     *
+     *  @param[in] sample - time between sending a request and its response
+     */
+    void update(std::chrono::microseconds sample)
+    {
+        if (!valid)
+        {
+            srtt = sample;
+            rttvar = sample / 2;
+            valid = true;
+            return;
+        }
+        auto delta = (srtt > sample) ? srtt - sample : sample - srtt;
+        rttvar = (3 * rttvar + delta) / 4;
+        srtt = (7 * srtt + sample) / 8;
+    }
+
+    /** @brief Get the response timeout derived from the samples
+     *
+     *  @param[in] fallback - timeout to use until a sample was taken
+     *  @param[in] min - lower bound of the derived timeout
+     *  @param[in] max - upper bound of the derived timeout
+     *
+     *  @return the response timeout
+     */
+    std::chrono::milliseconds timeout(std::chrono::milliseconds fallback,
+                                      std::chrono::milliseconds min,
+                                      std::chrono::milliseconds max) const
+    {
+        if (!valid)
+        {
+            return fallback;
+        }
+        return std::clamp(
+            std::chrono::ceil<std::chrono::milliseconds>(srtt + 4 * rttvar),
+            std::min(min, max), max);
+    }
+};
+
+/** @brief Number of buckets of the request latency histogram */
+constexpr size_t latencyBuckets = 16;
+
+/** @struct RequestStats
+ *
+ *  Counters of the requests sent for one (EID, PLDM type, PLDM command).
+ *  Bucket 0 of the latency histogram counts responses within 1ms, bucket i
+ *  those within [2^(i-1), 2^i) ms, the last bucket everything slower.
+ */
+struct RequestStats
+{
+    uint64_t sent = 0;      //!< requests sent
+    uint64_t retried = 0;   //!< retries of those requests
+    uint64_t timedOut = 0;  //!< requests whose instance ID expired
+    uint64_t responses = 0; //!< responses received
+    std::array<uint64_t, latencyBuckets> latency{}; //!< response latency
+
+    /** @brief Account for a response
+     *
+     *  @param[in] elapsed - time since the request was first sent
+     */
+    void addResponse(std::chrono::steady_clock::duration elapsed)
+    {
+        auto ms = std::max<int64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
+                .count(),
+            0);
+        auto bucket = std::bit_width(static_cast<uint64_t>(ms));
+        latency[std::min<size_t>(bucket, latencyBuckets - 1)]++;
+        responses++;
+    }
 };
 
+/** @brief Request statistics keyed by (EID, PLDM type, PLDM command) */
+using RequestStatsMap =
+    std::map<std::tuple<mctp_eid_t, uint8_t, uint8_t>, RequestStats>;
+
+/** @brief Lower bound of the response timeout derived for an endpoint */
+constexpr std::chrono::milliseconds minAdaptiveResponseTimeOut{300};
+
 /** @struct EndpointMessageQueue
  *
  *  This struct is used to save the list of request messages of one endpoint and
- *  the existing of the request message to the endpoint with its' EID.
+ *  the number of request messages in flight to the endpoint with its' EID.
+ *
+ *  Queued requests wait in one FIFO per RequestPriority. The next request
+ *  sent is the head with the earliest queue time plus its class times the
+ *  aging interval, so a control request overtakes the sensor and bulk
+ *  requests queued less than one and two aging intervals before it, and
+ *  no class waits forever behind another.
  */
 struct EndpointMessageQueue
 {
     mctp_eid_t eid; //!< Responder MCTP endpoint ID
-    std::deque<std::shared_ptr<RegisteredRequest>> requestQueue; //!< Queue
-    bool activeRequest; //!< Waiting for response flag
+    std::array<std::deque<RegisteredRequest>, requestPriorities>
+        requestQueues;  //!< Queues, by RequestPriority
+    uint8_t inFlight;   //!< Number of requests waiting for a response
+    uint8_t windowSize; //!< Maximum number of requests in flight
+    ResponseTimeEstimator responseTime; //!< Observed response times
 
     bool operator==(const mctp_eid_t& mctpEid) const
     {
         return (eid == mctpEid);
     }
+
+    /** @brief Check if no request is queued */
+    bool empty() const
+    {
+        return std::ranges::all_of(
+            requestQueues, [](const auto& queue) { return queue.empty(); });
+    }
+
+    /** @brief Queue a request in the queue of its class */
+    void push(RegisteredRequest&& request)
+    {
+        requestQueues[static_cast<size_t>(request.priority)].emplace_back(
+            std::move(request));
+    }
+
+    /** @brief Dequeue the next request to send, the queues must not all be
+     *         empty
+     *
+     *  @param[in] aging - delay by which a class yields to the class above
+     *
+     *  @return the request
+     */
+    RegisteredRequest pop(std::chrono::milliseconds aging)
+    {
+        std::deque<RegisteredRequest>* next = nullptr;
+        std::chrono::steady_clock::time_point nextDue;
+        std::chrono::milliseconds delay{};
+        for (auto& queue : requestQueues)
+        {
+            if (!queue.empty())
+            {
+                auto due = queue.front().queued + delay;
+                if (!next || due < nextDue)
+                {
+                    next = &queue;
+                    nextDue = due;
+                }
+            }
+            delay += aging;
+        }
+        auto request = std::move(next->front());
+        next->pop_front();
+        return request;
+    }
+
+    /** @brief Remove a queued request
+     *
+     *  @param[in] key - key of the request
+     *
+     *  @return true if the request was queued
+     */
+    bool erase(const RequestKey& key)
+    {
+        for (auto& queue : requestQueues)
+        {
+            auto it = std::ranges::find(queue, key, &RegisteredRequest::key);
+            if (it != queue.end())
+            {
+                queue.erase(it);
+                return true;
+            }
+        }
+        return false;
+    }
 };
 
 /** @class Handler
@@ -137,6 +367,8 @@ class Handler
      *  @param[in] instanceIdExpiryInterval - instance ID expiration interval
      *  @param[in] numRetries - number of request retries
      *  @param[in] responseTimeOut - time to wait between each retry
+     *  @param[in] windowSize - default number of requests that may be in
+     *                          flight to one endpoint
      */
     explicit Handler(
         PldmTransport* pldmTransport, sdeventplus::Event& event,
@@ -145,11 +377,103 @@ class Handler
             std::chrono::seconds(INSTANCE_ID_EXPIRATION_INTERVAL),
         uint8_t numRetries = static_cast<uint8_t>(NUMBER_OF_REQUEST_RETRIES),
         std::chrono::milliseconds responseTimeOut =
-            std::chrono::milliseconds(RESPONSE_TIME_OUT)) :
+            std::chrono::milliseconds(RESPONSE_TIME_OUT),
+        uint8_t windowSize = static_cast<uint8_t>(REQUEST_WINDOW_SIZE)) :
         pldmTransport(pldmTransport), event(event), instanceIdDb(instanceIdDb),
         verbose(verbose), instanceIdExpiryInterval(instanceIdExpiryInterval),
-        numRetries(numRetries), responseTimeOut(responseTimeOut)
-    {}
+        numRetries(numRetries), responseTimeOut(responseTimeOut),
+        windowSize(std::clamp<uint8_t>(windowSize, 1, maxRequestWindowSize))
+    {
+        // A GetPDR may have to assemble a large record, do not let fast small
+        // commands to the same endpoint shrink its timeout
+        setCommandTimeout(PLDM_PLATFORM, PLDM_GET_PDR, responseTimeOut);
+
+        // Discovery and sensor polling may read the same data of an endpoint
+        // at once, these reads have no side effect
+        enableCoalescing(PLDM_BASE, PLDM_GET_TID);
+        enableCoalescing(PLDM_BASE, PLDM_GET_PLDM_VERSION);
+        enableCoalescing(PLDM_BASE, PLDM_GET_PLDM_TYPES);
+        enableCoalescing(PLDM_BASE, PLDM_GET_PLDM_COMMANDS);
+        enableCoalescing(PLDM_PLATFORM, PLDM_GET_SENSOR_READING);
+        enableCoalescing(PLDM_PLATFORM, PLDM_GET_STATE_SENSOR_READINGS);
+    }
+
+    /** @brief Set a lower bound on the response timeout of a command
+     *
+     *  The response timeout of a request is derived from the response times
+     *  observed on its endpoint. Commands known to be slow can be kept from
+     *  using a timeout shorter than timeout.
+     *
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     *  @param[in] timeout - minimum time to wait before retrying
+     */
+    void setCommandTimeout(uint8_t type, uint8_t command,
+                           std::chrono::milliseconds timeout)
+    {
+        commandTimeouts[{type, command}] = timeout;
+    }
+
+    /** @brief Let the requests of an idempotent command share a transaction
+     *
+     *  A request of the command registered while an identical one, same
+     *  endpoint and same message but for the instance ID, is queued or in
+     *  flight does not go on the bus. It gets the response of the other
+     *  request, carrying the instance ID of that request. Its own instance
+     *  ID stays allocated until then for its key to remain unique.
+     *
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     */
+    void enableCoalescing(uint8_t type, uint8_t command)
+    {
+        coalescableCommands.emplace(type, command);
+    }
+
+    /** @brief Get the time to wait for a response before retrying a request
+     *
+     *  Until responses were observed on the endpoint the configured response
+     *  timeout is used. Afterwards it is smoothed response time plus four
+     *  deviations, bounded by minAdaptiveResponseTimeOut, or the configured
+     *  response timeout when shorter, and the instance ID expiration
+     *  interval. Each retry doubles the wait.
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] type - PLDM type
+     *  @param[in] command - PLDM command
+     *
+     *  @return the initial response timeout
+     */
+    std::chrono::milliseconds getResponseTimeOut(mctp_eid_t eid, uint8_t type,
+                                                 uint8_t command)
+    {
+        // A fast endpoint never waits longer than configured
+        auto timeout = getEndpointQueue(eid).responseTime.timeout(
+            responseTimeOut,
+            std::min(minAdaptiveResponseTimeOut, responseTimeOut),
+            getMaxResponseTimeOut());
+        if (auto it = commandTimeouts.find({type, command});
+            it != commandTimeouts.end())
+        {
+            timeout = std::max(timeout, it->second);
+        }
+        return timeout;
+    }
+
+    /** @brief Set the number of requests that may be in flight to an endpoint
+     *
+     *  Requests beyond the window wait in the endpoint queue and go out as
+     *  responses for earlier requests arrive or time out.
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] size - window size, clamped to [1, maxRequestWindowSize]
+     */
+    void setEndpointWindowSize(mctp_eid_t eid, uint8_t size)
+    {
+        getEndpointQueue(eid).windowSize =
+            std::clamp<uint8_t>(size, 1, maxRequestWindowSize);
+        pollEndpointQueue(eid);
+    }
 
     void instanceIdExpiryCallBack(RequestKey key)
     {
@@ -162,6 +486,11 @@ class Handler
             auto& [request, responseHandler,
                    timerInstance] = this->handlers[key];
             request->stop();
+            PLDM_TRACE_ASYNC("request.timeout", "requester",
+                             request->getSendTime(), key.eid);
+            auto& requestStats = getStats(key);
+            requestStats.timedOut++;
+            requestStats.retried += request->getRetryCount();
             auto rc = timerInstance->stop();
             if (rc)
             {
@@ -176,10 +505,7 @@ class Handler
                 key,
                 std::make_unique<sdeventplus::source::Defer>(
                     event, std::bind(&Handler::removeRequestEntry, this, key)));
-            endpointMessageQueues[eid]->activeRequest = false;
-
-            /* try to send new request if the endpoint is free */
-            pollEndpointQueue(eid);
+            releaseWindowSlot(eid);
         }
         else
         {
@@ -191,60 +517,27 @@ class Handler
     }
 
     /** @brief Send the remaining PLDM request messages in endpoint queue
+     *
+     *  Requests are sent until the endpoint's in-flight window is full.
      *
      *  @param[in] eid - endpoint ID of the remote MCTP endpoint
      */
     int pollEndpointQueue(mctp_eid_t eid)
     {
-        if (endpointMessageQueues[eid]->activeRequest ||
-            endpointMessageQueues[eid]->requestQueue.empty())
-        {
-            return PLDM_SUCCESS;
-        }
-
-        endpointMessageQueues[eid]->activeRequest = true;
-        auto requestMsg = endpointMessageQueues[eid]->requestQueue.front();
-        endpointMessageQueues[eid]->requestQueue.pop_front();
-
-        auto request = std::make_unique<RequestInterface>(
-            pldmTransport, requestMsg->key.eid, event,
-            std::move(requestMsg->reqMsg), numRetries, responseTimeOut,
-            verbose);
-        auto timer = std::make_unique<sdbusplus::Timer>(
-            event.get(), std::bind(&Handler::instanceIdExpiryCallBack, this,
-                                   requestMsg->key));
-
-        auto rc = request->start();
-        if (rc)
-        {
-            instanceIdDb.free(requestMsg->key.eid, requestMsg->key.instanceId);
-            error(
-                "Failure to send the PLDM request message for polling endpoint queue, response code '{RC}'",
-                "RC", rc);
-            endpointMessageQueues[eid]->activeRequest = false;
-            return rc;
-        }
-
-        try
-        {
-            timer->start(duration_cast<std::chrono::microseconds>(
-                instanceIdExpiryInterval));
-        }
-        catch (const std::runtime_error& e)
+        auto& endpoint = getEndpointQueue(eid);
+        int rc = PLDM_SUCCESS;
+        while (endpoint.inFlight < endpoint.windowSize && !endpoint.empty())
         {
-            instanceIdDb.free(requestMsg->key.eid, requestMsg->key.instanceId);
-            error(
-                "Failed to start the instance ID expiry timer, error - {ERROR}",
-                "ERROR", e);
-            endpointMessageQueues[eid]->activeRequest = false;
-            return PLDM_ERROR;
+            auto requestMsg = endpoint.pop(priorityAging);
+            auto sendRc = sendRequest(requestMsg);
+            if (sendRc)
+            {
+                rc = sendRc;
+                continue;
+            }
+            endpoint.inFlight++;
         }
-
-        handlers.emplace(requestMsg->key,
-                         std::make_tuple(std::move(request),
-                                         std::move(requestMsg->responseHandler),
-                                         std::move(timer)));
-        return PLDM_SUCCESS;
+        return rc;
     }
 
     /** @brief Register a PLDM request message
@@ -255,12 +548,15 @@ class Handler
      *  @param[in] command - PLDM command
      *  @param[in] requestMsg - PLDM request message
      *  @param[in] responseHandler - Response handler for this request
+     *  @param[in] priority - class the request is queued in, by default the
+     *                        class of its command, see requestPriority()
      *
      *  @return return PLDM_SUCCESS on success and PLDM_ERROR otherwise
      */
-    int registerRequest(mctp_eid_t eid, uint8_t instanceId, uint8_t type,
-                        uint8_t command, pldm::Request&& requestMsg,
-                        ResponseHandler&& responseHandler)
+    int registerRequest(
+        mctp_eid_t eid, uint8_t instanceId, uint8_t type, uint8_t command,
+        pldm::RequestMsg&& requestMsg, ResponseHandler&& responseHandler,
+        std::optional<RequestPriority> priority = std::nullopt)
     {
         RequestKey key{eid, instanceId, type, command};
 
@@ -272,21 +568,18 @@ class Handler
             return PLDM_ERROR;
         }
 
-        auto inputRequest = std::make_shared<RegisteredRequest>(
-            key, std::move(requestMsg), std::move(responseHandler));
-        if (endpointMessageQueues.contains(eid))
+        if (coalescableCommands.contains({type, command}) &&
+            coalesce(key, requestMsg, responseHandler))
         {
-            endpointMessageQueues[eid]->requestQueue.push_back(inputRequest);
-        }
-        else
-        {
-            std::deque<std::shared_ptr<RegisteredRequest>> reqQueue;
-            reqQueue.push_back(inputRequest);
-            endpointMessageQueues[eid] =
-                std::make_shared<EndpointMessageQueue>(eid, reqQueue, false);
+            return PLDM_SUCCESS;
         }
 
-        /* try to send new request if the endpoint is free */
+        getEndpointQueue(eid).push(RegisteredRequest{
+            key, std::move(requestMsg), std::move(responseHandler),
+            priority.value_or(requestPriority(type, command)),
+            std::chrono::steady_clock::now()});
+
+        /* try to send new request if the endpoint window has room */
         pollEndpointQueue(eid);
 
         return PLDM_SUCCESS;
@@ -306,6 +599,30 @@ class Handler
     {
         RequestKey key{eid, instanceId, type, command};
 
+        /* A coalesced request goes on while other requests wait for it */
+        for (auto it = coalesced.begin(); it != coalesced.end(); ++it)
+        {
+            auto& waiters = it->second.waiters;
+            auto waiter = std::ranges::find(waiters, key,
+                                            &CoalescedWaiter::first);
+            if (waiter == waiters.end())
+            {
+                continue;
+            }
+            waiters.erase(waiter);
+            if (key != it->first)
+            {
+                instanceIdDb.free(key.eid, key.instanceId);
+            }
+            if (!waiters.empty())
+            {
+                return PLDM_SUCCESS;
+            }
+            key = it->first;
+            coalesced.erase(it);
+            break;
+        }
+
         /* handlers only contain key when the message is already sent */
         if (handlers.contains(key))
         {
@@ -321,9 +638,7 @@ class Handler
 
             instanceIdDb.free(key.eid, key.instanceId);
             handlers.erase(key);
-            endpointMessageQueues[eid]->activeRequest = false;
-            /* try to send new request if the endpoint is free */
-            pollEndpointQueue(eid);
+            releaseWindowSlot(eid);
 
             return PLDM_SUCCESS;
         }
@@ -336,22 +651,11 @@ class Handler
                     "EID", (unsigned)eid, "INSTANCEID", (unsigned)instanceId);
                 return PLDM_ERROR;
             }
-            auto requestMsg = endpointMessageQueues[eid]->requestQueue;
-            /* Find the registered request in the requestQueue */
-            for (auto it = requestMsg.begin(); it != requestMsg.end();)
+            /* Find the registered request in the request queues */
+            if (endpointMessageQueues[eid]->erase(key))
             {
-                auto msg = *it;
-                if (msg->key == key)
-                {
-                    // erase and get the next valid iterator
-                    it = endpointMessageQueues[eid]->requestQueue.erase(it);
-                    instanceIdDb.free(key.eid, key.instanceId);
-                    return PLDM_SUCCESS;
-                }
-                else
-                {
-                    ++it; // increment iterator only if not erasing
-                }
+                instanceIdDb.free(key.eid, key.instanceId);
+                return PLDM_SUCCESS;
             }
         }
 
@@ -383,13 +687,27 @@ class Handler
                     "Failed to stop the instance ID expiry timer, response code '{RC}'",
                     "RC", rc);
             }
+            PLDM_TRACE_ASYNC("request", "requester", request->getSendTime(),
+                             key.eid);
+            auto& requestStats = getStats(key);
+            requestStats.retried += request->getRetryCount();
+            requestStats.addResponse(std::chrono::steady_clock::now() -
+                                     request->getSendTime());
+
+            // A response to a retried request can't be attributed to one of
+            // the attempts, only sample requests answered at the first try
+            if (!request->getRetryCount())
+            {
+                getEndpointQueue(eid).responseTime.update(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() -
+                        request->getSendTime()));
+            }
             responseHandler(eid, response, respMsgLen);
             instanceIdDb.free(key.eid, key.instanceId);
             handlers.erase(key);
 
-            endpointMessageQueues[eid]->activeRequest = false;
-            /* try to send new request if the endpoint is free */
-            pollEndpointQueue(eid);
+            releaseWindowSlot(eid);
         }
         else
         {
@@ -408,7 +726,28 @@ class Handler
      *          Return [PLDM_SUCCESS, resp, len] if succeeded
      */
     stdexec::sender_of<stdexec::set_value_t(SendRecvCoResp)> auto sendRecvMsg(
-        mctp_eid_t eid, pldm::Request&& request);
+        mctp_eid_t eid, pldm::RequestMsg&& request,
+        std::optional<RequestPriority> priority = std::nullopt);
+
+    /** @brief Set the delay by which a request class yields to the class
+     *         above it
+     *
+     *  @param[in] aging - the delay, 0 sends the queued requests in the
+     *                     order they were registered
+     */
+    void setPriorityAging(std::chrono::milliseconds aging)
+    {
+        priorityAging = aging;
+    }
+
+    /** @brief Get the request statistics
+     *
+     *  @return statistics of every (EID, type, command) requested so far
+     */
+    const RequestStatsMap& getStats() const
+    {
+        return stats;
+    }
 
   private:
     PldmTransport* pldmTransport; //!< PLDM transport object
@@ -420,6 +759,9 @@ class Handler
     uint8_t numRetries;               //!< number of request retries
     std::chrono::milliseconds
         responseTimeOut;              //!< time to wait between each retry
+    uint8_t windowSize; //!< default in-flight window of new endpoints
+    std::chrono::milliseconds priorityAging{
+        REQUEST_PRIORITY_AGING_MS}; //!< see setPriorityAging()
 
     /** @brief Container for storing the details of the PLDM request
      *         message, handler for the corresponding PLDM response and the
@@ -436,6 +778,137 @@ class Handler
     /** @brief Container for storing the PLDM request entries */
     std::unordered_map<RequestKey, RequestValue, RequestKeyHasher> handlers;
 
+    /** @brief Counters of the requests sent */
+    RequestStatsMap stats;
+
+    /** @brief Minimum response timeouts by (PLDM type, PLDM command) */
+    std::map<std::pair<uint8_t, uint8_t>, std::chrono::milliseconds>
+        commandTimeouts;
+
+    /** @brief Commands whose identical requests share a transaction, by
+     *         (PLDM type, PLDM command)
+     */
+    std::set<std::pair<uint8_t, uint8_t>> coalescableCommands;
+
+    /** @brief A request waiting for a coalesced request, by its own key */
+    using CoalescedWaiter = std::pair<RequestKey, ResponseHandler>;
+
+    /** @struct CoalescedRequest
+     *
+     *  A queued or in-flight request of a coalescable command and the
+     *  requests waiting for its response, itself included.
+     */
+    struct CoalescedRequest
+    {
+        std::vector<uint8_t> message; //!< the request, from the PLDM type on
+        std::vector<CoalescedWaiter> waiters;
+    };
+
+    /** @brief Coalesced requests, by the key of the request on the bus */
+    std::unordered_map<RequestKey, CoalescedRequest, RequestKeyHasher>
+        coalesced;
+
+    /** @brief Join an identical request queued or in flight, or make the
+     *         request one others may join
+     *
+     *  @param[in] key - key of the request
+     *  @param[in] requestMsg - PLDM request message
+     *  @param[in,out] responseHandler - response handler of the request,
+     *                                   taken over
+     *
+     *  @return true if the request joined another one and is not sent
+     */
+    bool coalesce(const RequestKey& key, const pldm::RequestMsg& requestMsg,
+                  ResponseHandler& responseHandler)
+    {
+        // The instance ID in the first byte differs between the requests
+        auto message = std::span(requestMsg.data(), requestMsg.size())
+                           .subspan(std::min<size_t>(1, requestMsg.size()));
+        for (auto& [busKey, request] : coalesced)
+        {
+            if (busKey.eid == key.eid && busKey.type == key.type &&
+                busKey.command == key.command &&
+                std::ranges::equal(request.message, message))
+            {
+                request.waiters.emplace_back(key, std::move(responseHandler));
+                return true;
+            }
+        }
+
+        auto& request = coalesced[key];
+        request.message.assign(message.begin(), message.end());
+        request.waiters.emplace_back(key, std::move(responseHandler));
+        responseHandler = [this, key](mctp_eid_t eid, const pldm_msg* response,
+                                      size_t respMsgLen) {
+            completeCoalesced(key, eid, response, respMsgLen);
+        };
+        return false;
+    }
+
+    /** @brief Pass the response of a coalesced request to its waiters
+     *
+     *  @param[in] key - key of the request on the bus
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     *  @param[in] response - PLDM response message, nullptr if none
+     *  @param[in] respMsgLen - length of the response message
+     */
+    void completeCoalesced(const RequestKey& key, mctp_eid_t eid,
+                           const pldm_msg* response, size_t respMsgLen)
+    {
+        // Waiters may register requests from their handler
+        auto node = coalesced.extract(key);
+        if (node.empty())
+        {
+            return;
+        }
+        for (auto& [waiterKey, handler] : node.mapped().waiters)
+        {
+            handler(eid, response, respMsgLen);
+            if (waiterKey != key)
+            {
+                instanceIdDb.free(waiterKey.eid, waiterKey.instanceId);
+            }
+        }
+    }
+
+    /** @brief Coalesced requests which could not be sent, their waiters get
+     *         an empty response once the event loop runs again
+     */
+    std::unordered_map<RequestKey, std::unique_ptr<sdeventplus::source::Defer>,
+                       RequestKeyHasher>
+        failedCoalesced;
+
+    /** @brief Fail the waiters of a coalesced request which could not be
+     *         sent
+     *
+     *  The send may fail within registerRequest, the waiters are called back
+     *  from the event loop so that none completes before it returned.
+     *
+     *  @param[in] key - key of the request
+     */
+    void failCoalesced(const RequestKey& key)
+    {
+        if (!coalesced.contains(key) || failedCoalesced.contains(key))
+        {
+            return;
+        }
+        failedCoalesced.emplace(
+            key, std::make_unique<sdeventplus::source::Defer>(
+                     event, std::bind(&Handler::removeFailedCoalesced, this,
+                                      key)));
+    }
+
+    /** @brief Call back the waiters of a coalesced request which could not
+     *         be sent with an empty response
+     *
+     *  @param[in] key - key of the request
+     */
+    void removeFailedCoalesced(RequestKey key)
+    {
+        failedCoalesced.erase(key);
+        completeCoalesced(key, key.eid, nullptr, 0);
+    }
+
     /** @brief Container to store information about the request entries to be
      *         removed after the instance ID timer expires
      */
@@ -443,6 +916,111 @@ class Handler
                        RequestKeyHasher>
         removeRequestContainer;
 
+    /** @brief Get the statistics entry of a request
+     *
+     *  @param[in] key - key for the Request
+     */
+    RequestStats& getStats(const RequestKey& key)
+    {
+        return stats[{key.eid, key.type, key.command}];
+    }
+
+    /** @brief Get the message queue of an endpoint, creating it on first use
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     */
+    EndpointMessageQueue& getEndpointQueue(mctp_eid_t eid)
+    {
+        auto& endpoint = endpointMessageQueues[eid];
+        if (!endpoint)
+        {
+            endpoint = std::make_shared<EndpointMessageQueue>(
+                eid,
+                std::array<std::deque<RegisteredRequest>, requestPriorities>{},
+                0, windowSize);
+        }
+        return *endpoint;
+    }
+
+    /** @brief Account for a request that left the in-flight window and send
+     *         the next queued requests
+     *
+     *  @param[in] eid - endpoint ID of the remote MCTP endpoint
+     */
+    void releaseWindowSlot(mctp_eid_t eid)
+    {
+        auto& endpoint = getEndpointQueue(eid);
+        if (endpoint.inFlight)
+        {
+            endpoint.inFlight--;
+        }
+        /* try to send new request if the endpoint window has room */
+        pollEndpointQueue(eid);
+    }
+
+    /** @brief Start the request flow of a request taken off the queue
+     *
+     *  @param[in] requestMsg - the registered request
+     *
+     *  @return PLDM_SUCCESS if the request is in flight
+     */
+    int sendRequest(RegisteredRequest& requestMsg)
+    {
+        const auto& key = requestMsg.key;
+        auto request = std::make_unique<RequestInterface>(
+            pldmTransport, key.eid, event, std::move(requestMsg.reqMsg),
+            numRetries, getResponseTimeOut(key.eid, key.type, key.command),
+            verbose);
+        request->setRetryBackoff(getMaxResponseTimeOut());
+        request->setRetryDeadline(getMaxResponseTimeOut());
+        getStats(key).sent++;
+        PLDM_TRACE_INSTANT("request.send", "requester", key.eid);
+        auto timer = std::make_unique<sdbusplus::Timer>(
+            event.get(), std::bind(&Handler::instanceIdExpiryCallBack, this,
+                                   requestMsg.key));
+
+        auto rc = request->start();
+        if (rc)
+        {
+            instanceIdDb.free(requestMsg.key.eid, requestMsg.key.instanceId);
+            failCoalesced(key);
+            error(
+                "Failure to send the PLDM request message for polling endpoint queue, response code '{RC}'",
+                "RC", rc);
+            return rc;
+        }
+
+        try
+        {
+            timer->start(duration_cast<std::chrono::microseconds>(
+                instanceIdExpiryInterval));
+        }
+        catch (const std::runtime_error& e)
+        {
+            instanceIdDb.free(requestMsg.key.eid, requestMsg.key.instanceId);
+            failCoalesced(key);
+            error(
+                "Failed to start the instance ID expiry timer, error - {ERROR}",
+                "ERROR", e);
+            return PLDM_ERROR;
+        }
+
+        handlers.emplace(requestMsg.key,
+                         std::make_tuple(std::move(request),
+                                         std::move(requestMsg.responseHandler),
+                                         std::move(timer)));
+        return PLDM_SUCCESS;
+    }
+
+    /** @brief Upper bound of a response timeout, a retry after the instance
+     *         ID expired is pointless
+     */
+    std::chrono::milliseconds getMaxResponseTimeOut() const
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            instanceIdExpiryInterval);
+    }
+
     /** @brief Remove request entry for which the instance ID expired
      *
      *  @param[in] key - key for the Request
@@ -472,9 +1050,11 @@ struct SendRecvMsgOperation
     SendRecvMsgOperation() = delete;
 
     explicit SendRecvMsgOperation(Handler<RequestInterface>& handler,
-                                  mctp_eid_t eid, pldm::Request&& request,
+                                  mctp_eid_t eid, pldm::RequestMsg&& request,
+                                  std::optional<RequestPriority> priority,
                                   R&& r) :
-        handler(handler), request(std::move(request)), receiver(std::move(r))
+        handler(handler), request(std::move(request)), priority(priority),
+        receiver(std::move(r))
     {
         auto requestMsg =
             reinterpret_cast<const pldm_msg*>(this->request.data());
@@ -507,11 +1087,17 @@ struct SendRecvMsgOperation
             return stdexec::set_stopped(std::move(op.receiver));
         }
 
-        using namespace std::placeholders;
+        // Capturing only the operation keeps the handler within the small
+        // buffer of std::function, the operation lives in the awaiting
+        // coroutine frame so nothing is allocated per request
         auto rc = op.handler.registerRequest(
             op.requestKey.eid, op.requestKey.instanceId, op.requestKey.type,
             op.requestKey.command, std::move(op.request),
-            std::bind(&SendRecvMsgOperation::onComplete, &op, _1, _2, _3));
+            [&op](mctp_eid_t eid, const pldm_msg* response,
+                  size_t respMsgLen) {
+                op.onComplete(eid, response, respMsgLen);
+            },
+            op.priority);
         if (rc)
         {
             return stdexec::set_value(std::move(op.receiver), rc,
@@ -521,9 +1107,7 @@ struct SendRecvMsgOperation
 
         if (stopToken.stop_possible())
         {
-            op.stopCallback.emplace(
-                std::move(stopToken),
-                std::bind(&SendRecvMsgOperation::onStop, &op));
+            op.stopCallback.emplace(std::move(stopToken), StopRequest{&op});
         }
     }
 
@@ -560,6 +1144,17 @@ struct SendRecvMsgOperation
     }
 
   private:
+    /** @brief Stop callback of the operation, small enough to not allocate */
+    struct StopRequest
+    {
+        SendRecvMsgOperation* op;
+
+        void operator()() noexcept
+        {
+            op->onStop();
+        }
+    };
+
     /** @brief Reference to a Handler object that manages the request/response
      *         logic.
      */
@@ -572,7 +1167,11 @@ struct SendRecvMsgOperation
 
     /** @brief The request message to be sent.
      */
-    pldm::Request request;
+    pldm::RequestMsg request;
+
+    /** @brief Class the request is queued in, by default its command's
+     */
+    std::optional<RequestPriority> priority;
 
     /** @brief The response message for the sent request message.
      */
@@ -590,7 +1189,7 @@ struct SendRecvMsgOperation
      *         requested.
      */
     std::optional<typename stdexec::stop_token_of_t<
-        stdexec::env_of_t<R>>::template callback_type<std::function<void()>>>
+        stdexec::env_of_t<R>>::template callback_type<StopRequest>>
         stopCallback = std::nullopt;
 };
 
@@ -608,8 +1207,10 @@ struct SendRecvMsgSender
     SendRecvMsgSender() = delete;
 
     explicit SendRecvMsgSender(requester::Handler<RequestInterface>& handler,
-                               mctp_eid_t eid, pldm::Request&& request) :
-        handler(handler), eid(eid), request(std::move(request))
+                               mctp_eid_t eid, pldm::RequestMsg&& request,
+                               std::optional<RequestPriority> priority) :
+        handler(handler), eid(eid), request(std::move(request)),
+        priority(priority)
     {}
 
     friend auto tag_invoke(stdexec::get_completion_signatures_t,
@@ -623,7 +1224,8 @@ struct SendRecvMsgSender
     friend auto tag_invoke(stdexec::connect_t, SendRecvMsgSender&& self, R r)
     {
         return SendRecvMsgOperation<RequestInterface, R>(
-            self.handler, self.eid, std::move(self.request), std::move(r));
+            self.handler, self.eid, std::move(self.request), self.priority,
+            std::move(r));
     }
 
   private:
@@ -636,13 +1238,18 @@ struct SendRecvMsgSender
     mctp_eid_t eid;
 
     /** @brief Request message */
-    pldm::Request request;
+    pldm::RequestMsg request;
+
+    /** @brief Class the request is queued in */
+    std::optional<RequestPriority> priority;
 };
 
 /** @brief Wrap registerRequest with coroutine API.
  *
  *  @param[in] eid - endpoint ID of the remote MCTP endpoint
  *  @param[in] request - PLDM request message
+ *  @param[in] priority - class the request is queued in, by default the
+ *                        class of its command
  *
  *  @return Return [PLDM_ERROR, _, _] if registerRequest fails.
  *          Return [PLDM_ERROR_NOT_READY, nullptr, 0] if timed out.
@@ -650,10 +1257,11 @@ struct SendRecvMsgSender
  */
 template <class RequestInterface>
 stdexec::sender_of<stdexec::set_value_t(SendRecvCoResp)> auto
-    Handler<RequestInterface>::sendRecvMsg(mctp_eid_t eid,
-                                           pldm::Request&& request)
+    Handler<RequestInterface>::sendRecvMsg(
+        mctp_eid_t eid, pldm::RequestMsg&& request,
+        std::optional<RequestPriority> priority)
 {
-    return SendRecvMsgSender(*this, eid, std::move(request)) |
+    return SendRecvMsgSender(*this, eid, std::move(request), priority) |
            stdexec::then([](int rc, const pldm_msg* resp, size_t respLen) {
                return std::make_tuple(rc, resp, respLen);
            });
@@ -10,9 +10,12 @@
 #include <phosphor-logging/lg2.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <optional>
+#include <set>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -25,7 +28,8 @@ namespace pldm
 {
 MctpDiscovery::MctpDiscovery(
     sdbusplus::bus_t& bus,
-    std::initializer_list<MctpDiscoveryHandlerIntf*> list) :
+    std::initializer_list<MctpDiscoveryHandlerIntf*> list,
+    MctpEndpointFilter filter) :
     bus(bus), mctpEndpointAddedSignal(
                   bus, interfacesAdded(MCTPPath),
                   std::bind_front(&MctpDiscovery::discoverEndpoints, this)),
@@ -35,7 +39,7 @@ MctpDiscovery::MctpDiscovery(
     mctpEndpointPropChangedSignal(
         bus, propertiesChangedNamespace(MCTPPath, MCTPInterfaceCC),
         std::bind_front(&MctpDiscovery::propertiesChangedCb, this)),
-    handlers(list)
+    handlers(list), filter(std::move(filter))
 {
     std::map<MctpInfo, Availability> currentMctpInfoMap;
     getMctpInfos(currentMctpInfoMap);
@@ -69,28 +73,119 @@ void MctpDiscovery::getMctpInfos(std::map<MctpInfo, Availability>& mctpInfoMap)
         return;
     }
 
-    for (const auto& [path, services] : mapperResponse)
+    std::set<std::string> services;
+    for (const auto& [path, serviceMap] : mapperResponse)
     {
-        for (const auto& serviceIter : services)
+        for (const auto& [service, interfaces] : serviceMap)
         {
-            const std::string& service = serviceIter.first;
-            const MctpEndpointProps& epProps =
-                getMctpEndpointProps(service, path);
-            const UUID& uuid = getEndpointUUIDProp(service, path);
-            const Availability& availability =
-                getEndpointConnectivityProp(path);
-            auto types = std::get<MCTPMsgTypes>(epProps);
-            if (std::find(types.begin(), types.end(), mctpTypePLDM) !=
-                types.end())
+            services.emplace(service);
+        }
+    }
+
+    endpoints.clear();
+    for (const auto& service : services)
+    {
+        pldm::utils::ObjectValueTree objects;
+        try
+        {
+            objects = pldm::utils::DBusHandler::getManagedObj(service.c_str(),
+                                                              MCTPPath);
+        }
+        catch (const sdbusplus::exception_t& e)
+        {
+            error(
+                "Failed to get managed objects of service '{SERVICE}' at path '{PATH}', reading endpoints one by one, error - {ERROR}",
+                "SERVICE", service, "PATH", MCTPPath, "ERROR", e);
+            for (const auto& [path, serviceMap] : mapperResponse)
             {
-                mctpInfoMap[MctpInfo(std::get<eid>(epProps), uuid, "",
-                                     std::get<NetworkId>(epProps))] =
-                    availability;
+                if (!std::ranges::any_of(serviceMap, [&service](
+                                                         const auto& entry) {
+                        return entry.first == service;
+                    }))
+                {
+                    continue;
+                }
+                const MctpEndpointProps& epProps =
+                    getMctpEndpointProps(service, path);
+                auto types = std::get<MCTPMsgTypes>(epProps);
+                if (!std::ranges::contains(types, mctpTypePLDM))
+                {
+                    continue;
+                }
+                MctpInfo mctpInfo(std::get<eid>(epProps),
+                                  getEndpointUUIDProp(service, path), "",
+                                  std::get<NetworkId>(epProps));
+                if (!filter.claims(mctpInfo))
+                {
+                    continue;
+                }
+                endpoints[path] = mctpInfo;
+                mctpInfoMap[mctpInfo] = getEndpointConnectivityProp(path);
+            }
+            continue;
+        }
+
+        for (const auto& [path, interfaces] : objects)
+        {
+            auto endpoint = getEndpointInfo(interfaces);
+            if (endpoint && filter.claims(endpoint->first))
+            {
+                endpoints[path.str] = endpoint->first;
+                mctpInfoMap[endpoint->first] = endpoint->second;
             }
         }
     }
 }
 
+std::optional<std::pair<MctpInfo, Availability>> MctpDiscovery::getEndpointInfo(
+    const pldm::utils::InterfaceMap& interfaces)
+{
+    auto endpointIntf = interfaces.find(MCTPInterface);
+    if (endpointIntf == interfaces.end())
+    {
+        return std::nullopt;
+    }
+
+    const auto& properties = endpointIntf->second;
+    if (!properties.contains("NetworkId") || !properties.contains("EID") ||
+        !properties.contains("SupportedMessageTypes"))
+    {
+        return std::nullopt;
+    }
+
+    auto networkId = std::get_if<NetworkId>(&properties.at("NetworkId"));
+    auto eid = std::get_if<mctp_eid_t>(&properties.at("EID"));
+    auto types = std::get_if<MCTPMsgTypes>(
+        &properties.at("SupportedMessageTypes"));
+    if (!networkId || !eid || !types ||
+        !std::ranges::contains(*types, mctpTypePLDM))
+    {
+        return std::nullopt;
+    }
+
+    UUID uuid = emptyUUID;
+    auto uuidIntf = interfaces.find(EndpointUUID);
+    if (uuidIntf != interfaces.end() && uuidIntf->second.contains("UUID"))
+    {
+        if (auto value = std::get_if<UUID>(&uuidIntf->second.at("UUID")))
+        {
+            uuid = *value;
+        }
+    }
+
+    Availability availability = false;
+    auto connectivityIntf = interfaces.find(MCTPInterfaceCC);
+    if (connectivityIntf != interfaces.end() &&
+        connectivityIntf->second.contains(MCTPConnectivityProp))
+    {
+        auto value = std::get_if<std::string>(
+            &connectivityIntf->second.at(MCTPConnectivityProp));
+        availability = value && *value == "Available";
+    }
+
+    return std::make_pair(MctpInfo(*eid, uuid, "", *networkId), availability);
+}
+
 MctpEndpointProps MctpDiscovery::getMctpEndpointProps(
     const std::string& service, const std::string& path)
 {
@@ -170,12 +265,8 @@ Availability MctpDiscovery::getEndpointConnectivityProp(const std::string& path)
 void MctpDiscovery::getAddedMctpInfos(sdbusplus::message_t& msg,
                                       MctpInfos& mctpInfos)
 {
-    using ObjectPath = sdbusplus::message::object_path;
-    ObjectPath objPath;
-    using Property = std::string;
-    using PropertyMap = std::map<Property, dbus::Value>;
-    std::map<std::string, PropertyMap> interfaces;
-    std::string uuid = emptyUUID;
+    sdbusplus::message::object_path objPath;
+    pldm::utils::InterfaceMap interfaces;
 
     try
     {
@@ -188,54 +279,28 @@ void MctpDiscovery::getAddedMctpInfos(sdbusplus::message_t& msg,
             "ERROR", e);
         return;
     }
-    const Availability& availability = getEndpointConnectivityProp(objPath.str);
 
-    /* Get UUID */
-    try
-    {
-        auto service = pldm::utils::DBusHandler().getService(
-            objPath.str.c_str(), EndpointUUID);
-        uuid = getEndpointUUIDProp(service, objPath.str);
-    }
-    catch (const sdbusplus::exception_t& e)
+    // The signal carries every interface of the endpoint object, UUID and
+    // Connectivity included
+    auto endpoint = getEndpointInfo(interfaces);
+    if (!endpoint || !filter.claims(endpoint->first))
     {
-        error("Error getting Endpoint UUID D-Bus interface, error - {ERROR}",
-              "ERROR", e);
+        return;
     }
 
-    for (const auto& [intfName, properties] : interfaces)
+    const auto& [mctpInfo, availability] = *endpoint;
+    if (!availability)
     {
-        if (intfName == MCTPInterface)
-        {
-            if (properties.contains("NetworkId") &&
-                properties.contains("EID") &&
-                properties.contains("SupportedMessageTypes"))
-            {
-                auto networkId =
-                    std::get<NetworkId>(properties.at("NetworkId"));
-                auto eid = std::get<mctp_eid_t>(properties.at("EID"));
-                auto types = std::get<std::vector<uint8_t>>(
-                    properties.at("SupportedMessageTypes"));
-
-                if (!availability)
-                {
-                    // Log an error message here, but still add it to the
-                    // terminus
-                    error(
-                        "mctpd added a DEGRADED endpoint {EID} networkId {NET} to D-Bus",
-                        "NET", networkId, "EID", static_cast<unsigned>(eid));
-                }
-                if (std::find(types.begin(), types.end(), mctpTypePLDM) !=
-                    types.end())
-                {
-                    info(
-                        "Adding Endpoint networkId '{NETWORK}' and EID '{EID}' UUID '{UUID}'",
-                        "NETWORK", networkId, "EID", eid, "UUID", uuid);
-                    mctpInfos.emplace_back(MctpInfo(eid, uuid, "", networkId));
-                }
-            }
-        }
+        // Log an error message here, but still add it to the terminus
+        error("mctpd added a DEGRADED endpoint {EID} networkId {NET} to D-Bus",
+              "NET", std::get<3>(mctpInfo), "EID",
+              static_cast<unsigned>(std::get<0>(mctpInfo)));
     }
+    info("Adding Endpoint networkId '{NETWORK}' and EID '{EID}' UUID '{UUID}'",
+         "NETWORK", std::get<3>(mctpInfo), "EID", std::get<0>(mctpInfo), "UUID",
+         std::get<1>(mctpInfo));
+    endpoints[objPath.str] = mctpInfo;
+    mctpInfos.emplace_back(mctpInfo);
 }
 
 void MctpDiscovery::addToExistingMctpInfos(const MctpInfos& addedInfos)
@@ -281,7 +346,6 @@ void MctpDiscovery::propertiesChangedCb(sdbusplus::message_t& msg)
     Interface interface;
     Properties properties;
     std::string objPath{};
-    std::string service{};
 
     try
     {
@@ -303,20 +367,14 @@ void MctpDiscovery::propertiesChangedCb(sdbusplus::message_t& msg)
 
         if (key == MCTPConnectivityProp)
         {
-            service = pldm::utils::DBusHandler().getService(objPath.c_str(),
-                                                            MCTPInterface);
-            const MctpEndpointProps& epProps =
-                getMctpEndpointProps(service, objPath);
-
-            auto types = std::get<MCTPMsgTypes>(epProps);
-            if (!std::ranges::contains(types, mctpTypePLDM))
+            // Only the PLDM capable endpoints are known
+            auto endpoint = endpoints.find(objPath);
+            if (endpoint == endpoints.end())
             {
                 return;
             }
-            const UUID& uuid = getEndpointUUIDProp(service, objPath);
 
-            MctpInfo mctpInfo(std::get<eid>(epProps), uuid, "",
-                              std::get<NetworkId>(epProps));
+            const MctpInfo& mctpInfo = endpoint->second;
             if (!std::ranges::contains(existingMctpInfos, mctpInfo))
             {
                 if (availability)
@@ -328,12 +386,14 @@ void MctpDiscovery::propertiesChangedCb(sdbusplus::message_t& msg)
                         "NETWORK", std::get<3>(mctpInfo), "EID",
                         unsigned(std::get<0>(mctpInfo)));
                     addToExistingMctpInfos(MctpInfos(1, mctpInfo));
-                    handleMctpEndpoints(MctpInfos(1, mctpInfo));
+                    queueMctpEndpoints(MctpInfos(1, mctpInfo));
                 }
             }
             else
             {
-                // The endpoint already in existingMctpInfos
+                // The endpoint already in existingMctpInfos, the handlers
+                // learn of it before its availability changes
+                flushMctpEndpoints();
                 updateMctpEndpointAvailability(mctpInfo, availability);
             }
         }
@@ -345,21 +405,133 @@ void MctpDiscovery::discoverEndpoints(sdbusplus::message_t& msg)
     MctpInfos addedInfos;
     getAddedMctpInfos(msg, addedInfos);
     addToExistingMctpInfos(addedInfos);
-    handleMctpEndpoints(addedInfos);
+    queueMctpEndpoints(addedInfos);
 }
 
-void MctpDiscovery::removeEndpoints(sdbusplus::message_t&)
+void MctpDiscovery::removeEndpoints(sdbusplus::message_t& msg)
 {
+    sdbusplus::message::object_path objPath;
+    std::vector<std::string> interfaces;
     MctpInfos mctpInfos;
     MctpInfos removedInfos;
-    std::map<MctpInfo, Availability> currentMctpInfoMap;
-    getMctpInfos(currentMctpInfoMap);
-    for (const auto& mapIt : currentMctpInfoMap)
+
+    try
+    {
+        msg.read(objPath, interfaces);
+    }
+    catch (const sdbusplus::exception_t& e)
+    {
+        error(
+            "Error reading MCTP Endpoint removed interface message, resynchronizing the endpoints, error - {ERROR}",
+            "ERROR", e);
+        std::map<MctpInfo, Availability> currentMctpInfoMap;
+        getMctpInfos(currentMctpInfoMap);
+        for (const auto& mapIt : currentMctpInfoMap)
+        {
+            mctpInfos.push_back(mapIt.first);
+        }
+        removeFromExistingMctpInfos(mctpInfos, removedInfos);
+        queueRemovedMctpEndpoints(removedInfos);
+        return;
+    }
+
+    if (!std::ranges::contains(interfaces, std::string(MCTPInterface)))
+    {
+        return;
+    }
+    auto endpoint = endpoints.find(objPath.str);
+    if (endpoint == endpoints.end())
     {
-        mctpInfos.push_back(mapIt.first);
+        return;
     }
+
+    mctpInfos = existingMctpInfos;
+    std::erase(mctpInfos, endpoint->second);
+    endpoints.erase(endpoint);
     removeFromExistingMctpInfos(mctpInfos, removedInfos);
-    handleRemovedMctpEndpoints(removedInfos);
+    queueRemovedMctpEndpoints(removedInfos);
+}
+
+void MctpDiscovery::queueMctpEndpoints(const MctpInfos& mctpInfos)
+{
+    for (const auto& mctpInfo : mctpInfos)
+    {
+        if (!std::ranges::contains(pendingMctpInfos, mctpInfo))
+        {
+            pendingMctpInfos.emplace_back(mctpInfo);
+        }
+    }
+    scheduleMctpEndpoints();
+}
+
+void MctpDiscovery::scheduleMctpEndpoints()
+{
+    if (pendingMctpInfos.empty() && pendingRemovedMctpInfos.empty())
+    {
+        return;
+    }
+
+    if (!MCTP_DISCOVERY_DEBOUNCE_MS)
+    {
+        flushMctpEndpoints();
+        return;
+    }
+
+    if (!batchTimer)
+    {
+        batchTimer = std::make_unique<
+            sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>(
+            sdeventplus::Event::get_default(),
+            [this](auto&) { flushMctpEndpoints(); });
+    }
+    // The window starts with the first change, later changes join it
+    if (!batchTimer->isEnabled())
+    {
+        batchTimer->restartOnce(
+            std::chrono::milliseconds(MCTP_DISCOVERY_DEBOUNCE_MS));
+    }
+}
+
+void MctpDiscovery::queueRemovedMctpEndpoints(const MctpInfos& mctpInfos)
+{
+    for (const auto& mctpInfo : mctpInfos)
+    {
+        // The handlers never saw an endpoint still waiting to be added
+        if (std::erase(pendingMctpInfos, mctpInfo))
+        {
+            continue;
+        }
+        if (!std::ranges::contains(pendingRemovedMctpInfos, mctpInfo))
+        {
+            pendingRemovedMctpInfos.emplace_back(mctpInfo);
+        }
+    }
+
+    scheduleMctpEndpoints();
+}
+
+void MctpDiscovery::flushMctpEndpoints()
+{
+    if (batchTimer && batchTimer->isEnabled())
+    {
+        batchTimer->setEnabled(false);
+    }
+
+    MctpInfos removedInfos;
+    MctpInfos addedInfos;
+    removedInfos.swap(pendingRemovedMctpInfos);
+    addedInfos.swap(pendingMctpInfos);
+
+    if (!removedInfos.empty())
+    {
+        handleRemovedMctpEndpoints(removedInfos);
+    }
+    if (!addedInfos.empty())
+    {
+        info("Handing over a batch of {COUNT} added MCTP endpoints", "COUNT",
+             addedInfos.size());
+        handleMctpEndpoints(addedInfos);
+    }
 }
 
 void MctpDiscovery::handleMctpEndpoints(const MctpInfos& mctpInfos)
@@ -6,9 +6,17 @@
 #include <libpldm/pldm.h>
 
 #include <sdbusplus/bus/match.hpp>
+#include <sdeventplus/clock.hpp>
+#include <sdeventplus/utility/timer.hpp>
 
 #include <filesystem>
 #include <initializer_list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace pldm
@@ -45,6 +53,29 @@ class MctpDiscoveryHandlerIntf
     virtual ~MctpDiscoveryHandlerIntf() {}
 };
 
+/** @struct MctpEndpointFilter
+ *
+ *  The MCTP endpoints a pldmd instance claims, by network and EID. An empty
+ *  set of networks claims every network, an empty set of EIDs every EID.
+ */
+struct MctpEndpointFilter
+{
+    std::set<NetworkId> networks;
+    std::set<eid> eids;
+
+    /** @brief Check if an endpoint is claimed
+     *
+     *  @param[in] mctpInfo - the MCTP endpoint
+     *
+     *  @return true if the endpoint is handled by this instance
+     */
+    bool claims(const MctpInfo& mctpInfo) const
+    {
+        return (networks.empty() || networks.contains(std::get<3>(mctpInfo))) &&
+               (eids.empty() || eids.contains(std::get<0>(mctpInfo)));
+    }
+};
+
 class MctpDiscovery
 {
   public:
@@ -60,10 +91,13 @@ class MctpDiscovery
      *
      *  @param[in] bus - reference to systemd bus
      *  @param[in] list - initializer list to the MctpDiscoveryHandlerIntf
+     *  @param[in] filter - the endpoints handed over to the handlers, the
+     *                      other ones are left to the other instances
      */
     explicit MctpDiscovery(
         sdbusplus::bus_t& bus,
-        std::initializer_list<MctpDiscoveryHandlerIntf*> list);
+        std::initializer_list<MctpDiscoveryHandlerIntf*> list,
+        MctpEndpointFilter filter = {});
 
     /** @brief reference to the systemd bus */
     sdbusplus::bus_t& bus;
@@ -119,6 +153,34 @@ class MctpDiscovery
      */
     void handleRemovedMctpEndpoints(const MctpInfos& mctpInfos);
 
+    /** @brief Queue added MCTP endpoints for the registered handlers
+     *
+     *  The endpoints added and removed within the debounce window reach the
+     *  handlers in one batch, see flushMctpEndpoints().
+     *
+     *  @param[in] mctpInfos - information of discovered MCTP endpoints
+     */
+    void queueMctpEndpoints(const MctpInfos& mctpInfos);
+
+    /** @brief Queue removed MCTP endpoints for the registered handlers
+     *
+     *  An endpoint removed before its addition was handed over is dropped
+     *  from the batch instead.
+     *
+     *  @param[in] mctpInfos - information of removed MCTP endpoints
+     */
+    void queueRemovedMctpEndpoints(const MctpInfos& mctpInfos);
+
+    /** @brief Start the debounce window of the queued endpoints, or hand
+     *         them over at once without debounce
+     */
+    void scheduleMctpEndpoints();
+
+    /** @brief Hand the queued endpoints over to the registered handlers,
+     *         the removed ones first
+     */
+    void flushMctpEndpoints();
+
     /** @brief Helper function to invoke registered handlers for
      *  updating the availability status of the MCTP endpoint
      *
@@ -129,6 +191,10 @@ class MctpDiscovery
                                         Availability availability);
 
     /** @brief Get list of MctpInfos in MCTP control interface.
+     *
+     *  Takes one GetManagedObjects snapshot per MCTP service and refreshes
+     *  the endpoints known by object path, kept up to date by the signals
+     *  afterwards.
      *
      *  @param[in] mctpInfoMap - information of discovered MCTP endpoints
      *  and the availability status of each endpoint
@@ -157,6 +223,17 @@ class MctpDiscovery
                                      MctpInfos& removedInfos);
 
   private:
+    /** @brief Extract a PLDM capable endpoint from the interfaces of its
+     *         object, as published by GetManagedObjects or InterfacesAdded
+     *
+     *  @param[in] interfaces - the interfaces of the MCTP endpoint object
+     *
+     *  @return the endpoint and its availability, std::nullopt if the object
+     *          is not a PLDM capable MCTP endpoint
+     */
+    static std::optional<std::pair<MctpInfo, Availability>> getEndpointInfo(
+        const pldm::utils::InterfaceMap& interfaces);
+
     /** @brief Get MCTP Endpoint D-Bus Properties in the
      *         `xyz.openbmc_project.MCTP.Endpoint` D-Bus interface
      *
@@ -189,6 +266,23 @@ class MctpDiscovery
      */
     Availability getEndpointConnectivityProp(const std::string& path);
 
+    /** @brief The endpoints claimed by this instance */
+    const MctpEndpointFilter filter;
+
+    /** @brief The PLDM capable MCTP endpoints claimed, by object path */
+    std::map<std::string, MctpInfo> endpoints;
+
+    /** @brief Added MCTP endpoints not handed over yet */
+    MctpInfos pendingMctpInfos;
+
+    /** @brief Removed MCTP endpoints not handed over yet */
+    MctpInfos pendingRemovedMctpInfos;
+
+    /** @brief Timer closing the debounce window of the queued endpoints */
+    std::unique_ptr<
+        sdeventplus::utility::Timer<sdeventplus::ClockId::Monotonic>>
+        batchTimer;
+
     static constexpr uint8_t mctpTypePLDM = 1;
 };
 
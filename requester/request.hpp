@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/flight_recorder.hpp"
+#include "common/pldm_msg.hpp"
 #include "common/transport.hpp"
 #include "common/types.hpp"
 #include "common/utils.hpp"
@@ -12,6 +13,7 @@
 #include <sdbusplus/timer.hpp>
 #include <sdeventplus/event.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <functional>
 #include <iostream>
@@ -52,12 +54,60 @@ class RequestRetryTimer
         timer(event.get(), std::bind_front(&RequestRetryTimer::callback, this))
     {}
 
+    /** @brief Double the wait between retries, up to limit
+     *
+     *  Must be called before start(). A zero limit, the default, keeps the
+     *  wait between retries fixed.
+     *
+     *  @param[in] limit - longest wait between two retries
+     */
+    void setRetryBackoff(std::chrono::milliseconds limit)
+    {
+        backoffLimit = limit;
+    }
+
+    /** @brief Send no retry whose response could arrive after deadline
+     *
+     *  Must be called before start(). A retry is sent at least the first
+     *  timeout before deadline, the waits between retries are shortened to
+     *  fit and the retries left out once none fits. A zero deadline, the
+     *  default, keeps every retry.
+     *
+     *  @param[in] deadline - time after the first attempt the request is
+     *                        given up, the expiry of its instance ID
+     */
+    void setRetryDeadline(std::chrono::milliseconds deadline)
+    {
+        retryDeadline = deadline;
+    }
+
+    /** @brief Get the number of retries sent so far
+     *
+     *  @return number of times the request was re-sent
+     */
+    uint8_t getRetryCount() const
+    {
+        return retryCount;
+    }
+
+    /** @brief Get the time start() first sent the request
+     *
+     *  @return send time of the first attempt
+     */
+    std::chrono::steady_clock::time_point getSendTime() const
+    {
+        return sendTime;
+    }
+
     /** @brief Starts the request flow and arms the timer for request retries
      *
      *  @return return PLDM_SUCCESS on success and PLDM_ERROR otherwise
      */
     int start()
     {
+        sendTime = std::chrono::steady_clock::now();
+        firstTimeout = timeout;
+        retrySchedule = std::chrono::milliseconds(0);
         auto rc = send();
         if (rc)
         {
@@ -99,6 +149,12 @@ class RequestRetryTimer
     std::chrono::milliseconds
         timeout;            //!< time to wait between each retry in milliseconds
     sdbusplus::Timer timer; //!< manages starting timers and handling timeouts
+    std::chrono::milliseconds backoffLimit{0}; //!< see setRetryBackoff()
+    uint8_t retryCount = 0;                    //!< retries sent so far
+    std::chrono::steady_clock::time_point sendTime; //!< see getSendTime()
+    std::chrono::milliseconds retryDeadline{0}; //!< see setRetryDeadline()
+    std::chrono::milliseconds firstTimeout{0};  //!< wait after the first send
+    std::chrono::milliseconds retrySchedule{0}; //!< waits elapsed so far
 
     /** @brief Sends the PLDM request message
      *
@@ -109,13 +165,46 @@ class RequestRetryTimer
     /** @brief Callback function invoked when the timeout happens */
     void callback()
     {
-        if (numRetries--)
+        retrySchedule += timeout;
+        auto latest = retryDeadline - firstTimeout;
+        if (!numRetries || (retryDeadline.count() && retrySchedule > latest))
+        {
+            stop();
+            return;
+        }
+
+        numRetries--;
+        send();
+        retryCount++;
+
+        auto next = timeout;
+        if (backoffLimit.count() && timeout < backoffLimit)
         {
-            send();
+            next = std::min(timeout * 2, backoffLimit);
         }
-        else
+        if (retryDeadline.count() && retrySchedule + next > latest)
         {
-            stop();
+            // The next retry still leaves the first timeout for its response
+            next = latest - retrySchedule;
+            if (next <= std::chrono::milliseconds(0))
+            {
+                stop();
+                return;
+            }
+        }
+        if (next != timeout)
+        {
+            timeout = next;
+            try
+            {
+                timer.start(duration_cast<std::chrono::microseconds>(timeout),
+                            true);
+            }
+            catch (const std::runtime_error& e)
+            {
+                error("Failed to restart the request timer, error - {ERROR}",
+                      "ERROR", e);
+            }
         }
     }
 };
@@ -151,7 +240,7 @@ class Request final : public RequestRetryTimer
      *  @param[in] verbose - verbose tracing flag
      */
     explicit Request(PldmTransport* pldmTransport, mctp_eid_t eid,
-                     sdeventplus::Event& event, pldm::Request&& requestMsg,
+                     sdeventplus::Event& event, pldm::RequestMsg&& requestMsg,
                      uint8_t numRetries, std::chrono::milliseconds timeout,
                      bool verbose) :
         RequestRetryTimer(event, numRetries, timeout),
@@ -162,7 +251,7 @@ class Request final : public RequestRetryTimer
   private:
     PldmTransport* pldmTransport; //!< PLDM transport
     mctp_eid_t eid;               //!< endpoint ID of the remote MCTP endpoint
-    pldm::Request requestMsg;     //!< PLDM request message
+    pldm::RequestMsg requestMsg;  //!< PLDM request message
     bool verbose;                 //!< verbose tracing flag
 
     /** @brief Sends the PLDM request message on the socket
@@ -176,7 +265,7 @@ class Request final : public RequestRetryTimer
             pldm::utils::printBuffer(pldm::utils::Tx, requestMsg);
         }
         pldm::flightrecorder::FlightRecorder::GetInstance().saveRecord(
-            requestMsg, true);
+            requestMsg, true, eid);
         const struct pldm_msg_hdr* hdr =
             (struct pldm_msg_hdr*)(requestMsg.data());
         if (!hdr->request)
@@ -10,6 +10,8 @@
 
 #include <sdbusplus/async.hpp>
 
+#include <thread>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -153,6 +155,242 @@ TEST_F(HandlerTest, multipleRequestResponseScenario)
     EXPECT_EQ(callbackCount, 2);
 }
 
+TEST_F(HandlerTest, requestWindowSerializesByDefault)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(1), 2,
+        milliseconds(100), 1);
+    pldm::Request request{};
+    auto instanceId = instanceIdDb.next(eid);
+    auto rc = reqHandler.registerRequest(
+        eid, instanceId, 0, 0, std::move(request),
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    pldm::Request requestNxt{};
+    auto instanceIdNxt = instanceIdDb.next(eid);
+    rc = reqHandler.registerRequest(
+        eid, instanceIdNxt, 0, 0, std::move(requestNxt),
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    // The second request is still queued, its response is not matched
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceIdNxt, 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 0);
+
+    reqHandler.handleResponse(eid, instanceId, 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 1);
+}
+
+TEST_F(HandlerTest, requestWindowPipelinesRequests)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(1), 2,
+        milliseconds(100), 2);
+    std::vector<uint8_t> instanceIds;
+    for (int i = 0; i < 3; i++)
+    {
+        pldm::Request request{};
+        instanceIds.push_back(instanceIdDb.next(eid));
+        auto rc = reqHandler.registerRequest(
+            eid, instanceIds.back(), 0, 0, std::move(request),
+            std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+        EXPECT_EQ(rc, PLDM_SUCCESS);
+    }
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+
+    // Two requests are in flight, responses may arrive out of order
+    reqHandler.handleResponse(eid, instanceIds[1], 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 1);
+
+    // The freed slot let the third request go out
+    reqHandler.handleResponse(eid, instanceIds[2], 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 2);
+
+    reqHandler.handleResponse(eid, instanceIds[0], 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 3);
+    EXPECT_EQ(nullResponse, false);
+}
+
+TEST_F(HandlerTest, requestPriorityOvertakesQueuedRequests)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(1), 2,
+        milliseconds(100), 1);
+    reqHandler.setPriorityAging(minutes(1));
+
+    std::vector<uint8_t> instanceIds;
+    auto registerRequest = [&](uint8_t command) {
+        pldm::Request request{};
+        instanceIds.push_back(instanceIdDb.next(eid));
+        return reqHandler.registerRequest(
+            eid, instanceIds.back(), PLDM_PLATFORM, command,
+            std::move(request),
+            std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    };
+    EXPECT_EQ(registerRequest(PLDM_GET_PDR), PLDM_SUCCESS);
+    EXPECT_EQ(registerRequest(PLDM_GET_PDR), PLDM_SUCCESS);
+    EXPECT_EQ(registerRequest(PLDM_SET_NUMERIC_EFFECTER_VALUE), PLDM_SUCCESS);
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceIds[0], PLDM_PLATFORM, PLDM_GET_PDR,
+                              responsePtr, response.size());
+    EXPECT_EQ(callbackCount, 1);
+
+    // The effecter write went out before the second GetPDR
+    reqHandler.handleResponse(eid, instanceIds[2], PLDM_PLATFORM,
+                              PLDM_SET_NUMERIC_EFFECTER_VALUE, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 2);
+    reqHandler.handleResponse(eid, instanceIds[1], PLDM_PLATFORM, PLDM_GET_PDR,
+                              responsePtr, response.size());
+    EXPECT_EQ(callbackCount, 3);
+}
+
+TEST_F(HandlerTest, requestPriorityAgesQueuedRequests)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(1), 2,
+        milliseconds(100), 1);
+    reqHandler.setPriorityAging(milliseconds(1));
+
+    std::vector<uint8_t> instanceIds;
+    auto registerRequest = [&](RequestPriority priority) {
+        pldm::Request request{};
+        instanceIds.push_back(instanceIdDb.next(eid));
+        return reqHandler.registerRequest(
+            eid, instanceIds.back(), 0, 0, std::move(request),
+            std::bind_front(&HandlerTest::pldmResponseCallBack, this),
+            priority);
+    };
+    EXPECT_EQ(registerRequest(RequestPriority::bulk), PLDM_SUCCESS);
+    EXPECT_EQ(registerRequest(RequestPriority::bulk), PLDM_SUCCESS);
+    std::this_thread::sleep_for(milliseconds(10));
+    EXPECT_EQ(registerRequest(RequestPriority::control), PLDM_SUCCESS);
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceIds[0], 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 1);
+
+    // The bulk request waited longer than two aging delays, it goes first
+    reqHandler.handleResponse(eid, instanceIds[2], 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 1);
+    reqHandler.handleResponse(eid, instanceIds[1], 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 2);
+}
+
+TEST_F(HandlerTest, identicalRequestsAreCoalesced)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(1), 2,
+        milliseconds(100));
+
+    std::vector<uint8_t> instanceIds;
+    auto registerRequest = [&](uint8_t sensorId) {
+        pldm::Request request(sizeof(pldm_msg_hdr) + 1);
+        request[0] = instanceIds.size();
+        request.back() = sensorId;
+        instanceIds.push_back(instanceIdDb.next(eid));
+        return reqHandler.registerRequest(
+            eid, instanceIds.back(), PLDM_PLATFORM, PLDM_GET_SENSOR_READING,
+            std::move(request),
+            std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    };
+    EXPECT_EQ(registerRequest(1), PLDM_SUCCESS);
+    EXPECT_EQ(registerRequest(1), PLDM_SUCCESS);
+    EXPECT_EQ(registerRequest(2), PLDM_SUCCESS);
+
+    // The second request is not on the bus, the first one answers both
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceIds[0], PLDM_PLATFORM,
+                              PLDM_GET_SENSOR_READING, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 2);
+    reqHandler.handleResponse(eid, instanceIds[2], PLDM_PLATFORM,
+                              PLDM_GET_SENSOR_READING, responsePtr,
+                              response.size());
+    EXPECT_EQ(callbackCount, 3);
+}
+
+TEST_F(HandlerTest, coalescedRequestsFailWithTheirSend)
+{
+    Handler<FailingRequest> reqHandler(pldmTransport, event, instanceIdDb,
+                                       false, seconds(1), 2, milliseconds(100));
+
+    std::vector<uint8_t> instanceIds;
+    auto registerRequest = [&]() {
+        pldm::Request request(sizeof(pldm_msg_hdr) + 1);
+        instanceIds.push_back(instanceIdDb.next(eid));
+        return reqHandler.registerRequest(
+            eid, instanceIds.back(), PLDM_PLATFORM, PLDM_GET_SENSOR_READING,
+            std::move(request),
+            std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    };
+    EXPECT_EQ(registerRequest(), PLDM_SUCCESS);
+    EXPECT_EQ(registerRequest(), PLDM_SUCCESS);
+    EXPECT_EQ(callbackCount, 0);
+
+    // Both requests get an empty response instead of waiting forever
+    waitEventExpiry(milliseconds(100));
+    EXPECT_EQ(callbackCount, 2);
+    EXPECT_EQ(nullResponse, true);
+    EXPECT_EQ(validResponse, false);
+
+    // Nothing is left to join and the instance IDs were freed
+    EXPECT_EQ(registerRequest(), PLDM_SUCCESS);
+    waitEventExpiry(milliseconds(100));
+    EXPECT_EQ(callbackCount, 3);
+    for (auto instanceId : instanceIds)
+    {
+        EXPECT_THROW(instanceIdDb.free(eid, instanceId), std::runtime_error);
+    }
+}
+
+TEST_F(HandlerTest, responseTimeOutAdaptsToEndpoint)
+{
+    Handler<NiceMock<MockRequest>> reqHandler(
+        pldmTransport, event, instanceIdDb, false, seconds(1), 2,
+        milliseconds(100));
+
+    // Without samples the configured timeout applies
+    EXPECT_EQ(reqHandler.getResponseTimeOut(eid, 0, 0), milliseconds(100));
+
+    pldm::Request request{};
+    auto instanceId = instanceIdDb.next(eid);
+    auto rc = reqHandler.registerRequest(
+        eid, instanceId, 0, 0, std::move(request),
+        std::bind_front(&HandlerTest::pldmResponseCallBack, this));
+    EXPECT_EQ(rc, PLDM_SUCCESS);
+
+    pldm::Response response(sizeof(pldm_msg_hdr) + sizeof(uint8_t));
+    auto responsePtr = reinterpret_cast<const pldm_msg*>(response.data());
+    reqHandler.handleResponse(eid, instanceId, 0, 0, responsePtr,
+                              response.size());
+    EXPECT_EQ(validResponse, true);
+
+    // An immediate response pulls the timeout down to its lower bound, the
+    // configured timeout when below minAdaptiveResponseTimeOut
+    EXPECT_EQ(reqHandler.getResponseTimeOut(eid, 0, 0), milliseconds(100));
+
+    reqHandler.setCommandTimeout(0, 0, milliseconds(500));
+    EXPECT_EQ(reqHandler.getResponseTimeOut(eid, 0, 0), milliseconds(500));
+}
+
 TEST_F(HandlerTest, singleRequestResponseScenarioUsingCoroutine)
 {
     exec::async_scope scope;
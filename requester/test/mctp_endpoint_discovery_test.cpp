@@ -136,3 +136,46 @@ TEST(MctpEndpointDiscoveryTest, goodRemoveEndpoints)
     mctpDiscoveryHandler->removeEndpoints(msg);
     EXPECT_EQ(mctpDiscoveryHandler->existingMctpInfos.size(), 0);
 }
+
+TEST(MctpEndpointDiscoveryTest, batchMctpEndpoints)
+{
+    if (!MCTP_DISCOVERY_DEBOUNCE_MS)
+    {
+        GTEST_SKIP() << "Endpoints are handed over without debounce";
+    }
+
+    auto& bus = pldm::utils::DBusHandler::getBus();
+    pldm::MockManager manager;
+    const pldm::MctpInfos& mctpInfos = {
+        pldm::MctpInfo(11, pldm::emptyUUID, "def", 2),
+        pldm::MctpInfo(12, pldm::emptyUUID, "abc", 1)};
+
+    // The constructor and the batch, without the endpoint removed before
+    // being handed over
+    EXPECT_CALL(manager, handleMctpEndpoints(_)).Times(1);
+    EXPECT_CALL(manager, handleMctpEndpoints(pldm::MctpInfos(1, mctpInfos[1])))
+        .Times(1);
+    EXPECT_CALL(manager, handleRemovedMctpEndpoints(_)).Times(0);
+
+    auto mctpDiscoveryHandler = std::make_unique<pldm::MctpDiscovery>(
+        bus, std::initializer_list<pldm::MctpDiscoveryHandlerIntf*>{&manager});
+    mctpDiscoveryHandler->queueMctpEndpoints(mctpInfos);
+    mctpDiscoveryHandler->queueRemovedMctpEndpoints(
+        pldm::MctpInfos(1, mctpInfos[0]));
+    mctpDiscoveryHandler->flushMctpEndpoints();
+}
+
+TEST(MctpEndpointDiscoveryTest, endpointFilter)
+{
+    pldm::MctpEndpointFilter all;
+    EXPECT_TRUE(all.claims(pldm::MctpInfo(11, pldm::emptyUUID, "", 1)));
+
+    pldm::MctpEndpointFilter network{{2}, {}};
+    EXPECT_TRUE(network.claims(pldm::MctpInfo(11, pldm::emptyUUID, "", 2)));
+    EXPECT_FALSE(network.claims(pldm::MctpInfo(11, pldm::emptyUUID, "", 1)));
+
+    pldm::MctpEndpointFilter eids{{2}, {11, 12}};
+    EXPECT_TRUE(eids.claims(pldm::MctpInfo(12, pldm::emptyUUID, "", 2)));
+    EXPECT_FALSE(eids.claims(pldm::MctpInfo(13, pldm::emptyUUID, "", 2)));
+    EXPECT_FALSE(eids.claims(pldm::MctpInfo(12, pldm::emptyUUID, "", 1)));
+}
@@ -18,7 +18,7 @@ class MockRequest : public RequestRetryTimer
 {
   public:
     MockRequest(PldmTransport* /*pldmTransport*/, mctp_eid_t /*eid*/,
-                sdeventplus::Event& event, pldm::Request&& /*requestMsg*/,
+                sdeventplus::Event& event, pldm::RequestMsg&& /*requestMsg*/,
                 uint8_t numRetries, std::chrono::milliseconds responseTimeOut,
                 bool /*verbose*/) :
         RequestRetryTimer(event, numRetries, responseTimeOut)
@@ -27,6 +27,24 @@ class MockRequest : public RequestRetryTimer
     MOCK_METHOD(int, send, (), (const, override));
 };
 
+/** @brief A request whose transport fails every send */
+class FailingRequest : public RequestRetryTimer
+{
+  public:
+    FailingRequest(
+        PldmTransport* /*pldmTransport*/, mctp_eid_t /*eid*/,
+        sdeventplus::Event& event, pldm::RequestMsg&& /*requestMsg*/,
+        uint8_t numRetries, std::chrono::milliseconds responseTimeOut,
+        bool /*verbose*/) :
+        RequestRetryTimer(event, numRetries, responseTimeOut)
+    {}
+
+    int send() const override
+    {
+        return PLDM_ERROR;
+    }
+};
+
 } // namespace requester
 
 } // namespace pldm
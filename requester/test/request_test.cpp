@@ -103,3 +103,30 @@ TEST_F(RequestIntfTest, 2Retries100msTimeoutsendReturnsError)
     auto rc = request.start();
     EXPECT_EQ(rc, PLDM_ERROR);
 }
+
+TEST_F(RequestIntfTest, retriesFitBeforeDeadline)
+{
+    std::vector<uint8_t> requestMsg;
+    MockRequest request(pldmTransport, eid, event, std::move(requestMsg), 3,
+                        milliseconds(100), false);
+    request.setRetryBackoff(seconds(1));
+    request.setRetryDeadline(milliseconds(350));
+    // Retries at 100ms and at 250ms, the wait shortened from 200ms to leave
+    // 100ms for the response, a retry at 550ms would come too late
+    EXPECT_CALL(request, send()).Times(3).WillRepeatedly(Return(PLDM_SUCCESS));
+    EXPECT_EQ(request.start(), PLDM_SUCCESS);
+    waitEventExpiry(milliseconds(500));
+    EXPECT_EQ(request.getRetryCount(), 2);
+}
+
+TEST_F(RequestIntfTest, noRetryAfterDeadline)
+{
+    std::vector<uint8_t> requestMsg;
+    MockRequest request(pldmTransport, eid, event, std::move(requestMsg), 2,
+                        milliseconds(100), false);
+    request.setRetryDeadline(milliseconds(150));
+    EXPECT_CALL(request, send()).Times(1).WillRepeatedly(Return(PLDM_SUCCESS));
+    EXPECT_EQ(request.start(), PLDM_SUCCESS);
+    waitEventExpiry(milliseconds(300));
+    EXPECT_EQ(request.getRetryCount(), 0);
+}
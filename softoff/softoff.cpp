@@ -16,8 +16,12 @@
 #include <sdeventplus/source/time.hpp>
 
 #include <array>
+#include <cerrno>
 #include <filesystem>
 #include <fstream>
+#include <optional>
+#include <tuple>
+#include <vector>
 
 PHOSPHOR_LOG2_USING;
 
@@ -49,38 +53,6 @@ SoftPowerOff::SoftPowerOff(sdbusplus::bus_t& bus, sd_event* event,
         return;
     }
 
-    getHostState();
-    if (hasError || completed)
-    {
-        return;
-    }
-    const std::vector<Json> emptyJsonList{};
-    auto entries = jsonData.value("entries", emptyJsonList);
-    for (const auto& entry : entries)
-    {
-        TID = entry.value("tid", 0);
-        pldm::pdr::EntityType entityType = entry.value("entityType", 0);
-        pldm::pdr::StateSetId stateSetId = entry.value("stateSetId", 0);
-
-        bool effecterFound = getEffecterID(entityType, stateSetId);
-        if (effecterFound)
-        {
-            auto rc = getSensorInfo(entityType, stateSetId);
-            if (rc != PLDM_SUCCESS)
-            {
-                error("Failed to get Sensor PDRs, response code '{RC}'", "RC",
-                      lg2::hex, rc);
-                hasError = true;
-                return;
-            }
-            break;
-        }
-        else
-        {
-            continue;
-        }
-    }
-
     // Matches on the pldm StateSensorEvent signal
     pldmEventSignal = std::make_unique<sdbusplus::bus::match_t>(
         bus,
@@ -89,37 +61,106 @@ SoftPowerOff::SoftPowerOff(sdbusplus::bus_t& bus, sd_event* event,
             sdbusRule::interface("xyz.openbmc_project.PLDM.Event"),
         std::bind(std::mem_fn(&SoftPowerOff::hostSoftOffComplete), this,
                   std::placeholders::_1));
-}
 
-int SoftPowerOff::getHostState()
-{
-    try
+    /* The host state and the PDRs of all the entries are looked up at once,
+     * the first entry with an effecter is used */
+    struct Lookup
     {
-        pldm::utils::PropertyValue propertyValue =
-            pldm::utils::DBusHandler().getDbusPropertyVariant(
-                "/xyz/openbmc_project/state/host0", "CurrentHostState",
-                "xyz.openbmc_project.State.Host");
-
-        if ((std::get<std::string>(propertyValue) !=
-             "xyz.openbmc_project.State.Host.HostState.Running") &&
-            (std::get<std::string>(propertyValue) !=
-             "xyz.openbmc_project.State.Host.HostState.TransitioningToOff"))
-        {
-            // Host state is not "Running", this app should return success
-            completed = true;
-            return PLDM_SUCCESS;
-        }
+        pldm::pdr::TerminusID tid;
+        std::optional<uint16_t> effecterID;
+        std::optional<std::tuple<uint16_t, uint8_t>> sensor;
+    };
+    const std::vector<Json> emptyJsonList{};
+    auto entries = jsonData.value("entries", emptyJsonList);
+    std::vector<Lookup> lookups(entries.size());
+    size_t pending = 1;
+
+    getHostState([&pending]() { pending--; });
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        lookups[i].tid = entries[i].value("tid", 0);
+        pldm::pdr::EntityType entityType = entries[i].value("entityType", 0);
+        pldm::pdr::StateSetId stateSetId = entries[i].value("stateSetId", 0);
+
+        pending += 2;
+        lookupPdr("FindStateEffecter", lookups[i].tid, entityType, stateSetId,
+                  [&pending, &lookup = lookups[i]](int rc, auto response) {
+                      pending--;
+                      if (rc)
+                      {
+                          error(
+                              "Failed to get softPowerOff PDR, error - {ERROR}",
+                              "ERROR", -rc);
+                          return;
+                      }
+                      lookup.effecterID = std::get<0>(response);
+                  });
+        lookupPdr("FindStateSensor", lookups[i].tid, entityType, stateSetId,
+                  [&pending, &lookup = lookups[i]](int rc, auto response) {
+                      pending--;
+                      if (!rc)
+                      {
+                          lookup.sensor = response;
+                      }
+                  });
     }
-    catch (const std::exception& e)
+
+    sdeventplus::Event loop(event);
+    while (pending)
     {
-        error(
-            "PLDM remote terminus soft off. Can't get current remote terminus state, error - {ERROR}",
-            "ERROR", e);
-        hasError = true;
-        return PLDM_ERROR;
+        loop.run(std::nullopt);
     }
 
-    return PLDM_SUCCESS;
+    if (hasError || completed)
+    {
+        return;
+    }
+    for (const auto& lookup : lookups)
+    {
+        if (!lookup.effecterID)
+        {
+            continue;
+        }
+        TID = lookup.tid;
+        effecterID = *lookup.effecterID;
+        if (!lookup.sensor)
+        {
+            error("Failed to get state sensor PDR during soft-off");
+            hasError = true;
+            return;
+        }
+        // The soft off state set is PLDM_STATE_SET_SW_TERMINATION_STATUS,
+        // its composite index is the offset of the sensor events
+        std::tie(sensorID, sensorOffset) = *lookup.sensor;
+        break;
+    }
+}
+
+void SoftPowerOff::getHostState(std::function<void()> done)
+{
+    pldm::utils::AsyncDBusHandler().getDbusPropertyVariant(
+        {"/xyz/openbmc_project/state/host0", "xyz.openbmc_project.State.Host",
+         "CurrentHostState", "string"},
+        [this, done = std::move(done)](
+            int rc, pldm::utils::PropertyValue&& propertyValue) {
+            auto state = std::get_if<std::string>(&propertyValue);
+            if (rc || !state)
+            {
+                error(
+                    "PLDM remote terminus soft off. Can't get current remote terminus state, error - {ERROR}",
+                    "ERROR", -rc);
+                hasError = true;
+            }
+            else if (*state !=
+                         "xyz.openbmc_project.State.Host.HostState.Running" &&
+                     *state !=
+                         "xyz.openbmc_project.State.Host.HostState.TransitioningToOff")
+            {
+                // Host state is not "Running", this app should return success
+                completed = true;
+            }
+            done();
+        });
 }
 
 void SoftPowerOff::hostSoftOffComplete(sdbusplus::message_t& msg)
@@ -168,103 +209,33 @@ Json SoftPowerOff::parseConfig()
     return Json::parse(jsonFile);
 }
 
-bool SoftPowerOff::getEffecterID(pldm::pdr::EntityType& entityType,
-                                 pldm::pdr::StateSetId& stateSetId)
+void SoftPowerOff::lookupPdr(
+    const char* methodName, pldm::pdr::TerminusID tid,
+    pldm::pdr::EntityType entityType, pldm::pdr::StateSetId stateSetId,
+    std::function<void(int, std::tuple<uint16_t, uint8_t>)> callback)
 {
-    auto& bus = pldm::utils::DBusHandler::getBus();
-    try
-    {
-        std::vector<std::vector<uint8_t>> response{};
-        auto method = bus.new_method_call(
-            "xyz.openbmc_project.PLDM", "/xyz/openbmc_project/pldm",
-            "xyz.openbmc_project.PLDM.PDR", "FindStateEffecterPDR");
-        method.append(TID, entityType, stateSetId);
-        auto responseMsg = bus.call(method, dbusTimeout);
-
-        responseMsg.read(response);
-        if (response.size())
-        {
-            for (auto& rep : response)
+    auto method = bus.new_method_call(
+        "xyz.openbmc_project.PLDM", "/xyz/openbmc_project/pldm",
+        "xyz.openbmc_project.PLDM.PDRLookup", methodName);
+    method.append(tid, entityType, stateSetId);
+    pldm::utils::AsyncDBusHandler().callMethod(
+        method, dbusTimeout,
+        [callback = std::move(callback)](int rc, sdbusplus::message_t* reply) {
+            std::tuple<uint16_t, uint8_t> response{};
+            if (!rc)
             {
-                auto softoffPdr = new (rep.data()) pldm_state_effecter_pdr;
-                effecterID = softoffPdr->effecter_id;
+                try
+                {
+                    auto& [id, compositeIndex] = response;
+                    reply->read(id, compositeIndex);
+                }
+                catch (const sdbusplus::exception_t&)
+                {
+                    rc = -EBADMSG;
+                }
             }
-        }
-        else
-        {
-            return false;
-        }
-    }
-    catch (const sdbusplus::exception_t& e)
-    {
-        error("Failed to get softPowerOff PDR, error - {ERROR}", "ERROR", e);
-        return false;
-    }
-    return true;
-}
-
-int SoftPowerOff::getSensorInfo(pldm::pdr::EntityType& entityType,
-                                pldm::pdr::StateSetId& stateSetId)
-{
-    try
-    {
-        auto& bus = pldm::utils::DBusHandler::getBus();
-        std::vector<std::vector<uint8_t>> Response{};
-        auto method = bus.new_method_call(
-            "xyz.openbmc_project.PLDM", "/xyz/openbmc_project/pldm",
-            "xyz.openbmc_project.PLDM.PDR", "FindStateSensorPDR");
-        method.append(TID, entityType, stateSetId);
-
-        auto ResponseMsg = bus.call(method, dbusTimeout);
-
-        ResponseMsg.read(Response);
-
-        if (Response.size() == 0)
-        {
-            error("No sensor PDR has been found that matches the criteria");
-            return PLDM_ERROR;
-        }
-
-        pldm_state_sensor_pdr* pdr = nullptr;
-        for (auto& rep : Response)
-        {
-            pdr = new (rep.data()) pldm_state_sensor_pdr;
-            if (!pdr)
-            {
-                error("Failed to get state sensor PDR.");
-                return PLDM_ERROR;
-            }
-        }
-
-        sensorID = pdr->sensor_id;
-
-        auto compositeSensorCount = pdr->composite_sensor_count;
-        auto possibleStatesStart = pdr->possible_states;
-
-        for (auto offset = 0; offset < compositeSensorCount; offset++)
-        {
-            auto possibleStates = new (possibleStatesStart)
-                state_sensor_possible_states;
-            auto setId = possibleStates->state_set_id;
-            auto possibleStateSize = possibleStates->possible_states_size;
-
-            if (setId == PLDM_STATE_SET_SW_TERMINATION_STATUS)
-            {
-                sensorOffset = offset;
-                break;
-            }
-            possibleStatesStart +=
-                possibleStateSize + sizeof(setId) + sizeof(possibleStateSize);
-        }
-    }
-    catch (const sdbusplus::exception_t& e)
-    {
-        error("Failed to get state sensor PDR during soft-off, error - {ERROR}",
-              "ERROR", e);
-        return PLDM_ERROR;
-    }
-
-    return PLDM_SUCCESS;
+            callback(rc, response);
+        });
 }
 
 int SoftPowerOff::hostSoftOff(sdeventplus::Event& event)
@@ -11,6 +11,9 @@
 #include <sdbusplus/timer.hpp>
 #include <sdeventplus/event.hpp>
 
+#include <functional>
+#include <tuple>
+
 namespace pldm
 {
 using Json = nlohmann::json;
@@ -70,9 +73,12 @@ class SoftPowerOff
     int hostSoftOff(sdeventplus::Event& event);
 
   private:
-    /** @brief Getting the host current state.
+    /** @brief Get the host current state, setting completed when it is not
+     *         running and hasError when it can't be read
+     *
+     *  @param[in] done - called once the state is known
      */
-    int getHostState();
+    void getHostState(std::function<void()> done);
 
     /** @brief Stop the timer.
      */
@@ -102,27 +108,20 @@ class SoftPowerOff
      */
     int startTimer(const std::chrono::microseconds& usec);
 
-    /** @brief Get effecterID from PDRs.
-     *
-     *  @param[in] entityType - entity type of the entity hosting
-     *                              hosting softoff PDR
-     *  @param[in] stateSetId - state set ID of the softoff PDR
-     *
-     *  @return true or false
-     */
-    bool getEffecterID(pldm::pdr::EntityType& entityType,
-                       pldm::pdr::StateSetId& stateSetId);
-
-    /** @brief Get VMM/SystemFirmware Sensor info from PDRs.
+    /** @brief Look up a softoff PDR with the PDRLookup service of pldmd
      *
+     *  @param[in] methodName - FindStateEffecter or FindStateSensor
+     *  @param[in] tid - TID of the terminus hosting the softoff PDR
      *  @param[in] entityType - entity type of the entity hosting
      *                              hosting softoff PDR
      *  @param[in] stateSetId - state set ID of the softoff PDR
-     *
-     *  @return PLDM_SUCCESS or PLDM_ERROR
+     *  @param[in] callback - called with 0 and the effecter ID, or the
+     *                        sensor ID and offset, else a negative errno
      */
-    int getSensorInfo(pldm::pdr::EntityType& entityType,
-                      pldm::pdr::StateSetId& stateSetId);
+    void lookupPdr(
+        const char* methodName, pldm::pdr::TerminusID tid,
+        pldm::pdr::EntityType entityType, pldm::pdr::StateSetId stateSetId,
+        std::function<void(int, std::tuple<uint16_t, uint8_t>)> callback);
 
     /** @brief effecterID
      */
@@ -0,0 +1,98 @@
+#include "pldmd/dbus_impl_instance_id_lease.hpp"
+#include "test/test_instance_id.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdeventplus/event.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::dbus_api;
+
+constexpr uint8_t eid = 9;
+constexpr auto leasePath = "/xyz/openbmc_project/pldm/test_lease";
+
+class TestInstanceIdLease : public testing::Test
+{
+  protected:
+    TestInstanceIdLease() :
+        bus(sdbusplus::bus::new_default()),
+        event(sdeventplus::Event::get_new()), db(1),
+        lease(bus, leasePath, event, db)
+    {}
+
+    /** @brief Process the signals received, NameOwnerChanged among them */
+    void processSignals()
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            bus.wait(std::chrono::milliseconds(10));
+            while (bus.process_discard())
+            {}
+        }
+    }
+
+    sdbusplus::bus_t bus;
+    sdeventplus::Event event;
+    TestInstanceIdDb db;
+    InstanceIdLease lease;
+};
+
+TEST_F(TestInstanceIdLease, freedWhenOwnerLeaves)
+{
+    auto ids = lease.getInstanceIds(":1.10", eid, 2);
+    ASSERT_EQ(ids.size(), 2);
+
+    // Another requester leaving keeps the leases
+    lease.reclaimLeases(":1.11");
+    EXPECT_NO_THROW(lease.renewInstanceIds(":1.10", eid, ids));
+
+    lease.reclaimLeases(":1.10");
+    EXPECT_THROW(lease.freeInstanceIds(":1.10", eid, ids),
+                 std::invalid_argument);
+    // All the IDs are free again
+    EXPECT_EQ(lease.getInstanceIds(":1.12", eid, pldm::maxInstanceIds).size(),
+              pldm::maxInstanceIds);
+}
+
+TEST_F(TestInstanceIdLease, renewOnlyOwnLeases)
+{
+    auto ids = lease.getInstanceIds(":1.10", eid, 1);
+    ASSERT_EQ(ids.size(), 1);
+
+    EXPECT_NO_THROW(lease.renewInstanceIds(":1.10", eid, ids));
+    EXPECT_THROW(lease.renewInstanceIds(":1.11", eid, ids),
+                 std::invalid_argument);
+    EXPECT_THROW(lease.renewInstanceIds(":1.10", eid + 1, ids),
+                 std::invalid_argument);
+
+    EXPECT_NO_THROW(lease.freeInstanceIds(":1.10", eid, ids));
+    EXPECT_THROW(lease.renewInstanceIds(":1.10", eid, ids),
+                 std::invalid_argument);
+}
+
+TEST_F(TestInstanceIdLease, reclaimedWhenRequesterLeavesBus)
+{
+    std::string owner;
+    std::vector<uint8_t> ids;
+    {
+        auto requester = sdbusplus::bus::new_bus();
+        owner = requester.get_unique_name();
+        ids = lease.getInstanceIds(owner, eid, 2);
+        ASSERT_EQ(ids.size(), 2);
+
+        processSignals();
+        EXPECT_NO_THROW(lease.renewInstanceIds(owner, eid, ids));
+    }
+
+    // The connection of the requester is closed
+    processSignals();
+    EXPECT_THROW(lease.renewInstanceIds(owner, eid, ids),
+                 std::invalid_argument);
+    EXPECT_EQ(lease.getInstanceIds(":1.12", eid, pldm::maxInstanceIds).size(),
+              pldm::maxInstanceIds);
+}
@@ -0,0 +1,88 @@
+#include "common/instance_id.hpp"
+#include "test/test_instance_id.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm;
+
+constexpr uint8_t tid = 1;
+
+TEST(InstanceIdLease, RotatesUntilLeaseIsFull)
+{
+    TestInstanceIdDb db(4);
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        auto id = db.next(tid);
+        EXPECT_EQ(id, i);
+        db.free(tid, id);
+    }
+    EXPECT_EQ(db.getStats().dbAllocations, 4);
+    EXPECT_EQ(db.getStats().localAllocations, 0);
+
+    // The lease is full, IDs are recycled oldest first
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        auto id = db.next(tid);
+        EXPECT_EQ(id, i);
+        db.free(tid, id);
+    }
+    EXPECT_EQ(db.getStats().dbAllocations, 4);
+    EXPECT_EQ(db.getStats().localAllocations, 4);
+}
+
+TEST(InstanceIdLease, ReturnsIdsBeyondLease)
+{
+    TestInstanceIdDb db(2);
+
+    std::vector<uint8_t> ids;
+    for (int i = 0; i < 3; i++)
+    {
+        ids.push_back(db.next(tid));
+    }
+    for (auto id : ids)
+    {
+        db.free(tid, id);
+    }
+    EXPECT_EQ(db.getStats().dbFrees, 1);
+}
+
+TEST(InstanceIdLease, LeaseSizeOneIsPassThrough)
+{
+    TestInstanceIdDb db(1);
+
+    EXPECT_EQ(db.next(tid), 0);
+    db.free(tid, 0);
+    EXPECT_EQ(db.next(tid), 1);
+    db.free(tid, 1);
+    EXPECT_EQ(db.getStats().localAllocations, 0);
+    EXPECT_EQ(db.getStats().dbFrees, 2);
+}
+
+TEST(InstanceIdLease, RejectsDoubleFree)
+{
+    TestInstanceIdDb db(4);
+
+    auto id = db.next(tid);
+    db.free(tid, id);
+    EXPECT_THROW(db.free(tid, id), std::runtime_error);
+}
+
+TEST(InstanceIdLease, FallsBackOnLeaseWhenExhausted)
+{
+    TestInstanceIdDb db(maxInstanceIds);
+
+    std::vector<uint8_t> ids;
+    for (int i = 0; i < maxInstanceIds; i++)
+    {
+        ids.push_back(db.next(tid));
+    }
+    EXPECT_THROW(db.next(tid), std::runtime_error);
+    EXPECT_EQ(db.getStats().exhausted, 1);
+
+    db.free(tid, ids[5]);
+    EXPECT_EQ(db.next(tid), ids[5]);
+}
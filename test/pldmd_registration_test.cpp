@@ -2,6 +2,7 @@
 
 #include <libpldm/base.h>
 
+#include <memory>
 #include <stdexcept>
 
 #include <gtest/gtest.h>
@@ -9,6 +10,7 @@
 using namespace pldm;
 using namespace pldm::responder;
 constexpr Command testCmd = 0xFF;
+constexpr Command laterCmd = 0xFE;
 constexpr Type testType = 0xFF;
 constexpr pldm_tid_t tid = 0;
 
@@ -60,3 +62,67 @@ TEST(Registration, testFailure)
     ASSERT_THROW(invoker.handle(tid, testType, badCmd, nullptr, 0),
                  std::out_of_range);
 }
+
+TEST(Registration, testDispatchTable)
+{
+    Invoker invoker{};
+    invoker.registerHandler(testType, std::make_unique<TestHandler>());
+    auto table = invoker.getDispatchTable();
+    ASSERT_EQ(table.size(), 1);
+    EXPECT_EQ(table[0].first, testType);
+    EXPECT_EQ(table[0].second, testCmd);
+}
+
+TEST(Registration, testDeferredHandler)
+{
+    class TestDeferredHandler : public CmdHandler
+    {
+      public:
+        TestDeferredHandler()
+        {
+            deferredHandlers.emplace(
+                testCmd, [](uint8_t /*tid*/, const pldm_msg* /*request*/,
+                            size_t /*payloadLength*/,
+                            ResponseCompletion complete) {
+                    complete({10});
+                });
+            deferredHandlers.emplace(
+                laterCmd, [this](uint8_t /*tid*/, const pldm_msg* /*request*/,
+                                 size_t /*payloadLength*/,
+                                 ResponseCompletion complete) {
+                    pending = std::move(complete);
+                });
+        }
+
+        ResponseCompletion pending;
+    };
+
+    Invoker invoker{};
+    auto handler = std::make_unique<TestDeferredHandler>();
+    auto& deferred = *handler;
+    invoker.registerHandler(testType, std::move(handler));
+
+    std::vector<std::pair<pldm_tid_t, Response>> sent;
+    invoker.setResponseSender([&sent](pldm_tid_t tid, Response&& response) {
+        sent.emplace_back(tid, std::move(response));
+    });
+
+    /* Completed before returning, returned like any other response */
+    Response response;
+    invoker.handle(tid, testType, testCmd, nullptr, 0, response);
+    ASSERT_EQ(response.size(), 1);
+    EXPECT_EQ(response[0], 10);
+    EXPECT_TRUE(sent.empty());
+
+    /* Completed later, handed to the sender */
+    invoker.handle(tid, testType, laterCmd, nullptr, 0, response);
+    EXPECT_TRUE(response.empty());
+    ASSERT_TRUE(deferred.pending);
+    deferred.pending({20, 30});
+    ASSERT_EQ(sent.size(), 1);
+    EXPECT_EQ(sent[0].first, tid);
+    EXPECT_EQ(sent[0].second, Response({20, 30}));
+
+    auto table = invoker.getDispatchTable();
+    EXPECT_EQ(table.size(), 2);
+}
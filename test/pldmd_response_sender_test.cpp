@@ -0,0 +1,38 @@
+#include "common/loopback.hpp"
+#include "common/transport.hpp"
+#include "pldmd/response_sender.hpp"
+
+#include <libpldm/base.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder;
+using pldm::transport::Loopback;
+
+TEST(ResponseSender, sentToRequester)
+{
+    constexpr pldm_tid_t hostEid = 9;
+    constexpr pldm_tid_t requesterEid = 20;
+    Loopback::get().clear();
+    std::vector<pldm_tid_t> receivers;
+    for (auto eid : {hostEid, requesterEid})
+    {
+        Loopback::get().attach(
+            eid, [eid, &receivers](std::span<const uint8_t>) {
+                receivers.push_back(eid);
+            });
+    }
+
+    PldmTransport transport{"loopback"};
+    ResponseSender sendResponse(transport, false);
+    pldm::Response response{0x03, PLDM_BASE, PLDM_GET_TID, PLDM_SUCCESS, 1};
+    sendResponse(requesterEid, response);
+    sendResponse(hostEid, response);
+
+    EXPECT_EQ(receivers, std::vector<pldm_tid_t>({requesterEid, hostEid}));
+    Loopback::get().clear();
+}
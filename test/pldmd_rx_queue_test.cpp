@@ -0,0 +1,138 @@
+#include "pldmd/rx_queue.hpp"
+
+#include <libpldm/base.h>
+#include <libpldm/platform.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::responder;
+
+static RxMessage makeMessage(pldm_tid_t tid, uint8_t type, uint8_t command,
+                             bool request = true, uint8_t instanceId = 0)
+{
+    pldm_msg_hdr hdr{};
+    hdr.request = request;
+    hdr.instance_id = instanceId;
+    hdr.type = type;
+    hdr.command = command;
+    auto msg = malloc(sizeof(hdr));
+    memcpy(msg, &hdr, sizeof(hdr));
+    return RxMessage(tid, msg, sizeof(hdr));
+}
+
+static const pldm_msg_hdr& header(const RxMessage& message)
+{
+    return *reinterpret_cast<const pldm_msg_hdr*>(message.data().data());
+}
+
+TEST(RxQueue, priorityClasses)
+{
+    RxQueue queue;
+    queue.push(makeMessage(1, PLDM_OEM, 0x04));
+    queue.push(makeMessage(1, PLDM_PLATFORM, PLDM_GET_SENSOR_READING));
+    queue.push(makeMessage(1, PLDM_BASE, PLDM_GET_TID));
+    queue.push(makeMessage(2, PLDM_PLATFORM, PLDM_SET_STATE_EFFECTER_STATES));
+    queue.push(makeMessage(3, PLDM_OEM, 0x04, false));
+    EXPECT_EQ(queue.size(), 5);
+
+    std::vector<std::pair<pldm_tid_t, uint8_t>> order;
+    while (auto message = queue.pop())
+    {
+        order.emplace_back(message->tid, header(*message).type);
+    }
+    EXPECT_TRUE(queue.empty());
+
+    std::vector<std::pair<pldm_tid_t, uint8_t>> expected{
+        {2, PLDM_PLATFORM}, // platform control
+        {3, PLDM_OEM},      // response
+        {1, PLDM_PLATFORM}, // FIFO within the class of a terminus
+        {1, PLDM_BASE},
+        {1, PLDM_OEM}, // bulk
+    };
+    EXPECT_EQ(order, expected);
+}
+
+TEST(RxQueue, roundRobinAcrossTids)
+{
+    RxQueue queue;
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        queue.push(makeMessage(1, PLDM_PLATFORM, PLDM_GET_SENSOR_READING, true,
+                               i));
+    }
+    queue.push(makeMessage(2, PLDM_PLATFORM, PLDM_GET_SENSOR_READING, true, 7));
+
+    std::vector<std::pair<pldm_tid_t, uint8_t>> order;
+    while (auto message = queue.pop())
+    {
+        order.emplace_back(message->tid, header(*message).instance_id);
+    }
+
+    std::vector<std::pair<pldm_tid_t, uint8_t>> expected{
+        {1, 0}, {2, 7}, {1, 1}, {1, 2}};
+    EXPECT_EQ(order, expected);
+}
+
+TEST(RxQueue, configuredClasses)
+{
+    RxQueue queue;
+    queue.setTypeClass(PLDM_BIOS, RxClass::Bulk);
+    queue.setCommandClass(PLDM_OEM, 0x01, RxClass::Control);
+
+    pldm_msg_hdr hdr{};
+    hdr.request = 1;
+    hdr.type = PLDM_BIOS;
+    EXPECT_EQ(queue.classify(hdr), RxClass::Bulk);
+    hdr.type = PLDM_OEM;
+    hdr.command = 0x01;
+    EXPECT_EQ(queue.classify(hdr), RxClass::Control);
+    hdr.command = 0x02;
+    EXPECT_EQ(queue.classify(hdr), RxClass::Bulk);
+    hdr.type = PLDM_FRU;
+    EXPECT_EQ(queue.classify(hdr), RxClass::Normal);
+}
+
+TEST(RxQueue, classesLoadedFromFile)
+{
+    char tmpfile[] = "/tmp/pldm_rx_priority.XXXXXX";
+    auto fd = mkstemp(tmpfile);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    std::ofstream(tmpfile) << R"({
+        "types": [{ "type": 3, "class": "bulk" },
+                  { "type": 4, "class": "urgent" }],
+        "commands": [{ "type": 63, "command": 1, "class": "control" },
+                     { "type": 2, "class": "bulk" }]
+    })";
+
+    RxQueue queue;
+    queue.loadClasses(tmpfile);
+    std::filesystem::remove(tmpfile);
+
+    pldm_msg_hdr hdr{};
+    hdr.request = 1;
+    hdr.type = PLDM_BIOS;
+    EXPECT_EQ(queue.classify(hdr), RxClass::Bulk);
+    hdr.type = PLDM_FRU;
+    EXPECT_EQ(queue.classify(hdr), RxClass::Normal);
+    hdr.type = PLDM_OEM;
+    hdr.command = 0x01;
+    EXPECT_EQ(queue.classify(hdr), RxClass::Control);
+    hdr.command = 0x02;
+    EXPECT_EQ(queue.classify(hdr), RxClass::Bulk);
+    // The entry without a command is skipped
+    hdr.type = PLDM_PLATFORM;
+    hdr.command = PLDM_GET_SENSOR_READING;
+    EXPECT_EQ(queue.classify(hdr), RxClass::Normal);
+
+    // A missing file keeps the classes
+    queue.loadClasses("/tmp/pldm_rx_priority_missing.json");
+    EXPECT_EQ(queue.classify(hdr), RxClass::Normal);
+}
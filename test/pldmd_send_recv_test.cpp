@@ -0,0 +1,91 @@
+#include "pldmd/dbus_impl_send_recv.hpp"
+
+#include <libpldm/base.h>
+#include <libpldm/firmware_update.h>
+#include <libpldm/platform.h>
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace pldm::dbus_api;
+
+static std::vector<uint8_t> makeRequest(uint8_t type, uint8_t command,
+                                        bool request = true,
+                                        size_t payloadLength = 1)
+{
+    pldm_msg_hdr hdr{};
+    hdr.request = request;
+    hdr.type = type;
+    hdr.command = command;
+    std::vector<uint8_t> msg(sizeof(hdr) + payloadLength);
+    std::memcpy(msg.data(), &hdr, sizeof(hdr));
+    return msg;
+}
+
+TEST(SendRecv, rootMayReadTermini)
+{
+    EXPECT_EQ(SendRecv::checkRequest(defaultSendRecvCommands, 0,
+                                     makeRequest(PLDM_BASE, PLDM_GET_TID)),
+              nullptr);
+    EXPECT_EQ(SendRecv::checkRequest(
+                  defaultSendRecvCommands, 0,
+                  makeRequest(PLDM_PLATFORM, PLDM_GET_SENSOR_READING)),
+              nullptr);
+}
+
+TEST(SendRecv, otherPeersAreDenied)
+{
+    auto request = makeRequest(PLDM_BASE, PLDM_GET_TID);
+    EXPECT_STREQ(
+        SendRecv::checkRequest(defaultSendRecvCommands, 1000, request),
+        SD_BUS_ERROR_ACCESS_DENIED);
+    EXPECT_STREQ(SendRecv::checkRequest(defaultSendRecvCommands,
+                                        std::nullopt, request),
+                 SD_BUS_ERROR_ACCESS_DENIED);
+}
+
+TEST(SendRecv, commandsOutsideAllowListAreDenied)
+{
+    EXPECT_STREQ(SendRecv::checkRequest(
+                     defaultSendRecvCommands, 0,
+                     makeRequest(PLDM_PLATFORM,
+                                 PLDM_SET_STATE_EFFECTER_STATES)),
+                 SD_BUS_ERROR_ACCESS_DENIED);
+    EXPECT_STREQ(SendRecv::checkRequest(
+                     defaultSendRecvCommands, 0,
+                     makeRequest(PLDM_FWUP, PLDM_REQUEST_UPDATE)),
+                 SD_BUS_ERROR_ACCESS_DENIED);
+
+    // A PLDM type not allowed at all
+    EXPECT_STREQ(SendRecv::checkRequest(defaultSendRecvCommands, 0,
+                                        makeRequest(PLDM_OEM, PLDM_GET_TID)),
+                 SD_BUS_ERROR_ACCESS_DENIED);
+
+    SendRecvCommands commands{{PLDM_FWUP, {PLDM_REQUEST_UPDATE}}};
+    EXPECT_EQ(SendRecv::checkRequest(
+                  commands, 0, makeRequest(PLDM_FWUP, PLDM_REQUEST_UPDATE)),
+              nullptr);
+}
+
+TEST(SendRecv, malformedRequestsAreInvalid)
+{
+    EXPECT_STREQ(SendRecv::checkRequest(defaultSendRecvCommands, 0,
+                                        std::vector<uint8_t>(2)),
+                 SD_BUS_ERROR_INVALID_ARGS);
+    EXPECT_STREQ(SendRecv::checkRequest(
+                     defaultSendRecvCommands, 0,
+                     makeRequest(PLDM_BASE, PLDM_GET_TID, false)),
+                 SD_BUS_ERROR_INVALID_ARGS);
+
+    // The header alone is a request, the responder checks the payload
+    EXPECT_EQ(SendRecv::checkRequest(
+                  defaultSendRecvCommands, 0,
+                  makeRequest(PLDM_BASE, PLDM_GET_TID, true, 0)),
+              nullptr);
+    EXPECT_STREQ(SendRecv::checkRequest(defaultSendRecvCommands, 0,
+                                        std::vector<uint8_t>(
+                                            sizeof(pldm_msg_hdr) - 1)),
+                 SD_BUS_ERROR_INVALID_ARGS);
+}
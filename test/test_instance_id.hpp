@@ -12,7 +12,9 @@ static constexpr uintmax_t pldmMaxInstanceIds = 32;
 class TestInstanceIdDb : public pldm::InstanceIdDb
 {
   public:
-    TestInstanceIdDb() : TestInstanceIdDb(createDb()) {}
+    TestInstanceIdDb(uint8_t leaseSize = INSTANCE_ID_LEASE_SIZE) :
+        TestInstanceIdDb(createDb(), leaseSize)
+    {}
 
     ~TestInstanceIdDb()
     {
@@ -35,8 +37,8 @@ class TestInstanceIdDb : public pldm::InstanceIdDb
         return dbPath;
     };
 
-    TestInstanceIdDb(std::filesystem::path dbPath) :
-        InstanceIdDb(dbPath), dbPath(dbPath)
+    TestInstanceIdDb(std::filesystem::path dbPath, uint8_t leaseSize) :
+        InstanceIdDb(dbPath, leaseSize), dbPath(dbPath)
     {}
 
     std::filesystem::path dbPath;
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+
+"""Tool to decode the binary PLDM flight recorder dump"""
+
+import argparse
+import json
+import mmap
+import struct
+import sys
+from datetime import datetime, timezone
+
+MAGIC = b"PLDMFREC"
+SUPPORTED_VERSIONS = (1, 2)
+
+# struct FlightRecorderHeader in common/flight_recorder.hpp
+HEADER_FORMAT = "<8sIIIIQq"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+
+# struct FlightRecorderSlot in common/flight_recorder.hpp, without payload
+SLOT_FORMAT = "<QQHBB4x"
+SLOT_SIZE = struct.calcsize(SLOT_FORMAT)
+
+SLOT_FLAG_TX = 0x01
+SLOT_FLAG_MARK = 0x02
+
+# struct FlightRecorderMark in common/flight_recorder.hpp
+MARK_FORMAT = "<B3xIQ"
+MARK_SIZE = struct.calcsize(MARK_FORMAT)
+
+# enum class MarkKind in common/flight_recorder.hpp
+MARK_KINDS = {
+    1: "host PDR exchange",
+    2: "host PDR processed",
+    3: "host PDR merge",
+}
+
+
+class DumpError(Exception):
+    pass
+
+
+def parse_header(buf):
+    """Parse and validate the dump header.
+
+    Parameters:
+        buf: the mapped dump
+
+    Returns:
+        dict with the header fields
+    """
+
+    if len(buf) < HEADER_SIZE:
+        raise DumpError("file is too small to hold a flight recorder header")
+
+    (
+        magic,
+        version,
+        slot_count,
+        payload_size,
+        slot_size,
+        sequence,
+        realtime_offset,
+    ) = struct.unpack_from(HEADER_FORMAT, buf, 0)
+
+    if magic != MAGIC:
+        raise DumpError("not a PLDM flight recorder dump")
+    if version not in SUPPORTED_VERSIONS:
+        raise DumpError(f"unsupported dump version {version}")
+    if slot_size != SLOT_SIZE + payload_size:
+        raise DumpError("slot size does not match the payload size")
+    if len(buf) < HEADER_SIZE + slot_count * slot_size:
+        raise DumpError("dump is truncated")
+
+    return {
+        "slot_count": slot_count,
+        "payload_size": payload_size,
+        "slot_size": slot_size,
+        "sequence": sequence,
+        "realtime_offset": realtime_offset,
+    }
+
+
+def records(buf, header):
+    """Yield the valid records of the dump, oldest first."""
+
+    entries = []
+    for index in range(header["slot_count"]):
+        offset = HEADER_SIZE + index * header["slot_size"]
+        sequence, timestamp, length, flags, tid = struct.unpack_from(
+            SLOT_FORMAT, buf, offset
+        )
+        if sequence == 0:
+            continue
+        payload_offset = offset + SLOT_SIZE
+        captured = min(length, header["payload_size"])
+        payload = bytes(buf[payload_offset : payload_offset + captured])
+        entries.append((sequence, timestamp, length, flags, tid, payload))
+
+    for entry in sorted(entries, key=lambda e: e[0]):
+        yield entry
+
+
+def decode_mark(payload):
+    """Decode the payload of a mark record.
+
+    Parameters:
+        payload: the captured payload of the record
+
+    Returns:
+        dict with the mark fields, None if the payload is too short
+    """
+
+    if len(payload) < MARK_SIZE:
+        return None
+    kind, record_handle, duration = struct.unpack_from(MARK_FORMAT, payload)
+    return {
+        "kind": MARK_KINDS.get(kind, f"unknown ({kind})"),
+        "record_handle": record_handle,
+        "duration_ns": duration,
+    }
+
+
+def direction(flags):
+    if flags & SLOT_FLAG_MARK:
+        return "Mark"
+    return "Tx" if flags & SLOT_FLAG_TX else "Rx"
+
+
+def format_time(timestamp, realtime_offset):
+    ns = timestamp + realtime_offset
+    wall = datetime.fromtimestamp(ns // 1_000_000_000, tz=timezone.utc)
+    return wall.strftime("%Y-%m-%d %H:%M:%S") + f".{ns % 1_000_000_000:09d}"
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode a binary PLDM flight recorder dump"
+    )
+    parser.add_argument(
+        "dump",
+        nargs="?",
+        default="/tmp/pldm_flight_recorder",
+        help="path of the dump written by pldmd on SIGUSR1",
+    )
+    parser.add_argument(
+        "--json", action="store_true", help="emit the records as JSON"
+    )
+    args = parser.parse_args()
+
+    try:
+        with open(args.dump, "rb") as f:
+            with mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ) as buf:
+                header = parse_header(buf)
+                decoded = []
+                for sequence, timestamp, length, flags, tid, payload in records(
+                    buf, header
+                ):
+                    record = {
+                        "sequence": sequence,
+                        "time": format_time(
+                            timestamp, header["realtime_offset"]
+                        ),
+                        "monotonic_ns": timestamp,
+                        "direction": direction(flags),
+                        "tid": tid,
+                        "length": length,
+                        "truncated": length > len(payload),
+                        "data": payload.hex(" "),
+                    }
+                    if flags & SLOT_FLAG_MARK:
+                        record["mark"] = decode_mark(payload)
+                    decoded.append(record)
+    except (OSError, ValueError, DumpError) as e:
+        sys.exit(f"{args.dump}: {e}")
+
+    if args.json:
+        print(json.dumps(decoded, indent=4))
+        return
+
+    for record in decoded:
+        mark = record.get("mark")
+        if mark:
+            print(
+                f"{record['time']} : Mark : TID {record['tid']}"
+                f" : {mark['kind']} : record handle {mark['record_handle']}"
+                f" : {mark['duration_ns']} ns"
+            )
+            continue
+        suffix = " ..." if record["truncated"] else ""
+        print(
+            f"{record['time']} : {record['direction']} : TID {record['tid']}"
+            f" : {record['length']} bytes"
+        )
+        print(record["data"] + suffix)
+
+
+if __name__ == "__main__":
+    main()